@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+
+"""
+This script generates C++ tables of the AprilTag field layouts from the JSON
+files in src/main/native/resources/edu/wpi/first/apriltag, so
+AprilTagFieldLayout::LoadField() doesn't have to parse JSON at runtime.
+
+Each table is a flat array of doubles: the field length and width, followed
+by the ID, X, Y, Z, and quaternion W, X, Y, Z of each tag.
+"""
+
+import argparse
+import json
+from pathlib import Path
+
+
+def generate_field_tables(output_directory: Path, resource_directory: Path):
+    lines = [
+        "// Copyright (c) FIRST and other WPILib contributors.",
+        "// Open Source Software; you can modify and/or share it under the terms of",
+        "// the WPILib BSD license file in the root directory of this project.",
+        "",
+        "// THIS FILE WAS AUTO-GENERATED BY ./apriltag/generate_field_tables.py. DO NOT MODIFY",
+        "",
+        "#include <span>",
+        "",
+        "namespace frc {",
+    ]
+
+    for filename in sorted(resource_directory.glob("*.json")):
+        with filename.open(encoding="utf-8") as f:
+            layout = json.load(f)
+
+        name = filename.stem.replace("-", "_")
+        rows = [[layout["field"]["length"], layout["field"]["width"]]]
+        for tag in layout["tags"]:
+            translation = tag["pose"]["translation"]
+            q = tag["pose"]["rotation"]["quaternion"]
+            rows.append(
+                [
+                    tag["ID"],
+                    translation["x"],
+                    translation["y"],
+                    translation["z"],
+                    q["W"],
+                    q["X"],
+                    q["Y"],
+                    q["Z"],
+                ]
+            )
+
+        lines.append("")
+        lines.append(f"static constexpr double k{name}[] = {{")
+        for row in rows:
+            lines.append("    " + " ".join(f"{float(value)!r}," for value in row))
+        lines.append("};")
+        lines.append("")
+        lines.append(f"std::span<const double> GetFieldTable_{name}() {{")
+        lines.append(f"  return k{name};")
+        lines.append("}")
+
+    lines.append("")
+    lines.append("}  // namespace frc")
+
+    output_directory.mkdir(parents=True, exist_ok=True)
+    output_file = output_directory / "AprilTagFieldTables.cpp"
+    output_file.write_text("\n".join(lines) + "\n", encoding="utf-8", newline="\n")
+
+
+def main():
+    script_path = Path(__file__).resolve()
+    dirname = script_path.parent
+
+    parser = argparse.ArgumentParser()
+    parser.add_argument(
+        "--output_directory",
+        help="Optional. If set, will output the generated files to this directory, otherwise it will use a path relative to the script",
+        default=dirname / "src/generated/main/native/cpp",
+        type=Path,
+    )
+    parser.add_argument(
+        "--resource_directory",
+        help="Optional. If set, will use this directory as the field layout resource directory, otherwise it will use a path relative to the script",
+        default=dirname / "src/main/native/resources/edu/wpi/first/apriltag",
+        type=Path,
+    )
+    args = parser.parse_args()
+
+    generate_field_tables(args.output_directory, args.resource_directory)
+
+
+if __name__ == "__main__":
+    main()
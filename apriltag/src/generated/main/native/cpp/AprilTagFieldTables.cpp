@@ -0,0 +1,143 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+// THIS FILE WAS AUTO-GENERATED BY ./apriltag/generate_field_tables.py. DO NOT MODIFY
+
+#include <span>
+
+namespace frc {
+
+static constexpr double k2022_rapidreact[] = {
+    16.4592, 8.2296,
+    0.0, -0.0035306, 7.578928199999999, 0.8858503999999999, 1.0, 0.0, 0.0, 0.0,
+    1.0, 3.2327088, 5.486654, 1.7254728, 1.0, 0.0, 0.0, 0.0,
+    2.0, 3.067812, 5.3305202, 1.3762228, 0.7071067811865476, 0.0, 0.0, -0.7071067811865475,
+    3.0, 0.0039878, 5.058536999999999, 0.80645, 1.0, 0.0, 0.0, 0.0,
+    4.0, 0.0039878, 3.5124898, 0.80645, 1.0, 0.0, 0.0, 0.0,
+    5.0, 0.12110719999999998, 1.7178274, 0.8906002000000001, 0.9196502204050923, 0.0, 0.0, 0.39273842708457407,
+    6.0, 0.8733027999999999, 0.9412985999999999, 0.8906002000000001, 0.9196502204050923, 0.0, 0.0, 0.39273842708457407,
+    7.0, 1.6150844, 0.15725139999999999, 0.8906002000000001, 0.9196502204050923, 0.0, 0.0, 0.39273842708457407,
+    10.0, 16.4627306, 0.6506718, 0.8858503999999999, 6.123233995736766e-17, 0.0, 0.0, 1.0,
+    11.0, 13.2350002, 2.743454, 1.7254728, 6.123233995736766e-17, 0.0, 0.0, 1.0,
+    12.0, 13.391388000000001, 2.8998418, 1.3762228, 0.7071067811865476, 0.0, 0.0, 0.7071067811865475,
+    13.0, 16.4552122, 3.1755079999999998, 0.80645, 6.123233995736766e-17, 0.0, 0.0, 1.0,
+    14.0, 16.4552122, 4.7171356, 0.80645, 6.123233995736766e-17, 0.0, 0.0, 1.0,
+    15.0, 16.3350194, 6.5149729999999995, 0.8937752, -0.37298778257580906, -0.0, 0.0, 0.9278362538989199,
+    16.0, 15.5904946, 7.292695599999999, 0.8906002000000001, -0.37298778257580906, -0.0, 0.0, 0.9278362538989199,
+    17.0, 14.847188999999998, 8.0691228, 0.8906002000000001, -0.37298778257580906, -0.0, 0.0, 0.9278362538989199,
+    40.0, 7.874127, 4.9131728, 0.7032752, 0.5446390350150271, 0.0, 0.0, 0.838670567945424,
+    41.0, 7.4312271999999995, 3.759327, 0.7032752, -0.20791169081775934, -0.0, 0.0, 0.9781476007338057,
+    42.0, 8.585073, 3.3164272, 0.7032752, 0.838670567945424, 0.0, 0.0, -0.5446390350150271,
+    43.0, 9.0279728, 4.470273, 0.7032752, 0.9781476007338057, 0.0, 0.0, 0.20791169081775934,
+    50.0, 7.6790296, 4.3261534, 2.4177244, 0.17729273396782605, -0.22744989571511945, 0.04215534644161733, 0.9565859910053995,
+    51.0, 8.0182466, 3.5642296, 2.4177244, -0.5510435465842192, -0.19063969497246985, -0.13102303230819815, 0.8017733354717242,
+    52.0, 8.7801704, 3.9034466, 2.4177244, -0.9565859910053994, -0.04215534644161739, -0.22744989571511942, 0.17729273396782633,
+    53.0, 8.4409534, 4.6653704, 2.4177244, 0.8017733354717241, -0.1310230323081982, 0.19063969497246983, 0.5510435465842194,
+};
+
+std::span<const double> GetFieldTable_2022_rapidreact() {
+  return k2022_rapidreact;
+}
+
+static constexpr double k2023_chargedup[] = {
+    16.54175, 8.0137,
+    1.0, 15.513558, 1.071626, 0.462788, 0.0, 0.0, 0.0, 1.0,
+    2.0, 15.513558, 2.748026, 0.462788, 0.0, 0.0, 0.0, 1.0,
+    3.0, 15.513558, 4.424426, 0.462788, 0.0, 0.0, 0.0, 1.0,
+    4.0, 16.178784, 6.749796, 0.695452, 0.0, 0.0, 0.0, 1.0,
+    5.0, 0.36195, 6.749796, 0.695452, 1.0, 0.0, 0.0, 0.0,
+    6.0, 1.02743, 4.424426, 0.462788, 1.0, 0.0, 0.0, 0.0,
+    7.0, 1.02743, 2.748026, 0.462788, 1.0, 0.0, 0.0, 0.0,
+    8.0, 1.02743, 1.071626, 0.462788, 1.0, 0.0, 0.0, 0.0,
+};
+
+std::span<const double> GetFieldTable_2023_chargedup() {
+  return k2023_chargedup;
+}
+
+static constexpr double k2024_crescendo[] = {
+    16.541, 8.211,
+    1.0, 15.079471999999997, 0.24587199999999998, 1.355852, 0.5000000000000001, 0.0, 0.0, 0.8660254037844386,
+    2.0, 16.185134, 0.883666, 1.355852, 0.5000000000000001, 0.0, 0.0, 0.8660254037844386,
+    3.0, 16.579342, 4.982717999999999, 1.4511020000000001, 6.123233995736766e-17, 0.0, 0.0, 1.0,
+    4.0, 16.579342, 5.547867999999999, 1.4511020000000001, 6.123233995736766e-17, 0.0, 0.0, 1.0,
+    5.0, 14.700757999999999, 8.2042, 1.355852, -0.7071067811865475, -0.0, 0.0, 0.7071067811865476,
+    6.0, 1.8415, 8.2042, 1.355852, -0.7071067811865475, -0.0, 0.0, 0.7071067811865476,
+    7.0, -0.038099999999999995, 5.547867999999999, 1.4511020000000001, 1.0, 0.0, 0.0, 0.0,
+    8.0, -0.038099999999999995, 4.982717999999999, 1.4511020000000001, 1.0, 0.0, 0.0, 0.0,
+    9.0, 0.356108, 0.883666, 1.355852, 0.8660254037844387, 0.0, 0.0, 0.49999999999999994,
+    10.0, 1.4615159999999998, 0.24587199999999998, 1.355852, 0.8660254037844387, 0.0, 0.0, 0.49999999999999994,
+    11.0, 11.904726, 3.7132259999999997, 1.3208, -0.8660254037844387, -0.0, 0.0, 0.49999999999999994,
+    12.0, 11.904726, 4.49834, 1.3208, 0.8660254037844387, 0.0, 0.0, 0.49999999999999994,
+    13.0, 11.220196, 4.105148, 1.3208, 6.123233995736766e-17, 0.0, 0.0, 1.0,
+    14.0, 5.320792, 4.105148, 1.3208, 1.0, 0.0, 0.0, 0.0,
+    15.0, 4.641342, 4.49834, 1.3208, 0.5000000000000001, 0.0, 0.0, 0.8660254037844386,
+    16.0, 4.641342, 3.7132259999999997, 1.3208, -0.4999999999999998, -0.0, 0.0, 0.8660254037844387,
+};
+
+std::span<const double> GetFieldTable_2024_crescendo() {
+  return k2024_crescendo;
+}
+
+static constexpr double k2025_reefscape_andymark[] = {
+    17.548, 8.042,
+    1.0, 16.687292, 0.628142, 1.4859, 0.4539904997395468, 0.0, 0.0, 0.8910065241883678,
+    2.0, 16.687292, 7.414259999999999, 1.4859, -0.45399049973954675, -0.0, 0.0, 0.8910065241883679,
+    3.0, 11.49096, 8.031733999999998, 1.30175, -0.7071067811865475, -0.0, 0.0, 0.7071067811865476,
+    4.0, 9.276079999999999, 6.132575999999999, 1.8679160000000001, 0.9659258262890683, 0.0, 0.25881904510252074, 0.0,
+    5.0, 9.276079999999999, 1.9098259999999998, 1.8679160000000001, 0.9659258262890683, 0.0, 0.25881904510252074, 0.0,
+    6.0, 13.474446, 3.3012379999999997, 0.308102, -0.8660254037844387, -0.0, 0.0, 0.49999999999999994,
+    7.0, 13.890498, 4.0208200000000005, 0.308102, 1.0, 0.0, 0.0, 0.0,
+    8.0, 13.474446, 4.740402, 0.308102, 0.8660254037844387, 0.0, 0.0, 0.49999999999999994,
+    9.0, 12.643358, 4.740402, 0.308102, 0.5000000000000001, 0.0, 0.0, 0.8660254037844386,
+    10.0, 12.227305999999999, 4.0208200000000005, 0.308102, 6.123233995736766e-17, 0.0, 0.0, 1.0,
+    11.0, 12.643358, 3.3012379999999997, 0.308102, -0.4999999999999998, -0.0, 0.0, 0.8660254037844387,
+    12.0, 0.8613139999999999, 0.628142, 1.4859, 0.8910065241883679, 0.0, 0.0, 0.45399049973954675,
+    13.0, 0.8613139999999999, 7.414259999999999, 1.4859, -0.8910065241883678, -0.0, 0.0, 0.45399049973954686,
+    14.0, 8.272272, 6.132575999999999, 1.8679160000000001, 5.914589856893349e-17, -0.25881904510252074, 1.5848095757158825e-17, 0.9659258262890683,
+    15.0, 8.272272, 1.9098259999999998, 1.8679160000000001, 5.914589856893349e-17, -0.25881904510252074, 1.5848095757158825e-17, 0.9659258262890683,
+    16.0, 6.057646, 0.010667999999999999, 1.30175, 0.7071067811865476, 0.0, 0.0, 0.7071067811865476,
+    17.0, 4.073905999999999, 3.3012379999999997, 0.308102, -0.4999999999999998, -0.0, 0.0, 0.8660254037844387,
+    18.0, 3.6576, 4.0208200000000005, 0.308102, 6.123233995736766e-17, 0.0, 0.0, 1.0,
+    19.0, 4.073905999999999, 4.740402, 0.308102, 0.5000000000000001, 0.0, 0.0, 0.8660254037844386,
+    20.0, 4.904739999999999, 4.740402, 0.308102, 0.8660254037844387, 0.0, 0.0, 0.49999999999999994,
+    21.0, 5.321046, 4.0208200000000005, 0.308102, 1.0, 0.0, 0.0, 0.0,
+    22.0, 4.904739999999999, 3.3012379999999997, 0.308102, -0.8660254037844387, -0.0, 0.0, 0.49999999999999994,
+};
+
+std::span<const double> GetFieldTable_2025_reefscape_andymark() {
+  return k2025_reefscape_andymark;
+}
+
+static constexpr double k2025_reefscape_welded[] = {
+    17.548, 8.052,
+    1.0, 16.697198, 0.65532, 1.4859, 0.4539904997395468, 0.0, 0.0, 0.8910065241883678,
+    2.0, 16.697198, 7.3964799999999995, 1.4859, -0.45399049973954675, -0.0, 0.0, 0.8910065241883679,
+    3.0, 11.560809999999998, 8.05561, 1.30175, -0.7071067811865475, -0.0, 0.0, 0.7071067811865476,
+    4.0, 9.276079999999999, 6.137656, 1.8679160000000001, 0.9659258262890683, 0.0, 0.25881904510252074, 0.0,
+    5.0, 9.276079999999999, 1.914906, 1.8679160000000001, 0.9659258262890683, 0.0, 0.25881904510252074, 0.0,
+    6.0, 13.474446, 3.3063179999999996, 0.308102, -0.8660254037844387, -0.0, 0.0, 0.49999999999999994,
+    7.0, 13.890498, 4.0259, 0.308102, 1.0, 0.0, 0.0, 0.0,
+    8.0, 13.474446, 4.745482, 0.308102, 0.8660254037844387, 0.0, 0.0, 0.49999999999999994,
+    9.0, 12.643358, 4.745482, 0.308102, 0.5000000000000001, 0.0, 0.0, 0.8660254037844386,
+    10.0, 12.227305999999999, 4.0259, 0.308102, 6.123233995736766e-17, 0.0, 0.0, 1.0,
+    11.0, 12.643358, 3.3063179999999996, 0.308102, -0.4999999999999998, -0.0, 0.0, 0.8660254037844387,
+    12.0, 0.851154, 0.65532, 1.4859, 0.8910065241883679, 0.0, 0.0, 0.45399049973954675,
+    13.0, 0.851154, 7.3964799999999995, 1.4859, -0.8910065241883678, -0.0, 0.0, 0.45399049973954686,
+    14.0, 8.272272, 6.137656, 1.8679160000000001, 5.914589856893349e-17, -0.25881904510252074, 1.5848095757158825e-17, 0.9659258262890683,
+    15.0, 8.272272, 1.914906, 1.8679160000000001, 5.914589856893349e-17, -0.25881904510252074, 1.5848095757158825e-17, 0.9659258262890683,
+    16.0, 5.9875419999999995, -0.0038099999999999996, 1.30175, 0.7071067811865476, 0.0, 0.0, 0.7071067811865476,
+    17.0, 4.073905999999999, 3.3063179999999996, 0.308102, -0.4999999999999998, -0.0, 0.0, 0.8660254037844387,
+    18.0, 3.6576, 4.0259, 0.308102, 6.123233995736766e-17, 0.0, 0.0, 1.0,
+    19.0, 4.073905999999999, 4.745482, 0.308102, 0.5000000000000001, 0.0, 0.0, 0.8660254037844386,
+    20.0, 4.904739999999999, 4.745482, 0.308102, 0.8660254037844387, 0.0, 0.0, 0.49999999999999994,
+    21.0, 5.321046, 4.0259, 0.308102, 1.0, 0.0, 0.0, 0.0,
+    22.0, 4.904739999999999, 3.3063179999999996, 0.308102, -0.8660254037844387, -0.0, 0.0, 0.49999999999999994,
+};
+
+std::span<const double> GetFieldTable_2025_reefscape_welded() {
+  return k2025_reefscape_welded;
+}
+
+}  // namespace frc
@@ -4,7 +4,9 @@
 
 #include "frc/apriltag/AprilTagDetector.h"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <utility>
 
 #ifdef _WIN32
@@ -51,6 +53,10 @@ AprilTagDetector& AprilTagDetector::operator=(AprilTagDetector&& rhs) {
   m_families = std::move(rhs.m_families);
   rhs.m_families.clear();
   m_qtpCriticalAngle = rhs.m_qtpCriticalAngle;
+  m_trackingConfig = rhs.m_trackingConfig;
+  m_rois = std::move(rhs.m_rois);
+  m_framesSinceFullScan = rhs.m_framesSinceFullScan;
+  m_preprocess = std::move(rhs.m_preprocess);
   return *this;
 }
 
@@ -103,6 +109,39 @@ AprilTagDetector::GetQuadThresholdParameters() const {
   };
 }
 
+void AprilTagDetector::SetTrackingConfig(const TrackingConfig& config) {
+  m_trackingConfig = config;
+  ResetTracking();
+}
+
+void AprilTagDetector::ResetTracking() {
+  m_rois.clear();
+  m_framesSinceFullScan = 0;
+}
+
+static AprilTagDetector::Image ToImage(const image_u8_t* im) {
+  return {im->width, im->height, im->stride, im->buf};
+}
+
+static int Preprocess(void* data, image_u8_t* im, image_u8_t* quad_im,
+                      image_u8_t* threshim) {
+  auto& func = *static_cast<AprilTagDetector::PreprocessFunction*>(data);
+  return func(ToImage(im), ToImage(quad_im), ToImage(threshim)) ? 1 : 0;
+}
+
+void AprilTagDetector::SetPreprocessFunction(PreprocessFunction func) {
+  auto& impl = *static_cast<apriltag_detector_t*>(m_impl);
+  if (func) {
+    m_preprocess = std::make_unique<PreprocessFunction>(std::move(func));
+    impl.preprocess = Preprocess;
+    impl.preprocess_data = m_preprocess.get();
+  } else {
+    impl.preprocess = nullptr;
+    impl.preprocess_data = nullptr;
+    m_preprocess.reset();
+  }
+}
+
 bool AprilTagDetector::AddFamily(std::string_view fam, int bitsCorrected) {
   auto& data = m_families[fam];
   if (data) {
@@ -143,10 +182,116 @@ void AprilTagDetector::ClearFamilies() {
 
 AprilTagDetector::Results AprilTagDetector::Detect(int width, int height,
                                                    int stride, uint8_t* buf) {
-  image_u8_t img{width, height, stride, buf};
-  return {
-      apriltag_detector_detect(static_cast<apriltag_detector_t*>(m_impl), &img),
-      Results::private_init{}};
+  auto impl = static_cast<apriltag_detector_t*>(m_impl);
+  if (!m_trackingConfig.enabled) {
+    image_u8_t img{width, height, stride, buf};
+    return {apriltag_detector_detect(impl, &img), Results::private_init{}};
+  }
+
+  void* detections;
+  if (m_rois.empty() ||
+      ++m_framesSinceFullScan >= m_trackingConfig.fullFrameInterval) {
+    image_u8_t img{width, height, stride, buf};
+    detections = apriltag_detector_detect(impl, &img);
+    m_framesSinceFullScan = 0;
+  } else {
+    detections = DetectRegions(width, height, stride, buf);
+  }
+
+  Results results{detections, Results::private_init{}};
+  UpdateRegions(results, width, height);
+  return results;
+}
+
+void* AprilTagDetector::DetectRegions(int width, int height, int stride,
+                                      uint8_t* buf) {
+  auto impl = static_cast<apriltag_detector_t*>(m_impl);
+  auto detections = zarray_create(sizeof(apriltag_detection_t*));
+  for (auto&& roi : m_rois) {
+    // The image size may have changed since the regions were found
+    int x0 = std::min(roi.x0, width);
+    int y0 = std::min(roi.y0, height);
+    int x1 = std::min(roi.x1, width);
+    int y1 = std::min(roi.y1, height);
+    if (x1 <= x0 || y1 <= y0) {
+      continue;
+    }
+
+    // The region shares the image's buffer, so no pixels are copied
+    image_u8_t img{x1 - x0, y1 - y0, stride, buf + y0 * stride + x0};
+    zarray_t* roiDetections = apriltag_detector_detect(impl, &img);
+
+    for (int i = 0; i < zarray_size(roiDetections); ++i) {
+      apriltag_detection_t* det;
+      zarray_get(roiDetections, i, &det);
+
+      // Shift from region to image pixel coordinates
+      det->c[0] += x0;
+      det->c[1] += y0;
+      for (auto&& corner : det->p) {
+        corner[0] += x0;
+        corner[1] += y0;
+      }
+
+      // The homography maps tag coordinates to pixel coordinates, so the shift
+      // premultiplies it
+      for (int col = 0; col < 3; ++col) {
+        MATD_EL(det->H, 0, col) += x0 * MATD_EL(det->H, 2, col);
+        MATD_EL(det->H, 1, col) += y0 * MATD_EL(det->H, 2, col);
+      }
+
+      zarray_add(detections, &det);
+    }
+
+    // The combined array now owns the detections, so only free the array
+    zarray_destroy(roiDetections);
+  }
+  return detections;
+}
+
+void AprilTagDetector::UpdateRegions(const Results& results, int width,
+                                     int height) {
+  m_rois.clear();
+  for (auto&& det : results) {
+    double minX = std::numeric_limits<double>::infinity();
+    double minY = std::numeric_limits<double>::infinity();
+    double maxX = -std::numeric_limits<double>::infinity();
+    double maxY = -std::numeric_limits<double>::infinity();
+    for (int i = 0; i < 4; ++i) {
+      auto& corner = det->GetCorner(i);
+      minX = std::min(minX, corner.x);
+      minY = std::min(minY, corner.y);
+      maxX = std::max(maxX, corner.x);
+      maxY = std::max(maxY, corner.y);
+    }
+
+    double marginX =
+        std::max((maxX - minX) * m_trackingConfig.roiMargin,
+                 static_cast<double>(m_trackingConfig.minRoiMarginPixels));
+    double marginY =
+        std::max((maxY - minY) * m_trackingConfig.roiMargin,
+                 static_cast<double>(m_trackingConfig.minRoiMarginPixels));
+    Region roi{
+        std::clamp(static_cast<int>(std::floor(minX - marginX)), 0, width),
+        std::clamp(static_cast<int>(std::floor(minY - marginY)), 0, height),
+        std::clamp(static_cast<int>(std::ceil(maxX + marginX)), 0, width),
+        std::clamp(static_cast<int>(std::ceil(maxY + marginY)), 0, height)};
+
+    // Merge overlapping regions so each tag is only detected once
+    for (auto it = m_rois.begin(); it != m_rois.end();) {
+      if (it->x0 < roi.x1 && roi.x0 < it->x1 && it->y0 < roi.y1 &&
+          roi.y0 < it->y1) {
+        roi = {std::min(roi.x0, it->x0), std::min(roi.y0, it->y0),
+               std::max(roi.x1, it->x1), std::max(roi.y1, it->y1)};
+        m_rois.erase(it);
+        // The merged region may now overlap regions already checked
+        it = m_rois.begin();
+      } else {
+        ++it;
+      }
+    }
+    m_rois.push_back(roi);
+  }
 }
 
 void AprilTagDetector::Destroy() {
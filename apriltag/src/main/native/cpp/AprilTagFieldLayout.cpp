@@ -4,12 +4,16 @@
 
 #include "frc/apriltag/AprilTagFieldLayout.h"
 
+#include <bit>
+#include <cstring>
+#include <span>
 #include <system_error>
 #include <utility>
 #include <vector>
 
 #include <units/angle.h>
 #include <units/length.h>
+#include <wpi/Endian.h>
 #include <wpi/MemoryBuffer.h>
 #include <wpi/json.h>
 #include <wpi/raw_ostream.h>
@@ -22,6 +26,16 @@ AprilTagFieldLayout::AprilTagFieldLayout(std::string_view path) {
     throw std::runtime_error(fmt::format("Cannot open file: {}", path));
   }
 
+  auto buffer = fileBuffer.value()->GetBuffer();
+  if (buffer.size() >= sizeof(kBinaryMagic) &&
+      std::memcmp(buffer.data(), kBinaryMagic, sizeof(kBinaryMagic)) == 0) {
+    if (!ReadBinary(buffer)) {
+      throw std::runtime_error(
+          fmt::format("Invalid binary field layout file: {}", path));
+    }
+    return;
+  }
+
   wpi::json json = wpi::json::parse(fileBuffer.value()->GetCharBuffer());
 
   for (const auto& tag : json.at("tags").get<std::vector<AprilTag>>()) {
@@ -101,6 +115,74 @@ void AprilTagFieldLayout::Serialize(std::string_view path) {
   output.flush();
 }
 
+void AprilTagFieldLayout::SerializeBinary(std::string_view path) {
+  std::error_code error_code;
+
+  wpi::raw_fd_ostream output{path, error_code};
+  if (error_code) {
+    throw std::runtime_error(fmt::format("Cannot open file: {}", path));
+  }
+
+  uint8_t buf[kBinaryTagSize];
+  output << std::string_view{kBinaryMagic, sizeof(kBinaryMagic)};
+  wpi::support::endian::write64le(
+      buf, std::bit_cast<uint64_t>(m_fieldLength.value()));
+  wpi::support::endian::write64le(
+      buf + 8, std::bit_cast<uint64_t>(m_fieldWidth.value()));
+  wpi::support::endian::write32le(buf + 16, m_apriltags.size());
+  output << std::span<const uint8_t>{buf, 20};
+
+  for (const auto& [id, tag] : m_apriltags) {
+    const auto& t = tag.pose.Translation();
+    const auto& q = tag.pose.Rotation().GetQuaternion();
+    double values[7] = {t.X().value(), t.Y().value(), t.Z().value(),
+                        q.W(),         q.X(),         q.Y(),
+                        q.Z()};
+    wpi::support::endian::write32le(buf, static_cast<uint32_t>(id));
+    for (int i = 0; i < 7; ++i) {
+      wpi::support::endian::write64le(buf + 4 + 8 * i,
+                                      std::bit_cast<uint64_t>(values[i]));
+    }
+    output << std::span<const uint8_t>{buf, kBinaryTagSize};
+  }
+  output.flush();
+}
+
+bool AprilTagFieldLayout::ReadBinary(std::span<const uint8_t> buffer) {
+  constexpr size_t kHeaderSize = sizeof(kBinaryMagic) + 20;
+  if (buffer.size() < kHeaderSize) {
+    return false;
+  }
+  auto p = buffer.data() + sizeof(kBinaryMagic);
+  m_fieldLength = units::meter_t{
+      std::bit_cast<double>(wpi::support::endian::read64le(p))};
+  m_fieldWidth = units::meter_t{
+      std::bit_cast<double>(wpi::support::endian::read64le(p + 8))};
+  size_t count = wpi::support::endian::read32le(p + 16);
+  if ((buffer.size() - kHeaderSize) / kBinaryTagSize < count) {
+    return false;
+  }
+
+  p = buffer.data() + kHeaderSize;
+  m_apriltags.clear();
+  m_apriltags.reserve(count);
+  for (size_t i = 0; i < count; ++i, p += kBinaryTagSize) {
+    double values[7];
+    for (int j = 0; j < 7; ++j) {
+      values[j] =
+          std::bit_cast<double>(wpi::support::endian::read64le(p + 4 + 8 * j));
+    }
+    int id = static_cast<int32_t>(wpi::support::endian::read32le(p));
+    m_apriltags[id] = AprilTag{
+        id, Pose3d{Translation3d{units::meter_t{values[0]},
+                                 units::meter_t{values[1]},
+                                 units::meter_t{values[2]}},
+                   Rotation3d{Quaternion{values[3], values[4], values[5],
+                                         values[6]}}}};
+  }
+  return true;
+}
+
 void frc::to_json(wpi::json& json, const AprilTagFieldLayout& layout) {
   std::vector<AprilTag> tagVector;
   tagVector.reserve(layout.m_apriltags.size());
@@ -129,39 +211,52 @@ void frc::from_json(const wpi::json& json, AprilTagFieldLayout& layout) {
 // Use namespace declaration for forward declaration
 namespace frc {
 
-// C++ generated from resource files
-std::string_view GetResource_2022_rapidreact_json();
-std::string_view GetResource_2023_chargedup_json();
-std::string_view GetResource_2024_crescendo_json();
-std::string_view GetResource_2025_reefscape_welded_json();
-std::string_view GetResource_2025_reefscape_andymark_json();
+// C++ generated from resource files by generate_field_tables.py
+std::span<const double> GetFieldTable_2022_rapidreact();
+std::span<const double> GetFieldTable_2023_chargedup();
+std::span<const double> GetFieldTable_2024_crescendo();
+std::span<const double> GetFieldTable_2025_reefscape_welded();
+std::span<const double> GetFieldTable_2025_reefscape_andymark();
 
 }  // namespace frc
 
 AprilTagFieldLayout AprilTagFieldLayout::LoadField(AprilTagField field) {
-  std::string_view fieldString;
+  std::span<const double> table;
   switch (field) {
     case AprilTagField::k2022RapidReact:
-      fieldString = GetResource_2022_rapidreact_json();
+      table = GetFieldTable_2022_rapidreact();
       break;
     case AprilTagField::k2023ChargedUp:
-      fieldString = GetResource_2023_chargedup_json();
+      table = GetFieldTable_2023_chargedup();
       break;
     case AprilTagField::k2024Crescendo:
-      fieldString = GetResource_2024_crescendo_json();
+      table = GetFieldTable_2024_crescendo();
       break;
     case AprilTagField::k2025ReefscapeWelded:
-      fieldString = GetResource_2025_reefscape_welded_json();
+      table = GetFieldTable_2025_reefscape_welded();
       break;
     case AprilTagField::k2025ReefscapeAndyMark:
-      fieldString = GetResource_2025_reefscape_andymark_json();
+      table = GetFieldTable_2025_reefscape_andymark();
       break;
     case AprilTagField::kNumFields:
       throw std::invalid_argument("Invalid Field");
   }
 
-  wpi::json json = wpi::json::parse(fieldString);
-  return json.get<AprilTagFieldLayout>();
+  // The table has the field length and width, then the ID, translation, and
+  // rotation quaternion of each tag
+  std::vector<AprilTag> tags;
+  tags.reserve((table.size() - 2) / 8);
+  for (size_t i = 2; i + 8 <= table.size(); i += 8) {
+    tags.push_back(AprilTag{
+        static_cast<int>(table[i]),
+        Pose3d{Translation3d{units::meter_t{table[i + 1]},
+                             units::meter_t{table[i + 2]},
+                             units::meter_t{table[i + 3]}},
+               Rotation3d{Quaternion{table[i + 4], table[i + 5], table[i + 6],
+                                     table[i + 7]}}}});
+  }
+  return AprilTagFieldLayout{std::move(tags), units::meter_t{table[0]},
+                             units::meter_t{table[1]}};
 }
 
 AprilTagFieldLayout frc::LoadAprilTagLayoutField(AprilTagField field) {
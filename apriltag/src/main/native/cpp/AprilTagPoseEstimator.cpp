@@ -4,9 +4,17 @@
 
 #include "frc/apriltag/AprilTagPoseEstimator.h"
 
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <Eigen/Cholesky>
+#include <Eigen/LU>
 #include <Eigen/QR>
 
 #include "frc/apriltag/AprilTagDetection.h"
+#include "frc/apriltag/AprilTagFieldLayout.h"
 
 #ifdef _WIN32
 #pragma warning(disable : 4200)
@@ -152,3 +160,272 @@ Transform3d AprilTagPoseEstimator::Estimate(
   matd_destroy(detection.H);
   return rv;
 }
+
+namespace {
+
+// A camera pose as the transform from field coordinates to camera coordinates
+// (x_camera = R x_field + t), where the camera frame has X right, Y down, and
+// Z forward like the single-tag estimates
+struct CameraPose {
+  Eigen::Matrix3d R;
+  Eigen::Vector3d t;
+};
+
+// A tag's corners in the field and in the image
+struct TagObservation {
+  std::array<Eigen::Vector3d, 4> fieldCorners;
+  std::array<double, 8> imageCorners;
+};
+
+}  // namespace
+
+// Rotation from the apriltag library's tag frame (X right, Y down, Z into the
+// tag) to the field layout's tag frame (X out of the tag, Y left, Z up)
+static const Eigen::Matrix3d kTagToLayout{
+    {0.0, 0.0, -1.0}, {1.0, 0.0, 0.0}, {0.0, -1.0, 0.0}};
+
+// Rotation from the field layout's camera frame (X forward, Y left, Z up) to
+// the camera frame (X right, Y down, Z forward)
+static const Eigen::Matrix3d kLayoutToCamera{
+    {0.0, -1.0, 0.0}, {0.0, 0.0, -1.0}, {1.0, 0.0, 0.0}};
+
+// Tag coordinates of each corner, as used by the detector's homography
+static constexpr double kCornerX[4] = {-1.0, 1.0, 1.0, -1.0};
+static constexpr double kCornerY[4] = {1.0, 1.0, -1.0, -1.0};
+
+static std::array<double, 9> ComputeHomography(
+    const std::array<double, 8>& corners) {
+  Eigen::Matrix<double, 8, 8> A;
+  Eigen::Vector<double, 8> b;
+  for (int i = 0; i < 4; ++i) {
+    double x = kCornerX[i];
+    double y = kCornerY[i];
+    double u = corners[2 * i];
+    double v = corners[2 * i + 1];
+    A.row(2 * i) << x, y, 1.0, 0.0, 0.0, 0.0, -x * u, -y * u;
+    A.row(2 * i + 1) << 0.0, 0.0, 0.0, x, y, 1.0, -x * v, -y * v;
+    b(2 * i) = u;
+    b(2 * i + 1) = v;
+  }
+  Eigen::Vector<double, 8> h = A.partialPivLu().solve(b);
+  return {h(0), h(1), h(2), h(3), h(4), h(5), h(6), h(7), 1.0};
+}
+
+static double SumSquaredError(std::span<const TagObservation> observations,
+                              const CameraPose& pose,
+                              const AprilTagPoseEstimator::Config& config) {
+  double sum = 0.0;
+  for (const auto& observation : observations) {
+    for (int i = 0; i < 4; ++i) {
+      Eigen::Vector3d p = pose.R * observation.fieldCorners[i] + pose.t;
+      if (p.z() <= 0.0) {
+        return std::numeric_limits<double>::infinity();
+      }
+      double du = config.fx * p.x() / p.z() + config.cx -
+                  observation.imageCorners[2 * i];
+      double dv = config.fy * p.y() / p.z() + config.cy -
+                  observation.imageCorners[2 * i + 1];
+      sum += du * du + dv * dv;
+    }
+  }
+  return sum;
+}
+
+// Refines the camera pose with Levenberg-Marquardt iterations, and returns the
+// sum of squared reprojection errors
+static double RefineCameraPose(std::span<const TagObservation> observations,
+                               CameraPose& pose,
+                               const AprilTagPoseEstimator::Config& config,
+                               int nIters) {
+  double cost = SumSquaredError(observations, pose, config);
+  double lambda = 1e-3;
+
+  for (int iter = 0; iter < nIters && std::isfinite(cost); ++iter) {
+    // Normal equations for a perturbation of the camera-frame translation and
+    // rotation, [δt; δθ]
+    Eigen::Matrix<double, 6, 6> JTJ = Eigen::Matrix<double, 6, 6>::Zero();
+    Eigen::Vector<double, 6> JTr = Eigen::Vector<double, 6>::Zero();
+    for (const auto& observation : observations) {
+      for (int i = 0; i < 4; ++i) {
+        Eigen::Vector3d p = pose.R * observation.fieldCorners[i] + pose.t;
+        double invZ = 1.0 / p.z();
+
+        Eigen::Matrix<double, 2, 3> projectionJ{
+            {config.fx * invZ, 0.0, -config.fx * p.x() * invZ * invZ},
+            {0.0, config.fy * invZ, -config.fy * p.y() * invZ * invZ}};
+        Eigen::Matrix<double, 3, 6> pointJ;
+        pointJ.leftCols<3>().setIdentity();
+        pointJ.rightCols<3>() << 0.0, p.z(), -p.y(), -p.z(), 0.0, p.x(),
+            p.y(), -p.x(), 0.0;
+        Eigen::Matrix<double, 2, 6> J = projectionJ * pointJ;
+
+        Eigen::Vector2d r{config.fx * p.x() * invZ + config.cx -
+                              observation.imageCorners[2 * i],
+                          config.fy * p.y() * invZ + config.cy -
+                              observation.imageCorners[2 * i + 1]};
+
+        JTJ += J.transpose() * J;
+        JTr += J.transpose() * r;
+      }
+    }
+
+    // Retry with more damping until the cost goes down
+    bool improved = false;
+    while (!improved && lambda < 1e10) {
+      Eigen::Matrix<double, 6, 6> A = JTJ;
+      A.diagonal() += lambda * JTJ.diagonal();
+      Eigen::Vector<double, 6> delta = A.ldlt().solve(-JTr);
+
+      Eigen::Matrix3d dR =
+          Rotation3d{Eigen::Vector3d{delta.tail<3>()}}.ToMatrix();
+      CameraPose candidate{dR * pose.R, dR * pose.t + delta.head<3>()};
+
+      double candidateCost = SumSquaredError(observations, candidate, config);
+      if (candidateCost < cost) {
+        double improvement = cost - candidateCost;
+        pose = candidate;
+        cost = candidateCost;
+        lambda = std::max(lambda / 10.0, 1e-9);
+        improved = true;
+
+        // Stop once the iterations stop making progress
+        if (improvement <= 1e-12 * cost + 1e-16) {
+          return cost;
+        }
+      } else {
+        lambda *= 10.0;
+      }
+    }
+    if (!improved) {
+      break;
+    }
+  }
+
+  return cost;
+}
+
+static std::optional<AprilTagPoseEstimator::MultiTagEstimate>
+DoEstimateMultiTag(std::span<const TagObservation> observations,
+                   std::span<const Pose3d> tagPoses,
+                   const AprilTagPoseEstimator& estimator,
+                   std::optional<Pose3d> initialGuess, int nIters) {
+  if (observations.empty()) {
+    return std::nullopt;
+  }
+
+  const auto& config = estimator.GetConfig();
+
+  CameraPose pose;
+  if (initialGuess) {
+    // x_camera = C R_guessᵀ (x_field - t_guess)
+    Eigen::Matrix3d R =
+        kLayoutToCamera * initialGuess->Rotation().ToMatrix().transpose();
+    pose = {R, -R * initialGuess->Translation().ToVector()};
+  } else {
+    // Start from whichever single-tag estimate best fits every tag
+    double bestCost = std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < observations.size(); ++i) {
+      auto homography = ComputeHomography(observations[i].imageCorners);
+      auto estimate = estimator.EstimateOrthogonalIteration(
+          homography, observations[i].imageCorners, 50);
+
+      Eigen::Matrix3d tagR = tagPoses[i].Rotation().ToMatrix() * kTagToLayout;
+      Eigen::Vector3d tagT = tagPoses[i].Translation().ToVector();
+      for (const auto& tagPose : {estimate.pose1, estimate.pose2}) {
+        if (tagPose == Transform3d{}) {
+          continue;
+        }
+
+        // Chain the tag-to-camera estimate with the field-to-tag transform
+        Eigen::Matrix3d R = tagPose.Rotation().ToMatrix() * tagR.transpose();
+        CameraPose candidate{R, tagPose.Translation().ToVector() - R * tagT};
+        double cost = SumSquaredError(observations, candidate, config);
+        if (cost < bestCost) {
+          pose = candidate;
+          bestCost = cost;
+        }
+      }
+    }
+    if (!std::isfinite(bestCost)) {
+      return std::nullopt;
+    }
+  }
+
+  double cost = RefineCameraPose(observations, pose, config, nIters);
+  if (!std::isfinite(cost)) {
+    return std::nullopt;
+  }
+
+  // Camera pose in the field: R_field = Rᵀ C, t_field = -Rᵀ t
+  Eigen::Matrix3d fieldR = pose.R.transpose() * kLayoutToCamera;
+  Eigen::Vector3d fieldT = -pose.R.transpose() * pose.t;
+  return AprilTagPoseEstimator::MultiTagEstimate{
+      Pose3d{Translation3d{units::meter_t{fieldT.x()},
+                           units::meter_t{fieldT.y()},
+                           units::meter_t{fieldT.z()}},
+             Rotation3d{OrthogonalizeRotationMatrix(fieldR)}},
+      std::sqrt(cost / (4.0 * observations.size())),
+      static_cast<int>(observations.size())};
+}
+
+static bool AddObservation(std::vector<TagObservation>& observations,
+                           std::vector<Pose3d>& tagPoses, int id,
+                           const std::array<double, 8>& corners,
+                           const AprilTagFieldLayout& layout,
+                           units::meter_t tagSize) {
+  auto tagPose = layout.GetTagPose(id);
+  if (!tagPose) {
+    return false;
+  }
+
+  Eigen::Matrix3d R = tagPose->Rotation().ToMatrix() * kTagToLayout;
+  Eigen::Vector3d t = tagPose->Translation().ToVector();
+  double scale = tagSize.value() / 2.0;
+
+  TagObservation observation;
+  for (int i = 0; i < 4; ++i) {
+    observation.fieldCorners[i] =
+        R * Eigen::Vector3d{scale * kCornerX[i], scale * kCornerY[i], 0.0} + t;
+  }
+  observation.imageCorners = corners;
+  observations.emplace_back(observation);
+  tagPoses.emplace_back(tagPose.value());
+  return true;
+}
+
+std::optional<AprilTagPoseEstimator::MultiTagEstimate>
+AprilTagPoseEstimator::EstimateMultiTag(
+    std::span<const AprilTagDetection* const> detections,
+    const AprilTagFieldLayout& layout, std::optional<Pose3d> initialGuess,
+    int nIters) const {
+  std::vector<TagObservation> observations;
+  std::vector<Pose3d> tagPoses;
+  for (auto detection : detections) {
+    std::array<double, 8> corners;
+    detection->GetCorners(corners);
+    AddObservation(observations, tagPoses, detection->GetId(), corners, layout,
+                   m_config.tagSize);
+  }
+  return DoEstimateMultiTag(observations, tagPoses, *this, initialGuess,
+                            nIters);
+}
+
+std::optional<AprilTagPoseEstimator::MultiTagEstimate>
+AprilTagPoseEstimator::EstimateMultiTag(
+    std::span<const int> ids, std::span<const std::array<double, 8>> corners,
+    const AprilTagFieldLayout& layout, std::optional<Pose3d> initialGuess,
+    int nIters) const {
+  if (ids.size() != corners.size()) {
+    throw std::invalid_argument(
+        "Number of tag IDs must match number of corner arrays");
+  }
+
+  std::vector<TagObservation> observations;
+  std::vector<Pose3d> tagPoses;
+  for (size_t i = 0; i < ids.size(); ++i) {
+    AddObservation(observations, tagPoses, ids[i], corners[i], layout,
+                   m_config.tagSize);
+  }
+  return DoEstimateMultiTag(observations, tagPoses, *this, initialGuess,
+                            nIters);
+}
@@ -6,10 +6,12 @@
 
 #include <stdint.h>
 
+#include <functional>
 #include <memory>
 #include <span>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include <units/angle.h>
 #include <wpi/StringMap.h>
@@ -124,6 +126,39 @@ class WPILIB_DLLEXPORT AprilTagDetector {
     bool deglitch = false;
   };
 
+  /** Region of interest tracking configuration. */
+  struct TrackingConfig {
+    bool operator==(const TrackingConfig&) const = default;
+
+    /**
+     * Whether to restrict detection to regions of interest around the previous
+     * frame's detections. Each region is detected independently, which is much
+     * cheaper than the full frame when tags cover a small part of the image.
+     * Default is disabled (false), which scans the full frame every time.
+     */
+    bool enabled = false;
+
+    /**
+     * How far to expand each detection's bounding box to form its region of
+     * interest, as a fraction of the box's width and height. Larger values
+     * tolerate more tag motion between frames. Default is 0.5.
+     */
+    double roiMargin = 0.5;
+
+    /**
+     * Minimum expansion of each detection's bounding box, in pixels. Default is
+     * 16 pixels.
+     */
+    int minRoiMarginPixels = 16;
+
+    /**
+     * How often to scan the full frame to find tags that entered the image
+     * since the last full scan, in frames. A full frame is also scanned
+     * whenever the previous frame had no detections. Default is 10 frames.
+     */
+    int fullFrameInterval = 10;
+  };
+
   /**
    * Array of detection results. Each array element is a pointer to an
    * AprilTagDetection.
@@ -149,6 +184,39 @@ class WPILIB_DLLEXPORT AprilTagDetector {
     void* m_impl = nullptr;
   };
 
+  /** An 8-bit grayscale image. */
+  struct Image {
+    /** Width, in pixels. */
+    int width;
+
+    /** Height, in pixels. */
+    int height;
+
+    /** Number of bytes between image rows. */
+    int stride;
+
+    /** Image buffer. */
+    uint8_t* buf;
+  };
+
+  /**
+   * Function that replaces the image-wide quad detection stages (decimation,
+   * blur, and thresholding), e.g. with an implementation that runs on a GPU.
+   *
+   * It's given the input image and must fill quadImage with the input image
+   * decimated by Config::quadDecimate and blurred by Config::quadSigma, and
+   * thresholdImage with the thresholded quad image: 0 for black pixels, 255
+   * for white pixels, and 127 for low-contrast pixels that should be skipped.
+   * Both output images are already sized for the decimated image. Connected
+   * components, quad fitting, and decoding still run on the CPU.
+   *
+   * Returning false falls back to the built-in CPU implementation for that
+   * image. The function must not throw.
+   */
+  using PreprocessFunction =
+      std::function<bool(const Image& image, const Image& quadImage,
+                         const Image& thresholdImage)>;
+
   AprilTagDetector();
   ~AprilTagDetector() { Destroy(); }
   AprilTagDetector(const AprilTagDetector&) = delete;
@@ -156,7 +224,11 @@ class WPILIB_DLLEXPORT AprilTagDetector {
   AprilTagDetector(AprilTagDetector&& rhs)
       : m_impl{rhs.m_impl},
         m_families{std::move(rhs.m_families)},
-        m_qtpCriticalAngle{rhs.m_qtpCriticalAngle} {
+        m_qtpCriticalAngle{rhs.m_qtpCriticalAngle},
+        m_trackingConfig{rhs.m_trackingConfig},
+        m_rois{std::move(rhs.m_rois)},
+        m_framesSinceFullScan{rhs.m_framesSinceFullScan},
+        m_preprocess{std::move(rhs.m_preprocess)} {
     rhs.m_impl = nullptr;
   }
   AprilTagDetector& operator=(AprilTagDetector&& rhs);
@@ -194,6 +266,35 @@ class WPILIB_DLLEXPORT AprilTagDetector {
    */
   QuadThresholdParameters GetQuadThresholdParameters() const;
 
+  /**
+   * Sets region of interest tracking configuration.
+   *
+   * @param config Configuration
+   */
+  void SetTrackingConfig(const TrackingConfig& config);
+
+  /**
+   * Gets region of interest tracking configuration.
+   *
+   * @return Configuration
+   */
+  TrackingConfig GetTrackingConfig() const { return m_trackingConfig; }
+
+  /**
+   * Forgets the previous frame's detections, so the next call to Detect()
+   * scans the full frame. Call this when switching between image sources.
+   */
+  void ResetTracking();
+
+  /**
+   * Sets a function to run the image-wide quad detection stages instead of
+   * the built-in CPU implementation.
+   *
+   * @param func Preprocessing function; an empty function restores the
+   *             built-in implementation
+   */
+  void SetPreprocessFunction(PreprocessFunction func);
+
   /** @} */
 
   /**
@@ -228,6 +329,9 @@ class WPILIB_DLLEXPORT AprilTagDetector {
    * Detect tags from an 8-bit image.
    * The image must be grayscale.
    *
+   * If tracking is enabled, only the regions of interest around the previous
+   * frame's detections are searched, except on periodic full-frame scans.
+   *
    * @param width width of the image
    * @param height height of the image
    * @param stride number of bytes between image rows (often the same as width)
@@ -253,10 +357,26 @@ class WPILIB_DLLEXPORT AprilTagDetector {
   void Destroy();
   void DestroyFamilies();
   void DestroyFamily(std::string_view name, void* data);
+  void* DetectRegions(int width, int height, int stride, uint8_t* buf);
+  void UpdateRegions(const Results& results, int width, int height);
+
+  // Image region, in pixels
+  struct Region {
+    int x0;
+    int y0;
+    int x1;
+    int y1;
+  };
 
   void* m_impl;
   wpi::StringMap<void*> m_families;
   units::radian_t m_qtpCriticalAngle = 10_deg;
+
+  TrackingConfig m_trackingConfig;
+  std::vector<Region> m_rois;
+  int m_framesSinceFullScan = 0;
+  // Heap allocated so the detector's pointer to it survives moves
+  std::unique_ptr<PreprocessFunction> m_preprocess;
 };
 
 }  // namespace frc
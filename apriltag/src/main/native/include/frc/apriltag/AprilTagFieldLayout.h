@@ -4,7 +4,10 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #include <optional>
+#include <span>
 #include <string_view>
 #include <unordered_map>
 #include <vector>
@@ -60,9 +63,10 @@ class WPILIB_DLLEXPORT AprilTagFieldLayout {
   AprilTagFieldLayout() = default;
 
   /**
-   * Construct a new AprilTagFieldLayout with values imported from a JSON file.
+   * Construct a new AprilTagFieldLayout with values imported from a JSON file,
+   * or a binary file written by SerializeBinary().
    *
-   * @param path Path of the JSON file to import from.
+   * @param path Path of the JSON or binary file to import from.
    */
   explicit AprilTagFieldLayout(std::string_view path);
 
@@ -137,6 +141,14 @@ class WPILIB_DLLEXPORT AprilTagFieldLayout {
    */
   void Serialize(std::string_view path);
 
+  /**
+   * Serializes an AprilTagFieldLayout to a binary file, which loads faster
+   * than JSON. The origin is not saved.
+   *
+   * @param path The path to write the binary file to.
+   */
+  void SerializeBinary(std::string_view path);
+
   /*
    * Checks equality between this AprilTagFieldLayout and another object.
    */
@@ -148,6 +160,16 @@ class WPILIB_DLLEXPORT AprilTagFieldLayout {
   units::meter_t m_fieldWidth;
   Pose3d m_origin;
 
+  // Binary file format: the magic, the field length and width (as
+  // little-endian doubles), and the number of tags (little-endian uint32),
+  // followed by each tag's ID (int32) and translation and rotation quaternion
+  // (seven doubles)
+  static constexpr char kBinaryMagic[8] = {'W', 'P', 'I', 'A',
+                                           'T', 'F', 'L', '1'};
+  static constexpr size_t kBinaryTagSize = 4 + 7 * 8;
+
+  bool ReadBinary(std::span<const uint8_t> buffer);
+
   friend WPILIB_DLLEXPORT void to_json(wpi::json& json,
                                        const AprilTagFieldLayout& layout);
 
@@ -4,17 +4,21 @@
 
 #pragma once
 
+#include <array>
+#include <optional>
 #include <span>
 
 #include <units/length.h>
 #include <wpi/SymbolExports.h>
 
 #include "frc/apriltag/AprilTagPoseEstimate.h"
+#include "frc/geometry/Pose3d.h"
 #include "frc/geometry/Transform3d.h"
 
 namespace frc {
 
 class AprilTagDetection;
+class AprilTagFieldLayout;
 
 /** Pose estimators for AprilTag tags. */
 class WPILIB_DLLEXPORT AprilTagPoseEstimator {
@@ -39,6 +43,21 @@ class WPILIB_DLLEXPORT AprilTagPoseEstimator {
     double cy;
   };
 
+  /** A camera pose estimate solved jointly from several tags. */
+  struct MultiTagEstimate {
+    /**
+     * The camera pose in field coordinates. The camera looks along its +X axis,
+     * with +Y to the left and +Z up.
+     */
+    Pose3d fieldToCamera;
+
+    /** The RMS reprojection error of the tag corners, in pixels. */
+    double error;
+
+    /** The number of tags used in the estimate. */
+    int numTags;
+  };
+
   /**
    * Creates estimator.
    *
@@ -138,6 +157,56 @@ class WPILIB_DLLEXPORT AprilTagPoseEstimator {
   Transform3d Estimate(std::span<const double, 9> homography,
                        std::span<const double, 8> corners) const;
 
+  /**
+   * Estimates the camera pose in the field from all detected tags at once.
+   *
+   * Rather than estimating each tag's pose separately, this finds the single
+   * camera pose that minimizes the reprojection error of every corner of every
+   * tag in the field layout, using Levenberg-Marquardt iterations. This is
+   * faster and more accurate than combining per-tag estimates when several tags
+   * are visible.
+   *
+   * Without an initial guess, the solve starts from the orthogonal iteration
+   * estimate (see EstimateOrthogonalIteration()) of whichever tag and pose
+   * ambiguity best fits all the tags. Passing the previous estimate or the
+   * odometry pose as an initial guess skips that step and usually converges in
+   * a few iterations.
+   *
+   * @param detections Tag detections. Tags not in the field layout are
+   *     ignored.
+   * @param layout Field layout with the tag poses.
+   * @param initialGuess Initial guess of the camera pose in the field, with
+   *     the same convention as MultiTagEstimate::fieldToCamera.
+   * @param nIters Maximum number of iterations
+   * @return Camera pose estimate, or std::nullopt if no tags were in the field
+   *     layout
+   */
+  std::optional<MultiTagEstimate> EstimateMultiTag(
+      std::span<const AprilTagDetection* const> detections,
+      const AprilTagFieldLayout& layout,
+      std::optional<Pose3d> initialGuess = std::nullopt,
+      int nIters = 20) const;
+
+  /**
+   * Estimates the camera pose in the field from all detected tags at once.
+   *
+   * @param ids Tag IDs
+   * @param corners Corner point arrays (X and Y for each corner in order) for
+   *     each tag ID
+   * @param layout Field layout with the tag poses.
+   * @param initialGuess Initial guess of the camera pose in the field, with
+   *     the same convention as MultiTagEstimate::fieldToCamera.
+   * @param nIters Maximum number of iterations
+   * @return Camera pose estimate, or std::nullopt if no tags were in the field
+   *     layout
+   * @throws std::invalid_argument if ids and corners have different sizes
+   */
+  std::optional<MultiTagEstimate> EstimateMultiTag(
+      std::span<const int> ids, std::span<const std::array<double, 8>> corners,
+      const AprilTagFieldLayout& layout,
+      std::optional<Pose3d> initialGuess = std::nullopt,
+      int nIters = 20) const;
+
  private:
   Config m_config;
 };
@@ -123,6 +123,20 @@ struct apriltag_quad_thresh_params
 // Represents a detector object. Upon creating a detector, all fields
 // are set to reasonable values, but can be overridden by accessing
 // these fields.
+// Scratch buffers kept by the detector between calls to
+// apriltag_detector_detect(); see apriltag_detector_scratch().
+enum apriltag_scratch_buffer
+{
+    APRILTAG_SCRATCH_DECIMATE,
+    APRILTAG_SCRATCH_THRESHOLD,
+    APRILTAG_SCRATCH_TILE_MAX,
+    APRILTAG_SCRATCH_TILE_MIN,
+    APRILTAG_SCRATCH_TILE_MAX_BLUR,
+    APRILTAG_SCRATCH_TILE_MIN_BLUR,
+    APRILTAG_SCRATCH_UNIONFIND,
+    APRILTAG_SCRATCH_COUNT
+};
+
 typedef struct apriltag_detector apriltag_detector_t;
 struct apriltag_detector
 {
@@ -167,6 +181,17 @@ struct apriltag_detector
 
     struct apriltag_quad_thresh_params qtp;
 
+    // Optional replacement for the image-wide quad detection stages
+    // (decimation, blur, and thresholding), e.g. to run them on a GPU.
+    // quad_im and threshim are sized for the decimated image. The
+    // function must fill quad_im with the decimated and blurred image
+    // and threshim with the thresholded image (0 for black, 255 for
+    // white, and 127 for low-contrast pixels). Returning 0 falls back
+    // to the built-in implementation. Connected components, quad
+    // fitting, and decoding always run on the CPU.
+    int (*preprocess)(void *data, image_u8_t *im, image_u8_t *quad_im, image_u8_t *threshim);
+    void *preprocess_data;
+
     ///////////////////////////////////////////////////////////////
     // Statistics relating to last processed frame
     timeprofile_t *tp;
@@ -188,6 +213,12 @@ struct apriltag_detector
 
     // Used for thread safety.
     pthread_mutex_t mutex;
+
+    // Image-sized buffers reused between frames, so continuous detection
+    // doesn't allocate and free them for every frame. They grow to fit the
+    // largest image seen and are freed by apriltag_detector_destroy().
+    void *scratch[APRILTAG_SCRATCH_COUNT];
+    size_t scratch_size[APRILTAG_SCRATCH_COUNT];
 };
 
 // Represents the detection of a tag. These are returned to the user
@@ -261,6 +292,16 @@ void apriltag_detector_destroy(apriltag_detector_t *td);
 // _detection_destroy and zarray_destroy yourself.
 zarray_t *apriltag_detector_detect(apriltag_detector_t *td, image_u8_t *im_orig);
 
+// Returns one of the detector's scratch buffers with room for at least size
+// bytes. The contents are unspecified, and the buffer is only valid until the
+// next call with the same buffer index.
+void *apriltag_detector_scratch(apriltag_detector_t *td, enum apriltag_scratch_buffer buffer, size_t size);
+
+// Creates an image header whose pixels are stored in one of the detector's
+// scratch buffers. Free the header with free(), not image_u8_destroy().
+image_u8_t *apriltag_detector_scratch_image(apriltag_detector_t *td, enum apriltag_scratch_buffer buffer,
+                                            int width, int height, int stride);
+
 // Call this method on each of the tags returned by apriltag_detector_detect
 void apriltag_detection_destroy(apriltag_detection_t *det);
 
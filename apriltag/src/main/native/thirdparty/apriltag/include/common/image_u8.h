@@ -73,6 +73,12 @@ void image_u8_gaussian_blur(image_u8_t *im, double sigma, int k);
 // 1.5, 2, 3, 4, ... supported
 image_u8_t *image_u8_decimate(image_u8_t *im, float factor);
 
+// Computes the size of the image image_u8_decimate() would return
+void image_u8_decimate_size(const image_u8_t *im, float factor, int *width, int *height);
+
+// Decimates into an existing image of the size from image_u8_decimate_size()
+void image_u8_decimate_into(const image_u8_t *im, float factor, image_u8_t *decim);
+
 void image_u8_destroy(image_u8_t *im);
 
 // Write a pnm. Returns 0 on success
@@ -55,6 +55,17 @@ static inline unionfind_t *unionfind_create(uint32_t maxid)
     return uf;
 }
 
+// Initializes a union-find over a caller-owned buffer with room for
+// 2*(maxid+1) elements. Don't call unionfind_destroy() on it afterward.
+static inline void unionfind_init(unionfind_t *uf, uint32_t maxid, uint32_t *buf)
+{
+    uf->maxid = maxid;
+    uf->parent = buf;
+    memset(uf->parent, 0xff, (maxid+1) * sizeof(uint32_t));
+    uf->size = uf->parent + (maxid+1);
+    memset(uf->size, 0, (maxid+1) * sizeof(uint32_t));
+}
+
 static inline void unionfind_destroy(unionfind_t *uf)
 {
     free(uf->parent);
@@ -67,6 +67,7 @@ static inline long int random(void)
 #define APRILTAG_U64_ONE ((uint64_t) 1)
 
 extern zarray_t *apriltag_quad_thresh(apriltag_detector_t *td, image_u8_t *im);
+extern zarray_t *apriltag_quad_thresh_image(apriltag_detector_t *td, image_u8_t *im, image_u8_t *threshim);
 
 // Regresses a model of the form:
 // intensity(x,y) = C0*x + C1*y + CC2
@@ -390,10 +391,36 @@ void apriltag_detector_destroy(apriltag_detector_t *td)
 
     apriltag_detector_clear_families(td);
 
+    for (int i = 0; i < APRILTAG_SCRATCH_COUNT; i++)
+        free(td->scratch[i]);
+
     zarray_destroy(td->tag_families);
     free(td);
 }
 
+void *apriltag_detector_scratch(apriltag_detector_t *td, enum apriltag_scratch_buffer buffer, size_t size)
+{
+    if (td->scratch_size[buffer] < size) {
+        free(td->scratch[buffer]);
+        td->scratch[buffer] = malloc(size);
+        td->scratch_size[buffer] = size;
+    }
+    return td->scratch[buffer];
+}
+
+image_u8_t *apriltag_detector_scratch_image(apriltag_detector_t *td, enum apriltag_scratch_buffer buffer,
+                                            int width, int height, int stride)
+{
+    uint8_t *buf = apriltag_detector_scratch(td, buffer, (size_t) height*stride);
+
+    // const initializer
+    image_u8_t tmp = { .width = width, .height = height, .stride = stride, .buf = buf };
+
+    image_u8_t *im = (image_u8_t*) malloc(sizeof(image_u8_t));
+    memcpy(im, &tmp, sizeof(image_u8_t));
+    return im;
+}
+
 struct quad_decode_task
 {
     int i0, i1;
@@ -1022,13 +1049,33 @@ zarray_t *apriltag_detector_detect(apriltag_detector_t *td, image_u8_t *im_orig)
     // Step 1. Detect quads according to requested image decimation
     // and blurring parameters.
     image_u8_t *quad_im = im_orig;
-    if (td->quad_decimate > 1) {
-        quad_im = image_u8_decimate(im_orig, td->quad_decimate);
+    image_u8_t *threshim = NULL;
+    if (td->preprocess) {
+        int width = im_orig->width, height = im_orig->height;
+        if (td->quad_decimate > 1)
+            image_u8_decimate_size(im_orig, td->quad_decimate, &width, &height);
+        image_u8_t *pre_im = apriltag_detector_scratch_image(td, APRILTAG_SCRATCH_DECIMATE, width, height, width);
+        image_u8_t *pre_threshim = apriltag_detector_scratch_image(td, APRILTAG_SCRATCH_THRESHOLD, width, height, width);
+        if (td->preprocess(td->preprocess_data, im_orig, pre_im, pre_threshim)) {
+            quad_im = pre_im;
+            threshim = pre_threshim;
+            timeprofile_stamp(td->tp, "preprocess");
+        } else {
+            free(pre_im);
+            free(pre_threshim);
+        }
+    }
+
+    if (threshim == NULL && td->quad_decimate > 1) {
+        int width, height;
+        image_u8_decimate_size(im_orig, td->quad_decimate, &width, &height);
+        quad_im = apriltag_detector_scratch_image(td, APRILTAG_SCRATCH_DECIMATE, width, height, width);
+        image_u8_decimate_into(im_orig, td->quad_decimate, quad_im);
 
         timeprofile_stamp(td->tp, "decimate");
     }
 
-    if (td->quad_sigma != 0) {
+    if (threshim == NULL && td->quad_sigma != 0) {
         // compute a reasonable kernel width by figuring that the
         // kernel should go out 2 std devs.
         //
@@ -1078,7 +1125,8 @@ zarray_t *apriltag_detector_detect(apriltag_detector_t *td, image_u8_t *im_orig)
     if (td->debug)
         image_u8_write_pnm(quad_im, "debug_preprocess.pnm");
 
-    zarray_t *quads = apriltag_quad_thresh(td, quad_im);
+    zarray_t *quads = threshim ? apriltag_quad_thresh_image(td, quad_im, threshim)
+                               : apriltag_quad_thresh(td, quad_im);
 
     // adjust centers of pixels so that they correspond to the
     // original full-resolution image.
@@ -1100,7 +1148,7 @@ zarray_t *apriltag_detector_detect(apriltag_detector_t *td, image_u8_t *im_orig)
     }
 
     if (quad_im != im_orig)
-        image_u8_destroy(quad_im);
+        free(quad_im);
 
     zarray_t *detections = zarray_create(sizeof(apriltag_detection_t*));
 
@@ -34,6 +34,11 @@ either expressed or implied, of the Regents of The University of Michigan.
 #include <string.h>
 #include <stdio.h>
 #include <stdint.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
 #include "apriltag.h"
 #include "common/image_u8x3.h"
@@ -1091,8 +1096,66 @@ void do_minmax_task(void *p)
     int ty = task->ty;
     int tw = task->im->width / tilesz;
     image_u8_t *im = task->im;
+    int tx = 0;
+
+    // Vectorized path: process four tiles (16 columns) at a time. The
+    // results are identical to the scalar loop below, which handles the
+    // remaining tiles.
+#if defined(__SSE2__)
+    for (; tx + 4 <= tw; tx += 4) {
+        const uint8_t *row = &im->buf[ty*tilesz*s + tx*tilesz];
+        __m128i vmax = _mm_loadu_si128((const __m128i *) row);
+        __m128i vmin = vmax;
+        for (int dy = 1; dy < tilesz; dy++) {
+            __m128i v = _mm_loadu_si128((const __m128i *) (row + dy*s));
+            vmax = _mm_max_epu8(vmax, v);
+            vmin = _mm_min_epu8(vmin, v);
+        }
 
-    for (int tx = 0; tx < tw; tx++) {
+        // Reduce each tile's four columns into the low byte of its 32-bit
+        // lane, then pack the low bytes together.
+        vmax = _mm_max_epu8(vmax, _mm_srli_epi32(vmax, 8));
+        vmax = _mm_max_epu8(vmax, _mm_srli_epi32(vmax, 16));
+        vmin = _mm_min_epu8(vmin, _mm_srli_epi32(vmin, 8));
+        vmin = _mm_min_epu8(vmin, _mm_srli_epi32(vmin, 16));
+
+        const __m128i lowbyte = _mm_set1_epi32(0xff);
+        vmax = _mm_and_si128(vmax, lowbyte);
+        vmin = _mm_and_si128(vmin, lowbyte);
+        vmax = _mm_packus_epi16(_mm_packs_epi32(vmax, vmax), vmax);
+        vmin = _mm_packus_epi16(_mm_packs_epi32(vmin, vmin), vmin);
+
+        int32_t max4 = _mm_cvtsi128_si32(vmax);
+        int32_t min4 = _mm_cvtsi128_si32(vmin);
+        memcpy(&task->im_max[ty*tw+tx], &max4, sizeof(max4));
+        memcpy(&task->im_min[ty*tw+tx], &min4, sizeof(min4));
+    }
+#elif defined(__ARM_NEON)
+    for (; tx + 4 <= tw; tx += 4) {
+        const uint8_t *row = &im->buf[ty*tilesz*s + tx*tilesz];
+        uint8x16_t vmax = vld1q_u8(row);
+        uint8x16_t vmin = vmax;
+        for (int dy = 1; dy < tilesz; dy++) {
+            uint8x16_t v = vld1q_u8(row + dy*s);
+            vmax = vmaxq_u8(vmax, v);
+            vmin = vminq_u8(vmin, v);
+        }
+
+        // Two rounds of pairwise reduction leave each tile's result in
+        // the first four bytes.
+        uint8x8_t max8 = vpmax_u8(vget_low_u8(vmax), vget_high_u8(vmax));
+        uint8x8_t min8 = vpmin_u8(vget_low_u8(vmin), vget_high_u8(vmin));
+        max8 = vpmax_u8(max8, max8);
+        min8 = vpmin_u8(min8, min8);
+
+        uint32_t max4 = vget_lane_u32(vreinterpret_u32_u8(max8), 0);
+        uint32_t min4 = vget_lane_u32(vreinterpret_u32_u8(min8), 0);
+        memcpy(&task->im_max[ty*tw+tx], &max4, sizeof(max4));
+        memcpy(&task->im_min[ty*tw+tx], &min4, sizeof(min4));
+    }
+#endif
+
+    for (; tx < tw; tx++) {
         uint8_t max = 0, min = 255;
 
         for (int dy = 0; dy < tilesz; dy++) {
@@ -1158,8 +1221,53 @@ void do_threshold_task(void *p)
     image_u8_t *im = task->im;
     image_u8_t *threshim = task->threshim;
     int min_white_black_diff = task->td->qtp.min_white_black_diff;
+    int tx = 0;
+
+    // Vectorized path: threshold four tiles (16 columns) at a time. The
+    // results are identical to the scalar loop below, which handles the
+    // remaining tiles.
+#if defined(__SSE2__) || defined(__ARM_NEON)
+    for (; tx + 4 <= tw; tx += 4) {
+        // Per-pixel threshold and low contrast mask for the four tiles
+        uint8_t thresh16[16], lowcontrast16[16];
+        for (int i = 0; i < 4; i++) {
+            int min = im_min[ty*tw + tx + i];
+            int max = im_max[ty*tw + tx + i];
+            memset(&thresh16[4*i], min + (max - min) / 2, 4);
+            memset(&lowcontrast16[4*i],
+                   max - min < min_white_black_diff ? 0xff : 0, 4);
+        }
 
-    for (int tx = 0; tx < tw; tx++) {
+#if defined(__SSE2__)
+        // SSE2 only has signed byte comparisons, so flip the sign bits
+        const __m128i bias = _mm_set1_epi8((char) 0x80);
+        __m128i thresh =
+            _mm_xor_si128(_mm_loadu_si128((const __m128i *) thresh16), bias);
+        __m128i lowcontrast = _mm_loadu_si128((const __m128i *) lowcontrast16);
+        __m128i fill = _mm_and_si128(lowcontrast, _mm_set1_epi8(127));
+
+        for (int dy = 0; dy < tilesz; dy++) {
+            int offset = (ty*tilesz + dy)*s + tx*tilesz;
+            __m128i v = _mm_loadu_si128((const __m128i *) &im->buf[offset]);
+            __m128i gt = _mm_cmpgt_epi8(_mm_xor_si128(v, bias), thresh);
+            _mm_storeu_si128((__m128i *) &threshim->buf[offset],
+                             _mm_or_si128(fill, _mm_andnot_si128(lowcontrast, gt)));
+        }
+#else
+        uint8x16_t thresh = vld1q_u8(thresh16);
+        uint8x16_t lowcontrast = vld1q_u8(lowcontrast16);
+        uint8x16_t fill = vdupq_n_u8(127);
+
+        for (int dy = 0; dy < tilesz; dy++) {
+            int offset = (ty*tilesz + dy)*s + tx*tilesz;
+            uint8x16_t gt = vcgtq_u8(vld1q_u8(&im->buf[offset]), thresh);
+            vst1q_u8(&threshim->buf[offset], vbslq_u8(lowcontrast, fill, gt));
+        }
+#endif
+    }
+#endif
+
+    for (; tx < tw; tx++) {
         int min = im_min[ty*tw + tx];
         int max = im_max[ty*tw + tx];
 
@@ -1205,8 +1313,7 @@ image_u8_t *threshold(apriltag_detector_t *td, image_u8_t *im)
     assert(w < 32768);
     assert(h < 32768);
 
-    image_u8_t *threshim = image_u8_create_alignment(w, h, s);
-    assert(threshim->stride == s);
+    image_u8_t *threshim = apriltag_detector_scratch_image(td, APRILTAG_SCRATCH_THRESHOLD, w, h, s);
 
     // The idea is to find the maximum and minimum values in a
     // window around each pixel. If it's a contrast-free region
@@ -1238,8 +1345,8 @@ image_u8_t *threshold(apriltag_detector_t *td, image_u8_t *im)
     int tw = w / tilesz;
     int th = h / tilesz;
 
-    uint8_t *im_max = calloc(tw*th, sizeof(uint8_t));
-    uint8_t *im_min = calloc(tw*th, sizeof(uint8_t));
+    uint8_t *im_max = apriltag_detector_scratch(td, APRILTAG_SCRATCH_TILE_MAX, tw*th);
+    uint8_t *im_min = apriltag_detector_scratch(td, APRILTAG_SCRATCH_TILE_MIN, tw*th);
 
     struct minmax_task *minmax_tasks = malloc(sizeof(struct minmax_task)*th);
     // first, collect min/max statistics for each tile
@@ -1258,8 +1365,8 @@ image_u8_t *threshold(apriltag_detector_t *td, image_u8_t *im)
     // over larger areas. This reduces artifacts due to abrupt changes
     // in the threshold value.
     if (1) {
-        uint8_t *im_max_tmp = calloc(tw*th, sizeof(uint8_t));
-        uint8_t *im_min_tmp = calloc(tw*th, sizeof(uint8_t));
+        uint8_t *im_max_tmp = apriltag_detector_scratch(td, APRILTAG_SCRATCH_TILE_MAX_BLUR, tw*th);
+        uint8_t *im_min_tmp = apriltag_detector_scratch(td, APRILTAG_SCRATCH_TILE_MIN_BLUR, tw*th);
 
         struct blur_task *blur_tasks = malloc(sizeof(struct blur_task)*th);
         for (int ty = 0; ty < th; ty++) {
@@ -1274,8 +1381,6 @@ image_u8_t *threshold(apriltag_detector_t *td, image_u8_t *im)
         }
         workerpool_run(td->wp);
         free(blur_tasks);
-        free(im_max);
-        free(im_min);
         im_max = im_max_tmp;
         im_min = im_min_tmp;
     }
@@ -1331,9 +1436,6 @@ image_u8_t *threshold(apriltag_detector_t *td, image_u8_t *im)
         }
     }
 
-    free(im_min);
-    free(im_max);
-
     // this is a dilate/erode deglitching scheme that does not improve
     // anything as far as I can tell.
     if (td->qtp.deglitch) {
@@ -1495,7 +1597,9 @@ image_u8_t *threshold_bayer(apriltag_detector_t *td, image_u8_t *im)
 }
 
 unionfind_t* connected_components(apriltag_detector_t *td, image_u8_t* threshim, int w, int h, int ts) {
-    unionfind_t *uf = unionfind_create(w * h);
+    unionfind_t *uf = malloc(sizeof(unionfind_t));
+    unionfind_init(uf, w * h, apriltag_detector_scratch(td, APRILTAG_SCRATCH_UNIONFIND,
+                                                        2 * ((size_t) w * h + 1) * sizeof(uint32_t)));
 
     if (td->nthreads <= 1) {
         do_unionfind_first_line(uf, threshim, w, ts);
@@ -1844,14 +1948,11 @@ zarray_t* fit_quads(apriltag_detector_t *td, int w, int h, zarray_t* clusters, i
     return quads;
 }
 
-zarray_t *apriltag_quad_thresh(apriltag_detector_t *td, image_u8_t *im)
+// Finds quads in an already thresholded image (either from threshold() or
+// td->preprocess). Frees the threshim header.
+zarray_t *apriltag_quad_thresh_image(apriltag_detector_t *td, image_u8_t *im, image_u8_t *threshim)
 {
-    ////////////////////////////////////////////////////////
-    // step 1. threshold the image, creating the edge image.
-
     int w = im->width, h = im->height;
-
-    image_u8_t *threshim = threshold(td, im);
     int ts = threshim->stride;
 
     if (td->debug)
@@ -1938,7 +2039,7 @@ zarray_t *apriltag_quad_thresh(apriltag_detector_t *td, image_u8_t *im)
     }
 
 
-    image_u8_destroy(threshim);
+    free(threshim);
     timeprofile_stamp(td->tp, "make clusters");
 
     ////////////////////////////////////////////////////////
@@ -1986,7 +2087,7 @@ zarray_t *apriltag_quad_thresh(apriltag_detector_t *td, image_u8_t *im)
 
     timeprofile_stamp(td->tp, "fit quads to clusters");
 
-    unionfind_destroy(uf);
+    free(uf);
 
     for (int i = 0; i < zarray_size(clusters); i++) {
         zarray_t *cluster;
@@ -1997,3 +2098,13 @@ zarray_t *apriltag_quad_thresh(apriltag_detector_t *td, image_u8_t *im)
 
     return quads;
 }
+
+zarray_t *apriltag_quad_thresh(apriltag_detector_t *td, image_u8_t *im)
+{
+    ////////////////////////////////////////////////////////
+    // step 1. threshold the image, creating the edge image.
+
+    image_u8_t *threshim = threshold(td, im);
+
+    return apriltag_quad_thresh_image(td, im, threshim);
+}
@@ -30,6 +30,11 @@ either expressed or implied, of the Regents of The University of Michigan.
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
 #include "common/image_u8.h"
 #include "common/pnm.h"
@@ -438,12 +443,32 @@ image_u8_t *image_u8_rotate(const image_u8_t *in, double rad, uint8_t pad)
 
 image_u8_t *image_u8_decimate(image_u8_t *im, float ffactor)
 {
-    int width = im->width, height = im->height;
+    int swidth, sheight;
+    image_u8_decimate_size(im, ffactor, &swidth, &sheight);
+
+    image_u8_t *decim = image_u8_create(swidth, sheight);
+    image_u8_decimate_into(im, ffactor, decim);
+    return decim;
+}
 
+void image_u8_decimate_size(const image_u8_t *im, float ffactor, int *width, int *height)
+{
     if (ffactor == 1.5) {
-        int swidth = width / 3 * 2, sheight = height / 3 * 2;
+        *width = im->width / 3 * 2;
+        *height = im->height / 3 * 2;
+    } else {
+        int factor = (int) ffactor;
+        *width = 1 + (im->width - 1)/factor;
+        *height = 1 + (im->height - 1)/factor;
+    }
+}
+
+void image_u8_decimate_into(const image_u8_t *im, float ffactor, image_u8_t *decim)
+{
+    int width = im->width, height = im->height;
 
-        image_u8_t *decim = image_u8_create(swidth, sheight);
+    if (ffactor == 1.5) {
+        int swidth = decim->width, sheight = decim->height;
 
         int y = 0, sy = 0;
         while (sy < sheight) {
@@ -483,24 +508,44 @@ image_u8_t *image_u8_decimate(image_u8_t *im, float ffactor)
             sy += 2;
         }
 
-        return decim;
+        return;
     }
 
     int factor = (int) ffactor;
 
-    int swidth = 1 + (width - 1)/factor;
-    int sheight = 1 + (height - 1)/factor;
-    image_u8_t *decim = image_u8_create(swidth, sheight);
     int sy = 0;
     for (int y = 0; y < height; y += factor) {
-        int sx = 0;
-        for (int x = 0; x < width; x += factor) {
-            decim->buf[sy*decim->stride + sx] = im->buf[y*im->stride + x];
+        const uint8_t *src = &im->buf[y*im->stride];
+        uint8_t *dst = &decim->buf[sy*decim->stride];
+        int x = 0, sx = 0;
+
+        // Vectorized path for the default factor of 2: keep the even
+        // bytes of every 32 pixels.
+#if defined(__SSE2__)
+        if (factor == 2) {
+            const __m128i even = _mm_set1_epi16(0xff);
+            for (; x + 32 <= width; x += 32, sx += 16) {
+                __m128i a = _mm_loadu_si128((const __m128i *) &src[x]);
+                __m128i b = _mm_loadu_si128((const __m128i *) &src[x + 16]);
+                _mm_storeu_si128((__m128i *) &dst[sx],
+                                 _mm_packus_epi16(_mm_and_si128(a, even),
+                                                  _mm_and_si128(b, even)));
+            }
+        }
+#elif defined(__ARM_NEON)
+        if (factor == 2) {
+            for (; x + 32 <= width; x += 32, sx += 16) {
+                vst1q_u8(&dst[sx], vld2q_u8(&src[x]).val[0]);
+            }
+        }
+#endif
+
+        for (; x < width; x += factor) {
+            dst[sx] = src[x];
             sx++;
         }
         sy++;
     }
-    return decim;
 }
 
 void image_u8_fill_line_max(image_u8_t *im, const image_u8_lut_t *lut, const float *xy0, const float *xy1)
@@ -2,8 +2,15 @@
 // Open Source Software; you can modify and/or share it under the terms of
 // the WPILib BSD license file in the root directory of this project.
 
+#include <stdint.h>
+
+#include <algorithm>
+#include <vector>
+
 #include <gtest/gtest.h>
+#include <wpi/RawFrame.h>
 
+#include "frc/apriltag/AprilTag.h"
 #include "frc/apriltag/AprilTagDetector.h"
 
 using namespace frc;
@@ -61,3 +68,148 @@ TEST(AprilTagDetectorTest, RemoveFamily) {
   detector.AddFamily("tag16h5");
   detector.RemoveFamily("tag16h5");
 }
+
+namespace {
+
+constexpr int kWidth = 640;
+constexpr int kHeight = 480;
+
+/**
+ * Draws a 36h11 tag into a grayscale image, scaled up by an integer factor,
+ * with its top-left corner at (x, y).
+ */
+void DrawTag(std::vector<uint8_t>& image, int id, int x, int y, int scale) {
+  wpi::RawFrame frame;
+  ASSERT_TRUE(AprilTag::Generate36h11AprilTagImage(&frame, id));
+  for (int row = 0; row < frame.height * scale; ++row) {
+    for (int col = 0; col < frame.width * scale; ++col) {
+      image[(y + row) * kWidth + x + col] =
+          frame.data[(row / scale) * frame.stride + col / scale];
+    }
+  }
+}
+
+}  // namespace
+
+TEST(AprilTagDetectorTest, TrackingConfigDefaults) {
+  AprilTagDetector detector;
+  ASSERT_EQ(detector.GetTrackingConfig(), AprilTagDetector::TrackingConfig{});
+  ASSERT_FALSE(detector.GetTrackingConfig().enabled);
+}
+
+TEST(AprilTagDetectorTest, TrackingMatchesFullFrame) {
+  std::vector<uint8_t> image(kWidth * kHeight, 255);
+  DrawTag(image, 1, 100, 100, 10);
+  DrawTag(image, 2, 400, 250, 10);
+
+  AprilTagDetector fullDetector;
+  fullDetector.AddFamily("tag36h11");
+  auto expected = fullDetector.Detect(kWidth, kHeight, image.data());
+  ASSERT_EQ(2u, expected.size());
+
+  AprilTagDetector detector;
+  detector.AddFamily("tag36h11");
+  detector.SetTrackingConfig({.enabled = true});
+
+  // The first frame is a full scan, and the second only scans the regions
+  // around the tags
+  for (int frame = 0; frame < 2; ++frame) {
+    auto results = detector.Detect(kWidth, kHeight, image.data());
+    ASSERT_EQ(expected.size(), results.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      auto& actual = *results[i];
+      auto match = std::find_if(
+          expected.begin(), expected.end(),
+          [&](auto det) { return det->GetId() == actual.GetId(); });
+      ASSERT_NE(expected.end(), match);
+      for (int corner = 0; corner < 4; ++corner) {
+        EXPECT_NEAR((*match)->GetCorner(corner).x, actual.GetCorner(corner).x,
+                    0.5);
+        EXPECT_NEAR((*match)->GetCorner(corner).y, actual.GetCorner(corner).y,
+                    0.5);
+      }
+      auto expectedH = (*match)->GetHomographyMatrix();
+      auto actualH = actual.GetHomographyMatrix();
+      EXPECT_TRUE(expectedH.isApprox(actualH, 1e-2));
+    }
+  }
+}
+
+TEST(AprilTagDetectorTest, TrackingFollowsMovingTag) {
+  AprilTagDetector detector;
+  detector.AddFamily("tag36h11");
+  detector.SetTrackingConfig({.enabled = true});
+
+  for (int frame = 0; frame < 5; ++frame) {
+    std::vector<uint8_t> image(kWidth * kHeight, 255);
+    DrawTag(image, 3, 100 + 20 * frame, 100 + 10 * frame, 10);
+
+    auto results = detector.Detect(kWidth, kHeight, image.data());
+    ASSERT_EQ(1u, results.size());
+    EXPECT_EQ(3, results[0]->GetId());
+    EXPECT_NEAR(100 + 20 * frame + 50, results[0]->GetCenter().x, 1.0);
+    EXPECT_NEAR(100 + 10 * frame + 50, results[0]->GetCenter().y, 1.0);
+  }
+}
+
+TEST(AprilTagDetectorTest, TrackingPeriodicFullFrameScan) {
+  AprilTagDetector detector;
+  detector.AddFamily("tag36h11");
+  detector.SetTrackingConfig({.enabled = true, .fullFrameInterval = 3});
+
+  std::vector<uint8_t> image(kWidth * kHeight, 255);
+  DrawTag(image, 1, 100, 100, 10);
+  EXPECT_EQ(1u, detector.Detect(kWidth, kHeight, image.data()).size());
+
+  // A new tag outside the tracked region is only found on the next full scan
+  DrawTag(image, 2, 400, 250, 10);
+  EXPECT_EQ(1u, detector.Detect(kWidth, kHeight, image.data()).size());
+  EXPECT_EQ(1u, detector.Detect(kWidth, kHeight, image.data()).size());
+  EXPECT_EQ(2u, detector.Detect(kWidth, kHeight, image.data()).size());
+
+  // Resetting tracking forces a full scan
+  detector.ResetTracking();
+  DrawTag(image, 4, 400, 50, 10);
+  EXPECT_EQ(3u, detector.Detect(kWidth, kHeight, image.data()).size());
+}
+
+TEST(AprilTagDetectorTest, PreprocessFallback) {
+  std::vector<uint8_t> image(kWidth * kHeight, 255);
+  DrawTag(image, 1, 100, 100, 10);
+
+  AprilTagDetector detector;
+  detector.AddFamily("tag36h11");
+  int calls = 0;
+  detector.SetPreprocessFunction(
+      [&](const auto& input, const auto& quadImage, const auto& threshImage) {
+        ++calls;
+        EXPECT_EQ(kWidth, input.width);
+        EXPECT_EQ(kWidth / 2, quadImage.width);
+        EXPECT_EQ(kHeight / 2, threshImage.height);
+        return false;
+      });
+  ASSERT_EQ(1u, detector.Detect(kWidth, kHeight, image.data()).size());
+  EXPECT_EQ(1, calls);
+
+  detector.SetPreprocessFunction({});
+  ASSERT_EQ(1u, detector.Detect(kWidth, kHeight, image.data()).size());
+  EXPECT_EQ(1, calls);
+}
+
+TEST(AprilTagDetectorTest, PreprocessReplacesThreshold) {
+  std::vector<uint8_t> image(kWidth * kHeight, 255);
+  DrawTag(image, 1, 100, 100, 10);
+
+  // A threshold image with no contrast anywhere has no quads to find
+  AprilTagDetector detector;
+  detector.AddFamily("tag36h11");
+  detector.SetPreprocessFunction(
+      [](const auto&, const auto&, const auto& threshImage) {
+        for (int y = 0; y < threshImage.height; ++y) {
+          std::fill_n(threshImage.buf + y * threshImage.stride,
+                      threshImage.width, 127);
+        }
+        return true;
+      });
+  EXPECT_EQ(0u, detector.Detect(kWidth, kHeight, image.data()).size());
+}
@@ -0,0 +1,174 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <array>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "frc/apriltag/AprilTag.h"
+#include "frc/apriltag/AprilTagFieldLayout.h"
+#include "frc/apriltag/AprilTagPoseEstimator.h"
+#include "frc/geometry/Pose3d.h"
+
+using namespace frc;
+
+namespace {
+
+constexpr AprilTagPoseEstimator::Config kConfig{0.1651_m, 600, 600, 320, 240};
+
+AprilTagFieldLayout MakeLayout() {
+  // Tags on the far wall and a side wall, all facing into the field
+  return AprilTagFieldLayout{
+      std::vector<AprilTag>{
+          AprilTag{1,
+                   Pose3d{8_m, 3_m, 0.5_m, Rotation3d{0_deg, 0_deg, 180_deg}}},
+          AprilTag{2,
+                   Pose3d{8_m, 4_m, 1_m, Rotation3d{0_deg, 0_deg, 180_deg}}},
+          AprilTag{3,
+                   Pose3d{8_m, 5_m, 0.5_m, Rotation3d{0_deg, 0_deg, 180_deg}}},
+          AprilTag{4, Pose3d{6_m, 7_m, 0.75_m,
+                             Rotation3d{0_deg, 0_deg, -90_deg}}}},
+      16_m, 8_m};
+}
+
+// Projects a tag's corners into the image of a camera at the given field pose.
+// Corners are counterclockwise from the bottom left, as seen facing the tag.
+std::array<double, 8> ProjectCorners(const Pose3d& tagPose,
+                                     const Pose3d& cameraPose) {
+  auto half = kConfig.tagSize / 2;
+  const Translation3d offsets[4] = {{0_m, -half, -half},
+                                    {0_m, half, -half},
+                                    {0_m, half, half},
+                                    {0_m, -half, half}};
+
+  std::array<double, 8> corners;
+  for (int i = 0; i < 4; ++i) {
+    auto corner = tagPose.TransformBy(Transform3d{offsets[i], Rotation3d{}})
+                      .RelativeTo(cameraPose)
+                      .Translation();
+    corners[2 * i] = kConfig.cx - kConfig.fx * corner.Y() / corner.X();
+    corners[2 * i + 1] = kConfig.cy - kConfig.fy * corner.Z() / corner.X();
+  }
+  return corners;
+}
+
+void ExpectPoseNear(const Pose3d& expected, const Pose3d& actual,
+                    double tolerance) {
+  EXPECT_NEAR(expected.X().value(), actual.X().value(), tolerance);
+  EXPECT_NEAR(expected.Y().value(), actual.Y().value(), tolerance);
+  EXPECT_NEAR(expected.Z().value(), actual.Z().value(), tolerance);
+  EXPECT_NEAR(0.0, (actual.Rotation() - expected.Rotation()).Angle().value(),
+              tolerance);
+}
+
+}  // namespace
+
+TEST(AprilTagPoseEstimatorTest, MultiTagRecoversCameraPose) {
+  auto layout = MakeLayout();
+  AprilTagPoseEstimator estimator{kConfig};
+
+  Pose3d cameraPose{4_m, 4.5_m, 0.6_m, Rotation3d{2_deg, -5_deg, 20_deg}};
+
+  std::vector<int> ids{1, 2, 3, 4};
+  std::vector<std::array<double, 8>> corners;
+  for (int id : ids) {
+    corners.push_back(ProjectCorners(*layout.GetTagPose(id), cameraPose));
+  }
+
+  auto estimate = estimator.EstimateMultiTag(ids, corners, layout);
+  ASSERT_TRUE(estimate);
+  EXPECT_EQ(4, estimate->numTags);
+  EXPECT_NEAR(0.0, estimate->error, 1e-6);
+  ExpectPoseNear(cameraPose, estimate->fieldToCamera, 1e-6);
+}
+
+TEST(AprilTagPoseEstimatorTest, MultiTagSingleTag) {
+  auto layout = MakeLayout();
+  AprilTagPoseEstimator estimator{kConfig};
+
+  Pose3d cameraPose{6_m, 3.5_m, 0.4_m, Rotation3d{0_deg, 0_deg, -10_deg}};
+
+  std::vector<int> ids{1};
+  std::vector<std::array<double, 8>> corners{
+      ProjectCorners(*layout.GetTagPose(1), cameraPose)};
+
+  auto estimate = estimator.EstimateMultiTag(ids, corners, layout);
+  ASSERT_TRUE(estimate);
+  EXPECT_EQ(1, estimate->numTags);
+  ExpectPoseNear(cameraPose, estimate->fieldToCamera, 1e-4);
+}
+
+TEST(AprilTagPoseEstimatorTest, MultiTagNoisyCorners) {
+  auto layout = MakeLayout();
+  AprilTagPoseEstimator estimator{kConfig};
+
+  Pose3d cameraPose{3_m, 4_m, 0.5_m, Rotation3d{0_deg, 0_deg, 15_deg}};
+
+  std::mt19937 gen{42};
+  std::normal_distribution<> noise{0.0, 0.5};
+
+  std::vector<int> ids{1, 2, 3, 4};
+  std::vector<std::array<double, 8>> corners;
+  for (int id : ids) {
+    auto tagCorners = ProjectCorners(*layout.GetTagPose(id), cameraPose);
+    for (auto& corner : tagCorners) {
+      corner += noise(gen);
+    }
+    corners.push_back(tagCorners);
+  }
+
+  auto estimate = estimator.EstimateMultiTag(ids, corners, layout);
+  ASSERT_TRUE(estimate);
+  EXPECT_LT(estimate->error, 1.0);
+  ExpectPoseNear(cameraPose, estimate->fieldToCamera, 0.05);
+}
+
+TEST(AprilTagPoseEstimatorTest, MultiTagInitialGuess) {
+  auto layout = MakeLayout();
+  AprilTagPoseEstimator estimator{kConfig};
+
+  Pose3d cameraPose{4_m, 4.5_m, 0.6_m, Rotation3d{0_deg, 0_deg, 5_deg}};
+
+  std::vector<int> ids{1, 2, 3};
+  std::vector<std::array<double, 8>> corners;
+  for (int id : ids) {
+    corners.push_back(ProjectCorners(*layout.GetTagPose(id), cameraPose));
+  }
+
+  // A guess like the previous frame's estimate converges in a few iterations
+  Pose3d guess{4.1_m, 4.4_m, 0.6_m, Rotation3d{0_deg, 0_deg, 8_deg}};
+  auto estimate = estimator.EstimateMultiTag(ids, corners, layout, guess, 5);
+  ASSERT_TRUE(estimate);
+  EXPECT_EQ(3, estimate->numTags);
+  ExpectPoseNear(cameraPose, estimate->fieldToCamera, 1e-4);
+}
+
+TEST(AprilTagPoseEstimatorTest, MultiTagUnknownTags) {
+  auto layout = MakeLayout();
+  AprilTagPoseEstimator estimator{kConfig};
+
+  Pose3d cameraPose{4_m, 4.5_m, 0.6_m, Rotation3d{0_deg, 0_deg, 0_deg}};
+  auto tag2Corners = ProjectCorners(*layout.GetTagPose(2), cameraPose);
+
+  std::vector<int> unknownIds{7};
+  std::vector<std::array<double, 8>> unknownCorners{tag2Corners};
+  EXPECT_FALSE(estimator.EstimateMultiTag(unknownIds, unknownCorners, layout));
+
+  // Tags that aren't in the layout are ignored
+  std::vector<int> ids{7, 2};
+  std::vector<std::array<double, 8>> corners{
+      std::array<double, 8>{0, 0, 10, 0, 10, 10, 0, 10}, tag2Corners};
+  auto estimate = estimator.EstimateMultiTag(ids, corners, layout);
+  ASSERT_TRUE(estimate);
+  EXPECT_EQ(1, estimate->numTags);
+  ExpectPoseNear(cameraPose, estimate->fieldToCamera, 1e-4);
+
+  std::vector<int> mismatchedIds{1, 2};
+  EXPECT_THROW(
+      estimator.EstimateMultiTag(mismatchedIds, unknownCorners, layout),
+      std::invalid_argument);
+}
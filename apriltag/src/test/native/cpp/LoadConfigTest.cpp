@@ -2,6 +2,8 @@
 // Open Source Software; you can modify and/or share it under the terms of
 // the WPILib BSD license file in the root directory of this project.
 
+#include <filesystem>
+#include <string>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -59,6 +61,21 @@ TEST_P(AllFieldsFixtureTest, CheckEntireEnum) {
   EXPECT_NO_THROW(AprilTagFieldLayout::LoadField(field));
 }
 
+TEST_P(AllFieldsFixtureTest, BinaryRoundTrip) {
+  auto layout = AprilTagFieldLayout::LoadField(GetParam());
+  std::string path =
+      (std::filesystem::temp_directory_path() /
+       ("apriltag_layout_" +
+        std::to_string(static_cast<int>(GetParam())) + ".bin"))
+          .string();
+
+  layout.SerializeBinary(path);
+  AprilTagFieldLayout deserialized{path};
+  std::filesystem::remove(path);
+
+  EXPECT_EQ(layout, deserialized);
+}
+
 INSTANTIATE_TEST_SUITE_P(ValuesEnumTestInstTests, AllFieldsFixtureTest,
                          ::testing::ValuesIn(GetAllFields()));
 
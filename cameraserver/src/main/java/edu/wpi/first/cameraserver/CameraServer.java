@@ -593,6 +593,10 @@ public final class CameraServer {
   /**
    * Start automatically capturing images to send to the dashboard from an existing camera.
    *
+   * <p>The camera only streams while a dashboard is viewing it. To also close a USB camera while no
+   * dashboard is viewing it, set its connection strategy to {@link
+   * VideoSource.ConnectionStrategy#kOnDemand}; its settings are restored when it is reopened.
+   *
    * @param camera Camera
    * @return The MJPEG server serving images from the given camera.
    */
@@ -4,6 +4,7 @@
 
 #include "cameraserver/CameraServer.h"
 
+#include <array>
 #include <atomic>
 #include <memory>
 #include <string>
@@ -12,6 +13,7 @@
 
 #include <fmt/format.h>
 #include <networktables/BooleanTopic.h>
+#include <networktables/DoubleArrayTopic.h>
 #include <networktables/IntegerTopic.h>
 #include <networktables/NetworkTable.h>
 #include <networktables/NetworkTableInstance.h>
@@ -62,6 +64,9 @@ struct SourcePublisher {
   nt::StringEntry modeEntry;
   nt::StringArrayPublisher modesPublisher;
   wpi::DenseMap<CS_Property, PropertyPublisher> properties;
+  std::array<nt::DoubleArrayPublisher, 6> latencyPublishers;
+
+  void UpdateLatency(CS_Source source);
 };
 
 struct Instance {
@@ -372,6 +377,33 @@ SourcePublisher::SourcePublisher(Instance& inst,
   modesPublisher.Set(GetSourceModeValues(source));
 }
 
+void SourcePublisher::UpdateLatency(CS_Source source) {
+  static constexpr std::array<const char*, 6> kStageNames{
+      "capture", "delivery", "convert", "encode", "send", "total"};
+  for (size_t i = 0; i < kStageNames.size(); ++i) {
+    CS_Status status = 0;
+    auto latency = cs::GetTelemetryLatency(
+        source, static_cast<CS_LatencyStage>(i), &status);
+    if (status != 0 || latency.count == 0) {
+      continue;
+    }
+    auto& publisher = latencyPublishers[i];
+    if (!publisher) {
+      publisher = table->GetDoubleArrayTopic(
+                           fmt::format("Latency/{}", kStageNames[i]))
+                      .Publish();
+    }
+    std::array<double, 5> values{latency.GetMean(), latency.GetPercentile(50),
+                                 latency.GetPercentile(90),
+                                 latency.GetPercentile(99),
+                                 static_cast<double>(latency.max)};
+    for (auto&& value : values) {
+      value /= 1000.0;  // to ms
+    }
+    publisher.Set(values);
+  }
+}
+
 Instance::Instance() {
   // We publish sources to NetworkTables using the following structure:
   // "/CameraPublisher/{Source.Name}/" - root
@@ -383,6 +415,9 @@ Instance::Instance() {
   // - "modes" (string array): Available video modes
   // - "Property/{Property}" - Property values
   // - "PropertyInfo/{Property}" - Property supporting information
+  // - "Latency/{Stage}" (double array): Frame pipeline latency in ms (mean,
+  //   50th, 90th and 99th percentiles, max); only published while cscore
+  //   telemetry is enabled
 
   // Listener for video events
   m_videoListener = cs::VideoListener{
@@ -463,11 +498,16 @@ Instance::Instance() {
             m_addresses = cs::GetNetworkInterfaces();
             UpdateStreamValues();
             break;
+          case cs::VideoEvent::kTelemetryUpdated:
+            for (auto&& publisher : m_publishers) {
+              publisher.second.UpdateLatency(publisher.first);
+            }
+            break;
           default:
             break;
         }
       },
-      0x4fff, true};
+      0x4fff | CS_TELEMETRY_UPDATED, true};
 }
 
 cs::UsbCamera CameraServer::StartAutomaticCapture() {
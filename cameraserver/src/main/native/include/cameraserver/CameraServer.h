@@ -71,6 +71,11 @@ class CameraServer {
    * Start automatically capturing images to send to the dashboard from
    * an existing camera.
    *
+   * The camera only streams while a dashboard is viewing it. To also close a
+   * USB camera while no dashboard is viewing it, set its connection strategy
+   * to cs::VideoSource::kConnectionOnDemand; its settings are restored when it
+   * is reopened.
+   *
    * @param camera Camera
    */
   static cs::MjpegServer StartAutomaticCapture(const cs::VideoSource& camera);
@@ -0,0 +1,450 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+// Benchmark for cscore's frame conversion and MJPEG streaming paths.
+// Synthetic frames are put on a RawSource and grabbed from a RawSink in each
+// pixel format the conversion code supports (CvSource and CvSink are thin
+// wrappers over these), and streamed from an MjpegServer to a client over
+// loopback.  For each case and resolution, reports frames per second, the
+// mean and 99th percentile put-to-receive latency, and heap allocations per
+// frame (counted by replacing the global operator new).
+//
+// Usage: cscoreBenchmark [--quick] [--port N] [filter]
+//
+// Only cases whose name contains the filter are run.  --quick runs fewer
+// frames at fewer resolutions.
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+#include <wpi/Logger.h>
+#include <wpi/RawFrame.h>
+#include <wpi/StringExtras.h>
+#include <wpi/print.h>
+#include <wpi/timestamp.h>
+#include <wpinet/NetworkStream.h>
+#include <wpinet/TCPConnector.h>
+
+#include "cscore.h"
+#include "cscore_raw.h"
+
+static std::atomic<uint64_t> gAllocations{0};
+
+void* operator new(size_t size) {
+  gAllocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+  std::free(p);
+}
+
+namespace {
+
+using PixelFormat = cs::VideoMode::PixelFormat;
+
+struct Resolution {
+  int width;
+  int height;
+};
+
+constexpr Resolution kFullResolutions[] = {
+    {320, 240}, {640, 480}, {1280, 720}, {1920, 1080}};
+constexpr Resolution kQuickResolutions[] = {{320, 240}, {640, 480}};
+
+constexpr int kFullFrames = 200;
+constexpr int kQuickFrames = 30;
+
+struct Conversion {
+  PixelFormat from;
+  PixelFormat to;
+};
+
+// Same-format grabs are the baseline for the cost of passing a frame from
+// source to sink
+constexpr Conversion kConversions[] = {
+    {PixelFormat::kBGR, PixelFormat::kBGR},
+    {PixelFormat::kGray, PixelFormat::kGray},
+    {PixelFormat::kYUYV, PixelFormat::kBGR},
+    {PixelFormat::kYUYV, PixelFormat::kGray},
+    {PixelFormat::kUYVY, PixelFormat::kBGR},
+    {PixelFormat::kUYVY, PixelFormat::kGray},
+    {PixelFormat::kBGR, PixelFormat::kGray},
+    {PixelFormat::kGray, PixelFormat::kBGR},
+    {PixelFormat::kBGR, PixelFormat::kRGB565},
+    {PixelFormat::kRGB565, PixelFormat::kBGR},
+    {PixelFormat::kBGR, PixelFormat::kBGRA},
+    {PixelFormat::kGray, PixelFormat::kY16},
+    {PixelFormat::kY16, PixelFormat::kGray},
+    {PixelFormat::kBGR, PixelFormat::kMJPEG},
+    {PixelFormat::kGray, PixelFormat::kMJPEG},
+    {PixelFormat::kMJPEG, PixelFormat::kBGR},
+    {PixelFormat::kMJPEG, PixelFormat::kGray},
+};
+
+std::string_view GetFormatName(PixelFormat pixelFormat) {
+  switch (pixelFormat) {
+    case PixelFormat::kMJPEG:
+      return "MJPEG";
+    case PixelFormat::kYUYV:
+      return "YUYV";
+    case PixelFormat::kRGB565:
+      return "RGB565";
+    case PixelFormat::kBGR:
+      return "BGR";
+    case PixelFormat::kGray:
+      return "Gray";
+    case PixelFormat::kY16:
+      return "Y16";
+    case PixelFormat::kUYVY:
+      return "UYVY";
+    case PixelFormat::kBGRA:
+      return "BGRA";
+    default:
+      return "Unknown";
+  }
+}
+
+struct Result {
+  int frames = 0;
+  double elapsed = 0;
+  uint64_t allocations = 0;
+  std::vector<int64_t> latencies;
+};
+
+void PrintHeader() {
+  wpi::print("{:<24} {:>10} {:>10} {:>12} {:>12} {:>12}\n", "case",
+             "resolution", "frames/s", "mean lat us", "p99 lat us",
+             "allocs/frame");
+}
+
+void PrintResult(std::string_view name, const Resolution& res,
+                 Result& result) {
+  if (result.frames == 0 || result.latencies.empty()) {
+    wpi::print("{:<24} {:>10} no frames received\n", name,
+               fmt::format("{}x{}", res.width, res.height));
+    return;
+  }
+  std::sort(result.latencies.begin(), result.latencies.end());
+  double mean = 0;
+  for (auto latency : result.latencies) {
+    mean += latency;
+  }
+  mean /= result.latencies.size();
+  auto p99 = result.latencies[(result.latencies.size() - 1) * 99 / 100];
+  wpi::print("{:<24} {:>10} {:>10.1f} {:>12.1f} {:>12} {:>12.1f}\n", name,
+             fmt::format("{}x{}", res.width, res.height),
+             result.frames / result.elapsed, mean, p99,
+             static_cast<double>(result.allocations) / result.frames);
+}
+
+// Fills an uncompressed frame with a moving gradient, so compression and
+// conversion see realistic rather than constant data
+void FillFrame(WPI_RawFrame& frame, int frameNum) {
+  for (int y = 0; y < frame.height; ++y) {
+    uint8_t* row = frame.data + static_cast<size_t>(y) * frame.stride;
+    for (int x = 0; x < frame.stride; ++x) {
+      row[x] = static_cast<uint8_t>(x / 4 + y + frameNum);
+    }
+  }
+}
+
+// Puts a frame on the source without a copy.  Compressed frames are copied
+// from jpeg.
+void PutFrame(CS_Source source, PixelFormat pixelFormat,
+              const Resolution& res, int frameNum, std::string_view jpeg) {
+  wpi::RawFrame frame;
+  frame.pixelFormat = pixelFormat;
+  frame.width = res.width;
+  frame.height = res.height;
+  frame.size = jpeg.size();
+  CS_Status status = 0;
+  cs::AllocSourceFrame(source, frame, &status);
+  if (pixelFormat == PixelFormat::kMJPEG) {
+    std::memcpy(frame.data, jpeg.data(), jpeg.size());
+  } else {
+    FillFrame(frame, frameNum);
+  }
+  cs::CommitSourceFrame(source, frame, &status);
+}
+
+// Encodes a synthetic BGR frame through cscore's own JPEG encoder, for use as
+// the content of MJPEG source frames
+std::string MakeJpeg(const Resolution& res) {
+  CS_Status status = 0;
+  cs::RawSource source{"jpegsource", PixelFormat::kBGR, res.width, res.height,
+                       30};
+  cs::RawSink sink{"jpegsink"};
+  sink.SetSource(source);
+  PutFrame(source.GetHandle(), PixelFormat::kBGR, res, 0, {});
+  wpi::RawFrame frame;
+  frame.pixelFormat = PixelFormat::kMJPEG;
+  if (cs::GrabSinkFrameTimeout(sink.GetHandle(), frame, 1.0, &status) == 0) {
+    return {};
+  }
+  return std::string{reinterpret_cast<const char*>(frame.data), frame.size};
+}
+
+Result RunConversion(const Conversion& conv, const Resolution& res,
+                     int numFrames) {
+  Result result;
+  std::string jpeg;
+  if (conv.from == PixelFormat::kMJPEG) {
+    jpeg = MakeJpeg(res);
+    if (jpeg.empty()) {
+      return result;
+    }
+  }
+
+  CS_Status status = 0;
+  cs::RawSource source{"source", conv.from, res.width, res.height, 30};
+  cs::RawSink sink{"sink"};
+  sink.SetSource(source);
+
+  wpi::RawFrame frame;
+  uint64_t lastTime = 0;
+  auto grab = [&](int frameNum) -> bool {
+    PutFrame(source.GetHandle(), conv.from, res, frameNum, jpeg);
+    frame.pixelFormat = conv.to;
+    frame.width = res.width;
+    frame.height = res.height;
+    lastTime = cs::GrabSinkFrameTimeoutLastTime(sink.GetHandle(), frame, 1.0,
+                                                lastTime, &status);
+    if (lastTime == 0) {
+      return false;
+    }
+    result.latencies.push_back(wpi::Now() - lastTime);
+    return true;
+  };
+
+  // warm up image pools and conversion buffers
+  for (int i = 0; i < 3; ++i) {
+    if (!grab(i)) {
+      return result;
+    }
+  }
+  result.latencies.clear();
+
+  uint64_t allocations = gAllocations.load(std::memory_order_relaxed);
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < numFrames; ++i) {
+    if (!grab(i)) {
+      break;
+    }
+    ++result.frames;
+  }
+  result.elapsed = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  result.allocations =
+      gAllocations.load(std::memory_order_relaxed) - allocations;
+  return result;
+}
+
+// Minimal client for an MjpegServer stream
+class MjpegClient {
+ public:
+  explicit MjpegClient(std::unique_ptr<wpi::NetworkStream> stream)
+      : m_stream{std::move(stream)} {}
+
+  bool Start() {
+    std::string_view request = "GET /stream.mjpg HTTP/1.0\r\n\r\n";
+    wpi::NetworkStream::Error err;
+    return m_stream->send(request.data(), request.size(), &err) ==
+           request.size();
+  }
+
+  // Reads the next JPEG image and returns its frame timestamp in wpi::Now()
+  // microseconds, or 0 on error
+  int64_t ReadFrame() {
+    int64_t timestamp = 0;
+    size_t length = 0;
+    bool haveLength = false;
+    for (;;) {
+      auto line = ReadLine();
+      if (!line) {
+        return 0;
+      }
+      if (line->empty()) {
+        if (haveLength) {
+          break;
+        }
+        continue;  // blank line before boundary
+      }
+      if (wpi::starts_with(*line, "Content-Length: ")) {
+        length =
+            wpi::parse_integer<size_t>(line->substr(16), 10).value_or(0);
+        haveLength = true;
+      } else if (wpi::starts_with(*line, "X-Timestamp: ")) {
+        timestamp = static_cast<int64_t>(
+            wpi::parse_float<double>(line->substr(13)).value_or(0) * 1e6);
+      }
+    }
+    if (!Fill(length)) {
+      return 0;
+    }
+    m_buf.erase(0, length);
+    return timestamp;
+  }
+
+ private:
+  std::optional<std::string> ReadLine() {
+    for (;;) {
+      auto pos = m_buf.find("\r\n");
+      if (pos != std::string::npos) {
+        std::string line = m_buf.substr(0, pos);
+        m_buf.erase(0, pos + 2);
+        return line;
+      }
+      if (!Fill(m_buf.size() + 1)) {
+        return std::nullopt;
+      }
+    }
+  }
+
+  bool Fill(size_t size) {
+    char buf[16384];
+    while (m_buf.size() < size) {
+      wpi::NetworkStream::Error err;
+      size_t len = m_stream->receive(buf, sizeof(buf), &err, 5);
+      if (len == 0) {
+        return false;
+      }
+      m_buf.append(buf, len);
+    }
+    return true;
+  }
+
+  std::unique_ptr<wpi::NetworkStream> m_stream;
+  std::string m_buf;
+};
+
+Result RunMjpegServer(PixelFormat pixelFormat, const Resolution& res,
+                      int numFrames, int port, wpi::Logger& logger) {
+  Result result;
+  std::string jpeg;
+  if (pixelFormat == PixelFormat::kMJPEG) {
+    jpeg = MakeJpeg(res);
+    if (jpeg.empty()) {
+      return result;
+    }
+  }
+
+  cs::RawSource source{"source", pixelFormat, res.width, res.height, 30};
+  cs::MjpegServer server{"server", "127.0.0.1", port};
+  server.SetSource(source);
+
+  auto stream = wpi::TCPConnector::connect("127.0.0.1", port, logger, 1);
+  if (!stream) {
+    return result;
+  }
+  MjpegClient client{std::move(stream)};
+  if (!client.Start()) {
+    return result;
+  }
+
+  auto receive = [&](int frameNum) -> bool {
+    PutFrame(source.GetHandle(), pixelFormat, res, frameNum, jpeg);
+    int64_t timestamp = client.ReadFrame();
+    if (timestamp == 0) {
+      return false;
+    }
+    result.latencies.push_back(wpi::Now() - timestamp);
+    return true;
+  };
+
+  for (int i = 0; i < 3; ++i) {
+    if (!receive(i)) {
+      return result;
+    }
+  }
+  result.latencies.clear();
+
+  uint64_t allocations = gAllocations.load(std::memory_order_relaxed);
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < numFrames; ++i) {
+    if (!receive(i)) {
+      break;
+    }
+    ++result.frames;
+  }
+  result.elapsed = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  result.allocations =
+      gAllocations.load(std::memory_order_relaxed) - allocations;
+  return result;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  bool quick = false;
+  int port = 1190;
+  std::string_view filter;
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg = argv[i];
+    if (arg == "--quick") {
+      quick = true;
+    } else if (arg == "--port" && i + 1 < argc) {
+      port = wpi::parse_integer<int>(argv[++i], 10).value_or(port);
+    } else {
+      filter = arg;
+    }
+  }
+
+  std::span<const Resolution> resolutions =
+      quick ? std::span<const Resolution>{kQuickResolutions}
+            : std::span<const Resolution>{kFullResolutions};
+  int numFrames = quick ? kQuickFrames : kFullFrames;
+  wpi::Logger logger;
+
+  PrintHeader();
+  for (auto&& conv : kConversions) {
+    auto name = fmt::format("{}->{}", GetFormatName(conv.from),
+                            GetFormatName(conv.to));
+    if (name.find(filter) == std::string::npos) {
+      continue;
+    }
+    for (auto&& res : resolutions) {
+      auto result = RunConversion(conv, res, numFrames);
+      PrintResult(name, res, result);
+    }
+  }
+
+  // the server encodes uncompressed sources and passes MJPEG through
+  for (auto pixelFormat :
+       {PixelFormat::kBGR, PixelFormat::kYUYV, PixelFormat::kMJPEG}) {
+    auto name = fmt::format("MjpegServer({})", GetFormatName(pixelFormat));
+    if (name.find(filter) == std::string::npos) {
+      continue;
+    }
+    for (auto&& res : resolutions) {
+      auto result = RunMjpegServer(pixelFormat, res, numFrames, port++, logger);
+      PrintResult(name, res, result);
+    }
+  }
+
+  cs::Shutdown();
+}
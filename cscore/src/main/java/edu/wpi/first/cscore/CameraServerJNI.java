@@ -784,6 +784,28 @@ public class CameraServerJNI {
   public static native long grabRawSinkFrameTimeout(
       int sink, RawFrame frame, long nativeObj, double timeout);
 
+  /**
+   * Borrows the next raw sink frame without copying it. The frame data points directly at the
+   * image in the source's pool until released with releaseRawSinkFrame().
+   *
+   * @param sink Sink handle.
+   * @param frame Raw frame.
+   * @param nativeObj Native object.
+   * @param timeout Timeout in seconds.
+   * @param lastFrameTime Time of the last frame, or 0 to wait for a new frame.
+   * @return Frame time, or 0 on error.
+   */
+  public static native long borrowRawSinkFrame(
+      int sink, RawFrame frame, long nativeObj, double timeout, long lastFrameTime);
+
+  /**
+   * Releases frame data borrowed with borrowRawSinkFrame().
+   *
+   * @param frame Raw frame.
+   * @param nativeObj Native object.
+   */
+  public static native void releaseRawSinkFrame(RawFrame frame, long nativeObj);
+
   /**
    * Returns sink error message.
    *
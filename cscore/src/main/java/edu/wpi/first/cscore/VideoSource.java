@@ -54,7 +54,14 @@ public class VideoSource implements AutoCloseable {
     /**
      * Never open the connection. If this is set when the connection is open, close the connection.
      */
-    kForceClose(2);
+    kForceClose(2),
+
+    /**
+     * Like kAutoManage, but also close the device after no sinks have been enabled for a short
+     * time. The device configuration is cached and restored when a sink is enabled again. Only USB
+     * cameras on Linux close the device; other sources behave as kAutoManage.
+     */
+    kOnDemand(3);
 
     private final int value;
 
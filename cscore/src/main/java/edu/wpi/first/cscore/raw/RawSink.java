@@ -61,4 +61,33 @@ public class RawSink extends ImageSink {
   public long grabFrameNoTimeout(RawFrame frame) {
     return CameraServerJNI.grabRawSinkFrame(m_handle, frame, frame.getNativeObj());
   }
+
+  /**
+   * Wait for the next frame and borrow its image without copying it. Times out (returning 0) after
+   * timeout seconds. The frame's data ByteBuffer points directly at the image in the source's
+   * pool; the frame's pixel format (if set) selects the image format.
+   *
+   * <p>The image is held until releaseFrame() is called or another frame is grabbed or borrowed
+   * into the same frame object. The data must not be accessed after it is released.
+   *
+   * @param frame The frame object to point at the image.
+   * @param timeout The frame timeout in seconds.
+   * @param lastFrameTime Time of the last frame; if non-zero, the first frame with a different
+   *     time is borrowed, otherwise this waits for a new frame.
+   * @return Frame time, or 0 on error (call getError() to obtain the error message); the frame time
+   *     is in the same time base as wpi::Now(), and is in 1 us increments.
+   */
+  public long borrowFrame(RawFrame frame, double timeout, long lastFrameTime) {
+    return CameraServerJNI.borrowRawSinkFrame(
+        m_handle, frame, frame.getNativeObj(), timeout, lastFrameTime);
+  }
+
+  /**
+   * Releases an image borrowed with borrowFrame(), returning it to the source's pool.
+   *
+   * @param frame The frame object passed to borrowFrame().
+   */
+  public void releaseFrame(RawFrame frame) {
+    CameraServerJNI.releaseRawSinkFrame(frame, frame.getNativeObj());
+  }
 }
@@ -0,0 +1,459 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "ColorConvert.h"
+
+#include <stddef.h>
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CSCORE_COLOR_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define CSCORE_COLOR_NEON
+#include <arm_neon.h>
+#endif
+
+using namespace cs;
+
+// BT.601 limited range YUV to RGB coefficients, with 6 fractional bits.  The
+// SIMD kernels use the same 16-bit arithmetic, so every path produces
+// identical results.
+static constexpr int kYG = 75;
+static constexpr int kUB = 129;
+static constexpr int kUG = 25;
+static constexpr int kVG = 52;
+static constexpr int kVR = 102;
+
+// BGR to gray weights, with 8 fractional bits
+static constexpr int kGrayB = 29;
+static constexpr int kGrayG = 150;
+static constexpr int kGrayR = 77;
+
+static inline uint8_t Clamp8(int v) {
+  return std::clamp(v, 0, 255);
+}
+
+static inline void YUVToBGR(int y, int u, int v, uint8_t* bgr) {
+  int yy = (y - 16) * kYG + 32;
+  u -= 128;
+  v -= 128;
+  bgr[0] = Clamp8((yy + kUB * u) >> 6);
+  bgr[1] = Clamp8((yy - kUG * u - kVG * v) >> 6);
+  bgr[2] = Clamp8((yy + kVR * v) >> 6);
+}
+
+#ifdef CSCORE_COLOR_SSE2
+static inline __m128i Load(const void* p) {
+  return _mm_loadu_si128(static_cast<const __m128i*>(p));
+}
+
+static inline void Store(void* p, __m128i v) {
+  _mm_storeu_si128(static_cast<__m128i*>(p), v);
+}
+
+// Converts 8 pixels of 16-bit Y, U, and V (U and V centered on 0) to 16-bit
+// B, G, and R.  Only the B sum can overflow; saturating it doesn't change the
+// clamped result.
+static inline void YUVToBGR8(__m128i y, __m128i u, __m128i v, __m128i* b,
+                             __m128i* g, __m128i* r) {
+  __m128i yy = _mm_add_epi16(
+      _mm_mullo_epi16(_mm_sub_epi16(y, _mm_set1_epi16(16)),
+                      _mm_set1_epi16(kYG)),
+      _mm_set1_epi16(32));
+  *b = _mm_srai_epi16(
+      _mm_adds_epi16(yy, _mm_mullo_epi16(u, _mm_set1_epi16(kUB))), 6);
+  *g = _mm_srai_epi16(
+      _mm_sub_epi16(
+          _mm_sub_epi16(yy, _mm_mullo_epi16(u, _mm_set1_epi16(kUG))),
+          _mm_mullo_epi16(v, _mm_set1_epi16(kVG))),
+      6);
+  *r = _mm_srai_epi16(
+      _mm_add_epi16(yy, _mm_mullo_epi16(v, _mm_set1_epi16(kVR))), 6);
+}
+
+// Packs 4 pixels of BGRx into the low 12 bytes
+static inline __m128i PackBGRx(__m128i x) {
+  __m128i y = _mm_or_si128(
+      _mm_and_si128(x, _mm_set1_epi64x(0xffffff)),
+      _mm_and_si128(_mm_srli_epi64(x, 8), _mm_set1_epi64x(0xffffff000000)));
+  return _mm_or_si128(_mm_move_epi64(y),
+                      _mm_slli_si128(_mm_srli_si128(y, 8), 6));
+}
+
+// Stores 16 pixels of B, G, and R as 48 bytes of BGR.  This writes 4 bytes
+// past the end of the pixels, which the caller must allow for.
+static inline void StoreBGR16(uint8_t* dst, __m128i b, __m128i g, __m128i r) {
+  __m128i zero = _mm_setzero_si128();
+  __m128i bgLo = _mm_unpacklo_epi8(b, g);
+  __m128i bgHi = _mm_unpackhi_epi8(b, g);
+  __m128i rLo = _mm_unpacklo_epi8(r, zero);
+  __m128i rHi = _mm_unpackhi_epi8(r, zero);
+  Store(dst, PackBGRx(_mm_unpacklo_epi16(bgLo, rLo)));
+  Store(dst + 12, PackBGRx(_mm_unpackhi_epi16(bgLo, rLo)));
+  Store(dst + 24, PackBGRx(_mm_unpacklo_epi16(bgHi, rHi)));
+  Store(dst + 36, PackBGRx(_mm_unpackhi_epi16(bgHi, rHi)));
+}
+#endif
+
+#ifdef CSCORE_COLOR_NEON
+static inline uint8x8x3_t YUVToBGR8(uint8x8_t y, uint8x8_t u, uint8x8_t v) {
+  int16x8_t yy = vaddq_s16(
+      vmulq_n_s16(
+          vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(y)), vdupq_n_s16(16)),
+          kYG),
+      vdupq_n_s16(32));
+  int16x8_t uu =
+      vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(u)), vdupq_n_s16(128));
+  int16x8_t vv =
+      vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(v)), vdupq_n_s16(128));
+  uint8x8x3_t out;
+  out.val[0] = vqshrun_n_s16(vqaddq_s16(yy, vmulq_n_s16(uu, kUB)), 6);
+  out.val[1] = vqshrun_n_s16(
+      vsubq_s16(vsubq_s16(yy, vmulq_n_s16(uu, kUG)), vmulq_n_s16(vv, kVG)),
+      6);
+  out.val[2] = vqshrun_n_s16(vaddq_s16(yy, vmulq_n_s16(vv, kVR)), 6);
+  return out;
+}
+
+static inline uint16x8_t PackRGB565(uint8x8_t b, uint8x8_t g, uint8x8_t r) {
+  uint16x8_t out = vmovl_u8(vshr_n_u8(r, 3));
+  out = vorrq_u16(out, vshlq_n_u16(vmovl_u8(vshr_n_u8(g, 2)), 5));
+  return vorrq_u16(out, vshlq_n_u16(vmovl_u8(vshr_n_u8(b, 3)), 11));
+}
+#endif
+
+void color::YUV422ToGray(const uint8_t* src, uint8_t* dst, int width,
+                         int height, bool uyvy) {
+  size_t n = static_cast<size_t>(width) * height;
+  size_t i = 0;
+#if defined(CSCORE_COLOR_SSE2)
+  const __m128i lowMask = _mm_set1_epi16(0x00ff);
+  for (; i + 16 <= n; i += 16) {
+    __m128i a = Load(src + 2 * i);
+    __m128i b = Load(src + 2 * i + 16);
+    if (uyvy) {
+      a = _mm_srli_epi16(a, 8);
+      b = _mm_srli_epi16(b, 8);
+    } else {
+      a = _mm_and_si128(a, lowMask);
+      b = _mm_and_si128(b, lowMask);
+    }
+    Store(dst + i, _mm_packus_epi16(a, b));
+  }
+#elif defined(CSCORE_COLOR_NEON)
+  for (; i + 16 <= n; i += 16) {
+    uint8x16x2_t p = vld2q_u8(src + 2 * i);
+    vst1q_u8(dst + i, uyvy ? p.val[1] : p.val[0]);
+  }
+#endif
+  int yOff = uyvy ? 1 : 0;
+  for (; i < n; ++i) {
+    dst[i] = src[2 * i + yOff];
+  }
+}
+
+void color::YUV422ToBGR(const uint8_t* src, uint8_t* dst, int width,
+                        int height, bool uyvy) {
+  size_t n = static_cast<size_t>(width) * height;
+  size_t i = 0;
+#if defined(CSCORE_COLOR_SSE2)
+  const __m128i lowMask = _mm_set1_epi16(0x00ff);
+  const __m128i lowWordMask = _mm_set1_epi32(0xffff);
+  const __m128i c128 = _mm_set1_epi16(128);
+  // leave at least 2 pixels for the scalar loop, as StoreBGR16 overruns
+  for (; i + 18 <= n; i += 16) {
+    __m128i p[2] = {Load(src + 2 * i), Load(src + 2 * i + 16)};
+    __m128i bgr[3][2];
+    for (int j = 0; j < 2; ++j) {
+      __m128i y, c;
+      if (uyvy) {
+        y = _mm_srli_epi16(p[j], 8);
+        c = _mm_and_si128(p[j], lowMask);
+      } else {
+        y = _mm_and_si128(p[j], lowMask);
+        c = _mm_srli_epi16(p[j], 8);
+      }
+      // chroma is U, V, U, V...; give both pixels of each pair its U and V
+      __m128i u = _mm_or_si128(_mm_and_si128(c, lowWordMask),
+                               _mm_slli_epi32(c, 16));
+      __m128i v = _mm_or_si128(_mm_srli_epi32(c, 16),
+                               _mm_andnot_si128(lowWordMask, c));
+      YUVToBGR8(y, _mm_sub_epi16(u, c128), _mm_sub_epi16(v, c128),
+                &bgr[0][j], &bgr[1][j], &bgr[2][j]);
+    }
+    StoreBGR16(dst + 3 * i, _mm_packus_epi16(bgr[0][0], bgr[0][1]),
+               _mm_packus_epi16(bgr[1][0], bgr[1][1]),
+               _mm_packus_epi16(bgr[2][0], bgr[2][1]));
+  }
+#elif defined(CSCORE_COLOR_NEON)
+  for (; i + 16 <= n; i += 16) {
+    uint8x16x2_t p = vld2q_u8(src + 2 * i);
+    uint8x16_t y = uyvy ? p.val[1] : p.val[0];
+    uint8x16_t c = uyvy ? p.val[0] : p.val[1];
+    // chroma is U, V, U, V...; give both pixels of each pair its U and V
+    uint8x8x2_t uv = vuzp_u8(vget_low_u8(c), vget_high_u8(c));
+    uint8x8x2_t u = vzip_u8(uv.val[0], uv.val[0]);
+    uint8x8x2_t v = vzip_u8(uv.val[1], uv.val[1]);
+    vst3_u8(dst + 3 * i, YUVToBGR8(vget_low_u8(y), u.val[0], v.val[0]));
+    vst3_u8(dst + 3 * i + 24,
+            YUVToBGR8(vget_high_u8(y), u.val[1], v.val[1]));
+  }
+#endif
+  int yOff = uyvy ? 1 : 0;
+  int cOff = uyvy ? 0 : 1;
+  for (; i + 1 < n; i += 2) {
+    const uint8_t* p = src + 2 * i;
+    YUVToBGR(p[yOff], p[cOff], p[cOff + 2], dst + 3 * i);
+    YUVToBGR(p[yOff + 2], p[cOff], p[cOff + 2], dst + 3 * i + 3);
+  }
+}
+
+void color::YUV422ToGrayHalf(const uint8_t* src, uint8_t* dst, int width,
+                             int height, bool uyvy) {
+  size_t stride = static_cast<size_t>(width) * 2;
+  int yOff = uyvy ? 1 : 0;
+  for (int row = 0; row < height / 2; ++row) {
+    const uint8_t* a = src + 2 * row * stride + yOff;
+    const uint8_t* b = a + stride;
+    for (int x = 0; x < width / 2; ++x, a += 4, b += 4) {
+      *dst++ = (a[0] + a[2] + b[0] + b[2] + 2) >> 2;
+    }
+  }
+}
+
+void color::YUV422ToBGRHalf(const uint8_t* src, uint8_t* dst, int width,
+                            int height, bool uyvy) {
+  size_t stride = static_cast<size_t>(width) * 2;
+  int yOff = uyvy ? 1 : 0;
+  int cOff = uyvy ? 0 : 1;
+  for (int row = 0; row < height / 2; ++row) {
+    const uint8_t* a = src + 2 * row * stride;
+    const uint8_t* b = a + stride;
+    for (int x = 0; x < width / 2; ++x, a += 4, b += 4, dst += 3) {
+      YUVToBGR((a[yOff] + a[yOff + 2] + b[yOff] + b[yOff + 2] + 2) >> 2,
+               (a[cOff] + b[cOff] + 1) >> 1,
+               (a[cOff + 2] + b[cOff + 2] + 1) >> 1, dst);
+    }
+  }
+}
+
+void color::BGRToGray(const uint8_t* src, uint8_t* dst, int width,
+                      int height) {
+  size_t n = static_cast<size_t>(width) * height;
+  size_t i = 0;
+#ifdef CSCORE_COLOR_NEON
+  for (; i + 16 <= n; i += 16) {
+    uint8x16x3_t p = vld3q_u8(src + 3 * i);
+    uint16x8_t lo = vmull_u8(vget_low_u8(p.val[0]), vdup_n_u8(kGrayB));
+    lo = vmlal_u8(lo, vget_low_u8(p.val[1]), vdup_n_u8(kGrayG));
+    lo = vmlal_u8(lo, vget_low_u8(p.val[2]), vdup_n_u8(kGrayR));
+    uint16x8_t hi = vmull_u8(vget_high_u8(p.val[0]), vdup_n_u8(kGrayB));
+    hi = vmlal_u8(hi, vget_high_u8(p.val[1]), vdup_n_u8(kGrayG));
+    hi = vmlal_u8(hi, vget_high_u8(p.val[2]), vdup_n_u8(kGrayR));
+    vst1q_u8(dst + i, vcombine_u8(vrshrn_n_u16(lo, 8), vrshrn_n_u16(hi, 8)));
+  }
+#endif
+  for (; i < n; ++i) {
+    const uint8_t* p = src + 3 * i;
+    dst[i] = (p[0] * kGrayB + p[1] * kGrayG + p[2] * kGrayR + 128) >> 8;
+  }
+}
+
+void color::BGRToRGB565(const uint8_t* src, uint16_t* dst, int width,
+                        int height) {
+  size_t n = static_cast<size_t>(width) * height;
+  size_t i = 0;
+#ifdef CSCORE_COLOR_NEON
+  for (; i + 16 <= n; i += 16) {
+    uint8x16x3_t p = vld3q_u8(src + 3 * i);
+    vst1q_u16(dst + i, PackRGB565(vget_low_u8(p.val[0]),
+                                  vget_low_u8(p.val[1]),
+                                  vget_low_u8(p.val[2])));
+    vst1q_u16(dst + i + 8, PackRGB565(vget_high_u8(p.val[0]),
+                                      vget_high_u8(p.val[1]),
+                                      vget_high_u8(p.val[2])));
+  }
+#endif
+  for (; i < n; ++i) {
+    const uint8_t* p = src + 3 * i;
+    dst[i] = (p[2] >> 3) | ((p[1] >> 2) << 5) | ((p[0] >> 3) << 11);
+  }
+}
+
+void color::RGB565ToBGR(const uint16_t* src, uint8_t* dst, int width,
+                        int height) {
+  size_t n = static_cast<size_t>(width) * height;
+  size_t i = 0;
+#if defined(CSCORE_COLOR_SSE2)
+  const __m128i mask5 = _mm_set1_epi16(0xf8);
+  const __m128i mask6 = _mm_set1_epi16(0xfc);
+  // leave at least 2 pixels for the scalar loop, as StoreBGR16 overruns
+  for (; i + 18 <= n; i += 16) {
+    __m128i a = Load(src + i);
+    __m128i b = Load(src + i + 8);
+    StoreBGR16(
+        dst + 3 * i,
+        _mm_packus_epi16(_mm_and_si128(_mm_srli_epi16(a, 8), mask5),
+                         _mm_and_si128(_mm_srli_epi16(b, 8), mask5)),
+        _mm_packus_epi16(_mm_and_si128(_mm_srli_epi16(a, 3), mask6),
+                         _mm_and_si128(_mm_srli_epi16(b, 3), mask6)),
+        _mm_packus_epi16(_mm_and_si128(_mm_slli_epi16(a, 3), mask5),
+                         _mm_and_si128(_mm_slli_epi16(b, 3), mask5)));
+  }
+#elif defined(CSCORE_COLOR_NEON)
+  const uint8x8_t mask5 = vdup_n_u8(0xf8);
+  const uint8x8_t mask6 = vdup_n_u8(0xfc);
+  for (; i + 8 <= n; i += 8) {
+    uint16x8_t p = vld1q_u16(src + i);
+    uint8x8x3_t out;
+    out.val[0] = vand_u8(vshrn_n_u16(p, 8), mask5);
+    out.val[1] = vand_u8(vshrn_n_u16(p, 3), mask6);
+    out.val[2] = vand_u8(vmovn_u16(vshlq_n_u16(p, 3)), mask5);
+    vst3_u8(dst + 3 * i, out);
+  }
+#endif
+  for (; i < n; ++i) {
+    uint8_t* p = dst + 3 * i;
+    p[0] = (src[i] >> 8) & 0xf8;
+    p[1] = (src[i] >> 3) & 0xfc;
+    p[2] = (src[i] << 3) & 0xf8;
+  }
+}
+
+void color::Y16ToGray(const uint16_t* src, uint8_t* dst, int width,
+                      int height) {
+  size_t n = static_cast<size_t>(width) * height;
+  if (n == 0) {
+    return;
+  }
+
+  // find the range
+  uint16_t minVal = src[0];
+  uint16_t maxVal = src[0];
+  size_t i = 0;
+#if defined(CSCORE_COLOR_SSE2)
+  if (n >= 8) {
+    // SSE2 only has signed 16-bit min/max, so flip the sign bit
+    const __m128i sign = _mm_set1_epi16(-0x8000);
+    __m128i vmin = _mm_xor_si128(Load(src), sign);
+    __m128i vmax = vmin;
+    for (i = 8; i + 8 <= n; i += 8) {
+      __m128i v = _mm_xor_si128(Load(src + i), sign);
+      vmin = _mm_min_epi16(vmin, v);
+      vmax = _mm_max_epi16(vmax, v);
+    }
+    alignas(16) uint16_t mins[8];
+    alignas(16) uint16_t maxs[8];
+    Store(mins, _mm_xor_si128(vmin, sign));
+    Store(maxs, _mm_xor_si128(vmax, sign));
+    minVal = *std::min_element(mins, mins + 8);
+    maxVal = *std::max_element(maxs, maxs + 8);
+  }
+#elif defined(CSCORE_COLOR_NEON)
+  if (n >= 8) {
+    uint16x8_t vmin = vld1q_u16(src);
+    uint16x8_t vmax = vmin;
+    for (i = 8; i + 8 <= n; i += 8) {
+      uint16x8_t v = vld1q_u16(src + i);
+      vmin = vminq_u16(vmin, v);
+      vmax = vmaxq_u16(vmax, v);
+    }
+    uint16_t mins[8];
+    uint16_t maxs[8];
+    vst1q_u16(mins, vmin);
+    vst1q_u16(maxs, vmax);
+    minVal = *std::min_element(mins, mins + 8);
+    maxVal = *std::max_element(maxs, maxs + 8);
+  }
+#endif
+  for (; i < n; ++i) {
+    minVal = std::min(minVal, src[i]);
+    maxVal = std::max(maxVal, src[i]);
+  }
+
+  // scale min to 0 and max to 255 (everything to 0 if there's no range)
+  float scale = maxVal > minVal ? 255.0f / (maxVal - minVal) : 0.0f;
+  i = 0;
+#if defined(CSCORE_COLOR_SSE2)
+  {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i vminVal = _mm_set1_epi16(minVal);
+    const __m128 vscale = _mm_set1_ps(scale);
+    const __m128 half = _mm_set1_ps(0.5f);
+    auto scale4 = [&](__m128i v) {
+      return _mm_cvttps_epi32(
+          _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(v), vscale), half));
+    };
+    for (; i + 16 <= n; i += 16) {
+      __m128i a = _mm_sub_epi16(Load(src + i), vminVal);
+      __m128i b = _mm_sub_epi16(Load(src + i + 8), vminVal);
+      __m128i a16 = _mm_packs_epi32(scale4(_mm_unpacklo_epi16(a, zero)),
+                                    scale4(_mm_unpackhi_epi16(a, zero)));
+      __m128i b16 = _mm_packs_epi32(scale4(_mm_unpacklo_epi16(b, zero)),
+                                    scale4(_mm_unpackhi_epi16(b, zero)));
+      Store(dst + i, _mm_packus_epi16(a16, b16));
+    }
+  }
+#elif defined(CSCORE_COLOR_NEON)
+  {
+    const uint16x8_t vminVal = vdupq_n_u16(minVal);
+    const float32x4_t half = vdupq_n_f32(0.5f);
+    auto scale4 = [&](uint16x4_t v) {
+      return vmovn_u32(vcvtq_u32_f32(
+          vaddq_f32(vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(v)), scale), half)));
+    };
+    for (; i + 8 <= n; i += 8) {
+      uint16x8_t v = vsubq_u16(vld1q_u16(src + i), vminVal);
+      vst1_u8(dst + i, vmovn_u16(vcombine_u16(scale4(vget_low_u16(v)),
+                                              scale4(vget_high_u16(v)))));
+    }
+  }
+#endif
+  for (; i < n; ++i) {
+    dst[i] = static_cast<int>(static_cast<float>(src[i] - minVal) * scale +
+                              0.5f);
+  }
+}
+
+void color::BGRToYUV420(const uint8_t* src, uint8_t* dst, int width,
+                        int height, bool nv12) {
+  // BT.601 limited range RGB to YUV coefficients, with 8 fractional bits
+  auto toY = [](int b, int g, int r) {
+    return ((66 * r + 129 * g + 25 * b + 128) >> 8) + 16;
+  };
+  size_t stride = static_cast<size_t>(width) * 3;
+  uint8_t* yPlane = dst;
+  uint8_t* uPlane = dst + static_cast<size_t>(width) * height;
+  uint8_t* vPlane = uPlane + static_cast<size_t>(width / 2) * (height / 2);
+  for (int y = 0; y < height; y += 2) {
+    const uint8_t* row0 = src + y * stride;
+    const uint8_t* row1 = row0 + stride;
+    uint8_t* y0 = yPlane + static_cast<size_t>(y) * width;
+    uint8_t* y1 = y0 + width;
+    for (int x = 0; x < width; x += 2) {
+      const uint8_t* a = row0 + 3 * x;
+      const uint8_t* b = row1 + 3 * x;
+      y0[x] = toY(a[0], a[1], a[2]);
+      y0[x + 1] = toY(a[3], a[4], a[5]);
+      y1[x] = toY(b[0], b[1], b[2]);
+      y1[x + 1] = toY(b[3], b[4], b[5]);
+      int sb = (a[0] + a[3] + b[0] + b[3] + 2) >> 2;
+      int sg = (a[1] + a[4] + b[1] + b[4] + 2) >> 2;
+      int sr = (a[2] + a[5] + b[2] + b[5] + 2) >> 2;
+      uint8_t u = ((-38 * sr - 74 * sg + 112 * sb + 128) >> 8) + 128;
+      uint8_t v = ((112 * sr - 94 * sg - 18 * sb + 128) >> 8) + 128;
+      size_t c = static_cast<size_t>(y / 2) * (width / 2) + x / 2;
+      if (nv12) {
+        uPlane[2 * c] = u;
+        uPlane[2 * c + 1] = v;
+      } else {
+        uPlane[c] = u;
+        vPlane[c] = v;
+      }
+    }
+  }
+}
@@ -0,0 +1,54 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef CSCORE_COLORCONVERT_H_
+#define CSCORE_COLORCONVERT_H_
+
+#include <stdint.h>
+
+namespace cs::color {
+
+// Pixel format conversion kernels for the formats produced by cameras.
+// These use SSE2 or NEON where available.  All images must be tightly packed
+// (no row padding), and packed 4:2:2 YUV (YUYV or UYVY) images must have an
+// even width.
+
+// YUYV or UYVY to 8-bit grayscale
+void YUV422ToGray(const uint8_t* src, uint8_t* dst, int width, int height,
+                  bool uyvy);
+
+// YUYV or UYVY to BGR (BT.601 limited range)
+void YUV422ToBGR(const uint8_t* src, uint8_t* dst, int width, int height,
+                 bool uyvy);
+
+// YUYV or UYVY to half width and height grayscale or BGR, averaging each 2x2
+// block of pixels.  The width and height are those of the source image, and
+// must both be even.
+void YUV422ToGrayHalf(const uint8_t* src, uint8_t* dst, int width,
+                      int height, bool uyvy);
+void YUV422ToBGRHalf(const uint8_t* src, uint8_t* dst, int width, int height,
+                     bool uyvy);
+
+// BGR to 8-bit grayscale
+void BGRToGray(const uint8_t* src, uint8_t* dst, int width, int height);
+
+// BGR to/from RGB565 (red in the low 5 bits)
+void BGRToRGB565(const uint8_t* src, uint16_t* dst, int width, int height);
+void RGB565ToBGR(const uint16_t* src, uint8_t* dst, int width, int height);
+
+// 16-bit grayscale to 8-bit grayscale, scaling the minimum value to 0 and the
+// maximum value to 255
+void Y16ToGray(const uint16_t* src, uint8_t* dst, int width, int height);
+
+// BGR to planar 4:2:0 YUV (BT.601 limited range), as used by video encoders.
+// Each chroma sample is the average of a 2x2 block of pixels, so the width and
+// height must both be even.  The luma plane is width x height and is followed
+// in dst by either separate U and V planes (I420), or a single interleaved UV
+// plane (NV12).
+void BGRToYUV420(const uint8_t* src, uint8_t* dst, int width, int height,
+                 bool nv12);
+
+}  // namespace cs::color
+
+#endif  // CSCORE_COLORCONVERT_H_
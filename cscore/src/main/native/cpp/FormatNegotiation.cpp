@@ -0,0 +1,106 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "FormatNegotiation.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace cs;
+
+// Relative per-pixel costs, roughly matching the measured cost of the
+// conversions in Frame on embedded ARM targets.
+static constexpr int64_t kDecodeCost = 8;  // MJPEG to BGR
+static constexpr int64_t kEncodeCost = 12;  // BGR to MJPEG
+static constexpr int64_t kResizeCost = 3;
+static constexpr int64_t kColorCost = 1;  // any raw color conversion
+
+// Cost of producing demand from a raw (not MJPEG) image of format from.
+static int64_t RawConversionCost(VideoMode::PixelFormat from, int width,
+                                 int height, const SinkDemand& demand) {
+  int64_t srcPixels = int64_t{width} * height;
+  int64_t dstPixels = int64_t{demand.width} * demand.height;
+  bool resize = demand.width != width || demand.height != height;
+  int64_t cost = resize ? kResizeCost * dstPixels : 0;
+
+  switch (demand.pixelFormat) {
+    case VideoMode::kYUYV:
+    case VideoMode::kUYVY:
+      // Frame can't convert to packed YUV formats
+      return from == demand.pixelFormat ? cost : kImpossibleConversion;
+    case VideoMode::kMJPEG:
+      // encoding starts from BGR (or gray)
+      if (from != VideoMode::kBGR && from != VideoMode::kGray) {
+        cost += kColorCost * srcPixels;
+      }
+      return cost + kEncodeCost * dstPixels;
+    default:
+      if (from != demand.pixelFormat) {
+        cost += kColorCost * srcPixels;
+      }
+      return cost;
+  }
+}
+
+int64_t cs::EstimateConversionCost(const VideoMode& mode,
+                                   std::span<const SinkDemand> demands) {
+  // resolve sizes and drop duplicates
+  std::vector<SinkDemand> distinct;
+  for (auto demand : demands) {
+    if (demand.width <= 0 || demand.height <= 0) {
+      demand.width = mode.width;
+      demand.height = mode.height;
+    }
+    if (std::find(distinct.begin(), distinct.end(), demand) ==
+        distinct.end()) {
+      distinct.emplace_back(demand);
+    }
+  }
+
+  int64_t cost = 0;
+  bool decoded = false;
+  for (auto&& demand : distinct) {
+    VideoMode::PixelFormat from =
+        static_cast<VideoMode::PixelFormat>(mode.pixelFormat);
+    if (from == VideoMode::kMJPEG) {
+      if (demand.pixelFormat == VideoMode::kMJPEG &&
+          demand.width == mode.width && demand.height == mode.height) {
+        continue;  // passed through as-is
+      }
+      if (!decoded) {
+        cost += kDecodeCost * mode.width * mode.height;
+        decoded = true;
+      }
+      from = VideoMode::kBGR;
+    }
+    cost += RawConversionCost(from, mode.width, mode.height, demand);
+    if (cost >= kImpossibleConversion) {
+      return kImpossibleConversion;
+    }
+  }
+  return cost;
+}
+
+VideoMode cs::ChooseVideoMode(std::span<const VideoMode> modes,
+                              const VideoMode& current,
+                              std::span<const SinkDemand> demands) {
+  if (demands.empty()) {
+    return current;
+  }
+  VideoMode best = current;
+  int64_t bestCost = EstimateConversionCost(current, demands);
+  for (auto&& mode : modes) {
+    if (mode.pixelFormat == VideoMode::kUnknown ||
+        mode.width != current.width || mode.height != current.height ||
+        mode.fps != current.fps) {
+      continue;
+    }
+    int64_t cost = EstimateConversionCost(mode, demands);
+    if (cost < bestCost) {
+      best = mode;
+      bestCost = cost;
+    }
+  }
+  return best;
+}
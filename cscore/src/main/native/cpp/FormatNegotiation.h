@@ -0,0 +1,45 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef CSCORE_FORMATNEGOTIATION_H_
+#define CSCORE_FORMATNEGOTIATION_H_
+
+#include <stdint.h>
+
+#include <span>
+
+#include "cscore_cpp.h"
+
+namespace cs {
+
+// The image format and size a sink requests from each frame.  A zero width
+// or height means the source's own size.
+struct SinkDemand {
+  VideoMode::PixelFormat pixelFormat = VideoMode::kUnknown;
+  int width = 0;
+  int height = 0;
+
+  bool operator==(const SinkDemand&) const = default;
+};
+
+// Sentinel cost of a demand that can't be produced from a mode at all.
+inline constexpr int64_t kImpossibleConversion = INT64_MAX / 4;
+
+// Estimates the per-frame cost (in arbitrary per-pixel units) of producing
+// images for all of the demands from frames captured in the given mode.
+// Conversions of one frame are cached and shared between sinks, so each
+// distinct demand is counted once, as is decoding an MJPEG frame.
+int64_t EstimateConversionCost(const VideoMode& mode,
+                               std::span<const SinkDemand> demands);
+
+// Chooses the capture mode from modes that minimizes the conversion cost for
+// the demands.  Only the pixel format is negotiated; the resolution and frame
+// rate are left as set in current.  Returns current if no mode is cheaper.
+VideoMode ChooseVideoMode(std::span<const VideoMode> modes,
+                          const VideoMode& current,
+                          std::span<const SinkDemand> demands);
+
+}  // namespace cs
+
+#endif  // CSCORE_FORMATNEGOTIATION_H_
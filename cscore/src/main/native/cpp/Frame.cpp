@@ -10,9 +10,13 @@
 #include <opencv2/core/core.hpp>
 #include <opencv2/highgui/highgui.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
+#include <wpi/timestamp.h>
 
+#include "ColorConvert.h"
 #include "Instance.h"
+#include "JpegCodec.h"
 #include "SourceImpl.h"
+#include "Telemetry.h"
 
 using namespace cs;
 
@@ -22,6 +26,7 @@ Frame::Frame(SourceImpl& source, std::string_view error, Time time,
   m_impl->refcount = 1;
   m_impl->error = error;
   m_impl->time = time;
+  m_impl->putTime = wpi::Now();
   m_impl->timeSource = timeSrc;
 }
 
@@ -31,10 +36,20 @@ Frame::Frame(SourceImpl& source, std::unique_ptr<Image> image, Time time,
   m_impl->refcount = 1;
   m_impl->error.resize(0);
   m_impl->time = time;
+  m_impl->putTime = wpi::Now();
   m_impl->timeSource = timeSrc;
   m_impl->images.push_back(image.release());
 }
 
+void Frame::RecordLatency(CS_LatencyStage stage, Time start) const {
+  if (!m_impl || start == 0) {
+    return;
+  }
+  Time now = wpi::Now();
+  m_impl->source.m_telemetry.RecordLatency(
+      m_impl->source, stage, now > start ? now - start : 0);
+}
+
 Image* Frame::GetNearestImage(int width, int height) const {
   if (!m_impl) {
     return nullptr;
@@ -392,7 +407,7 @@ Image* Frame::ConvertMJPEGToBGR(Image* image) {
 
   // Decode
   cv::Mat newMat = newImage->AsMat();
-  cv::imdecode(image->AsInputArray(), cv::IMREAD_COLOR, &newMat);
+  GetJpegCodec().Decode(image->span(), newMat);
 
   // Save the result
   Image* rv = newImage.release();
@@ -415,7 +430,7 @@ Image* Frame::ConvertMJPEGToGray(Image* image) {
 
   // Decode
   cv::Mat newMat = newImage->AsMat();
-  cv::imdecode(image->AsInputArray(), cv::IMREAD_GRAYSCALE, &newMat);
+  GetJpegCodec().Decode(image->span(), newMat);
 
   // Save the result
   Image* rv = newImage.release();
@@ -437,7 +452,8 @@ Image* Frame::ConvertYUYVToBGR(Image* image) {
                                 image->width * image->height * 3);
 
   // Convert
-  cv::cvtColor(image->AsMat(), newImage->AsMat(), cv::COLOR_YUV2BGR_YUYV);
+  color::YUV422ToBGR(image->span().data(), newImage->vec().data(), image->width,
+                     image->height, false);
 
   // Save the result
   Image* rv = newImage.release();
@@ -459,7 +475,8 @@ Image* Frame::ConvertYUYVToGray(Image* image) {
                                 image->width * image->height);
 
   // Convert
-  cv::cvtColor(image->AsMat(), newImage->AsMat(), cv::COLOR_YUV2GRAY_YUYV);
+  color::YUV422ToGray(image->span().data(), newImage->vec().data(),
+                      image->width, image->height, false);
 
   // Save the result
   Image* rv = newImage.release();
@@ -481,7 +498,8 @@ Image* Frame::ConvertUYVYToBGR(Image* image) {
                                 image->width * image->height * 3);
 
   // Convert
-  cv::cvtColor(image->AsMat(), newImage->AsMat(), cv::COLOR_YUV2BGR_UYVY);
+  color::YUV422ToBGR(image->span().data(), newImage->vec().data(), image->width,
+                     image->height, true);
 
   // Save the result
   Image* rv = newImage.release();
@@ -503,7 +521,8 @@ Image* Frame::ConvertUYVYToGray(Image* image) {
                                 image->width * image->height);
 
   // Convert
-  cv::cvtColor(image->AsMat(), newImage->AsMat(), cv::COLOR_YUV2GRAY_UYVY);
+  color::YUV422ToGray(image->span().data(), newImage->vec().data(),
+                      image->width, image->height, true);
 
   // Save the result
   Image* rv = newImage.release();
@@ -525,7 +544,9 @@ Image* Frame::ConvertBGRToRGB565(Image* image) {
                                 image->width * image->height * 2);
 
   // Convert
-  cv::cvtColor(image->AsMat(), newImage->AsMat(), cv::COLOR_RGB2BGR565);
+  color::BGRToRGB565(image->span().data(),
+                     reinterpret_cast<uint16_t*>(newImage->vec().data()),
+                     image->width, image->height);
 
   // Save the result
   Image* rv = newImage.release();
@@ -547,7 +568,8 @@ Image* Frame::ConvertRGB565ToBGR(Image* image) {
                                 image->width * image->height * 3);
 
   // Convert
-  cv::cvtColor(image->AsMat(), newImage->AsMat(), cv::COLOR_BGR5652RGB);
+  color::RGB565ToBGR(reinterpret_cast<const uint16_t*>(image->span().data()),
+                     newImage->vec().data(), image->width, image->height);
 
   // Save the result
   Image* rv = newImage.release();
@@ -569,7 +591,8 @@ Image* Frame::ConvertBGRToGray(Image* image) {
                                 image->width * image->height);
 
   // Convert
-  cv::cvtColor(image->AsMat(), newImage->AsMat(), cv::COLOR_BGR2GRAY);
+  color::BGRToGray(image->span().data(), newImage->vec().data(), image->width,
+                   image->height);
 
   // Save the result
   Image* rv = newImage.release();
@@ -622,14 +645,7 @@ Image* Frame::ConvertBGRToMJPEG(Image* image, int quality) {
                                 image->width * image->height * 1.5);
 
   // Compress
-  if (m_impl->compressionParams.empty()) {
-    m_impl->compressionParams.push_back(cv::IMWRITE_JPEG_QUALITY);
-    m_impl->compressionParams.push_back(quality);
-  } else {
-    m_impl->compressionParams[1] = quality;
-  }
-  cv::imencode(".jpg", image->AsMat(), newImage->vec(),
-               m_impl->compressionParams);
+  GetJpegCodec().Encode(image->AsMat(), quality, newImage->vec());
 
   // Save the result
   Image* rv = newImage.release();
@@ -657,14 +673,7 @@ Image* Frame::ConvertGrayToMJPEG(Image* image, int quality) {
                                 image->width * image->height * 0.75);
 
   // Compress
-  if (m_impl->compressionParams.empty()) {
-    m_impl->compressionParams.push_back(cv::IMWRITE_JPEG_QUALITY);
-    m_impl->compressionParams.push_back(quality);
-  } else {
-    m_impl->compressionParams[1] = quality;
-  }
-  cv::imencode(".jpg", image->AsMat(), newImage->vec(),
-               m_impl->compressionParams);
+  GetJpegCodec().Encode(image->AsMat(), quality, newImage->vec());
 
   // Save the result
   Image* rv = newImage.release();
@@ -705,7 +714,8 @@ Image* Frame::ConvertY16ToGray(Image* image) {
                                 image->width * image->height);
 
   // Scale min to 0 and max to 255
-  cv::normalize(image->AsMat(), newImage->AsMat(), 255, 0, cv::NORM_MINMAX);
+  color::Y16ToGray(reinterpret_cast<const uint16_t*>(image->span().data()),
+                   newImage->vec().data(), image->width, image->height);
 
   // Save the result
   Image* rv = newImage.release();
@@ -755,6 +765,19 @@ Image* Frame::GetImageImpl(int width, int height,
              cur->height, static_cast<int>(cur->pixelFormat), width, height,
              static_cast<int>(pixelFormat));
 
+  Time start = wpi::Now();
+  cur = ResizeAndConvert(cur, width, height, pixelFormat, requiredJpegQuality,
+                         defaultJpegQuality);
+  RecordLatency(
+      pixelFormat == VideoMode::kMJPEG ? CS_LATENCY_ENCODE : CS_LATENCY_CONVERT,
+      start);
+  return cur;
+}
+
+Image* Frame::ResizeAndConvert(Image* cur, int width, int height,
+                               VideoMode::PixelFormat pixelFormat,
+                               int requiredJpegQuality,
+                               int defaultJpegQuality) {
   // If the source image is a JPEG, we need to decode it before we can do
   // anything else with it.  Note that if the destination format is JPEG, we
   // still need to do this (unless the width/height/compression were the same,
@@ -763,6 +786,29 @@ Image* Frame::GetImageImpl(int width, int height,
     cur = ConvertMJPEGToBGR(cur);
   }
 
+  // Downscaling YUV by half to BGR or grayscale is common (e.g. for
+  // processing at a lower resolution than streaming), and is much faster
+  // combined with the color conversion.
+  if ((cur->pixelFormat == VideoMode::kYUYV ||
+       cur->pixelFormat == VideoMode::kUYVY) &&
+      (pixelFormat == VideoMode::kBGR || pixelFormat == VideoMode::kGray) &&
+      cur->Is(width * 2, height * 2)) {
+    bool uyvy = cur->pixelFormat == VideoMode::kUYVY;
+    auto newImage = m_impl->source.AllocImage(
+        pixelFormat, width, height,
+        width * height * (pixelFormat == VideoMode::kBGR ? 3 : 1));
+    if (pixelFormat == VideoMode::kBGR) {
+      color::YUV422ToBGRHalf(cur->span().data(), newImage->vec().data(),
+                             cur->width, cur->height, uyvy);
+    } else {
+      color::YUV422ToGrayHalf(cur->span().data(), newImage->vec().data(),
+                              cur->width, cur->height, uyvy);
+    }
+    cur = newImage.release();
+    m_impl->images.push_back(cur);
+    return cur;
+  }
+
   // Resize
   if (!cur->Is(width, height)) {
     // Allocate an image.
@@ -39,11 +39,11 @@ class Frame {
     wpi::recursive_mutex mutex;
     std::atomic_int refcount{0};
     Time time{0};
+    Time putTime{0};  // when the source put the frame
     WPI_TimestampSource timeSource{WPI_TIMESRC_UNKNOWN};
     SourceImpl& source;
     std::string error;
     wpi::SmallVector<Image*, 4> images;
-    std::vector<int> compressionParams;
   };
 
  public:
@@ -81,6 +81,11 @@ class Frame {
   WPI_TimestampSource GetTimeSource() const {
     return m_impl ? m_impl->timeSource : WPI_TIMESRC_UNKNOWN;
   }
+  Time GetPutTime() const { return m_impl ? m_impl->putTime : 0; }
+
+  // Records the latency of a processing stage of this frame, from start until
+  // now, to the source's telemetry.
+  void RecordLatency(CS_LatencyStage stage, Time start) const;
 
   std::string_view GetError() const {
     if (!m_impl) {
@@ -241,6 +246,9 @@ class Frame {
                      int requiredJpegQuality, int defaultJpegQuality);
   Image* GetImageImpl(int width, int height, VideoMode::PixelFormat pixelFormat,
                       int requiredJpegQuality, int defaultJpegQuality);
+  Image* ResizeAndConvert(Image* cur, int width, int height,
+                          VideoMode::PixelFormat pixelFormat,
+                          int requiredJpegQuality, int defaultJpegQuality);
   void DecRef() {
     if (m_impl && --(m_impl->refcount) == 0) {
       ReleaseFrame();
@@ -0,0 +1,63 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "FrameSync.h"
+
+#include <algorithm>
+
+using namespace cs;
+
+// Returns the time in times (sorted, non-empty) closest to t
+static uint64_t Closest(const std::vector<uint64_t>& times, uint64_t t) {
+  auto it = std::lower_bound(times.begin(), times.end(), t);
+  if (it == times.end()) {
+    return times.back();
+  }
+  if (it == times.begin() || *it - t < t - *(it - 1)) {
+    return *it;
+  }
+  return *(it - 1);
+}
+
+FrameSyncMatch cs::MatchFrameTimes(
+    std::span<const std::vector<uint64_t>> times, uint64_t window) {
+  FrameSyncMatch result;
+  if (times.empty()) {
+    return result;
+  }
+
+  // find the sink whose newest frame is oldest
+  for (size_t i = 0; i < times.size(); ++i) {
+    if (times[i].empty()) {
+      result.waitSink = i;
+      return result;
+    }
+    if (times[i].back() < times[result.waitSink].back()) {
+      result.waitSink = i;
+    }
+  }
+
+  const auto& anchors = times[result.waitSink];
+  result.times.resize(times.size());
+  for (auto anchor = anchors.rbegin(); anchor != anchors.rend(); ++anchor) {
+    uint64_t minTime = *anchor;
+    uint64_t maxTime = *anchor;
+    for (size_t i = 0; i < times.size(); ++i) {
+      result.times[i] = Closest(times[i], *anchor);
+      minTime = std::min(minTime, result.times[i]);
+      maxTime = std::max(maxTime, result.times[i]);
+    }
+    if (maxTime - minTime <= window) {
+      result.matched = true;
+      return result;
+    }
+  }
+
+  // later frames from waitSink are newer than its newest, so older frames
+  // from the others can't match them
+  result.times.clear();
+  uint64_t newest = anchors.back();
+  result.dropBefore = newest > window ? newest - window : 0;
+  return result;
+}
@@ -0,0 +1,39 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef CSCORE_FRAMESYNC_H_
+#define CSCORE_FRAMESYNC_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <span>
+#include <vector>
+
+namespace cs {
+
+// Result of matching frame times across several sinks.
+struct FrameSyncMatch {
+  // True if a set of frames within the window was found
+  bool matched = false;
+  // If matched, the time of the chosen frame for each sink
+  std::vector<uint64_t> times;
+  // If not matched, frames older than this can never be part of a match
+  uint64_t dropBefore = 0;
+  // If not matched, the sink that needs a newer frame before a match is
+  // possible
+  size_t waitSink = 0;
+};
+
+// Finds the newest set of frames, one per sink, whose times all fall within
+// window of each other.  times holds the queued frame times of each sink,
+// oldest first.  As every set must include a frame from the sink whose newest
+// frame is oldest, each of that sink's frames (newest first) is tried as the
+// anchor, taking the closest frame to it from each of the other sinks.
+FrameSyncMatch MatchFrameTimes(std::span<const std::vector<uint64_t>> times,
+                               uint64_t window);
+
+}  // namespace cs
+
+#endif  // CSCORE_FRAMESYNC_H_
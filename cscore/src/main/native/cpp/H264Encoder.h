@@ -0,0 +1,62 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef CSCORE_H264ENCODER_H_
+#define CSCORE_H264ENCODER_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace wpi {
+class Logger;
+}  // namespace wpi
+
+namespace cs {
+
+// H.264 video encoder.  Implementations are platform specific hardware
+// encoders; there is no software fallback.  An encoder instance is not thread
+// safe and encodes a single stream.
+class H264Encoder {
+ public:
+  struct Settings {
+    int width;
+    int height;
+    int fps;
+    // bits per second
+    int bitrate;
+    // frames between IDR frames
+    int keyFrameInterval;
+  };
+
+  virtual ~H264Encoder() = default;
+
+  virtual std::string_view GetName() const = 0;
+
+  // Encodes a BGR image of the configured size.  The encoded access unit is
+  // stored in out in Annex B format (NAL units with start codes); SPS and PPS
+  // are repeated before every IDR frame.  Returns false on error.  The
+  // encoder may not produce output for every input; in that case out is
+  // empty and true is returned.
+  virtual bool Encode(std::span<const uint8_t> bgr, bool forceKeyFrame,
+                      std::vector<uint8_t>& out) = 0;
+
+  // Changes the target bitrate (bits per second) of a running encoder.
+  virtual void SetBitrate(int bitrate) = 0;
+};
+
+// Returns true if a hardware encoder is likely to be available.
+bool IsH264EncoderAvailable();
+
+// Creates a hardware encoder.  Returns nullptr if none is available or it
+// doesn't support the settings.
+std::unique_ptr<H264Encoder> CreateH264Encoder(
+    const H264Encoder::Settings& settings, wpi::Logger& logger);
+
+}  // namespace cs
+
+#endif  // CSCORE_H264ENCODER_H_
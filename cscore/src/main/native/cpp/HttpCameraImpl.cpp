@@ -12,6 +12,7 @@
 #include <fmt/format.h>
 #include <wpi/MemAlloc.h>
 #include <wpi/StringExtras.h>
+#include <wpi/ThreadRegistry.h>
 #include <wpi/timestamp.h>
 #include <wpinet/TCPConnector.h>
 
@@ -19,6 +20,7 @@
 #include "JpegUtil.h"
 #include "Log.h"
 #include "Notifier.h"
+#include "ReadaheadStream.h"
 #include "Telemetry.h"
 #include "c_util.h"
 
@@ -102,6 +104,7 @@ void HttpCameraImpl::MonitorThreadMain() {
 }
 
 void HttpCameraImpl::StreamThreadMain() {
+  wpi::SetCurrentThreadClass(wpi::ThreadClass::kCamera, "HttpCamera");
   while (m_active) {
     SetConnected(false);
 
@@ -138,8 +141,10 @@ void HttpCameraImpl::StreamThreadMain() {
     // update connected since we're actually connected
     SetConnected(true);
 
-    // stream
-    DeviceStream(conn->is, boundary.str());
+    // stream; the handshake reads the response headers unbuffered, so
+    // nothing has been read ahead of the multipart body yet
+    ReadaheadStream is{*conn->stream, 1};
+    DeviceStream(is, boundary.str());
     {
       std::unique_lock lock(m_mutex);
       m_streamConn = nullptr;
@@ -232,10 +237,13 @@ wpi::HttpConnection* HttpCameraImpl::DeviceStreamConnect(
   return conn;
 }
 
-void HttpCameraImpl::DeviceStream(wpi::raw_istream& is,
+void HttpCameraImpl::DeviceStream(ReadaheadStream& is,
                                   std::string_view boundary) {
-  // Stored here so we reuse it from frame to frame
-  std::string imageBuf;
+  std::string delim = fmt::format("--{}", boundary);
+
+  // Size of the last image without a Content-Length, so the next one is
+  // usually read without reallocating
+  size_t sizeHint = 0;
 
   // keep track of number of bad images received; if we receive 3 bad images
   // in a row, we reconnect
@@ -244,7 +252,7 @@ void HttpCameraImpl::DeviceStream(wpi::raw_istream& is,
   // streaming loop
   while (m_active && !is.has_error() && IsEnabled() && numErrors < 3 &&
          !m_streamSettingsUpdated) {
-    if (!FindMultipartBoundary(is, boundary, nullptr)) {
+    if (!is.SkipPast(delim)) {
       break;
     }
 
@@ -266,7 +274,7 @@ void HttpCameraImpl::DeviceStream(wpi::raw_istream& is,
       }
     }
 
-    if (!DeviceStreamFrame(is, imageBuf)) {
+    if (!DeviceStreamFrame(is, sizeHint)) {
       ++numErrors;
     } else {
       numErrors = 0;
@@ -274,8 +282,8 @@ void HttpCameraImpl::DeviceStream(wpi::raw_istream& is,
   }
 }
 
-bool HttpCameraImpl::DeviceStreamFrame(wpi::raw_istream& is,
-                                       std::string& imageBuf) {
+bool HttpCameraImpl::DeviceStreamFrame(ReadaheadStream& is,
+                                       size_t& sizeHint) {
   // Read the headers
   wpi::SmallString<64> contentTypeBuf;
   wpi::SmallString<64> contentLengthBuf;
@@ -316,13 +324,16 @@ bool HttpCameraImpl::DeviceStreamFrame(wpi::raw_istream& is,
     PutFrame(std::move(image), wpi::Now());
   } else {
     // Ugh, no Content-Length?  Read the blocks of the JPEG file.
-    if (!ReadJpeg(is, imageBuf, &width, &height)) {
+    auto image = AllocImage(VideoMode::PixelFormat::kMJPEG, 0, 0, sizeHint);
+    if (!ReadJpeg(is, *image, &width, &height)) {
       SWARNING("did not receive a JPEG image");
       PutError("did not receive a JPEG image", wpi::Now());
       return false;
     }
-    PutFrame(VideoMode::PixelFormat::kMJPEG, width, height, imageBuf,
-             wpi::Now());
+    sizeHint = image->size();
+    image->width = width;
+    image->height = height;
+    PutFrame(std::move(image), wpi::Now());
   }
 
   ++m_frameCount;
@@ -25,6 +25,8 @@
 
 namespace cs {
 
+class ReadaheadStream;
+
 class HttpCameraImpl : public SourceImpl {
  public:
   HttpCameraImpl(std::string_view name, CS_HttpCameraKind kind,
@@ -101,8 +103,8 @@ class HttpCameraImpl : public SourceImpl {
   // Functions used by StreamThreadMain()
   wpi::HttpConnection* DeviceStreamConnect(
       wpi::SmallVectorImpl<char>& boundary);
-  void DeviceStream(wpi::raw_istream& is, std::string_view boundary);
-  bool DeviceStreamFrame(wpi::raw_istream& is, std::string& imageBuf);
+  void DeviceStream(ReadaheadStream& is, std::string_view boundary);
+  bool DeviceStreamFrame(ReadaheadStream& is, size_t& sizeHint);
 
   // The camera settings thread
   void SettingsThreadMain();
@@ -5,7 +5,10 @@
 #ifndef CSCORE_IMAGE_H_
 #define CSCORE_IMAGE_H_
 
+#include <functional>
+#include <span>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include <opencv2/core/core.hpp>
@@ -17,18 +20,30 @@ namespace cs {
 
 class Frame;
 
+// Image data storage.  Resizing doesn't zero-fill, as the contents are always
+// overwritten.
+using ImageBuffer = std::vector<uchar, default_init_allocator<uchar>>;
+
 class Image {
   friend class Frame;
 
  public:
-#ifndef __linux__
   explicit Image(size_t capacity) { m_data.reserve(capacity); }
-#else
-  explicit Image(size_t capacity)
-      : m_data{capacity, default_init_allocator<uchar>{}} {
-    m_data.resize(0);
+
+  // Wraps an externally owned buffer (e.g. a memory-mapped camera buffer)
+  // without copying it.  release is called when the image is destroyed.
+  // External images are never returned to the image pool, and can't be
+  // resized.
+  Image(uchar* data, size_t size, std::function<void()> release)
+      : m_external{data},
+        m_externalSize{size},
+        m_release{std::move(release)} {}
+
+  ~Image() {
+    if (m_release) {
+      m_release();
+    }
   }
-#endif
 
   Image(const Image&) = delete;
   Image& operator=(const Image&) = delete;
@@ -39,14 +54,14 @@ class Image {
   }
   std::string_view str() const { return {data(), size()}; }
   size_t capacity() const { return m_data.capacity(); }
-  const char* data() const {
-    return reinterpret_cast<const char*>(m_data.data());
-  }
-  char* data() { return reinterpret_cast<char*>(m_data.data()); }
-  size_t size() const { return m_data.size(); }
+  const char* data() const { return reinterpret_cast<const char*>(bytes()); }
+  char* data() { return reinterpret_cast<char*>(bytes()); }
+  size_t size() const { return m_external ? m_externalSize : m_data.size(); }
+  std::span<const uchar> span() const { return {bytes(), size()}; }
+  bool IsExternal() const { return m_external != nullptr; }
 
-  const std::vector<uchar>& vec() const { return m_data; }
-  std::vector<uchar>& vec() { return m_data; }
+  const ImageBuffer& vec() const { return m_data; }
+  ImageBuffer& vec() { return m_data; }
 
   void resize(size_t size) { m_data.resize(size); }
   void SetSize(size_t size) { m_data.resize(size); }
@@ -72,10 +87,13 @@ class Image {
         type = CV_8UC1;
         break;
     }
-    return cv::Mat{height, width, type, m_data.data()};
+    return cv::Mat{height, width, type, bytes()};
   }
 
-  int GetStride() const {
+  int GetStride() const { return GetStride(pixelFormat, width); }
+
+  // Row size of an uncompressed image, or 0 for compressed formats
+  static int GetStride(VideoMode::PixelFormat pixelFormat, int width) {
     switch (pixelFormat) {
       case VideoMode::kYUYV:
       case VideoMode::kRGB565:
@@ -94,7 +112,9 @@ class Image {
     }
   }
 
-  cv::_InputArray AsInputArray() { return cv::_InputArray{m_data}; }
+  cv::_InputArray AsInputArray() {
+    return cv::_InputArray{bytes(), static_cast<int>(size())};
+  }
 
   bool Is(int width_, int height_) {
     return width == width_ && height == height_;
@@ -120,7 +140,13 @@ class Image {
   bool IsSmaller(const Image& oth) { return !IsLarger(oth); }
 
  private:
-  std::vector<uchar> m_data;
+  const uchar* bytes() const { return m_external ? m_external : m_data.data(); }
+  uchar* bytes() { return m_external ? m_external : m_data.data(); }
+
+  ImageBuffer m_data;
+  uchar* m_external = nullptr;
+  size_t m_externalSize = 0;
+  std::function<void()> m_release;
 
  public:
   VideoMode::PixelFormat pixelFormat{VideoMode::kUnknown};
@@ -0,0 +1,131 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "ImagePool.h"
+
+#include <bit>
+#include <memory>
+#include <utility>
+
+using namespace cs;
+
+size_t ImagePool::GetSizeClass(size_t size) {
+  if (size <= kMinClassSize) {
+    return 0;
+  }
+  // round up to a quarter of the highest power of two below size
+  int bit = static_cast<int>(std::bit_width(size - 1)) - 1;
+  size_t step = size_t{1} << (bit - 2);
+  size_t quarters = (size - 1) / step + 1;  // 5 to 8
+  size_t sizeClass = 1 + (bit - 12) * 4 + (quarters - 5);
+  return sizeClass < kNumClasses ? sizeClass : kNumClasses;
+}
+
+size_t ImagePool::GetClassSize(size_t sizeClass) {
+  if (sizeClass == 0) {
+    return kMinClassSize;
+  }
+  size_t bit = 12 + (sizeClass - 1) / 4;
+  return (5 + (sizeClass - 1) % 4) << (bit - 2);
+}
+
+std::unique_ptr<Image> ImagePool::Alloc(size_t size) {
+  size_t sizeClass = GetSizeClass(size);
+  {
+    std::scoped_lock lock{m_mutex};
+    if (sizeClass < kNumClasses) {
+      auto& images = m_classes[sizeClass].images;
+      m_classes[sizeClass].lastUse = ++m_useCount;
+      if (!images.empty()) {
+        auto image = std::move(images.back());
+        images.pop_back();
+        --m_stats.pooledBuffers;
+        m_stats.pooledBytes -= image->capacity();
+        ++m_stats.hits;
+        return image;
+      }
+    }
+    ++m_stats.misses;
+  }
+  // allocate the full class size so the buffer can be reused for any size in
+  // the class
+  return std::make_unique<Image>(
+      sizeClass < kNumClasses ? GetClassSize(sizeClass) : size);
+}
+
+bool ImagePool::MakeRoom(size_t bytes, size_t except) {
+  if (bytes > m_capacity) {
+    return false;
+  }
+  while (m_stats.pooledBytes + bytes > m_capacity) {
+    // free from the least recently used class
+    SizeClass* victim = nullptr;
+    for (size_t i = 0; i < kNumClasses; ++i) {
+      auto& c = m_classes[i];
+      if (i != except && !c.images.empty() &&
+          (!victim || c.lastUse < victim->lastUse)) {
+        victim = &c;
+      }
+    }
+    if (!victim) {
+      return false;
+    }
+    m_stats.pooledBytes -= victim->images.back()->capacity();
+    --m_stats.pooledBuffers;
+    victim->images.pop_back();
+  }
+  return true;
+}
+
+void ImagePool::Release(std::unique_ptr<Image> image) {
+  // External images release their buffer when destroyed
+  if (image->IsExternal()) {
+    return;
+  }
+
+  // the capacity may have grown beyond the class it was allocated from
+  size_t capacity = image->capacity();
+  size_t sizeClass = GetSizeClass(capacity);
+  if (sizeClass < kNumClasses && GetClassSize(sizeClass) > capacity) {
+    if (sizeClass == 0) {
+      sizeClass = kNumClasses;  // too small to be worth pooling
+    } else {
+      --sizeClass;
+    }
+  }
+
+  std::scoped_lock lock{m_mutex};
+  if (m_shutdown || sizeClass >= kNumClasses ||
+      !MakeRoom(capacity, sizeClass)) {
+    ++m_stats.discards;
+    return;  // image is freed after the lock is released
+  }
+  m_classes[sizeClass].lastUse = ++m_useCount;
+  m_classes[sizeClass].images.emplace_back(std::move(image));
+  ++m_stats.pooledBuffers;
+  m_stats.pooledBytes += capacity;
+}
+
+void ImagePool::SetCapacity(size_t capacity) {
+  std::scoped_lock lock{m_mutex};
+  m_capacity = capacity;
+  MakeRoom(0, kNumClasses);
+}
+
+ImagePoolStatistics ImagePool::GetStatistics() const {
+  std::scoped_lock lock{m_mutex};
+  return m_stats;
+}
+
+void ImagePool::Shutdown() {
+  // free the buffers after the lock is released
+  std::array<SizeClass, kNumClasses> classes;
+  {
+    std::scoped_lock lock{m_mutex};
+    m_shutdown = true;
+    classes.swap(m_classes);
+    m_stats.pooledBuffers = 0;
+    m_stats.pooledBytes = 0;
+  }
+}
@@ -0,0 +1,80 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef CSCORE_IMAGEPOOL_H_
+#define CSCORE_IMAGEPOOL_H_
+
+#include <stdint.h>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include <wpi/mutex.h>
+
+#include "Image.h"
+#include "cscore_cpp.h"
+
+namespace cs {
+
+// Pool of image buffers, to avoid repeatedly allocating and freeing large
+// buffers at the frame rate.  Buffers are grouped into size classes (four per
+// power of two), so a buffer can be reused for any image that rounds up to
+// the same class.  The total size of pooled (free) buffers is limited; when
+// the limit is reached, buffers of the least recently used size classes are
+// freed first, so changing resolution doesn't leave stale buffers behind.
+class ImagePool {
+ public:
+  static constexpr size_t kDefaultCapacity = 64 * 1024 * 1024;
+
+  explicit ImagePool(size_t capacity = kDefaultCapacity)
+      : m_capacity{capacity} {}
+
+  ImagePool(const ImagePool&) = delete;
+  ImagePool& operator=(const ImagePool&) = delete;
+
+  // Gets an empty image with capacity for at least size bytes.
+  std::unique_ptr<Image> Alloc(size_t size);
+
+  // Returns an image to the pool.  External images are discarded.
+  void Release(std::unique_ptr<Image> image);
+
+  // Sets the maximum total capacity of pooled buffers, in bytes.  0 disables
+  // pooling.
+  void SetCapacity(size_t capacity);
+
+  ImagePoolStatistics GetStatistics() const;
+
+  // Frees all pooled buffers; images released afterwards are discarded.
+  void Shutdown();
+
+  // Size class of an allocation of size bytes, and the buffer size of a size
+  // class.  Sizes too large to pool map to kNumClasses.
+  static size_t GetSizeClass(size_t size);
+  static size_t GetClassSize(size_t sizeClass);
+
+  static constexpr size_t kMinClassSize = 4096;
+  static constexpr size_t kNumClasses = 61;  // up to 128 MB
+
+ private:
+  struct SizeClass {
+    std::vector<std::unique_ptr<Image>> images;
+    uint64_t lastUse = 0;
+  };
+
+  // Frees buffers until bytes more fit within the capacity, without
+  // touching the except class.  Returns false if that isn't possible.
+  bool MakeRoom(size_t bytes, size_t except);
+
+  mutable wpi::mutex m_mutex;
+  std::array<SizeClass, kNumClasses> m_classes;
+  size_t m_capacity;
+  bool m_shutdown = false;
+  uint64_t m_useCount = 0;
+  ImagePoolStatistics m_stats;
+};
+
+}  // namespace cs
+
+#endif  // CSCORE_IMAGEPOOL_H_
@@ -0,0 +1,167 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "JpegCodec.h"
+
+#include <cstdlib>
+#include <vector>
+
+#include <opencv2/imgcodecs.hpp>
+
+#ifdef CSCORE_HAVE_TURBOJPEG
+#include <turbojpeg.h>
+#endif
+
+using namespace cs;
+
+namespace {
+
+class OpenCvJpegCodec final : public JpegCodec {
+ public:
+  std::string_view GetName() const override { return "opencv"; }
+
+  bool Decode(std::span<const uint8_t> data, cv::Mat& out) override {
+    int flags =
+        out.type() == CV_8UC3 ? cv::IMREAD_COLOR : cv::IMREAD_GRAYSCALE;
+    cv::Mat in{1, static_cast<int>(data.size()), CV_8UC1,
+               const_cast<uint8_t*>(data.data())};
+    cv::imdecode(in, flags, &out);
+    return !out.empty();
+  }
+
+  bool Encode(const cv::Mat& image, int quality, ImageBuffer& out) override {
+    // imencode requires a std::vector with the default allocator
+    thread_local std::vector<uchar> buf;
+    if (!cv::imencode(".jpg", image, buf,
+                      {cv::IMWRITE_JPEG_QUALITY, quality})) {
+      out.clear();
+      return false;
+    }
+    out.assign(buf.begin(), buf.end());
+    return true;
+  }
+};
+
+#ifdef CSCORE_HAVE_TURBOJPEG
+// libjpeg-turbo, which uses SIMD instructions on most platforms (including
+// ARM NEON), and avoids the intermediate copies made by OpenCV
+class TurboJpegCodec final : public JpegCodec {
+ public:
+  std::string_view GetName() const override { return "turbojpeg"; }
+
+  bool IsAvailable() const override {
+    auto& handles = GetHandles();
+    return handles.compress && handles.decompress;
+  }
+
+  bool Decode(std::span<const uint8_t> data, cv::Mat& out) override {
+    auto& handles = GetHandles();
+    if (!handles.decompress) {
+      return false;
+    }
+    int width, height, subsamp, colorspace;
+    if (tjDecompressHeader3(handles.decompress, data.data(), data.size(),
+                            &width, &height, &subsamp, &colorspace) != 0) {
+      return false;
+    }
+    int type = out.type() == CV_8UC3 ? CV_8UC3 : CV_8UC1;
+    out.create(height, width, type);
+    return tjDecompress2(handles.decompress, data.data(), data.size(),
+                         out.data, width, out.step, height,
+                         type == CV_8UC3 ? TJPF_BGR : TJPF_GRAY,
+                         TJFLAG_FASTDCT) == 0;
+  }
+
+  bool Encode(const cv::Mat& image, int quality, ImageBuffer& out) override {
+    auto& handles = GetHandles();
+    if (!handles.compress) {
+      return false;
+    }
+    int pixelFormat;
+    int subsamp;
+    if (image.type() == CV_8UC3) {
+      pixelFormat = TJPF_BGR;
+      subsamp = TJSAMP_420;
+    } else if (image.type() == CV_8UC1) {
+      pixelFormat = TJPF_GRAY;
+      subsamp = TJSAMP_GRAY;
+    } else {
+      return false;
+    }
+
+    // compress directly into the output to avoid a copy
+    out.resize(tjBufSize(image.cols, image.rows, subsamp));
+    unsigned char* buf = out.data();
+    unsigned long size = out.size();  // NOLINT(runtime/int)
+    if (tjCompress2(handles.compress, image.data, image.cols, image.step,
+                    image.rows, pixelFormat, &buf, &size, subsamp, quality,
+                    TJFLAG_NOREALLOC | TJFLAG_FASTDCT) != 0) {
+      out.clear();
+      return false;
+    }
+    out.resize(size);
+    return true;
+  }
+
+ private:
+  // TurboJPEG handles can't be shared between threads
+  struct Handles {
+    Handles() : compress{tjInitCompress()}, decompress{tjInitDecompress()} {}
+    ~Handles() {
+      if (compress) {
+        tjDestroy(compress);
+      }
+      if (decompress) {
+        tjDestroy(decompress);
+      }
+    }
+
+    Handles(const Handles&) = delete;
+    Handles& operator=(const Handles&) = delete;
+
+    tjhandle compress;
+    tjhandle decompress;
+  };
+
+  static Handles& GetHandles() {
+    static thread_local Handles handles;
+    return handles;
+  }
+};
+#endif
+
+}  // namespace
+
+static JpegCodec& SelectJpegCodec() {
+  static OpenCvJpegCodec opencv;
+#ifdef CSCORE_HAVE_TURBOJPEG
+  static TurboJpegCodec turbo;
+#endif
+  // in order of preference
+  JpegCodec* codecs[] = {
+#ifdef CSCORE_HAVE_TURBOJPEG
+      &turbo,
+#endif
+      &opencv,
+  };
+
+  if (const char* name = std::getenv("CSCORE_JPEG_CODEC")) {
+    for (auto codec : codecs) {
+      if (codec->GetName() == name && codec->IsAvailable()) {
+        return *codec;
+      }
+    }
+  }
+  for (auto codec : codecs) {
+    if (codec->IsAvailable()) {
+      return *codec;
+    }
+  }
+  return opencv;
+}
+
+JpegCodec& cs::GetJpegCodec() {
+  static JpegCodec& codec = SelectJpegCodec();
+  return codec;
+}
@@ -0,0 +1,48 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef CSCORE_JPEGCODEC_H_
+#define CSCORE_JPEGCODEC_H_
+
+#include <stdint.h>
+
+#include <span>
+#include <string_view>
+
+#include <opencv2/core/core.hpp>
+
+#include "Image.h"
+
+namespace cs {
+
+// JPEG compression and decompression backend used for Frame conversions.
+// Implementations must be safe to call from multiple threads.
+class JpegCodec {
+ public:
+  virtual ~JpegCodec() = default;
+
+  virtual std::string_view GetName() const = 0;
+
+  // Returns false if the codec can't be used on this system.
+  virtual bool IsAvailable() const { return true; }
+
+  // Decodes a JPEG image into out, which determines the output format:
+  // CV_8UC3 for BGR or CV_8UC1 for grayscale.  If the image dimensions
+  // don't match out, out is reallocated.
+  virtual bool Decode(std::span<const uint8_t> data, cv::Mat& out) = 0;
+
+  // Encodes a BGR (CV_8UC3) or grayscale (CV_8UC1) image.
+  virtual bool Encode(const cv::Mat& image, int quality,
+                      ImageBuffer& out) = 0;
+};
+
+// Gets the JPEG codec.  The fastest codec available at runtime is selected
+// on first use.  The selection can be overridden by setting the
+// CSCORE_JPEG_CODEC environment variable to the name of a codec
+// ("turbojpeg" or "opencv").
+JpegCodec& GetJpegCodec();
+
+}  // namespace cs
+
+#endif  // CSCORE_JPEGCODEC_H_
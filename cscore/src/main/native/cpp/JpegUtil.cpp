@@ -4,10 +4,13 @@
 
 #include "JpegUtil.h"
 
+#include <cstring>
 #include <string>
 
 #include <wpi/StringExtras.h>
-#include <wpi/raw_istream.h>
+
+#include "Image.h"
+#include "ReadaheadStream.h"
 
 namespace cs {
 
@@ -139,33 +142,70 @@ std::string_view JpegGetDHT() {
   return {reinterpret_cast<const char*>(dhtData), sizeof(dhtData)};
 }
 
-static inline void ReadInto(wpi::raw_istream& is, std::string& buf,
-                            size_t len) {
-  size_t oldSize = buf.size();
-  buf.resize(oldSize + len);
-  is.read(&(*buf.begin()) + oldSize, len);
+static inline void ReadInto(wpi::raw_istream& is, Image& image, size_t len) {
+  size_t oldSize = image.size();
+  image.resize(oldSize + len);
+  is.read(image.data() + oldSize, len);
+}
+
+// Copies entropy-coded data up to and including the byte following the 0xff
+// of the next marker, a chunk of buffered data at a time.  Byte stuffing
+// ensures we don't get false markers.
+static bool ReadEntropyCoded(ReadaheadStream& is, Image& image) {
+  bool maybeMarker = false;
+  for (;;) {
+    auto data = is.Peek();
+    if (data.empty()) {
+      return false;
+    }
+    auto bytes = reinterpret_cast<const unsigned char*>(data.data());
+    size_t i = 0;
+    for (;;) {
+      if (!maybeMarker) {
+        auto ff = std::memchr(bytes + i, 0xff, data.size() - i);
+        if (!ff) {
+          i = data.size();
+          break;
+        }
+        i = static_cast<const unsigned char*>(ff) - bytes + 1;
+        maybeMarker = true;
+      }
+      if (i == data.size()) {
+        break;
+      }
+      unsigned char byte = bytes[i++];
+      if (byte != 0x00 && byte != 0xff && (byte < 0xd0 || byte > 0xd7)) {
+        image.vec().insert(image.vec().end(), bytes, bytes + i);
+        is.Consume(i);
+        return true;
+      }
+      maybeMarker = byte == 0xff;
+    }
+    image.vec().insert(image.vec().end(), bytes, bytes + i);
+    is.Consume(i);
+  }
 }
 
-bool ReadJpeg(wpi::raw_istream& is, std::string& buf, int* width, int* height) {
+bool ReadJpeg(ReadaheadStream& is, Image& image, int* width, int* height) {
   // in case we don't get a SOF
   *width = 0;
   *height = 0;
 
   // read SOI and first marker
-  buf.resize(4);
-  is.read(&(*buf.begin()), 4);
+  image.resize(0);
+  ReadInto(is, image, 4);
   if (is.has_error()) {
     return false;
   }
 
   // Check for valid SOI
-  auto bytes = reinterpret_cast<const unsigned char*>(buf.data());
+  auto bytes = reinterpret_cast<const unsigned char*>(image.data());
   if (bytes[0] != 0xff || bytes[1] != 0xd8) {
     return false;
   }
   size_t pos = 2;  // point to first marker
   for (;;) {
-    bytes = reinterpret_cast<const unsigned char*>(buf.data() + pos);
+    bytes = reinterpret_cast<const unsigned char*>(image.data() + pos);
     if (bytes[0] != 0xff) {
       return false;  // not a marker
     }
@@ -177,48 +217,30 @@ bool ReadJpeg(wpi::raw_istream& is, std::string& buf, int* width, int* height) {
 
     if (marker == 0xda) {
       // SOS: need to keep reading until we reach a normal marker.
-      // Byte stuffing ensures we don't get false markers.
-      // Have to read a byte at a time as we don't want to overread.
-      pos += 2;  // point after SOS marker
-      bool maybeMarker = false;
-      for (;;) {
-        ReadInto(is, buf, 1);
-        if (is.has_error()) {
-          return false;
-        }
-        bytes = reinterpret_cast<const unsigned char*>(buf.data() + pos);
-        if (maybeMarker) {
-          if (bytes[0] != 0x00 && bytes[0] != 0xff &&
-              (bytes[0] < 0xd0 || bytes[0] > 0xd7)) {
-            break;
-          }
-          maybeMarker = false;
-        } else if (bytes[0] == 0xff) {
-          maybeMarker = true;
-        }
-        ++pos;  // point after byte we finished reading
+      if (!ReadEntropyCoded(is, image)) {
+        return false;
       }
-      --pos;  // point back to start of marker
+      pos = image.size() - 2;  // point to start of marker
       continue;
     }
 
     // A normal block. Read the length
-    ReadInto(is, buf, 2);  // read length
+    ReadInto(is, image, 2);  // read length
     if (is.has_error()) {
       return false;
     }
 
     // Point to length
     pos += 2;
-    bytes = reinterpret_cast<const unsigned char*>(buf.data() + pos);
+    bytes = reinterpret_cast<const unsigned char*>(image.data() + pos);
 
     // Read the block and the next marker
     size_t blockLength = bytes[0] * 256 + bytes[1];
-    ReadInto(is, buf, blockLength);
+    ReadInto(is, image, blockLength);
     if (is.has_error()) {
       return false;
     }
-    bytes = reinterpret_cast<const unsigned char*>(buf.data() + pos);
+    bytes = reinterpret_cast<const unsigned char*>(image.data() + pos);
 
     // Special block processing
     if (marker == 0xc0) {
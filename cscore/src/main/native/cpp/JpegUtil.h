@@ -8,12 +8,11 @@
 #include <string>
 #include <string_view>
 
-namespace wpi {
-class raw_istream;
-}  // namespace wpi
-
 namespace cs {
 
+class Image;
+class ReadaheadStream;
+
 bool IsJpeg(std::string_view data);
 
 bool GetJpegSize(std::string_view data, int* width, int* height);
@@ -22,7 +21,8 @@ bool JpegNeedsDHT(const char* data, size_t* size, size_t* locSOF);
 
 std::string_view JpegGetDHT();
 
-bool ReadJpeg(wpi::raw_istream& is, std::string& buf, int* width, int* height);
+// Reads a JPEG image of unknown length into image by following its markers.
+bool ReadJpeg(ReadaheadStream& is, Image& image, int* width, int* height);
 
 }  // namespace cs
 
@@ -0,0 +1,65 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <algorithm>
+#include <bit>
+
+#include "cscore_cpp.h"
+
+using namespace cs;
+
+static constexpr int kMinBit = 4;  // first bucket is below 2^kMinBit us
+
+int LatencyHistogram::GetBucket(int64_t us) {
+  if (us < (int64_t{1} << kMinBit)) {
+    return 0;
+  }
+  int bit = std::bit_width(static_cast<uint64_t>(us)) - 1;
+  int quarter = (us >> (bit - 2)) & 3;
+  return std::min(1 + (bit - kMinBit) * 4 + quarter, kNumBuckets - 1);
+}
+
+int64_t LatencyHistogram::GetBucketUpperBound(int bucket) {
+  if (bucket <= 0) {
+    return int64_t{1} << kMinBit;
+  }
+  if (bucket >= kNumBuckets - 1) {
+    return INT64_MAX;
+  }
+  int bit = kMinBit + (bucket - 1) / 4;
+  return int64_t{5 + (bucket - 1) % 4} << (bit - 2);
+}
+
+void LatencyHistogram::Record(int64_t us) {
+  if (us < 0) {
+    us = 0;
+  }
+  ++count;
+  sum += us;
+  max = std::max(max, us);
+  ++buckets[GetBucket(us)];
+}
+
+double LatencyHistogram::GetMean() const {
+  return count == 0 ? 0.0 : static_cast<double>(sum) / count;
+}
+
+double LatencyHistogram::GetPercentile(double percentile) const {
+  if (count == 0) {
+    return 0.0;
+  }
+  double rank = std::clamp(percentile, 0.0, 100.0) / 100.0 * count;
+  int64_t below = 0;
+  for (int i = 0; i < kNumBuckets; ++i) {
+    if (buckets[i] == 0 || below + buckets[i] < rank) {
+      below += buckets[i];
+      continue;
+    }
+    double lower = i == 0 ? 0.0 : GetBucketUpperBound(i - 1);
+    double upper = std::min(GetBucketUpperBound(i), max + 1);
+    double value = lower + (upper - lower) * (rank - below) / buckets[i];
+    return std::min(value, static_cast<double>(max));
+  }
+  return max;
+}
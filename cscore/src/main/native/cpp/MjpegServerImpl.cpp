@@ -4,15 +4,20 @@
 
 #include "MjpegServerImpl.h"
 
+#include <algorithm>
 #include <chrono>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <wpi/SmallString.h>
 #include <wpi/StringExtras.h>
+#include <wpi/ThreadRegistry.h>
+#include <wpi/condition_variable.h>
 #include <wpi/fmt/raw_ostream.h>
 #include <wpi/print.h>
+#include <wpi/timestamp.h>
 #include <wpinet/HttpUtil.h>
 #include <wpinet/TCPAcceptor.h>
 #include <wpinet/raw_socket_istream.h>
@@ -75,6 +80,234 @@ static const char* startRootPage =
     "<div class=\"settings\">\n";
 static const char* endRootPage = "</div></body></html>";
 
+// Frame selection and JPEG encoding for all client streams with the same
+// settings.  Clients at the same FPS limit would otherwise each pick their
+// own subset of the source frames, and each of those frames would need its
+// own encode; sharing them makes it one encode per sent frame regardless of
+// the number of clients.
+class MjpegServerImpl::SharedStream {
+ public:
+  struct Settings {
+    int width;
+    int height;
+    int compression;
+    int defaultCompression;
+    int fps;
+
+    bool operator==(const Settings&) const = default;
+  };
+
+  enum Result { kFrame, kNoFrame, kDropped, kBadImage };
+
+  explicit SharedStream(const Settings& settings_) : settings{settings_} {
+    if (settings.fps != 0) {
+      m_timePerFrame = 1000000.0 / settings.fps;
+    }
+    if (m_averagePeriod < m_timePerFrame) {
+      m_averagePeriod = m_timePerFrame * 10;
+    }
+  }
+
+  // Gets the most recent frame to send, waiting for a new one if the client
+  // has already sent it (lastTime is the time of the last frame sent).  Only
+  // one client fetches a new frame at a time; the others wait for its
+  // result.  Returns kFrame and sets frame and image if there's a frame to
+  // send.
+  Result GetNextFrame(SourceImpl& source, Frame::Time lastTime, Frame* frame,
+                      Image** image);
+
+  const Settings settings;
+
+ private:
+  Result Fetch(SourceImpl& source, Frame* frame, Image** image);
+
+  wpi::mutex m_mutex;
+  wpi::condition_variable m_cond;
+  bool m_fetching = false;
+  uint64_t m_fetchCount = 0;
+  Result m_result = kNoFrame;
+  Frame m_frame;
+  Image* m_image = nullptr;
+
+  // Only accessed by the fetching client
+  Frame::Time m_timePerFrame = 0;
+  Frame::Time m_averagePeriod = 1000000;  // 1 second window
+  Frame::Time m_averageFrameTime = 0;
+  Frame::Time m_lastFrameTime = 0;
+};
+
+struct MjpegServerImpl::SharedStreams {
+  std::shared_ptr<SharedStream> Get(const SharedStream::Settings& settings);
+
+  wpi::mutex mutex;
+  std::vector<std::weak_ptr<SharedStream>> streams;
+};
+
+MjpegServerImpl::SharedStream::Result
+MjpegServerImpl::SharedStream::GetNextFrame(SourceImpl& source,
+                                            Frame::Time lastTime, Frame* frame,
+                                            Image** image) {
+  std::unique_lock lock(m_mutex);
+  if (m_image && m_frame.GetTime() != lastTime) {
+    *frame = m_frame;
+    *image = m_image;
+    return kFrame;
+  }
+
+  if (m_fetching) {
+    // wait for the fetching client
+    uint64_t fetchCount = m_fetchCount;
+    m_cond.wait(lock, [&] { return m_fetchCount != fetchCount; });
+    if (m_result == kFrame) {
+      *frame = m_frame;
+      *image = m_image;
+    }
+    return m_result;
+  }
+
+  m_fetching = true;
+  lock.unlock();
+  Frame newFrame;
+  Image* newImage = nullptr;
+  Result result = Fetch(source, &newFrame, &newImage);
+  lock.lock();
+  if (result == kFrame) {
+    m_frame = newFrame;
+    m_image = newImage;
+    *frame = std::move(newFrame);
+    *image = newImage;
+  }
+  m_result = result;
+  ++m_fetchCount;
+  m_fetching = false;
+  lock.unlock();
+  m_cond.notify_all();
+  return result;
+}
+
+MjpegServerImpl::SharedStream::Result MjpegServerImpl::SharedStream::Fetch(
+    SourceImpl& source, Frame* frame, Image** image) {
+  Frame newFrame = source.GetNextFrame(0.225);  // blocks
+  if (!newFrame) {
+    return kNoFrame;
+  }
+
+  auto thisFrameTime = newFrame.GetTime();
+  if (thisFrameTime != 0 && m_timePerFrame != 0 && m_lastFrameTime != 0) {
+    Frame::Time deltaTime = thisFrameTime - m_lastFrameTime;
+
+    // drop frame if it is early compared to the desired frame rate AND
+    // the current average is higher than the desired average
+    if (deltaTime < m_timePerFrame && m_averageFrameTime < m_timePerFrame) {
+      return kDropped;
+    }
+
+    // update average
+    if (m_averageFrameTime != 0) {
+      m_averageFrameTime = m_averageFrameTime *
+                               (m_averagePeriod - m_timePerFrame) /
+                               m_averagePeriod +
+                           deltaTime * m_timePerFrame / m_averagePeriod;
+    } else {
+      m_averageFrameTime = deltaTime;
+    }
+  }
+
+  int width = settings.width != 0 ? settings.width
+                                  : newFrame.GetOriginalWidth();
+  int height = settings.height != 0 ? settings.height
+                                    : newFrame.GetOriginalHeight();
+  Image* newImage = newFrame.GetImageMJPEG(
+      width, height, settings.compression,
+      settings.compression == -1 ? settings.defaultCompression
+                                 : settings.compression);
+  if (!newImage || newImage->pixelFormat != VideoMode::kMJPEG) {
+    return kBadImage;
+  }
+
+  m_lastFrameTime = thisFrameTime;
+  *frame = std::move(newFrame);
+  *image = newImage;
+  return kFrame;
+}
+
+std::shared_ptr<MjpegServerImpl::SharedStream>
+MjpegServerImpl::SharedStreams::Get(const SharedStream::Settings& settings) {
+  std::scoped_lock lock(mutex);
+  std::erase_if(streams, [](const auto& stream) { return stream.expired(); });
+  for (auto&& weakStream : streams) {
+    auto stream = weakStream.lock();
+    if (stream && stream->settings == settings) {
+      return stream;
+    }
+  }
+  auto stream = std::make_shared<SharedStream>(settings);
+  streams.emplace_back(stream);
+  return stream;
+}
+
+// Per-client stream degradation for slow links.  Sends block once the
+// socket send buffer is full, so the time to send a frame measures how far
+// the link is behind.  Sends slower than kMaxSendTime step down the JPEG
+// quality and then the resolution; a run of fast sends steps back up.  Frames
+// that arrive while a send is blocked are skipped, as the next send always
+// takes the newest frame.
+class StreamRateControl {
+ public:
+  static constexpr Frame::Time kMaxSendTime = 100000;  // 100 ms
+  static constexpr int kRecoverFrames = 30;
+  static constexpr int kQualityStep = 15;
+  static constexpr int kMinQuality = 20;
+  static constexpr int kMaxLevel = 6;
+
+  // Records the time taken to send a frame; returns true if the level changed
+  bool Update(Frame::Time sendTime) {
+    if (sendTime > kMaxSendTime) {
+      m_fastCount = 0;
+      if (m_level < kMaxLevel) {
+        ++m_level;
+        return true;
+      }
+    } else if (m_level > 0 && sendTime < kMaxSendTime / 4 &&
+               ++m_fastCount >= kRecoverFrames) {
+      m_fastCount = 0;
+      --m_level;
+      return true;
+    }
+    return false;
+  }
+
+  int GetLevel() const { return m_level; }
+
+  // Applies the current level to the client's requested settings.  The
+  // first levels lower the quality; once it reaches kMinQuality, each
+  // further level halves the resolution.
+  void Apply(int* width, int* height, int* compression,
+             int defaultCompression, int originalWidth,
+             int originalHeight) const {
+    if (m_level == 0) {
+      return;
+    }
+    int quality = *compression == -1 ? defaultCompression : *compression;
+    int level = m_level;
+    while (level > 0 && quality > kMinQuality) {
+      quality = std::max(quality - kQualityStep, kMinQuality);
+      --level;
+    }
+    *compression = quality;
+    if (level > 0) {
+      int w = *width != 0 ? *width : originalWidth;
+      int h = *height != 0 ? *height : originalHeight;
+      *width = std::max(w >> level, 1);
+      *height = std::max(h >> level, 1);
+    }
+  }
+
+ private:
+  int m_level = 0;
+  int m_fastCount = 0;
+};
+
 class MjpegServerImpl::ConnThread : public wpi::SafeThread {
  public:
   explicit ConnThread(std::string_view name, wpi::Logger& logger)
@@ -92,6 +325,7 @@ class MjpegServerImpl::ConnThread : public wpi::SafeThread {
 
   std::unique_ptr<wpi::NetworkStream> m_stream;
   std::shared_ptr<SourceImpl> m_source;
+  std::shared_ptr<SharedStreams> m_sharedStreams;
   bool m_streaming = false;
   bool m_noStreaming = false;
   int m_width = 0;
@@ -100,6 +334,11 @@ class MjpegServerImpl::ConnThread : public wpi::SafeThread {
   int m_defaultCompression = 80;
   int m_fps = 0;
 
+  // The images streaming requests from each frame
+  SinkDemand GetDemand() const {
+    return {VideoMode::kMJPEG, m_width, m_height};
+  }
+
  private:
   std::string m_name;
   wpi::Logger& m_logger;
@@ -114,6 +353,7 @@ class MjpegServerImpl::ConnThread : public wpi::SafeThread {
   void StartStream() {
     std::scoped_lock lock(m_mutex);
     if (m_source) {
+      m_source->SetSinkDemand(this, GetDemand());
       m_source->EnableSink();
     }
     m_streaming = true;
@@ -122,6 +362,7 @@ class MjpegServerImpl::ConnThread : public wpi::SafeThread {
   void StopStream() {
     std::scoped_lock lock(m_mutex);
     if (m_source) {
+      m_source->RemoveSinkDemand(this);
       m_source->DisableSink();
     }
     m_streaming = false;
@@ -604,7 +845,8 @@ MjpegServerImpl::MjpegServerImpl(std::string_view name, wpi::Logger& logger,
     : SinkImpl{name, logger, notifier, telemetry},
       m_listenAddress(listenAddress),
       m_port(port),
-      m_acceptor{std::move(acceptor)} {
+      m_acceptor{std::move(acceptor)},
+      m_sharedStreams{std::make_shared<SharedStreams>()} {
   m_active = true;
 
   SetDescription(fmt::format("HTTP Server on port {}", port));
@@ -680,16 +922,10 @@ void MjpegServerImpl::ConnThread::SendStream(wpi::raw_socket_ostream& os) {
 
   SDEBUG("Headers send, sending stream now");
 
+  auto stream = m_sharedStreams->Get(
+      {m_width, m_height, m_compression, m_defaultCompression, m_fps});
   Frame::Time lastFrameTime = 0;
-  Frame::Time timePerFrame = 0;
-  if (m_fps != 0) {
-    timePerFrame = 1000000.0 / m_fps;
-  }
-  Frame::Time averageFrameTime = 0;
-  Frame::Time averagePeriod = 1000000;  // 1 second window
-  if (averagePeriod < timePerFrame) {
-    averagePeriod = timePerFrame * 10;
-  }
+  StreamRateControl rateControl;
 
   StartStream();
   while (m_active && !os.has_error()) {
@@ -701,76 +937,47 @@ void MjpegServerImpl::ConnThread::SendStream(wpi::raw_socket_ostream& os) {
       continue;
     }
     SDEBUG4("waiting for frame");
-    Frame frame = source->GetNextFrame(0.225);  // blocks
+    Frame frame;
+    Image* image = nullptr;
+    auto result =
+        stream->GetNextFrame(*source, lastFrameTime, &frame, &image);  // blocks
     if (!m_active) {
       break;
     }
-    if (!frame) {
-      // Bad frame; sleep for 20 ms so we don't consume all processor time.
-      os << "\r\n";  // Keep connection alive
-      std::this_thread::sleep_for(std::chrono::milliseconds(20));
-      continue;
-    }
-
-    auto thisFrameTime = frame.GetTime();
-    if (thisFrameTime != 0 && timePerFrame != 0 && lastFrameTime != 0) {
-      Frame::Time deltaTime = thisFrameTime - lastFrameTime;
-
-      // drop frame if it is early compared to the desired frame rate AND
-      // the current average is higher than the desired average
-      if (deltaTime < timePerFrame && averageFrameTime < timePerFrame) {
-        // sleep for 1 ms so we don't consume all processor time
+    switch (result) {
+      case SharedStream::kFrame:
+        break;
+      case SharedStream::kNoFrame:
+        // Bad frame; sleep for 20 ms so we don't consume all processor time.
+        os << "\r\n";  // Keep connection alive
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        continue;
+      case SharedStream::kDropped:
+        // Early frame; sleep for 1 ms so we don't consume all processor time
         std::this_thread::sleep_for(std::chrono::milliseconds(1));
         continue;
-      }
-
-      // update average
-      if (averageFrameTime != 0) {
-        averageFrameTime =
-            averageFrameTime * (averagePeriod - timePerFrame) / averagePeriod +
-            deltaTime * timePerFrame / averagePeriod;
-      } else {
-        averageFrameTime = deltaTime;
-      }
-    }
-
-    int width = m_width != 0 ? m_width : frame.GetOriginalWidth();
-    int height = m_height != 0 ? m_height : frame.GetOriginalHeight();
-    Image* image = frame.GetImageMJPEG(
-        width, height, m_compression,
-        m_compression == -1 ? m_defaultCompression : m_compression);
-    if (!image) {
-      // Shouldn't happen, but just in case...
-      std::this_thread::sleep_for(std::chrono::milliseconds(20));
-      continue;
+      case SharedStream::kBadImage:
+      default:
+        // Shouldn't happen, but just in case...
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        continue;
     }
+    frame.RecordLatency(CS_LATENCY_DELIVERY, frame.GetPutTime());
 
+    // Determine if we need to add DHT to it, and allocate enough space for
+    // adding it if required.
     const char* data = image->data();
     size_t size = image->size();
-    bool addDHT = false;
     size_t locSOF = size;
-    switch (image->pixelFormat) {
-      case VideoMode::kMJPEG:
-        // Determine if we need to add DHT to it, and allocate enough space
-        // for adding it if required.
-        addDHT = JpegNeedsDHT(data, &size, &locSOF);
-        break;
-      case VideoMode::kUYVY:
-      case VideoMode::kRGB565:
-      case VideoMode::kYUYV:
-      case VideoMode::kY16:
-      default:
-        // Bad frame; sleep for 10 ms so we don't consume all processor time.
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
-        continue;
-    }
+    bool addDHT = JpegNeedsDHT(data, &size, &locSOF);
 
     SDEBUG4("sending frame size={} addDHT={}", size, addDHT);
 
     // print the individual mimetype and the length
     // sending the content-length fixes random stream disruption observed
     // with firefox
-    lastFrameTime = thisFrameTime;
+    lastFrameTime = frame.GetTime();
+    Frame::Time sendStart = wpi::Now();
     double timestamp = lastFrameTime / 1000000.0;
     header.clear();
     oss << "\r\n--" BOUNDARY "\r\n"
@@ -788,6 +995,20 @@ void MjpegServerImpl::ConnThread::SendStream(wpi::raw_socket_ostream& os) {
       os << std::string_view(data, size);
     }
     // os.flush();
+    frame.RecordLatency(CS_LATENCY_SEND, sendStart);
+    frame.RecordLatency(CS_LATENCY_TOTAL, lastFrameTime);
+
+    if (rateControl.Update(wpi::Now() - sendStart)) {
+      int width = m_width;
+      int height = m_height;
+      int compression = m_compression;
+      rateControl.Apply(&width, &height, &compression, m_defaultCompression,
+                        frame.GetOriginalWidth(), frame.GetOriginalHeight());
+      SDEBUG("stream rate level {}: {}x{} quality {}", rateControl.GetLevel(),
+             width, height, compression);
+      stream = m_sharedStreams->Get(
+          {width, height, compression, m_defaultCompression, m_fps});
+    }
   }
   StopStream();
 }
@@ -921,6 +1142,7 @@ void MjpegServerImpl::ConnThread::ProcessRequest() {
 
 // worker thread for clients that connected to this server
 void MjpegServerImpl::ConnThread::Main() {
+  wpi::SetCurrentThreadClass(wpi::ThreadClass::kCamera, "MjpegConn");
   std::unique_lock lock(m_mutex);
   while (m_active) {
     while (!m_stream) {
@@ -938,6 +1160,7 @@ void MjpegServerImpl::ConnThread::Main() {
 
 // Main server thread
 void MjpegServerImpl::ServerThreadMain() {
+  wpi::SetCurrentThreadClass(wpi::ThreadClass::kCamera, "MjpegServer");
   if (m_acceptor->start() != 0) {
     m_active = false;
     return;
@@ -984,6 +1207,7 @@ void MjpegServerImpl::ServerThreadMain() {
     auto thr = it->GetThread();
     thr->m_stream = std::move(stream);
     thr->m_source = source;
+    thr->m_sharedStreams = m_sharedStreams;
     thr->m_noStreaming = nstreams >= 10;
     thr->m_width = GetProperty(m_widthProp)->value;
     thr->m_height = GetProperty(m_heightProp)->value;
@@ -1003,10 +1227,12 @@ void MjpegServerImpl::SetSourceImpl(std::shared_ptr<SourceImpl> source) {
       if (thr->m_source != source) {
         bool streaming = thr->m_streaming;
         if (thr->m_source && streaming) {
+          thr->m_source->RemoveSinkDemand(&*thr);
           thr->m_source->DisableSink();
         }
         thr->m_source = source;
         if (source && streaming) {
+          thr->m_source->SetSinkDemand(&*thr, thr->GetDemand());
           thr->m_source->EnableSink();
         }
       }
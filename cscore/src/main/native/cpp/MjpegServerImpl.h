@@ -44,6 +44,8 @@ class MjpegServerImpl : public SinkImpl {
   void ServerThreadMain();
 
   class ConnThread;
+  class SharedStream;
+  struct SharedStreams;
 
   // Never changed, so not protected by mutex
   std::string m_listenAddress;
@@ -55,6 +57,9 @@ class MjpegServerImpl : public SinkImpl {
 
   std::vector<wpi::SafeThreadOwner<ConnThread>> m_connThreads;
 
+  // Handed to connection threads, which may outlive the server
+  std::shared_ptr<SharedStreams> m_sharedStreams;
+
   // property indices
   int m_widthProp;
   int m_heightProp;
@@ -5,13 +5,20 @@
 #include "RawSinkImpl.h"
 
 #include <algorithm>
+#include <chrono>
 #include <memory>
+#include <utility>
+#include <vector>
 
+#include "FrameSync.h"
 #include "Instance.h"
 #include "cscore_raw.h"
 
 using namespace cs;
 
+// Frames queued by each sink for GrabSinkFrameSet()
+static constexpr int kFrameSetQueueSize = 4;
+
 RawSinkImpl::RawSinkImpl(std::string_view name, wpi::Logger& logger,
                          Notifier& notifier, Telemetry& telemetry)
     : SinkImpl{name, logger, notifier, telemetry} {
@@ -22,7 +29,9 @@ RawSinkImpl::RawSinkImpl(std::string_view name, wpi::Logger& logger,
 RawSinkImpl::RawSinkImpl(std::string_view name, wpi::Logger& logger,
                          Notifier& notifier, Telemetry& telemetry,
                          std::function<void(uint64_t time)> processFrame)
-    : SinkImpl{name, logger, notifier, telemetry} {}
+    : SinkImpl{name, logger, notifier, telemetry} {
+  m_active = true;
+}
 
 RawSinkImpl::~RawSinkImpl() {
   Stop();
@@ -40,6 +49,18 @@ void RawSinkImpl::Stop() {
   if (m_thread.joinable()) {
     m_thread.join();
   }
+
+  std::thread queueThread;
+  {
+    std::scoped_lock lock(m_queueMutex);
+    ++m_queueGeneration;
+    queueThread = std::move(m_queueThread);
+    m_queue.clear();
+  }
+  m_queueCv.notify_all();
+  if (queueThread.joinable()) {
+    queueThread.join();
+  }
 }
 
 uint64_t RawSinkImpl::GrabFrame(WPI_RawFrame& image) {
@@ -68,6 +89,16 @@ uint64_t RawSinkImpl::GrabFrame(WPI_RawFrame& image, double timeout) {
 
 uint64_t RawSinkImpl::GrabFrame(WPI_RawFrame& image, double timeout,
                                 uint64_t lastFrameTime) {
+  return GrabNextFrame(image, timeout, lastFrameTime, false);
+}
+
+uint64_t RawSinkImpl::BorrowFrame(WPI_RawFrame& image, double timeout,
+                                  uint64_t lastFrameTime) {
+  return GrabNextFrame(image, timeout, lastFrameTime, true);
+}
+
+uint64_t RawSinkImpl::GrabNextFrame(WPI_RawFrame& image, double timeout,
+                                    uint64_t lastFrameTime, bool borrow) {
   SetEnabled(true);
 
   auto source = GetSource();
@@ -84,11 +115,18 @@ uint64_t RawSinkImpl::GrabFrame(WPI_RawFrame& image, double timeout,
     return 0;  // signal error
   }
 
-  return GrabFrameImpl(image, frame);
+  return GrabFrameImpl(image, frame, borrow ? source : nullptr);
+}
+
+// Frees a borrowed image by releasing the frame holding it
+static void ReleaseBorrowedFrame(void* cbdata, void*, size_t) {
+  delete static_cast<RawSinkImpl::BorrowedFrame*>(cbdata);
 }
 
 uint64_t RawSinkImpl::GrabFrameImpl(WPI_RawFrame& rawFrame,
-                                    Frame& incomingFrame) {
+                                    Frame& incomingFrame,
+                                    std::shared_ptr<SourceImpl> borrowSource) {
+  incomingFrame.RecordLatency(CS_LATENCY_DELIVERY, incomingFrame.GetPutTime());
   Image* newImage = nullptr;
 
   if (rawFrame.pixelFormat == WPI_PixelFormat::WPI_PIXFMT_UNKNOWN) {
@@ -100,6 +138,7 @@ uint64_t RawSinkImpl::GrabFrameImpl(WPI_RawFrame& rawFrame,
     auto height = rawFrame.height;
     auto pixelFormat =
         static_cast<VideoMode::PixelFormat>(rawFrame.pixelFormat);
+    SetDemand({pixelFormat, width, height});
     if (width <= 0 || height <= 0) {
       width = incomingFrame.GetOriginalWidth();
       height = incomingFrame.GetOriginalHeight();
@@ -113,19 +152,160 @@ uint64_t RawSinkImpl::GrabFrameImpl(WPI_RawFrame& rawFrame,
     return 0;
   }
 
-  WPI_AllocateRawFrameData(&rawFrame, newImage->size());
+  if (borrowSource) {
+    // Point at the image instead of copying it; the frame (and the source
+    // whose pool the image came from) is held until the data is freed
+    WPI_SetRawFrameData(
+        &rawFrame, newImage->data(), newImage->size(), newImage->size(),
+        new BorrowedFrame{std::move(borrowSource), incomingFrame},
+        ReleaseBorrowedFrame);
+  } else {
+    // Never copy into a previously borrowed image
+    if (rawFrame.freeFunc == ReleaseBorrowedFrame) {
+      WPI_FreeRawFrameData(&rawFrame);
+    }
+    WPI_AllocateRawFrameData(&rawFrame, newImage->size());
+    std::copy(newImage->data(), newImage->data() + newImage->size(),
+              rawFrame.data);
+  }
   rawFrame.height = newImage->height;
   rawFrame.width = newImage->width;
   rawFrame.stride = newImage->GetStride();
   rawFrame.pixelFormat = newImage->pixelFormat;
   rawFrame.size = newImage->size();
-  std::copy(newImage->data(), newImage->data() + rawFrame.size, rawFrame.data);
   rawFrame.timestamp = incomingFrame.GetTime();
   rawFrame.timestampSrc = incomingFrame.GetTimeSource();
+  incomingFrame.RecordLatency(CS_LATENCY_TOTAL, incomingFrame.GetTime());
 
   return incomingFrame.GetTime();
 }
 
+void RawSinkImpl::SetFrameQueueSize(int size) {
+  std::thread oldThread;
+  {
+    std::scoped_lock lock(m_queueMutex);
+    m_queueSize = size > 0 ? size : 0;
+    while (m_queue.size() > m_queueSize) {
+      m_queue.pop_front();
+    }
+    if (m_queueSize == 0 || !m_active) {
+      ++m_queueGeneration;
+      oldThread = std::move(m_queueThread);
+    } else if (!m_queueThread.joinable()) {
+      m_queueThread = std::thread(&RawSinkImpl::QueueThreadMain, this,
+                                  m_queueGeneration);
+    }
+  }
+  m_queueCv.notify_all();
+  // exits after its current frame wait times out
+  if (oldThread.joinable()) {
+    oldThread.join();
+  }
+}
+
+int RawSinkImpl::GrabFrames(std::span<WPI_RawFrame* const> frames,
+                            double timeout) {
+  if (frames.empty()) {
+    return 0;
+  }
+
+  std::deque<QueuedFrame> queued;
+  {
+    std::unique_lock lock(m_queueMutex);
+    if (m_queueSize == 0) {
+      lock.unlock();
+      SetFrameQueueSize(frames.size());
+      lock.lock();
+    }
+    if (m_queue.empty() && timeout > 0) {
+      m_queueCv.wait_for(lock, std::chrono::duration<double>(timeout),
+                         [&] { return !m_queue.empty() || !m_active; });
+    }
+    // only the most recent frames are returned
+    while (m_queue.size() > frames.size()) {
+      m_queue.pop_front();
+    }
+    queued.swap(m_queue);
+  }
+
+  int count = 0;
+  for (auto&& q : queued) {
+    if (GrabFrameImpl(*frames[count], q.frame) != 0) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+void RawSinkImpl::GetQueuedFrameTimes(std::vector<uint64_t>& times,
+                                      int queueSize) {
+  times.clear();
+  std::unique_lock lock(m_queueMutex);
+  if (m_queueSize == 0) {
+    lock.unlock();
+    SetFrameQueueSize(queueSize);
+    return;
+  }
+  for (auto&& q : m_queue) {
+    times.emplace_back(q.frame.GetTime());
+  }
+}
+
+void RawSinkImpl::WaitForQueuedFrame(uint64_t time, double timeout) {
+  std::unique_lock lock(m_queueMutex);
+  m_queueCv.wait_for(lock, std::chrono::duration<double>(timeout), [&] {
+    return !m_active ||
+           (!m_queue.empty() && m_queue.back().frame.GetTime() > time);
+  });
+}
+
+uint64_t RawSinkImpl::TakeQueuedFrame(uint64_t time, WPI_RawFrame* frame) {
+  QueuedFrame taken;
+  {
+    std::scoped_lock lock(m_queueMutex);
+    while (!m_queue.empty() && m_queue.front().frame.GetTime() < time) {
+      m_queue.pop_front();
+    }
+    if (!frame || m_queue.empty() ||
+        m_queue.front().frame.GetTime() != time) {
+      return 0;
+    }
+    taken = std::move(m_queue.front());
+    m_queue.pop_front();
+  }
+  return GrabFrameImpl(*frame, taken.frame);
+}
+
+void RawSinkImpl::QueueThreadMain(unsigned generation) {
+  Enable();
+  Frame::Time lastFrameTime = 0;
+  while (m_active) {
+    auto source = GetSource();
+    Frame frame;
+    if (source) {
+      frame = source->GetNextFrame(0.225, lastFrameTime);  // blocks
+    } else {
+      // Source disconnected; sleep so we don't consume all processor time.
+      std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    }
+
+    std::scoped_lock lock(m_queueMutex);
+    if (generation != m_queueGeneration) {
+      break;
+    }
+    if (!frame) {
+      continue;
+    }
+    lastFrameTime = frame.GetTime();
+    if (m_queue.size() >= m_queueSize) {
+      m_queue.pop_front();
+    }
+    m_queue.push_back({std::move(source), std::move(frame)});
+    m_queueCv.notify_all();
+  }
+  Disable();
+}
+
 // Send HTTP response and a stream of JPG-frames
 void RawSinkImpl::ThreadMain() {
   Enable();
@@ -202,6 +382,98 @@ uint64_t GrabSinkFrameTimeoutLastTime(CS_Sink sink, WPI_RawFrame& image,
       .GrabFrame(image, timeout, lastFrameTime);
 }
 
+uint64_t BorrowSinkFrame(CS_Sink sink, WPI_RawFrame& image, double timeout,
+                         uint64_t lastFrameTime, CS_Status* status) {
+  auto data = Instance::GetInstance().GetSink(sink);
+  if (!data || (data->kind & SinkMask) == 0) {
+    *status = CS_INVALID_HANDLE;
+    return 0;
+  }
+  return static_cast<RawSinkImpl&>(*data->sink)
+      .BorrowFrame(image, timeout, lastFrameTime);
+}
+
+void SetSinkFrameQueueSize(CS_Sink sink, int size, CS_Status* status) {
+  auto data = Instance::GetInstance().GetSink(sink);
+  if (!data || (data->kind & SinkMask) == 0) {
+    *status = CS_INVALID_HANDLE;
+    return;
+  }
+  static_cast<RawSinkImpl&>(*data->sink).SetFrameQueueSize(size);
+}
+
+int GrabSinkFrames(CS_Sink sink, std::span<WPI_RawFrame* const> images,
+                   double timeout, CS_Status* status) {
+  auto data = Instance::GetInstance().GetSink(sink);
+  if (!data || (data->kind & SinkMask) == 0) {
+    *status = CS_INVALID_HANDLE;
+    return 0;
+  }
+  return static_cast<RawSinkImpl&>(*data->sink).GrabFrames(images, timeout);
+}
+
+uint64_t GrabSinkFrameSet(std::span<const CS_Sink> sinks,
+                          std::span<WPI_RawFrame* const> images,
+                          uint64_t window, double timeout, CS_Status* status) {
+  if (sinks.empty() || images.size() != sinks.size()) {
+    *status = CS_INVALID_HANDLE;
+    return 0;
+  }
+  wpi::SmallVector<std::shared_ptr<SinkImpl>, 4> impls;
+  for (auto sink : sinks) {
+    auto data = Instance::GetInstance().GetSink(sink);
+    if (!data || (data->kind & SinkMask) == 0) {
+      *status = CS_INVALID_HANDLE;
+      return 0;
+    }
+    impls.emplace_back(data->sink);
+  }
+  auto raw = [&](size_t i) -> RawSinkImpl& {
+    return static_cast<RawSinkImpl&>(*impls[i]);
+  };
+
+  auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::duration<double>(timeout);
+  std::vector<std::vector<uint64_t>> times(impls.size());
+  for (;;) {
+    for (size_t i = 0; i < impls.size(); ++i) {
+      raw(i).GetQueuedFrameTimes(times[i], kFrameSetQueueSize);
+    }
+    auto match = MatchFrameTimes(times, window);
+    if (match.matched) {
+      // the queue may have dropped a chosen frame since the times were read;
+      // if so, try again
+      uint64_t setTime = UINT64_MAX;
+      bool ok = true;
+      for (size_t i = 0; i < impls.size(); ++i) {
+        if (raw(i).TakeQueuedFrame(match.times[i], images[i]) == 0) {
+          ok = false;
+        }
+        setTime = std::min(setTime, match.times[i]);
+      }
+      if (ok) {
+        return setTime;
+      }
+    } else {
+      for (size_t i = 0; i < impls.size(); ++i) {
+        raw(i).TakeQueuedFrame(match.dropBefore, nullptr);
+      }
+    }
+
+    std::chrono::duration<double> remaining =
+        deadline - std::chrono::steady_clock::now();
+    if (remaining.count() <= 0) {
+      return 0;
+    }
+    if (match.matched) {
+      continue;
+    }
+    uint64_t newest =
+        times[match.waitSink].empty() ? 0 : times[match.waitSink].back();
+    raw(match.waitSink).WaitForQueuedFrame(newest, remaining.count());
+  }
+}
+
 }  // namespace cs
 
 extern "C" {
@@ -237,4 +509,35 @@ uint64_t CS_GrabRawSinkFrameTimeoutWithFrameTime(CS_Sink sink,
                                           status);
 }
 
+uint64_t CS_BorrowRawSinkFrame(CS_Sink sink, struct WPI_RawFrame* image,
+                               double timeout, uint64_t lastFrameTime,
+                               CS_Status* status) {
+  return cs::BorrowSinkFrame(sink, *image, timeout, lastFrameTime, status);
+}
+
+void CS_SetRawSinkFrameQueueSize(CS_Sink sink, int size, CS_Status* status) {
+  cs::SetSinkFrameQueueSize(sink, size, status);
+}
+
+int CS_GrabRawSinkFrames(CS_Sink sink, struct WPI_RawFrame* rawImages,
+                         int count, double timeout, CS_Status* status) {
+  wpi::SmallVector<WPI_RawFrame*, 16> images;
+  for (int i = 0; i < count; ++i) {
+    images.emplace_back(&rawImages[i]);
+  }
+  return cs::GrabSinkFrames(sink, images, timeout, status);
+}
+
+uint64_t CS_GrabRawSinkFrameSet(const CS_Sink* sinks,
+                                struct WPI_RawFrame* rawImages, int count,
+                                uint64_t window, double timeout,
+                                CS_Status* status) {
+  wpi::SmallVector<WPI_RawFrame*, 4> images;
+  for (int i = 0; i < count; ++i) {
+    images.emplace_back(&rawImages[i]);
+  }
+  return cs::GrabSinkFrameSet({sinks, static_cast<size_t>(count)}, images,
+                              window, timeout, status);
+}
+
 }  // extern "C"
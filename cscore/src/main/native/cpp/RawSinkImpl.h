@@ -8,11 +8,16 @@
 #include <stdint.h>
 
 #include <atomic>
+#include <deque>
 #include <functional>
+#include <memory>
+#include <span>
 #include <string_view>
 #include <thread>
+#include <vector>
 
 #include <wpi/condition_variable.h>
+#include <wpi/mutex.h>
 
 #include "Frame.h"
 #include "SinkImpl.h"
@@ -38,16 +43,65 @@ class RawSinkImpl : public SinkImpl {
   uint64_t GrabFrame(WPI_RawFrame& frame, double timeout,
                      uint64_t lastFrameTime);
 
+  // Like GrabFrame(), but points frame at the incoming image instead of
+  // copying it.  The image is held until frame's data is freed, and must not
+  // be modified, as other sinks may share it.
+  uint64_t BorrowFrame(WPI_RawFrame& frame, double timeout,
+                       uint64_t lastFrameTime);
+
+  // Sets the number of frames kept in the frame queue; 0 disables it.
+  void SetFrameQueueSize(int size);
+  // Gets the most recent queued frames (up to frames.size()), oldest first,
+  // waiting up to timeout seconds for one if the queue is empty.  Enables the
+  // queue if it isn't already.  Returns the number of frames filled.
+  int GrabFrames(std::span<WPI_RawFrame* const> frames, double timeout);
+
+  // Used to grab synchronized frames from several sinks.  Gets the times of
+  // the queued frames, oldest first, enabling the queue with queueSize frames
+  // if it isn't already.
+  void GetQueuedFrameTimes(std::vector<uint64_t>& times, int queueSize);
+  // Waits up to timeout seconds for a frame newer than time to be queued.
+  void WaitForQueuedFrame(uint64_t time, double timeout);
+  // Removes queued frames older than time.  If frame is set and the oldest
+  // remaining frame has the given time, it is also removed and copied into
+  // frame.  Returns the frame time, or 0 if no frame was copied.
+  uint64_t TakeQueuedFrame(uint64_t time, WPI_RawFrame* frame);
+
+  // Holds a borrowed image's frame
+  struct BorrowedFrame {
+    std::shared_ptr<SourceImpl> source;
+    Frame frame;
+  };
+
  private:
   void ThreadMain();
+  void QueueThreadMain(unsigned generation);
+
+  uint64_t GrabNextFrame(WPI_RawFrame& image, double timeout,
+                         uint64_t lastFrameTime, bool borrow);
 
   // Copies the image from incomingFrame into rawFrame, converting where
-  // necessary to the resolution of rawFrame
-  uint64_t GrabFrameImpl(WPI_RawFrame& rawFrame, Frame& incomingFrame);
+  // necessary to the resolution of rawFrame.  If borrowSource is set, rawFrame
+  // borrows the image from borrowSource's frame instead.
+  uint64_t GrabFrameImpl(WPI_RawFrame& rawFrame, Frame& incomingFrame,
+                         std::shared_ptr<SourceImpl> borrowSource = nullptr);
 
   std::atomic_bool m_active;  // set to false to terminate threads
   std::thread m_thread;
   std::function<void(uint64_t time)> m_processFrame;
+
+  // Frame queue, filled by m_queueThread so frames aren't missed while the
+  // user is processing.  The source is held as queued frames refer to it.
+  struct QueuedFrame {
+    std::shared_ptr<SourceImpl> source;
+    Frame frame;
+  };
+  wpi::mutex m_queueMutex;
+  wpi::condition_variable m_queueCv;
+  std::deque<QueuedFrame> m_queue;
+  size_t m_queueSize = 0;
+  unsigned m_queueGeneration = 0;  // incremented to stop m_queueThread
+  std::thread m_queueThread;
 };
 }  // namespace cs
 
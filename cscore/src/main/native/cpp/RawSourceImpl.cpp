@@ -4,10 +4,13 @@
 
 #include "RawSourceImpl.h"
 
+#include <algorithm>
 #include <memory>
+#include <utility>
 
 #include <wpi/timestamp.h>
 
+#include "Image.h"
 #include "Instance.h"
 #include "Notifier.h"
 #include "cscore_raw.h"
@@ -28,6 +31,29 @@ void RawSourceImpl::PutFrame(const WPI_RawFrame& image) {
                        image.width, image.height, data_view, currentTime);
 }
 
+void RawSourceImpl::PutImage(std::unique_ptr<Image> image) {
+  SourceImpl::PutFrame(std::move(image), wpi::Now());
+}
+
+namespace {
+// Holds an image allocated by AllocSourceFrame() until it is committed or
+// freed.  The source is held as the image belongs to its pool.
+struct AllocatedImage {
+  std::shared_ptr<SourceImpl> source;
+  std::unique_ptr<Image> image;
+};
+}  // namespace
+
+// Frees an allocated frame's holder, returning the image to the pool if the
+// frame wasn't committed
+static void ReleaseAllocatedImage(void* cbdata, void*, size_t) {
+  auto allocated = static_cast<AllocatedImage*>(cbdata);
+  if (allocated->image) {
+    allocated->source->ReleaseImage(std::move(allocated->image));
+  }
+  delete allocated;
+}
+
 namespace cs {
 static constexpr unsigned SourceMask = CS_SOURCE_CV | CS_SOURCE_RAW;
 
@@ -50,6 +76,48 @@ void PutSourceFrame(CS_Source source, const WPI_RawFrame& image,
   static_cast<RawSourceImpl&>(*data->source).PutFrame(image);
 }
 
+void AllocSourceFrame(CS_Source source, WPI_RawFrame& image,
+                      CS_Status* status) {
+  auto data = Instance::GetInstance().GetSource(source);
+  if (!data || (data->kind & SourceMask) == 0) {
+    *status = CS_INVALID_HANDLE;
+    return;
+  }
+  auto pixelFormat = static_cast<VideoMode::PixelFormat>(image.pixelFormat);
+  int stride = Image::GetStride(pixelFormat, image.width);
+  // compressed images use the requested size as the buffer size
+  size_t size = stride != 0 ? static_cast<size_t>(stride) * image.height
+                            : image.size;
+  auto newImage =
+      data->source->AllocImage(pixelFormat, image.width, image.height, size);
+  auto imageData = newImage->data();
+  WPI_SetRawFrameData(&image, imageData, size, size,
+                      new AllocatedImage{data->source, std::move(newImage)},
+                      ReleaseAllocatedImage);
+  image.stride = stride;
+}
+
+void CommitSourceFrame(CS_Source source, WPI_RawFrame& image,
+                       CS_Status* status) {
+  auto data = Instance::GetInstance().GetSource(source);
+  if (!data || (data->kind & SourceMask) == 0) {
+    *status = CS_INVALID_HANDLE;
+    return;
+  }
+  auto allocated = static_cast<AllocatedImage*>(image.freeCbData);
+  if (image.freeFunc != ReleaseAllocatedImage ||
+      allocated->source != data->source || !allocated->image) {
+    // not allocated from this source; copy it instead
+    static_cast<RawSourceImpl&>(*data->source).PutFrame(image);
+    return;
+  }
+  auto newImage = std::move(allocated->image);
+  newImage->SetSize(std::min(image.size, image.capacity));
+  WPI_FreeRawFrameData(&image);
+  image.size = 0;
+  static_cast<RawSourceImpl&>(*data->source).PutImage(std::move(newImage));
+}
+
 }  // namespace cs
 
 extern "C" {
@@ -64,4 +132,14 @@ void CS_PutRawSourceFrame(CS_Source source, const struct WPI_RawFrame* image,
   return cs::PutSourceFrame(source, *image, status);
 }
 
+void CS_AllocRawSourceFrame(CS_Source source, struct WPI_RawFrame* image,
+                            CS_Status* status) {
+  cs::AllocSourceFrame(source, *image, status);
+}
+
+void CS_CommitRawSourceFrame(CS_Source source, struct WPI_RawFrame* image,
+                             CS_Status* status) {
+  cs::CommitSourceFrame(source, *image, status);
+}
+
 }  // extern "C"
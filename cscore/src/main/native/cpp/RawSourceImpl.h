@@ -26,6 +26,8 @@ class RawSourceImpl : public ConfigurableSourceImpl {
 
   // Raw-specific functions
   void PutFrame(const WPI_RawFrame& image);
+  // Puts an image from AllocImage() without copying it
+  void PutImage(std::unique_ptr<Image> image);
 
  private:
   std::atomic_bool m_connected{true};
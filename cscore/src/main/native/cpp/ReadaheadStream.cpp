@@ -0,0 +1,94 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "ReadaheadStream.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+#include <wpinet/NetworkStream.h>
+
+using namespace cs;
+
+ReadaheadStream::ReadaheadStream(wpi::NetworkStream& stream, int timeout)
+    : m_stream{stream},
+      m_timeout{timeout},
+      m_buf{std::make_unique_for_overwrite<char[]>(kBufferSize)} {}
+
+void ReadaheadStream::close() {
+  m_stream.close();
+}
+
+std::string_view ReadaheadStream::Peek() {
+  if (m_pos == m_end && !Fill()) {
+    return {};
+  }
+  return {m_buf.get() + m_pos, m_end - m_pos};
+}
+
+bool ReadaheadStream::SkipPast(std::string_view delim) {
+  for (;;) {
+    std::string_view buffered{m_buf.get() + m_pos, m_end - m_pos};
+    auto found = buffered.find(delim);
+    if (found != std::string_view::npos) {
+      m_pos += found + delim.size();
+      return true;
+    }
+    // keep enough to match a delimiter split across receives
+    if (buffered.size() >= delim.size()) {
+      m_pos = m_end - (delim.size() - 1);
+    }
+    if (!Fill()) {
+      return false;
+    }
+  }
+}
+
+void ReadaheadStream::read_impl(void* data, size_t len) {
+  char* cdata = static_cast<char*>(data);
+  size_t pos = 0;
+
+  while (pos < len) {
+    if (m_pos != m_end) {
+      size_t count = (std::min)(m_end - m_pos, len - pos);
+      std::memcpy(&cdata[pos], m_buf.get() + m_pos, count);
+      m_pos += count;
+      pos += count;
+    } else if (len - pos >= kBufferSize) {
+      // large read: avoid the extra copy through the buffer
+      wpi::NetworkStream::Error err;
+      size_t count =
+          m_stream.receive(&cdata[pos], len - pos, &err, m_timeout);
+      if (count == 0) {
+        error_detected();
+        break;
+      }
+      pos += count;
+    } else if (!Fill()) {
+      break;
+    }
+  }
+  set_read_count(pos);
+}
+
+bool ReadaheadStream::Fill() {
+  if (m_pos != 0) {
+    std::memmove(m_buf.get(), m_buf.get() + m_pos, m_end - m_pos);
+    m_end -= m_pos;
+    m_pos = 0;
+  }
+  if (m_end == kBufferSize) {
+    return true;
+  }
+  wpi::NetworkStream::Error err;
+  size_t count = m_stream.receive(m_buf.get() + m_end, kBufferSize - m_end,
+                                  &err, m_timeout);
+  if (count == 0) {
+    error_detected();
+    return false;
+  }
+  m_end += count;
+  return true;
+}
@@ -0,0 +1,61 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef CSCORE_READAHEADSTREAM_H_
+#define CSCORE_READAHEADSTREAM_H_
+
+#include <memory>
+#include <string_view>
+
+#include <wpi/raw_istream.h>
+
+namespace wpi {
+class NetworkStream;
+}  // namespace wpi
+
+namespace cs {
+
+// Buffered input stream for a network connection.  raw_socket_istream does a
+// receive for every read, which is a system call per byte when scanning for
+// a multipart boundary or through JPEG entropy-coded data; this receives as
+// much as is available (up to the buffer size) at once, and lets callers scan
+// the buffered data in place.  Reads larger than the buffer go directly to
+// the destination once the buffered data is used up.
+class ReadaheadStream : public wpi::raw_istream {
+ public:
+  static constexpr size_t kBufferSize = 64 * 1024;
+
+  explicit ReadaheadStream(wpi::NetworkStream& stream, int timeout = 0);
+
+  void close() override;
+  size_t in_avail() const override { return m_end - m_pos; }
+
+  // Gets the buffered data, receiving more first if there is none.  Empty on
+  // error.
+  std::string_view Peek();
+
+  // Discards len bytes of the buffered data.
+  void Consume(size_t len) { m_pos += len; }
+
+  // Discards data up to and including the next occurrence of delim, which
+  // must be shorter than the buffer.  Returns false on error.
+  bool SkipPast(std::string_view delim);
+
+ private:
+  void read_impl(void* data, size_t len) override;
+
+  // Moves the buffered data to the start of the buffer and receives more
+  // after it.  Returns false on error.
+  bool Fill();
+
+  wpi::NetworkStream& m_stream;
+  int m_timeout;
+  std::unique_ptr<char[]> m_buf;
+  size_t m_pos = 0;
+  size_t m_end = 0;
+};
+
+}  // namespace cs
+
+#endif  // CSCORE_READAHEADSTREAM_H_
@@ -0,0 +1,741 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "RtspServerImpl.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <wpi/SmallString.h>
+#include <wpi/StringExtras.h>
+#include <wpi/fmt/raw_ostream.h>
+#include <wpi/mutex.h>
+#include <wpi/print.h>
+#include <wpi/timestamp.h>
+#include <wpinet/TCPAcceptor.h>
+#include <wpinet/raw_socket_istream.h>
+#include <wpinet/raw_socket_ostream.h>
+
+#include "H264Encoder.h"
+#include "Instance.h"
+#include "Log.h"
+#include "SourceImpl.h"
+#include "c_util.h"
+#include "cscore_cpp.h"
+
+using namespace cs;
+
+// RTP payload type used for H.264 (dynamic range)
+static constexpr uint8_t kPayloadType = 96;
+
+// Maximum RTP payload size.  Packets are sent over TCP so there is no MTU, but
+// keeping them to Ethernet size lets proxies forward them as UDP unchanged.
+static constexpr size_t kMaxPayload = 1400;
+
+// Calls func for each NAL unit (without start code) in an Annex B byte stream
+template <typename F>
+static void ForEachNal(std::span<const uint8_t> data, F&& func) {
+  size_t start = SIZE_MAX;
+  size_t i = 0;
+  auto emit = [&](size_t end) {
+    // drop trailing zeros (e.g. from a following 4-byte start code)
+    while (end > start && data[end - 1] == 0) {
+      --end;
+    }
+    if (end > start) {
+      func(data.subspan(start, end - start));
+    }
+  };
+  while (i + 3 <= data.size()) {
+    if (data[i] == 0 && data[i + 1] == 0 && data[i + 2] == 1) {
+      if (start != SIZE_MAX) {
+        emit(i);
+      }
+      i += 3;
+      start = i;
+    } else {
+      ++i;
+    }
+  }
+  if (start != SIZE_MAX) {
+    emit(data.size());
+  }
+}
+
+// Appends an interleaved RTP packet header ($, channel, length, RTP header).
+// The marker bit is left clear.
+static void AppendRtpHeader(std::vector<uint8_t>& out, int channel,
+                            size_t payloadSize, uint16_t seq,
+                            uint32_t timestamp, uint32_t ssrc) {
+  size_t len = 12 + payloadSize;
+  uint8_t header[16] = {
+      '$',
+      static_cast<uint8_t>(channel),
+      static_cast<uint8_t>(len >> 8),
+      static_cast<uint8_t>(len),
+      0x80,  // version 2
+      kPayloadType,
+      static_cast<uint8_t>(seq >> 8),
+      static_cast<uint8_t>(seq),
+      static_cast<uint8_t>(timestamp >> 24),
+      static_cast<uint8_t>(timestamp >> 16),
+      static_cast<uint8_t>(timestamp >> 8),
+      static_cast<uint8_t>(timestamp),
+      static_cast<uint8_t>(ssrc >> 24),
+      static_cast<uint8_t>(ssrc >> 16),
+      static_cast<uint8_t>(ssrc >> 8),
+      static_cast<uint8_t>(ssrc)};
+  out.insert(out.end(), std::begin(header), std::end(header));
+}
+
+class RtspServerImpl::ConnThread : public wpi::SafeThread {
+ public:
+  explicit ConnThread(std::string_view name, wpi::Logger& logger)
+      : m_name(name), m_logger(logger) {}
+
+  void Main() override;
+
+  void ProcessSession();
+
+  std::unique_ptr<wpi::NetworkStream> m_stream;
+  std::shared_ptr<SourceImpl> m_source;
+  std::shared_ptr<EncoderSettings> m_encoderSettings;
+  bool m_streaming = false;
+  bool m_noStreaming = false;
+  int m_width = 0;
+  int m_height = 0;
+  int m_fps = 0;
+
+  // The images streaming requests from each frame
+  SinkDemand GetDemand() const {
+    return {VideoMode::kBGR, m_width, m_height};
+  }
+
+ private:
+  std::string m_name;
+  wpi::Logger& m_logger;
+
+  // output stream, shared with the stream thread under m_sendMutex
+  wpi::raw_socket_ostream* m_os = nullptr;
+  wpi::mutex m_sendMutex;
+
+  // set by SETUP
+  std::string m_sessionId;
+  int m_channel = 0;
+
+  // set by PLAY, cleared by PAUSE and TEARDOWN
+  std::atomic_bool m_playing{false};
+  std::thread m_streamThread;
+
+  // RTP state
+  uint16_t m_seq = 0;
+  uint32_t m_ssrc = 0;
+  std::vector<uint8_t> m_packets;
+
+  std::string_view GetName() { return m_name; }
+
+  std::shared_ptr<SourceImpl> GetSource() {
+    std::scoped_lock lock(m_mutex);
+    return m_source;
+  }
+
+  void StartStream() {
+    std::scoped_lock lock(m_mutex);
+    if (m_source) {
+      m_source->SetSinkDemand(this, GetDemand());
+      m_source->EnableSink();
+    }
+    m_streaming = true;
+  }
+
+  void StopStream() {
+    std::scoped_lock lock(m_mutex);
+    if (m_source) {
+      m_source->RemoveSinkDemand(this);
+      m_source->DisableSink();
+    }
+    m_streaming = false;
+  }
+
+  bool ProcessRequest(std::string_view request, std::string_view cseq,
+                      std::string_view transport, std::string_view session);
+  void SendResponse(int code, std::string_view codeText, std::string_view cseq,
+                    std::string_view extra = {}, std::string_view body = {});
+  void StartPlaying();
+  void StopPlaying();
+  void StreamThreadMain();
+  bool SendAccessUnit(std::span<const uint8_t> data, uint32_t timestamp);
+};
+
+void RtspServerImpl::ConnThread::SendResponse(int code,
+                                              std::string_view codeText,
+                                              std::string_view cseq,
+                                              std::string_view extra,
+                                              std::string_view body) {
+  wpi::SmallString<512> buf;
+  wpi::raw_svector_ostream oss{buf};
+  wpi::print(oss, "RTSP/1.0 {} {}\r\n", code, codeText);
+  if (!cseq.empty()) {
+    wpi::print(oss, "CSeq: {}\r\n", cseq);
+  }
+  oss << "Server: CameraServer/1.0\r\n";
+  oss << extra;
+  if (!body.empty()) {
+    wpi::print(oss, "Content-Length: {}\r\n", body.size());
+  }
+  oss << "\r\n" << body;
+
+  std::scoped_lock lock(m_sendMutex);
+  *m_os << oss.str();
+}
+
+bool RtspServerImpl::ConnThread::SendAccessUnit(std::span<const uint8_t> data,
+                                                uint32_t timestamp) {
+  // Packetize per RFC 6184: NAL units that fit are sent as single NAL unit
+  // packets, larger ones are split into FU-A fragments.  The marker bit is
+  // set on the last packet of the access unit.
+  m_packets.clear();
+  size_t lastStart = m_packets.size();
+  ForEachNal(data, [&](std::span<const uint8_t> nal) {
+    if (nal.size() <= kMaxPayload) {
+      lastStart = m_packets.size();
+      AppendRtpHeader(m_packets, m_channel, nal.size(), m_seq++, timestamp,
+                      m_ssrc);
+      m_packets.insert(m_packets.end(), nal.begin(), nal.end());
+      return;
+    }
+    uint8_t indicator = (nal[0] & 0xe0) | 28;
+    uint8_t type = nal[0] & 0x1f;
+    for (size_t pos = 1; pos < nal.size();) {
+      size_t len = std::min(kMaxPayload - 2, nal.size() - pos);
+      uint8_t header = type;
+      if (pos == 1) {
+        header |= 0x80;  // start
+      }
+      if (pos + len == nal.size()) {
+        header |= 0x40;  // end
+      }
+      lastStart = m_packets.size();
+      AppendRtpHeader(m_packets, m_channel, len + 2, m_seq++, timestamp,
+                      m_ssrc);
+      m_packets.push_back(indicator);
+      m_packets.push_back(header);
+      m_packets.insert(m_packets.end(), nal.begin() + pos,
+                       nal.begin() + pos + len);
+      pos += len;
+    }
+  });
+  if (m_packets.empty()) {
+    return true;
+  }
+  m_packets[lastStart + 5] |= 0x80;  // marker
+
+  std::scoped_lock lock(m_sendMutex);
+  *m_os << std::string_view{reinterpret_cast<const char*>(m_packets.data()),
+                            m_packets.size()};
+  return !m_os->has_error();
+}
+
+void RtspServerImpl::ConnThread::StreamThreadMain() {
+  StartStream();
+
+  std::unique_ptr<H264Encoder> encoder;
+  std::vector<uint8_t> encoded;
+  Frame::Time lastFrameTime = 0;
+  Frame::Time lastSentTime = 0;
+  bool needKeyFrame = true;
+  while (m_active && m_playing) {
+    auto source = GetSource();
+    if (!source) {
+      // Source disconnected; sleep so we don't consume all processor time.
+      std::this_thread::sleep_for(std::chrono::milliseconds(200));
+      continue;
+    }
+    Frame frame = source->GetNextFrame(0.225, lastFrameTime);  // blocks
+    if (!frame) {
+      continue;
+    }
+    lastFrameTime = frame.GetTime();
+    frame.RecordLatency(CS_LATENCY_DELIVERY, frame.GetPutTime());
+
+    // drop frames that are early compared to the desired frame rate
+    if (m_fps > 0 && lastSentTime != 0 &&
+        lastFrameTime - lastSentTime <
+            static_cast<Frame::Time>(1000000 / m_fps)) {
+      continue;
+    }
+
+    // encoders require even dimensions
+    int width = (m_width != 0 ? m_width : frame.GetOriginalWidth()) & ~1;
+    int height = (m_height != 0 ? m_height : frame.GetOriginalHeight()) & ~1;
+    Image* image = frame.GetImage(width, height, VideoMode::kBGR);
+    if (!image) {
+      continue;
+    }
+
+    H264Encoder::Settings settings{width, height, m_fps > 0 ? m_fps : 30,
+                                   m_encoderSettings->bitrate,
+                                   m_encoderSettings->keyFrameInterval};
+    if (!encoder) {
+      encoder = CreateH264Encoder(settings, m_logger);
+      if (!encoder) {
+        SERROR("no H.264 encoder available for {}x{}", width, height);
+        break;
+      }
+      SDEBUG("using H.264 encoder {}", encoder->GetName());
+      needKeyFrame = true;
+    }
+    encoder->SetBitrate(settings.bitrate);
+
+    Frame::Time encodeStart = wpi::Now();
+    if (!encoder->Encode(image->span(), needKeyFrame, encoded)) {
+      // recreate the encoder on the next frame (this also handles resolution
+      // changes, which fail the size check)
+      SWARNING("H.264 encoding failed");
+      encoder.reset();
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      continue;
+    }
+    if (encoded.empty()) {
+      continue;
+    }
+    frame.RecordLatency(CS_LATENCY_ENCODE, encodeStart);
+    needKeyFrame = false;
+    lastSentTime = lastFrameTime;
+
+    // 90 kHz clock
+    uint32_t timestamp = static_cast<uint32_t>(lastFrameTime * 9 / 100);
+    Frame::Time sendStart = wpi::Now();
+    if (!SendAccessUnit(encoded, timestamp)) {
+      break;
+    }
+    frame.RecordLatency(CS_LATENCY_SEND, sendStart);
+    frame.RecordLatency(CS_LATENCY_TOTAL, lastFrameTime);
+  }
+
+  StopStream();
+  if (m_playing) {
+    // ended due to error; drop the connection so the client notices
+    m_stream->close();
+  }
+}
+
+void RtspServerImpl::ConnThread::StartPlaying() {
+  if (m_playing) {
+    return;
+  }
+  if (m_streamThread.joinable()) {
+    m_streamThread.join();
+  }
+  m_playing = true;
+  m_streamThread = std::thread(&ConnThread::StreamThreadMain, this);
+}
+
+void RtspServerImpl::ConnThread::StopPlaying() {
+  m_playing = false;
+  if (m_streamThread.joinable()) {
+    m_streamThread.join();
+  }
+}
+
+bool RtspServerImpl::ConnThread::ProcessRequest(std::string_view request,
+                                                std::string_view cseq,
+                                                std::string_view transport,
+                                                std::string_view session) {
+  auto [method, rest] = wpi::split(request, ' ');
+  auto url = wpi::split(rest, ' ').first;
+  SDEBUG("RTSP request: '{}'", request);
+
+  if (method == "OPTIONS") {
+    SendResponse(200, "OK", cseq,
+                 "Public: OPTIONS, DESCRIBE, SETUP, PLAY, PAUSE, TEARDOWN, "
+                 "GET_PARAMETER, SET_PARAMETER\r\n");
+  } else if (method == "DESCRIBE") {
+    if (!IsH264EncoderAvailable()) {
+      SERROR("no H.264 encoder available");
+      SendResponse(503, "Service Unavailable", cseq);
+      return true;
+    }
+    // SPS and PPS are sent in-band with each IDR frame, so they are not
+    // included in the SDP (sprop-parameter-sets is optional)
+    std::string sdp = fmt::format(
+        "v=0\r\n"
+        "o=- {0} 1 IN IP4 0.0.0.0\r\n"
+        "s={1}\r\n"
+        "c=IN IP4 0.0.0.0\r\n"
+        "t=0 0\r\n"
+        "a=control:*\r\n"
+        "m=video 0 RTP/AVP {2}\r\n"
+        "a=rtpmap:{2} H264/90000\r\n"
+        "a=fmtp:{2} packetization-mode=1\r\n"
+        "a=control:track0\r\n",
+        m_ssrc, m_name, kPayloadType);
+    std::string base{url};
+    if (!wpi::ends_with(base, '/')) {
+      base += '/';
+    }
+    SendResponse(200, "OK", cseq,
+                 fmt::format("Content-Base: {}\r\n"
+                             "Content-Type: application/sdp\r\n",
+                             base),
+                 sdp);
+  } else if (method == "SETUP") {
+    // only RTP over the RTSP connection is supported
+    size_t pos = transport.find("interleaved=");
+    if (transport.find("RTP/AVP/TCP") == std::string_view::npos ||
+        pos == std::string_view::npos) {
+      SendResponse(461, "Unsupported Transport", cseq);
+      return true;
+    }
+    m_channel =
+        wpi::parse_integer<int>(
+            wpi::split(wpi::substr(transport, pos + 12), '-').first, 10)
+            .value_or(0);
+    if (m_sessionId.empty()) {
+      m_sessionId = fmt::format("{:08X}", m_ssrc);
+    }
+    SendResponse(200, "OK", cseq,
+                 fmt::format("Transport: RTP/AVP/TCP;unicast;"
+                             "interleaved={}-{}\r\n"
+                             "Session: {};timeout=60\r\n",
+                             m_channel, m_channel + 1, m_sessionId));
+  } else if (method == "PLAY") {
+    if (m_sessionId.empty() ||
+        wpi::trim(wpi::split(session, ';').first) != m_sessionId) {
+      SendResponse(454, "Session Not Found", cseq);
+      return true;
+    }
+    if (m_noStreaming) {
+      SERROR("Too many simultaneous client streams");
+      SendResponse(453, "Not Enough Bandwidth", cseq);
+      return true;
+    }
+    SendResponse(200, "OK", cseq,
+                 fmt::format("Session: {}\r\n"
+                             "Range: npt=0.000-\r\n",
+                             m_sessionId));
+    StartPlaying();
+  } else if (method == "PAUSE") {
+    StopPlaying();
+    SendResponse(200, "OK", cseq,
+                 fmt::format("Session: {}\r\n", m_sessionId));
+  } else if (method == "TEARDOWN") {
+    StopPlaying();
+    SendResponse(200, "OK", cseq);
+    return false;
+  } else if (method == "GET_PARAMETER" || method == "SET_PARAMETER") {
+    // used by clients as a keep-alive
+    SendResponse(200, "OK", cseq);
+  } else {
+    SendResponse(501, "Not Implemented", cseq);
+  }
+  return true;
+}
+
+void RtspServerImpl::ConnThread::ProcessSession() {
+  wpi::raw_socket_istream is{*m_stream};
+  wpi::raw_socket_ostream os{*m_stream, true};
+  os.SetUnbuffered();
+  m_os = &os;
+  m_sessionId.clear();
+  m_channel = 0;
+  m_seq = 0;
+  m_ssrc = std::random_device{}();
+
+  wpi::SmallString<128> lineBuf;
+  while (m_active) {
+    char c;
+    is.read(c);
+    if (is.has_error()) {
+      break;
+    }
+
+    if (c == '$') {
+      // interleaved data (RTCP receiver reports) from the client; discard it
+      uint8_t header[3];
+      is.read(header, 3);
+      size_t len = (header[1] << 8) | header[2];
+      char discard[256];
+      while (len > 0 && !is.has_error()) {
+        size_t count = std::min(len, sizeof(discard));
+        is.read(discard, count);
+        len -= count;
+      }
+      continue;
+    }
+
+    // request line and headers
+    std::string request{c};
+    request += is.getline(lineBuf, 4096);
+    std::string cseq, transport, session;
+    size_t contentLength = 0;
+    for (;;) {
+      std::string_view line = is.getline(lineBuf, 4096);
+      if (is.has_error() || line == "\n") {
+        break;
+      }
+      auto [name, value] = wpi::split(line, ':');
+      value = wpi::trim(value);
+      if (wpi::equals_lower(name, "cseq")) {
+        cseq = value;
+      } else if (wpi::equals_lower(name, "transport")) {
+        transport = value;
+      } else if (wpi::equals_lower(name, "session")) {
+        session = value;
+      } else if (wpi::equals_lower(name, "content-length")) {
+        contentLength =
+            wpi::parse_integer<size_t>(value, 10).value_or(0);
+      }
+    }
+    // ignore request body (e.g. SET_PARAMETER)
+    while (contentLength > 0 && !is.has_error()) {
+      is.read(c);
+      --contentLength;
+    }
+    if (is.has_error()) {
+      break;
+    }
+
+    if (!ProcessRequest(wpi::trim(request), cseq, transport, session)) {
+      break;
+    }
+  }
+
+  StopPlaying();
+  m_os = nullptr;
+  SDEBUG("leaving RTSP client thread");
+}
+
+// worker thread for clients that connected to this server
+void RtspServerImpl::ConnThread::Main() {
+  std::unique_lock lock(m_mutex);
+  while (m_active) {
+    while (!m_stream) {
+      m_cond.wait(lock);
+      if (!m_active) {
+        return;
+      }
+    }
+    lock.unlock();
+    ProcessSession();
+    lock.lock();
+    m_stream = nullptr;
+  }
+}
+
+RtspServerImpl::RtspServerImpl(std::string_view name, wpi::Logger& logger,
+                               Notifier& notifier, Telemetry& telemetry,
+                               std::string_view listenAddress, int port,
+                               std::unique_ptr<wpi::NetworkAcceptor> acceptor)
+    : SinkImpl{name, logger, notifier, telemetry},
+      m_listenAddress(listenAddress),
+      m_port(port),
+      m_acceptor{std::move(acceptor)},
+      m_encoderSettings{std::make_shared<EncoderSettings>()} {
+  m_active = true;
+
+  SetDescription(fmt::format("RTSP Server on port {}", port));
+
+  // Create properties
+  m_widthProp = CreateProperty("width", [] {
+    return std::make_unique<PropertyImpl>("width", CS_PROP_INTEGER, 1, 0, 0);
+  });
+  m_heightProp = CreateProperty("height", [] {
+    return std::make_unique<PropertyImpl>("height", CS_PROP_INTEGER, 1, 0, 0);
+  });
+  m_fpsProp = CreateProperty("fps", [] {
+    return std::make_unique<PropertyImpl>("fps", CS_PROP_INTEGER, 1, 0, 0);
+  });
+  m_bitrateProp = CreateProperty("bitrate", [] {
+    return std::make_unique<PropertyImpl>("bitrate", CS_PROP_INTEGER, 100000,
+                                          50000000, 1, 2000000, 2000000);
+  });
+  m_keyFrameIntervalProp = CreateProperty("keyframe_interval", [] {
+    return std::make_unique<PropertyImpl>("keyframe_interval",
+                                          CS_PROP_INTEGER, 1, 600, 1, 60, 60);
+  });
+
+  m_serverThread = std::thread(&RtspServerImpl::ServerThreadMain, this);
+}
+
+RtspServerImpl::~RtspServerImpl() {
+  Stop();
+}
+
+void RtspServerImpl::Stop() {
+  m_active = false;
+
+  // wake up server thread by shutting down the socket
+  m_acceptor->shutdown();
+
+  // join server thread
+  if (m_serverThread.joinable()) {
+    m_serverThread.join();
+  }
+
+  // close streams
+  for (auto& connThread : m_connThreads) {
+    if (auto thr = connThread.GetThread()) {
+      if (thr->m_stream) {
+        thr->m_stream->close();
+      }
+    }
+    connThread.Stop();
+  }
+}
+
+void RtspServerImpl::UpdatePropertyValue(int property, bool setString,
+                                         int value,
+                                         std::string_view valueStr) {
+  SinkImpl::UpdatePropertyValue(property, setString, value, valueStr);
+  if (property == m_bitrateProp) {
+    m_encoderSettings->bitrate = GetProperty(property)->value;
+  } else if (property == m_keyFrameIntervalProp) {
+    m_encoderSettings->keyFrameInterval = GetProperty(property)->value;
+  }
+}
+
+// Main server thread
+void RtspServerImpl::ServerThreadMain() {
+  if (m_acceptor->start() != 0) {
+    m_active = false;
+    return;
+  }
+
+  SDEBUG("waiting for clients to connect");
+  while (m_active) {
+    auto stream = m_acceptor->accept();
+    if (!stream) {
+      m_active = false;
+      return;
+    }
+    if (!m_active) {
+      return;
+    }
+
+    SDEBUG("client connection from {}", stream->getPeerIP());
+
+    auto source = GetSource();
+
+    std::scoped_lock lock(m_mutex);
+    // Find unoccupied worker thread, or create one if necessary
+    auto it = std::find_if(m_connThreads.begin(), m_connThreads.end(),
+                           [](const wpi::SafeThreadOwner<ConnThread>& owner) {
+                             auto thr = owner.GetThread();
+                             return !thr || !thr->m_stream;
+                           });
+    if (it == m_connThreads.end()) {
+      m_connThreads.emplace_back();
+      it = std::prev(m_connThreads.end());
+    }
+
+    // Start it if not already started
+    it->Start(GetName(), m_logger);
+
+    // each stream uses a hardware encoder instance, and these are scarce
+    auto nstreams =
+        std::count_if(m_connThreads.begin(), m_connThreads.end(),
+                      [](const wpi::SafeThreadOwner<ConnThread>& owner) {
+                        auto thr = owner.GetThread();
+                        return thr && thr->m_streaming;
+                      });
+
+    // Hand off connection to it
+    auto thr = it->GetThread();
+    thr->m_stream = std::move(stream);
+    thr->m_source = source;
+    thr->m_encoderSettings = m_encoderSettings;
+    thr->m_noStreaming = nstreams >= 4;
+    thr->m_width = GetProperty(m_widthProp)->value;
+    thr->m_height = GetProperty(m_heightProp)->value;
+    thr->m_fps = GetProperty(m_fpsProp)->value;
+    thr->m_cond.notify_one();
+  }
+
+  SDEBUG("leaving server thread");
+}
+
+void RtspServerImpl::SetSourceImpl(std::shared_ptr<SourceImpl> source) {
+  std::scoped_lock lock(m_mutex);
+  for (auto& connThread : m_connThreads) {
+    if (auto thr = connThread.GetThread()) {
+      if (thr->m_source != source) {
+        bool streaming = thr->m_streaming;
+        if (thr->m_source && streaming) {
+          thr->m_source->RemoveSinkDemand(&*thr);
+          thr->m_source->DisableSink();
+        }
+        thr->m_source = source;
+        if (source && streaming) {
+          thr->m_source->SetSinkDemand(&*thr, thr->GetDemand());
+          thr->m_source->EnableSink();
+        }
+      }
+    }
+  }
+}
+
+namespace cs {
+
+CS_Sink CreateRtspServer(std::string_view name, std::string_view listenAddress,
+                         int port, CS_Status* status) {
+  auto& inst = Instance::GetInstance();
+  return inst.CreateSink(
+      CS_SINK_RTSP,
+      std::make_shared<RtspServerImpl>(
+          name, inst.logger, inst.notifier, inst.telemetry, listenAddress, port,
+          std::unique_ptr<wpi::NetworkAcceptor>(
+              new wpi::TCPAcceptor(port, listenAddress, inst.logger))));
+}
+
+std::string GetRtspServerListenAddress(CS_Sink sink, CS_Status* status) {
+  auto data = Instance::GetInstance().GetSink(sink);
+  if (!data || data->kind != CS_SINK_RTSP) {
+    *status = CS_INVALID_HANDLE;
+    return std::string{};
+  }
+  return static_cast<RtspServerImpl&>(*data->sink).GetListenAddress();
+}
+
+int GetRtspServerPort(CS_Sink sink, CS_Status* status) {
+  auto data = Instance::GetInstance().GetSink(sink);
+  if (!data || data->kind != CS_SINK_RTSP) {
+    *status = CS_INVALID_HANDLE;
+    return 0;
+  }
+  return static_cast<RtspServerImpl&>(*data->sink).GetPort();
+}
+
+}  // namespace cs
+
+extern "C" {
+
+CS_Sink CS_CreateRtspServer(const struct WPI_String* name,
+                            const struct WPI_String* listenAddress, int port,
+                            CS_Status* status) {
+  return cs::CreateRtspServer(wpi::to_string_view(name),
+                              wpi::to_string_view(listenAddress), port,
+                              status);
+}
+
+void CS_GetRtspServerListenAddress(CS_Sink sink, WPI_String* listenAddress,
+                                   CS_Status* status) {
+  cs::ConvertToC(listenAddress, cs::GetRtspServerListenAddress(sink, status));
+}
+
+int CS_GetRtspServerPort(CS_Sink sink, CS_Status* status) {
+  return cs::GetRtspServerPort(sink, status);
+}
+
+}  // extern "C"
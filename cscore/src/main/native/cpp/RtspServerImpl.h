@@ -0,0 +1,79 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef CSCORE_RTSPSERVERIMPL_H_
+#define CSCORE_RTSPSERVERIMPL_H_
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <wpi/SafeThread.h>
+#include <wpinet/NetworkAcceptor.h>
+#include <wpinet/NetworkStream.h>
+
+#include "SinkImpl.h"
+
+namespace cs {
+
+class SourceImpl;
+
+// RTSP server that streams H.264 over RTP.  Only the TCP interleaved RTP
+// transport (RFC 2326 section 10.12) is supported, so each client needs just
+// its RTSP connection; this works through NAT and firewalls that only allow
+// the server port.
+class RtspServerImpl : public SinkImpl {
+ public:
+  RtspServerImpl(std::string_view name, wpi::Logger& logger,
+                 Notifier& notifier, Telemetry& telemetry,
+                 std::string_view listenAddress, int port,
+                 std::unique_ptr<wpi::NetworkAcceptor> acceptor);
+  ~RtspServerImpl() override;
+
+  void Stop();
+  std::string GetListenAddress() { return m_listenAddress; }
+  int GetPort() { return m_port; }
+
+ private:
+  void SetSourceImpl(std::shared_ptr<SourceImpl> source) override;
+  void UpdatePropertyValue(int property, bool setString, int value,
+                           std::string_view valueStr) override;
+
+  void ServerThreadMain();
+
+  class ConnThread;
+
+  // Encoder settings that can change while clients are streaming
+  struct EncoderSettings {
+    std::atomic_int bitrate{2000000};
+    std::atomic_int keyFrameInterval{60};
+  };
+
+  // Never changed, so not protected by mutex
+  std::string m_listenAddress;
+  int m_port;
+
+  std::unique_ptr<wpi::NetworkAcceptor> m_acceptor;
+  std::atomic_bool m_active;  // set to false to terminate threads
+  std::thread m_serverThread;
+
+  std::vector<wpi::SafeThreadOwner<ConnThread>> m_connThreads;
+
+  // Handed to connection threads, which may outlive the server
+  std::shared_ptr<EncoderSettings> m_encoderSettings;
+
+  // property indices
+  int m_widthProp;
+  int m_heightProp;
+  int m_fpsProp;
+  int m_bitrateProp;
+  int m_keyFrameIntervalProp;
+};
+
+}  // namespace cs
+
+#endif  // CSCORE_RTSPSERVERIMPL_H_
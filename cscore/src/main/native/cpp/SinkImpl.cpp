@@ -26,6 +26,7 @@ SinkImpl::SinkImpl(std::string_view name, wpi::Logger& logger,
 SinkImpl::~SinkImpl() {
   if (m_source) {
     if (m_enabledCount > 0) {
+      m_source->RemoveSinkDemand(this);
       m_source->DisableSink();
     }
     m_source->RemoveSink();
@@ -49,6 +50,9 @@ void SinkImpl::Enable() {
   ++m_enabledCount;
   if (m_enabledCount == 1) {
     if (m_source) {
+      if (m_demand.pixelFormat != VideoMode::kUnknown) {
+        m_source->SetSinkDemand(this, m_demand);
+      }
       m_source->EnableSink();
     }
     m_notifier.NotifySink(*this, CS_SINK_ENABLED);
@@ -60,6 +64,7 @@ void SinkImpl::Disable() {
   --m_enabledCount;
   if (m_enabledCount == 0) {
     if (m_source) {
+      m_source->RemoveSinkDemand(this);
       m_source->DisableSink();
     }
     m_notifier.NotifySink(*this, CS_SINK_DISABLED);
@@ -70,12 +75,16 @@ void SinkImpl::SetEnabled(bool enabled) {
   std::scoped_lock lock(m_mutex);
   if (enabled && m_enabledCount == 0) {
     if (m_source) {
+      if (m_demand.pixelFormat != VideoMode::kUnknown) {
+        m_source->SetSinkDemand(this, m_demand);
+      }
       m_source->EnableSink();
     }
     m_enabledCount = 1;
     m_notifier.NotifySink(*this, CS_SINK_ENABLED);
   } else if (!enabled && m_enabledCount > 0) {
     if (m_source) {
+      m_source->RemoveSinkDemand(this);
       m_source->DisableSink();
     }
     m_enabledCount = 0;
@@ -91,6 +100,7 @@ void SinkImpl::SetSource(std::shared_ptr<SourceImpl> source) {
     }
     if (m_source) {
       if (m_enabledCount > 0) {
+        m_source->RemoveSinkDemand(this);
         m_source->DisableSink();
       }
       m_source->RemoveSink();
@@ -99,6 +109,9 @@ void SinkImpl::SetSource(std::shared_ptr<SourceImpl> source) {
     if (m_source) {
       m_source->AddSink();
       if (m_enabledCount > 0) {
+        if (m_demand.pixelFormat != VideoMode::kUnknown) {
+          m_source->SetSinkDemand(this, m_demand);
+        }
         m_source->EnableSink();
       }
     }
@@ -106,6 +119,17 @@ void SinkImpl::SetSource(std::shared_ptr<SourceImpl> source) {
   SetSourceImpl(source);
 }
 
+void SinkImpl::SetDemand(const SinkDemand& demand) {
+  std::scoped_lock lock(m_mutex);
+  if (demand == m_demand) {
+    return;
+  }
+  m_demand = demand;
+  if (m_source && m_enabledCount > 0) {
+    m_source->SetSinkDemand(this, m_demand);
+  }
+}
+
 std::string SinkImpl::GetError() const {
   std::scoped_lock lock(m_mutex);
   if (!m_source) {
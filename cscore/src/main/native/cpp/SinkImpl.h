@@ -40,6 +40,10 @@ class SinkImpl : public PropertyContainer {
 
   void SetSource(std::shared_ptr<SourceImpl> source);
 
+  // Reports the image format and size this sink requests from frames, which
+  // the source uses (while the sink is enabled) to pick its capture format.
+  void SetDemand(const SinkDemand& demand);
+
   std::shared_ptr<SourceImpl> GetSource() const {
     std::scoped_lock lock(m_mutex);
     return m_source;
@@ -71,6 +75,7 @@ class SinkImpl : public PropertyContainer {
   std::string m_description;
   std::shared_ptr<SourceImpl> m_source;
   int m_enabledCount{0};
+  SinkDemand m_demand;
 };
 
 }  // namespace cs
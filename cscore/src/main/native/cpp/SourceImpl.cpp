@@ -21,7 +21,6 @@
 
 using namespace cs;
 
-static constexpr size_t kMaxImagesAvail = 32;
 
 SourceImpl::SourceImpl(std::string_view name, wpi::Logger& logger,
                        Notifier& notifier, Telemetry& telemetry)
@@ -42,6 +41,7 @@ SourceImpl::~SourceImpl() {
     m_destroyFrames = true;
     auto frames = std::move(m_framesAvail);
   }
+  m_imagePool.Shutdown();
   // Everything else can clean up itself.
 }
 
@@ -66,6 +66,45 @@ void SourceImpl::SetConnected(bool connected) {
   }
 }
 
+void SourceImpl::SetSinkDemand(const void* key, const SinkDemand& demand) {
+  {
+    std::scoped_lock lock(m_demandMutex);
+    auto it = std::find_if(m_sinkDemands.begin(), m_sinkDemands.end(),
+                           [&](const auto& d) { return d.first == key; });
+    if (it == m_sinkDemands.end()) {
+      m_sinkDemands.emplace_back(key, demand);
+    } else if (it->second == demand) {
+      return;
+    } else {
+      it->second = demand;
+    }
+  }
+  SinkDemandsChanged();
+}
+
+void SourceImpl::RemoveSinkDemand(const void* key) {
+  {
+    std::scoped_lock lock(m_demandMutex);
+    auto it = std::find_if(m_sinkDemands.begin(), m_sinkDemands.end(),
+                           [&](const auto& d) { return d.first == key; });
+    if (it == m_sinkDemands.end()) {
+      return;
+    }
+    m_sinkDemands.erase(it);
+  }
+  SinkDemandsChanged();
+}
+
+std::vector<SinkDemand> SourceImpl::GetSinkDemands() const {
+  std::scoped_lock lock(m_demandMutex);
+  std::vector<SinkDemand> demands;
+  demands.reserve(m_sinkDemands.size());
+  for (auto&& d : m_sinkDemands) {
+    demands.emplace_back(d.second);
+  }
+  return demands;
+}
+
 uint64_t SourceImpl::GetCurFrameTime() {
   std::unique_lock lock{m_frameMutex};
   return m_frame.GetTime();
@@ -429,30 +468,7 @@ std::vector<VideoMode> SourceImpl::EnumerateVideoModes(
 
 std::unique_ptr<Image> SourceImpl::AllocImage(
     VideoMode::PixelFormat pixelFormat, int width, int height, size_t size) {
-  std::unique_ptr<Image> image;
-  {
-    std::scoped_lock lock{m_poolMutex};
-    // find the smallest existing frame that is at least big enough.
-    int found = -1;
-    for (size_t i = 0; i < m_imagesAvail.size(); ++i) {
-      // is it big enough?
-      if (m_imagesAvail[i] && m_imagesAvail[i]->capacity() >= size) {
-        // is it smaller than the last found?
-        if (found < 0 ||
-            m_imagesAvail[i]->capacity() < m_imagesAvail[found]->capacity()) {
-          // yes, update
-          found = i;
-        }
-      }
-    }
-
-    // if nothing found, allocate a new buffer
-    if (found < 0) {
-      image = std::make_unique<Image>(size);
-    } else {
-      image = std::move(m_imagesAvail[found]);
-    }
-  }
+  auto image = m_imagePool.Alloc(size);
 
   // Initialize image
   image->SetSize(size);
@@ -490,6 +506,11 @@ void SourceImpl::PutFrame(std::unique_ptr<Image> image, Frame::Time time,
   // Update telemetry
   m_telemetry.RecordSourceFrames(*this, 1);
   m_telemetry.RecordSourceBytes(*this, static_cast<int>(image->size()));
+  if (time != 0) {
+    Frame::Time now = wpi::Now();
+    m_telemetry.RecordLatency(*this, CS_LATENCY_CAPTURE,
+                              now > time ? now - time : 0);
+  }
 
   // Update frame
   {
@@ -546,29 +567,7 @@ void SourceImpl::UpdatePropertyValue(int property, bool setString, int value,
 }
 
 void SourceImpl::ReleaseImage(std::unique_ptr<Image> image) {
-  std::scoped_lock lock{m_poolMutex};
-  if (m_destroyFrames) {
-    return;
-  }
-  // Return the frame to the pool.  First try to find an empty slot, otherwise
-  // add it to the end.
-  auto it = std::find(m_imagesAvail.begin(), m_imagesAvail.end(), nullptr);
-  if (it != m_imagesAvail.end()) {
-    *it = std::move(image);
-  } else if (m_imagesAvail.size() > kMaxImagesAvail) {
-    // Replace smallest buffer; don't need to check for null because the above
-    // find would have found it.
-    auto it2 = std::min_element(
-        m_imagesAvail.begin(), m_imagesAvail.end(),
-        [](const std::unique_ptr<Image>& a, const std::unique_ptr<Image>& b) {
-          return a->capacity() < b->capacity();
-        });
-    if ((*it2)->capacity() < image->capacity()) {
-      *it2 = std::move(image);
-    }
-  } else {
-    m_imagesAvail.emplace_back(std::move(image));
-  }
+  m_imagePool.Release(std::move(image));
 }
 
 std::unique_ptr<Frame::Impl> SourceImpl::AllocFrameImpl() {
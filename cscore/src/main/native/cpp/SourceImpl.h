@@ -10,6 +10,7 @@
 #include <memory>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include <wpi/Logger.h>
@@ -18,9 +19,11 @@
 #include <wpi/json_fwd.h>
 #include <wpi/mutex.h>
 
+#include "FormatNegotiation.h"
 #include "Frame.h"
 #include "Handle.h"
 #include "Image.h"
+#include "ImagePool.h"
 #include "PropertyContainer.h"
 #include "cscore_cpp.h"
 
@@ -50,9 +53,14 @@ class SourceImpl : public PropertyContainer {
     m_strategy = static_cast<int>(strategy);
     NumSinksChanged();
   }
+  CS_ConnectionStrategy GetConnectionStrategy() const {
+    return static_cast<CS_ConnectionStrategy>(m_strategy.load());
+  }
   bool IsEnabled() const {
     return m_strategy == CS_CONNECTION_KEEP_OPEN ||
-           (m_strategy == CS_CONNECTION_AUTO_MANAGE && m_numSinksEnabled > 0);
+           ((m_strategy == CS_CONNECTION_AUTO_MANAGE ||
+             m_strategy == CS_CONNECTION_ON_DEMAND) &&
+            m_numSinksEnabled > 0);
   }
 
   // User-visible connection status
@@ -88,6 +96,13 @@ class SourceImpl : public PropertyContainer {
     NumSinksEnabledChanged();
   }
 
+  // Functions to keep track of the image format and size each enabled
+  // consumer requests, so the source can pick the capture format that is
+  // cheapest to convert from.  The key identifies the consumer (a sink or
+  // one of its connections).
+  void SetSinkDemand(const void* key, const SinkDemand& demand);
+  void RemoveSinkDemand(const void* key);
+
   // Gets the current frame time (without waiting for a new one).
   uint64_t GetCurFrameTime();
 
@@ -135,6 +150,13 @@ class SourceImpl : public PropertyContainer {
 
   std::unique_ptr<Image> AllocImage(VideoMode::PixelFormat pixelFormat,
                                     int width, int height, size_t size);
+  // Returns an image from AllocImage() that wasn't put to the pool.
+  void ReleaseImage(std::unique_ptr<Image> image);
+
+  void SetImagePoolCapacity(size_t bytes) { m_imagePool.SetCapacity(bytes); }
+  ImagePoolStatistics GetImagePoolStatistics() const {
+    return m_imagePool.GetStatistics();
+  }
 
  protected:
   void NotifyPropertyCreated(int propIndex, PropertyImpl& prop) override;
@@ -151,6 +173,9 @@ class SourceImpl : public PropertyContainer {
   // Notification functions for corresponding atomics
   virtual void NumSinksChanged() = 0;
   virtual void NumSinksEnabledChanged() = 0;
+  virtual void SinkDemandsChanged() {}
+
+  std::vector<SinkDemand> GetSinkDemands() const;
 
   std::atomic_int m_numSinks{0};
 
@@ -165,7 +190,6 @@ class SourceImpl : public PropertyContainer {
   Telemetry& m_telemetry;
 
  private:
-  void ReleaseImage(std::unique_ptr<Image> image);
   std::unique_ptr<Frame::Impl> AllocFrameImpl();
   void ReleaseFrameImpl(std::unique_ptr<Frame::Impl> data);
 
@@ -175,6 +199,9 @@ class SourceImpl : public PropertyContainer {
   std::atomic_int m_strategy{CS_CONNECTION_AUTO_MANAGE};
   std::atomic_int m_numSinksEnabled{0};
 
+  mutable wpi::mutex m_demandMutex;
+  std::vector<std::pair<const void*, SinkDemand>> m_sinkDemands;
+
   wpi::mutex m_frameMutex;
   wpi::condition_variable m_frameCv;
 
@@ -183,14 +210,14 @@ class SourceImpl : public PropertyContainer {
   // Pool of frames/images to reduce malloc traffic.
   wpi::mutex m_poolMutex;
   std::vector<std::unique_ptr<Frame::Impl>> m_framesAvail;
-  std::vector<std::unique_ptr<Image>> m_imagesAvail;
+  ImagePool m_imagePool;
 
   std::atomic_bool m_connected{false};
 
   // Most recent frame (returned to callers of GetNextFrame)
   // Access protected by m_frameMutex.
-  // MUST be located below m_poolMutex as the Frame destructor calls back
-  // into SourceImpl::ReleaseImage, which locks m_poolMutex.
+  // MUST be located below m_poolMutex and m_imagePool as the Frame destructor
+  // calls back into SourceImpl::ReleaseImage and ReleaseFrameImpl.
   Frame m_frame;
 };
 
@@ -26,6 +26,8 @@ class Telemetry::Thread : public wpi::SafeThread {
   Notifier& m_notifier;
   wpi::DenseMap<std::pair<CS_Handle, int>, int64_t> m_user;
   wpi::DenseMap<std::pair<CS_Handle, int>, int64_t> m_current;
+  wpi::DenseMap<std::pair<CS_Handle, int>, LatencyHistogram> m_userLatency;
+  wpi::DenseMap<std::pair<CS_Handle, int>, LatencyHistogram> m_currentLatency;
   double m_period = 0.0;
   double m_elapsed = 0.0;
   bool m_updated = false;
@@ -77,6 +79,8 @@ void Telemetry::Thread::Main() {
     // move to user and clear current, as we don't keep around old values
     m_user = std::move(m_current);
     m_current.clear();
+    m_userLatency = std::move(m_currentLatency);
+    m_currentLatency.clear();
     auto curTime = std::chrono::steady_clock::now();
     m_elapsed = std::chrono::duration<double>(curTime - prevTime).count();
     prevTime = curTime;
@@ -130,6 +134,23 @@ double Telemetry::GetAverageValue(CS_Handle handle, CS_TelemetryKind kind,
   return thr->GetValue(handle, kind, status) / thr->m_elapsed;
 }
 
+LatencyHistogram Telemetry::GetLatency(CS_Handle handle,
+                                       CS_LatencyStage stage,
+                                       CS_Status* status) {
+  auto thr = m_owner.GetThread();
+  if (!thr) {
+    *status = CS_TELEMETRY_NOT_ENABLED;
+    return {};
+  }
+  auto it =
+      thr->m_userLatency.find(std::pair{handle, static_cast<int>(stage)});
+  if (it == thr->m_userLatency.end()) {
+    *status = CS_EMPTY_VALUE;
+    return {};
+  }
+  return it->getSecond();
+}
+
 void Telemetry::RecordSourceBytes(const SourceImpl& source, int quantity) {
   auto thr = m_owner.GetThread();
   if (!thr) {
@@ -151,3 +172,15 @@ void Telemetry::RecordSourceFrames(const SourceImpl& source, int quantity) {
                            static_cast<int>(CS_SOURCE_FRAMES_RECEIVED)}] +=
       quantity;
 }
+
+void Telemetry::RecordLatency(const SourceImpl& source, CS_LatencyStage stage,
+                              int64_t us) {
+  auto thr = m_owner.GetThread();
+  if (!thr) {
+    return;
+  }
+  auto handleData = Instance::GetInstance().FindSource(source);
+  thr->m_currentLatency[std::pair{Handle{handleData.first, Handle::kSource},
+                                  static_cast<int>(stage)}]
+      .Record(us);
+}
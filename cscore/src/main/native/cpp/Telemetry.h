@@ -30,10 +30,14 @@ class Telemetry {
   int64_t GetValue(CS_Handle handle, CS_TelemetryKind kind, CS_Status* status);
   double GetAverageValue(CS_Handle handle, CS_TelemetryKind kind,
                          CS_Status* status);
+  LatencyHistogram GetLatency(CS_Handle handle, CS_LatencyStage stage,
+                              CS_Status* status);
 
   // Telemetry events
   void RecordSourceBytes(const SourceImpl& source, int quantity);
   void RecordSourceFrames(const SourceImpl& source, int quantity);
+  void RecordLatency(const SourceImpl& source, CS_LatencyStage stage,
+                     int64_t us);
 
  private:
   Notifier& m_notifier;
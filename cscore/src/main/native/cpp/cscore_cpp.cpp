@@ -413,6 +413,26 @@ std::span<CS_Sink> EnumerateSourceSinks(CS_Source source,
   return inst.EnumerateSourceSinks(source, vec);
 }
 
+void SetSourceImagePoolCapacity(CS_Source source, size_t bytes,
+                                CS_Status* status) {
+  auto data = Instance::GetInstance().GetSource(source);
+  if (!data) {
+    *status = CS_INVALID_HANDLE;
+    return;
+  }
+  data->source->SetImagePoolCapacity(bytes);
+}
+
+ImagePoolStatistics GetSourceImagePoolStatistics(CS_Source source,
+                                                 CS_Status* status) {
+  auto data = Instance::GetInstance().GetSource(source);
+  if (!data) {
+    *status = CS_INVALID_HANDLE;
+    return {};
+  }
+  return data->source->GetImagePoolStatistics();
+}
+
 CS_Source CopySource(CS_Source source, CS_Status* status) {
   if (source == 0) {
     return 0;
@@ -842,6 +862,11 @@ double GetTelemetryAverageValue(CS_Handle handle, CS_TelemetryKind kind,
                                                            status);
 }
 
+LatencyHistogram GetTelemetryLatency(CS_Source source, CS_LatencyStage stage,
+                                     CS_Status* status) {
+  return Instance::GetInstance().telemetry.GetLatency(source, stage, status);
+}
+
 //
 // Logging Functions
 //
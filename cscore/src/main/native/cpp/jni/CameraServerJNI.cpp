@@ -1657,6 +1657,62 @@ Java_edu_wpi_first_cscore_CameraServerJNI_grabRawSinkFrameTimeout
   return rv;
 }
 
+/*
+ * Class:     edu_wpi_first_cscore_CameraServerJNI
+ * Method:    borrowRawSinkFrame
+ * Signature: (ILjava/lang/Object;JDJ)J
+ */
+JNIEXPORT jlong JNICALL
+Java_edu_wpi_first_cscore_CameraServerJNI_borrowRawSinkFrame
+  (JNIEnv* env, jclass, jint sink, jobject frameObj, jlong framePtr,
+   jdouble timeout, jlong lastFrameTime)
+{
+  auto* frame = reinterpret_cast<wpi::RawFrame*>(framePtr);
+  if (!frame) {
+    nullPointerEx.Throw(env, "frame is null");
+    return 0;
+  }
+  auto origData = frame->data;
+  CS_Status status = 0;
+  auto rv = cs::BorrowSinkFrame(static_cast<CS_Sink>(sink), *frame, timeout,
+                                lastFrameTime, &status);
+  if (!CheckStatus(env, status)) {
+    return 0;
+  }
+  // the direct ByteBuffer points at the borrowed image
+  wpi::SetFrameData(env, rawFrameCls, frameObj, *frame,
+                    origData != frame->data);
+  return rv;
+}
+
+/*
+ * Class:     edu_wpi_first_cscore_CameraServerJNI
+ * Method:    releaseRawSinkFrame
+ * Signature: (Ljava/lang/Object;J)V
+ */
+JNIEXPORT void JNICALL
+Java_edu_wpi_first_cscore_CameraServerJNI_releaseRawSinkFrame
+  (JNIEnv* env, jclass, jobject frameObj, jlong framePtr)
+{
+  auto* frame = reinterpret_cast<wpi::RawFrame*>(framePtr);
+  if (!frame) {
+    nullPointerEx.Throw(env, "frame is null");
+    return;
+  }
+  WPI_FreeRawFrameData(frame);
+  frame->size = 0;
+  // drop the Java reference to the released data
+  static jmethodID setData = env->GetMethodID(
+      rawFrameCls, "setDataJNI", "(Ljava/nio/ByteBuffer;IIIIJI)V");
+  env->CallVoidMethod(frameObj, setData, nullptr,
+                      static_cast<jint>(frame->width),
+                      static_cast<jint>(frame->height),
+                      static_cast<jint>(frame->stride),
+                      static_cast<jint>(frame->pixelFormat),
+                      static_cast<jlong>(frame->timestamp),
+                      static_cast<jint>(frame->timestampSrc));
+}
+
 /*
  * Class:     edu_wpi_first_cscore_CameraServerJNI
  * Method:    getSinkError
@@ -136,7 +136,8 @@ enum CS_SinkKind {
   CS_SINK_UNKNOWN = 0,
   CS_SINK_MJPEG = 2,
   CS_SINK_CV = 4,
-  CS_SINK_RAW = 8
+  CS_SINK_RAW = 8,
+  CS_SINK_RTSP = 16
 };
 
 /**
@@ -173,6 +174,24 @@ enum CS_TelemetryKind {
   CS_SOURCE_FRAMES_RECEIVED = 2
 };
 
+/**
+ * Frame pipeline stages for latency telemetry
+ */
+enum CS_LatencyStage {
+  /** Frame timestamp (e.g. driver capture time) to frame put by source */
+  CS_LATENCY_CAPTURE = 0,
+  /** Frame put by source to frame received by a sink */
+  CS_LATENCY_DELIVERY = 1,
+  /** Pixel format conversion and resizing */
+  CS_LATENCY_CONVERT = 2,
+  /** JPEG encoding (including any conversion and resizing before it) */
+  CS_LATENCY_ENCODE = 3,
+  /** Sending a frame to a network client */
+  CS_LATENCY_SEND = 4,
+  /** Frame timestamp to a sink finishing with the frame */
+  CS_LATENCY_TOTAL = 5
+};
+
 /** Connection strategy */
 enum CS_ConnectionStrategy {
   /**
@@ -191,7 +210,15 @@ enum CS_ConnectionStrategy {
    * Never open the connection.  If this is set when the connection is open,
    * close the connection.
    */
-  CS_CONNECTION_FORCE_CLOSE
+  CS_CONNECTION_FORCE_CLOSE,
+
+  /**
+   * Like CS_CONNECTION_AUTO_MANAGE, but also close the device after no sinks
+   * have been enabled for a short time.  The device configuration is cached
+   * and restored when a sink is enabled again.  Only USB cameras on Linux
+   * close the device; other sources behave as CS_CONNECTION_AUTO_MANAGE.
+   */
+  CS_CONNECTION_ON_DEMAND
 };
 
 /**
@@ -390,6 +417,9 @@ void CS_SetSourceEnumPropertyChoices(CS_Source source, CS_Property property,
 CS_Sink CS_CreateMjpegServer(const struct WPI_String* name,
                              const struct WPI_String* listenAddress, int port,
                              CS_Status* status);
+CS_Sink CS_CreateRtspServer(const struct WPI_String* name,
+                            const struct WPI_String* listenAddress, int port,
+                            CS_Status* status);
 CS_Sink CS_CreateCvSink(const struct WPI_String* name,
                         enum WPI_PixelFormat pixelFormat, CS_Status* status);
 CS_Sink CS_CreateCvSinkCallback(const struct WPI_String* name,
@@ -433,6 +463,16 @@ void CS_GetMjpegServerListenAddress(CS_Sink sink,
 int CS_GetMjpegServerPort(CS_Sink sink, CS_Status* status);
 /** @} */
 
+/**
+ * @defgroup cscore_rtspserver_cfunc RtspServer Sink Functions
+ * @{
+ */
+void CS_GetRtspServerListenAddress(CS_Sink sink,
+                                   struct WPI_String* listenAddress,
+                                   CS_Status* status);
+int CS_GetRtspServerPort(CS_Sink sink, CS_Status* status);
+/** @} */
+
 /**
  * @defgroup cscore_frame_sink_cfunc Frame Sink Functions
  * @{
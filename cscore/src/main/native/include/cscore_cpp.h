@@ -7,6 +7,7 @@
 
 #include <stdint.h>
 
+#include <array>
 #include <functional>
 #include <span>
 #include <string>
@@ -96,6 +97,57 @@ struct VideoMode : public CS_VideoMode {
   }
 };
 
+/**
+ * Image buffer pool statistics for a source
+ */
+struct ImagePoolStatistics {
+  /** Number of image buffer allocations satisfied from the pool */
+  uint64_t hits = 0;
+  /** Number of image buffer allocations that required a new buffer */
+  uint64_t misses = 0;
+  /** Number of released buffers freed because the pool was full */
+  uint64_t discards = 0;
+  /** Number of free buffers currently in the pool */
+  size_t pooledBuffers = 0;
+  /** Total size of free buffers currently in the pool, in bytes */
+  size_t pooledBytes = 0;
+};
+
+/**
+ * Histogram of latencies, in microseconds.  Below 16 us there is a single
+ * bucket; from there to about 1 second, each power of two is split into four
+ * buckets; the last bucket holds everything longer.
+ */
+struct LatencyHistogram {
+  static constexpr int kNumBuckets = 66;
+
+  /** Number of recorded latencies */
+  int64_t count = 0;
+  /** Sum of recorded latencies */
+  int64_t sum = 0;
+  /** Maximum recorded latency */
+  int64_t max = 0;
+  /** Number of recorded latencies in each bucket */
+  std::array<int64_t, kNumBuckets> buckets{};
+
+  void Record(int64_t us);
+
+  /** Gets the mean latency, or 0 if none were recorded. */
+  double GetMean() const;
+
+  /**
+   * Estimates a percentile (e.g. 99 for the 99th percentile) of the recorded
+   * latencies, interpolating within the bucket it falls in.
+   */
+  double GetPercentile(double percentile) const;
+
+  /** Gets the bucket a latency falls in. */
+  static int GetBucket(int64_t us);
+
+  /** Gets the (exclusive) upper bound of the latencies in a bucket. */
+  static int64_t GetBucketUpperBound(int bucket);
+};
+
 /**
  * Listener event
  */
@@ -256,6 +308,10 @@ std::vector<VideoMode> EnumerateSourceVideoModes(CS_Source source,
 std::span<CS_Sink> EnumerateSourceSinks(CS_Source source,
                                         wpi::SmallVectorImpl<CS_Sink>& vec,
                                         CS_Status* status);
+void SetSourceImagePoolCapacity(CS_Source source, size_t bytes,
+                                CS_Status* status);
+ImagePoolStatistics GetSourceImagePoolStatistics(CS_Source source,
+                                                 CS_Status* status);
 CS_Source CopySource(CS_Source source, CS_Status* status);
 void ReleaseSource(CS_Source source, CS_Status* status);
 /** @} */
@@ -318,6 +374,8 @@ void SetSourceEnumPropertyChoices(CS_Source source, CS_Property property,
  */
 CS_Sink CreateMjpegServer(std::string_view name, std::string_view listenAddress,
                           int port, CS_Status* status);
+CS_Sink CreateRtspServer(std::string_view name, std::string_view listenAddress,
+                         int port, CS_Status* status);
 CS_Sink CreateCvSink(std::string_view name, VideoMode::PixelFormat pixelFormat,
                      CS_Status* status);
 CS_Sink CreateCvSinkCallback(std::string_view name,
@@ -365,6 +423,14 @@ std::string GetMjpegServerListenAddress(CS_Sink sink, CS_Status* status);
 int GetMjpegServerPort(CS_Sink sink, CS_Status* status);
 /** @} */
 
+/**
+ * @defgroup cscore_rtspserver_func RtspServer Sink Functions
+ * @{
+ */
+std::string GetRtspServerListenAddress(CS_Sink sink, CS_Status* status);
+int GetRtspServerPort(CS_Sink sink, CS_Status* status);
+/** @} */
+
 /**
  * @defgroup cscore_frame_sink_func Frame Sink Functions
  * @{
@@ -411,6 +477,8 @@ int64_t GetTelemetryValue(CS_Handle handle, CS_TelemetryKind kind,
                           CS_Status* status);
 double GetTelemetryAverageValue(CS_Handle handle, CS_TelemetryKind kind,
                                 CS_Status* status);
+LatencyHistogram GetTelemetryLatency(CS_Source source, CS_LatencyStage stage,
+                                     CS_Status* status);
 /** @} */
 
 /**
@@ -5,7 +5,10 @@
 #ifndef CSCORE_CSCORE_CV_H_
 #define CSCORE_CSCORE_CV_H_
 
+#include <algorithm>
 #include <functional>
+#include <span>
+#include <vector>
 
 #include <opencv2/core/mat.hpp>
 #include <wpi/RawFrame.h>
@@ -73,6 +76,31 @@ class CvSource : public ImageSource {
   void PutFrame(cv::Mat& image, VideoMode::PixelFormat pixelFormat,
                 bool skipVerification);
 
+  /**
+   * Get an OpenCV image backed by a buffer from the source's image pool, to
+   * draw a frame into and put with CommitFrame() without a copy.
+   *
+   * <p>
+   * The returned image shares frame's buffer and is only valid until frame is
+   * committed or destroyed.
+   *
+   * @param frame       frame holding the buffer
+   * @param pixelFormat pixel format of the image
+   * @param width       width of the image
+   * @param height      height of the image
+   * @return OpenCV image
+   */
+  cv::Mat AllocFrame(wpi::RawFrame& frame, VideoMode::PixelFormat pixelFormat,
+                     int width, int height);
+
+  /**
+   * Put a frame allocated by AllocFrame() and notify sinks, without copying
+   * it.
+   *
+   * @param frame frame holding the buffer
+   */
+  void CommitFrame(wpi::RawFrame& frame);
+
  private:
   static bool VerifyFormat(cv::Mat& image, VideoMode::PixelFormat pixelFormat);
 };
@@ -173,6 +201,36 @@ class CvSink : public ImageSink {
   uint64_t GrabFrameDirectLastTime(cv::Mat& image, uint64_t lastFrameTime,
                                    double timeout = 0.225);
 
+  /**
+   * Set the number of frames to queue for GrabFramesDirect().  While the
+   * queue is enabled, a thread in the sink waits for frames from the source
+   * and queues them, dropping the oldest frame when the queue is full, so
+   * frames are not missed while user code is busy.
+   *
+   * @param size number of frames to queue; 0 disables the queue
+   */
+  void SetFrameQueueSize(int size);
+
+  /**
+   * Get the most recent frames from the frame queue, oldest first, and
+   * remove them from the queue.  If the queue is empty, waits up to timeout
+   * seconds for a frame; a timeout of 0 polls without blocking.  If the queue
+   * is not enabled, it is enabled with a size of images.size(), so the first
+   * call may return no frames.
+   * The provided images will have the pixelFormat this class was constructed
+   * with. The data is backed by data in the CvSink. It will be invalidated by
+   * the next GrabFramesDirect() call on the sink.
+   *
+   * @param images images to fill
+   * @param times filled with the frame time of each image; must be at least
+   *              as long as images
+   * @param timeout timeout in seconds
+   * @return Number of images filled
+   */
+  [[nodiscard]]
+  int GrabFramesDirect(std::span<cv::Mat> images, std::span<uint64_t> times,
+                       double timeout = 0.225);
+
   /**
    * Get the last time a frame was grabbed. This uses the same time base as
    * wpi::Now().
@@ -194,6 +252,7 @@ class CvSink : public ImageSink {
   constexpr int GetCvFormat(WPI_PixelFormat pixelFormat);
 
   wpi::RawFrame rawFrame;
+  std::vector<wpi::RawFrame> rawFrames;
   VideoMode::PixelFormat pixelFormat;
 };
 
@@ -319,6 +378,44 @@ inline void CvSource::PutFrame(cv::Mat& image,
   PutSourceFrame(m_handle, frame, &m_status);
 }
 
+inline cv::Mat CvSource::AllocFrame(wpi::RawFrame& frame,
+                                    VideoMode::PixelFormat pixelFormat,
+                                    int width, int height) {
+  frame.pixelFormat = pixelFormat;
+  frame.width = width;
+  frame.height = height;
+  m_status = 0;
+  AllocSourceFrame(m_handle, frame, &m_status);
+  if (m_status != CS_OK) {
+    return cv::Mat{};
+  }
+  int type;
+  switch (pixelFormat) {
+    case VideoMode::kYUYV:
+    case VideoMode::kRGB565:
+    case VideoMode::kY16:
+    case VideoMode::kUYVY:
+      type = CV_8UC2;
+      break;
+    case VideoMode::kBGR:
+      type = CV_8UC3;
+      break;
+    case VideoMode::kBGRA:
+      type = CV_8UC4;
+      break;
+    default:
+      type = CV_8UC1;
+      break;
+  }
+  return cv::Mat{height, width, type, frame.data,
+                 static_cast<size_t>(frame.stride)};
+}
+
+inline void CvSource::CommitFrame(wpi::RawFrame& frame) {
+  m_status = 0;
+  CommitSourceFrame(m_handle, frame, &m_status);
+}
+
 inline CvSink::CvSink(std::string_view name,
                       VideoMode::PixelFormat pixelFormat) {
   m_handle = CreateRawSink(name, true, &m_status);
@@ -423,6 +520,42 @@ inline uint64_t CvSink::GrabFrameDirectLastTime(cv::Mat& image,
   return timestamp;
 }
 
+inline void CvSink::SetFrameQueueSize(int size) {
+  m_status = 0;
+  SetSinkFrameQueueSize(m_handle, size, &m_status);
+}
+
+inline int CvSink::GrabFramesDirect(std::span<cv::Mat> images,
+                                    std::span<uint64_t> times,
+                                    double timeout) {
+  size_t count = std::min(images.size(), times.size());
+  if (rawFrames.size() < count) {
+    rawFrames.resize(count);
+  }
+  wpi::SmallVector<WPI_RawFrame*, 16> ptrs;
+  for (size_t i = 0; i < count; ++i) {
+    rawFrames[i].height = 0;
+    rawFrames[i].width = 0;
+    rawFrames[i].stride = 0;
+    rawFrames[i].pixelFormat = pixelFormat;
+    ptrs.emplace_back(&rawFrames[i]);
+  }
+  m_status = 0;
+  int grabbed = GrabSinkFrames(m_handle, ptrs, timeout, &m_status);
+  if (m_status != CS_OK) {
+    return 0;
+  }
+  for (int i = 0; i < grabbed; ++i) {
+    auto& frame = rawFrames[i];
+    images[i] =
+        cv::Mat{frame.height, frame.width,
+                GetCvFormat(static_cast<WPI_PixelFormat>(frame.pixelFormat)),
+                frame.data, static_cast<size_t>(frame.stride)};
+    times[i] = frame.timestamp;
+  }
+  return grabbed;
+}
+
 inline uint64_t CvSink::LastFrameTime() {
   return rawFrame.timestamp;
 }
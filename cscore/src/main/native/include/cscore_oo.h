@@ -289,7 +289,15 @@ class VideoSource {
      * Never open the connection.  If this is set when the connection is open,
      * close the connection.
      */
-    kConnectionForceClose = CS_CONNECTION_FORCE_CLOSE
+    kConnectionForceClose = CS_CONNECTION_FORCE_CLOSE,
+
+    /**
+     * Like kConnectionAutoManage, but also close the device after no sinks
+     * have been enabled for a short time.  The device configuration is cached
+     * and restored when a sink is enabled again.  Only USB cameras on Linux
+     * close the device; other sources behave as kConnectionAutoManage.
+     */
+    kConnectionOnDemand = CS_CONNECTION_ON_DEMAND
   };
 
   VideoSource() noexcept = default;
@@ -564,6 +572,21 @@ class VideoSource {
                                         &m_status);
   }
 
+  /**
+   * Get the latencies of a stage of the frame pipeline for frames from this
+   * source, e.g. how long sinks take to receive frames after the source puts
+   * them (CS_LATENCY_DELIVERY).
+   *
+   * <p>SetTelemetryPeriod() must be called for this to be valid.
+   *
+   * @param stage pipeline stage
+   * @return Latency histogram over the telemetry period.
+   */
+  LatencyHistogram GetLatency(CS_LatencyStage stage) const {
+    m_status = 0;
+    return cs::GetTelemetryLatency(m_handle, stage, &m_status);
+  }
+
   /**
    * Enumerate all known video modes for this source.
    */
@@ -572,6 +595,29 @@ class VideoSource {
     return EnumerateSourceVideoModes(m_handle, &status);
   }
 
+  /**
+   * Set the maximum total size of free image buffers kept for reuse by this
+   * source.  The default is 64 MB.  Pipelines with many high resolution
+   * conversions or slow sinks may need more to avoid allocating buffers at
+   * the frame rate; see GetImagePoolStatistics().
+   *
+   * @param bytes capacity in bytes, 0 to disable buffer reuse
+   */
+  void SetImagePoolCapacity(size_t bytes) {
+    m_status = 0;
+    SetSourceImagePoolCapacity(m_handle, bytes, &m_status);
+  }
+
+  /**
+   * Get statistics for the image buffer pool of this source.  A steadily
+   * increasing number of misses means buffers are being allocated at the
+   * frame rate.
+   */
+  ImagePoolStatistics GetImagePoolStatistics() const {
+    m_status = 0;
+    return GetSourceImagePoolStatistics(m_handle, &m_status);
+  }
+
   CS_Status GetLastStatus() const { return m_status; }
 
   /**
@@ -765,6 +811,52 @@ class UsbCamera : public VideoCamera {
     SetProperty(GetSourceProperty(m_handle, "connect_verbose", &m_status),
                 level, &m_status);
   }
+
+  /**
+   * Set whether frames are passed to sinks directly in the camera's
+   * memory-mapped buffers, rather than being copied.  This reduces memory
+   * bandwidth, but a buffer is not returned to the camera driver until all
+   * frames referencing it are released; frames are copied if sinks hold on
+   * to too many buffers.  Only supported on Linux and Windows.
+   *
+   * @param enabled true to enable zero-copy frames
+   */
+  void SetZeroCopy(bool enabled) {
+    m_status = 0;
+    SetProperty(GetSourceProperty(m_handle, "zero_copy", &m_status),
+                enabled ? 1 : 0, &m_status);
+  }
+
+  /**
+   * Set whether the camera pixel format is chosen automatically to minimize
+   * conversions for the image formats and sizes requested by connected sinks
+   * (e.g. capturing YUYV rather than MJPEG when all sinks want BGR images).
+   * Only formats available at the current resolution and frame rate are
+   * considered.  Has no effect once a pixel format has been set explicitly.
+   * Only supported on Linux.
+   *
+   * @param enabled true to choose the pixel format automatically
+   */
+  void SetAutoPixelFormat(bool enabled) {
+    m_status = 0;
+    SetProperty(GetSourceProperty(m_handle, "auto_pixel_format", &m_status),
+                enabled ? 1 : 0, &m_status);
+  }
+
+  /**
+   * Set whether MJPEG frames are decoded to YUYV by MediaFoundation (using a
+   * hardware decoder if one is available) before they are passed to sinks.
+   * This is much faster than decoding in sinks that want BGR images, but
+   * sinks serving MJPEG must then re-encode the frames.  Changing this
+   * reconnects to the camera.  Only supported on Windows.
+   *
+   * @param enabled true to decode MJPEG frames in MediaFoundation
+   */
+  void SetHardwareDecode(bool enabled) {
+    m_status = 0;
+    SetProperty(GetSourceProperty(m_handle, "hw_decode", &m_status),
+                enabled ? 1 : 0, &m_status);
+  }
 };
 
 /**
@@ -1146,6 +1238,8 @@ class VideoSink {
     kCv = CS_SINK_CV,
     /// Raw video sink.
     kRaw = CS_SINK_RAW,
+    /// RTSP (H.264) video sink.
+    kRtsp = CS_SINK_RTSP,
   };
 
   VideoSink() noexcept = default;
@@ -1445,6 +1539,103 @@ class MjpegServer : public VideoSink {
   }
 };
 
+/**
+ * A sink that acts as an H.264-over-RTSP network server.
+ *
+ * <p>Frames are encoded with a hardware H.264 encoder (on Linux, a V4L2
+ * memory-to-memory encoder device).  Clients connect with rtsp://host:port/
+ * and must use RTP over the RTSP connection (TCP interleaved) transport.
+ * Each streaming client gets its own encoder instance.
+ */
+class RtspServer : public VideoSink {
+ public:
+  RtspServer() = default;
+
+  /**
+   * Create an H.264-over-RTSP server sink.
+   *
+   * @param name Sink name (arbitrary unique identifier)
+   * @param listenAddress TCP listen address (empty string for all addresses)
+   * @param port TCP port number
+   */
+  RtspServer(std::string_view name, std::string_view listenAddress, int port) {
+    m_handle = CreateRtspServer(name, listenAddress, port, &m_status);
+  }
+
+  /**
+   * Create an H.264-over-RTSP server sink.
+   *
+   * @param name Sink name (arbitrary unique identifier)
+   * @param port TCP port number
+   */
+  RtspServer(std::string_view name, int port) : RtspServer(name, "", port) {}
+
+  /**
+   * Get the listen address of the server.
+   */
+  std::string GetListenAddress() const {
+    m_status = 0;
+    return cs::GetRtspServerListenAddress(m_handle, &m_status);
+  }
+
+  /**
+   * Get the port number of the server.
+   */
+  int GetPort() const {
+    m_status = 0;
+    return cs::GetRtspServerPort(m_handle, &m_status);
+  }
+
+  /**
+   * Set the stream resolution.
+   *
+   * @param width width, 0 for the source resolution
+   * @param height height, 0 for the source resolution
+   */
+  void SetResolution(int width, int height) {
+    m_status = 0;
+    SetProperty(GetSinkProperty(m_handle, "width", &m_status), width,
+                &m_status);
+    SetProperty(GetSinkProperty(m_handle, "height", &m_status), height,
+                &m_status);
+  }
+
+  /**
+   * Set the maximum stream frames per second (FPS).
+   *
+   * @param fps FPS, 0 for the source FPS
+   */
+  void SetFPS(int fps) {
+    m_status = 0;
+    SetProperty(GetSinkProperty(m_handle, "fps", &m_status), fps, &m_status);
+  }
+
+  /**
+   * Set the target encoder bitrate.  Takes effect immediately for connected
+   * clients.
+   *
+   * @param bitrate bitrate, in bits per second
+   */
+  void SetBitrate(int bitrate) {
+    m_status = 0;
+    SetProperty(GetSinkProperty(m_handle, "bitrate", &m_status), bitrate,
+                &m_status);
+  }
+
+  /**
+   * Set the number of frames between key frames.  Shorter intervals let
+   * clients recover from lost data sooner at the cost of bandwidth.  Takes
+   * effect for clients that start streaming after it is set.
+   *
+   * @param frames key frame interval, in frames
+   */
+  void SetKeyFrameInterval(int frames) {
+    m_status = 0;
+    SetProperty(GetSinkProperty(m_handle, "keyframe_interval", &m_status),
+                frames, &m_status);
+  }
+};
+
 /**
  * A base class for single image reading sinks.
  */
@@ -11,6 +11,10 @@
 
 // NOLINTBEGIN
 #ifdef __cplusplus
+#include <span>
+
+#include <wpi/SmallVector.h>
+
 #include "cscore_oo.h"
 #endif
 
@@ -32,6 +36,16 @@ uint64_t CS_GrabRawSinkFrameTimeoutWithFrameTime(CS_Sink sink,
                                                  double timeout,
                                                  uint64_t lastFrameTime,
                                                  CS_Status* status);
+uint64_t CS_BorrowRawSinkFrame(CS_Sink sink, struct WPI_RawFrame* rawImage,
+                               double timeout, uint64_t lastFrameTime,
+                               CS_Status* status);
+void CS_SetRawSinkFrameQueueSize(CS_Sink sink, int size, CS_Status* status);
+int CS_GrabRawSinkFrames(CS_Sink sink, struct WPI_RawFrame* rawImages,
+                         int count, double timeout, CS_Status* status);
+uint64_t CS_GrabRawSinkFrameSet(const CS_Sink* sinks,
+                                struct WPI_RawFrame* rawImages, int count,
+                                uint64_t window, double timeout,
+                                CS_Status* status);
 
 CS_Sink CS_CreateRawSink(const struct WPI_String* name, CS_Bool isCv,
                          CS_Status* status);
@@ -42,6 +56,10 @@ CS_Sink CS_CreateRawSinkCallback(
 
 void CS_PutRawSourceFrame(CS_Source source, const struct WPI_RawFrame* image,
                           CS_Status* status);
+void CS_AllocRawSourceFrame(CS_Source source, struct WPI_RawFrame* image,
+                            CS_Status* status);
+void CS_CommitRawSourceFrame(CS_Source source, struct WPI_RawFrame* image,
+                             CS_Status* status);
 
 CS_Source CS_CreateRawSource(const struct WPI_String* name, CS_Bool isCv,
                              const CS_VideoMode* mode, CS_Status* status);
@@ -69,12 +87,68 @@ CS_Sink CreateRawSinkCallback(std::string_view name, bool isCv,
 
 void PutSourceFrame(CS_Source source, const WPI_RawFrame& image,
                     CS_Status* status);
+
+/**
+ * Points image at a buffer from the source's image pool, so the image can be
+ * drawn directly into and passed to CommitSourceFrame() without a copy.
+ *
+ * The image's pixel format, width, and height must be set; for compressed
+ * formats (MJPEG), its size must be set to the buffer size needed.  The
+ * buffer is returned to the pool if the image's data is freed without being
+ * committed.
+ *
+ * @param source raw or OpenCV source
+ * @param image image to allocate the buffer for
+ * @param status status
+ */
+void AllocSourceFrame(CS_Source source, WPI_RawFrame& image,
+                      CS_Status* status);
+
+/**
+ * Puts an image allocated by AllocSourceFrame() and notifies sinks, without
+ * copying it.  The image no longer has a buffer afterwards.  For compressed
+ * formats, the image's size must be set to the size of the data.  Images
+ * that weren't allocated from this source are copied as for PutSourceFrame().
+ *
+ * @param source raw or OpenCV source
+ * @param image image to commit
+ * @param status status
+ */
+void CommitSourceFrame(CS_Source source, WPI_RawFrame& image,
+                       CS_Status* status);
 uint64_t GrabSinkFrame(CS_Sink sink, WPI_RawFrame& image, CS_Status* status);
 uint64_t GrabSinkFrameTimeout(CS_Sink sink, WPI_RawFrame& image, double timeout,
                               CS_Status* status);
 uint64_t GrabSinkFrameTimeoutLastTime(CS_Sink sink, WPI_RawFrame& image,
                                       double timeout, uint64_t lastFrameTime,
                                       CS_Status* status);
+uint64_t BorrowSinkFrame(CS_Sink sink, WPI_RawFrame& image, double timeout,
+                         uint64_t lastFrameTime, CS_Status* status);
+void SetSinkFrameQueueSize(CS_Sink sink, int size, CS_Status* status);
+int GrabSinkFrames(CS_Sink sink, std::span<WPI_RawFrame* const> images,
+                   double timeout, CS_Status* status);
+
+/**
+ * Grabs a synchronized set of frames, one from each sink, whose frame times
+ * are all within window microseconds of each other.  This is used to combine
+ * images from several cameras that were captured at (nearly) the same time.
+ *
+ * Each sink's frame queue is used (and enabled if it isn't already), so the
+ * newest matching set is returned even if the cameras deliver frames at
+ * different times; frames older than the returned set are dropped.  Each
+ * image is converted as for GrabSinkFrame() and its timestamp is set to its
+ * frame time.
+ *
+ * @param sinks raw or OpenCV sinks
+ * @param images one image per sink
+ * @param window maximum difference between frame times, in microseconds
+ * @param timeout seconds to wait for a matching set
+ * @param status status
+ * @return Oldest frame time in the set, or 0 on timeout or error
+ */
+uint64_t GrabSinkFrameSet(std::span<const CS_Sink> sinks,
+                          std::span<WPI_RawFrame* const> images,
+                          uint64_t window, double timeout, CS_Status* status);
 
 /**
  * A source for user code to provide video frames as raw bytes.
@@ -112,6 +186,23 @@ class RawSource : public ImageSource {
    * @param image raw frame image
    */
   void PutFrame(wpi::RawFrame& image);
+
+  /**
+   * Get a buffer from the source's image pool to draw a frame into.  The
+   * image's pixel format, width, and height must be set.  Pass the image to
+   * CommitFrame() to put it without a copy.
+   *
+   * @param image raw frame image
+   */
+  void AllocFrame(wpi::RawFrame& image);
+
+  /**
+   * Put an image allocated by AllocFrame() and notify sinks, without copying
+   * it.
+   *
+   * @param image raw frame image
+   */
+  void CommitFrame(wpi::RawFrame& image);
 };
 
 /**
@@ -148,6 +239,19 @@ class RawSink : public ImageSink {
   RawSink(std::string_view name,
           std::function<void(uint64_t time)> processFrame);
 
+  /**
+   * Set the number of frames to queue for GrabFrames().  While the queue is
+   * enabled, a thread in the sink waits for frames from the source and queues
+   * them, dropping the oldest frame when the queue is full, so frames are not
+   * missed while user code is busy.
+   *
+   * @param size number of frames to queue; 0 disables the queue
+   */
+  void SetFrameQueueSize(int size) {
+    m_status = 0;
+    SetSinkFrameQueueSize(m_handle, size, &m_status);
+  }
+
  protected:
   /**
    * Wait for the next frame and get the image.
@@ -189,6 +293,99 @@ class RawSink : public ImageSink {
   [[nodiscard]]
   uint64_t GrabFrameLastTime(wpi::RawFrame& image, uint64_t lastFrameTime,
                              double timeout = 0.225) const;
+
+  /**
+   * Get the most recent frames from the frame queue, oldest first, and
+   * remove them from the queue.  If the queue is empty, waits up to timeout
+   * seconds for a frame; a timeout of 0 polls without blocking.  If the queue
+   * is not enabled, it is enabled with a size of images.size(), so the first
+   * call may return no frames.
+   *
+   * <p>Each image is converted to the pixel format and resolution it is set
+   * to, as for GrabFrame(), and its timestamp is set to the frame time.
+   *
+   * @return Number of images filled
+   */
+  [[nodiscard]]
+  int GrabFrames(std::span<wpi::RawFrame> images, double timeout = 0.225) const;
+};
+
+/**
+ * A sink that delivers grayscale images without copying them, for image
+ * processing such as AprilTag detection that only needs brightness.
+ *
+ * Each frame is converted straight to grayscale from the camera's format
+ * (for YUYV and UYVY, by taking the Y plane; for MJPEG, by decoding
+ * directly to grayscale), and a grayscale camera's frames are delivered as-is,
+ * so there is no BGR conversion and no copy. The image is borrowed from the
+ * camera: it stays valid until the wpi::RawFrame is destroyed or used to grab
+ * another frame, and must not be modified, as other sinks may share it. For
+ * example, with an AprilTagDetector:
+ *
+ * <pre>
+ * wpi::RawFrame frame;
+ * if (sink.GrabFrame(frame) != 0) {
+ *   auto detections = detector.Detect(frame.width, frame.height, frame.stride,
+ *                                     frame.data);
+ * }
+ * </pre>
+ */
+class GrayscaleSink : public RawSink {
+ public:
+  GrayscaleSink() = default;
+
+  /**
+   * Create a sink for borrowing grayscale images.
+   *
+   * <p>GrabFrame() must be called on the created sink to get each new
+   * image.
+   *
+   * @param name Sink name (arbitrary unique identifier)
+   */
+  explicit GrayscaleSink(std::string_view name) : RawSink{name} {}
+
+  /**
+   * Wait for the next frame and borrow its grayscale image.
+   * Times out (returning 0) after timeout seconds.
+   *
+   * <p>The image is scaled to the resolution of image if it is set, and
+   * otherwise has the camera's resolution. The previous image borrowed into
+   * image is released.
+   *
+   * @param image frame to point at the grayscale image
+   * @param timeout timeout in seconds
+   * @return Frame time, or 0 on error (call GetError() to obtain the error
+   *         message); the frame time is in the same time base as wpi::Now(),
+   *         and is in 1 us increments.
+   */
+  [[nodiscard]]
+  uint64_t GrabFrame(wpi::RawFrame& image, double timeout = 0.225) const {
+    return GrabFrameLastTime(image, 0, timeout);
+  }
+
+  /**
+   * Wait for the next frame and borrow its grayscale image.
+   * Times out (returning 0) after timeout seconds.
+   *
+   * <p>If lastFrameTime is provided and non-zero, the sink will borrow the
+   * first frame from the source that is not equal to lastFrameTime. If
+   * lastFrameTime is zero, this function will block until the source provides
+   * a new frame.
+   *
+   * @param image frame to point at the grayscale image
+   * @param lastFrameTime time of the last frame
+   * @param timeout timeout in seconds
+   * @return Frame time, or 0 on error (call GetError() to obtain the error
+   *         message); the frame time is in the same time base as wpi::Now(),
+   *         and is in 1 us increments.
+   */
+  [[nodiscard]]
+  uint64_t GrabFrameLastTime(wpi::RawFrame& image, uint64_t lastFrameTime,
+                             double timeout = 0.225) const {
+    image.pixelFormat = WPI_PIXFMT_GRAY;
+    m_status = 0;
+    return BorrowSinkFrame(m_handle, image, timeout, lastFrameTime, &m_status);
+  }
 };
 
 inline RawSource::RawSource(std::string_view name, const VideoMode& mode) {
@@ -207,6 +404,16 @@ inline void RawSource::PutFrame(wpi::RawFrame& image) {
   PutSourceFrame(m_handle, image, &m_status);
 }
 
+inline void RawSource::AllocFrame(wpi::RawFrame& image) {
+  m_status = 0;
+  AllocSourceFrame(m_handle, image, &m_status);
+}
+
+inline void RawSource::CommitFrame(wpi::RawFrame& image) {
+  m_status = 0;
+  CommitSourceFrame(m_handle, image, &m_status);
+}
+
 inline RawSink::RawSink(std::string_view name) {
   m_handle = CreateRawSink(name, false, &m_status);
 }
@@ -233,6 +440,16 @@ inline uint64_t RawSink::GrabFrameLastTime(wpi::RawFrame& image,
   return GrabSinkFrameTimeoutLastTime(m_handle, image, timeout, lastFrameTime,
                                       &m_status);
 }
+
+inline int RawSink::GrabFrames(std::span<wpi::RawFrame> images,
+                               double timeout) const {
+  wpi::SmallVector<WPI_RawFrame*, 16> ptrs;
+  for (auto&& image : images) {
+    ptrs.emplace_back(&image);
+  }
+  m_status = 0;
+  return GrabSinkFrames(m_handle, ptrs, timeout, &m_status);
+}
 /** @} */
 
 }  // namespace cs
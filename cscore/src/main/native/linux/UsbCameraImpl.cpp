@@ -29,10 +29,12 @@
 #include <wpi/MemAlloc.h>
 #include <wpi/SmallString.h>
 #include <wpi/StringExtras.h>
+#include <wpi/ThreadRegistry.h>
 #include <wpi/fs.h>
 #include <wpi/raw_ostream.h>
 #include <wpi/timestamp.h>
 
+#include "FormatNegotiation.h"
 #include "Instance.h"
 #include "JpegUtil.h"
 #include "Log.h"
@@ -58,6 +60,19 @@ static constexpr char const* kPropExValue = "exposure_absolute";
 static constexpr char const* kPropBrValue = "brightness";
 static constexpr char const* kPropConnectVerbose = "connect_verbose";
 static constexpr unsigned kPropConnectVerboseId = 0;
+static constexpr char const* kPropZeroCopy = "zero_copy";
+static constexpr unsigned kPropZeroCopyId = 1;
+static constexpr char const* kPropAutoPixelFormat = "auto_pixel_format";
+static constexpr unsigned kPropAutoPixelFormatId = 2;
+
+// Minimum number of buffers to keep queued to the driver in zero-copy mode;
+// frames are copied instead if zero-copy images are holding the rest
+static constexpr int kMinQueuedBuffers = 2;
+
+// Time (in microseconds) a source with the on-demand connection strategy
+// must go without enabled sinks before the device is closed.  This keeps
+// briefly reconnecting clients from reopening the device.
+static constexpr uint64_t kOnDemandCloseTime = 5000000;
 
 // Conversions v4l2_fract time per frame from/to frames per second (fps)
 static inline int FractToFPS(const struct v4l2_fract& timeperframe) {
@@ -341,7 +356,9 @@ UsbCameraImpl::UsbCameraImpl(std::string_view name, wpi::Logger& logger,
       m_fd{-1},
       m_command_fd{eventfd(0, 0)},
       m_active{true},
+      m_releasedBuffers{std::make_shared<ReleasedBuffers>()},
       m_path{path} {
+  m_releasedBuffers->commandFd = m_command_fd;
   SetDescription(GetDescriptionImpl(m_path.c_str()));
   SetQuirks();
 
@@ -350,6 +367,15 @@ UsbCameraImpl::UsbCameraImpl(std::string_view name, wpi::Logger& logger,
                                                kPropConnectVerboseId,
                                                CS_PROP_INTEGER, 0, 1, 1, 1, 1);
   });
+  CreateProperty(kPropZeroCopy, [] {
+    return std::make_unique<UsbCameraProperty>(kPropZeroCopy, kPropZeroCopyId,
+                                               CS_PROP_INTEGER, 0, 1, 1, 0, 0);
+  });
+  CreateProperty(kPropAutoPixelFormat, [] {
+    return std::make_unique<UsbCameraProperty>(kPropAutoPixelFormat,
+                                               kPropAutoPixelFormatId,
+                                               CS_PROP_INTEGER, 0, 1, 1, 0, 0);
+  });
 }
 
 UsbCameraImpl::~UsbCameraImpl() {
@@ -367,6 +393,12 @@ UsbCameraImpl::~UsbCameraImpl() {
     m_cameraThread.join();
   }
 
+  // stop zero-copy images still in use from sending to the command fd
+  {
+    std::scoped_lock lock(m_releasedBuffers->mutex);
+    m_releasedBuffers->commandFd = -1;
+  }
+
   // close command fd
   int fd = m_command_fd.exchange(-1);
   if (fd >= 0) {
@@ -389,6 +421,8 @@ void UsbCameraImpl::Start() {
 }
 
 void UsbCameraImpl::CameraThreadMain() {
+  wpi::SetCurrentThreadClass(wpi::ThreadClass::kCamera, "UsbCamera");
+
   // We want to be notified on file creation and deletion events in the device
   // path.  This is used to detect disconnects and reconnects.
   std::unique_ptr<wpi::raw_fd_istream> notify_is;
@@ -419,10 +453,30 @@ void UsbCameraImpl::CameraThreadMain() {
   // Default to not streaming
   m_streaming = false;
 
+  // Time at which the source was last disabled (0 while enabled)
+  uint64_t disabledTime = 0;
+
   while (m_active) {
+    // With the on-demand strategy, close the device once it has been disabled
+    // for long enough.  The video mode and property values stay cached and
+    // are restored by DeviceConnect() when a sink is enabled again.
+    bool closeIdle = false;
+    if (IsEnabled()) {
+      disabledTime = 0;
+    } else if (disabledTime == 0) {
+      disabledTime = wpi::Now();
+    } else if (GetConnectionStrategy() == CS_CONNECTION_ON_DEMAND &&
+               m_properties_cached) {
+      closeIdle = (wpi::Now() - disabledTime) >= kOnDemandCloseTime;
+    }
+
     // If not connected, try to reconnect
-    if (m_fd < 0) {
+    if (m_fd < 0 && !closeIdle) {
       DeviceConnect();
+    } else if (m_fd >= 0 && closeIdle) {
+      SDEBUG("closing idle device");
+      DeviceStreamOff();
+      DeviceDisconnect();
     }
 
     // Make copies of fd's in case they go away
@@ -450,7 +504,7 @@ void UsbCameraImpl::CameraThreadMain() {
 
     // The select timeout can be long unless we're trying to reconnect
     struct timeval tv;
-    if (fd < 0 && notified) {
+    if (fd < 0 && notified && !closeIdle) {
       tv.tv_sec = 0;
       tv.tv_usec = 300000;
     } else {
@@ -514,6 +568,7 @@ void UsbCameraImpl::CameraThreadMain() {
       eventfd_t val;
       eventfd_read(command_fd, &val);
       DeviceProcessCommands();
+      DeviceRequeueBuffers();
       continue;
     }
 
@@ -538,13 +593,13 @@ void UsbCameraImpl::CameraThreadMain() {
       if ((buf.flags & V4L2_BUF_FLAG_ERROR) == 0) {
         SDEBUG4("got image size={} index={}", buf.bytesused, buf.index);
 
-        if (buf.index >= kNumBuffers || !m_buffers[buf.index].m_data) {
+        if (buf.index >= kNumBuffers || !m_buffers[buf.index]) {
           SWARNING("invalid buffer {}", buf.index);
           continue;
         }
 
         std::string_view image{
-            static_cast<const char*>(m_buffers[buf.index].m_data),
+            static_cast<const char*>(m_buffers[buf.index]->m_data),
             static_cast<size_t>(buf.bytesused)};
         int width = m_mode.width;
         int height = m_mode.height;
@@ -598,8 +653,29 @@ void UsbCameraImpl::CameraThreadMain() {
             SDEBUG4("Got valid copy time for frame - default to wpi::Now");
           }
 
-          PutFrame(static_cast<VideoMode::PixelFormat>(m_mode.pixelFormat),
-                   width, height, image, frameTime, timeSource);
+          auto pixelFormat =
+              static_cast<VideoMode::PixelFormat>(m_mode.pixelFormat);
+          if (m_zeroCopy && pixelFormat != VideoMode::kBGRA &&
+              std::count(m_bufferHeld.begin(), m_bufferHeld.end(), true) <
+                  kNumBuffers - kMinQueuedBuffers) {
+            // Hand the buffer itself to the sinks; it's requeued when the
+            // last frame referencing it is released
+            auto& mapping = m_buffers[buf.index];
+            auto frame = std::make_unique<Image>(
+                static_cast<uchar*>(mapping->m_data), buf.bytesused,
+                [released = m_releasedBuffers, mapping,
+                 generation = m_bufferGeneration, index = buf.index] {
+                  released->Release(generation, index);
+                });
+            frame->pixelFormat = pixelFormat;
+            frame->width = width;
+            frame->height = height;
+            m_bufferHeld[buf.index] = true;
+            PutFrame(std::move(frame), frameTime, timeSource);
+            continue;
+          }
+
+          PutFrame(pixelFormat, width, height, image, frameTime, timeSource);
         }
       }
 
@@ -626,9 +702,9 @@ void UsbCameraImpl::DeviceDisconnect() {
     return;  // already disconnected
   }
 
-  // Unmap buffers
+  // Unmap buffers (zero-copy images keep their buffer mapped until released)
   for (int i = 0; i < kNumBuffers; ++i) {
-    m_buffers[i] = UsbCameraBuffer{};
+    m_buffers[i].reset();
   }
 
   // Close device
@@ -713,6 +789,8 @@ void UsbCameraImpl::DeviceConnect() {
 
   // Map buffers
   SDEBUG3("mapping buffers");
+  ++m_bufferGeneration;
+  m_bufferHeld.fill(false);
   for (int i = 0; i < kNumBuffers; ++i) {
     struct v4l2_buffer buf;
     std::memset(&buf, 0, sizeof(buf));
@@ -727,19 +805,20 @@ void UsbCameraImpl::DeviceConnect() {
     }
     SDEBUG4("buf {} length={} offset={}", i, buf.length, buf.m.offset);
 
-    m_buffers[i] = UsbCameraBuffer(fd, buf.length, buf.m.offset);
-    if (!m_buffers[i].m_data) {
+    m_buffers[i] =
+        std::make_shared<UsbCameraBuffer>(fd, buf.length, buf.m.offset);
+    if (!m_buffers[i]->m_data) {
       SWARNING("could not map buffer {}", i);
-      // release other buffers
-      for (int j = 0; j < i; ++j) {
-        m_buffers[j] = UsbCameraBuffer{};
+      // release buffers
+      for (int j = 0; j <= i; ++j) {
+        m_buffers[j].reset();
       }
       close(fd);
       m_fd = -1;
       return;
     }
 
-    SDEBUG4("buf {} address={}", i, m_buffers[i].m_data);
+    SDEBUG4("buf {} address={}", i, m_buffers[i]->m_data);
   }
 
   // Update description (as it may have changed)
@@ -764,6 +843,9 @@ bool UsbCameraImpl::DeviceStreamOn() {
   // Queue buffers
   SDEBUG3("queuing buffers");
   for (int i = 0; i < kNumBuffers; ++i) {
+    if (m_bufferHeld[i]) {
+      continue;  // queued when released
+    }
     struct v4l2_buffer buf;
     std::memset(&buf, 0, sizeof(buf));
     buf.index = i;
@@ -823,10 +905,12 @@ CS_StatusValue UsbCameraImpl::DeviceCmdSetMode(
     m_modeSetPixelFormat = true;
     m_modeSetResolution = true;
     m_modeSetFPS = true;
+    m_pixelFormatNegotiated = false;
   } else if (msg.kind == Message::kCmdSetPixelFormat) {
     newMode = m_mode;
     newMode.pixelFormat = msg.data[0];
     m_modeSetPixelFormat = true;
+    m_pixelFormatNegotiated = false;
   } else if (msg.kind == Message::kCmdSetResolution) {
     newMode = m_mode;
     newMode.width = msg.data[0];
@@ -922,6 +1006,10 @@ CS_StatusValue UsbCameraImpl::DeviceCmdSetProperty(
   if (!prop->device) {
     if (prop->id == kPropConnectVerboseId) {
       m_connectVerbose = value;
+    } else if (prop->id == kPropZeroCopyId) {
+      m_zeroCopy = value;
+    } else if (prop->id == kPropAutoPixelFormatId) {
+      m_autoPixelFormat = value;
     }
   } else {
     if (!prop->DeviceSet(lock, m_fd, value, valueStr)) {
@@ -936,6 +1024,10 @@ CS_StatusValue UsbCameraImpl::DeviceCmdSetProperty(
                         valueStr);
   }
 
+  if (!prop->device && prop->id == kPropAutoPixelFormatId) {
+    DeviceNegotiatePixelFormat(lock);
+  }
+
   return CS_OK;
 }
 
@@ -972,6 +1064,9 @@ CS_StatusValue UsbCameraImpl::DeviceProcessCommand(
   } else if (msg.kind == Message::kNumSinksChanged ||
              msg.kind == Message::kNumSinksEnabledChanged) {
     return CS_OK;
+  } else if (msg.kind == Message::kSinkDemandsChanged) {
+    DeviceNegotiatePixelFormat(lock);
+    return CS_OK;
   } else if (msg.kind == Message::kCmdSetPath) {
     return DeviceCmdSetPath(lock, msg);
   } else {
@@ -979,6 +1074,27 @@ CS_StatusValue UsbCameraImpl::DeviceProcessCommand(
   }
 }
 
+void UsbCameraImpl::DeviceNegotiatePixelFormat(
+    std::unique_lock<wpi::mutex>& lock) {
+  // Don't override a pixel format set by the user
+  if (!m_autoPixelFormat ||
+      (m_modeSetPixelFormat && !m_pixelFormatNegotiated)) {
+    return;
+  }
+
+  auto demands = GetSinkDemands();
+  VideoMode mode = ChooseVideoMode(m_videoModes, m_mode, demands);
+  if (mode.pixelFormat == m_mode.pixelFormat) {
+    return;
+  }
+  SDEBUG("switching to pixel format {} to reduce conversions",
+         mode.pixelFormat);
+  Message msg{Message::kCmdSetPixelFormat};
+  msg.data[0] = mode.pixelFormat;
+  DeviceCmdSetMode(lock, msg);
+  m_pixelFormatNegotiated = true;
+}
+
 void UsbCameraImpl::DeviceProcessCommands() {
   std::unique_lock lock(m_mutex);
   if (m_commands.empty()) {
@@ -990,7 +1106,8 @@ void UsbCameraImpl::DeviceProcessCommands() {
 
     CS_StatusValue status = DeviceProcessCommand(lock, msg);
     if (msg.kind != Message::kNumSinksChanged &&
-        msg.kind != Message::kNumSinksEnabledChanged) {
+        msg.kind != Message::kNumSinksEnabledChanged &&
+        msg.kind != Message::kSinkDemandsChanged) {
       m_responses.emplace_back(msg.from, status);
     }
   }
@@ -998,6 +1115,41 @@ void UsbCameraImpl::DeviceProcessCommands() {
   m_responseCv.notify_all();
 }
 
+void UsbCameraImpl::ReleasedBuffers::Release(unsigned generation,
+                                             unsigned index) {
+  std::scoped_lock lock(mutex);
+  if (commandFd >= 0) {
+    buffers.emplace_back(generation, index);
+    eventfd_write(commandFd, 1);
+  }
+}
+
+void UsbCameraImpl::DeviceRequeueBuffers() {
+  std::vector<std::pair<unsigned, unsigned>> released;
+  {
+    std::scoped_lock lock(m_releasedBuffers->mutex);
+    released.swap(m_releasedBuffers->buffers);
+  }
+  int fd = m_fd.load();
+  for (auto [generation, index] : released) {
+    if (generation != m_bufferGeneration) {
+      continue;  // buffers have been reallocated since
+    }
+    m_bufferHeld[index] = false;
+    if (!m_streaming || fd < 0) {
+      continue;  // queued when streaming is turned on
+    }
+    struct v4l2_buffer buf;
+    std::memset(&buf, 0, sizeof(buf));
+    buf.index = index;
+    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory = V4L2_MEMORY_MMAP;
+    if (DoIoctl(fd, VIDIOC_QBUF, &buf) != 0) {
+      SWARNING("could not requeue buffer {}", index);
+    }
+  }
+}
+
 void UsbCameraImpl::DeviceSetMode() {
   int fd = m_fd.load();
   if (fd < 0) {
@@ -1600,6 +1752,10 @@ void UsbCameraImpl::NumSinksEnabledChanged() {
   Send(Message{Message::kNumSinksEnabledChanged});
 }
 
+void UsbCameraImpl::SinkDemandsChanged() {
+  Send(Message{Message::kSinkDemandsChanged});
+}
+
 void UsbCameraImpl::SetPath(std::string_view path, CS_Status* status) {
   Message msg{Message::kCmdSetPath};
   msg.dataStr = path;
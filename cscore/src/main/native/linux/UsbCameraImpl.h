@@ -7,6 +7,7 @@
 
 #include <linux/videodev2.h>
 
+#include <array>
 #include <atomic>
 #include <memory>
 #include <string>
@@ -61,6 +62,7 @@ class UsbCameraImpl : public SourceImpl {
 
   void NumSinksChanged() override;
   void NumSinksEnabledChanged() override;
+  void SinkDemandsChanged() override;
 
   void SetPath(std::string_view path, CS_Status* status);
   std::string GetPath() const;
@@ -78,6 +80,7 @@ class UsbCameraImpl : public SourceImpl {
       kCmdSetPropertyStr,
       kNumSinksChanged,         // no response
       kNumSinksEnabledChanged,  // no response
+      kSinkDemandsChanged,      // no response
       // Responses
       kOk,
       kError
@@ -116,6 +119,7 @@ class UsbCameraImpl : public SourceImpl {
   bool DeviceStreamOn();
   bool DeviceStreamOff();
   void DeviceProcessCommands();
+  void DeviceRequeueBuffers();
   void DeviceSetMode();
   void DeviceSetFPS();
   void DeviceCacheMode();
@@ -132,6 +136,7 @@ class UsbCameraImpl : public SourceImpl {
                                       const Message& msg);
   CS_StatusValue DeviceCmdSetPath(std::unique_lock<wpi::mutex>& lock,
                                   const Message& msg);
+  void DeviceNegotiatePixelFormat(std::unique_lock<wpi::mutex>& lock);
 
   // Property helper functions
   int RawToPercentage(const UsbCameraProperty& rawProp, int rawValue);
@@ -146,16 +151,36 @@ class UsbCameraImpl : public SourceImpl {
   bool m_modeSetPixelFormat{false};
   bool m_modeSetResolution{false};
   bool m_modeSetFPS{false};
+  int m_autoPixelFormat{0};
+  // Pixel format was picked by DeviceNegotiatePixelFormat, not the user
+  bool m_pixelFormatNegotiated{false};
   int m_connectVerbose{1};
   unsigned m_capabilities = 0;
+  int m_zeroCopy{0};
   // Number of buffers to ask OS for
   static constexpr int kNumBuffers = 4;
-  std::array<UsbCameraBuffer, kNumBuffers> m_buffers;
+  // Shared with zero-copy images, which may outlive the mapping
+  std::array<std::shared_ptr<UsbCameraBuffer>, kNumBuffers> m_buffers;
+  // Buffers held by zero-copy images rather than queued to the driver
+  std::array<bool, kNumBuffers> m_bufferHeld{};
+  // Incremented when buffers are reallocated
+  unsigned m_bufferGeneration{0};
 
   std::atomic_int m_fd;
   std::atomic_int m_command_fd;  // for command eventfd
 
   std::atomic_bool m_active;  // set to false to terminate thread
+
+  // Buffers released by zero-copy images, to be requeued by the camera
+  // thread.  Shared with the images, as they may outlive the camera.
+  struct ReleasedBuffers {
+    void Release(unsigned generation, unsigned index);
+
+    wpi::mutex mutex;
+    int commandFd;  // -1 once the camera is destroyed
+    std::vector<std::pair<unsigned, unsigned>> buffers;
+  };
+  std::shared_ptr<ReleasedBuffers> m_releasedBuffers;
   std::thread m_cameraThread;
 
   // Quirks
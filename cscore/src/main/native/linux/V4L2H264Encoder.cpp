@@ -0,0 +1,417 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <fcntl.h>
+#include <linux/videodev2.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <wpi/Logger.h>
+
+#include "ColorConvert.h"
+#include "H264Encoder.h"
+#include "Log.h"
+#include "UsbCameraBuffer.h"
+#include "UsbUtil.h"
+
+using namespace cs;
+
+namespace {
+
+// Stateful memory-to-memory encoder (e.g. the Raspberry Pi bcm2835-codec or
+// Rockchip/Amlogic VPUs).  Raw frames are queued on the OUTPUT queue and
+// encoded frames are dequeued from the CAPTURE queue.
+class V4L2H264Encoder : public H264Encoder {
+ public:
+  V4L2H264Encoder(std::string_view path, const Settings& settings,
+                  wpi::Logger& logger)
+      : m_path{path}, m_settings{settings}, m_logger{logger} {}
+  ~V4L2H264Encoder() override;
+
+  bool Init();
+
+  std::string_view GetName() const override { return m_path; }
+  bool Encode(std::span<const uint8_t> bgr, bool forceKeyFrame,
+              std::vector<uint8_t>& out) override;
+  void SetBitrate(int bitrate) override;
+
+ private:
+  static constexpr int kNumBuffers = 2;
+
+  bool SetControl(uint32_t id, int32_t value);
+  bool SetupQueue(uint32_t type,
+                  std::array<UsbCameraBuffer, kNumBuffers>& buffers);
+  bool ReclaimOutputBuffers();
+
+  std::string m_path;
+  Settings m_settings;
+  wpi::Logger& m_logger;
+  int m_fd = -1;
+  bool m_streaming = false;
+
+  // raw frame layout
+  bool m_nv12 = false;
+  uint32_t m_bytesPerLine = 0;
+  uint32_t m_planeHeight = 0;
+  std::vector<uint8_t> m_yuv;
+
+  std::array<UsbCameraBuffer, kNumBuffers> m_outputBuffers;
+  std::array<UsbCameraBuffer, kNumBuffers> m_captureBuffers;
+  std::array<bool, kNumBuffers> m_outputQueued{};
+};
+
+}  // namespace
+
+// Returns true if the device is a memory-to-memory H.264 encoder
+static bool IsH264EncoderDevice(int fd) {
+  v4l2_capability vcap;
+  std::memset(&vcap, 0, sizeof(vcap));
+  if (TryIoctl(fd, VIDIOC_QUERYCAP, &vcap) < 0) {
+    return false;
+  }
+  uint32_t caps = vcap.capabilities;
+  if (caps & V4L2_CAP_DEVICE_CAPS) {
+    caps = vcap.device_caps;
+  }
+  if ((caps & V4L2_CAP_VIDEO_M2M_MPLANE) == 0) {
+    return false;
+  }
+  v4l2_fmtdesc fmt;
+  std::memset(&fmt, 0, sizeof(fmt));
+  fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+  for (fmt.index = 0; TryIoctl(fd, VIDIOC_ENUM_FMT, &fmt) >= 0; ++fmt.index) {
+    if (fmt.pixelformat == V4L2_PIX_FMT_H264) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Calls func with the path of each encoder device until it returns true
+template <typename F>
+static void ForEachEncoderDevice(F&& func) {
+  for (int i = 0; i < 64; ++i) {
+    auto path = fmt::format("/dev/video{}", i);
+    int fd = open(path.c_str(), O_RDWR | O_NONBLOCK);
+    if (fd < 0) {
+      continue;
+    }
+    bool isEncoder = IsH264EncoderDevice(fd);
+    close(fd);
+    if (isEncoder && func(path)) {
+      return;
+    }
+  }
+}
+
+V4L2H264Encoder::~V4L2H264Encoder() {
+  if (m_fd < 0) {
+    return;
+  }
+  if (m_streaming) {
+    int type = V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE;
+    TryIoctl(m_fd, VIDIOC_STREAMOFF, &type);
+    type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+    TryIoctl(m_fd, VIDIOC_STREAMOFF, &type);
+  }
+  // buffers must be unmapped before the device is closed
+  m_outputBuffers = {};
+  m_captureBuffers = {};
+  close(m_fd);
+}
+
+bool V4L2H264Encoder::SetControl(uint32_t id, int32_t value) {
+  v4l2_control ctrl;
+  ctrl.id = id;
+  ctrl.value = value;
+  return TryIoctl(m_fd, VIDIOC_S_CTRL, &ctrl) >= 0;
+}
+
+bool V4L2H264Encoder::SetupQueue(
+    uint32_t type, std::array<UsbCameraBuffer, kNumBuffers>& buffers) {
+  v4l2_requestbuffers rb;
+  std::memset(&rb, 0, sizeof(rb));
+  rb.count = kNumBuffers;
+  rb.type = type;
+  rb.memory = V4L2_MEMORY_MMAP;
+  if (DoIoctl(m_fd, VIDIOC_REQBUFS, &rb) != 0 || rb.count < kNumBuffers) {
+    return false;
+  }
+  for (int i = 0; i < kNumBuffers; ++i) {
+    v4l2_plane plane;
+    v4l2_buffer buf;
+    std::memset(&plane, 0, sizeof(plane));
+    std::memset(&buf, 0, sizeof(buf));
+    buf.type = type;
+    buf.memory = V4L2_MEMORY_MMAP;
+    buf.index = i;
+    buf.m.planes = &plane;
+    buf.length = 1;
+    if (DoIoctl(m_fd, VIDIOC_QUERYBUF, &buf) != 0) {
+      return false;
+    }
+    buffers[i] = UsbCameraBuffer(m_fd, plane.length, plane.m.mem_offset);
+    if (!buffers[i].m_data) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool V4L2H264Encoder::Init() {
+  m_fd = open(m_path.c_str(), O_RDWR | O_NONBLOCK);
+  if (m_fd < 0) {
+    return false;
+  }
+
+  // encoded format; this must be set before the raw format
+  v4l2_format vfmt;
+  std::memset(&vfmt, 0, sizeof(vfmt));
+  vfmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+  vfmt.fmt.pix_mp.width = m_settings.width;
+  vfmt.fmt.pix_mp.height = m_settings.height;
+  vfmt.fmt.pix_mp.pixelformat = V4L2_PIX_FMT_H264;
+  vfmt.fmt.pix_mp.field = V4L2_FIELD_ANY;
+  vfmt.fmt.pix_mp.num_planes = 1;
+  vfmt.fmt.pix_mp.plane_fmt[0].sizeimage =
+      std::max(m_settings.width * m_settings.height, 512 * 1024);
+  if (DoIoctl(m_fd, VIDIOC_S_FMT, &vfmt) != 0) {
+    return false;
+  }
+
+  // raw format; prefer NV12 but accept I420, both single plane
+  for (uint32_t pixelFormat : {V4L2_PIX_FMT_NV12, V4L2_PIX_FMT_YUV420}) {
+    std::memset(&vfmt, 0, sizeof(vfmt));
+    vfmt.type = V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE;
+    vfmt.fmt.pix_mp.width = m_settings.width;
+    vfmt.fmt.pix_mp.height = m_settings.height;
+    vfmt.fmt.pix_mp.pixelformat = pixelFormat;
+    vfmt.fmt.pix_mp.field = V4L2_FIELD_ANY;
+    vfmt.fmt.pix_mp.num_planes = 1;
+    if (TryIoctl(m_fd, VIDIOC_S_FMT, &vfmt) == 0 &&
+        vfmt.fmt.pix_mp.pixelformat == pixelFormat &&
+        vfmt.fmt.pix_mp.num_planes == 1 &&
+        static_cast<int>(vfmt.fmt.pix_mp.width) == m_settings.width &&
+        static_cast<int>(vfmt.fmt.pix_mp.height) >= m_settings.height) {
+      m_nv12 = pixelFormat == V4L2_PIX_FMT_NV12;
+      m_bytesPerLine = vfmt.fmt.pix_mp.plane_fmt[0].bytesperline;
+      m_planeHeight = vfmt.fmt.pix_mp.height;
+      break;
+    }
+  }
+  if (m_bytesPerLine == 0) {
+    WARNING("{}: no supported raw format for {}x{}", m_path,
+            m_settings.width, m_settings.height);
+    return false;
+  }
+
+  if (m_settings.fps > 0) {
+    v4l2_streamparm parm;
+    std::memset(&parm, 0, sizeof(parm));
+    parm.type = V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE;
+    parm.parm.output.timeperframe.numerator = 1;
+    parm.parm.output.timeperframe.denominator = m_settings.fps;
+    TryIoctl(m_fd, VIDIOC_S_PARM, &parm);
+  }
+
+  // not all drivers support all controls, so failures are ignored
+  SetControl(V4L2_CID_MPEG_VIDEO_BITRATE, m_settings.bitrate);
+  SetControl(V4L2_CID_MPEG_VIDEO_H264_I_PERIOD, m_settings.keyFrameInterval);
+  SetControl(V4L2_CID_MPEG_VIDEO_GOP_SIZE, m_settings.keyFrameInterval);
+  SetControl(V4L2_CID_MPEG_VIDEO_H264_PROFILE,
+             V4L2_MPEG_VIDEO_H264_PROFILE_CONSTRAINED_BASELINE);
+  // clients can join mid-stream, so every IDR frame needs SPS/PPS
+  SetControl(V4L2_CID_MPEG_VIDEO_REPEAT_SEQ_HEADER, 1);
+
+  if (!SetupQueue(V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE, m_outputBuffers) ||
+      !SetupQueue(V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE, m_captureBuffers)) {
+    return false;
+  }
+
+  for (int i = 0; i < kNumBuffers; ++i) {
+    v4l2_plane plane;
+    v4l2_buffer buf;
+    std::memset(&plane, 0, sizeof(plane));
+    std::memset(&buf, 0, sizeof(buf));
+    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+    buf.memory = V4L2_MEMORY_MMAP;
+    buf.index = i;
+    buf.m.planes = &plane;
+    buf.length = 1;
+    if (DoIoctl(m_fd, VIDIOC_QBUF, &buf) != 0) {
+      return false;
+    }
+  }
+
+  int type = V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE;
+  if (DoIoctl(m_fd, VIDIOC_STREAMON, &type) != 0) {
+    return false;
+  }
+  m_streaming = true;
+  type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+  if (DoIoctl(m_fd, VIDIOC_STREAMON, &type) != 0) {
+    return false;
+  }
+
+  m_yuv.resize(m_settings.width * m_settings.height * 3 / 2);
+  return true;
+}
+
+void V4L2H264Encoder::SetBitrate(int bitrate) {
+  if (bitrate != m_settings.bitrate) {
+    m_settings.bitrate = bitrate;
+    SetControl(V4L2_CID_MPEG_VIDEO_BITRATE, bitrate);
+  }
+}
+
+bool V4L2H264Encoder::ReclaimOutputBuffers() {
+  for (;;) {
+    v4l2_plane plane;
+    v4l2_buffer buf;
+    std::memset(&plane, 0, sizeof(plane));
+    std::memset(&buf, 0, sizeof(buf));
+    buf.type = V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE;
+    buf.memory = V4L2_MEMORY_MMAP;
+    buf.m.planes = &plane;
+    buf.length = 1;
+    if (ioctl(m_fd, VIDIOC_DQBUF, &buf) < 0) {
+      return errno == EAGAIN;
+    }
+    if (buf.index < kNumBuffers) {
+      m_outputQueued[buf.index] = false;
+    }
+  }
+}
+
+bool V4L2H264Encoder::Encode(std::span<const uint8_t> bgr, bool forceKeyFrame,
+                             std::vector<uint8_t>& out) {
+  out.clear();
+  size_t pixels = static_cast<size_t>(m_settings.width) * m_settings.height;
+  if (bgr.size() < pixels * 3 || !ReclaimOutputBuffers()) {
+    return false;
+  }
+  auto it = std::find(m_outputQueued.begin(), m_outputQueued.end(), false);
+  if (it == m_outputQueued.end()) {
+    // encoder is behind; drop this frame
+    return true;
+  }
+  unsigned int index = it - m_outputQueued.begin();
+
+  // convert and copy into the buffer with the driver's stride
+  color::BGRToYUV420(bgr.data(), m_yuv.data(), m_settings.width,
+                     m_settings.height, m_nv12);
+  auto dst = static_cast<uint8_t*>(m_outputBuffers[index].m_data);
+  size_t lumaSize = static_cast<size_t>(m_bytesPerLine) * m_planeHeight;
+  if (m_bytesPerLine == static_cast<uint32_t>(m_settings.width) &&
+      m_planeHeight == static_cast<uint32_t>(m_settings.height)) {
+    std::memcpy(dst, m_yuv.data(), m_yuv.size());
+  } else {
+    const uint8_t* src = m_yuv.data();
+    int width = m_settings.width;
+    for (int y = 0; y < m_settings.height; ++y, src += width) {
+      std::memcpy(dst + y * m_bytesPerLine, src, width);
+    }
+    // NV12 has one interleaved chroma plane, I420 has two half-stride planes
+    int chromaPlanes = m_nv12 ? 1 : 2;
+    uint32_t chromaStride = m_nv12 ? m_bytesPerLine : m_bytesPerLine / 2;
+    int chromaWidth = m_nv12 ? width : width / 2;
+    uint8_t* chroma = dst + lumaSize;
+    for (int p = 0; p < chromaPlanes; ++p) {
+      for (int y = 0; y < m_settings.height / 2; ++y, src += chromaWidth) {
+        std::memcpy(chroma + y * chromaStride, src, chromaWidth);
+      }
+      chroma += chromaStride * (m_planeHeight / 2);
+    }
+  }
+
+  if (forceKeyFrame) {
+    SetControl(V4L2_CID_MPEG_VIDEO_FORCE_KEY_FRAME, 1);
+  }
+
+  v4l2_plane plane;
+  v4l2_buffer buf;
+  std::memset(&plane, 0, sizeof(plane));
+  std::memset(&buf, 0, sizeof(buf));
+  buf.type = V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE;
+  buf.memory = V4L2_MEMORY_MMAP;
+  buf.index = index;
+  buf.m.planes = &plane;
+  buf.length = 1;
+  plane.bytesused = lumaSize * 3 / 2;
+  plane.length = m_outputBuffers[index].m_length;
+  if (DoIoctl(m_fd, VIDIOC_QBUF, &buf) != 0) {
+    return false;
+  }
+  m_outputQueued[index] = true;
+
+  // wait for the encoded frame
+  pollfd pfd{m_fd, POLLIN, 0};
+  int rv = poll(&pfd, 1, 1000);
+  if (rv <= 0 || (pfd.revents & POLLERR) != 0) {
+    WARNING("{}: timed out waiting for encoded frame", m_path);
+    return false;
+  }
+
+  std::memset(&plane, 0, sizeof(plane));
+  std::memset(&buf, 0, sizeof(buf));
+  buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+  buf.memory = V4L2_MEMORY_MMAP;
+  buf.m.planes = &plane;
+  buf.length = 1;
+  if (DoIoctl(m_fd, VIDIOC_DQBUF, &buf) != 0 || buf.index >= kNumBuffers) {
+    return false;
+  }
+  auto data = static_cast<const uint8_t*>(m_captureBuffers[buf.index].m_data);
+  size_t size = std::min<size_t>(plane.bytesused,
+                                 m_captureBuffers[buf.index].m_length);
+  if (plane.data_offset < size) {
+    out.assign(data + plane.data_offset, data + size);
+  }
+
+  // hand the buffer back to the encoder
+  plane.bytesused = 0;
+  return DoIoctl(m_fd, VIDIOC_QBUF, &buf) == 0;
+}
+
+namespace cs {
+
+bool IsH264EncoderAvailable() {
+  bool found = false;
+  ForEachEncoderDevice([&](const std::string&) {
+    found = true;
+    return true;
+  });
+  return found;
+}
+
+std::unique_ptr<H264Encoder> CreateH264Encoder(
+    const H264Encoder::Settings& settings, wpi::Logger& logger) {
+  std::unique_ptr<H264Encoder> encoder;
+  if (settings.width <= 0 || settings.height <= 0 || settings.width % 2 != 0 ||
+      settings.height % 2 != 0) {
+    return encoder;
+  }
+  ForEachEncoderDevice([&](const std::string& path) {
+    auto v4l2 = std::make_unique<V4L2H264Encoder>(path, settings, logger);
+    if (!v4l2->Init()) {
+      return false;
+    }
+    encoder = std::move(v4l2);
+    return true;
+  });
+  return encoder;
+}
+
+}  // namespace cs
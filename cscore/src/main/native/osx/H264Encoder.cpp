@@ -0,0 +1,20 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "H264Encoder.h"
+
+namespace cs {
+
+// Hardware encoding is not yet implemented on this platform
+
+bool IsH264EncoderAvailable() {
+  return false;
+}
+
+std::unique_ptr<H264Encoder> CreateH264Encoder(
+    const H264Encoder::Settings& settings, wpi::Logger& logger) {
+  return nullptr;
+}
+
+}  // namespace cs
@@ -129,12 +129,13 @@ ComPtr<IMFMediaSource> CreateVideoCaptureDevice(LPCWSTR pszSymbolicLink) {
 }
 
 ComPtr<IMFSourceReader> CreateSourceReader(IMFMediaSource* mediaSource,
-                                           IMFSourceReaderCallback* callback) {
+                                           IMFSourceReaderCallback* callback,
+                                           bool hardwareTransforms) {
   HRESULT hr = S_OK;
   ComPtr<IMFAttributes> pAttributes;
   ComPtr<IMFSourceReader> sourceReader;
 
-  hr = MFCreateAttributes(pAttributes.GetAddressOf(), 1);
+  hr = MFCreateAttributes(pAttributes.GetAddressOf(), 3);
   if (FAILED(hr)) {
     return nullptr;
   }
@@ -150,6 +151,14 @@ ComPtr<IMFSourceReader> CreateSourceReader(IMFMediaSource* mediaSource,
     return nullptr;
   }
 
+  // Lets the reader use hardware decoders (e.g. for MJPEG)
+  if (hardwareTransforms) {
+    hr = pAttributes->SetUINT32(MF_READWRITE_ENABLE_HARDWARE_TRANSFORMS, TRUE);
+    if (FAILED(hr)) {
+      return nullptr;
+    }
+  }
+
   MFCreateSourceReaderFromMediaSource(mediaSource, pAttributes.Get(),
                                       sourceReader.GetAddressOf());
 
@@ -50,6 +50,7 @@ class SourceReaderCB : public IMFSourceReaderCallback {
 ComPtr<SourceReaderCB> CreateSourceReaderCB(
     std::weak_ptr<cs::UsbCameraImpl> source, const cs::VideoMode& mode);
 ComPtr<IMFSourceReader> CreateSourceReader(IMFMediaSource* mediaSource,
-                                           IMFSourceReaderCallback* callback);
+                                           IMFSourceReaderCallback* callback,
+                                           bool hardwareTransforms = false);
 ComPtr<IMFMediaSource> CreateVideoCaptureDevice(LPCWSTR pszSymbolicLink);
 }  // namespace cs
@@ -62,6 +62,15 @@ static constexpr char const* kPropBrValue = "Brightness";
 static constexpr char const* kPropConnectVerbose = "connect_verbose";
 
 static constexpr unsigned kPropConnectVerboseId = 0;
+static constexpr char const* kPropZeroCopy = "zero_copy";
+static constexpr unsigned kPropZeroCopyId = 1;
+static constexpr char const* kPropHwDecode = "hw_decode";
+static constexpr unsigned kPropHwDecodeId = 2;
+
+// Maximum number of MediaFoundation buffers held by zero-copy images.  The
+// capture device delivers samples from a small pool, so frames are copied
+// instead while this many are held.
+static constexpr int kMaxHeldBuffers = 2;
 
 using namespace cs;
 
@@ -75,6 +84,7 @@ UsbCameraImpl::UsbCameraImpl(std::string_view name, wpi::Logger& logger,
   wpi::sys::windows::UTF8ToUTF16(m_path, wideStorage);
   m_widePath = std::wstring{wideStorage.data(), wideStorage.size()};
   m_deviceId = -1;
+  CreateSoftwareProperties();
   StartMessagePump();
 }
 
@@ -82,6 +92,7 @@ UsbCameraImpl::UsbCameraImpl(std::string_view name, wpi::Logger& logger,
                              Notifier& notifier, Telemetry& telemetry,
                              int deviceId)
     : SourceImpl{name, logger, notifier, telemetry}, m_deviceId(deviceId) {
+  CreateSoftwareProperties();
   StartMessagePump();
 }
 
@@ -89,6 +100,17 @@ UsbCameraImpl::~UsbCameraImpl() {
   m_messagePump = nullptr;
 }
 
+void UsbCameraImpl::CreateSoftwareProperties() {
+  CreateProperty(kPropZeroCopy, [] {
+    return std::make_unique<UsbCameraProperty>(kPropZeroCopy, kPropZeroCopyId,
+                                               CS_PROP_INTEGER, 0, 1, 1, 0, 0);
+  });
+  CreateProperty(kPropHwDecode, [] {
+    return std::make_unique<UsbCameraProperty>(kPropHwDecode, kPropHwDecodeId,
+                                               CS_PROP_INTEGER, 0, 1, 1, 0, 0);
+  });
+}
+
 void UsbCameraImpl::SetProperty(int property, int value, CS_Status* status) {
   Message msg{Message::kCmdSetProperty};
   msg.data[0] = property;
@@ -339,9 +361,32 @@ void UsbCameraImpl::ProcessFrame(IMFSample* videoSample,
     }
   }
 
+  auto pixelFormat = static_cast<VideoMode::PixelFormat>(mode.pixelFormat);
+  if (m_zeroCopy && pixelFormat != VideoMode::kBGRA) {
+    if (++*m_heldBuffers <= kMaxHeldBuffers) {
+      // Hand the locked buffer itself to the sinks; it's unlocked when the
+      // last frame referencing it is released
+      auto image = std::make_unique<Image>(
+          ptr, length, [buf, buffer2d, held = m_heldBuffers] {
+            if (buffer2d) {
+              buffer2d->Unlock2D();
+            } else {
+              buf->Unlock();
+            }
+            --*held;
+          });
+      image->pixelFormat = pixelFormat;
+      image->width = mode.width;
+      image->height = mode.height;
+      SourceImpl::PutFrame(std::move(image), currentTime);
+      return;
+    }
+    --*m_heldBuffers;
+  }
+
   std::string_view data_view{reinterpret_cast<char*>(ptr), length};
-  SourceImpl::PutFrame(static_cast<VideoMode::PixelFormat>(mode.pixelFormat),
-                       mode.width, mode.height, data_view, currentTime);
+  SourceImpl::PutFrame(pixelFormat, mode.width, mode.height, data_view,
+                       currentTime);
 
   if (buffer2d) {
     buffer2d->Unlock2D();
@@ -469,8 +514,8 @@ bool UsbCameraImpl::DeviceConnect() {
     return false;
   }
 
-  m_sourceReader =
-      CreateSourceReader(m_mediaSource.Get(), m_imageCallback.Get());
+  m_sourceReader = CreateSourceReader(m_mediaSource.Get(),
+                                      m_imageCallback.Get(), m_hwDecode);
 
   if (!m_sourceReader) {
     m_mediaSource.Reset();
@@ -790,9 +835,15 @@ CS_StatusValue UsbCameraImpl::DeviceCmdSetProperty(
   }
 
   // Actually set the new value on the device (if possible)
+  bool reconnect = false;
   if (!prop->device) {
     if (prop->id == kPropConnectVerboseId) {
       m_connectVerbose = value;
+    } else if (prop->id == kPropZeroCopyId) {
+      m_zeroCopy = value != 0;
+    } else if (prop->id == kPropHwDecodeId) {
+      reconnect = m_sourceReader && m_hwDecode != (value != 0);
+      m_hwDecode = value != 0;
     }
   } else {
     if (!prop->DeviceSet(lock, m_sourceReader.Get())) {
@@ -806,6 +857,18 @@ CS_StatusValue UsbCameraImpl::DeviceCmdSetProperty(
     UpdatePropertyValue(percentageProperty, setString, percentageValue,
                         valueStr);
 
+  if (reconnect) {
+    // Hardware transforms can only be enabled when the source reader is
+    // created
+#pragma warning(push)
+#pragma warning(disable : 26110)
+    lock.unlock();
+#pragma warning(pop)
+    DeviceDisconnect();
+    DeviceConnect();
+    lock.lock();
+  }
+
   return CS_OK;
 }
 
@@ -946,7 +1009,13 @@ CS_StatusValue UsbCameraImpl::DeviceSetMode() {
 
   m_deviceValid = SUCCEEDED(setResult);
 
-  m_imageCallback->SetVideoMode(m_mode);
+  // The device keeps capturing MJPEG; frames are delivered decoded
+  VideoMode frameMode = m_mode;
+  if (m_deviceValid && m_hwDecode &&
+      m_mode.pixelFormat == VideoMode::kMJPEG && DeviceSetDecodedType()) {
+    frameMode.pixelFormat = VideoMode::kYUYV;
+  }
+  m_imageCallback->SetVideoMode(frameMode);
 
   switch (setResult) {
     case S_OK:
@@ -965,6 +1034,35 @@ CS_StatusValue UsbCameraImpl::DeviceSetMode() {
   return CS_UNSUPPORTED_MODE;
 }
 
+bool UsbCameraImpl::DeviceSetDecodedType() {
+  UINT32 width, height, num, den;
+  ComPtr<IMFMediaType> decodedType;
+  if (FAILED(::MFGetAttributeSize(m_currentMode.Get(), MF_MT_FRAME_SIZE,
+                                  &width, &height)) ||
+      FAILED(::MFGetAttributeRatio(m_currentMode.Get(), MF_MT_FRAME_RATE, &num,
+                                   &den)) ||
+      FAILED(MFCreateMediaType(decodedType.GetAddressOf())) ||
+      FAILED(decodedType->SetGUID(MF_MT_MAJOR_TYPE, MFMediaType_Video)) ||
+      FAILED(decodedType->SetGUID(MF_MT_SUBTYPE, MFVideoFormat_YUY2)) ||
+      FAILED(::MFSetAttributeSize(decodedType.Get(), MF_MT_FRAME_SIZE, width,
+                                  height)) ||
+      FAILED(::MFSetAttributeRatio(decodedType.Get(), MF_MT_FRAME_RATE, num,
+                                   den))) {
+    return false;
+  }
+
+  // The current native type is MJPEG, so the source reader inserts a decoder
+  // (a hardware one if the reader was created with hardware transforms)
+  if (FAILED(m_sourceReader->SetCurrentMediaType(
+          MF_SOURCE_READER_FIRST_VIDEO_STREAM, NULL, decodedType.Get()))) {
+    SWARNING("could not decode MJPEG, delivering compressed frames");
+    m_sourceReader->SetCurrentMediaType(MF_SOURCE_READER_FIRST_VIDEO_STREAM,
+                                        NULL, m_currentMode.Get());
+    return false;
+  }
+  return true;
+}
+
 void UsbCameraImpl::DeviceCacheVideoModes() {
   if (!m_sourceReader) {
     return;
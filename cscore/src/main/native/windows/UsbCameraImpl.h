@@ -125,6 +125,7 @@ class UsbCameraImpl : public SourceImpl,
   bool DeviceStreamOn();
   bool DeviceStreamOff();
   CS_StatusValue DeviceSetMode();
+  bool DeviceSetDecodedType();
   void DeviceCacheMode();
   void DeviceCacheProperty(std::unique_ptr<UsbCameraProperty> rawProp,
                            IMFSourceReader* sourceReader);
@@ -149,6 +150,7 @@ class UsbCameraImpl : public SourceImpl,
   int RawToPercentage(const UsbCameraProperty& rawProp, int rawValue);
   int PercentageToRaw(const UsbCameraProperty& rawProp, int percentValue);
 
+  void CreateSoftwareProperties();
   void StartMessagePump();
 
   //
@@ -158,6 +160,7 @@ class UsbCameraImpl : public SourceImpl,
   bool m_wasStreaming{false};
   bool m_modeSet{false};
   int m_connectVerbose{1};
+  bool m_hwDecode{false};
   bool m_deviceValid{false};
 
   ComPtr<IMFMediaSource> m_mediaSource;
@@ -172,6 +175,14 @@ class UsbCameraImpl : public SourceImpl,
   int m_deviceId;
 
   std::vector<std::pair<VideoMode, ComPtr<IMFMediaType>>> m_windowsVideoModes;
+
+  //
+  // Variables also used by the source reader callback
+  //
+  std::atomic_bool m_zeroCopy{false};
+  // Shared with zero-copy images, which may outlive the camera
+  std::shared_ptr<std::atomic_int> m_heldBuffers{
+      std::make_shared<std::atomic_int>(0)};
 };
 
 }  // namespace cs
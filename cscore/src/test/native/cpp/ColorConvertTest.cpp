@@ -0,0 +1,217 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ColorConvert.h"
+
+namespace cs {
+
+// width is not a multiple of the SIMD block size, so the scalar tails run too
+static constexpr int kWidth = 38;
+static constexpr int kHeight = 6;
+static constexpr size_t kPixels = kWidth * kHeight;
+
+static std::vector<uint8_t> RandomBytes(size_t size) {
+  std::mt19937 gen{1234};
+  std::uniform_int_distribution<int> dist{0, 255};
+  std::vector<uint8_t> out(size);
+  std::generate(out.begin(), out.end(), [&] { return dist(gen); });
+  return out;
+}
+
+static void RefYUVToBGR(int y, int u, int v, uint8_t* bgr) {
+  int yy = (y - 16) * 75 + 32;
+  bgr[0] = std::clamp((yy + 129 * (u - 128)) >> 6, 0, 255);
+  bgr[1] =
+      std::clamp((yy - 25 * (u - 128) - 52 * (v - 128)) >> 6, 0, 255);
+  bgr[2] = std::clamp((yy + 102 * (v - 128)) >> 6, 0, 255);
+}
+
+class ColorConvertYUVTest : public ::testing::TestWithParam<bool> {};
+
+TEST_P(ColorConvertYUVTest, ToGray) {
+  bool uyvy = GetParam();
+  auto src = RandomBytes(kPixels * 2);
+  std::vector<uint8_t> dst(kPixels);
+  color::YUV422ToGray(src.data(), dst.data(), kWidth, kHeight, uyvy);
+  for (size_t i = 0; i < kPixels; ++i) {
+    ASSERT_EQ(dst[i], src[2 * i + (uyvy ? 1 : 0)]) << "pixel " << i;
+  }
+}
+
+TEST_P(ColorConvertYUVTest, ToBGR) {
+  bool uyvy = GetParam();
+  auto src = RandomBytes(kPixels * 2);
+  std::vector<uint8_t> dst(kPixels * 3);
+  color::YUV422ToBGR(src.data(), dst.data(), kWidth, kHeight, uyvy);
+  for (size_t i = 0; i < kPixels; ++i) {
+    const uint8_t* p = &src[(i & ~1) * 2];
+    uint8_t expected[3];
+    if (uyvy) {
+      RefYUVToBGR(p[(i & 1) * 2 + 1], p[0], p[2], expected);
+    } else {
+      RefYUVToBGR(p[(i & 1) * 2], p[1], p[3], expected);
+    }
+    for (int c = 0; c < 3; ++c) {
+      ASSERT_EQ(dst[i * 3 + c], expected[c]) << "pixel " << i << " " << c;
+    }
+  }
+}
+
+TEST_P(ColorConvertYUVTest, ToGrayHalf) {
+  bool uyvy = GetParam();
+  auto src = RandomBytes(kPixels * 2);
+  std::vector<uint8_t> full(kPixels);
+  std::vector<uint8_t> half(kPixels / 4);
+  color::YUV422ToGray(src.data(), full.data(), kWidth, kHeight, uyvy);
+  color::YUV422ToGrayHalf(src.data(), half.data(), kWidth, kHeight, uyvy);
+  for (int y = 0; y < kHeight / 2; ++y) {
+    for (int x = 0; x < kWidth / 2; ++x) {
+      const uint8_t* a = &full[2 * y * kWidth + 2 * x];
+      const uint8_t* b = a + kWidth;
+      ASSERT_EQ(half[y * kWidth / 2 + x],
+                (a[0] + a[1] + b[0] + b[1] + 2) / 4);
+    }
+  }
+}
+
+TEST_P(ColorConvertYUVTest, ToBGRHalf) {
+  bool uyvy = GetParam();
+  // uniform 2x2 blocks convert the same as at full size
+  std::vector<uint8_t> src(kPixels * 2);
+  auto block = RandomBytes(kPixels);
+  for (int y = 0; y < kHeight; ++y) {
+    for (int x = 0; x < kWidth * 2; x += 4) {
+      uint8_t* p = &src[y * kWidth * 2 + x];
+      const uint8_t* b = &block[(y / 2) * kWidth + x / 2];
+      p[uyvy ? 1 : 0] = p[uyvy ? 3 : 2] = b[0];
+      p[uyvy ? 0 : 1] = b[1];
+      p[uyvy ? 2 : 3] = b[2];
+    }
+  }
+  std::vector<uint8_t> full(kPixels * 3);
+  std::vector<uint8_t> half(kPixels * 3 / 4);
+  color::YUV422ToBGR(src.data(), full.data(), kWidth, kHeight, uyvy);
+  color::YUV422ToBGRHalf(src.data(), half.data(), kWidth, kHeight, uyvy);
+  for (int y = 0; y < kHeight / 2; ++y) {
+    for (int x = 0; x < kWidth / 2; ++x) {
+      for (int c = 0; c < 3; ++c) {
+        ASSERT_EQ(half[(y * kWidth / 2 + x) * 3 + c],
+                  full[(2 * y * kWidth + 2 * x) * 3 + c]);
+      }
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(ColorConvertYUVTests, ColorConvertYUVTest,
+                         ::testing::Values(false, true));
+
+TEST(ColorConvertTest, YUVToBGRLimits) {
+  // black, white, and full blue (with red clamped)
+  uint8_t src[12] = {16, 128, 16, 128, 235, 128, 235, 128, 41, 240, 41, 100};
+  uint8_t dst[18];
+  color::YUV422ToBGR(src, dst, 6, 1, false);
+  EXPECT_EQ(dst[0], 0);
+  EXPECT_EQ(dst[1], 0);
+  EXPECT_EQ(dst[2], 0);
+  EXPECT_EQ(dst[6], 255);
+  EXPECT_EQ(dst[7], 255);
+  EXPECT_EQ(dst[8], 255);
+  EXPECT_EQ(dst[12], 255);
+  EXPECT_EQ(dst[14], 0);
+}
+
+TEST(ColorConvertTest, BGRToGray) {
+  auto src = RandomBytes(kPixels * 3);
+  std::vector<uint8_t> dst(kPixels);
+  color::BGRToGray(src.data(), dst.data(), kWidth, kHeight);
+  for (size_t i = 0; i < kPixels; ++i) {
+    const uint8_t* p = &src[i * 3];
+    ASSERT_EQ(dst[i], (p[0] * 29 + p[1] * 150 + p[2] * 77 + 128) >> 8);
+  }
+}
+
+TEST(ColorConvertTest, RGB565RoundTrip) {
+  auto src = RandomBytes(kPixels * 3);
+  std::vector<uint16_t> rgb565(kPixels);
+  std::vector<uint8_t> dst(kPixels * 3);
+  color::BGRToRGB565(src.data(), rgb565.data(), kWidth, kHeight);
+  color::RGB565ToBGR(rgb565.data(), dst.data(), kWidth, kHeight);
+  for (size_t i = 0; i < kPixels; ++i) {
+    const uint8_t* p = &src[i * 3];
+    ASSERT_EQ(rgb565[i],
+              (p[2] >> 3) | ((p[1] >> 2) << 5) | ((p[0] >> 3) << 11));
+    ASSERT_EQ(dst[i * 3], p[0] & 0xf8);
+    ASSERT_EQ(dst[i * 3 + 1], p[1] & 0xfc);
+    ASSERT_EQ(dst[i * 3 + 2], p[2] & 0xf8);
+  }
+}
+
+TEST(ColorConvertTest, Y16ToGray) {
+  std::vector<uint16_t> src(kPixels);
+  for (size_t i = 0; i < kPixels; ++i) {
+    src[i] = 1000 + i * 7;
+  }
+  std::vector<uint8_t> dst(kPixels);
+  color::Y16ToGray(src.data(), dst.data(), kWidth, kHeight);
+  EXPECT_EQ(dst.front(), 0);
+  EXPECT_EQ(dst.back(), 255);
+  float scale = 255.0f / ((kPixels - 1) * 7);
+  for (size_t i = 0; i < kPixels; ++i) {
+    ASSERT_EQ(dst[i], static_cast<int>(i * 7 * scale + 0.5f)) << i;
+  }
+
+  // no range
+  std::fill(src.begin(), src.end(), 500);
+  color::Y16ToGray(src.data(), dst.data(), kWidth, kHeight);
+  EXPECT_TRUE(
+      std::all_of(dst.begin(), dst.end(), [](auto v) { return v == 0; }));
+}
+
+TEST(ColorConvertTest, BGRToYUV420) {
+  // uniform 2x2 blocks so chroma matches a single pixel's conversion
+  std::vector<uint8_t> src(kPixels * 3);
+  auto block = RandomBytes(kPixels * 3 / 4);
+  for (int y = 0; y < kHeight; ++y) {
+    for (int x = 0; x < kWidth; ++x) {
+      const uint8_t* b = &block[((y / 2) * (kWidth / 2) + x / 2) * 3];
+      std::copy(b, b + 3, &src[(y * kWidth + x) * 3]);
+    }
+  }
+  std::vector<uint8_t> i420(kPixels * 3 / 2);
+  std::vector<uint8_t> nv12(kPixels * 3 / 2);
+  color::BGRToYUV420(src.data(), i420.data(), kWidth, kHeight, false);
+  color::BGRToYUV420(src.data(), nv12.data(), kWidth, kHeight, true);
+  constexpr size_t kChroma = kPixels / 4;
+  for (size_t c = 0; c < kChroma; ++c) {
+    ASSERT_EQ(nv12[kPixels + 2 * c], i420[kPixels + c]);
+    ASSERT_EQ(nv12[kPixels + 2 * c + 1], i420[kPixels + kChroma + c]);
+  }
+  for (size_t i = 0; i < kPixels; ++i) {
+    ASSERT_EQ(nv12[i], i420[i]);
+  }
+
+  // converting back gives approximately the original color
+  for (int y = 0; y < kHeight; ++y) {
+    for (int x = 0; x < kWidth; ++x) {
+      size_t c = (y / 2) * (kWidth / 2) + x / 2;
+      uint8_t bgr[3];
+      RefYUVToBGR(i420[y * kWidth + x], i420[kPixels + c],
+                  i420[kPixels + kChroma + c], bgr);
+      for (int k = 0; k < 3; ++k) {
+        ASSERT_NEAR(bgr[k], src[(y * kWidth + x) * 3 + k], 6)
+            << x << "," << y << " " << k;
+      }
+    }
+  }
+}
+
+}  // namespace cs
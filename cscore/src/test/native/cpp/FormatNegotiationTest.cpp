@@ -0,0 +1,68 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "FormatNegotiation.h"
+
+namespace cs {
+
+class FormatNegotiationTest : public ::testing::Test {
+ protected:
+  VideoMode mjpeg{VideoMode::kMJPEG, 640, 480, 30};
+  VideoMode yuyv{VideoMode::kYUYV, 640, 480, 30};
+  std::vector<VideoMode> modes{mjpeg, yuyv,
+                               {VideoMode::kYUYV, 320, 240, 30},
+                               {VideoMode::kGray, 640, 480, 15}};
+};
+
+TEST_F(FormatNegotiationTest, NoDemandsKeepsMode) {
+  EXPECT_EQ(ChooseVideoMode(modes, mjpeg, {}), mjpeg);
+  EXPECT_EQ(EstimateConversionCost(mjpeg, {}), 0);
+}
+
+TEST_F(FormatNegotiationTest, PassThroughMJPEG) {
+  std::vector<SinkDemand> demands{{VideoMode::kMJPEG, 0, 0}};
+  EXPECT_EQ(EstimateConversionCost(mjpeg, demands), 0);
+  EXPECT_EQ(ChooseVideoMode(modes, yuyv, demands), mjpeg);
+}
+
+TEST_F(FormatNegotiationTest, RawDemandsAvoidDecode) {
+  std::vector<SinkDemand> demands{{VideoMode::kBGR, 640, 480},
+                                  {VideoMode::kGray, 0, 0}};
+  EXPECT_LT(EstimateConversionCost(yuyv, demands),
+            EstimateConversionCost(mjpeg, demands));
+  // the resolution and frame rate are kept
+  EXPECT_EQ(ChooseVideoMode(modes, mjpeg, demands), yuyv);
+}
+
+TEST_F(FormatNegotiationTest, DecodeSharedBetweenSinks) {
+  std::vector<SinkDemand> one{{VideoMode::kBGR, 0, 0}};
+  std::vector<SinkDemand> two{{VideoMode::kBGR, 0, 0},
+                              {VideoMode::kBGR, 640, 480},
+                              {VideoMode::kGray, 0, 0}};
+  // the duplicate is free, and gray from the decoded image only costs a
+  // color conversion
+  EXPECT_EQ(EstimateConversionCost(mjpeg, two) -
+                EstimateConversionCost(mjpeg, one),
+            640 * 480);
+}
+
+TEST_F(FormatNegotiationTest, MixedDemandsPreferMJPEG) {
+  // re-encoding costs more than decoding once for the raw sink
+  std::vector<SinkDemand> demands{{VideoMode::kMJPEG, 0, 0},
+                                  {VideoMode::kMJPEG, 0, 0},
+                                  {VideoMode::kBGR, 0, 0}};
+  EXPECT_EQ(ChooseVideoMode(modes, yuyv, demands), mjpeg);
+}
+
+TEST_F(FormatNegotiationTest, ImpossibleConversion) {
+  std::vector<SinkDemand> demands{{VideoMode::kYUYV, 0, 0}};
+  EXPECT_EQ(EstimateConversionCost(mjpeg, demands), kImpossibleConversion);
+  EXPECT_EQ(ChooseVideoMode(modes, mjpeg, demands), yuyv);
+}
+
+}  // namespace cs
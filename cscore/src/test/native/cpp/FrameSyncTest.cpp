@@ -0,0 +1,44 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "FrameSync.h"
+
+namespace cs {
+
+TEST(FrameSyncTest, EmptyQueueWaits) {
+  std::vector<std::vector<uint64_t>> times{{100, 200}, {}};
+  auto match = MatchFrameTimes(times, 10);
+  EXPECT_FALSE(match.matched);
+  EXPECT_EQ(match.waitSink, 1u);
+}
+
+TEST(FrameSyncTest, NewestSetWithinWindow) {
+  std::vector<std::vector<uint64_t>> times{
+      {1000, 34000, 67000}, {2000, 35000, 68000}, {500, 33500}};
+  auto match = MatchFrameTimes(times, 2000);
+  ASSERT_TRUE(match.matched);
+  EXPECT_EQ(match.times, (std::vector<uint64_t>{34000, 35000, 33500}));
+}
+
+TEST(FrameSyncTest, OlderAnchor) {
+  // the newest frames don't line up, but the previous ones do
+  std::vector<std::vector<uint64_t>> times{{0, 100}, {0, 200}};
+  auto match = MatchFrameTimes(times, 10);
+  ASSERT_TRUE(match.matched);
+  EXPECT_EQ(match.times, (std::vector<uint64_t>{0, 0}));
+}
+
+TEST(FrameSyncTest, NoMatchDropsOldFrames) {
+  std::vector<std::vector<uint64_t>> times{{1000, 2000}, {1500, 5000}};
+  auto match = MatchFrameTimes(times, 100);
+  EXPECT_FALSE(match.matched);
+  EXPECT_EQ(match.waitSink, 0u);
+  EXPECT_EQ(match.dropBefore, 1900u);
+}
+
+}  // namespace cs
@@ -0,0 +1,103 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <wpi/RawFrame.h>
+
+#include "cscore.h"
+#include "cscore_raw.h"
+
+namespace cs {
+
+namespace {
+
+constexpr int kWidth = 64;
+constexpr int kHeight = 48;
+
+// Puts a frame to the source every few milliseconds until destroyed
+class FramePutter {
+ public:
+  FramePutter(const RawSource& source, VideoMode::PixelFormat pixelFormat,
+              int bytesPerPixel) {
+    m_frame.Reserve(kWidth * kHeight * bytesPerPixel);
+    m_frame.size = kWidth * kHeight * bytesPerPixel;
+    m_frame.width = kWidth;
+    m_frame.height = kHeight;
+    m_frame.stride = kWidth * bytesPerPixel;
+    m_frame.pixelFormat = pixelFormat;
+    for (int y = 0; y < kHeight; ++y) {
+      for (int x = 0; x < kWidth; ++x) {
+        for (int c = 0; c < bytesPerPixel; ++c) {
+          m_frame.data[y * m_frame.stride + x * bytesPerPixel + c] =
+              static_cast<uint8_t>(x + y);
+        }
+      }
+    }
+
+    m_thread = std::thread{[this, handle = source.GetHandle()] {
+      while (m_active) {
+        CS_Status status = 0;
+        PutSourceFrame(handle, m_frame, &status);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      }
+    }};
+  }
+
+  ~FramePutter() {
+    m_active = false;
+    m_thread.join();
+  }
+
+ private:
+  wpi::RawFrame m_frame;
+  std::atomic_bool m_active{true};
+  std::thread m_thread;
+};
+
+}  // namespace
+
+TEST(GrayscaleSinkTest, BorrowsGrayFrames) {
+  RawSource source{"source", VideoMode::kGray, kWidth, kHeight, 30};
+  GrayscaleSink sink{"sink"};
+  sink.SetSource(source);
+  FramePutter putter{source, VideoMode::kGray, 1};
+
+  wpi::RawFrame frame;
+  ASSERT_NE(0u, sink.GrabFrame(frame, 1.0));
+  EXPECT_EQ(WPI_PIXFMT_GRAY, frame.pixelFormat);
+  EXPECT_EQ(kWidth, frame.width);
+  EXPECT_EQ(kHeight, frame.height);
+  EXPECT_EQ(7, frame.data[3 * frame.stride + 4]);
+
+  // The frame borrows the source's image rather than owning a copy
+  EXPECT_NE(nullptr, frame.freeFunc);
+
+  // Grabbing again releases the previous image
+  ASSERT_NE(0u, sink.GrabFrame(frame, 1.0));
+  EXPECT_EQ(7, frame.data[3 * frame.stride + 4]);
+}
+
+TEST(GrayscaleSinkTest, ConvertsBGRFrames) {
+  RawSource source{"source", VideoMode::kBGR, kWidth, kHeight, 30};
+  GrayscaleSink sink{"sink"};
+  sink.SetSource(source);
+  FramePutter putter{source, VideoMode::kBGR, 3};
+
+  wpi::RawFrame frame;
+  ASSERT_NE(0u, sink.GrabFrame(frame, 1.0));
+  EXPECT_EQ(WPI_PIXFMT_GRAY, frame.pixelFormat);
+  EXPECT_EQ(kWidth, frame.width);
+  EXPECT_EQ(kHeight, frame.height);
+
+  // Gray BGR pixels keep their value
+  EXPECT_NEAR(7, frame.data[3 * frame.stride + 4], 1);
+}
+
+}  // namespace cs
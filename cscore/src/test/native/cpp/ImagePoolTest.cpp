@@ -0,0 +1,87 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <memory>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include "ImagePool.h"
+
+namespace cs {
+
+TEST(ImagePoolTest, SizeClasses) {
+  EXPECT_EQ(ImagePool::GetSizeClass(0), 0u);
+  EXPECT_EQ(ImagePool::GetSizeClass(4096), 0u);
+  EXPECT_EQ(ImagePool::GetSizeClass(4097), 1u);
+  EXPECT_EQ(ImagePool::GetClassSize(1), 5120u);
+  EXPECT_EQ(ImagePool::GetClassSize(4), 8192u);
+  EXPECT_EQ(ImagePool::GetSizeClass(1 << 30), ImagePool::kNumClasses);
+
+  // every size fits its class, and wastes at most a quarter
+  for (size_t size = 4097; size < (size_t{1} << 27); size = size * 9 / 8) {
+    size_t sizeClass = ImagePool::GetSizeClass(size);
+    ASSERT_LT(sizeClass, ImagePool::kNumClasses) << size;
+    size_t classSize = ImagePool::GetClassSize(sizeClass);
+    ASSERT_GE(classSize, size);
+    ASSERT_LT(ImagePool::GetClassSize(sizeClass - 1), size);
+    ASSERT_LE(classSize, size + size / 4);
+    ASSERT_EQ(ImagePool::GetSizeClass(classSize), sizeClass);
+  }
+}
+
+TEST(ImagePoolTest, Reuse) {
+  ImagePool pool;
+  auto image = pool.Alloc(640 * 480 * 3);
+  EXPECT_GE(image->capacity(), 640u * 480 * 3);
+  auto data = image->data();
+  pool.Release(std::move(image));
+
+  // a slightly different size in the same class reuses the buffer
+  image = pool.Alloc(640 * 480 * 3 - 100);
+  EXPECT_EQ(image->data(), data);
+
+  auto stats = pool.GetStatistics();
+  EXPECT_EQ(stats.hits, 1u);
+  EXPECT_EQ(stats.misses, 1u);
+  EXPECT_EQ(stats.pooledBuffers, 0u);
+  EXPECT_EQ(stats.pooledBytes, 0u);
+}
+
+TEST(ImagePoolTest, EvictsLeastRecentlyUsed) {
+  constexpr size_t kSmall = 64 * 1024;
+  constexpr size_t kLarge = 256 * 1024;
+  ImagePool pool{kSmall + kLarge};
+  auto small = pool.Alloc(kSmall);
+  auto large = pool.Alloc(kLarge);
+  pool.Release(std::move(small));
+  pool.Release(std::move(large));
+  EXPECT_EQ(pool.GetStatistics().pooledBytes, kSmall + kLarge);
+
+  // releasing another large buffer evicts the older small one
+  auto large2 = pool.Alloc(kLarge + 1);
+  pool.Release(std::move(large2));
+  auto stats = pool.GetStatistics();
+  EXPECT_EQ(stats.pooledBuffers, 1u);
+  EXPECT_EQ(stats.discards, 0u);
+
+  // and a buffer bigger than the capacity is discarded
+  pool.Release(pool.Alloc(kSmall + kLarge + 1));
+  EXPECT_EQ(pool.GetStatistics().discards, 1u);
+
+  pool.SetCapacity(0);
+  EXPECT_EQ(pool.GetStatistics().pooledBytes, 0u);
+}
+
+TEST(ImagePoolTest, Shutdown) {
+  ImagePool pool;
+  auto image = pool.Alloc(1000);
+  pool.Shutdown();
+  pool.Release(std::move(image));
+  auto stats = pool.GetStatistics();
+  EXPECT_EQ(stats.pooledBuffers, 0u);
+  EXPECT_EQ(stats.discards, 1u);
+}
+
+}  // namespace cs
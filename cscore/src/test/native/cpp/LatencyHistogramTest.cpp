@@ -0,0 +1,47 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <gtest/gtest.h>
+
+#include "cscore_cpp.h"
+
+namespace cs {
+
+TEST(LatencyHistogramTest, Buckets) {
+  EXPECT_EQ(LatencyHistogram::GetBucket(0), 0);
+  EXPECT_EQ(LatencyHistogram::GetBucket(15), 0);
+  EXPECT_EQ(LatencyHistogram::GetBucket(16), 1);
+  EXPECT_EQ(LatencyHistogram::GetBucketUpperBound(1), 20);
+  EXPECT_EQ(LatencyHistogram::GetBucket(20), 2);
+  EXPECT_EQ(LatencyHistogram::GetBucket(int64_t{1} << 40),
+            LatencyHistogram::kNumBuckets - 1);
+
+  // every latency is within its bucket, and buckets are at most 25% wide
+  for (int64_t us = 16; us < (1 << 20); us = us * 9 / 8) {
+    int bucket = LatencyHistogram::GetBucket(us);
+    ASSERT_LT(bucket, LatencyHistogram::kNumBuckets - 1) << us;
+    ASSERT_LT(us, LatencyHistogram::GetBucketUpperBound(bucket));
+    ASSERT_GE(us, LatencyHistogram::GetBucketUpperBound(bucket - 1));
+    ASSERT_LE(LatencyHistogram::GetBucketUpperBound(bucket),
+              LatencyHistogram::GetBucketUpperBound(bucket - 1) * 5 / 4);
+  }
+}
+
+TEST(LatencyHistogramTest, Statistics) {
+  LatencyHistogram histogram;
+  EXPECT_EQ(histogram.GetMean(), 0.0);
+  EXPECT_EQ(histogram.GetPercentile(50), 0.0);
+
+  for (int i = 1; i <= 100; ++i) {
+    histogram.Record(i * 1000);
+  }
+  EXPECT_EQ(histogram.count, 100);
+  EXPECT_EQ(histogram.max, 100000);
+  EXPECT_DOUBLE_EQ(histogram.GetMean(), 50500.0);
+  EXPECT_NEAR(histogram.GetPercentile(50), 50000, 50000 / 8);
+  EXPECT_NEAR(histogram.GetPercentile(99), 99000, 99000 / 8);
+  EXPECT_EQ(histogram.GetPercentile(100), 100000.0);
+}
+
+}  // namespace cs
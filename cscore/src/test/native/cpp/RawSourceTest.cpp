@@ -0,0 +1,98 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <wpi/RawFrame.h>
+
+#include "cscore.h"
+#include "cscore_raw.h"
+
+namespace cs {
+
+namespace {
+
+constexpr int kWidth = 64;
+constexpr int kHeight = 48;
+
+// Allocates, fills, and commits a gray frame every few milliseconds until
+// destroyed
+class FrameCommitter {
+ public:
+  explicit FrameCommitter(const RawSource& source) {
+    m_thread = std::thread{[this, handle = source.GetHandle()] {
+      while (m_active) {
+        wpi::RawFrame frame;
+        frame.pixelFormat = WPI_PIXFMT_GRAY;
+        frame.width = kWidth;
+        frame.height = kHeight;
+        CS_Status status = 0;
+        AllocSourceFrame(handle, frame, &status);
+        for (int y = 0; y < kHeight; ++y) {
+          for (int x = 0; x < kWidth; ++x) {
+            frame.data[y * frame.stride + x] = static_cast<uint8_t>(x + y);
+          }
+        }
+        CommitSourceFrame(handle, frame, &status);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      }
+    }};
+  }
+
+  ~FrameCommitter() {
+    m_active = false;
+    m_thread.join();
+  }
+
+ private:
+  std::atomic_bool m_active{true};
+  std::thread m_thread;
+};
+
+}  // namespace
+
+TEST(RawSourceTest, AllocFrame) {
+  RawSource source{"source", VideoMode::kGray, kWidth, kHeight, 30};
+
+  wpi::RawFrame frame;
+  frame.pixelFormat = WPI_PIXFMT_GRAY;
+  frame.width = kWidth;
+  frame.height = kHeight;
+  CS_Status status = 0;
+  AllocSourceFrame(source.GetHandle(), frame, &status);
+  ASSERT_EQ(CS_OK, status);
+  ASSERT_NE(nullptr, frame.data);
+  EXPECT_EQ(kWidth, frame.stride);
+  EXPECT_EQ(static_cast<size_t>(kWidth * kHeight), frame.size);
+
+  // the buffer is handed to the source rather than copied
+  CommitSourceFrame(source.GetHandle(), frame, &status);
+  EXPECT_EQ(CS_OK, status);
+  EXPECT_EQ(nullptr, frame.data);
+
+  // freeing an uncommitted frame returns the buffer to the pool
+  AllocSourceFrame(source.GetHandle(), frame, &status);
+  ASSERT_NE(nullptr, frame.data);
+}
+
+TEST(RawSourceTest, CommitFrame) {
+  RawSource source{"source", VideoMode::kGray, kWidth, kHeight, 30};
+  GrayscaleSink sink{"sink"};
+  sink.SetSource(source);
+  FrameCommitter committer{source};
+
+  wpi::RawFrame frame;
+  ASSERT_NE(0u, sink.GrabFrame(frame, 1.0));
+  EXPECT_EQ(WPI_PIXFMT_GRAY, frame.pixelFormat);
+  EXPECT_EQ(kWidth, frame.width);
+  EXPECT_EQ(kHeight, frame.height);
+  EXPECT_EQ(7, frame.data[3 * frame.stride + 4]);
+}
+
+}  // namespace cs
@@ -0,0 +1,95 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+#include <wpinet/NetworkStream.h>
+
+#include "Image.h"
+#include "JpegUtil.h"
+#include "ReadaheadStream.h"
+
+namespace cs {
+
+namespace {
+// Delivers data a few bytes per receive, like a slow connection
+class ChunkedStream : public wpi::NetworkStream {
+ public:
+  ChunkedStream(std::string_view data, size_t chunk)
+      : m_data{data}, m_chunk{chunk} {}
+
+  size_t send(const char* buffer, size_t len, Error* err) override {
+    return 0;
+  }
+  size_t receive(char* buffer, size_t len, Error* err,
+                 int timeout = 0) override {
+    size_t count = (std::min)({len, m_chunk, m_data.size() - m_pos});
+    std::copy_n(m_data.data() + m_pos, count, buffer);
+    m_pos += count;
+    ++receives;
+    return count;
+  }
+  void close() override {}
+  std::string_view getPeerIP() const override { return {}; }
+  int getPeerPort() const override { return 0; }
+  void setNoDelay() override {}
+  bool setBlocking(bool enabled) override { return true; }
+  int getNativeHandle() const override { return 0; }
+
+  int receives = 0;
+
+ private:
+  std::string m_data;
+  size_t m_chunk;
+  size_t m_pos = 0;
+};
+}  // namespace
+
+TEST(ReadaheadStreamTest, SkipPastSplitDelimiter) {
+  ChunkedStream stream{"junk--bound\r\nContent-Type: x\r\n--boundary\r\nA", 5};
+  ReadaheadStream is{stream};
+  ASSERT_TRUE(is.SkipPast("--boundary"));
+  char buf[3];
+  is.read(buf, 3);
+  EXPECT_EQ(std::string_view(buf, 3), "\r\nA");
+  EXPECT_FALSE(is.SkipPast("--boundary"));
+  EXPECT_TRUE(is.has_error());
+}
+
+TEST(ReadaheadStreamTest, ReadsAhead) {
+  std::string data(1000, 'x');
+  ChunkedStream stream{data, data.size()};
+  ReadaheadStream is{stream};
+  char c;
+  for (size_t i = 0; i < data.size(); ++i) {
+    is.read(c);
+  }
+  EXPECT_FALSE(is.has_error());
+  EXPECT_EQ(stream.receives, 1);
+}
+
+TEST(ReadaheadStreamTest, ReadJpeg) {
+  // SOI, SOF with 320x240, SOS with stuffed and restart bytes, EOI
+  static constexpr char kJpeg[] =
+      "\xff\xd8"
+      "\xff\xc0\x00\x0b\x08\x00\xf0\x01\x40\x01\x01\x11\x00"
+      "\xff\xda\x00\x02"
+      "\x12\xff\x00\x34\xff\xd0\x56\xff\xff"
+      "\xff\xd9";
+  std::string jpeg{kJpeg, sizeof(kJpeg) - 1};
+  ChunkedStream stream{jpeg + "--next", 3};
+  ReadaheadStream is{stream};
+  Image image{0};
+  int width, height;
+  ASSERT_TRUE(ReadJpeg(is, image, &width, &height));
+  EXPECT_EQ(image.str(), jpeg);
+  EXPECT_EQ(width, 320);
+  EXPECT_EQ(height, 240);
+  EXPECT_TRUE(is.SkipPast("--next"));
+}
+
+}  // namespace cs
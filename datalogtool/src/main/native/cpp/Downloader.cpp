@@ -12,9 +12,11 @@
 #endif
 
 #include <algorithm>
+#include <deque>
 #include <filesystem>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <fmt/format.h>
@@ -275,6 +277,9 @@ void Downloader::ThreadMain() {
   std::unique_ptr<sftp::Session> session;
 
   static constexpr size_t kBufSize = 32 * 1024;
+  // number of read requests to keep in flight, so transfers aren't limited
+  // to one buffer per network round trip
+  static constexpr size_t kMaxPendingReads = 16;
   std::unique_ptr<uint8_t[]> copyBuf = std::make_unique<uint8_t[]>(kBufSize);
 
   std::unique_lock lock{m_mutex};
@@ -364,17 +369,30 @@ void Downloader::ThreadMain() {
 
             lock.unlock();
 
-            // open local file
+            // resume a previous partial download of the file
             std::error_code ec;
-            fs::file_t of = fs::OpenFileForWrite(localFilename, ec,
-                                                 fs::CD_CreateNew, fs::OF_None);
+            uint64_t offset = 0;
+            if (fs::exists(localFilename, ec)) {
+              offset = fs::file_size(localFilename, ec);
+              if (ec || offset > fileSize) {
+                lock.lock();
+                file.status = "local file already exists";
+                continue;
+              }
+            }
+
+            // open local file
+            fs::file_t of = fs::OpenFileForWrite(
+                localFilename, ec,
+                offset == 0 ? fs::CD_CreateNew : fs::CD_OpenExisting,
+                fs::OF_Append);
             if (ec) {
               // failed to open
               lock.lock();
               file.status = ec.message();
               continue;
             }
-            int ofd = fs::FileToFd(of, ec, fs::OF_None);
+            int ofd = fs::FileToFd(of, ec, fs::OF_Append);
             if (ofd == -1 || ec) {
               // failed to convert to fd
               lock.lock();
@@ -385,13 +403,29 @@ void Downloader::ThreadMain() {
             try {
               // open remote file
               sftp::File f = session->Open(remoteFilename, O_RDONLY, 0);
+              if (offset != 0) {
+                f.Seek(offset);
+              }
 
-              // copy in chunks
-              uint64_t total = 0;
+              // copy in chunks, keeping several read requests in flight
+              uint64_t total = offset;
+              uint64_t requested = offset;
+              std::deque<std::pair<uint32_t, uint32_t>> pending;  // id, size
               while (total < fileSize) {
-                uint64_t toCopy = (std::min)(fileSize - total,
-                                             static_cast<uint64_t>(kBufSize));
-                auto copied = f.Read(copyBuf.get(), toCopy);
+                while (pending.size() < kMaxPendingReads &&
+                       requested < fileSize) {
+                  auto toRequest = static_cast<uint32_t>((std::min)(
+                      fileSize - requested, static_cast<uint64_t>(kBufSize)));
+                  pending.emplace_back(f.AsyncReadBegin(toRequest), toRequest);
+                  requested += toRequest;
+                }
+                auto [id, size] = pending.front();
+                pending.pop_front();
+                auto copied = f.AsyncRead(copyBuf.get(), kBufSize, id);
+                if (copied == 0) {
+                  // remote file was truncated
+                  break;
+                }
                 if (write(ofd, copyBuf.get(), copied) !=
                     static_cast<int64_t>(copied)) {
                   // error writing
@@ -402,6 +436,16 @@ void Downloader::ThreadMain() {
                   goto err;
                 }
                 total += copied;
+                if (copied < size) {
+                  // short read; discard the following responses and request
+                  // the rest again
+                  for (auto&& request : pending) {
+                    f.AsyncRead(copyBuf.get(), kBufSize, request.first);
+                  }
+                  pending.clear();
+                  f.Seek(total);
+                  requested = total;
+                }
                 lock.lock();
                 file.complete = static_cast<float>(total) / fileSize;
                 lock.unlock();
@@ -412,15 +456,15 @@ void Downloader::ThreadMain() {
               ofd = -1;
 
               // delete remote file (if enabled)
-              if (m_deleteAfter) {
+              if (m_deleteAfter && total == fileSize) {
                 f = sftp::File{};
                 session->Unlink(remoteFilename);
               }
             } catch (sftp::Exception& ex) {
               if (ofd != -1) {
-                // close local file and delete it (due to failure)
+                // close local file; keep what was downloaded so the next
+                // download resumes from there
                 close(ofd);
-                fs::remove(localFilename, ec);
               }
               lock.lock();
               file.status = ex.what();
@@ -4,6 +4,7 @@
 
 #include "Exporter.h"
 
+#include <algorithm>
 #include <atomic>
 #include <ctime>
 #include <functional>
@@ -13,6 +14,8 @@
 #include <set>
 #include <string>
 #include <string_view>
+#include <system_error>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -25,8 +28,8 @@
 #include <imgui_internal.h>
 #include <imgui_stdlib.h>
 #include <portable-file-dialogs.h>
+#include <wpi/DataLogReader.h>
 #include <wpi/DenseMap.h>
-#include <wpi/MemoryBuffer.h>
 #include <wpi/SmallVector.h>
 #include <wpi/SpanExtras.h>
 #include <wpi/StringExtras.h>
@@ -39,6 +42,55 @@
 #include "App.h"
 
 namespace {
+// value type of an entry, resolved from the type string once so exports
+// don't compare strings for every record
+enum class ValueKind {
+  kOther,
+  kSystemTime,
+  kDouble,
+  kInteger,
+  kString,
+  kBoolean,
+  kBooleanArray,
+  kDoubleArray,
+  kFloatArray,
+  kIntegerArray,
+  kStringArray
+};
+
+ValueKind GetValueKind(std::string_view name, std::string_view type) {
+  if (name == "systemTime" && type == "int64") {
+    return ValueKind::kSystemTime;
+  } else if (type == "double") {
+    return ValueKind::kDouble;
+  } else if (type == "int64" || type == "int") {
+    // support "int" for compatibility with old NT4 datalogs
+    return ValueKind::kInteger;
+  } else if (type == "string" || type == "json") {
+    return ValueKind::kString;
+  } else if (type == "boolean") {
+    return ValueKind::kBoolean;
+  } else if (type == "boolean[]") {
+    return ValueKind::kBooleanArray;
+  } else if (type == "double[]") {
+    return ValueKind::kDoubleArray;
+  } else if (type == "float[]") {
+    return ValueKind::kFloatArray;
+  } else if (type == "int64[]") {
+    return ValueKind::kIntegerArray;
+  } else if (type == "string[]") {
+    return ValueKind::kStringArray;
+  } else {
+    return ValueKind::kOther;
+  }
+}
+
+// Type and metadata of an entry in a single input file
+struct InputFileEntry {
+  std::string type;
+  std::string metadata;
+};
+
 struct InputFile {
   explicit InputFile(std::unique_ptr<glass::DataLogReaderThread> datalog);
 
@@ -49,27 +101,39 @@ struct InputFile {
 
   ~InputFile();
 
+  // Releases the reader once the scan is done.  The entry list is all that's
+  // kept; exports reopen the file, so open files don't hold on to the log
+  // contents (e.g. the decompressed blocks of compressed logs).
+  void ReleaseReader();
+
   std::string filename;
   std::string stem;
+  // only set while the file is being scanned
   std::unique_ptr<glass::DataLogReaderThread> datalog;
+  // true if the file is a valid data log
+  bool valid = false;
+  unsigned int numRecords = 0;
+  // entries of this file; protected by gEntriesMutex
+  std::map<std::string, InputFileEntry, std::less<>> entries;
   std::string status;
   bool highlight = false;
 };
 
 struct Entry {
   explicit Entry(const wpi::log::StartRecordData& srd)
-      : name{srd.name}, type{srd.type}, metadata{srd.metadata} {}
+      : name{srd.name},
+        type{srd.type},
+        metadata{srd.metadata},
+        kind{GetValueKind(name, type)} {}
 
   std::string name;
   std::string type;
   std::string metadata;
+  ValueKind kind;
   std::set<InputFile*> inputFiles;
   bool typeConflict = false;
   bool metadataConflict = false;
   bool selected = true;
-
-  // used only during export
-  int column = -1;
 };
 
 struct EntryTreeNode {
@@ -142,9 +206,13 @@ static void RebuildEntryTree() {
 InputFile::InputFile(std::unique_ptr<glass::DataLogReaderThread> datalog_)
     : filename{datalog_->GetBufferIdentifier()},
       stem{fs::path{filename}.stem().string()},
-      datalog{std::move(datalog_)} {
+      datalog{std::move(datalog_)},
+      valid{true} {
   datalog->sigEntryAdded.connect([this](const wpi::log::StartRecordData& srd) {
     std::scoped_lock lock{gEntriesMutex};
+    entries.try_emplace(std::string{srd.name},
+                        InputFileEntry{std::string{srd.type},
+                                       std::string{srd.metadata}});
     auto it = gEntries.find(srd.name);
     if (it == gEntries.end()) {
       it = gEntries.emplace(srd.name, std::make_unique<Entry>(srd)).first;
@@ -162,9 +230,11 @@ InputFile::InputFile(std::unique_ptr<glass::DataLogReaderThread> datalog_)
 }
 
 InputFile::~InputFile() {
-  if (gShutdown || !datalog) {
+  if (gShutdown || !valid) {
     return;
   }
+  // stop the scan before removing the entries it added
+  datalog.reset();
   std::scoped_lock lock{gEntriesMutex};
   bool changed = false;
   for (auto it = gEntries.begin(); it != gEntries.end();) {
@@ -181,15 +251,21 @@ InputFile::~InputFile() {
   }
 }
 
+void InputFile::ReleaseReader() {
+  if (!datalog || !datalog->IsDone()) {
+    return;
+  }
+  numRecords = datalog->GetNumRecords();
+  datalog.reset();
+}
+
 static std::unique_ptr<InputFile> LoadDataLog(std::string_view filename) {
-  auto fileBuffer = wpi::MemoryBuffer::GetFile(filename);
-  if (!fileBuffer) {
+  std::error_code ec;
+  wpi::log::DataLogReader reader{filename, ec};
+  if (ec) {
     return std::make_unique<InputFile>(
-        filename,
-        fmt::format("Could not open file: {}", fileBuffer.error().message()));
+        filename, fmt::format("Could not open file: {}", ec.message()));
   }
-
-  wpi::log::DataLogReader reader{std::move(*fileBuffer)};
   if (!reader.IsValid()) {
     return std::make_unique<InputFile>(filename, "Not a valid datalog file");
   }
@@ -233,11 +309,19 @@ void DisplayInputFiles() {
       }
 
       ImGui::TableNextColumn();
+      it->second->ReleaseReader();
       if (it->second->datalog) {
-        ImGui::Text("%u records, %u entries%s",
+        ImGui::Text("%u records, %u entries (working)",
                     it->second->datalog->GetNumRecords(),
-                    it->second->datalog->GetNumEntries(),
-                    it->second->datalog->IsDone() ? "" : " (working)");
+                    it->second->datalog->GetNumEntries());
+      } else if (it->second->valid) {
+        size_t numEntries;
+        {
+          std::scoped_lock lock{gEntriesMutex};
+          numEntries = it->second->entries.size();
+        }
+        ImGui::Text("%u records, %u entries", it->second->numRecords,
+                    static_cast<unsigned int>(numEntries));
       } else {
         ImGui::TextUnformatted(it->second->status.c_str());
       }
@@ -287,9 +371,10 @@ static bool EmitEntry(const std::string& name, Entry& entry) {
     if (ImGui::IsItemHovered()) {
       ImGui::BeginTooltip();
       for (auto inputFile : entry.inputFiles) {
-        if (auto info = inputFile->datalog->GetEntry(entry.name)) {
+        auto it = inputFile->entries.find(entry.name);
+        if (it != inputFile->entries.end()) {
           ImGui::Text("%s: %s", inputFile->stem.c_str(),
-                      std::string{info->type}.c_str());
+                      it->second.type.c_str());
         }
       }
       ImGui::EndTooltip();
@@ -304,9 +389,10 @@ static bool EmitEntry(const std::string& name, Entry& entry) {
     if (ImGui::IsItemHovered()) {
       ImGui::BeginTooltip();
       for (auto inputFile : entry.inputFiles) {
-        if (auto info = inputFile->datalog->GetEntry(entry.name)) {
+        auto it = inputFile->entries.find(entry.name);
+        if (it != inputFile->entries.end()) {
           ImGui::Text("%s: %s", inputFile->stem.c_str(),
-                      std::string{info->metadata}.c_str());
+                      it->second.metadata.c_str());
         }
       }
       ImGui::EndTooltip();
@@ -455,141 +541,327 @@ static void PrintEscapedCsvString(wpi::raw_ostream& os, std::string_view str) {
 
 static void ValueToCsv(wpi::raw_ostream& os, const Entry& entry,
                        const wpi::log::DataLogRecord& record) {
-  // handle systemTime specially
-  if (entry.name == "systemTime" && entry.type == "int64") {
-    int64_t val;
-    if (record.GetInteger(&val)) {
-      std::time_t timeval = val / 1000000;
-      wpi::print(os, "{:%Y-%m-%d %H:%M:%S}.{:06}", *std::localtime(&timeval),
-                 val % 1000000);
-      return;
+  switch (entry.kind) {
+    case ValueKind::kSystemTime: {
+      int64_t val;
+      if (record.GetInteger(&val)) {
+        std::time_t timeval = val / 1000000;
+        std::tm tm;
+#ifdef _WIN32
+        localtime_s(&tm, &timeval);
+#else
+        localtime_r(&timeval, &tm);
+#endif
+        wpi::print(os, "{:%Y-%m-%d %H:%M:%S}.{:06}", tm, val % 1000000);
+        return;
+      }
+      break;
     }
-  } else if (entry.type == "double") {
-    double val;
-    if (record.GetDouble(&val)) {
-      wpi::print(os, "{}", val);
-      return;
+    case ValueKind::kDouble: {
+      double val;
+      if (record.GetDouble(&val)) {
+        wpi::print(os, "{}", val);
+        return;
+      }
+      break;
     }
-  } else if (entry.type == "int64" || entry.type == "int") {
-    // support "int" for compatibility with old NT4 datalogs
-    int64_t val;
-    if (record.GetInteger(&val)) {
-      wpi::print(os, "{}", val);
-      return;
+    case ValueKind::kInteger: {
+      int64_t val;
+      if (record.GetInteger(&val)) {
+        wpi::print(os, "{}", val);
+        return;
+      }
+      break;
     }
-  } else if (entry.type == "string" || entry.type == "json") {
-    std::string_view val;
-    record.GetString(&val);
-    os << '"';
-    PrintEscapedCsvString(os, val);
-    os << '"';
-    return;
-  } else if (entry.type == "boolean") {
-    bool val;
-    if (record.GetBoolean(&val)) {
-      wpi::print(os, "{}", val);
+    case ValueKind::kString: {
+      std::string_view val;
+      record.GetString(&val);
+      os << '"';
+      PrintEscapedCsvString(os, val);
+      os << '"';
       return;
     }
-  } else if (entry.type == "boolean[]") {
-    std::vector<int> val;
-    if (record.GetBooleanArray(&val)) {
-      wpi::print(os, "{}", fmt::join(val, ";"));
-      return;
+    case ValueKind::kBoolean: {
+      bool val;
+      if (record.GetBoolean(&val)) {
+        wpi::print(os, "{}", val);
+        return;
+      }
+      break;
     }
-  } else if (entry.type == "double[]") {
-    std::vector<double> val;
-    if (record.GetDoubleArray(&val)) {
-      wpi::print(os, "{}", fmt::join(val, ";"));
-      return;
+    case ValueKind::kBooleanArray: {
+      std::vector<int> val;
+      if (record.GetBooleanArray(&val)) {
+        wpi::print(os, "{}", fmt::join(val, ";"));
+        return;
+      }
+      break;
     }
-  } else if (entry.type == "float[]") {
-    std::vector<float> val;
-    if (record.GetFloatArray(&val)) {
-      wpi::print(os, "{}", fmt::join(val, ";"));
-      return;
+    case ValueKind::kDoubleArray: {
+      std::vector<double> val;
+      if (record.GetDoubleArray(&val)) {
+        wpi::print(os, "{}", fmt::join(val, ";"));
+        return;
+      }
+      break;
     }
-  } else if (entry.type == "int64[]") {
-    std::vector<int64_t> val;
-    if (record.GetIntegerArray(&val)) {
-      wpi::print(os, "{}", fmt::join(val, ";"));
-      return;
+    case ValueKind::kFloatArray: {
+      std::vector<float> val;
+      if (record.GetFloatArray(&val)) {
+        wpi::print(os, "{}", fmt::join(val, ";"));
+        return;
+      }
+      break;
     }
-  } else if (entry.type == "string[]") {
-    std::vector<std::string_view> val;
-    if (record.GetStringArray(&val)) {
-      os << '"';
-      bool first = true;
-      for (auto&& v : val) {
-        if (!first) {
-          os << ';';
+    case ValueKind::kIntegerArray: {
+      std::vector<int64_t> val;
+      if (record.GetIntegerArray(&val)) {
+        wpi::print(os, "{}", fmt::join(val, ";"));
+        return;
+      }
+      break;
+    }
+    case ValueKind::kStringArray: {
+      std::vector<std::string_view> val;
+      if (record.GetStringArray(&val)) {
+        os << '"';
+        bool first = true;
+        for (auto&& v : val) {
+          if (!first) {
+            os << ';';
+          }
+          first = false;
+          PrintEscapedCsvString(os, v);
         }
-        first = false;
-        PrintEscapedCsvString(os, v);
+        os << '"';
+        return;
       }
-      os << '"';
-      return;
+      break;
     }
+    case ValueKind::kOther:
+      break;
   }
   wpi::print(os, "<invalid>");
 }
 
-static void ExportCsvFile(InputFile& f, wpi::raw_ostream& os, int style) {
-  // header
-  if (style == 0) {
-    os << "Timestamp,Name,Value\n";
-  } else if (style == 1) {
-    // scan for exported fields for this file to print header and assign columns
-    os << "Timestamp";
-    int columnNum = 0;
-    for (auto&& entry : gEntries) {
-      if (entry.second->selected &&
-          entry.second->inputFiles.find(&f) != entry.second->inputFiles.end()) {
-        os << ',' << '"';
-        PrintEscapedCsvString(os, entry.first);
-        os << '"';
-        entry.second->column = columnNum++;
-      } else {
-        entry.second->column = -1;
+namespace {
+// A range of records of an input file, along with the entries that are
+// started (and selected for export) at the beginning of the range.
+struct ExportChunk {
+  wpi::log::DataLogReader::iterator begin;
+  wpi::log::DataLogReader::iterator end;
+  wpi::DenseMap<int, Entry*> nameMap;
+};
+}  // namespace
+
+// Approximate amount of log data in each export chunk.  Chunks are formatted
+// in parallel and written in order.
+static constexpr size_t kExportChunkSize = 1024 * 1024;
+
+static void UpdateNameMap(const wpi::log::DataLogRecord& record,
+                          wpi::DenseMap<int, Entry*>& nameMap) {
+  if (record.IsStart()) {
+    wpi::log::StartRecordData data;
+    if (record.GetStartData(&data)) {
+      auto it = gEntries.find(data.name);
+      if (it != gEntries.end() && it->second->selected) {
+        nameMap[data.entry] = it->second.get();
       }
     }
-    os << '\n';
+  } else if (record.IsFinish()) {
+    int entry;
+    if (record.GetFinishEntry(&entry)) {
+      nameMap.erase(entry);
+    }
   }
+}
 
+static std::vector<ExportChunk> SplitExportChunks(
+    const wpi::log::DataLogReader& reader) {
+  // this only parses record headers and control records, so it's much faster
+  // than formatting
+  std::vector<ExportChunk> chunks;
   wpi::DenseMap<int, Entry*> nameMap;
-  for (auto&& record : f.datalog->GetReader()) {
-    if (record.IsStart()) {
-      wpi::log::StartRecordData data;
-      if (record.GetStartData(&data)) {
-        auto it = gEntries.find(data.name);
-        if (it != gEntries.end() && it->second->selected) {
-          nameMap[data.entry] = it->second.get();
-        }
-      }
-    } else if (record.IsFinish()) {
-      int entry;
-      if (record.GetFinishEntry(&entry)) {
-        nameMap.erase(entry);
-      }
-    } else if (!record.IsControl()) {
-      auto entryIt = nameMap.find(record.GetEntry());
-      if (entryIt == nameMap.end()) {
-        continue;
-      }
-      Entry* entry = entryIt->second;
-
-      if (style == 0) {
-        wpi::print(os, "{},\"", record.GetTimestamp() / 1000000.0);
-        PrintEscapedCsvString(os, entry->name);
-        os << '"' << ',';
-        ValueToCsv(os, *entry, record);
-        os << '\n';
-      } else if (style == 1 && entry->column != -1) {
-        wpi::print(os, "{},", record.GetTimestamp() / 1000000.0);
-        for (int i = 0; i < entry->column; ++i) {
+  auto end = reader.end();
+  auto it = reader.begin();
+  chunks.push_back({it, end, nameMap});
+  size_t size = 0;
+  for (; it != end; ++it) {
+    if (size >= kExportChunkSize) {
+      chunks.back().end = it;
+      chunks.push_back({it, end, nameMap});
+      size = 0;
+    }
+    auto&& record = *it;
+    size += record.GetSize();
+    if (record.IsControl()) {
+      UpdateNameMap(record, nameMap);
+    }
+  }
+  return chunks;
+}
+
+// Returns the formatted output for each output file
+static std::vector<std::string> FormatExportChunk(
+    const ExportChunk& chunk, const wpi::DenseMap<const Entry*, int>& columns,
+    int style) {
+  std::vector<std::string> out(style == 2 ? columns.size() : 1);
+  auto nameMap = chunk.nameMap;
+  for (auto it = chunk.begin; it != chunk.end; ++it) {
+    auto&& record = *it;
+    if (record.IsControl()) {
+      UpdateNameMap(record, nameMap);
+      continue;
+    }
+    auto entryIt = nameMap.find(record.GetEntry());
+    if (entryIt == nameMap.end()) {
+      continue;
+    }
+    Entry* entry = entryIt->second;
+    auto columnIt = columns.find(entry);
+    if (columnIt == columns.end()) {
+      continue;
+    }
+
+    wpi::raw_string_ostream os{out[style == 2 ? columnIt->second : 0]};
+    if (style == 0) {
+      wpi::print(os, "{},\"", record.GetTimestamp() / 1000000.0);
+      PrintEscapedCsvString(os, entry->name);
+      os << '"' << ',';
+    } else {
+      wpi::print(os, "{},", record.GetTimestamp() / 1000000.0);
+      if (style == 1) {
+        for (int i = 0; i < columnIt->second; ++i) {
           os << ',';
         }
-        ValueToCsv(os, *entry, record);
-        os << '\n';
+      }
+    }
+    ValueToCsv(os, *entry, record);
+    os << '\n';
+  }
+  return out;
+}
+
+// Replaces characters that aren't safe in a filename. As different names can
+// map to the same filename (e.g. "/a/b" and "/a_b"), a number is added to
+// any filename already in use (compared case-insensitively, as filesystems
+// may be).
+static std::string EntryToFilename(std::string_view name,
+                                   std::set<std::string>& used) {
+  std::string stem;
+  stem.reserve(name.size());
+  for (char ch : name) {
+    if (wpi::isAlnum(ch) || ch == '-' || ch == '_' || ch == '.') {
+      stem += ch;
+    } else {
+      stem += '_';
+    }
+  }
+  std::string rv = stem + ".csv";
+  for (int i = 2;; ++i) {
+    std::string key = rv;
+    std::transform(key.begin(), key.end(), key.begin(),
+                   [](char ch) { return wpi::toLower(ch); });
+    if (used.insert(std::move(key)).second) {
+      return rv;
+    }
+    rv = fmt::format("{}_{}.csv", stem, i);
+  }
+}
+
+static std::unique_ptr<wpi::raw_fd_ostream> OpenCsvFile(const fs::path& path) {
+  std::error_code ec;
+  auto of = fs::OpenFileForWrite(path, ec, fs::CD_CreateNew, fs::OF_Text);
+  if (ec) {
+    std::scoped_lock lock{gExportMutex};
+    gExportErrors.emplace_back(
+        fmt::format("{}: {}", path.string(), ec.message()));
+    return nullptr;
+  }
+  return std::make_unique<wpi::raw_fd_ostream>(
+      fs::FileToFd(of, ec, fs::OF_Text), true);
+}
+
+static void ExportCsvFile(InputFile& f, const fs::path& outPath, int style) {
+  // reopen the log rather than keeping it open from the scan; the mapping
+  // (and any decompressed blocks) are released when the export is done
+  std::error_code ec;
+  wpi::log::DataLogReader reader{f.filename, ec};
+  if (ec || !reader.IsValid()) {
+    std::scoped_lock lock{gExportMutex};
+    gExportErrors.emplace_back(fmt::format(
+        "{}: {}", f.filename,
+        ec ? ec.message() : std::string{"Not a valid datalog file"}));
+    return;
+  }
+
+  // assign columns to the entries of this file that are selected for export
+  wpi::DenseMap<const Entry*, int> columns;
+  std::vector<const Entry*> entries;
+  for (auto&& entry : gEntries) {
+    if (entry.second->selected &&
+        entry.second->inputFiles.find(&f) != entry.second->inputFiles.end()) {
+      columns[entry.second.get()] = entries.size();
+      entries.emplace_back(entry.second.get());
+    }
+  }
+
+  // open output files and print headers
+  std::vector<std::unique_ptr<wpi::raw_fd_ostream>> outputs;
+  if (style == 2) {
+    // one file per entry, in a folder named after the input file
+    fs::path dir = outPath / f.stem;
+    fs::create_directories(dir, ec);
+    if (ec) {
+      std::scoped_lock lock{gExportMutex};
+      gExportErrors.emplace_back(
+          fmt::format("{}: {}", dir.string(), ec.message()));
+      return;
+    }
+    std::set<std::string> usedFilenames;
+    for (auto&& entry : entries) {
+      auto os = OpenCsvFile(dir / EntryToFilename(entry->name, usedFilenames));
+      if (!os) {
+        return;
+      }
+      *os << "Timestamp,Value\n";
+      outputs.emplace_back(std::move(os));
+    }
+  } else {
+    auto os = OpenCsvFile(outPath /
+                          fs::path{f.filename}.replace_extension("csv"));
+    if (!os) {
+      return;
+    }
+    if (style == 0) {
+      *os << "Timestamp,Name,Value\n";
+    } else if (style == 1) {
+      *os << "Timestamp";
+      for (auto&& entry : entries) {
+        *os << ',' << '"';
+        PrintEscapedCsvString(*os, entry->name);
+        *os << '"';
+      }
+      *os << '\n';
+    }
+    outputs.emplace_back(std::move(os));
+  }
+
+  // format chunks in batches of one per thread; write each batch in order
+  auto chunks = SplitExportChunks(reader);
+  size_t numThreads = std::max(1u, std::thread::hardware_concurrency());
+  std::vector<std::future<std::vector<std::string>>> batch;
+  for (size_t i = 0; i < chunks.size(); i += batch.size()) {
+    batch.clear();
+    for (size_t j = i; j < chunks.size() && batch.size() < numThreads; ++j) {
+      batch.emplace_back(std::async(std::launch::async, FormatExportChunk,
+                                    std::cref(chunks[j]), std::cref(columns),
+                                    style));
+    }
+    for (auto&& result : batch) {
+      auto out = result.get();
+      for (size_t k = 0; k < out.size(); ++k) {
+        *outputs[k] << out[k];
       }
     }
   }
@@ -598,20 +870,8 @@ static void ExportCsvFile(InputFile& f, wpi::raw_ostream& os, int style) {
 static void ExportCsv(std::string_view outputFolder, int style) {
   fs::path outPath{outputFolder};
   for (auto&& f : gInputFiles) {
-    if (f.second->datalog) {
-      std::error_code ec;
-      auto of = fs::OpenFileForWrite(
-          outPath / fs::path{f.first}.replace_extension("csv"), ec,
-          fs::CD_CreateNew, fs::OF_Text);
-      if (ec) {
-        std::scoped_lock lock{gExportMutex};
-        gExportErrors.emplace_back(
-            fmt::format("{}: {}", f.first, ec.message()));
-        ++gExportCount;
-        continue;
-      }
-      wpi::raw_fd_ostream os{fs::FileToFd(of, ec, fs::OF_Text), true};
-      ExportCsvFile(*f.second, os, style);
+    if (f.second->valid) {
+      ExportCsvFile(*f.second, outPath, style);
     }
     ++gExportCount;
   }
@@ -630,7 +890,7 @@ void DisplayOutput(glass::Storage& storage) {
     }
     ImGui::TextUnformatted(outputFolder.c_str());
 
-    static const char* const options[] = {"List", "Table"};
+    static const char* const options[] = {"List", "Table", "Columns"};
     static int style = 0;
     ImGui::SetNextItemWidth(ImGui::GetFontSize() * 8);
     ImGui::Combo("Style", &style, options,
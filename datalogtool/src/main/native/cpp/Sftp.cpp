@@ -75,6 +75,22 @@ size_t File::Read(void* buf, uint32_t count) {
   return rv;
 }
 
+uint32_t File::AsyncReadBegin(uint32_t count) {
+  int rv = sftp_async_read_begin(m_handle, count);
+  if (rv < 0) {
+    throw Exception{m_handle->sftp};
+  }
+  return rv;
+}
+
+size_t File::AsyncRead(void* buf, uint32_t count, uint32_t id) {
+  int rv = sftp_async_read(m_handle, buf, count, id);
+  if (rv < 0) {
+    throw Exception{m_handle->sftp};
+  }
+  return rv;
+}
+
 size_t File::Write(std::span<const uint8_t> data) {
   auto rv = sftp_write(m_handle, data.data(), data.size());
   if (rv < 0) {
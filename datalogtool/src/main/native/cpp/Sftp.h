@@ -48,6 +48,27 @@ class File {
   void SetBlocking() { sftp_file_set_blocking(m_handle); }
 
   size_t Read(void* buf, uint32_t count);
+
+  /**
+   * Sends a read request for the data at the current offset, and advances the
+   * offset.  Multiple requests can be outstanding to avoid waiting a round
+   * trip for each read.
+   *
+   * @param count number of bytes to read
+   * @return request ID to pass to AsyncRead()
+   */
+  uint32_t AsyncReadBegin(uint32_t count);
+
+  /**
+   * Waits for the response to a read request.  Responses must be read in the
+   * order the requests were made.
+   *
+   * @param buf buffer
+   * @param count size of buffer; must be at least the requested count
+   * @param id request ID returned by AsyncReadBegin()
+   * @return number of bytes read; 0 at end of file
+   */
+  size_t AsyncRead(void* buf, uint32_t count, uint32_t id);
   size_t Write(std::span<const uint8_t> data);
 
   void Seek(uint64_t offset);
@@ -23,6 +23,7 @@
 #include <wpigui_internal.h>
 
 #include "glass/ContextInternal.h"
+#include "glass/DataSource.h"
 
 using namespace glass;
 
@@ -318,6 +319,9 @@ Context::Context()
           storageRoots.try_emplace("").first->second.GetChild("sourceNames")} {
   storageStack.emplace_back(&storageRoots[""]);
 
+  // notify data source listeners once per frame, after the models update
+  wpi::gui::AddLateExecute([] { DataSource::NotifyChanges(); });
+
   // override ImGui ini saving
   wpi::gui::ConfigureCustomSaveSettings(
       [this] { LoadStorageImpl(this, storageLoadDir, storageName); },
@@ -502,6 +506,18 @@ bool glass::TreeNodeEx(const char* label, ImGuiTreeNodeFlags flags) {
   return open;
 }
 
+bool glass::TreeNodeHidden(const char* label, ImGuiTreeNodeFlags flags) {
+  PushStorageStack(label);
+  bool open = GetStorage().GetBool(
+      "open", (flags & ImGuiTreeNodeFlags_DefaultOpen) != 0);
+  if (open) {
+    ImGui::TreePush(label);
+  } else {
+    PopStorageStack();
+  }
+  return open;
+}
+
 void glass::TreePop() {
   ImGui::TreePop();
   PopStorageStack();
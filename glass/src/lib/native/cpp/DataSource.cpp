@@ -4,13 +4,20 @@
 
 #include "glass/DataSource.h"
 
+#include <algorithm>
+
 #include <fmt/format.h>
+#include <wpigui.h>
 
 #include "glass/ContextInternal.h"
 
 using namespace glass;
 
 wpi::sig::Signal<const char*, DataSource*> DataSource::sourceCreated;
+wpi::sig::Signal<const DataSource::Changes&> DataSource::valuesChanged;
+
+// Limit on values waiting for NotifyChanges(), in case the GUI isn't running
+static constexpr size_t kMaxPendingChanges = 1 << 18;
 
 DataSource::DataSource(std::string_view id)
     : m_id{id}, m_name{gContext->sourceNameStorage.GetString(m_id)} {
@@ -29,6 +36,69 @@ DataSource::~DataSource() {
     return;
   }
   gContext->sources.erase(m_id);
+
+  std::scoped_lock lock{gContext->sourceChangesMutex};
+  if (m_changePending) {
+    auto& sources = gContext->sourceChanges.sources;
+    std::replace(sources.begin(), sources.end(), this,
+                 static_cast<DataSource*>(nullptr));
+  }
+}
+
+void DataSource::SetValue(double value, int64_t time) {
+  {
+    std::scoped_lock lock{m_valueMutex};
+    if (value != m_value) {
+      wpi::gui::Wake();
+    }
+    m_value = value;
+    m_valueTime = time;
+  }
+
+  if (!gContext) {
+    return;
+  }
+  std::scoped_lock lock{gContext->sourceChangesMutex};
+  auto& changes = gContext->sourceChanges;
+  if (changes.sources.size() < kMaxPendingChanges) {
+    changes.sources.emplace_back(this);
+    changes.values.emplace_back(value);
+    changes.times.emplace_back(time);
+    m_changePending = true;
+  }
+}
+
+void DataSource::NotifyChanges() {
+  if (!gContext) {
+    return;
+  }
+
+  // swap buffers so values set by listeners are notified next time
+  auto& changes = gContext->notifyingSourceChanges;
+  {
+    std::scoped_lock lock{gContext->sourceChangesMutex};
+    std::swap(changes, gContext->sourceChanges);
+    for (auto source : changes.sources) {
+      if (source) {
+        source->m_changePending = false;
+      }
+    }
+  }
+
+  if (changes.sources.empty()) {
+    return;
+  }
+
+  for (size_t i = 0; i < changes.sources.size(); ++i) {
+    if (auto source = changes.sources[i]) {
+      source->valueChanged(changes.values[i], changes.times[i]);
+    }
+  }
+  valuesChanged(changes);
+
+  changes.sources.clear();
+  changes.values.clear();
+  changes.times.clear();
 }
 
 void DataSource::LabelText(const char* label, const char* fmt, ...) const {
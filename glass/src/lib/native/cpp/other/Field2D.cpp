@@ -4,12 +4,15 @@
 
 #include "glass/other/Field2D.h"
 
+#include <stdint.h>
+
 #include <algorithm>
 #include <cmath>
 #include <cstdio>
 #include <memory>
 #include <string>
 #include <string_view>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -164,7 +167,8 @@ class PoseFrameData {
   SelectedTargetInfo GetDragTarget(int corner, float dist) const;
   void HandleDrag(const ImVec2& cursor);
   void Draw(ImDrawList* drawList, std::vector<ImVec2>* center,
-            std::vector<ImVec2>* left, std::vector<ImVec2>* right) const;
+            std::vector<ImVec2>* left, std::vector<ImVec2>* right,
+            bool drawLine, bool drawShape) const;
 
   // in window coordinates
   ImVec2 m_center;
@@ -186,6 +190,37 @@ class PoseFrameData {
   frc::Pose2d m_pose;
 };
 
+// Skips drawing parts of poses that wouldn't visibly change the frame, so
+// objects with thousands of poses (e.g. trajectories or particle filter clouds)
+// stay cheap to draw. Line points within a pixel of the previous point are
+// dropped, as are boxes and arrows that are off screen or that land on the same
+// pixel with about the same rotation as one that was already drawn.
+class PoseDecimator {
+ public:
+  void Reset(const DisplayOptions& displayOptions, const ImVec2& clipMin,
+             const ImVec2& clipMax);
+
+  // returns true if the pose should be added to the lines
+  bool AddLinePoint(const PoseFrameData& pfd);
+
+  // returns true if the pose's box or arrow should be drawn
+  bool AddShape(const PoseFrameData& pfd);
+
+ private:
+  static int GetRotationBucket(const PoseFrameData& pfd);
+
+  bool m_hasLine;
+  bool m_hasShape;
+  ImVec2 m_clipMin;
+  ImVec2 m_clipMax;
+
+  bool m_hasLinePoint;
+  ImVec2 m_linePoint;
+  int m_lineRotation;
+
+  std::unordered_set<uint64_t> m_drawnShapes;
+};
+
 class ObjectInfo {
  public:
   explicit ObjectInfo(Storage& storage);
@@ -904,10 +939,13 @@ void PoseFrameData::HandleDrag(const ImVec2& cursor) {
 }
 
 void PoseFrameData::Draw(ImDrawList* drawList, std::vector<ImVec2>* center,
-                         std::vector<ImVec2>* left,
-                         std::vector<ImVec2>* right) const {
+                         std::vector<ImVec2>* left, std::vector<ImVec2>* right,
+                         bool drawLine, bool drawShape) const {
   switch (m_displayOptions.style) {
     case DisplayOptions::kBoxImage:
+      if (!drawShape) {
+        return;
+      }
       if (m_displayOptions.texture) {
         drawList->AddImageQuad(m_displayOptions.texture, m_corners[0],
                                m_corners[1], m_corners[2], m_corners[3]);
@@ -918,24 +956,95 @@ void PoseFrameData::Draw(ImDrawList* drawList, std::vector<ImVec2>* center,
       break;
     case DisplayOptions::kLine:
     case DisplayOptions::kLineClosed:
-      center->emplace_back(m_center);
+      if (drawLine) {
+        center->emplace_back(m_center);
+      }
       break;
     case DisplayOptions::kTrack:
-      center->emplace_back(m_center);
-      left->emplace_back(m_corners[4]);
-      right->emplace_back(m_corners[5]);
+      if (drawLine) {
+        center->emplace_back(m_center);
+        left->emplace_back(m_corners[4]);
+        right->emplace_back(m_corners[5]);
+      }
       break;
     case DisplayOptions::kHidden:
       break;
   }
 
-  if (m_displayOptions.arrows) {
+  if (m_displayOptions.arrows && drawShape) {
     drawList->AddTriangle(m_arrow[0], m_arrow[1], m_arrow[2],
                           m_displayOptions.arrowColor,
                           m_displayOptions.arrowWeight);
   }
 }
 
+void PoseDecimator::Reset(const DisplayOptions& displayOptions,
+                          const ImVec2& clipMin, const ImVec2& clipMax) {
+  m_hasLine = displayOptions.style == DisplayOptions::kLine ||
+              displayOptions.style == DisplayOptions::kLineClosed ||
+              displayOptions.style == DisplayOptions::kTrack;
+  m_hasShape = displayOptions.style == DisplayOptions::kBoxImage ||
+               displayOptions.arrows;
+  m_clipMin = clipMin;
+  m_clipMax = clipMax;
+  m_hasLinePoint = false;
+  m_drawnShapes.clear();
+}
+
+int PoseDecimator::GetRotationBucket(const PoseFrameData& pfd) {
+  // 1 degree buckets
+  return static_cast<int>(
+      std::floor(pfd.GetRotation().Degrees().value() + 180.0));
+}
+
+bool PoseDecimator::AddLinePoint(const PoseFrameData& pfd) {
+  if (!m_hasLine) {
+    return false;
+  }
+
+  // only consecutive points are compared, as dropping a point that's only
+  // close to an earlier part of the line would change the line's path
+  int rotation = GetRotationBucket(pfd);
+  if (m_hasLinePoint && rotation == m_lineRotation &&
+      gui::GetDistSquared(pfd.m_center, m_linePoint) < 1.0f) {
+    return false;
+  }
+  m_hasLinePoint = true;
+  m_linePoint = pfd.m_center;
+  m_lineRotation = rotation;
+  return true;
+}
+
+bool PoseDecimator::AddShape(const PoseFrameData& pfd) {
+  if (!m_hasShape) {
+    return false;
+  }
+
+  // skip if entirely off screen
+  ImVec2 min = pfd.m_arrow[0];
+  ImVec2 max = pfd.m_arrow[0];
+  for (auto&& pt : pfd.m_corners) {
+    min = ImMin(min, pt);
+    max = ImMax(max, pt);
+  }
+  for (auto&& pt : pfd.m_arrow) {
+    min = ImMin(min, pt);
+    max = ImMax(max, pt);
+  }
+  if (max.x < m_clipMin.x || max.y < m_clipMin.y || min.x > m_clipMax.x ||
+      min.y > m_clipMax.y) {
+    return false;
+  }
+
+  // skip if one was already drawn at the same pixel and rotation
+  auto x = static_cast<uint64_t>(std::floor(pfd.m_center.x - m_clipMin.x));
+  auto y = static_cast<uint64_t>(std::floor(pfd.m_center.y - m_clipMin.y));
+  auto rotation = static_cast<uint64_t>(GetRotationBucket(pfd));
+  return m_drawnShapes
+      .insert(((x & 0xffffff) << 40) | ((y & 0xffffff) << 16) | rotation)
+      .second;
+}
+
 void glass::DisplayField2DSettings(Field2DModel* model) {
   auto& storage = GetStorage();
   auto field = storage.GetData<FieldInfo>();
@@ -1003,6 +1112,8 @@ class FieldDisplay {
 
   // lines; static so buffer gets reused
   std::vector<ImVec2> m_centerLine, m_leftLine, m_rightLine;
+
+  PoseDecimator m_decimator;
 };
 }  // namespace
 
@@ -1113,6 +1224,9 @@ void FieldDisplay::DisplayObject(FieldObjectModel& model,
   m_leftLine.resize(0);
   m_rightLine.resize(0);
 
+  m_decimator.Reset(displayOptions, m_drawList->GetClipRectMin(),
+                    m_drawList->GetClipRectMax());
+
   m_drawSplit.Split(m_drawList, 2);
   m_drawSplit.SetCurrentChannel(m_drawList, 1);
   auto poses = gPopupState.GetInsertModel() == &model
@@ -1134,12 +1248,17 @@ void FieldDisplay::DisplayObject(FieldObjectModel& model,
     }
 
     // handle active dragging of this object
-    if (gDragState.target.objModel == &model && gDragState.target.index == i) {
+    bool isDragging =
+        gDragState.target.objModel == &model && gDragState.target.index == i;
+    if (isDragging) {
       pfd.HandleDrag(m_mousePos);
     }
 
-    // draw
-    pfd.Draw(m_drawList, &m_centerLine, &m_leftLine, &m_rightLine);
+    // draw (always draw the pose being dragged)
+    bool drawLine = m_decimator.AddLinePoint(pfd) || isDragging;
+    bool drawShape = m_decimator.AddShape(pfd) || isDragging;
+    pfd.Draw(m_drawList, &m_centerLine, &m_leftLine, &m_rightLine, drawLine,
+             drawShape);
     ++i;
   }
 
@@ -85,6 +85,9 @@ class PlotSeries {
            (m_digital.GetValue() == kAuto && m_source && m_source->IsDigital());
   }
   void AppendValue(double value, int64_t time);
+  void AddPoint(const ImPlotPoint& point);
+  void Decimate(double xMin, double xMax, int width, double now,
+                double zeroTime, int size, int offset);
 
   // source linkage
   DataSource* m_source = nullptr;
@@ -106,11 +109,23 @@ class PlotSeries {
   int& m_digitalBitGap;
 
   // value storage
-  static constexpr int kMaxSize = 20000;
+  static constexpr int kMaxSize = 1 << 17;
   static constexpr double kTimeGap = 0.05;
   std::atomic<int> m_size = 0;
   std::atomic<int> m_offset = 0;
   ImPlotPoint m_data[kMaxSize];
+
+  // lowest and highest points of each block of m_data, so the extremes of a
+  // long span of values can be found without visiting every value
+  static constexpr int kBlockSize = 64;
+  struct BlockRange {
+    ImPlotPoint min;
+    ImPlotPoint max;
+  };
+  BlockRange m_blocks[kMaxSize / kBlockSize];
+
+  // values to plot when there are many more than the plot is pixels wide
+  std::vector<ImPlotPoint> m_decimated;
 };
 
 class Plot {
@@ -264,43 +279,127 @@ void PlotSeries::SetSource(DataSource* source) {
 
 void PlotSeries::AppendValue(double value, int64_t timeUs) {
   double time = (timeUs != 0 ? timeUs : wpi::Now()) * 1.0e-6;
-  if (IsDigital()) {
-    if (m_size < kMaxSize) {
-      m_data[m_size] = ImPlotPoint{time, value};
-      ++m_size;
-    } else {
-      m_data[m_offset] = ImPlotPoint{time, value};
-      m_offset = (m_offset + 1) % kMaxSize;
+  // as an analog graph draws linear lines in between each value,
+  // insert duplicate value if "long" time between updates so it
+  // looks appropriately flat
+  if (!IsDigital() && m_size > 0) {
+    const ImPlotPoint& last = m_data[(m_offset + m_size - 1) % kMaxSize];
+    if ((time - last.x) > kTimeGap) {
+      AddPoint(ImPlotPoint{time, last.y});
     }
+  }
+  AddPoint(ImPlotPoint{time, value});
+}
+
+void PlotSeries::AddPoint(const ImPlotPoint& point) {
+  int index = m_size < kMaxSize ? m_size.load() : m_offset.load();
+  m_data[index] = point;
+
+  auto& block = m_blocks[index / kBlockSize];
+  if (index % kBlockSize == 0) {
+    block = {point, point};
+  } else if (point.y < block.min.y) {
+    block.min = point;
+  } else if (point.y > block.max.y) {
+    block.max = point;
+  }
+
+  if (m_size < kMaxSize) {
+    ++m_size;
   } else {
-    // as an analog graph draws linear lines in between each value,
-    // insert duplicate value if "long" time between updates so it
-    // looks appropriately flat
-    if (m_size < kMaxSize) {
-      if (m_size > 0) {
-        if ((time - m_data[m_size - 1].x) > kTimeGap) {
-          m_data[m_size] = ImPlotPoint{time, m_data[m_size - 1].y};
-          ++m_size;
-        }
+    m_offset = (m_offset + 1) % kMaxSize;
+  }
+}
+
+void PlotSeries::Decimate(double xMin, double xMax, int width, double now,
+                          double zeroTime, int size, int offset) {
+  auto at = [&](int idx) -> const ImPlotPoint& {
+    return m_data[(offset + idx) % kMaxSize];
+  };
+
+  // index of the first value at or after time x in [first, last)
+  auto lowerBound = [&](int first, int last, double x) {
+    while (first < last) {
+      int mid = first + (last - first) / 2;
+      if (at(mid).x < x) {
+        first = mid + 1;
+      } else {
+        last = mid;
       }
-      m_data[m_size] = ImPlotPoint{time, value};
-      ++m_size;
-    } else {
-      if (m_offset == 0) {
-        if ((time - m_data[kMaxSize - 1].x) > kTimeGap) {
-          m_data[m_offset] = ImPlotPoint{time, m_data[kMaxSize - 1].y};
-          ++m_offset;
+    }
+    return first;
+  };
+
+  // the block being written holds both the newest and oldest values, so its
+  // range can't be used
+  int writeBlock = (size < kMaxSize ? size : offset) / kBlockSize;
+
+  // include the values just outside the visible range so lines reach the edges
+  int begin = std::max(lowerBound(0, size, xMin) - 1, 0);
+  int end = std::min(lowerBound(begin, size, xMax) + 1, size);
+
+  m_decimated.clear();
+  auto add = [&](const ImPlotPoint& point) {
+    m_decimated.emplace_back(point.x - zeroTime, point.y);
+  };
+
+  // keep the lowest and highest value in each pixel column, in time order, so
+  // spikes are never dropped
+  add(at(begin));
+  double columnTime = (xMax - xMin) / width;
+  int idx = begin + 1;
+  for (int column = 1; column <= width && idx < end - 1; ++column) {
+    int columnEnd =
+        column == width ? end - 1
+                        : lowerBound(idx, end - 1, xMin + column * columnTime);
+    if (columnEnd == idx) {
+      continue;
+    }
+
+    const ImPlotPoint* min = &at(idx);
+    const ImPlotPoint* max = min;
+    while (idx < columnEnd) {
+      int index = (offset + idx) % kMaxSize;
+      if (index % kBlockSize == 0 && idx + kBlockSize <= columnEnd &&
+          index / kBlockSize != writeBlock) {
+        const auto& block = m_blocks[index / kBlockSize];
+        if (block.min.y < min->y) {
+          min = &block.min;
         }
+        if (block.max.y > max->y) {
+          max = &block.max;
+        }
+        idx += kBlockSize;
       } else {
-        if ((time - m_data[m_offset - 1].x) > kTimeGap) {
-          m_data[m_offset] = ImPlotPoint{time, m_data[m_offset - 1].y};
-          m_offset = (m_offset + 1) % kMaxSize;
+        const ImPlotPoint& point = m_data[index];
+        if (point.y < min->y) {
+          min = &point;
+        }
+        if (point.y > max->y) {
+          max = &point;
         }
+        ++idx;
       }
-      m_data[m_offset] = ImPlotPoint{time, value};
-      m_offset = (m_offset + 1) % kMaxSize;
+    }
+
+    if (min->x < max->x) {
+      add(*min);
+      add(*max);
+    } else if (min->x > max->x) {
+      add(*max);
+      add(*min);
+    } else {
+      add(*min);
     }
   }
+  if (end - 1 > begin) {
+    add(at(end - 1));
+  }
+
+  // need to have last value at current time
+  if (end == size) {
+    add(ImPlotPoint{now, at(size - 1).y});
+  }
 }
 
 const char* PlotSeries::GetName() const {
@@ -326,6 +425,7 @@ PlotSeries::Action PlotSeries::EmitPlot(PlotView& view, double now, size_t i,
 
   int size = m_size;
   int offset = m_offset;
+  double zeroTime = GetZeroTime() * 1.0e-6;
 
   // need to have last value at current time, so need to create fake last value
   // we handle the offset logic ourselves to avoid wrap issues with size + 1
@@ -336,8 +436,8 @@ PlotSeries::Action PlotSeries::EmitPlot(PlotView& view, double now, size_t i,
     int size;
     int offset;
   };
-  GetterData getterData = {now, GetZeroTime() * 1.0e-6, m_data, size, offset};
-  auto getter = [](int idx, void* data) {
+  GetterData getterData = {now, zeroTime, m_data, size, offset};
+  ImPlotGetter getter = [](int idx, void* data) {
     auto d = static_cast<GetterData*>(data);
     if (idx == d->size) {
       return ImPlotPoint{
@@ -352,6 +452,23 @@ PlotSeries::Action PlotSeries::EmitPlot(PlotView& view, double now, size_t i,
     }
     return ImPlotPoint{point->x - d->zeroTime, point->y};
   };
+  void* userData = &getterData;
+  int count = size + 1;
+
+  // when there are many more values than pixels, only plot the extremes of
+  // the visible values in each pixel column so the cost of drawing doesn't
+  // grow with the number of values
+  int width = static_cast<int>(ImPlot::GetPlotSize().x);
+  if (width > 0 && size > 4 * width) {
+    ImPlotRange xRange = ImPlot::GetPlotLimits().X;
+    Decimate(xRange.Min + zeroTime, xRange.Max + zeroTime, width, now,
+             zeroTime, size, offset);
+    getter = [](int idx, void* data) {
+      return static_cast<ImPlotPoint*>(data)[idx];
+    };
+    userData = m_decimated.data();
+    count = m_decimated.size();
+  }
 
   if (m_color.GetColorFloat()[3] == IMPLOT_AUTO) {
     SetColor(ImPlot::GetColormapColor(i));
@@ -360,7 +477,7 @@ PlotSeries::Action PlotSeries::EmitPlot(PlotView& view, double now, size_t i,
   if (IsDigital()) {
     ImPlot::PushStyleVar(ImPlotStyleVar_DigitalBitHeight, m_digitalBitHeight);
     ImPlot::PushStyleVar(ImPlotStyleVar_DigitalBitGap, m_digitalBitGap);
-    ImPlot::PlotDigitalG(label, getter, &getterData, size + 1);
+    ImPlot::PlotDigitalG(label, getter, userData, count);
     ImPlot::PopStyleVar();
     ImPlot::PopStyleVar();
   } else {
@@ -370,7 +487,7 @@ PlotSeries::Action PlotSeries::EmitPlot(PlotView& view, double now, size_t i,
       ImPlot::SetAxis(ImAxis_Y1);
     }
     ImPlot::SetNextMarkerStyle(m_marker.GetValue() - 1);
-    ImPlot::PlotLineG(label, getter, &getterData, size + 1);
+    ImPlot::PlotLineG(label, getter, userData, count);
   }
 
   // DND source for PlotSeries
@@ -4,6 +4,9 @@
 
 #include "glass/support/DataLogReaderThread.h"
 
+#include <algorithm>
+#include <deque>
+#include <future>
 #include <string>
 #include <utility>
 
@@ -20,17 +23,99 @@ DataLogReaderThread::~DataLogReaderThread() {
 }
 
 void DataLogReaderThread::ReadMain() {
-  wpi::SmallDenseMap<
-      int, std::pair<DataLogReaderEntry*, std::span<const uint8_t>>, 8>
-      schemaEntries;
+  size_t numBlocks = m_reader.GetBlockCount();
+  if (numBlocks <= 1) {
+    ProcessChunk(ScanChunk(m_reader.begin(), m_reader.end()));
+  } else {
+    // Compressed logs can be split at block boundaries. Scan chunks of a few
+    // blocks in parallel, but process them in order, so entries are added as
+    // soon as the start of the log has been scanned.
+    size_t numThreads = std::max(1u, std::thread::hardware_concurrency());
+    size_t blocksPerChunk = std::max<size_t>(numBlocks / (numThreads * 4), 1);
+    std::deque<std::future<Chunk>> pending;
+    size_t nextBlock = 0;
+    while (m_active && (nextBlock < numBlocks || !pending.empty())) {
+      while (nextBlock < numBlocks && pending.size() < numThreads) {
+        size_t endBlock = std::min(nextBlock + blocksPerChunk, numBlocks);
+        pending.emplace_back(std::async(
+            std::launch::async,
+            [this, begin = m_reader.BlockBegin(nextBlock),
+             end = m_reader.BlockBegin(endBlock)] {
+              return ScanChunk(begin, end);
+            }));
+        nextBlock = endBlock;
+      }
+      ProcessChunk(pending.front().get());
+      pending.pop_front();
+    }
+  }
 
-  for (auto recordIt = m_reader.begin(), recordEnd = m_reader.end();
-       recordIt != recordEnd; ++recordIt) {
-    auto& record = *recordIt;
+  // build schema databases
+  for (auto&& schemaPair : m_schemaEntries) {
+    auto name = schemaPair.second.entry->name;
+    auto data = schemaPair.second.data;
+    if (data.empty()) {
+      continue;
+    }
+    if (auto strippedName = wpi::remove_prefix(name, "NT:")) {
+      name = *strippedName;
+    }
+    if (auto typeStr = wpi::remove_prefix(name, "/.schema/struct:")) {
+      std::string_view schema{reinterpret_cast<const char*>(data.data()),
+                              data.size()};
+      std::string err;
+      auto desc = m_structDb.Add(*typeStr, schema, &err);
+      if (!desc) {
+        wpi::print("could not decode struct '{}' schema '{}': {}\n", name,
+                   schema, err);
+      }
+    } else if (auto filename = wpi::remove_prefix(name, "/.schema/proto:")) {
+#ifndef NO_PROTOBUF
+      // protobuf descriptor handling
+      if (!m_protoDb.Add(*filename, data)) {
+        wpi::print("could not decode protobuf '{}' filename '{}'\n", name,
+                   *filename);
+      }
+#endif
+    }
+  }
+
+  sigDone();
+  m_done = true;
+}
+
+DataLogReaderThread::Chunk DataLogReaderThread::ScanChunk(
+    wpi::log::DataLogReader::iterator begin,
+    wpi::log::DataLogReader::iterator end) {
+  Chunk chunk;
+  unsigned int numRecords = 0;
+  // end() is past every record, and a corrupt record also ends the scan
+  for (auto recordIt = begin; recordIt < end; ++recordIt) {
     if (!m_active) {
       break;
     }
-    ++m_numRecords;
+    auto& record = *recordIt;
+    if (record.IsControl()) {
+      chunk.controlRecords.emplace_back(recordIt);
+    } else {
+      chunk.lastData.insert_or_assign(record.GetEntry(), recordIt);
+    }
+    // avoid contending on the counter for every record
+    if (++numRecords == 1024) {
+      m_numRecords += numRecords;
+      numRecords = 0;
+    }
+  }
+  m_numRecords += numRecords;
+  return chunk;
+}
+
+void DataLogReaderThread::ProcessChunk(const Chunk& chunk) {
+  for (auto&& recordIt : chunk.controlRecords) {
+    auto& record = *recordIt;
+    if (!m_active) {
+      return;
+    }
     if (record.IsStart()) {
       DataLogReaderEntry data;
       if (record.GetStartData(&data)) {
@@ -41,13 +126,13 @@ void DataLogReaderThread::ReadMain() {
         }
         auto [it, isNew] = m_entriesByName.emplace(data.name, data);
         if (isNew) {
-          it->second.ranges.emplace_back(recordIt, recordEnd);
+          it->second.ranges.emplace_back(recordIt, m_reader.end());
         }
         entryPtr = &it->second;
         if (data.type == "structschema" ||
             data.type == "proto:FileDescriptorProto") {
-          schemaEntries.try_emplace(data.entry, entryPtr,
-                                    std::span<const uint8_t>{});
+          m_schemaEntries.try_emplace(data.entry, entryPtr, recordIt,
+                                      std::span<const uint8_t>{});
         }
         sigEntryAdded(data);
       } else {
@@ -80,46 +165,16 @@ void DataLogReaderThread::ReadMain() {
       } else {
         wpi::print("SetMetadata(INVALID)\n");
       }
-    } else if (record.IsControl()) {
-      wpi::print("Unrecognized control record\n");
     } else {
-      auto it = schemaEntries.find(record.GetEntry());
-      if (it != schemaEntries.end()) {
-        it->second.second = record.GetRaw();
-      }
+      wpi::print("Unrecognized control record\n");
     }
   }
 
-  // build schema databases
-  for (auto&& schemaPair : schemaEntries) {
-    auto name = schemaPair.second.first->name;
-    auto data = schemaPair.second.second;
-    if (data.empty()) {
-      continue;
-    }
-    if (auto strippedName = wpi::remove_prefix(name, "NT:")) {
-      name = *strippedName;
-    }
-    if (auto typeStr = wpi::remove_prefix(name, "/.schema/struct:")) {
-      std::string_view schema{reinterpret_cast<const char*>(data.data()),
-                              data.size()};
-      std::string err;
-      auto desc = m_structDb.Add(*typeStr, schema, &err);
-      if (!desc) {
-        wpi::print("could not decode struct '{}' schema '{}': {}\n", name,
-                   schema, err);
-      }
-    } else if (auto filename = wpi::remove_prefix(name, "/.schema/proto:")) {
-#ifndef NO_PROTOBUF
-      // protobuf descriptor handling
-      if (!m_protoDb.Add(*filename, data)) {
-        wpi::print("could not decode protobuf '{}' filename '{}'\n", name,
-                   *filename);
-      }
-#endif
+  // the schema is the last data record since the schema entry started
+  for (auto&& schemaPair : m_schemaEntries) {
+    auto it = chunk.lastData.find(schemaPair.first);
+    if (it != chunk.lastData.end() && schemaPair.second.start < it->second) {
+      schemaPair.second.data = it->second->GetRaw();
     }
   }
-
-  sigDone();
-  m_done = true;
 }
@@ -182,6 +182,14 @@ bool CollapsingHeader(const char* label, ImGuiTreeNodeFlags flags = 0);
 
 bool TreeNodeEx(const char* label, ImGuiTreeNodeFlags flags = 0);
 
+/**
+ * Like TreeNodeEx(), but for a tree node that isn't visible, so it isn't
+ * drawn. Returns the saved open status; if returning 'true', the ID and
+ * storage stacks are pushed as TreeNodeEx() does and the user must call
+ * TreePop().
+ */
+bool TreeNodeHidden(const char* label, ImGuiTreeNodeFlags flags = 0);
+
 void TreePop();
 
 // push string into the ID stack (will hash string).
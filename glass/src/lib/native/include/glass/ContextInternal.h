@@ -12,14 +12,14 @@
 
 #include <wpi/SmallVector.h>
 #include <wpi/StringMap.h>
+#include <wpi/spinlock.h>
 
 #include "glass/Context.h"
+#include "glass/DataSource.h"
 #include "glass/Storage.h"
 
 namespace glass {
 
-class DataSource;
-
 class Context {
  public:
   Context();
@@ -36,6 +36,9 @@ class Context {
   wpi::StringMap<Storage> storageRoots;
   wpi::StringMap<bool> deviceHidden;
   wpi::StringMap<DataSource*> sources;
+  wpi::spinlock sourceChangesMutex;
+  DataSource::Changes sourceChanges;
+  DataSource::Changes notifyingSourceChanges;
   Storage& sourceNameStorage;
   uint64_t zeroTime = 0;
   bool isPlatformSaveDir = false;
@@ -8,6 +8,7 @@
 
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include <imgui.h>
 #include <wpi/Signal.h>
@@ -37,12 +38,15 @@ class DataSource {
   void SetDigital(bool digital) { m_digital = digital; }
   bool IsDigital() const { return m_digital; }
 
-  void SetValue(double value, int64_t time = 0) {
-    std::scoped_lock lock{m_valueMutex};
-    m_value = value;
-    m_valueTime = time;
-    valueChanged(value, time);
-  }
+  /**
+   * Sets the value. If the value changed, the GUI is woken so it renders the
+   * change even if it's idle. Listeners are notified of the value on the next
+   * call to NotifyChanges().
+   *
+   * @param value value
+   * @param time time of the value
+   */
+  void SetValue(double value, int64_t time = 0);
 
   double GetValue() const {
     std::scoped_lock lock{m_valueMutex};
@@ -71,6 +75,26 @@ class DataSource {
 
   wpi::sig::SignalBase<wpi::spinlock, double, int64_t> valueChanged;
 
+  /**
+   * Values set since the last NotifyChanges(), in the order they were set.
+   * The arrays are parallel; element i of each describes one SetValue() call.
+   * Sources destroyed before the notification are null.
+   */
+  struct Changes {
+    std::vector<DataSource*> sources;
+    std::vector<double> values;
+    std::vector<int64_t> times;
+  };
+
+  /**
+   * Notifies listeners of all values set since the last call. valueChanged is
+   * emitted for each value, then valuesChanged is emitted once with all of
+   * them. This is called once per frame by the GUI main loop.
+   */
+  static void NotifyChanges();
+
+  static wpi::sig::Signal<const Changes&> valuesChanged;
+
   static DataSource* Find(std::string_view id);
 
   static wpi::sig::Signal<const char*, DataSource*> sourceCreated;
@@ -82,6 +106,7 @@ class DataSource {
   mutable wpi::spinlock m_valueMutex;
   double m_value = 0;
   int64_t m_valueTime = 0;
+  bool m_changePending = false;  // protected by context's sourceChangesMutex
 };
 
 }  // namespace glass
@@ -7,6 +7,7 @@
 #include <atomic>
 #include <functional>
 #include <map>
+#include <span>
 #include <string>
 #include <string_view>
 #include <thread>
@@ -89,7 +90,25 @@ class DataLogReaderThread {
   wpi::sig::Signal_mt<> sigDone;
 
  private:
+  // records of part of the log that are needed to build the entries
+  struct Chunk {
+    std::vector<wpi::log::DataLogReader::iterator> controlRecords;
+    // last data record of each entry ID
+    wpi::DenseMap<int, wpi::log::DataLogReader::iterator> lastData;
+  };
+
+  struct SchemaEntry {
+    DataLogReaderEntry* entry;
+    wpi::log::DataLogReader::iterator start;
+    std::span<const uint8_t> data;
+  };
+
   void ReadMain();
+  // may be called on multiple threads at once
+  Chunk ScanChunk(wpi::log::DataLogReader::iterator begin,
+                  wpi::log::DataLogReader::iterator end);
+  // must be called in log order
+  void ProcessChunk(const Chunk& chunk);
 
   wpi::log::DataLogReader m_reader;
   mutable wpi::mutex m_mutex;
@@ -98,6 +117,7 @@ class DataLogReaderThread {
   std::atomic<unsigned int> m_numRecords{0};
   std::map<std::string, DataLogReaderEntry, std::less<>> m_entriesByName;
   wpi::DenseMap<int, DataLogReaderEntry*> m_entriesById;
+  wpi::SmallDenseMap<int, SchemaEntry, 8> m_schemaEntries;
   wpi::StructDescriptorDatabase m_structDb;
 #ifndef NO_PROTOBUF
   wpi::ProtobufMessageDatabase m_protoDb;
@@ -802,15 +802,29 @@ void NetworkTablesModel::ValueSource::UpdateFromValue(
 }
 
 void NetworkTablesModel::Update() {
-  bool updateTree = false;
+  // entries to add to the tree once their topic info is known; new entries
+  // also need to be added to m_sortedEntries
+  std::vector<Entry*> newEntries;
+  std::vector<Entry*> changedEntries;
+  auto addPendingEntries = [&] {
+    for (auto entry : newEntries) {
+      AddSortedEntry(entry);
+      AddTreeEntry(entry);
+    }
+    for (auto entry : changedEntries) {
+      AddTreeEntry(entry);
+    }
+    newEntries.clear();
+    changedEntries.clear();
+  };
+
   for (auto&& event : m_poller.ReadQueue()) {
     if (auto info = event.GetTopicInfo()) {
       auto& entry = m_entries[info->topic];
       if (event.flags & nt::EventFlags::kPublish) {
         if (!entry) {
           entry = std::make_unique<Entry>();
-          m_sortedEntries.emplace_back(entry.get());
-          updateTree = true;
+          newEntries.emplace_back(entry.get());
         }
       }
       if (event.flags & nt::EventFlags::kUnpublish) {
@@ -837,18 +851,25 @@ void NetworkTablesModel::Update() {
             }
           }
         }
-        auto it = std::find(m_sortedEntries.begin(), m_sortedEntries.end(),
-                            entry.get());
-        // will be removed completely below
-        if (it != m_sortedEntries.end()) {
-          *it = nullptr;
+        if (entry) {
+          std::erase(newEntries, entry.get());
+          std::erase(changedEntries, entry.get());
+          if (RemoveSortedEntry(entry.get())) {
+            RemoveTreeEntry(entry.get());
+          }
         }
         m_entries.erase(info->topic);
-        updateTree = true;
         continue;
       }
-      if (event.flags & nt::EventFlags::kProperties) {
-        updateTree = true;
+      if ((event.flags & nt::EventFlags::kProperties) && entry &&
+          std::find(newEntries.begin(), newEntries.end(), entry.get()) ==
+              newEntries.end() &&
+          std::find(changedEntries.begin(), changedEntries.end(),
+                    entry.get()) == changedEntries.end()) {
+        // persistent and retained may have changed; re-add it to the tree
+        // once they're updated
+        RemoveTreeEntry(entry.get());
+        changedEntries.emplace_back(entry.get());
       }
       if (entry) {
         entry->UpdateTopic(std::move(event));
@@ -862,10 +883,8 @@ void NetworkTablesModel::Update() {
             entry->info.type_str == "msgpack") {
           // meta topic handling
           if (entry->info.name == "$clients") {
-            // need to remove deleted entries as UpdateClients() uses GetEntry()
-            if (updateTree) {
-              std::erase(m_sortedEntries, nullptr);
-            }
+            // need to add new entries as UpdateClients() uses GetEntry()
+            addPendingEntries();
             UpdateClients(entry->value.GetRaw());
           } else if (entry->info.name == "$serverpub") {
             m_server.UpdatePublishers(entry->value.GetRaw());
@@ -939,74 +958,124 @@ void NetworkTablesModel::Update() {
     }
   }
 
-  // shortcut common case (updates)
-  if (!updateTree) {
-    return;
-  }
+  addPendingEntries();
+}
 
-  // remove deleted entries
-  std::erase(m_sortedEntries, nullptr);
+void NetworkTablesModel::AddSortedEntry(Entry* entry) {
+  m_sortedEntries.insert(
+      std::upper_bound(m_sortedEntries.begin(), m_sortedEntries.end(),
+                       entry->info.name,
+                       [](const auto& name, const auto& sorted) {
+                         return name < sorted->info.name;
+                       }),
+      entry);
+}
 
-  RebuildTree();
+bool NetworkTablesModel::RemoveSortedEntry(Entry* entry) {
+  auto it = std::lower_bound(
+      m_sortedEntries.begin(), m_sortedEntries.end(), entry->info.name,
+      [](const auto& sorted, const auto& name) {
+        return sorted->info.name < name;
+      });
+  for (; it != m_sortedEntries.end() && (*it)->info.name == entry->info.name;
+       ++it) {
+    if (*it == entry) {
+      m_sortedEntries.erase(it);
+      return true;
+    }
+  }
+  return false;
 }
 
-void NetworkTablesModel::RebuildTree() {
-  // sort by name
-  std::sort(
-      m_sortedEntries.begin(), m_sortedEntries.end(),
-      [](const auto& a, const auto& b) { return a->info.name < b->info.name; });
+void NetworkTablesModel::AddTreeEntry(Entry* entry) {
+  AddTreeEntryImpl(&m_root, ShowAll, entry);
+  AddTreeEntryImpl(&m_persistentRoot, ShowPersistent, entry);
+  AddTreeEntryImpl(&m_retainedRoot, ShowRetained, entry);
+  AddTreeEntryImpl(&m_transitoryRoot, ShowTransitory, entry);
+}
 
-  RebuildTreeImpl(&m_root, ShowAll);
-  RebuildTreeImpl(&m_persistentRoot, ShowPersistent);
-  RebuildTreeImpl(&m_retainedRoot, ShowRetained);
-  RebuildTreeImpl(&m_transitoryRoot, ShowTransitory);
+// Finds the child with the given name, or where to insert it
+static std::vector<NetworkTablesModel::TreeNode>::iterator FindTreeNode(
+    std::vector<NetworkTablesModel::TreeNode>* nodes, std::string_view name) {
+  return std::lower_bound(
+      nodes->begin(), nodes->end(), name,
+      [](const auto& node, std::string_view name) { return node.name < name; });
 }
 
-void NetworkTablesModel::RebuildTreeImpl(std::vector<TreeNode>* tree,
-                                         int category) {
-  tree->clear();
+void NetworkTablesModel::AddTreeEntryImpl(std::vector<TreeNode>* tree,
+                                          int category, Entry* entry) {
+  if (!IsVisible(static_cast<ShowCategory>(category), entry->persistent,
+                 entry->retained)) {
+    return;
+  }
   wpi::SmallVector<std::string_view, 16> parts;
-  for (auto& entry : m_sortedEntries) {
-    if (!IsVisible(static_cast<ShowCategory>(category), entry->persistent,
-                   entry->retained)) {
-      continue;
-    }
-    parts.clear();
-    wpi::split(entry->info.name, parts, '/', -1, false);
+  wpi::split(entry->info.name, parts, '/', -1, false);
 
-    // ignore a raw "/" key
-    if (parts.empty()) {
-      continue;
-    }
+  // ignore a raw "/" key
+  if (parts.empty()) {
+    return;
+  }
 
-    // get to leaf
-    auto nodes = tree;
-    for (auto part : wpi::drop_back(std::span{parts.begin(), parts.end()})) {
-      auto it =
-          std::find_if(nodes->begin(), nodes->end(),
-                       [&](const auto& node) { return node.name == part; });
-      if (it == nodes->end()) {
-        nodes->emplace_back(part);
-        // path is from the beginning of the string to the end of the current
-        // part; this works because part is a reference to the internals of
-        // entry->info.name
-        nodes->back().path.assign(
-            entry->info.name.data(),
-            part.data() + part.size() - entry->info.name.data());
-        it = nodes->end() - 1;
-      }
-      nodes = &it->children;
+  // get to leaf
+  auto nodes = tree;
+  for (auto part : wpi::drop_back(std::span{parts.begin(), parts.end()})) {
+    auto it = FindTreeNode(nodes, part);
+    if (it == nodes->end() || it->name != part) {
+      it = nodes->emplace(it, part);
+      // path is from the beginning of the string to the end of the current
+      // part; this works because part is a reference to the internals of
+      // entry->info.name
+      it->path.assign(entry->info.name.data(),
+                      part.data() + part.size() - entry->info.name.data());
     }
+    nodes = &it->children;
+  }
 
-    auto it = std::find_if(nodes->begin(), nodes->end(), [&](const auto& node) {
-      return node.name == parts.back();
-    });
-    if (it == nodes->end()) {
-      nodes->emplace_back(parts.back());
-      // no need to set path, as it's identical to entry->name
-      it = nodes->end() - 1;
+  auto it = FindTreeNode(nodes, parts.back());
+  if (it == nodes->end() || it->name != parts.back()) {
+    // no need to set path, as it's identical to entry->name
+    it = nodes->emplace(it, parts.back());
+  }
+  it->entry = entry;
+}
+
+// Clears the entry from the node at the path, and removes nodes left with
+// neither an entry nor children. Returns true if the node at the front of the
+// path was removed.
+static bool RemoveTreeNodeEntry(
+    std::vector<NetworkTablesModel::TreeNode>* nodes,
+    std::span<const std::string_view> parts,
+    NetworkTablesModel::Entry* entry) {
+  auto it = FindTreeNode(nodes, parts.front());
+  if (it == nodes->end() || it->name != parts.front()) {
+    return false;
+  }
+  if (parts.size() == 1) {
+    if (it->entry != entry) {
+      return false;
     }
-    it->entry = entry;
+    it->entry = nullptr;
+    // the path is needed if the node stays for its children
+    it->path = entry->info.name;
+  } else if (!RemoveTreeNodeEntry(&it->children, parts.subspan(1), entry)) {
+    return false;
+  }
+  if (it->entry || !it->children.empty()) {
+    return false;
+  }
+  nodes->erase(it);
+  return true;
+}
+
+void NetworkTablesModel::RemoveTreeEntry(Entry* entry) {
+  wpi::SmallVector<std::string_view, 16> parts;
+  wpi::split(entry->info.name, parts, '/', -1, false);
+  if (parts.empty()) {
+    return;
+  }
+  for (auto tree :
+       {&m_root, &m_persistentRoot, &m_retainedRoot, &m_transitoryRoot}) {
+    RemoveTreeNodeEntry(tree, parts, entry);
   }
 }
 
@@ -1030,9 +1099,9 @@ NetworkTablesModel::Entry* NetworkTablesModel::AddEntry(NT_Topic topic) {
     entry = std::make_unique<Entry>();
     entry->info = nt::GetTopicInfo(topic);
     entry->properties = entry->info.GetProperties();
-    m_sortedEntries.emplace_back(entry.get());
+    AddSortedEntry(entry.get());
+    AddTreeEntry(entry.get());
   }
-  RebuildTree();
   return entry.get();
 }
 
@@ -1665,39 +1734,59 @@ static void EmitValueName(DataSource* source, const char* name,
   }
 }
 
+// Starts a table row and its first column. If the row is scrolled out of view,
+// returns false after only giving the row the usual height, so callers can
+// skip drawing it
+static bool NextRowVisible() {
+  ImGui::TableNextRow();
+  ImGui::TableNextColumn();
+  float height = ImGui::GetFrameHeight();
+  if (ImGui::IsRectVisible(ImVec2{1, height})) {
+    return true;
+  }
+  ImGui::Dummy(ImVec2{0, height});
+  return false;
+}
+
 static void EmitValueTree(
     const std::vector<NetworkTablesModel::EntryValueTreeNode>& children,
     NetworkTablesFlags flags) {
   for (auto&& child : children) {
-    ImGui::TableNextRow();
-    ImGui::TableNextColumn();
-    EmitValueName(child.source.get(), child.name.c_str(), child.path.c_str());
+    bool visible = NextRowVisible();
+    if (visible) {
+      EmitValueName(child.source.get(), child.name.c_str(),
+                    child.path.c_str());
+      ImGui::TableNextColumn();
+    }
 
-    ImGui::TableNextColumn();
     if (!child.valueChildren.empty()) {
-      auto pos = ImGui::GetCursorPos();
       char label[128];
       std::string_view ts = child.typeStr;
       bool havePopup = GetHeadingTypeString(&ts);
       wpi::format_to_n_c_str(label, sizeof(label), "{}##v_{}", ts.data(),
                              child.name.c_str());
-      bool valueChildrenOpen =
-          TreeNodeEx(label, ImGuiTreeNodeFlags_SpanFullWidth);
-      if (havePopup) {
-        if (ImGui::IsItemHovered()) {
-          ImGui::BeginTooltip();
-          ImGui::TextUnformatted(child.typeStr.c_str());
-          ImGui::EndTooltip();
+      bool valueChildrenOpen;
+      if (visible) {
+        auto pos = ImGui::GetCursorPos();
+        valueChildrenOpen = TreeNodeEx(label, ImGuiTreeNodeFlags_SpanFullWidth);
+        if (havePopup) {
+          if (ImGui::IsItemHovered()) {
+            ImGui::BeginTooltip();
+            ImGui::TextUnformatted(child.typeStr.c_str());
+            ImGui::EndTooltip();
+          }
         }
+        // make it look like a normal label w/type
+        ImGui::SetCursorPos(pos);
+        ImGui::LabelText(child.valueChildrenMap ? "{...}" : "[...]", "%s", "");
+      } else {
+        valueChildrenOpen = TreeNodeHidden(label);
       }
-      // make it look like a normal label w/type
-      ImGui::SetCursorPos(pos);
-      ImGui::LabelText(child.valueChildrenMap ? "{...}" : "[...]", "%s", "");
       if (valueChildrenOpen) {
         EmitValueTree(child.valueChildren, flags);
         TreePop();
       }
-    } else {
+    } else if (visible) {
       EmitEntryValueReadonly(child, nullptr, flags);
     }
   }
@@ -1711,18 +1800,26 @@ static void EmitEntry(NetworkTablesModel* model,
   }
 
   bool valueChildrenOpen = false;
-  ImGui::TableNextRow();
-  ImGui::TableNextColumn();
+  char label[128];
+  std::string_view ts = entry.info.type_str;
+  bool havePopup = GetHeadingTypeString(&ts);
+  wpi::format_to_n_c_str(label, sizeof(label), "{}##v_{}", ts.data(),
+                         entry.info.name.c_str());
+
+  if (!NextRowVisible()) {
+    // skip drawing, but keep the value tree's IDs and open status
+    if (!entry.valueChildren.empty() && TreeNodeHidden(label)) {
+      EmitValueTree(entry.valueChildren, flags);
+      TreePop();
+    }
+    return;
+  }
+
   EmitValueName(entry.source.get(), name, entry.info.name.c_str());
 
   ImGui::TableNextColumn();
   if (!entry.valueChildren.empty()) {
     auto pos = ImGui::GetCursorPos();
-    char label[128];
-    std::string_view ts = entry.info.type_str;
-    bool havePopup = GetHeadingTypeString(&ts);
-    wpi::format_to_n_c_str(label, sizeof(label), "{}##v_{}", ts.data(),
-                           entry.info.name.c_str());
     valueChildrenOpen =
         TreeNodeEx(label, ImGuiTreeNodeFlags_SpanFullWidth |
                               ImGuiTreeNodeFlags_AllowItemOverlap);
@@ -1843,11 +1940,13 @@ static void EmitTree(NetworkTablesModel* model,
     }
 
     if (!node.children.empty()) {
-      ImGui::TableNextRow();
-      ImGui::TableNextColumn();
-      bool open =
-          TreeNodeEx(node.name.c_str(), ImGuiTreeNodeFlags_SpanFullWidth);
-      EmitParentContextMenu(model, node.path, flags);
+      bool open;
+      if (NextRowVisible()) {
+        open = TreeNodeEx(node.name.c_str(), ImGuiTreeNodeFlags_SpanFullWidth);
+        EmitParentContextMenu(model, node.path, flags);
+      } else {
+        open = TreeNodeHidden(node.name.c_str());
+      }
       if (open) {
         EmitTree(model, node.children, flags, category, false);
         TreePop();
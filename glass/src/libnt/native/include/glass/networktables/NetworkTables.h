@@ -176,8 +176,12 @@ class NetworkTablesModel : public Model {
 #endif
 
  private:
-  void RebuildTree();
-  void RebuildTreeImpl(std::vector<TreeNode>* tree, int category);
+  void AddSortedEntry(Entry* entry);
+  bool RemoveSortedEntry(Entry* entry);
+  void AddTreeEntry(Entry* entry);
+  void AddTreeEntryImpl(std::vector<TreeNode>* tree, int category,
+                        Entry* entry);
+  void RemoveTreeEntry(Entry* entry);
   void UpdateClients(std::span<const uint8_t> data);
 
   nt::NetworkTableInstance m_inst;
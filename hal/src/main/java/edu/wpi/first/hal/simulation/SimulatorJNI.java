@@ -28,6 +28,10 @@ public class SimulatorJNI extends JNIWrapper {
 
   public static native void stepTimingAsync(long delta);
 
+  public static native void setFastTiming(boolean enable);
+
+  public static native boolean isFastTiming();
+
   public static native void resetHandles();
 
   /** Utility class. */
@@ -257,6 +257,38 @@ void HAL_WriteAddressableLEDData(HAL_AddressableLEDHandle handle,
   led->led->strobeLoad(status);
 }
 
+void HAL_WriteAddressableLEDDataRange(HAL_AddressableLEDHandle handle,
+                                      const struct HAL_AddressableLEDData* data,
+                                      int32_t start, int32_t length,
+                                      int32_t* status) {
+  auto led = addressableLEDHandles->Get(handle);
+  if (!led) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+
+  if (start < 0 || length < 0 || start > led->stringLength - length) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    hal::SetLastError(
+        status, fmt::format("Data range [{}, {}) must be within the strip "
+                            "length of {}",
+                            start, start + length, led->stringLength));
+    return;
+  }
+
+  if (length == 0) {
+    return;
+  }
+
+  ConvertAndCopyLEDData(static_cast<HAL_AddressableLEDData*>(led->ledBuffer) +
+                            start,
+                        data, length, led->colorOrder);
+
+  asm("dmb");
+
+  led->led->strobeLoad(status);
+}
+
 void HAL_SetAddressableLEDBitTiming(HAL_AddressableLEDHandle handle,
                                     int32_t highTime0NanoSeconds,
                                     int32_t lowTime0NanoSeconds,
@@ -35,6 +35,21 @@ void InitializeDIO() {
 }
 }  // namespace hal::init
 
+static HAL_Bool GetDIOValue(const tDIO::tDI& currentDIO, int32_t channel) {
+  // Shift 00000001 over channel-1 places.
+  // AND it against the currentDIO
+  // if it == 0, then return false
+  // else return true
+
+  if (channel >= kNumDigitalHeaders + kNumDigitalMXPChannels) {
+    return ((currentDIO.SPIPort >> remapSPIChannel(channel)) & 1) != 0;
+  } else if (channel < kNumDigitalHeaders) {
+    return ((currentDIO.Headers >> channel) & 1) != 0;
+  } else {
+    return ((currentDIO.MXP >> remapMXPChannel(channel)) & 1) != 0;
+  }
+}
+
 extern "C" {
 
 HAL_DigitalHandle HAL_InitializeDIOPort(HAL_PortHandle portHandle,
@@ -286,7 +301,7 @@ void HAL_SetDigitalPWMOutputChannel(HAL_DigitalPWMHandle pwmGenerator,
 
 void HAL_SetDIO(HAL_DigitalHandle dioPortHandle, HAL_Bool value,
                 int32_t* status) {
-  auto port = digitalChannelHandles->Get(dioPortHandle, HAL_HandleEnum::DIO);
+  auto port = digitalChannelHandles->GetRef(dioPortHandle, HAL_HandleEnum::DIO);
   if (port == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -352,7 +367,7 @@ void HAL_SetDIO(HAL_DigitalHandle dioPortHandle, HAL_Bool value,
 
 void HAL_SetDIODirection(HAL_DigitalHandle dioPortHandle, HAL_Bool input,
                          int32_t* status) {
-  auto port = digitalChannelHandles->Get(dioPortHandle, HAL_HandleEnum::DIO);
+  auto port = digitalChannelHandles->GetRef(dioPortHandle, HAL_HandleEnum::DIO);
   if (port == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -389,28 +404,38 @@ void HAL_SetDIODirection(HAL_DigitalHandle dioPortHandle, HAL_Bool input,
 }
 
 HAL_Bool HAL_GetDIO(HAL_DigitalHandle dioPortHandle, int32_t* status) {
-  auto port = digitalChannelHandles->Get(dioPortHandle, HAL_HandleEnum::DIO);
+  auto port = digitalChannelHandles->GetRef(dioPortHandle, HAL_HandleEnum::DIO);
   if (port == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return false;
   }
   tDIO::tDI currentDIO = digitalSystem->readDI(status);
-  // Shift 00000001 over channel-1 places.
-  // AND it against the currentDIO
-  // if it == 0, then return false
-  // else return true
+  return GetDIOValue(currentDIO, port->channel);
+}
 
-  if (port->channel >= kNumDigitalHeaders + kNumDigitalMXPChannels) {
-    return ((currentDIO.SPIPort >> remapSPIChannel(port->channel)) & 1) != 0;
-  } else if (port->channel < kNumDigitalHeaders) {
-    return ((currentDIO.Headers >> port->channel) & 1) != 0;
-  } else {
-    return ((currentDIO.MXP >> remapMXPChannel(port->channel)) & 1) != 0;
+int32_t HAL_GetDIOBulk(const HAL_DigitalHandle* dioPortHandles,
+                       HAL_Bool* values, int32_t count, int32_t* status) {
+  if (count <= 0) {
+    return 0;
+  }
+  tDIO::tDI currentDIO = digitalSystem->readDI(status);
+  if (*status != 0) {
+    return 0;
+  }
+  for (int32_t i = 0; i < count; ++i) {
+    auto port =
+        digitalChannelHandles->GetRef(dioPortHandles[i], HAL_HandleEnum::DIO);
+    if (port == nullptr) {
+      *status = HAL_HANDLE_ERROR;
+      return i;
+    }
+    values[i] = GetDIOValue(currentDIO, port->channel);
   }
+  return count;
 }
 
 HAL_Bool HAL_GetDIODirection(HAL_DigitalHandle dioPortHandle, int32_t* status) {
-  auto port = digitalChannelHandles->Get(dioPortHandle, HAL_HandleEnum::DIO);
+  auto port = digitalChannelHandles->GetRef(dioPortHandle, HAL_HandleEnum::DIO);
   if (port == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return false;
@@ -435,7 +460,7 @@ HAL_Bool HAL_GetDIODirection(HAL_DigitalHandle dioPortHandle, int32_t* status) {
 
 void HAL_Pulse(HAL_DigitalHandle dioPortHandle, double pulseLengthSeconds,
                int32_t* status) {
-  auto port = digitalChannelHandles->Get(dioPortHandle, HAL_HandleEnum::DIO);
+  auto port = digitalChannelHandles->GetRef(dioPortHandle, HAL_HandleEnum::DIO);
   if (port == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -489,7 +514,7 @@ void HAL_PulseMultiple(uint32_t channelMask, double pulseLengthSeconds,
 }
 
 HAL_Bool HAL_IsPulsing(HAL_DigitalHandle dioPortHandle, int32_t* status) {
-  auto port = digitalChannelHandles->Get(dioPortHandle, HAL_HandleEnum::DIO);
+  auto port = digitalChannelHandles->GetRef(dioPortHandle, HAL_HandleEnum::DIO);
   if (port == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return false;
@@ -517,7 +542,7 @@ HAL_Bool HAL_IsAnyPulsing(int32_t* status) {
 
 void HAL_SetFilterSelect(HAL_DigitalHandle dioPortHandle, int32_t filterIndex,
                          int32_t* status) {
-  auto port = digitalChannelHandles->Get(dioPortHandle, HAL_HandleEnum::DIO);
+  auto port = digitalChannelHandles->GetRef(dioPortHandle, HAL_HandleEnum::DIO);
   if (port == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -537,7 +562,7 @@ void HAL_SetFilterSelect(HAL_DigitalHandle dioPortHandle, int32_t filterIndex,
 }
 
 int32_t HAL_GetFilterSelect(HAL_DigitalHandle dioPortHandle, int32_t* status) {
-  auto port = digitalChannelHandles->Get(dioPortHandle, HAL_HandleEnum::DIO);
+  auto port = digitalChannelHandles->GetRef(dioPortHandle, HAL_HandleEnum::DIO);
   if (port == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return 0;
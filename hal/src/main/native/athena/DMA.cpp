@@ -4,11 +4,13 @@
 
 #include "hal/DMA.h"
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstring>
 #include <memory>
 #include <type_traits>
+#include <vector>
 
 #include <wpi/print.h>
 
@@ -40,6 +42,9 @@ struct DMA {
   std::unique_ptr<tDMA> aDMA;
 
   HAL_DMASample captureStore;
+
+  // Staging buffer for HAL_ReadDMASamples
+  std::vector<uint32_t> readBuffer;
 };
 }  // namespace
 
@@ -718,6 +723,18 @@ void* HAL_GetDMADirectPointer(HAL_DMAHandle handle) {
   return dma.get();
 }
 
+// Fills in the sample fields other than the captured data
+static void FillDMASample(const DMA& dma, HAL_DMASample* dmaSample) {
+  uint32_t captureSize = dma.captureStore.captureSize;
+  uint64_t upper_sample = dmaSample->readBuffer[captureSize - 1];
+  uint64_t lower_sample = dmaSample->readBuffer[captureSize - 2];
+  dmaSample->timeStamp = (upper_sample << 32) + lower_sample;
+  dmaSample->triggerChannels = dma.captureStore.triggerChannels;
+  dmaSample->captureSize = captureSize;
+  std::memcpy(dmaSample->channelOffsets, dma.captureStore.channelOffsets,
+              sizeof(dmaSample->channelOffsets));
+}
+
 enum HAL_DMAReadStatus HAL_ReadDMADirect(void* dmaPointer,
                                          HAL_DMASample* dmaSample,
                                          double timeoutSeconds,
@@ -747,18 +764,7 @@ enum HAL_DMAReadStatus HAL_ReadDMADirect(void* dmaPointer,
   *remainingOut = remainingBytes / dma->captureStore.captureSize;
 
   if (*status == 0) {
-    uint64_t upper_sample =
-        dmaSample->readBuffer[dma->captureStore.captureSize - 1];
-    uint64_t lower_sample =
-        dmaSample->readBuffer[dma->captureStore.captureSize - 2];
-    dmaSample->timeStamp = (upper_sample << 32) + lower_sample;
-    if (*status != 0) {
-      return HAL_DMA_ERROR;
-    }
-    dmaSample->triggerChannels = dma->captureStore.triggerChannels;
-    dmaSample->captureSize = dma->captureStore.captureSize;
-    std::memcpy(dmaSample->channelOffsets, dma->captureStore.channelOffsets,
-                sizeof(dmaSample->channelOffsets));
+    FillDMASample(*dma, dmaSample);
     return HAL_DMA_OK;
   } else if (*status == NiFpga_Status_FifoTimeout) {
     *status = 0;
@@ -782,6 +788,72 @@ enum HAL_DMAReadStatus HAL_ReadDMA(HAL_DMAHandle handle,
                            status);
 }
 
+int32_t HAL_ReadDMASamples(HAL_DMAHandle handle, HAL_DMASample* dmaSamples,
+                           int32_t count, double timeoutSeconds,
+                           int32_t* remainingOut, int32_t* status) {
+  *remainingOut = 0;
+  auto dma = dmaHandles->Get(handle);
+  if (!dma) {
+    *status = HAL_HANDLE_ERROR;
+    return 0;
+  }
+
+  if (!dma->manager) {
+    *status = HAL_INVALID_DMA_STATE;
+    return 0;
+  }
+
+  if (count <= 0) {
+    return 0;
+  }
+
+  size_t captureSize = dma->captureStore.captureSize;
+  int32_t numRead = 0;
+
+  // A zero-length read returns the amount of queued data
+  size_t remainingBytes = 0;
+  dma->manager->read(dmaSamples[0].readBuffer, 0, 0, &remainingBytes, status);
+  if (*status != 0) {
+    return 0;
+  }
+
+  if (remainingBytes < captureSize) {
+    // Nothing queued; wait for one sample, like HAL_ReadDMA
+    dma->manager->read(dmaSamples[0].readBuffer, captureSize,
+                       static_cast<uint32_t>(timeoutSeconds * 1000),
+                       &remainingBytes, status);
+    if (*status == NiFpga_Status_FifoTimeout) {
+      *status = 0;
+      return 0;
+    } else if (*status != 0) {
+      return 0;
+    }
+    FillDMASample(*dma, &dmaSamples[0]);
+    numRead = 1;
+  }
+
+  // Read the rest of the queued samples that fit in a single transfer
+  size_t numToRead = (std::min)(remainingBytes / captureSize,
+                                static_cast<size_t>(count - numRead));
+  if (numToRead > 0) {
+    dma->readBuffer.resize(numToRead * captureSize);
+    dma->manager->read(dma->readBuffer.data(), dma->readBuffer.size(), 0,
+                       &remainingBytes, status);
+    if (*status != 0) {
+      return numRead;
+    }
+    for (size_t i = 0; i < numToRead; ++i) {
+      auto dmaSample = &dmaSamples[numRead++];
+      std::memcpy(dmaSample->readBuffer, &dma->readBuffer[i * captureSize],
+                  captureSize * sizeof(uint32_t));
+      FillDMASample(*dma, dmaSample);
+    }
+  }
+
+  *remainingOut = remainingBytes / captureSize;
+  return numRead;
+}
+
 static uint32_t ReadDMAValue(const HAL_DMASample& dma, int valueType, int index,
                              int32_t* status) {
   auto offset = dma.channelOffsets[valueType];
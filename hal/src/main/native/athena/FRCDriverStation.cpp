@@ -119,12 +119,33 @@ void JoystickDataCache::Update() {
 
 static HAL_ControlWord newestControlWord;
 static JoystickDataCache caches[3];
-static JoystickDataCache* currentRead = &caches[0];
+static std::atomic<JoystickDataCache*> currentRead{&caches[0]};
 static JoystickDataCache* currentReadLocal = &caches[0];
 static std::atomic<JoystickDataCache*> currentCache{nullptr};
 static JoystickDataCache* lastGiven = &caches[1];
 static JoystickDataCache* cacheToUpdate = &caches[2];
 
+// Incremented before and after HAL_RefreshDSData() changes currentRead or
+// newestControlWord (so it's odd while they're being changed). Readers copy
+// the data without locking and retry if the sequence changed meanwhile.
+// NewDriverStationData() only writes to a cache after a refresh has moved
+// currentRead away from it, so the sequence also catches those writes.
+static std::atomic<uint32_t> cacheSequence{0};
+
+template <typename F>
+static void ReadCache(F&& read) {
+  for (;;) {
+    uint32_t seq = cacheSequence.load(std::memory_order_acquire);
+    if ((seq & 1) == 0) {
+      read(*currentRead.load(std::memory_order_relaxed));
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (cacheSequence.load(std::memory_order_relaxed) == seq) {
+        return;
+      }
+    }
+  }
+}
+
 static wpi::mutex cacheMutex;
 
 /**
@@ -353,39 +374,36 @@ int32_t HAL_SendConsoleLine(const char* line) {
 }
 
 int32_t HAL_GetControlWord(HAL_ControlWord* controlWord) {
-  std::scoped_lock lock{cacheMutex};
-  *controlWord = newestControlWord;
+  ReadCache([&](auto&) { *controlWord = newestControlWord; });
   return 0;
 }
 
 int32_t HAL_GetJoystickAxes(int32_t joystickNum, HAL_JoystickAxes* axes) {
   CHECK_JOYSTICK_NUMBER(joystickNum);
-  std::scoped_lock lock{cacheMutex};
-  *axes = currentRead->axes[joystickNum];
+  ReadCache([&](auto& cache) { *axes = cache.axes[joystickNum]; });
   return 0;
 }
 
 int32_t HAL_GetJoystickPOVs(int32_t joystickNum, HAL_JoystickPOVs* povs) {
   CHECK_JOYSTICK_NUMBER(joystickNum);
-  std::scoped_lock lock{cacheMutex};
-  *povs = currentRead->povs[joystickNum];
+  ReadCache([&](auto& cache) { *povs = cache.povs[joystickNum]; });
   return 0;
 }
 
 int32_t HAL_GetJoystickButtons(int32_t joystickNum,
                                HAL_JoystickButtons* buttons) {
   CHECK_JOYSTICK_NUMBER(joystickNum);
-  std::scoped_lock lock{cacheMutex};
-  *buttons = currentRead->buttons[joystickNum];
+  ReadCache([&](auto& cache) { *buttons = cache.buttons[joystickNum]; });
   return 0;
 }
 
 void HAL_GetAllJoystickData(HAL_JoystickAxes* axes, HAL_JoystickPOVs* povs,
                             HAL_JoystickButtons* buttons) {
-  std::scoped_lock lock{cacheMutex};
-  std::memcpy(axes, currentRead->axes, sizeof(currentRead->axes));
-  std::memcpy(povs, currentRead->povs, sizeof(currentRead->povs));
-  std::memcpy(buttons, currentRead->buttons, sizeof(currentRead->buttons));
+  ReadCache([&](auto& cache) {
+    std::memcpy(axes, cache.axes, sizeof(cache.axes));
+    std::memcpy(povs, cache.povs, sizeof(cache.povs));
+    std::memcpy(buttons, cache.buttons, sizeof(cache.buttons));
+  });
 }
 
 int32_t HAL_GetJoystickDescriptor(int32_t joystickNum,
@@ -403,8 +421,9 @@ int32_t HAL_GetMatchInfo(HAL_MatchInfo* info) {
 }
 
 HAL_AllianceStationID HAL_GetAllianceStation(int32_t* status) {
-  std::scoped_lock lock{cacheMutex};
-  return currentRead->allianceStation;
+  HAL_AllianceStationID allianceStation;
+  ReadCache([&](auto& cache) { allianceStation = cache.allianceStation; });
+  return allianceStation;
 }
 
 HAL_Bool HAL_GetJoystickIsXbox(int32_t joystickNum) {
@@ -453,8 +472,9 @@ int32_t HAL_SetJoystickOutputs(int32_t joystickNum, int64_t outputs,
 }
 
 double HAL_GetMatchTime(int32_t* status) {
-  std::scoped_lock lock{cacheMutex};
-  return currentRead->matchTime;
+  double matchTime;
+  ReadCache([&](auto& cache) { matchTime = cache.matchTime; });
+  return matchTime;
 }
 
 void HAL_ObserveUserProgramStarting(void) {
@@ -527,10 +547,13 @@ HAL_Bool HAL_RefreshDSData(void) {
   JoystickDataCache* prev;
   {
     std::scoped_lock lock{cacheMutex};
+    cacheSequence.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
     prev = currentCache.exchange(nullptr);
     if (prev != nullptr) {
-      currentRead = prev;
+      currentRead.store(prev, std::memory_order_relaxed);
     }
+    JoystickDataCache* read = currentRead.load(std::memory_order_relaxed);
     // If newest state shows we have a DS attached, just use the
     // control word out of the cache, As it will be the one in sync
     // with the data. If no data has been updated, at this point,
@@ -548,10 +571,10 @@ HAL_Bool HAL_RefreshDSData(void) {
       // Also, when the DS has never been connected the rest of the fields
       // in control word are garbage, so we also need to zero out in that
       // case too
-      std::memset(&currentRead->controlWord, 0,
-                  sizeof(currentRead->controlWord));
+      std::memset(&read->controlWord, 0, sizeof(read->controlWord));
     }
-    newestControlWord = currentRead->controlWord;
+    newestControlWord = read->controlWord;
+    cacheSequence.fetch_add(1, std::memory_order_release);
   }
 
   uint32_t mask = tcpMask.exchange(0);
@@ -121,6 +121,16 @@ int64_t HAL_WaitForMultipleInterrupts(HAL_InterruptHandle interruptHandle,
   return result;
 }
 
+int64_t HAL_GetInterruptMask(HAL_InterruptHandle interruptHandle,
+                             int32_t* status) {
+  auto anInterrupt = interruptHandles->Get(interruptHandle);
+  if (anInterrupt == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return 0;
+  }
+  return anInterrupt->mask;
+}
+
 int64_t HAL_ReadInterruptRisingTimestamp(HAL_InterruptHandle interruptHandle,
                                          int32_t* status) {
   auto anInterrupt = interruptHandles->Get(interruptHandle);
@@ -4,12 +4,13 @@
 
 #include "hal/Notifier.h"
 
+#include <algorithm>
 #include <atomic>
 #include <cstdlib>  // For std::atexit()
 #include <memory>
 #include <thread>
 
-#include <wpi/condition_variable.h>
+#include <wpi/ThreadRegistry.h>
 #include <wpi/mutex.h>
 #include <wpi/print.h>
 
@@ -26,6 +27,11 @@ using namespace hal;
 
 static constexpr int32_t kTimerInterruptNumber = 28;
 
+// Alarms expiring within this many microseconds of the current one are fired
+// together, instead of reprogramming the hardware alarm and taking another
+// interrupt a few microseconds later.
+static constexpr uint64_t kBatchTolerance = 20;
+
 static wpi::mutex notifierMutex;
 static std::unique_ptr<tAlarm> notifierAlarm;
 static std::thread notifierThread;
@@ -37,10 +43,28 @@ namespace {
 
 struct Notifier {
   uint64_t triggerTime = UINT64_MAX;
-  uint64_t triggeredTime = UINT64_MAX;
-  bool active = true;
+  std::atomic<uint64_t> triggeredTime = UINT64_MAX;
+  std::atomic<uint64_t> firedTriggerTime = 0;  // triggerTime that fired
+  std::atomic_bool active = true;
+  std::atomic<uint64_t> lastLatency = 0;
+  std::atomic<uint64_t> maxLatency = 0;
+  // Bumped on every state change the waiter cares about; the waiter blocks on
+  // it directly (a futex on Linux), so the alarm thread doesn't need to take
+  // a lock to wake it.
+  std::atomic<uint32_t> wakeups = 0;
   wpi::mutex mutex;
-  wpi::condition_variable cond;
+
+  void Wake() {
+    wakeups.fetch_add(1);
+    wakeups.notify_all();
+  }
+
+  // Must be called with mutex held.
+  void Stop() {
+    triggerTime = UINT64_MAX;
+    triggeredTime = 0;
+    active = false;
+  }
 };
 
 }  // namespace
@@ -59,11 +83,9 @@ class NotifierHandleContainer
     ForEach([](HAL_NotifierHandle handle, Notifier* notifier) {
       {
         std::scoped_lock lock(notifier->mutex);
-        notifier->triggerTime = UINT64_MAX;
-        notifier->triggeredTime = 0;
-        notifier->active = false;
+        notifier->Stop();
       }
-      notifier->cond.notify_all();  // wake up any waiting threads
+      notifier->Wake();  // wake up any waiting threads
     });
   }
 };
@@ -87,11 +109,15 @@ static void alarmCallback() {
       currentTime = HAL_GetFPGATime(&status);
     }
     std::unique_lock lock(notifier->mutex);
-    if (notifier->triggerTime < currentTime) {
+    if (notifier->triggerTime <= currentTime + kBatchTolerance) {
+      // Never report a time before the requested one; callers schedule the
+      // next alarm relative to it.
+      uint64_t triggerTime = notifier->triggerTime;
       notifier->triggerTime = UINT64_MAX;
-      notifier->triggeredTime = currentTime;
+      notifier->firedTriggerTime = triggerTime;
+      notifier->triggeredTime = (std::max)(currentTime, triggerTime);
       lock.unlock();
-      notifier->cond.notify_all();
+      notifier->Wake();
     } else if (notifier->triggerTime < closestTrigger) {
       closestTrigger = notifier->triggerTime;
     }
@@ -107,6 +133,7 @@ static void alarmCallback() {
 }
 
 static void notifierThreadMain() {
+  wpi::SetCurrentThreadClass(wpi::ThreadClass::kNotifier, "HALNotifier");
   InterruptManager& manager = InterruptManager::GetInstance();
   NiFpga_IrqContext context = manager.GetContext();
   uint32_t mask = 1 << kTimerInterruptNumber;
@@ -209,11 +236,9 @@ void HAL_StopNotifier(HAL_NotifierHandle notifierHandle, int32_t* status) {
 
   {
     std::scoped_lock lock(notifier->mutex);
-    notifier->triggerTime = UINT64_MAX;
-    notifier->triggeredTime = 0;
-    notifier->active = false;
+    notifier->Stop();
   }
-  notifier->cond.notify_all();  // wake up any waiting threads
+  notifier->Wake();  // wake up any waiting threads
 }
 
 void HAL_CleanNotifier(HAL_NotifierHandle notifierHandle) {
@@ -225,11 +250,9 @@ void HAL_CleanNotifier(HAL_NotifierHandle notifierHandle) {
   // Just in case HAL_StopNotifier() wasn't called...
   {
     std::scoped_lock lock(notifier->mutex);
-    notifier->triggerTime = UINT64_MAX;
-    notifier->triggeredTime = 0;
-    notifier->active = false;
+    notifier->Stop();
   }
-  notifier->cond.notify_all();
+  notifier->Wake();
 
   if (notifierRefCount.fetch_sub(1) == 1) {
     // if this was the last notifier, clean up alarm and thread
@@ -299,11 +322,38 @@ uint64_t HAL_WaitForNotifierAlarm(HAL_NotifierHandle notifierHandle,
   if (!notifier) {
     return 0;
   }
-  std::unique_lock lock(notifier->mutex);
-  notifier->cond.wait(lock, [&] {
-    return !notifier->active || notifier->triggeredTime != UINT64_MAX;
-  });
-  return notifier->active ? notifier->triggeredTime : 0;
+  for (;;) {
+    // Read the wakeup count before the state so a wake between the two is
+    // not lost
+    uint32_t wakeups = notifier->wakeups.load();
+    if (!notifier->active) {
+      return 0;
+    }
+    uint64_t triggeredTime = notifier->triggeredTime.load();
+    if (triggeredTime != UINT64_MAX) {
+      uint64_t now = HAL_GetFPGATime(status);
+      uint64_t fired = notifier->firedTriggerTime.load();
+      uint64_t latency = now > fired ? now - fired : 0;
+      notifier->lastLatency = latency;
+      if (latency > notifier->maxLatency) {
+        notifier->maxLatency = latency;
+      }
+      return triggeredTime;
+    }
+    notifier->wakeups.wait(wakeups);
+  }
+}
+
+void HAL_GetNotifierWakeLatency(HAL_NotifierHandle notifierHandle,
+                                uint64_t* lastLatency, uint64_t* maxLatency,
+                                int32_t* status) {
+  auto notifier = notifierHandles->Get(notifierHandle);
+  if (!notifier) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  *lastLatency = notifier->lastLatency;
+  *maxLatency = notifier->maxLatency;
 }
 
 }  // extern "C"
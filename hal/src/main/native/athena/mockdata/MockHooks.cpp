@@ -30,6 +30,12 @@ void HALSIM_StepTiming(uint64_t delta) {}
 
 void HALSIM_StepTimingAsync(uint64_t delta) {}
 
+void HALSIM_SetFastTiming(HAL_Bool enable) {}
+
+HAL_Bool HALSIM_IsFastTiming(void) {
+  return false;
+}
+
 void HALSIM_SetSendError(HALSIM_SendErrorHandler handler) {}
 
 void HALSIM_SetSendConsoleLine(HALSIM_SendConsoleLineHandler handler) {}
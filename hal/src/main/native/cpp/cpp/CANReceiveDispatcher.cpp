@@ -0,0 +1,153 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "hal/cpp/CANReceiveDispatcher.h"
+
+#include <cstring>
+#include <iterator>
+
+using namespace hal;
+
+static constexpr uint32_t kFullMask = 0x1FFFFFFF;
+
+CANReceiveDispatcher::~CANReceiveDispatcher() {
+  if (m_session != 0) {
+    HAL_CAN_CloseStreamSession(m_session);
+  }
+}
+
+void CANReceiveDispatcher::Add(uint32_t messageId, int32_t* status) {
+  std::scoped_lock lock(m_mutex);
+  ++m_queues[messageId & kFullMask].refs;
+  m_empty = false;
+  UpdateSession(status);
+}
+
+void CANReceiveDispatcher::Remove(uint32_t messageId) {
+  std::scoped_lock lock(m_mutex);
+  auto it = m_queues.find(messageId & kFullMask);
+  if (it == m_queues.end() || --it->second.refs > 0) {
+    return;
+  }
+  m_queues.erase(it);
+  m_empty = m_queues.empty();
+  int32_t status = 0;
+  UpdateSession(&status);
+}
+
+bool CANReceiveDispatcher::Receive(uint32_t messageId, bool latest,
+                                   uint8_t* data, uint8_t* dataSize,
+                                   uint32_t* timeStamp, int32_t* status) {
+  if (m_empty) {
+    return false;
+  }
+  std::scoped_lock lock(m_mutex);
+  auto it = m_queues.find(messageId & kFullMask);
+  if (it == m_queues.end()) {
+    return false;
+  }
+  auto& queue = it->second;
+  if (queue.size == 0) {
+    PollLocked(status);
+    if (queue.size == 0) {
+      if (*status == 0) {
+        *status = HAL_ERR_CANSessionMux_MessageNotFound;
+      }
+      return true;
+    }
+  }
+
+  const HAL_CANStreamMessage* frame;
+  if (latest) {
+    frame = &queue.frames[(queue.head + queue.size - 1) % kQueueDepth];
+    queue.size = 0;
+  } else {
+    frame = &queue.frames[queue.head];
+    queue.head = (queue.head + 1) % kQueueDepth;
+    --queue.size;
+  }
+  std::memcpy(data, frame->data, frame->dataSize);
+  *dataSize = frame->dataSize;
+  *timeStamp = frame->timeStamp;
+  *status = 0;
+  return true;
+}
+
+void CANReceiveDispatcher::Poll(int32_t* status) {
+  std::scoped_lock lock(m_mutex);
+  PollLocked(status);
+}
+
+void CANReceiveDispatcher::UpdateSession(int32_t* status) {
+  // The session matches the bits that all dispatched IDs have in common
+  uint32_t id = 0;
+  uint32_t mask = 0;
+  if (!m_queues.empty()) {
+    id = m_queues.begin()->first;
+    uint32_t differing = 0;
+    for (auto&& queue : m_queues) {
+      differing |= queue.first ^ id;
+    }
+    mask = kFullMask & ~differing;
+    id &= mask;
+  }
+  if (m_session != 0 && id == m_sessionId && mask == m_sessionMask) {
+    return;
+  }
+
+  if (m_session != 0) {
+    HAL_CAN_CloseStreamSession(m_session);
+    m_session = 0;
+  }
+  if (m_queues.empty()) {
+    return;
+  }
+  HAL_CAN_OpenStreamSession(&m_session, id, mask, kSessionDepth, status);
+  if (*status != 0) {
+    m_session = 0;
+    return;
+  }
+  m_sessionId = id;
+  m_sessionMask = mask;
+}
+
+void CANReceiveDispatcher::PollLocked(int32_t* status) {
+  if (m_session == 0) {
+    // Retry opening the session if that failed before
+    UpdateSession(status);
+    if (m_session == 0) {
+      return;
+    }
+  }
+
+  HAL_CANStreamMessage messages[32];
+  uint32_t messagesRead;
+  do {
+    messagesRead = 0;
+    HAL_CAN_ReadStreamSession(m_session, messages, std::size(messages),
+                              &messagesRead, status);
+    // Dropped messages aren't an error for the readers
+    if (*status == HAL_ERR_CANSessionMux_SessionOverrun) {
+      *status = 0;
+    }
+    for (uint32_t i = 0; i < messagesRead; ++i) {
+      // Frames of other devices that happen to match the mask are dropped
+      auto it = m_queues.find(messages[i].messageID & kFullMask);
+      if (it == m_queues.end()) {
+        continue;
+      }
+      auto& queue = it->second;
+      if (queue.size == kQueueDepth) {
+        queue.head = (queue.head + 1) % kQueueDepth;  // drop the oldest
+        --queue.size;
+      }
+      queue.frames[(queue.head + queue.size) % kQueueDepth] = messages[i];
+      ++queue.size;
+    }
+  } while (*status == 0 && messagesRead == std::size(messages));
+
+  if (*status == HAL_ERR_CANSessionMux_MessageNotFound) {
+    *status = 0;
+  }
+}
@@ -0,0 +1,94 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "hal/handles/HandleEpoch.h"
+
+#include <stdint.h>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace {
+// Per-thread read state. epoch is the global epoch when the outermost read
+// started, or 0 when not reading.
+struct ReaderRecord {
+  ReaderRecord();
+  ~ReaderRecord();
+
+  std::atomic<uint64_t> epoch{0};
+  int depth = 0;
+  ReaderRecord* prev = nullptr;
+  ReaderRecord* next = nullptr;
+};
+}  // namespace
+
+static std::atomic<uint64_t> gEpoch{1};
+// protects the reader list
+static std::mutex gReadersMutex;
+static ReaderRecord* gReaders = nullptr;
+
+ReaderRecord::ReaderRecord() {
+  std::scoped_lock lock{gReadersMutex};
+  next = gReaders;
+  if (next) {
+    next->prev = this;
+  }
+  gReaders = this;
+}
+
+ReaderRecord::~ReaderRecord() {
+  std::scoped_lock lock{gReadersMutex};
+  if (prev) {
+    prev->next = next;
+  } else {
+    gReaders = next;
+  }
+  if (next) {
+    next->prev = prev;
+  }
+}
+
+static ReaderRecord& GetReaderRecord() {
+  static thread_local ReaderRecord record;
+  return record;
+}
+
+void hal::detail::EnterHandleRead() {
+  auto& record = GetReaderRecord();
+  if (record.depth++ == 0) {
+    record.epoch.store(gEpoch.load(std::memory_order_relaxed),
+                       std::memory_order_relaxed);
+    // order the epoch store before the pointer load; pairs with the fence in
+    // SynchronizeHandleReaders()
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+}
+
+void hal::detail::ExitHandleRead() {
+  auto& record = GetReaderRecord();
+  if (--record.depth == 0) {
+    record.epoch.store(0, std::memory_order_release);
+  }
+}
+
+void hal::SynchronizeHandleReaders() {
+  // order the pointer unpublish before the epoch checks
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  uint64_t epoch = gEpoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+  auto self = &GetReaderRecord();
+  std::scoped_lock lock{gReadersMutex};
+  for (auto record = gReaders; record; record = record->next) {
+    if (record == self) {
+      continue;
+    }
+    for (;;) {
+      uint64_t readerEpoch = record->epoch.load(std::memory_order_acquire);
+      if (readerEpoch == 0 || readerEpoch >= epoch) {
+        break;
+      }
+      std::this_thread::yield();
+    }
+  }
+}
@@ -253,6 +253,30 @@ Java_edu_wpi_first_hal_simulation_SimulatorJNI_stepTimingAsync
   HALSIM_StepTimingAsync(delta);
 }
 
+/*
+ * Class:     edu_wpi_first_hal_simulation_SimulatorJNI
+ * Method:    setFastTiming
+ * Signature: (Z)V
+ */
+JNIEXPORT void JNICALL
+Java_edu_wpi_first_hal_simulation_SimulatorJNI_setFastTiming
+  (JNIEnv*, jclass, jboolean enable)
+{
+  HALSIM_SetFastTiming(enable);
+}
+
+/*
+ * Class:     edu_wpi_first_hal_simulation_SimulatorJNI
+ * Method:    isFastTiming
+ * Signature: ()Z
+ */
+JNIEXPORT jboolean JNICALL
+Java_edu_wpi_first_hal_simulation_SimulatorJNI_isFastTiming
+  (JNIEnv*, jclass)
+{
+  return HALSIM_IsFastTiming();
+}
+
 /*
  * Class:     edu_wpi_first_hal_simulation_SimulatorJNI
  * Method:    resetHandles
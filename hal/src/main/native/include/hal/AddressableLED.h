@@ -85,6 +85,25 @@ void HAL_WriteAddressableLEDData(HAL_AddressableLEDHandle handle,
                                  const struct HAL_AddressableLEDData* data,
                                  int32_t length, int32_t* status);
 
+/**
+ * Sets the led output data for a range of the strip, leaving the rest of the
+ * strip unchanged.
+ *
+ * <p>Only the given range is converted and copied to the output buffer, so
+ * updating a small part of a long strip is cheaper than rewriting all of it.
+ * If the output is enabled, this will start writing the next data cycle.
+ *
+ * @param[in] handle the Addressable LED handle
+ * @param[in] data the buffer to write
+ * @param[in] start the index of the first LED to write
+ * @param[in] length the number of LEDs to write
+ * @param[out] status the error code, or 0 for success
+ */
+void HAL_WriteAddressableLEDDataRange(HAL_AddressableLEDHandle handle,
+                                      const struct HAL_AddressableLEDData* data,
+                                      int32_t start, int32_t length,
+                                      int32_t* status);
+
 /**
  * Sets the bit timing.
  *
@@ -65,6 +65,20 @@ void HAL_CleanCAN(HAL_CANHandle handle);
 void HAL_WriteCANPacket(HAL_CANHandle handle, const uint8_t* data,
                         int32_t length, int32_t apiId, int32_t* status);
 
+/**
+ * Writes packets to CAN devices.
+ *
+ * This is equivalent to calling HAL_WriteCANPacket for each packet in order,
+ * but with a single call. Writing stops at the first packet that fails.
+ *
+ * @param[in] packets the packets to write
+ * @param[in] count   the number of packets
+ * @param[out] status Error status variable. 0 on success.
+ * @return the number of packets written
+ */
+int32_t HAL_WriteCANPackets(const struct HAL_CANPacket* packets, int32_t count,
+                            int32_t* status);
+
 /**
  * Writes a repeating packet to the CAN device with a specific ID.
  *
@@ -128,6 +142,26 @@ void HAL_ReadCANPacketNew(HAL_CANHandle handle, int32_t apiId, uint8_t* data,
                           int32_t* length, uint64_t* receivedTimestamp,
                           int32_t* status);
 
+/**
+ * Reads the oldest CAN packet not yet read.
+ *
+ * For an API ID routed through the CAN receive dispatcher (see
+ * HAL_StartCANReceiveDispatch), this returns each queued packet in the order
+ * received, rather than only the newest one like HAL_ReadCANPacketNew. For
+ * other API IDs this is the same as HAL_ReadCANPacketNew.
+ *
+ * @param[in] handle             the CAN handle
+ * @param[in] apiId              the ID to read (0-1023)
+ * @param[out] data              the packet data (8 bytes)
+ * @param[out] length            the received length (0-8 bytes)
+ * @param[out] receivedTimestamp the packet received timestamp in ms (based off
+ *                               of CLOCK_MONOTONIC)
+ * @param[out] status            Error status variable. 0 on success.
+ */
+void HAL_ReadCANPacketQueued(HAL_CANHandle handle, int32_t apiId, uint8_t* data,
+                             int32_t* length, uint64_t* receivedTimestamp,
+                             int32_t* status);
+
 /**
  * Reads a CAN packet. The will continuously return the last packet received,
  * without accounting for packet age.
@@ -163,6 +197,47 @@ void HAL_ReadCANPacketTimeout(HAL_CANHandle handle, int32_t apiId,
                               uint64_t* receivedTimestamp, int32_t timeoutMs,
                               int32_t* status);
 
+/**
+ * Routes received packets for an API ID of a CAN device through the shared
+ * CAN receive dispatcher.
+ *
+ * The dispatcher receives the packets of all routed API IDs (of any device)
+ * with a single CAN stream session and queues them per API ID. Reads of a
+ * routed API ID take packets from its queue, and only read the stream session
+ * when the queue is empty, so reading many devices each loop costs a few
+ * stream reads rather than one receive call per read. The read functions keep
+ * their behavior, except that they return the newest queued packet (clearing
+ * the queue), which may not be the newest one received if the stream session
+ * hasn't been read since. HAL_PollCANReceiveDispatch can be called at the
+ * start of each loop to get the newest packets. HAL_ReadCANPacketQueued
+ * returns the queued packets in order instead.
+ *
+ * @param[in] handle the CAN handle
+ * @param[in] apiId  the ID to route (0-1023)
+ * @param[out] status Error status variable. 0 on success.
+ */
+void HAL_StartCANReceiveDispatch(HAL_CANHandle handle, int32_t apiId,
+                                 int32_t* status);
+
+/**
+ * Stops routing received packets for an API ID of a CAN device through the
+ * shared CAN receive dispatcher.
+ *
+ * @param[in] handle the CAN handle
+ * @param[in] apiId  the ID to stop routing (0-1023)
+ * @param[out] status Error status variable. 0 on success.
+ */
+void HAL_StopCANReceiveDispatch(HAL_CANHandle handle, int32_t apiId,
+                                int32_t* status);
+
+/**
+ * Reads all pending packets from the CAN receive dispatcher's stream session
+ * into its queues.
+ *
+ * @param[out] status Error status variable. 0 on success.
+ */
+void HAL_PollCANReceiveDispatch(int32_t* status);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -91,4 +91,18 @@ HAL_ENUM(HAL_CANManufacturer) {
   /// Vivid-Hosting.
   HAL_CAN_Man_kVividHosting = 16
 };
+
+/**
+ * A packet to write to a CAN device with HAL_WriteCANPackets.
+ */
+struct HAL_CANPacket {
+  /** The CAN handle */
+  HAL_CANHandle handle;
+  /** The ID to write (0-1023) */
+  int32_t apiId;
+  /** The data to write */
+  uint8_t data[8];
+  /** The length of data (0-8) */
+  int32_t length;
+};
 /** @} */
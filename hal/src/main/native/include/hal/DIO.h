@@ -143,6 +143,22 @@ void HAL_SetDIODirection(HAL_DigitalHandle dioPortHandle, HAL_Bool input,
  */
 HAL_Bool HAL_GetDIO(HAL_DigitalHandle dioPortHandle, int32_t* status);
 
+/**
+ * Reads the digital values of multiple DIO channels.
+ *
+ * This is equivalent to calling HAL_GetDIO for each channel, but reads the
+ * FPGA input register only once, so all values are from the same instant.
+ * Reading stops at the first invalid handle.
+ *
+ * @param[in] dioPortHandles the digital port handles
+ * @param[out] values        the states of the channels (count elements)
+ * @param[in] count          the number of channels
+ * @param[out] status        Error status variable. 0 on success.
+ * @return the number of channels read
+ */
+int32_t HAL_GetDIOBulk(const HAL_DigitalHandle* dioPortHandles,
+                       HAL_Bool* values, int32_t count, int32_t* status);
+
 /**
  * Reads the direction of a DIO channel.
  *
@@ -317,6 +317,26 @@ enum HAL_DMAReadStatus HAL_ReadDMA(HAL_DMAHandle handle,
                                    double timeoutSeconds, int32_t* remainingOut,
                                    int32_t* status);
 
+/**
+ * Reads multiple DMA samples from the queue.
+ *
+ * If no samples are queued, waits for one as HAL_ReadDMA does. Then reads as
+ * many of the already queued samples as fit in the array with a single FPGA
+ * transfer, rather than one transfer per sample.
+ *
+ * @param[in] handle         the dma handle
+ * @param[in] dmaSamples     the array of sample objects to place data into
+ * @param[in] count          the number of sample objects in the array
+ * @param[in] timeoutSeconds the time to wait for data to be queued before
+ *                           timing out
+ * @param[out] remainingOut  the number of samples remaining in the queue
+ * @param[out] status        Error status variable. 0 on success.
+ * @return the number of samples read; 0 on timeout or error
+ */
+int32_t HAL_ReadDMASamples(HAL_DMAHandle handle, HAL_DMASample* dmaSamples,
+                           int32_t count, double timeoutSeconds,
+                           int32_t* remainingOut, int32_t* status);
+
 // The following are helper functions for reading data from samples
 
 /**
@@ -51,6 +51,10 @@ int64_t HAL_WaitForInterrupt(HAL_InterruptHandle interruptHandle,
 /**
  * Waits for any interrupt covered by the mask to occur.
  *
+ * The mask may cover other interrupts than interruptHandle; combine the
+ * results of HAL_GetInterruptMask() to wait for several interrupts at once.
+ * Only one thread at a time may wait for each interrupt.
+ *
  * @param[in] interruptHandle the interrupt handle to use for the context
  * @param[in] mask            the mask of interrupts to wait for
  * @param[in] timeout         timeout in seconds
@@ -63,6 +67,18 @@ int64_t HAL_WaitForMultipleInterrupts(HAL_InterruptHandle interruptHandle,
                                       int64_t mask, double timeout,
                                       HAL_Bool ignorePrevious, int32_t* status);
 
+/**
+ * Gets the bits an interrupt sets in the mask returned by
+ * HAL_WaitForInterrupt() and HAL_WaitForMultipleInterrupts(). The rising edge
+ * bit is in the low byte and the falling edge bit is in the second byte.
+ *
+ * @param[in] interruptHandle the interrupt handle
+ * @param[out] status         Error status variable. 0 on success.
+ * @return the mask of the interrupt
+ */
+int64_t HAL_GetInterruptMask(HAL_InterruptHandle interruptHandle,
+                             int32_t* status);
+
 /**
  * Returns the timestamp for the rising interrupt that occurred most recently.
  *
@@ -119,6 +119,21 @@ WPI_NODISCARD
 uint64_t HAL_WaitForNotifierAlarm(HAL_NotifierHandle notifierHandle,
                                   int32_t* status);
 
+/**
+ * Gets how late the notifier's waiting thread woke up after its alarm time.
+ *
+ * The latency is measured when HAL_WaitForNotifierAlarm returns for an alarm,
+ * as the time elapsed since the requested trigger time.
+ *
+ * @param[in] notifierHandle the notifier handle
+ * @param[out] lastLatency   the latency of the last alarm, in microseconds
+ * @param[out] maxLatency    the largest latency seen so far, in microseconds
+ * @param[out] status        Error status variable. 0 on success.
+ */
+void HAL_GetNotifierWakeLatency(HAL_NotifierHandle notifierHandle,
+                                uint64_t* lastLatency, uint64_t* maxLatency,
+                                int32_t* status);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -128,6 +128,22 @@ void HAL_SetPWMPulseTimeMicroseconds(HAL_DigitalHandle pwmPortHandle,
 void HAL_SetPWMSpeed(HAL_DigitalHandle pwmPortHandle, double speed,
                      int32_t* status);
 
+/**
+ * Sets multiple PWM channels to the desired scaled values.
+ *
+ * This is equivalent to calling HAL_SetPWMSpeed for each channel in order,
+ * but with a single call. Setting stops at the first channel that fails.
+ *
+ * @param[in] pwmPortHandles the PWM handles
+ * @param[in] speeds         the scaled PWM values to set (count elements)
+ * @param[in] count          the number of channels
+ * @param[out] status        Error status variable. 0 on success.
+ * @return the number of channels set
+ */
+int32_t HAL_SetPWMSpeedBulk(const HAL_DigitalHandle* pwmPortHandles,
+                            const double* speeds, int32_t count,
+                            int32_t* status);
+
 /**
  * Sets a PWM channel to the desired position value.
  *
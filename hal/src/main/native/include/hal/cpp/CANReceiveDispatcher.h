@@ -0,0 +1,102 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <array>
+#include <atomic>
+
+#include <wpi/DenseMap.h>
+#include <wpi/mutex.h>
+
+#include "hal/CAN.h"
+
+namespace hal {
+
+/**
+ * Receives CAN frames for a set of message IDs with a single CAN stream
+ * session, and demultiplexes them into a small queue per message ID.
+ *
+ * Reading a message ID takes a frame from its queue, and only reads the
+ * stream session when the queue is empty, so one stream read serves the
+ * reads of all message IDs whose frames arrived in the meantime, rather than
+ * each read being a separate receive call.
+ */
+class CANReceiveDispatcher {
+ public:
+  /** Number of frames queued per message ID; older frames are dropped. */
+  static constexpr size_t kQueueDepth = 8;
+
+  /** Depth of the stream session shared by all message IDs. */
+  static constexpr uint32_t kSessionDepth = 256;
+
+  CANReceiveDispatcher() = default;
+  CANReceiveDispatcher(const CANReceiveDispatcher&) = delete;
+  CANReceiveDispatcher& operator=(const CANReceiveDispatcher&) = delete;
+  ~CANReceiveDispatcher();
+
+  /**
+   * Starts dispatching a message ID. Each call must be matched by a call to
+   * Remove().
+   *
+   * @param[in] messageId the full (29 bit) message ID
+   * @param[out] status   Error status variable. 0 on success.
+   */
+  void Add(uint32_t messageId, int32_t* status);
+
+  /**
+   * Stops dispatching a message ID.
+   *
+   * @param[in] messageId the full (29 bit) message ID
+   */
+  void Remove(uint32_t messageId);
+
+  /**
+   * Receives a frame for a message ID, if it is dispatched.
+   *
+   * Gets the oldest queued frame (or the newest, discarding the rest, if
+   * latest is true), reading the stream session first if there are none.
+   * Sets status to HAL_ERR_CANSessionMux_MessageNotFound if there is still no
+   * frame, like HAL_CAN_ReceiveMessage().
+   *
+   * @param[in] messageId the full (29 bit) message ID
+   * @param[in] latest    get the newest frame rather than the oldest
+   * @param[out] data      data output (8 bytes)
+   * @param[out] dataSize  data length (0-8 bytes)
+   * @param[out] timeStamp the frame received timestamp
+   * @param[out] status    Error status variable. 0 on success.
+   * @return false if messageId is not dispatched (outputs are not changed)
+   */
+  bool Receive(uint32_t messageId, bool latest, uint8_t* data,
+               uint8_t* dataSize, uint32_t* timeStamp, int32_t* status);
+
+  /**
+   * Reads all frames from the stream session into the queues.
+   *
+   * @param[out] status Error status variable. 0 on success.
+   */
+  void Poll(int32_t* status);
+
+ private:
+  struct Queue {
+    std::array<HAL_CANStreamMessage, kQueueDepth> frames;
+    size_t head = 0;
+    size_t size = 0;
+    int refs = 0;
+  };
+
+  void UpdateSession(int32_t* status);
+  void PollLocked(int32_t* status);
+
+  wpi::mutex m_mutex;
+  wpi::DenseMap<uint32_t, Queue> m_queues;
+  std::atomic_bool m_empty{true};  // m_queues.empty(), for a lock-free check
+  uint32_t m_session = 0;
+  uint32_t m_sessionId = 0;
+  uint32_t m_sessionMask = 0;
+};
+
+}  // namespace hal
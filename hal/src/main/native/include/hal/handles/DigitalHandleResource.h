@@ -7,12 +7,15 @@
 #include <stdint.h>
 
 #include <array>
+#include <atomic>
 #include <memory>
+#include <utility>
 
 #include <wpi/mutex.h>
 
 #include "hal/Errors.h"
 #include "hal/Types.h"
+#include "hal/handles/HandleEpoch.h"
 #include "hal/handles/HandlesInternal.h"
 
 namespace hal {
@@ -44,11 +47,14 @@ class DigitalHandleResource : public HandleBase {
     return getHandleTypedIndex(handle, enumValue, m_version);
   }
   std::shared_ptr<TStruct> Get(THandle handle, HAL_HandleEnum enumValue);
+  // lock-free version of Get(); see HandleEpoch.h
+  HandleRef<TStruct> GetRef(THandle handle, HAL_HandleEnum enumValue);
   void Free(THandle handle, HAL_HandleEnum enumValue);
   void ResetHandles() override;
 
  private:
   std::array<std::shared_ptr<TStruct>, size> m_structures;
+  std::array<std::atomic<TStruct*>, size> m_pointers{};
   std::array<wpi::mutex, size> m_handleMutexes;
 };
 
@@ -70,6 +76,7 @@ DigitalHandleResource<THandle, TStruct, size>::Allocate(
     return m_structures[index];
   }
   m_structures[index] = std::make_shared<TStruct>();
+  m_pointers[index].store(m_structures[index].get(), std::memory_order_release);
   *handle =
       static_cast<THandle>(hal::createHandle(index, enumValue, m_version));
   *status = HAL_SUCCESS;
@@ -90,6 +97,17 @@ std::shared_ptr<TStruct> DigitalHandleResource<THandle, TStruct, size>::Get(
   return m_structures[index];
 }
 
+template <typename THandle, typename TStruct, int16_t size>
+HandleRef<TStruct> DigitalHandleResource<THandle, TStruct, size>::GetRef(
+    THandle handle, HAL_HandleEnum enumValue) {
+  // get handle index, and fail early if index out of range or wrong handle
+  int16_t index = GetIndex(handle, enumValue);
+  if (index < 0 || index >= size) {
+    return {};
+  }
+  return HandleRef<TStruct>{m_pointers[index]};
+}
+
 template <typename THandle, typename TStruct, int16_t size>
 void DigitalHandleResource<THandle, TStruct, size>::Free(
     THandle handle, HAL_HandleEnum enumValue) {
@@ -99,12 +117,24 @@ void DigitalHandleResource<THandle, TStruct, size>::Free(
     return;
   }
   // lock and deallocated handle
-  std::scoped_lock lock(m_handleMutexes[index]);
-  m_structures[index].reset();
+  std::shared_ptr<TStruct> structure;
+  {
+    std::scoped_lock lock(m_handleMutexes[index]);
+    m_pointers[index].store(nullptr);
+    structure = std::move(m_structures[index]);
+  }
+  // wait for lock-free readers before destroying
+  if (structure) {
+    SynchronizeHandleReaders();
+  }
 }
 
 template <typename THandle, typename TStruct, int16_t size>
 void DigitalHandleResource<THandle, TStruct, size>::ResetHandles() {
+  for (auto&& pointer : m_pointers) {
+    pointer.store(nullptr);
+  }
+  SynchronizeHandleReaders();
   for (int i = 0; i < size; i++) {
     std::scoped_lock lock(m_handleMutexes[i]);
     m_structures[i].reset();
@@ -0,0 +1,83 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+/* Lock-free handle lookup
+ *
+ * Handle resources publish a raw pointer to each allocated structure in
+ * addition to the owning std::shared_ptr. GetRef() reads the raw pointer
+ * without taking a lock or touching the reference count, and marks the
+ * calling thread as reading for as long as the returned HandleRef lives.
+ * Free() unpublishes the pointer and then calls SynchronizeHandleReaders(),
+ * which waits for every thread that might still hold the old pointer to
+ * finish, before the structure can be destroyed.
+ *
+ * As Free() waits for readers, a HandleRef must only be held briefly: never
+ * block (e.g. wait on a condition variable or for another thread's Free())
+ * while holding one. Use Get() for those cases.
+ */
+
+namespace hal {
+
+namespace detail {
+void EnterHandleRead();
+void ExitHandleRead();
+}  // namespace detail
+
+/**
+ * Waits until every other thread that was reading a handle resource when this
+ * was called has dropped its HandleRef. Called by the handle resources after
+ * unpublishing a structure and before destroying it.
+ */
+void SynchronizeHandleReaders();
+
+/**
+ * Non-owning reference to a handle resource structure, returned by the
+ * resources' GetRef(). The structure is guaranteed to stay alive until the
+ * reference is destroyed.
+ *
+ * @tparam T The struct type
+ */
+template <typename T>
+class HandleRef {
+ public:
+  HandleRef() = default;
+
+  explicit HandleRef(const std::atomic<T*>& ptr) {
+    detail::EnterHandleRead();
+    m_ptr = ptr.load(std::memory_order_acquire);
+    if (!m_ptr) {
+      detail::ExitHandleRead();
+    }
+  }
+
+  HandleRef(HandleRef&& rhs) noexcept : m_ptr{std::exchange(rhs.m_ptr, {})} {}
+  HandleRef& operator=(HandleRef&& rhs) noexcept {
+    std::swap(m_ptr, rhs.m_ptr);
+    return *this;
+  }
+
+  ~HandleRef() {
+    if (m_ptr) {
+      detail::ExitHandleRead();
+    }
+  }
+
+  T* get() const { return m_ptr; }
+  T& operator*() const { return *m_ptr; }
+  T* operator->() const { return m_ptr; }
+
+  explicit operator bool() const { return m_ptr != nullptr; }
+  bool operator==(std::nullptr_t) const { return m_ptr == nullptr; }
+
+ private:
+  T* m_ptr = nullptr;
+};
+
+}  // namespace hal
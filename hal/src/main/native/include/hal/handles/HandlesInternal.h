@@ -35,7 +35,7 @@ class HandleBase {
   static void ResetGlobalHandles();
 
  protected:
-  int16_t m_version;
+  int16_t m_version = 0;
 };
 
 constexpr int16_t InvalidHandleIndex = -1;
@@ -7,12 +7,15 @@
 #include <stdint.h>
 
 #include <array>
+#include <atomic>
 #include <memory>
+#include <utility>
 
 #include <wpi/mutex.h>
 
 #include "hal/Errors.h"
 #include "hal/Types.h"
+#include "hal/handles/HandleEpoch.h"
 #include "hal/handles/HandlesInternal.h"
 
 namespace hal {
@@ -45,11 +48,14 @@ class IndexedHandleResource : public HandleBase {
     return getHandleTypedIndex(handle, enumValue, m_version);
   }
   std::shared_ptr<TStruct> Get(THandle handle);
+  // lock-free version of Get(); see HandleEpoch.h
+  HandleRef<TStruct> GetRef(THandle handle);
   void Free(THandle handle);
   void ResetHandles() override;
 
  private:
   std::array<std::shared_ptr<TStruct>, size> m_structures;
+  std::array<std::atomic<TStruct*>, size> m_pointers{};
   std::array<wpi::mutex, size> m_handleMutexes;
 };
 
@@ -72,6 +78,7 @@ IndexedHandleResource<THandle, TStruct, size, enumValue>::Allocate(
     return m_structures[index];
   }
   m_structures[index] = std::make_shared<TStruct>();
+  m_pointers[index].store(m_structures[index].get(), std::memory_order_release);
   *handle =
       static_cast<THandle>(hal::createHandle(index, enumValue, m_version));
   *status = HAL_SUCCESS;
@@ -93,6 +100,19 @@ IndexedHandleResource<THandle, TStruct, size, enumValue>::Get(THandle handle) {
   return m_structures[index];
 }
 
+template <typename THandle, typename TStruct, int16_t size,
+          HAL_HandleEnum enumValue>
+HandleRef<TStruct>
+IndexedHandleResource<THandle, TStruct, size, enumValue>::GetRef(
+    THandle handle) {
+  // get handle index, and fail early if index out of range or wrong handle
+  int16_t index = GetIndex(handle);
+  if (index < 0 || index >= size) {
+    return {};
+  }
+  return HandleRef<TStruct>{m_pointers[index]};
+}
+
 template <typename THandle, typename TStruct, int16_t size,
           HAL_HandleEnum enumValue>
 void IndexedHandleResource<THandle, TStruct, size, enumValue>::Free(
@@ -103,13 +123,25 @@ void IndexedHandleResource<THandle, TStruct, size, enumValue>::Free(
     return;
   }
   // lock and deallocated handle
-  std::scoped_lock lock(m_handleMutexes[index]);
-  m_structures[index].reset();
+  std::shared_ptr<TStruct> structure;
+  {
+    std::scoped_lock lock(m_handleMutexes[index]);
+    m_pointers[index].store(nullptr);
+    structure = std::move(m_structures[index]);
+  }
+  // wait for lock-free readers before destroying
+  if (structure) {
+    SynchronizeHandleReaders();
+  }
 }
 
 template <typename THandle, typename TStruct, int16_t size,
           HAL_HandleEnum enumValue>
 void IndexedHandleResource<THandle, TStruct, size, enumValue>::ResetHandles() {
+  for (auto&& pointer : m_pointers) {
+    pointer.store(nullptr);
+  }
+  SynchronizeHandleReaders();
   for (int i = 0; i < size; i++) {
     std::scoped_lock lock(m_handleMutexes[i]);
     m_structures[i].reset();
@@ -10,6 +10,7 @@
 #include <memory>
 
 #include <wpi/mutex.h>
+#include <wpi/profiled_mutex.h>
 
 #include "hal/Types.h"
 #include "hal/handles/HandlesInternal.h"
@@ -49,7 +50,7 @@ class LimitedClassedHandleResource : public HandleBase {
  private:
   std::array<std::shared_ptr<TStruct>, size> m_structures;
   std::array<wpi::mutex, size> m_handleMutexes;
-  wpi::mutex m_allocateMutex;
+  wpi::profiled_mutex m_allocateMutex{"HAL.LimitedClassedHandleResource"};
 };
 
 template <typename THandle, typename TStruct, int16_t size,
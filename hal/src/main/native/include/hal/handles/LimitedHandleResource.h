@@ -7,10 +7,14 @@
 #include <stdint.h>
 
 #include <array>
+#include <atomic>
 #include <memory>
+#include <utility>
 
 #include <wpi/mutex.h>
+#include <wpi/profiled_mutex.h>
 
+#include "HandleEpoch.h"
 #include "HandlesInternal.h"
 #include "hal/Types.h"
 
@@ -41,13 +45,16 @@ class LimitedHandleResource : public HandleBase {
     return getHandleTypedIndex(handle, enumValue, m_version);
   }
   std::shared_ptr<TStruct> Get(THandle handle);
+  // lock-free version of Get(); see HandleEpoch.h
+  HandleRef<TStruct> GetRef(THandle handle);
   void Free(THandle handle);
   void ResetHandles() override;
 
  private:
   std::array<std::shared_ptr<TStruct>, size> m_structures;
+  std::array<std::atomic<TStruct*>, size> m_pointers{};
   std::array<wpi::mutex, size> m_handleMutexes;
-  wpi::mutex m_allocateMutex;
+  wpi::profiled_mutex m_allocateMutex{"HAL.LimitedHandleResource"};
 };
 
 template <typename THandle, typename TStruct, int16_t size,
@@ -61,6 +68,7 @@ THandle LimitedHandleResource<THandle, TStruct, size, enumValue>::Allocate() {
       // and allocate it.
       std::scoped_lock lock(m_handleMutexes[i]);
       m_structures[i] = std::make_shared<TStruct>();
+      m_pointers[i].store(m_structures[i].get(), std::memory_order_release);
       return static_cast<THandle>(createHandle(i, enumValue, m_version));
     }
   }
@@ -82,6 +90,19 @@ LimitedHandleResource<THandle, TStruct, size, enumValue>::Get(THandle handle) {
   return m_structures[index];
 }
 
+template <typename THandle, typename TStruct, int16_t size,
+          HAL_HandleEnum enumValue>
+HandleRef<TStruct>
+LimitedHandleResource<THandle, TStruct, size, enumValue>::GetRef(
+    THandle handle) {
+  // get handle index, and fail early if index out of range or wrong handle
+  int16_t index = GetIndex(handle);
+  if (index < 0 || index >= size) {
+    return {};
+  }
+  return HandleRef<TStruct>{m_pointers[index]};
+}
+
 template <typename THandle, typename TStruct, int16_t size,
           HAL_HandleEnum enumValue>
 void LimitedHandleResource<THandle, TStruct, size, enumValue>::Free(
@@ -92,14 +113,26 @@ void LimitedHandleResource<THandle, TStruct, size, enumValue>::Free(
     return;
   }
   // lock and deallocated handle
-  std::scoped_lock allocateLock(m_allocateMutex);
-  std::scoped_lock handleLock(m_handleMutexes[index]);
-  m_structures[index].reset();
+  std::shared_ptr<TStruct> structure;
+  {
+    std::scoped_lock allocateLock(m_allocateMutex);
+    std::scoped_lock handleLock(m_handleMutexes[index]);
+    m_pointers[index].store(nullptr);
+    structure = std::move(m_structures[index]);
+  }
+  // wait for lock-free readers before destroying
+  if (structure) {
+    SynchronizeHandleReaders();
+  }
 }
 
 template <typename THandle, typename TStruct, int16_t size,
           HAL_HandleEnum enumValue>
 void LimitedHandleResource<THandle, TStruct, size, enumValue>::ResetHandles() {
+  for (auto&& pointer : m_pointers) {
+    pointer.store(nullptr);
+  }
+  SynchronizeHandleReaders();
   {
     std::scoped_lock allocateLock(m_allocateMutex);
     for (int i = 0; i < size; i++) {
@@ -6,13 +6,16 @@
 
 #include <stdint.h>
 
+#include <array>
+#include <atomic>
 #include <memory>
 #include <utility>
 #include <vector>
 
-#include <wpi/mutex.h>
+#include <wpi/profiled_mutex.h>
 
 #include "hal/Types.h"
+#include "hal/handles/HandleEpoch.h"
 #include "hal/handles/HandlesInternal.h"
 
 namespace hal {
@@ -37,6 +40,11 @@ class UnlimitedHandleResource : public HandleBase {
 
  public:
   UnlimitedHandleResource() = default;
+  ~UnlimitedHandleResource() {
+    for (auto&& chunk : m_pointers) {
+      delete chunk.load(std::memory_order_relaxed);
+    }
+  }
   UnlimitedHandleResource(const UnlimitedHandleResource&) = delete;
   UnlimitedHandleResource& operator=(const UnlimitedHandleResource&) = delete;
 
@@ -45,6 +53,8 @@ class UnlimitedHandleResource : public HandleBase {
     return getHandleTypedIndex(handle, enumValue, m_version);
   }
   std::shared_ptr<TStruct> Get(THandle handle);
+  // lock-free version of Get(); see HandleEpoch.h
+  HandleRef<TStruct> GetRef(THandle handle);
   /* Returns structure previously at that handle (or nullptr if none) */
   std::shared_ptr<TStruct> Free(THandle handle);
   void ResetHandles() override;
@@ -56,8 +66,26 @@ class UnlimitedHandleResource : public HandleBase {
   void ForEach(Functor func);
 
  private:
+  // Raw pointers for GetRef(), in chunks that are allocated as needed and
+  // never moved, so they can be read without the lock.
+  static constexpr int kChunkSize = 64;
+  using PointerChunk = std::array<std::atomic<TStruct*>, kChunkSize>;
+
+  // must be called with m_handleMutex held
+  std::atomic<TStruct*>& GetPointer(size_t index) {
+    auto& chunk = m_pointers[index / kChunkSize];
+    PointerChunk* ptr = chunk.load(std::memory_order_relaxed);
+    if (!ptr) {
+      ptr = new PointerChunk{};
+      chunk.store(ptr, std::memory_order_release);
+    }
+    return (*ptr)[index % kChunkSize];
+  }
+
   std::vector<std::shared_ptr<TStruct>> m_structures;
-  wpi::mutex m_handleMutex;
+  std::array<std::atomic<PointerChunk*>, (INT16_MAX + kChunkSize) / kChunkSize>
+      m_pointers{};
+  wpi::profiled_mutex m_handleMutex{"HAL.UnlimitedHandleResource"};
 };
 
 template <typename THandle, typename TStruct, HAL_HandleEnum enumValue>
@@ -68,6 +96,7 @@ THandle UnlimitedHandleResource<THandle, TStruct, enumValue>::Allocate(
   for (i = 0; i < m_structures.size(); i++) {
     if (m_structures[i] == nullptr) {
       m_structures[i] = structure;
+      GetPointer(i).store(structure.get(), std::memory_order_release);
       return static_cast<THandle>(createHandle(i, enumValue, m_version));
     }
   }
@@ -76,6 +105,7 @@ THandle UnlimitedHandleResource<THandle, TStruct, enumValue>::Allocate(
   }
 
   m_structures.push_back(structure);
+  GetPointer(i).store(structure.get(), std::memory_order_release);
   return static_cast<THandle>(
       createHandle(static_cast<int16_t>(i), enumValue, m_version));
 }
@@ -91,19 +121,49 @@ UnlimitedHandleResource<THandle, TStruct, enumValue>::Get(THandle handle) {
   return m_structures[index];
 }
 
+template <typename THandle, typename TStruct, HAL_HandleEnum enumValue>
+HandleRef<TStruct> UnlimitedHandleResource<THandle, TStruct, enumValue>::GetRef(
+    THandle handle) {
+  int16_t index = GetIndex(handle);
+  if (index < 0) {
+    return {};
+  }
+  auto chunk = m_pointers[index / kChunkSize].load(std::memory_order_acquire);
+  if (!chunk) {
+    return {};
+  }
+  return HandleRef<TStruct>{(*chunk)[index % kChunkSize]};
+}
+
 template <typename THandle, typename TStruct, HAL_HandleEnum enumValue>
 std::shared_ptr<TStruct>
 UnlimitedHandleResource<THandle, TStruct, enumValue>::Free(THandle handle) {
   int16_t index = GetIndex(handle);
-  std::scoped_lock lock(m_handleMutex);
-  if (index < 0 || index >= static_cast<int16_t>(m_structures.size())) {
-    return nullptr;
+  std::shared_ptr<TStruct> structure;
+  {
+    std::scoped_lock lock(m_handleMutex);
+    if (index < 0 || index >= static_cast<int16_t>(m_structures.size())) {
+      return nullptr;
+    }
+    GetPointer(index).store(nullptr);
+    structure = std::move(m_structures[index]);
+  }
+  // wait for lock-free readers, as the caller may destroy the structure
+  if (structure) {
+    SynchronizeHandleReaders();
   }
-  return std::move(m_structures[index]);
+  return structure;
 }
 
 template <typename THandle, typename TStruct, HAL_HandleEnum enumValue>
 void UnlimitedHandleResource<THandle, TStruct, enumValue>::ResetHandles() {
+  {
+    std::scoped_lock lock(m_handleMutex);
+    for (size_t i = 0; i < m_structures.size(); i++) {
+      GetPointer(i).store(nullptr);
+    }
+  }
+  SynchronizeHandleReaders();
   {
     std::scoped_lock lock(m_handleMutex);
     for (size_t i = 0; i < m_structures.size(); i++) {
@@ -19,6 +19,30 @@ HAL_Bool HALSIM_IsTimingPaused(void);
 void HALSIM_StepTiming(uint64_t delta);
 void HALSIM_StepTimingAsync(uint64_t delta);
 
+/**
+ * Enables or disables fast timing.
+ *
+ * With fast timing, simulated time is paused and, whenever all notifiers are
+ * waiting, advanced directly to the next notifier alarm, so the program runs
+ * as fast as its notifiers (including the TimedRobot loop) can, with
+ * notifiers woken in a deterministic order. Threads that wait on anything
+ * other than notifiers are not synchronized with simulated time.
+ * HALSIM_StepTiming must not be called while fast timing is enabled.
+ *
+ * Fast timing is enabled by HAL_Initialize if the HALSIM_FAST_TIMING
+ * environment variable is set.
+ *
+ * @param enable true to enable fast timing
+ */
+void HALSIM_SetFastTiming(HAL_Bool enable);
+
+/**
+ * Gets whether fast timing is enabled.
+ *
+ * @return true if fast timing is enabled
+ */
+HAL_Bool HALSIM_IsFastTiming(void);
+
 typedef int32_t (*HALSIM_SendErrorHandler)(
     HAL_Bool isError, int32_t errorCode, HAL_Bool isLVCode, const char* details,
     const char* location, const char* callStack, HAL_Bool printMsg);
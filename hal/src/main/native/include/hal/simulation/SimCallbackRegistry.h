@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <utility>
 
@@ -29,6 +30,7 @@ class SimCallbackRegistryBase {
     std::scoped_lock lock(m_mutex);
     if (m_callbacks && uid > 0) {
       m_callbacks->erase(uid - 1);
+      m_hasCallbacks = !m_callbacks->empty();
     }
   }
 
@@ -48,17 +50,23 @@ class SimCallbackRegistryBase {
     if (!m_callbacks) {
       m_callbacks = std::make_unique<CallbackVector>();
     }
-    return m_callbacks->emplace_back(param, callback) + 1;
+    int32_t uid = m_callbacks->emplace_back(param, callback) + 1;
+    m_hasCallbacks = true;
+    return uid;
   }
 
   LLVM_ATTRIBUTE_ALWAYS_INLINE void DoReset() {
     if (m_callbacks) {
       m_callbacks->clear();
     }
+    m_hasCallbacks = false;
   }
 
   mutable wpi::recursive_spinlock m_mutex;
   std::unique_ptr<CallbackVector> m_callbacks;
+  // Mirrors whether m_callbacks is non-empty, so invoking can skip the lock
+  // when nothing is registered
+  std::atomic_bool m_hasCallbacks{false};
 };
 
 }  // namespace impl
@@ -79,6 +87,9 @@ class SimCallbackRegistry : public impl::SimCallbackRegistryBase {
 
   template <typename... U>
   void Invoke(U&&... u) const {
+    if (!m_hasCallbacks) {
+      return;
+    }
     std::scoped_lock lock(m_mutex);
     if (m_callbacks) {
       const char* name = GetName();
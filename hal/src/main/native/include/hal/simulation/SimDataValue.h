@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 
 #include <wpi/Compiler.h>
@@ -23,10 +24,7 @@ class SimDataValueBase : protected SimCallbackRegistryBase {
 
   LLVM_ATTRIBUTE_ALWAYS_INLINE void CancelCallback(int32_t uid) { Cancel(uid); }
 
-  T Get() const {
-    std::scoped_lock lock(m_mutex);
-    return m_value;
-  }
+  T Get() const { return m_value; }
 
   LLVM_ATTRIBUTE_ALWAYS_INLINE operator T() const { return Get(); }  // NOLINT
 
@@ -48,7 +46,7 @@ class SimDataValueBase : protected SimCallbackRegistryBase {
     }
     if (initialNotify) {
       // We know that the callback is not null because of earlier null check
-      HAL_Value value = MakeValue(m_value);
+      HAL_Value value = MakeValue(m_value.load());
       lock.unlock();
       callback(name, param, &value);
     }
@@ -56,20 +54,38 @@ class SimDataValueBase : protected SimCallbackRegistryBase {
   }
 
   void DoSet(T value, const char* name) {
-    std::scoped_lock lock(this->m_mutex);
-    if (m_value != value) {
-      m_value = value;
-      if (m_callbacks) {
-        HAL_Value halValue = MakeValue(value);
-        for (auto&& cb : *m_callbacks) {
-          reinterpret_cast<HAL_NotifyCallback>(cb.callback)(name, cb.param,
-                                                            &halValue);
-        }
+    // Without callbacks, the value can be set without taking the lock.  The
+    // flag is checked again after the exchange so a callback registered
+    // concurrently either sees the new value or is notified of it.
+    if (!m_hasCallbacks) {
+      if (m_value.exchange(value) == value || !m_hasCallbacks) {
+        return;
       }
+      std::scoped_lock lock(m_mutex);
+      Notify(value, name);
+      return;
+    }
+
+    // Callbacks are called with the lock held, so they see changes in order
+    // and aren't called after they are canceled
+    std::scoped_lock lock(m_mutex);
+    if (m_value.exchange(value) != value) {
+      Notify(value, name);
     }
   }
 
-  T m_value;
+  std::atomic<T> m_value;
+
+ private:
+  void Notify(T value, const char* name) {
+    if (m_callbacks) {
+      HAL_Value halValue = MakeValue(value);
+      for (auto&& cb : *m_callbacks) {
+        reinterpret_cast<HAL_NotifyCallback>(cb.callback)(name, cb.param,
+                                                          &halValue);
+      }
+    }
+  }
 };
 }  // namespace impl
 
@@ -149,6 +149,27 @@ void HAL_WriteAddressableLEDData(HAL_AddressableLEDHandle handle,
   SimAddressableLEDData[led->index].SetData(data, length);
 }
 
+void HAL_WriteAddressableLEDDataRange(HAL_AddressableLEDHandle handle,
+                                      const struct HAL_AddressableLEDData* data,
+                                      int32_t start, int32_t length,
+                                      int32_t* status) {
+  auto led = ledHandles->Get(handle);
+  if (!led) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  int32_t stringLength = SimAddressableLEDData[led->index].length;
+  if (start < 0 || length < 0 || start > stringLength - length) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    hal::SetLastError(
+        status, fmt::format("Data range [{}, {}) must be within the strip "
+                            "length of {}",
+                            start, start + length, stringLength));
+    return;
+  }
+  SimAddressableLEDData[led->index].SetData(data, start, length);
+}
+
 void HAL_SetAddressableLEDBitTiming(HAL_AddressableLEDHandle handle,
                                     int32_t highTime0NanoSeconds,
                                     int32_t lowTime0NanoSeconds,
@@ -4,15 +4,18 @@
 
 #include "hal/CANAPI.h"
 
+#include <algorithm>
 #include <memory>
 
 #include <wpi/DenseMap.h>
+#include <wpi/SmallVector.h>
 
 #include "CANAPIInternal.h"
 #include "HALInitializer.h"
 #include "hal/CAN.h"
 #include "hal/Errors.h"
 #include "hal/HALBase.h"
+#include "hal/cpp/CANReceiveDispatcher.h"
 #include "hal/handles/UnlimitedHandleResource.h"
 
 using namespace hal;
@@ -32,11 +35,14 @@ struct CANStorage {
   wpi::SmallDenseMap<int32_t, int32_t> periodicSends;
   wpi::mutex receivesMutex;
   wpi::SmallDenseMap<int32_t, Receives> receives;
+  // API IDs routed through the receive dispatcher; protected by receivesMutex
+  wpi::SmallVector<int32_t, 4> dispatchedApiIds;
 };
 }  // namespace
 
 static UnlimitedHandleResource<HAL_CANHandle, CANStorage, HAL_HandleEnum::CAN>*
     canHandles;
+static CANReceiveDispatcher* receiveDispatcher;
 
 namespace hal {
 namespace init {
@@ -44,6 +50,8 @@ void InitializeCANAPI() {
   static UnlimitedHandleResource<HAL_CANHandle, CANStorage, HAL_HandleEnum::CAN>
       cH;
   canHandles = &cH;
+  static CANReceiveDispatcher rD;
+  receiveDispatcher = &rD;
 }
 }  // namespace init
 namespace can {
@@ -66,6 +74,42 @@ static int32_t CreateCANId(CANStorage* storage, int32_t apiId) {
   createdId |= (storage->deviceId & 0x3F);
   return createdId;
 }
+static void ReceiveMessage(uint32_t messageId, bool latest, uint8_t* data,
+                           uint8_t* dataSize, uint32_t* timeStamp,
+                           int32_t* status) {
+  if (!receiveDispatcher->Receive(messageId, latest, data, dataSize,
+                                  timeStamp, status)) {
+    HAL_CAN_ReceiveMessage(&messageId, 0x1FFFFFFF, data, dataSize, timeStamp,
+                           status);
+  }
+}
+
+static void ReadNewCANPacket(HAL_CANHandle handle, int32_t apiId, bool latest,
+                             uint8_t* data, int32_t* length,
+                             uint64_t* receivedTimestamp, int32_t* status) {
+  auto can = canHandles->GetRef(handle);
+  if (!can) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+
+  uint32_t messageId = CreateCANId(can.get(), apiId);
+  uint8_t dataSize = 0;
+  uint32_t ts = 0;
+  ReceiveMessage(messageId, latest, data, &dataSize, &ts, status);
+
+  if (*status == 0) {
+    std::scoped_lock lock(can->receivesMutex);
+    auto& msg = can->receives[messageId];
+    msg.length = dataSize;
+    msg.lastTimeStamp = ts;
+    // The NetComm call placed in data, copy into the msg
+    std::memcpy(msg.data, data, dataSize);
+  }
+  *length = dataSize;
+  *receivedTimestamp = ts;
+}
+
 extern "C" {
 uint32_t HAL_GetCANPacketBaseTime(void) {
   int status = 0;
@@ -100,6 +144,14 @@ void HAL_CleanCAN(HAL_CANHandle handle) {
     return;
   }
 
+  {
+    std::scoped_lock lock(data->receivesMutex);
+    for (auto apiId : data->dispatchedApiIds) {
+      receiveDispatcher->Remove(CreateCANId(data.get(), apiId));
+    }
+    data->dispatchedApiIds.clear();
+  }
+
   std::scoped_lock lock(data->periodicSendsMutex);
 
   for (auto&& i : data->periodicSends) {
@@ -112,7 +164,7 @@ void HAL_CleanCAN(HAL_CANHandle handle) {
 
 void HAL_WriteCANPacket(HAL_CANHandle handle, const uint8_t* data,
                         int32_t length, int32_t apiId, int32_t* status) {
-  auto can = canHandles->Get(handle);
+  auto can = canHandles->GetRef(handle);
   if (!can) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -124,10 +176,36 @@ void HAL_WriteCANPacket(HAL_CANHandle handle, const uint8_t* data,
   can->periodicSends[apiId] = -1;
 }
 
+int32_t HAL_WriteCANPackets(const struct HAL_CANPacket* packets, int32_t count,
+                            int32_t* status) {
+  hal::HandleRef<CANStorage> can;
+  for (int32_t i = 0; i < count; ++i) {
+    const HAL_CANPacket& packet = packets[i];
+    // Consecutive packets are usually for the same device
+    if (i == 0 || packet.handle != packets[i - 1].handle) {
+      can = canHandles->GetRef(packet.handle);
+      if (!can) {
+        *status = HAL_HANDLE_ERROR;
+        return i;
+      }
+    }
+    auto id = CreateCANId(can.get(), packet.apiId);
+
+    std::scoped_lock lock(can->periodicSendsMutex);
+    HAL_CAN_SendMessage(id, packet.data, packet.length,
+                        HAL_CAN_SEND_PERIOD_NO_REPEAT, status);
+    can->periodicSends[packet.apiId] = -1;
+    if (*status != 0) {
+      return i;
+    }
+  }
+  return count;
+}
+
 void HAL_WriteCANPacketRepeating(HAL_CANHandle handle, const uint8_t* data,
                                  int32_t length, int32_t apiId,
                                  int32_t repeatMs, int32_t* status) {
-  auto can = canHandles->Get(handle);
+  auto can = canHandles->GetRef(handle);
   if (!can) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -141,7 +219,7 @@ void HAL_WriteCANPacketRepeating(HAL_CANHandle handle, const uint8_t* data,
 
 void HAL_WriteCANRTRFrame(HAL_CANHandle handle, int32_t length, int32_t apiId,
                           int32_t* status) {
-  auto can = canHandles->Get(handle);
+  auto can = canHandles->GetRef(handle);
   if (!can) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -158,7 +236,7 @@ void HAL_WriteCANRTRFrame(HAL_CANHandle handle, int32_t length, int32_t apiId,
 
 void HAL_StopCANPacketRepeating(HAL_CANHandle handle, int32_t apiId,
                                 int32_t* status) {
-  auto can = canHandles->Get(handle);
+  auto can = canHandles->GetRef(handle);
   if (!can) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -174,33 +252,21 @@ void HAL_StopCANPacketRepeating(HAL_CANHandle handle, int32_t apiId,
 void HAL_ReadCANPacketNew(HAL_CANHandle handle, int32_t apiId, uint8_t* data,
                           int32_t* length, uint64_t* receivedTimestamp,
                           int32_t* status) {
-  auto can = canHandles->Get(handle);
-  if (!can) {
-    *status = HAL_HANDLE_ERROR;
-    return;
-  }
-
-  uint32_t messageId = CreateCANId(can.get(), apiId);
-  uint8_t dataSize = 0;
-  uint32_t ts = 0;
-  HAL_CAN_ReceiveMessage(&messageId, 0x1FFFFFFF, data, &dataSize, &ts, status);
+  ReadNewCANPacket(handle, apiId, true, data, length, receivedTimestamp,
+                   status);
+}
 
-  if (*status == 0) {
-    std::scoped_lock lock(can->receivesMutex);
-    auto& msg = can->receives[messageId];
-    msg.length = dataSize;
-    msg.lastTimeStamp = ts;
-    // The NetComm call placed in data, copy into the msg
-    std::memcpy(msg.data, data, dataSize);
-  }
-  *length = dataSize;
-  *receivedTimestamp = ts;
+void HAL_ReadCANPacketQueued(HAL_CANHandle handle, int32_t apiId, uint8_t* data,
+                             int32_t* length, uint64_t* receivedTimestamp,
+                             int32_t* status) {
+  ReadNewCANPacket(handle, apiId, false, data, length, receivedTimestamp,
+                   status);
 }
 
 void HAL_ReadCANPacketLatest(HAL_CANHandle handle, int32_t apiId, uint8_t* data,
                              int32_t* length, uint64_t* receivedTimestamp,
                              int32_t* status) {
-  auto can = canHandles->Get(handle);
+  auto can = canHandles->GetRef(handle);
   if (!can) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -209,7 +275,7 @@ void HAL_ReadCANPacketLatest(HAL_CANHandle handle, int32_t apiId, uint8_t* data,
   uint32_t messageId = CreateCANId(can.get(), apiId);
   uint8_t dataSize = 0;
   uint32_t ts = 0;
-  HAL_CAN_ReceiveMessage(&messageId, 0x1FFFFFFF, data, &dataSize, &ts, status);
+  ReceiveMessage(messageId, true, data, &dataSize, &ts, status);
 
   std::scoped_lock lock(can->receivesMutex);
   if (*status == 0) {
@@ -237,7 +303,7 @@ void HAL_ReadCANPacketTimeout(HAL_CANHandle handle, int32_t apiId,
                               uint8_t* data, int32_t* length,
                               uint64_t* receivedTimestamp, int32_t timeoutMs,
                               int32_t* status) {
-  auto can = canHandles->Get(handle);
+  auto can = canHandles->GetRef(handle);
   if (!can) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -246,7 +312,7 @@ void HAL_ReadCANPacketTimeout(HAL_CANHandle handle, int32_t apiId,
   uint32_t messageId = CreateCANId(can.get(), apiId);
   uint8_t dataSize = 0;
   uint32_t ts = 0;
-  HAL_CAN_ReceiveMessage(&messageId, 0x1FFFFFFF, data, &dataSize, &ts, status);
+  ReceiveMessage(messageId, true, data, &dataSize, &ts, status);
 
   std::scoped_lock lock(can->receivesMutex);
   if (*status == 0) {
@@ -276,4 +342,44 @@ void HAL_ReadCANPacketTimeout(HAL_CANHandle handle, int32_t apiId,
     }
   }
 }
+
+void HAL_StartCANReceiveDispatch(HAL_CANHandle handle, int32_t apiId,
+                                 int32_t* status) {
+  auto can = canHandles->Get(handle);
+  if (!can) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+
+  std::scoped_lock lock(can->receivesMutex);
+  if (std::find(can->dispatchedApiIds.begin(), can->dispatchedApiIds.end(),
+                apiId) != can->dispatchedApiIds.end()) {
+    return;
+  }
+  receiveDispatcher->Add(CreateCANId(can.get(), apiId), status);
+  can->dispatchedApiIds.push_back(apiId);
+}
+
+void HAL_StopCANReceiveDispatch(HAL_CANHandle handle, int32_t apiId,
+                                int32_t* status) {
+  auto can = canHandles->Get(handle);
+  if (!can) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+
+  std::scoped_lock lock(can->receivesMutex);
+  auto it = std::find(can->dispatchedApiIds.begin(),
+                      can->dispatchedApiIds.end(), apiId);
+  if (it == can->dispatchedApiIds.end()) {
+    return;
+  }
+  receiveDispatcher->Remove(CreateCANId(can.get(), apiId));
+  can->dispatchedApiIds.erase(it);
+}
+
+void HAL_PollCANReceiveDispatch(int32_t* status) {
+  hal::init::CheckInit();
+  receiveDispatcher->Poll(status);
+}
 }  // extern "C"
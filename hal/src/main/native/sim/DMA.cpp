@@ -76,6 +76,12 @@ enum HAL_DMAReadStatus HAL_ReadDMA(HAL_DMAHandle handle,
   return HAL_DMA_ERROR;
 }
 
+int32_t HAL_ReadDMASamples(HAL_DMAHandle handle, HAL_DMASample* dmaSamples,
+                           int32_t count, double timeoutSeconds,
+                           int32_t* remainingOut, int32_t* status) {
+  return 0;
+}
+
 // Sampling Code
 uint64_t HAL_GetDMASampleTime(const HAL_DMASample* dmaSample, int32_t* status) {
   return 0;
@@ -5,6 +5,7 @@
 #include "hal/HAL.h"
 
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <utility>
 #include <vector>
@@ -368,6 +369,10 @@ HAL_Bool HAL_Initialize(int32_t timeout, int32_t mode) {
   hal::RestartTiming();
   hal::InitializeDriverStation();
 
+  if (std::getenv("HALSIM_FAST_TIMING")) {
+    HALSIM_SetFastTiming(true);
+  }
+
   initialized = true;
 
 // Set Timer Precision to 0.5ms on Windows
@@ -4,9 +4,12 @@
 
 #include "hal/Interrupts.h"
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 
 #include <wpi/condition_variable.h>
+#include <wpi/mutex.h>
 
 #include "AnalogInternal.h"
 #include "DigitalInternal.h"
@@ -48,18 +51,30 @@ struct Interrupt {
   bool fireOnUp;
   bool fireOnDown;
   int32_t callbackId;
+  // set by HAL_ReleaseWaitingInterrupt() if nothing was waiting
+  std::atomic_bool releasePending{false};
+};
+
+// State shared by all of the interrupts a single wait call is waiting for
+struct WaitGroup {
+  wpi::mutex mutex;
+  wpi::condition_variable cond;
+  int64_t result{WaitResult::Timeout};
+  bool released{false};
 };
 
 struct SynchronousWaitData {
   HAL_InterruptHandle interruptHandle{HAL_kInvalidHandle};
-  wpi::condition_variable waitCond;
-  HAL_Bool waitPredicate{false};
+  std::shared_ptr<WaitGroup> group;
 };
 }  // namespace
 
 static LimitedHandleResource<HAL_InterruptHandle, Interrupt, kNumInterrupts,
                              HAL_HandleEnum::Interrupt>* interruptHandles;
 
+// handles by interrupt index, for HAL_WaitForMultipleInterrupts()
+static std::atomic<HAL_InterruptHandle> interruptsByIndex[kNumInterrupts];
+
 using SynchronousWaitDataHandle = HAL_Handle;
 static UnlimitedHandleResource<SynchronousWaitDataHandle, SynchronousWaitData,
                                HAL_HandleEnum::Vendor>*
@@ -78,6 +93,50 @@ void InitializeInterrupts() {
 }
 }  // namespace hal::init
 
+static int64_t GetInterruptMask(uint8_t index) {
+  return (1ll << index) | (1ll << (8 + index));
+}
+
+static void ReleaseWaitGroup(WaitGroup* group) {
+  std::scoped_lock lock(group->mutex);
+  group->released = true;
+  group->cond.notify_all();
+}
+
+static void ProcessInterruptState(SynchronousWaitData* interruptData,
+                                  Interrupt* interrupt, bool state) {
+  auto previousState = interrupt->currentState;
+  interrupt->currentState = state;
+  // If no change in interrupt, return;
+  if (state == previousState) {
+    return;
+  }
+  // If its a falling change, and we dont fire on falling return
+  if (previousState && !interrupt->fireOnDown) {
+    return;
+  }
+  // If its a rising change, and we dont fire on rising return.
+  if (!previousState && !interrupt->fireOnUp) {
+    return;
+  }
+
+  // Set our return value and our timestamps
+  int64_t edge;
+  if (state) {
+    interrupt->risingTimestamp = hal::GetFPGATime();
+    edge = 1ll << interrupt->index;
+  } else {
+    interrupt->fallingTimestamp = hal::GetFPGATime();
+    edge = 1ll << (8 + interrupt->index);
+  }
+
+  // Pulse interrupt
+  auto group = interruptData->group.get();
+  std::scoped_lock lock(group->mutex);
+  group->result |= edge;
+  group->cond.notify_all();
+}
+
 extern "C" {
 HAL_InterruptHandle HAL_InitializeInterrupts(int32_t* status) {
   hal::init::CheckInit();
@@ -94,10 +153,17 @@ HAL_InterruptHandle HAL_InitializeInterrupts(int32_t* status) {
 
   anInterrupt->index = getHandleIndex(handle);
   anInterrupt->callbackId = -1;
+  interruptsByIndex[anInterrupt->index] = handle;
 
   return handle;
 }
 void HAL_CleanInterrupts(HAL_InterruptHandle interruptHandle) {
+  int16_t index = interruptHandles->GetIndex(interruptHandle);
+  if (index >= 0 && index < kNumInterrupts) {
+    HAL_InterruptHandle expected = interruptHandle;
+    interruptsByIndex[index].compare_exchange_strong(expected,
+                                                     HAL_kInvalidHandle);
+  }
   interruptHandles->Free(interruptHandle);
 }
 
@@ -120,26 +186,8 @@ static void ProcessInterruptDigitalSynchronous(const char* name, void* param,
   if (value->type != HAL_Type::HAL_BOOLEAN) {
     return;
   }
-  bool retVal = value->data.v_boolean;
-  auto previousState = interrupt->currentState;
-  interrupt->currentState = retVal;
-  // If no change in interrupt, return;
-  if (retVal == previousState) {
-    return;
-  }
-  // If its a falling change, and we dont fire on falling return
-  if (previousState && !interrupt->fireOnDown) {
-    return;
-  }
-  // If its a rising change, and we dont fire on rising return.
-  if (!previousState && !interrupt->fireOnUp) {
-    return;
-  }
-
-  interruptData->waitPredicate = true;
-
-  // Pulse interrupt
-  interruptData->waitCond.notify_all();
+  ProcessInterruptState(interruptData.get(), interrupt.get(),
+                        value->data.v_boolean);
 }
 
 static double GetAnalogTriggerValue(HAL_Handle triggerHandle,
@@ -172,169 +220,125 @@ static void ProcessInterruptAnalogSynchronous(const char* name, void* param,
                                       interrupt->trigType, &status);
   if (status != 0) {
     // Interrupt and Cancel
-    interruptData->waitPredicate = true;
-    // Pulse interrupt
-    interruptData->waitCond.notify_all();
-  }
-  auto previousState = interrupt->currentState;
-  interrupt->currentState = retVal;
-  // If no change in interrupt, return;
-  if (retVal == previousState) {
-    return;
-  }
-  // If its a falling change, and we dont fire on falling return
-  if (previousState && !interrupt->fireOnDown) {
-    return;
-  }
-  // If its a rising change, and we dont fire on rising return.
-  if (!previousState && !interrupt->fireOnUp) {
+    ReleaseWaitGroup(interruptData->group.get());
     return;
   }
+  ProcessInterruptState(interruptData.get(), interrupt.get(), retVal);
+}
 
-  interruptData->waitPredicate = true;
+namespace {
+struct WaitRegistration {
+  SynchronousWaitDataHandle dataHandle;
+  bool isAnalog;
+  int32_t index;
+  int32_t uid;
+};
+}  // namespace
 
-  // Pulse interrupt
-  interruptData->waitCond.notify_all();
-}
+// Registers a value callback on the source of the interrupt at index
+static bool RegisterInterruptWait(const std::shared_ptr<WaitGroup>& group,
+                                  int32_t interruptIndex,
+                                  bool ignorePrevious,
+                                  WaitRegistration* registration) {
+  HAL_InterruptHandle handle = interruptsByIndex[interruptIndex];
+  auto interrupt = interruptHandles->Get(handle);
+  if (interrupt == nullptr) {
+    return false;
+  }
 
-static int64_t WaitForInterruptDigital(HAL_InterruptHandle handle,
-                                       Interrupt* interrupt, double timeout,
-                                       bool ignorePrevious) {
   auto data = std::make_shared<SynchronousWaitData>();
+  data->interruptHandle = handle;
+  data->group = group;
 
   auto dataHandle = synchronousInterruptHandles->Allocate(data);
   if (dataHandle == HAL_kInvalidHandle) {
     // Error allocating data
-    return WaitResult::Timeout;
+    return false;
   }
 
-  // auto data = synchronousInterruptHandles->Get(dataHandle);
-  data->waitPredicate = false;
-  data->interruptHandle = handle;
-
   int32_t status = 0;
-
-  int32_t digitalIndex = GetDigitalInputChannel(interrupt->portHandle, &status);
-
-  if (status != 0) {
-    return WaitResult::Timeout;
-  }
-
-  interrupt->currentState = SimDIOData[digitalIndex].value;
-
-  int32_t uid = SimDIOData[digitalIndex].value.RegisterCallback(
-      &ProcessInterruptDigitalSynchronous,
-      reinterpret_cast<void*>(static_cast<uintptr_t>(dataHandle)), false);
-
-  bool timedOut = false;
-
-  wpi::mutex waitMutex;
-
-  auto timeoutTime =
-      std::chrono::steady_clock::now() + std::chrono::duration<double>(timeout);
-
-  {
-    std::unique_lock lock(waitMutex);
-    while (!data->waitPredicate) {
-      if (data->waitCond.wait_until(lock, timeoutTime) ==
-          std::cv_status::timeout) {
-        timedOut = true;
-        break;
-      }
+  registration->dataHandle = dataHandle;
+  registration->isAnalog = interrupt->isAnalog;
+  void* param = reinterpret_cast<void*>(static_cast<uintptr_t>(dataHandle));
+  if (interrupt->isAnalog) {
+    interrupt->currentState = GetAnalogTriggerValue(
+        interrupt->portHandle, interrupt->trigType, &status);
+    if (status == 0) {
+      registration->index =
+          GetAnalogTriggerInputIndex(interrupt->portHandle, &status);
+    }
+    if (status != 0) {
+      (void)synchronousInterruptHandles->Free(dataHandle);
+      return false;
+    }
+    registration->uid =
+        SimAnalogInData[registration->index].voltage.RegisterCallback(
+            &ProcessInterruptAnalogSynchronous, param, false);
+  } else {
+    registration->index =
+        GetDigitalInputChannel(interrupt->portHandle, &status);
+    if (status != 0) {
+      (void)synchronousInterruptHandles->Free(dataHandle);
+      return false;
     }
+    interrupt->currentState = SimDIOData[registration->index].value;
+    registration->uid = SimDIOData[registration->index].value.RegisterCallback(
+        &ProcessInterruptDigitalSynchronous, param, false);
   }
 
-  // Cancel our callback
-  SimDIOData[digitalIndex].value.CancelCallback(uid);
-  (void)synchronousInterruptHandles->Free(dataHandle);
-
-  // Check for what to return
-  if (timedOut) {
-    return WaitResult::Timeout;
-  }
-  // We know the value has changed because we would've timed out otherwise.
-  // If the current state is true, the previous state was false, so this is a
-  // rising edge. Otherwise, it's a falling edge.
-  if (interrupt->currentState) {
-    // Set our return value and our timestamps
-    interrupt->risingTimestamp = hal::GetFPGATime();
-    return 1 << (interrupt->index);
-  } else {
-    interrupt->fallingTimestamp = hal::GetFPGATime();
-    return 1 << (8 + interrupt->index);
+  // A release with nothing waiting wakes the next wait, unless that ignores
+  // previous interrupts. Checked after registering so a concurrent release is
+  // never missed.
+  if (interrupt->releasePending.exchange(false) && !ignorePrevious) {
+    ReleaseWaitGroup(group.get());
   }
+  return true;
 }
 
-static int64_t WaitForInterruptAnalog(HAL_InterruptHandle handle,
-                                      Interrupt* interrupt, double timeout,
-                                      bool ignorePrevious) {
-  auto data = std::make_shared<SynchronousWaitData>();
-
-  auto dataHandle = synchronousInterruptHandles->Allocate(data);
-  if (dataHandle == HAL_kInvalidHandle) {
-    // Error allocating data
-    return WaitResult::Timeout;
+static void UnregisterInterruptWait(const WaitRegistration& registration) {
+  if (registration.isAnalog) {
+    SimAnalogInData[registration.index].voltage.CancelCallback(
+        registration.uid);
+  } else {
+    SimDIOData[registration.index].value.CancelCallback(registration.uid);
   }
+  (void)synchronousInterruptHandles->Free(registration.dataHandle);
+}
 
-  data->waitPredicate = false;
-  data->interruptHandle = handle;
-
-  int32_t status = 0;
-  interrupt->currentState = GetAnalogTriggerValue(interrupt->portHandle,
-                                                  interrupt->trigType, &status);
-
-  if (status != 0) {
-    return WaitResult::Timeout;
+static int64_t WaitForInterrupts(int64_t mask, double timeout,
+                                 bool ignorePrevious) {
+  auto group = std::make_shared<WaitGroup>();
+
+  WaitRegistration registrations[kNumInterrupts];
+  int numRegistrations = 0;
+  for (int32_t i = 0; i < kNumInterrupts; i++) {
+    if ((mask & GetInterruptMask(i)) != 0 &&
+        RegisterInterruptWait(group, i, ignorePrevious,
+                              &registrations[numRegistrations])) {
+      ++numRegistrations;
+    }
   }
-
-  int32_t analogIndex =
-      GetAnalogTriggerInputIndex(interrupt->portHandle, &status);
-
-  if (status != 0) {
+  if (numRegistrations == 0) {
     return WaitResult::Timeout;
   }
 
-  int32_t uid = SimAnalogInData[analogIndex].voltage.RegisterCallback(
-      &ProcessInterruptAnalogSynchronous,
-      reinterpret_cast<void*>(static_cast<uintptr_t>(dataHandle)), false);
-
-  bool timedOut = false;
-
-  wpi::mutex waitMutex;
-
   auto timeoutTime =
       std::chrono::steady_clock::now() + std::chrono::duration<double>(timeout);
 
   {
-    std::unique_lock lock(waitMutex);
-    while (!data->waitPredicate) {
-      if (data->waitCond.wait_until(lock, timeoutTime) ==
-          std::cv_status::timeout) {
-        timedOut = true;
-        break;
-      }
-    }
+    std::unique_lock lock(group->mutex);
+    group->cond.wait_until(lock, timeoutTime, [&] {
+      return group->result != WaitResult::Timeout || group->released;
+    });
   }
 
-  // Cancel our callback
-  SimAnalogInData[analogIndex].voltage.CancelCallback(uid);
-  (void)synchronousInterruptHandles->Free(dataHandle);
-
-  // Check for what to return
-  if (timedOut) {
-    return WaitResult::Timeout;
-  }
-  // We know the value has changed because we would've timed out otherwise.
-  // If the current state is true, the previous state was false, so this is a
-  // rising edge. Otherwise, it's a falling edge.
-  if (interrupt->currentState) {
-    // Set our return value and our timestamps
-    interrupt->risingTimestamp = hal::GetFPGATime();
-    return 1 << (interrupt->index);
-  } else {
-    interrupt->fallingTimestamp = hal::GetFPGATime();
-    return 1 << (8 + interrupt->index);
+  // Cancel our callbacks
+  for (int i = 0; i < numRegistrations; i++) {
+    UnregisterInterruptWait(registrations[i]);
   }
+
+  std::scoped_lock lock(group->mutex);
+  return group->result & mask;
 }
 
 int64_t HAL_WaitForInterrupt(HAL_InterruptHandle interruptHandle,
@@ -346,33 +350,32 @@ int64_t HAL_WaitForInterrupt(HAL_InterruptHandle interruptHandle,
     return WaitResult::Timeout;
   }
 
-  if (interrupt->isAnalog) {
-    return WaitForInterruptAnalog(interruptHandle, interrupt.get(), timeout,
-                                  ignorePrevious);
-  } else {
-    return WaitForInterruptDigital(interruptHandle, interrupt.get(), timeout,
-                                   ignorePrevious);
-  }
+  return WaitForInterrupts(GetInterruptMask(interrupt->index), timeout,
+                           ignorePrevious);
 }
 
 int64_t HAL_WaitForMultipleInterrupts(HAL_InterruptHandle interruptHandle,
                                       int64_t mask, double timeout,
                                       HAL_Bool ignorePrevious,
                                       int32_t* status) {
-  // TODO make this properly work, will require a decent rewrite
   auto interrupt = interruptHandles->Get(interruptHandle);
   if (interrupt == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return WaitResult::Timeout;
   }
 
-  if (interrupt->isAnalog) {
-    return WaitForInterruptAnalog(interruptHandle, interrupt.get(), timeout,
-                                  ignorePrevious);
-  } else {
-    return WaitForInterruptDigital(interruptHandle, interrupt.get(), timeout,
-                                   ignorePrevious);
+  return WaitForInterrupts(mask, timeout, ignorePrevious);
+}
+
+int64_t HAL_GetInterruptMask(HAL_InterruptHandle interruptHandle,
+                             int32_t* status) {
+  auto interrupt = interruptHandles->Get(interruptHandle);
+  if (interrupt == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return 0;
   }
+
+  return GetInterruptMask(interrupt->index);
 }
 
 int64_t HAL_ReadInterruptRisingTimestamp(HAL_InterruptHandle interruptHandle,
@@ -442,13 +445,18 @@ void HAL_ReleaseWaitingInterrupt(HAL_InterruptHandle interruptHandle,
     return;
   }
 
+  // Latch the release first, so a wait that is just starting sees it
+  interrupt->releasePending = true;
+  bool released = false;
   synchronousInterruptHandles->ForEach(
-      [interruptHandle](SynchronousWaitDataHandle handle,
-                        SynchronousWaitData* data) {
+      [&](SynchronousWaitDataHandle handle, SynchronousWaitData* data) {
         if (data->interruptHandle == interruptHandle) {
-          data->waitPredicate = true;
-          data->waitCond.notify_all();
+          ReleaseWaitGroup(data->group.get());
+          released = true;
         }
       });
+  if (released) {
+    interrupt->releasePending = false;
+  }
 }
 }  // extern "C"
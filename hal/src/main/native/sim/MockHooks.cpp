@@ -8,6 +8,7 @@
 #include <cstdio>
 #include <thread>
 
+#include <wpi/mutex.h>
 #include <wpi/print.h>
 #include <wpi/timestamp.h>
 
@@ -21,6 +22,74 @@ static std::atomic<uint64_t> programStartTime{0};
 static std::atomic<uint64_t> programPauseTime{0};
 static std::atomic<uint64_t> programStepTime{0};
 
+namespace {
+// Advances time to the next notifier alarm as soon as all notifiers are
+// waiting, rather than waiting for the wall clock to get there.
+class FastTimingThread {
+ public:
+  ~FastTimingThread() { Stop(); }
+
+  void Start();
+  void Stop();
+  bool IsRunning() const { return m_active; }
+
+ private:
+  void Main();
+
+  wpi::mutex m_mutex;  // serializes Start() and Stop()
+  std::atomic_bool m_active{false};
+  std::thread m_thread;
+};
+}  // namespace
+
+static FastTimingThread& GetFastTimingThread() {
+  static FastTimingThread thread;
+  return thread;
+}
+
+void FastTimingThread::Start() {
+  std::scoped_lock lock(m_mutex);
+  if (m_active) {
+    return;
+  }
+  hal::PauseTiming();
+  hal::PauseNotifiers();
+  m_active = true;
+  m_thread = std::thread([this] { Main(); });
+}
+
+void FastTimingThread::Stop() {
+  std::scoped_lock lock(m_mutex);
+  if (!m_active) {
+    return;
+  }
+  m_active = false;
+  hal::InterruptWaitNotifiers();
+  m_thread.join();
+  hal::ResumeTiming();
+  hal::ResumeNotifiers();
+}
+
+void FastTimingThread::Main() {
+  while (m_active) {
+    hal::WaitNotifiers(&m_active);
+    if (!m_active) {
+      break;
+    }
+    uint64_t nextTimeout = HALSIM_GetNextNotifierTimeout();
+    if (nextTimeout == UINT64_MAX) {
+      // Nothing scheduled yet; give the program time to set up an alarm
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      continue;
+    }
+    uint64_t curTime = hal::GetFPGATime();
+    if (nextTimeout > curTime) {
+      hal::StepTiming(nextTimeout - curTime);
+    }
+    hal::WakeupWaitNotifiers(&m_active);
+  }
+}
+
 namespace hal::init {
 void InitializeMockHooks() {
   wpi::SetNowImpl(GetFPGATime);
@@ -135,4 +204,16 @@ void HALSIM_StepTimingAsync(uint64_t delta) {
   StepTiming(delta);
   WakeupNotifiers();
 }
+
+void HALSIM_SetFastTiming(HAL_Bool enable) {
+  if (enable) {
+    GetFastTimingThread().Start();
+  } else {
+    GetFastTimingThread().Stop();
+  }
+}
+
+HAL_Bool HALSIM_IsFastTiming(void) {
+  return GetFastTimingThread().IsRunning();
+}
 }  // extern "C"
@@ -4,11 +4,13 @@
 
 #include "hal/Notifier.h"
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cstdio>
 #include <cstring>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 
@@ -33,6 +35,8 @@ struct Notifier {
   bool waitTimeValid = false;    // True if waitTime is set and in the future
   bool waitingForAlarm = false;  // True if in HAL_WaitForNotifierAlarm()
   uint64_t waitCount = 0;        // Counts calls to HAL_WaitForNotifierAlarm()
+  uint64_t lastLatency = 0;
+  uint64_t maxLatency = 0;
   wpi::mutex mutex;
   wpi::condition_variable cond;
 };
@@ -43,6 +47,26 @@ using namespace hal;
 static wpi::mutex notifiersWaiterMutex;
 static wpi::condition_variable notifiersWaiterCond;
 
+// Valid alarms of active notifiers, ordered by time and then handle, so the
+// next alarm and the expired ones can be found without visiting every
+// notifier.  Kept in sync with waitTime and waitTimeValid by SetAlarm().
+static wpi::mutex alarmsMutex;
+static std::set<std::pair<uint64_t, HAL_NotifierHandle>> alarms;
+
+// Must be called with notifier->mutex held.
+static void SetAlarm(HAL_NotifierHandle handle, Notifier* notifier,
+                     uint64_t waitTime, bool waitTimeValid) {
+  std::scoped_lock lock(alarmsMutex);
+  if (notifier->waitTimeValid) {
+    alarms.erase({notifier->waitTime, handle});
+  }
+  notifier->waitTime = waitTime;
+  notifier->waitTimeValid = waitTimeValid;
+  if (waitTimeValid) {
+    alarms.emplace(waitTime, handle);
+  }
+}
+
 class NotifierHandleContainer
     : public UnlimitedHandleResource<HAL_NotifierHandle, Notifier,
                                      HAL_HandleEnum::Notifier> {
@@ -52,7 +76,7 @@ class NotifierHandleContainer
       {
         std::scoped_lock lock(notifier->mutex);
         notifier->active = false;
-        notifier->waitTimeValid = false;
+        SetAlarm(handle, notifier, notifier->waitTime, false);
       }
       notifier->cond.notify_all();  // wake up any waiting threads
     });
@@ -86,7 +110,7 @@ void WakeupNotifiers() {
   });
 }
 
-void WaitNotifiers() {
+void WaitNotifiers(const std::atomic_bool* active) {
   std::unique_lock ulock(notifiersWaiterMutex);
   wpi::SmallVector<HAL_NotifierHandle, 8> waiters;
 
@@ -112,7 +136,7 @@ void WaitNotifiers() {
       // No longer need to wait for it, put at end so it can be erased
       std::swap(it, waiters[--end]);
     }
-    if (count == 0) {
+    if (count == 0 || (active && !*active)) {
       break;
     }
     waiters.resize(count);
@@ -120,48 +144,62 @@ void WaitNotifiers() {
   }
 }
 
-void WakeupWaitNotifiers() {
-  std::unique_lock ulock(notifiersWaiterMutex);
+void WakeupWaitNotifiers(const std::atomic_bool* active) {
   int32_t status = 0;
   uint64_t curTime = HAL_GetFPGATime(&status);
-  wpi::SmallVector<std::pair<HAL_NotifierHandle, uint64_t>, 8> waiters;
 
-  // Wake up Notifiers that have expired timeouts
-  notifierHandles->ForEach([&](HAL_NotifierHandle handle, Notifier* notifier) {
-    std::scoped_lock lock(notifier->mutex);
+  // Notifiers with expired alarms, in alarm order
+  wpi::SmallVector<HAL_NotifierHandle, 8> expired;
+  {
+    std::scoped_lock lock(alarmsMutex);
+    for (auto&& alarm : alarms) {
+      if (alarm.first > curTime) {
+        break;
+      }
+      expired.emplace_back(alarm.second);
+    }
+  }
 
-    // Only wait for the Notifier if it has a valid timeout that's expired
-    if (notifier->active && notifier->waitTimeValid &&
-        curTime >= notifier->waitTime) {
-      waiters.emplace_back(handle, notifier->waitCount);
-      notifier->cond.notify_all();
+  // Wake them up one at a time, so they run in a deterministic order
+  std::unique_lock ulock(notifiersWaiterMutex);
+  for (auto handle : expired) {
+    auto notifier = notifierHandles->Get(handle);
+    if (!notifier) {
+      continue;
     }
-  });
-  for (;;) {
-    int count = 0;
-    int end = waiters.size();
-    while (count < end) {
-      auto& it = waiters[count];
-      if (auto notifier = notifierHandles->Get(it.first)) {
-        std::scoped_lock lock(notifier->mutex);
+    uint64_t waitCount;
+    {
+      std::scoped_lock lock(notifier->mutex);
+      // An earlier notifier may have changed the alarm
+      if (!notifier->active || !notifier->waitTimeValid ||
+          curTime < notifier->waitTime) {
+        continue;
+      }
+      waitCount = notifier->waitCount;
+    }
+    notifier->cond.notify_all();
 
-        // waitCount is used here instead of waitingForAlarm because we want to
-        // wait until HAL_WaitForNotifierAlarm() is exited, then reentered
-        if (notifier->active && notifier->waitCount == it.second) {
-          ++count;
-          continue;
+    // waitCount is used here instead of waitingForAlarm because we want to
+    // wait until HAL_WaitForNotifierAlarm() is exited, then reentered
+    for (;;) {
+      {
+        std::scoped_lock lock(notifier->mutex);
+        if (!notifier->active || notifier->waitCount != waitCount) {
+          break;
         }
       }
-      // No longer need to wait for it, put at end so it can be erased
-      it.swap(waiters[--end]);
-    }
-    if (count == 0) {
-      break;
+      if (active && !*active) {
+        return;
+      }
+      notifiersWaiterCond.wait_for(ulock, std::chrono::duration<double>(1));
     }
-    waiters.resize(count);
-    notifiersWaiterCond.wait_for(ulock, std::chrono::duration<double>(1));
   }
 }
+
+void InterruptWaitNotifiers() {
+  std::scoped_lock lock(notifiersWaiterMutex);
+  notifiersWaiterCond.notify_all();
+}
 }  // namespace hal
 
 extern "C" {
@@ -201,7 +239,7 @@ void HAL_StopNotifier(HAL_NotifierHandle notifierHandle, int32_t* status) {
   {
     std::scoped_lock lock(notifier->mutex);
     notifier->active = false;
-    notifier->waitTimeValid = false;
+    SetAlarm(notifierHandle, notifier.get(), notifier->waitTime, false);
   }
   notifier->cond.notify_all();
 }
@@ -216,7 +254,7 @@ void HAL_CleanNotifier(HAL_NotifierHandle notifierHandle) {
   {
     std::scoped_lock lock(notifier->mutex);
     notifier->active = false;
-    notifier->waitTimeValid = false;
+    SetAlarm(notifierHandle, notifier.get(), notifier->waitTime, false);
   }
   notifier->cond.notify_all();
 }
@@ -230,8 +268,8 @@ void HAL_UpdateNotifierAlarm(HAL_NotifierHandle notifierHandle,
 
   {
     std::scoped_lock lock(notifier->mutex);
-    notifier->waitTime = triggerTime;
-    notifier->waitTimeValid = (triggerTime != UINT64_MAX);
+    SetAlarm(notifierHandle, notifier.get(), triggerTime,
+             notifier->active && triggerTime != UINT64_MAX);
   }
 
   // We wake up any waiters to change how long they're sleeping for
@@ -247,7 +285,7 @@ void HAL_CancelNotifierAlarm(HAL_NotifierHandle notifierHandle,
 
   {
     std::scoped_lock lock(notifier->mutex);
-    notifier->waitTimeValid = false;
+    SetAlarm(notifierHandle, notifier.get(), notifier->waitTime, false);
   }
 }
 
@@ -267,7 +305,10 @@ uint64_t HAL_WaitForNotifierAlarm(HAL_NotifierHandle notifierHandle,
   while (notifier->active) {
     uint64_t curTime = HAL_GetFPGATime(status);
     if (notifier->waitTimeValid && curTime >= notifier->waitTime) {
-      notifier->waitTimeValid = false;
+      notifier->lastLatency = curTime - notifier->waitTime;
+      notifier->maxLatency =
+          (std::max)(notifier->maxLatency, notifier->lastLatency);
+      SetAlarm(notifierHandle, notifier.get(), notifier->waitTime, false);
       notifier->waitingForAlarm = false;
       return curTime;
     }
@@ -286,16 +327,22 @@ uint64_t HAL_WaitForNotifierAlarm(HAL_NotifierHandle notifierHandle,
   return 0;
 }
 
+void HAL_GetNotifierWakeLatency(HAL_NotifierHandle notifierHandle,
+                                uint64_t* lastLatency, uint64_t* maxLatency,
+                                int32_t* status) {
+  auto notifier = notifierHandles->Get(notifierHandle);
+  if (!notifier) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  std::scoped_lock lock(notifier->mutex);
+  *lastLatency = notifier->lastLatency;
+  *maxLatency = notifier->maxLatency;
+}
+
 uint64_t HALSIM_GetNextNotifierTimeout(void) {
-  uint64_t timeout = UINT64_MAX;
-  notifierHandles->ForEach([&](HAL_NotifierHandle, Notifier* notifier) {
-    std::scoped_lock lock(notifier->mutex);
-    if (notifier->active && notifier->waitTimeValid &&
-        timeout > notifier->waitTime) {
-      timeout = notifier->waitTime;
-    }
-  });
-  return timeout;
+  std::scoped_lock lock(alarmsMutex);
+  return alarms.empty() ? UINT64_MAX : alarms.begin()->first;
 }
 
 int32_t HALSIM_GetNumNotifiers(void) {
@@ -4,10 +4,15 @@
 
 #pragma once
 
+#include <atomic>
+
 namespace hal {
 void PauseNotifiers();
 void ResumeNotifiers();
 void WakeupNotifiers();
-void WaitNotifiers();
-void WakeupWaitNotifiers();
+// If active is given, the waits return early once it is cleared and
+// InterruptWaitNotifiers() is called.
+void WaitNotifiers(const std::atomic_bool* active = nullptr);
+void WakeupWaitNotifiers(const std::atomic_bool* active = nullptr);
+void InterruptWaitNotifiers();
 }  // namespace hal
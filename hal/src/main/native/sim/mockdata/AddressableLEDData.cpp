@@ -36,6 +36,15 @@ void AddressableLEDData::SetData(const HAL_AddressableLEDData* d, int32_t len) {
   data(reinterpret_cast<const uint8_t*>(d), len * sizeof(d[0]));
 }
 
+void AddressableLEDData::SetData(const HAL_AddressableLEDData* d,
+                                 int32_t start, int32_t len) {
+  len = (std::min)(HAL_kAddressableLEDMaxLength - start, len);
+  std::scoped_lock lock(m_dataMutex);
+  std::memcpy(m_data + start, d, len * sizeof(d[0]));
+  int32_t total = (std::max)(start + len, length.Get());
+  data(reinterpret_cast<const uint8_t*>(m_data), total * sizeof(m_data[0]));
+}
+
 int32_t AddressableLEDData::GetData(HAL_AddressableLEDData* d) {
   std::scoped_lock lock(m_dataMutex);
   int32_t len = length;
@@ -25,6 +25,8 @@ class AddressableLEDData {
 
  public:
   void SetData(const HAL_AddressableLEDData* d, int32_t len);
+  // Updates part of the data; callbacks are called with the whole strip
+  void SetData(const HAL_AddressableLEDData* d, int32_t start, int32_t len);
   int32_t GetData(HAL_AddressableLEDData* d);
 
   SimDataValue<HAL_Bool, HAL_MakeBoolean, GetInitializedName> initialized{
@@ -3,10 +3,13 @@
 // the WPILib BSD license file in the root directory of this project.
 
 #include <utility>
+#include <vector>
 
 #include <gtest/gtest.h>
 
+#include "hal/CAN.h"
 #include "hal/CANAPI.h"
+#include "hal/Errors.h"
 #include "hal/simulation/CanData.h"
 
 namespace hal {
@@ -79,4 +82,166 @@ TEST(CANTest, CanIdPacking) {
   ASSERT_EQ(static_cast<int32_t>(HAL_CANDeviceType::HAL_CAN_Dev_kMiscellaneous),
             (storePair.first & 0x1F000000) >> 24);
 }
+
+TEST(CANTest, WritePackets) {
+  int32_t status = 0;
+  CANTestStore device1(1, &status);
+  CANTestStore device2(2, &status);
+  ASSERT_EQ(0, status);
+
+  std::vector<std::pair<uint32_t, uint8_t>> sent;
+  auto cbHandle = HALSIM_RegisterCanSendMessageCallback(
+      [](const char* name, void* param, uint32_t messageID, const uint8_t* data,
+         uint8_t dataSize, int32_t periodMs, int32_t* status) {
+        static_cast<std::vector<std::pair<uint32_t, uint8_t>>*>(param)
+            ->emplace_back(messageID, dataSize);
+      },
+      &sent);
+  CANSendCallbackStore cbStore(cbHandle);
+
+  HAL_CANPacket packets[4] = {{device1.handle, 1, {}, 8},
+                              {device1.handle, 2, {}, 4},
+                              {device2.handle, 1, {}, 2},
+                              {HAL_kInvalidHandle, 1, {}, 8}};
+  EXPECT_EQ(3, HAL_WriteCANPackets(packets, 4, &status));
+  EXPECT_EQ(HAL_HANDLE_ERROR, status);
+
+  ASSERT_EQ(3u, sent.size());
+  EXPECT_EQ(1u, sent[0].first & 0x3F);
+  EXPECT_EQ(1u, (sent[0].first & 0xFFC0) >> 6);
+  EXPECT_EQ(8, sent[0].second);
+  EXPECT_EQ(2u, (sent[1].first & 0xFFC0) >> 6);
+  EXPECT_EQ(4, sent[1].second);
+  EXPECT_EQ(2u, sent[2].first & 0x3F);
+  EXPECT_EQ(2, sent[2].second);
+}
+
+struct CANBusStore {
+  std::vector<HAL_CANStreamMessage> frames;
+  uint32_t sessionId = 0;
+  uint32_t sessionMask = 0;
+  int openSessions = 0;
+  int streamReads = 0;
+  int receives = 0;
+};
+
+TEST(CANTest, ReceiveDispatch) {
+  int32_t status = 0;
+  CANTestStore device1(1, &status);
+  CANTestStore device2(2, &status);
+  ASSERT_EQ(0, status);
+
+  CANBusStore bus;
+  auto openHandle = HALSIM_RegisterCanOpenStreamCallback(
+      [](const char* name, void* param, uint32_t* sessionHandle,
+         uint32_t messageID, uint32_t messageIDMask, uint32_t maxMessages,
+         int32_t* status) {
+        auto bus = static_cast<CANBusStore*>(param);
+        *sessionHandle = 1;
+        bus->sessionId = messageID;
+        bus->sessionMask = messageIDMask;
+        ++bus->openSessions;
+      },
+      &bus);
+  auto closeHandle = HALSIM_RegisterCanCloseStreamCallback(
+      [](const char* name, void* param, uint32_t sessionHandle) {
+        --static_cast<CANBusStore*>(param)->openSessions;
+      },
+      &bus);
+  auto readHandle = HALSIM_RegisterCanReadStreamCallback(
+      [](const char* name, void* param, uint32_t sessionHandle,
+         HAL_CANStreamMessage* messages, uint32_t messagesToRead,
+         uint32_t* messagesRead, int32_t* status) {
+        auto bus = static_cast<CANBusStore*>(param);
+        ++bus->streamReads;
+        *messagesRead = 0;
+        while (*messagesRead < messagesToRead && !bus->frames.empty()) {
+          messages[(*messagesRead)++] = bus->frames.front();
+          bus->frames.erase(bus->frames.begin());
+        }
+      },
+      &bus);
+  auto receiveHandle = HALSIM_RegisterCanReceiveMessageCallback(
+      [](const char* name, void* param, uint32_t* messageID,
+         uint32_t messageIDMask, uint8_t* data, uint8_t* dataSize,
+         uint32_t* timeStamp, int32_t* status) {
+        ++static_cast<CANBusStore*>(param)->receives;
+        *status = HAL_ERR_CANSessionMux_MessageNotFound;
+      },
+      &bus);
+
+  int32_t apiId = 5;
+  HAL_StartCANReceiveDispatch(device1.handle, apiId, &status);
+  HAL_StartCANReceiveDispatch(device2.handle, apiId, &status);
+  ASSERT_EQ(0, status);
+  EXPECT_EQ(1, bus.openSessions);
+  // device IDs 1 and 2 differ in the low two bits
+  EXPECT_EQ(0x1FFFFFFCu, bus.sessionMask);
+
+  auto frame = [&](int32_t deviceId, uint8_t value) {
+    HAL_CANStreamMessage msg{};
+    msg.messageID = (bus.sessionId & ~0x3Fu) | deviceId;
+    msg.timeStamp = value;
+    msg.data[0] = value;
+    msg.dataSize = 1;
+    return msg;
+  };
+  bus.frames = {frame(1, 10), frame(2, 20), frame(3, 30), frame(1, 11)};
+
+  uint8_t data[8];
+  int32_t length;
+  uint64_t timestamp;
+  HAL_ReadCANPacketQueued(device1.handle, apiId, data, &length, &timestamp,
+                          &status);
+  ASSERT_EQ(0, status);
+  EXPECT_EQ(1, length);
+  EXPECT_EQ(10, data[0]);
+  EXPECT_EQ(1, bus.streamReads);
+
+  // the other frames were queued by the same stream read
+  HAL_ReadCANPacketLatest(device2.handle, apiId, data, &length, &timestamp,
+                          &status);
+  ASSERT_EQ(0, status);
+  EXPECT_EQ(20, data[0]);
+  HAL_ReadCANPacketQueued(device1.handle, apiId, data, &length, &timestamp,
+                          &status);
+  ASSERT_EQ(0, status);
+  EXPECT_EQ(11, data[0]);
+  EXPECT_EQ(1, bus.streamReads);
+
+  // nothing new
+  HAL_ReadCANPacketQueued(device1.handle, apiId, data, &length, &timestamp,
+                          &status);
+  EXPECT_EQ(HAL_ERR_CANSessionMux_MessageNotFound, status);
+  EXPECT_EQ(2, bus.streamReads);
+
+  // reading new packets gets the newest one and discards the rest
+  status = 0;
+  bus.frames = {frame(1, 12), frame(1, 13)};
+  HAL_ReadCANPacketNew(device1.handle, apiId, data, &length, &timestamp,
+                       &status);
+  ASSERT_EQ(0, status);
+  EXPECT_EQ(13, data[0]);
+  HAL_ReadCANPacketNew(device1.handle, apiId, data, &length, &timestamp,
+                       &status);
+  EXPECT_EQ(HAL_ERR_CANSessionMux_MessageNotFound, status);
+  EXPECT_EQ(0, bus.receives);
+
+  status = 0;
+  HAL_StopCANReceiveDispatch(device1.handle, apiId, &status);
+  EXPECT_EQ(1, bus.openSessions);
+  EXPECT_EQ(0x1FFFFFFFu, bus.sessionMask);
+  HAL_StopCANReceiveDispatch(device2.handle, apiId, &status);
+  EXPECT_EQ(0, bus.openSessions);
+
+  // not dispatched any more
+  HAL_ReadCANPacketNew(device1.handle, apiId, data, &length, &timestamp,
+                       &status);
+  EXPECT_EQ(1, bus.receives);
+
+  HALSIM_CancelCanOpenStreamCallback(openHandle);
+  HALSIM_CancelCanCloseStreamCallback(closeHandle);
+  HALSIM_CancelCanReadStreamCallback(readHandle);
+  HALSIM_CancelCanReceiveMessageCallback(receiveHandle);
+}
 }  // namespace hal
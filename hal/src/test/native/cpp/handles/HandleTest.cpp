@@ -2,16 +2,31 @@
 // Open Source Software; you can modify and/or share it under the terms of
 // the WPILib BSD license file in the root directory of this project.
 
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <thread>
 
 #include <gtest/gtest.h>
 
 #include "hal/handles/IndexedClassedHandleResource.h"
+#include "hal/handles/IndexedHandleResource.h"
+#include "hal/handles/LimitedHandleResource.h"
+#include "hal/handles/UnlimitedHandleResource.h"
 
 #define HAL_TestHandle HAL_Handle
 
 namespace {
 class MyTestClass {};
+
+struct MyTestStruct {
+  ~MyTestStruct() {
+    if (destroyed) {
+      *destroyed = true;
+    }
+  }
+  std::atomic<bool>* destroyed = nullptr;
+};
 }  // namespace
 
 namespace hal {
@@ -24,4 +39,74 @@ TEST(HandleTest, ClassedHandle) {
   EXPECT_EQ(0, status);
 }
 
+TEST(HandleTest, IndexedGetRef) {
+  hal::IndexedHandleResource<HAL_TestHandle, MyTestStruct, 8,
+                             HAL_HandleEnum::Vendor>
+      resource;
+  std::atomic<bool> destroyed{false};
+  int32_t status = 0;
+  HAL_TestHandle handle;
+  auto structure = resource.Allocate(3, &handle, &status);
+  ASSERT_EQ(0, status);
+  structure->destroyed = &destroyed;
+  structure.reset();
+
+  {
+    auto ref = resource.GetRef(handle);
+    ASSERT_TRUE(ref);
+    EXPECT_EQ(ref->destroyed, &destroyed);
+  }
+  EXPECT_FALSE(resource.GetRef(HAL_kInvalidHandle));
+
+  resource.Free(handle);
+  EXPECT_TRUE(destroyed);
+  EXPECT_FALSE(resource.GetRef(handle));
+}
+
+TEST(HandleTest, LimitedFreeWaitsForReaders) {
+  hal::LimitedHandleResource<HAL_TestHandle, MyTestStruct, 8,
+                             HAL_HandleEnum::Vendor>
+      resource;
+  std::atomic<bool> destroyed{false};
+  auto handle = resource.Allocate();
+  resource.Get(handle)->destroyed = &destroyed;
+
+  std::atomic<bool> reading{false};
+  std::atomic<bool> done{false};
+  std::thread reader{[&] {
+    auto ref = resource.GetRef(handle);
+    reading = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    // still valid, as Free() waits for this reference
+    EXPECT_FALSE(destroyed);
+    done = true;
+  }};
+  while (!reading) {
+    std::this_thread::yield();
+  }
+  resource.Free(handle);
+  EXPECT_TRUE(done);
+  EXPECT_TRUE(destroyed);
+  reader.join();
+}
+
+TEST(HandleTest, UnlimitedGetRef) {
+  hal::UnlimitedHandleResource<HAL_TestHandle, MyTestStruct,
+                               HAL_HandleEnum::Vendor>
+      resource;
+  std::atomic<bool> destroyed{false};
+  HAL_TestHandle handle = HAL_kInvalidHandle;
+  for (int i = 0; i < 100; ++i) {
+    handle = resource.Allocate(std::make_shared<MyTestStruct>());
+  }
+  resource.Get(handle)->destroyed = &destroyed;
+  EXPECT_EQ(resource.GetRef(handle)->destroyed, &destroyed);
+
+  auto structure = resource.Free(handle);
+  EXPECT_FALSE(resource.GetRef(handle));
+  EXPECT_FALSE(destroyed);
+  structure.reset();
+  EXPECT_TRUE(destroyed);
+}
+
 }  // namespace hal
@@ -0,0 +1,99 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <wpi/mutex.h>
+
+#include "hal/HAL.h"
+#include "hal/Notifier.h"
+#include "hal/simulation/MockHooks.h"
+#include "hal/simulation/NotifierData.h"
+
+namespace hal {
+
+TEST(NotifierSimTest, StepTimingRunsAlarmsInOrder) {
+  HALSIM_PauseTiming();
+  HALSIM_RestartTiming();
+
+  // alarm offsets; notifiers with equal times run in handle order
+  const uint64_t offsets[] = {3000, 1000, 2000, 1000};
+  int32_t status = 0;
+  uint64_t start = HAL_GetFPGATime(&status);
+
+  wpi::mutex mutex;
+  std::vector<int> order;
+  std::vector<HAL_NotifierHandle> handles;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    handles.emplace_back(HAL_InitializeNotifier(&status));
+    ASSERT_EQ(0, status);
+    HAL_UpdateNotifierAlarm(handles.back(), start + offsets[i], &status);
+  }
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&, i] {
+      int32_t status = 0;
+      while (HAL_WaitForNotifierAlarm(handles[i], &status) != 0) {
+        std::scoped_lock lock(mutex);
+        order.emplace_back(i);
+      }
+    });
+  }
+
+  HALSIM_StepTiming(2500);
+  {
+    std::scoped_lock lock(mutex);
+    EXPECT_EQ((std::vector<int>{1, 3, 2}), order);
+  }
+  EXPECT_EQ(start + 3000, HALSIM_GetNextNotifierTimeout());
+
+  HALSIM_StepTiming(1000);
+  {
+    std::scoped_lock lock(mutex);
+    EXPECT_EQ((std::vector<int>{1, 3, 2, 0}), order);
+  }
+  EXPECT_EQ(UINT64_MAX, HALSIM_GetNextNotifierTimeout());
+
+  for (int i = 0; i < 4; ++i) {
+    HAL_StopNotifier(handles[i], &status);
+  }
+  for (auto&& thread : threads) {
+    thread.join();
+  }
+  for (auto handle : handles) {
+    HAL_CleanNotifier(handle);
+  }
+  HALSIM_ResumeTiming();
+}
+
+TEST(NotifierSimTest, FastTiming) {
+  int32_t status = 0;
+  HAL_NotifierHandle handle = HAL_InitializeNotifier(&status);
+  ASSERT_EQ(0, status);
+
+  HALSIM_SetFastTiming(true);
+  EXPECT_TRUE(HALSIM_IsFastTiming());
+  uint64_t start = HAL_GetFPGATime(&status);
+  auto wallStart = std::chrono::steady_clock::now();
+
+  // 10 seconds of 20 ms periodic loops
+  uint64_t triggerTime = start;
+  for (int i = 0; i < 500; ++i) {
+    triggerTime += 20000;
+    HAL_UpdateNotifierAlarm(handle, triggerTime, &status);
+    ASSERT_EQ(triggerTime, HAL_WaitForNotifierAlarm(handle, &status));
+  }
+  EXPECT_LT(std::chrono::steady_clock::now() - wallStart,
+            std::chrono::seconds(5));
+
+  HALSIM_SetFastTiming(false);
+  EXPECT_FALSE(HALSIM_IsFastTiming());
+  EXPECT_FALSE(HALSIM_IsTimingPaused());
+  HAL_CleanNotifier(handle);
+}
+
+}  // namespace hal
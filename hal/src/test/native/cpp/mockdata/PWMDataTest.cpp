@@ -79,4 +79,36 @@ TEST(PWMSimTest, PwmInitialization) {
   EXPECT_STREQ("Initialized", gTestPwmCallbackName.c_str());
   HALSIM_CancelPWMInitializedCallback(INDEX_TO_TEST, callbackId);
 }
+
+TEST(PWMSimTest, SpeedCallback) {
+  const int INDEX_TO_TEST = 3;
+  HALSIM_ResetPWMData(INDEX_TO_TEST);
+
+  // without callbacks, the value is still stored
+  HALSIM_SetPWMSpeed(INDEX_TO_TEST, 0.5);
+  EXPECT_EQ(0.5, HALSIM_GetPWMSpeed(INDEX_TO_TEST));
+
+  int callbackParam = 0;
+  gTestPwmCallbackName = "Unset";
+  int callbackId = HALSIM_RegisterPWMSpeedCallback(
+      INDEX_TO_TEST, &TestPwmInitializationCallback, &callbackParam, true);
+  ASSERT_TRUE(0 != callbackId);
+  EXPECT_STREQ("Speed", gTestPwmCallbackName.c_str());
+  EXPECT_EQ(0.5, gTestPwmCallbackValue.data.v_double);
+
+  HALSIM_SetPWMSpeed(INDEX_TO_TEST, -0.25);
+  EXPECT_EQ(-0.25, gTestPwmCallbackValue.data.v_double);
+
+  // setting the same value doesn't notify
+  gTestPwmCallbackName = "Unset";
+  HALSIM_SetPWMSpeed(INDEX_TO_TEST, -0.25);
+  EXPECT_STREQ("Unset", gTestPwmCallbackName.c_str());
+
+  // nor does setting a value after the callback is canceled
+  HALSIM_CancelPWMSpeedCallback(INDEX_TO_TEST, callbackId);
+  HALSIM_SetPWMSpeed(INDEX_TO_TEST, 1.0);
+  EXPECT_STREQ("Unset", gTestPwmCallbackName.c_str());
+  EXPECT_EQ(1.0, HALSIM_GetPWMSpeed(INDEX_TO_TEST));
+  HALSIM_ResetPWMData(INDEX_TO_TEST);
+}
 }  // namespace hal
@@ -0,0 +1,357 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+// Throughput/latency benchmark for ntcore.  Runs an in-process server and
+// one or more NT4 clients connected over loopback; the server publishes and
+// the clients subscribe.  For each combination of topic count, value type,
+// and pub/sub options, reports publish-to-receive latency percentiles,
+// received messages per second, process CPU time per received message, and
+// resident memory per topic (Linux only).
+//
+// Usage: ntcoreBenchmark [--quick] [--clients N] [--port N]
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+#include <wpi/StringExtras.h>
+#include <wpi/mutex.h>
+#include <wpi/print.h>
+#include <wpi/timestamp.h>
+
+#include "ntcore_cpp.h"
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+using namespace std::chrono_literals;
+
+namespace {
+
+struct ValueType {
+  std::string_view name;
+  NT_Type type;
+  std::string_view typeStr;
+};
+
+constexpr ValueType kValueTypes[] = {
+    {"double", NT_DOUBLE, "double"},
+    {"string", NT_STRING, "string"},
+    {"double[8]", NT_DOUBLE_ARRAY, "double[]"},
+};
+
+struct Options {
+  std::string_view name;
+  nt::PubSubOptions options;
+};
+
+const Options kOptions[] = {
+    {"default", {}},
+    {"periodic=10ms", {.periodic = 0.01}},
+    {"sendAll", {.sendAll = true}},
+    {"sendAll+keepDup", {.sendAll = true, .keepDuplicates = true}},
+};
+
+constexpr int kFullTopicCounts[] = {1, 10, 100, 1000};
+constexpr int kQuickTopicCounts[] = {1, 100};
+
+// publish rounds per case, and time between rounds
+constexpr int kFullRounds = 200;
+constexpr int kQuickRounds = 50;
+constexpr auto kRoundPeriod = 5ms;
+
+// the send time (in wpi::Now() microseconds) is encoded into every value
+nt::Value MakeValue(NT_Type type, int64_t sendTime) {
+  switch (type) {
+    case NT_DOUBLE:
+      return nt::Value::MakeDouble(static_cast<double>(sendTime));
+    case NT_STRING:
+      return nt::Value::MakeString(fmt::format("{}", sendTime));
+    case NT_DOUBLE_ARRAY: {
+      std::vector<double> arr(8, 0.0);
+      arr[0] = static_cast<double>(sendTime);
+      return nt::Value::MakeDoubleArray(std::move(arr));
+    }
+    default:
+      return {};
+  }
+}
+
+int64_t GetSendTime(const nt::Value& value) {
+  switch (value.type()) {
+    case NT_DOUBLE:
+      return static_cast<int64_t>(value.GetDouble());
+    case NT_STRING:
+      return wpi::parse_integer<int64_t>(value.GetString(), 10).value_or(0);
+    case NT_DOUBLE_ARRAY: {
+      auto arr = value.GetDoubleArray();
+      return arr.empty() ? 0 : static_cast<int64_t>(arr[0]);
+    }
+    default:
+      return 0;
+  }
+}
+
+// resident set size in bytes, or 0 if unknown
+size_t GetResidentBytes() {
+#ifdef __linux__
+  std::FILE* f = std::fopen("/proc/self/statm", "r");
+  if (!f) {
+    return 0;
+  }
+  unsigned long size = 0;      // NOLINT(runtime/int)
+  unsigned long resident = 0;  // NOLINT(runtime/int)
+  int n = std::fscanf(f, "%lu %lu", &size, &resident);
+  std::fclose(f);
+  if (n != 2) {
+    return 0;
+  }
+  return static_cast<size_t>(resident) * sysconf(_SC_PAGESIZE);
+#else
+  return 0;
+#endif
+}
+
+double GetCpuSeconds() {
+  return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+}
+
+struct Client {
+  NT_Inst inst;
+  NT_MultiSubscriber sub{0};
+  NT_Listener listener{0};
+
+  wpi::mutex mutex;
+  std::vector<int64_t> latencies;
+  std::atomic<int64_t> received{0};
+  std::atomic<int64_t> lastReceivedTime{0};
+};
+
+struct Result {
+  int64_t received = 0;
+  double elapsed = 0;
+  double cpu = 0;
+  std::vector<int64_t> latencies;
+  size_t memBytes = 0;
+};
+
+template <typename Pred>
+bool WaitFor(Pred&& pred, std::chrono::milliseconds timeout) {
+  auto end = std::chrono::steady_clock::now() + timeout;
+  while (!pred()) {
+    if (std::chrono::steady_clock::now() >= end) {
+      return false;
+    }
+    std::this_thread::sleep_for(1ms);
+  }
+  return true;
+}
+
+Result RunCase(NT_Inst server, std::vector<std::unique_ptr<Client>>& clients,
+               int caseNum, int topicCount, const ValueType& valueType,
+               const Options& options, int rounds) {
+  Result result;
+  std::string prefix = fmt::format("/bench/{}/", caseNum);
+  size_t memBefore = GetResidentBytes();
+
+  // subscribe
+  std::string_view prefixes[] = {prefix};
+  for (auto&& client : clients) {
+    client->latencies.clear();
+    client->received = 0;
+    client->sub =
+        nt::SubscribeMultiple(client->inst, prefixes, options.options);
+    client->listener = nt::AddListener(
+        client->sub, NT_EVENT_VALUE_REMOTE, [c = client.get()](auto& event) {
+          auto now = wpi::Now();
+          if (auto data = event.GetValueEventData()) {
+            int64_t latency = now - GetSendTime(data->value);
+            std::scoped_lock lock{c->mutex};
+            c->latencies.emplace_back(latency);
+          }
+          ++c->received;
+          c->lastReceivedTime = now;
+        });
+  }
+
+  // publish
+  std::vector<NT_Publisher> pubs;
+  pubs.reserve(topicCount);
+  for (int i = 0; i < topicCount; ++i) {
+    pubs.emplace_back(nt::Publish(
+        nt::GetTopic(server, fmt::format("{}{}", prefix, i)), valueType.type,
+        valueType.typeStr, options.options));
+  }
+
+  // send an initial value and wait for it to reach every client
+  for (auto pub : pubs) {
+    nt::SetEntryValue(pub, MakeValue(valueType.type, wpi::Now()));
+  }
+  nt::Flush(server);
+  for (auto&& client : clients) {
+    if (!WaitFor([&] { return client->received >= topicCount; }, 5s)) {
+      wpi::print(stderr, "timed out waiting for initial values\n");
+    }
+  }
+  size_t memAfter = GetResidentBytes();
+  if (memBefore != 0 && memAfter > memBefore) {
+    result.memBytes = memAfter - memBefore;
+  }
+  for (auto&& client : clients) {
+    std::scoped_lock lock{client->mutex};
+    client->latencies.clear();
+    client->received = 0;
+  }
+
+  // benchmark
+  double cpuStart = GetCpuSeconds();
+  int64_t start = wpi::Now();
+  for (int round = 0; round < rounds; ++round) {
+    for (auto pub : pubs) {
+      nt::SetEntryValue(pub, MakeValue(valueType.type, wpi::Now()));
+    }
+    nt::FlushLocal(server);
+    std::this_thread::sleep_for(kRoundPeriod);
+  }
+
+  // wait for received count to stop changing
+  int64_t prevReceived = -1;
+  for (;;) {
+    int64_t received = 0;
+    for (auto&& client : clients) {
+      received += client->received;
+    }
+    if (received == prevReceived) {
+      break;
+    }
+    prevReceived = received;
+    std::this_thread::sleep_for(200ms);
+  }
+  result.cpu = GetCpuSeconds() - cpuStart;
+  // up to the last value received (excludes the idle wait above)
+  int64_t stop = start;
+  for (auto&& client : clients) {
+    stop = (std::max)(stop, client->lastReceivedTime.load());
+  }
+  result.elapsed = (stop - start) * 1e-6;
+
+  // clean up
+  for (auto pub : pubs) {
+    nt::Unpublish(pub);
+  }
+  for (auto&& client : clients) {
+    nt::RemoveListener(client->listener);
+    nt::UnsubscribeMultiple(client->sub);
+    std::scoped_lock lock{client->mutex};
+    result.received += client->received;
+    result.latencies.insert(result.latencies.end(), client->latencies.begin(),
+                            client->latencies.end());
+  }
+  std::sort(result.latencies.begin(), result.latencies.end());
+  return result;
+}
+
+int64_t Percentile(const std::vector<int64_t>& sorted, double p) {
+  if (sorted.empty()) {
+    return 0;
+  }
+  size_t i = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+  return sorted[i];
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  bool quick = false;
+  int numClients = 1;
+  unsigned int port = 5820;
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg{argv[i]};
+    if (arg == "--quick") {
+      quick = true;
+    } else if (arg == "--clients" && i + 1 < argc) {
+      numClients = wpi::parse_integer<int>(argv[++i], 10).value_or(1);
+    } else if (arg == "--port" && i + 1 < argc) {
+      port = wpi::parse_integer<unsigned int>(argv[++i], 10).value_or(port);
+    } else {
+      wpi::print(stderr,
+                 "usage: {} [--quick] [--clients N] [--port N]\n", argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (numClients < 1) {
+    numClients = 1;
+  }
+
+  // set up instances
+  auto server = nt::CreateInstance();
+  nt::StartServer(server, "ntcoreBenchmark.json", "127.0.0.1", 0, port);
+  std::vector<std::unique_ptr<Client>> clients;
+  for (int i = 0; i < numClients; ++i) {
+    auto client = std::make_unique<Client>();
+    client->inst = nt::CreateInstance();
+    nt::StartClient4(client->inst, fmt::format("bench{}", i));
+    nt::SetServer(client->inst, "127.0.0.1", port);
+    clients.emplace_back(std::move(client));
+  }
+  if (!WaitFor(
+          [&] {
+            return nt::GetConnections(server).size() ==
+                   static_cast<size_t>(numClients);
+          },
+          10s)) {
+    wpi::print(stderr, "clients failed to connect\n");
+    return EXIT_FAILURE;
+  }
+
+  std::span<const int> topicCounts =
+      quick ? std::span<const int>{kQuickTopicCounts}
+            : std::span<const int>{kFullTopicCounts};
+  int rounds = quick ? kQuickRounds : kFullRounds;
+
+  wpi::print("{} client(s), {} rounds every {} ms\n", numClients, rounds,
+             kRoundPeriod.count());
+  wpi::print("{:>6} {:<10} {:<16} {:>10} {:>8} {:>8} {:>8} {:>8} {:>9} {:>9}\n",
+             "topics", "type", "options", "msgs/s", "p50 us", "p90 us",
+             "p99 us", "max us", "cpu us/m", "B/topic");
+  int caseNum = 0;
+  for (int topicCount : topicCounts) {
+    for (auto&& valueType : kValueTypes) {
+      for (auto&& options : kOptions) {
+        auto r = RunCase(server, clients, caseNum++, topicCount, valueType,
+                         options, rounds);
+        std::string mem =
+            r.memBytes == 0 ? "-" : fmt::format("{}", r.memBytes / topicCount);
+        wpi::print(
+            "{:>6} {:<10} {:<16} {:>10.0f} {:>8} {:>8} {:>8} {:>8} {:>9.2f} "
+            "{:>9}\n",
+            topicCount, valueType.name, options.name,
+            r.elapsed > 0 ? r.received / r.elapsed : 0.0,
+            Percentile(r.latencies, 0.5), Percentile(r.latencies, 0.9),
+            Percentile(r.latencies, 0.99),
+            r.latencies.empty() ? 0 : r.latencies.back(),
+            r.received == 0 ? 0.0 : r.cpu * 1e6 / r.received, mem);
+      }
+    }
+  }
+
+  for (auto&& client : clients) {
+    nt::DestroyInstance(client->inst);
+  }
+  nt::DestroyInstance(server);
+  return EXIT_SUCCESS;
+}
@@ -1208,6 +1208,18 @@ public final class NetworkTableInstance implements AutoCloseable {
     NetworkTablesJNI.stopServer(m_handle);
   }
 
+  /**
+   * Sets the number of I/O threads the server uses for NT4 client connections. With the default of
+   * 1, all connections are serviced by the single server thread. Larger values spread NT4 client
+   * connections across that many additional event loop threads. Takes effect the next time the
+   * server is started. Ignored on Windows.
+   *
+   * @param count number of I/O threads
+   */
+  public void setServerIoThreads(int count) {
+    NetworkTablesJNI.setServerIoThreads(m_handle, count);
+  }
+
   /**
    * Starts a NT3 client. Use SetServer or SetServerTeam to set the server name and port.
    *
@@ -1259,6 +1259,27 @@ public final class NetworkTablesJNI {
    */
   public static native NetworkTableValue getValue(int entry);
 
+  /**
+   * Sets the values of multiple double entries or publishers in one call.
+   * This is much faster than calling setDouble for each entry.
+   *
+   * @param entries Entry or publisher handles.
+   * @param time Time in microseconds (0 for current time).
+   * @param values Values; must be the same length as entries.
+   * @return True if all sets succeeded.
+   */
+  public static native boolean setDoubles(int[] entries, long time, double[] values);
+
+  /**
+   * Gets the values of multiple double entries or subscribers in one call.
+   * This is much faster than calling getDouble for each entry.
+   *
+   * @param entries Entry or subscriber handles.
+   * @param defaultValue Value used for entries with no double value.
+   * @param values Array to store the values into; must be the same length as entries.
+   */
+  public static native void getDoubles(int[] entries, double defaultValue, double[] values);
+
   /**
    * Sets entry flags.
    *
@@ -1417,6 +1438,15 @@ public final class NetworkTablesJNI {
    */
   public static native void stopServer(int inst);
 
+  /**
+   * Sets the number of I/O threads the server uses for NT4 client connections. Takes effect the
+   * next time the server is started. Ignored on Windows.
+   *
+   * @param inst NT instance handle.
+   * @param count number of I/O threads
+   */
+  public static native void setServerIoThreads(int inst, int count);
+
   /**
    * Starts a NT3 client. Use SetServer or SetServerTeam to set the server name and port.
    *
@@ -165,6 +165,23 @@ class DoubleArraySubscriber : public Subscriber {
     return ::nt::ReadQueueDoubleArray(m_subHandle);
   }
 
+  /**
+   * Get an array of all value changes since the last call to ReadQueue.
+   * Also provides a timestamp for each value. Reuses the capacity of buf, so
+   * for scalar types repeated calls with the same buf do not allocate once it
+   * has grown to the queue depth. Array, string, and raw values reuse the
+   * storage of the elements of buf they overwrite; elements left over when
+   * fewer values are read are destroyed along with their storage.
+   *
+   * @note The "poll storage" subscribe option can be used to set the queue
+   *     depth.
+   *
+   * @param buf storage for timestamped values; replaced with the values read
+   */
+  void ReadQueue(std::vector<TimestampedValueType>& buf) {
+    ::nt::ReadQueueDoubleArray(m_subHandle, buf);
+  }
+
   /**
    * Get the corresponding topic.
    *
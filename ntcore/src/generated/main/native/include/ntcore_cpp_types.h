@@ -113,6 +113,25 @@ TimestampedBoolean GetAtomicBoolean(NT_Handle subentry, bool defaultValue);
  */
 std::vector<TimestampedBoolean> ReadQueueBoolean(NT_Handle subentry);
 
+/**
+ * Get an array of all value changes since the last call to ReadQueue.
+ * Also provides a timestamp for each value. Unlike the returning version,
+ * this reuses the capacity of buf, so for scalar types repeated calls with the
+ * same buf do not allocate once it has grown to the queue depth. Array, string,
+ * and raw values reuse the storage of the elements of buf they overwrite;
+ * elements left over when fewer values are read are destroyed along with their
+ * storage.
+ *
+ * @note The "poll storage" subscribe option can be used to set the queue
+ *     depth.
+ *
+ * @param subentry subscriber or entry handle
+ * @param buf storage for timestamped values; replaced with the values read,
+ *     or cleared if no new changes have been published since the previous
+ *     call.
+ */
+void ReadQueueBoolean(NT_Handle subentry, std::vector<TimestampedBoolean>& buf);
+
 /**
  * Get an array of all value changes since the last call to ReadQueue.
  *
@@ -192,6 +211,25 @@ TimestampedInteger GetAtomicInteger(NT_Handle subentry, int64_t defaultValue);
  */
 std::vector<TimestampedInteger> ReadQueueInteger(NT_Handle subentry);
 
+/**
+ * Get an array of all value changes since the last call to ReadQueue.
+ * Also provides a timestamp for each value. Unlike the returning version,
+ * this reuses the capacity of buf, so for scalar types repeated calls with the
+ * same buf do not allocate once it has grown to the queue depth. Array, string,
+ * and raw values reuse the storage of the elements of buf they overwrite;
+ * elements left over when fewer values are read are destroyed along with their
+ * storage.
+ *
+ * @note The "poll storage" subscribe option can be used to set the queue
+ *     depth.
+ *
+ * @param subentry subscriber or entry handle
+ * @param buf storage for timestamped values; replaced with the values read,
+ *     or cleared if no new changes have been published since the previous
+ *     call.
+ */
+void ReadQueueInteger(NT_Handle subentry, std::vector<TimestampedInteger>& buf);
+
 /**
  * Get an array of all value changes since the last call to ReadQueue.
  *
@@ -271,6 +309,25 @@ TimestampedFloat GetAtomicFloat(NT_Handle subentry, float defaultValue);
  */
 std::vector<TimestampedFloat> ReadQueueFloat(NT_Handle subentry);
 
+/**
+ * Get an array of all value changes since the last call to ReadQueue.
+ * Also provides a timestamp for each value. Unlike the returning version,
+ * this reuses the capacity of buf, so for scalar types repeated calls with the
+ * same buf do not allocate once it has grown to the queue depth. Array, string,
+ * and raw values reuse the storage of the elements of buf they overwrite;
+ * elements left over when fewer values are read are destroyed along with their
+ * storage.
+ *
+ * @note The "poll storage" subscribe option can be used to set the queue
+ *     depth.
+ *
+ * @param subentry subscriber or entry handle
+ * @param buf storage for timestamped values; replaced with the values read,
+ *     or cleared if no new changes have been published since the previous
+ *     call.
+ */
+void ReadQueueFloat(NT_Handle subentry, std::vector<TimestampedFloat>& buf);
+
 /**
  * Get an array of all value changes since the last call to ReadQueue.
  *
@@ -350,6 +407,25 @@ TimestampedDouble GetAtomicDouble(NT_Handle subentry, double defaultValue);
  */
 std::vector<TimestampedDouble> ReadQueueDouble(NT_Handle subentry);
 
+/**
+ * Get an array of all value changes since the last call to ReadQueue.
+ * Also provides a timestamp for each value. Unlike the returning version,
+ * this reuses the capacity of buf, so for scalar types repeated calls with the
+ * same buf do not allocate once it has grown to the queue depth. Array, string,
+ * and raw values reuse the storage of the elements of buf they overwrite;
+ * elements left over when fewer values are read are destroyed along with their
+ * storage.
+ *
+ * @note The "poll storage" subscribe option can be used to set the queue
+ *     depth.
+ *
+ * @param subentry subscriber or entry handle
+ * @param buf storage for timestamped values; replaced with the values read,
+ *     or cleared if no new changes have been published since the previous
+ *     call.
+ */
+void ReadQueueDouble(NT_Handle subentry, std::vector<TimestampedDouble>& buf);
+
 /**
  * Get an array of all value changes since the last call to ReadQueue.
  *
@@ -435,6 +511,25 @@ TimestampedString GetAtomicString(NT_Handle subentry, std::string_view defaultVa
  */
 std::vector<TimestampedString> ReadQueueString(NT_Handle subentry);
 
+/**
+ * Get an array of all value changes since the last call to ReadQueue.
+ * Also provides a timestamp for each value. Unlike the returning version,
+ * this reuses the capacity of buf, so for scalar types repeated calls with the
+ * same buf do not allocate once it has grown to the queue depth. Array, string,
+ * and raw values reuse the storage of the elements of buf they overwrite;
+ * elements left over when fewer values are read are destroyed along with their
+ * storage.
+ *
+ * @note The "poll storage" subscribe option can be used to set the queue
+ *     depth.
+ *
+ * @param subentry subscriber or entry handle
+ * @param buf storage for timestamped values; replaced with the values read,
+ *     or cleared if no new changes have been published since the previous
+ *     call.
+ */
+void ReadQueueString(NT_Handle subentry, std::vector<TimestampedString>& buf);
+
 /**
  * Get an array of all value changes since the last call to ReadQueue.
  *
@@ -527,6 +622,25 @@ TimestampedRaw GetAtomicRaw(NT_Handle subentry, std::span<const uint8_t> default
  */
 std::vector<TimestampedRaw> ReadQueueRaw(NT_Handle subentry);
 
+/**
+ * Get an array of all value changes since the last call to ReadQueue.
+ * Also provides a timestamp for each value. Unlike the returning version,
+ * this reuses the capacity of buf, so for scalar types repeated calls with the
+ * same buf do not allocate once it has grown to the queue depth. Array, string,
+ * and raw values reuse the storage of the elements of buf they overwrite;
+ * elements left over when fewer values are read are destroyed along with their
+ * storage.
+ *
+ * @note The "poll storage" subscribe option can be used to set the queue
+ *     depth.
+ *
+ * @param subentry subscriber or entry handle
+ * @param buf storage for timestamped values; replaced with the values read,
+ *     or cleared if no new changes have been published since the previous
+ *     call.
+ */
+void ReadQueueRaw(NT_Handle subentry, std::vector<TimestampedRaw>& buf);
+
 /**
  * Get an array of all value changes since the last call to ReadQueue.
  *
@@ -619,6 +733,25 @@ TimestampedBooleanArray GetAtomicBooleanArray(NT_Handle subentry, std::span<cons
  */
 std::vector<TimestampedBooleanArray> ReadQueueBooleanArray(NT_Handle subentry);
 
+/**
+ * Get an array of all value changes since the last call to ReadQueue.
+ * Also provides a timestamp for each value. Unlike the returning version,
+ * this reuses the capacity of buf, so for scalar types repeated calls with the
+ * same buf do not allocate once it has grown to the queue depth. Array, string,
+ * and raw values reuse the storage of the elements of buf they overwrite;
+ * elements left over when fewer values are read are destroyed along with their
+ * storage.
+ *
+ * @note The "poll storage" subscribe option can be used to set the queue
+ *     depth.
+ *
+ * @param subentry subscriber or entry handle
+ * @param buf storage for timestamped values; replaced with the values read,
+ *     or cleared if no new changes have been published since the previous
+ *     call.
+ */
+void ReadQueueBooleanArray(NT_Handle subentry, std::vector<TimestampedBooleanArray>& buf);
+
 /**
  * Get an array of all value changes since the last call to ReadQueue.
  *
@@ -711,6 +844,25 @@ TimestampedIntegerArray GetAtomicIntegerArray(NT_Handle subentry, std::span<cons
  */
 std::vector<TimestampedIntegerArray> ReadQueueIntegerArray(NT_Handle subentry);
 
+/**
+ * Get an array of all value changes since the last call to ReadQueue.
+ * Also provides a timestamp for each value. Unlike the returning version,
+ * this reuses the capacity of buf, so for scalar types repeated calls with the
+ * same buf do not allocate once it has grown to the queue depth. Array, string,
+ * and raw values reuse the storage of the elements of buf they overwrite;
+ * elements left over when fewer values are read are destroyed along with their
+ * storage.
+ *
+ * @note The "poll storage" subscribe option can be used to set the queue
+ *     depth.
+ *
+ * @param subentry subscriber or entry handle
+ * @param buf storage for timestamped values; replaced with the values read,
+ *     or cleared if no new changes have been published since the previous
+ *     call.
+ */
+void ReadQueueIntegerArray(NT_Handle subentry, std::vector<TimestampedIntegerArray>& buf);
+
 /**
  * Get an array of all value changes since the last call to ReadQueue.
  *
@@ -803,6 +955,25 @@ TimestampedFloatArray GetAtomicFloatArray(NT_Handle subentry, std::span<const fl
  */
 std::vector<TimestampedFloatArray> ReadQueueFloatArray(NT_Handle subentry);
 
+/**
+ * Get an array of all value changes since the last call to ReadQueue.
+ * Also provides a timestamp for each value. Unlike the returning version,
+ * this reuses the capacity of buf, so for scalar types repeated calls with the
+ * same buf do not allocate once it has grown to the queue depth. Array, string,
+ * and raw values reuse the storage of the elements of buf they overwrite;
+ * elements left over when fewer values are read are destroyed along with their
+ * storage.
+ *
+ * @note The "poll storage" subscribe option can be used to set the queue
+ *     depth.
+ *
+ * @param subentry subscriber or entry handle
+ * @param buf storage for timestamped values; replaced with the values read,
+ *     or cleared if no new changes have been published since the previous
+ *     call.
+ */
+void ReadQueueFloatArray(NT_Handle subentry, std::vector<TimestampedFloatArray>& buf);
+
 /**
  * Get an array of all value changes since the last call to ReadQueue.
  *
@@ -895,6 +1066,25 @@ TimestampedDoubleArray GetAtomicDoubleArray(NT_Handle subentry, std::span<const
  */
 std::vector<TimestampedDoubleArray> ReadQueueDoubleArray(NT_Handle subentry);
 
+/**
+ * Get an array of all value changes since the last call to ReadQueue.
+ * Also provides a timestamp for each value. Unlike the returning version,
+ * this reuses the capacity of buf, so for scalar types repeated calls with the
+ * same buf do not allocate once it has grown to the queue depth. Array, string,
+ * and raw values reuse the storage of the elements of buf they overwrite;
+ * elements left over when fewer values are read are destroyed along with their
+ * storage.
+ *
+ * @note The "poll storage" subscribe option can be used to set the queue
+ *     depth.
+ *
+ * @param subentry subscriber or entry handle
+ * @param buf storage for timestamped values; replaced with the values read,
+ *     or cleared if no new changes have been published since the previous
+ *     call.
+ */
+void ReadQueueDoubleArray(NT_Handle subentry, std::vector<TimestampedDoubleArray>& buf);
+
 /**
  * Get an array of all value changes since the last call to ReadQueue.
  *
@@ -981,6 +1171,25 @@ TimestampedStringArray GetAtomicStringArray(NT_Handle subentry, std::span<const
  */
 std::vector<TimestampedStringArray> ReadQueueStringArray(NT_Handle subentry);
 
+/**
+ * Get an array of all value changes since the last call to ReadQueue.
+ * Also provides a timestamp for each value. Unlike the returning version,
+ * this reuses the capacity of buf, so for scalar types repeated calls with the
+ * same buf do not allocate once it has grown to the queue depth. Array, string,
+ * and raw values reuse the storage of the elements of buf they overwrite;
+ * elements left over when fewer values are read are destroyed along with their
+ * storage.
+ *
+ * @note The "poll storage" subscribe option can be used to set the queue
+ *     depth.
+ *
+ * @param subentry subscriber or entry handle
+ * @param buf storage for timestamped values; replaced with the values read,
+ *     or cleared if no new changes have been published since the previous
+ *     call.
+ */
+void ReadQueueStringArray(NT_Handle subentry, std::vector<TimestampedStringArray>& buf);
+
 /**
  * Get an array of all value changes since the last call to ReadQueue.
  *
@@ -16,7 +16,9 @@ public class PubSubOption {
     disableLocal,
     excludePublisher,
     excludeSelf,
-    hidden
+    hidden,
+    deltaArrays,
+    coalescePeriod
   }
 
   PubSubOption(Kind kind, boolean value) {
@@ -162,6 +164,31 @@ public class PubSubOption {
     return new PubSubOption(Kind.hidden, enabled);
   }
 
+  /**
+   * For subscriptions, ask the server to send boolean, integer, float, and double array value
+   * changes as element-level deltas against the previously sent value, with periodic full values.
+   * This reduces bandwidth for large arrays where only a few elements change between updates.
+   *
+   * @param enabled True to enable, false to disable
+   * @return option
+   */
+  public static PubSubOption deltaArrays(boolean enabled) {
+    return new PubSubOption(Kind.deltaArrays, enabled);
+  }
+
+  /**
+   * For subscriptions, coalesce values in the local poll storage (the readQueue() buffer) into
+   * fixed time intervals. A value whose timestamp falls in the same interval as the most recently
+   * stored value replaces it rather than being added, so the queue holds at most the last value per
+   * interval. 0 (the default) disables coalescing.
+   *
+   * @param period interval in seconds
+   * @return option
+   */
+  public static PubSubOption coalescePeriod(double period) {
+    return new PubSubOption(Kind.coalescePeriod, period);
+  }
+
   final Kind m_kind;
   final boolean m_bValue;
   final int m_iValue;
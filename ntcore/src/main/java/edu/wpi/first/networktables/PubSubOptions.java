@@ -25,6 +25,8 @@ public class PubSubOptions {
         case excludePublisher -> excludePublisher = option.m_iValue;
         case excludeSelf -> excludeSelf = option.m_bValue;
         case hidden -> hidden = option.m_bValue;
+        case deltaArrays -> deltaArrays = option.m_bValue;
+        case coalescePeriod -> coalescePeriod = option.m_dValue;
         default -> {
           // NOP
         }
@@ -43,7 +45,9 @@ public class PubSubOptions {
       boolean disableRemote,
       boolean disableLocal,
       boolean excludeSelf,
-      boolean hidden) {
+      boolean hidden,
+      boolean deltaArrays,
+      double coalescePeriod) {
     this.pollStorage = pollStorage;
     this.periodic = periodic;
     this.excludePublisher = excludePublisher;
@@ -55,6 +59,8 @@ public class PubSubOptions {
     this.disableLocal = disableLocal;
     this.excludeSelf = excludeSelf;
     this.hidden = hidden;
+    this.deltaArrays = deltaArrays;
+    this.coalescePeriod = coalescePeriod;
   }
 
   /** Default value of periodic. */
@@ -116,4 +122,16 @@ public class PubSubOptions {
    * this one, and the subscription will not appear in metatopics.
    */
   public boolean hidden;
+
+  /**
+   * For subscriptions, ask the server to send boolean, integer, float, and double array value
+   * changes as element-level deltas against the previously sent value, with periodic full values.
+   */
+  public boolean deltaArrays;
+
+  /**
+   * For subscriptions, coalesce values in the local poll storage into fixed time intervals, in
+   * seconds, keeping only the last value per interval. 0 disables coalescing.
+   */
+  public double coalescePeriod;
 }
@@ -13,7 +13,10 @@ public final class TimeSyncEventData {
    */
   public final long serverTimeOffset;
 
-  /** Measured round trip time divided by 2, in microseconds. */
+  /**
+   * Measured round trip time divided by 2, in microseconds, of the ping exchange serverTimeOffset is
+   * based on.
+   */
   public final long rtt2;
 
   /**
@@ -22,6 +25,12 @@ public final class TimeSyncEventData {
    */
   public final boolean valid;
 
+  /**
+   * Uncertainty of serverTimeOffset, in microseconds: rtt2 plus an allowance for clock drift since
+   * the ping exchange.
+   */
+  public final long uncertainty;
+
   /**
    * Constructor. This should generally only be used internally to NetworkTables.
    *
@@ -30,8 +39,21 @@ public final class TimeSyncEventData {
    * @param valid If other parameters are valid
    */
   public TimeSyncEventData(long serverTimeOffset, long rtt2, boolean valid) {
+    this(serverTimeOffset, rtt2, valid, rtt2);
+  }
+
+  /**
+   * Constructor. This should generally only be used internally to NetworkTables.
+   *
+   * @param serverTimeOffset Server time offset
+   * @param rtt2 Round trip time divided by 2
+   * @param valid If other parameters are valid
+   * @param uncertainty Uncertainty of server time offset
+   */
+  public TimeSyncEventData(long serverTimeOffset, long rtt2, boolean valid, long uncertainty) {
     this.serverTimeOffset = serverTimeOffset;
     this.rtt2 = rtt2;
     this.valid = valid;
+    this.uncertainty = uncertainty;
   }
 }
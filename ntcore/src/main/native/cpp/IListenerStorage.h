@@ -37,7 +37,8 @@ class IListenerStorage {
                       std::string_view message) = 0;
   virtual void NotifyTimeSync(std::span<const NT_Listener> handles,
                               unsigned int flags, int64_t serverTimeOffset,
-                              int64_t rtt2, bool valid) = 0;
+                              int64_t rtt2, bool valid,
+                              int64_t uncertainty) = 0;
 
   void Notify(std::span<const NT_Listener> handles, unsigned int flags,
               const ConnectionInfo* info) {
@@ -108,15 +108,16 @@ void InstanceImpl::StartServer(std::string_view persistFilename,
     return;
   }
   m_networkServer = std::make_shared<NetworkServer>(
-      persistFilename, listenAddress, port3, port4, localStorage,
-      connectionList, logger, [this] {
+      persistFilename, listenAddress, port3, port4, m_serverIoThreads,
+      m_serverBandwidthLimit, localStorage, connectionList, logger, [this] {
         std::scoped_lock lock{m_mutex};
         networkMode &= ~NT_NET_MODE_STARTING;
       });
   networkMode = NT_NET_MODE_SERVER | NT_NET_MODE_STARTING;
-  listenerStorage.NotifyTimeSync({}, NT_EVENT_TIMESYNC, 0, 0, true);
+  listenerStorage.NotifyTimeSync({}, NT_EVENT_TIMESYNC, 0, 0, true, 0);
   m_serverTimeOffset = 0;
   m_rtt2 = 0;
+  m_uncertainty = 0;
 }
 
 void InstanceImpl::StopServer() {
@@ -128,9 +129,10 @@ void InstanceImpl::StopServer() {
     }
     server = std::move(m_networkServer);
     networkMode = NT_NET_MODE_NONE;
-    listenerStorage.NotifyTimeSync({}, NT_EVENT_TIMESYNC, 0, 0, false);
+    listenerStorage.NotifyTimeSync({}, NT_EVENT_TIMESYNC, 0, 0, false, 0);
     m_serverTimeOffset.reset();
     m_rtt2 = 0;
+    m_uncertainty = 0;
   }
 }
 
@@ -154,16 +156,19 @@ void InstanceImpl::StartClient4(std::string_view identity) {
   }
   m_networkClient = std::make_shared<NetworkClient>(
       m_inst, identity, localStorage, connectionList, logger,
-      [this](int64_t serverTimeOffset, int64_t rtt2, bool valid) {
+      [this](int64_t serverTimeOffset, int64_t rtt2, bool valid,
+             int64_t uncertainty) {
         std::scoped_lock lock{m_mutex};
         listenerStorage.NotifyTimeSync({}, NT_EVENT_TIMESYNC, serverTimeOffset,
-                                       rtt2, valid);
+                                       rtt2, valid, uncertainty);
         if (valid) {
           m_serverTimeOffset = serverTimeOffset;
           m_rtt2 = rtt2;
+          m_uncertainty = uncertainty;
         } else {
           m_serverTimeOffset.reset();
           m_rtt2 = 0;
+          m_uncertainty = 0;
         }
       });
   if (!m_servers.empty()) {
@@ -185,9 +190,23 @@ void InstanceImpl::StopClient() {
   client.reset();
   {
     std::scoped_lock lock{m_mutex};
-    listenerStorage.NotifyTimeSync({}, NT_EVENT_TIMESYNC, 0, 0, false);
+    listenerStorage.NotifyTimeSync({}, NT_EVENT_TIMESYNC, 0, 0, false, 0);
     m_serverTimeOffset.reset();
     m_rtt2 = 0;
+    m_uncertainty = 0;
+  }
+}
+
+void InstanceImpl::SetServerIoThreads(unsigned int count) {
+  std::scoped_lock lock{m_mutex};
+  m_serverIoThreads = count;
+}
+
+void InstanceImpl::SetServerBandwidthLimit(unsigned int bytesPerSec) {
+  std::scoped_lock lock{m_mutex};
+  m_serverBandwidthLimit = bytesPerSec;
+  if (m_networkServer) {
+    m_networkServer->SetClientBandwidthLimit(bytesPerSec);
   }
 }
 
@@ -215,6 +234,12 @@ std::optional<int64_t> InstanceImpl::GetServerTimeOffset() {
   return m_serverTimeOffset;
 }
 
+TimeSyncEventData InstanceImpl::GetServerTimeSync() {
+  std::scoped_lock lock{m_mutex};
+  return {m_serverTimeOffset.value_or(0), m_rtt2,
+          m_serverTimeOffset.has_value(), m_uncertainty};
+}
+
 void InstanceImpl::AddTimeSyncListener(NT_Listener listener,
                                        unsigned int eventMask) {
   std::scoped_lock lock{m_mutex};
@@ -225,7 +250,8 @@ void InstanceImpl::AddTimeSyncListener(NT_Listener listener,
       m_serverTimeOffset) {
     listenerStorage.NotifyTimeSync({&listener, 1},
                                    NT_EVENT_TIMESYNC | NT_EVENT_IMMEDIATE,
-                                   *m_serverTimeOffset, m_rtt2, true);
+                                   *m_serverTimeOffset, m_rtt2, true,
+                                   m_uncertainty);
   }
 }
 
@@ -237,6 +263,7 @@ void InstanceImpl::Reset() {
   networkMode = NT_NET_MODE_NONE;
   m_serverTimeOffset.reset();
   m_rtt2 = 0;
+  m_uncertainty = 0;
 
   listenerStorage.Reset();
   // connectionList should have been cleared by destroying networkClient/server
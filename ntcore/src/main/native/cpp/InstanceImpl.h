@@ -48,6 +48,8 @@ class InstanceImpl {
                    std::string_view listenAddress, unsigned int port3,
                    unsigned int port4);
   void StopServer();
+  void SetServerIoThreads(unsigned int count);
+  void SetServerBandwidthLimit(unsigned int bytesPerSec);
   void StartClient3(std::string_view identity);
   void StartClient4(std::string_view identity);
   void StopClient();
@@ -58,6 +60,7 @@ class InstanceImpl {
   std::shared_ptr<INetworkClient> GetClient();
 
   std::optional<int64_t> GetServerTimeOffset();
+  TimeSyncEventData GetServerTimeSync();
   void AddTimeSyncListener(NT_Listener listener, unsigned int eventMask);
 
   void Reset();
@@ -81,8 +84,11 @@ class InstanceImpl {
   std::shared_ptr<NetworkServer> m_networkServer;
   std::shared_ptr<INetworkClient> m_networkClient;
   std::vector<std::pair<std::string, unsigned int>> m_servers;
+  unsigned int m_serverIoThreads = 1;
+  unsigned int m_serverBandwidthLimit = 0;
   std::optional<int64_t> m_serverTimeOffset;
   int64_t m_rtt2 = 0;
+  int64_t m_uncertainty = 0;
   int m_inst;
 };
 
@@ -9,12 +9,15 @@
 #include <vector>
 
 #include <wpi/SmallVector.h>
+#include <wpi/ThreadRegistry.h>
+#include <wpi/timestamp.h>
 
 #include "ntcore_c.h"
 
 using namespace nt;
 
 void ListenerStorage::Thread::Main() {
+  wpi::SetCurrentThreadClass(wpi::ThreadClass::kListener, "NTListener");
   while (m_active) {
     WPI_Handle signaledBuf[3];
     auto signaled = wpi::WaitForObjects(
@@ -44,6 +47,21 @@ void ListenerStorage::Thread::Main() {
   }
 }
 
+void ListenerStorage::SignalListener(ListenerData& listener,
+                                     PollerSet& pollers) {
+  listener.handle.Set();
+  if (std::find(pollers.begin(), pollers.end(), listener.poller) ==
+      pollers.end()) {
+    pollers.emplace_back(listener.poller);
+  }
+}
+
+void ListenerStorage::SignalPollers(const PollerSet& pollers) {
+  for (auto poller : pollers) {
+    poller->handle.Set();
+  }
+}
+
 void ListenerStorage::Activate(NT_Listener listenerHandle, unsigned int mask,
                                FinishEventFunc finishEvent) {
   std::scoped_lock lock{m_mutex};
@@ -79,6 +97,7 @@ void ListenerStorage::Notify(std::span<const NT_Listener> handles,
     return;
   }
   std::scoped_lock lock{m_mutex};
+  PollerSet pollers;
 
   auto doSignal = [&](ListenerData& listener) {
     if ((flags & listener.eventMask) != 0) {
@@ -90,8 +109,7 @@ void ListenerStorage::Notify(std::span<const NT_Listener> handles,
           }
         }
       }
-      listener.handle.Set();
-      listener.poller->handle.Set();
+      SignalListener(listener, pollers);
     }
   };
 
@@ -106,6 +124,7 @@ void ListenerStorage::Notify(std::span<const NT_Listener> handles,
       doSignal(*listener);
     }
   }
+  SignalPollers(pollers);
 }
 
 void ListenerStorage::Notify(std::span<const NT_Listener> handles,
@@ -115,6 +134,7 @@ void ListenerStorage::Notify(std::span<const NT_Listener> handles,
     return;
   }
   std::scoped_lock lock{m_mutex};
+  PollerSet pollers;
 
   auto doSignal = [&](ListenerData& listener) {
     if ((flags & listener.eventMask) != 0) {
@@ -133,8 +153,7 @@ void ListenerStorage::Notify(std::span<const NT_Listener> handles,
         }
       }
       if (count > 0) {
-        listener.handle.Set();
-        listener.poller->handle.Set();
+        SignalListener(listener, pollers);
       }
     }
   };
@@ -150,6 +169,7 @@ void ListenerStorage::Notify(std::span<const NT_Listener> handles,
       doSignal(*listener);
     }
   }
+  SignalPollers(pollers);
 }
 
 void ListenerStorage::Notify(std::span<const NT_Listener> handles,
@@ -159,6 +179,7 @@ void ListenerStorage::Notify(std::span<const NT_Listener> handles,
     return;
   }
   std::scoped_lock lock{m_mutex};
+  PollerSet pollers;
 
   auto doSignal = [&](ListenerData& listener) {
     if ((flags & listener.eventMask) != 0) {
@@ -176,8 +197,7 @@ void ListenerStorage::Notify(std::span<const NT_Listener> handles,
         }
       }
       if (count > 0) {
-        listener.handle.Set();
-        listener.poller->handle.Set();
+        SignalListener(listener, pollers);
       }
     }
   };
@@ -193,6 +213,7 @@ void ListenerStorage::Notify(std::span<const NT_Listener> handles,
       doSignal(*listener);
     }
   }
+  SignalPollers(pollers);
 }
 
 void ListenerStorage::Notify(unsigned int flags, unsigned int level,
@@ -202,6 +223,7 @@ void ListenerStorage::Notify(unsigned int flags, unsigned int level,
     return;
   }
   std::scoped_lock lock{m_mutex};
+  PollerSet pollers;
   for (auto&& listener : m_logListeners) {
     if ((flags & listener->eventMask) != 0) {
       int count = 0;
@@ -218,33 +240,34 @@ void ListenerStorage::Notify(unsigned int flags, unsigned int level,
         }
       }
       if (count > 0) {
-        listener->handle.Set();
-        listener->poller->handle.Set();
+        SignalListener(*listener, pollers);
       }
     }
   }
+  SignalPollers(pollers);
 }
 
 void ListenerStorage::NotifyTimeSync(std::span<const NT_Listener> handles,
                                      unsigned int flags,
                                      int64_t serverTimeOffset, int64_t rtt2,
-                                     bool valid) {
+                                     bool valid, int64_t uncertainty) {
   if (flags == 0) {
     return;
   }
   std::scoped_lock lock{m_mutex};
+  PollerSet pollers;
 
   auto doSignal = [&](ListenerData& listener) {
     if ((flags & listener.eventMask) != 0) {
       for (auto&& [finishEvent, mask] : listener.sources) {
         if ((flags & mask) != 0) {
           listener.poller->queue.emplace_back(listener.handle, flags,
-                                              serverTimeOffset, rtt2, valid);
+                                              serverTimeOffset, rtt2, valid,
+                                              uncertainty);
           // finishEvent is never set (see InstanceImpl)
         }
       }
-      listener.handle.Set();
-      listener.poller->handle.Set();
+      SignalListener(listener, pollers);
     }
   };
 
@@ -259,14 +282,22 @@ void ListenerStorage::NotifyTimeSync(std::span<const NT_Listener> handles,
       doSignal(*listener);
     }
   }
+  SignalPollers(pollers);
 }
 
 NT_Listener ListenerStorage::AddListener(ListenerCallback callback) {
   std::scoped_lock lock{m_mutex};
-  if (!m_thread) {
-    m_thread.Start(m_pollers.Add(m_inst)->handle);
+  if (m_nextThread >= m_threadCount) {
+    m_nextThread = 0;
+  }
+  if (m_nextThread >= m_threads.size()) {
+    m_threads.resize(m_nextThread + 1);
   }
-  if (auto thr = m_thread.GetThread()) {
+  auto& thread = m_threads[m_nextThread++];
+  if (!thread) {
+    thread.Start(m_pollers.Add(m_inst)->handle);
+  }
+  if (auto thr = thread.GetThread()) {
     auto listener = DoAddListener(thr->m_poller);
     if (listener) {
       thr->m_callbacks.try_emplace(listener, std::move(callback));
@@ -331,19 +362,38 @@ ListenerStorage::RemoveListener(NT_Listener listenerHandle) {
 }
 
 bool ListenerStorage::WaitForListenerQueue(double timeout) {
-  WPI_EventHandle h;
+  wpi::SmallVector<WPI_EventHandle, 4> handles;
   {
     std::scoped_lock lock{m_mutex};
-    if (auto thr = m_thread.GetThread()) {
-      h = thr->m_waitQueueWaiter.GetHandle();
-      thr->m_waitQueueWakeup.Set();
-    } else {
+    for (auto&& thread : m_threads) {
+      if (auto thr = thread.GetThread()) {
+        handles.emplace_back(thr->m_waitQueueWaiter.GetHandle());
+        thr->m_waitQueueWakeup.Set();
+      }
+    }
+  }
+  if (handles.empty()) {
+    return false;
+  }
+  // wait for every thread to drain its queue
+  int64_t deadline = wpi::Now() + static_cast<int64_t>(timeout * 1e6);
+  for (auto h : handles) {
+    double remaining = timeout;
+    if (timeout > 0) {
+      remaining = std::max(0.0, (deadline - wpi::Now()) * 1e-6);
+    }
+    bool timedOut;
+    wpi::WaitForObject(h, remaining, &timedOut);
+    if (timedOut) {
       return false;
     }
   }
-  bool timedOut;
-  wpi::WaitForObject(h, timeout, &timedOut);
-  return !timedOut;
+  return true;
+}
+
+void ListenerStorage::SetListenerThreads(unsigned int count) {
+  std::scoped_lock lock{m_mutex};
+  m_threadCount = std::max(count, 1u);
 }
 
 void ListenerStorage::Reset() {
@@ -355,21 +405,26 @@ void ListenerStorage::Reset() {
   m_valueListeners.clear();
   m_logListeners.clear();
   m_timeSyncListeners.clear();
-  if (m_thread) {
-    m_thread.Stop();
+  for (auto&& thread : m_threads) {
+    if (thread) {
+      thread.Stop();
+    }
   }
+  m_threads.clear();
+  m_nextThread = 0;
 }
 
 std::vector<std::pair<NT_Listener, unsigned int>>
 ListenerStorage::DoRemoveListeners(std::span<const NT_Listener> handles) {
   std::vector<std::pair<NT_Listener, unsigned int>> rv;
-  auto thr = m_thread.GetThread();
   for (auto handle : handles) {
     if (auto listener = m_listeners.Remove(handle)) {
       rv.emplace_back(handle, listener->eventMask);
-      if (thr) {
-        if (thr->m_poller == listener->poller->handle) {
+      for (auto&& thread : m_threads) {
+        auto thr = thread.GetThread();
+        if (thr && thr->m_poller == listener->poller->handle) {
           thr->m_callbacks.erase(handle);
+          break;
         }
       }
       if ((listener->eventMask & NT_EVENT_CONNECTION) != 0) {
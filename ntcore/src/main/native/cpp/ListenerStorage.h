@@ -43,7 +43,8 @@ class ListenerStorage final : public IListenerStorage {
   void Notify(unsigned int flags, unsigned int level, std::string_view filename,
               unsigned int line, std::string_view message) final;
   void NotifyTimeSync(std::span<const NT_Listener> handles, unsigned int flags,
-                      int64_t serverTimeOffset, int64_t rtt2, bool valid) final;
+                      int64_t serverTimeOffset, int64_t rtt2, bool valid,
+                      int64_t uncertainty) final;
 
   // user-facing functions
   NT_Listener AddListener(ListenerCallback callback);
@@ -64,14 +65,25 @@ class ListenerStorage final : public IListenerStorage {
 
   bool WaitForListenerQueue(double timeout);
 
+  void SetListenerThreads(unsigned int count);
+
   void Reset();
 
  private:
+  struct PollerData;
+  struct ListenerData;
+
   // these assume the mutex is already held
   NT_Listener DoAddListener(NT_ListenerPoller pollerHandle);
   std::vector<std::pair<NT_Listener, unsigned int>> DoRemoveListeners(
       std::span<const NT_Listener> handles);
 
+  // Pollers to wake at the end of a Notify call.  Each poller is signaled
+  // once per call, no matter how many of its listeners received events.
+  using PollerSet = wpi::SmallVector<PollerData*, 4>;
+  static void SignalListener(ListenerData& listener, PollerSet& pollers);
+  static void SignalPollers(const PollerSet& pollers);
+
   int m_inst;
   mutable wpi::mutex m_mutex;
 
@@ -115,7 +127,13 @@ class ListenerStorage final : public IListenerStorage {
     wpi::Event m_waitQueueWakeup;
     wpi::Event m_waitQueueWaiter;
   };
-  wpi::SafeThreadOwner<Thread> m_thread;
+
+  // callback listeners are assigned to the dispatch threads in turn; each
+  // thread has its own poller, so a slow callback only delays the callbacks
+  // of listeners on the same thread
+  std::vector<wpi::SafeThreadOwner<Thread>> m_threads;
+  unsigned int m_threadCount = 1;
+  unsigned int m_nextThread = 0;
 };
 
 }  // namespace nt
@@ -4,6 +4,7 @@
 
 #include "LocalStorage.h"
 
+#include <utility>
 #include <vector>
 
 using namespace nt;
@@ -46,6 +47,16 @@ std::vector<TopicInfo> LocalStorage::GetTopicInfo(
   return rv;
 }
 
+std::vector<std::pair<NT_Topic, Value>> LocalStorage::GetScalarTopicValues(
+    unsigned int types) {
+  std::scoped_lock lock(m_mutex);
+  std::vector<std::pair<NT_Topic, Value>> rv;
+  m_impl.ForEachScalarValue(types, [&](NT_Topic topic, const Value& value) {
+    rv.emplace_back(topic, value);
+  });
+  return rv;
+}
+
 void LocalStorage::Release(NT_Handle pubsubentryHandle) {
   switch (Handle{pubsubentryHandle}.GetType()) {
     case Handle::kEntry:
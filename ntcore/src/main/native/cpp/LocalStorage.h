@@ -6,18 +6,21 @@
 
 #include <stdint.h>
 
+#include <mutex>
 #include <optional>
 #include <span>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include <wpi/Logger.h>
 #include <wpi/SmallVector.h>
 #include <wpi/json.h>
-#include <wpi/mutex.h>
+#include <wpi/profiled_mutex.h>
 
 #include "local/LocalStorageImpl.h"
+#include "local/PendingValueQueue.h"
 #include "net/MessageHandler.h"
 #include "net/NetworkInterface.h"
 #include "ntcore_cpp.h"
@@ -89,6 +92,9 @@ class LocalStorage final : public net::ILocalStorage {
   std::vector<TopicInfo> GetTopicInfo(std::string_view prefix,
                                       std::span<const std::string_view> types);
 
+  std::vector<std::pair<NT_Topic, Value>> GetScalarTopicValues(
+      unsigned int types);
+
   NT_Topic GetTopic(std::string_view name) {
     if (name.empty()) {
       return {};
@@ -278,6 +284,30 @@ class LocalStorage final : public net::ILocalStorage {
     return {};
   }
 
+  std::vector<NT_Publisher> PublishMultiple(
+      std::span<const PublishRequest> requests) {
+    std::vector<NT_Publisher> handles;
+    handles.reserve(requests.size());
+    std::scoped_lock lock{m_mutex};
+    for (auto&& req : requests) {
+      local::LocalPublisher* publisher = nullptr;
+      if (req.name.empty()) {
+        WPI_ERROR(m_impl.GetLogger(), "trying to publish empty topic name");
+      } else {
+        auto topic = m_impl.GetOrCreateTopic(req.name);
+        if (req.properties) {
+          publisher = m_impl.Publish(topic, req.type, req.typeStr,
+                                     *req.properties, req.options);
+        } else {
+          publisher = m_impl.Publish(topic, req.type, req.typeStr,
+                                     wpi::json::object(), req.options);
+        }
+      }
+      handles.emplace_back(publisher ? publisher->handle : 0);
+    }
+    return handles;
+  }
+
   void Unpublish(NT_Handle pubentryHandle) {
     std::scoped_lock lock{m_mutex};
     m_impl.Unpublish(pubentryHandle);
@@ -311,10 +341,39 @@ class LocalStorage final : public net::ILocalStorage {
   }
 
   bool SetEntryValue(NT_Handle pubentryHandle, const Value& value) {
+    if (IsScalar(value)) {
+      // fast path: if another thread (typically a network thread) holds the
+      // lock, queue the value for that thread to apply instead of waiting.
+      // Only values known to be accepted are queued, as the result of the
+      // queued set can't be reported.
+      std::unique_lock lock{m_mutex, std::try_to_lock};
+      if (!lock && m_impl.IsPublishable(pubentryHandle, value.type()) &&
+          m_pendingValues.Push(pubentryHandle, value)) {
+        // the lock holder may have already checked for pending values
+        if (lock.try_lock()) {
+          lock.unlock();
+        }
+        return true;
+      }
+      if (!lock) {
+        lock.lock();
+      }
+      return m_impl.SetEntryValue(pubentryHandle, value);
+    }
     std::scoped_lock lock{m_mutex};
     return m_impl.SetEntryValue(pubentryHandle, value);
   }
 
+  bool SetEntryValues(std::span<const NT_Handle> pubentryHandles,
+                      std::span<const Value> values) {
+    bool ok = pubentryHandles.size() == values.size();
+    std::scoped_lock lock{m_mutex};
+    for (size_t i = 0; i < pubentryHandles.size() && i < values.size(); ++i) {
+      ok = m_impl.SetEntryValue(pubentryHandles[i], values[i]) && ok;
+    }
+    return ok;
+  }
+
   bool SetDefaultEntryValue(NT_Handle pubsubentryHandle, const Value& value) {
     std::scoped_lock lock{m_mutex};
     return m_impl.SetDefaultEntryValue(pubsubentryHandle, value);
@@ -366,6 +425,18 @@ class LocalStorage final : public net::ILocalStorage {
     return subscriber->pollStorage.Read<T>();
   }
 
+  template <ValidType T>
+  void ReadQueue(NT_Handle subentry,
+                 std::vector<Timestamped<typename TypeInfo<T>::Value>>& buf) {
+    std::scoped_lock lock{m_mutex};
+    auto subscriber = m_impl.GetSubEntry(subentry);
+    if (!subscriber) {
+      buf.clear();
+      return;
+    }
+    subscriber->pollStorage.Read<T>(buf);
+  }
+
   //
   // Backwards compatible user functions
   //
@@ -486,7 +557,64 @@ class LocalStorage final : public net::ILocalStorage {
   }
 
  private:
-  wpi::mutex m_mutex;
+  // Storage mutex. Values queued by SetEntryValue() while the mutex is held
+  // by another thread are applied as soon as the mutex is next acquired, and
+  // on release if any remain.
+  class StorageMutex {
+   public:
+    explicit StorageMutex(LocalStorage& storage) : m_storage{storage} {}
+
+    void lock() {
+      m_mutex.lock();
+      m_storage.ApplyPendingValues();
+    }
+
+    bool try_lock() {
+      if (!m_mutex.try_lock()) {
+        return false;
+      }
+      m_storage.ApplyPendingValues();
+      return true;
+    }
+
+    void unlock() {
+      for (;;) {
+        m_mutex.unlock();
+        if (m_storage.m_pendingValues.Empty() || !m_mutex.try_lock()) {
+          return;
+        }
+        m_storage.ApplyPendingValues();
+      }
+    }
+
+   private:
+    LocalStorage& m_storage;
+    wpi::profiled_mutex m_mutex{"NT.LocalStorage"};
+  };
+
+  static bool IsScalar(const Value& value) {
+    switch (value.type()) {
+      case NT_BOOLEAN:
+      case NT_INTEGER:
+      case NT_FLOAT:
+      case NT_DOUBLE:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  // must be called with m_mutex held
+  void ApplyPendingValues() {
+    if (!m_pendingValues.Empty()) {
+      m_pendingValues.Drain([&](NT_Handle handle, const Value& value) {
+        m_impl.SetEntryValue(handle, value);
+      });
+    }
+  }
+
+  local::PendingValueQueue m_pendingValues;
+  StorageMutex m_mutex{*this};
   local::StorageImpl m_impl;
 };
 
@@ -15,6 +15,7 @@
 #include <fmt/format.h>
 #include <wpi/SmallString.h>
 #include <wpi/StringExtras.h>
+#include <wpi/ThreadRegistry.h>
 #include <wpinet/HttpUtil.h>
 #include <wpinet/uv/Loop.h>
 #include <wpinet/uv/Tcp.h>
@@ -44,6 +45,9 @@ NetworkClientBase::NetworkClientBase(int inst, std::string_view id,
       m_localQueue{logger},
       m_loop{*m_loopRunner.GetLoop()} {
   INFO("starting network client");
+  m_loopRunner.ExecAsync([](auto&) {
+    wpi::SetCurrentThreadClass(wpi::ThreadClass::kNetwork, "NTClient");
+  });
 }
 
 NetworkClientBase::~NetworkClientBase() {
@@ -300,7 +304,8 @@ void NetworkClient3::DoDisconnect(std::string_view reason) {
 NetworkClient::NetworkClient(
     int inst, std::string_view id, net::ILocalStorage& localStorage,
     IConnectionList& connList, wpi::Logger& logger,
-    std::function<void(int64_t serverTimeOffset, int64_t rtt2, bool valid)>
+    std::function<void(int64_t serverTimeOffset, int64_t rtt2, bool valid,
+                       int64_t uncertainty)>
         timeSyncUpdated)
     : NetworkClientBase{inst, id, localStorage, connList, logger},
       m_timeSyncUpdated{std::move(timeSyncUpdated)} {
@@ -375,46 +380,77 @@ void NetworkClient::HandleLocal() {
 void NetworkClient::TcpConnected(uv::Tcp& tcp) {
   tcp.SetLogger(&m_logger);
   tcp.SetNoDelay(true);
-  // Start the WS client
-  if (m_logger.min_level() >= wpi::WPI_LOG_DEBUG4) {
-    std::string ip;
-    unsigned int port = 0;
-    uv::AddrToName(tcp.GetPeer(), &ip, &port);
-    DEBUG4("Starting WebSocket client on {} port {}", ip, port);
+  std::string ip;
+  unsigned int port = 0;
+  uv::AddrToName(tcp.GetPeer(), &ip, &port);
+
+  // same-host servers are offered a shared memory connection
+  std::shared_ptr<net::SharedMemoryRegion> shm;
+  if (!m_sharedMemoryFailed && net::IsLoopbackAddress(ip)) {
+    shm = net::SharedMemoryRegion::Create();
   }
+
+  // Start the WS client
+  DEBUG4("Starting WebSocket client on {} port {}", ip, port);
   wpi::WebSocket::ClientOptions options;
   options.handshakeTimeout = kWebsocketHandshakeTimeout;
+  options.deflate = wpi::WebSocket::DeflateOptions{};
+  std::pair<std::string_view, std::string_view> shmHeader;
+  if (shm) {
+    shmHeader = {net::kSharedMemoryHeader, shm->GetName()};
+    options.extraHeaders = {&shmHeader, 1};
+  }
+  std::string_view protocols[] = {
+      net::kSharedMemoryProtocol, "v4.2.networktables.first.wpi.edu",
+      "v4.1.networktables.first.wpi.edu", "networktables.first.wpi.edu"};
   wpi::SmallString<128> idBuf;
   auto ws = wpi::WebSocket::CreateClient(
       tcp, fmt::format("/nt/{}", wpi::EscapeURI(m_id, idBuf)), "",
-      {"v4.1.networktables.first.wpi.edu", "networktables.first.wpi.edu"},
-      options);
+      shm ? std::span{protocols} : std::span{protocols}.subspan(1), options);
   ws->SetMaxMessageSize(kMaxMessageSize);
-  ws->open.connect([this, &tcp, ws = ws.get()](std::string_view protocol) {
+  ws->open.connect([this, &tcp, ws = ws.get(),
+                    shm = std::move(shm)](std::string_view protocol) {
     if (m_connList.IsConnected()) {
       ws->Terminate(1006, "no longer needed");
       return;
     }
-    WsConnected(*ws, tcp, protocol);
+    WsConnected(*ws, tcp, protocol, shm);
   });
 }
 
 void NetworkClient::WsConnected(wpi::WebSocket& ws, uv::Tcp& tcp,
-                                std::string_view protocol) {
+                                std::string_view protocol,
+                                std::shared_ptr<net::SharedMemoryRegion> shm) {
   if (m_parallelConnect) {
     m_parallelConnect->Succeeded(tcp);
   }
 
   ConnectionInfo connInfo;
   uv::AddrToName(tcp.GetPeer(), &connInfo.remote_ip, &connInfo.remote_port);
-  connInfo.protocol_version =
-      protocol == "v4.1.networktables.first.wpi.edu" ? 0x0401 : 0x0400;
+  if (protocol == net::kSharedMemoryProtocol ||
+      protocol == "v4.2.networktables.first.wpi.edu") {
+    connInfo.protocol_version = 0x0402;
+  } else if (protocol == "v4.1.networktables.first.wpi.edu") {
+    connInfo.protocol_version = 0x0401;
+  } else {
+    connInfo.protocol_version = 0x0400;
+  }
 
-  INFO("CONNECTED NT4 to {} port {}", connInfo.remote_ip, connInfo.remote_port);
-  m_connHandle = m_connList.AddConnection(connInfo);
+  std::shared_ptr<net::SharedMemoryConnection> shmWire;
+  if (protocol == net::kSharedMemoryProtocol && shm) {
+    // the server has opened the region by now
+    shm->Remove();
+    shmWire = std::make_shared<net::SharedMemoryConnection>(
+        ws, connInfo.protocol_version, std::move(shm), false, m_logger);
+    m_wire = shmWire;
+  } else {
+    m_wire = std::make_shared<net::WebSocketConnection>(
+        ws, connInfo.protocol_version, m_logger);
+  }
 
-  m_wire = std::make_shared<net::WebSocketConnection>(
-      ws, connInfo.protocol_version, m_logger);
+  INFO("CONNECTED NT4 to {} port {}{}", connInfo.remote_ip,
+       connInfo.remote_port, shmWire ? " (shared memory)" : "");
+  m_connHandle = m_connList.AddConnection(connInfo);
   m_clientImpl = std::make_unique<net::ClientImpl>(
       m_loop.Now().count(), *m_wire, m_logger, m_timeSyncUpdated,
       [this](uint32_t repeatMs) {
@@ -427,10 +463,15 @@ void NetworkClient::WsConnected(wpi::WebSocket& ws, uv::Tcp& tcp,
         }
       });
   m_clientImpl->SetLocal(&m_localStorage);
+  m_clientImpl->SetResumeState(&m_resumeState);
   m_localStorage.StartNetwork(&m_localQueue);
   HandleLocal();
   m_clientImpl->SendInitial();
   ws.closed.connect([this, &ws](uint16_t, std::string_view reason) {
+    if (reason == net::kSharedMemoryFailReason && !m_sharedMemoryFailed) {
+      WARN("server could not open shared memory, using websocket instead");
+      m_sharedMemoryFailed = true;
+    }
     if (!ws.GetStream().IsLoopClosing()) {
       // we could be in the middle of sending data, so defer disconnect
       // capture a shared_ptr copy of ws to make sure it doesn't get destroyed
@@ -442,16 +483,38 @@ void NetworkClient::WsConnected(wpi::WebSocket& ws, uv::Tcp& tcp,
           });
     }
   });
-  ws.text.connect([this](std::string_view data, bool) {
+  auto processText = [this](std::string_view data) {
     if (m_clientImpl) {
       m_clientImpl->ProcessIncomingText(data);
     }
-  });
-  ws.binary.connect([this](std::span<const uint8_t> data, bool) {
+  };
+  auto processBinary = [this](std::span<const uint8_t> data) {
     if (m_clientImpl) {
       m_clientImpl->ProcessIncomingBinary(m_loop.Now().count(), data);
     }
-  });
+  };
+  if (shmWire) {
+    // the websocket is only used to wake up the shared memory connection
+    shmWire->SetHandlers(processText, processBinary);
+    ws.text.connect([wire = std::weak_ptr{shmWire}](std::string_view, bool) {
+      if (auto shm = wire.lock()) {
+        shm->Poll();
+      }
+    });
+    ws.binary.connect(
+        [wire = std::weak_ptr{shmWire}](std::span<const uint8_t>, bool) {
+          if (auto shm = wire.lock()) {
+            shm->Poll();
+          }
+        });
+    shmWire->Poll();
+  } else {
+    ws.text.connect(
+        [processText](std::string_view data, bool) { processText(data); });
+    ws.binary.connect([processBinary](std::span<const uint8_t> data, bool) {
+      processBinary(data);
+    });
+  }
 }
 
 void NetworkClient::ForceDisconnect(std::string_view reason) {
@@ -470,5 +533,5 @@ void NetworkClient::DoDisconnect(std::string_view reason) {
   m_clientImpl.reset();
   m_wire.reset();
   NetworkClientBase::DoDisconnect(reason);
-  m_timeSyncUpdated(0, 0, false);
+  m_timeSyncUpdated(0, 0, false, 0);
 }
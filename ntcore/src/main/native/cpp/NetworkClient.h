@@ -24,6 +24,7 @@
 #include "net/ClientImpl.h"
 #include "net/ClientMessageQueue.h"
 #include "net/Message.h"
+#include "net/SharedMemoryConnection.h"
 #include "net/WebSocketConnection.h"
 #include "net3/ClientImpl3.h"
 #include "net3/UvStreamConnection3.h"
@@ -125,7 +126,8 @@ class NetworkClient final : public NetworkClientBase {
   NetworkClient(
       int inst, std::string_view id, net::ILocalStorage& localStorage,
       IConnectionList& connList, wpi::Logger& logger,
-      std::function<void(int64_t serverTimeOffset, int64_t rtt2, bool valid)>
+      std::function<void(int64_t serverTimeOffset, int64_t rtt2, bool valid,
+                         int64_t uncertainty)>
           timeSyncUpdated);
   ~NetworkClient() final;
 
@@ -138,14 +140,19 @@ class NetworkClient final : public NetworkClientBase {
   void HandleLocal();
   void TcpConnected(wpi::uv::Tcp& tcp) final;
   void WsConnected(wpi::WebSocket& ws, wpi::uv::Tcp& tcp,
-                   std::string_view protocol);
+                   std::string_view protocol,
+                   std::shared_ptr<net::SharedMemoryRegion> shm);
   void ForceDisconnect(std::string_view reason) override;
   void DoDisconnect(std::string_view reason) override;
 
-  std::function<void(int64_t serverTimeOffset, int64_t rtt2, bool valid)>
+  std::function<void(int64_t serverTimeOffset, int64_t rtt2, bool valid,
+                     int64_t uncertainty)>
       m_timeSyncUpdated;
-  std::shared_ptr<net::WebSocketConnection> m_wire;
+  std::shared_ptr<net::WireConnection> m_wire;
   std::unique_ptr<net::ClientImpl> m_clientImpl;
+  net::ClientResumeState m_resumeState;
+  // set if the server couldn't open shared memory; don't try again
+  bool m_sharedMemoryFailed = false;
 };
 
 }  // namespace nt
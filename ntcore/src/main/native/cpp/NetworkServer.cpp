@@ -6,17 +6,25 @@
 
 #include <stdint.h>
 
+#include <algorithm>
 #include <atomic>
 #include <memory>
 #include <span>
 #include <string>
 #include <system_error>
+#include <thread>
 #include <utility>
 #include <vector>
 
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
 #include <wpi/MemoryBuffer.h>
 #include <wpi/SmallString.h>
+#include <wpi/SmallVector.h>
 #include <wpi/StringExtras.h>
+#include <wpi/ThreadRegistry.h>
 #include <wpi/fs.h>
 #include <wpi/mutex.h>
 #include <wpi/raw_ostream.h>
@@ -31,6 +39,7 @@
 #include "IConnectionList.h"
 #include "InstanceImpl.h"
 #include "Log.h"
+#include "net/SharedMemoryConnection.h"
 #include "net/WebSocketConnection.h"
 #include "net/WireDecoder.h"
 #include "net/WireEncoder.h"
@@ -44,16 +53,23 @@ static constexpr size_t kMaxMessageSize = 2 * 1024 * 1024;
 
 static constexpr size_t kClientProcessMessageCountMax = 16;
 
+// persistent changes are appended to a journal file; once the journal grows
+// larger than this (or the last full save, if larger), the full file is
+// rewritten and the journal removed
+static constexpr size_t kPersistentJournalMinCompactSize = 64 * 1024;
+
 class NetworkServer::ServerConnection {
  public:
-  ServerConnection(NetworkServer& server, std::string_view addr,
+  ServerConnection(NetworkServer& server, IoLoop& ioLoop, std::string_view addr,
                    unsigned int port, wpi::Logger& logger)
       : m_server{server},
+        m_ioLoop{ioLoop},
         m_connInfo{fmt::format("{}:{}", addr, port)},
         m_logger{logger} {
     m_info.remote_ip = addr;
     m_info.remote_port = port;
   }
+  ~ServerConnection() { --m_ioLoop.numConnections; }
 
   int GetClientId() const { return m_clientId; }
 
@@ -62,24 +78,144 @@ class NetworkServer::ServerConnection {
   void UpdateOutgoingTimer(uint32_t repeatMs);
   void ConnectionClosed();
 
+  void ClientAdded();
+
   NetworkServer& m_server;
+  IoLoop& m_ioLoop;
   ConnectionInfo m_info;
   std::string m_connInfo;
   wpi::Logger& m_logger;
-  int m_clientId;
+  int m_clientId = -1;
 
  private:
   std::shared_ptr<uv::Timer> m_outgoingTimer;
 };
 
+namespace {
+
+// NT3 clients send immediately from within m_serverImpl, which may be called
+// from any I/O loop thread.  Sends made from threads other than the stream's
+// own loop are buffered and handed off to that loop through an async handle.
+// All calls must be made while holding NetworkServer::m_serverMutex.
+class LoopWireConnection3 final : public net3::WireConnection3 {
+ public:
+  LoopWireConnection3(uv::Stream& stream, wpi::recursive_mutex& mutex);
+  ~LoopWireConnection3() override;
+
+  bool Ready() const final { return m_wire->Ready(); }
+
+  net3::Writer Send() final;
+
+  void Flush() final;
+
+  uint64_t GetLastFlushTime() const final {
+    return m_wire->GetLastFlushTime();
+  }
+
+  void StopRead() final { m_wire->StopRead(); }
+  void StartRead() final { m_wire->StartRead(); }
+
+  void Disconnect(std::string_view reason) final;
+
+  std::string_view GetDisconnectReason() const {
+    return m_wire->GetDisconnectReason();
+  }
+
+  uv::Stream& GetStream() { return m_wire->GetStream(); }
+
+ private:
+  void FinishSend() final {}
+
+  bool OnLoop() const {
+    return m_loop.GetThreadId() == std::this_thread::get_id();
+  }
+  void SendPending();
+
+  uv::Loop& m_loop;
+  std::shared_ptr<net3::UvStreamConnection3> m_wire;
+  std::shared_ptr<uv::Async<>> m_async;
+
+  // sent from other threads, waiting for the loop
+  wpi::SmallVector<char, 256> m_pending;
+  wpi::raw_svector_ostream m_pendingOs{m_pending};
+  std::string m_pendingDisconnect;
+  bool m_pendingFlush = false;
+};
+
+}  // namespace
+
+LoopWireConnection3::LoopWireConnection3(uv::Stream& stream,
+                                         wpi::recursive_mutex& mutex)
+    : m_loop{stream.GetLoopRef()},
+      m_wire{std::make_shared<net3::UvStreamConnection3>(stream)},
+      m_async{uv::Async<>::Create(m_loop)} {
+  if (m_async) {
+    m_async->wakeup.connect([this, &mutex] {
+      std::scoped_lock lock{mutex};
+      SendPending();
+    });
+  }
+}
+
+LoopWireConnection3::~LoopWireConnection3() {
+  if (m_async) {
+    m_async->Close();
+  }
+}
+
+net3::Writer LoopWireConnection3::Send() {
+  if (OnLoop()) {
+    // keep ordering with anything sent from other threads
+    SendPending();
+    return m_wire->Send();
+  }
+  return {m_pendingOs, *this};
+}
+
+void LoopWireConnection3::Flush() {
+  if (OnLoop()) {
+    SendPending();
+    m_wire->Flush();
+  } else if (m_async) {
+    m_pendingFlush = true;
+    m_async->Send();
+  }
+}
+
+void LoopWireConnection3::Disconnect(std::string_view reason) {
+  if (OnLoop()) {
+    m_wire->Disconnect(reason);
+  } else if (m_async) {
+    if (m_pendingDisconnect.empty()) {
+      m_pendingDisconnect = reason;
+    }
+    m_async->Send();
+  }
+}
+
+void LoopWireConnection3::SendPending() {
+  if (!m_pending.empty()) {
+    m_wire->Send().stream() << m_pendingOs.str();
+    m_pending.clear();
+  }
+  if (m_pendingFlush) {
+    m_pendingFlush = false;
+    m_wire->Flush();
+  }
+  if (!m_pendingDisconnect.empty()) {
+    m_wire->Disconnect(m_pendingDisconnect);
+    m_pendingDisconnect.clear();
+  }
+}
+
 class NetworkServer::ServerConnection3 : public ServerConnection {
  public:
   ServerConnection3(std::shared_ptr<uv::Stream> stream, NetworkServer& server,
-                    std::string_view addr, unsigned int port,
+                    IoLoop& ioLoop, std::string_view addr, unsigned int port,
                     wpi::Logger& logger);
 
  private:
-  std::shared_ptr<net3::UvStreamConnection3> m_wire;
+  std::shared_ptr<LoopWireConnection3> m_wire;
 };
 
 class NetworkServer::ServerConnection4 final
@@ -87,28 +223,41 @@ class NetworkServer::ServerConnection4 final
       public wpi::HttpWebSocketServerConnection<ServerConnection4> {
  public:
   ServerConnection4(std::shared_ptr<uv::Stream> stream, NetworkServer& server,
-                    std::string_view addr, unsigned int port,
+                    IoLoop& ioLoop, std::string_view addr, unsigned int port,
                     wpi::Logger& logger)
-      : ServerConnection{server, addr, port, logger},
+      : ServerConnection{server, ioLoop, addr, port, logger},
         HttpWebSocketServerConnection(
             stream,
-            {"v4.1.networktables.first.wpi.edu", "networktables.first.wpi.edu",
+            {net::kSharedMemoryProtocol, "v4.2.networktables.first.wpi.edu",
+             "v4.1.networktables.first.wpi.edu", "networktables.first.wpi.edu",
              "rtt.networktables.first.wpi.edu"}) {
     m_info.protocol_version = 0x0400;
+    // compress large messages (e.g. announcements); clients must compress
+    // messages independently so no per-client history needs to be kept
+    wpi::WebSocket::DeflateOptions deflate;
+    deflate.allowContextTakeover = false;
+    m_deflate = deflate;
+    m_request.header.connect(
+        [this](std::string_view name, std::string_view value) {
+          if (wpi::equals_lower(name, net::kSharedMemoryHeader)) {
+            m_sharedMemoryName = value;
+          }
+        });
   }
 
  private:
   void ProcessRequest() final;
   void ProcessWsUpgrade() final;
 
-  std::shared_ptr<net::WebSocketConnection> m_wire;
+  std::shared_ptr<net::WireConnection> m_wire;
+  std::string m_sharedMemoryName;
 };
 
 void NetworkServer::ServerConnection::SetupOutgoingTimer() {
-  m_outgoingTimer = uv::Timer::Create(m_server.m_loop);
+  m_outgoingTimer = uv::Timer::Create(m_ioLoop.loop);
   m_outgoingTimer->timeout.connect([this] {
-    m_server.m_serverImpl.SendOutgoing(m_clientId,
-                                       m_server.m_loop.Now().count());
+    std::scoped_lock lock{m_server.m_serverMutex};
+    m_server.m_serverImpl.SendOutgoing(m_clientId, m_ioLoop.loop.Now().count());
   });
 }
 
@@ -123,9 +272,16 @@ void NetworkServer::ServerConnection::UpdateOutgoingTimer(uint32_t repeatMs) {
   }
 }
 
+void NetworkServer::ServerConnection::ClientAdded() {
+  // caller must hold m_server.m_serverMutex
+  m_ioLoop.clientIds.push_back(m_clientId);
+}
+
 void NetworkServer::ServerConnection::ConnectionClosed() {
   // don't call back into m_server if it's being destroyed
   if (!m_outgoingTimer->IsLoopClosing()) {
+    std::scoped_lock lock{m_server.m_serverMutex};
+    std::erase(m_ioLoop.clientIds, m_clientId);
     uv::Timer::SingleShot(m_outgoingTimer->GetLoopRef(), uv::Timer::Time{0},
                           [client = m_server.m_serverImpl.RemoveClient(
                                m_clientId)]() mutable { client.reset(); });
@@ -135,13 +291,15 @@ void NetworkServer::ServerConnection::ConnectionClosed() {
 }
 
 NetworkServer::ServerConnection3::ServerConnection3(
-    std::shared_ptr<uv::Stream> stream, NetworkServer& server,
+    std::shared_ptr<uv::Stream> stream, NetworkServer& server, IoLoop& ioLoop,
     std::string_view addr, unsigned int port, wpi::Logger& logger)
-    : ServerConnection{server, addr, port, logger},
-      m_wire{std::make_shared<net3::UvStreamConnection3>(*stream)} {
+    : ServerConnection{server, ioLoop, addr, port, logger},
+      m_wire{std::make_shared<LoopWireConnection3>(*stream,
+                                                   server.m_serverMutex)} {
   m_info.remote_ip = addr;
   m_info.remote_port = port;
 
+  std::scoped_lock lock{m_server.m_serverMutex};
   // TODO: set local flag appropriately
   m_clientId = m_server.m_serverImpl.AddClient3(
       m_connInfo, false, *m_wire,
@@ -152,6 +310,7 @@ NetworkServer::ServerConnection3::ServerConnection3(
         INFO("CONNECTED NT3 client '{}' (from {})", name, m_connInfo);
       },
       [this](uint32_t repeatMs) { UpdateOutgoingTimer(repeatMs); });
+  ClientAdded();
 
   stream->error.connect([this](uv::Error err) {
     if (!m_wire->GetDisconnectReason().empty()) {
@@ -173,9 +332,10 @@ NetworkServer::ServerConnection3::ServerConnection3(
     ConnectionClosed();
   });
   stream->data.connect([this](uv::Buffer& buf, size_t size) {
+    std::scoped_lock lock{m_server.m_serverMutex};
     if (m_server.m_serverImpl.ProcessIncomingBinary(
             m_clientId, {reinterpret_cast<const uint8_t*>(buf.base), size})) {
-      m_server.m_idle->Start();
+      m_ioLoop.idle->Start();
     }
   });
   stream->StartRead();
@@ -213,8 +373,12 @@ void NetworkServer::ServerConnection4::ProcessRequest() {
                  "<body><p>WebSockets must be used to access NetworkTables."
                  "</body></html>");
   } else if (isGET && path == "/nt/persistent.json") {
-    SendResponse(200, "OK", "application/json",
-                 m_server.m_serverImpl.DumpPersistent());
+    std::string persistent;
+    {
+      std::scoped_lock lock{m_server.m_serverMutex};
+      persistent = m_server.m_serverImpl.DumpPersistent();
+    }
+    SendResponse(200, "OK", "application/json", persistent);
   } else {
     SendError(404, "Resource not found");
   }
@@ -247,10 +411,34 @@ void NetworkServer::ServerConnection4::ProcessWsUpgrade() {
 
   m_websocket->open.connect([this, name = std::string{name}](
                                 std::string_view protocol) {
-    m_info.protocol_version =
-        protocol == "v4.1.networktables.first.wpi.edu" ? 0x0401 : 0x0400;
-    m_wire = std::make_shared<net::WebSocketConnection>(
-        *m_websocket, m_info.protocol_version, m_logger);
+    std::shared_ptr<net::SharedMemoryConnection> shm;
+    if (protocol == net::kSharedMemoryProtocol) {
+      m_info.protocol_version = 0x0402;
+      std::shared_ptr<net::SharedMemoryRegion> region;
+      if (net::IsLoopbackAddress(m_info.remote_ip)) {
+        region = net::SharedMemoryRegion::Open(m_sharedMemoryName);
+      }
+      if (!region) {
+        INFO("could not open shared memory '{}' (from {}), closing",
+             m_sharedMemoryName, m_connInfo);
+        m_websocket->Fail(1011, net::kSharedMemoryFailReason);
+        return;
+      }
+      shm = std::make_shared<net::SharedMemoryConnection>(
+          *m_websocket, m_info.protocol_version, std::move(region), true,
+          m_logger);
+      m_wire = shm;
+    } else {
+      if (protocol == "v4.2.networktables.first.wpi.edu") {
+        m_info.protocol_version = 0x0402;
+      } else if (protocol == "v4.1.networktables.first.wpi.edu") {
+        m_info.protocol_version = 0x0401;
+      } else {
+        m_info.protocol_version = 0x0400;
+      }
+      m_wire = std::make_shared<net::WebSocketConnection>(
+          *m_websocket, m_info.protocol_version, m_logger);
+    }
 
     if (protocol == "rtt.networktables.first.wpi.edu") {
       INFO("CONNECTED RTT client (from {})", m_connInfo);
@@ -281,12 +469,15 @@ void NetworkServer::ServerConnection4::ProcessWsUpgrade() {
       return;
     }
 
+    std::scoped_lock lock{m_server.m_serverMutex};
     // TODO: set local flag appropriately
     std::string dedupName;
     std::tie(dedupName, m_clientId) = m_server.m_serverImpl.AddClient(
         name, m_connInfo, false, *m_wire,
         [this](uint32_t repeatMs) { UpdateOutgoingTimer(repeatMs); });
-    INFO("CONNECTED NT4 client '{}' (from {})", dedupName, m_connInfo);
+    ClientAdded();
+    INFO("CONNECTED NT4 client '{}' (from {}{})", dedupName, m_connInfo,
+         shm ? ", shared memory" : "");
     m_info.remote_id = dedupName;
     m_server.AddConnection(this, m_info);
     m_websocket->closed.connect([this](uint16_t, std::string_view reason) {
@@ -295,16 +486,34 @@ void NetworkServer::ServerConnection4::ProcessWsUpgrade() {
            m_connInfo, realReason.empty() ? reason : realReason);
       ConnectionClosed();
     });
-    m_websocket->text.connect([this](std::string_view data, bool) {
+    auto processText = [this](std::string_view data) {
+      std::scoped_lock lock{m_server.m_serverMutex};
       if (m_server.m_serverImpl.ProcessIncomingText(m_clientId, data)) {
-        m_server.m_idle->Start();
+        m_ioLoop.idle->Start();
       }
-    });
-    m_websocket->binary.connect([this](std::span<const uint8_t> data, bool) {
+    };
+    auto processBinary = [this](std::span<const uint8_t> data) {
+      std::scoped_lock lock{m_server.m_serverMutex};
       if (m_server.m_serverImpl.ProcessIncomingBinary(m_clientId, data)) {
-        m_server.m_idle->Start();
+        m_ioLoop.idle->Start();
       }
-    });
+    };
+    if (shm) {
+      // the websocket is only used to wake up the shared memory connection
+      shm->SetHandlers(processText, processBinary);
+      m_websocket->text.connect(
+          [shm = shm.get()](std::string_view, bool) { shm->Poll(); });
+      m_websocket->binary.connect(
+          [shm = shm.get()](std::span<const uint8_t>, bool) { shm->Poll(); });
+      shm->Poll();
+    } else {
+      m_websocket->text.connect(
+          [processText](std::string_view data, bool) { processText(data); });
+      m_websocket->binary.connect(
+          [processBinary](std::span<const uint8_t> data, bool) {
+            processBinary(data);
+          });
+    }
 
     SetupOutgoingTimer();
   });
@@ -312,7 +521,8 @@ void NetworkServer::ServerConnection4::ProcessWsUpgrade() {
 
 NetworkServer::NetworkServer(std::string_view persistentFilename,
                              std::string_view listenAddress, unsigned int port3,
-                             unsigned int port4,
+                             unsigned int port4, unsigned int ioThreads,
+                             unsigned int bandwidthLimit,
                              net::ILocalStorage& localStorage,
                              IConnectionList& connList, wpi::Logger& logger,
                              std::function<void()> initDone)
@@ -327,14 +537,46 @@ NetworkServer::NetworkServer(std::string_view persistentFilename,
       m_serverImpl{logger},
       m_localQueue{logger},
       m_loop(*m_loopRunner.GetLoop()) {
+  m_serverImpl.SetClientBandwidthLimit(bandwidthLimit);
+
+  // the local client (id 0) is always serviced by the main loop
+  m_ioLoops.emplace_back(std::make_unique<IoLoop>(m_loop));
+  m_ioLoops.front()->clientIds.push_back(0);
+
+#ifndef _WIN32
+  // dedicated I/O loops for NT4 clients; these are fully set up before any
+  // connection can be handed off to them
+  if (ioThreads > 1) {
+    for (unsigned int i = 0; i < ioThreads; ++i) {
+      auto& runner =
+          m_ioRunners.emplace_back(std::make_unique<wpi::EventLoopRunner>());
+      auto& ioLoop =
+          m_ioLoops.emplace_back(std::make_unique<IoLoop>(*runner->GetLoop()));
+      ioLoop->runner = runner.get();
+      runner->ExecSync([&](uv::Loop&) {
+        wpi::SetCurrentThreadClass(wpi::ThreadClass::kNetwork, "NTServerIO");
+        InitIoLoop(*ioLoop);
+      });
+    }
+  }
+#endif
+
   m_loopRunner.ExecAsync([=, this](uv::Loop& loop) {
+    wpi::SetCurrentThreadClass(wpi::ThreadClass::kNetwork, "NTServer");
+    std::scoped_lock lock{m_serverMutex};
     // connect local storage to server
     m_serverImpl.SetLocal(&m_localStorage, &m_localQueue);
     m_localStorage.StartNetwork(&m_localQueue);
     ProcessAllLocal();
 
     // load persistent file first, then initialize
-    uv::QueueWork(m_loop, [this] { LoadPersistent(); }, [this] { Init(); });
+    uv::QueueWork(
+        m_loop,
+        [this] {
+          LoadPersistent();
+          LoadPersistentJournal();
+        },
+        [this] { Init(); });
   });
 }
 
@@ -356,11 +598,88 @@ void NetworkServer::Flush() {
   }
 }
 
+void NetworkServer::SetClientBandwidthLimit(unsigned int bytesPerSec) {
+  std::scoped_lock lock{m_serverMutex};
+  m_serverImpl.SetClientBandwidthLimit(bytesPerSec);
+}
+
 void NetworkServer::ProcessAllLocal() {
   while (m_serverImpl.ProcessLocalMessages(128)) {
   }
 }
 
+void NetworkServer::ProcessIncoming(IoLoop& ioLoop) {
+  std::scoped_lock lock{m_serverMutex};
+  bool more = false;
+  for (int clientId : ioLoop.clientIds) {
+    if (m_serverImpl.ProcessIncomingMessages(clientId,
+                                             kClientProcessMessageCountMax)) {
+      more = true;
+    }
+  }
+  if (more) {
+    DEBUG4("Starting idle processing");
+    ioLoop.idle->Start();  // more to process
+  } else {
+    DEBUG4("Stopping idle processing");
+    ioLoop.idle->Stop();  // go back to sleep
+  }
+}
+
+void NetworkServer::SendOutgoing(IoLoop& ioLoop, bool flush) {
+  // caller must hold m_serverMutex
+  auto now = ioLoop.loop.Now().count();
+  for (int clientId : ioLoop.clientIds) {
+    m_serverImpl.SendOutgoing(clientId, now, flush);
+  }
+}
+
+void NetworkServer::InitIoLoop(IoLoop& ioLoop) {
+  ioLoop.idle = uv::Idle::Create(ioLoop.loop);
+  if (ioLoop.idle) {
+    ioLoop.idle->idle.connect([this, &ioLoop] { ProcessIncoming(ioLoop); });
+  }
+
+  // the main loop flush processes local messages first, then wakes up the
+  // other loops, so it's set up separately in Init()
+  if (&ioLoop.loop != &m_loop) {
+    ioLoop.flush = uv::Async<>::Create(ioLoop.loop);
+    if (ioLoop.flush) {
+      ioLoop.flush->wakeup.connect([this, &ioLoop] {
+        std::scoped_lock lock{m_serverMutex};
+        SendOutgoing(ioLoop, true);
+      });
+    }
+  }
+}
+
+NetworkServer::IoLoop& NetworkServer::SelectIoLoop() {
+  if (m_ioLoops.size() == 1) {
+    return *m_ioLoops.front();
+  }
+  // least loaded dedicated I/O loop
+  auto it = std::min_element(
+      m_ioLoops.begin() + 1, m_ioLoops.end(), [](auto&& a, auto&& b) {
+        return a->numConnections.load() < b->numConnections.load();
+      });
+  return **it;
+}
+
+void NetworkServer::AcceptConnection4(IoLoop& ioLoop,
+                                      std::shared_ptr<uv::Tcp> tcp,
+                                      std::string_view peerAddr,
+                                      unsigned int peerPort) {
+  tcp->SetLogger(&m_logger);
+  tcp->error.connect([logger = &m_logger](uv::Error err) {
+    WPI_INFO(*logger, "NT4 socket error: {}", err.str());
+  });
+  tcp->SetNoDelay(true);
+  ++ioLoop.numConnections;
+  auto conn = std::make_shared<ServerConnection4>(tcp, *this, ioLoop, peerAddr,
+                                                  peerPort, m_logger);
+  tcp->SetData(conn);
+}
+
 void NetworkServer::LoadPersistent() {
   auto fileBuffer = wpi::MemoryBuffer::GetFile(m_persistentFilename);
   if (!fileBuffer) {
@@ -383,6 +702,32 @@ void NetworkServer::LoadPersistent() {
   m_persistentData =
       std::string{fileBuffer.value()->begin(), fileBuffer.value()->end()};
   DEBUG4("read data: {}", m_persistentData);
+  m_persistentSize = m_persistentData.size();
+}
+
+void NetworkServer::LoadPersistentJournal() {
+  auto fileBuffer = wpi::MemoryBuffer::GetFile(
+      fmt::format("{}.journal", m_persistentFilename));
+  if (!fileBuffer) {
+    return;
+  }
+  m_persistentJournalData =
+      std::string{fileBuffer.value()->begin(), fileBuffer.value()->end()};
+  DEBUG4("read journal: {}", m_persistentJournalData);
+}
+
+void NetworkServer::AppendPersistentJournal(std::string_view filename,
+                                            std::string_view data) {
+  auto journal = fmt::format("{}.journal", filename);
+  std::error_code ec;
+  wpi::raw_fd_ostream os{journal, ec, fs::F_Text | fs::F_Append};
+  if (ec.value() != 0) {
+    INFO("could not open persistent journal '{}' for write: {}", journal,
+         ec.message());
+    return;
+  }
+  os << data;
+  os.close();
 }
 
 void NetworkServer::SavePersistent(std::string_view filename,
@@ -411,25 +756,51 @@ void NetworkServer::SavePersistent(std::string_view filename,
   if (ec.value() != 0) {
     // attempt to restore backup
     fs::rename(bak, filename, ec);
+    return;
   }
+
+  // the journal is now fully contained in the real file
+  fs::remove(fmt::format("{}.journal", filename), ec);
 }
 
 void NetworkServer::Init() {
   if (m_shutdown) {
     return;
   }
+  std::scoped_lock lock{m_serverMutex};
   auto errs = m_serverImpl.LoadPersistent(m_persistentData);
   if (!errs.empty()) {
     WARN("error reading persistent file: {}", errs);
   }
+  errs = m_serverImpl.LoadPersistentChanges(m_persistentJournalData);
+  if (!errs.empty()) {
+    WARN("error reading persistent journal: {}", errs);
+  }
+  bool haveJournal = !m_persistentJournalData.empty();
+  m_persistentData.clear();
+  m_persistentJournalData.clear();
+
+  // fold a journal left from the last run into the full file right away
+  if (haveJournal) {
+    auto full = m_serverImpl.DumpPersistent();
+    m_persistentSize = full.size();
+    m_savePersistentPending = true;
+    uv::QueueWork(
+        m_loop,
+        [this, fn = m_persistentFilename, full = std::move(full)] {
+          SavePersistent(fn, full);
+        },
+        [this] { m_savePersistentPending = false; });
+  }
 
   // set up timers
   m_readLocalTimer = uv::Timer::Create(m_loop);
   if (m_readLocalTimer) {
     m_readLocalTimer->timeout.connect([this] {
+      std::scoped_lock lock{m_serverMutex};
       if (m_serverImpl.ProcessLocalMessages(kClientProcessMessageCountMax)) {
         DEBUG4("Starting idle processing");
-        m_idle->Start();  // more to process
+        m_ioLoops.front()->idle->Start();  // more to process
       }
     });
     m_readLocalTimer->Start(uv::Timer::Time{100}, uv::Timer::Time{100});
@@ -438,25 +809,64 @@ void NetworkServer::Init() {
   m_savePersistentTimer = uv::Timer::Create(m_loop);
   if (m_savePersistentTimer) {
     m_savePersistentTimer->timeout.connect([this] {
+      // saves must not be reordered, so wait for the previous one to finish
+      if (m_savePersistentPending) {
+        return;
+      }
+      std::scoped_lock lock{m_serverMutex};
       if (m_serverImpl.PersistentChanged()) {
+        // changes are always appended, even when compacting, so that the
+        // journal never holds anything older than the full file it follows
+        auto changes = m_serverImpl.DumpPersistentChanges();
+        m_persistentJournalSize += changes.size();
+        std::string full;
+        if (m_persistentJournalSize >
+            std::max(kPersistentJournalMinCompactSize, m_persistentSize)) {
+          full = m_serverImpl.DumpPersistent();
+          m_persistentSize = full.size();
+          m_persistentJournalSize = 0;
+        }
+        m_savePersistentPending = true;
         uv::QueueWork(
             m_loop,
-            [this, fn = m_persistentFilename,
-             data = m_serverImpl.DumpPersistent()] {
-              SavePersistent(fn, data);
+            [this, fn = m_persistentFilename, changes = std::move(changes),
+             full = std::move(full)] {
+              if (!changes.empty()) {
+                AppendPersistentJournal(fn, changes);
+              }
+              if (!full.empty()) {
+                SavePersistent(fn, full);
+              }
             },
-            nullptr);
+            [this] { m_savePersistentPending = false; });
       }
     });
     m_savePersistentTimer->Start(uv::Timer::Time{1000}, uv::Timer::Time{1000});
   }
 
+  m_statsTimer = uv::Timer::Create(m_loop);
+  if (m_statsTimer) {
+    m_statsTimer->timeout.connect([this] {
+      std::scoped_lock lock{m_serverMutex};
+      m_serverImpl.UpdateMetaStats();
+    });
+    m_statsTimer->Start(uv::Timer::Time{1000}, uv::Timer::Time{1000});
+  }
+
   // set up flush async
   m_flush = uv::Async<>::Create(m_loop);
   if (m_flush) {
     m_flush->wakeup.connect([this] {
-      ProcessAllLocal();
-      m_serverImpl.SendAllOutgoing(m_loop.Now().count(), true);
+      {
+        std::scoped_lock lock{m_serverMutex};
+        ProcessAllLocal();
+        SendOutgoing(*m_ioLoops.front(), true);
+      }
+      for (auto&& ioLoop : std::span{m_ioLoops}.subspan(1)) {
+        if (ioLoop->flush) {
+          ioLoop->flush->Send();
+        }
+      }
     });
   }
   m_flushAtomic = m_flush.get();
@@ -464,26 +874,16 @@ void NetworkServer::Init() {
   m_flushLocal = uv::Async<>::Create(m_loop);
   if (m_flushLocal) {
     m_flushLocal->wakeup.connect([this] {
+      std::scoped_lock lock{m_serverMutex};
       if (m_serverImpl.ProcessLocalMessages(kClientProcessMessageCountMax)) {
         DEBUG4("Starting idle processing");
-        m_idle->Start();  // more to process
+        m_ioLoops.front()->idle->Start();  // more to process
       }
     });
   }
   m_flushLocalAtomic = m_flushLocal.get();
 
-  m_idle = uv::Idle::Create(m_loop);
-  if (m_idle) {
-    m_idle->idle.connect([this] {
-      if (m_serverImpl.ProcessIncomingMessages(kClientProcessMessageCountMax)) {
-        DEBUG4("Starting idle processing");
-        m_idle->Start();  // more to process
-      } else {
-        DEBUG4("Stopping idle processing");
-        m_idle->Stop();  // go back to sleep
-      }
-    });
-  }
+  InitIoLoop(*m_ioLoops.front());
 
   INFO("Listening on NT3 port {}, NT4 port {}", m_port3, m_port4);
 
@@ -511,8 +911,10 @@ void NetworkServer::Init() {
       } else {
         INFO("Got a NT3 connection from unknown");
       }
-      auto conn = std::make_shared<ServerConnection3>(tcp, *this, peerAddr,
-                                                      peerPort, m_logger);
+      auto& ioLoop = *m_ioLoops.front();
+      ++ioLoop.numConnections;
+      auto conn = std::make_shared<ServerConnection3>(
+          tcp, *this, ioLoop, peerAddr, peerPort, m_logger);
       tcp->SetData(conn);
     });
 
@@ -532,11 +934,6 @@ void NetworkServer::Init() {
       if (!tcp) {
         return;
       }
-      tcp->SetLogger(&m_logger);
-      tcp->error.connect([logger = &m_logger](uv::Error err) {
-        WPI_INFO(*logger, "NT4 socket error: {}", err.str());
-      });
-      tcp->SetNoDelay(true);
       std::string peerAddr;
       unsigned int peerPort = 0;
       if (uv::AddrToName(tcp->GetPeer(), &peerAddr, &peerPort) == 0) {
@@ -544,9 +941,40 @@ void NetworkServer::Init() {
       } else {
         INFO("Got a NT4 connection from unknown");
       }
-      auto conn = std::make_shared<ServerConnection4>(tcp, *this, peerAddr,
-                                                      peerPort, m_logger);
-      tcp->SetData(conn);
+
+      auto& ioLoop = SelectIoLoop();
+      if (&ioLoop.loop == &m_loop) {
+        AcceptConnection4(ioLoop, std::move(tcp), peerAddr, peerPort);
+        return;
+      }
+
+#ifndef _WIN32
+      // hand off the socket to the selected I/O loop; libuv handles can't
+      // move between loops, so duplicate the descriptor and reopen it there
+      uv_os_fd_t fd;
+      if (uv_fileno(tcp->GetRawHandle(), &fd) != 0) {
+        tcp->Close();
+        return;
+      }
+      int newFd = ::dup(fd);
+      tcp->Close();
+      if (newFd < 0) {
+        WARN("could not hand off NT4 connection from {} port {}", peerAddr,
+             peerPort);
+        return;
+      }
+      ioLoop.runner->ExecAsync(
+          [this, &ioLoop, newFd, peerAddr = std::move(peerAddr),
+           peerPort](uv::Loop& loop) {
+            auto tcp = uv::Tcp::Create(loop);
+            if (!tcp) {
+              ::close(newFd);
+              return;
+            }
+            tcp->Open(newFd);
+            AcceptConnection4(ioLoop, std::move(tcp), peerAddr, peerPort);
+          });
+#endif
     });
 
     tcp4->Listen();
@@ -561,13 +989,13 @@ void NetworkServer::Init() {
 
 void NetworkServer::AddConnection(ServerConnection* conn,
                                   const ConnectionInfo& info) {
-  std::scoped_lock lock{m_mutex};
+  std::scoped_lock lock{m_serverMutex, m_mutex};
   m_connections.emplace_back(Connection{conn, m_connList.AddConnection(info)});
   m_serverImpl.ConnectionsChanged(m_connList.GetConnections());
 }
 
 void NetworkServer::RemoveConnection(ServerConnection* conn) {
-  std::scoped_lock lock{m_mutex};
+  std::scoped_lock lock{m_serverMutex, m_mutex};
   auto it = std::find_if(m_connections.begin(), m_connections.end(),
                          [=](auto&& c) { return c.conn == conn; });
   if (it != m_connections.end()) {
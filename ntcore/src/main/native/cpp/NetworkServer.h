@@ -14,6 +14,7 @@
 #include <wpinet/EventLoopRunner.h>
 #include <wpinet/uv/Async.h>
 #include <wpinet/uv/Idle.h>
+#include <wpinet/uv/Tcp.h>
 #include <wpinet/uv/Timer.h>
 
 #include "net/ClientMessageQueue.h"
@@ -37,7 +38,8 @@ class NetworkServer {
  public:
   NetworkServer(std::string_view persistentFilename,
                 std::string_view listenAddress, unsigned int port3,
-                unsigned int port4, net::ILocalStorage& localStorage,
+                unsigned int port4, unsigned int ioThreads,
+                unsigned int bandwidthLimit, net::ILocalStorage& localStorage,
                 IConnectionList& connList, wpi::Logger& logger,
                 std::function<void()> initDone);
   ~NetworkServer();
@@ -45,13 +47,41 @@ class NetworkServer {
   void FlushLocal();
   void Flush();
 
+  // applies to connections made after this call
+  void SetClientBandwidthLimit(unsigned int bytesPerSec);
+
  private:
   class ServerConnection;
   class ServerConnection3;
   class ServerConnection4;
 
+  // Event loop servicing a set of client connections.  Index 0 in m_ioLoops
+  // is the main server loop; any others are dedicated I/O loops, each running
+  // on its own thread.  All access to m_serverImpl from any loop must hold
+  // m_serverMutex, and each client's connection is only ever touched from its
+  // own loop.
+  struct IoLoop {
+    explicit IoLoop(wpi::uv::Loop& loop) : loop{loop} {}
+
+    wpi::uv::Loop& loop;
+    wpi::EventLoopRunner* runner = nullptr;  // nullptr for the main loop
+    std::shared_ptr<wpi::uv::Idle> idle;
+    std::shared_ptr<wpi::uv::Async<>> flush;
+    std::vector<int> clientIds;  // protected by m_serverMutex
+    std::atomic<unsigned int> numConnections{0};
+  };
+
   void ProcessAllLocal();
+  void ProcessIncoming(IoLoop& ioLoop);
+  void SendOutgoing(IoLoop& ioLoop, bool flush);
+  void InitIoLoop(IoLoop& ioLoop);
+  IoLoop& SelectIoLoop();
+  void AcceptConnection4(IoLoop& ioLoop, std::shared_ptr<wpi::uv::Tcp> tcp,
+                         std::string_view peerAddr, unsigned int peerPort);
   void LoadPersistent();
+  void LoadPersistentJournal();
+  void AppendPersistentJournal(std::string_view filename,
+                               std::string_view data);
   void SavePersistent(std::string_view filename, std::string_view data);
   void Init();
   void AddConnection(ServerConnection* conn, const ConnectionInfo& info);
@@ -62,6 +92,7 @@ class NetworkServer {
   wpi::Logger& m_logger;
   std::function<void()> m_initDone;
   std::string m_persistentData;
+  std::string m_persistentJournalData;
   std::string m_persistentFilename;
   std::string m_listenAddress;
   unsigned int m_port3;
@@ -70,14 +101,20 @@ class NetworkServer {
   // used only from loop
   std::shared_ptr<wpi::uv::Timer> m_readLocalTimer;
   std::shared_ptr<wpi::uv::Timer> m_savePersistentTimer;
+  std::shared_ptr<wpi::uv::Timer> m_statsTimer;
+  bool m_savePersistentPending = false;
+  size_t m_persistentSize = 0;         // size of last full persistent file
+  size_t m_persistentJournalSize = 0;  // bytes appended since last full save
   std::shared_ptr<wpi::uv::Async<>> m_flushLocal;
   std::shared_ptr<wpi::uv::Async<>> m_flush;
-  std::shared_ptr<wpi::uv::Idle> m_idle;
   bool m_shutdown = false;
 
   using Queue = net::LocalClientMessageQueue;
   net::ClientMessage m_localMsgs[Queue::kBlockSize];
 
+  // recursive because closing a connection from within m_serverImpl (e.g. on
+  // a decode error) synchronously calls back into it
+  wpi::recursive_mutex m_serverMutex;
   server::ServerImpl m_serverImpl;
 
   // shared with user (must be atomic or mutex-protected)
@@ -92,6 +129,9 @@ class NetworkServer {
 
   Queue m_localQueue;
 
+  std::vector<std::unique_ptr<IoLoop>> m_ioLoops;
+  std::vector<std::unique_ptr<wpi::EventLoopRunner>> m_ioRunners;
+
   wpi::EventLoopRunner m_loopRunner;
   wpi::uv::Loop& m_loop;
 };
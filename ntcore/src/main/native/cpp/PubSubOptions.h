@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #include "ntcore_cpp.h"
 
 namespace nt {
@@ -20,6 +22,7 @@ class PubSubOptionsImpl : public PubSubOptions {
       periodic = kDefaultPeriodic;
     }
     periodicMs = static_cast<unsigned int>(periodic * 1000);
+    coalescePeriodUs = static_cast<int64_t>(coalescePeriod * 1000000);
     if (pollStorage == 0) {
       if (sendAll) {
         pollStorage = 20;
@@ -31,6 +34,7 @@ class PubSubOptionsImpl : public PubSubOptions {
 
   static constexpr unsigned int kDefaultPeriodicMs = 100;
   unsigned int periodicMs = kDefaultPeriodicMs;
+  int64_t coalescePeriodUs = 0;
 };
 
 }  // namespace nt
@@ -47,7 +47,7 @@ struct StringArrayStorage {
 };
 
 template <typename T>
-inline std::shared_ptr<T[]> AllocateArray(size_t nelem) {
+inline std::shared_ptr<T[]> AllocateSharedArray(size_t nelem) {
 #if __cpp_lib_shared_ptr_arrays >= 201707L
 #if __cpp_lib_smart_ptr_for_overwrite >= 202002L
   return std::make_shared_for_overwrite<T[]>(nelem);
@@ -69,27 +69,50 @@ void StringArrayStorage::InitNtStrings() {
   }
 }
 
+template <typename T>
+T* Value::AllocateArray(size_t nelem) {
+  if (nelem * sizeof(T) <= kInlineSize) {
+    m_isInline = true;
+    return reinterpret_cast<T*>(m_inline);
+  }
+  auto data = AllocateSharedArray<T>(nelem);
+  T* arr = data.get();
+  m_storage = std::move(data);
+  return arr;
+}
+
+Value Value::MakeString(std::string_view value, int64_t time) {
+  Value val{NT_STRING, value.size(), time, private_init{}};
+  char* data = val.AllocateArray<char>(value.size() + 1);
+  std::copy(value.begin(), value.end(), data);
+  data[value.size()] = '\0';
+  val.m_val.data.v_string.str = data;
+  val.m_val.data.v_string.len = value.size();
+  return val;
+}
+
 Value Value::MakeBooleanArray(std::span<const bool> value, int64_t time) {
   Value val{NT_BOOLEAN_ARRAY, value.size() * sizeof(int), time, private_init{}};
-  auto data = AllocateArray<int>(value.size());
-  std::copy(value.begin(), value.end(), data.get());
-  val.m_val.data.arr_boolean.arr = data.get();
+  int* data = val.AllocateArray<int>(value.size());
+  std::copy(value.begin(), value.end(), data);
+  val.m_val.data.arr_boolean.arr = data;
   val.m_val.data.arr_boolean.size = value.size();
-  val.m_storage = std::move(data);
   return val;
 }
 
 Value Value::MakeBooleanArray(std::span<const int> value, int64_t time) {
   Value val{NT_BOOLEAN_ARRAY, value.size() * sizeof(int), time, private_init{}};
-  auto data = AllocateArray<int>(value.size());
-  std::copy(value.begin(), value.end(), data.get());
-  val.m_val.data.arr_boolean.arr = data.get();
+  int* data = val.AllocateArray<int>(value.size());
+  std::copy(value.begin(), value.end(), data);
+  val.m_val.data.arr_boolean.arr = data;
   val.m_val.data.arr_boolean.size = value.size();
-  val.m_storage = std::move(data);
   return val;
 }
 
 Value Value::MakeBooleanArray(std::vector<int>&& value, int64_t time) {
+  if (value.size() * sizeof(int) <= kInlineSize) {
+    return MakeBooleanArray(std::span<const int>{value}, time);
+  }
   Value val{NT_BOOLEAN_ARRAY, value.size() * sizeof(int), time, private_init{}};
   auto data = std::make_shared<std::vector<int>>(std::move(value));
   val.m_val.data.arr_boolean.arr = data->data();
@@ -98,18 +121,33 @@ Value Value::MakeBooleanArray(std::vector<int>&& value, int64_t time) {
   return val;
 }
 
+Value Value::MakeRaw(std::span<const uint8_t> value, int64_t time) {
+  Value val = AllocateRaw(value.size(), time);
+  std::copy(value.begin(), value.end(), val.m_val.data.v_raw.data);
+  return val;
+}
+
+Value Value::AllocateRaw(size_t size, int64_t time) {
+  Value val{NT_RAW, size, time, private_init{}};
+  val.m_val.data.v_raw.data = val.AllocateArray<uint8_t>(size);
+  val.m_val.data.v_raw.size = size;
+  return val;
+}
+
 Value Value::MakeIntegerArray(std::span<const int64_t> value, int64_t time) {
   Value val{NT_INTEGER_ARRAY, value.size() * sizeof(int64_t), time,
             private_init{}};
-  auto data = AllocateArray<int64_t>(value.size());
-  std::copy(value.begin(), value.end(), data.get());
-  val.m_val.data.arr_int.arr = data.get();
+  int64_t* data = val.AllocateArray<int64_t>(value.size());
+  std::copy(value.begin(), value.end(), data);
+  val.m_val.data.arr_int.arr = data;
   val.m_val.data.arr_int.size = value.size();
-  val.m_storage = std::move(data);
   return val;
 }
 
 Value Value::MakeIntegerArray(std::vector<int64_t>&& value, int64_t time) {
+  if (value.size() * sizeof(int64_t) <= kInlineSize) {
+    return MakeIntegerArray(std::span<const int64_t>{value}, time);
+  }
   Value val{NT_INTEGER_ARRAY, value.size() * sizeof(int64_t), time,
             private_init{}};
   auto data = std::make_shared<std::vector<int64_t>>(std::move(value));
@@ -121,15 +159,17 @@ Value Value::MakeIntegerArray(std::vector<int64_t>&& value, int64_t time) {
 
 Value Value::MakeFloatArray(std::span<const float> value, int64_t time) {
   Value val{NT_FLOAT_ARRAY, value.size() * sizeof(float), time, private_init{}};
-  auto data = AllocateArray<float>(value.size());
-  std::copy(value.begin(), value.end(), data.get());
-  val.m_val.data.arr_float.arr = data.get();
+  float* data = val.AllocateArray<float>(value.size());
+  std::copy(value.begin(), value.end(), data);
+  val.m_val.data.arr_float.arr = data;
   val.m_val.data.arr_float.size = value.size();
-  val.m_storage = std::move(data);
   return val;
 }
 
 Value Value::MakeFloatArray(std::vector<float>&& value, int64_t time) {
+  if (value.size() * sizeof(float) <= kInlineSize) {
+    return MakeFloatArray(std::span<const float>{value}, time);
+  }
   Value val{NT_FLOAT_ARRAY, value.size() * sizeof(float), time, private_init{}};
   auto data = std::make_shared<std::vector<float>>(std::move(value));
   val.m_val.data.arr_float.arr = data->data();
@@ -141,15 +181,17 @@ Value Value::MakeFloatArray(std::vector<float>&& value, int64_t time) {
 Value Value::MakeDoubleArray(std::span<const double> value, int64_t time) {
   Value val{NT_DOUBLE_ARRAY, value.size() * sizeof(double), time,
             private_init{}};
-  auto data = AllocateArray<double>(value.size());
-  std::copy(value.begin(), value.end(), data.get());
-  val.m_val.data.arr_double.arr = data.get();
+  double* data = val.AllocateArray<double>(value.size());
+  std::copy(value.begin(), value.end(), data);
+  val.m_val.data.arr_double.arr = data;
   val.m_val.data.arr_double.size = value.size();
-  val.m_storage = std::move(data);
   return val;
 }
 
 Value Value::MakeDoubleArray(std::vector<double>&& value, int64_t time) {
+  if (value.size() * sizeof(double) <= kInlineSize) {
+    return MakeDoubleArray(std::span<const double>{value}, time);
+  }
   Value val{NT_DOUBLE_ARRAY, value.size() * sizeof(double), time,
             private_init{}};
   auto data = std::make_shared<std::vector<double>>(std::move(value));
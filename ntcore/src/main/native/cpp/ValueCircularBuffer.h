@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #include <utility>
 #include <vector>
 
@@ -17,19 +19,39 @@ namespace nt {
 
 class ValueCircularBuffer {
  public:
-  explicit ValueCircularBuffer(size_t size) : m_storage{size} {}
+  /**
+   * Constructor.
+   *
+   * @param size maximum number of values stored
+   * @param coalescePeriod if nonzero, a value whose time (in microseconds)
+   *                       falls in the same period as the most recently stored
+   *                       value replaces that value instead of being added
+   */
+  explicit ValueCircularBuffer(size_t size, int64_t coalescePeriod = 0)
+      : m_storage{size}, m_coalescePeriod{coalescePeriod} {}
 
-  template <class... Args>
-  void emplace_back(Args&&... args) {
-    m_storage.emplace_back(std::forward<Args...>(args...));
+  void emplace_back(const Value& value) {
+    if (m_coalescePeriod > 0 && m_storage.size() != 0 &&
+        m_storage.back().time() / m_coalescePeriod ==
+            value.time() / m_coalescePeriod) {
+      m_storage.back() = value;
+      return;
+    }
+    m_storage.emplace_back(value);
   }
 
   std::vector<Value> ReadValue(unsigned int types);
   template <ValidType T>
   std::vector<Timestamped<typename TypeInfo<T>::Value>> Read();
 
+  // reads into buf, overwriting its existing elements in place; elements
+  // past the number of values read are destroyed
+  template <ValidType T>
+  void Read(std::vector<Timestamped<typename TypeInfo<T>::Value>>& buf);
+
  private:
   wpi::circular_buffer<Value> m_storage;
+  int64_t m_coalescePeriod;
 };
 
 template <ValidType T>
@@ -46,4 +68,22 @@ ValueCircularBuffer::Read() {
   return rv;
 }
 
+template <ValidType T>
+void ValueCircularBuffer::Read(
+    std::vector<Timestamped<typename TypeInfo<T>::Value>>& buf) {
+  size_t count = 0;
+  for (auto&& val : m_storage) {
+    if (IsNumericConvertibleTo<T>(val) || IsType<T>(val)) {
+      if (count < buf.size()) {
+        AssignTimestamped<T, true>(val, buf[count]);
+      } else {
+        buf.emplace_back(GetTimestamped<T, true>(val));
+      }
+      ++count;
+    }
+  }
+  buf.resize(count);
+  m_storage.reset();
+}
+
 }  // namespace nt
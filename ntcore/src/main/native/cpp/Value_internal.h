@@ -404,6 +404,42 @@ inline Timestamped<typename TypeInfo<T>::Value> GetTimestamped(
           GetValueCopy<T, ConvertNumeric>(value)};
 }
 
+// like GetValueCopy(), but reuses the existing storage of out
+template <ValidType T, bool ConvertNumeric>
+inline void AssignValueCopy(const Value& value,
+                            typename TypeInfo<T>::Value& out) {
+  if constexpr (ConvertNumeric && NumericType<T>) {
+    out = GetNumericAs<T>(value);
+  } else if constexpr (ConvertNumeric && NumericArrayType<T>) {
+    if (value.IsIntegerArray()) {
+      auto arr = value.GetIntegerArray();
+      out.assign(arr.begin(), arr.end());
+    } else if (value.IsFloatArray()) {
+      auto arr = value.GetFloatArray();
+      out.assign(arr.begin(), arr.end());
+    } else if (value.IsDoubleArray()) {
+      auto arr = value.GetDoubleArray();
+      out.assign(arr.begin(), arr.end());
+    } else {
+      out.clear();
+    }
+  } else if constexpr (ArrayType<T> || IsNTType<T, NT_RAW> ||
+                       IsNTType<T, NT_STRING>) {
+    auto view = GetValueView<T>(value);
+    out.assign(view.begin(), view.end());
+  } else {
+    out = GetValueView<T>(value);
+  }
+}
+
+template <ValidType T, bool ConvertNumeric>
+inline void AssignTimestamped(const Value& value,
+                              Timestamped<typename TypeInfo<T>::Value>& out) {
+  out.time = value.time();
+  out.serverTime = value.server_time();
+  AssignValueCopy<T, ConvertNumeric>(value, out.value);
+}
+
 template <SmallArrayType T, bool ConvertNumeric>
 inline Timestamped<typename TypeInfo<T>::SmallRet> GetTimestamped(
     const Value& value,
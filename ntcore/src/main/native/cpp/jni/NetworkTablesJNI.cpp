@@ -143,6 +143,8 @@ static nt::PubSubOptions FromJavaPubSubOptions(JNIEnv* env, jobject joptions) {
   FIELD(disableLocal, "Z");
   FIELD(excludeSelf, "Z");
   FIELD(hidden, "Z");
+  FIELD(deltaArrays, "Z");
+  FIELD(coalescePeriod, "D");
 
 #undef FIELD
 
@@ -159,7 +161,9 @@ static nt::PubSubOptions FromJavaPubSubOptions(JNIEnv* env, jobject joptions) {
           FIELD(bool, Boolean, disableRemote),
           FIELD(bool, Boolean, disableLocal),
           FIELD(bool, Boolean, excludeSelf),
-          FIELD(bool, Boolean, hidden)};
+          FIELD(bool, Boolean, hidden),
+          FIELD(bool, Boolean, deltaArrays),
+          FIELD(double, Double, coalescePeriod)};
 
 #undef GET
 #undef FIELD
@@ -301,11 +305,12 @@ static jobject MakeJObject(JNIEnv* env, jobject inst,
 
 static jobject MakeJObject(JNIEnv* env, const nt::TimeSyncEventData& data) {
   static jmethodID constructor =
-      env->GetMethodID(timeSyncEventDataCls, "<init>", "(JJZ)V");
+      env->GetMethodID(timeSyncEventDataCls, "<init>", "(JJZJ)V");
   return env->NewObject(timeSyncEventDataCls, constructor,
                         static_cast<jlong>(data.serverTimeOffset),
                         static_cast<jlong>(data.rtt2),
-                        static_cast<jboolean>(data.valid));
+                        static_cast<jboolean>(data.valid),
+                        static_cast<jlong>(data.uncertainty));
 }
 
 static jobject MakeJObject(JNIEnv* env, jobject inst, const nt::Event& event) {
@@ -1004,6 +1009,65 @@ Java_edu_wpi_first_networktables_NetworkTablesJNI_getValue
   return MakeJValue(env, nt::GetEntryValue(entry));
 }
 
+/*
+ * Class:     edu_wpi_first_networktables_NetworkTablesJNI
+ * Method:    setDoubles
+ * Signature: ([IJ[D)Z
+ */
+JNIEXPORT jboolean JNICALL
+Java_edu_wpi_first_networktables_NetworkTablesJNI_setDoubles
+  (JNIEnv* env, jclass, jintArray entries, jlong time, jdoubleArray values)
+{
+  if (!entries) {
+    nullPointerEx.Throw(env, "entries cannot be null");
+    return false;
+  }
+  if (!values) {
+    nullPointerEx.Throw(env, "values cannot be null");
+    return false;
+  }
+  if (env->GetArrayLength(entries) != env->GetArrayLength(values)) {
+    illegalArgEx.Throw(env, "entries and values must be the same length");
+    return false;
+  }
+  CriticalJSpan<const jint> entriesRef{env, entries};
+  CriticalJSpan<const jdouble> valuesRef{env, values};
+  bool rv = true;
+  for (size_t i = 0; i < entriesRef.size(); ++i) {
+    rv = nt::SetDouble(entriesRef[i], valuesRef[i], time) && rv;
+  }
+  return rv;
+}
+
+/*
+ * Class:     edu_wpi_first_networktables_NetworkTablesJNI
+ * Method:    getDoubles
+ * Signature: ([ID[D)V
+ */
+JNIEXPORT void JNICALL
+Java_edu_wpi_first_networktables_NetworkTablesJNI_getDoubles
+  (JNIEnv* env, jclass, jintArray entries, jdouble defaultValue,
+   jdoubleArray values)
+{
+  if (!entries) {
+    nullPointerEx.Throw(env, "entries cannot be null");
+    return;
+  }
+  if (!values) {
+    nullPointerEx.Throw(env, "values cannot be null");
+    return;
+  }
+  if (env->GetArrayLength(entries) != env->GetArrayLength(values)) {
+    illegalArgEx.Throw(env, "entries and values must be the same length");
+    return;
+  }
+  CriticalJSpan<const jint> entriesRef{env, entries};
+  CriticalJSpan<jdouble> valuesRef{env, values};
+  for (size_t i = 0; i < entriesRef.size(); ++i) {
+    valuesRef[i] = nt::GetDouble(entriesRef[i], defaultValue);
+  }
+}
+
 /*
  * Class:     edu_wpi_first_networktables_NetworkTablesJNI
  * Method:    setEntryFlags
@@ -1204,6 +1268,22 @@ Java_edu_wpi_first_networktables_NetworkTablesJNI_stopServer
   nt::StopServer(inst);
 }
 
+/*
+ * Class:     edu_wpi_first_networktables_NetworkTablesJNI
+ * Method:    setServerIoThreads
+ * Signature: (II)V
+ */
+JNIEXPORT void JNICALL
+Java_edu_wpi_first_networktables_NetworkTablesJNI_setServerIoThreads
+  (JNIEnv* env, jclass, jint inst, jint count)
+{
+  if (count < 0) {
+    illegalArgEx.Throw(env, "count cannot be negative");
+    return;
+  }
+  nt::SetServerIoThreads(inst, count);
+}
+
 /*
  * Class:     edu_wpi_first_networktables_NetworkTablesJNI
  * Method:    startClient3
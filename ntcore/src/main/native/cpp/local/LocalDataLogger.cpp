@@ -10,6 +10,66 @@
 
 using namespace nt::local;
 
+static void AppendValue(wpi::log::DataLog& log, int entry, const nt::Value& v) {
+  auto time = v.time();
+  switch (v.type()) {
+    case NT_BOOLEAN:
+      log.AppendBoolean(entry, v.GetBoolean(), time);
+      break;
+    case NT_INTEGER:
+      log.AppendInteger(entry, v.GetInteger(), time);
+      break;
+    case NT_FLOAT:
+      log.AppendFloat(entry, v.GetFloat(), time);
+      break;
+    case NT_DOUBLE:
+      log.AppendDouble(entry, v.GetDouble(), time);
+      break;
+    case NT_STRING:
+      log.AppendString(entry, v.GetString(), time);
+      break;
+    case NT_RAW: {
+      auto val = v.GetRaw();
+      log.AppendRaw(entry,
+                    {reinterpret_cast<const uint8_t*>(val.data()), val.size()},
+                    time);
+      break;
+    }
+    case NT_BOOLEAN_ARRAY:
+      log.AppendBooleanArray(entry, v.GetBooleanArray(), time);
+      break;
+    case NT_INTEGER_ARRAY:
+      log.AppendIntegerArray(entry, v.GetIntegerArray(), time);
+      break;
+    case NT_FLOAT_ARRAY:
+      log.AppendFloatArray(entry, v.GetFloatArray(), time);
+      break;
+    case NT_DOUBLE_ARRAY:
+      log.AppendDoubleArray(entry, v.GetDoubleArray(), time);
+      break;
+    case NT_STRING_ARRAY:
+      log.AppendStringArray(entry, v.GetStringArray(), time);
+      break;
+    default:
+      break;
+  }
+}
+
+LocalDataLogger::LocalDataLogger(NT_DataLogger handle, wpi::log::DataLog& log,
+                                 std::string_view prefix,
+                                 std::string_view logPrefix)
+    : handle{handle},
+      log{log},
+      prefix{prefix},
+      logPrefix{logPrefix} {
+  m_flushCallback = log.AddFlushCallback([this] { Flush(); });
+}
+
+LocalDataLogger::~LocalDataLogger() {
+  log.RemoveFlushCallback(m_flushCallback);
+  Flush();
+}
+
 int LocalDataLogger::Start(std::string_view name, std::string_view typeStr,
                            std::string_view metadata, int64_t time) {
   // NT and DataLog use different standard representations for int and int[]
@@ -22,3 +82,27 @@ int LocalDataLogger::Start(std::string_view name, std::string_view typeStr,
                                wpi::remove_prefix(name, prefix).value_or(name)),
                    typeStr, metadata, time);
 }
+
+void LocalDataLogger::Append(int entry, const Value& value) {
+  {
+    std::scoped_lock lock{m_queueMutex};
+    m_queue.emplace_back(entry, value);
+    if (m_queue.size() < kMaxQueued) {
+      [[likely]] return;
+    }
+  }
+  Flush();
+}
+
+void LocalDataLogger::Flush() {
+  std::scoped_lock flushLock{m_flushMutex};
+  {
+    std::scoped_lock lock{m_queueMutex};
+    m_flushing.swap(m_queue);
+  }
+  for (auto&& [entry, value] : m_flushing) {
+    AppendValue(log, entry, value);
+  }
+  // keep the capacity for the next batch
+  m_flushing.clear();
+}
@@ -8,8 +8,13 @@
 
 #include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
+
+#include <wpi/mutex.h>
 
 #include "Handle.h"
+#include "networktables/NetworkTableValue.h"
 #include "ntcore_c.h"
 
 namespace wpi::log {
@@ -24,16 +29,42 @@ struct LocalDataLogger {
   static constexpr auto kType = Handle::kDataLogger;
 
   LocalDataLogger(NT_DataLogger handle, wpi::log::DataLog& log,
-                  std::string_view prefix, std::string_view logPrefix)
-      : handle{handle}, log{log}, prefix{prefix}, logPrefix{logPrefix} {}
+                  std::string_view prefix, std::string_view logPrefix);
+  ~LocalDataLogger();
+
+  LocalDataLogger(const LocalDataLogger&) = delete;
+  LocalDataLogger& operator=(const LocalDataLogger&) = delete;
 
   int Start(std::string_view name, std::string_view typeStr,
             std::string_view metadata, int64_t time);
 
+  // Queues a value to be appended to a log entry.  Values are appended in
+  // batches by Flush(), which the log calls from its writer thread, so
+  // publishing only copies the value (array and string contents are shared,
+  // not copied).
+  void Append(int entry, const Value& value);
+
+  // Appends all queued values to the log.  Must be called before finishing
+  // an entry, so its values are appended before the finish record.
+  void Flush();
+
   NT_DataLogger handle;
   wpi::log::DataLog& log;
   std::string prefix;
   std::string logPrefix;
+
+ private:
+  // flush on the appending thread once this many entries are queued
+  static constexpr size_t kMaxQueued = 4096;
+
+  int m_flushCallback = 0;
+
+  wpi::mutex m_queueMutex;
+  std::vector<std::pair<int, Value>> m_queue;
+
+  // held while appending queued values, so they stay in order
+  wpi::mutex m_flushMutex;
+  std::vector<std::pair<int, Value>> m_flushing;
 };
 
 }  // namespace nt::local
@@ -11,11 +11,7 @@
 
 #include <wpi/DataLog.h>
 
-#include "ntcore_c.h"
-
-namespace wpi::log {
-class DataLog;
-}  // namespace wpi::log
+#include "local/LocalDataLogger.h"
 
 namespace nt {
 class Value;
@@ -26,20 +22,22 @@ namespace nt::local {
 struct LocalTopic;
 
 struct LocalDataLoggerEntry {
-  LocalDataLoggerEntry(wpi::log::DataLog& log, int entry, NT_DataLogger logger)
-      : log{&log}, entry{entry}, logger{logger} {}
+  LocalDataLoggerEntry(LocalDataLogger& logger, int entry)
+      : logger{&logger}, entry{entry} {}
 
   static std::string MakeMetadata(std::string_view properties);
 
-  void Append(const Value& v);
-  void Finish(int64_t timestamp) { log->Finish(entry, timestamp); }
+  void Append(const Value& v) { logger->Append(entry, v); }
+  void Finish(int64_t timestamp) {
+    logger->Flush();
+    logger->log.Finish(entry, timestamp);
+  }
   void SetMetadata(std::string_view metadata, int64_t timestamp) {
-    log->SetMetadata(entry, metadata, timestamp);
+    logger->log.SetMetadata(entry, metadata, timestamp);
   }
 
-  wpi::log::DataLog* log;
+  LocalDataLogger* logger;
   int entry;
-  NT_DataLogger logger;
 };
 
 }  // namespace nt::local
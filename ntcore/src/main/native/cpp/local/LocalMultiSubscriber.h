@@ -54,6 +54,9 @@ struct LocalMultiSubscriber {
 
   // value listeners
   VectorSet<NT_Listener> valueListeners;
+
+  // topic listeners
+  VectorSet<NT_Listener> topicListeners;
 };
 
 }  // namespace nt::local
@@ -0,0 +1,122 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <bit>
+#include <vector>
+
+#include "Handle.h"
+#include "networktables/NetworkTableValue.h"
+#include "ntcore_c.h"
+
+namespace nt::local {
+
+// Last values of scalar (boolean, integer, float, and double) topics, stored
+// as parallel arrays indexed by topic handle index. This is a copy of each
+// topic's lastValue kept for bulk reads, which only need to walk these arrays
+// instead of visiting every topic.
+class LocalScalarStore {
+ public:
+  // Stores the value for the topic; non-scalar or unassigned values remove
+  // the topic from the store.
+  void Set(NT_Topic topic, const Value& value) {
+    unsigned int i = Handle{topic}.GetIndex();
+    if (i >= m_types.size()) {
+      if (!IsScalar(value.type())) {
+        return;
+      }
+      m_topics.resize(i + 1);
+      m_types.resize(i + 1, NT_UNASSIGNED);
+      m_data.resize(i + 1);
+      m_times.resize(i + 1);
+      m_serverTimes.resize(i + 1);
+    }
+    if (!IsScalar(value.type())) {
+      m_types[i] = NT_UNASSIGNED;
+      return;
+    }
+    m_topics[i] = topic;
+    m_types[i] = value.type();
+    m_times[i] = value.time();
+    m_serverTimes[i] = value.server_time();
+    switch (value.type()) {
+      case NT_BOOLEAN:
+        m_data[i] = value.GetBoolean();
+        break;
+      case NT_INTEGER:
+        m_data[i] = value.GetInteger();
+        break;
+      case NT_FLOAT:
+        m_data[i] = std::bit_cast<uint32_t>(value.GetFloat());
+        break;
+      case NT_DOUBLE:
+        m_data[i] = std::bit_cast<int64_t>(value.GetDouble());
+        break;
+      default:
+        break;
+    }
+  }
+
+  // Calls func(NT_Topic, const Value&) for each stored value whose type is in
+  // the types bitmask (0 is treated as all types).
+  template <typename F>
+  void ForEach(unsigned int types, F&& func) const {
+    for (size_t i = 0; i < m_types.size(); ++i) {
+      if (m_types[i] != NT_UNASSIGNED &&
+          (types == 0 || (types & m_types[i]) != 0)) {
+        func(m_topics[i], GetValue(i));
+      }
+    }
+  }
+
+  void clear() {
+    m_topics.clear();
+    m_types.clear();
+    m_data.clear();
+    m_times.clear();
+    m_serverTimes.clear();
+  }
+
+ private:
+  static constexpr bool IsScalar(NT_Type type) {
+    return type == NT_BOOLEAN || type == NT_INTEGER || type == NT_FLOAT ||
+           type == NT_DOUBLE;
+  }
+
+  Value GetValue(size_t i) const {
+    Value value;
+    // pass a nonzero time so the factories don't call Now()
+    switch (m_types[i]) {
+      case NT_BOOLEAN:
+        value = Value::MakeBoolean(m_data[i] != 0, 1);
+        break;
+      case NT_INTEGER:
+        value = Value::MakeInteger(m_data[i], 1);
+        break;
+      case NT_FLOAT:
+        value = Value::MakeFloat(
+            std::bit_cast<float>(static_cast<uint32_t>(m_data[i])), 1);
+        break;
+      case NT_DOUBLE:
+        value = Value::MakeDouble(std::bit_cast<double>(m_data[i]), 1);
+        break;
+      default:
+        break;
+    }
+    value.SetTime(m_times[i]);
+    value.SetServerTime(m_serverTimes[i]);
+    return value;
+  }
+
+  std::vector<NT_Topic> m_topics;
+  std::vector<NT_Type> m_types;
+  std::vector<int64_t> m_data;  // value, or bit pattern for float and double
+  std::vector<int64_t> m_times;
+  std::vector<int64_t> m_serverTimes;
+};
+
+}  // namespace nt::local
@@ -4,6 +4,7 @@
 
 #include "LocalStorageImpl.h"
 
+#include <algorithm>
 #include <memory>
 #include <string_view>
 #include <utility>
@@ -169,17 +170,58 @@ LocalTopic* StorageImpl::GetOrCreateTopic(std::string_view name) {
   auto& topic = m_nameTopics[name];
   // create if it does not already exist
   if (!topic) {
-    topic = m_topics.Add(m_inst, name);
-    // attach multi-subscribers
-    for (auto&& sub : m_multiSubscribers) {
-      if (sub->Matches(name, topic->special)) {
-        topic->multiSubscribers.Add(sub.get());
+    topic = m_topics.Add(m_inst, name, &m_scalars);
+    // attach multi-subscribers; only prefixes of the name can match, so look
+    // up each registered prefix length
+    for (auto&& length : m_multiSubscriberPrefixLengths) {
+      if (length.first > name.size()) {
+        break;
+      }
+      if (length.first == 0 && topic->special) {
+        continue;
+      }
+      auto it = m_multiSubscriberPrefixes.find(name.substr(0, length.first));
+      if (it == m_multiSubscriberPrefixes.end()) {
+        continue;
+      }
+      for (auto sub : it->second) {
+        // a subscriber may have several prefixes matching the name
+        if (std::find(topic->multiSubscribers.begin(),
+                      topic->multiSubscribers.end(),
+                      sub) == topic->multiSubscribers.end()) {
+          topic->multiSubscribers.Add(sub);
+        }
       }
     }
   }
   return topic;
 }
 
+void StorageImpl::AddMultiSubscriberPrefixes(LocalMultiSubscriber* subscriber) {
+  for (auto&& prefix : subscriber->prefixes) {
+    auto& subscribers = m_multiSubscriberPrefixes[prefix];
+    if (subscribers.empty()) {
+      ++m_multiSubscriberPrefixLengths[prefix.size()];
+    }
+    subscribers.Add(subscriber);
+  }
+}
+
+void StorageImpl::RemoveMultiSubscriberPrefixes(
+    LocalMultiSubscriber* subscriber) {
+  for (auto&& prefix : subscriber->prefixes) {
+    auto it = m_multiSubscriberPrefixes.find(prefix);
+    if (it != m_multiSubscriberPrefixes.end() &&
+        it->second.Remove(subscriber) && it->second.empty()) {
+      m_multiSubscriberPrefixes.erase(it);
+      auto lengthIt = m_multiSubscriberPrefixLengths.find(prefix.size());
+      if (--lengthIt->second == 0) {
+        m_multiSubscriberPrefixLengths.erase(lengthIt);
+      }
+    }
+  }
+}
+
 //
 // Topic property functions
 //
@@ -289,7 +331,7 @@ bool StorageImpl::SetDefaultEntryValue(NT_Handle pubsubentryHandle,
       if (publisher) {
         PublishLocalValue(publisher, newValue, true);
       } else {
-        topic->lastValue = newValue;
+        topic->SetLastValue(newValue);
       }
       return true;
     }
@@ -418,6 +460,7 @@ LocalMultiSubscriber* StorageImpl::AddMultiSubscriber(
     return nullptr;
   }
   auto subscriber = m_multiSubscribers.Add(m_inst, prefixes, options);
+  AddMultiSubscriberPrefixes(subscriber);
   // subscribe to any already existing topics
   for (auto&& topic : m_topics) {
     for (auto&& prefix : prefixes) {
@@ -439,6 +482,7 @@ std::unique_ptr<LocalMultiSubscriber> StorageImpl::RemoveMultiSubscriber(
     NT_MultiSubscriber subHandle) {
   auto subscriber = m_multiSubscribers.Remove(subHandle);
   if (subscriber) {
+    RemoveMultiSubscriberPrefixes(subscriber.get());
     for (auto&& topic : m_topics) {
       topic->multiSubscribers.Remove(subscriber.get());
     }
@@ -609,6 +653,7 @@ void StorageImpl::AddListenerImpl(NT_Listener listenerHandle,
         listenerHandle, eventMask & (NT_EVENT_TOPIC | NT_EVENT_IMMEDIATE));
 
     m_topicPrefixListeners.Add(listener);
+    subscriber->topicListeners.Add(listenerHandle);
 
     // handle immediate publish
     if ((eventMask & (NT_EVENT_PUBLISH | NT_EVENT_IMMEDIATE)) ==
@@ -679,6 +724,7 @@ void StorageImpl::RemoveListener(NT_Listener listenerHandle,
   }
   if (listener->multiSubscriber) {
     listener->multiSubscriber->valueListeners.Remove(listenerHandle);
+    listener->multiSubscriber->topicListeners.Remove(listenerHandle);
     if (listener->subscriberOwned) {
       RemoveMultiSubscriber(listener->multiSubscriber->handle);
     }
@@ -759,10 +805,16 @@ void StorageImpl::AddSchema(std::string_view name, std::string_view type,
 void StorageImpl::Reset() {
   m_network = nullptr;
   m_topics.clear();
+  m_scalars.clear();
   m_publishers.clear();
+  for (auto&& slot : m_publishableTypes) {
+    slot.store(0, std::memory_order_release);
+  }
   m_subscribers.clear();
   m_entries.clear();
   m_multiSubscribers.clear();
+  m_multiSubscriberPrefixes.clear();
+  m_multiSubscriberPrefixLengths.clear();
   m_dataloggers.clear();
   m_nameTopics.clear();
   m_listeners.clear();
@@ -777,11 +829,9 @@ void StorageImpl::NotifyTopic(LocalTopic* topic, unsigned int eventFlags) {
   }
 
   wpi::SmallVector<NT_Listener, 32> listeners;
-  for (auto listener : m_topicPrefixListeners) {
-    if (listener->multiSubscriber &&
-        listener->multiSubscriber->Matches(topic->name, topic->special)) {
-      listeners.emplace_back(listener->handle);
-    }
+  for (auto subscriber : topic->multiSubscribers) {
+    listeners.append(subscriber->topicListeners.begin(),
+                     subscriber->topicListeners.end());
   }
   if (!listeners.empty()) {
     m_listenerStorage.Notify(listeners, eventFlags, topicInfo);
@@ -818,7 +868,7 @@ bool StorageImpl::SetValue(LocalTopic* topic, const Value& value,
     if (!(suppressIfDuplicate && isDuplicate)) {
       topic->type = value.type();
       if (topic->IsCached()) {
-        topic->lastValue = value;
+        topic->SetLastValue(value);
         topic->lastValueFromNetwork = false;
       }
       NotifyValue(topic, value, eventFlags, isDuplicate, publisher);
@@ -888,6 +938,7 @@ void StorageImpl::RefreshPubSubActive(LocalTopic* topic,
                                       bool warnOnSubMismatch) {
   for (auto&& publisher : topic->localPublishers) {
     publisher->UpdateActive();
+    UpdatePublishable(*publisher);
   }
   for (auto&& subscriber : topic->localSubscribers) {
     subscriber->UpdateActive();
@@ -901,6 +952,18 @@ void StorageImpl::RefreshPubSubActive(LocalTopic* topic,
   }
 }
 
+void StorageImpl::UpdatePublishable(const LocalPublisher& publisher) {
+  auto& slot = m_publishableTypes[Handle{publisher.handle}.GetIndex() %
+                                  m_publishableTypes.size()];
+  if (publisher.active) {
+    slot.store(PublishableSlot(publisher.handle, publisher.config.type),
+               std::memory_order_release);
+  } else {
+    uint64_t active = PublishableSlot(publisher.handle, publisher.config.type);
+    slot.compare_exchange_strong(active, 0, std::memory_order_release);
+  }
+}
+
 LocalPublisher* StorageImpl::AddLocalPublisher(LocalTopic* topic,
                                                const wpi::json& properties,
                                                const PubSubConfig& config) {
@@ -933,6 +996,7 @@ LocalPublisher* StorageImpl::AddLocalPublisher(LocalTopic* topic,
   } else {
     // only need to update just this publisher
     publisher->UpdateActive();
+    UpdatePublishable(*publisher);
     if (!publisher->active) {
       // warn on type mismatch
       INFO(
@@ -953,6 +1017,11 @@ std::unique_ptr<LocalPublisher> StorageImpl::RemoveLocalPublisher(
     NT_Publisher pubHandle) {
   auto publisher = m_publishers.Remove(pubHandle);
   if (publisher) {
+    // clear the slot unless another publisher has taken it
+    uint64_t slot = PublishableSlot(pubHandle, publisher->config.type);
+    m_publishableTypes[Handle{pubHandle}.GetIndex() %
+                       m_publishableTypes.size()]
+        .compare_exchange_strong(slot, 0, std::memory_order_release);
     auto topic = publisher->topic;
     bool didExist = topic->Exists();
     topic->localPublishers.Remove(publisher.get());
@@ -4,9 +4,13 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <concepts>
+#include <map>
 #include <memory>
 #include <string_view>
+#include <utility>
 
 #include <wpi/DenseMap.h>
 #include <wpi/StringExtras.h>
@@ -20,6 +24,7 @@
 #include "local/LocalListener.h"
 #include "local/LocalMultiSubscriber.h"
 #include "local/LocalPublisher.h"
+#include "local/LocalScalarStore.h"
 #include "local/LocalSubscriber.h"
 #include "local/LocalTopic.h"
 #include "ntcore_c.h"
@@ -117,6 +122,13 @@ class StorageImpl {
     }
   }
 
+  // calls func(NT_Topic, const Value&) for the cached value of each scalar
+  // topic
+  template <std::invocable<NT_Topic, const Value&> F>
+  void ForEachScalarValue(unsigned int types, F&& func) const {
+    m_scalars.ForEach(types, std::forward<F>(func));
+  }
+
   //
   // Topic property functions
   //
@@ -138,6 +150,21 @@ class StorageImpl {
   //
 
   bool SetEntryValue(NT_Handle pubentryHandle, const Value& value);
+
+  // Returns true if pubHandle is an active publisher of values of the given
+  // type, so setting such a value would be accepted.  Unlike the other
+  // functions, this can be called without holding the storage lock; it checks
+  // a snapshot of the publisher types, and may return false for valid
+  // publishers (e.g. entries, or several publishers sharing a slot).
+  bool IsPublishable(NT_Handle pubHandle, NT_Type type) const {
+    Handle h{pubHandle};
+    if (!h.IsType(Handle::kPublisher)) {
+      return false;
+    }
+    return m_publishableTypes[h.GetIndex() % m_publishableTypes.size()].load(
+               std::memory_order_acquire) == PublishableSlot(pubHandle, type);
+  }
+
   bool SetDefaultEntryValue(NT_Handle pubsubentryHandle, const Value& value);
 
   Value* GetSubEntryValue(NT_Handle subentryHandle) {
@@ -259,6 +286,16 @@ class StorageImpl {
 
   void RefreshPubSubActive(LocalTopic* topic, bool warnOnSubMismatch);
 
+  static constexpr uint64_t PublishableSlot(NT_Publisher handle,
+                                            NT_Type type) {
+    return (static_cast<uint64_t>(handle) << 32) | type;
+  }
+  void UpdatePublishable(const LocalPublisher& publisher);
+
+  // multi-subscriber prefix index functions
+  void AddMultiSubscriberPrefixes(LocalMultiSubscriber* subscriber);
+  void RemoveMultiSubscriberPrefixes(LocalMultiSubscriber* subscriber);
+
   LocalPublisher* AddLocalPublisher(LocalTopic* topic,
                                     const wpi::json& properties,
                                     const PubSubConfig& options);
@@ -298,19 +335,30 @@ class StorageImpl {
 
   // handle mappings
   HandleMap<LocalTopic, 16> m_topics;
+  LocalScalarStore m_scalars;
   HandleMap<LocalPublisher, 16> m_publishers;
   HandleMap<LocalSubscriber, 16> m_subscribers;
   HandleMap<LocalEntry, 16> m_entries;
   HandleMap<LocalMultiSubscriber, 16> m_multiSubscribers;
   HandleMap<LocalDataLogger, 16> m_dataloggers;
 
+  // active publisher handle and type by publisher index, for IsPublishable()
+  std::array<std::atomic<uint64_t>, 256> m_publishableTypes{};
+
   // name mappings
   wpi::StringMap<LocalTopic*> m_nameTopics;
 
+  // multi-subscribers by prefix, so new topics are only checked against the
+  // prefixes of their name rather than every multi-subscriber
+  wpi::StringMap<VectorSet<LocalMultiSubscriber*>> m_multiSubscriberPrefixes;
+  // number of prefixes in m_multiSubscriberPrefixes of each length
+  std::map<size_t, int> m_multiSubscriberPrefixLengths;
+
   // listeners
   wpi::DenseMap<NT_Listener, std::unique_ptr<LocalListener>> m_listeners;
 
-  // string-based listeners
+  // string-based listeners; topic events are dispatched via the matching
+  // multi-subscribers' topicListeners
   VectorSet<LocalListener*> m_topicPrefixListeners;
 
   // schema publishers
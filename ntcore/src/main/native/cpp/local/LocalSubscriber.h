@@ -25,7 +25,7 @@ struct LocalSubscriber {
       : handle{handle},
         topic{topic},
         config{std::move(config)},
-        pollStorage{config.pollStorage} {}
+        pollStorage{config.pollStorage, config.coalescePeriodUs} {}
 
   void UpdateActive() {
     // for subscribers, unassigned is a wildcard
@@ -14,14 +14,13 @@ void LocalTopic::StartStopDataLog(LocalDataLogger* logger, int64_t timestamp,
                                   bool publish) {
   auto it = std::find_if(
       datalogs.begin(), datalogs.end(),
-      [&](const auto& elem) { return elem.logger == logger->handle; });
+      [&](const auto& elem) { return elem.logger == logger; });
   if (publish && it == datalogs.end()) {
     datalogs.emplace_back(
-        logger->log,
+        *logger,
         logger->Start(name, typeStr,
                       LocalDataLoggerEntry::MakeMetadata(m_propertiesStr),
-                      timestamp),
-        logger->handle);
+                      timestamp));
     datalogType = type;
   } else if (!publish && it != datalogs.end()) {
     it->Finish(timestamp);
@@ -64,7 +63,7 @@ wpi::json LocalTopic::SetFlags(unsigned int flags) {
     update["cached"] = wpi::json();
   }
   if ((flags & NT_UNCACHED) != 0) {
-    lastValue = {};
+    SetLastValue({});
     lastValueNetwork = {};
     lastValueFromNetwork = false;
   }
@@ -176,7 +175,7 @@ void LocalTopic::ResetIfDoesNotExist() {
   if (Exists()) {
     return;
   }
-  lastValue = {};
+  SetLastValue({});
   lastValueNetwork = {};
   lastValueFromNetwork = false;
   type = NT_UNASSIGNED;
@@ -219,7 +218,7 @@ void LocalTopic::RefreshFlags() {
   }
 
   if ((m_flags & NT_UNCACHED) != 0) {
-    lastValue = {};
+    SetLastValue({});
     lastValueNetwork = {};
     lastValueFromNetwork = false;
   }
@@ -17,6 +17,7 @@
 #include "VectorSet.h"
 #include "local/LocalDataLogger.h"
 #include "local/LocalDataLoggerEntry.h"
+#include "local/LocalScalarStore.h"
 #include "ntcore_cpp.h"
 
 namespace nt::local {
@@ -34,13 +35,23 @@ constexpr bool IsSpecial(std::string_view name) {
 struct LocalTopic {
   static constexpr auto kType = Handle::kTopic;
 
-  LocalTopic(NT_Topic handle, std::string_view name)
-      : handle{handle}, name{name}, special{IsSpecial(name)} {}
+  LocalTopic(NT_Topic handle, std::string_view name,
+             LocalScalarStore* scalars)
+      : handle{handle},
+        name{name},
+        special{IsSpecial(name)},
+        m_scalars{scalars} {}
 
   bool Exists() const { return onNetwork || !localPublishers.empty(); }
 
   bool IsCached() const { return (m_flags & NT_UNCACHED) == 0; }
 
+  // sets lastValue, keeping the scalar store up to date
+  void SetLastValue(const Value& value) {
+    lastValue = value;
+    m_scalars->Set(handle, value);
+  }
+
   // starts if publish is true, stops if false
   void StartStopDataLog(LocalDataLogger* logger, int64_t timestamp,
                         bool publish);
@@ -104,6 +115,8 @@ struct LocalTopic {
   // update flags from properties
   void RefreshFlags();
 
+  LocalScalarStore* m_scalars;
+
   unsigned int m_flags{0};            // for NT3 APIs
   std::string m_propertiesStr{"{}"};  // cached string for GetTopicInfo() et al
 };
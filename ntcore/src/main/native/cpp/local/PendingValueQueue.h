@@ -0,0 +1,44 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stddef.h>
+
+#include <utility>
+
+#include <wpi/MpmcQueue.h>
+
+#include "networktables/NetworkTableValue.h"
+#include "ntcore_c.h"
+
+namespace nt::local {
+
+// Bounded lock-free multi-producer, single-consumer queue of value sets.
+// Producers may call Push() from any thread; Drain() must only be called by
+// one thread at a time (e.g. while holding a lock).
+class PendingValueQueue {
+ public:
+  // returns false if the queue is full
+  bool Push(NT_Handle handle, const Value& value) {
+    return m_queue.TryEmplace(handle, value);
+  }
+
+  // calls func(handle, value) for each queued value, in order
+  template <typename F>
+  void Drain(F&& func) {
+    while (auto item = m_queue.TryPop()) {
+      func(item->first, item->second);
+    }
+  }
+
+  bool Empty() const { return m_queue.Empty(); }
+
+  static constexpr size_t kSize = 256;
+
+ private:
+  wpi::MpmcQueue<std::pair<NT_Handle, Value>> m_queue{kSize};
+};
+
+}  // namespace nt::local
@@ -20,6 +20,7 @@
 #include "Log.h"
 #include "Message.h"
 #include "NetworkInterface.h"
+#include "Types_internal.h"
 #include "WireConnection.h"
 #include "WireEncoder.h"
 #include "networktables/NetworkTableValue.h"
@@ -29,7 +30,8 @@ using namespace nt::net;
 
 ClientImpl::ClientImpl(
     uint64_t curTimeMs, WireConnection& wire, wpi::Logger& logger,
-    std::function<void(int64_t serverTimeOffset, int64_t rtt2, bool valid)>
+    std::function<void(int64_t serverTimeOffset, int64_t rtt2, bool valid,
+                       int64_t uncertainty)>
         timeSyncUpdated,
     std::function<void(uint32_t repeatMs)> setPeriodic)
     : m_wire{wire},
@@ -38,69 +40,101 @@ ClientImpl::ClientImpl(
       m_setPeriodic{std::move(setPeriodic)},
       m_ping{wire},
       m_nextPingTimeMs{curTimeMs + (wire.GetVersion() >= 0x0401
-                                        ? NetworkPing::kPingIntervalMs
+                                        ? kInitialTimeSyncIntervalMs
                                         : kRttIntervalMs)},
       m_outgoing{wire, false} {
   // immediately send RTT ping
-  auto now = wpi::Now();
-  DEBUG4("Sending initial RTT ping {}", now);
-  m_wire.SendBinary(
-      [&](auto& os) { WireEncodeBinary(os, -1, 0, Value::MakeInteger(now)); });
+  SendTimeSyncPing();
   m_setPeriodic(m_periodMs);
 }
 
 void ClientImpl::ProcessIncomingBinary(uint64_t curTimeMs,
                                        std::span<const uint8_t> data) {
+  // timestamp RTT ping responses as soon as they are received, rather than
+  // after decoding any preceding messages
+  int64_t recvTime = wpi::Now();
   for (;;) {
     if (data.empty()) {
       break;
     }
 
+    // decode batch message
+    std::string error;
+    bool isBatch;
+    if (!WireDecodeBinaryBatch(
+            &data, &isBatch,
+            [&](int id, Value& value) { ServerSetValue(id, value); }, &error,
+            -m_outgoing.GetTimeOffset())) {
+      m_wire.Disconnect(fmt::format("binary decode error: {}", error));
+      break;
+    }
+    if (isBatch) {
+      DEBUG4("BinaryBatchMessage");
+      continue;
+    }
+
     // decode message
     int id;
     Value value;
-    std::string error;
     if (!WireDecodeBinary(&data, &id, &value, &error,
-                          -m_outgoing.GetTimeOffset())) {
-      ERR("binary decode error: {}", error);
-      break;  // FIXME
+                          -m_outgoing.GetTimeOffset(),
+                          [&](int topicId) -> const Value* {
+                            auto it = m_deltaBases.find(topicId);
+                            return it == m_deltaBases.end() ? nullptr
+                                                            : &it->second;
+                          })) {
+      m_wire.Disconnect(fmt::format("binary decode error: {}", error));
+      break;
     }
     DEBUG4("BinaryMessage({})", id);
 
-    // handle RTT ping response (only use first one)
+    // handle RTT ping response
     if (id == -1) {
-      if (!m_haveTimeOffset) {
-        if (!value.IsInteger()) {
-          WARN("RTT ping response with non-integer type {}",
-               static_cast<int>(value.type()));
-          continue;
-        }
-        DEBUG4("RTT ping response time {} value {}", value.time(),
-               value.GetInteger());
-        if (m_wire.GetVersion() < 0x0401) {
-          m_pongTimeMs = curTimeMs;
-        }
-        int64_t now = wpi::Now();
-        int64_t rtt2 = (now - value.GetInteger()) / 2;
-        if (rtt2 < m_rtt2Us) {
-          m_rtt2Us = rtt2;
-          int64_t serverTimeOffsetUs = value.server_time() + rtt2 - now;
-          DEBUG3("Time offset: {}", serverTimeOffsetUs);
-          m_outgoing.SetTimeOffset(serverTimeOffsetUs);
-          m_haveTimeOffset = true;
-          m_timeSyncUpdated(serverTimeOffsetUs, m_rtt2Us, true);
-        }
+      if (!value.IsInteger()) {
+        WARN("RTT ping response with non-integer type {}",
+             static_cast<int>(value.type()));
+        continue;
+      }
+      DEBUG4("RTT ping response time {} value {}", value.time(),
+             value.GetInteger());
+      if (m_wire.GetVersion() < 0x0401) {
+        m_pongTimeMs = curTimeMs;
+      }
+      if (m_clockSync.AddSample(value.GetInteger(), value.server_time(),
+                                recvTime)) {
+        int64_t serverTimeOffsetUs = m_clockSync.GetOffset(recvTime);
+        int64_t uncertaintyUs = m_clockSync.GetUncertainty(recvTime);
+        DEBUG3("Time offset: {} +/- {}", serverTimeOffsetUs, uncertaintyUs);
+        m_outgoing.SetTimeOffset(serverTimeOffsetUs);
+        m_haveTimeOffset = true;
+        m_timeSyncUpdated(serverTimeOffsetUs, m_clockSync.GetRtt2(), true,
+                          uncertaintyUs);
       }
       continue;
     }
 
-    // otherwise it's a value message
+    // otherwise it's a value message; if deltas may be sent, remember array
+    // values so later deltas can be applied to them
+    if (m_deltaArrays) {
+      switch (value.type()) {
+        case NT_BOOLEAN_ARRAY:
+        case NT_INTEGER_ARRAY:
+        case NT_FLOAT_ARRAY:
+        case NT_DOUBLE_ARRAY:
+          m_deltaBases[id] = value;
+          break;
+        default:
+          break;
+      }
+    }
     ServerSetValue(id, value);
   }
 }
 
 void ClientImpl::HandleLocal(std::span<ClientMessage> msgs) {
   DEBUG4("HandleLocal()");
+  bool updatePeriod = false;
+  bool recalcPeriod = false;
   for (auto&& elem : msgs) {
     // common case is value
     if (auto msg = std::get_if<ClientValueMsg>(&elem.contents)) {
@@ -109,22 +143,48 @@ void ClientImpl::HandleLocal(std::span<ClientMessage> msgs) {
       Publish(msg->pubuid, msg->name, msg->typeStr, msg->properties,
               msg->options);
       m_outgoing.SendMessage(msg->pubuid, std::move(elem));
+      updatePeriod = true;
     } else if (auto msg = std::get_if<UnpublishMsg>(&elem.contents)) {
       Unpublish(msg->pubuid, std::move(elem));
+      recalcPeriod = true;
     } else {
+      if (auto msg = std::get_if<SubscribeMsg>(&elem.contents)) {
+        m_deltaArrays = m_deltaArrays || msg->options.deltaArrays;
+      }
       m_outgoing.SendMessage(0, std::move(elem));
     }
   }
+
+  // update period once per batch rather than per publish/unpublish
+  if (recalcPeriod) {
+    // loop over all publishers
+    m_periodMs = kMaxPeriodMs;
+    for (auto&& pub : m_publishers) {
+      if (pub) {
+        m_periodMs = std::gcd(m_periodMs, pub->periodMs);
+      }
+    }
+  }
+  if (updatePeriod || recalcPeriod) {
+    UpdatePeriodic();
+  }
 }
 
 void ClientImpl::SendOutgoing(uint64_t curTimeMs, bool flush) {
   DEBUG4("SendOutgoing({}, {})", curTimeMs, flush);
 
   if (m_wire.GetVersion() >= 0x0401) {
-    // Use WS pings
+    // Use WS pings for timeouts, and RTT pings only for time sync
     if (!m_ping.Send(curTimeMs)) {
       return;
     }
+    if (curTimeMs >= m_nextPingTimeMs) {
+      SendTimeSyncPing();
+      m_nextPingTimeMs =
+          curTimeMs + (m_timeSyncCount < kInitialTimeSyncCount
+                           ? kInitialTimeSyncIntervalMs
+                           : kTimeSyncIntervalMs);
+    }
   } else {
     // Use RTT pings; it's unsafe to use WS pings due to bugs in WS message
     // fragmentation in earlier NT4 implementations
@@ -135,11 +195,7 @@ void ClientImpl::SendOutgoing(uint64_t curTimeMs, bool flush) {
         return;
       }
 
-      auto now = wpi::Now();
-      DEBUG4("Sending RTT ping {}", now);
-      m_wire.SendBinary([&](auto& os) {
-        WireEncodeBinary(os, -1, 0, Value::MakeInteger(now));
-      });
+      SendTimeSyncPing();
       // drift isn't critical here, so just go from current time
       m_nextPingTimeMs = curTimeMs + kRttIntervalMs;
       m_pongTimeMs = 0;
@@ -154,6 +210,14 @@ void ClientImpl::SendOutgoing(uint64_t curTimeMs, bool flush) {
   m_outgoing.SendOutgoing(curTimeMs, flush);
 }
 
+void ClientImpl::SendTimeSyncPing() {
+  auto now = wpi::Now();
+  DEBUG4("Sending RTT ping {}", now);
+  m_wire.SendBinary(
+      [&](auto& os) { WireEncodeBinary(os, -1, 0, Value::MakeInteger(now)); });
+  ++m_timeSyncCount;
+}
+
 void ClientImpl::UpdatePeriodic() {
   if (m_periodMs < kMinPeriodMs) {
     m_periodMs = kMinPeriodMs;
@@ -181,9 +245,8 @@ void ClientImpl::Publish(int32_t pubuid, std::string_view name,
   }
   m_outgoing.SetPeriod(pubuid, publisher->periodMs);
 
-  // update period
+  // update period; caller calls UpdatePeriodic()
   m_periodMs = UpdatePeriodCalc(m_periodMs, publisher->periodMs);
-  UpdatePeriodic();
 }
 
 void ClientImpl::Unpublish(int32_t pubuid, ClientMessage&& msg) {
@@ -192,15 +255,6 @@ void ClientImpl::Unpublish(int32_t pubuid, ClientMessage&& msg) {
   }
   m_publishers[pubuid].reset();
 
-  // loop over all publishers to update period
-  m_periodMs = kMaxPeriodMs;
-  for (auto&& pub : m_publishers) {
-    if (pub) {
-      m_periodMs = std::gcd(m_periodMs, pub->periodMs);
-    }
-  }
-  UpdatePeriodic();
-
   m_outgoing.SendMessage(pubuid, std::move(msg));
 
   // remove from outgoing handle map
@@ -226,8 +280,24 @@ int ClientImpl::ServerAnnounce(std::string_view name, int id,
                                std::optional<int> pubuid) {
   DEBUG4("ServerAnnounce({}, {}, {})", name, id, typeStr);
   assert(m_local);
-  m_topicMap[id] =
-      m_local->ServerAnnounce(name, 0, typeStr, properties, pubuid);
+  int localId = m_local->ServerAnnounce(name, 0, typeStr, properties, pubuid);
+  m_topicMap[id] = localId;
+
+  if (m_resumeState) {
+    auto& value = m_resumeState->values[name];
+    value = {};
+    // the server won't resend values we already have from a resumed session,
+    // so restore them (any newer value will follow from the server)
+    if (m_resumed) {
+      auto it = m_resumeCache.find(name);
+      if (it != m_resumeCache.end() &&
+          it->second.type() == StringToType(typeStr)) {
+        value = it->second;
+        m_local->ServerSetValue(localId, value);
+      }
+    }
+    m_resumeValues[id] = &value;
+  }
   return id;
 }
 
@@ -236,6 +306,11 @@ void ClientImpl::ServerUnannounce(std::string_view name, int id) {
   assert(m_local);
   m_local->ServerUnannounce(name, m_topicMap[id]);
   m_topicMap.erase(id);
+  m_deltaBases.erase(id);
+  if (m_resumeState) {
+    m_resumeState->values.erase(name);
+    m_resumeValues.erase(id);
+  }
 }
 
 void ClientImpl::ServerPropertiesUpdate(std::string_view name,
@@ -257,6 +332,46 @@ void ClientImpl::ServerSetValue(int topicId, const Value& value) {
   if (m_local) {
     m_local->ServerSetValue(topicIt->second, value);
   }
+
+  if (m_resumeState) {
+    auto it = m_resumeValues.find(topicId);
+    if (it != m_resumeValues.end()) {
+      *it->second = value;
+    }
+  }
+}
+
+void ClientImpl::ServerCheckpoint(std::string_view token, int64_t seq) {
+  DEBUG4("ServerCheckpoint({}, {})", token, seq);
+  if (!m_resumeState) {
+    return;
+  }
+  // the first checkpoint is sent immediately if the resume succeeded
+  if (m_resuming && token == m_resumeState->token) {
+    DEBUG3("resumed session {} at {}", token, seq);
+    m_resumed = true;
+  }
+  m_resuming = false;
+  m_resumeState->token = token;
+  m_resumeState->seq = seq;
+}
+
+void ClientImpl::SetResumeState(ClientResumeState* state) {
+  m_resumeState = state;
+  if (!state) {
+    return;
+  }
+  m_resumeCache = std::move(state->values);
+  state->values.clear();
+  if (m_wire.GetVersion() < 0x0402 || state->token.empty()) {
+    state->token.clear();
+    m_resumeCache.clear();
+    return;
+  }
+  DEBUG3("resuming session {} at {}", state->token, state->seq);
+  m_wire.SendText(
+      [&](auto& os) { WireEncodeResume(os, state->token, state->seq); });
+  m_resuming = true;
 }
 
 void ClientImpl::ProcessIncomingText(std::string_view data) {
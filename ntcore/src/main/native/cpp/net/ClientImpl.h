@@ -9,17 +9,21 @@
 #include <functional>
 #include <memory>
 #include <span>
+#include <string>
 #include <string_view>
 #include <vector>
 
 #include <wpi/DenseMap.h>
+#include <wpi/StringMap.h>
 
+#include "ClockSync.h"
 #include "MessageHandler.h"
 #include "NetworkOutgoingQueue.h"
 #include "NetworkPing.h"
 #include "PubSubOptions.h"
 #include "WireConnection.h"
 #include "WireDecoder.h"
+#include "networktables/NetworkTableValue.h"
 
 namespace wpi {
 class Logger;
@@ -35,11 +39,22 @@ namespace nt::net {
 struct ClientMessage;
 class WireConnection;
 
+// Session resume state (protocol 4.2); outlives individual connections.
+struct ClientResumeState {
+  // most recent checkpoint received; token is empty if none
+  std::string token;
+  int64_t seq{0};
+
+  // last value received on the current connection, by topic name
+  wpi::StringMap<Value> values;
+};
+
 class ClientImpl final : private ServerMessageHandler {
  public:
   ClientImpl(
       uint64_t curTimeMs, WireConnection& wire, wpi::Logger& logger,
-      std::function<void(int64_t serverTimeOffset, int64_t rtt2, bool valid)>
+      std::function<void(int64_t serverTimeOffset, int64_t rtt2, bool valid,
+                         int64_t uncertainty)>
           timeSyncUpdated,
       std::function<void(uint32_t repeatMs)> setPeriodic);
 
@@ -50,6 +65,10 @@ class ClientImpl final : private ServerMessageHandler {
   void SendOutgoing(uint64_t curTimeMs, bool flush);
 
   void SetLocal(ServerMessageHandler* local) { m_local = local; }
+  // Tracks values received in state, and if state has a checkpoint, asks
+  // the server to resume that session.  Must be called before any
+  // subscriptions are sent.
+  void SetResumeState(ClientResumeState* state);
   void SendInitial();
 
  private:
@@ -61,6 +80,7 @@ class ClientImpl final : private ServerMessageHandler {
   };
 
   void UpdatePeriodic();
+  void SendTimeSyncPing();
 
   // ServerMessageHandler interface
   int ServerAnnounce(std::string_view name, int id, std::string_view typeStr,
@@ -70,6 +90,7 @@ class ClientImpl final : private ServerMessageHandler {
   void ServerPropertiesUpdate(std::string_view name, const wpi::json& update,
                               bool ack) final;
   void ServerSetValue(int topicId, const Value& value) final;
+  void ServerCheckpoint(std::string_view token, int64_t seq) final;
 
   void Publish(int pubuid, std::string_view name, std::string_view typeStr,
                const wpi::json& properties, const PubSubOptionsImpl& options);
@@ -79,7 +100,8 @@ class ClientImpl final : private ServerMessageHandler {
   WireConnection& m_wire;
   wpi::Logger& m_logger;
   ServerMessageHandler* m_local{nullptr};
-  std::function<void(int64_t serverTimeOffset, int64_t rtt2, bool valid)>
+  std::function<void(int64_t serverTimeOffset, int64_t rtt2, bool valid,
+                     int64_t uncertainty)>
       m_timeSyncUpdated;
   std::function<void(uint32_t repeatMs)> m_setPeriodic;
 
@@ -89,14 +111,34 @@ class ClientImpl final : private ServerMessageHandler {
   // indexed by server-provided topic id
   wpi::DenseMap<int, int> m_topicMap;
 
+  // last array value received, indexed by server-provided topic id; only
+  // tracked once a subscription has requested deltas
+  wpi::DenseMap<int, Value> m_deltaBases;
+  bool m_deltaArrays{false};
+
+  // session resume; values are indexed by server-provided topic id
+  ClientResumeState* m_resumeState{nullptr};
+  wpi::DenseMap<int, Value*> m_resumeValues;
+  // values from the previous connection, used only if the server confirms
+  // the resume
+  wpi::StringMap<Value> m_resumeCache;
+  bool m_resuming{false};
+  bool m_resumed{false};
+
   // ping
   NetworkPing m_ping;
 
-  // timestamp handling
+  // timestamp handling; protocol 4.0 uses the time sync pings (at the RTT
+  // interval) to detect timeouts
   static constexpr uint32_t kRttIntervalMs = 3000;
+  static constexpr uint32_t kTimeSyncIntervalMs = 1000;
+  // the first pings are sent more often, for a quick initial estimate
+  static constexpr uint32_t kInitialTimeSyncIntervalMs = 100;
+  static constexpr int kInitialTimeSyncCount = 4;
   uint64_t m_nextPingTimeMs{0};
   uint64_t m_pongTimeMs{0};
-  uint32_t m_rtt2Us{UINT32_MAX};
+  int m_timeSyncCount{0};
+  ClockSync m_clockSync;
   bool m_haveTimeOffset{false};
 
   // periodic sweep handling
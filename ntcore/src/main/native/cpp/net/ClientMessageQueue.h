@@ -117,6 +117,11 @@ class ClientMessageQueueImpl final : public ClientMessageHandler,
     m_queue.enqueue(ClientMessage{ClientValueMsg{pubuid, value}});
   }
 
+  void ClientResume(std::string_view token, int64_t seq) final {
+    std::scoped_lock lock{m_mutex};
+    m_queue.enqueue(ClientMessage{ResumeMsg{std::string{token}, seq}});
+  }
+
  private:
   wpi::FastQueue<ClientMessage, kBlockSize> m_queue{kBlockSize - 1};
   wpi::Logger& m_logger;
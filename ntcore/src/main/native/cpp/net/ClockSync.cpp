@@ -0,0 +1,72 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "ClockSync.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace nt::net;
+
+bool ClockSync::AddSample(int64_t sendTime, int64_t serverTime,
+                          int64_t recvTime) {
+  if (recvTime < sendTime) {
+    return false;
+  }
+  int64_t rtt2 = (recvTime - sendTime) / 2;
+  int64_t localTime = sendTime + rtt2;
+  m_samples[m_next] = {localTime, serverTime - localTime, rtt2};
+  m_next = (m_next + 1) % kWindowSize;
+  if (m_count < kWindowSize) {
+    ++m_count;
+  }
+
+  // the best sample is the one whose offset, extrapolated to now, has the
+  // least uncertainty
+  double driftUncertainty = GetDriftUncertainty();
+  auto uncertainty = [&](const Sample& sample) {
+    return sample.rtt2 + (recvTime - sample.localTime) * driftUncertainty;
+  };
+  auto best = *std::min_element(
+      m_samples.begin(), m_samples.begin() + m_count,
+      [&](const Sample& a, const Sample& b) {
+        return uncertainty(a) < uncertainty(b);
+      });
+
+  bool changed = m_count == 1 || best.localTime != m_best.localTime;
+  m_best = best;
+
+  // update the drift estimate from the change in offset since the anchor
+  if (!m_haveDriftAnchor) {
+    m_driftAnchor = best;
+    m_haveDriftAnchor = true;
+  } else if (best.localTime - m_driftAnchor.localTime >= kMinDriftSpanUs) {
+    double span = best.localTime - m_driftAnchor.localTime;
+    double drift = (best.offset - m_driftAnchor.offset) / span;
+    double error = (best.rtt2 + m_driftAnchor.rtt2) / span;
+    // wait until the span is long enough for the measurement to be within
+    // kDriftUncertainty; ignore clock steps (e.g. the server setting its time)
+    if (error < kDriftUncertainty) {
+      if (std::abs(drift) < kMaxDrift + error) {
+        drift = std::clamp(drift, -kMaxDrift, kMaxDrift);
+        m_drift = m_haveDrift ? m_drift + 0.25 * (drift - m_drift) : drift;
+        m_haveDrift = true;
+        changed = true;
+      }
+      m_driftAnchor = best;
+    }
+  }
+
+  return changed;
+}
+
+int64_t ClockSync::GetOffset(int64_t localTime) const {
+  return m_best.offset +
+         std::llround(m_drift * (localTime - m_best.localTime));
+}
+
+int64_t ClockSync::GetUncertainty(int64_t localTime) const {
+  return m_best.rtt2 + std::llround(GetDriftUncertainty() *
+                                    std::abs(localTime - m_best.localTime));
+}
@@ -0,0 +1,77 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+
+namespace nt::net {
+
+// Estimates the offset between the local clock and the server clock from
+// ping exchanges.  A single exchange bounds the offset to within half its
+// round trip time, so the estimate is taken from the exchange with the
+// smallest round trip time in a window of recent exchanges, extrapolated to
+// the current time using the estimated drift rate between the two clocks.
+// All times are in microseconds.
+class ClockSync {
+ public:
+  // number of recent exchanges considered
+  static constexpr size_t kWindowSize = 16;
+  // minimum time between exchanges used to estimate drift
+  static constexpr int64_t kMinDriftSpanUs = 30000000;
+  // bound on the drift rate between two crystal clocks; used as the drift
+  // uncertainty until drift has been estimated
+  static constexpr double kMaxDrift = 200e-6;
+  // drift uncertainty once drift has been estimated
+  static constexpr double kDriftUncertainty = 20e-6;
+
+  // Adds an exchange: a ping sent at local time sendTime, stamped by the
+  // server at serverTime, and whose response was received at local time
+  // recvTime.  Returns true if the estimate changed.
+  bool AddSample(int64_t sendTime, int64_t serverTime, int64_t recvTime);
+
+  bool IsValid() const { return m_count != 0; }
+
+  // Add to a local time to get the equivalent server time
+  int64_t GetOffset(int64_t localTime) const;
+
+  // Bound on the error of GetOffset(localTime)
+  int64_t GetUncertainty(int64_t localTime) const;
+
+  // Round trip time divided by 2 of the exchange the estimate is based on
+  int64_t GetRtt2() const { return m_best.rtt2; }
+
+  // Estimated drift rate (server clock rate relative to local clock, minus 1)
+  double GetDrift() const { return m_drift; }
+
+ private:
+  struct Sample {
+    int64_t localTime;  // midpoint of send and receive
+    int64_t offset;
+    int64_t rtt2;
+  };
+
+  double GetDriftUncertainty() const {
+    return m_haveDrift ? kDriftUncertainty : kMaxDrift;
+  }
+
+  std::array<Sample, kWindowSize> m_samples;
+  size_t m_count = 0;
+  size_t m_next = 0;
+
+  // the sample the estimate is based on
+  Sample m_best{0, 0, 0};
+
+  // drift is estimated between successive best exchanges at least
+  // kMinDriftSpanUs apart, and far enough apart to be precise
+  Sample m_driftAnchor{0, 0, 0};
+  bool m_haveDriftAnchor = false;
+  bool m_haveDrift = false;
+  double m_drift = 0;
+};
+
+}  // namespace nt::net
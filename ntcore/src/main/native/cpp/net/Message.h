@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <stdint.h>
+
+#include <memory>
 #include <optional>
 #include <string>
 #include <variant>
@@ -58,6 +61,14 @@ struct ClientValueMsg {
   Value value;
 };
 
+// protocol 4.2: sent before subscribing on reconnect, with the most recent
+// CheckpointMsg received from the same server
+struct ResumeMsg {
+  static constexpr std::string_view kMethodStr = "resume";
+  std::string token;
+  int64_t seq{0};
+};
+
 #if __GNUC__ >= 13
 #pragma GCC diagnostic pop
 #endif
@@ -65,7 +76,7 @@ struct ClientValueMsg {
 struct ClientMessage {
   using Contents =
       std::variant<std::monostate, PublishMsg, UnpublishMsg, SetPropertiesMsg,
-                   SubscribeMsg, UnsubscribeMsg, ClientValueMsg>;
+                   SubscribeMsg, UnsubscribeMsg, ClientValueMsg, ResumeMsg>;
   using ValueMsg = ClientValueMsg;
   Contents contents;
 };
@@ -92,14 +103,27 @@ struct PropertiesUpdateMsg {
   bool ack;
 };
 
+// protocol 4.2: all value changes up to seq have been sent before this
+struct CheckpointMsg {
+  static constexpr std::string_view kMethodStr = "checkpoint";
+  std::string token;
+  int64_t seq{0};
+};
+
+// Binary encoding of a complete value message.  Immutable once created, so it
+// can be shared by every client the same value is sent to.
+using SharedEncodedValue = std::shared_ptr<const std::vector<uint8_t>>;
+
 struct ServerValueMsg {
   int topic{0};
   Value value;
+  SharedEncodedValue encoded;  // optional pre-encoded form of value
 };
 
 struct ServerMessage {
-  using Contents = std::variant<std::monostate, AnnounceMsg, UnannounceMsg,
-                                PropertiesUpdateMsg, ServerValueMsg>;
+  using Contents =
+      std::variant<std::monostate, AnnounceMsg, UnannounceMsg,
+                   PropertiesUpdateMsg, ServerValueMsg, CheckpointMsg>;
   using ValueMsg = ServerValueMsg;
   Contents contents;
 };
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #include <optional>
 #include <span>
 #include <string>
@@ -34,6 +36,7 @@ class ClientMessageHandler {
                                const PubSubOptionsImpl& options) = 0;
   virtual void ClientUnsubscribe(int subuid) = 0;
   virtual void ClientSetValue(int pubuid, const Value& value) = 0;
+  virtual void ClientResume(std::string_view token, int64_t seq) {}
 };
 
 class ServerMessageHandler {
@@ -47,6 +50,7 @@ class ServerMessageHandler {
   virtual void ServerPropertiesUpdate(std::string_view name,
                                       const wpi::json& update, bool ack) = 0;
   virtual void ServerSetValue(int topicuid, const Value& value) = 0;
+  virtual void ServerCheckpoint(std::string_view token, int64_t seq) {}
 };
 
 }  // namespace nt::net
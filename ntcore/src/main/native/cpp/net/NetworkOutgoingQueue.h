@@ -11,9 +11,11 @@
 #include <numeric>
 #include <span>
 #include <utility>
+#include <variant>
 #include <vector>
 
 #include <wpi/DenseMap.h>
+#include <wpi/SmallVector.h>
 
 #include "Message.h"
 #include "WireConnection.h"
@@ -61,32 +63,52 @@ concept NetworkMessage =
 
 enum class ValueSendMode { kDisabled = 0, kAll, kNormal, kImm };
 
+// Transmission priority of a topic.  When a bandwidth limit is set, critical
+// messages are always sent, telemetry is sent while budget remains, and bulk
+// is only sent while more than half the burst budget remains.
+enum class SendPriority { kCritical = 0, kTelemetry, kBulk };
+
+struct OutgoingQueueStats {
+  // queued values replaced by a newer value before being sent
+  uint64_t coalesced = 0;
+  // replaced values that would have been sent if the queue weren't full
+  uint64_t dropped = 0;
+  // messages and approximate bytes currently waiting to be sent
+  size_t queuedMessages = 0;
+  size_t queuedBytes = 0;
+};
+
 template <NetworkMessage MessageType>
 class NetworkOutgoingQueue {
  public:
   NetworkOutgoingQueue(WireConnection& wire, bool local)
       : m_wire{wire}, m_local{local} {
-    m_queues.emplace_back(100);  // default queue is 100 ms period
+    // default queue is 100 ms period
+    m_queues.emplace_back(100, SendPriority::kTelemetry);
   }
 
-  void SetPeriod(int id, uint32_t periodMs) {
+  void SetPeriod(int id, uint32_t periodMs,
+                 SendPriority priority = SendPriority::kTelemetry) {
     // it's quite common to set a lot of things in a row with the same period
     unsigned int queueIndex;
-    if (m_lastSetPeriod == periodMs) {
+    if (m_lastSetPeriod == periodMs && m_lastSetPriority == priority) {
       queueIndex = m_lastSetPeriodQueueIndex;
     } else {
-      // find and possibly create queue for this period
-      auto it =
-          std::find_if(m_queues.begin(), m_queues.end(),
-                       [&](const auto& q) { return q.periodMs == periodMs; });
+      // find and possibly create queue for this period and priority
+      auto it = std::find_if(m_queues.begin(), m_queues.end(),
+                             [&](const auto& q) {
+                               return q.periodMs == periodMs &&
+                                      q.priority == priority;
+                             });
       if (it == m_queues.end()) {
         queueIndex = m_queues.size();
-        m_queues.emplace_back(periodMs);
+        m_queues.emplace_back(periodMs, priority);
       } else {
         queueIndex = it - m_queues.begin();
       }
       m_lastSetPeriodQueueIndex = queueIndex;
       m_lastSetPeriod = periodMs;
+      m_lastSetPriority = priority;
     }
 
     // map the handle to the queue
@@ -107,7 +129,28 @@ class NetworkOutgoingQueue {
     infoIt->getSecond().queueIndex = queueIndex;
   }
 
-  void EraseId(int id) { m_idMap.erase(id); }
+  // enables or disables sending array values for id as deltas against the
+  // previously sent value; the first value after enabling is always sent in
+  // full
+  void SetDeltaArrays(int id, bool enable) {
+    if (enable) {
+      m_deltaMap.try_emplace(id);
+    } else {
+      m_deltaMap.erase(id);
+    }
+  }
+
+  // limits non-critical transmissions to approximately bytesPerSec, with
+  // bursts of up to kBurstMs worth of budget; 0 disables the limit
+  void SetBandwidthLimit(uint32_t bytesPerSec) {
+    m_bytesPerSec = bytesPerSec;
+    m_tokens = GetBurstSize();
+  }
+
+  void EraseId(int id) {
+    m_idMap.erase(id);
+    m_deltaMap.erase(id);
+  }
 
   template <typename T>
   void SendMessage(int id, T&& msg) {
@@ -115,25 +158,39 @@ class NetworkOutgoingQueue {
     m_totalSize += sizeof(Message);
   }
 
-  void SendValue(int id, const Value& value, ValueSendMode mode) {
+  // encoded, if provided, must be the WireEncodeBinary() encoding of value as
+  // it is to be sent; it's written out as is instead of re-encoding value
+  void SendValue(int id, const Value& value, ValueSendMode mode,
+                 SharedEncodedValue encoded = {}) {
     if (m_local) {
       mode = ValueSendMode::kImm;  // always send local immediately
     }
     // backpressure by stopping sending all if the buffer is too full
+    bool backpressure = false;
     if (mode == ValueSendMode::kAll && m_totalSize >= kOutgoingLimit) {
       mode = ValueSendMode::kNormal;
+      backpressure = true;
     }
     switch (mode) {
       case ValueSendMode::kDisabled:  // do nothing
         break;
       case ValueSendMode::kImm:  // send immediately
-        m_wire.SendBinary([&](auto& os) { EncodeValue(os, id, value); });
+        m_wire.SendBinary([&](auto& os) {
+          if (encoded) {
+            os << std::span{*encoded};
+          } else {
+            EncodeValue(os, id, value);
+          }
+        });
+        if (auto it = m_deltaMap.find(id); it != m_deltaMap.end()) {
+          it->second.lastSent = value;
+        }
         break;
       case ValueSendMode::kAll: {  // append to outgoing
         auto& info = m_idMap[id];
         auto& queue = m_queues[info.queueIndex];
         info.valuePos = queue.msgs.size();
-        queue.Append(id, ValueMsg{id, value});
+        queue.Append(id, MakeValueMsg(id, value, std::move(encoded)));
         m_totalSize += sizeof(Message) + value.size();
         break;
       }
@@ -150,19 +207,39 @@ class NetworkOutgoingQueue {
                 (m->value.time() == 0 || value.time() >= m->value.time())) {
               int delta = value.size() - m->value.size();
               m->value = value;
+              if constexpr (std::same_as<ValueMsg, ServerValueMsg>) {
+                m->encoded = std::move(encoded);
+              }
               m_totalSize += delta;
+              if (backpressure) {
+                ++m_stats.dropped;
+              } else {
+                ++m_stats.coalesced;
+              }
               return;
             }
           }
         }
         info.valuePos = queue.msgs.size();
-        queue.Append(id, ValueMsg{id, value});
+        queue.Append(id, MakeValueMsg(id, value, std::move(encoded)));
         m_totalSize += sizeof(Message) + value.size();
         break;
       }
     }
   }
 
+  // true if nothing is waiting to be sent
+  bool IsEmpty() const { return m_totalSize == 0; }
+
+  OutgoingQueueStats GetStats() const {
+    OutgoingQueueStats stats = m_stats;
+    for (auto&& queue : m_queues) {
+      stats.queuedMessages += queue.msgs.size();
+    }
+    stats.queuedBytes = m_totalSize;
+    return stats;
+  }
+
   void SendOutgoing(uint64_t curTimeMs, bool flush) {
     if (m_totalSize == 0) {
       return;  // nothing to do
@@ -189,30 +266,88 @@ class NetworkOutgoingQueue {
       return;  // nothing needs to be sent yet
     }
 
-    // Sort transmission order by what queue has been waiting the longest time.
+    // protocol 4.2 supports sending scalar values in batches
+    bool batch = m_wire.GetVersion() >= 0x0402;
+
+    // Sort transmission order by priority, then by what queue has been waiting
+    // the longest time.
     // XXX: byte-weighted fair queueing might be better, but is much more
     // complex to implement.
     std::sort(queues.begin(), queues.end(), [&](const auto& a, const auto& b) {
-      return m_queues[a].nextSendMs < m_queues[b].nextSendMs;
+      auto& qa = m_queues[a];
+      auto& qb = m_queues[b];
+      if (qa.priority != qb.priority) {
+        return qa.priority < qb.priority;
+      }
+      return qa.nextSendMs < qb.nextSendMs;
     });
 
+    // refill bandwidth budget
+    if (m_bytesPerSec != 0) {
+      m_tokens = (std::min)(
+          m_tokens + static_cast<int64_t>((curTimeMs - m_lastRefillMs) *
+                                          m_bytesPerSec / 1000),
+          GetBurstSize());
+      m_lastRefillMs = curTimeMs;
+    }
+
     for (unsigned int queueIndex : queues) {
       auto& queue = m_queues[queueIndex];
+      // over budget; leave queue to be sent later (values will coalesce)
+      if (m_bytesPerSec != 0 &&
+          ((queue.priority == SendPriority::kTelemetry && m_tokens <= 0) ||
+           (queue.priority == SendPriority::kBulk &&
+            m_tokens <= GetBurstSize() / 2))) {
+        continue;
+      }
+      size_t prevTotalSize = m_totalSize;
       auto& msgs = queue.msgs;
       auto it = msgs.begin();
       auto end = msgs.end();
       int unsent = 0;
-      for (; it != end && unsent == 0; ++it) {
+      // number of messages covered by each write call; only tracked when
+      // batching, as otherwise it's always 1
+      wpi::SmallVector<unsigned int, 32> writeCounts;
+      while (it != end && unsent == 0) {
         if (auto m = std::get_if<ValueMsg>(&it->msg.contents)) {
-          unsent = m_wire.WriteBinary(
-              [&](auto& os) { EncodeValue(os, it->id, m->value); });
+          if (batch) {
+            auto batchEnd = FindBatchEnd(it, end);
+            if (batchEnd - it >= 2) {
+              unsent = m_wire.WriteBinary(
+                  [&](auto& os) { EncodeBatch(os, std::span{it, batchEnd}); });
+              writeCounts.emplace_back(batchEnd - it);
+              it = batchEnd;
+              continue;
+            }
+            writeCounts.emplace_back(1);
+          }
+          unsent = m_wire.WriteBinary([&](auto& os) {
+            if constexpr (std::same_as<ValueMsg, ServerValueMsg>) {
+              if (!m_deltaMap.empty()) {
+                auto deltaIt = m_deltaMap.find(it->id);
+                if (deltaIt != m_deltaMap.end()) {
+                  EncodeDeltaValue(os, it->id, m->value, deltaIt->second);
+                  return;
+                }
+              }
+              if (m->encoded) {
+                os << std::span{*m->encoded};
+                return;
+              }
+            }
+            EncodeValue(os, it->id, m->value);
+          });
         } else {
+          if (batch) {
+            writeCounts.emplace_back(1);
+          }
           unsent = m_wire.WriteText([&](auto& os) {
             if (!WireEncodeText(os, it->msg)) {
               os << "{}";
             }
           });
         }
+        ++it;
       }
       if (unsent < 0) {
         return;  // error
@@ -224,7 +359,27 @@ class NetworkOutgoingQueue {
           return;  // error
         }
       }
-      int delta = it - msgs.begin() - unsent;
+      // convert unsent write calls into unsent messages
+      int unsentMsgs = unsent;
+      if (batch && unsent > 0) {
+        unsentMsgs = std::accumulate(
+            writeCounts.end() -
+                (std::min)(static_cast<size_t>(unsent), writeCounts.size()),
+            writeCounts.end(), 0);
+      }
+      int delta = it - msgs.begin() - unsentMsgs;
+      if (unsentMsgs > 0 && !m_deltaMap.empty()) {
+        // unsent values will be re-encoded later; the client never saw them,
+        // so they can't be used as delta bases
+        for (auto&& msg : std::span{msgs}.subspan(delta, unsentMsgs)) {
+          if (std::holds_alternative<ValueMsg>(msg.msg.contents)) {
+            auto deltaIt = m_deltaMap.find(msg.id);
+            if (deltaIt != m_deltaMap.end()) {
+              deltaIt->second.lastSent = Value{};
+            }
+          }
+        }
+      }
       for (auto&& msg : std::span{msgs}.subspan(0, delta)) {
         if (auto m = std::get_if<ValueMsg>(&msg.msg.contents)) {
           m_totalSize -= sizeof(Message) + m->value.size();
@@ -232,7 +387,8 @@ class NetworkOutgoingQueue {
           m_totalSize -= sizeof(Message);
         }
       }
-      msgs.erase(msgs.begin(), it - unsent);
+      msgs.erase(msgs.begin(), it - unsentMsgs);
+      m_tokens -= static_cast<int64_t>(prevTotalSize - m_totalSize);
       for (auto&& kv : m_idMap) {
         auto& info = kv.getSecond();
         if (info.queueIndex == queueIndex) {
@@ -265,7 +421,16 @@ class NetworkOutgoingQueue {
  private:
   using ValueMsg = typename MessageType::ValueMsg;
 
-  void EncodeValue(wpi::raw_ostream& os, int id, const Value& value) {
+  static ValueMsg MakeValueMsg(int id, const Value& value,
+                               SharedEncodedValue encoded) {
+    if constexpr (std::same_as<ValueMsg, ServerValueMsg>) {
+      return ValueMsg{id, value, std::move(encoded)};
+    } else {
+      return ValueMsg{id, value};
+    }
+  }
+
+  int64_t GetWireTime(const Value& value) const {
     int64_t time = value.time();
     if constexpr (std::same_as<ValueMsg, ClientValueMsg>) {
       if (time != 0) {
@@ -276,7 +441,28 @@ class NetworkOutgoingQueue {
         }
       }
     }
-    WireEncodeBinary(os, id, time, value);
+    return time;
+  }
+
+  void EncodeValue(wpi::raw_ostream& os, int id, const Value& value) {
+    WireEncodeBinary(os, id, GetWireTime(value), value);
+  }
+
+  struct DeltaInfo {
+    Value lastSent;  // last value written to the wire
+    unsigned int sinceKeyframe = 0;
+  };
+
+  void EncodeDeltaValue(wpi::raw_ostream& os, int id, const Value& value,
+                        DeltaInfo& info) {
+    if (info.lastSent && info.sinceKeyframe < kDeltaKeyframeInterval &&
+        WireEncodeBinaryDelta(os, id, value.time(), value, info.lastSent)) {
+      ++info.sinceKeyframe;
+    } else {
+      EncodeValue(os, id, value);
+      info.sinceKeyframe = 0;
+    }
+    info.lastSent = value;
   }
 
   struct Message {
@@ -288,8 +474,38 @@ class NetworkOutgoingQueue {
     int id;
   };
 
+  // returns the end of the run of batchable values starting at it
+  template <typename It>
+  static It FindBatchEnd(It it, It end) {
+    if (static_cast<size_t>(end - it) > kMaxBatchSize) {
+      end = it + kMaxBatchSize;
+    }
+    for (; it != end; ++it) {
+      auto m = std::get_if<ValueMsg>(&it->msg.contents);
+      if (!m || !WireIsBatchable(m->value)) {
+        break;
+      }
+    }
+    return it;
+  }
+
+  void EncodeBatch(wpi::raw_ostream& os, std::span<const Message> msgs) {
+    wpi::SmallVector<BinaryBatchEntry, 64> entries;
+    entries.reserve(msgs.size());
+    for (auto&& msg : msgs) {
+      auto& value = std::get<ValueMsg>(msg.msg.contents).value;
+      entries.emplace_back(msg.id, GetWireTime(value), &value);
+    }
+    WireEncodeBinaryBatch(os, entries);
+  }
+
+  int64_t GetBurstSize() const {
+    return static_cast<int64_t>(m_bytesPerSec) * kBurstMs / 1000;
+  }
+
   struct Queue {
-    explicit Queue(uint32_t periodMs) : periodMs{periodMs} {}
+    Queue(uint32_t periodMs, SendPriority priority)
+        : periodMs{periodMs}, priority{priority} {}
     template <typename T>
     void Append(NT_Handle handle, T&& msg) {
       msgs.emplace_back(std::forward<T>(msg), handle);
@@ -297,6 +513,7 @@ class NetworkOutgoingQueue {
     std::vector<Message> msgs;
     uint64_t nextSendMs = 0;
     uint32_t periodMs;
+    SendPriority priority;
   };
 
   std::vector<Queue> m_queues;
@@ -306,15 +523,32 @@ class NetworkOutgoingQueue {
     int valuePos = -1;  // -1 if not in queue
   };
   wpi::DenseMap<int, HandleInfo> m_idMap;
+  wpi::DenseMap<int, DeltaInfo> m_deltaMap;
   size_t m_totalSize{0};
   uint64_t m_lastSendMs{0};
   int64_t m_timeOffsetUs{0};
   unsigned int m_lastSetPeriodQueueIndex = 0;
   unsigned int m_lastSetPeriod = 100;
+  SendPriority m_lastSetPriority = SendPriority::kTelemetry;
   bool m_local;
+  OutgoingQueueStats m_stats;
+
+  // bandwidth limiting (token bucket, in bytes); disabled if m_bytesPerSec is 0
+  uint32_t m_bytesPerSec = 0;
+  int64_t m_tokens = 0;
+  uint64_t m_lastRefillMs = 0;
 
   // maximum total size of outgoing queues in bytes (approximate)
   static constexpr size_t kOutgoingLimit = 1024 * 1024;
+
+  // a full value is sent after at most this many consecutive deltas
+  static constexpr unsigned int kDeltaKeyframeInterval = 50;
+
+  // maximum number of values in a single batch message
+  static constexpr size_t kMaxBatchSize = 256;
+
+  // bandwidth budget can accumulate up to this many ms worth of bytes
+  static constexpr uint32_t kBurstMs = 100;
 };
 
 }  // namespace nt::net
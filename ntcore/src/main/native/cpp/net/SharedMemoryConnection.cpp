@@ -0,0 +1,367 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "SharedMemoryConnection.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#include <fmt/format.h>
+#include <wpi/Endian.h>
+#include <wpi/Logger.h>
+#include <wpi/StringExtras.h>
+#include <wpi/fs.h>
+#include <wpi/raw_ostream.h>
+#include <wpi/timestamp.h>
+#include <wpinet/uv/Stream.h>
+#include <wpinet/uv/Timer.h>
+
+using namespace nt;
+using namespace nt::net;
+
+// size of each ring's data area; a single frame must fit in this
+static constexpr size_t kRingDataSize = 4 * 1024 * 1024;
+static constexpr size_t kRingSize =
+    SharedMemoryRing::kHeaderSize + kRingDataSize;
+// region layout: header, client to server ring, server to client ring
+static constexpr size_t kRegionHeaderSize = 128;
+static constexpr size_t kRegionSize = kRegionHeaderSize + 2 * kRingSize;
+static constexpr uint64_t kRegionMagic = 0x4e54534d30303031;  // "NTSM0001"
+
+// start a new frame once the current one is this large
+static constexpr size_t kNewFrameThresholdBytes = 64 * 1024;
+static constexpr size_t kFlushThresholdBytes = 1024 * 1024;
+
+static const uint8_t kWakeData[1] = {0};
+
+bool nt::net::IsLoopbackAddress(std::string_view addr) {
+  return wpi::starts_with(addr, "127.") || addr == "::1" ||
+         wpi::starts_with(addr, "::ffff:127.");
+}
+
+static fs::path GetRegionDir() {
+  std::error_code ec;
+#ifdef __linux__
+  // tmpfs, so the file is never written back to disk
+  if (fs::is_directory("/dev/shm", ec)) {
+    return "/dev/shm";
+  }
+#endif
+  return fs::temp_directory_path(ec);
+}
+
+static bool IsValidRegionName(std::string_view name) {
+  return wpi::starts_with(name, "ntcore-") &&
+         std::all_of(name.begin(), name.end(), [](char ch) {
+           return wpi::isAlnum(ch) || ch == '-';
+         });
+}
+
+std::shared_ptr<SharedMemoryRegion> SharedMemoryRegion::Create() {
+#ifdef _WIN32
+  return nullptr;
+#else
+  static std::atomic<unsigned int> counter{0};
+  std::shared_ptr<SharedMemoryRegion> region{new SharedMemoryRegion};
+  region->m_name =
+      fmt::format("ntcore-{}-{}-{:x}", ::getpid(), ++counter, wpi::Now());
+  auto path = GetRegionDir() / region->m_name;
+
+  std::error_code ec;
+  fs::file_t f = fs::OpenFileForReadWrite(path, ec, fs::CD_CreateNew,
+                                          fs::OF_None, 0600);
+  if (ec) {
+    return nullptr;
+  }
+  region->m_path = path.string();
+  fs::resize_file(path, kRegionSize, ec);
+  if (!ec) {
+    region->m_mapping = wpi::MappedFileRegion{
+        f, kRegionSize, 0, wpi::MappedFileRegion::kReadWrite, ec};
+  }
+  fs::CloseFile(f);
+  if (ec) {
+    return nullptr;
+  }
+
+  region->GetClientToServer().Init();
+  region->GetServerToClient().Init();
+  std::memcpy(region->m_mapping.data(), &kRegionMagic, sizeof(kRegionMagic));
+  return region;
+#endif
+}
+
+std::shared_ptr<SharedMemoryRegion> SharedMemoryRegion::Open(
+    std::string_view name) {
+#ifdef _WIN32
+  return nullptr;
+#else
+  if (!IsValidRegionName(name)) {
+    return nullptr;
+  }
+  auto path = GetRegionDir() / name;
+
+  std::error_code ec;
+  if (fs::file_size(path, ec) != kRegionSize || ec) {
+    return nullptr;
+  }
+  fs::file_t f =
+      fs::OpenFileForReadWrite(path, ec, fs::CD_OpenExisting, fs::OF_None);
+  if (ec) {
+    return nullptr;
+  }
+  std::shared_ptr<SharedMemoryRegion> region{new SharedMemoryRegion};
+  region->m_name = name;
+  region->m_mapping = wpi::MappedFileRegion{
+      f, kRegionSize, 0, wpi::MappedFileRegion::kReadWrite, ec};
+  fs::CloseFile(f);
+  // the mapping keeps the memory alive; remove the name right away so it's
+  // cleaned up no matter how either side exits
+  fs::remove(path, ec);
+  if (!region->m_mapping || std::memcmp(region->m_mapping.data(), &kRegionMagic,
+                                         sizeof(kRegionMagic)) != 0) {
+    return nullptr;
+  }
+  return region;
+#endif
+}
+
+void SharedMemoryRegion::Remove() {
+  if (!m_path.empty()) {
+    std::error_code ec;
+    fs::remove(m_path, ec);
+    m_path.clear();
+  }
+}
+
+SharedMemoryRing SharedMemoryRegion::GetClientToServer() const {
+  return {m_mapping.data() + kRegionHeaderSize, kRingSize};
+}
+
+SharedMemoryRing SharedMemoryRegion::GetServerToClient() const {
+  return {m_mapping.data() + kRegionHeaderSize + kRingSize, kRingSize};
+}
+
+SharedMemoryConnection::SharedMemoryConnection(
+    wpi::WebSocket& ws, unsigned int version,
+    std::shared_ptr<SharedMemoryRegion> region, bool server,
+    wpi::Logger& logger)
+    : m_ws{ws},
+      m_logger{logger},
+      m_region{std::move(region)},
+      m_tx{server ? m_region->GetServerToClient()
+                  : m_region->GetClientToServer()},
+      m_rx{server ? m_region->GetClientToServer()
+                  : m_region->GetServerToClient()},
+      m_version{version} {
+  m_pongConn = m_ws.pong.connect_connection([this](std::span<const uint8_t>) {
+    if (m_pingSentTime != 0) {
+      m_rttUs.store(wpi::Now() - m_pingSentTime, std::memory_order_relaxed);
+      m_pingSentTime = 0;
+    }
+  });
+}
+
+void SharedMemoryConnection::Poll() {
+  // handlers may call back in (e.g. via StartRead)
+  if (m_polling) {
+    return;
+  }
+  m_polling = true;
+
+  // read incoming messages
+  bool read = false;
+  while (m_readActive) {
+    if (!m_rx.ReadOne([&](uint8_t type, std::span<const uint8_t> data) {
+          m_bytesIn.fetch_add(data.size(), std::memory_order_relaxed);
+          if (type == kText) {
+            if (m_textHandler) {
+              m_textHandler({reinterpret_cast<const char*>(data.data()),
+                             data.size()});
+            }
+          } else if (m_binaryHandler) {
+            m_binaryHandler(data);
+          }
+        })) {
+      if (m_rx.IsCorrupt()) {
+        m_polling = false;
+        Disconnect("corrupt shared memory ring");
+        return;
+      }
+      if (!m_rx.SetReaderWaiting()) {
+        break;
+      }
+      continue;
+    }
+    read = true;
+  }
+  if (read) {
+    m_lastReceivedTime = wpi::Now();
+    if (m_rx.ConsumeWriterWaiting()) {
+      Wake();
+    }
+  }
+  m_polling = false;
+
+  SendPending();
+}
+
+void SharedMemoryConnection::SendPending() {
+  bool wrote = false;
+  while (!m_pending.empty()) {
+    auto& [type, data] = m_pending.front();
+    if (!m_tx.Write(type, data)) {
+      break;
+    }
+    m_bytesOut.fetch_add(data.size(), std::memory_order_relaxed);
+    m_pending.pop_front();
+    wrote = true;
+  }
+  if (wrote && m_tx.ConsumeReaderWaiting()) {
+    Wake();
+  }
+}
+
+void SharedMemoryConnection::SendPing(uint64_t time) {
+  WPI_DEBUG4(m_logger, "shm: sending ping {}", time);
+  auto buf = wpi::uv::Buffer::Allocate(8);
+  wpi::support::endian::write64<wpi::endianness::native>(buf.base, time);
+  m_pingSentTime = wpi::Now();
+  m_ws.SendPing({buf}, [](auto bufs, auto) {
+    for (auto&& buf : bufs) {
+      buf.Deallocate();
+    }
+  });
+}
+
+int SharedMemoryConnection::Write(
+    Type type, wpi::function_ref<void(wpi::raw_ostream& os)> writer) {
+  bool first = false;
+  if (m_numFrames == 0 || m_frames[m_numFrames - 1].type != type ||
+      m_frames[m_numFrames - 1].data.size() >= kNewFrameThresholdBytes) {
+    // start a new frame, reusing a spare if possible
+    if (m_numFrames == m_frames.size()) {
+      m_frames.emplace_back();
+    }
+    auto& frame = m_frames[m_numFrames++];
+    frame.type = type;
+    frame.data.clear();
+    frame.count = 0;
+    first = true;
+  }
+  auto& frame = m_frames[m_numFrames - 1];
+  size_t prevSize = frame.data.size();
+  {
+    wpi::raw_uvector_ostream os{frame.data};
+    if (type == kText) {
+      os << (first ? '[' : ',');
+    }
+    writer(os);
+  }
+  ++frame.count;
+  m_written += frame.data.size() - prevSize;
+  if (m_written >= kFlushThresholdBytes) {
+    return Flush();
+  }
+  return 0;
+}
+
+int SharedMemoryConnection::Flush() {
+  m_lastFlushTime = wpi::Now();
+  if (m_numFrames == 0) {
+    return 0;
+  }
+
+  // messages sent with SendText/SendBinary must go first
+  SendPending();
+
+  int unsent = 0;
+  bool wrote = false;
+  for (auto&& frame : std::span{m_frames}.subspan(0, m_numFrames)) {
+    if (frame.type == kText) {
+      frame.data.push_back(']');
+    }
+    if (unsent == 0 && m_pending.empty() &&
+        m_tx.Write(frame.type, frame.data)) {
+      m_bytesOut.fetch_add(frame.data.size(), std::memory_order_relaxed);
+      wrote = true;
+    } else {
+      if (frame.data.size() > m_tx.GetMaxPayloadSize()) {
+        Disconnect("message too large for shared memory");
+      }
+      unsent += frame.count;
+    }
+  }
+  m_numFrames = 0;
+  m_written = 0;
+  if (wrote && m_tx.ConsumeReaderWaiting()) {
+    Wake();
+  }
+  return unsent;
+}
+
+void SharedMemoryConnection::Send(
+    Type type, wpi::function_ref<void(wpi::raw_ostream& os)> writer) {
+  std::vector<uint8_t> data;
+  {
+    wpi::raw_uvector_ostream os{data};
+    if (type == kText) {
+      os << '[';
+    }
+    writer(os);
+    if (type == kText) {
+      os << ']';
+    }
+  }
+  if (data.size() > m_tx.GetMaxPayloadSize()) {
+    Disconnect("message too large for shared memory");
+    return;
+  }
+  if (m_pending.empty() && m_tx.Write(type, data)) {
+    m_bytesOut.fetch_add(data.size(), std::memory_order_relaxed);
+    if (m_tx.ConsumeReaderWaiting()) {
+      Wake();
+    }
+  } else {
+    m_pending.emplace_back(type, std::move(data));
+  }
+}
+
+void SharedMemoryConnection::StartRead() {
+  if (m_readActive) {
+    return;
+  }
+  m_readActive = true;
+  // the other side doesn't wake us for data that arrived while stopped
+  wpi::uv::Timer::SingleShot(m_ws.GetStream().GetLoopRef(),
+                             wpi::uv::Timer::Time{0},
+                             [selfweak = weak_from_this()] {
+                               if (auto self = selfweak.lock()) {
+                                 self->Poll();
+                               }
+                             });
+}
+
+void SharedMemoryConnection::Disconnect(std::string_view reason) {
+  if (m_reason.empty()) {
+    m_reason = reason;
+  }
+  m_ws.Fail(1001, reason);
+}
+
+void SharedMemoryConnection::Wake() {
+  m_ws.SendBinary({wpi::uv::Buffer{kWakeData, sizeof(kWakeData)}},
+                  [](auto, auto) {});
+}
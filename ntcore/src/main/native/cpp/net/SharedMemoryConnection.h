@@ -0,0 +1,183 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <wpi/MappedFileRegion.h>
+#include <wpi/function_ref.h>
+#include <wpinet/WebSocket.h>
+
+#include "SharedMemoryRing.h"
+#include "WireConnection.h"
+
+namespace wpi {
+class Logger;
+}  // namespace wpi
+
+namespace nt::net {
+
+// WebSocket subprotocol used to negotiate a shared memory connection, and the
+// handshake header carrying the region name
+inline constexpr std::string_view kSharedMemoryProtocol =
+    "shm.v4.2.networktables.first.wpi.edu";
+inline constexpr std::string_view kSharedMemoryHeader = "NT-SharedMemory";
+// close reason sent by the server if it can't open the region
+inline constexpr std::string_view kSharedMemoryFailReason =
+    "shared memory unavailable";
+
+// true if addr is a loopback IP address
+bool IsLoopbackAddress(std::string_view addr);
+
+// Memory mapped file holding the two rings of a shared memory connection.
+// The client creates it, and the server opens it and removes the file (after
+// which it's only reachable via the mappings).
+class SharedMemoryRegion {
+ public:
+  // returns nullptr on error
+  static std::shared_ptr<SharedMemoryRegion> Create();
+  static std::shared_ptr<SharedMemoryRegion> Open(std::string_view name);
+
+  SharedMemoryRegion(const SharedMemoryRegion&) = delete;
+  SharedMemoryRegion& operator=(const SharedMemoryRegion&) = delete;
+  ~SharedMemoryRegion() { Remove(); }
+
+  std::string_view GetName() const { return m_name; }
+
+  // removes the file, if not already removed
+  void Remove();
+
+  SharedMemoryRing GetClientToServer() const;
+  SharedMemoryRing GetServerToClient() const;
+
+ private:
+  SharedMemoryRegion() = default;
+
+  std::string m_name;
+  std::string m_path;  // empty if removed
+  wpi::MappedFileRegion m_mapping;
+};
+
+// WireConnection that exchanges messages through a SharedMemoryRegion instead
+// of the WebSocket it was negotiated on.  The WebSocket stays open to wake up
+// the other side when it's waiting for data (or space), for pings, and to
+// detect disconnection.
+class SharedMemoryConnection final
+    : public WireConnection,
+      public std::enable_shared_from_this<SharedMemoryConnection> {
+ public:
+  SharedMemoryConnection(wpi::WebSocket& ws, unsigned int version,
+                         std::shared_ptr<SharedMemoryRegion> region,
+                         bool server, wpi::Logger& logger);
+  SharedMemoryConnection(const SharedMemoryConnection&) = delete;
+  SharedMemoryConnection& operator=(const SharedMemoryConnection&) = delete;
+
+  // sets the handlers called by Poll() for incoming messages
+  void SetHandlers(std::function<void(std::string_view)> text,
+                   std::function<void(std::span<const uint8_t>)> binary) {
+    m_textHandler = std::move(text);
+    m_binaryHandler = std::move(binary);
+  }
+
+  // Processes incoming messages and retries pending sends.  Must be called
+  // whenever anything is received on the WebSocket.
+  void Poll();
+
+  unsigned int GetVersion() const final { return m_version; }
+
+  void SendPing(uint64_t time) final;
+
+  bool Ready() const final { return m_pending.empty(); }
+
+  int WriteText(wpi::function_ref<void(wpi::raw_ostream& os)> writer) final {
+    return Write(kText, writer);
+  }
+  int WriteBinary(wpi::function_ref<void(wpi::raw_ostream& os)> writer) final {
+    return Write(kBinary, writer);
+  }
+  int Flush() final;
+
+  void SendText(wpi::function_ref<void(wpi::raw_ostream& os)> writer) final {
+    Send(kText, writer);
+  }
+  void SendBinary(wpi::function_ref<void(wpi::raw_ostream& os)> writer) final {
+    Send(kBinary, writer);
+  }
+
+  uint64_t GetLastFlushTime() const final { return m_lastFlushTime; }
+
+  uint64_t GetLastReceivedTime() const final {
+    return (std::max)(m_ws.GetLastReceivedTime(), m_lastReceivedTime);
+  }
+
+  void StopRead() final { m_readActive = false; }
+  void StartRead() final;
+
+  WireStats GetStats() const final {
+    return {m_bytesIn.load(std::memory_order_relaxed),
+            m_bytesOut.load(std::memory_order_relaxed),
+            m_rttUs.load(std::memory_order_relaxed)};
+  }
+
+  void Disconnect(std::string_view reason) final;
+
+  std::string_view GetDisconnectReason() const final { return m_reason; }
+
+ private:
+  enum Type : uint8_t { kText = 1, kBinary = 2 };
+
+  int Write(Type type, wpi::function_ref<void(wpi::raw_ostream& os)> writer);
+  void Send(Type type, wpi::function_ref<void(wpi::raw_ostream& os)> writer);
+  void SendPending();
+  void Wake();
+
+  wpi::WebSocket& m_ws;
+  wpi::Logger& m_logger;
+  std::shared_ptr<SharedMemoryRegion> m_region;
+  SharedMemoryRing m_tx;
+  SharedMemoryRing m_rx;
+  std::function<void(std::string_view)> m_textHandler;
+  std::function<void(std::span<const uint8_t>)> m_binaryHandler;
+  bool m_readActive = true;
+  bool m_polling = false;
+
+  // messages written but not yet flushed; text frames hold JSON arrays
+  struct Frame {
+    Type type;
+    std::vector<uint8_t> data;
+    unsigned int count = 0;
+  };
+  std::vector<Frame> m_frames;  // entries beyond m_numFrames are spares
+  size_t m_numFrames = 0;
+  size_t m_written = 0;
+
+  // SendText/SendBinary messages waiting for ring space
+  std::deque<std::pair<Type, std::vector<uint8_t>>> m_pending;
+
+  std::string m_reason;
+  uint64_t m_lastFlushTime = 0;
+  uint64_t m_lastReceivedTime = 0;
+  uint64_t m_pingSentTime = 0;
+  unsigned int m_version;
+
+  // statistics; read from other threads
+  std::atomic<uint64_t> m_bytesIn{0};
+  std::atomic<uint64_t> m_bytesOut{0};
+  std::atomic<int64_t> m_rttUs{0};
+  wpi::sig::ScopedConnection m_pongConn;
+};
+
+}  // namespace nt::net
@@ -0,0 +1,100 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "SharedMemoryRing.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <new>
+#include <utility>
+
+#include <wpi/Endian.h>
+
+using namespace nt::net;
+
+SharedMemoryRing::SharedMemoryRing(uint8_t* mem, size_t size)
+    : m_shared{reinterpret_cast<Shared*>(mem)},
+      m_data{mem + kHeaderSize},
+      m_capacity{size - kHeaderSize} {
+  assert((m_capacity & (m_capacity - 1)) == 0);
+}
+
+void SharedMemoryRing::Init() {
+  new (m_shared) Shared;
+  m_shared->head = 0;
+  m_shared->tail = 0;
+  m_shared->writerWaiting = 0;
+  // the reader starts out waiting for the first message
+  m_shared->readerWaiting = 1;
+}
+
+bool SharedMemoryRing::Write(uint8_t type, std::span<const uint8_t> data) {
+  if (data.size() > GetMaxPayloadSize()) {
+    return false;
+  }
+  uint64_t size = RecordSize(data.size());
+  uint64_t head = m_shared->head.load(std::memory_order_relaxed);
+  if (size > m_capacity - (head - m_shared->tail.load())) {
+    // ask to be woken, then check again in case the reader freed space before
+    // it saw the flag
+    m_shared->writerWaiting = 1;
+    if (size > m_capacity - (head - m_shared->tail.load())) {
+      return false;
+    }
+  }
+
+  // records are 8-byte aligned, so the record header never wraps
+  uint8_t* hdr = m_data + (head & (m_capacity - 1));
+  wpi::support::endian::write32le(hdr, data.size());
+  hdr[4] = type;
+  CopyIn(head + kRecordHeaderSize, data.data(), data.size());
+  m_shared->head.store(head + size);
+  return true;
+}
+
+bool SharedMemoryRing::SetReaderWaiting() {
+  m_shared->readerWaiting = 1;
+  if (m_shared->tail.load(std::memory_order_relaxed) !=
+      m_shared->head.load()) {
+    m_shared->readerWaiting = 0;
+    return true;
+  }
+  return false;
+}
+
+std::optional<std::pair<uint8_t, std::span<const uint8_t>>>
+SharedMemoryRing::Peek(uint64_t pos, uint64_t available) {
+  // records are 8-byte aligned, so the header can be read without wrapping
+  if ((pos & 7) != 0 || available < kRecordHeaderSize ||
+      available > m_capacity) {
+    return std::nullopt;
+  }
+  const uint8_t* hdr = m_data + (pos & (m_capacity - 1));
+  size_t len = wpi::support::endian::read32le(hdr);
+  uint8_t type = hdr[4];
+  if (len > GetMaxPayloadSize() || RecordSize(len) > available) {
+    return std::nullopt;
+  }
+  size_t start = (pos + kRecordHeaderSize) & (m_capacity - 1);
+  if (start + len <= m_capacity) {
+    return {{type, {m_data + start, len}}};
+  }
+  // wraps around; copy into contiguous buffer
+  m_scratch.resize(len);
+  size_t first = m_capacity - start;
+  std::memcpy(m_scratch.data(), m_data + start, first);
+  std::memcpy(m_scratch.data() + first, m_data, len - first);
+  return {{type, m_scratch}};
+}
+
+void SharedMemoryRing::CopyIn(uint64_t pos, const uint8_t* data, size_t len) {
+  if (len == 0) {
+    return;
+  }
+  size_t start = pos & (m_capacity - 1);
+  size_t first = (std::min)(len, m_capacity - start);
+  std::memcpy(m_data + start, data, first);
+  std::memcpy(m_data, data + first, len - first);
+}
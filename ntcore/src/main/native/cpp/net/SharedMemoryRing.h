@@ -0,0 +1,113 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace nt::net {
+
+// Single-producer, single-consumer ring of messages in memory that may be
+// shared between processes.  Each message has a type and a byte payload.
+//
+// Wakeups are left to the caller: after a successful Write(), the writer must
+// wake the reader if ConsumeReaderWaiting() returns true; after reading, the
+// reader must wake the writer if ConsumeWriterWaiting() returns true.
+class SharedMemoryRing {
+ public:
+  // size of the shared header at the start of the ring memory
+  static constexpr size_t kHeaderSize = 128;
+
+  // mem must be 8-byte aligned, and size must be kHeaderSize plus a power of 2
+  SharedMemoryRing(uint8_t* mem, size_t size);
+
+  // Initializes the shared header; must be called by exactly one side, before
+  // the other side starts using the ring.
+  void Init();
+
+  // largest payload that can ever be written
+  size_t GetMaxPayloadSize() const { return m_capacity - kRecordHeaderSize; }
+
+  // Returns false if there is not currently enough space; the reader will
+  // then report (via ConsumeWriterWaiting) when it has freed space.
+  bool Write(uint8_t type, std::span<const uint8_t> data);
+
+  // Reads one message, calling func(type, data).  data is only valid during
+  // the call.  Returns false if the ring is empty, or if the ring is corrupt
+  // (the next record doesn't fit in the written data); IsCorrupt()
+  // distinguishes the two.  Nothing more is read once the ring is corrupt.
+  template <typename F>
+  bool ReadOne(F&& func) {
+    if (m_corrupt) {
+      return false;
+    }
+    uint64_t tail = m_shared->tail.load(std::memory_order_relaxed);
+    uint64_t head = m_shared->head.load(std::memory_order_acquire);
+    if (tail == head) {
+      return false;
+    }
+    auto record = Peek(tail, head - tail);
+    if (!record) {
+      m_corrupt = true;
+      return false;
+    }
+    func(record->first, record->second);
+    m_shared->tail.store(tail + RecordSize(record->second.size()));
+    return true;
+  }
+
+  // true if ReadOne() found an invalid record; the connection should be closed
+  bool IsCorrupt() const { return m_corrupt; }
+
+  // true if there is at least one message to read
+  bool HasData() const {
+    return m_shared->tail.load(std::memory_order_relaxed) !=
+           m_shared->head.load(std::memory_order_acquire);
+  }
+
+  // Marks the reader as waiting for a wakeup.  Returns true if data arrived
+  // in the meantime (the reader should keep reading instead of waiting).
+  bool SetReaderWaiting();
+
+  bool ConsumeReaderWaiting() { return m_shared->readerWaiting.exchange(0); }
+  bool ConsumeWriterWaiting() { return m_shared->writerWaiting.exchange(0); }
+
+ private:
+  static constexpr size_t kRecordHeaderSize = 8;
+
+  static uint64_t RecordSize(size_t len) {
+    return kRecordHeaderSize + ((len + 7) & ~static_cast<size_t>(7));
+  }
+
+  // Returns nullopt if the record at pos is invalid, given the number of
+  // bytes available to read.  Both are read from shared memory, so the peer
+  // could have written anything.
+  std::optional<std::pair<uint8_t, std::span<const uint8_t>>> Peek(
+      uint64_t pos, uint64_t available);
+  void CopyIn(uint64_t pos, const uint8_t* data, size_t len);
+
+  struct Shared {
+    alignas(64) std::atomic<uint64_t> head;  // written by writer
+    std::atomic<uint32_t> writerWaiting;
+    alignas(64) std::atomic<uint64_t> tail;  // written by reader
+    std::atomic<uint32_t> readerWaiting;
+  };
+  static_assert(sizeof(Shared) <= kHeaderSize);
+  static_assert(std::atomic<uint64_t>::is_always_lock_free);
+  static_assert(std::atomic<uint32_t>::is_always_lock_free);
+
+  Shared* m_shared;
+  uint8_t* m_data;
+  size_t m_capacity;
+  std::vector<uint8_t> m_scratch;  // for payloads that wrap around
+  bool m_corrupt = false;
+};
+
+}  // namespace nt::net
@@ -58,6 +58,7 @@ void WebSocketConnection::Stream::write_impl(const char* data, size_t len) {
     m_conn.m_bufs.back().len = len;
     m_conn.m_framePos += amt;
     m_conn.m_written += amt;
+    m_conn.m_bytesOut.fetch_add(amt, std::memory_order_relaxed);
     if (!m_disableAlloc) {
 #ifdef NT_ENABLE_WS_FRAG
       m_conn.m_frames.back().opcode &= ~wpi::WebSocket::kFlagFin;
@@ -84,6 +85,7 @@ void WebSocketConnection::Stream::write_impl(const char* data, size_t len) {
       buf.len += amt;
       m_conn.m_framePos += amt;
       m_conn.m_written += amt;
+      m_conn.m_bytesOut.fetch_add(amt, std::memory_order_relaxed);
       data += amt;
       len -= amt;
     }
@@ -109,7 +111,22 @@ void WebSocketConnection::Stream::write_impl(const char* data, size_t len) {
 WebSocketConnection::WebSocketConnection(wpi::WebSocket& ws,
                                          unsigned int version,
                                          wpi::Logger& logger)
-    : m_ws{ws}, m_logger{logger}, m_version{version} {}
+    : m_ws{ws}, m_logger{logger}, m_version{version} {
+  m_textConn =
+      m_ws.text.connect_connection([this](std::string_view data, bool) {
+        m_bytesIn.fetch_add(data.size(), std::memory_order_relaxed);
+      });
+  m_binaryConn = m_ws.binary.connect_connection(
+      [this](std::span<const uint8_t> data, bool) {
+        m_bytesIn.fetch_add(data.size(), std::memory_order_relaxed);
+      });
+  m_pongConn = m_ws.pong.connect_connection([this](std::span<const uint8_t>) {
+    if (m_pingSentTime != 0) {
+      m_rttUs.store(wpi::Now() - m_pingSentTime, std::memory_order_relaxed);
+      m_pingSentTime = 0;
+    }
+  });
+}
 
 WebSocketConnection::~WebSocketConnection() {
   for (auto&& buf : m_bufs) {
@@ -125,6 +142,7 @@ void WebSocketConnection::SendPing(uint64_t time) {
   auto buf = AllocBuf();
   buf.len = 8;
   wpi::support::endian::write64<wpi::endianness::native>(buf.base, time);
+  m_pingSentTime = wpi::Now();
   m_ws.SendPing({buf}, [selfweak = weak_from_this()](auto bufs, auto err) {
     if (auto self = selfweak.lock()) {
       self->m_err = err;
@@ -253,6 +271,9 @@ void WebSocketConnection::Send(
   if (opcode == wpi::WebSocket::Frame::kText) {
     os << ']';
   }
+  for (auto&& buf : os.bufs()) {
+    m_bytesOut.fetch_add(buf.len, std::memory_order_relaxed);
+  }
   wpi::WebSocket::Frame frame{opcode, os.bufs()};
   WPI_DEBUG4(m_logger, "Send({})", static_cast<uint8_t>(opcode));
   m_ws.SendFrames({{frame}}, [selfweak = weak_from_this()](auto bufs, auto) {
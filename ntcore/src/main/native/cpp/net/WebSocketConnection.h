@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -59,6 +60,12 @@ class WebSocketConnection final
     return m_ws.GetLastReceivedTime();
   }
 
+  WireStats GetStats() const final {
+    return {m_bytesIn.load(std::memory_order_relaxed),
+            m_bytesOut.load(std::memory_order_relaxed),
+            m_rttUs.load(std::memory_order_relaxed)};
+  }
+
   void StopRead() final {
     if (m_readActive) {
       m_ws.GetStream().StopRead();
@@ -74,7 +81,7 @@ class WebSocketConnection final
 
   void Disconnect(std::string_view reason) final;
 
-  std::string_view GetDisconnectReason() const { return m_reason; }
+  std::string_view GetDisconnectReason() const final { return m_reason; }
 
  private:
   enum State { kEmpty, kText, kBinary };
@@ -114,6 +121,15 @@ class WebSocketConnection final
   std::string m_reason;
   uint64_t m_lastFlushTime = 0;
   unsigned int m_version;
+
+  // statistics; read from other threads
+  std::atomic<uint64_t> m_bytesIn{0};
+  std::atomic<uint64_t> m_bytesOut{0};
+  std::atomic<int64_t> m_rttUs{0};
+  uint64_t m_pingSentTime = 0;
+  wpi::sig::ScopedConnection m_textConn;
+  wpi::sig::ScopedConnection m_binaryConn;
+  wpi::sig::ScopedConnection m_pongConn;
 };
 
 }  // namespace nt::net
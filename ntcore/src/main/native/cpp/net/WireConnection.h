@@ -16,6 +16,13 @@ class raw_ostream;
 
 namespace nt::net {
 
+struct WireStats {
+  uint64_t bytesIn = 0;
+  uint64_t bytesOut = 0;
+  // most recent ping round trip time, in microseconds; 0 if unknown
+  int64_t rttUs = 0;
+};
+
 class WireConnection {
  public:
   virtual ~WireConnection() = default;
@@ -54,10 +61,16 @@ class WireConnection {
   // Gets the timestamp of the last incoming data
   virtual uint64_t GetLastReceivedTime() const = 0;  // in microseconds
 
+  // Gets byte counts and round trip time, if tracked by the connection
+  virtual WireStats GetStats() const { return {}; }
+
   virtual void StopRead() = 0;
   virtual void StartRead() = 0;
 
   virtual void Disconnect(std::string_view reason) = 0;
+
+  // reason passed to Disconnect(), if it has been called
+  virtual std::string_view GetDisconnectReason() const { return {}; }
 };
 
 }  // namespace nt::net
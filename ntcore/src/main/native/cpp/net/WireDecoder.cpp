@@ -5,435 +5,924 @@
 #include "WireDecoder.h"
 
 #include <algorithm>
+#include <bit>
 #include <concepts>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <utility>
+#include <variant>
 #include <vector>
 
 #include <fmt/format.h>
+#include <wpi/Endian.h>
 #include <wpi/Logger.h>
+#include <wpi/SmallVector.h>
 #include <wpi/SpanExtras.h>
 #include <wpi/json.h>
 #include <wpi/mpack.h>
 
 #include "Message.h"
 #include "MessageHandler.h"
+#include "networktables/NetworkTableValue.h"
 
 using namespace nt;
 using namespace nt::net;
 using namespace mpack;
 
-static bool GetNumber(wpi::json& val, double* num) {
-  if (auto v = val.get_ptr<const int64_t*>()) {
-    *num = *v;
-  } else if (auto v = val.get_ptr<const uint64_t*>()) {
-    *num = *v;
-  } else if (auto v = val.get_ptr<const double*>()) {
-    *num = *v;
-  } else {
-    return false;
+static NT_Type DeltaBaseType(int type) {
+  switch (type) {
+    case 80:
+      return NT_BOOLEAN_ARRAY;
+    case 81:
+      return NT_DOUBLE_ARRAY;
+    case 82:
+      return NT_INTEGER_ARRAY;
+    case 83:
+      return NT_FLOAT_ARRAY;
+    default:
+      return NT_UNASSIGNED;
   }
-  return true;
 }
 
-static bool GetNumber(wpi::json& val, int64_t* num) {
-  if (auto v = val.get_ptr<const int64_t*>()) {
-    *num = *v;
-  } else if (auto v = val.get_ptr<const uint64_t*>()) {
-    *num = *v;
-  } else {
-    return false;
+// avoid a fmtlib "unused type alias 'char_type'" warning false positive
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-local-typedef"
+#endif
+
+namespace {
+
+// A scalar value in a JSON message. Strings keep their capacity across
+// messages, so decoding a run of similar messages reuses the same storage.
+struct JsonScalar {
+  enum Type {
+    kMissing,
+    kString,
+    kInteger,
+    kUnsigned,
+    kFloat,
+    kBoolean,
+    kOther
+  };
+
+  void Reset() {
+    type = kMissing;
+    str.clear();
   }
-  return true;
-}
 
-static std::string* ObjGetString(wpi::json::object_t& obj, std::string_view key,
-                                 std::string* error) {
-  auto it = obj.find(key);
-  if (it == obj.end()) {
+  void Set(std::string&& val) {
+    type = kString;
+    str = std::move(val);
+  }
+  void Set(int64_t val) {
+    type = kInteger;
+    i = val;
+  }
+  void Set(uint64_t val) {
+    type = kUnsigned;
+    u = val;
+  }
+  void Set(double val) {
+    type = kFloat;
+    d = val;
+  }
+  void Set(bool val) {
+    type = kBoolean;
+    b = val;
+  }
+  void Set(std::nullptr_t) { type = kOther; }
+
+  bool GetNumber(double* num) const {
+    switch (type) {
+      case kInteger:
+        *num = i;
+        return true;
+      case kUnsigned:
+        *num = u;
+        return true;
+      case kFloat:
+        *num = d;
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  bool GetNumber(int64_t* num) const {
+    switch (type) {
+      case kInteger:
+        *num = i;
+        return true;
+      case kUnsigned:
+        *num = u;
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  Type type = kMissing;
+  std::string str;
+  int64_t i = 0;
+  uint64_t u = 0;
+  double d = 0;
+  bool b = false;
+};
+
+// An object-valued parameter (properties or update), which is kept as JSON
+struct JsonObjectParam {
+  void Reset() {
+    present = false;
+    isObject = false;
+  }
+
+  bool present = false;
+  bool isObject = false;
+  wpi::json value;
+};
+
+// The params object of a message. All recognized keys are captured
+// regardless of method, as "method" may come after "params".
+struct TextParams {
+  void Reset() {
+    for (auto s : {&name, &type, &id, &pubuid, &subuid, &token, &seq, &ack,
+                   &periodic, &all, &topicsOnly, &prefix, &deltas}) {
+      s->Reset();
+    }
+    properties.Reset();
+    update.Reset();
+    hasOptions = false;
+    optionsIsObject = false;
+    hasTopics = false;
+    topicsIsArray = false;
+    topics.clear();
+    badTopic.reset();
+  }
+
+  JsonScalar name;
+  JsonScalar type;
+  JsonScalar id;
+  JsonScalar pubuid;
+  JsonScalar subuid;
+  JsonScalar token;
+  JsonScalar seq;
+  JsonScalar ack;
+  JsonObjectParam properties;
+  JsonObjectParam update;
+
+  // options (subscribe)
+  bool hasOptions = false;
+  bool optionsIsObject = false;
+  JsonScalar periodic;
+  JsonScalar all;
+  JsonScalar topicsOnly;
+  JsonScalar prefix;
+  JsonScalar deltas;
+
+  // topics (subscribe)
+  bool hasTopics = false;
+  bool topicsIsArray = false;
+  std::vector<std::string> topics;
+  std::optional<size_t> badTopic;  // index of first non-string topic
+};
+
+// Builds a JSON value from SAX events
+class JsonBuilder {
+ public:
+  void Start(wpi::json* root) {
+    m_root = root;
+    m_stack.clear();
+  }
+
+  bool Done() const { return m_stack.empty(); }
+
+  void Value(wpi::json&& val) { Add(std::move(val)); }
+  void StartObject() { m_stack.emplace_back(Add(wpi::json::object())); }
+  void StartArray() { m_stack.emplace_back(Add(wpi::json::array())); }
+  void Key(std::string& key) { m_key = std::move(key); }
+  void End() { m_stack.pop_back(); }
+
+ private:
+  // the containers on the stack aren't modified until their last child is
+  // complete, so the pointers stay valid
+  wpi::json* Add(wpi::json&& val) {
+    if (m_stack.empty()) {
+      *m_root = std::move(val);
+      return m_root;
+    }
+    wpi::json* parent = m_stack.back();
+    if (parent->is_array()) {
+      parent->emplace_back(std::move(val));
+      return &parent->back();
+    }
+    auto& slot = (*parent)[m_key];
+    slot = std::move(val);
+    return &slot;
+  }
+
+  wpi::json* m_root = nullptr;
+  wpi::SmallVector<wpi::json*, 8> m_stack;
+  std::string m_key;
+};
+
+std::string* ParamGetString(JsonScalar& param, std::string_view key,
+                                   std::string* error) {
+  if (param.type == JsonScalar::kMissing) {
     *error = fmt::format("no {} key", key);
     return nullptr;
   }
-  auto val = it->second.get_ptr<std::string*>();
-  if (!val) {
+  if (param.type != JsonScalar::kString) {
     *error = fmt::format("{} must be a string", key);
+    return nullptr;
   }
-  return val;
+  return &param.str;
 }
 
-static bool ObjGetNumber(wpi::json::object_t& obj, std::string_view key,
-                         std::string* error, int64_t* num) {
-  auto it = obj.find(key);
-  if (it == obj.end()) {
+bool ParamGetNumber(const JsonScalar& param, std::string_view key,
+                           std::string* error, int64_t* num) {
+  if (param.type == JsonScalar::kMissing) {
     *error = fmt::format("no {} key", key);
     return false;
   }
-  if (!GetNumber(it->second, num)) {
+  if (!param.GetNumber(num)) {
     *error = fmt::format("{} must be a number", key);
     return false;
   }
   return true;
 }
 
-static bool ObjGetStringArray(wpi::json::object_t& obj, std::string_view key,
-                              std::string* error,
-                              std::vector<std::string>* out) {
-  // prefixes
-  auto it = obj.find(key);
-  if (it == obj.end()) {
-    *error = fmt::format("no {} key", key);
-    return false;
+bool OptionGetBool(const JsonScalar& option, std::string_view key,
+                          std::string* error, bool* out) {
+  if (option.type == JsonScalar::kMissing) {
+    return true;
   }
-  auto jarr = it->second.get_ptr<wpi::json::array_t*>();
-  if (!jarr) {
-    *error = fmt::format("{} must be an array", key);
+  if (option.type != JsonScalar::kBoolean) {
+    *error = fmt::format("{} value must be a boolean", key);
     return false;
   }
-  out->resize(0);
-  out->reserve(jarr->size());
-  for (auto&& jval : *jarr) {
-    auto str = jval.get_ptr<std::string*>();
-    if (!str) {
-      *error = fmt::format("{}/{} must be a string", key, out->size());
-      return false;
-    }
-    out->emplace_back(std::move(*str));
-  }
+  *out = option.b;
   return true;
 }
 
-// avoid a fmtlib "unused type alias 'char_type'" warning false positive
-#ifdef __clang__
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wunused-local-typedef"
-#endif
-
+// Decodes a JSON text frame (an array of messages) directly into message
+// structs with wpi::json's SAX interface, without building a DOM for
+// anything but property objects. Messages and errors are collected and only
+// handled once the whole frame has parsed successfully.
 template <typename T>
-  requires(std::same_as<T, ClientMessageHandler> ||
-           std::same_as<T, ServerMessageHandler>)
-static bool WireDecodeTextImpl(std::string_view in, T& out,
-                               wpi::Logger& logger) {
-  wpi::json j;
-  try {
-    j = wpi::json::parse(in);
-  } catch (wpi::json::parse_error& err) {
-    WPI_WARNING(logger, "could not decode JSON message: {}", err.what());
-    return false;
-  }
+class TextDecoder {
+  static_assert(std::same_as<T, ClientMessageHandler> ||
+                std::same_as<T, ServerMessageHandler>);
 
-  if (!j.is_array()) {
-    WPI_WARNING(logger, "expected JSON array at top level");
-    return false;
-  }
+ public:
+  using Contents =
+      typename std::conditional_t<std::same_as<T, ClientMessageHandler>,
+                                  ClientMessage, ServerMessage>::Contents;
 
-  bool rv = false;
-  int i = -1;
-  for (auto&& jmsg : j) {
-    ++i;
-    std::string error;
-    {
-      auto obj = jmsg.get_ptr<wpi::json::object_t*>();
-      if (!obj) {
-        error = "expected message to be an object";
-        goto err;
-      }
-
-      auto method = ObjGetString(*obj, "method", &error);
-      if (!method) {
-        goto err;
-      }
-
-      auto paramsIt = obj->find("params");
-      if (paramsIt == obj->end()) {
-        error = "no params key";
-        goto err;
-      }
-      auto params = paramsIt->second.get_ptr<wpi::json::object_t*>();
-      if (!params) {
-        error = "params must be an object";
-        goto err;
-      }
-
-      if constexpr (std::same_as<T, ClientMessageHandler>) {
-        if (*method == PublishMsg::kMethodStr) {
-          // name
-          auto name = ObjGetString(*params, "name", &error);
-          if (!name) {
-            goto err;
-          }
-
-          // type
-          auto typeStr = ObjGetString(*params, "type", &error);
-          if (!typeStr) {
-            goto err;
-          }
+  struct Decoded {
+    int index;
+    std::string warning{};  // logged as-is before handling
+    std::string error{};    // message is skipped if not empty
+    Contents contents{};
+  };
 
-          // pubuid
-          int64_t pubuid;
-          if (!ObjGetNumber(*params, "pubuid", &error, &pubuid)) {
-            goto err;
-          }
+  bool Decode(std::string_view in, T& out, wpi::Logger& logger);
 
-          // properties; allow missing (treated as empty)
-          wpi::json* properties = nullptr;
-          auto propertiesIt = params->find("properties");
-          if (propertiesIt != params->end()) {
-            properties = &propertiesIt->second;
-            if (!properties->is_object()) {
-              error = "properties must be an object";
-              goto err;
-            }
-          }
-          wpi::json propertiesEmpty;
-          if (!properties) {
-            propertiesEmpty = wpi::json::object();
-            properties = &propertiesEmpty;
-          }
+  // wpi::json SAX interface
+  bool null() { return Scalar(nullptr); }
+  bool boolean(bool val) { return Scalar(val); }
+  bool number_integer(int64_t val) { return Scalar(val); }
+  bool number_unsigned(uint64_t val) { return Scalar(val); }
+  bool number_float(double val, const std::string&) { return Scalar(val); }
+  bool string(std::string& val) { return Scalar(std::move(val)); }
+  bool binary(wpi::json::binary_t&) { return Scalar(nullptr); }
+  bool start_object(size_t) { return StartContainer(true); }
+  bool end_object() { return EndContainer(); }
+  bool start_array(size_t) { return StartContainer(false); }
+  bool end_array() { return EndContainer(); }
+  bool key(std::string& key);
+  bool parse_error(size_t, const std::string&,
+                   const wpi::json::exception& ex) {
+    m_parseError = ex.what();
+    return false;
+  }
 
-          // complete
-          out.ClientPublish(pubuid, *name, *typeStr, *properties, {});
-          rv = true;
-        } else if (*method == UnpublishMsg::kMethodStr) {
-          // pubuid
-          int64_t pubuid;
-          if (!ObjGetNumber(*params, "pubuid", &error, &pubuid)) {
-            goto err;
-          }
+ private:
+  enum State { kTop, kMessages, kMessage, kParams, kOptions, kTopics };
 
-          // complete
-          out.ClientUnpublish(pubuid);
-          rv = true;
-        } else if (*method == SetPropertiesMsg::kMethodStr) {
-          // name
-          auto name = ObjGetString(*params, "name", &error);
-          if (!name) {
-            goto err;
-          }
+  static constexpr const char* kNotObject =
+      "expected message to be an object";
 
-          // update
-          auto updateIt = params->find("update");
-          if (updateIt == params->end()) {
-            error = "no update key";
-            goto err;
-          }
-          auto update = &updateIt->second;
-          if (!update->is_object()) {
-            error = "update must be an object";
-            goto err;
-          }
+  template <typename V>
+  bool Scalar(V&& val);
+  bool StartContainer(bool isObject);
+  bool EndContainer();
+  JsonScalar* ParamScalar();
+  JsonScalar* OptionScalar();
+  void FinishMessage();
+  void Handle(Decoded& msg, T& out, wpi::Logger& logger, bool* rv);
 
-          // complete
-          out.ClientSetProperties(*name, *update);
-        } else if (*method == SubscribeMsg::kMethodStr) {
-          // subuid
-          int64_t subuid;
-          if (!ObjGetNumber(*params, "subuid", &error, &subuid)) {
-            goto err;
-          }
+  State m_state = kTop;
+  int m_skipDepth = 0;
+  bool m_building = false;
+  JsonBuilder m_builder;
+  bool m_notArray = false;
+  std::string m_parseError;
 
-          // options
-          PubSubOptionsImpl options;
-          auto optionsIt = params->find("options");
-          if (optionsIt != params->end()) {
-            auto joptions = optionsIt->second.get_ptr<wpi::json::object_t*>();
-            if (!joptions) {
-              error = "options must be an object";
-              goto err;
-            }
-
-            // periodic
-            auto periodicIt = joptions->find("periodic");
-            if (periodicIt != joptions->end()) {
-              double val;
-              if (!GetNumber(periodicIt->second, &val)) {
-                error = "periodic value must be a number";
-                goto err;
-              }
-              options.periodic = val;
-              options.periodicMs = val * 1000;
-            }
-
-            // send all changes
-            auto sendAllIt = joptions->find("all");
-            if (sendAllIt != joptions->end()) {
-              auto sendAll = sendAllIt->second.get_ptr<bool*>();
-              if (!sendAll) {
-                error = "all value must be a boolean";
-                goto err;
-              }
-              options.sendAll = *sendAll;
-            }
-
-            // topics only
-            auto topicsOnlyIt = joptions->find("topicsonly");
-            if (topicsOnlyIt != joptions->end()) {
-              auto topicsOnly = topicsOnlyIt->second.get_ptr<bool*>();
-              if (!topicsOnly) {
-                error = "topicsonly value must be a boolean";
-                goto err;
-              }
-              options.topicsOnly = *topicsOnly;
-            }
-
-            // prefix match
-            auto prefixMatchIt = joptions->find("prefix");
-            if (prefixMatchIt != joptions->end()) {
-              auto prefixMatch = prefixMatchIt->second.get_ptr<bool*>();
-              if (!prefixMatch) {
-                error = "prefix value must be a boolean";
-                goto err;
-              }
-              options.prefixMatch = *prefixMatch;
-            }
-          }
+  // current message
+  int m_index = -1;
+  std::string m_key;
+  JsonScalar m_method;
+  bool m_hasParams = false;
+  bool m_paramsIsObject = false;
+  TextParams m_params;
 
-          // topic names
-          std::vector<std::string> topicNames;
-          if (!ObjGetStringArray(*params, "topics", &error, &topicNames)) {
-            goto err;
-          }
+  std::vector<Decoded> m_decoded;
+};
 
-          // complete
-          out.ClientSubscribe(subuid, topicNames, options);
-          rv = true;
-        } else if (*method == UnsubscribeMsg::kMethodStr) {
-          // subuid
-          int64_t subuid;
-          if (!ObjGetNumber(*params, "subuid", &error, &subuid)) {
-            goto err;
-          }
+template <typename T>
+template <typename V>
+bool TextDecoder<T>::Scalar(V&& val) {
+  if (m_building) {
+    m_builder.Value(wpi::json(std::forward<V>(val)));
+    m_building = !m_builder.Done();
+    return true;
+  }
+  if (m_skipDepth > 0) {
+    return true;
+  }
+  switch (m_state) {
+    case kTop:
+      m_notArray = true;
+      break;
+    case kMessages:
+      ++m_index;
+      m_decoded.emplace_back(Decoded{.index = m_index, .error = kNotObject});
+      break;
+    case kMessage:
+      if (m_key == "method") {
+        m_method.Set(std::forward<V>(val));
+      } else if (m_key == "params") {
+        m_hasParams = true;
+        m_paramsIsObject = false;
+      }
+      break;
+    case kParams:
+      if (auto param = ParamScalar()) {
+        param->Set(std::forward<V>(val));
+      } else if (m_key == "properties" || m_key == "update") {
+        auto& param = m_key == "update" ? m_params.update : m_params.properties;
+        param.present = true;
+        param.isObject = false;
+      } else if (m_key == "options") {
+        m_params.hasOptions = true;
+        m_params.optionsIsObject = false;
+      } else if (m_key == "topics") {
+        m_params.hasTopics = true;
+        m_params.topicsIsArray = false;
+      }
+      break;
+    case kOptions:
+      if (auto option = OptionScalar()) {
+        option->Set(std::forward<V>(val));
+      }
+      break;
+    case kTopics:
+      if constexpr (std::same_as<std::remove_cvref_t<V>, std::string>) {
+        m_params.topics.emplace_back(std::move(val));
+      } else if (!m_params.badTopic) {
+        m_params.badTopic = m_params.topics.size();
+      }
+      break;
+  }
+  return true;
+}
 
-          // complete
-          out.ClientUnsubscribe(subuid);
-          rv = true;
+template <typename T>
+bool TextDecoder<T>::StartContainer(bool isObject) {
+  if (m_building) {
+    if (isObject) {
+      m_builder.StartObject();
+    } else {
+      m_builder.StartArray();
+    }
+    return true;
+  }
+  if (m_skipDepth > 0) {
+    ++m_skipDepth;
+    return true;
+  }
+  bool skip = false;
+  switch (m_state) {
+    case kTop:
+      if (isObject) {
+        m_notArray = true;
+        skip = true;
+      } else {
+        m_state = kMessages;
+      }
+      break;
+    case kMessages:
+      ++m_index;
+      if (isObject) {
+        m_method.Reset();
+        m_hasParams = false;
+        m_paramsIsObject = false;
+        m_params.Reset();
+        m_state = kMessage;
+      } else {
+        m_decoded.emplace_back(Decoded{.index = m_index, .error = kNotObject});
+        skip = true;
+      }
+      break;
+    case kMessage:
+      if (m_key == "params") {
+        m_hasParams = true;
+        m_paramsIsObject = isObject;
+        if (isObject) {
+          m_params.Reset();
+          m_state = kParams;
+          break;
+        }
+      } else if (m_key == "method") {
+        m_method.Set(nullptr);
+      }
+      skip = true;
+      break;
+    case kParams:
+      if (auto param = ParamScalar()) {
+        param->Set(nullptr);
+        skip = true;
+      } else if (m_key == "properties" || m_key == "update") {
+        auto& param = m_key == "update" ? m_params.update : m_params.properties;
+        param.present = true;
+        param.isObject = isObject;
+        if (isObject) {
+          m_builder.Start(&param.value);
+          m_builder.StartObject();
+          m_building = true;
         } else {
-          error = fmt::format("unrecognized method '{}'", *method);
-          goto err;
+          skip = true;
         }
-      } else if constexpr (std::same_as<T, ServerMessageHandler>) {
-        if (*method == AnnounceMsg::kMethodStr) {
-          // name
-          auto name = ObjGetString(*params, "name", &error);
-          if (!name) {
-            goto err;
-          }
-
-          // id
-          int64_t id;
-          if (!ObjGetNumber(*params, "id", &error, &id)) {
-            goto err;
-          }
+      } else if (m_key == "options") {
+        m_params.hasOptions = true;
+        m_params.optionsIsObject = isObject;
+        if (isObject) {
+          m_state = kOptions;
+        } else {
+          skip = true;
+        }
+      } else if (m_key == "topics") {
+        m_params.hasTopics = true;
+        m_params.topicsIsArray = !isObject;
+        m_params.topics.clear();
+        m_params.badTopic.reset();
+        if (!isObject) {
+          m_state = kTopics;
+        } else {
+          skip = true;
+        }
+      } else {
+        skip = true;
+      }
+      break;
+    case kOptions:
+      if (auto option = OptionScalar()) {
+        option->Set(nullptr);
+      }
+      skip = true;
+      break;
+    case kTopics:
+      if (!m_params.badTopic) {
+        m_params.badTopic = m_params.topics.size();
+      }
+      skip = true;
+      break;
+  }
+  if (skip) {
+    m_skipDepth = 1;
+  }
+  return true;
+}
 
-          // type
-          auto typeStr = ObjGetString(*params, "type", &error);
-          if (!typeStr) {
-            goto err;
-          }
+template <typename T>
+bool TextDecoder<T>::EndContainer() {
+  if (m_building) {
+    m_builder.End();
+    m_building = !m_builder.Done();
+    return true;
+  }
+  if (m_skipDepth > 0) {
+    --m_skipDepth;
+    return true;
+  }
+  switch (m_state) {
+    case kMessages:
+      m_state = kTop;
+      break;
+    case kMessage:
+      FinishMessage();
+      m_state = kMessages;
+      break;
+    case kParams:
+      m_state = kMessage;
+      break;
+    case kOptions:
+    case kTopics:
+      m_state = kParams;
+      break;
+    default:
+      break;
+  }
+  return true;
+}
 
-          // pubuid
-          std::optional<int64_t> pubuid;
-          auto pubuidIt = params->find("pubuid");
-          if (pubuidIt != params->end()) {
-            int64_t val;
-            if (!GetNumber(pubuidIt->second, &val)) {
-              error = "pubuid value must be a number";
-              goto err;
-            }
-            pubuid = val;
-          }
+template <typename T>
+bool TextDecoder<T>::key(std::string& key) {
+  if (m_building) {
+    m_builder.Key(key);
+  } else if (m_skipDepth == 0) {
+    m_key = std::move(key);
+  }
+  return true;
+}
 
-          // properties
-          auto propertiesIt = params->find("properties");
-          if (propertiesIt == params->end()) {
-            error = "no properties key";
-            goto err;
-          }
-          auto properties = &propertiesIt->second;
-          if (!properties->is_object()) {
-            WPI_WARNING(logger, "{}: properties is not an object", *name);
-            *properties = wpi::json::object();
-          }
+template <typename T>
+JsonScalar* TextDecoder<T>::ParamScalar() {
+  auto& p = m_params;
+  for (auto [key, param] : {std::pair{"name", &p.name},
+                            {"type", &p.type},
+                            {"id", &p.id},
+                            {"pubuid", &p.pubuid},
+                            {"subuid", &p.subuid},
+                            {"token", &p.token},
+                            {"seq", &p.seq},
+                            {"ack", &p.ack}}) {
+    if (m_key == key) {
+      return param;
+    }
+  }
+  return nullptr;
+}
 
-          // complete
-          out.ServerAnnounce(*name, id, *typeStr, *properties, pubuid);
-        } else if (*method == UnannounceMsg::kMethodStr) {
-          // name
-          auto name = ObjGetString(*params, "name", &error);
-          if (!name) {
-            goto err;
-          }
+template <typename T>
+JsonScalar* TextDecoder<T>::OptionScalar() {
+  auto& p = m_params;
+  for (auto [key, option] : {std::pair{"periodic", &p.periodic},
+                             {"all", &p.all},
+                             {"topicsonly", &p.topicsOnly},
+                             {"prefix", &p.prefix},
+                             {"deltas", &p.deltas}}) {
+    if (m_key == key) {
+      return option;
+    }
+  }
+  return nullptr;
+}
 
-          // id
-          int64_t id;
-          if (!ObjGetNumber(*params, "id", &error, &id)) {
-            goto err;
-          }
+template <typename T>
+void TextDecoder<T>::FinishMessage() {
+  auto& msg = m_decoded.emplace_back(Decoded{.index = m_index});
+  auto& p = m_params;
+  std::string* error = &msg.error;
 
-          // complete
-          out.ServerUnannounce(*name, id);
-        } else if (*method == PropertiesUpdateMsg::kMethodStr) {
-          // name
-          auto name = ObjGetString(*params, "name", &error);
-          if (!name) {
-            goto err;
-          }
+  auto method = ParamGetString(m_method, "method", error);
+  if (!method) {
+    return;
+  }
+  if (!m_hasParams) {
+    *error = "no params key";
+    return;
+  }
+  if (!m_paramsIsObject) {
+    *error = "params must be an object";
+    return;
+  }
 
-          // update
-          auto updateIt = params->find("update");
-          if (updateIt == params->end()) {
-            error = "no update key";
-            goto err;
-          }
-          auto update = &updateIt->second;
-          if (!update->is_object()) {
-            error = "update must be an object";
-            goto err;
-          }
+  if constexpr (std::same_as<T, ClientMessageHandler>) {
+    if (*method == PublishMsg::kMethodStr) {
+      auto name = ParamGetString(p.name, "name", error);
+      if (!name) {
+        return;
+      }
+      auto typeStr = ParamGetString(p.type, "type", error);
+      if (!typeStr) {
+        return;
+      }
+      int64_t pubuid;
+      if (!ParamGetNumber(p.pubuid, "pubuid", error, &pubuid)) {
+        return;
+      }
+      // properties; allow missing (treated as empty)
+      if (p.properties.present && !p.properties.isObject) {
+        *error = "properties must be an object";
+        return;
+      }
+      msg.contents = PublishMsg{
+          .pubuid = static_cast<int>(pubuid),
+          .name = std::move(*name),
+          .typeStr = std::move(*typeStr),
+          .properties = p.properties.present ? std::move(p.properties.value)
+                                             : wpi::json::object(),
+          .options = {}};
+    } else if (*method == UnpublishMsg::kMethodStr) {
+      int64_t pubuid;
+      if (!ParamGetNumber(p.pubuid, "pubuid", error, &pubuid)) {
+        return;
+      }
+      msg.contents = UnpublishMsg{static_cast<int>(pubuid)};
+    } else if (*method == SetPropertiesMsg::kMethodStr) {
+      auto name = ParamGetString(p.name, "name", error);
+      if (!name) {
+        return;
+      }
+      if (!p.update.present) {
+        *error = "no update key";
+        return;
+      }
+      if (!p.update.isObject) {
+        *error = "update must be an object";
+        return;
+      }
+      msg.contents =
+          SetPropertiesMsg{std::move(*name), std::move(p.update.value)};
+    } else if (*method == SubscribeMsg::kMethodStr) {
+      int64_t subuid;
+      if (!ParamGetNumber(p.subuid, "subuid", error, &subuid)) {
+        return;
+      }
 
-          bool ack = false;
-          auto ackIt = params->find("ack");
-          if (ackIt != params->end()) {
-            auto val = ackIt->second.get_ptr<bool*>();
-            if (!val) {
-              error = "ack must be a boolean";
-              goto err;
-            }
-            ack = *val;
+      PubSubOptionsImpl options;
+      if (p.hasOptions) {
+        if (!p.optionsIsObject) {
+          *error = "options must be an object";
+          return;
+        }
+        if (p.periodic.type != JsonScalar::kMissing) {
+          double val;
+          if (!p.periodic.GetNumber(&val)) {
+            *error = "periodic value must be a number";
+            return;
           }
+          options.periodic = val;
+          options.periodicMs = val * 1000;
+        }
+        if (!OptionGetBool(p.all, "all", error, &options.sendAll) ||
+            !OptionGetBool(p.topicsOnly, "topicsonly", error,
+                           &options.topicsOnly) ||
+            !OptionGetBool(p.prefix, "prefix", error, &options.prefixMatch) ||
+            !OptionGetBool(p.deltas, "deltas", error, &options.deltaArrays)) {
+          return;
+        }
+      }
 
-          // complete
-          out.ServerPropertiesUpdate(*name, *update, ack);
-        } else {
-          error = fmt::format("unrecognized method '{}'", *method);
-          goto err;
+      if (!p.hasTopics) {
+        *error = "no topics key";
+        return;
+      }
+      if (!p.topicsIsArray) {
+        *error = "topics must be an array";
+        return;
+      }
+      if (p.badTopic) {
+        *error = fmt::format("topics/{} must be a string", *p.badTopic);
+        return;
+      }
+      msg.contents = SubscribeMsg{static_cast<int>(subuid),
+                                  std::move(p.topics), options};
+    } else if (*method == UnsubscribeMsg::kMethodStr) {
+      int64_t subuid;
+      if (!ParamGetNumber(p.subuid, "subuid", error, &subuid)) {
+        return;
+      }
+      msg.contents = UnsubscribeMsg{static_cast<int>(subuid)};
+    } else if (*method == ResumeMsg::kMethodStr) {
+      auto token = ParamGetString(p.token, "token", error);
+      if (!token) {
+        return;
+      }
+      int64_t seq;
+      if (!ParamGetNumber(p.seq, "seq", error, &seq)) {
+        return;
+      }
+      msg.contents = ResumeMsg{std::move(*token), seq};
+    } else {
+      *error = fmt::format("unrecognized method '{}'", *method);
+    }
+  } else if constexpr (std::same_as<T, ServerMessageHandler>) {
+    if (*method == AnnounceMsg::kMethodStr) {
+      auto name = ParamGetString(p.name, "name", error);
+      if (!name) {
+        return;
+      }
+      int64_t id;
+      if (!ParamGetNumber(p.id, "id", error, &id)) {
+        return;
+      }
+      auto typeStr = ParamGetString(p.type, "type", error);
+      if (!typeStr) {
+        return;
+      }
+      std::optional<int> pubuid;
+      if (p.pubuid.type != JsonScalar::kMissing) {
+        int64_t val;
+        if (!p.pubuid.GetNumber(&val)) {
+          *error = "pubuid value must be a number";
+          return;
         }
+        pubuid = val;
+      }
+      if (!p.properties.present) {
+        *error = "no properties key";
+        return;
+      }
+      if (!p.properties.isObject) {
+        msg.warning = fmt::format("{}: properties is not an object", *name);
+        p.properties.value = wpi::json::object();
+      }
+      msg.contents = AnnounceMsg{std::move(*name), static_cast<int>(id),
+                                 std::move(*typeStr), pubuid,
+                                 std::move(p.properties.value)};
+    } else if (*method == UnannounceMsg::kMethodStr) {
+      auto name = ParamGetString(p.name, "name", error);
+      if (!name) {
+        return;
+      }
+      int64_t id;
+      if (!ParamGetNumber(p.id, "id", error, &id)) {
+        return;
       }
-      continue;
+      msg.contents = UnannounceMsg{std::move(*name), static_cast<int>(id)};
+    } else if (*method == PropertiesUpdateMsg::kMethodStr) {
+      auto name = ParamGetString(p.name, "name", error);
+      if (!name) {
+        return;
+      }
+      if (!p.update.present) {
+        *error = "no update key";
+        return;
+      }
+      if (!p.update.isObject) {
+        *error = "update must be an object";
+        return;
+      }
+      bool ack = false;
+      if (p.ack.type != JsonScalar::kMissing) {
+        if (p.ack.type != JsonScalar::kBoolean) {
+          *error = "ack must be a boolean";
+          return;
+        }
+        ack = p.ack.b;
+      }
+      msg.contents = PropertiesUpdateMsg{std::move(*name),
+                                         std::move(p.update.value), ack};
+    } else if (*method == CheckpointMsg::kMethodStr) {
+      auto token = ParamGetString(p.token, "token", error);
+      if (!token) {
+        return;
+      }
+      int64_t seq;
+      if (!ParamGetNumber(p.seq, "seq", error, &seq)) {
+        return;
+      }
+      msg.contents = CheckpointMsg{std::move(*token), seq};
+    } else {
+      *error = fmt::format("unrecognized method '{}'", *method);
     }
-  err:
-    WPI_WARNING(logger, "{}: {}", i, error);
+  }
+}
+
+template <typename T>
+void TextDecoder<T>::Handle(Decoded& msg, T& out, wpi::Logger& logger,
+                            bool* rv) {
+  if (!msg.warning.empty()) {
+    WPI_WARNING(logger, "{}", msg.warning);
+  }
+  if (!msg.error.empty()) {
+    WPI_WARNING(logger, "{}: {}", msg.index, msg.error);
+    return;
+  }
+  std::visit(
+      [&](auto& m) {
+        using M = std::remove_cvref_t<decltype(m)>;
+        if constexpr (std::same_as<M, PublishMsg>) {
+          out.ClientPublish(m.pubuid, m.name, m.typeStr, m.properties, {});
+          *rv = true;
+        } else if constexpr (std::same_as<M, UnpublishMsg>) {
+          out.ClientUnpublish(m.pubuid);
+          *rv = true;
+        } else if constexpr (std::same_as<M, SetPropertiesMsg>) {
+          out.ClientSetProperties(m.name, m.update);
+        } else if constexpr (std::same_as<M, SubscribeMsg>) {
+          out.ClientSubscribe(m.subuid, m.topicNames, m.options);
+          *rv = true;
+        } else if constexpr (std::same_as<M, UnsubscribeMsg>) {
+          out.ClientUnsubscribe(m.subuid);
+          *rv = true;
+        } else if constexpr (std::same_as<M, ResumeMsg>) {
+          out.ClientResume(m.token, m.seq);
+        } else if constexpr (std::same_as<M, AnnounceMsg>) {
+          out.ServerAnnounce(m.name, m.id, m.typeStr, m.properties, m.pubuid);
+        } else if constexpr (std::same_as<M, UnannounceMsg>) {
+          out.ServerUnannounce(m.name, m.id);
+        } else if constexpr (std::same_as<M, PropertiesUpdateMsg>) {
+          out.ServerPropertiesUpdate(m.name, m.update, m.ack);
+        } else if constexpr (std::same_as<M, CheckpointMsg>) {
+          out.ServerCheckpoint(m.token, m.seq);
+        }
+      },
+      msg.contents);
+}
+
+template <typename T>
+bool TextDecoder<T>::Decode(std::string_view in, T& out,
+                            wpi::Logger& logger) {
+  if (!wpi::json::sax_parse(in, this)) {
+    WPI_WARNING(logger, "could not decode JSON message: {}", m_parseError);
+    return false;
+  }
+  if (m_notArray) {
+    WPI_WARNING(logger, "expected JSON array at top level");
+    return false;
   }
 
+  bool rv = false;
+  for (auto&& msg : m_decoded) {
+    Handle(msg, out, logger, &rv);
+  }
   return rv;
 }
 
-#ifdef __clang__
-#pragma clang diagnostic pop
-#endif
+}  // namespace
 
 bool nt::net::WireDecodeText(std::string_view in, ClientMessageHandler& out,
                              wpi::Logger& logger) {
-  return ::WireDecodeTextImpl(in, out, logger);
+  return TextDecoder<ClientMessageHandler>{}.Decode(in, out, logger);
 }
 
 void nt::net::WireDecodeText(std::string_view in, ServerMessageHandler& out,
                              wpi::Logger& logger) {
-  ::WireDecodeTextImpl(in, out, logger);
+  TextDecoder<ServerMessageHandler>{}.Decode(in, out, logger);
+}
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+
+template <typename T, typename F>
+static void ReadArrayDelta(mpack_reader_t* reader, std::span<const T> base,
+                           std::vector<T>* arr, F&& readElem) {
+  // [size, index, value, index, value, ...]
+  auto count = mpack_expect_array(reader);
+  if (mpack_reader_error(reader) != mpack_ok) {
+    return;
+  }
+  uint32_t size = mpack_expect_u32(reader);
+  uint32_t numChanges = count / 2;
+  if ((count % 2) != 1 || size > base.size() + numChanges) {
+    mpack_reader_flag_error(reader, mpack_error_data);
+    return;
+  }
+  size_t numKept = (std::min)(static_cast<size_t>(size), base.size());
+  arr->assign(base.begin(), base.begin() + numKept);
+  arr->resize(size);
+  // every element past the end of base must be given by the delta
+  std::vector<bool> added(size > base.size() ? size - base.size() : 0);
+  size_t numAdded = 0;
+  for (uint32_t i = 0; i < numChanges; ++i) {
+    uint32_t index = mpack_expect_u32(reader);
+    if (mpack_reader_error(reader) == mpack_ok && index >= size) {
+      mpack_reader_flag_error(reader, mpack_error_data);
+    }
+    if (mpack_reader_error(reader) != mpack_ok) {
+      return;
+    }
+    (*arr)[index] = readElem(reader);
+    if (index >= base.size() && !added[index - base.size()]) {
+      added[index - base.size()] = true;
+      ++numAdded;
+    }
+  }
+  if (numAdded != added.size()) {
+    mpack_reader_flag_error(reader, mpack_error_data);
+    return;
+  }
+  mpack_done_array(reader);
 }
 
 bool nt::net::WireDecodeBinary(std::span<const uint8_t>* in, int* outId,
                                Value* outValue, std::string* error,
                                int64_t localTimeOffset) {
+  return WireDecodeBinary(in, outId, outValue, error, localTimeOffset,
+                          [](int) -> const Value* { return nullptr; });
+}
+
+bool nt::net::WireDecodeBinary(
+    std::span<const uint8_t>* in, int* outId, Value* outValue,
+    std::string* error, int64_t localTimeOffset,
+    wpi::function_ref<const Value*(int id)> getDeltaBase) {
   mpack_reader_t reader;
   mpack_reader_init_data(&reader, reinterpret_cast<const char*>(in->data()),
                          in->size());
@@ -557,6 +1046,56 @@ bool nt::net::WireDecodeBinary(std::span<const uint8_t>* in, int* outId,
       mpack_done_array(&reader);
       break;
     }
+    case 80:    // boolean array delta
+    case 81:    // double array delta
+    case 82:    // integer array delta
+    case 83: {  // float array delta
+      const Value* base = getDeltaBase(*outId);
+      if (!base || base->type() != DeltaBaseType(type)) {
+        *error = fmt::format("delta for id {} without matching base value",
+                             *outId);
+        return false;
+      }
+      switch (type) {
+        case 80: {
+          std::vector<int> arr;
+          ReadArrayDelta(&reader, base->GetBooleanArray(), &arr,
+                         [](mpack_reader_t* r) -> int {
+                           return mpack_expect_bool(r);
+                         });
+          *outValue = Value::MakeBooleanArray(std::move(arr), 1);
+          break;
+        }
+        case 81: {
+          std::vector<double> arr;
+          ReadArrayDelta(&reader, base->GetDoubleArray(), &arr,
+                         [](mpack_reader_t* r) {
+                           return mpack_expect_double(r);
+                         });
+          *outValue = Value::MakeDoubleArray(std::move(arr), 1);
+          break;
+        }
+        case 82: {
+          std::vector<int64_t> arr;
+          ReadArrayDelta(&reader, base->GetIntegerArray(), &arr,
+                         [](mpack_reader_t* r) {
+                           return mpack_expect_i64(r);
+                         });
+          *outValue = Value::MakeIntegerArray(std::move(arr), 1);
+          break;
+        }
+        case 83: {
+          std::vector<float> arr;
+          ReadArrayDelta(&reader, base->GetFloatArray(), &arr,
+                         [](mpack_reader_t* r) {
+                           return mpack_expect_float(r);
+                         });
+          *outValue = Value::MakeFloatArray(std::move(arr), 1);
+          break;
+        }
+      }
+      break;
+    }
     default:
       *error = fmt::format("unrecognized type {}", type);
       return false;
@@ -574,3 +1113,115 @@ bool nt::net::WireDecodeBinary(std::span<const uint8_t>* in, int* outId,
   *in = wpi::take_back(*in, mpack_reader_remaining(&reader, nullptr));
   return true;
 }
+
+bool nt::net::WireDecodeBinaryBatch(
+    std::span<const uint8_t>* in, bool* isBatch,
+    wpi::function_ref<void(int id, Value& value)> out, std::string* error,
+    int64_t localTimeOffset) {
+  mpack_reader_t reader;
+  mpack_reader_init_data(&reader, reinterpret_cast<const char*>(in->data()),
+                         in->size());
+  mpack_expect_array_match(&reader, 4);
+  if (mpack_reader_error(&reader) != mpack_ok ||
+      mpack_expect_int(&reader) != -2) {
+    // not a batch; let WireDecodeBinary() handle it
+    *isBatch = false;
+    return true;
+  }
+  *isBatch = true;
+
+  // [-2, base time, 96, [[ids], [time offsets], [types], bin values]]
+  auto baseTime = mpack_expect_i64(&reader);
+  int type = mpack_expect_int(&reader);
+  if (mpack_reader_error(&reader) == mpack_ok && type != 96) {
+    *error = fmt::format("unrecognized batch type {}", type);
+    return false;
+  }
+  mpack_expect_array_match(&reader, 4);
+
+  uint32_t count = mpack_expect_array_max(&reader, 65535);
+  wpi::SmallVector<int, 64> ids;
+  ids.reserve(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    ids.emplace_back(mpack_expect_int(&reader));
+  }
+  mpack_done_array(&reader);
+
+  mpack_expect_array_match(&reader, count);
+  wpi::SmallVector<int64_t, 64> times;
+  times.reserve(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    times.emplace_back(baseTime + mpack_expect_i64(&reader));
+  }
+  mpack_done_array(&reader);
+
+  mpack_expect_array_match(&reader, count);
+  wpi::SmallVector<uint8_t, 64> types;
+  types.reserve(count);
+  uint32_t size = 0;
+  for (uint32_t i = 0; i < count; ++i) {
+    uint8_t t = mpack_expect_u8(&reader);
+    switch (t) {
+      case 0:  // boolean
+        size += 1;
+        break;
+      case 1:  // double
+      case 2:  // integer
+        size += 8;
+        break;
+      case 3:  // float
+        size += 4;
+        break;
+      default:
+        mpack_reader_flag_error(&reader, mpack_error_data);
+        break;
+    }
+    types.emplace_back(t);
+  }
+  mpack_done_array(&reader);
+
+  mpack_expect_bin_size(&reader, size);
+  auto data = reinterpret_cast<const uint8_t*>(
+      mpack_read_bytes_inplace(&reader, size));
+  mpack_done_bin(&reader);
+
+  mpack_done_array(&reader);
+  mpack_done_array(&reader);
+  auto err = mpack_reader_destroy(&reader);
+  if (err != mpack_ok) {
+    *error = mpack_error_to_string(err);
+    return false;
+  }
+
+  for (uint32_t i = 0; i < count; ++i) {
+    Value value;
+    switch (types[i]) {
+      case 0:
+        value = Value::MakeBoolean(*data != 0, 1);
+        data += 1;
+        break;
+      case 1:
+        value = Value::MakeDouble(
+            std::bit_cast<double>(wpi::support::endian::read64le(data)), 1);
+        data += 8;
+        break;
+      case 2:
+        value = Value::MakeInteger(
+            static_cast<int64_t>(wpi::support::endian::read64le(data)), 1);
+        data += 8;
+        break;
+      case 3:
+        value = Value::MakeFloat(
+            std::bit_cast<float>(wpi::support::endian::read32le(data)), 1);
+        data += 4;
+        break;
+    }
+    value.SetServerTime(times[i]);
+    value.SetTime(times[i] == 0 ? 0 : times[i] + localTimeOffset);
+    out(ids[i], value);
+  }
+
+  // update input range
+  *in = wpi::take_back(*in, mpack_reader_remaining(&reader, nullptr));
+  return true;
+}
@@ -10,6 +10,8 @@
 #include <string>
 #include <string_view>
 
+#include <wpi/function_ref.h>
+
 namespace wpi {
 class Logger;
 }  // namespace wpi
@@ -33,4 +35,19 @@ void WireDecodeText(std::string_view in, ServerMessageHandler& out,
 bool WireDecodeBinary(std::span<const uint8_t>* in, int* outId, Value* outValue,
                       std::string* error, int64_t localTimeOffset);
 
+// as above, but also decodes array delta messages; getDeltaBase is called with
+// the message id and should return the last value received for that id (or
+// nullptr if there is none)
+bool WireDecodeBinary(std::span<const uint8_t>* in, int* outId, Value* outValue,
+                      std::string* error, int64_t localTimeOffset,
+                      wpi::function_ref<const Value*(int id)> getDeltaBase);
+
+// decodes a batched binary message (protocol version 4.2 and later), calling
+// out for each value in the batch. If the next message in *in is not a batch,
+// sets *isBatch to false and returns true without consuming any input.
+// Returns false on decode error.
+bool WireDecodeBinaryBatch(std::span<const uint8_t>* in, bool* isBatch,
+                           wpi::function_ref<void(int id, Value& value)> out,
+                           std::string* error, int64_t localTimeOffset);
+
 }  // namespace nt::net
@@ -4,9 +4,16 @@
 
 #include "WireEncoder.h"
 
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <bit>
 #include <optional>
+#include <span>
 #include <string>
 
+#include <wpi/Endian.h>
 #include <wpi/json.h>
 #include <wpi/mpack.h>
 #include <wpi/raw_ostream.h>
@@ -99,6 +106,13 @@ static void WireEncodeSubscribeImpl(wpi::raw_ostream& os, int subuid,
     os << "\"prefix\":true";
     first = false;
   }
+  if (options.deltaArrays) {
+    if (!first) {
+      os << ',';
+    }
+    os << "\"deltas\":true";
+    first = false;
+  }
   if (options.periodicMs != PubSubOptionsImpl::kDefaultPeriodicMs) {
     if (!first) {
       os << ',';
@@ -133,6 +147,17 @@ void nt::net::WireEncodeUnsubscribe(wpi::raw_ostream& os, int subuid) {
   os << "}}";
 }
 
+void nt::net::WireEncodeResume(wpi::raw_ostream& os, std::string_view token,
+                               int64_t seq) {
+  wpi::json::serializer s{os, ' ', 0};
+  os << "{\"method\":\"" << ResumeMsg::kMethodStr << "\",\"params\":{";
+  os << "\"seq\":";
+  s.dump_integer(seq);
+  os << ",\"token\":\"";
+  s.dump_escaped(token, false);
+  os << "\"}}";
+}
+
 bool nt::net::WireEncodeText(wpi::raw_ostream& os, const ClientMessage& msg) {
   if (auto m = std::get_if<PublishMsg>(&msg.contents)) {
     WireEncodePublish(os, m->pubuid, m->name, m->typeStr, m->properties);
@@ -144,6 +169,8 @@ bool nt::net::WireEncodeText(wpi::raw_ostream& os, const ClientMessage& msg) {
     WireEncodeSubscribe(os, m->subuid, m->topicNames, m->options);
   } else if (auto m = std::get_if<UnsubscribeMsg>(&msg.contents)) {
     WireEncodeUnsubscribe(os, m->subuid);
+  } else if (auto m = std::get_if<ResumeMsg>(&msg.contents)) {
+    WireEncodeResume(os, m->token, m->seq);
   } else {
     return false;
   }
@@ -198,6 +225,17 @@ void nt::net::WireEncodePropertiesUpdate(wpi::raw_ostream& os,
   os << "}}";
 }
 
+void nt::net::WireEncodeCheckpoint(wpi::raw_ostream& os,
+                                   std::string_view token, int64_t seq) {
+  wpi::json::serializer s{os, ' ', 0};
+  os << "{\"method\":\"" << CheckpointMsg::kMethodStr << "\",\"params\":{";
+  os << "\"seq\":";
+  s.dump_integer(seq);
+  os << ",\"token\":\"";
+  s.dump_escaped(token, false);
+  os << "\"}}";
+}
+
 bool nt::net::WireEncodeText(wpi::raw_ostream& os, const ServerMessage& msg) {
   if (auto m = std::get_if<AnnounceMsg>(&msg.contents)) {
     WireEncodeAnnounce(os, m->name, m->id, m->typeStr, m->properties,
@@ -206,6 +244,8 @@ bool nt::net::WireEncodeText(wpi::raw_ostream& os, const ServerMessage& msg) {
     WireEncodeUnannounce(os, m->name, m->id);
   } else if (auto m = std::get_if<PropertiesUpdateMsg>(&msg.contents)) {
     WireEncodePropertiesUpdate(os, m->name, m->update, m->ack);
+  } else if (auto m = std::get_if<CheckpointMsg>(&msg.contents)) {
+    WireEncodeCheckpoint(os, m->token, m->seq);
   } else {
     return false;
   }
@@ -312,3 +352,230 @@ bool nt::net::WireEncodeBinary(wpi::raw_ostream& os, int id, int64_t time,
   mpack_finish_array(&writer);
   return mpack_writer_destroy(&writer) == mpack_ok;
 }
+
+template <typename T>
+static bool ElementChanged(const T& a, const T& b) {
+  // bitwise comparison so e.g. -0.0 vs 0.0 and NaN are handled exactly
+  return memcmp(&a, &b, sizeof(T)) != 0;
+}
+
+template <typename T>
+static size_t CountArrayChanges(std::span<const T> arr,
+                                std::span<const T> base) {
+  size_t common = (std::min)(arr.size(), base.size());
+  size_t changed = arr.size() - common;
+  for (size_t i = 0; i < common; ++i) {
+    if (ElementChanged(arr[i], base[i])) {
+      ++changed;
+    }
+  }
+  return changed;
+}
+
+template <typename T, typename F>
+static void WriteArrayDelta(mpack_writer_t* writer, std::span<const T> arr,
+                            std::span<const T> base, size_t changed,
+                            F&& writeElem) {
+  // [size, index, value, index, value, ...]
+  mpack_start_array(writer, 1 + changed * 2);
+  mpack_write_uint(writer, arr.size());
+  for (size_t i = 0; i < arr.size(); ++i) {
+    if (i >= base.size() || ElementChanged(arr[i], base[i])) {
+      mpack_write_uint(writer, i);
+      writeElem(writer, arr[i]);
+    }
+  }
+  mpack_finish_array(writer);
+}
+
+bool nt::net::WireEncodeBinaryDelta(wpi::raw_ostream& os, int id,
+                                    int64_t time, const Value& value,
+                                    const Value& base) {
+  if (value.type() != base.type()) {
+    return false;
+  }
+
+  // only send a delta if less than half of the elements changed
+  size_t size;
+  size_t changed;
+  switch (value.type()) {
+    case NT_BOOLEAN_ARRAY:
+      size = value.GetBooleanArray().size();
+      changed =
+          CountArrayChanges(value.GetBooleanArray(), base.GetBooleanArray());
+      break;
+    case NT_INTEGER_ARRAY:
+      size = value.GetIntegerArray().size();
+      changed =
+          CountArrayChanges(value.GetIntegerArray(), base.GetIntegerArray());
+      break;
+    case NT_FLOAT_ARRAY:
+      size = value.GetFloatArray().size();
+      changed = CountArrayChanges(value.GetFloatArray(), base.GetFloatArray());
+      break;
+    case NT_DOUBLE_ARRAY:
+      size = value.GetDoubleArray().size();
+      changed =
+          CountArrayChanges(value.GetDoubleArray(), base.GetDoubleArray());
+      break;
+    default:
+      return false;
+  }
+  if (changed * 2 >= size) {
+    return false;
+  }
+
+  char buf[128];
+  mpack_writer_t writer;
+  mpack_writer_init(&writer, buf, sizeof(buf));
+  mpack_writer_set_context(&writer, &os);
+  mpack_writer_set_flush(
+      &writer, [](mpack_writer_t* writer, const char* buffer, size_t count) {
+        static_cast<wpi::raw_ostream*>(writer->context)->write(buffer, count);
+      });
+  mpack_start_array(&writer, 4);
+  mpack_write_int(&writer, id);
+  mpack_write_int(&writer, time);
+  // delta type ids are the array type id + 64
+  switch (value.type()) {
+    case NT_BOOLEAN_ARRAY:
+      mpack_write_u8(&writer, 80);
+      WriteArrayDelta(&writer, value.GetBooleanArray(), base.GetBooleanArray(),
+                      changed, [](mpack_writer_t* w, int v) {
+                        mpack_write_bool(w, v);
+                      });
+      break;
+    case NT_INTEGER_ARRAY:
+      mpack_write_u8(&writer, 82);
+      WriteArrayDelta(&writer, value.GetIntegerArray(), base.GetIntegerArray(),
+                      changed, [](mpack_writer_t* w, int64_t v) {
+                        mpack_write_int(w, v);
+                      });
+      break;
+    case NT_FLOAT_ARRAY:
+      mpack_write_u8(&writer, 83);
+      WriteArrayDelta(&writer, value.GetFloatArray(), base.GetFloatArray(),
+                      changed, [](mpack_writer_t* w, float v) {
+                        mpack_write_float(w, v);
+                      });
+      break;
+    case NT_DOUBLE_ARRAY:
+      mpack_write_u8(&writer, 81);
+      WriteArrayDelta(&writer, value.GetDoubleArray(), base.GetDoubleArray(),
+                      changed, [](mpack_writer_t* w, double v) {
+                        mpack_write_double(w, v);
+                      });
+      break;
+    default:
+      break;
+  }
+  mpack_finish_array(&writer);
+  return mpack_writer_destroy(&writer) == mpack_ok;
+}
+
+bool nt::net::WireIsBatchable(const Value& value) {
+  switch (value.type()) {
+    case NT_BOOLEAN:
+    case NT_INTEGER:
+    case NT_FLOAT:
+    case NT_DOUBLE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool nt::net::WireEncodeBinaryBatch(wpi::raw_ostream& os,
+                                    std::span<const BinaryBatchEntry> entries) {
+  if (entries.empty()) {
+    return false;
+  }
+  int64_t baseTime = entries.front().time;
+
+  char buf[128];
+  mpack_writer_t writer;
+  mpack_writer_init(&writer, buf, sizeof(buf));
+  mpack_writer_set_context(&writer, &os);
+  mpack_writer_set_flush(
+      &writer, [](mpack_writer_t* writer, const char* buffer, size_t count) {
+        static_cast<wpi::raw_ostream*>(writer->context)->write(buffer, count);
+      });
+  // [-2, base time, 96, [[ids], [time offsets], [types], bin values]]
+  mpack_start_array(&writer, 4);
+  mpack_write_int(&writer, -2);
+  mpack_write_int(&writer, baseTime);
+  mpack_write_u8(&writer, 96);
+  mpack_start_array(&writer, 4);
+
+  mpack_start_array(&writer, entries.size());
+  for (auto&& entry : entries) {
+    mpack_write_int(&writer, entry.id);
+  }
+  mpack_finish_array(&writer);
+
+  mpack_start_array(&writer, entries.size());
+  for (auto&& entry : entries) {
+    mpack_write_int(&writer, entry.time - baseTime);
+  }
+  mpack_finish_array(&writer);
+
+  // types are the same as for individual values; values are fixed width
+  uint32_t size = 0;
+  mpack_start_array(&writer, entries.size());
+  for (auto&& entry : entries) {
+    switch (entry.value->type()) {
+      case NT_BOOLEAN:
+        mpack_write_u8(&writer, 0);
+        size += 1;
+        break;
+      case NT_DOUBLE:
+        mpack_write_u8(&writer, 1);
+        size += 8;
+        break;
+      case NT_INTEGER:
+        mpack_write_u8(&writer, 2);
+        size += 8;
+        break;
+      case NT_FLOAT:
+        mpack_write_u8(&writer, 3);
+        size += 4;
+        break;
+      default:
+        mpack_writer_flag_error(&writer, mpack_error_bug);
+        break;
+    }
+  }
+  mpack_finish_array(&writer);
+
+  mpack_start_bin(&writer, size);
+  for (auto&& entry : entries) {
+    uint8_t data[8];
+    switch (entry.value->type()) {
+      case NT_BOOLEAN:
+        data[0] = entry.value->GetBoolean() ? 1 : 0;
+        mpack_write_bytes(&writer, reinterpret_cast<const char*>(data), 1);
+        break;
+      case NT_DOUBLE:
+        wpi::support::endian::write64le(
+            data, std::bit_cast<uint64_t>(entry.value->GetDouble()));
+        mpack_write_bytes(&writer, reinterpret_cast<const char*>(data), 8);
+        break;
+      case NT_INTEGER:
+        wpi::support::endian::write64le(data, entry.value->GetInteger());
+        mpack_write_bytes(&writer, reinterpret_cast<const char*>(data), 8);
+        break;
+      case NT_FLOAT:
+        wpi::support::endian::write32le(
+            data, std::bit_cast<uint32_t>(entry.value->GetFloat()));
+        mpack_write_bytes(&writer, reinterpret_cast<const char*>(data), 4);
+        break;
+      default:
+        break;
+    }
+  }
+  mpack_finish_bin(&writer);
+
+  mpack_finish_array(&writer);
+  mpack_finish_array(&writer);
+  return mpack_writer_destroy(&writer) == mpack_ok;
+}
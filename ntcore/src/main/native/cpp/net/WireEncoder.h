@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #include <optional>
 #include <span>
 #include <string>
@@ -38,6 +40,8 @@ void WireEncodeSubscribe(wpi::raw_ostream& os, int subuid,
                          std::span<const std::string> topicNames,
                          const PubSubOptionsImpl& options);
 void WireEncodeUnsubscribe(wpi::raw_ostream& os, int subuid);
+void WireEncodeResume(wpi::raw_ostream& os, std::string_view token,
+                      int64_t seq);
 
 // encoders for server text messages (avoids need to construct a Message struct)
 void WireEncodeAnnounce(wpi::raw_ostream& os, std::string_view name, int id,
@@ -47,6 +51,8 @@ void WireEncodeUnannounce(wpi::raw_ostream& os, std::string_view name,
                           int64_t id);
 void WireEncodePropertiesUpdate(wpi::raw_ostream& os, std::string_view name,
                                 const wpi::json& update, bool ack);
+void WireEncodeCheckpoint(wpi::raw_ostream& os, std::string_view token,
+                          int64_t seq);
 
 // Encode a single message; note text messages must be put into a
 // JSON array "[msg1, msg2]" for transmission.
@@ -58,4 +64,28 @@ bool WireEncodeText(wpi::raw_ostream& os, const ServerMessage& msg);
 bool WireEncodeBinary(wpi::raw_ostream& os, int id, int64_t time,
                       const Value& value);
 
+// encoder for array delta binary messages (sent in place of WireEncodeBinary
+// to subscribers that requested deltas); base is the last value sent for id.
+// Returns false without writing anything if value can't be delta encoded
+// against base or a delta would not be smaller than the full value.
+bool WireEncodeBinaryDelta(wpi::raw_ostream& os, int id, int64_t time,
+                           const Value& value, const Value& base);
+
+// entry for WireEncodeBinaryBatch()
+struct BinaryBatchEntry {
+  int id;
+  int64_t time;
+  const Value* value;
+};
+
+// returns true if value can be sent as part of a batch message (boolean,
+// integer, float, and double values)
+bool WireIsBatchable(const Value& value);
+
+// encoder for batched binary messages (protocol version 4.2 and later); all
+// entry values must be batchable. Timestamps are encoded relative to the first
+// entry's time.
+bool WireEncodeBinaryBatch(wpi::raw_ostream& os,
+                           std::span<const BinaryBatchEntry> entries);
+
 }  // namespace nt::net
@@ -6,8 +6,11 @@
 
 #include <stdint.h>
 
+#include <memory>
 #include <span>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "networktables/NetworkTableValue.h"
 #include "ntcore_c.h"
@@ -66,7 +69,15 @@ class Message3 {
   unsigned int flags() const { return m_flags; }
   unsigned int seq_num_uid() const { return m_seq_num_uid; }
 
-  void SetValue(const Value& value) { m_value = value; }
+  // Optional encoding of value by WireEncodeValue, shared with other messages
+  // for the same value; may be null
+  using SharedEncodedValue = std::shared_ptr<const std::vector<uint8_t>>;
+  const SharedEncodedValue& encodedValue() const { return m_encodedValue; }
+
+  void SetValue(const Value& value, SharedEncodedValue encoded = {}) {
+    m_value = value;
+    m_encodedValue = std::move(encoded);
+  }
 
   // Create messages without data
   static Message3 KeepAlive() { return {kKeepAlive, {}}; }
@@ -95,19 +106,21 @@ class Message3 {
   }
   static Message3 EntryAssign(std::string_view name, unsigned int id,
                               unsigned int seq_num, const Value& value,
-                              unsigned int flags) {
+                              unsigned int flags,
+                              SharedEncodedValue encoded = {}) {
     Message3 msg{kEntryAssign, {}};
     msg.m_str = name;
-    msg.m_value = value;
+    msg.SetValue(value, std::move(encoded));
     msg.m_id = id;
     msg.m_flags = flags;
     msg.m_seq_num_uid = seq_num;
     return msg;
   }
   static Message3 EntryUpdate(unsigned int id, unsigned int seq_num,
-                              const Value& value) {
+                              const Value& value,
+                              SharedEncodedValue encoded = {}) {
     Message3 msg{kEntryUpdate, {}};
-    msg.m_value = value;
+    msg.SetValue(value, std::move(encoded));
     msg.m_id = id;
     msg.m_seq_num_uid = seq_num;
     return msg;
@@ -148,6 +161,7 @@ class Message3 {
   // Message data.  Use varies by message type.
   std::string m_str;
   Value m_value;
+  SharedEncodedValue m_encodedValue;
   unsigned int m_id{0};  // also used for proto_rev
   unsigned int m_flags{0};
   unsigned int m_seq_num_uid{0};
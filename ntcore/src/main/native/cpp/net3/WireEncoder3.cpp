@@ -241,6 +241,30 @@ bool nt::net3::WireEncodeEntryUpdate(wpi::raw_ostream& os, unsigned int id,
   return WriteValue(os, value);
 }
 
+void nt::net3::WireEncodeEntryAssign(wpi::raw_ostream& os,
+                                     std::string_view name, unsigned int id,
+                                     unsigned int seq_num,
+                                     std::span<const uint8_t> encodedValue,
+                                     unsigned int flags) {
+  // the type is separated from the data by the id, sequence number and flags
+  Write8(os, Message3::kEntryAssign);
+  WriteString(os, name);
+  os << encodedValue.front();
+  Write16(os, id);
+  Write16(os, seq_num);
+  Write8(os, flags);
+  os << encodedValue.subspan(1);
+}
+
+void nt::net3::WireEncodeEntryUpdate(wpi::raw_ostream& os, unsigned int id,
+                                     unsigned int seq_num,
+                                     std::span<const uint8_t> encodedValue) {
+  Write8(os, Message3::kEntryUpdate);
+  Write16(os, id);
+  Write16(os, seq_num);
+  os << encodedValue;
+}
+
 void nt::net3::WireEncodeFlagsUpdate(wpi::raw_ostream& os, unsigned int id,
                                      unsigned int flags) {
   Write8(os, Message3::kFlagsUpdate);
@@ -292,9 +316,18 @@ bool nt::net3::WireEncode(wpi::raw_ostream& os, const Message3& msg) {
       WireEncodeServerHello(os, msg.flags(), msg.str());
       break;
     case Message3::kEntryAssign:
+      if (auto encoded = msg.encodedValue()) {
+        WireEncodeEntryAssign(os, msg.str(), msg.id(), msg.seq_num_uid(),
+                              *encoded, msg.flags());
+        break;
+      }
       return WireEncodeEntryAssign(os, msg.str(), msg.id(), msg.seq_num_uid(),
                                    msg.value(), msg.flags());
     case Message3::kEntryUpdate:
+      if (auto encoded = msg.encodedValue()) {
+        WireEncodeEntryUpdate(os, msg.id(), msg.seq_num_uid(), *encoded);
+        break;
+      }
       return WireEncodeEntryUpdate(os, msg.id(), msg.seq_num_uid(),
                                    msg.value());
     case Message3::kFlagsUpdate:
@@ -319,3 +352,7 @@ bool nt::net3::WireEncode(wpi::raw_ostream& os, const Message3& msg) {
   }
   return true;
 }
+
+bool nt::net3::WireEncodeValue(wpi::raw_ostream& os, const Value& value) {
+  return WriteType(os, value.type()) && WriteValue(os, value);
+}
@@ -36,6 +36,14 @@ bool WireEncodeEntryAssign(wpi::raw_ostream& os, std::string_view name,
                            const Value& value, unsigned int flags);
 bool WireEncodeEntryUpdate(wpi::raw_ostream& os, unsigned int id,
                            unsigned int seq_num, const Value& value);
+// as above, but with a value pre-encoded by WireEncodeValue
+void WireEncodeEntryAssign(wpi::raw_ostream& os, std::string_view name,
+                           unsigned int id, unsigned int seq_num,
+                           std::span<const uint8_t> encodedValue,
+                           unsigned int flags);
+void WireEncodeEntryUpdate(wpi::raw_ostream& os, unsigned int id,
+                           unsigned int seq_num,
+                           std::span<const uint8_t> encodedValue);
 void WireEncodeFlagsUpdate(wpi::raw_ostream& os, unsigned int id,
                            unsigned int flags);
 void WireEncodeEntryDelete(wpi::raw_ostream& os, unsigned int id);
@@ -46,4 +54,9 @@ void WireEncodeRpcResponse(wpi::raw_ostream& os, unsigned int id,
 
 bool WireEncode(wpi::raw_ostream& os, const Message3& msg);
 
+// Encodes the type and data of a value, which are the same in every entry
+// assign and update message for the value, so the encoding can be shared
+// between messages and clients.
+bool WireEncodeValue(wpi::raw_ostream& os, const Value& value);
+
 }  // namespace nt::net3
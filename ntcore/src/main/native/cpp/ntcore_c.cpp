@@ -59,6 +59,7 @@ static void ConvertToC(const TimeSyncEventData& in, NT_TimeSyncEventData* out) {
   out->serverTimeOffset = in.serverTimeOffset;
   out->rtt2 = in.rtt2;
   out->valid = in.valid;
+  out->uncertainty = in.uncertainty;
 }
 
 static void ConvertToC(const Event& in, NT_Event* out) {
@@ -129,6 +130,8 @@ static PubSubOptions ConvertToCpp(const NT_PubSubOptions* in) {
   out.disableLocal = in->disableLocal;
   out.excludeSelf = in->excludeSelf;
   out.hidden = in->hidden;
+  out.deltaArrays = in->deltaArrays;
+  out.coalescePeriod = in->coalescePeriod;
   return out;
 }
 
@@ -447,6 +450,10 @@ NT_Bool NT_WaitForListenerQueue(NT_Handle handle, double timeout) {
   return nt::WaitForListenerQueue(handle, timeout);
 }
 
+void NT_SetListenerThreads(NT_Inst inst, unsigned int count) {
+  nt::SetListenerThreads(inst, count);
+}
+
 NT_Listener NT_AddListenerSingle(NT_Inst inst, const struct WPI_String* prefix,
                                  unsigned int mask, void* data,
                                  NT_ListenerCallback callback) {
@@ -537,6 +544,14 @@ void NT_StopServer(NT_Inst inst) {
   nt::StopServer(inst);
 }
 
+void NT_SetServerIoThreads(NT_Inst inst, unsigned int count) {
+  nt::SetServerIoThreads(inst, count);
+}
+
+void NT_SetServerBandwidthLimit(NT_Inst inst, unsigned int bytesPerSec) {
+  nt::SetServerBandwidthLimit(inst, bytesPerSec);
+}
+
 void NT_StartClient3(NT_Inst inst, const struct WPI_String* identity) {
   nt::StartClient3(inst, wpi::to_string_view(identity));
 }
@@ -599,6 +614,10 @@ struct NT_ConnectionInfo* NT_GetConnections(NT_Inst inst, size_t* count) {
   return ConvertToC<NT_ConnectionInfo>(conn_v, count);
 }
 
+void NT_GetServerTimeSync(NT_Inst inst, struct NT_TimeSyncEventData* data) {
+  ConvertToC(nt::GetServerTimeSync(inst), data);
+}
+
 int64_t NT_GetServerTimeOffset(NT_Inst inst, NT_Bool* valid) {
   if (auto v = nt::GetServerTimeOffset(inst)) {
     *valid = true;
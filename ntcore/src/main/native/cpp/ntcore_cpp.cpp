@@ -132,6 +132,29 @@ bool SetEntryValue(NT_Entry entry, const Value& value) {
   }
 }
 
+bool SetEntryValues(std::span<const NT_Handle> entries,
+                    std::span<const Value> values) {
+  if (entries.empty()) {
+    return values.empty();
+  }
+  int inst = Handle{entries.front()}.GetInst();
+  for (auto entry : entries) {
+    if (Handle{entry}.GetInst() != inst) {
+      // mixed instances; set individually
+      bool ok = entries.size() == values.size();
+      for (size_t i = 0; i < entries.size() && i < values.size(); ++i) {
+        ok = SetEntryValue(entries[i], values[i]) && ok;
+      }
+      return ok;
+    }
+  }
+  if (auto ii = InstanceImpl::Get(inst)) {
+    return ii->localStorage.SetEntryValues(entries, values);
+  } else {
+    return {};
+  }
+}
+
 void SetEntryFlags(NT_Entry entry, unsigned int flags) {
   if (auto ii = InstanceImpl::GetHandle(entry)) {
     ii->localStorage.SetEntryFlags(entry, flags);
@@ -198,6 +221,15 @@ std::vector<TopicInfo> GetTopicInfo(NT_Inst inst, std::string_view prefix,
   }
 }
 
+std::vector<std::pair<NT_Topic, Value>> GetScalarTopicValues(
+    NT_Inst inst, unsigned int types) {
+  if (auto ii = InstanceImpl::GetTyped(inst, Handle::kInstance)) {
+    return ii->localStorage.GetScalarTopicValues(types);
+  } else {
+    return {};
+  }
+}
+
 TopicInfo GetTopicInfo(NT_Topic topic) {
   if (auto ii = InstanceImpl::GetTyped(topic, Handle::kTopic)) {
     return ii->localStorage.GetTopicInfo(topic);
@@ -362,6 +394,15 @@ NT_Publisher PublishEx(NT_Topic topic, NT_Type type, std::string_view typeStr,
   }
 }
 
+std::vector<NT_Publisher> PublishMultiple(
+    NT_Inst inst, std::span<const PublishRequest> requests) {
+  if (auto ii = InstanceImpl::GetTyped(inst, Handle::kInstance)) {
+    return ii->localStorage.PublishMultiple(requests);
+  } else {
+    return std::vector<NT_Publisher>(requests.size());
+  }
+}
+
 void Unpublish(NT_Handle pubentry) {
   if (auto ii = InstanceImpl::GetHandle(pubentry)) {
     ii->localStorage.Unpublish(pubentry);
@@ -489,6 +530,12 @@ bool WaitForListenerQueue(NT_Handle handle, double timeout) {
   }
 }
 
+void SetListenerThreads(NT_Inst inst, unsigned int count) {
+  if (auto ii = InstanceImpl::GetTyped(inst, Handle::kInstance)) {
+    ii->listenerStorage.SetListenerThreads(count);
+  }
+}
+
 NT_Listener AddListener(NT_Inst inst,
                         std::span<const std::string_view> prefixes,
                         unsigned int mask, ListenerCallback callback) {
@@ -646,6 +693,18 @@ void StopServer(NT_Inst inst) {
   }
 }
 
+void SetServerIoThreads(NT_Inst inst, unsigned int count) {
+  if (auto ii = InstanceImpl::GetTyped(inst, Handle::kInstance)) {
+    ii->SetServerIoThreads(count);
+  }
+}
+
+void SetServerBandwidthLimit(NT_Inst inst, unsigned int bytesPerSec) {
+  if (auto ii = InstanceImpl::GetTyped(inst, Handle::kInstance)) {
+    ii->SetServerBandwidthLimit(bytesPerSec);
+  }
+}
+
 void StartClient3(NT_Inst inst, std::string_view identity) {
   if (auto ii = InstanceImpl::GetTyped(inst, Handle::kInstance)) {
     ii->StartClient3(identity);
@@ -777,6 +836,14 @@ std::optional<int64_t> GetServerTimeOffset(NT_Inst inst) {
   }
 }
 
+TimeSyncEventData GetServerTimeSync(NT_Inst inst) {
+  if (auto ii = InstanceImpl::GetTyped(inst, Handle::kInstance)) {
+    return ii->GetServerTimeSync();
+  } else {
+    return {0, 0, false, 0};
+  }
+}
+
 NT_Listener AddLogger(NT_Inst inst, unsigned int minLevel,
                       unsigned int maxLevel, ListenerCallback func) {
   if (auto ii = InstanceImpl::GetTyped(inst, Handle::kInstance)) {
@@ -30,6 +30,8 @@ static SubscriberOptions DecodeSubscriberOptions(mpack_reader_t& r) {
       options.periodic = mpack_expect_float(&r);
     } else if (key == "prefix") {
       options.prefixMatch = mpack_expect_bool(&r);
+    } else if (key == "deltas") {
+      options.deltaArrays = mpack_expect_bool(&r);
     } else {
       // TODO: Save other options
       mpack_discard(&r);
@@ -212,3 +214,85 @@ std::optional<std::vector<Client>> nt::meta::DecodeClients(
     return {};
   }
 }
+
+std::optional<std::vector<ConnectionStats>> nt::meta::DecodeConnectionStats(
+    std::span<const uint8_t> data) {
+  mpack_reader_t r;
+  mpack_reader_init_data(&r, data);
+  uint32_t numClients = mpack_expect_array_max(&r, 100);
+  std::vector<ConnectionStats> clients;
+  clients.reserve(numClients);
+  for (uint32_t i = 0; i < numClients; ++i) {
+    ConnectionStats client;
+    uint32_t numMapElem = mpack_expect_map(&r);
+    for (uint32_t j = 0; j < numMapElem; ++j) {
+      std::string key;
+      mpack_expect_str(&r, &key);
+      if (key == "id") {
+        mpack_expect_str(&r, &client.id);
+      } else if (key == "bytesIn") {
+        client.bytesIn = mpack_expect_u64(&r);
+      } else if (key == "bytesOut") {
+        client.bytesOut = mpack_expect_u64(&r);
+      } else if (key == "rtt") {
+        client.rtt = mpack_expect_i64(&r);
+      } else if (key == "coalesced") {
+        client.coalesced = mpack_expect_u64(&r);
+      } else if (key == "dropped") {
+        client.dropped = mpack_expect_u64(&r);
+      } else if (key == "queueMsgs") {
+        client.queueMessages = mpack_expect_u64(&r);
+      } else if (key == "queueBytes") {
+        client.queueBytes = mpack_expect_u64(&r);
+      } else {
+        mpack_discard(&r);
+      }
+    }
+    mpack_done_map(&r);
+    clients.emplace_back(std::move(client));
+  }
+  mpack_done_array(&r);
+  if (mpack_reader_destroy(&r) == mpack_ok) {
+    return {std::move(clients)};
+  } else {
+    return {};
+  }
+}
+
+std::optional<std::vector<TopicStats>> nt::meta::DecodeTopicStats(
+    std::span<const uint8_t> data) {
+  mpack_reader_t r;
+  mpack_reader_init_data(&r, data);
+  uint32_t numTopics = mpack_expect_array_max(&r, 100000);
+  std::vector<TopicStats> topics;
+  topics.reserve(numTopics);
+  for (uint32_t i = 0; i < numTopics; ++i) {
+    TopicStats topic;
+    uint32_t numMapElem = mpack_expect_map(&r);
+    for (uint32_t j = 0; j < numMapElem; ++j) {
+      std::string key;
+      mpack_expect_str(&r, &key);
+      if (key == "name") {
+        mpack_expect_str(&r, &topic.name);
+      } else if (key == "valuesIn") {
+        topic.valuesIn = mpack_expect_u64(&r);
+      } else if (key == "bytesIn") {
+        topic.bytesIn = mpack_expect_u64(&r);
+      } else if (key == "valuesOut") {
+        topic.valuesOut = mpack_expect_u64(&r);
+      } else if (key == "bytesOut") {
+        topic.bytesOut = mpack_expect_u64(&r);
+      } else {
+        mpack_discard(&r);
+      }
+    }
+    mpack_done_map(&r);
+    topics.emplace_back(std::move(topic));
+  }
+  mpack_done_array(&r);
+  if (mpack_reader_destroy(&r) == mpack_ok) {
+    return {std::move(topics)};
+  } else {
+    return {};
+  }
+}
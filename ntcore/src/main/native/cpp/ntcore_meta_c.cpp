@@ -17,6 +17,7 @@ static void ConvertToC(const SubscriberOptions& in,
   out->topicsOnly = in.topicsOnly;
   out->sendAll = in.sendAll;
   out->prefixMatch = in.prefixMatch;
+  out->deltaArrays = in.deltaArrays;
 }
 
 static void ConvertToC(const TopicPublisher& in, NT_Meta_TopicPublisher* out) {
@@ -50,6 +51,26 @@ static void ConvertToC(const Client& in, NT_Meta_Client* out) {
   out->version = in.version;
 }
 
+static void ConvertToC(const ConnectionStats& in,
+                       NT_Meta_ConnectionStats* out) {
+  ConvertToC(in.id, &out->id);
+  out->bytesIn = in.bytesIn;
+  out->bytesOut = in.bytesOut;
+  out->rtt = in.rtt;
+  out->coalesced = in.coalesced;
+  out->dropped = in.dropped;
+  out->queueMessages = in.queueMessages;
+  out->queueBytes = in.queueBytes;
+}
+
+static void ConvertToC(const TopicStats& in, NT_Meta_TopicStats* out) {
+  ConvertToC(in.name, &out->name);
+  out->valuesIn = in.valuesIn;
+  out->bytesIn = in.bytesIn;
+  out->valuesOut = in.valuesOut;
+  out->bytesOut = in.bytesOut;
+}
+
 template <typename O, typename I>
 static O* ConvertToC(const std::optional<std::vector<I>>& in, size_t* out_len) {
   if (in) {
@@ -95,6 +116,18 @@ struct NT_Meta_Client* NT_Meta_DecodeClients(const uint8_t* data, size_t size,
   return ConvertToC<NT_Meta_Client>(DecodeClients({data, size}), count);
 }
 
+struct NT_Meta_ConnectionStats* NT_Meta_DecodeConnectionStats(
+    const uint8_t* data, size_t size, size_t* count) {
+  return ConvertToC<NT_Meta_ConnectionStats>(
+      DecodeConnectionStats({data, size}), count);
+}
+
+struct NT_Meta_TopicStats* NT_Meta_DecodeTopicStats(const uint8_t* data,
+                                                    size_t size,
+                                                    size_t* count) {
+  return ConvertToC<NT_Meta_TopicStats>(DecodeTopicStats({data, size}), count);
+}
+
 void NT_Meta_FreeTopicPublishers(struct NT_Meta_TopicPublisher* arr,
                                  size_t count) {
   for (size_t i = 0; i < count; ++i) {
@@ -135,4 +168,19 @@ void NT_Meta_FreeClients(struct NT_Meta_Client* arr, size_t count) {
   std::free(arr);
 }
 
+void NT_Meta_FreeConnectionStats(struct NT_Meta_ConnectionStats* arr,
+                                 size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    WPI_FreeString(&arr[i].id);
+  }
+  std::free(arr);
+}
+
+void NT_Meta_FreeTopicStats(struct NT_Meta_TopicStats* arr, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    WPI_FreeString(&arr[i].name);
+  }
+  std::free(arr);
+}
+
 }  // extern "C"
@@ -4,10 +4,23 @@
 
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 
 namespace nt::server {
 
 inline constexpr uint32_t kMinPeriodMs = 5;
 
+// values at least this large (in bytes) are encoded once and the encoding
+// shared between all clients they are sent to
+inline constexpr size_t kMinSharedEncodeSize = 256;
+
+// minimum time between resume checkpoints sent to each client
+inline constexpr uint32_t kCheckpointPeriodMs = 1000;
+
+// how long a disconnected client may resume its session, and how many
+// sessions are kept
+inline constexpr uint64_t kResumeSessionTimeoutMs = 30000;
+inline constexpr size_t kMaxResumeSessions = 32;
+
 }  // namespace nt::server
@@ -52,8 +52,11 @@ class ServerClient {
   virtual bool ProcessIncomingText(std::string_view data) = 0;
   virtual bool ProcessIncomingBinary(std::span<const uint8_t> data) = 0;
 
+  // encoded is shared by all clients the value is sent to; clients that send
+  // the binary NT4 encoding may fill it in (if empty) and use it
   virtual void SendValue(ServerTopic* topic, const Value& value,
-                         net::ValueSendMode mode) = 0;
+                         net::ValueSendMode mode,
+                         net::SharedEncodedValue& encoded) = 0;
   virtual void SendAnnounce(ServerTopic* topic, std::optional<int> pubuid) = 0;
   virtual void SendUnannounce(ServerTopic* topic) = 0;
   virtual void SendPropertiesUpdate(ServerTopic* topic, const wpi::json& update,
@@ -76,6 +79,15 @@ class ServerClient {
 
   virtual void UpdatePeriod(TopicClientData& tcd, ServerTopic* topic) {}
 
+  // called prior to removal so the client can later resume
+  virtual void SaveResumeSession() {}
+
+  // returns false if the client doesn't track connection statistics
+  virtual bool GetStats(net::WireStats* wire,
+                        net::OutgoingQueueStats* queue) const {
+    return false;
+  }
+
  protected:
   std::string m_name;
   std::string m_connInfo;
@@ -6,7 +6,10 @@
 
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include <wpi/raw_ostream.h>
 #include <wpi/timestamp.h>
 
 #include "Log.h"
@@ -29,6 +32,38 @@ bool ServerClient3::TopicData3::UpdateFlags(ServerTopic* topic) {
   return updated;
 }
 
+nt::net::SharedEncodedValue ServerClient3::GetEncodedValue(
+    ServerTopic* topic, const Value& value) {
+  // only the last value is shared; other values are sent to few clients
+  if (&value != &topic->lastValue) {
+    return {};
+  }
+  if (!topic->lastValueEncoded3) {
+    auto data = std::make_shared<std::vector<uint8_t>>();
+    wpi::raw_uvector_ostream os{*data};
+    if (!net3::WireEncodeValue(os, value)) {
+      return {};  // unsupported type
+    }
+    topic->lastValueEncoded3 = std::move(data);
+  }
+  return topic->lastValueEncoded3;
+}
+
+nt::net3::Message3 ServerClient3::MakeValueMessage(ServerTopic* topic,
+                                                   TopicData3* topic3,
+                                                   const Value& value) {
+  ++topic3->seqNum;
+  if (topic3->sentAssign) {
+    return net3::Message3::EntryUpdate(topic->id, topic3->seqNum.value(),
+                                       value, GetEncodedValue(topic, value));
+  }
+  topic3->sentAssign = true;
+  return net3::Message3::EntryAssign(topic->name, topic->id,
+                                     topic3->seqNum.value(), value,
+                                     topic3->flags,
+                                     GetEncodedValue(topic, value));
+}
+
 bool ServerClient3::ProcessIncomingBinary(std::span<const uint8_t> data) {
   if (!m_decoder.Execute(&data)) {
     m_wire.Disconnect(m_decoder.GetError());
@@ -37,7 +72,8 @@ bool ServerClient3::ProcessIncomingBinary(std::span<const uint8_t> data) {
 }
 
 void ServerClient3::SendValue(ServerTopic* topic, const Value& value,
-                              net::ValueSendMode mode) {
+                              net::ValueSendMode mode,
+                              net::SharedEncodedValue& encoded) {
   if (m_state != kStateRunning) {
     if (mode == net::ValueSendMode::kImm) {
       mode = net::ValueSendMode::kAll;
@@ -52,16 +88,8 @@ void ServerClient3::SendValue(ServerTopic* topic, const Value& value,
     case net::ValueSendMode::kDisabled:  // do nothing
       break;
     case net::ValueSendMode::kImm:  // send immediately
-      ++topic3->seqNum;
-      if (topic3->sentAssign) {
-        net3::WireEncodeEntryUpdate(m_wire.Send().stream(), topic->id,
-                                    topic3->seqNum.value(), value);
-      } else {
-        net3::WireEncodeEntryAssign(m_wire.Send().stream(), topic->name,
-                                    topic->id, topic3->seqNum.value(), value,
-                                    topic3->flags);
-        topic3->sentAssign = true;
-      }
+      net3::WireEncode(m_wire.Send().stream(),
+                       MakeValueMessage(topic, topic3, value));
       if (m_local) {
         Flush();
       }
@@ -76,7 +104,7 @@ void ServerClient3::SendValue(ServerTopic* topic, const Value& value,
         if (msg.Is(net3::Message3::kEntryUpdate) ||
             msg.Is(net3::Message3::kEntryAssign)) {
           if (msg.id() == topic->id) {  // should always be true
-            msg.SetValue(value);
+            msg.SetValue(value, GetEncodedValue(topic, value));
             break;
           }
         }
@@ -87,16 +115,7 @@ void ServerClient3::SendValue(ServerTopic* topic, const Value& value,
       if (!added) {
         m_outgoingValueMap[topic->id] = m_outgoing.size();
       }
-      ++topic3->seqNum;
-      if (topic3->sentAssign) {
-        m_outgoing.emplace_back(net3::Message3::EntryUpdate(
-            topic->id, topic3->seqNum.value(), value));
-      } else {
-        m_outgoing.emplace_back(net3::Message3::EntryAssign(
-            topic->name, topic->id, topic3->seqNum.value(), value,
-            topic3->flags));
-        topic3->sentAssign = true;
-      }
+      m_outgoing.emplace_back(MakeValueMessage(topic, topic3, value));
       break;
   }
 }
@@ -301,9 +320,15 @@ void ServerClient3::ClientHello(std::string_view self_id,
 
         TopicData3* topic3 = GetTopic3(topic);
         ++topic3->seqNum;
-        net3::WireEncodeEntryAssign(out.stream(), topic->name, topic->id,
-                                    topic3->seqNum.value(), topic->lastValue,
-                                    topic3->flags);
+        if (auto encoded = GetEncodedValue(topic, topic->lastValue)) {
+          net3::WireEncodeEntryAssign(out.stream(), topic->name, topic->id,
+                                      topic3->seqNum.value(), *encoded,
+                                      topic3->flags);
+        } else {
+          net3::WireEncodeEntryAssign(out.stream(), topic->name, topic->id,
+                                      topic3->seqNum.value(), topic->lastValue,
+                                      topic3->flags);
+        }
         topic3->sentAssign = true;
       }
     });
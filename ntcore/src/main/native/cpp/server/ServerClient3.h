@@ -35,7 +35,8 @@ class ServerClient3 final : public ServerClient, private net3::MessageHandler3 {
   bool ProcessIncomingMessages(size_t max) final { return false; }
 
   void SendValue(ServerTopic* topic, const Value& value,
-                 net::ValueSendMode mode) final;
+                 net::ValueSendMode mode,
+                 net::SharedEncodedValue& encoded) final;
   void SendAnnounce(ServerTopic* topic, std::optional<int> pubuid) final;
   void SendUnannounce(ServerTopic* topic) final;
   void SendPropertiesUpdate(ServerTopic* topic, const wpi::json& update,
@@ -92,6 +93,18 @@ class ServerClient3 final : public ServerClient, private net3::MessageHandler3 {
   TopicData3* GetTopic3(ServerTopic* topic) {
     return &m_topics3.try_emplace(topic, topic).first->second;
   }
+
+  // The NT3 encoding of a topic's last value is cached in the topic and
+  // shared by all NT3 clients; returns null for other values, which are
+  // encoded per client.
+  static net::SharedEncodedValue GetEncodedValue(ServerTopic* topic,
+                                                 const Value& value);
+
+  // makes an entry assign message if the client hasn't been sent one yet,
+  // and an entry update message otherwise
+  static net3::Message3 MakeValueMessage(ServerTopic* topic,
+                                         TopicData3* topic3,
+                                         const Value& value);
 };
 
 }  // namespace nt::server
@@ -4,12 +4,19 @@
 
 #include "ServerClient4.h"
 
+#include <algorithm>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include <wpi/raw_ostream.h>
 #include <wpi/timestamp.h>
 
 #include "Log.h"
 #include "net/WireDecoder.h"
+#include "net/WireEncoder.h"
+#include "server/Constants.h"
 #include "server/ServerStorage.h"
 #include "server/ServerTopic.h"
 
@@ -57,10 +64,29 @@ bool ServerClient4::ProcessIncomingBinary(std::span<const uint8_t> data) {
       break;
     }
 
+    // decode batch message
+    std::string error;
+    bool isBatch;
+    if (!net::WireDecodeBinaryBatch(
+            &data, &isBatch,
+            [&](int pubuid, Value& value) {
+              if (++count < kMaxImmProcessing) {
+                ClientSetValue(pubuid, value);
+              } else {
+                m_incoming.ClientSetValue(pubuid, value);
+              }
+            },
+            &error, 0)) {
+      m_wire.Disconnect(fmt::format("binary decode error: {}", error));
+      break;
+    }
+    if (isBatch) {
+      continue;
+    }
+
     // decode message
     int pubuid;
     Value value;
-    std::string error;
     if (!net::WireDecodeBinary(&data, &pubuid, &value, &error, 0)) {
       m_wire.Disconnect(fmt::format("binary decode error: {}", error));
       break;
@@ -90,8 +116,16 @@ bool ServerClient4::ProcessIncomingBinary(std::span<const uint8_t> data) {
 }
 
 void ServerClient4::SendValue(ServerTopic* topic, const Value& value,
-                              net::ValueSendMode mode) {
-  m_outgoing.SendValue(topic->id, value, mode);
+                              net::ValueSendMode mode,
+                              net::SharedEncodedValue& encoded) {
+  if (!encoded && mode != net::ValueSendMode::kDisabled &&
+      value.size() >= kMinSharedEncodeSize) {
+    auto data = std::make_shared<std::vector<uint8_t>>();
+    wpi::raw_uvector_ostream os{*data};
+    net::WireEncodeBinary(os, topic->id, value.time(), value);
+    encoded = std::move(data);
+  }
+  m_outgoing.SendValue(topic->id, value, mode, encoded);
 }
 
 void ServerClient4::SendAnnounce(ServerTopic* topic,
@@ -170,11 +204,36 @@ void ServerClient4::SendOutgoing(uint64_t curTimeMs, bool flush) {
     }
   }
   m_outgoing.SendOutgoing(curTimeMs, flush);
+
+  // once everything queued has been sent, let the client know which value
+  // changes it has received, so it can resume after a reconnect
+  if (m_wire.GetVersion() >= 0x0402 && !m_local &&
+      curTimeMs >= m_nextCheckpointMs &&
+      m_checkpointSeq != m_storage.GetValueSeq() && m_outgoing.IsEmpty() &&
+      m_wire.Ready()) {
+    if (m_resumeToken.empty()) {
+      m_resumeToken = m_storage.NewResumeToken();
+    }
+    m_checkpointSeq = m_storage.GetValueSeq();
+    RecordCheckpointTopics();
+    m_nextCheckpointMs = curTimeMs + kCheckpointPeriodMs;
+    SendCheckpoint();
+  }
+}
+
+void ServerClient4::SendCheckpoint() {
+  m_wire.SendText([&](auto& os) {
+    net::WireEncodeCheckpoint(os, m_resumeToken, m_checkpointSeq);
+  });
 }
 
 void ServerClient4::UpdatePeriod(TopicClientData& tcd, ServerTopic* topic) {
   uint32_t period = net::CalculatePeriod(
       tcd.subscribers, [](auto& x) { return x->GetPeriodMs(); });
   DEBUG4("updating {} period to {} ms", topic->name, period);
-  m_outgoing.SetPeriod(topic->id, period);
+  m_outgoing.SetPeriod(topic->id, period, topic->priority);
+  bool deltaArrays =
+      std::any_of(tcd.subscribers.begin(), tcd.subscribers.end(),
+                  [](auto* x) { return x->GetOptions().deltaArrays; });
+  m_outgoing.SetDeltaArrays(topic->id, deltaArrays);
 }
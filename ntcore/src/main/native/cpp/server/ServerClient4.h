@@ -31,7 +31,8 @@ class ServerClient4 final : public ServerClient4Base {
   }
 
   void SendValue(ServerTopic* topic, const Value& value,
-                 net::ValueSendMode mode) final;
+                 net::ValueSendMode mode,
+                 net::SharedEncodedValue& encoded) final;
   void SendAnnounce(ServerTopic* topic, std::optional<int> pubuid) final;
   void SendUnannounce(ServerTopic* topic) final;
   void SendPropertiesUpdate(ServerTopic* topic, const wpi::json& update,
@@ -42,6 +43,20 @@ class ServerClient4 final : public ServerClient4Base {
 
   void UpdatePeriod(TopicClientData& tcd, ServerTopic* topic) final;
 
+  void SetBandwidthLimit(uint32_t bytesPerSec) {
+    m_outgoing.SetBandwidthLimit(bytesPerSec);
+  }
+
+  bool GetStats(net::WireStats* wire,
+                net::OutgoingQueueStats* queue) const final {
+    *wire = m_wire.GetStats();
+    *queue = m_outgoing.GetStats();
+    return true;
+  }
+
+ protected:
+  void SendCheckpoint() final;
+
  public:
   net::WireConnection& m_wire;
 
@@ -49,6 +64,7 @@ class ServerClient4 final : public ServerClient4Base {
   net::NetworkPing m_ping;
   net::NetworkIncomingClientQueue m_incoming;
   net::NetworkOutgoingQueue<net::ServerMessage> m_outgoing;
+  uint64_t m_nextCheckpointMs{0};
 };
 
 }  // namespace nt::server
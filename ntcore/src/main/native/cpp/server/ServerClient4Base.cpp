@@ -4,6 +4,7 @@
 
 #include "ServerClient4Base.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -17,6 +18,13 @@
 
 using namespace nt::server;
 
+// sorts topics into id order and removes duplicates
+static void SortUniqueTopics(std::vector<ServerTopic*>& topics) {
+  std::sort(topics.begin(), topics.end(),
+            [](auto* a, auto* b) { return a->id < b->id; });
+  topics.erase(std::unique(topics.begin(), topics.end()), topics.end());
+}
+
 void ServerClient4Base::ClientPublish(int pubuid, std::string_view name,
                                       std::string_view typeStr,
                                       const wpi::json& properties,
@@ -92,8 +100,12 @@ void ServerClient4Base::ClientSubscribe(int subuid,
          subuid);
   auto& sub = m_subscribers[subuid];
   bool replace = false;
+  // only topics matched by the old or new subscription can change
+  std::vector<ServerTopic*> topics;
   if (sub) {
     // replace subscription
+    m_storage.FindMatchingTopics(sub->GetTopicNames(),
+                                 sub->GetOptions().prefixMatch, topics);
     sub->Update(topicNames, options);
     replace = true;
   } else {
@@ -112,9 +124,11 @@ void ServerClient4Base::ClientSubscribe(int subuid,
   // for transmit efficiency, we want to batch announcements and values, so
   // send announcements in first loop and remember what we want to send in
   // second loop.
+  m_storage.FindMatchingTopics(topicNames, options.prefixMatch, topics);
+  SortUniqueTopics(topics);
   std::vector<ServerTopic*> dataToSend;
-  dataToSend.reserve(m_storage.GetNumTopics());
-  m_storage.ForEachTopic([&](ServerTopic* topic) {
+  dataToSend.reserve(topics.size());
+  for (auto topic : topics) {
     auto tcdIt = topic->clients.find(this);
     bool removed = tcdIt != topic->clients.end() && replace &&
                    tcdIt->second.subscribers.erase(sub.get());
@@ -148,14 +162,16 @@ void ServerClient4Base::ClientSubscribe(int subuid,
 
     // send last value
     if (added && !sub->GetOptions().topicsOnly && !wasSubscribedValue &&
-        topic->lastValue) {
+        topic->lastValue && !HasResumedValue(topic)) {
       dataToSend.emplace_back(topic);
     }
-  });
+  }
 
   for (auto topic : dataToSend) {
     DEBUG4("send last value for {} to client {}", topic->name, m_id);
-    SendValue(topic, topic->lastValue, net::ValueSendMode::kAll);
+    SendValue(topic, topic->lastValue, net::ValueSendMode::kAll,
+              topic->lastValueEncoded);
+    topic->CountValueOut(topic->lastValue);
   }
 }
 
@@ -168,7 +184,11 @@ void ServerClient4Base::ClientUnsubscribe(int subuid) {
   auto sub = subIt->getSecond().get();
 
   // remove from topics
-  m_storage.ForEachTopic([&](ServerTopic* topic) {
+  std::vector<ServerTopic*> topics;
+  m_storage.FindMatchingTopics(sub->GetTopicNames(),
+                               sub->GetOptions().prefixMatch, topics);
+  SortUniqueTopics(topics);
+  for (auto topic : topics) {
     auto tcdIt = topic->clients.find(this);
     if (tcdIt != topic->clients.end()) {
       if (tcdIt->second.subscribers.erase(sub)) {
@@ -176,7 +196,7 @@ void ServerClient4Base::ClientUnsubscribe(int subuid) {
         m_storage.UpdateMetaTopicSub(topic);
       }
     }
-  });
+  }
 
   // delete it from client (future value sets will be ignored)
   m_subscribers.erase(subIt);
@@ -200,6 +220,53 @@ void ServerClient4Base::ClientSetValue(int pubuid, const Value& value) {
   m_storage.SetValue(this, topic, value);
 }
 
+void ServerClient4Base::ClientResume(std::string_view token, int64_t seq) {
+  DEBUG3("ClientResume({}, {}, {})", m_id, token, seq);
+  if (!m_subscribers.empty() || m_resumeSeq >= 0) {
+    WARN("client {} resume after subscribe, ignoring", m_id);
+    return;
+  }
+  if (!m_storage.TakeResumeSession(token, seq, &m_resumeTopicNames)) {
+    DEBUG3("client {} resume session {} not available", m_id, token);
+    return;
+  }
+  m_resumeSeq = seq;
+
+  // continue the session, and confirm to the client (ahead of any announce
+  // resulting from its subscriptions) that it was resumed
+  m_resumeToken = token;
+  m_checkpointSeq = seq;
+  m_checkpointTopicNames = m_resumeTopicNames;
+  SendCheckpoint();
+}
+
+void ServerClient4Base::SaveResumeSession() {
+  if (m_resumeToken.empty()) {
+    return;  // client was never sent a checkpoint
+  }
+  // values sent after the last checkpoint may not have reached the client,
+  // so only the topics delivered as of that checkpoint are saved
+  m_storage.SaveResumeSession(m_resumeToken, m_checkpointSeq,
+                              std::move(m_checkpointTopicNames));
+}
+
+void ServerClient4Base::RecordCheckpointTopics() {
+  m_checkpointTopicNames.clear();
+  m_storage.ForEachTopic([&](ServerTopic* topic) {
+    auto tcdIt = topic->clients.find(this);
+    if (tcdIt != topic->clients.end() && topic->lastValue &&
+        tcdIt->second.sendMode != net::ValueSendMode::kDisabled) {
+      m_checkpointTopicNames.emplace_back(topic->name);
+    }
+  });
+}
+
+bool ServerClient4Base::HasResumedValue(ServerTopic* topic) const {
+  return topic->lastValueSeq <= m_resumeSeq &&
+         std::binary_search(m_resumeTopicNames.begin(),
+                            m_resumeTopicNames.end(), topic->name);
+}
+
 bool ServerClient4Base::DoProcessIncomingMessages(
     net::ClientMessageQueue& queue, size_t max) {
   DEBUG4("ProcessIncomingMessage()");
@@ -229,6 +296,8 @@ bool ServerClient4Base::DoProcessIncomingMessages(
     } else if (auto msg = std::get_if<net::UnsubscribeMsg>(&elem.contents)) {
       ClientUnsubscribe(msg->subuid);
       updatesub = true;
+    } else if (auto msg = std::get_if<net::ResumeMsg>(&elem.contents)) {
+      ClientResume(msg->token, msg->seq);
     }
   }
   if (updatepub) {
@@ -4,8 +4,11 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include <wpi/DenseMap.h>
 
@@ -36,12 +39,39 @@ class ServerClient4Base : public ServerClient,
   void ClientUnsubscribe(int subuid) final;
 
   void ClientSetValue(int pubuid, const Value& value) final;
+  void ClientResume(std::string_view token, int64_t seq) final;
+
+ public:
+  void SaveResumeSession() final;
 
+ protected:
   bool DoProcessIncomingMessages(net::ClientMessageQueue& queue, size_t max);
 
+  // sends m_resumeToken and m_checkpointSeq to the client
+  virtual void SendCheckpoint() {}
+
+  // records the topics whose last values the client has been sent, for the
+  // resume session saved at the next checkpoint; call only when there's
+  // nothing left in the outgoing queue
+  void RecordCheckpointTopics();
+
   wpi::DenseMap<ServerTopic*, bool> m_announceSent;
 
+  // resume token and sequence number of the most recent checkpoint sent;
+  // token is empty if no checkpoint has been sent
+  std::string m_resumeToken;
+  int64_t m_checkpointSeq{-1};
+
  private:
+  // true if the client already has topic's last value from a resumed session
+  bool HasResumedValue(ServerTopic* topic) const;
+
+  int64_t m_resumeSeq{-1};
+  std::vector<std::string> m_resumeTopicNames;  // sorted
+
+  // topics with values delivered as of m_checkpointSeq
+  std::vector<std::string> m_checkpointTopicNames;
+
   std::array<net::ClientMessage, 16> m_msgsBuf;
 };
 
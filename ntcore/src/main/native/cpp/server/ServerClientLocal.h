@@ -28,7 +28,8 @@ class ServerClientLocal final : public ServerClient4Base {
   }
 
   void SendValue(ServerTopic* topic, const Value& value,
-                 net::ValueSendMode mode) final;
+                 net::ValueSendMode mode,
+                 net::SharedEncodedValue& encoded) final;
   void SendAnnounce(ServerTopic* topic, std::optional<int> pubuid) final;
   void SendUnannounce(ServerTopic* topic) final;
   void SendPropertiesUpdate(ServerTopic* topic, const wpi::json& update,
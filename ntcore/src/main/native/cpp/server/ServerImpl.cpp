@@ -6,6 +6,7 @@
 
 #include <stdint.h>
 
+#include <algorithm>
 #include <cmath>
 #include <memory>
 #include <string>
@@ -36,6 +37,8 @@ ServerImpl::ServerImpl(wpi::Logger& logger)
 
   // create server meta topics
   m_metaClients = m_storage.CreateMetaTopic("$clients");
+  m_metaClientStats = m_storage.CreateMetaTopic("$sys/clients");
+  m_metaTopicStats = m_storage.CreateMetaTopic("$sys/topics");
 }
 
 std::pair<std::string, int> ServerImpl::AddClient(std::string_view name,
@@ -51,10 +54,13 @@ std::pair<std::string, int> ServerImpl::AddClient(std::string_view name,
   // ensure name is unique by suffixing index
   std::string dedupName = fmt::format("{}@{}", name, index);
 
-  auto& clientData = m_clients[index];
-  clientData = std::make_unique<ServerClient4>(dedupName, connInfo, local, wire,
-                                               std::move(setPeriodic),
-                                               m_storage, index, m_logger);
+  auto client = std::make_unique<ServerClient4>(dedupName, connInfo, local,
+                                                wire, std::move(setPeriodic),
+                                                m_storage, index, m_logger);
+  if (!local) {
+    client->SetBandwidthLimit(m_bandwidthLimit);
+  }
+  m_clients[index] = std::move(client);
 
   DEBUG3("AddClient('{}', '{}') -> {}", name, connInfo, index);
   return {std::move(dedupName), index};
@@ -78,6 +84,7 @@ std::shared_ptr<void> ServerImpl::RemoveClient(int clientId) {
   DEBUG3("RemoveClient({})", clientId);
   auto& client = m_clients[clientId];
   if (client) {
+    client->SaveResumeSession();
     m_storage.RemoveClient(client.get());
   }
   return std::move(client);
@@ -154,6 +161,94 @@ void ServerImpl::UpdateMetaClients(const std::vector<ConnectionInfo>& conns) {
   }
 }
 
+static bool IsSubscribed(const ServerTopic* topic) {
+  return std::any_of(
+      topic->clients.begin(), topic->clients.end(),
+      [](auto&& tcd) { return !tcd.second.subscribers.empty(); });
+}
+
+void ServerImpl::UpdateMetaStats() {
+  if (IsSubscribed(m_metaClientStats)) {
+    struct Stats {
+      std::string_view id;
+      net::WireStats wire;
+      net::OutgoingQueueStats queue;
+    };
+    std::vector<Stats> stats;
+    for (auto&& client : m_clients) {
+      if (client) {
+        Stats s{client->GetName(), {}, {}};
+        if (client->GetStats(&s.wire, &s.queue)) {
+          stats.emplace_back(s);
+        }
+      }
+    }
+
+    Writer w;
+    mpack_start_array(&w, stats.size());
+    for (auto&& s : stats) {
+      mpack_start_map(&w, 8);
+      mpack_write_str(&w, "id");
+      mpack_write_str(&w, s.id);
+      mpack_write_str(&w, "bytesIn");
+      mpack_write_u64(&w, s.wire.bytesIn);
+      mpack_write_str(&w, "bytesOut");
+      mpack_write_u64(&w, s.wire.bytesOut);
+      mpack_write_str(&w, "rtt");
+      mpack_write_i64(&w, s.wire.rttUs);
+      mpack_write_str(&w, "coalesced");
+      mpack_write_u64(&w, s.queue.coalesced);
+      mpack_write_str(&w, "dropped");
+      mpack_write_u64(&w, s.queue.dropped);
+      mpack_write_str(&w, "queueMsgs");
+      mpack_write_u64(&w, s.queue.queuedMessages);
+      mpack_write_str(&w, "queueBytes");
+      mpack_write_u64(&w, s.queue.queuedBytes);
+      mpack_finish_map(&w);
+    }
+    mpack_finish_array(&w);
+    if (mpack_writer_destroy(&w) == mpack_ok) {
+      m_storage.SetValue(nullptr, m_metaClientStats,
+                         Value::MakeRaw(std::move(w.bytes)));
+    } else {
+      DEBUG4("failed to encode $sys/clients");
+    }
+  }
+
+  if (IsSubscribed(m_metaTopicStats)) {
+    std::vector<ServerTopic*> topics;
+    m_storage.ForEachTopic([&](ServerTopic* topic) {
+      if (topic && !topic->special) {
+        topics.emplace_back(topic);
+      }
+    });
+
+    Writer w;
+    mpack_start_array(&w, topics.size());
+    for (auto topic : topics) {
+      mpack_start_map(&w, 5);
+      mpack_write_str(&w, "name");
+      mpack_write_str(&w, topic->name);
+      mpack_write_str(&w, "valuesIn");
+      mpack_write_u64(&w, topic->valuesIn);
+      mpack_write_str(&w, "bytesIn");
+      mpack_write_u64(&w, topic->bytesIn);
+      mpack_write_str(&w, "valuesOut");
+      mpack_write_u64(&w, topic->valuesOut);
+      mpack_write_str(&w, "bytesOut");
+      mpack_write_u64(&w, topic->bytesOut);
+      mpack_finish_map(&w);
+    }
+    mpack_finish_array(&w);
+    if (mpack_writer_destroy(&w) == mpack_ok) {
+      m_storage.SetValue(nullptr, m_metaTopicStats,
+                         Value::MakeRaw(std::move(w.bytes)));
+    } else {
+      DEBUG4("failed to encode $sys/topics");
+    }
+  }
+}
+
 void ServerImpl::SendAllOutgoing(uint64_t curTimeMs, bool flush) {
   for (auto&& client : m_clients) {
     if (client) {
@@ -162,9 +257,9 @@ void ServerImpl::SendAllOutgoing(uint64_t curTimeMs, bool flush) {
   }
 }
 
-void ServerImpl::SendOutgoing(int clientId, uint64_t curTimeMs) {
+void ServerImpl::SendOutgoing(int clientId, uint64_t curTimeMs, bool flush) {
   if (auto client = m_clients[clientId].get()) {
-    client->SendOutgoing(curTimeMs, false);
+    client->SendOutgoing(curTimeMs, flush);
   }
 }
 
@@ -202,6 +297,14 @@ bool ServerImpl::ProcessIncomingMessages(size_t max) {
   return rv;
 }
 
+bool ServerImpl::ProcessIncomingMessages(int clientId, size_t max) {
+  if (auto client = m_clients[clientId].get()) {
+    return client->ProcessIncomingMessages(max);
+  } else {
+    return false;
+  }
+}
+
 bool ServerImpl::ProcessLocalMessages(size_t max) {
   DEBUG4("ProcessLocalMessages({})", max);
   return m_localClient->ProcessIncomingMessages(max);
@@ -214,3 +317,11 @@ std::string ServerImpl::DumpPersistent() {
   os.flush();
   return rv;
 }
+
+std::string ServerImpl::DumpPersistentChanges() {
+  std::string rv;
+  wpi::raw_string_ostream os{rv};
+  m_storage.DumpPersistentChanges(os);
+  os.flush();
+  return rv;
+}
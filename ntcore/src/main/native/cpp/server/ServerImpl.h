@@ -42,7 +42,7 @@ class ServerImpl final {
   explicit ServerImpl(wpi::Logger& logger);
 
   void SendAllOutgoing(uint64_t curTimeMs, bool flush);
-  void SendOutgoing(int clientId, uint64_t curTimeMs);
+  void SendOutgoing(int clientId, uint64_t curTimeMs, bool flush = false);
 
   void SetLocal(net::ServerMessageHandler* local,
                 net::ClientMessageQueue* queue);
@@ -53,6 +53,7 @@ class ServerImpl final {
 
   // later processing -- returns true if more to process
   bool ProcessIncomingMessages(size_t max);
+  bool ProcessIncomingMessages(int clientId, size_t max);
   bool ProcessLocalMessages(size_t max);
 
   // Returns -1 if cannot add client (e.g. due to duplicate name).
@@ -66,10 +67,19 @@ class ServerImpl final {
                  SetPeriodicFunc setPeriodic);
   std::shared_ptr<void> RemoveClient(int clientId);
 
+  // limits non-critical outgoing traffic to each subsequently added NT4
+  // (non-local) client to approximately bytesPerSec; 0 for no limit
+  void SetClientBandwidthLimit(uint32_t bytesPerSec) {
+    m_bandwidthLimit = bytesPerSec;
+  }
+
   void ConnectionsChanged(const std::vector<ConnectionInfo>& conns) {
     UpdateMetaClients(conns);
   }
 
+  // updates the $sys/ statistics meta topics (if subscribed)
+  void UpdateMetaStats();
+
   // if any persistent values changed since the last call to this function
   bool PersistentChanged() { return m_storage.PersistentChanged(); }
 
@@ -79,6 +89,13 @@ class ServerImpl final {
     return m_storage.LoadPersistent(in);
   }
 
+  // persistent topics changed since the last call, as journal lines
+  std::string DumpPersistentChanges();
+  // returns newline-separated errors
+  std::string LoadPersistentChanges(std::string_view in) {
+    return m_storage.LoadPersistentChanges(in);
+  }
+
  private:
   wpi::Logger& m_logger;
 
@@ -90,6 +107,10 @@ class ServerImpl final {
   // global meta topics (other meta topics are linked to from the specific
   // client or topic)
   ServerTopic* m_metaClients;
+  ServerTopic* m_metaClientStats;
+  ServerTopic* m_metaTopicStats;
+
+  uint32_t m_bandwidthLimit = 0;
 
   size_t GetEmptyClientSlot();
   void SendAnnounce(ServerTopic* topic, ServerClient* client);
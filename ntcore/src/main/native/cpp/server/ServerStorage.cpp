@@ -4,17 +4,21 @@
 
 #include "ServerStorage.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
 #include <fmt/format.h>
 #include <wpi/Base64.h>
 #include <wpi/MessagePack.h>
+#include <wpi/StringExtras.h>
 #include <wpi/json.h>
 
 #include "Log.h"
+#include "server/Constants.h"
 #include "server/MessagePackWriter.h"
 #include "server/ServerClient.h"
 
@@ -42,6 +46,7 @@ ServerTopic* ServerStorage::CreateTopic(ServerClient* client,
     topic = m_topics[id].get();
     topic->id = id;
     topic->special = special;
+    m_sortedTopics.emplace(topic->name, topic);
 
     m_sendAnnounce(topic, client);
 
@@ -57,6 +62,24 @@ ServerTopic* ServerStorage::CreateTopic(ServerClient* client,
   return topic;
 }
 
+void ServerStorage::FindMatchingTopics(std::span<const std::string> names,
+                                       bool prefix,
+                                       std::vector<ServerTopic*>& out) const {
+  for (auto&& name : names) {
+    if (!prefix) {
+      if (auto topic = GetTopic(name)) {
+        out.emplace_back(topic);
+      }
+      continue;
+    }
+    for (auto it = m_sortedTopics.lower_bound(name);
+         it != m_sortedTopics.end() && wpi::starts_with(it->first, name);
+         ++it) {
+      out.emplace_back(it->second);
+    }
+  }
+}
+
 ServerTopic* ServerStorage::CreateMetaTopic(std::string_view name) {
   return CreateTopic(nullptr, name, "msgpack", {{"retained", true}}, true);
 }
@@ -83,6 +106,9 @@ void ServerStorage::DeleteTopic(ServerTopic* topic) {
   }
 
   // erase the topic
+  if (auto it = m_sortedTopics.find(topic->name); it != m_sortedTopics.end()) {
+    m_sortedTopics.erase(it);
+  }
   m_nameTopics.erase(topic->name);
   m_topics.erase(topic->id);
 }
@@ -93,9 +119,9 @@ void ServerStorage::SetProperties(ServerClient* client, ServerTopic* topic,
          topic->name, update.dump());
   bool wasPersistent = topic->persistent;
   if (topic->SetProperties(update)) {
-    // update persistentChanged flag
-    if (topic->persistent != wasPersistent) {
-      m_persistentChanged = true;
+    // update persistentChanged flag; properties are saved with the value
+    if (topic->persistent || wasPersistent) {
+      MarkPersistentChanged(topic);
     }
     PropertiesChanged(client, topic, update);
   }
@@ -107,7 +133,7 @@ void ServerStorage::SetFlags(ServerClient* client, ServerTopic* topic,
   if (topic->SetFlags(flags)) {
     // update persistentChanged flag
     if (topic->persistent != wasPersistent) {
-      m_persistentChanged = true;
+      MarkPersistentChanged(topic);
       wpi::json update;
       if (topic->persistent) {
         update = {{"persistent", true}};
@@ -121,6 +147,10 @@ void ServerStorage::SetFlags(ServerClient* client, ServerTopic* topic,
 
 void ServerStorage::SetValue(ServerClient* client, ServerTopic* topic,
                              const Value& value) {
+  ++topic->valuesIn;
+  topic->bytesIn += value.size();
+
+  bool updatedLastValue = false;
   // update retained value if from same client or timestamp newer
   if (topic->cached && (!topic->lastValue || topic->lastValueClient == client ||
                         topic->lastValue.time() == 0 ||
@@ -129,19 +159,80 @@ void ServerStorage::SetValue(ServerClient* client, ServerTopic* topic,
            topic->lastValue.time(), value.time());
     topic->lastValue = value;
     topic->lastValueClient = client;
+    topic->lastValueEncoded.reset();
+    topic->lastValueEncoded3.reset();
+    topic->lastValueSeq = ++m_valueSeq;
+    updatedLastValue = true;
 
     // if persistent, update flag
     if (topic->persistent) {
-      m_persistentChanged = true;
+      MarkPersistentChanged(topic);
     }
   }
 
+  // large values are encoded at most once, by the first client needing the
+  // encoding, and shared with all others (and kept for later subscribers).
+  // When the value is the new last value, send that copy, so NT3 clients can
+  // recognize it and share its cached NT3 encoding.
+  net::SharedEncodedValue encoded;
+  const Value& sendValue = updatedLastValue ? topic->lastValue : value;
   for (auto&& tcd : topic->clients) {
     if (tcd.first != client &&
         tcd.second.sendMode != net::ValueSendMode::kDisabled) {
-      tcd.first->SendValue(topic, value, tcd.second.sendMode);
+      tcd.first->SendValue(topic, sendValue, tcd.second.sendMode, encoded);
+      topic->CountValueOut(value);
     }
   }
+  if (updatedLastValue) {
+    topic->lastValueEncoded = std::move(encoded);
+  }
+}
+
+std::string ServerStorage::NewResumeToken() {
+  return fmt::format("{:x}-{:x}", m_resumeInstance, ++m_resumeTokenCount);
+}
+
+void ServerStorage::SaveResumeSession(std::string_view token, int64_t seq,
+                                      std::vector<std::string> topicNames) {
+  uint64_t now = wpi::Now() / 1000;
+
+  // expire old sessions
+  for (auto it = m_resumeSessions.begin(); it != m_resumeSessions.end();) {
+    if (it->second.expireMs <= now) {
+      it = m_resumeSessions.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  // drop the oldest session if there are too many
+  if (m_resumeSessions.size() >= kMaxResumeSessions) {
+    m_resumeSessions.erase(
+        std::min_element(m_resumeSessions.begin(), m_resumeSessions.end(),
+                         [](auto& a, auto& b) {
+                           return a.second.expireMs < b.second.expireMs;
+                         }));
+  }
+
+  std::sort(topicNames.begin(), topicNames.end());
+  m_resumeSessions.insert_or_assign(
+      token, ResumeSession{seq, now + kResumeSessionTimeoutMs,
+                           std::move(topicNames)});
+}
+
+bool ServerStorage::TakeResumeSession(std::string_view token, int64_t seq,
+                                      std::vector<std::string>* topicNames) {
+  auto it = m_resumeSessions.find(token);
+  if (it == m_resumeSessions.end()) {
+    return false;
+  }
+  bool valid =
+      it->second.expireMs > wpi::Now() / 1000 && seq <= it->second.seq;
+  if (valid) {
+    *topicNames = std::move(it->second.topicNames);
+  }
+  m_resumeSessions.erase(it);
+  return valid;
 }
 
 void ServerStorage::RemoveClient(ServerClient* client) {
@@ -228,8 +319,12 @@ void ServerStorage::PropertiesChanged(ServerClient* client, ServerTopic* topic,
     DeleteTopic(topic);
   } else {
     // send updated announcement to all subscribers
+    bool priorityChanged = update.contains("priority");
     for (auto&& tcd : topic->clients) {
       tcd.first->SendPropertiesUpdate(topic, update, tcd.first == client);
+      if (priorityChanged && !tcd.second.subscribers.empty()) {
+        tcd.first->UpdatePeriod(tcd.second, topic);
+      }
     }
   }
 }
@@ -372,6 +467,30 @@ void ServerStorage::DumpPersistent(wpi::raw_ostream& os) {
   os << "\n]\n";
 }
 
+size_t ServerStorage::DumpPersistentChanges(wpi::raw_ostream& os) {
+  wpi::json::serializer s{os, ' ', 16};
+  size_t count = 0;
+  for (auto&& entry : m_persistentDirty) {
+    os << "{\"name\": \"";
+    s.dump_escaped(entry.first, false);
+    auto topic = GetTopic(entry.first);
+    if (!topic || !topic->persistent || !topic->lastValue) {
+      os << "\", \"deleted\": true}\n";
+    } else {
+      os << "\", \"type\": \"";
+      s.dump_escaped(topic->typeStr, false);
+      os << "\", \"value\": ";
+      DumpValue(os, topic->lastValue, s);
+      os << ", \"properties\": ";
+      s.dump(topic->properties, false, false, 0);
+      os << "}\n";
+    }
+    ++count;
+  }
+  m_persistentDirty.clear();
+  return count;
+}
+
 static std::string* ObjGetString(wpi::json::object_t& obj, std::string_view key,
                                  std::string* error) {
   auto it = obj.find(key);
@@ -386,6 +505,200 @@ static std::string* ObjGetString(wpi::json::object_t& obj, std::string_view key,
   return val;
 }
 
+bool ServerStorage::LoadPersistentItem(wpi::json& jitem, int64_t time,
+                                       std::string* error) {
+  auto obj = jitem.get_ptr<wpi::json::object_t*>();
+  if (!obj) {
+    *error = "expected item to be an object";
+    return false;
+  }
+
+  // name
+  auto name = ObjGetString(*obj, "name", error);
+  if (!name) {
+    return false;
+  }
+
+  // type
+  auto typeStr = ObjGetString(*obj, "type", error);
+  if (!typeStr) {
+    return false;
+  }
+
+  // properties
+  auto propsIt = obj->find("properties");
+  if (propsIt == obj->end()) {
+    *error = "no properties key";
+    return false;
+  }
+  auto& props = propsIt->second;
+  if (!props.is_object()) {
+    *error = "properties must be an object";
+    return false;
+  }
+
+  // check to make sure persistent property is set
+  auto persistentIt = props.find("persistent");
+  if (persistentIt == props.end()) {
+    *error = "no persistent property";
+    return false;
+  }
+  if (auto v = persistentIt->get_ptr<bool*>()) {
+    if (!*v) {
+      *error = "persistent property is false";
+      return false;
+    }
+  } else {
+    *error = "persistent property is not boolean";
+    return false;
+  }
+
+  // value
+  auto valueIt = obj->find("value");
+  if (valueIt == obj->end()) {
+    *error = "no value key";
+    return false;
+  }
+  Value value;
+  if (*typeStr == "boolean") {
+    if (auto v = valueIt->second.get_ptr<bool*>()) {
+      value = Value::MakeBoolean(*v, time);
+    } else {
+      *error = "value type mismatch, expected boolean";
+      return false;
+    }
+  } else if (*typeStr == "int") {
+    if (auto v = valueIt->second.get_ptr<int64_t*>()) {
+      value = Value::MakeInteger(*v, time);
+    } else if (auto v = valueIt->second.get_ptr<uint64_t*>()) {
+      value = Value::MakeInteger(*v, time);
+    } else {
+      *error = "value type mismatch, expected int";
+      return false;
+    }
+  } else if (*typeStr == "float") {
+    if (auto v = valueIt->second.get_ptr<double*>()) {
+      value = Value::MakeFloat(*v, time);
+    } else {
+      *error = "value type mismatch, expected float";
+      return false;
+    }
+  } else if (*typeStr == "double") {
+    if (auto v = valueIt->second.get_ptr<double*>()) {
+      value = Value::MakeDouble(*v, time);
+    } else {
+      *error = "value type mismatch, expected double";
+      return false;
+    }
+  } else if (*typeStr == "string" || *typeStr == "json") {
+    if (auto v = valueIt->second.get_ptr<std::string*>()) {
+      value = Value::MakeString(*v, time);
+    } else {
+      *error = "value type mismatch, expected string";
+      return false;
+    }
+  } else if (*typeStr == "boolean[]") {
+    auto arr = valueIt->second.get_ptr<wpi::json::array_t*>();
+    if (!arr) {
+      *error = "value type mismatch, expected array";
+      return false;
+    }
+    std::vector<int> elems;
+    for (auto&& jelem : valueIt->second) {
+      if (auto v = jelem.get_ptr<bool*>()) {
+        elems.push_back(*v);
+      } else {
+        *error = "value type mismatch, expected boolean";
+      }
+    }
+    value = Value::MakeBooleanArray(elems, time);
+  } else if (*typeStr == "int[]") {
+    auto arr = valueIt->second.get_ptr<wpi::json::array_t*>();
+    if (!arr) {
+      *error = "value type mismatch, expected array";
+      return false;
+    }
+    std::vector<int64_t> elems;
+    for (auto&& jelem : valueIt->second) {
+      if (auto v = jelem.get_ptr<int64_t*>()) {
+        elems.push_back(*v);
+      } else if (auto v = jelem.get_ptr<uint64_t*>()) {
+        elems.push_back(*v);
+      } else {
+        *error = "value type mismatch, expected int";
+      }
+    }
+    value = Value::MakeIntegerArray(elems, time);
+  } else if (*typeStr == "double[]") {
+    auto arr = valueIt->second.get_ptr<wpi::json::array_t*>();
+    if (!arr) {
+      *error = "value type mismatch, expected array";
+      return false;
+    }
+    std::vector<double> elems;
+    for (auto&& jelem : valueIt->second) {
+      if (auto v = jelem.get_ptr<double*>()) {
+        elems.push_back(*v);
+      } else {
+        *error = "value type mismatch, expected double";
+      }
+    }
+    value = Value::MakeDoubleArray(elems, time);
+  } else if (*typeStr == "float[]") {
+    auto arr = valueIt->second.get_ptr<wpi::json::array_t*>();
+    if (!arr) {
+      *error = "value type mismatch, expected array";
+      return false;
+    }
+    std::vector<float> elems;
+    for (auto&& jelem : valueIt->second) {
+      if (auto v = jelem.get_ptr<double*>()) {
+        elems.push_back(*v);
+      } else {
+        *error = "value type mismatch, expected float";
+      }
+    }
+    value = Value::MakeFloatArray(elems, time);
+  } else if (*typeStr == "string[]") {
+    auto arr = valueIt->second.get_ptr<wpi::json::array_t*>();
+    if (!arr) {
+      *error = "value type mismatch, expected array";
+      return false;
+    }
+    std::vector<std::string> elems;
+    for (auto&& jelem : valueIt->second) {
+      if (auto v = jelem.get_ptr<std::string*>()) {
+        elems.emplace_back(*v);
+      } else {
+        *error = "value type mismatch, expected string";
+      }
+    }
+    value = Value::MakeStringArray(std::move(elems), time);
+  } else {
+    // raw
+    if (auto v = valueIt->second.get_ptr<std::string*>()) {
+      std::vector<uint8_t> data;
+      wpi::Base64Decode(*v, &data);
+      value = Value::MakeRaw(std::move(data), time);
+    } else {
+      *error = "value type mismatch, expected string";
+      return false;
+    }
+  }
+
+  // create persistent topic; when replaying changes, the topic may already
+  // exist with older properties
+  auto topic = CreateTopic(nullptr, *name, *typeStr, props);
+  if (topic->properties != props) {
+    topic->properties = props;
+    topic->RefreshProperties();
+  }
+
+  // set value
+  SetValue(nullptr, topic, value);
+  return true;
+}
+
 std::string ServerStorage::LoadPersistent(std::string_view in) {
   if (in.empty()) {
     return {};
@@ -410,199 +723,67 @@ std::string ServerStorage::LoadPersistent(std::string_view in) {
   for (auto&& jitem : j) {
     ++i;
     std::string error;
-    {
-      auto obj = jitem.get_ptr<wpi::json::object_t*>();
-      if (!obj) {
-        error = "expected item to be an object";
-        goto err;
-      }
-
-      // name
-      auto name = ObjGetString(*obj, "name", &error);
-      if (!name) {
-        goto err;
-      }
-
-      // type
-      auto typeStr = ObjGetString(*obj, "type", &error);
-      if (!typeStr) {
-        goto err;
-      }
+    if (!LoadPersistentItem(jitem, time, &error)) {
+      allerrors += fmt::format("{}: {}\n", i, error);
+    }
+  }
 
-      // properties
-      auto propsIt = obj->find("properties");
-      if (propsIt == obj->end()) {
-        error = "no properties key";
-        goto err;
-      }
-      auto& props = propsIt->second;
-      if (!props.is_object()) {
-        error = "properties must be an object";
-        goto err;
-      }
+  m_persistentChanged = persistentChanged;  // restore flag
+  if (!persistentChanged) {
+    m_persistentDirty.clear();
+  }
 
-      // check to make sure persistent property is set
-      auto persistentIt = props.find("persistent");
-      if (persistentIt == props.end()) {
-        error = "no persistent property";
-        goto err;
-      }
-      if (auto v = persistentIt->get_ptr<bool*>()) {
-        if (!*v) {
-          error = "persistent property is false";
-          goto err;
-        }
-      } else {
-        error = "persistent property is not boolean";
-        goto err;
-      }
+  return allerrors;
+}
 
-      // value
-      auto valueIt = obj->find("value");
-      if (valueIt == obj->end()) {
-        error = "no value key";
-        goto err;
-      }
-      Value value;
-      if (*typeStr == "boolean") {
-        if (auto v = valueIt->second.get_ptr<bool*>()) {
-          value = Value::MakeBoolean(*v, time);
-        } else {
-          error = "value type mismatch, expected boolean";
-          goto err;
-        }
-      } else if (*typeStr == "int") {
-        if (auto v = valueIt->second.get_ptr<int64_t*>()) {
-          value = Value::MakeInteger(*v, time);
-        } else if (auto v = valueIt->second.get_ptr<uint64_t*>()) {
-          value = Value::MakeInteger(*v, time);
-        } else {
-          error = "value type mismatch, expected int";
-          goto err;
-        }
-      } else if (*typeStr == "float") {
-        if (auto v = valueIt->second.get_ptr<double*>()) {
-          value = Value::MakeFloat(*v, time);
-        } else {
-          error = "value type mismatch, expected float";
-          goto err;
-        }
-      } else if (*typeStr == "double") {
-        if (auto v = valueIt->second.get_ptr<double*>()) {
-          value = Value::MakeDouble(*v, time);
-        } else {
-          error = "value type mismatch, expected double";
-          goto err;
-        }
-      } else if (*typeStr == "string" || *typeStr == "json") {
-        if (auto v = valueIt->second.get_ptr<std::string*>()) {
-          value = Value::MakeString(*v, time);
-        } else {
-          error = "value type mismatch, expected string";
-          goto err;
-        }
-      } else if (*typeStr == "boolean[]") {
-        auto arr = valueIt->second.get_ptr<wpi::json::array_t*>();
-        if (!arr) {
-          error = "value type mismatch, expected array";
-          goto err;
-        }
-        std::vector<int> elems;
-        for (auto&& jelem : valueIt->second) {
-          if (auto v = jelem.get_ptr<bool*>()) {
-            elems.push_back(*v);
-          } else {
-            error = "value type mismatch, expected boolean";
-          }
-        }
-        value = Value::MakeBooleanArray(elems, time);
-      } else if (*typeStr == "int[]") {
-        auto arr = valueIt->second.get_ptr<wpi::json::array_t*>();
-        if (!arr) {
-          error = "value type mismatch, expected array";
-          goto err;
-        }
-        std::vector<int64_t> elems;
-        for (auto&& jelem : valueIt->second) {
-          if (auto v = jelem.get_ptr<int64_t*>()) {
-            elems.push_back(*v);
-          } else if (auto v = jelem.get_ptr<uint64_t*>()) {
-            elems.push_back(*v);
-          } else {
-            error = "value type mismatch, expected int";
-          }
-        }
-        value = Value::MakeIntegerArray(elems, time);
-      } else if (*typeStr == "double[]") {
-        auto arr = valueIt->second.get_ptr<wpi::json::array_t*>();
-        if (!arr) {
-          error = "value type mismatch, expected array";
-          goto err;
-        }
-        std::vector<double> elems;
-        for (auto&& jelem : valueIt->second) {
-          if (auto v = jelem.get_ptr<double*>()) {
-            elems.push_back(*v);
-          } else {
-            error = "value type mismatch, expected double";
-          }
-        }
-        value = Value::MakeDoubleArray(elems, time);
-      } else if (*typeStr == "float[]") {
-        auto arr = valueIt->second.get_ptr<wpi::json::array_t*>();
-        if (!arr) {
-          error = "value type mismatch, expected array";
-          goto err;
-        }
-        std::vector<float> elems;
-        for (auto&& jelem : valueIt->second) {
-          if (auto v = jelem.get_ptr<double*>()) {
-            elems.push_back(*v);
-          } else {
-            error = "value type mismatch, expected float";
-          }
-        }
-        value = Value::MakeFloatArray(elems, time);
-      } else if (*typeStr == "string[]") {
-        auto arr = valueIt->second.get_ptr<wpi::json::array_t*>();
-        if (!arr) {
-          error = "value type mismatch, expected array";
-          goto err;
-        }
-        std::vector<std::string> elems;
-        for (auto&& jelem : valueIt->second) {
-          if (auto v = jelem.get_ptr<std::string*>()) {
-            elems.emplace_back(*v);
-          } else {
-            error = "value type mismatch, expected string";
-          }
-        }
-        value = Value::MakeStringArray(std::move(elems), time);
-      } else {
-        // raw
-        if (auto v = valueIt->second.get_ptr<std::string*>()) {
-          std::vector<uint8_t> data;
-          wpi::Base64Decode(*v, &data);
-          value = Value::MakeRaw(std::move(data), time);
-        } else {
-          error = "value type mismatch, expected string";
-          goto err;
-        }
-      }
+std::string ServerStorage::LoadPersistentChanges(std::string_view in) {
+  bool persistentChanged = m_persistentChanged;
 
-      // create persistent topic
-      auto topic = CreateTopic(nullptr, *name, *typeStr, props);
+  std::string allerrors;
+  int lineNum = 0;
+  auto time = nt::Now();
+  while (!in.empty()) {
+    std::string_view line;
+    std::tie(line, in) = wpi::split(in, '\n');
+    ++lineNum;
+    line = wpi::trim(line);
+    if (line.empty()) {
+      continue;
+    }
 
-      // set value
-      SetValue(nullptr, topic, value);
+    wpi::json jitem;
+    try {
+      jitem = wpi::json::parse(line);
+    } catch (wpi::json::parse_error& err) {
+      // a torn final line is expected if we were stopped mid-append
+      allerrors += fmt::format("{}: could not decode JSON: {}\n", lineNum,
+                               err.what());
+      continue;
+    }
 
+    // removal of a persistent topic
+    if (auto obj = jitem.get_ptr<wpi::json::object_t*>();
+        obj && obj->contains("deleted")) {
+      std::string error;
+      auto name = ObjGetString(*obj, "name", &error);
+      if (!name) {
+        allerrors += fmt::format("{}: {}\n", lineNum, error);
+      } else if (auto topic = GetTopic(*name); topic && topic->persistent) {
+        SetProperties(nullptr, topic, {{"persistent", nullptr}});
+      }
       continue;
     }
-  err:
-    allerrors += fmt::format("{}: {}\n", i, error);
+
+    std::string error;
+    if (!LoadPersistentItem(jitem, time, &error)) {
+      allerrors += fmt::format("{}: {}\n", lineNum, error);
+    }
   }
 
   m_persistentChanged = persistentChanged;  // restore flag
+  if (!persistentChanged) {
+    m_persistentDirty.clear();
+  }
 
   return allerrors;
 }
@@ -4,14 +4,20 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #include <concepts>
+#include <map>
+#include <span>
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include <wpi/StringMap.h>
 #include <wpi/UidVector.h>
 #include <wpi/json_fwd.h>
+#include <wpi/timestamp.h>
 
 #include "server/ServerTopic.h"
 
@@ -29,7 +35,9 @@ class ServerStorage final {
   ServerStorage(wpi::Logger& logger,
                 std::function<void(ServerTopic* topic, ServerClient* client)>
                     sendAnnounce)
-      : m_logger{logger}, m_sendAnnounce{std::move(sendAnnounce)} {}
+      : m_logger{logger},
+        m_sendAnnounce{std::move(sendAnnounce)},
+        m_resumeInstance{wpi::Now()} {}
   ServerStorage(const ServerStorage&) = delete;
   ServerStorage& operator=(const ServerStorage&) = delete;
 
@@ -68,6 +76,13 @@ class ServerStorage final {
     }
   }
 
+  // Appends to out each topic that may be matched by a subscription to the
+  // given names (exact names, or prefixes if prefix is true). Looks up only
+  // the matching names rather than walking all topics. out may contain
+  // duplicates if prefixes overlap.
+  void FindMatchingTopics(std::span<const std::string> names, bool prefix,
+                          std::vector<ServerTopic*>& out) const;
+
   // update meta topic values from data structures
   void UpdateMetaTopicPub(ServerTopic* topic);
   void UpdateMetaTopicSub(ServerTopic* topic);
@@ -79,17 +94,62 @@ class ServerStorage final {
     return rv;
   }
 
+  // sequence number of the most recent last value update of any topic
+  int64_t GetValueSeq() const { return m_valueSeq; }
+
+  // returns a token unique to this server instance, for resume checkpoints
+  std::string NewResumeToken();
+  // records the topics a disconnecting client had last values for (as of
+  // seq), so the client can skip receiving them again if it reconnects
+  void SaveResumeSession(std::string_view token, int64_t seq,
+                         std::vector<std::string> topicNames);
+  // removes and returns the topic names of an unexpired session, if seq is
+  // not newer than the session; returns false if the session cannot be
+  // resumed
+  bool TakeResumeSession(std::string_view token, int64_t seq,
+                         std::vector<std::string>* topicNames);
+
   void DumpPersistent(wpi::raw_ostream& os);
   // returns newline-separated errors
   std::string LoadPersistent(std::string_view in);
 
+  // Writes one JSON object per line for each persistent topic changed since
+  // the last call to this function (topics that are no longer persistent are
+  // written as deleted).  Returns the number of lines written.
+  size_t DumpPersistentChanges(wpi::raw_ostream& os);
+  // Applies lines written by DumpPersistentChanges() on top of the current
+  // state; returns newline-separated errors
+  std::string LoadPersistentChanges(std::string_view in);
+
  private:
+  void MarkPersistentChanged(ServerTopic* topic) {
+    m_persistentChanged = true;
+    m_persistentDirty.try_emplace(topic->name);
+  }
+  // returns false and sets error if the item could not be loaded
+  bool LoadPersistentItem(wpi::json& jitem, int64_t time, std::string* error);
+
   wpi::Logger& m_logger;
   std::function<void(ServerTopic* topic, ServerClient* client)> m_sendAnnounce;
 
   wpi::UidVector<std::unique_ptr<ServerTopic>, 16> m_topics;
   wpi::StringMap<ServerTopic*> m_nameTopics;
+  // sorted by name, for prefix lookup
+  std::map<std::string, ServerTopic*, std::less<>> m_sortedTopics;
   bool m_persistentChanged{false};
+  // names of persistent topics changed since last DumpPersistentChanges()
+  wpi::StringMap<char> m_persistentDirty;
+
+  int64_t m_valueSeq{0};
+
+  struct ResumeSession {
+    int64_t seq;
+    uint64_t expireMs;
+    std::vector<std::string> topicNames;  // sorted
+  };
+  uint64_t m_resumeInstance;
+  uint64_t m_resumeTokenCount{0};
+  wpi::StringMap<ResumeSession> m_resumeSessions;
 };
 
 }  // namespace nt::server
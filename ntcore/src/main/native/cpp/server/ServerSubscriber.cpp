@@ -20,7 +20,7 @@ static void WriteOptions(mpack_writer_t& w, const PubSubOptionsImpl& options) {
   int size =
       (options.sendAll ? 1 : 0) + (options.topicsOnly ? 1 : 0) +
       (options.periodicMs != PubSubOptionsImpl::kDefaultPeriodicMs ? 1 : 0) +
-      (options.prefixMatch ? 1 : 0);
+      (options.prefixMatch ? 1 : 0) + (options.deltaArrays ? 1 : 0);
   mpack_start_map(&w, size);
   if (options.sendAll) {
     mpack_write_str(&w, "all");
@@ -38,6 +38,10 @@ static void WriteOptions(mpack_writer_t& w, const PubSubOptionsImpl& options) {
     mpack_write_str(&w, "prefix");
     mpack_write_bool(&w, true);
   }
+  if (options.deltaArrays) {
+    mpack_write_str(&w, "deltas");
+    mpack_write_bool(&w, true);
+  }
   mpack_finish_map(&w);
 }
 
@@ -31,6 +31,7 @@ void ServerTopic::RefreshProperties() {
   persistent = false;
   retained = false;
   cached = true;
+  priority = net::SendPriority::kTelemetry;
 
   auto persistentIt = properties.find("persistent");
   if (persistentIt != properties.end()) {
@@ -53,6 +54,17 @@ void ServerTopic::RefreshProperties() {
     }
   }
 
+  auto priorityIt = properties.find("priority");
+  if (priorityIt != properties.end()) {
+    if (auto val = priorityIt->get_ptr<std::string*>()) {
+      if (*val == "critical") {
+        priority = net::SendPriority::kCritical;
+      } else if (*val == "bulk") {
+        priority = net::SendPriority::kBulk;
+      }
+    }
+  }
+
   if (!cached) {
     lastValue = {};
     lastValueClient = nullptr;
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #include <string>
 #include <string_view>
 #include <utility>
@@ -72,7 +74,11 @@ struct ServerTopic {
   std::string name;
   unsigned int id;
   Value lastValue;
+  net::SharedEncodedValue lastValueEncoded;  // may be null
+  // NT3 encoding of lastValue (net3::WireEncodeValue); may be null
+  net::SharedEncodedValue lastValueEncoded3;
   ServerClient* lastValueClient = nullptr;
+  int64_t lastValueSeq{0};  // ServerStorage value sequence of lastValue
   std::string typeStr;
   wpi::json properties = wpi::json::object();
   unsigned int publisherCount{0};
@@ -80,8 +86,21 @@ struct ServerTopic {
   bool retained{false};
   bool cached{true};
   bool special{false};
+  net::SendPriority priority{net::SendPriority::kTelemetry};
   int localTopic{0};
 
+  // statistics: values received from publishers, and values forwarded to
+  // subscribed clients (before any coalescing in outgoing queues)
+  uint64_t valuesIn{0};
+  uint64_t bytesIn{0};
+  uint64_t valuesOut{0};
+  uint64_t bytesOut{0};
+
+  void CountValueOut(const Value& value) {
+    ++valuesOut;
+    bytesOut += value.size();
+  }
+
   void AddPublisher(ServerClient* client, ServerPublisher* pub) {
     if (clients[client].publishers.insert(pub).second) {
       ++publisherCount;
@@ -416,6 +416,35 @@ class NetworkTableInstance final {
     return ::nt::GetTopicInfo(m_handle, prefix, types);
   }
 
+  /**
+   * Get the cached values of all scalar (boolean, integer, float, and double)
+   * topics. This is much faster than getting the value of each topic
+   * individually.
+   *
+   * @param types   bitmask of NT_Type values; 0 is treated specially
+   *                as a "don't care"
+   * @return Array of topic handle and value pairs.
+   */
+  std::vector<std::pair<NT_Topic, Value>> GetScalarTopicValues(
+      unsigned int types = 0) {
+    return ::nt::GetScalarTopicValues(m_handle, types);
+  }
+
+  /**
+   * Creates publishers to multiple topics at once. This is much faster than
+   * publishing each topic individually when creating many publishers (e.g.
+   * at startup). Typed publishers can be constructed from the returned
+   * handles, e.g. DoublePublisher{handle}.
+   *
+   * @param requests topic names, types, properties, and options
+   * @return Publisher handles, in the same order as requests; 0 for any
+   *         request that failed
+   */
+  std::vector<NT_Publisher> PublishMultiple(
+      std::span<const PublishRequest> requests) {
+    return ::nt::PublishMultiple(m_handle, requests);
+  }
+
   /**
    * Gets the entry for a key.
    *
@@ -462,6 +491,20 @@ class NetworkTableInstance final {
     return ::nt::WaitForListenerQueue(m_handle, timeout);
   }
 
+  /**
+   * Sets the number of threads used to run listener callbacks.  With the
+   * default of 1, all callbacks run on a single thread, one at a time.  With
+   * larger values, callback listeners added afterwards are assigned to the
+   * threads in turn, so a slow callback only delays listeners on the same
+   * thread.  Callbacks for any one listener always run on the same thread, in
+   * order; callbacks for different listeners may run concurrently.
+   *
+   * @param count  number of listener threads
+   */
+  void SetListenerThreads(unsigned int count) {
+    ::nt::SetListenerThreads(m_handle, count);
+  }
+
   /**
    * Add a connection listener. The callback function is called asynchronously
    * on a separate thread, so it's important to use synchronization or atomics
@@ -626,6 +669,31 @@ class NetworkTableInstance final {
    */
   void StopServer() { ::nt::StopServer(m_handle); }
 
+  /**
+   * Sets the number of I/O threads the server uses for NT4 client connections.
+   * With the default of 1, all connections are serviced by the single server
+   * thread.  Larger values spread NT4 client connections across that many
+   * additional event loop threads.  Takes effect the next time the server is
+   * started.  Ignored on Windows.
+   *
+   * @param count  number of I/O threads
+   */
+  void SetServerIoThreads(unsigned int count) {
+    ::nt::SetServerIoThreads(m_handle, count);
+  }
+
+  /**
+   * Sets the approximate outgoing bandwidth limit the server applies to each
+   * (non-local) NT4 client connection.  Topics with a "priority" property of
+   * "critical" are always sent; "bulk" topics are deferred first when over
+   * budget.  Takes effect for connections made after this call.
+   *
+   * @param bytesPerSec  bytes per second; 0 (the default) for no limit
+   */
+  void SetServerBandwidthLimit(unsigned int bytesPerSec) {
+    ::nt::SetServerBandwidthLimit(m_handle, bytesPerSec);
+  }
+
   /**
    * Starts a NT3 client.  Use SetServer or SetServerTeam to set the server name
    * and port.
@@ -761,6 +829,19 @@ class NetworkTableInstance final {
     return ::nt::GetServerTimeOffset(m_handle);
   }
 
+  /**
+   * Get the time offset between server time and local time, and its
+   * uncertainty. This is the same data as the most recent "time sync" event.
+   * In server mode, the offset and uncertainty are always 0. In client mode,
+   * the data is valid only if the client and server are connected and have
+   * exchanged synchronization messages.
+   *
+   * @return Time sync data
+   */
+  TimeSyncEventData GetServerTimeSync() const {
+    return ::nt::GetServerTimeSync(m_handle);
+  }
+
   /** @} */
 
   /**
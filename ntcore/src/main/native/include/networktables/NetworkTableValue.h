@@ -8,6 +8,7 @@
 
 #include <cassert>
 #include <concepts>
+#include <cstring>
 #include <initializer_list>
 #include <memory>
 #include <span>
@@ -72,6 +73,44 @@ class Value final {
     }
   }
 
+  Value(const Value& other)
+      : m_val{other.m_val},
+        m_storage{other.m_storage},
+        m_size{other.m_size},
+        m_isInline{other.m_isInline} {
+    CopyInline(other);
+  }
+
+  Value(Value&& other) noexcept
+      : m_val{other.m_val},
+        m_storage{std::move(other.m_storage)},
+        m_size{other.m_size},
+        m_isInline{other.m_isInline} {
+    CopyInline(other);
+  }
+
+  Value& operator=(const Value& other) {
+    if (this != &other) {
+      m_val = other.m_val;
+      m_storage = other.m_storage;
+      m_size = other.m_size;
+      m_isInline = other.m_isInline;
+      CopyInline(other);
+    }
+    return *this;
+  }
+
+  Value& operator=(Value&& other) noexcept {
+    if (this != &other) {
+      m_val = other.m_val;
+      m_storage = std::move(other.m_storage);
+      m_size = other.m_size;
+      m_isInline = other.m_isInline;
+      CopyInline(other);
+    }
+    return *this;
+  }
+
   explicit operator bool() const { return m_val.type != NT_UNASSIGNED; }
 
   /**
@@ -409,14 +448,7 @@ class Value final {
    *             time)
    * @return The entry value
    */
-  static Value MakeString(std::string_view value, int64_t time = 0) {
-    auto data = std::make_shared<std::string>(value);
-    Value val{NT_STRING, data->capacity(), time, private_init{}};
-    val.m_val.data.v_string.str = const_cast<char*>(data->c_str());
-    val.m_val.data.v_string.len = data->size();
-    val.m_storage = std::move(data);
-    return val;
-  }
+  static Value MakeString(std::string_view value, int64_t time = 0);
 
   /**
    * Creates a string entry value.
@@ -428,6 +460,9 @@ class Value final {
    */
   template <std::same_as<std::string> T>
   static Value MakeString(T&& value, int64_t time = 0) {
+    if (value.size() < kInlineSize) {
+      return MakeString(std::string_view{value}, time);
+    }
     auto data = std::make_shared<std::string>(std::forward<T>(value));
     Value val{NT_STRING, data->capacity(), time, private_init{}};
     val.m_val.data.v_string.str = const_cast<char*>(data->c_str());
@@ -444,15 +479,7 @@ class Value final {
    *             time)
    * @return The entry value
    */
-  static Value MakeRaw(std::span<const uint8_t> value, int64_t time = 0) {
-    auto data =
-        std::make_shared<std::vector<uint8_t>>(value.begin(), value.end());
-    Value val{NT_RAW, data->capacity(), time, private_init{}};
-    val.m_val.data.v_raw.data = const_cast<uint8_t*>(data->data());
-    val.m_val.data.v_raw.size = data->size();
-    val.m_storage = std::move(data);
-    return val;
-  }
+  static Value MakeRaw(std::span<const uint8_t> value, int64_t time = 0);
 
   /**
    * Creates a raw entry value.
@@ -464,6 +491,9 @@ class Value final {
    */
   template <std::same_as<std::vector<uint8_t>> T>
   static Value MakeRaw(T&& value, int64_t time = 0) {
+    if (value.size() <= kInlineSize) {
+      return MakeRaw(std::span<const uint8_t>{value}, time);
+    }
     auto data = std::make_shared<std::vector<uint8_t>>(std::forward<T>(value));
     Value val{NT_RAW, data->capacity(), time, private_init{}};
     val.m_val.data.v_raw.data = const_cast<uint8_t*>(data->data());
@@ -472,6 +502,24 @@ class Value final {
     return val;
   }
 
+  /**
+   * Creates a raw entry value by writing the contents in place. This avoids
+   * copying the data from an intermediate buffer.
+   *
+   * @param size size of the value, in bytes
+   * @param fill function called with the (uninitialized) value contents;
+   *             must write all size bytes
+   * @param time if nonzero, the creation time to use (instead of the current
+   *             time)
+   * @return The entry value
+   */
+  template <std::invocable<std::span<uint8_t>> F>
+  static Value MakeRaw(size_t size, F&& fill, int64_t time = 0) {
+    Value val = AllocateRaw(size, time);
+    fill(std::span<uint8_t>{val.m_val.data.v_raw.data, size});
+    return val;
+  }
+
   /**
    * Creates a boolean array entry value.
    *
@@ -678,9 +726,50 @@ class Value final {
   friend bool operator==(const Value& lhs, const Value& rhs);
 
  private:
+  // Payloads up to this many bytes (including the string terminator) are
+  // stored in the Value itself rather than in a separate allocation
+  static constexpr size_t kInlineSize = 32;
+
+  static Value AllocateRaw(size_t size, int64_t time);
+
+  template <typename T>
+  T* AllocateArray(size_t nelem);
+
+  // Copies the inline payload of other and points m_val at our copy
+  void CopyInline(const Value& other) {
+    if (!m_isInline) {
+      return;
+    }
+    std::memcpy(m_inline, other.m_inline, kInlineSize);
+    switch (m_val.type) {
+      case NT_STRING:
+        m_val.data.v_string.str = reinterpret_cast<char*>(m_inline);
+        break;
+      case NT_RAW:
+        m_val.data.v_raw.data = m_inline;
+        break;
+      case NT_BOOLEAN_ARRAY:
+        m_val.data.arr_boolean.arr = reinterpret_cast<int*>(m_inline);
+        break;
+      case NT_INTEGER_ARRAY:
+        m_val.data.arr_int.arr = reinterpret_cast<int64_t*>(m_inline);
+        break;
+      case NT_FLOAT_ARRAY:
+        m_val.data.arr_float.arr = reinterpret_cast<float*>(m_inline);
+        break;
+      case NT_DOUBLE_ARRAY:
+        m_val.data.arr_double.arr = reinterpret_cast<double*>(m_inline);
+        break;
+      default:
+        break;
+    }
+  }
+
   NT_Value m_val = {};
   std::shared_ptr<void> m_storage;
   size_t m_size = 0;
+  bool m_isInline = false;
+  alignas(8) uint8_t m_inline[kInlineSize];
 };
 
 #if __GNUC__ >= 13
@@ -105,7 +105,8 @@ class ProtobufSubscriber : public Subscriber {
       return false;
     } else {
       std::scoped_lock lock{m_mutex};
-      return m_msg.UnpackInto(out, view.value);
+      m_arena.Reset();
+      return m_msg.UnpackInto(out, view.value, m_arena);
     }
   }
 
@@ -131,7 +132,8 @@ class ProtobufSubscriber : public Subscriber {
     TimestampedRawView view = ::nt::GetAtomicRaw(m_subHandle, buf, {});
     if (!view.value.empty()) {
       std::scoped_lock lock{m_mutex};
-      if (auto optval = m_msg.Unpack(view.value)) {
+      m_arena.Reset();
+      if (auto optval = m_msg.Unpack(view.value, m_arena)) {
         return {view.time, view.serverTime, *optval};
       }
     }
@@ -155,7 +157,8 @@ class ProtobufSubscriber : public Subscriber {
     rv.reserve(raw.size());
     std::scoped_lock lock{m_mutex};
     for (auto&& r : raw) {
-      if (auto optval = m_msg.Unpack(r.value)) {
+      m_arena.Reset();
+      if (auto optval = m_msg.Unpack(r.value, m_arena)) {
         rv.emplace_back(r.time, r.serverTime, *optval);
       }
     }
@@ -174,6 +177,8 @@ class ProtobufSubscriber : public Subscriber {
  private:
   mutable wpi::mutex m_mutex;
   mutable wpi::ProtobufMessage<T> m_msg;
+  // scratch space for decoding; not moved with the subscriber
+  mutable wpi::ProtobufArena m_arena;
   ValueType m_defaultValue;
 };
 
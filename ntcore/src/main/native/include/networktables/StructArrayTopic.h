@@ -7,6 +7,8 @@
 #include <stdint.h>
 
 #include <atomic>
+#include <concepts>
+#include <cstring>
 #include <functional>
 #include <memory>
 #include <ranges>
@@ -15,9 +17,7 @@
 #include <utility>
 #include <vector>
 
-#include <wpi/SmallVector.h>
 #include <wpi/json_fwd.h>
-#include <wpi/mutex.h>
 #include <wpi/struct/Struct.h>
 
 #include "networktables/NetworkTableInstance.h"
@@ -126,24 +126,14 @@ class StructArraySubscriber : public Subscriber {
              std::convertible_to<std::ranges::range_value_t<U>, T>
 #endif
   TimestampedValueType GetAtomic(U&& defaultValue) const {
-    wpi::SmallVector<uint8_t, 128> buf;
+    // the value shares its buffer with storage, so nothing is copied
+    Value value = ::nt::GetEntryValue(m_subHandle);
     size_t size = std::apply(S::GetSize, m_info);
-    TimestampedRawView view = ::nt::GetAtomicRaw(m_subHandle, buf, {});
-    if (view.value.size() == 0 || (view.value.size() % size) != 0) {
+    if (!value.IsRaw() || value.GetRaw().size() == 0 ||
+        (value.GetRaw().size() % size) != 0) {
       return {0, 0, std::forward<U>(defaultValue)};
     }
-    TimestampedValueType rv{view.time, view.serverTime, {}};
-    rv.value.reserve(view.value.size() / size);
-    for (auto in = view.value.begin(), end = view.value.end(); in != end;
-         in += size) {
-      std::apply(
-          [&](const I&... info) {
-            rv.value.emplace_back(S::Unpack(
-                std::span<const uint8_t>{std::to_address(in), size}, info...));
-          },
-          m_info);
-    }
-    return rv;
+    return {value.time(), value.server_time(), Unpack(value.GetRaw())};
   }
 
   /**
@@ -155,24 +145,14 @@ class StructArraySubscriber : public Subscriber {
    * @return timestamped value
    */
   TimestampedValueType GetAtomic(std::span<const T> defaultValue) const {
-    wpi::SmallVector<uint8_t, 128> buf;
+    // the value shares its buffer with storage, so nothing is copied
+    Value value = ::nt::GetEntryValue(m_subHandle);
     size_t size = std::apply(S::GetSize, m_info);
-    TimestampedRawView view = ::nt::GetAtomicRaw(m_subHandle, buf, {});
-    if (view.value.size() == 0 || (view.value.size() % size) != 0) {
+    if (!value.IsRaw() || value.GetRaw().size() == 0 ||
+        (value.GetRaw().size() % size) != 0) {
       return {0, 0, {defaultValue.begin(), defaultValue.end()}};
     }
-    TimestampedValueType rv{view.time, view.serverTime, {}};
-    rv.value.reserve(view.value.size() / size);
-    for (auto in = view.value.begin(), end = view.value.end(); in != end;
-         in += size) {
-      std::apply(
-          [&](const I&... info) {
-            rv.value.emplace_back(S::Unpack(
-                std::span<const uint8_t>{std::to_address(in), size}, info...));
-          },
-          m_info);
-    }
-    return rv;
+    return {value.time(), value.server_time(), Unpack(value.GetRaw())};
   }
 
   /**
@@ -187,27 +167,15 @@ class StructArraySubscriber : public Subscriber {
    *     have been published since the previous call.
    */
   std::vector<TimestampedValueType> ReadQueue() {
-    auto raw = ::nt::ReadQueueRaw(m_subHandle);
+    auto raw = ::nt::ReadQueueValue(m_subHandle, NT_RAW);
     std::vector<TimestampedValueType> rv;
     rv.reserve(raw.size());
     size_t size = std::apply(S::GetSize, m_info);
     for (auto&& r : raw) {
-      if (r.value.size() == 0 || (r.value.size() % size) != 0) {
+      if (r.GetRaw().size() == 0 || (r.GetRaw().size() % size) != 0) {
         continue;
       }
-      std::vector<T> values;
-      values.reserve(r.value.size() / size);
-      for (auto in = r.value.begin(), end = r.value.end(); in != end;
-           in += size) {
-        std::apply(
-            [&](const I&... info) {
-              values.emplace_back(
-                  S::Unpack(std::span<const uint8_t>{std::to_address(in), size},
-                            info...));
-            },
-            m_info);
-      }
-      rv.emplace_back(r.time, r.serverTime, std::move(values));
+      rv.emplace_back(r.time(), r.server_time(), Unpack(r.GetRaw()));
     }
     return rv;
   }
@@ -227,6 +195,27 @@ class StructArraySubscriber : public Subscriber {
   }
 
  private:
+  // data size must be a multiple of the struct size
+  ValueType Unpack(std::span<const uint8_t> data) const {
+    size_t size = std::apply(S::GetSize, m_info);
+    ValueType rv;
+    if constexpr (wpi::LayoutCompatibleStruct<T, I...>) {
+      rv.resize(data.size() / size);
+      std::memcpy(rv.data(), data.data(), rv.size() * size);
+      return rv;
+    }
+    rv.reserve(data.size() / size);
+    for (auto in = data.begin(), end = data.end(); in != end; in += size) {
+      std::apply(
+          [&](const I&... info) {
+            rv.emplace_back(S::Unpack(
+                std::span<const uint8_t>{std::to_address(in), size}, info...));
+          },
+          m_info);
+    }
+    return rv;
+  }
+
   ValueType m_defaultValue;
   [[no_unique_address]]
   std::tuple<I...> m_info;
@@ -264,14 +253,12 @@ class StructArrayPublisher : public Publisher {
 
   StructArrayPublisher(StructArrayPublisher&& rhs)
       : Publisher{std::move(rhs)},
-        m_buf{std::move(rhs.m_buf)},
         m_schemaPublished{
             rhs.m_schemaPublished.load(std::memory_order_relaxed)},
         m_info{std::move(rhs.m_info)} {}
 
   StructArrayPublisher& operator=(StructArrayPublisher&& rhs) {
     Publisher::operator=(std::move(rhs));
-    m_buf = std::move(rhs.m_buf);
     m_schemaPublished.store(
         rhs.m_schemaPublished.load(std::memory_order_relaxed),
         std::memory_order_relaxed);
@@ -296,10 +283,8 @@ class StructArrayPublisher : public Publisher {
           if (!m_schemaPublished.exchange(true, std::memory_order_relaxed)) {
             GetTopic().GetInstance().template AddStructSchema<T>(info...);
           }
-          m_buf.Write(
-              std::forward<U>(value),
-              [&](auto bytes) { ::nt::SetRaw(m_pubHandle, bytes, time); },
-              info...);
+          ::nt::SetEntryValue(m_pubHandle,
+                              MakeValue(std::forward<U>(value), time, info...));
         },
         m_info);
   }
@@ -316,10 +301,7 @@ class StructArrayPublisher : public Publisher {
           if (!m_schemaPublished.exchange(true, std::memory_order_relaxed)) {
             GetTopic().GetInstance().template AddStructSchema<T>(info...);
           }
-          m_buf.Write(
-              value,
-              [&](auto bytes) { ::nt::SetRaw(m_pubHandle, bytes, time); },
-              info...);
+          ::nt::SetEntryValue(m_pubHandle, MakeValue(value, time, info...));
         },
         m_info);
   }
@@ -342,10 +324,8 @@ class StructArrayPublisher : public Publisher {
           if (!m_schemaPublished.exchange(true, std::memory_order_relaxed)) {
             GetTopic().GetInstance().template AddStructSchema<T>(info...);
           }
-          m_buf.Write(
-              std::forward<U>(value),
-              [&](auto bytes) { ::nt::SetDefaultRaw(m_pubHandle, bytes); },
-              info...);
+          ::nt::SetDefaultEntryValue(
+              m_pubHandle, MakeValue(std::forward<U>(value), 1, info...));
         },
         m_info);
   }
@@ -363,10 +343,7 @@ class StructArrayPublisher : public Publisher {
           if (!m_schemaPublished.exchange(true, std::memory_order_relaxed)) {
             GetTopic().GetInstance().template AddStructSchema<T>(info...);
           }
-          m_buf.Write(
-              value,
-              [&](auto bytes) { ::nt::SetDefaultRaw(m_pubHandle, bytes); },
-              info...);
+          ::nt::SetDefaultEntryValue(m_pubHandle, MakeValue(value, 1, info...));
         },
         m_info);
   }
@@ -386,7 +363,29 @@ class StructArrayPublisher : public Publisher {
   }
 
  private:
-  wpi::StructArrayBuffer<T, I...> m_buf;
+  // packs directly into the value's buffer
+  template <typename U>
+  static Value MakeValue(U&& value, int64_t time, const I&... info) {
+    size_t size = S::GetSize(info...);
+    return Value::MakeRaw(
+        std::size(value) * size,
+        [&](std::span<uint8_t> buf) {
+          if constexpr (wpi::LayoutCompatibleStruct<T, I...> &&
+                        std::ranges::contiguous_range<U> &&
+                        std::same_as<std::ranges::range_value_t<U>, T>) {
+            std::memcpy(buf.data(), std::ranges::data(value), buf.size());
+            return;
+          }
+          auto out = buf.begin();
+          for (auto&& val : value) {
+            S::Pack(std::span<uint8_t>{std::to_address(out), size},
+                    std::forward<decltype(val)>(val), info...);
+            out += size;
+          }
+        },
+        time);
+  }
+
   std::atomic_bool m_schemaPublished{false};
   [[no_unique_address]]
   std::tuple<I...> m_info;
@@ -15,7 +15,6 @@
 #include <utility>
 #include <vector>
 
-#include <wpi/SmallVector.h>
 #include <wpi/json_fwd.h>
 #include <wpi/struct/Struct.h>
 
@@ -88,14 +87,15 @@ class StructSubscriber : public Subscriber {
    * @return true if successful
    */
   bool GetInto(T* out) {
-    wpi::SmallVector<uint8_t, 128> buf;
-    TimestampedRawView view = ::nt::GetAtomicRaw(m_subHandle, buf, {});
-    if (view.value.size() < std::apply(S::GetSize, m_info)) {
+    // the value shares its buffer with storage, so nothing is copied
+    Value value = ::nt::GetEntryValue(m_subHandle);
+    if (!value.IsRaw() ||
+        value.GetRaw().size() < std::apply(S::GetSize, m_info)) {
       return false;
     } else {
       std::apply(
           [&](const I&... info) {
-            wpi::UnpackStructInto(out, view.value, info...);
+            wpi::UnpackStructInto(out, value.GetRaw(), info...);
           },
           m_info);
       return true;
@@ -120,16 +120,18 @@ class StructSubscriber : public Subscriber {
    * @return timestamped value
    */
   TimestampedValueType GetAtomic(const T& defaultValue) const {
-    wpi::SmallVector<uint8_t, 128> buf;
-    TimestampedRawView view = ::nt::GetAtomicRaw(m_subHandle, buf, {});
-    if (view.value.size() < std::apply(S::GetSize, m_info)) {
+    // the value shares its buffer with storage, so nothing is copied
+    Value value = ::nt::GetEntryValue(m_subHandle);
+    if (!value.IsRaw() ||
+        value.GetRaw().size() < std::apply(S::GetSize, m_info)) {
       return {0, 0, defaultValue};
     } else {
-      return {
-          view.time, view.serverTime,
-          std::apply(
-              [&](const I&... info) { return S::Unpack(view.value, info...); },
-              m_info)};
+      return {value.time(), value.server_time(),
+              std::apply(
+                  [&](const I&... info) {
+                    return S::Unpack(value.GetRaw(), info...);
+                  },
+                  m_info)};
     }
   }
 
@@ -145,18 +147,17 @@ class StructSubscriber : public Subscriber {
    *     have been published since the previous call.
    */
   std::vector<TimestampedValueType> ReadQueue() {
-    auto raw = ::nt::ReadQueueRaw(m_subHandle);
+    auto raw = ::nt::ReadQueueValue(m_subHandle, NT_RAW);
     std::vector<TimestampedValueType> rv;
     rv.reserve(raw.size());
     for (auto&& r : raw) {
-      if (r.value.size() < std::apply(S::GetSize, m_info)) {
+      if (r.GetRaw().size() < std::apply(S::GetSize, m_info)) {
         continue;
       } else {
         std::apply(
             [&](const I&... info) {
-              rv.emplace_back(
-                  r.time, r.serverTime,
-                  S::Unpack(std::span<const uint8_t>(r.value), info...));
+              rv.emplace_back(r.time(), r.server_time(),
+                              S::Unpack(r.GetRaw(), info...));
             },
             m_info);
       }
@@ -243,18 +244,7 @@ class StructPublisher : public Publisher {
           },
           m_info);
     }
-    if constexpr (sizeof...(I) == 0) {
-      if constexpr (wpi::is_constexpr([] { S::GetSize(); })) {
-        uint8_t buf[S::GetSize()];
-        S::Pack(buf, value);
-        ::nt::SetRaw(m_pubHandle, buf, time);
-        return;
-      }
-    }
-    wpi::SmallVector<uint8_t, 128> buf;
-    buf.resize_for_overwrite(std::apply(S::GetSize, m_info));
-    std::apply([&](const I&... info) { S::Pack(buf, value, info...); }, m_info);
-    ::nt::SetRaw(m_pubHandle, buf, time);
+    ::nt::SetEntryValue(m_pubHandle, MakeValue(value, time));
   }
 
   /**
@@ -272,18 +262,7 @@ class StructPublisher : public Publisher {
           },
           m_info);
     }
-    if constexpr (sizeof...(I) == 0) {
-      if constexpr (wpi::is_constexpr([] { S::GetSize(); })) {
-        uint8_t buf[S::GetSize()];
-        S::Pack(buf, value);
-        ::nt::SetDefaultRaw(m_pubHandle, buf);
-        return;
-      }
-    }
-    wpi::SmallVector<uint8_t, 128> buf;
-    buf.resize_for_overwrite(std::apply(S::GetSize, m_info));
-    std::apply([&](const I&... info) { S::Pack(buf, value, info...); }, m_info);
-    ::nt::SetDefaultRaw(m_pubHandle, buf);
+    ::nt::SetDefaultEntryValue(m_pubHandle, MakeValue(value, 1));
   }
 
   /**
@@ -301,6 +280,18 @@ class StructPublisher : public Publisher {
   }
 
  private:
+  // packs directly into the value's buffer
+  Value MakeValue(const T& value, int64_t time) const {
+    return std::apply(
+        [&](const I&... info) {
+          return Value::MakeRaw(
+              S::GetSize(info...),
+              [&](std::span<uint8_t> buf) { S::Pack(buf, value, info...); },
+              time);
+        },
+        m_info);
+  }
+
   std::atomic_bool m_schemaPublished{false};
   [[no_unique_address]]
   std::tuple<I...> m_info;
@@ -248,7 +248,10 @@ struct NT_TimeSyncEventData {
    */
   int64_t serverTimeOffset;
 
-  /** Measured round trip time divided by 2, in microseconds. */
+  /**
+   * Measured round trip time divided by 2, in microseconds, of the ping
+   * exchange serverTimeOffset is based on.
+   */
   int64_t rtt2;
 
   /**
@@ -256,6 +259,12 @@ struct NT_TimeSyncEventData {
    * sent when the client disconnects.
    */
   NT_Bool valid;
+
+  /**
+   * Uncertainty of serverTimeOffset, in microseconds: rtt2 plus an allowance
+   * for clock drift since the ping exchange.
+   */
+  int64_t uncertainty;
 };
 
 /** NetworkTables event */
@@ -360,6 +369,25 @@ struct NT_PubSubOptions {
    * will not appear in metatopics.
    */
   NT_Bool hidden;
+
+  /**
+   * For subscriptions, ask the server to send boolean, integer, float, and
+   * double array value changes as element-level deltas against the previously
+   * sent value, with periodic full values. This reduces bandwidth for large
+   * arrays where only a few elements change between updates. Only honored by
+   * NetworkTables 4 servers and clients implemented by this library.
+   */
+  NT_Bool deltaArrays;
+
+  /**
+   * For subscriptions, coalesce values in the local poll storage (the
+   * ReadQueue() buffer) into fixed time intervals, in seconds. A value whose
+   * timestamp falls in the same interval as the most recently stored value
+   * replaces it rather than being added, so the queue holds at most the last
+   * value per interval. This lets slow loops consume high-rate topics without
+   * reading every sample. 0 (the default) disables coalescing.
+   */
+  double coalescePeriod;
 };
 
 /**
@@ -969,6 +997,19 @@ void NT_RemoveListener(NT_Listener listener);
  */
 NT_Bool NT_WaitForListenerQueue(NT_Handle handle, double timeout);
 
+/**
+ * Sets the number of threads used to run listener callbacks.  With the
+ * default of 1, all callbacks run on a single thread, one at a time.  With
+ * larger values, callback listeners added afterwards are assigned to the
+ * threads in turn, so a slow callback only delays listeners on the same
+ * thread.  Callbacks for any one listener always run on the same thread, in
+ * order; callbacks for different listeners may run concurrently.
+ *
+ * @param inst   instance handle
+ * @param count  number of listener threads
+ */
+void NT_SetListenerThreads(NT_Inst inst, unsigned int count);
+
 /**
  * Create a listener for changes to topics with names that start with
  * the given prefix. This creates a corresponding internal subscriber with the
@@ -1133,6 +1174,31 @@ void NT_StartServer(NT_Inst inst, const struct WPI_String* persist_filename,
  */
 void NT_StopServer(NT_Inst inst);
 
+/**
+ * Sets the number of I/O threads the server uses for NT4 client connections.
+ * With the default of 1, all connections are serviced by the single server
+ * thread.  Larger values spread NT4 client connections across that many
+ * additional event loop threads, each handling socket I/O and outgoing message
+ * flushing for its connections.  Takes effect the next time the server is
+ * started.  Ignored on Windows.
+ *
+ * @param inst   instance handle
+ * @param count  number of I/O threads
+ */
+void NT_SetServerIoThreads(NT_Inst inst, unsigned int count);
+
+/**
+ * Sets the approximate outgoing bandwidth limit the server applies to each
+ * (non-local) NT4 client connection.  Topics with a "priority" property of
+ * "critical" are always sent; other topics are deferred (with values
+ * coalesced) when over budget, "bulk" topics before the default "telemetry"
+ * topics.  Takes effect for connections made after this call.
+ *
+ * @param inst         instance handle
+ * @param bytesPerSec  bytes per second; 0 (the default) for no limit
+ */
+void NT_SetServerBandwidthLimit(NT_Inst inst, unsigned int bytesPerSec);
+
 /**
  * Starts a NT3 client.  Use NT_SetServer or NT_SetServerTeam to set the server
  * name and port.
@@ -1281,6 +1347,18 @@ NT_Bool NT_IsConnected(NT_Inst inst);
  */
 int64_t NT_GetServerTimeOffset(NT_Inst inst, NT_Bool* valid);
 
+/**
+ * Get the time offset between server time and local time, and its
+ * uncertainty. This is the same data as the most recent "time sync" event.
+ * In server mode, the offset and uncertainty are always 0. In client mode, the
+ * data is valid only if the client and server are connected and have
+ * exchanged synchronization messages.
+ *
+ * @param inst instance handle
+ * @param data time sync data (output)
+ */
+void NT_GetServerTimeSync(NT_Inst inst, struct NT_TimeSyncEventData* data);
+
 /** @} */
 
 /**
@@ -1819,6 +1897,7 @@ struct NT_Meta_SubscriberOptions {
   NT_Bool topicsOnly;
   NT_Bool sendAll;
   NT_Bool prefixMatch;
+  NT_Bool deltaArrays;
 };
 
 /**
@@ -1865,6 +1944,31 @@ struct NT_Meta_Client {
   uint16_t version;
 };
 
+/**
+ * Client connection statistics (as published via `$sys/clients`).
+ */
+struct NT_Meta_ConnectionStats {
+  struct WPI_String id;
+  uint64_t bytesIn;
+  uint64_t bytesOut;
+  int64_t rtt;
+  uint64_t coalesced;
+  uint64_t dropped;
+  uint64_t queueMessages;
+  uint64_t queueBytes;
+};
+
+/**
+ * Topic statistics (as published via `$sys/topics`).
+ */
+struct NT_Meta_TopicStats {
+  struct WPI_String name;
+  uint64_t valuesIn;
+  uint64_t bytesIn;
+  uint64_t valuesOut;
+  uint64_t bytesOut;
+};
+
 /**
  * Decodes `$pub$<topic>` meta-topic data.
  *
@@ -1920,6 +2024,29 @@ struct NT_Meta_ClientSubscriber* NT_Meta_DecodeClientSubscribers(
 struct NT_Meta_Client* NT_Meta_DecodeClients(const uint8_t* data, size_t size,
                                              size_t* count);
 
+/**
+ * Decodes `$sys/clients` meta-topic data.
+ *
+ * @param data data contents
+ * @param size size of data contents
+ * @param count number of elements in returned array (output)
+ * @return Array of ConnectionStats, or NULL on decoding error.
+ */
+struct NT_Meta_ConnectionStats* NT_Meta_DecodeConnectionStats(
+    const uint8_t* data, size_t size, size_t* count);
+
+/**
+ * Decodes `$sys/topics` meta-topic data.
+ *
+ * @param data data contents
+ * @param size size of data contents
+ * @param count number of elements in returned array (output)
+ * @return Array of TopicStats, or NULL on decoding error.
+ */
+struct NT_Meta_TopicStats* NT_Meta_DecodeTopicStats(const uint8_t* data,
+                                                    size_t size,
+                                                    size_t* count);
+
 /**
  * Frees an array of NT_Meta_TopicPublisher.
  *
@@ -1964,6 +2091,23 @@ void NT_Meta_FreeClientSubscribers(struct NT_Meta_ClientSubscriber* arr,
  */
 void NT_Meta_FreeClients(struct NT_Meta_Client* arr, size_t count);
 
+/**
+ * Frees an array of NT_Meta_ConnectionStats.
+ *
+ * @param arr   pointer to the array to free
+ * @param count size of the array to free
+ */
+void NT_Meta_FreeConnectionStats(struct NT_Meta_ConnectionStats* arr,
+                                 size_t count);
+
+/**
+ * Frees an array of NT_Meta_TopicStats.
+ *
+ * @param arr   pointer to the array to free
+ * @param count size of the array to free
+ */
+void NT_Meta_FreeTopicStats(struct NT_Meta_TopicStats* arr, size_t count);
+
 /** @} */
 
 #ifdef __cplusplus
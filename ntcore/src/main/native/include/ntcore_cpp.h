@@ -194,8 +194,12 @@ class LogMessage {
 class TimeSyncEventData {
  public:
   TimeSyncEventData() = default;
-  TimeSyncEventData(int64_t serverTimeOffset, int64_t rtt2, bool valid)
-      : serverTimeOffset{serverTimeOffset}, rtt2{rtt2}, valid{valid} {}
+  TimeSyncEventData(int64_t serverTimeOffset, int64_t rtt2, bool valid,
+                    int64_t uncertainty = 0)
+      : serverTimeOffset{serverTimeOffset},
+        rtt2{rtt2},
+        valid{valid},
+        uncertainty{uncertainty} {}
 
   /**
    * Offset between local time and server time, in microseconds. Add this value
@@ -203,7 +207,10 @@ class TimeSyncEventData {
    */
   int64_t serverTimeOffset;
 
-  /** Measured round trip time divided by 2, in microseconds. */
+  /**
+   * Measured round trip time divided by 2, in microseconds, of the ping
+   * exchange serverTimeOffset is based on.
+   */
   int64_t rtt2;
 
   /**
@@ -211,6 +218,12 @@ class TimeSyncEventData {
    * sent when the client disconnects.
    */
   bool valid;
+
+  /**
+   * Uncertainty of serverTimeOffset, in microseconds: rtt2 plus an allowance
+   * for clock drift since the ping exchange.
+   */
+  int64_t uncertainty;
 };
 
 /** NetworkTables event */
@@ -236,10 +249,10 @@ class Event {
         flags{flags},
         data{LogMessage{level, filename, line, message}} {}
   Event(NT_Listener listener, unsigned int flags, int64_t serverTimeOffset,
-        int64_t rtt2, bool valid)
+        int64_t rtt2, bool valid, int64_t uncertainty)
       : listener{listener},
         flags{flags},
-        data{TimeSyncEventData{serverTimeOffset, rtt2, valid}} {}
+        data{TimeSyncEventData{serverTimeOffset, rtt2, valid, uncertainty}} {}
 
   /** Listener that triggered this event. */
   NT_Listener listener{0};
@@ -382,6 +395,25 @@ struct PubSubOptions {
    * will not appear in metatopics.
    */
   bool hidden = false;
+
+  /**
+   * For subscriptions, ask the server to send boolean, integer, float, and
+   * double array value changes as element-level deltas against the previously
+   * sent value, with periodic full values. This reduces bandwidth for large
+   * arrays where only a few elements change between updates. Only honored by
+   * NetworkTables 4 servers and clients implemented by this library.
+   */
+  bool deltaArrays = false;
+
+  /**
+   * For subscriptions, coalesce values in the local poll storage (the
+   * ReadQueue() buffer) into fixed time intervals, in seconds. A value whose
+   * timestamp falls in the same interval as the most recently stored value
+   * replaces it rather than being added, so the queue holds at most the last
+   * value per interval. This lets slow loops consume high-rate topics without
+   * reading every sample. 0 (the default) disables coalescing.
+   */
+  double coalescePeriod = 0;
 };
 
 /**
@@ -389,6 +421,46 @@ struct PubSubOptions {
  */
 constexpr PubSubOptions kDefaultPubSubOptions;
 
+/**
+ * Parameters for one publisher created by PublishMultiple().
+ */
+struct PublishRequest {
+  PublishRequest() = default;
+
+  /**
+   * Constructs a request.
+   *
+   * @param name topic name
+   * @param type topic type
+   * @param typeStr topic type string
+   * @param properties initial properties (JSON object), or nullptr for none
+   * @param options publish options
+   */
+  PublishRequest(std::string_view name, NT_Type type, std::string_view typeStr,
+                 const wpi::json* properties = nullptr,
+                 const PubSubOptions& options = kDefaultPubSubOptions)
+      : name{name},
+        type{type},
+        typeStr{typeStr},
+        properties{properties},
+        options{options} {}
+
+  /** Topic name */
+  std::string_view name;
+
+  /** Topic type */
+  NT_Type type{NT_UNASSIGNED};
+
+  /** Topic type string */
+  std::string_view typeStr;
+
+  /** Initial topic properties (JSON object), or nullptr for none */
+  const wpi::json* properties{nullptr};
+
+  /** Publish options */
+  PubSubOptions options;
+};
+
 /**
  * @defgroup ntcore_instance_func Instance Functions
  * @{
@@ -510,6 +582,22 @@ bool SetDefaultEntryValue(NT_Entry entry, const Value& value);
  */
 bool SetEntryValue(NT_Entry entry, const Value& value);
 
+/**
+ * Set Entry Values.
+ *
+ * Sets new values for several entries or publishers at once. This is
+ * equivalent to calling SetEntryValue() for each, but only acquires the
+ * storage lock once, so it's cheaper when publishing many values together.
+ * The handles should all be from the same instance.
+ *
+ * @param entries   entry or publisher handles
+ * @param values    new values, one per handle
+ * @return False if any value was not set (type mismatch, or the spans have
+ *         different sizes), True on success
+ */
+bool SetEntryValues(std::span<const NT_Handle> entries,
+                    std::span<const Value> values);
+
 /**
  * Set Entry Flags.
  *
@@ -619,6 +707,23 @@ std::vector<TopicInfo> GetTopicInfo(NT_Inst inst, std::string_view prefix,
 std::vector<TopicInfo> GetTopicInfo(NT_Inst inst, std::string_view prefix,
                                     std::span<const std::string_view> types);
 
+/**
+ * Get the cached values of all scalar (boolean, integer, float, and double)
+ * topics.
+ *
+ * Scalar values are kept in a compact table, so this is much faster than
+ * getting the value of each topic individually, e.g. for periodically
+ * snapshotting all values. Topics with no cached value (including uncached
+ * topics) are not returned.
+ *
+ * @param inst    instance handle
+ * @param types   bitmask of NT_Type values; 0 is treated specially
+ *                as a "don't care"
+ * @return Array of topic handle and value pairs.
+ */
+std::vector<std::pair<NT_Topic, Value>> GetScalarTopicValues(
+    NT_Inst inst, unsigned int types);
+
 /**
  * Gets Topic Information.
  *
@@ -820,6 +925,21 @@ NT_Publisher PublishEx(NT_Topic topic, NT_Type type, std::string_view typeStr,
                        const wpi::json& properties,
                        const PubSubOptions& options = kDefaultPubSubOptions);
 
+/**
+ * Creates publishers to multiple topics at once. This is equivalent to calling
+ * GetTopic() and PublishEx() for each request, but all the publishers are
+ * created in a single operation, which is much faster when creating many
+ * publishers (e.g. at startup). The publish messages are sent to the server
+ * together.
+ *
+ * @param inst instance handle
+ * @param requests topic names, types, properties, and options
+ * @return Publisher handles, in the same order as requests; 0 for any request
+ *         that failed (e.g. due to an empty name or unassigned type)
+ */
+std::vector<NT_Publisher> PublishMultiple(
+    NT_Inst inst, std::span<const PublishRequest> requests);
+
 /**
  * Stops publisher.
  *
@@ -947,6 +1067,19 @@ void RemoveListener(NT_Listener listener);
  */
 bool WaitForListenerQueue(NT_Handle handle, double timeout);
 
+/**
+ * Sets the number of threads used to run listener callbacks.  With the
+ * default of 1, all callbacks run on a single thread, one at a time.  With
+ * larger values, callback listeners added afterwards are assigned to the
+ * threads in turn, so a slow callback only delays listeners on the same
+ * thread.  Callbacks for any one listener always run on the same thread, in
+ * order; callbacks for different listeners may run concurrently.
+ *
+ * @param inst   instance handle
+ * @param count  number of listener threads
+ */
+void SetListenerThreads(NT_Inst inst, unsigned int count);
+
 /**
  * Create a listener for changes to topics with names that start with any of
  * the given prefixes. This creates a corresponding internal subscriber with the
@@ -1071,6 +1204,31 @@ void StartServer(NT_Inst inst, std::string_view persist_filename,
  */
 void StopServer(NT_Inst inst);
 
+/**
+ * Sets the number of I/O threads the server uses for NT4 client connections.
+ * With the default of 1, all connections are serviced by the single server
+ * thread.  Larger values spread NT4 client connections across that many
+ * additional event loop threads, each handling socket I/O and outgoing message
+ * flushing for its connections.  Takes effect the next time the server is
+ * started.  Ignored on Windows.
+ *
+ * @param inst   instance handle
+ * @param count  number of I/O threads
+ */
+void SetServerIoThreads(NT_Inst inst, unsigned int count);
+
+/**
+ * Sets the approximate outgoing bandwidth limit the server applies to each
+ * (non-local) NT4 client connection.  Topics with a "priority" property of
+ * "critical" are always sent; other topics are deferred (with values
+ * coalesced) when over budget, "bulk" topics before the default "telemetry"
+ * topics.  Takes effect for connections made after this call.
+ *
+ * @param inst         instance handle
+ * @param bytesPerSec  bytes per second; 0 (the default) for no limit
+ */
+void SetServerBandwidthLimit(NT_Inst inst, unsigned int bytesPerSec);
+
 /**
  * Starts a NT3 client.  Use SetServer or SetServerTeam to set the server name
  * and port.
@@ -1208,6 +1366,18 @@ bool IsConnected(NT_Inst inst);
  */
 std::optional<int64_t> GetServerTimeOffset(NT_Inst inst);
 
+/**
+ * Get the time offset between server time and local time, and its
+ * uncertainty. This is the same data as the most recent "time sync" event.
+ * In server mode, the offset and uncertainty are always 0. In client mode, the
+ * data is valid only if the client and server are connected and have
+ * exchanged synchronization messages.
+ *
+ * @param inst instance handle
+ * @return Time sync data
+ */
+TimeSyncEventData GetServerTimeSync(NT_Inst inst);
+
 /** @} */
 
 /**
@@ -1423,6 +1593,7 @@ struct SubscriberOptions {
   bool topicsOnly = false;
   bool sendAll = false;
   bool prefixMatch = false;
+  bool deltaArrays = false;
   // std::string otherStr;
 };
 
@@ -1469,6 +1640,44 @@ struct Client {
   uint16_t version = 0;
 };
 
+/**
+ * Client connection statistics (as published via `$sys/clients`).
+ */
+struct ConnectionStats {
+  /** Client id */
+  std::string id;
+  /** Total bytes received from the client */
+  uint64_t bytesIn = 0;
+  /** Total bytes sent to the client */
+  uint64_t bytesOut = 0;
+  /** Most recent ping round trip time, in microseconds (0 if unknown) */
+  int64_t rtt = 0;
+  /** Queued values replaced by a newer value before being sent */
+  uint64_t coalesced = 0;
+  /** Replaced values that were dropped due to a full outgoing queue */
+  uint64_t dropped = 0;
+  /** Number of messages waiting to be sent */
+  uint64_t queueMessages = 0;
+  /** Approximate number of bytes waiting to be sent */
+  uint64_t queueBytes = 0;
+};
+
+/**
+ * Topic statistics (as published via `$sys/topics`).
+ */
+struct TopicStats {
+  /** Topic name */
+  std::string name;
+  /** Number of values received from publishers */
+  uint64_t valuesIn = 0;
+  /** Total size of values received from publishers */
+  uint64_t bytesIn = 0;
+  /** Number of values forwarded to subscribed clients */
+  uint64_t valuesOut = 0;
+  /** Total size of values forwarded to subscribed clients */
+  uint64_t bytesOut = 0;
+};
+
 /**
  * Decodes `$pub$<topic>` meta-topic data.
  *
@@ -1513,6 +1722,24 @@ std::optional<std::vector<ClientSubscriber>> DecodeClientSubscribers(
  */
 std::optional<std::vector<Client>> DecodeClients(std::span<const uint8_t> data);
 
+/**
+ * Decodes `$sys/clients` meta-topic data.
+ *
+ * @param data data contents
+ * @return Vector of ConnectionStats, or empty optional on decoding error.
+ */
+std::optional<std::vector<ConnectionStats>> DecodeConnectionStats(
+    std::span<const uint8_t> data);
+
+/**
+ * Decodes `$sys/topics` meta-topic data.
+ *
+ * @param data data contents
+ * @return Vector of TopicStats, or empty optional on decoding error.
+ */
+std::optional<std::vector<TopicStats>> DecodeTopicStats(
+    std::span<const uint8_t> data);
+
 /** @} */
 
 }  // namespace meta
@@ -4,6 +4,10 @@
 
 package edu.wpi.first.networktables;
 
+import static org.junit.jupiter.api.Assertions.assertArrayEquals;
+import static org.junit.jupiter.api.Assertions.assertThrows;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
 import org.junit.jupiter.api.Test;
 
 class JNITest {
@@ -13,4 +17,22 @@ class JNITest {
     int inst = NetworkTablesJNI.getDefaultInstance();
     NetworkTablesJNI.flush(inst);
   }
+
+  @Test
+  void batchDoublesTest() {
+    try (var inst = NetworkTableInstance.create();
+        var foo = inst.getDoubleTopic("foo").getEntry(0.0);
+        var bar = inst.getDoubleTopic("bar").getEntry(0.0)) {
+      int[] handles = {foo.getHandle(), bar.getHandle()};
+      assertTrue(NetworkTablesJNI.setDoubles(handles, 0, new double[] {1.0, 2.0}));
+
+      double[] values = new double[2];
+      NetworkTablesJNI.getDoubles(handles, -1.0, values);
+      assertArrayEquals(new double[] {1.0, 2.0}, values);
+
+      assertThrows(
+          IllegalArgumentException.class,
+          () -> NetworkTablesJNI.getDoubles(handles, -1.0, new double[1]));
+    }
+  }
 }
@@ -2,6 +2,8 @@
 // Open Source Software; you can modify and/or share it under the terms of
 // the WPILib BSD license file in the root directory of this project.
 
+#include <chrono>
+#include <future>
 #include <string>
 #include <vector>
 
@@ -195,6 +197,43 @@ TEST_F(LocalStorageTest, SubscribeNoTypeLocalPubPost) {
   ASSERT_TRUE(vals2.empty());
 }
 
+TEST_F(LocalStorageTest, SetEntryValueContended) {
+  EXPECT_CALL(
+      network,
+      ClientPublish(_, std::string_view{"foo"}, std::string_view{"double"},
+                    wpi::json::object(), IsDefaultPubSubOptions()));
+  auto pub = storage.Publish(fooTopic, NT_DOUBLE, "double", {}, {});
+
+  // sets from other threads while this thread holds the storage lock
+  std::future<bool> queued;
+  std::future<bool> wrongType;
+  std::future<bool> badHandle;
+  auto val = Value::MakeDouble(1.0, 5);
+  auto queuedVal = Value::MakeDouble(2.0, 6);
+  EXPECT_CALL(network, ClientSetValue(Handle{pub}.GetIndex(), val))
+      .WillOnce([&] {
+        queued = std::async(std::launch::async, [&] {
+          return storage.SetEntryValue(pub, queuedVal);
+        });
+        // queued values don't wait for the lock
+        EXPECT_EQ(queued.wait_for(std::chrono::seconds(5)),
+                  std::future_status::ready);
+        wrongType = std::async(std::launch::async, [&] {
+          return storage.SetEntryValue(pub, Value::MakeBoolean(true, 7));
+        });
+        badHandle = std::async(std::launch::async, [&] {
+          return storage.SetEntryValue(pub + 1, Value::MakeDouble(3.0, 8));
+        });
+        wrongType.wait_for(std::chrono::milliseconds(10));
+      });
+  EXPECT_CALL(network, ClientSetValue(Handle{pub}.GetIndex(), queuedVal));
+  EXPECT_TRUE(storage.SetEntryValue(pub, val));
+
+  EXPECT_TRUE(queued.get());
+  EXPECT_FALSE(wrongType.get());
+  EXPECT_FALSE(badHandle.get());
+}
+
 TEST_F(LocalStorageTest, SubscribeNoTypeLocalPubPre) {
   EXPECT_CALL(
       network,
@@ -508,6 +547,24 @@ TEST_F(LocalStorageTest, SetValueEmptyValue) {
   EXPECT_FALSE(storage.SetEntryValue(pub, {}));
 }
 
+TEST_F(LocalStorageTest, SetValues) {
+  EXPECT_CALL(network, ClientPublish(_, std::string_view{"foo"}, _, _, _));
+  EXPECT_CALL(network, ClientPublish(_, std::string_view{"bar"}, _, _, _));
+  auto fooPub = storage.Publish(fooTopic, NT_BOOLEAN, "boolean", {}, {});
+  auto barPub = storage.Publish(barTopic, NT_STRING, "string", {}, {});
+  NT_Handle pubs[] = {fooPub, barPub};
+
+  Value values[] = {Value::MakeBoolean(true, 5), Value::MakeString("x", 5)};
+  EXPECT_CALL(network, ClientSetValue(Handle{fooPub}.GetIndex(), values[0]));
+  EXPECT_CALL(network, ClientSetValue(Handle{barPub}.GetIndex(), values[1]));
+  EXPECT_TRUE(storage.SetEntryValues(pubs, values));
+
+  // a type mismatch fails, but the other values are still set
+  Value values2[] = {Value::MakeInteger(3, 6), Value::MakeString("y", 6)};
+  EXPECT_CALL(network, ClientSetValue(Handle{barPub}.GetIndex(), values2[1]));
+  EXPECT_FALSE(storage.SetEntryValues(pubs, values2));
+}
+
 TEST_F(LocalStorageTest, SetValueEmptyUntypedEntry) {
   EXPECT_CALL(network, ClientSubscribe(_, wpi::SpanEq({std::string{"foo"}}),
                                        IsDefaultPubSubOptions()));
@@ -524,6 +581,48 @@ TEST_F(LocalStorageTest, PublishUntyped) {
   EXPECT_EQ(storage.Publish(fooTopic, NT_UNASSIGNED, "", {}, {}), 0u);
 }
 
+TEST_F(LocalStorageTest, PublishMultiple) {
+  wpi::json properties = {{"persistent", true}};
+  PubSubOptions options;
+  options.periodic = 0.5;
+  PublishRequest requests[] = {
+      {"foo", NT_BOOLEAN, "boolean"},
+      {"", NT_DOUBLE, "double"},
+      {"new", NT_DOUBLE, "double", &properties, options},
+      {"bar", NT_UNASSIGNED, ""},
+  };
+
+  ::testing::InSequence seq;
+  EXPECT_CALL(
+      network,
+      ClientPublish(_, std::string_view{"foo"}, std::string_view{"boolean"},
+                    wpi::json::object(), IsDefaultPubSubOptions()));
+  EXPECT_CALL(logger, Call(NT_LOG_ERROR, _, _,
+                           std::string_view{
+                               "trying to publish empty topic name"}));
+  PubSubOptionsImpl newOptions;
+  newOptions.periodicMs = 500;
+  EXPECT_CALL(network, ClientPublish(_, std::string_view{"new"},
+                                     std::string_view{"double"}, properties,
+                                     IsPubSubOptions(newOptions)));
+  EXPECT_CALL(logger,
+              Call(NT_LOG_ERROR, _, _,
+                   std::string_view{"cannot publish 'bar' with an unassigned "
+                                    "type or empty type string"}));
+  auto pubs = storage.PublishMultiple(requests);
+
+  ASSERT_EQ(pubs.size(), 4u);
+  EXPECT_NE(pubs[0], 0u);
+  EXPECT_EQ(pubs[1], 0u);
+  EXPECT_NE(pubs[2], 0u);
+  EXPECT_EQ(pubs[3], 0u);
+  EXPECT_EQ(storage.GetTopicFromHandle(pubs[0]), fooTopic);
+  auto info = storage.GetTopicInfo(storage.GetTopicFromHandle(pubs[2]));
+  EXPECT_EQ(info.name, "new");
+  EXPECT_EQ(info.type, NT_DOUBLE);
+  EXPECT_EQ(info.properties, "{\"persistent\":true}");
+}
+
 TEST_F(LocalStorageTest, SetValueInvalidHandle) {
   EXPECT_FALSE(storage.SetEntryValue(0u, {}));
 }
@@ -939,6 +1038,69 @@ TEST_F(LocalStorageTest, MultiSubSpecial) {
   storage.SetEntryValue(pubnormal, Value::MakeDouble(2.0, 40));
 }
 
+TEST_F(LocalStorageTest, MultiSubPrefixIndex) {
+  EXPECT_CALL(network, ClientSubscribe(_, _, _)).Times(3);
+  EXPECT_CALL(network, ClientUnsubscribe(_));
+  EXPECT_CALL(network, ClientPublish(_, _, _, _, _)).Times(2);
+  EXPECT_CALL(listenerStorage, Activate(_, _, _)).Times(2);
+
+  // overlapping prefixes, a prefix longer than the topic name, and a removed
+  // multi-subscriber, all before the topics are created
+  auto sub1 = storage.SubscribeMultiple({{"/foo/", "/foo/bar/"}}, {});
+  auto sub2 = storage.SubscribeMultiple({{"/foo/bar/baz/qux"}}, {});
+  auto sub3 = storage.SubscribeMultiple({{"/foo/"}}, {});
+  storage.UnsubscribeMultiple(sub3);
+  storage.AddListener(1, sub1, NT_EVENT_PUBLISH);
+  storage.AddListener(2, sub2, NT_EVENT_PUBLISH);
+
+  EXPECT_CALL(listenerStorage,
+              Notify(wpi::SpanEq(std::span<const NT_Listener>{{1}}),
+                     NT_EVENT_PUBLISH,
+                     ::testing::An<std::span<const TopicInfo>>()));
+  storage.Publish(storage.GetTopic("/foo/bar/baz"), NT_DOUBLE, "double", {},
+                  {});
+
+  EXPECT_CALL(listenerStorage,
+              Notify(wpi::SpanEq(std::span<const NT_Listener>{{1, 2}}),
+                     NT_EVENT_PUBLISH,
+                     ::testing::An<std::span<const TopicInfo>>()));
+  storage.Publish(storage.GetTopic("/foo/bar/baz/qux"), NT_DOUBLE, "double",
+                  {}, {});
+}
+
+TEST_F(LocalStorageTest, GetScalarTopicValues) {
+  EXPECT_CALL(network, ClientPublish(_, _, _, _, _)).Times(3);
+  EXPECT_CALL(network, ClientSetValue(_, _)).Times(4);
+  EXPECT_CALL(network, ClientUnpublish(_));
+  auto fooPub = storage.Publish(fooTopic, NT_DOUBLE, "double", {}, {});
+  auto barPub = storage.Publish(barTopic, NT_STRING, "string", {}, {});
+  auto bazPub = storage.Publish(bazTopic, NT_BOOLEAN, "boolean", {}, {});
+  EXPECT_TRUE(storage.GetScalarTopicValues(0).empty());
+
+  storage.SetEntryValue(fooPub, Value::MakeDouble(1.5, 50));
+  storage.SetEntryValue(barPub, Value::MakeString("hello", 50));
+  storage.SetEntryValue(bazPub, Value::MakeBoolean(true, 60));
+  storage.SetEntryValue(fooPub, Value::MakeDouble(2.5, 70));
+
+  auto values = storage.GetScalarTopicValues(0);
+  ASSERT_EQ(values.size(), 2u);
+  EXPECT_EQ(values[0].first, fooTopic);
+  EXPECT_EQ(values[0].second, Value::MakeDouble(2.5, 70));
+  EXPECT_EQ(values[0].second.time(), 70);
+  EXPECT_EQ(values[1].first, bazTopic);
+  EXPECT_EQ(values[1].second, Value::MakeBoolean(true, 60));
+
+  values = storage.GetScalarTopicValues(NT_DOUBLE | NT_STRING);
+  ASSERT_EQ(values.size(), 1u);
+  EXPECT_EQ(values[0].first, fooTopic);
+
+  // topics that no longer exist have no value
+  storage.Unpublish(fooPub);
+  values = storage.GetScalarTopicValues(0);
+  ASSERT_EQ(values.size(), 1u);
+  EXPECT_EQ(values[0].first, bazTopic);
+}
+
 TEST_F(LocalStorageTest, NetworkDuplicateDetect) {
   EXPECT_CALL(network, ClientPublish(_, _, _, _, _));
   auto pub = storage.Publish(fooTopic, NT_DOUBLE, "double", {}, {});
@@ -38,7 +38,8 @@ class MockListenerStorage : public IListenerStorage {
               (override));
   MOCK_METHOD(void, NotifyTimeSync,
               (std::span<const NT_Listener> handles, unsigned int flags,
-               int64_t serverTimeOffset, int64_t rtt2, bool valid),
+               int64_t serverTimeOffset, int64_t rtt2, bool valid,
+               int64_t uncertainty),
               (override));
 };
 
@@ -0,0 +1,130 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <wpi/mutex.h>
+
+#include "TestPrinters.h"
+#include "local/PendingValueQueue.h"
+#include "networktables/NetworkTableValue.h"
+#include "ntcore_cpp.h"
+
+namespace nt {
+
+TEST(PendingValueQueueTest, Empty) {
+  local::PendingValueQueue queue;
+  EXPECT_TRUE(queue.Empty());
+  int count = 0;
+  queue.Drain([&](NT_Handle, const Value&) { ++count; });
+  EXPECT_EQ(count, 0);
+}
+
+TEST(PendingValueQueueTest, PushDrainOrder) {
+  local::PendingValueQueue queue;
+  ASSERT_TRUE(queue.Push(1, Value::MakeDouble(1.0, 10)));
+  ASSERT_TRUE(queue.Push(2, Value::MakeInteger(5, 20)));
+  ASSERT_TRUE(queue.Push(1, Value::MakeDouble(2.0, 30)));
+  EXPECT_FALSE(queue.Empty());
+
+  std::vector<std::pair<NT_Handle, Value>> drained;
+  queue.Drain([&](NT_Handle handle, const Value& value) {
+    drained.emplace_back(handle, value);
+  });
+  ASSERT_EQ(drained.size(), 3u);
+  EXPECT_EQ(drained[0].first, 1u);
+  EXPECT_EQ(drained[0].second, Value::MakeDouble(1.0, 10));
+  EXPECT_EQ(drained[1].first, 2u);
+  EXPECT_EQ(drained[1].second, Value::MakeInteger(5, 20));
+  EXPECT_EQ(drained[2].first, 1u);
+  EXPECT_EQ(drained[2].second, Value::MakeDouble(2.0, 30));
+  EXPECT_TRUE(queue.Empty());
+}
+
+TEST(PendingValueQueueTest, Full) {
+  local::PendingValueQueue queue;
+  for (size_t i = 0; i < local::PendingValueQueue::kSize; ++i) {
+    ASSERT_TRUE(queue.Push(1, Value::MakeBoolean(true)));
+  }
+  EXPECT_FALSE(queue.Push(1, Value::MakeBoolean(false)));
+
+  size_t count = 0;
+  queue.Drain([&](NT_Handle, const Value&) { ++count; });
+  EXPECT_EQ(count, local::PendingValueQueue::kSize);
+
+  // wraps around after draining
+  EXPECT_TRUE(queue.Push(1, Value::MakeBoolean(false)));
+}
+
+TEST(PendingValueQueueTest, MultipleProducers) {
+  static constexpr int kThreads = 4;
+  static constexpr int kPerThread = 10000;
+  local::PendingValueQueue queue;
+  wpi::mutex consumerMutex;
+  std::vector<int> last(kThreads, -1);
+  std::atomic<int> received{0};
+  bool ordered = true;
+
+  auto drain = [&] {
+    std::scoped_lock lock{consumerMutex};
+    queue.Drain([&](NT_Handle handle, const Value& value) {
+      int seq = static_cast<int>(value.GetInteger());
+      if (seq <= last[handle]) {
+        ordered = false;
+      }
+      last[handle] = seq;
+      ++received;
+    });
+  };
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < kPerThread; ++i) {
+        while (!queue.Push(t, Value::MakeInteger(i))) {
+          drain();
+        }
+      }
+    });
+  }
+  for (auto&& thr : threads) {
+    thr.join();
+  }
+  drain();
+
+  EXPECT_EQ(received, kThreads * kPerThread);
+  EXPECT_TRUE(ordered);
+  for (int t = 0; t < kThreads; ++t) {
+    EXPECT_EQ(last[t], kPerThread - 1);
+  }
+}
+
+TEST(PendingValueQueueTest, ContendedSetValue) {
+  auto inst = CreateInstance();
+  auto topic = GetTopic(inst, "/foo");
+  auto sub = Subscribe(topic, NT_INTEGER, "int");
+  auto pub = Publish(topic, NT_INTEGER, "int");
+  std::atomic<bool> done{false};
+
+  // keep the storage lock busy so some sets take the queued path
+  std::thread reader{[&] {
+    while (!done) {
+      GetTopics(inst, "", 0);
+    }
+  }};
+  static constexpr int kCount = 20000;
+  for (int i = 1; i <= kCount; ++i) {
+    SetInteger(pub, i);
+  }
+  done = true;
+  reader.join();
+
+  EXPECT_EQ(GetInteger(sub, 0), kCount);
+  DestroyInstance(inst);
+}
+
+}  // namespace nt
@@ -0,0 +1,105 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "TestPrinters.h"
+#include "ntcore_cpp.h"
+
+class ServerIoThreadsTest : public ::testing::Test {
+ public:
+  ServerIoThreadsTest()
+      : m_serverInst(nt::CreateInstance()),
+        m_clientInst1(nt::CreateInstance()),
+        m_clientInst2(nt::CreateInstance()) {}
+
+  ~ServerIoThreadsTest() override {
+    nt::DestroyInstance(m_clientInst1);
+    nt::DestroyInstance(m_clientInst2);
+    nt::DestroyInstance(m_serverInst);
+  }
+
+  void Connect(NT_Inst inst, const char* name, unsigned int port,
+               bool nt3 = false);
+
+ protected:
+  NT_Inst m_serverInst;
+  NT_Inst m_clientInst1;
+  NT_Inst m_clientInst2;
+};
+
+void ServerIoThreadsTest::Connect(NT_Inst inst, const char* name,
+                                  unsigned int port, bool nt3) {
+  if (nt3) {
+    nt::StartClient3(inst, name);
+  } else {
+    nt::StartClient4(inst, name);
+  }
+  nt::SetServer(inst, "127.0.0.1", port);
+
+  // wait for client to report it's connected
+  int count = 0;
+  while (!nt::IsConnected(inst)) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    if (++count > 30) {
+      FAIL() << "client '" << name << "' didn't connect to server";
+    }
+  }
+}
+
+TEST_F(ServerIoThreadsTest, ValueAcrossLoops) {
+  nt::SetServerIoThreads(m_serverInst, 2);
+  nt::StartServer(m_serverInst, "serveriothreadstest.json", "127.0.0.1", 0,
+                  10040);
+  Connect(m_clientInst1, "client1", 10040);
+  Connect(m_clientInst2, "client2", 10040);
+
+  // with two I/O loops, the two clients are serviced by different threads
+  auto sub = nt::Subscribe(nt::GetTopic(m_clientInst2, "/foo"), NT_DOUBLE,
+                           "double");
+  auto pub =
+      nt::Publish(nt::GetTopic(m_clientInst1, "/foo"), NT_DOUBLE, "double");
+  nt::SetDouble(pub, 1.0);
+  nt::Flush(m_clientInst1);
+
+  int count = 0;
+  while (nt::GetDouble(sub, 0.0) != 1.0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    if (++count > 100) {
+      FAIL() << "timed out waiting for value";
+    }
+  }
+
+  // server sees both connections
+  EXPECT_EQ(nt::GetConnections(m_serverInst).size(), 2u);
+}
+
+TEST_F(ServerIoThreadsTest, ValueToNT3Client) {
+  nt::SetServerIoThreads(m_serverInst, 2);
+  nt::StartServer(m_serverInst, "serveriothreadstest.json", "127.0.0.1", 10041,
+                  10042);
+  Connect(m_clientInst1, "client1", 10042);
+  Connect(m_clientInst2, "client2", 10041, true);
+
+  // the NT4 client's I/O loop sends to the NT3 client owned by the main loop
+  auto sub = nt::Subscribe(nt::GetTopic(m_clientInst2, "/foo"), NT_DOUBLE,
+                           "double");
+  auto pub =
+      nt::Publish(nt::GetTopic(m_clientInst1, "/foo"), NT_DOUBLE, "double");
+  for (int i = 1; i <= 10; ++i) {
+    nt::SetDouble(pub, i);
+    nt::Flush(m_clientInst1);
+  }
+
+  int count = 0;
+  while (nt::GetDouble(sub, 0.0) != 10.0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    if (++count > 200) {
+      FAIL() << "timed out waiting for value";
+    }
+  }
+}
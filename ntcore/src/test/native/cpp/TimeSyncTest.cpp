@@ -20,6 +20,7 @@ class TimeSyncTest : public ::testing::Test {
 TEST_F(TimeSyncTest, TestLocal) {
   auto offset = m_inst.GetServerTimeOffset();
   ASSERT_FALSE(offset);
+  ASSERT_FALSE(m_inst.GetServerTimeSync().valid);
 }
 
 TEST_F(TimeSyncTest, TestServer) {
@@ -30,6 +31,11 @@ TEST_F(TimeSyncTest, TestServer) {
   auto offset = m_inst.GetServerTimeOffset();
   ASSERT_TRUE(offset);
   ASSERT_EQ(0, *offset);
+  auto sync = m_inst.GetServerTimeSync();
+  ASSERT_TRUE(sync.valid);
+  ASSERT_EQ(0, sync.serverTimeOffset);
+  ASSERT_EQ(0, sync.rtt2);
+  ASSERT_EQ(0, sync.uncertainty);
 
   auto events = poller.ReadQueue();
   ASSERT_EQ(1u, events.size());
@@ -38,6 +44,7 @@ TEST_F(TimeSyncTest, TestServer) {
   ASSERT_TRUE(data->valid);
   ASSERT_EQ(0, data->serverTimeOffset);
   ASSERT_EQ(0, data->rtt2);
+  ASSERT_EQ(0, data->uncertainty);
 
   m_inst.StopServer();
   offset = m_inst.GetServerTimeOffset();
@@ -0,0 +1,93 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "TestPrinters.h"
+#include "ValueCircularBuffer.h"
+#include "networktables/NetworkTableValue.h"
+
+namespace nt {
+
+TEST(ValueCircularBufferTest, NoCoalesce) {
+  ValueCircularBuffer buf{10};
+  buf.emplace_back(Value::MakeDouble(1.0, 100));
+  buf.emplace_back(Value::MakeDouble(2.0, 101));
+  auto values = buf.Read<double>();
+  ASSERT_EQ(values.size(), 2u);
+  EXPECT_EQ(values[0].value, 1.0);
+  EXPECT_EQ(values[1].value, 2.0);
+}
+
+TEST(ValueCircularBufferTest, Coalesce) {
+  ValueCircularBuffer buf{10, 1000};
+  buf.emplace_back(Value::MakeDouble(1.0, 100));
+  buf.emplace_back(Value::MakeDouble(2.0, 500));
+  buf.emplace_back(Value::MakeDouble(3.0, 999));
+  buf.emplace_back(Value::MakeDouble(4.0, 1000));
+  buf.emplace_back(Value::MakeDouble(5.0, 2500));
+  auto values = buf.Read<double>();
+  ASSERT_EQ(values.size(), 3u);
+  EXPECT_EQ(values[0].value, 3.0);
+  EXPECT_EQ(values[0].time, 999);
+  EXPECT_EQ(values[1].value, 4.0);
+  EXPECT_EQ(values[2].value, 5.0);
+
+  // buffer starts over after a read
+  buf.emplace_back(Value::MakeDouble(6.0, 2600));
+  auto values2 = buf.ReadValue(0);
+  ASSERT_EQ(values2.size(), 1u);
+  EXPECT_EQ(values2[0], Value::MakeDouble(6.0, 2600));
+}
+
+TEST(ValueCircularBufferTest, ReadIntoBuffer) {
+  ValueCircularBuffer buf{10};
+  std::vector<Timestamped<std::vector<double>>> out;
+  std::vector<double> arr1{1.0, 2.0, 3.0};
+  std::vector<double> arr2{4.0};
+  buf.emplace_back(Value::MakeDoubleArray(arr1, 100));
+  buf.emplace_back(Value::MakeDoubleArray(arr2, 200));
+  buf.Read<double[]>(out);
+  ASSERT_EQ(out.size(), 2u);
+  EXPECT_EQ(out[0].time, 100);
+  EXPECT_EQ(out[0].value, arr1);
+  EXPECT_EQ(out[1].value, arr2);
+
+  // existing element storage is reused
+  const double* data = out[0].value.data();
+  buf.emplace_back(Value::MakeIntegerArray(std::vector<int64_t>{5, 6}, 300));
+  buf.Read<double[]>(out);
+  ASSERT_EQ(out.size(), 1u);
+  EXPECT_EQ(out[0].time, 300);
+  EXPECT_EQ(out[0].value, (std::vector<double>{5.0, 6.0}));
+  EXPECT_EQ(out[0].value.data(), data);
+
+  buf.Read<double[]>(out);
+  EXPECT_TRUE(out.empty());
+}
+
+TEST(ValueCircularBufferTest, ReadIntoBufferKeepsCapacity) {
+  ValueCircularBuffer buf{10};
+  std::vector<Timestamped<double>> out;
+  buf.emplace_back(Value::MakeDouble(1.0, 100));
+  buf.emplace_back(Value::MakeDouble(2.0, 200));
+  buf.Read<double>(out);
+  ASSERT_EQ(out.size(), 2u);
+  const auto* data = out.data();
+
+  // an empty read clears buf but keeps its capacity
+  buf.Read<double>(out);
+  EXPECT_TRUE(out.empty());
+
+  buf.emplace_back(Value::MakeDouble(3.0, 300));
+  buf.emplace_back(Value::MakeDouble(4.0, 400));
+  buf.Read<double>(out);
+  ASSERT_EQ(out.size(), 2u);
+  EXPECT_EQ(out[1].value, 4.0);
+  EXPECT_EQ(out.data(), data);
+}
+
+}  // namespace nt
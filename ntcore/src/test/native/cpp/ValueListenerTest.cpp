@@ -2,6 +2,8 @@
 // Open Source Software; you can modify and/or share it under the terms of
 // the WPILib BSD license file in the root directory of this project.
 
+#include <atomic>
+
 #include <gtest/gtest.h>
 #include <wpi/StringExtras.h>
 #include <wpi/Synchronization.h>
@@ -406,4 +408,27 @@ TEST_F(ValueListenerTest, TwoSubOneMultiListener) {
   EXPECT_EQ(valueData->value, nt::Value::MakeDouble(0.0));
 }
 
+TEST_F(ValueListenerTest, ListenerThreads) {
+  nt::SetListenerThreads(m_inst, 2);
+  auto entry1 = nt::GetEntry(m_inst, "foo");
+  auto entry2 = nt::GetEntry(m_inst, "bar");
+
+  // the first callback blocks until the second one runs, which requires them
+  // to be on different threads
+  wpi::Event event;
+  std::atomic_bool timedOut = true;
+  nt::AddListener(entry1, nt::EventFlags::kValueLocal, [&](auto&) {
+    bool waitTimedOut = false;
+    wpi::WaitForObject(event.GetHandle(), 1.0, &waitTimedOut);
+    timedOut = waitTimedOut;
+  });
+  nt::AddListener(entry2, nt::EventFlags::kValueLocal,
+                  [&](auto&) { event.Set(); });
+
+  ASSERT_TRUE(nt::SetDouble(entry1, 0));
+  ASSERT_TRUE(nt::SetDouble(entry2, 0));
+  ASSERT_TRUE(nt::WaitForListenerQueue(m_inst, 2.0));
+  EXPECT_FALSE(timedOut);
+}
+
 }  // namespace nt
@@ -129,6 +129,58 @@ TEST_F(ValueTest, Raw) {
   NT_DisposeValue(&cv);
 }
 
+TEST_F(ValueTest, RawInPlace) {
+  auto v = Value::MakeRaw(
+      4,
+      [](std::span<uint8_t> data) {
+        ASSERT_EQ(data.size(), 4u);
+        for (size_t i = 0; i < data.size(); ++i) {
+          data[i] = i + 1;
+        }
+      },
+      5);
+  ASSERT_EQ(NT_RAW, v.type());
+  ASSERT_EQ(5, v.time());
+  ASSERT_EQ(4u, v.size());
+  ASSERT_EQ(std::span(reinterpret_cast<const uint8_t*>("\1\2\3\4"), 4),
+            v.GetRaw());
+}
+
+TEST_F(ValueTest, CopyMove) {
+  // small values are stored inline; large values are shared
+  std::vector<double> small{0.5, 0.25, 0.5};
+  std::vector<double> large(16, 0.5);
+  for (auto&& vec : {small, large}) {
+    auto v = Value::MakeDoubleArray(vec);
+    Value copy{v};
+    ASSERT_EQ(std::span<const double>(vec), copy.GetDoubleArray());
+    Value moved{std::move(copy)};
+    ASSERT_EQ(std::span<const double>(vec), moved.GetDoubleArray());
+    copy = v;
+    v = Value::MakeDouble(1.0);
+    ASSERT_EQ(std::span<const double>(vec), copy.GetDoubleArray());
+    v = std::move(copy);
+    ASSERT_EQ(std::span<const double>(vec), v.GetDoubleArray());
+  }
+
+  std::string str = "hello";
+  for (auto&& s : {str, std::string(100, 'x')}) {
+    auto v = Value::MakeString(s);
+    std::vector<Value> values(3, v);
+    values.resize(100);
+    for (size_t i = 0; i < 3; ++i) {
+      ASSERT_EQ(s, values[i].GetString());
+      ASSERT_EQ('\0', values[i].value().data.v_string.str[s.size()]);
+    }
+    ASSERT_EQ(v, values[0]);
+  }
+
+  auto v = Value::MakeRaw(std::vector<uint8_t>{1, 2, 3});
+  Value copy = v;
+  ASSERT_NE(v.GetRaw().data(), copy.GetRaw().data());
+  ASSERT_EQ(v, copy);
+}
+
 TEST_F(ValueTest, BooleanArray) {
   std::vector<int> vec{1, 0, 1};
   auto v = Value::MakeBooleanArray(vec);
@@ -0,0 +1,33 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <stdint.h>
+
+#include <gtest/gtest.h>
+
+#include "../MockLogger.h"
+#include "MockWireConnection.h"
+#include "gmock/gmock.h"
+#include "net/ClientImpl.h"
+
+using ::testing::_;
+using ::testing::Return;
+
+namespace nt {
+
+TEST(ClientImplTest, BinaryDecodeErrorDisconnects) {
+  wpi::MockLogger logger;
+  ::testing::NiceMock<net::MockWireConnection> wire;
+  ON_CALL(wire, GetVersion()).WillByDefault(Return(0x0401));
+  net::ClientImpl client{
+      0, wire, logger, [](int64_t, int64_t, bool, int64_t) {},
+      [](uint32_t) {}};
+
+  EXPECT_CALL(wire, Disconnect(_));
+  // integer array delta for a topic with no value to apply it to
+  const uint8_t data[] = {0x94, 0x05, 0x06, 0x52, 0x93, 0x04, 0x02, 0x04};
+  client.ProcessIncomingBinary(0, data);
+}
+
+}  // namespace nt
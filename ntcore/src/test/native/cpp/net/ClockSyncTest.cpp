@@ -0,0 +1,108 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <stdint.h>
+
+#include <cmath>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "net/ClockSync.h"
+
+namespace nt::net {
+
+// Simulates ping exchanges with a server whose clock is offset and drifting
+// relative to the local clock, over a link with random one-way delays.
+class ClockSyncTest : public ::testing::Test {
+ public:
+  int64_t ServerTime(int64_t localTime) const {
+    return localTime + kOffset + std::llround(drift * localTime);
+  }
+
+  // returns the true offset at localTime
+  int64_t TrueOffset(int64_t localTime) const {
+    return ServerTime(localTime) - localTime;
+  }
+
+  // pings at time, returns the receive time
+  int64_t Ping(int64_t time) {
+    int64_t send = time;
+    int64_t serverRecv = send + Delay();
+    int64_t recv = serverRecv + Delay();
+    sync.AddSample(send, ServerTime(serverRecv), recv);
+    return recv;
+  }
+
+  // mostly short delays, with occasional long ones
+  int64_t Delay() { return 100 + static_cast<int64_t>(delayDist(rng)); }
+
+  static constexpr int64_t kOffset = 1000000000;
+  double drift = 0;
+  std::mt19937 rng{1234};
+  std::exponential_distribution<double> delayDist{1.0 / 2000};
+  ClockSync sync;
+};
+
+TEST_F(ClockSyncTest, Invalid) {
+  EXPECT_FALSE(sync.IsValid());
+  EXPECT_FALSE(sync.AddSample(1000, 0, 999));
+  EXPECT_FALSE(sync.IsValid());
+}
+
+TEST_F(ClockSyncTest, SingleSample) {
+  EXPECT_TRUE(sync.AddSample(1000, 5000, 1200));
+  ASSERT_TRUE(sync.IsValid());
+  EXPECT_EQ(sync.GetOffset(1200), 5000 - 1100);
+  EXPECT_EQ(sync.GetRtt2(), 100);
+  EXPECT_EQ(sync.GetUncertainty(1100), 100);
+  EXPECT_GT(sync.GetUncertainty(1000100), 100);
+}
+
+TEST_F(ClockSyncTest, MinRoundTripSelected) {
+  EXPECT_TRUE(sync.AddSample(0, 5000, 4000));        // offset 3000 +/- 2000
+  EXPECT_TRUE(sync.AddSample(10000, 14200, 10200));  // offset 4100 +/- 100
+  // a later sample with a longer round trip doesn't replace it
+  EXPECT_FALSE(sync.AddSample(20000, 27000, 22000));
+  EXPECT_EQ(sync.GetOffset(20000), 4100);
+}
+
+TEST_F(ClockSyncTest, OldSamplesExpire) {
+  // offset 4000 +/- 100, then offset 3000 +/- 10000
+  EXPECT_TRUE(sync.AddSample(0, 4100, 200));
+  int64_t time = 0;
+  for (size_t i = 1; i < ClockSync::kWindowSize; ++i) {
+    time += 1000000;
+    sync.AddSample(time, time + 13000, time + 20000);
+  }
+  EXPECT_EQ(sync.GetOffset(time), 4000);
+  time += 1000000;
+  EXPECT_TRUE(sync.AddSample(time, time + 13000, time + 20000));
+  EXPECT_EQ(sync.GetOffset(time), 3000);
+}
+
+TEST_F(ClockSyncTest, Jitter) {
+  int64_t time = 0;
+  for (int i = 0; i < 30; ++i) {
+    time = Ping(time) + 1000000;
+    int64_t error = sync.GetOffset(time) - TrueOffset(time);
+    EXPECT_LE(std::abs(error), sync.GetUncertainty(time)) << "ping " << i;
+  }
+  // the filtered offset is much better than the mean one-way delay
+  EXPECT_LT(std::abs(sync.GetOffset(time) - TrueOffset(time)), 500);
+}
+
+TEST_F(ClockSyncTest, Drift) {
+  drift = 80e-6;
+  int64_t time = 0;
+  for (int i = 0; i < 600; ++i) {
+    time = Ping(time) + 1000000;
+    int64_t error = sync.GetOffset(time) - TrueOffset(time);
+    EXPECT_LE(std::abs(error), sync.GetUncertainty(time)) << "ping " << i;
+  }
+  EXPECT_NEAR(sync.GetDrift(), drift, 10e-6);
+  EXPECT_LT(std::abs(sync.GetOffset(time) - TrueOffset(time)), 500);
+}
+
+}  // namespace nt::net
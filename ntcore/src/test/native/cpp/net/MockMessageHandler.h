@@ -30,6 +30,8 @@ class MockClientMessageHandler : public net::ClientMessageHandler {
   MOCK_METHOD(void, ClientUnsubscribe, (int subuid), (override));
   MOCK_METHOD(void, ClientSetValue, (int pubuid, const Value& value),
               (override));
+  MOCK_METHOD(void, ClientResume, (std::string_view token, int64_t seq),
+              (override));
 };
 
 class MockServerMessageHandler : public net::ServerMessageHandler {
@@ -45,6 +47,8 @@ class MockServerMessageHandler : public net::ServerMessageHandler {
               (override));
   MOCK_METHOD(void, ServerSetValue, (int topicuid, const Value& value),
               (override));
+  MOCK_METHOD(void, ServerCheckpoint, (std::string_view token, int64_t seq),
+              (override));
 };
 
 }  // namespace nt::net
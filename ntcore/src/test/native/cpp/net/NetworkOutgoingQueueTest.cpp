@@ -0,0 +1,109 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <stdint.h>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <wpi/SpanMatcher.h>
+#include <wpi/raw_ostream.h>
+
+#include "../TestPrinters.h"
+#include "MockWireConnection.h"
+#include "gmock/gmock.h"
+#include "net/NetworkOutgoingQueue.h"
+#include "net/WireEncoder.h"
+
+using ::testing::Return;
+
+namespace nt::net {
+
+static std::vector<uint8_t> EncodeValue(int id, const Value& value) {
+  std::vector<uint8_t> data;
+  wpi::raw_uvector_ostream os{data};
+  WireEncodeBinary(os, id, value.time(), value);
+  return data;
+}
+
+class NetworkOutgoingQueueTest : public ::testing::Test {
+ public:
+  NetworkOutgoingQueueTest() {
+    EXPECT_CALL(wire, GetVersion()).WillRepeatedly(Return(0x0401));
+    EXPECT_CALL(wire, Ready()).WillRepeatedly(Return(true));
+    EXPECT_CALL(wire, Flush()).WillRepeatedly(Return(0));
+  }
+
+  ::testing::StrictMock<MockWireConnection> wire;
+  NetworkOutgoingQueue<ServerMessage> queue{wire, false};
+};
+
+TEST_F(NetworkOutgoingQueueTest, PriorityOrder) {
+  auto critical = Value::MakeDouble(1.0, 10);
+  auto bulk = Value::MakeDouble(2.0, 10);
+  queue.SetPeriod(1, 100, SendPriority::kBulk);
+  queue.SetPeriod(2, 100, SendPriority::kCritical);
+  queue.SendValue(1, bulk, ValueSendMode::kNormal);
+  queue.SendValue(2, critical, ValueSendMode::kNormal);
+
+  ::testing::InSequence seq;
+  EXPECT_CALL(wire, DoWriteBinary(wpi::SpanEq(EncodeValue(2, critical))))
+      .WillOnce(Return(0));
+  EXPECT_CALL(wire, DoWriteBinary(wpi::SpanEq(EncodeValue(1, bulk))))
+      .WillOnce(Return(0));
+  queue.SendOutgoing(1000, false);
+}
+
+TEST_F(NetworkOutgoingQueueTest, BandwidthLimitDefersBulk) {
+  // 100 bytes of burst budget, less than a single queued message
+  queue.SetBandwidthLimit(1000);
+  auto critical = Value::MakeDouble(1.0, 10);
+  auto bulk = Value::MakeDouble(2.0, 10);
+  queue.SetPeriod(1, 100, SendPriority::kBulk);
+  queue.SetPeriod(2, 100, SendPriority::kCritical);
+  queue.SendValue(1, bulk, ValueSendMode::kNormal);
+  queue.SendValue(2, critical, ValueSendMode::kNormal);
+
+  // critical is sent even though it exhausts the budget
+  EXPECT_CALL(wire, DoWriteBinary(wpi::SpanEq(EncodeValue(2, critical))))
+      .WillOnce(Return(0));
+  queue.SendOutgoing(1000, false);
+  ::testing::Mock::VerifyAndClearExpectations(&wire);
+
+  // still over budget
+  EXPECT_CALL(wire, GetVersion()).WillRepeatedly(Return(0x0401));
+  EXPECT_CALL(wire, Ready()).WillRepeatedly(Return(true));
+  EXPECT_CALL(wire, Flush()).WillRepeatedly(Return(0));
+  queue.SendOutgoing(1010, false);
+
+  // newer bulk value replaces the deferred one, and is sent once the budget
+  // refills
+  auto bulk2 = Value::MakeDouble(3.0, 20);
+  queue.SendValue(1, bulk2, ValueSendMode::kNormal);
+  EXPECT_CALL(wire, DoWriteBinary(wpi::SpanEq(EncodeValue(1, bulk2))))
+      .WillOnce(Return(0));
+  queue.SendOutgoing(2000, false);
+}
+
+TEST_F(NetworkOutgoingQueueTest, StatsCoalescedAndDropped) {
+  queue.SendValue(1, Value::MakeDouble(1.0, 10), ValueSendMode::kNormal);
+  queue.SendValue(1, Value::MakeDouble(2.0, 20), ValueSendMode::kNormal);
+  auto stats = queue.GetStats();
+  EXPECT_EQ(stats.coalesced, 1u);
+  EXPECT_EQ(stats.dropped, 0u);
+  EXPECT_EQ(stats.queuedMessages, 1u);
+  EXPECT_GT(stats.queuedBytes, 0u);
+
+  // fill the queue so sendAll values are replaced rather than appended
+  queue.SendValue(2, Value::MakeRaw(std::vector<uint8_t>(2 * 1024 * 1024), 10),
+                  ValueSendMode::kAll);
+  queue.SendValue(3, Value::MakeDouble(1.0, 10), ValueSendMode::kAll);
+  queue.SendValue(3, Value::MakeDouble(2.0, 20), ValueSendMode::kAll);
+  stats = queue.GetStats();
+  EXPECT_EQ(stats.coalesced, 1u);
+  EXPECT_EQ(stats.dropped, 1u);
+  EXPECT_EQ(stats.queuedMessages, 3u);
+}
+
+}  // namespace nt::net
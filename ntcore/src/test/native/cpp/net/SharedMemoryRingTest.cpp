@@ -0,0 +1,116 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <stdint.h>
+
+#include <numeric>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "net/SharedMemoryRing.h"
+
+namespace nt::net {
+
+class SharedMemoryRingTest : public ::testing::Test {
+ public:
+  SharedMemoryRingTest() { ring.Init(); }
+
+  std::vector<uint8_t> Read() {
+    std::vector<uint8_t> out;
+    EXPECT_TRUE(ring.ReadOne([&](uint8_t type, std::span<const uint8_t> data) {
+      out.push_back(type);
+      out.insert(out.end(), data.begin(), data.end());
+    }));
+    return out;
+  }
+
+  // 64-byte data area
+  alignas(64) uint8_t mem[SharedMemoryRing::kHeaderSize + 64];
+  SharedMemoryRing ring{mem, sizeof(mem)};
+};
+
+TEST_F(SharedMemoryRingTest, WriteRead) {
+  EXPECT_FALSE(ring.HasData());
+  uint8_t data[] = {1, 2, 3};
+  ASSERT_TRUE(ring.Write(5, data));
+  ASSERT_TRUE(ring.Write(6, {}));
+  EXPECT_TRUE(ring.HasData());
+  EXPECT_EQ(Read(), (std::vector<uint8_t>{5, 1, 2, 3}));
+  EXPECT_EQ(Read(), (std::vector<uint8_t>{6}));
+  EXPECT_FALSE(ring.HasData());
+}
+
+TEST_F(SharedMemoryRingTest, WrapAround) {
+  std::vector<uint8_t> data(20);
+  std::iota(data.begin(), data.end(), 0);
+  // each record takes 32 bytes; the third one wraps around to the start
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_TRUE(ring.Write(1, data));
+    std::vector<uint8_t> expected{1};
+    expected.insert(expected.end(), data.begin(), data.end());
+    EXPECT_EQ(Read(), expected);
+  }
+  // payload spanning the end of the data area
+  ASSERT_TRUE(ring.Write(1, std::span{data}.subspan(0, 4)));
+  EXPECT_EQ(Read(), (std::vector<uint8_t>{1, 0, 1, 2, 3}));
+  std::vector<uint8_t> big(48);
+  std::iota(big.begin(), big.end(), 100);
+  ASSERT_TRUE(ring.Write(2, big));
+  std::vector<uint8_t> expected{2};
+  expected.insert(expected.end(), big.begin(), big.end());
+  EXPECT_EQ(Read(), expected);
+}
+
+TEST_F(SharedMemoryRingTest, FullSetsWriterWaiting) {
+  std::vector<uint8_t> data(24);
+  ASSERT_TRUE(ring.Write(1, data));
+  ASSERT_TRUE(ring.Write(1, data));
+  EXPECT_FALSE(ring.ConsumeWriterWaiting());
+  EXPECT_FALSE(ring.Write(1, data));
+  Read();
+  EXPECT_TRUE(ring.ConsumeWriterWaiting());
+  EXPECT_FALSE(ring.ConsumeWriterWaiting());
+  EXPECT_TRUE(ring.Write(1, data));
+}
+
+TEST_F(SharedMemoryRingTest, TooLarge) {
+  std::vector<uint8_t> data(ring.GetMaxPayloadSize() + 1);
+  EXPECT_FALSE(ring.Write(1, data));
+  data.pop_back();
+  EXPECT_TRUE(ring.Write(1, data));
+}
+
+TEST_F(SharedMemoryRingTest, ReaderWaiting) {
+  // reader starts out waiting
+  ASSERT_TRUE(ring.Write(1, {}));
+  EXPECT_TRUE(ring.ConsumeReaderWaiting());
+  ASSERT_TRUE(ring.Write(1, {}));
+  EXPECT_FALSE(ring.ConsumeReaderWaiting());
+
+  // data still queued, so the reader shouldn't wait
+  EXPECT_TRUE(ring.SetReaderWaiting());
+  Read();
+  Read();
+  EXPECT_FALSE(ring.SetReaderWaiting());
+  ASSERT_TRUE(ring.Write(1, {}));
+  EXPECT_TRUE(ring.ConsumeReaderWaiting());
+}
+
+TEST_F(SharedMemoryRingTest, CorruptLength) {
+  uint8_t data[] = {1, 2, 3};
+  ASSERT_TRUE(ring.Write(1, data));
+  // the peer overwrites the record length with one past the written data
+  mem[SharedMemoryRing::kHeaderSize] = 200;
+  EXPECT_FALSE(ring.ReadOne([](uint8_t, std::span<const uint8_t>) {
+    ADD_FAILURE() << "read corrupt record";
+  }));
+  EXPECT_TRUE(ring.IsCorrupt());
+
+  // nothing more is read, even valid records
+  ASSERT_TRUE(ring.Write(1, data));
+  EXPECT_FALSE(ring.ReadOne([](uint8_t, std::span<const uint8_t>) {}));
+}
+
+}  // namespace nt::net
@@ -2,10 +2,16 @@
 // Open Source Software; you can modify and/or share it under the terms of
 // the WPILib BSD license file in the root directory of this project.
 
+#include <stdint.h>
+
+#include <span>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include <wpi/SmallString.h>
+#include <wpi/SpanMatcher.h>
 #include <wpi/raw_ostream.h>
 
 #include "../MockLogger.h"
@@ -166,6 +172,66 @@ TEST_F(WireDecodeTextClientTest, PublishError) {
       handler, logger);
 }
 
+TEST_F(WireDecodeTextClientTest, PublishNestedProps) {
+  wpi::json props = {{"a", {{"b", {1, {{"c", nullptr}}, "x"}}}}, {"d", true}};
+  EXPECT_CALL(handler, ClientPublish(5, std::string_view{"test"},
+                                     std::string_view{"double"}, props,
+                                     PubSubOptionsEq({})));
+  net::WireDecodeText(
+      "[{\"method\":\"publish\",\"params\":{"
+      "\"name\":\"test\",\"properties\":{\"a\":{\"b\":[1,{\"c\":null},\"x\"]},"
+      "\"d\":true},\"pubuid\":5,\"type\":\"double\"}}]",
+      handler, logger);
+}
+
+TEST_F(WireDecodeTextClientTest, ParamsBeforeMethod) {
+  EXPECT_CALL(handler, ClientPublish(5, std::string_view{"test"},
+                                     std::string_view{"double"},
+                                     wpi::json::object(), PubSubOptionsEq({})));
+  net::WireDecodeText(
+      "[{\"params\":{\"name\":\"test\",\"pubuid\":5,\"type\":\"double\","
+      "\"extra\":[{\"name\":\"x\"}]},\"method\":\"publish\"}]",
+      handler, logger);
+}
+
+TEST_F(WireDecodeTextClientTest, ParseErrorAfterMessage) {
+  // nothing is handled if any part of the frame fails to parse
+  EXPECT_CALL(logger, Call(_, _, _, _));
+  net::WireDecodeText(
+      "[{\"method\":\"unpublish\",\"params\":{\"pubuid\":5}},{", handler,
+      logger);
+}
+
+TEST_F(WireDecodeTextClientTest, Subscribe) {
+  PubSubOptionsImpl options;
+  options.periodic = 0.5;
+  options.periodicMs = 500;
+  options.sendAll = true;
+  options.prefixMatch = true;
+  std::vector<std::string> topics{"a", "b"};
+  EXPECT_CALL(handler, ClientSubscribe(7, wpi::SpanEq(topics),
+                                       PubSubOptionsEq(options)));
+  net::WireDecodeText(
+      "[{\"method\":\"subscribe\",\"params\":{\"subuid\":7,"
+      "\"options\":{\"periodic\":0.5,\"all\":true,\"prefix\":true},"
+      "\"topics\":[\"a\",\"b\"]}}]",
+      handler, logger);
+}
+
+TEST_F(WireDecodeTextClientTest, SubscribeError) {
+  EXPECT_CALL(logger, Call(_, _, _, "0: topics/1 must be a string"sv));
+  net::WireDecodeText(
+      "[{\"method\":\"subscribe\",\"params\":{\"subuid\":7,"
+      "\"topics\":[\"a\",[\"b\"],\"c\"]}}]",
+      handler, logger);
+
+  EXPECT_CALL(logger, Call(_, _, _, "0: all value must be a boolean"sv));
+  net::WireDecodeText(
+      "[{\"method\":\"subscribe\",\"params\":{\"subuid\":7,"
+      "\"options\":{\"all\":1},\"topics\":[]}}]",
+      handler, logger);
+}
+
 TEST_F(WireDecodeTextClientTest, Unpublish) {
   EXPECT_CALL(handler, ClientUnpublish(5));
   net::WireDecodeText("[{\"method\":\"unpublish\",\"params\":{\"pubuid\":5}}]",
@@ -192,4 +258,166 @@ TEST_F(WireDecodeTextClientTest, UnpublishError) {
       logger);
 }
 
+TEST_F(WireDecodeTextClientTest, Resume) {
+  EXPECT_CALL(handler, ClientResume(std::string_view{"abc"}, 5));
+  net::WireDecodeText(
+      "[{\"method\":\"resume\",\"params\":{\"token\":\"abc\",\"seq\":5}}]",
+      handler, logger);
+}
+
+TEST_F(WireDecodeTextClientTest, ResumeError) {
+  EXPECT_CALL(logger, Call(_, _, _, "0: no token key"sv));
+  net::WireDecodeText("[{\"method\":\"resume\",\"params\":{\"seq\":5}}]",
+                      handler, logger);
+
+  EXPECT_CALL(logger, Call(_, _, _, "0: no seq key"sv));
+  net::WireDecodeText(
+      "[{\"method\":\"resume\",\"params\":{\"token\":\"abc\"}}]", handler,
+      logger);
+}
+
+TEST_F(WireDecodeTextServerTest, Checkpoint) {
+  EXPECT_CALL(handler, ServerCheckpoint(std::string_view{"abc"}, 5));
+  net::WireDecodeText(
+      "[{\"method\":\"checkpoint\",\"params\":{\"token\":\"abc\","
+      "\"seq\":5}}]",
+      handler, logger);
+}
+
+TEST_F(WireDecodeTextServerTest, Announce) {
+  wpi::json props = {{"persistent", true}};
+  EXPECT_CALL(handler, ServerAnnounce(std::string_view{"test"}, 3,
+                                      std::string_view{"double"}, props,
+                                      std::optional<int>{5}));
+  net::WireDecodeText(
+      "[{\"method\":\"announce\",\"params\":{\"name\":\"test\",\"id\":3,"
+      "\"type\":\"double\",\"pubuid\":5,"
+      "\"properties\":{\"persistent\":true}}}]",
+      handler, logger);
+}
+
+TEST_F(WireDecodeTextServerTest, AnnouncePropsNotObject) {
+  EXPECT_CALL(logger, Call(_, _, _, "test: properties is not an object"sv));
+  EXPECT_CALL(handler, ServerAnnounce(std::string_view{"test"}, 3,
+                                      std::string_view{"double"},
+                                      wpi::json::object(),
+                                      std::optional<int>{}));
+  net::WireDecodeText(
+      "[{\"method\":\"announce\",\"params\":{\"name\":\"test\",\"id\":3,"
+      "\"type\":\"double\",\"properties\":5}}]",
+      handler, logger);
+}
+
+TEST(WireDecodeBinaryTest, IntegerArrayDelta) {
+  auto data = "\x94\x05\x06\x52\x93\x04\x02\x04"_us;
+  std::span<const uint8_t> in = data;
+  Value base = Value::MakeIntegerArray({1, 2, 3, 8});
+  int id;
+  Value value;
+  std::string error;
+  ASSERT_TRUE(net::WireDecodeBinary(&in, &id, &value, &error, 0,
+                                    [&](int) { return &base; }));
+  EXPECT_TRUE(in.empty());
+  EXPECT_EQ(id, 5);
+  EXPECT_EQ(value, Value::MakeIntegerArray({1, 2, 4, 8}));
+  EXPECT_EQ(value.server_time(), 6);
+}
+
+TEST(WireDecodeBinaryTest, ArrayDeltaNoBase) {
+  auto data = "\x94\x05\x06\x52\x93\x04\x02\x04"_us;
+  std::span<const uint8_t> in = data;
+  int id;
+  Value value;
+  std::string error;
+  ASSERT_FALSE(net::WireDecodeBinary(&in, &id, &value, &error, 0));
+  EXPECT_EQ(error, "delta for id 5 without matching base value");
+}
+
+TEST(WireDecodeBinaryTest, ArrayDeltaBadIndex) {
+  auto data = "\x94\x05\x06\x52\x93\x04\x07\x04"_us;
+  std::span<const uint8_t> in = data;
+  Value base = Value::MakeIntegerArray({1, 2, 3, 8});
+  int id;
+  Value value;
+  std::string error;
+  ASSERT_FALSE(net::WireDecodeBinary(&in, &id, &value, &error, 0,
+                                     [&](int) { return &base; }));
+}
+
+TEST(WireDecodeBinaryTest, ArrayDeltaGrow) {
+  auto data = "\x94\x05\x06\x52\x95\x05\x03\x07\x04\x09"_us;
+  std::span<const uint8_t> in = data;
+  Value base = Value::MakeIntegerArray({1, 2, 3});
+  int id;
+  Value value;
+  std::string error;
+  ASSERT_TRUE(net::WireDecodeBinary(&in, &id, &value, &error, 0,
+                                    [&](int) { return &base; }));
+  EXPECT_EQ(value, Value::MakeIntegerArray({1, 2, 3, 7, 9}));
+}
+
+TEST(WireDecodeBinaryTest, ArrayDeltaGrowMissingElement) {
+  // grows to 5 elements but only gives index 3 (twice)
+  auto data = "\x94\x05\x06\x52\x95\x05\x03\x07\x03\x07"_us;
+  std::span<const uint8_t> in = data;
+  Value base = Value::MakeIntegerArray({1, 2, 3});
+  int id;
+  Value value;
+  std::string error;
+  ASSERT_FALSE(net::WireDecodeBinary(&in, &id, &value, &error, 0,
+                                     [&](int) { return &base; }));
+}
+
+TEST(WireDecodeBinaryTest, Batch) {
+  auto data =
+      "\x94\xfe\x06\x60\x94"
+      "\x93\x05\x07\x09"
+      "\x93\x00\x02\x04"
+      "\x93\x00\x02\x03"
+      "\xc4\x0d\x01"
+      "\x07\x00\x00\x00\x00\x00\x00\x00"
+      "\x00\x00\x20\x40"
+      "\x94\x05\x06\x00\xc3"_us;
+  std::span<const uint8_t> in = data;
+  std::vector<std::pair<int, Value>> values;
+  bool isBatch;
+  std::string error;
+  ASSERT_TRUE(net::WireDecodeBinaryBatch(
+      &in, &isBatch,
+      [&](int id, Value& value) { values.emplace_back(id, value); }, &error,
+      0));
+  ASSERT_TRUE(isBatch);
+  ASSERT_EQ(values.size(), 3u);
+  EXPECT_EQ(values[0].first, 5);
+  EXPECT_EQ(values[0].second, Value::MakeBoolean(true));
+  EXPECT_EQ(values[0].second.server_time(), 6);
+  EXPECT_EQ(values[1].first, 7);
+  EXPECT_EQ(values[1].second, Value::MakeInteger(7));
+  EXPECT_EQ(values[1].second.server_time(), 8);
+  EXPECT_EQ(values[2].first, 9);
+  EXPECT_EQ(values[2].second, Value::MakeFloat(2.5));
+  EXPECT_EQ(values[2].second.server_time(), 10);
+
+  // following non-batch message is left alone
+  EXPECT_EQ(in.size(), 5u);
+  ASSERT_TRUE(net::WireDecodeBinaryBatch(
+      &in, &isBatch, [&](int, Value&) { FAIL(); }, &error, 0));
+  EXPECT_FALSE(isBatch);
+  EXPECT_EQ(in.size(), 5u);
+}
+
+TEST(WireDecodeBinaryTest, BatchSizeMismatch) {
+  auto data =
+      "\x94\xfe\x06\x60\x94"
+      "\x92\x05\x07"
+      "\x91\x00"
+      "\x92\x00\x00"
+      "\xc4\x02\x01\x00"_us;
+  std::span<const uint8_t> in = data;
+  bool isBatch;
+  std::string error;
+  ASSERT_FALSE(net::WireDecodeBinaryBatch(
+      &in, &isBatch, [&](int, Value&) { FAIL(); }, &error, 0));
+}
+
 }  // namespace nt
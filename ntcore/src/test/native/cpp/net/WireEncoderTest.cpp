@@ -95,6 +95,17 @@ TEST_F(WireEncoderTextTest, SubscribePeriodic) {
             "\"subuid\":5}}");
 }
 
+TEST_F(WireEncoderTextTest, SubscribeDeltas) {
+  PubSubOptionsImpl options;
+  options.deltaArrays = true;
+  net::WireEncodeSubscribe(os, 5, std::span<const std::string_view>{{"a", "b"}},
+                           options);
+  ASSERT_EQ(os.str(),
+            "{\"method\":\"subscribe\",\"params\":{"
+            "\"options\":{\"deltas\":true},\"topics\":[\"a\",\"b\"],"
+            "\"subuid\":5}}");
+}
+
 TEST_F(WireEncoderTextTest, SubscribeAllOptions) {
   PubSubOptionsImpl options;
   options.sendAll = true;
@@ -112,6 +123,12 @@ TEST_F(WireEncoderTextTest, Unsubscribe) {
   ASSERT_EQ(os.str(), "{\"method\":\"unsubscribe\",\"params\":{\"subuid\":5}}");
 }
 
+TEST_F(WireEncoderTextTest, Resume) {
+  net::WireEncodeResume(os, "abc", 5);
+  ASSERT_EQ(os.str(),
+            "{\"method\":\"resume\",\"params\":{\"seq\":5,\"token\":\"abc\"}}");
+}
+
 TEST_F(WireEncoderTextTest, Announce) {
   net::WireEncodeAnnounce(os, "test", 5, "double", wpi::json::object(),
                           std::nullopt);
@@ -213,6 +230,14 @@ TEST_F(WireEncoderTextTest, MessageUnannounce) {
       "{\"method\":\"unannounce\",\"params\":{\"id\":5,\"name\":\"test\"}}");
 }
 
+TEST_F(WireEncoderTextTest, MessageCheckpoint) {
+  net::ServerMessage msg{net::CheckpointMsg{"abc", 5}};
+  ASSERT_TRUE(net::WireEncodeText(os, msg));
+  ASSERT_EQ(os.str(),
+            "{\"method\":\"checkpoint\",\"params\":{\"seq\":5,\"token\":"
+            "\"abc\"}}");
+}
+
 TEST_F(WireEncoderTextTest, ServerMessageEmpty) {
   ASSERT_FALSE(net::WireEncodeText(os, net::ServerMessage{}));
 }
@@ -286,4 +311,45 @@ TEST_F(WireEncoderBinaryTest, StringArray) {
                                "bye"_us));
 }
 
+TEST_F(WireEncoderBinaryTest, IntegerArrayDelta) {
+  ASSERT_TRUE(net::WireEncodeBinaryDelta(
+      os, 5, 6, Value::MakeIntegerArray({1, 2, 4, 8}),
+      Value::MakeIntegerArray({1, 2, 3, 8})));
+  ASSERT_THAT(out, wpi::SpanEq("\x94\x05\x06\x52\x93\x04\x02\x04"_us));
+}
+
+TEST_F(WireEncoderBinaryTest, BooleanArrayDeltaGrow) {
+  ASSERT_TRUE(net::WireEncodeBinaryDelta(
+      os, 5, 6, Value::MakeBooleanArray({true, false, true, true, true}),
+      Value::MakeBooleanArray({true, false, true, true})));
+  ASSERT_THAT(out, wpi::SpanEq("\x94\x05\x06\x50\x93\x05\x04\xc3"_us));
+}
+
+TEST_F(WireEncoderBinaryTest, ArrayDeltaNotSmaller) {
+  ASSERT_FALSE(net::WireEncodeBinaryDelta(os, 5, 6,
+                                          Value::MakeDoubleArray({1, 5, 6}),
+                                          Value::MakeDoubleArray({1, 2, 3})));
+  ASSERT_TRUE(out.empty());
+}
+
+TEST_F(WireEncoderBinaryTest, ArrayDeltaTypeMismatch) {
+  ASSERT_FALSE(net::WireEncodeBinaryDelta(os, 5, 6,
+                                          Value::MakeDoubleArray({1, 2, 3}),
+                                          Value::MakeIntegerArray({1, 2, 3})));
+  ASSERT_TRUE(out.empty());
+}
+
+TEST_F(WireEncoderBinaryTest, Batch) {
+  Value v1 = Value::MakeBoolean(true);
+  Value v2 = Value::MakeDouble(2.5);
+  net::BinaryBatchEntry entries[] = {{5, 6, &v1}, {7, 8, &v2}};
+  ASSERT_TRUE(net::WireEncodeBinaryBatch(os, entries));
+  ASSERT_THAT(out, wpi::SpanEq("\x94\xfe\x06\x60\x94"
+                               "\x92\x05\x07"
+                               "\x92\x00\x02"
+                               "\x92\x00\x01"
+                               "\xc4\x09\x01"
+                               "\x00\x00\x00\x00\x00\x00\x04\x40"_us));
+}
+
 }  // namespace nt
@@ -4,6 +4,7 @@
 
 #include <cfloat>
 #include <climits>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -281,4 +282,25 @@ TEST_F(WireEncoder3Test, EntryUpdateStringArrayTrunc) {
   ASSERT_THAT(out, ex);
 }
 
+TEST_F(WireEncoder3Test, EncodedValue) {
+  auto value = Value::MakeDouble(2.3e5);
+  auto encoded = std::make_shared<std::vector<uint8_t>>();
+  wpi::raw_uvector_ostream encodedOs{*encoded};
+  ASSERT_TRUE(net3::WireEncodeValue(encodedOs, value));
+  ASSERT_THAT(*encoded, wpi::SpanEq("\x01\x41\x0c\x13\x80\x00\x00\x00\x00"_us));
+
+  // pre-encoded values are used in place of the value
+  net3::WireEncode(os, net3::Message3::EntryAssign("test"sv, 0x5678, 0x1234,
+                                                   Value{}, 0x9a, encoded));
+  ASSERT_THAT(out, wpi::SpanEq("\x10\x04test\x01\x56\x78\x12\x34"
+                               "\x9a\x41\x0c\x13\x80\x00\x00\x00\x00"_us));
+
+  out.clear();
+  net3::WireEncode(
+      os, net3::Message3::EntryUpdate(0x5678, 0x1234, Value{}, encoded));
+  ASSERT_THAT(
+      out, wpi::SpanEq(
+               "\x11\x56\x78\x12\x34\x01\x41\x0c\x13\x80\x00\x00\x00\x00"_us));
+}
+
 }  // namespace nt
@@ -32,6 +32,7 @@ using ::testing::_;
 using ::testing::AllOf;
 using ::testing::ElementsAre;
 using ::testing::Field;
+using ::testing::HasSubstr;
 using ::testing::IsEmpty;
 using ::testing::Property;
 using ::testing::Return;
@@ -187,17 +188,17 @@ TEST_F(ServerImplTest, PublishLocal) {
     EXPECT_CALL(wire, Ready()).WillOnce(Return(true));  // SendControl()
     EXPECT_CALL(
         wire, DoWriteText(StrEq(EncodeText1(net::ServerMessage{net::AnnounceMsg{
-                  "test", 3, "double", std::nullopt, wpi::json::object()}}))))
+                  "test", 5, "double", std::nullopt, wpi::json::object()}}))))
         .WillOnce(Return(0));
     EXPECT_CALL(
         wire, DoWriteText(StrEq(EncodeText1(net::ServerMessage{net::AnnounceMsg{
-                  "test2", 8, "double", std::nullopt, wpi::json::object()}}))))
+                  "test2", 10, "double", std::nullopt, wpi::json::object()}}))))
         .WillOnce(Return(0));
     EXPECT_CALL(wire, Flush()).WillOnce(Return(0));     // SendControl()
     EXPECT_CALL(wire, Ready()).WillOnce(Return(true));  // SendControl()
     EXPECT_CALL(
         wire, DoWriteText(StrEq(EncodeText1(net::ServerMessage{net::AnnounceMsg{
-                  "test3", 11, "double", std::nullopt, wpi::json::object()}}))))
+                  "test3", 13, "double", std::nullopt, wpi::json::object()}}))))
         .WillOnce(Return(0));
     EXPECT_CALL(wire, Flush()).WillOnce(Return(0));  // SendControl()
   }
@@ -261,7 +262,7 @@ TEST_F(ServerImplTest, ClientSubTopicOnlyThenValue) {
     EXPECT_CALL(wire, Ready()).WillOnce(Return(true));  // SendValues()
     EXPECT_CALL(
         wire, DoWriteText(StrEq(EncodeText1(net::ServerMessage{net::AnnounceMsg{
-                  "test", 3, "double", std::nullopt, wpi::json::object()}}))))
+                  "test", 5, "double", std::nullopt, wpi::json::object()}}))))
         .WillOnce(Return(0));
     EXPECT_CALL(wire, Flush()).WillOnce(Return(0));  // SendValues()
     EXPECT_CALL(setPeriodic, Call(100));             // ClientSubscribe()
@@ -269,7 +270,7 @@ TEST_F(ServerImplTest, ClientSubTopicOnlyThenValue) {
     EXPECT_CALL(wire, Ready()).WillOnce(Return(true));  // SendValues()
     EXPECT_CALL(
         wire, DoWriteBinary(wpi::SpanEq(EncodeServerBinary1(net::ServerMessage{
-                  net::ServerValueMsg{3, Value::MakeDouble(1.0, 10)}}))))
+                  net::ServerValueMsg{5, Value::MakeDouble(1.0, 10), {}}}))))
         .WillOnce(Return(0));
     EXPECT_CALL(wire, Flush());  // SendValues()
   }
@@ -303,6 +304,361 @@ TEST_F(ServerImplTest, ClientSubTopicOnlyThenValue) {
   server.SendOutgoing(id, 200);
 }
 
+TEST_F(ServerImplTest, ClientSubOverlappingPrefixes) {
+  server.SetLocal(&local, &queue);
+  constexpr int pubuid = 1;
+  constexpr int pubuid2 = 2;
+  EXPECT_CALL(
+      local,
+      ServerAnnounce(std::string_view{"test"}, 0, std::string_view{"double"},
+                     wpi::json::object(), std::optional<int>{pubuid}));
+  EXPECT_CALL(
+      local,
+      ServerAnnounce(std::string_view{"other"}, 0, std::string_view{"double"},
+                     wpi::json::object(), std::optional<int>{pubuid2}));
+
+  {
+    queue.msgs.emplace_back(net::ClientMessage{
+        net::PublishMsg{pubuid, "test", "double", wpi::json::object(), {}}});
+    queue.msgs.emplace_back(net::ClientMessage{
+        net::PublishMsg{pubuid2, "other", "double", wpi::json::object(), {}}});
+    EXPECT_FALSE(server.ProcessLocalMessages(UINT_MAX));
+  }
+
+  ::testing::StrictMock<net::MockWireConnection> wire;
+  EXPECT_CALL(wire, GetVersion()).WillRepeatedly(Return(0x0401));
+  MockSetPeriodicFunc setPeriodic;
+  {
+    ::testing::InSequence seq;
+    EXPECT_CALL(setPeriodic, Call(100));  // ClientSubscribe()
+    EXPECT_CALL(wire, GetLastReceivedTime()).WillOnce(Return(0));
+    EXPECT_CALL(wire, SendPing(100));
+    EXPECT_CALL(wire, Ready()).WillOnce(Return(true));  // SendValues()
+    // announced once even though both prefixes match
+    EXPECT_CALL(
+        wire, DoWriteText(StrEq(EncodeText1(net::ServerMessage{net::AnnounceMsg{
+                  "test", 5, "double", std::nullopt, wpi::json::object()}}))))
+        .WillOnce(Return(0));
+    EXPECT_CALL(wire, Flush()).WillOnce(Return(0));  // SendValues()
+  }
+
+  auto [name, id] = server.AddClient("test", "connInfo", false, wire,
+                                     setPeriodic.AsStdFunction());
+
+  {
+    constexpr int subuid = 1;
+    std::vector<net::ClientMessage> msgs;
+    msgs.emplace_back(net::ClientMessage{net::SubscribeMsg{
+        subuid,
+        {"t", "te"},
+        PubSubOptions{.topicsOnly = true, .prefixMatch = true}}});
+    server.ProcessIncomingText(id, EncodeText(msgs));
+  }
+
+  server.SendOutgoing(id, 100);
+}
+
+TEST_F(ServerImplTest, ClientSubLargeValueShared) {
+  // publish large value before clients connect
+  server.SetLocal(&local, &queue);
+  constexpr int pubuid = 1;
+  std::vector<uint8_t> data(1024);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = i & 0xff;
+  }
+  Value value = Value::MakeRaw(data, 10);
+  EXPECT_CALL(
+      local, ServerAnnounce(std::string_view{"test"}, 0, std::string_view{"raw"},
+                            wpi::json::object(), std::optional<int>{pubuid}));
+
+  {
+    queue.msgs.emplace_back(net::ClientMessage{
+        net::PublishMsg{pubuid, "test", "raw", wpi::json::object(), {}}});
+    queue.msgs.emplace_back(
+        net::ClientMessage{net::ClientValueMsg{pubuid, value}});
+    EXPECT_FALSE(server.ProcessLocalMessages(UINT_MAX));
+  }
+
+  // each client gets the same (shared) encoding of the value
+  for (int i = 0; i < 2; ++i) {
+    ::testing::StrictMock<net::MockWireConnection> wire;
+    EXPECT_CALL(wire, GetVersion()).WillRepeatedly(Return(0x0401));
+    MockSetPeriodicFunc setPeriodic;
+    {
+      ::testing::InSequence seq;
+      EXPECT_CALL(setPeriodic, Call(100));  // ClientSubscribe()
+      EXPECT_CALL(wire, GetLastReceivedTime()).WillOnce(Return(0));
+      EXPECT_CALL(wire, SendPing(100));
+      EXPECT_CALL(wire, Ready()).WillOnce(Return(true));  // SendValues()
+      EXPECT_CALL(wire,
+                  DoWriteText(StrEq(EncodeText1(net::ServerMessage{
+                      net::AnnounceMsg{"test", 5, "raw", std::nullopt,
+                                       wpi::json::object()}}))))
+          .WillOnce(Return(0));
+      EXPECT_CALL(wire,
+                  DoWriteBinary(wpi::SpanEq(EncodeServerBinary1(
+                      net::ServerMessage{net::ServerValueMsg{5, value, {}}}))))
+          .WillOnce(Return(0));
+      EXPECT_CALL(wire, Flush());  // SendValues()
+    }
+
+    auto [name, id] = server.AddClient("test", "connInfo", false, wire,
+                                       setPeriodic.AsStdFunction());
+
+    {
+      constexpr int subuid = 1;
+      std::vector<net::ClientMessage> msgs;
+      msgs.emplace_back(net::ClientMessage{
+          net::SubscribeMsg{subuid, {{"test"}}, PubSubOptions{}}});
+      server.ProcessIncomingText(id, EncodeText(msgs));
+    }
+
+    server.SendOutgoing(id, 100);
+    server.RemoveClient(id);
+  }
+}
+
+TEST_F(ServerImplTest, ClientSubBatchedValues) {
+  // publish before client connect
+  server.SetLocal(&local, &queue);
+  Value value1 = Value::MakeDouble(1.0, 10);
+  Value value2 = Value::MakeBoolean(true, 20);
+  EXPECT_CALL(
+      local,
+      ServerAnnounce(std::string_view{"a"}, 0, std::string_view{"double"},
+                     wpi::json::object(), std::optional<int>{1}));
+  EXPECT_CALL(
+      local,
+      ServerAnnounce(std::string_view{"b"}, 0, std::string_view{"boolean"},
+                     wpi::json::object(), std::optional<int>{2}));
+
+  {
+    queue.msgs.emplace_back(net::ClientMessage{
+        net::PublishMsg{1, "a", "double", wpi::json::object(), {}}});
+    queue.msgs.emplace_back(
+        net::ClientMessage{net::ClientValueMsg{1, value1}});
+    queue.msgs.emplace_back(net::ClientMessage{
+        net::PublishMsg{2, "b", "boolean", wpi::json::object(), {}}});
+    queue.msgs.emplace_back(
+        net::ClientMessage{net::ClientValueMsg{2, value2}});
+    EXPECT_FALSE(server.ProcessLocalMessages(UINT_MAX));
+  }
+
+  // version 4.2 client gets both values in a single batch message
+  std::vector<uint8_t> batch;
+  {
+    wpi::raw_uvector_ostream os{batch};
+    net::BinaryBatchEntry entries[] = {{5, 10, &value1}, {8, 20, &value2}};
+    net::WireEncodeBinaryBatch(os, entries);
+  }
+
+  ::testing::StrictMock<net::MockWireConnection> wire;
+  EXPECT_CALL(wire, GetVersion()).WillRepeatedly(Return(0x0402));
+  MockSetPeriodicFunc setPeriodic;
+  {
+    ::testing::InSequence seq;
+    EXPECT_CALL(setPeriodic, Call(100));  // ClientSubscribe()
+    EXPECT_CALL(wire, GetLastReceivedTime()).WillOnce(Return(0));
+    EXPECT_CALL(wire, SendPing(100));
+    EXPECT_CALL(wire, Ready()).WillOnce(Return(true));  // SendValues()
+    EXPECT_CALL(
+        wire, DoWriteText(StrEq(EncodeText1(net::ServerMessage{net::AnnounceMsg{
+                  "a", 5, "double", std::nullopt, wpi::json::object()}}))))
+        .WillOnce(Return(0));
+    EXPECT_CALL(
+        wire, DoWriteText(StrEq(EncodeText1(net::ServerMessage{net::AnnounceMsg{
+                  "b", 8, "boolean", std::nullopt, wpi::json::object()}}))))
+        .WillOnce(Return(0));
+    EXPECT_CALL(wire, DoWriteBinary(wpi::SpanEq(batch))).WillOnce(Return(0));
+    EXPECT_CALL(wire, Flush());  // SendValues()
+    // everything has been sent, so a resume checkpoint follows
+    EXPECT_CALL(wire, Ready()).WillOnce(Return(true));
+    EXPECT_CALL(wire, DoSendText(HasSubstr("\"checkpoint\"")));
+  }
+
+  auto [name, id] = server.AddClient("test", "connInfo", false, wire,
+                                     setPeriodic.AsStdFunction());
+
+  {
+    constexpr int subuid = 1;
+    std::vector<net::ClientMessage> msgs;
+    msgs.emplace_back(net::ClientMessage{
+        net::SubscribeMsg{subuid, {{"a"}, {"b"}}, PubSubOptions{}}});
+    server.ProcessIncomingText(id, EncodeText(msgs));
+  }
+
+  server.SendOutgoing(id, 100);
+}
+
+TEST_F(ServerImplTest, ClientResume) {
+  // publish before client connect
+  server.SetLocal(&local, &queue);
+  Value value1 = Value::MakeDouble(1.0, 10);
+  Value value2 = Value::MakeDouble(2.0, 20);
+  Value value3 = Value::MakeDouble(3.0, 30);
+  EXPECT_CALL(
+      local,
+      ServerAnnounce(std::string_view{"a"}, 0, std::string_view{"double"},
+                     wpi::json::object(), std::optional<int>{1}));
+  EXPECT_CALL(
+      local,
+      ServerAnnounce(std::string_view{"b"}, 0, std::string_view{"double"},
+                     wpi::json::object(), std::optional<int>{2}));
+
+  {
+    queue.msgs.emplace_back(net::ClientMessage{
+        net::PublishMsg{1, "a", "double", wpi::json::object(), {}}});
+    queue.msgs.emplace_back(
+        net::ClientMessage{net::ClientValueMsg{1, value1}});
+    queue.msgs.emplace_back(net::ClientMessage{
+        net::PublishMsg{2, "b", "double", wpi::json::object(), {}}});
+    queue.msgs.emplace_back(
+        net::ClientMessage{net::ClientValueMsg{2, value2}});
+    EXPECT_FALSE(server.ProcessLocalMessages(UINT_MAX));
+  }
+
+  std::vector<net::ClientMessage> subMsgs;
+  subMsgs.emplace_back(net::ClientMessage{
+      net::SubscribeMsg{1, {{"a"}, {"b"}}, PubSubOptions{}}});
+
+  // first connection receives both values, then a checkpoint
+  std::string checkpoint;
+  {
+    ::testing::NiceMock<net::MockWireConnection> wire;
+    EXPECT_CALL(wire, GetVersion()).WillRepeatedly(Return(0x0402));
+    EXPECT_CALL(wire, Ready()).WillRepeatedly(Return(true));
+    EXPECT_CALL(wire, DoWriteText(_)).WillRepeatedly(Return(0));
+    EXPECT_CALL(wire, DoWriteBinary(_)).WillRepeatedly(Return(0));
+    EXPECT_CALL(wire, DoSendText(HasSubstr("\"checkpoint\"")))
+        .WillOnce([&](std::string_view text) { checkpoint = text; });
+    MockSetPeriodicFunc setPeriodic;
+    auto [name, id] = server.AddClient("test", "connInfo", false, wire,
+                                       setPeriodic.AsStdFunction());
+    server.ProcessIncomingText(id, EncodeText(subMsgs));
+    server.SendOutgoing(id, 100);
+    server.RemoveClient(id);
+  }
+  auto params = wpi::json::parse(checkpoint)["params"];
+  std::string token = params["token"];
+  int64_t seq = params["seq"];
+
+  // b changes while disconnected
+  queue.msgs.emplace_back(net::ClientMessage{net::ClientValueMsg{2, value3}});
+  EXPECT_FALSE(server.ProcessLocalMessages(UINT_MAX));
+
+  // on resume, only the changed value is sent
+  auto value3Data = EncodeServerBinary1(
+      net::ServerMessage{net::ServerValueMsg{8, value3, {}}});
+  ::testing::StrictMock<net::MockWireConnection> wire;
+  EXPECT_CALL(wire, GetVersion()).WillRepeatedly(Return(0x0402));
+  MockSetPeriodicFunc setPeriodic;
+  {
+    ::testing::InSequence s;
+    EXPECT_CALL(wire, DoSendText(StrEq(EncodeText1(net::ServerMessage{
+                          net::CheckpointMsg{token, seq}}))));
+    EXPECT_CALL(setPeriodic, Call(100));  // ClientSubscribe()
+    EXPECT_CALL(wire, GetLastReceivedTime()).WillOnce(Return(0));
+    EXPECT_CALL(wire, SendPing(100));
+    EXPECT_CALL(wire, Ready()).WillOnce(Return(true));  // SendValues()
+    EXPECT_CALL(
+        wire, DoWriteText(StrEq(EncodeText1(net::ServerMessage{net::AnnounceMsg{
+                  "a", 5, "double", std::nullopt, wpi::json::object()}}))))
+        .WillOnce(Return(0));
+    EXPECT_CALL(
+        wire, DoWriteText(StrEq(EncodeText1(net::ServerMessage{net::AnnounceMsg{
+                  "b", 8, "double", std::nullopt, wpi::json::object()}}))))
+        .WillOnce(Return(0));
+    EXPECT_CALL(wire, DoWriteBinary(wpi::SpanEq(value3Data)))
+        .WillOnce(Return(0));
+    EXPECT_CALL(wire, Flush());  // SendValues()
+    EXPECT_CALL(wire, Ready()).WillOnce(Return(true));
+    EXPECT_CALL(wire, DoSendText(HasSubstr(token)));
+  }
+
+  auto [name, id] = server.AddClient("test", "connInfo", false, wire,
+                                     setPeriodic.AsStdFunction());
+  {
+    std::vector<net::ClientMessage> msgs;
+    msgs.emplace_back(net::ClientMessage{net::ResumeMsg{token, seq}});
+    server.ProcessIncomingText(id, EncodeText(msgs));
+  }
+  server.ProcessIncomingText(id, EncodeText(subMsgs));
+  server.SendOutgoing(id, 100);
+}
+
+TEST_F(ServerImplTest, ClientResumeAfterCheckpoint) {
+  server.SetLocal(&local, &queue);
+  Value value1 = Value::MakeDouble(1.0, 10);
+  Value value2 = Value::MakeDouble(2.0, 20);
+  EXPECT_CALL(local, ServerAnnounce(_, _, _, _, _)).Times(2);
+
+  {
+    queue.msgs.emplace_back(net::ClientMessage{
+        net::PublishMsg{1, "a", "double", wpi::json::object(), {}}});
+    queue.msgs.emplace_back(
+        net::ClientMessage{net::ClientValueMsg{1, value1}});
+    queue.msgs.emplace_back(net::ClientMessage{
+        net::PublishMsg{2, "b", "double", wpi::json::object(), {}}});
+    queue.msgs.emplace_back(
+        net::ClientMessage{net::ClientValueMsg{2, value2}});
+    EXPECT_FALSE(server.ProcessLocalMessages(UINT_MAX));
+  }
+
+  std::vector<net::ClientMessage> subMsgsA;
+  subMsgsA.emplace_back(
+      net::ClientMessage{net::SubscribeMsg{1, {{"a"}}, PubSubOptions{}}});
+  std::vector<net::ClientMessage> subMsgsB;
+  subMsgsB.emplace_back(
+      net::ClientMessage{net::SubscribeMsg{2, {{"b"}}, PubSubOptions{}}});
+
+  // first connection is sent a checkpoint after a's value; b's value is
+  // sent after the checkpoint, so it may not have been received
+  std::string checkpoint;
+  {
+    ::testing::NiceMock<net::MockWireConnection> wire;
+    EXPECT_CALL(wire, GetVersion()).WillRepeatedly(Return(0x0402));
+    EXPECT_CALL(wire, Ready()).WillRepeatedly(Return(true));
+    EXPECT_CALL(wire, DoWriteText(_)).WillRepeatedly(Return(0));
+    EXPECT_CALL(wire, DoWriteBinary(_)).WillRepeatedly(Return(0));
+    EXPECT_CALL(wire, DoSendText(HasSubstr("\"checkpoint\"")))
+        .WillOnce([&](std::string_view text) { checkpoint = text; });
+    MockSetPeriodicFunc setPeriodic;
+    auto [name, id] = server.AddClient("test", "connInfo", false, wire,
+                                       setPeriodic.AsStdFunction());
+    server.ProcessIncomingText(id, EncodeText(subMsgsA));
+    server.SendOutgoing(id, 100);
+    server.ProcessIncomingText(id, EncodeText(subMsgsB));
+    server.SendOutgoing(id, 200);
+    server.RemoveClient(id);
+  }
+  auto params = wpi::json::parse(checkpoint)["params"];
+  std::string token = params["token"];
+  int64_t seq = params["seq"];
+
+  // on resume, b's value is sent again
+  auto value2Data = EncodeServerBinary1(
+      net::ServerMessage{net::ServerValueMsg{8, value2, {}}});
+  ::testing::NiceMock<net::MockWireConnection> wire;
+  EXPECT_CALL(wire, GetVersion()).WillRepeatedly(Return(0x0402));
+  EXPECT_CALL(wire, Ready()).WillRepeatedly(Return(true));
+  EXPECT_CALL(wire, DoWriteText(_)).WillRepeatedly(Return(0));
+  EXPECT_CALL(wire, DoWriteBinary(_)).Times(0);
+  EXPECT_CALL(wire, DoWriteBinary(wpi::SpanEq(value2Data)))
+      .WillOnce(Return(0));
+  MockSetPeriodicFunc setPeriodic;
+
+  auto [name, id] = server.AddClient("test", "connInfo", false, wire,
+                                     setPeriodic.AsStdFunction());
+  {
+    std::vector<net::ClientMessage> msgs;
+    msgs.emplace_back(net::ClientMessage{net::ResumeMsg{token, seq}});
+    server.ProcessIncomingText(id, EncodeText(msgs));
+  }
+  server.ProcessIncomingText(id, EncodeText(subMsgsA));
+  server.ProcessIncomingText(id, EncodeText(subMsgsB));
+  server.SendOutgoing(id, 100);
+}
+
 TEST_F(ServerImplTest, ClientDisconnectUnpublish) {
   server.SetLocal(&local, &queue);
   constexpr int pubuidLocal = 1;
@@ -344,7 +700,7 @@ TEST_F(ServerImplTest, ClientDisconnectUnpublish) {
     EXPECT_CALL(wire, Ready()).WillOnce(Return(true));  // SendValues()
     EXPECT_CALL(
         wire, DoWriteText(StrEq(EncodeText1(net::ServerMessage{net::AnnounceMsg{
-                  "test", 8, "double", 1, wpi::json::object()}}))))
+                  "test", 10, "double", 1, wpi::json::object()}}))))
         .WillOnce(Return(0));
     EXPECT_CALL(wire, Flush());  // SendValues()
   }
@@ -423,4 +779,46 @@ TEST_F(ServerImplTest, ZeroTimestampNegativeTime) {
   }
 }
 
+TEST_F(ServerImplTest, PersistentJournal) {
+  EXPECT_EQ(server.LoadPersistent(R"([
+  {"name": "a", "type": "double", "value": 1.0,
+   "properties": {"persistent": true}},
+  {"name": "b", "type": "string", "value": "x",
+   "properties": {"persistent": true}}
+])"),
+            "");
+  // loading does not count as a change
+  EXPECT_FALSE(server.PersistentChanged());
+  EXPECT_EQ(server.DumpPersistentChanges(), "");
+
+  // replay changes on top of the full file; a torn last line is an error
+  EXPECT_THAT(server.LoadPersistentChanges(
+                  "{\"name\": \"a\", \"type\": \"double\", \"value\": 2.0, "
+                  "\"properties\": {\"persistent\": true}}\n"
+                  "{\"name\": \"b\", \"deleted\": true}\n"
+                  "{\"name\": \"c\", \"type\": \"int\", \"value\": 5, "
+                  "\"properties\": {\"persistent\": true}}\n"
+                  "{\"name\": \"d\", \"ty"),
+              ::testing::StartsWith("4: could not decode JSON"));
+  EXPECT_EQ(server.DumpPersistent(), R"([
+  {
+    "name": "a",
+    "type": "double",
+    "value": 2.0,
+    "properties": {
+      "persistent": true
+    }
+  },
+  {
+    "name": "c",
+    "type": "int",
+    "value": 5,
+    "properties": {
+      "persistent": true
+    }
+  }
+]
+)");
+}
+
 }  // namespace nt
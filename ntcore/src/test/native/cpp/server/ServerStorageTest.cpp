@@ -0,0 +1,48 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <stdint.h>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../MockLogger.h"
+#include "../net/MockWireConnection.h"
+#include "gmock/gmock.h"
+#include "server/Constants.h"
+#include "server/ServerClient4.h"
+#include "server/ServerStorage.h"
+#include "server/ServerTopic.h"
+
+using ::testing::Return;
+
+namespace nt {
+
+TEST(ServerStorageTest, LargeValueEncodedOnce) {
+  wpi::MockLogger logger;
+  server::ServerStorage storage{
+      logger, [](server::ServerTopic*, server::ServerClient*) {}};
+  ::testing::NiceMock<net::MockWireConnection> wire1;
+  ::testing::NiceMock<net::MockWireConnection> wire2;
+  ON_CALL(wire1, GetVersion()).WillByDefault(Return(0x0401));
+  ON_CALL(wire2, GetVersion()).WillByDefault(Return(0x0401));
+  server::ServerClient4 client1{"client1", "", false, wire1,
+                                [](uint32_t) {}, storage, 0, logger};
+  server::ServerClient4 client2{"client2", "", false, wire2,
+                                [](uint32_t) {}, storage, 1, logger};
+
+  auto topic = storage.CreateTopic(nullptr, "test", "raw", wpi::json::object());
+  topic->clients[&client1].sendMode = net::ValueSendMode::kNormal;
+  topic->clients[&client2].sendMode = net::ValueSendMode::kNormal;
+
+  std::vector<uint8_t> data(server::kMinSharedEncodeSize);
+  storage.SetValue(nullptr, topic, Value::MakeRaw(data, 10));
+
+  // the retained encoding is the one buffer queued to both clients
+  ASSERT_TRUE(topic->lastValueEncoded);
+  EXPECT_EQ(topic->lastValueEncoded.use_count(), 3);
+}
+
+}  // namespace nt
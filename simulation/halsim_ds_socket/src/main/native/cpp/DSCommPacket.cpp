@@ -167,7 +167,9 @@ void DSCommPacket::DecodeUDP(std::span<const uint8_t> packet) {
 
     switch (packet[1]) {
       case kJoystickDataTag:
-        ReadJoystickTag(tagPacket, joystickNum);
+        if (joystickNum < HAL_kMaxJoysticks) {
+          ReadJoystickTag(tagPacket, joystickNum);
+        }
         joystickNum++;
         break;
       case kMatchTimeTag:
@@ -252,13 +254,35 @@ void DSCommPacket::ReadJoystickDescriptionTag(std::span<const uint8_t> data) {
   packet.descriptor.povCount = data[1];
 }
 
+// The packets are memset before being filled in, so they can be compared
+// bytewise
+template <typename T>
+static bool UpdateSent(T* sent, const T& value, bool force) {
+  if (!force && std::memcmp(sent, &value, sizeof(T)) == 0) {
+    return false;
+  }
+  std::memcpy(sent, &value, sizeof(T));
+  return true;
+}
+
 void DSCommPacket::SendJoysticks(void) {
+  bool force = !m_joysticks_sent;
+  m_joysticks_sent = true;
   for (int i = 0; i < HAL_kMaxJoysticks; i++) {
     DSCommJoystickPacket& packet = m_joystick_packets[i];
-    HALSIM_SetJoystickAxes(i, &packet.axes);
-    HALSIM_SetJoystickPOVs(i, &packet.povs);
-    HALSIM_SetJoystickButtons(i, &packet.buttons);
-    HALSIM_SetJoystickDescriptor(i, &packet.descriptor);
+    DSCommJoystickPacket& sent = m_joystick_sent[i];
+    if (UpdateSent(&sent.axes, packet.axes, force)) {
+      HALSIM_SetJoystickAxes(i, &packet.axes);
+    }
+    if (UpdateSent(&sent.povs, packet.povs, force)) {
+      HALSIM_SetJoystickPOVs(i, &packet.povs);
+    }
+    if (UpdateSent(&sent.buttons, packet.buttons, force)) {
+      HALSIM_SetJoystickButtons(i, &packet.buttons);
+    }
+    if (UpdateSent(&sent.descriptor, packet.descriptor, force)) {
+      HALSIM_SetJoystickDescriptor(i, &packet.descriptor);
+    }
   }
 }
 
@@ -66,6 +66,10 @@ class DSCommPacket {
   HAL_AllianceStationID m_alliance_station;
   HAL_MatchInfo matchInfo;
   std::array<DSCommJoystickPacket, HAL_kMaxJoysticks> m_joystick_packets;
+  // Last joystick values set in the sim data; only changes are set, so the
+  // sim callbacks aren't called for every joystick on every packet
+  std::array<DSCommJoystickPacket, HAL_kMaxJoysticks> m_joystick_sent;
+  bool m_joysticks_sent = false;
   double m_match_time = -1;
 };
 
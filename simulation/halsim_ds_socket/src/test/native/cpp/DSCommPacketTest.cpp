@@ -157,3 +157,43 @@ TEST_F(DSCommPacketTest, GameDataTag) {
   ASSERT_EQ(matchInfo.gameSpecificMessage[2], 'B');
   ASSERT_EQ(matchInfo.gameSpecificMessage[3], 'C');
 }
+
+TEST_F(DSCommPacketTest, SendOnlyChangedJoysticks) {
+  HALSIM_ResetDriverStationData();
+  int calls = 0;
+  int32_t uid = HALSIM_RegisterJoystickAxesCallback(
+      0,
+      [](const char*, void* param, int32_t joystickNum,
+         const HAL_JoystickAxes*) {
+        if (joystickNum == 0) {
+          ++*static_cast<int*>(param);
+        }
+      },
+      &calls, false);
+
+  uint8_t arr[] = {// Size, Tag
+                   6, 12,
+                   // Axes
+                   2, 0x9C, 0xCE,
+                   // Buttons, POVs
+                   0, 0};
+  ReadJoystickTag(arr, 0);
+  SendJoysticks();
+  EXPECT_EQ(calls, 1);
+
+  // unchanged values don't call the callback again
+  ReadJoystickTag(arr, 0);
+  SendJoysticks();
+  EXPECT_EQ(calls, 1);
+
+  arr[4] = 0;
+  ReadJoystickTag(arr, 0);
+  SendJoysticks();
+  EXPECT_EQ(calls, 2);
+  HAL_JoystickAxes axes;
+  HALSIM_GetJoystickAxes(0, &axes);
+  EXPECT_EQ(axes.count, 2);
+  EXPECT_EQ(axes.axes[1], 0);
+
+  HALSIM_CancelJoystickAxesCallback(uid);
+}
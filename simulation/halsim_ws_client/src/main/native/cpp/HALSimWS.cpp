@@ -70,6 +70,8 @@ bool HALSimWS::Initialize() {
     m_uri = "/wpilibws";
   }
 
+  m_useBinary = std::getenv("HALSIMWS_MSGPACK") != nullptr;
+
   const char* msgFilters = std::getenv("HALSIMWS_FILTERS");
   if (msgFilters != nullptr) {
     m_useMsgFiltering = true;
@@ -20,6 +20,7 @@
 #include <WSProvider_RoboRIO.h>
 #include <WSProvider_SimDevice.h>
 #include <WSProvider_Solenoid.h>
+#include <WSProvider_Timing.h>
 #include <WSProvider_dPWM.h>
 #include <wpinet/EventLoopRunner.h>
 
@@ -53,6 +54,7 @@ bool HALSimWSClient::Initialize() {
     HALSimWSProviderRelay::Initialize(registerFunc);
     HALSimWSProviderRoboRIO::Initialize(registerFunc);
     HALSimWSProviderSolenoid::Initialize(registerFunc);
+    HALSimWSProviderTiming::Initialize(registerFunc);
 
     simDevices.Initialize(loop);
 
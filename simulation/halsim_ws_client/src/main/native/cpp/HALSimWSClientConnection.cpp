@@ -6,6 +6,8 @@
 
 #include <cstdio>
 #include <string>
+#include <string_view>
+#include <utility>
 
 #include <fmt/format.h>
 #include <wpi/print.h>
@@ -21,10 +23,15 @@ void HALSimWSClientConnection::Initialize() {
   // Get a shared pointer to ourselves
   auto self = this->shared_from_this();
 
+  std::span<const std::string_view> protocols;
+  if (m_client->GetUseBinary()) {
+    protocols = {&kBinaryProtocol, 1};
+  }
   auto ws = wpi::WebSocket::CreateClient(
       *m_stream, m_client->GetTargetUri(),
       fmt::format("{}:{}", m_client->GetTargetHost(),
-                  m_client->GetTargetPort()));
+                  m_client->GetTargetPort()),
+      protocols);
 
   ws->SetData(self);
 
@@ -34,6 +41,7 @@ void HALSimWSClientConnection::Initialize() {
   m_websocket->open.connect_extended([this](auto conn, auto) {
     conn.disconnect();
 
+    m_ws_binary = m_websocket->GetProtocol() == kBinaryProtocol;
     if (!m_client->RegisterWebsocket(shared_from_this())) {
       std::fputs("Unable to register websocket\n", stderr);
       return;
@@ -62,6 +70,23 @@ void HALSimWSClientConnection::Initialize() {
     m_client->OnNetValueChanged(j);
   });
 
+  // binary frames hold a batch of messages
+  m_websocket->binary.connect([this](auto data, bool) {
+    if (!m_ws_connected) {
+      return;
+    }
+
+    try {
+      DecodeBinaryFrame(
+          data, [&](const wpi::json& j) { m_client->OnNetValueChanged(j); });
+    } catch (const wpi::json::exception& e) {
+      std::string err("MessagePack parse failed: ");
+      err += e.what();
+      wpi::print(stderr, "{}\n", err);
+      m_websocket->Fail(1003, err);
+    }
+  });
+
   m_websocket->closed.connect([this](uint16_t, auto) {
     if (m_ws_connected) {
       std::puts("HALSimWS: Websocket Disconnected");
@@ -87,6 +112,15 @@ void HALSimWSClientConnection::OnSimValueChanged(const wpi::json& msg) {
     wpi::print(stderr, "Error with message: {}\n", e.what());
   }
 
+  // batch messages until the uv loop gets to them
+  if (m_ws_binary) {
+    if (m_batch.Add(msg)) {
+      m_client->GetExec().Send(
+          [self = shared_from_this()] { self->SendBatch(); });
+    }
+    return;
+  }
+
   wpi::SmallVector<uv::Buffer, 4> sendBufs;
   wpi::raw_uv_ostream os{sendBufs, [this]() -> uv::Buffer {
                            std::lock_guard lock(m_buffers_mutex);
@@ -96,18 +130,37 @@ void HALSimWSClientConnection::OnSimValueChanged(const wpi::json& msg) {
   os << msg;
 
   // Call the websocket send function on the uv loop
-  m_client->GetExec().Send([self = shared_from_this(), sendBufs] {
-    self->m_websocket->SendText(sendBufs,
-                                [self](auto bufs, wpi::uv::Error err) {
-                                  {
-                                    std::lock_guard lock(self->m_buffers_mutex);
-                                    self->m_buffers.Release(bufs);
-                                  }
-
-                                  if (err) {
-                                    wpi::print(stderr, "{}\n", err.str());
-                                    std::fflush(stderr);
-                                  }
-                                });
-  });
+  m_client->GetExec().Send(
+      [self = shared_from_this(), sendBufs] { self->Send(sendBufs, false); });
+}
+
+void HALSimWSClientConnection::SendBatch() {
+  wpi::SmallVector<uv::Buffer, 4> sendBufs;
+  wpi::raw_uv_ostream os{sendBufs, [this]() -> uv::Buffer {
+                           std::lock_guard lock(m_buffers_mutex);
+                           return m_buffers.Allocate();
+                         }};
+  if (m_batch.Flush(os)) {
+    Send(sendBufs, true);
+  }
+}
+
+void HALSimWSClientConnection::Send(std::span<const uv::Buffer> bufs,
+                                    bool binary) {
+  auto callback = [self = shared_from_this()](auto sent, uv::Error err) {
+    {
+      std::lock_guard lock(self->m_buffers_mutex);
+      self->m_buffers.Release(sent);
+    }
+
+    if (err) {
+      wpi::print(stderr, "{}\n", err.str());
+      std::fflush(stderr);
+    }
+  };
+  if (binary) {
+    m_websocket->SendBinary(bufs, std::move(callback));
+  } else {
+    m_websocket->SendText(bufs, std::move(callback));
+  }
 }
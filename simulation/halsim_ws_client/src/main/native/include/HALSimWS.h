@@ -45,6 +45,7 @@ class HALSimWS : public std::enable_shared_from_this<HALSimWS> {
   const std::string& GetTargetHost() const { return m_host; }
   const std::string& GetTargetUri() const { return m_uri; }
   int GetTargetPort() const { return m_port; }
+  bool GetUseBinary() const { return m_useBinary; }
   wpi::uv::Loop& GetLoop() { return m_loop; }
 
   UvExecFunc& GetExec() { return *m_exec; }
@@ -68,6 +69,7 @@ class HALSimWS : public std::enable_shared_from_this<HALSimWS> {
   std::string m_host;
   std::string m_uri;
   int m_port;
+  bool m_useBinary;
 
   bool m_useMsgFiltering;
   wpi::StringMap<bool> m_msgFilters;
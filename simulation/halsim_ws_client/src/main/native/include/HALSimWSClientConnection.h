@@ -5,9 +5,11 @@
 #pragma once
 
 #include <memory>
+#include <span>
 #include <utility>
 
 #include <HALSimBaseWebSocketConnection.h>
+#include <WSMessageBatch.h>
 #include <wpi/json_fwd.h>
 #include <wpi/mutex.h>
 #include <wpinet/WebSocket.h>
@@ -35,12 +37,20 @@ class HALSimWSClientConnection
   void Initialize();
 
  private:
+  // called on the uv loop
+  void SendBatch();
+  void Send(std::span<const wpi::uv::Buffer> bufs, bool binary);
+
   std::shared_ptr<HALSimWS> m_client;
   std::shared_ptr<wpi::uv::Stream> m_stream;
 
   bool m_ws_connected = false;
   wpi::WebSocket* m_websocket = nullptr;
 
+  // was the binary protocol negotiated?
+  bool m_ws_binary = false;
+  WSMessageBatch m_batch;
+
   wpi::uv::SimpleBufferPool<4> m_buffers;
   std::mutex m_buffers_mutex;
 };
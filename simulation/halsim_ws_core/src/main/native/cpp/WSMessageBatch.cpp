@@ -0,0 +1,44 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "WSMessageBatch.h"
+
+#include <utility>
+#include <vector>
+
+#include <wpi/raw_ostream.h>
+
+using namespace wpilibws;
+
+bool WSMessageBatch::Add(const wpi::json& msg) {
+  std::scoped_lock lock(m_mutex);
+  m_msgs.emplace_back(msg);
+  return m_msgs.size() == 1;
+}
+
+bool WSMessageBatch::Flush(wpi::raw_ostream& os) {
+  wpi::json frame(wpi::json::value_t::array);
+  {
+    std::scoped_lock lock(m_mutex);
+    if (m_msgs.empty()) {
+      return false;
+    }
+    frame.get_ref<wpi::json::array_t&>().swap(m_msgs);
+  }
+  wpi::json::to_msgpack(frame, wpi::detail::output_adapter<char>(os));
+  return true;
+}
+
+void wpilibws::DecodeBinaryFrame(
+    std::span<const uint8_t> data,
+    wpi::function_ref<void(const wpi::json&)> func) {
+  auto frame = wpi::json::from_msgpack(data.begin(), data.end());
+  if (!frame.is_array()) {
+    func(frame);
+    return;
+  }
+  for (auto&& msg : frame) {
+    func(msg);
+  }
+}
@@ -0,0 +1,101 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "WSProvider_Timing.h"
+
+#include <stdint.h>
+
+#include <hal/HALBase.h>
+#include <hal/simulation/MockHooks.h>
+#include <wpi/json.h>
+
+namespace wpilibws {
+
+// Steps are run on their own thread, as stepping waits for robot code,
+// which may need the uv loop (e.g. to create sim devices).
+class HALSimWSProviderTiming::StepThread : public wpi::SafeThread {
+ public:
+  explicit StepThread(HALSimWSProviderTiming& provider)
+      : m_provider(provider) {}
+
+  void Main() override;
+
+  // protected by m_mutex
+  uint64_t m_pendingStep = 0;
+  bool m_stepRequested = false;
+
+ private:
+  HALSimWSProviderTiming& m_provider;
+};
+
+void HALSimWSProviderTiming::StepThread::Main() {
+  std::unique_lock lock(m_mutex);
+  while (m_active) {
+    m_cond.wait(lock, [&] { return !m_active || m_stepRequested; });
+    if (!m_active) {
+      break;
+    }
+    uint64_t delta = m_pendingStep;
+    m_pendingStep = 0;
+    m_stepRequested = false;
+
+    lock.unlock();
+    HALSIM_StepTiming(delta);
+    int32_t status = 0;
+    m_provider.ProcessHalCallback({{"<time", HAL_GetFPGATime(&status)}});
+    lock.lock();
+  }
+}
+
+void HALSimWSProviderTiming::Initialize(WSRegisterFunc webRegisterFunc) {
+  CreateSingleProvider<HALSimWSProviderTiming>("Timing", webRegisterFunc);
+}
+
+HALSimWSProviderTiming::~HALSimWSProviderTiming() {
+  m_stepThread.Join();
+}
+
+void HALSimWSProviderTiming::RegisterCallbacks() {
+  if (!m_stepThread) {
+    m_stepThread.Start(*this);
+  }
+}
+
+void HALSimWSProviderTiming::CancelCallbacks() {
+  // don't leave the robot program paused without anything to step it
+  SetLockstep(false);
+}
+
+void HALSimWSProviderTiming::SetLockstep(bool enable) {
+  if (enable == m_lockstep) {
+    return;
+  }
+  m_lockstep = enable;
+  if (enable) {
+    HALSIM_PauseTiming();
+    // tell the remote end where time starts
+    int32_t status = 0;
+    ProcessHalCallback({{"<time", HAL_GetFPGATime(&status)}});
+  } else {
+    HALSIM_ResumeTiming();
+  }
+}
+
+void HALSimWSProviderTiming::OnNetValueChanged(const wpi::json& json) {
+  wpi::json::const_iterator it;
+  if ((it = json.find(">lockstep")) != json.end()) {
+    SetLockstep(it.value().get<bool>());
+  }
+  if ((it = json.find(">step")) != json.end() && m_lockstep) {
+    auto thr = m_stepThread.GetThread();
+    if (thr) {
+      // steps requested while one is running are combined
+      thr->m_pendingStep += it.value().get<uint64_t>();
+      thr->m_stepRequested = true;
+      thr->m_cond.notify_one();
+    }
+  }
+}
+
+}  // namespace wpilibws
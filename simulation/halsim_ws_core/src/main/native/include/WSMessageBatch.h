@@ -0,0 +1,49 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <wpi/function_ref.h>
+#include <wpi/json.h>
+#include <wpi/mutex.h>
+
+namespace wpi {
+class raw_ostream;
+}  // namespace wpi
+
+namespace wpilibws {
+
+// WebSocket subprotocol for binary frames; each frame is a MessagePack
+// array of messages, in the same format as the JSON text messages.
+inline constexpr std::string_view kBinaryProtocol = "msgpack.wpilibws";
+
+// Collects outgoing messages so they can be sent in a single binary frame.
+// Add() may be called from any thread.
+class WSMessageBatch {
+ public:
+  // Returns true if the batch was empty, in which case the caller needs to
+  // schedule a Flush()
+  bool Add(const wpi::json& msg);
+
+  // Writes all pending messages as one frame.  Returns false if there were
+  // no messages.
+  bool Flush(wpi::raw_ostream& os);
+
+ private:
+  wpi::mutex m_mutex;
+  std::vector<wpi::json> m_msgs;
+};
+
+// Decodes a binary frame, calling func for each message.  Throws
+// wpi::json::exception on malformed data.
+void DecodeBinaryFrame(std::span<const uint8_t> data,
+                       wpi::function_ref<void(const wpi::json&)> func);
+
+}  // namespace wpilibws
@@ -0,0 +1,40 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <memory>
+
+#include <wpi/SafeThread.h>
+
+#include "WSHalProviders.h"
+
+namespace wpilibws {
+
+// Lets the remote end drive simulated time.  In lockstep mode, time is
+// paused and only advances when a step is requested; each step is
+// acknowledged after all notifiers due in it have run.
+class HALSimWSProviderTiming : public HALSimWSHalProvider {
+ public:
+  static void Initialize(WSRegisterFunc webRegisterFunc);
+
+  using HALSimWSHalProvider::HALSimWSHalProvider;
+  ~HALSimWSProviderTiming() override;
+
+  void OnNetValueChanged(const wpi::json& json) override;
+
+ protected:
+  void RegisterCallbacks() override;
+  void CancelCallbacks() override;
+
+ private:
+  class StepThread;
+
+  void SetLockstep(bool enable);
+
+  bool m_lockstep = false;
+  wpi::SafeThreadOwner<StepThread> m_stepThread;
+};
+
+}  // namespace wpilibws
@@ -9,6 +9,7 @@
 #include <cstdio>
 #include <string>
 #include <string_view>
+#include <utility>
 
 #include <wpi/MemoryBuffer.h>
 #include <wpi/SmallVector.h>
@@ -37,6 +38,7 @@ void HALSimHttpConnection::ProcessWsUpgrade() {
   m_websocket->open.connect_extended([this](auto conn, auto) {
     conn.disconnect();  // one-shot
 
+    m_isBinary = m_websocket->GetProtocol() == kBinaryProtocol;
     if (!m_server->RegisterWebsocket(shared_from_this())) {
       Log(409);
       m_websocket->Fail(409, "Only a single simulation websocket is allowed");
@@ -66,6 +68,22 @@ void HALSimHttpConnection::ProcessWsUpgrade() {
     m_server->OnNetValueChanged(j);
   });
 
+  // binary frames hold a batch of messages
+  m_websocket->binary.connect([this](auto data, bool) {
+    if (!m_isWsConnected) {
+      return;
+    }
+
+    try {
+      DecodeBinaryFrame(
+          data, [&](const wpi::json& j) { m_server->OnNetValueChanged(j); });
+    } catch (const wpi::json::exception& e) {
+      std::string err("MessagePack parse failed: ");
+      err += e.what();
+      m_websocket->Fail(400, err);
+    }
+  });
+
   m_websocket->closed.connect([this](uint16_t, auto) {
     // unset the global, allow another websocket to connect
     if (m_isWsConnected) {
@@ -88,6 +106,15 @@ void HALSimHttpConnection::OnSimValueChanged(const wpi::json& msg) {
     wpi::print(stderr, "Error with message: {}\n", e.what());
   }
 
+  // batch messages until the uv loop gets to them
+  if (m_isBinary) {
+    if (m_batch.Add(msg)) {
+      m_server->GetExec().Send(
+          [self = shared_from_this()] { self->SendBatch(); });
+    }
+    return;
+  }
+
   // render json to buffers
   wpi::SmallVector<uv::Buffer, 4> sendBufs;
   wpi::raw_uv_ostream os{sendBufs, [this]() -> uv::Buffer {
@@ -97,20 +124,39 @@ void HALSimHttpConnection::OnSimValueChanged(const wpi::json& msg) {
   os << msg;
 
   // call the websocket send function on the uv loop
-  m_server->GetExec().Send([self = shared_from_this(), sendBufs] {
-    self->m_websocket->SendText(sendBufs,
-                                [self](auto bufs, wpi::uv::Error err) {
-                                  {
-                                    std::lock_guard lock(self->m_buffers_mutex);
-                                    self->m_buffers.Release(bufs);
-                                  }
-
-                                  if (err) {
-                                    wpi::print(stderr, "{}\n", err.str());
-                                    std::fflush(stderr);
-                                  }
-                                });
-  });
+  m_server->GetExec().Send(
+      [self = shared_from_this(), sendBufs] { self->Send(sendBufs, false); });
+}
+
+void HALSimHttpConnection::SendBatch() {
+  wpi::SmallVector<uv::Buffer, 4> sendBufs;
+  wpi::raw_uv_ostream os{sendBufs, [this]() -> uv::Buffer {
+                           std::lock_guard lock(m_buffers_mutex);
+                           return m_buffers.Allocate();
+                         }};
+  if (m_batch.Flush(os)) {
+    Send(sendBufs, true);
+  }
+}
+
+void HALSimHttpConnection::Send(std::span<const uv::Buffer> bufs,
+                                bool binary) {
+  auto callback = [self = shared_from_this()](auto sent, uv::Error err) {
+    {
+      std::lock_guard lock(self->m_buffers_mutex);
+      self->m_buffers.Release(sent);
+    }
+
+    if (err) {
+      wpi::print(stderr, "{}\n", err.str());
+      std::fflush(stderr);
+    }
+  };
+  if (binary) {
+    m_websocket->SendBinary(bufs, std::move(callback));
+  } else {
+    m_websocket->SendText(bufs, std::move(callback));
+  }
 }
 
 void HALSimHttpConnection::SendFileResponse(int code, std::string_view codeText,
@@ -6,10 +6,12 @@
 
 #include <cinttypes>
 #include <memory>
+#include <span>
 #include <string_view>
 #include <utility>
 
 #include <HALSimBaseWebSocketConnection.h>
+#include <WSMessageBatch.h>
 #include <wpi/json_fwd.h>
 #include <wpi/mutex.h>
 #include <wpinet/HttpWebSocketServerConnection.h>
@@ -26,9 +28,12 @@ class HALSimHttpConnection
  public:
   HALSimHttpConnection(std::shared_ptr<HALSimWeb> server,
                        std::shared_ptr<wpi::uv::Stream> stream)
-      : wpi::HttpWebSocketServerConnection<HALSimHttpConnection>(stream, {}),
+      : wpi::HttpWebSocketServerConnection<HALSimHttpConnection>(
+            stream, {kBinaryProtocol}),
         m_server(std::move(server)),
-        m_buffers(128) {}
+        m_buffers(128) {
+    m_deflate = wpi::WebSocket::DeflateOptions{};
+  }
 
  public:
   // callable from any thread
@@ -46,11 +51,19 @@ class HALSimHttpConnection
   void Log(int code);
 
  private:
+  // called on the uv loop
+  void SendBatch();
+  void Send(std::span<const wpi::uv::Buffer> bufs, bool binary);
+
   std::shared_ptr<HALSimWeb> m_server;
 
   // is the websocket connected?
   bool m_isWsConnected = false;
 
+  // was the binary protocol negotiated?
+  bool m_isBinary = false;
+  WSMessageBatch m_batch;
+
   // these are only valid if the websocket is connected
   wpi::uv::SimpleBufferPool<4> m_buffers;
   std::mutex m_buffers_mutex;
@@ -4,6 +4,7 @@
 
 #include "XRP.h"
 
+#include <algorithm>
 #include <bit>
 #include <string>
 
@@ -35,6 +36,13 @@ void XRP::HandleWPILibUpdate(const wpi::json& data) {
     return;
   }
 
+  // A newly initialized device needs the current values from the XRP, even
+  // if they haven't changed
+  if (auto it = data.find("data");
+      it != data.end() && it->find("<init") != it->end()) {
+    m_last_xrp_tags.clear();
+  }
+
   if (data["type"] == "DriverStation") {
     HandleDriverStationSimValueChanged(data);
   } else if (data["type"] == "XRPMotor") {
@@ -73,11 +81,18 @@ void XRP::HandleXRPUpdate(std::span<const uint8_t> packet) {
 
     // NOTE: tagPacket contains the size and tag bytes as well
     // Verify that the packet is indeed the right size
-    if (tagPacket.size() != static_cast<size_t>(tagLength + 1)) {
+    if (tagLength == 0 ||
+        tagPacket.size() != static_cast<size_t>(tagLength + 1)) {
       break;
     }
+    packet = packet.subspan(tagLength + 1);
+
+    // Most sensor values don't change from one packet to the next
+    if (!CheckTagChanged(tagPacket)) {
+      continue;
+    }
 
-    switch (packet[1]) {
+    switch (tagPacket[1]) {
       case XRP_TAG_GYRO:
         ReadGyroTag(tagPacket);
         break;
@@ -94,8 +109,6 @@ void XRP::HandleXRPUpdate(std::span<const uint8_t> packet) {
         ReadAnalogTag(tagPacket);
         break;
     }
-
-    packet = packet.subspan(tagLength + 1);
   }
 }
 
@@ -183,7 +196,11 @@ void XRP::HandleDIOSimValueChanged(const wpi::json& data) {
 }
 
 void XRP::HandleGyroSimValueChanged(const wpi::json& data) {
-  m_gyro_name = data["device"].get<std::string>();
+  auto& name = data["device"].get_ref<const std::string&>();
+  if (name != m_gyro_name) {
+    m_gyro_name = name;
+    m_last_xrp_tags.clear();
+  }
 }
 
 void XRP::HandleEncoderSimValueChanged(const wpi::json& data) {
@@ -276,6 +293,21 @@ void XRP::SetupDigitalOutTag(wpi::raw_uv_ostream& buf) {
   }
 }
 
+bool XRP::CheckTagChanged(std::span<const uint8_t> tagPacket) {
+  uint8_t tag = tagPacket[1];
+  uint16_t key = tag << 8;
+  if (tag != XRP_TAG_GYRO && tag != XRP_TAG_ACCEL && tagPacket.size() > 2) {
+    key |= tagPacket[2];
+  }
+  auto& last = m_last_xrp_tags[key];
+  if (std::equal(tagPacket.begin(), tagPacket.end(), last.begin(),
+                 last.end())) {
+    return false;
+  }
+  last.assign(tagPacket.begin(), tagPacket.end());
+  return true;
+}
+
 void XRP::ReadGyroTag(std::span<const uint8_t> packet) {
   if (packet.size() < 26) {
     return;  // size(1) + tag(1) + 6x 4byte
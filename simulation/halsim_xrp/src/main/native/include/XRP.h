@@ -9,6 +9,7 @@
 #include <span>
 #include <string>
 
+#include <wpi/SmallVector.h>
 #include <wpi/json_fwd.h>
 #include <wpinet/raw_uv_ostream.h>
 
@@ -59,6 +60,10 @@ class XRP {
   void ReadEncoderTag(std::span<const uint8_t> packet);
   void ReadAnalogTag(std::span<const uint8_t> packet);
 
+  // Returns false if the tag is identical to the last one received for the
+  // same device, so it doesn't need to be decoded and sent to WPILib again
+  bool CheckTagChanged(std::span<const uint8_t> tagPacket);
+
   // Robot State
   std::map<uint8_t, bool> m_digital_outputs;
   std::map<uint8_t, float> m_motor_outputs;
@@ -75,6 +80,11 @@ class XRP {
   // If no encoders are init-ed, this map is empty
   std::map<uint8_t, uint8_t> m_encoder_channel_map;
 
+  // Last tag received from the XRP for each device
+  // Key: tag << 8 | device ID (0 for the gyro and accelerometer)
+  // Cleared when WPILib devices are initialized, as they need the full state
+  std::map<uint16_t, wpi::SmallVector<uint8_t, 32>> m_last_xrp_tags;
+
   uint16_t m_wpilib_bound_seq = 0;
   uint16_t m_xrp_bound_seq = 0;
 
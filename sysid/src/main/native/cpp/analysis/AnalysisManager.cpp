@@ -4,8 +4,13 @@
 
 #include "sysid/analysis/AnalysisManager.h"
 
+#include <algorithm>
 #include <cmath>
+#include <future>
 #include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -21,10 +26,12 @@
 using namespace sysid;
 
 static double Lerp(units::second_t time,
-                   std::vector<MotorData::Run::Sample<double>>& data) {
-  auto next = std::find_if(data.begin(), data.end(), [&](const auto& entry) {
-    return entry.time > time;
-  });
+                   const std::vector<MotorData::Run::Sample<double>>& data) {
+  // Samples are in time order
+  auto next = std::upper_bound(data.begin(), data.end(), time,
+                               [](units::second_t time, const auto& entry) {
+                                 return time < entry.time;
+                               });
 
   if (next == data.begin()) {
     next++;
@@ -57,8 +64,9 @@ static double Lerp(units::second_t time,
  */
 static std::vector<PreparedData> ConvertToPrepared(const MotorData& data) {
   std::vector<PreparedData> prepared;
+  prepared.reserve(data.runs[0].voltage.size());
   // assume we've selected down to a single contiguous run by this point
-  auto run = data.runs[0];
+  const auto& run = data.runs[0];
 
   for (int i = 0; i < static_cast<int>(run.voltage.size()) - 1; ++i) {
     const auto& currentVoltage = run.voltage[i];
@@ -77,29 +85,6 @@ static std::vector<PreparedData> ConvertToPrepared(const MotorData& data) {
   return prepared;
 }
 
-/**
- * To preserve a raw copy of the data, this method saves a raw version
- * in the dataset StringMap where the key of the raw data starts with "raw-"
- * before the name of the original data.
- *
- * @tparam S The size of the array data that's being used
- *
- * @param dataset A reference to the dataset being used
- */
-static void CopyRawData(wpi::StringMap<MotorData>* dataset) {
-  auto& data = *dataset;
-  // Loads the Raw Data
-  for (auto& it : data) {
-    auto& key = it.first;
-    auto& motorData = it.second;
-
-    if (!wpi::contains(key, "raw")) {
-      data[fmt::format("raw-{}", key)] = motorData;
-      data[fmt::format("original-raw-{}", key)] = motorData;
-    }
-  }
-}
-
 /**
  * Assigns the combines the various datasets into a single one for analysis.
  *
@@ -115,28 +100,50 @@ static Storage CombineDatasets(const std::vector<PreparedData>& slowForward,
   return Storage{slowForward, slowBackward, fastForward, fastBackward};
 }
 
-void AnalysisManager::PrepareGeneralData() {
-  wpi::StringMap<std::vector<PreparedData>> preparedData;
+void AnalysisManager::ConvertRawData() {
+  WPI_INFO(m_logger, "{}", "Converting raw data to PreparedData struct.");
+  // Convert data to PreparedData structs, one test per thread
+  std::vector<std::pair<std::string, std::future<std::vector<PreparedData>>>>
+      conversions;
+  for (auto& [key, motorData] : m_data.motorData) {
+    conversions.emplace_back(
+        key, std::async(std::launch::async, [&motorData = motorData] {
+          return ConvertToPrepared(motorData);
+        }));
+  }
 
-  WPI_INFO(m_logger, "{}", "Preprocessing raw data.");
+  for (auto& [key, conversion] : conversions) {
+    auto& prepared = m_convertedData[key];
+    prepared = conversion.get();
+    WPI_INFO(m_logger, "SAMPLES {}", prepared.size());
+  }
+
+  // Store the original datasets
+  auto original = [&](std::string_view key) {
+    auto it = m_convertedData.find(key);
+    return it != m_convertedData.end() ? it->second
+                                       : std::vector<PreparedData>{};
+  };
+  m_originalDataset = CombineDatasets(
+      original("quasistatic-forward"), original("quasistatic-reverse"),
+      original("dynamic-forward"), original("dynamic-reverse"));
+}
 
-  WPI_INFO(m_logger, "{}", "Copying raw data.");
-  CopyRawData(&m_data.motorData);
+void AnalysisManager::PrepareGeneralData() {
+  WPI_INFO(m_logger, "{}", "Preprocessing raw data.");
 
-  WPI_INFO(m_logger, "{}", "Converting raw data to PreparedData struct.");
-  // Convert data to PreparedData structs
-  for (auto& it : m_data.motorData) {
-    auto key = it.first;
-    preparedData[key] = ConvertToPrepared(m_data.motorData[key]);
-    WPI_INFO(m_logger, "SAMPLES {}", preparedData[key].size());
+  // The conversion doesn't depend on the settings, so it's only done once
+  if (m_convertedData.empty()) {
+    ConvertRawData();
   }
 
-  // Store the original datasets
-  m_originalDataset =
-      CombineDatasets(preparedData["original-raw-quasistatic-forward"],
-                      preparedData["original-raw-quasistatic-reverse"],
-                      preparedData["original-raw-dynamic-forward"],
-                      preparedData["original-raw-dynamic-reverse"]);
+  // To preserve raw copies of the data, the raw data is also stored under keys
+  // starting with "raw-" before the name of the test
+  wpi::StringMap<std::vector<PreparedData>> preparedData;
+  for (auto& [key, prepared] : m_convertedData) {
+    preparedData[key] = prepared;
+    preparedData[fmt::format("raw-{}", key)] = prepared;
+  }
 
   WPI_INFO(m_logger, "{}", "Initial trimming and filtering.");
   sysid::InitialTrimAndFilter(&preparedData, &m_settings, m_positionDelays,
@@ -181,17 +188,106 @@ AnalysisManager::AnalysisManager(TestData data, Settings& settings,
 void AnalysisManager::PrepareData() {
   //  WPI_INFO(m_logger, "Preparing {} data", m_data.mechanismType.name);
 
+  if (auto index = FindCachedAnalysis()) {
+    WPI_INFO(m_logger, "{}", "Using cached data for the current settings");
+    LoadCachedAnalysis(*index);
+    return;
+  }
+
+  Settings requested = m_settings;
+  size_t numDelays = m_positionDelays.size();
+  m_currentAnalysis.reset();
+
   PrepareGeneralData();
+  StoreCachedAnalysis(requested, numDelays);
 
   WPI_INFO(m_logger, "{}", "Finished Preparing Data");
 }
 
+std::optional<size_t> AnalysisManager::FindCachedAnalysis() const {
+  // Preparing data with an unset velocity threshold or step test duration
+  // gives the same result as preparing it with the defaults they resolve to,
+  // so either one matches
+  for (size_t i = 0; i < m_cache.size(); ++i) {
+    const auto& entry = m_cache[i];
+    if (entry.medianWindow == m_settings.medianWindow &&
+        entry.unit == m_data.distanceUnit &&
+        (m_settings.velocityThreshold == entry.velocityThreshold ||
+         m_settings.velocityThreshold == entry.resolvedVelocityThreshold) &&
+        (m_settings.stepTestDuration == entry.stepTestDuration ||
+         m_settings.stepTestDuration == entry.resolvedStepTestDuration)) {
+      return i;
+    }
+  }
+  return std::nullopt;
+}
+
+void AnalysisManager::StoreCachedAnalysis(const Settings& requested,
+                                          size_t numDelays) {
+  CachedAnalysis entry{
+      .velocityThreshold = requested.velocityThreshold,
+      .medianWindow = requested.medianWindow,
+      .stepTestDuration = requested.stepTestDuration,
+      .unit = m_data.distanceUnit,
+      .resolvedVelocityThreshold = m_settings.velocityThreshold,
+      .resolvedStepTestDuration = m_settings.stepTestDuration,
+      .rawDataset = m_rawDataset,
+      .filteredDataset = m_filteredDataset,
+      .startTimes = m_startTimes,
+      .maxStepTime = m_maxStepTime,
+      .positionDelays = {m_positionDelays.begin() + numDelays,
+                         m_positionDelays.end()},
+      .velocityDelays = {m_velocityDelays.begin() + numDelays,
+                         m_velocityDelays.end()},
+      .feedforwardGains = std::nullopt};
+
+  // Replace the oldest entry once the cache is full
+  size_t index = m_nextCacheEntry;
+  m_nextCacheEntry = (m_nextCacheEntry + 1) % kMaxCachedAnalyses;
+  if (index < m_cache.size()) {
+    m_cache[index] = std::move(entry);
+  } else {
+    m_cache.emplace_back(std::move(entry));
+  }
+  m_currentAnalysis = index;
+}
+
+void AnalysisManager::LoadCachedAnalysis(size_t index) {
+  const auto& entry = m_cache[index];
+  m_settings.velocityThreshold = entry.resolvedVelocityThreshold;
+  m_settings.stepTestDuration = entry.resolvedStepTestDuration;
+  m_rawDataset = entry.rawDataset;
+  m_filteredDataset = entry.filteredDataset;
+  m_startTimes = entry.startTimes;
+  m_maxStepTime = entry.maxStepTime;
+
+  // The delays are averaged over every time the data was prepared, so add
+  // them again as if the data was prepared from scratch
+  m_positionDelays.insert(m_positionDelays.end(), entry.positionDelays.begin(),
+                          entry.positionDelays.end());
+  m_velocityDelays.insert(m_velocityDelays.end(), entry.velocityDelays.begin(),
+                          entry.velocityDelays.end());
+  m_currentAnalysis = index;
+}
+
 AnalysisManager::FeedforwardGains AnalysisManager::CalculateFeedforward() {
   if (m_filteredDataset.empty()) {
     throw sysid::InvalidDataError(
         "There is no data to perform gain calculation on.");
   }
 
+  if (!m_currentAnalysis) {
+    return FitFeedforward();
+  }
+
+  auto& gains = m_cache[*m_currentAnalysis].feedforwardGains;
+  if (!gains) {
+    gains = FitFeedforward();
+  }
+  return *gains;
+}
+
+AnalysisManager::FeedforwardGains AnalysisManager::FitFeedforward() {
   WPI_INFO(m_logger, "{}", "Calculating Gains");
   // Calculate feedforward gains from the data.
   const auto& analysisType = m_data.mechanismType;
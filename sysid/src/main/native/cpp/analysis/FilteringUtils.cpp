@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <future>
 #include <limits>
 #include <numbers>
 #include <numeric>
@@ -40,6 +41,43 @@ static void CheckSize(const std::vector<PreparedData>& data, size_t window,
   }
 }
 
+/**
+ * Runs a function on each dataset in parallel. If any calls throw, the
+ * exception from the first dataset in iteration order is rethrown once all the
+ * calls have finished.
+ *
+ * @param data The datasets.
+ * @param func The function to call with each dataset's key and data.
+ */
+template <typename F>
+static void ForEachDataset(wpi::StringMap<std::vector<PreparedData>>& data,
+                           F&& func) {
+  std::vector<std::future<void>> futures;
+  futures.reserve(data.size());
+  for (auto& it : data) {
+    futures.emplace_back(std::async(
+        std::launch::async,
+        [&func, key = std::string_view{it.first}, &dataset = it.second] {
+          func(key, dataset);
+        }));
+  }
+
+  // Wait for every call before rethrowing since they reference the datasets
+  std::exception_ptr exception;
+  for (auto& future : futures) {
+    try {
+      future.get();
+    } catch (...) {
+      if (!exception) {
+        exception = std::current_exception();
+      }
+    }
+  }
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
+
 /**
  * Helper function that determines if a certain key is storing raw data.
  *
@@ -362,10 +400,8 @@ void sysid::InitialTrimAndFilter(
     }
   }
 
-  for (auto& it : preparedData) {
-    auto& key = it.first;
-    auto& dataset = it.second;
-
+  // Each dataset is trimmed and filtered independently
+  ForEachDataset(preparedData, [&](std::string_view key, auto& dataset) {
     // Trim quasistatic test data to remove all points where voltage is zero or
     // velocity < velocity threshold.
     if (wpi::contains(key, "quasistatic")) {
@@ -390,6 +426,12 @@ void sysid::InitialTrimAndFilter(
 
     // Recalculate Accel and Cosine
     PrepareMechData(&dataset, unit);
+  });
+
+  // Step trimming runs serially since the first dynamic test trimmed sets the
+  // step test duration for the rest
+  for (auto& it : preparedData) {
+    auto& key = it.first;
 
     // Trims filtered Dynamic Test Data
     if (IsFiltered(key) && wpi::contains(key, "dynamic")) {
@@ -423,16 +465,12 @@ void sysid::AccelFilter(wpi::StringMap<std::vector<PreparedData>>* data) {
   auto& preparedData = *data;
 
   // Remove points with acceleration = 0
-  for (auto& it : preparedData) {
-    auto& dataset = it.second;
-
-    for (size_t i = 0; i < dataset.size(); i++) {
-      if (dataset.at(i).acceleration == 0.0) {
-        dataset.erase(dataset.begin() + i);
-        i--;
-      }
-    }
-  }
+  ForEachDataset(preparedData, [](std::string_view, auto& dataset) {
+    dataset.erase(
+        std::remove_if(dataset.begin(), dataset.end(),
+                       [](const auto& pt) { return pt.acceleration == 0.0; }),
+        dataset.end());
+  });
 
   // Confirm there's still data
   if (std::any_of(preparedData.begin(), preparedData.end(),
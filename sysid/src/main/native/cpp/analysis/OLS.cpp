@@ -4,6 +4,7 @@
 
 #include "sysid/analysis/OLS.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 
@@ -11,6 +12,49 @@
 
 namespace sysid {
 
+/**
+ * Computes the fit statistics for a regression.
+ *
+ * @param β The regression coefficients.
+ * @param SSE The error sum of squares.
+ * @param yty The sum of the squared dependent variables.
+ * @param ySum The sum of the dependent variables.
+ * @param n The sample size.
+ */
+static OLSResult MakeResult(const Eigen::VectorXd& β, double SSE, double yty,
+                            double ySum, int n) {
+  // Number of explanatory variables
+  int p = β.rows();
+
+  // Total sum of squares (total variation in y)
+  //
+  // From slide 24 of
+  // http://www.stat.columbia.edu/~fwood/Teaching/w4315/Fall2009/lecture_11:
+  //
+  //   SSTO = yᵀy - 1/n yᵀJy
+  //
+  // where J is a matrix of ones. yᵀJy is the square of the sum of y.
+  double SSTO = yty - ySum * ySum / n;
+
+  // R² or the coefficient of determination, which represents how much of the
+  // total variation (variation in y) can be explained by the regression model
+  double rSquared = 1.0 - SSE / SSTO;
+
+  // Adjusted R²
+  //
+  //                       n − 1
+  //   R̅² = 1 − (1 − R²) ---------
+  //                     n − p − 1
+  //
+  // See https://en.wikipedia.org/wiki/Coefficient_of_determination#Adjusted_R2
+  double adjRSquared = 1.0 - (1.0 - rSquared) * ((n - 1.0) / (n - p - 1.0));
+
+  // Root-mean-square error
+  double RMSE = std::sqrt(SSE / n);
+
+  return {{β.data(), β.data() + β.size()}, adjRSquared, RMSE};
+}
+
 OLSResult OLS(const Eigen::MatrixXd& X, const Eigen::VectorXd& y) {
   assert(X.rows() == y.rows());
 
@@ -42,47 +86,74 @@ OLSResult OLS(const Eigen::MatrixXd& X, const Eigen::VectorXd& y) {
   //
   // XᵀX is guaranteed to be symmetric positive definite, so an LLT
   // decomposition can be used.
-  Eigen::MatrixXd β = (X.transpose() * X).llt().solve(X.transpose() * y);
+  Eigen::VectorXd β = (X.transpose() * X).llt().solve(X.transpose() * y);
 
   // Error sum of squares
   double SSE = (y - X * β).squaredNorm();
 
-  // Sample size
-  int n = X.rows();
+  return MakeResult(β, SSE, y.squaredNorm(), y.sum(), X.rows());
+}
 
-  // Number of explanatory variables
-  int p = β.rows();
+IncrementalOLS::IncrementalOLS(int numVariables)
+    : m_XtX{Eigen::MatrixXd::Zero(numVariables, numVariables)},
+      m_Xty{Eigen::VectorXd::Zero(numVariables)} {}
 
-  // Total sum of squares (total variation in y)
-  //
-  // From slide 24 of
-  // http://www.stat.columbia.edu/~fwood/Teaching/w4315/Fall2009/lecture_11:
-  //
-  //   SSTO = yᵀy - 1/n yᵀJy
-  //
-  // where J is a matrix of ones.
-  double SSTO =
-      (y.transpose() * y - 1.0 / y.rows() * y.transpose() *
-                               Eigen::MatrixXd::Ones(y.rows(), y.rows()) * y)
-          .value();
+void IncrementalOLS::Add(const Eigen::Ref<const Eigen::VectorXd>& x,
+                         double y) {
+  assert(x.rows() == m_Xty.rows());
 
-  // R² or the coefficient of determination, which represents how much of the
-  // total variation (variation in y) can be explained by the regression model
-  double rSquared = 1.0 - SSE / SSTO;
+  m_XtX.selfadjointView<Eigen::Lower>().rankUpdate(x);
+  m_Xty += y * x;
+  m_yty += y * y;
+  m_ySum += y;
+  ++m_n;
+}
 
-  // Adjusted R²
+void IncrementalOLS::Add(const Eigen::Ref<const Eigen::MatrixXd>& X,
+                         const Eigen::Ref<const Eigen::VectorXd>& y) {
+  assert(X.rows() == y.rows());
+  assert(X.cols() == m_Xty.rows());
+
+  m_XtX.selfadjointView<Eigen::Lower>().rankUpdate(X.transpose());
+  m_Xty += X.transpose() * y;
+  m_yty += y.squaredNorm();
+  m_ySum += y.sum();
+  m_n += X.rows();
+}
+
+void IncrementalOLS::Remove(const Eigen::Ref<const Eigen::VectorXd>& x,
+                            double y) {
+  assert(x.rows() == m_Xty.rows());
+
+  m_XtX.selfadjointView<Eigen::Lower>().rankUpdate(x, -1.0);
+  m_Xty -= y * x;
+  m_yty -= y * y;
+  m_ySum -= y;
+  --m_n;
+}
+
+void IncrementalOLS::Reset() {
+  m_XtX.setZero();
+  m_Xty.setZero();
+  m_yty = 0.0;
+  m_ySum = 0.0;
+  m_n = 0;
+}
+
+OLSResult IncrementalOLS::Solve() const {
+  // β = (XᵀX)⁻¹Xᵀy, where only the lower triangle of XᵀX is updated
+  Eigen::VectorXd β = m_XtX.selfadjointView<Eigen::Lower>().llt().solve(m_Xty);
+
+  // Error sum of squares
   //
-  //                       n − 1
-  //   R̅² = 1 − (1 − R²) ---------
-  //                     n − p − 1
+  //   SSE = (y − Xβ)ᵀ(y − Xβ)
+  //       = yᵀy − 2βᵀXᵀy + βᵀXᵀXβ
+  //       = yᵀy − βᵀXᵀy
   //
-  // See https://en.wikipedia.org/wiki/Coefficient_of_determination#Adjusted_R2
-  double adjRSquared = 1.0 - (1.0 - rSquared) * ((n - 1.0) / (n - p - 1.0));
+  // since XᵀXβ = Xᵀy. Cancellation can make it slightly negative.
+  double SSE = std::max(m_yty - β.dot(m_Xty), 0.0);
 
-  // Root-mean-square error
-  double RMSE = std::sqrt(SSE / n);
-
-  return {{β.data(), β.data() + β.size()}, adjRSquared, RMSE};
+  return MakeResult(β, SSE, m_yty, m_ySum, m_n);
 }
 
 }  // namespace sysid
@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <cmath>
 #include <functional>
+#include <future>
 #include <mutex>
 #include <utility>
 #include <vector>
@@ -224,31 +225,36 @@ void AnalyzerPlot::SetData(const Storage& rawData, const Storage& filteredData,
 
     SetRawTimeData(rawSlow, rawFast, abort);
 
-    // Populate simulated time domain data
+    // Populate simulated time domain data. The quasistatic and dynamic tests
+    // are simulated concurrently since they're independent.
+    auto simulate = [&](const auto& model) {
+      double dynamicSquaredErrorSum = 0;
+      double dynamicSquaredVariationSum = 0;
+      int dynamicTimeSeriesPoints = 0;
+      auto dynamicSim = std::async(std::launch::async, [&] {
+        return PopulateTimeDomainSim(
+            rawFast, startTimes, fastStep, model, &dynamicSquaredErrorSum,
+            &dynamicSquaredVariationSum, &dynamicTimeSeriesPoints);
+      });
+      m_quasistaticData.simData = PopulateTimeDomainSim(
+          rawSlow, startTimes, fastStep, model, &simSquaredErrorSum,
+          &squaredVariationSum, &timeSeriesPoints);
+      m_dynamicData.simData = dynamicSim.get();
+
+      simSquaredErrorSum += dynamicSquaredErrorSum;
+      squaredVariationSum += dynamicSquaredVariationSum;
+      timeSeriesPoints += dynamicTimeSeriesPoints;
+    };
+
     if (type == analysis::kElevator) {
       const auto& Kg = ffGains.Kg.gain;
-      m_quasistaticData.simData = PopulateTimeDomainSim(
-          rawSlow, startTimes, fastStep, sysid::ElevatorSim{Ks, Kv, Ka, Kg},
-          &simSquaredErrorSum, &squaredVariationSum, &timeSeriesPoints);
-      m_dynamicData.simData = PopulateTimeDomainSim(
-          rawFast, startTimes, fastStep, sysid::ElevatorSim{Ks, Kv, Ka, Kg},
-          &simSquaredErrorSum, &squaredVariationSum, &timeSeriesPoints);
+      simulate(sysid::ElevatorSim{Ks, Kv, Ka, Kg});
     } else if (type == analysis::kArm) {
       const auto& Kg = ffGains.Kg.gain;
       const auto& offset = ffGains.offset.gain;
-      m_quasistaticData.simData = PopulateTimeDomainSim(
-          rawSlow, startTimes, fastStep, sysid::ArmSim{Ks, Kv, Ka, Kg, offset},
-          &simSquaredErrorSum, &squaredVariationSum, &timeSeriesPoints);
-      m_dynamicData.simData = PopulateTimeDomainSim(
-          rawFast, startTimes, fastStep, sysid::ArmSim{Ks, Kv, Ka, Kg, offset},
-          &simSquaredErrorSum, &squaredVariationSum, &timeSeriesPoints);
+      simulate(sysid::ArmSim{Ks, Kv, Ka, Kg, offset});
     } else {
-      m_quasistaticData.simData = PopulateTimeDomainSim(
-          rawSlow, startTimes, fastStep, sysid::SimpleMotorSim{Ks, Kv, Ka},
-          &simSquaredErrorSum, &squaredVariationSum, &timeSeriesPoints);
-      m_dynamicData.simData = PopulateTimeDomainSim(
-          rawFast, startTimes, fastStep, sysid::SimpleMotorSim{Ks, Kv, Ka},
-          &simSquaredErrorSum, &squaredVariationSum, &timeSeriesPoints);
+      simulate(sysid::SimpleMotorSim{Ks, Kv, Ka});
     }
   }
 
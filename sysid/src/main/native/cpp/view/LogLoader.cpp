@@ -9,6 +9,7 @@
 #include <span>
 #include <string>
 #include <string_view>
+#include <system_error>
 #include <utility>
 #include <vector>
 
@@ -39,15 +40,13 @@ void LogLoader::Display() {
     if (!m_opener->result().empty()) {
       m_filename = m_opener->result()[0];
 
-      auto fileBuffer = wpi::MemoryBuffer::GetFile(m_filename);
-      if (!fileBuffer) {
+      std::error_code ec;
+      wpi::log::DataLogReader reader{m_filename, ec};
+      if (ec) {
         ImGui::OpenPopup("Error");
-        m_error = fmt::format("Could not open file: {}",
-                              fileBuffer.error().message());
+        m_error = fmt::format("Could not open file: {}", ec.message());
         return;
       }
-
-      wpi::log::DataLogReader reader{std::move(*fileBuffer)};
       if (!reader.IsValid()) {
         ImGui::OpenPopup("Error");
         m_error = "Not a valid datalog file";
@@ -9,6 +9,7 @@
 #include <exception>
 #include <limits>
 #include <numeric>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -205,6 +206,11 @@ class AnalysisManager {
   /**
    * Prepares data from the JSON and stores the output in Storage member
    * variables.
+   *
+   * The prepared data for the last few combinations of filtering settings
+   * (velocity threshold, median window, step test duration, and units) is
+   * cached, so switching back to previously used settings doesn't rerun the
+   * filtering or the feedforward fit.
    */
   void PrepareData();
 
@@ -346,6 +352,49 @@ class AnalysisManager {
   std::vector<units::second_t> m_positionDelays;
   std::vector<units::second_t> m_velocityDelays;
 
+  // Raw data converted to PreparedData, indexed by test name. This doesn't
+  // depend on the settings, so it's only computed once.
+  wpi::StringMap<std::vector<PreparedData>> m_convertedData;
+
+  /**
+   * The output of PrepareData() and CalculateFeedforward() for one
+   * combination of filtering settings.
+   */
+  struct CachedAnalysis {
+    // The settings the data was prepared with
+    double velocityThreshold;
+    int medianWindow;
+    units::second_t stepTestDuration;
+    std::string unit;
+
+    // The settings after unset values were replaced with their defaults
+    double resolvedVelocityThreshold;
+    units::second_t resolvedStepTestDuration;
+
+    Storage rawDataset;
+    Storage filteredDataset;
+    std::array<units::second_t, 4> startTimes;
+    units::second_t maxStepTime;
+    std::vector<units::second_t> positionDelays;
+    std::vector<units::second_t> velocityDelays;
+
+    // Computed on the first CalculateFeedforward() call for these settings
+    std::optional<FeedforwardGains> feedforwardGains;
+  };
+
+  static constexpr size_t kMaxCachedAnalyses = 8;
+
+  std::vector<CachedAnalysis> m_cache;
+  size_t m_nextCacheEntry = 0;
+
+  // Index in m_cache of the analysis for the current settings
+  std::optional<size_t> m_currentAnalysis;
+
   void PrepareGeneralData();
+  void ConvertRawData();
+  std::optional<size_t> FindCachedAnalysis() const;
+  void StoreCachedAnalysis(const Settings& requested, size_t numDelays);
+  void LoadCachedAnalysis(size_t index);
+  FeedforwardGains FitFeedforward();
 };
 }  // namespace sysid
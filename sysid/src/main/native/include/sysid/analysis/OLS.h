@@ -29,4 +29,70 @@ struct OLSResult {
  */
 OLSResult OLS(const Eigen::MatrixXd& X, const Eigen::VectorXd& y);
 
+/**
+ * Performs ordinary least squares multiple regression on samples that can be
+ * added and removed one at a time.
+ *
+ * Only the normal equations XᵀXβ = Xᵀy and the sums needed for the fit
+ * statistics are stored, so adding or removing a sample is a rank-one update
+ * that costs O(p²) for p explanatory variables regardless of how many samples
+ * there are, and solving costs O(p³).
+ */
+class IncrementalOLS {
+ public:
+  /**
+   * Constructs an empty regression.
+   *
+   * @param numVariables The number of explanatory variables (columns of X).
+   */
+  explicit IncrementalOLS(int numVariables);
+
+  /**
+   * Adds a sample.
+   *
+   * @param x The sample's row of X in y = Xβ.
+   * @param y The sample's element of y in y = Xβ.
+   */
+  void Add(const Eigen::Ref<const Eigen::VectorXd>& x, double y);
+
+  /**
+   * Adds a sample for each row of X.
+   *
+   * @param X The samples' rows of X in y = Xβ.
+   * @param y The samples' elements of y in y = Xβ.
+   */
+  void Add(const Eigen::Ref<const Eigen::MatrixXd>& X,
+           const Eigen::Ref<const Eigen::VectorXd>& y);
+
+  /**
+   * Removes a previously added sample.
+   *
+   * @param x The sample's row of X in y = Xβ.
+   * @param y The sample's element of y in y = Xβ.
+   */
+  void Remove(const Eigen::Ref<const Eigen::VectorXd>& x, double y);
+
+  /**
+   * Removes all samples.
+   */
+  void Reset();
+
+  /**
+   * Returns the number of samples.
+   */
+  int Size() const { return m_n; }
+
+  /**
+   * Solves the regression for the current samples.
+   */
+  OLSResult Solve() const;
+
+ private:
+  Eigen::MatrixXd m_XtX;
+  Eigen::VectorXd m_Xty;
+  double m_yty = 0.0;
+  double m_ySum = 0.0;
+  int m_n = 0;
+};
+
 }  // namespace sysid
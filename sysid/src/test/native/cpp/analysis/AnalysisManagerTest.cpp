@@ -0,0 +1,100 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <string_view>
+
+#include <gtest/gtest.h>
+#include <units/time.h>
+#include <units/voltage.h>
+#include <wpi/Logger.h>
+
+#include "sysid/analysis/AnalysisManager.h"
+#include "sysid/analysis/AnalysisType.h"
+#include "sysid/analysis/SimpleMotorSim.h"
+#include "sysid/analysis/Storage.h"
+
+namespace {
+
+constexpr double Ks = 1.01;
+constexpr double Kv = 3.060;
+constexpr double Ka = 0.327;
+
+/**
+ * Simulates a test with a simple motor and records it as motor data.
+ *
+ * @param ramp Voltage ramp rate for quasistatic tests, or zero for dynamic
+ *   tests.
+ * @param step Step voltage for dynamic tests, or zero for quasistatic tests.
+ * @param duration Duration of the test.
+ */
+sysid::MotorData SimulateTest(units::volt_t ramp, units::volt_t step,
+                              units::second_t duration) {
+  constexpr auto kDt = 5_ms;
+  sysid::SimpleMotorSim model{Ks, Kv, Ka};
+
+  sysid::MotorData::Run run;
+  for (auto t = 0_s; t < duration; t += kDt) {
+    auto voltage = ramp * t.value() + step;
+    run.voltage.emplace_back(t, voltage);
+    run.position.emplace_back(t, model.GetPosition());
+    run.velocity.emplace_back(t, model.GetVelocity());
+    model.Update(voltage, kDt);
+  }
+
+  return sysid::MotorData{"motor", {run}};
+}
+
+sysid::TestData SimulateTests() {
+  sysid::TestData data{"Meters", sysid::analysis::kSimple, {}};
+  data.motorData["quasistatic-forward"] = SimulateTest(0.5_V, 0_V, 15_s);
+  data.motorData["quasistatic-reverse"] = SimulateTest(-0.5_V, 0_V, 15_s);
+  data.motorData["dynamic-forward"] = SimulateTest(0_V, 7_V, 3_s);
+  data.motorData["dynamic-reverse"] = SimulateTest(0_V, -7_V, 3_s);
+  return data;
+}
+
+}  // namespace
+
+TEST(AnalysisManagerTest, CachedSettingsMatchRecalculation) {
+  wpi::Logger logger;
+  sysid::AnalysisManager::Settings settings;
+  sysid::AnalysisManager manager{SimulateTests(), settings, logger};
+
+  settings.velocityThreshold = 0.2;
+  manager.PrepareData();
+  auto gains = manager.CalculateFeedforward();
+  auto filtered = manager.GetFilteredData();
+  auto stepTestDuration = settings.stepTestDuration;
+
+  EXPECT_NEAR(Ks, gains.Ks.gain, 0.05);
+  EXPECT_NEAR(Kv, gains.Kv.gain, 0.05);
+  EXPECT_NEAR(Ka, gains.Ka.gain, 0.05);
+
+  settings.velocityThreshold = 1.0;
+  settings.medianWindow = 3;
+  manager.PrepareData();
+  manager.CalculateFeedforward();
+  EXPECT_NE(filtered.slowForward.size(),
+            manager.GetFilteredData().slowForward.size());
+
+  // Switching back to the first settings gives the same data and gains
+  settings.velocityThreshold = 0.2;
+  settings.medianWindow = 1;
+  manager.PrepareData();
+  auto cachedGains = manager.CalculateFeedforward();
+
+  EXPECT_EQ(stepTestDuration, settings.stepTestDuration);
+  EXPECT_EQ(filtered.slowForward, manager.GetFilteredData().slowForward);
+  EXPECT_EQ(filtered.fastBackward, manager.GetFilteredData().fastBackward);
+  EXPECT_EQ(gains.olsResult.coeffs, cachedGains.olsResult.coeffs);
+  EXPECT_EQ(gains.Ka.gain, cachedGains.Ka.gain);
+
+  // A fresh manager with the same settings gives the same gains
+  sysid::AnalysisManager::Settings freshSettings;
+  sysid::AnalysisManager freshManager{SimulateTests(), freshSettings, logger};
+  freshSettings.velocityThreshold = 0.2;
+  freshManager.PrepareData();
+  auto freshGains = freshManager.CalculateFeedforward();
+  EXPECT_EQ(freshGains.olsResult.coeffs, cachedGains.olsResult.coeffs);
+}
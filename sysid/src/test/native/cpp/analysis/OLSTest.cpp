@@ -33,6 +33,59 @@ TEST(OLSTest, TwoVariablesFivePoints) {
   EXPECT_DOUBLE_EQ(rSquared, 0.91906029466386019);
 }
 
+TEST(OLSTest, IncrementalMatchesBatch) {
+  Eigen::MatrixXd X{{1, 2}, {1, 3}, {1, 5}, {1, 7}, {1, 9}};
+  Eigen::VectorXd y{{4}, {5}, {7}, {10}, {15}};
+
+  sysid::IncrementalOLS ols{2};
+  for (int i = 0; i < X.rows(); ++i) {
+    ols.Add(X.row(i).transpose(), y(i));
+  }
+  EXPECT_EQ(ols.Size(), 5);
+
+  auto expected = sysid::OLS(X, y);
+  auto [coeffs, rSquared, rmse] = ols.Solve();
+  EXPECT_EQ(coeffs.size(), 2u);
+
+  EXPECT_NEAR(coeffs[0], expected.coeffs[0], 1e-12);
+  EXPECT_NEAR(coeffs[1], expected.coeffs[1], 1e-12);
+  EXPECT_NEAR(rSquared, expected.rSquared, 1e-12);
+  EXPECT_NEAR(rmse, expected.rmse, 1e-12);
+}
+
+TEST(OLSTest, IncrementalRemove) {
+  // Adding then removing an outlier leaves the fit from TwoVariablesFivePoints
+  Eigen::MatrixXd X{{1, 2}, {1, 3}, {1, 5}, {1, 7}, {1, 9}};
+  Eigen::VectorXd y{{4}, {5}, {7}, {10}, {15}};
+
+  sysid::IncrementalOLS ols{2};
+  ols.Add(X, y);
+  ols.Add(Eigen::Vector2d{1, 4}, 30);
+  ols.Remove(Eigen::Vector2d{1, 4}, 30);
+  EXPECT_EQ(ols.Size(), 5);
+
+  auto [coeffs, rSquared, rmse] = ols.Solve();
+  EXPECT_NEAR(coeffs[0], 0.30487804878048774, 1e-12);
+  EXPECT_NEAR(coeffs[1], 1.5182926829268293, 1e-12);
+  EXPECT_NEAR(rSquared, 0.91906029466386019, 1e-12);
+
+  // Sliding the window forward by one sample matches a batch fit of it
+  ols.Remove(X.row(0).transpose(), y(0));
+  ols.Add(Eigen::Vector2d{1, 11}, 17);
+
+  Eigen::MatrixXd windowX{{1, 3}, {1, 5}, {1, 7}, {1, 9}, {1, 11}};
+  Eigen::VectorXd windowY{{5}, {7}, {10}, {15}, {17}};
+  auto expected = sysid::OLS(windowX, windowY);
+  auto windowFit = ols.Solve();
+  EXPECT_NEAR(windowFit.coeffs[0], expected.coeffs[0], 1e-12);
+  EXPECT_NEAR(windowFit.coeffs[1], expected.coeffs[1], 1e-12);
+  EXPECT_NEAR(windowFit.rSquared, expected.rSquared, 1e-12);
+  EXPECT_NEAR(windowFit.rmse, expected.rmse, 1e-12);
+
+  ols.Reset();
+  EXPECT_EQ(ols.Size(), 0);
+}
+
 #ifndef NDEBUG
 TEST(OLSTest, MalformedData) {
   Eigen::MatrixXd X{{1, 2}, {1, 3}, {1, 4}};
@@ -4,12 +4,23 @@
 
 #include "cameracalibration.h"
 
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
 #include <fstream>
 #include <iostream>
+#include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
+#include <Eigen/QR>
 #include <mrcal_wrapper.h>
 #include <opencv2/objdetect/aruco_board.hpp>
 #include <opencv2/opencv.hpp>
@@ -43,78 +54,184 @@ static bool filter(std::vector<cv::Point2f> charuco_corners,
   return true;
 }
 
-int cameracalibration::calibrate(const std::string& input_video,
-                                 CameraModel& camera_model, float square_width,
-                                 float marker_width, int board_width,
-                                 int board_height, bool show_debug_window) {
-  // ChArUco Board
-  cv::aruco::Dictionary aruco_dict =
-      cv::aruco::getPredefinedDictionary(cv::aruco::DICT_5X5_1000);
-  cv::Ptr<cv::aruco::CharucoBoard> charuco_board = new cv::aruco::CharucoBoard(
-      cv::Size(board_width, board_height), square_width * 0.0254,
-      marker_width * 0.0254, aruco_dict);
-  cv::aruco::CharucoDetector charuco_detector(*charuco_board);
+// Most frames to calibrate with. Frames beyond this add solve time without
+// adding information, as consecutive video frames are nearly identical.
+constexpr size_t max_keyframes = 300;
+
+// A ChArUco board detection in one video frame
+struct BoardDetection {
+  std::vector<int> charuco_ids;
+  std::vector<cv::Point3f> obj_points;
+  std::vector<cv::Point2f> img_points;
+  cv::Mat debug_image;
+};
+
+static std::optional<BoardDetection> detect_board(
+    const cv::aruco::CharucoDetector& charuco_detector,
+    const cv::aruco::CharucoBoard& charuco_board, const cv::Mat& frame,
+    int board_width, int board_height, bool show_debug_window) {
+  cv::Mat frame_gray;
+  cv::cvtColor(frame, frame_gray, cv::COLOR_BGR2GRAY);
+
+  std::vector<cv::Point2f> charuco_corners;
+  std::vector<int> charuco_ids;
+  std::vector<std::vector<cv::Point2f>> marker_corners;
+  std::vector<int> marker_ids;
+
+  charuco_detector.detectBoard(frame_gray, charuco_corners, charuco_ids,
+                               marker_corners, marker_ids);
+
+  if (!filter(charuco_corners, charuco_ids, marker_corners, marker_ids,
+              board_width, board_height)) {
+    return std::nullopt;
+  }
 
-  // Video capture
-  cv::VideoCapture video_capture(input_video);
-  cv::Size frame_shape;
+  BoardDetection detection;
+  charuco_board.matchImagePoints(charuco_corners, charuco_ids,
+                                 detection.obj_points, detection.img_points);
+  detection.charuco_ids = std::move(charuco_ids);
 
-  std::vector<std::vector<cv::Point2f>> all_charuco_corners;
-  std::vector<std::vector<int>> all_charuco_ids;
+  if (show_debug_window) {
+    detection.debug_image = frame.clone();
+    cv::aruco::drawDetectedMarkers(detection.debug_image, marker_corners,
+                                   marker_ids);
+    cv::aruco::drawDetectedCornersCharuco(
+        detection.debug_image, charuco_corners, detection.charuco_ids);
+  }
 
-  std::vector<std::vector<cv::Point3f>> all_obj_points;
-  std::vector<std::vector<cv::Point2f>> all_img_points;
+  return detection;
+}
 
-  while (video_capture.grab()) {
-    cv::Mat frame;
-    video_capture.retrieve(frame);
+// Detects the ChArUco board in every frame of a video. Frames are decoded on
+// one thread and detected on a thread per hardware thread, and the detections
+// are returned in frame order. Returns false if the video can't be opened.
+static bool detect_boards(const std::string& input_video,
+                          const cv::aruco::CharucoBoard& charuco_board,
+                          int board_width, int board_height,
+                          bool show_debug_window,
+                          std::vector<BoardDetection>& detections,
+                          cv::Size& frame_shape) {
+  cv::VideoCapture video_capture(input_video);
+  if (!video_capture.isOpened()) {
+    return false;
+  }
 
-    cv::Mat debug_image = frame;
+  const int num_workers =
+      std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+
+  // Limits how many frames are decoded ahead of merging
+  const size_t max_pending_frames = 2 * num_workers;
+
+  std::mutex mutex;
+  std::condition_variable frame_decoded;
+  std::condition_variable frame_merged;
+  std::condition_variable frame_processed;
+  std::deque<std::pair<int, cv::Mat>> decoded_frames;
+  std::map<int, std::optional<BoardDetection>> processed_frames;
+  bool decoding_done = false;
+  bool stop = false;
+  int frame_count = 0;
+
+  std::thread decoder{[&] {
+    int frame_num = 0;
+    while (video_capture.grab()) {
+      cv::Mat frame;
+      video_capture.retrieve(frame);
+      if (frame.empty()) {
+        break;
+      }
 
-    if (frame.empty()) {
-      break;
+      std::unique_lock lock{mutex};
+      frame_merged.wait(lock, [&] {
+        return stop || decoded_frames.size() + processed_frames.size() <
+                           max_pending_frames;
+      });
+      if (stop) {
+        break;
+      }
+      if (frame_num == 0) {
+        frame_shape = frame.size();
+      }
+      decoded_frames.emplace_back(frame_num++, std::move(frame));
+      frame_decoded.notify_one();
     }
 
-    // Detect
-    cv::Mat frame_gray;
-    cv::cvtColor(frame, frame_gray, cv::COLOR_BGR2GRAY);
-
-    frame_shape = frame_gray.size();
-
-    std::vector<cv::Point2f> charuco_corners;
-    std::vector<int> charuco_ids;
-    std::vector<std::vector<cv::Point2f>> marker_corners;
-    std::vector<int> marker_ids;
-
-    std::vector<cv::Point3f> obj_points;
-    std::vector<cv::Point2f> img_points;
+    std::scoped_lock lock{mutex};
+    decoding_done = true;
+    frame_count = frame_num;
+    frame_decoded.notify_all();
+    frame_processed.notify_all();
+  }};
+
+  std::vector<std::thread> workers;
+  for (int i = 0; i < num_workers; i++) {
+    workers.emplace_back([&] {
+      // Detectors aren't shared between threads
+      cv::aruco::CharucoDetector charuco_detector(charuco_board);
+
+      while (true) {
+        std::pair<int, cv::Mat> frame;
+        {
+          std::unique_lock lock{mutex};
+          frame_decoded.wait(
+              lock, [&] { return !decoded_frames.empty() || decoding_done; });
+          if (decoded_frames.empty()) {
+            return;
+          }
+          frame = std::move(decoded_frames.front());
+          decoded_frames.pop_front();
+        }
+
+        auto detection =
+            detect_board(charuco_detector, charuco_board, frame.second,
+                         board_width, board_height, show_debug_window);
+
+        std::scoped_lock lock{mutex};
+        processed_frames.emplace(frame.first, std::move(detection));
+        frame_processed.notify_all();
+      }
+    });
+  }
 
-    charuco_detector.detectBoard(frame_gray, charuco_corners, charuco_ids,
-                                 marker_corners, marker_ids);
+  // Merge detections in frame order
+  for (int frame_num = 0;; frame_num++) {
+    std::optional<BoardDetection> detection;
+    {
+      std::unique_lock lock{mutex};
+      frame_processed.wait(lock, [&] {
+        return processed_frames.contains(frame_num) ||
+               (decoding_done && frame_num >= frame_count);
+      });
+      auto it = processed_frames.find(frame_num);
+      if (it == processed_frames.end()) {
+        break;
+      }
+      detection = std::move(it->second);
+      processed_frames.erase(it);
+    }
+    frame_merged.notify_one();
 
-    if (!filter(charuco_corners, charuco_ids, marker_corners, marker_ids,
-                board_width, board_height)) {
+    if (!detection) {
       continue;
     }
 
-    charuco_board->matchImagePoints(charuco_corners, charuco_ids, obj_points,
-                                    img_points);
-
-    all_charuco_corners.push_back(charuco_corners);
-    all_charuco_ids.push_back(charuco_ids);
-
-    all_obj_points.push_back(obj_points);
-    all_img_points.push_back(img_points);
-
     if (show_debug_window) {
-      cv::aruco::drawDetectedMarkers(debug_image, marker_corners, marker_ids);
-      cv::aruco::drawDetectedCornersCharuco(debug_image, charuco_corners,
-                                            charuco_ids);
-      cv::imshow("Frame", debug_image);
+      cv::imshow("Frame", detection->debug_image);
+      detection->debug_image.release();
       if (cv::waitKey(1) == 'q') {
+        std::scoped_lock lock{mutex};
+        stop = true;
+        frame_merged.notify_one();
         break;
       }
     }
+
+    detections.emplace_back(std::move(detection.value()));
+  }
+
+  decoder.join();
+  for (auto& worker : workers) {
+    worker.join();
   }
 
   video_capture.release();
@@ -122,6 +239,166 @@ int cameracalibration::calibrate(const std::string& input_video,
     cv::destroyAllWindows();
   }
 
+  return true;
+}
+
+// Chooses up to max_keyframes informative board detections to calibrate with.
+// Frames are first chosen greedily to cover as much of the image with board
+// corners as possible, which constrains the distortion model, and then by
+// farthest-point sampling on where the board is in the image, its size, and
+// its in-plane rotation and foreshortening, which constrain the intrinsics.
+// Returns the chosen indices in frame order.
+static std::vector<size_t> select_keyframes(
+    const std::vector<BoardDetection>& detections, cv::Size frame_shape) {
+  std::vector<size_t> keyframes;
+  if (detections.size() <= max_keyframes) {
+    for (size_t i = 0; i < detections.size(); i++) {
+      keyframes.push_back(i);
+    }
+    return keyframes;
+  }
+
+  constexpr int grid_cols = 8;
+  constexpr int grid_rows = 6;
+  const double diagonal = std::hypot(frame_shape.width, frame_shape.height);
+
+  // Image grid cells each frame covers, and a pose descriptor for each frame
+  // from the affine fit of the board plane to the image
+  std::vector<std::vector<int>> frame_cells;
+  std::vector<Eigen::Matrix<double, 6, 1>> descriptors;
+  for (const auto& detection : detections) {
+    std::vector<int> cells;
+    Eigen::MatrixX3d A(detection.img_points.size(), 3);
+    Eigen::MatrixX2d b(detection.img_points.size(), 2);
+    double min_x = std::numeric_limits<double>::infinity();
+    double max_x = -min_x;
+    double min_y = min_x;
+    double max_y = -min_x;
+    for (size_t i = 0; i < detection.img_points.size(); i++) {
+      const auto& img_point = detection.img_points[i];
+      const auto& obj_point = detection.obj_points[i];
+
+      int col = std::clamp(
+          static_cast<int>(img_point.x * grid_cols / frame_shape.width), 0,
+          grid_cols - 1);
+      int row = std::clamp(
+          static_cast<int>(img_point.y * grid_rows / frame_shape.height), 0,
+          grid_rows - 1);
+      cells.push_back(row * grid_cols + col);
+
+      A.row(i) << obj_point.x, obj_point.y, 1.0;
+      b.row(i) << img_point.x, img_point.y;
+      min_x = std::min<double>(min_x, obj_point.x);
+      max_x = std::max<double>(max_x, obj_point.x);
+      min_y = std::min<double>(min_y, obj_point.y);
+      max_y = std::max<double>(max_y, obj_point.y);
+    }
+    std::sort(cells.begin(), cells.end());
+    cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+    frame_cells.push_back(std::move(cells));
+
+    // Image position of the board's center, and the image lengths of the
+    // detected part of the board's axes
+    Eigen::Matrix<double, 3, 2> affine = A.colPivHouseholderQr().solve(b);
+    Eigen::Vector2d center = affine.transpose() *
+                             Eigen::Vector3d{(min_x + max_x) / 2.0,
+                                             (min_y + max_y) / 2.0, 1.0};
+    Eigen::Matrix<double, 6, 1> descriptor;
+    descriptor << center.x() / frame_shape.width,
+        center.y() / frame_shape.height,
+        affine.row(0).transpose() * (max_x - min_x) / diagonal,
+        affine.row(1).transpose() * (max_y - min_y) / diagonal;
+    descriptors.push_back(descriptor);
+  }
+
+  std::vector<bool> selected(detections.size(), false);
+  auto select = [&](size_t i) {
+    selected[i] = true;
+    keyframes.push_back(i);
+  };
+
+  // Cover the image
+  std::vector<bool> covered(grid_cols * grid_rows, false);
+  while (keyframes.size() < max_keyframes) {
+    size_t best = 0;
+    int best_gain = 0;
+    for (size_t i = 0; i < detections.size(); i++) {
+      if (selected[i]) {
+        continue;
+      }
+      int gain = std::count_if(frame_cells[i].begin(), frame_cells[i].end(),
+                               [&](int cell) { return !covered[cell]; });
+      if (gain > best_gain) {
+        best = i;
+        best_gain = gain;
+      }
+    }
+    if (best_gain == 0) {
+      break;
+    }
+    for (int cell : frame_cells[best]) {
+      covered[cell] = true;
+    }
+    select(best);
+  }
+
+  // Add the frames least like any chosen so far
+  std::vector<double> distances(detections.size(),
+                                std::numeric_limits<double>::infinity());
+  for (size_t keyframe : keyframes) {
+    for (size_t i = 0; i < detections.size(); i++) {
+      distances[i] = std::min(
+          distances[i], (descriptors[i] - descriptors[keyframe]).norm());
+    }
+  }
+  while (keyframes.size() < max_keyframes) {
+    size_t best = 0;
+    double best_distance = -1.0;
+    for (size_t i = 0; i < detections.size(); i++) {
+      if (!selected[i] && distances[i] > best_distance) {
+        best = i;
+        best_distance = distances[i];
+      }
+    }
+    select(best);
+    for (size_t i = 0; i < detections.size(); i++) {
+      distances[i] =
+          std::min(distances[i], (descriptors[i] - descriptors[best]).norm());
+    }
+  }
+
+  std::sort(keyframes.begin(), keyframes.end());
+  return keyframes;
+}
+
+int cameracalibration::calibrate(const std::string& input_video,
+                                 CameraModel& camera_model, float square_width,
+                                 float marker_width, int board_width,
+                                 int board_height, bool show_debug_window) {
+  // ChArUco Board
+  cv::aruco::Dictionary aruco_dict =
+      cv::aruco::getPredefinedDictionary(cv::aruco::DICT_5X5_1000);
+  cv::Ptr<cv::aruco::CharucoBoard> charuco_board = new cv::aruco::CharucoBoard(
+      cv::Size(board_width, board_height), square_width * 0.0254,
+      marker_width * 0.0254, aruco_dict);
+
+  // Detect
+  cv::Size frame_shape;
+  std::vector<BoardDetection> detections;
+  if (!detect_boards(input_video, *charuco_board, board_width, board_height,
+                     show_debug_window, detections, frame_shape)) {
+    std::cout << "calibration failed" << std::endl;
+    return 1;
+  }
+
+  std::vector<std::vector<cv::Point3f>> all_obj_points;
+  std::vector<std::vector<cv::Point2f>> all_img_points;
+
+  for (size_t keyframe : select_keyframes(detections, frame_shape)) {
+    all_obj_points.push_back(std::move(detections[keyframe].obj_points));
+    all_img_points.push_back(std::move(detections[keyframe].img_points));
+  }
+
   // Calibrate
   cv::Mat camera_matrix, dist_coeffs;
   std::vector<cv::Mat> r_vecs, t_vecs;
@@ -164,11 +441,15 @@ int cameracalibration::calibrate(const std::string& input_video,
   cv::Ptr<cv::aruco::CharucoBoard> charuco_board = new cv::aruco::CharucoBoard(
       cv::Size(board_width, board_height), square_width * 0.0254,
       marker_width * 0.0254, aruco_dict);
-  cv::aruco::CharucoDetector charuco_detector(*charuco_board);
 
-  // Video capture
-  cv::VideoCapture video_capture(input_video);
+  // Detect
   cv::Size frame_shape;
+  std::vector<BoardDetection> detections;
+  if (!detect_boards(input_video, *charuco_board, board_width, board_height,
+                     show_debug_window, detections, frame_shape)) {
+    std::cout << "calibration failed" << std::endl;
+    return 1;
+  }
 
   // Detection output
   std::vector<mrcal_point3_t> observation_boards;
@@ -177,47 +458,15 @@ int cameracalibration::calibrate(const std::string& input_video,
   cv::Size boardSize(board_width - 1, board_height - 1);
   cv::Size imagerSize(imagerWidthPixels, imagerHeightPixels);
 
-  while (video_capture.grab()) {
-    cv::Mat frame;
-    video_capture.retrieve(frame);
-
-    cv::Mat debug_image = frame;
-
-    if (frame.empty()) {
-      break;
-    }
-
-    // Detect
-    cv::Mat frame_gray;
-    cv::cvtColor(frame, frame_gray, cv::COLOR_BGR2GRAY);
-
-    frame_shape = frame_gray.size();
-
-    std::vector<cv::Point2f> charuco_corners;
-    std::vector<int> charuco_ids;
-    std::vector<std::vector<cv::Point2f>> marker_corners;
-    std::vector<int> marker_ids;
-
-    std::vector<cv::Point3f> obj_points;
-    std::vector<cv::Point2f> img_points;
+  for (size_t keyframe : select_keyframes(detections, frame_shape)) {
+    const BoardDetection& detection = detections[keyframe];
 
     std::vector<mrcal_point3_t> points((board_width - 1) * (board_height - 1));
 
-    charuco_detector.detectBoard(frame_gray, charuco_corners, charuco_ids,
-                                 marker_corners, marker_ids);
-
-    if (!filter(charuco_corners, charuco_ids, marker_corners, marker_ids,
-                board_width, board_height)) {
-      continue;
-    }
-
-    charuco_board->matchImagePoints(charuco_corners, charuco_ids, obj_points,
-                                    img_points);
-
-    for (int i = 0; i < charuco_ids.size(); i++) {
-      int id = charuco_ids.at(i);
-      points[id].x = img_points.at(i).x;
-      points[id].y = img_points.at(i).y;
+    for (int i = 0; i < detection.charuco_ids.size(); i++) {
+      int id = detection.charuco_ids.at(i);
+      points[id].x = detection.img_points.at(i).x;
+      points[id].y = detection.img_points.at(i).y;
       points[id].z = 1.0f;
     }
 
@@ -233,21 +482,6 @@ int cameracalibration::calibrate(const std::string& input_video,
         getSeedPose(points.data(), boardSize, imagerSize, square_width, 1000));
     observation_boards.insert(observation_boards.end(), points.begin(),
                               points.end());
-
-    if (show_debug_window) {
-      cv::aruco::drawDetectedMarkers(debug_image, marker_corners, marker_ids);
-      cv::aruco::drawDetectedCornersCharuco(debug_image, charuco_corners,
-                                            charuco_ids);
-      cv::imshow("Frame", debug_image);
-      if (cv::waitKey(1) == 'q') {
-        break;
-      }
-    }
-  }
-
-  video_capture.release();
-  if (show_debug_window) {
-    cv::destroyAllWindows();
   }
 
   if (observation_boards.empty()) {
@@ -5,12 +5,17 @@
 #include "fieldcalibration.h"
 
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
 #include <filesystem>
 #include <fstream>
 #include <functional>
 #include <iostream>
 #include <map>
+#include <mutex>
+#include <span>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -311,118 +316,231 @@ inline void draw_tag_cube(cv::Mat& frame,
   }
 }
 
-inline bool process_video_file(
-    apriltag_detector_t* tag_detector,
+// Tag observations from one video frame
+struct FrameObservations {
+  std::vector<int> tag_ids;
+  std::vector<Constraint, Eigen::aligned_allocator<Constraint>> constraints;
+  cv::Mat debug_frame;
+};
+
+inline FrameObservations process_frame(
+    apriltag_detector_t* tag_detector, const cv::Mat& frame,
     const Eigen::Matrix<double, 3, 3>& camera_matrix,
     const Eigen::Matrix<double, 8, 1>& camera_distortion, double tag_size,
-    const std::string& path,
-    std::map<int, Pose, std::less<int>,
-             Eigen::aligned_allocator<std::pair<const int, Pose>>>& poses,
-    std::vector<Constraint, Eigen::aligned_allocator<Constraint>>& constraints,
     bool show_debug_window) {
+  FrameObservations observations;
+
+  // Convert color frame to grayscale frame
+  cv::Mat frame_gray;
+  cv::cvtColor(frame, frame_gray, cv::COLOR_BGR2GRAY);
+
+  // Clone color frame for debugging
   if (show_debug_window) {
-    cv::namedWindow("Processing Frame", cv::WINDOW_NORMAL);
+    observations.debug_frame = frame.clone();
   }
-  cv::VideoCapture video_input(path);
 
-  if (!video_input.isOpened()) {
-    std::cout << "Unable to open video " << path << std::endl;
-    return false;
+  // Detect tags
+  image_u8_t tag_image = {frame_gray.cols, frame_gray.rows, frame_gray.cols,
+                          frame_gray.data};
+  zarray_t* tag_detections = apriltag_detector_detect(tag_detector, &tag_image);
+
+  // Skip this frame if there are no tags detected
+  if (zarray_size(tag_detections) == 0) {
+    apriltag_detections_destroy(tag_detections);
+    return observations;
   }
 
-  cv::Mat frame;
-  cv::Mat frame_gray;
-  cv::Mat frame_debug;
+  // Find detection with the smallest tag ID
+  apriltag_detection_t* tag_detection_min = nullptr;
+  zarray_get(tag_detections, 0, &tag_detection_min);
 
-  int frame_num = 0;
+  for (int i = 0; i < zarray_size(tag_detections); i++) {
+    apriltag_detection_t* tag_detection_i;
+    zarray_get(tag_detections, i, &tag_detection_i);
 
-  while (video_input.read(frame)) {
-    std::cout << "Processing " << path << " - Frame " << frame_num++
-              << std::endl;
+    if (tag_detection_i->id < tag_detection_min->id) {
+      tag_detection_min = tag_detection_i;
+    }
+  }
 
-    // Convert color frame to grayscale frame
-    cv::cvtColor(frame, frame_gray, cv::COLOR_BGR2GRAY);
+  Eigen::Matrix<double, 4, 4> camera_to_tag_min = estimate_tag_pose(
+      tag_detection_min, camera_matrix, camera_distortion, tag_size);
 
-    // Clone color frame for debugging
-    frame_debug = frame.clone();
+  // Find transformation from smallest tag ID
+  for (int i = 0; i < zarray_size(tag_detections); i++) {
+    apriltag_detection_t* tag_detection_i;
+    zarray_get(tag_detections, i, &tag_detection_i);
 
-    // Detect tags
-    image_u8_t tag_image = {frame_gray.cols, frame_gray.rows, frame_gray.cols,
-                            frame_gray.data};
-    zarray_t* tag_detections =
-        apriltag_detector_detect(tag_detector, &tag_image);
+    observations.tag_ids.push_back(tag_detection_i->id);
 
-    // Skip this loop if there are no tags detected
-    if (zarray_size(tag_detections) == 0) {
-      std::cout << "No tags detected" << std::endl;
+    // Estimate camera to tag pose
+    Eigen::Matrix<double, 4, 4> caamera_to_tag = estimate_tag_pose(
+        tag_detection_i, camera_matrix, camera_distortion, tag_size);
+
+    // Draw debug cube
+    if (show_debug_window) {
+      draw_tag_cube(observations.debug_frame, caamera_to_tag, camera_matrix,
+                    camera_distortion, tag_size);
+    }
+
+    // Skip finding transformation from smallest tag ID to itself
+    if (tag_detection_i->id == tag_detection_min->id) {
       continue;
     }
 
-    // Find detection with the smallest tag ID
-    apriltag_detection_t* tag_detection_min = nullptr;
-    zarray_get(tag_detections, 0, &tag_detection_min);
+    Eigen::Matrix<double, 4, 4> tag_min_to_tag =
+        camera_to_tag_min.inverse() * caamera_to_tag;
 
-    for (int i = 0; i < zarray_size(tag_detections); i++) {
-      apriltag_detection_t* tag_detection_i;
-      zarray_get(tag_detections, i, &tag_detection_i);
+    // Constraint
+    Constraint constraint;
+    constraint.id_begin = tag_detection_min->id;
+    constraint.id_end = tag_detection_i->id;
+    constraint.t_begin_end.p = tag_min_to_tag.block<3, 1>(0, 3);
+    constraint.t_begin_end.q =
+        Eigen::Quaterniond(tag_min_to_tag.block<3, 3>(0, 0));
 
-      if (tag_detection_i->id < tag_detection_min->id) {
-        tag_detection_min = tag_detection_i;
-      }
-    }
+    observations.constraints.push_back(constraint);
+  }
 
-    Eigen::Matrix<double, 4, 4> camera_to_tag_min = estimate_tag_pose(
-        tag_detection_min, camera_matrix, camera_distortion, tag_size);
+  apriltag_detections_destroy(tag_detections);
+
+  return observations;
+}
+
+// Decodes a video on one thread while the frames are processed on a thread per
+// tag detector. Each frame's observations are merged in frame order, so the
+// results don't depend on thread timing.
+inline bool process_video_file(
+    std::span<apriltag_detector_t* const> tag_detectors,
+    const Eigen::Matrix<double, 3, 3>& camera_matrix,
+    const Eigen::Matrix<double, 8, 1>& camera_distortion, double tag_size,
+    const std::string& path,
+    std::map<int, Pose, std::less<int>,
+             Eigen::aligned_allocator<std::pair<const int, Pose>>>& poses,
+    std::vector<Constraint, Eigen::aligned_allocator<Constraint>>& constraints,
+    bool show_debug_window) {
+  if (show_debug_window) {
+    cv::namedWindow("Processing Frame", cv::WINDOW_NORMAL);
+  }
+  cv::VideoCapture video_input(path);
 
-    // Find transformation from smallest tag ID
-    for (int i = 0; i < zarray_size(tag_detections); i++) {
-      apriltag_detection_t* tag_detection_i;
-      zarray_get(tag_detections, i, &tag_detection_i);
+  if (!video_input.isOpened()) {
+    std::cout << "Unable to open video " << path << std::endl;
+    return false;
+  }
 
-      // Add tag ID to poses
-      if (poses.find(tag_detection_i->id) == poses.end()) {
-        poses[tag_detection_i->id] = {Eigen::Vector3d(0.0, 0.0, 0.0),
-                                      Eigen::Quaterniond(1.0, 0.0, 0.0, 0.0)};
+  // Limits how many frames are decoded ahead of merging
+  const size_t max_pending_frames = 2 * tag_detectors.size();
+
+  std::mutex mutex;
+  std::condition_variable frame_decoded;
+  std::condition_variable frame_merged;
+  std::condition_variable frame_processed;
+  std::deque<std::pair<int, cv::Mat>> decoded_frames;
+  std::map<int, FrameObservations> processed_frames;
+  bool decoding_done = false;
+  int frame_count = 0;
+
+  std::thread decoder{[&] {
+    int frame_num = 0;
+    while (true) {
+      cv::Mat frame;
+      if (!video_input.read(frame)) {
+        break;
       }
 
-      // Estimate camera to tag pose
-      Eigen::Matrix<double, 4, 4> caamera_to_tag = estimate_tag_pose(
-          tag_detection_i, camera_matrix, camera_distortion, tag_size);
+      std::unique_lock lock{mutex};
+      frame_merged.wait(lock, [&] {
+        return decoded_frames.size() + processed_frames.size() <
+               max_pending_frames;
+      });
+      decoded_frames.emplace_back(frame_num++, std::move(frame));
+      frame_decoded.notify_one();
+    }
+
+    std::scoped_lock lock{mutex};
+    decoding_done = true;
+    frame_count = frame_num;
+    frame_decoded.notify_all();
+    frame_processed.notify_all();
+  }};
+
+  std::vector<std::thread> workers;
+  for (apriltag_detector_t* tag_detector : tag_detectors) {
+    workers.emplace_back([&, tag_detector] {
+      while (true) {
+        std::pair<int, cv::Mat> frame;
+        {
+          std::unique_lock lock{mutex};
+          frame_decoded.wait(
+              lock, [&] { return !decoded_frames.empty() || decoding_done; });
+          if (decoded_frames.empty()) {
+            return;
+          }
+          frame = std::move(decoded_frames.front());
+          decoded_frames.pop_front();
+        }
 
-      // Draw debug cube
-      if (show_debug_window) {
-        draw_tag_cube(frame_debug, caamera_to_tag, camera_matrix,
-                      camera_distortion, tag_size);
+        FrameObservations observations =
+            process_frame(tag_detector, frame.second, camera_matrix,
+                          camera_distortion, tag_size, show_debug_window);
+
+        std::scoped_lock lock{mutex};
+        processed_frames.emplace(frame.first, std::move(observations));
+        frame_processed.notify_all();
       }
+    });
+  }
 
-      // Skip finding transformation from smallest tag ID to itself
-      if (tag_detection_i->id == tag_detection_min->id) {
-        continue;
+  // Merge observations in frame order
+  for (int frame_num = 0;; frame_num++) {
+    FrameObservations observations;
+    {
+      std::unique_lock lock{mutex};
+      frame_processed.wait(lock, [&] {
+        return processed_frames.contains(frame_num) ||
+               (decoding_done && frame_num >= frame_count);
+      });
+      auto it = processed_frames.find(frame_num);
+      if (it == processed_frames.end()) {
+        break;
       }
+      observations = std::move(it->second);
+      processed_frames.erase(it);
+    }
+    frame_merged.notify_one();
 
-      Eigen::Matrix<double, 4, 4> tag_min_to_tag =
-          camera_to_tag_min.inverse() * caamera_to_tag;
+    std::cout << "Processing " << path << " - Frame " << frame_num
+              << std::endl;
 
-      // Constraint
-      Constraint constraint;
-      constraint.id_begin = tag_detection_min->id;
-      constraint.id_end = tag_detection_i->id;
-      constraint.t_begin_end.p = tag_min_to_tag.block<3, 1>(0, 3);
-      constraint.t_begin_end.q =
-          Eigen::Quaterniond(tag_min_to_tag.block<3, 3>(0, 0));
+    if (observations.tag_ids.empty()) {
+      std::cout << "No tags detected" << std::endl;
+      continue;
+    }
 
-      constraints.push_back(constraint);
+    // Add tag IDs to poses
+    for (int tag_id : observations.tag_ids) {
+      if (poses.find(tag_id) == poses.end()) {
+        poses[tag_id] = {Eigen::Vector3d(0.0, 0.0, 0.0),
+                         Eigen::Quaterniond(1.0, 0.0, 0.0, 0.0)};
+      }
     }
 
-    apriltag_detections_destroy(tag_detections);
+    constraints.insert(constraints.end(), observations.constraints.begin(),
+                       observations.constraints.end());
 
     // Show debug
     if (show_debug_window) {
-      cv::imshow("Processing Frame", frame_debug);
+      cv::imshow("Processing Frame", observations.debug_frame);
       cv::waitKey(1);
     }
   }
 
+  decoder.join();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
   video_input.release();
   if (show_debug_window) {
     cv::destroyAllWindows();
@@ -431,6 +549,45 @@ inline bool process_video_file(
   return true;
 }
 
+// AprilTag detectors for processing frames in parallel, one per thread since a
+// detector can only process one frame at a time
+class TagDetectorPool {
+ public:
+  explicit TagDetectorPool(int size) {
+    for (int i = 0; i < size; i++) {
+      // Each detector needs its own family, as adding a family to a detector
+      // builds its decode table in the family
+      apriltag_family_t* tag_family = tag36h11_create();
+      apriltag_detector_t* tag_detector = apriltag_detector_create();
+      tag_detector->nthreads = 1;
+      apriltag_detector_add_family(tag_detector, tag_family);
+
+      m_tag_families.push_back(tag_family);
+      m_tag_detectors.push_back(tag_detector);
+    }
+  }
+
+  ~TagDetectorPool() {
+    for (apriltag_detector_t* tag_detector : m_tag_detectors) {
+      apriltag_detector_destroy(tag_detector);
+    }
+    for (apriltag_family_t* tag_family : m_tag_families) {
+      tag36h11_destroy(tag_family);
+    }
+  }
+
+  TagDetectorPool(const TagDetectorPool&) = delete;
+  TagDetectorPool& operator=(const TagDetectorPool&) = delete;
+
+  std::span<apriltag_detector_t* const> detectors() const {
+    return m_tag_detectors;
+  }
+
+ private:
+  std::vector<apriltag_family_t*> m_tag_families;
+  std::vector<apriltag_detector_t*> m_tag_detectors;
+};
+
 int fieldcalibration::calibrate(std::string input_dir_path,
                                 wpi::json& output_json,
                                 std::string camera_model_path,
@@ -478,12 +635,9 @@ int fieldcalibration::calibrate(std::string input_dir_path,
     return 1;
   }
 
-  // Apriltag detector
-  apriltag_detector_t* tag_detector = apriltag_detector_create();
-  tag_detector->nthreads = 8;
-
-  apriltag_family_t* tag_family = tag36h11_create();
-  apriltag_detector_add_family(tag_detector, tag_family);
+  // Apriltag detectors, one per frame processing thread
+  TagDetectorPool tag_detectors{
+      std::max(static_cast<int>(std::thread::hardware_concurrency()), 1)};
 
   // Find tag poses
   std::map<int, Pose, std::less<int>,
@@ -499,9 +653,9 @@ int fieldcalibration::calibrate(std::string input_dir_path,
 
     const std::string path = entry.path().string();
 
-    bool success = process_video_file(tag_detector, camera_matrix,
-                                      camera_distortion, tagSizeMeters, path,
-                                      poses, constraints, show_debug_window);
+    bool success = process_video_file(
+        tag_detectors.detectors(), camera_matrix, camera_distortion,
+        tagSizeMeters, path, poses, constraints, show_debug_window);
 
     if (!success) {
       std::cout << "Unable to process video " << path << std::endl;
@@ -106,6 +106,8 @@ static void IniReadLine(ImGuiContext* ctx, ImGuiSettingsHandler* handler,
     impl->defaultFontName = &lineStr[5];
   } else if (std::strncmp(lineStr, "fps=", 4) == 0) {
     impl->fps = num;
+  } else if (std::strncmp(lineStr, "idleFps=", 8) == 0) {
+    impl->idleFps = num;
   }
 }
 
@@ -116,10 +118,11 @@ static void IniWriteAll(ImGuiContext* ctx, ImGuiSettingsHandler* handler,
   }
   out_buf->appendf(
       "[MainWindow][GLOBAL]\nwidth=%d\nheight=%d\nmaximized=%d\n"
-      "xpos=%d\nypos=%d\nuserScale=%d\nstyle=%d\nfont=%s\nfps=%d\n\n",
+      "xpos=%d\nypos=%d\nuserScale=%d\nstyle=%d\nfont=%s\nfps=%d\n"
+      "idleFps=%d\n\n",
       gContext->width, gContext->height, gContext->maximized ? 1 : 0,
       gContext->xPos, gContext->yPos, gContext->userScale, gContext->style,
-      gContext->defaultFontName.c_str(), gContext->fps);
+      gContext->defaultFontName.c_str(), gContext->fps, gContext->idleFps);
 }
 
 void gui::CreateContext() {
@@ -384,13 +387,28 @@ bool gui::Initialize(const char* title, int width, int height,
   return true;
 }
 
+// How long to keep rendering at the full frame rate after input or Wake()
+static constexpr double kActiveTime = 1.0;
+
 void gui::Main() {
   // Main loop
   while (!glfwWindowShouldClose(gContext->window) && !gContext->exit) {
     double startTime = glfwGetTime();
 
-    // Poll and handle events (inputs, window resize, etc.)
-    glfwPollEvents();
+    // Poll and handle events (inputs, window resize, etc.). If idle, wait for
+    // an event instead, rendering a frame at least at the idle frame rate.
+    if (gContext->idleFps != 0 &&
+        startTime - gContext->lastActiveTime > kActiveTime) {
+      glfwWaitEventsTimeout(1.0 / gContext->idleFps);
+      startTime = glfwGetTime();
+    } else {
+      glfwPollEvents();
+    }
+    if (gContext->wake.exchange(false) ||
+        !ImGui::GetCurrentContext()->InputEventsQueue.empty()) {
+      gContext->lastActiveTime = startTime;
+    }
+
     gContext->isPlatformRendering = true;
     UpdateFontScale();
     if (gContext->reloadFonts) {
@@ -644,6 +662,20 @@ void gui::SetFPS(int fps) {
   gContext->fps = fps;
 }
 
+void gui::SetIdleFPS(int fps) {
+  gContext->idleFps = fps;
+}
+
+void gui::Wake() {
+  if (!gContext) {
+    return;
+  }
+  // only need to post one event to wake the main loop per frame
+  if (!gContext->wake.exchange(true) && gContext->window) {
+    glfwPostEmptyEvent();
+  }
+}
+
 void gui::SetClearColor(ImVec4 color) {
   gContext->clearColor = color;
 }
@@ -742,6 +774,27 @@ void gui::EmitViewMenu() {
       ImGui::EndMenu();
     }
 
+    if (ImGui::BeginMenu("Idle Frame Rate")) {
+      bool selected;
+      selected = gContext->idleFps == 0;
+      if (ImGui::MenuItem("disabled", nullptr, &selected)) {
+        gContext->idleFps = 0;
+      }
+      selected = gContext->idleFps == 1;
+      if (ImGui::MenuItem("1 fps", nullptr, &selected)) {
+        gContext->idleFps = 1;
+      }
+      selected = gContext->idleFps == 5;
+      if (ImGui::MenuItem("5 fps", nullptr, &selected)) {
+        gContext->idleFps = 5;
+      }
+      selected = gContext->idleFps == 10;
+      if (ImGui::MenuItem("10 fps", nullptr, &selected)) {
+        gContext->idleFps = 10;
+      }
+      ImGui::EndMenu();
+    }
+
     if (!gContext->saveSettings) {
       ImGui::MenuItem("Reset UI on Exit?", nullptr, &gContext->resetOnExit);
     }
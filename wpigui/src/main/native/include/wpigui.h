@@ -184,6 +184,22 @@ void SetStyle(Style style);
  */
 void SetFPS(int fps);
 
+/**
+ * Sets the idle frame rate.  When enabled, the main loop waits for input or
+ * Wake() instead of continuously rendering, and only renders at this rate
+ * while idle.  Using this function makes this setting persistent.
+ *
+ * @param fps idle FPS (0=disabled, always render at the FPS limit)
+ */
+void SetIdleFPS(int fps);
+
+/**
+ * Wakes the main loop if it's idle so it renders at the full frame rate for
+ * a short time.  This should be called when displayed data changes.  Can be
+ * called from any thread.
+ */
+void Wake();
+
 /**
  * Sets the clear (background) color.
  *
@@ -25,6 +25,7 @@ struct SavedSettings {
   int userScale = 2;
   int style = 0;
   int fps = 120;
+  int idleFps = 0;
   std::string defaultFontName = "Proggy Dotted";
 };
 
@@ -32,6 +33,8 @@ constexpr int kFontScaledLevels = 9;
 
 struct Context : public SavedSettings {
   std::atomic_bool exit{false};
+  std::atomic_bool wake{false};
+  double lastActiveTime = 0;  // updated by main loop
 
   std::string title;
   int defaultWidth;
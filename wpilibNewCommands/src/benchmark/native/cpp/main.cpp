@@ -0,0 +1,290 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+// Scalability benchmarks for CommandScheduler::Run().  Each case builds a
+// robot with a number of subsystems (each with a default command), trigger
+// bindings that periodically take over those subsystems, and a deeply nested
+// composition of sequential and deadline groups that runs repeatedly, then
+// runs the scheduler loop.  For each case, reports the mean and 99th
+// percentile time per Run(), the number of heap allocations per Run()
+// (counted by replacing the global operator new), and the scheduling latency:
+// the time from the start of Run() until a command bound to a trigger that
+// just became true is initialized.
+//
+// Usage: wpilibNewCommandsBenchmark [--quick] [filter]
+//
+// Only cases whose name contains the filter are run.  --quick runs each case
+// for less time.
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <frc/simulation/DriverStationSim.h>
+#include <hal/HALBase.h>
+#include <wpi/print.h>
+
+#include "frc2/command/CommandScheduler.h"
+#include "frc2/command/Commands.h"
+#include "frc2/command/FunctionalCommand.h"
+#include "frc2/command/SubsystemBase.h"
+#include "frc2/command/button/Trigger.h"
+
+static std::atomic<uint64_t> gAllocations{0};
+
+// GCC 11+ sees free() on a pointer from the (inlined) replacement operator
+// new and flags it as mismatched, even though both sides are ours.
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(size_t size) {
+  gAllocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+  std::free(p);
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct RobotConfig {
+  std::string_view name;
+  // number of subsystems, each with a default command
+  int subsystems;
+  // number of trigger bindings
+  int bindings;
+  // nesting depth of the repeating composition
+  int depth;
+  // scheduler worker threads; all subsystems are parallel if nonzero
+  int threads = 0;
+};
+
+class BenchSubsystem : public frc2::SubsystemBase {
+ public:
+  void Periodic() override { ++m_periodic; }
+
+  uint64_t m_periodic = 0;
+  uint64_t m_output = 0;
+};
+
+// State shared by the commands of a robot
+struct RobotState {
+  uint64_t cycle = 0;
+  Clock::time_point runStart;
+  std::vector<double> latencies;
+};
+
+// A requirement-free command that finishes after the given number of cycles
+frc2::CommandPtr Leaf(int cycles) {
+  auto count = std::make_shared<int>(0);
+  return frc2::FunctionalCommand(
+             [count] { *count = 0; }, [count] { ++*count; },
+             [](bool) {}, [count, cycles] { return *count >= cycles; })
+      .ToPtr();
+}
+
+// Builds a composition nested depth levels deep.  Each level is a sequence of
+// a deadline group (whose deadline is the next level down) and a leaf.
+frc2::CommandPtr Composition(int depth) {
+  if (depth == 0) {
+    return Leaf(3);
+  }
+  return frc2::cmd::Sequence(
+      frc2::cmd::Deadline(Composition(depth - 1), Leaf(2), Leaf(depth + 5)),
+      Leaf(1));
+}
+
+class Robot {
+ public:
+  explicit Robot(const RobotConfig& config) {
+    auto& scheduler = frc2::CommandScheduler::GetInstance();
+    auto loop = scheduler.GetActiveButtonLoop();
+
+    m_subsystems.reserve(config.subsystems);
+    for (int i = 0; i < config.subsystems; ++i) {
+      auto subsystem = std::make_unique<BenchSubsystem>();
+      auto s = subsystem.get();
+      s->SetDefaultCommand(s->Run([s] { ++s->m_output; }));
+      if (config.threads != 0) {
+        scheduler.SetParallel(s);
+      }
+      m_subsystems.emplace_back(std::move(subsystem));
+    }
+
+    // Each binding is active for a quarter of every 64 cycles, with the
+    // phases staggered so that commands are continually started, interrupted
+    // and ended.  Odd bindings take over a subsystem from its default
+    // command; even ones have no requirements.
+    for (int i = 0; i < config.bindings; ++i) {
+      uint64_t phase = i * 7;
+      frc2::Trigger trigger{loop, [this, phase] {
+                              return ((m_state.cycle + phase) % 64) < 16;
+                            }};
+      if (i % 2 == 1 && !m_subsystems.empty()) {
+        auto s = m_subsystems[i % m_subsystems.size()].get();
+        trigger.WhileTrue(s->Run([s] { s->m_output += 2; }));
+      } else {
+        trigger.WhileTrue(Leaf(8));
+      }
+    }
+
+    // Bound last, so the latency includes polling the other bindings
+    frc2::Trigger{loop, [this] {
+                    return m_state.cycle % 10 == 0;
+                  }}.OnTrue(frc2::cmd::RunOnce([this] {
+      m_state.latencies.push_back(
+          std::chrono::duration<double, std::micro>(Clock::now() -
+                                                    m_state.runStart)
+              .count());
+    }));
+
+    m_composition = Composition(config.depth).Repeatedly();
+    scheduler.Schedule(m_composition);
+  }
+
+  ~Robot() {
+    auto& scheduler = frc2::CommandScheduler::GetInstance();
+    scheduler.CancelAll();
+    scheduler.GetActiveButtonLoop()->Clear();
+    scheduler.UnregisterAllSubsystems();
+  }
+
+  Robot(const Robot&) = delete;
+  Robot& operator=(const Robot&) = delete;
+
+  RobotState m_state;
+
+ private:
+  std::vector<std::unique_ptr<BenchSubsystem>> m_subsystems;
+  frc2::CommandPtr m_composition = frc2::cmd::None();
+};
+
+double Percentile(std::vector<double>& values, double p) {
+  if (values.empty()) {
+    return 0;
+  }
+  auto n = static_cast<size_t>(p * (values.size() - 1));
+  std::nth_element(values.begin(), values.begin() + n, values.end());
+  return values[n];
+}
+
+double Mean(const std::vector<double>& values) {
+  if (values.empty()) {
+    return 0;
+  }
+  double sum = 0;
+  for (double value : values) {
+    sum += value;
+  }
+  return sum / values.size();
+}
+
+// Runs the scheduler for about minTime and prints the statistics
+void Run(const RobotConfig& config, std::chrono::duration<double> minTime) {
+  auto& scheduler = frc2::CommandScheduler::GetInstance();
+  scheduler.SetParallelThreads(config.threads);
+
+  Robot robot{config};
+  auto& state = robot.m_state;
+
+  // warm up, so that every binding and composition level has run
+  for (int i = 0; i < 256; ++i) {
+    ++state.cycle;
+    state.runStart = Clock::now();
+    scheduler.Run();
+  }
+
+  std::vector<double> times;
+  times.reserve(1 << 16);
+  state.latencies.clear();
+  state.latencies.reserve(1 << 14);
+
+  uint64_t allocations = 0;
+  auto start = Clock::now();
+  do {
+    ++state.cycle;
+    uint64_t before = gAllocations.load(std::memory_order_relaxed);
+    state.runStart = Clock::now();
+    scheduler.Run();
+    auto end = Clock::now();
+    allocations += gAllocations.load(std::memory_order_relaxed) - before;
+    times.push_back(
+        std::chrono::duration<double, std::micro>(end - state.runStart)
+            .count());
+  } while (Clock::now() - start < minTime && times.size() < (1 << 16));
+
+  double mean = Mean(times);
+  double p99 = Percentile(times, 0.99);
+  double latency = Percentile(state.latencies, 0.5);
+  double latencyP99 = Percentile(state.latencies, 0.99);
+  wpi::print("{:<32} {:>10.2f} {:>10.2f} {:>10.2f} {:>10.2f} {:>10.2f}\n",
+             config.name, mean, p99,
+             static_cast<double>(allocations) / times.size(), latency,
+             latencyP99);
+
+  scheduler.SetParallelThreads(0);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::chrono::duration<double> minTime = std::chrono::seconds{2};
+  std::string_view filter;
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg{argv[i]};
+    if (arg == "--quick") {
+      minTime = std::chrono::milliseconds{200};
+    } else {
+      filter = arg;
+    }
+  }
+
+  HAL_Initialize(500, 0);
+  frc::sim::DriverStationSim::SetDsAttached(true);
+  frc::sim::DriverStationSim::SetEnabled(true);
+  frc::sim::DriverStationSim::NotifyNewData();
+
+  static const RobotConfig kConfigs[] = {
+      {"Run/4 subsystems, 8 bindings", 4, 8, 2},
+      {"Run/8 subsystems, 32 bindings", 8, 32, 4},
+      {"Run/16 subsystems, 64 bindings", 16, 64, 8},
+      {"Run/32 subsystems, 256 bindings", 32, 256, 16},
+      {"Run/deep composition", 4, 8, 64},
+      {"Run/many bindings", 8, 1024, 4},
+      {"Run/parallel 16 subsystems", 16, 64, 8, 2},
+  };
+
+  wpi::print("{:<32} {:>10} {:>10} {:>10} {:>10} {:>10}\n", "benchmark",
+             "us/run", "p99 us", "allocs", "lat us", "p99 lat");
+  for (auto&& config : kConfigs) {
+    if (config.name.find(filter) == std::string_view::npos) {
+      continue;
+    }
+    Run(config, minTime);
+  }
+}
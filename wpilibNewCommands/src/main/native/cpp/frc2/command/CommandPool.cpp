@@ -0,0 +1,139 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc2/command/CommandPool.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include <wpi/mutex.h>
+
+using namespace frc2;
+
+namespace {
+// Pooled sizes are rounded up to a multiple of this, which is also the
+// alignment of every block.
+constexpr size_t kGranularity = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+constexpr size_t kNumClasses = CommandPool::kMaxPooledSize / kGranularity;
+
+struct FreeBlock {
+  FreeBlock* next;
+};
+
+struct Pool {
+  wpi::mutex mutex;
+  std::array<FreeBlock*, kNumClasses> freeLists{};
+  std::vector<std::unique_ptr<std::byte[]>> chunks;
+  // unused part of the current chunk
+  std::byte* chunkPos = nullptr;
+  size_t chunkLeft = 0;
+  // chunks at the end of the list that haven't been used yet
+  size_t reservedChunks = 0;
+  CommandPool::Statistics stats;
+
+  void NextChunk();
+};
+}  // namespace
+
+static Pool& GetPool() {
+  // never destroyed, as static commands may be destroyed after it would be
+  static Pool* pool = new Pool;
+  return *pool;
+}
+
+static size_t GetClass(size_t size) {
+  return (size + kGranularity - 1) / kGranularity - 1;
+}
+
+void Pool::NextChunk() {
+  // put the rest of the current chunk on the free lists
+  while (chunkLeft >= kGranularity) {
+    size_t sizeClass =
+        GetClass(std::min(chunkLeft, CommandPool::kMaxPooledSize));
+    auto block = reinterpret_cast<FreeBlock*>(chunkPos);
+    block->next = freeLists[sizeClass];
+    freeLists[sizeClass] = block;
+    chunkPos += (sizeClass + 1) * kGranularity;
+    chunkLeft -= (sizeClass + 1) * kGranularity;
+  }
+
+  if (reservedChunks > 0) {
+    chunkPos = chunks[chunks.size() - reservedChunks].get();
+    --reservedChunks;
+  } else {
+    chunks.emplace_back(new std::byte[CommandPool::kChunkSize]);
+    chunkPos = chunks.back().get();
+    stats.chunkBytes += CommandPool::kChunkSize;
+    ++stats.chunkAllocations;
+  }
+  chunkLeft = CommandPool::kChunkSize;
+}
+
+void* CommandPool::Allocate(size_t size) {
+  auto& pool = GetPool();
+  if (size > kMaxPooledSize) {
+    {
+      std::scoped_lock lock{pool.mutex};
+      ++pool.stats.largeAllocations;
+    }
+    return ::operator new(size);
+  }
+
+  size_t sizeClass = GetClass(size);
+  size_t blockSize = (sizeClass + 1) * kGranularity;
+  std::scoped_lock lock{pool.mutex};
+  ++pool.stats.liveCommands;
+  if (FreeBlock* block = pool.freeLists[sizeClass]) {
+    pool.freeLists[sizeClass] = block->next;
+    return block;
+  }
+  if (pool.chunkLeft < blockSize) {
+    pool.NextChunk();
+  }
+  void* ptr = pool.chunkPos;
+  pool.chunkPos += blockSize;
+  pool.chunkLeft -= blockSize;
+  return ptr;
+}
+
+void CommandPool::Free(void* ptr, size_t size) {
+  if (!ptr) {
+    return;
+  }
+  if (size > kMaxPooledSize) {
+    ::operator delete(ptr, size);
+    return;
+  }
+
+  auto& pool = GetPool();
+  size_t sizeClass = GetClass(size);
+  auto block = static_cast<FreeBlock*>(ptr);
+  std::scoped_lock lock{pool.mutex};
+  block->next = pool.freeLists[sizeClass];
+  pool.freeLists[sizeClass] = block;
+  --pool.stats.liveCommands;
+}
+
+void CommandPool::Reserve(size_t bytes) {
+  auto& pool = GetPool();
+  std::scoped_lock lock{pool.mutex};
+  size_t available = pool.chunkLeft + pool.reservedChunks * kChunkSize;
+  while (available < bytes) {
+    pool.chunks.emplace_back(new std::byte[kChunkSize]);
+    ++pool.reservedChunks;
+    pool.stats.chunkBytes += kChunkSize;
+    ++pool.stats.chunkAllocations;
+    available += kChunkSize;
+  }
+}
+
+CommandPool::Statistics CommandPool::GetStatistics() {
+  auto& pool = GetPool();
+  std::scoped_lock lock{pool.mutex};
+  return pool.stats;
+}
@@ -4,12 +4,18 @@
 
 #include "frc2/command/CommandScheduler.h"
 
+#include <algorithm>
+#include <atomic>
+#include <bit>
 #include <cstdio>
+#include <exception>
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
+#include <fmt/format.h>
 #include <frc/RobotBase.h>
 #include <frc/RobotState.h>
 #include <frc/TimedRobot.h>
@@ -20,27 +26,296 @@
 #include <networktables/StringArrayTopic.h>
 #include <wpi/DenseMap.h>
 #include <wpi/SmallVector.h>
+#include <wpi/DataLog.h>
+#include <wpi/condition_variable.h>
+#include <wpi/function_ref.h>
+#include <wpi/mutex.h>
 #include <wpi/sendable/SendableBuilder.h>
 #include <wpi/sendable/SendableRegistry.h>
+#include <wpi/timestamp.h>
 
 #include "frc2/command/CommandPtr.h"
 #include "frc2/command/Subsystem.h"
 
 using namespace frc2;
 
+namespace {
+// Runs batches of tasks on a fixed set of worker threads. Idle threads claim
+// the next unstarted task, and the calling thread takes tasks too.
+class ParallelRunner {
+ public:
+  ~ParallelRunner() { SetThreads(0); }
+
+  void SetThreads(int threads);
+
+  // Calls task(i) for every i in [0, count) and waits for all of them to
+  // finish. Rethrows the first exception thrown by a task.
+  void Run(size_t count, wpi::function_ref<void(size_t)> task);
+
+ private:
+  struct Batch {
+    wpi::function_ref<void(size_t)> task;
+    size_t count;
+    std::atomic<size_t> next{0};
+    std::exception_ptr error = nullptr;
+  };
+
+  void ThreadMain();
+  void Work(Batch& batch);
+
+  wpi::mutex m_mutex;
+  wpi::condition_variable m_startCond;
+  wpi::condition_variable m_doneCond;
+  std::vector<std::thread> m_threads;
+  Batch* m_batch = nullptr;
+  uint64_t m_generation = 0;
+  int m_busy = 0;
+  bool m_stop = false;
+};
+}  // namespace
+
+void ParallelRunner::SetThreads(int threads) {
+  {
+    std::scoped_lock lock{m_mutex};
+    m_stop = true;
+  }
+  m_startCond.notify_all();
+  for (auto&& thread : m_threads) {
+    thread.join();
+  }
+  m_threads.clear();
+  m_stop = false;
+  for (int i = 0; i < threads; ++i) {
+    m_threads.emplace_back([this] { ThreadMain(); });
+  }
+}
+
+void ParallelRunner::Run(size_t count, wpi::function_ref<void(size_t)> task) {
+  if (m_threads.empty() || count <= 1) {
+    for (size_t i = 0; i < count; ++i) {
+      task(i);
+    }
+    return;
+  }
+
+  Batch batch{task, count};
+  {
+    std::scoped_lock lock{m_mutex};
+    m_batch = &batch;
+    ++m_generation;
+  }
+  m_startCond.notify_all();
+  Work(batch);
+
+  // every task has been claimed; wait for the workers still running one
+  std::unique_lock lock{m_mutex};
+  m_doneCond.wait(lock, [&] { return m_busy == 0; });
+  m_batch = nullptr;
+  if (batch.error) {
+    std::rethrow_exception(batch.error);
+  }
+}
+
+void ParallelRunner::ThreadMain() {
+  uint64_t generation = 0;
+  std::unique_lock lock{m_mutex};
+  for (;;) {
+    m_startCond.wait(lock,
+                     [&] { return m_stop || m_generation != generation; });
+    if (m_stop) {
+      return;
+    }
+    generation = m_generation;
+    Batch* batch = m_batch;
+    if (!batch) {
+      continue;
+    }
+    ++m_busy;
+    lock.unlock();
+    Work(*batch);
+    lock.lock();
+    if (--m_busy == 0) {
+      m_doneCond.notify_all();
+    }
+  }
+}
+
+void ParallelRunner::Work(Batch& batch) {
+  for (;;) {
+    size_t i = batch.next.fetch_add(1, std::memory_order_relaxed);
+    if (i >= batch.count) {
+      return;
+    }
+    try {
+      batch.task(i);
+    } catch (...) {
+      std::scoped_lock lock{m_mutex};
+      if (!batch.error) {
+        batch.error = std::current_exception();
+      }
+    }
+  }
+}
+
+// A set of subsystem indices.
+class RequirementMask {
+ public:
+  void Set(size_t index) {
+    if (index / 64 >= m_words.size()) {
+      m_words.resize(index / 64 + 1);
+    }
+    m_words[index / 64] |= uint64_t{1} << (index % 64);
+  }
+
+  void Reset(size_t index) {
+    if (index / 64 < m_words.size()) {
+      m_words[index / 64] &= ~(uint64_t{1} << (index % 64));
+    }
+  }
+
+  // Calls func(index) for every index in both this and other. func may reset
+  // indices in this mask.
+  template <typename F>
+  void ForEachCommon(const RequirementMask& other, F&& func) const {
+    size_t size = std::min(m_words.size(), other.m_words.size());
+    for (size_t i = 0; i < size; ++i) {
+      for (uint64_t word = m_words[i] & other.m_words[i]; word != 0;
+           word &= word - 1) {
+        func(i * 64 + std::countr_zero(word));
+      }
+    }
+  }
+
+  // Calls func(index) for every index in this mask. func may reset indices.
+  template <typename F>
+  void ForEach(F&& func) const {
+    for (size_t i = 0; i < m_words.size(); ++i) {
+      for (uint64_t word = m_words[i]; word != 0; word &= word - 1) {
+        func(i * 64 + std::countr_zero(word));
+      }
+    }
+  }
+
+ private:
+  wpi::SmallVector<uint64_t, 1> m_words;
+};
+
+namespace {
+// Logs command lifecycle events and execute times to a DataLog, with command
+// names interned as integer IDs.
+class CommandLog {
+ public:
+  enum Event : int64_t { kInitialize = 0, kInterrupt = 1, kFinish = 2 };
+
+  CommandLog(wpi::log::DataLog& log, std::string_view prefix)
+      : m_names{log, fmt::format("{}Names", prefix)},
+        m_events{log, fmt::format("{}Events", prefix)},
+        m_executeTimes{log, fmt::format("{}ExecuteTimes", prefix)} {}
+
+  void LogInitialize(const Command& command);
+  void LogEvent(Event event, const Command& command) {
+    int64_t record[] = {event, GetId(command)};
+    m_events.Append(record);
+  }
+  void AddExecuteTime(const Command& command, int64_t us) {
+    m_times.emplace_back(GetId(command));
+    m_times.emplace_back(us);
+  }
+  void FlushExecuteTimes() {
+    if (!m_times.empty()) {
+      m_executeTimes.Append(m_times);
+      m_times.clear();
+    }
+  }
+
+ private:
+  int64_t GetId(const Command& command);
+
+  wpi::log::StringLogEntry m_names;
+  wpi::log::IntegerArrayLogEntry m_events;
+  wpi::log::IntegerArrayLogEntry m_executeTimes;
+  // Commands may be destroyed and their address reused, so the name is
+  // checked again each time a command is initialized.
+  wpi::DenseMap<const Command*, std::pair<int64_t, std::string>> m_ids;
+  int64_t m_nextId = 0;
+  std::vector<int64_t> m_times;
+};
+}  // namespace
+
+void CommandLog::LogInitialize(const Command& command) {
+  auto name = command.GetName();
+  auto [it, isNew] = m_ids.try_emplace(&command);
+  auto& [id, idName] = it->second;
+  if (isNew || idName != name) {
+    id = m_nextId++;
+    m_names.Append(name);
+    idName = std::move(name);
+  }
+  LogEvent(kInitialize, command);
+}
+
+int64_t CommandLog::GetId(const Command& command) {
+  auto it = m_ids.find(&command);
+  if (it == m_ids.end()) {
+    // scheduled before logging started
+    LogInitialize(command);
+    it = m_ids.find(&command);
+  }
+  return it->second.first;
+}
+
 class CommandScheduler::Impl {
  public:
+  // Returns the index of a subsystem, assigning one if it doesn't have one.
+  size_t GetIndex(Subsystem* subsystem) {
+    auto [it, isNew] =
+        subsystemIndices.try_emplace(subsystem, requiringCommands.size());
+    if (isNew) {
+      requiringCommands.emplace_back(nullptr);
+    }
+    return it->second;
+  }
+
+  RequirementMask GetMask(const wpi::SmallSet<Subsystem*, 4>& subsystems) {
+    RequirementMask mask;
+    for (auto&& subsystem : subsystems) {
+      mask.Set(GetIndex(subsystem));
+    }
+    return mask;
+  }
+
+  // Releases the subsystems required by a command.
+  void ReleaseRequirements(const Command* command) {
+    requiredMask.ForEach([&](size_t index) {
+      if (requiringCommands[index] == command) {
+        requiringCommands[index] = nullptr;
+        requiredMask.Reset(index);
+      }
+    });
+  }
+
   // A set of the currently-running commands.
   wpi::SmallSet<Command*, 12> scheduledCommands;
 
-  // A map from required subsystems to their requiring commands.  Also used as a
-  // set of the currently-required subsystems.
-  wpi::DenseMap<Subsystem*, Command*> requirements;
+  // Subsystems are given indices the first time they're registered or
+  // required, so requirement sets can be compared as bitmasks. Indices aren't
+  // reused; programs create a fixed set of subsystems.
+  wpi::DenseMap<const Subsystem*, size_t> subsystemIndices;
+
+  // The command requiring each subsystem index, or nullptr.
+  std::vector<Command*> requiringCommands;
+
+  // The set of currently-required subsystem indices.
+  RequirementMask requiredMask;
 
   // A map from subsystems registered with the scheduler to their default
   // commands.  Also used as a list of currently-registered subsystems.
   wpi::DenseMap<Subsystem*, std::unique_ptr<Command>> subsystems;
 
+  // Subsystems that may run in parallel, and the threads that run them.
+  wpi::SmallSet<Subsystem*, 12> parallelSubsystems;
+  ParallelRunner parallelRunner;
+
   frc::EventLoop defaultButtonLoop;
   // The set of currently-registered buttons that will be polled every
   // iteration.
@@ -59,6 +334,8 @@ class CommandScheduler::Impl {
   // via Schedule(CommandPtr&&). These are erased (destroyed) at the very end of
   // the loop cycle when the command lifecycle is complete.
   wpi::DenseMap<Command*, CommandPtr> ownedCommands;
+
+  std::unique_ptr<CommandLog> log;
 };
 
 template <typename TMap, typename TKey>
@@ -117,20 +394,19 @@ void CommandScheduler::Schedule(Command* command) {
     return;
   }
 
-  const auto& requirements = command->GetRequirements();
+  RequirementMask requirements = m_impl->GetMask(command->GetRequirements());
 
   wpi::SmallVector<Command*, 8> intersection;
 
   bool isDisjoint = true;
   bool allInterruptible = true;
-  for (auto&& i1 : m_impl->requirements) {
-    if (requirements.find(i1.first) != requirements.end()) {
-      isDisjoint = false;
-      allInterruptible &= (i1.second->GetInterruptionBehavior() ==
-                           Command::InterruptionBehavior::kCancelSelf);
-      intersection.emplace_back(i1.second);
-    }
-  }
+  m_impl->requiredMask.ForEachCommon(requirements, [&](size_t index) {
+    Command* requiring = m_impl->requiringCommands[index];
+    isDisjoint = false;
+    allInterruptible &= (requiring->GetInterruptionBehavior() ==
+                         Command::InterruptionBehavior::kCancelSelf);
+    intersection.emplace_back(requiring);
+  });
 
   if (isDisjoint || allInterruptible) {
     if (allInterruptible) {
@@ -139,13 +415,17 @@ void CommandScheduler::Schedule(Command* command) {
       }
     }
     m_impl->scheduledCommands.insert(command);
-    for (auto&& requirement : requirements) {
-      m_impl->requirements[requirement] = command;
-    }
+    requirements.ForEach([&](size_t index) {
+      m_impl->requiringCommands[index] = command;
+      m_impl->requiredMask.Set(index);
+    });
     command->Initialize();
     for (auto&& action : m_impl->initActions) {
       action(*command);
     }
+    if (m_impl->log) {
+      m_impl->log->LogInitialize(*command);
+    }
     m_watchdog.AddEpoch(command->GetName() + ".Initialize()");
   }
 }
@@ -179,8 +459,27 @@ void CommandScheduler::Run() {
 
   m_watchdog.Reset();
 
-  // Run the periodic method of all registered subsystems.
+  // Run the periodic method of all registered subsystems, starting with the
+  // parallel ones.
+  wpi::SmallVector<Subsystem*, 12> parallel;
+  for (auto&& subsystem : m_impl->subsystems) {
+    if (m_impl->parallelSubsystems.contains(subsystem.getFirst())) {
+      parallel.emplace_back(subsystem.getFirst());
+    }
+  }
+  if (!parallel.empty()) {
+    m_impl->parallelRunner.Run(parallel.size(), [&](size_t i) {
+      parallel[i]->Periodic();
+      if constexpr (frc::RobotBase::IsSimulation()) {
+        parallel[i]->SimulationPeriodic();
+      }
+    });
+    m_watchdog.AddEpoch("parallel Periodic()");
+  }
   for (auto&& subsystem : m_impl->subsystems) {
+    if (m_impl->parallelSubsystems.contains(subsystem.getFirst())) {
+      continue;
+    }
     subsystem.getFirst()->Periodic();
     if constexpr (frc::RobotBase::IsSimulation()) {
       subsystem.getFirst()->SimulationPeriodic();
@@ -196,6 +495,44 @@ void CommandScheduler::Run() {
   m_watchdog.AddEpoch("buttons.Run()");
 
   bool isDisabled = frc::RobotState::IsDisabled();
+
+  // Execute the commands that only require parallel subsystems. Those can't
+  // share a requirement, so they're independent of each other.
+  wpi::SmallVector<Command*, 12> parallelCommands;
+  if (!m_impl->parallelSubsystems.empty()) {
+    for (Command* command : m_impl->scheduledCommands) {
+      const auto& requirements = command->GetRequirements();
+      if ((!isDisabled || command->RunsWhenDisabled()) &&
+          !requirements.empty() &&
+          std::all_of(requirements.begin(), requirements.end(),
+                      [&](Subsystem* requirement) {
+                        return m_impl->parallelSubsystems.contains(
+                            requirement);
+                      })) {
+        parallelCommands.emplace_back(command);
+      }
+    }
+  }
+  if (!parallelCommands.empty()) {
+    wpi::SmallVector<int64_t, 12> times;
+    if (m_impl->log) {
+      times.resize(parallelCommands.size());
+    }
+    m_impl->parallelRunner.Run(parallelCommands.size(), [&](size_t i) {
+      if (times.empty()) {
+        parallelCommands[i]->Execute();
+      } else {
+        uint64_t start = wpi::Now();
+        parallelCommands[i]->Execute();
+        times[i] = wpi::Now() - start;
+      }
+    });
+    for (size_t i = 0; i < times.size(); ++i) {
+      m_impl->log->AddExecuteTime(*parallelCommands[i], times[i]);
+    }
+    m_watchdog.AddEpoch("parallel Execute()");
+  }
+
   // create a new set to avoid iterator invalidation.
   for (Command* command : wpi::SmallSet(m_impl->scheduledCommands)) {
     if (!IsScheduled(command)) {
@@ -207,7 +544,16 @@ void CommandScheduler::Run() {
       continue;
     }
 
-    command->Execute();
+    if (std::find(parallelCommands.begin(), parallelCommands.end(),
+                  command) == parallelCommands.end()) {
+      if (m_impl->log) {
+        uint64_t start = wpi::Now();
+        command->Execute();
+        m_impl->log->AddExecuteTime(*command, wpi::Now() - start);
+      } else {
+        command->Execute();
+      }
+    }
     for (auto&& action : m_impl->executeActions) {
       action(*command);
     }
@@ -219,21 +565,25 @@ void CommandScheduler::Run() {
       for (auto&& action : m_impl->finishActions) {
         action(*command);
       }
-
-      for (auto&& requirement : command->GetRequirements()) {
-        m_impl->requirements.erase(requirement);
+      if (m_impl->log) {
+        m_impl->log->LogEvent(CommandLog::kFinish, *command);
       }
 
+      m_impl->ReleaseRequirements(command);
+
       m_watchdog.AddEpoch(command->GetName() + ".End(false)");
       // remove owned commands after everything else is done
       m_impl->ownedCommands.erase(command);
     }
   }
 
+  if (m_impl->log) {
+    m_impl->log->FlushExecuteTimes();
+  }
+
   // Add default commands for un-required registered subsystems.
   for (auto&& subsystem : m_impl->subsystems) {
-    auto s = m_impl->requirements.find(subsystem.getFirst());
-    if (s == m_impl->requirements.end() && subsystem.getSecond()) {
+    if (!Requiring(subsystem.getFirst()) && subsystem.getSecond()) {
       Schedule({subsystem.getSecond().get()});
     }
   }
@@ -251,6 +601,7 @@ void CommandScheduler::RegisterSubsystem(Subsystem* subsystem) {
   }
 
   m_impl->subsystems[subsystem] = nullptr;
+  m_impl->GetIndex(subsystem);
 }
 
 void CommandScheduler::UnregisterSubsystem(Subsystem* subsystem) {
@@ -258,6 +609,7 @@ void CommandScheduler::UnregisterSubsystem(Subsystem* subsystem) {
   if (s != m_impl->subsystems.end()) {
     m_impl->subsystems.erase(s);
   }
+  m_impl->parallelSubsystems.erase(subsystem);
 }
 
 void CommandScheduler::RegisterSubsystem(
@@ -290,6 +642,19 @@ void CommandScheduler::UnregisterSubsystem(
 
 void CommandScheduler::UnregisterAllSubsystems() {
   m_impl->subsystems.clear();
+  m_impl->parallelSubsystems.clear();
+}
+
+void CommandScheduler::SetParallelThreads(int threads) {
+  m_impl->parallelRunner.SetThreads(std::max(threads, 0));
+}
+
+void CommandScheduler::SetParallel(Subsystem* subsystem, bool parallel) {
+  if (parallel) {
+    m_impl->parallelSubsystems.insert(subsystem);
+  } else {
+    m_impl->parallelSubsystems.erase(subsystem);
+  }
 }
 
 void CommandScheduler::SetDefaultCommand(Subsystem* subsystem,
@@ -329,11 +694,10 @@ void CommandScheduler::Cancel(Command* command,
   for (auto&& action : m_impl->interruptActions) {
     action(*command, interruptor);
   }
-  for (auto&& requirement : m_impl->requirements) {
-    if (requirement.second == command) {
-      m_impl->requirements.erase(requirement.first);
-    }
+  if (m_impl->log) {
+    m_impl->log->LogEvent(CommandLog::kInterrupt, *command);
   }
+  m_impl->ReleaseRequirements(command);
   m_watchdog.AddEpoch(command->GetName() + ".End(true)");
 }
 
@@ -394,9 +758,9 @@ bool CommandScheduler::IsScheduled(const CommandPtr& command) const {
 }
 
 Command* CommandScheduler::Requiring(const Subsystem* subsystem) const {
-  auto find = m_impl->requirements.find(subsystem);
-  if (find != m_impl->requirements.end()) {
-    return find->second;
+  auto find = m_impl->subsystemIndices.find(subsystem);
+  if (find != m_impl->subsystemIndices.end()) {
+    return m_impl->requiringCommands[find->second];
   } else {
     return nullptr;
   }
@@ -438,6 +802,13 @@ void CommandScheduler::OnCommandFinish(Action action) {
   m_impl->finishActions.emplace_back(std::move(action));
 }
 
+void CommandScheduler::StartDataLog(wpi::log::DataLog& log,
+                                    std::string_view prefix) {
+  if (!m_impl->log) {
+    m_impl->log = std::make_unique<CommandLog>(log, prefix);
+  }
+}
+
 void CommandScheduler::RequireUngrouped(const Command* command) {
   auto stacktrace = command->GetPreviousCompositionSite();
   if (stacktrace.has_value()) {
@@ -13,7 +13,14 @@ frc::GenericHID& CommandGenericHID::GetHID() {
 }
 
 Trigger CommandGenericHID::Button(int button, frc::EventLoop* loop) const {
-  return Trigger(loop, [this, button] { return m_hid.GetRawButton(button); });
+  auto it = m_buttons.find({loop, button});
+  if (it == m_buttons.end()) {
+    it = m_buttons
+             .try_emplace({loop, button}, loop,
+                          [this, button] { return m_hid.GetRawButton(button); })
+             .first;
+  }
+  return it->second;
 }
 
 Trigger CommandGenericHID::POV(int angle, frc::EventLoop* loop) const {
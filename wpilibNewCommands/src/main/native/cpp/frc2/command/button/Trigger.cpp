@@ -15,10 +15,22 @@ using namespace frc2;
 
 Trigger::Trigger(const Trigger& other) = default;
 
+bool Trigger::Condition::Get() {
+  if (!loop->IsPolling()) {
+    return func();
+  }
+  uint64_t poll = loop->GetPollCount();
+  if (lastPoll != poll) {
+    value = func();
+    lastPoll = poll;
+  }
+  return value;
+}
+
 void Trigger::AddBinding(wpi::unique_function<void(bool, bool)>&& body) {
-  m_loop->Bind([condition = m_condition, previous = m_condition(),
+  m_loop->Bind([condition = m_condition, previous = m_condition->Get(),
                 body = std::move(body)]() mutable {
-    bool current = condition();
+    bool current = condition->Get();
 
     body(previous, current);
 
@@ -180,10 +192,10 @@ Trigger Trigger::Debounce(units::second_t debounceTime,
                           frc::Debouncer::DebounceType type) {
   return Trigger(m_loop, [debouncer = frc::Debouncer(debounceTime, type),
                           condition = m_condition]() mutable {
-    return debouncer.Calculate(condition());
+    return debouncer.Calculate(condition->Get());
   });
 }
 
 bool Trigger::Get() const {
-  return m_condition();
+  return m_condition->Get();
 }
@@ -18,16 +18,21 @@ frc2::CommandPtr SysIdRoutine::Quasistatic(Direction direction) {
 
   double outputSign = direction == Direction::kForward ? 1.0 : -1.0;
 
-  return m_mechanism.m_subsystem->RunOnce([this] { timer.Restart(); })
+  return m_mechanism.m_subsystem
+      ->RunOnce([this] {
+        timer.Restart();
+        StartLogging();
+      })
       .AndThen(
           m_mechanism.m_subsystem
               ->Run([this, state, outputSign] {
                 m_outputVolts = outputSign * timer.Get() * m_config.m_rampRate;
                 m_mechanism.m_drive(m_outputVolts);
-                m_mechanism.m_log(this);
+                Log();
                 m_recordState(state);
               })
               .FinallyDo([this] {
+                StopCapture();
                 m_mechanism.m_drive(0_V);
                 m_recordState(frc::sysid::State::kNone);
                 timer.Stop();
@@ -49,13 +54,17 @@ frc2::CommandPtr SysIdRoutine::Dynamic(Direction direction) {
   double outputSign = direction == Direction::kForward ? 1.0 : -1.0;
 
   return m_mechanism.m_subsystem
-      ->RunOnce([this] { m_outputVolts = m_config.m_stepVoltage; })
+      ->RunOnce([this] {
+        m_outputVolts = m_config.m_stepVoltage;
+        StartLogging();
+      })
       .AndThen(m_mechanism.m_subsystem->Run([this, state, outputSign] {
         m_mechanism.m_drive(m_outputVolts * outputSign);
-        m_mechanism.m_log(this);
+        Log();
         m_recordState(state);
       }))
       .FinallyDo([this] {
+        StopCapture();
         m_mechanism.m_drive(0_V);
         m_recordState(frc::sysid::State::kNone);
       })
@@ -64,3 +73,15 @@ frc2::CommandPtr SysIdRoutine::Dynamic(Direction direction) {
                 m_mechanism.m_name)
       .WithTimeout(m_config.m_timeout);
 }
+
+void SysIdRoutine::StartLogging() {
+  if (m_config.m_capturePeriod > 0_s) {
+    StartCapture(m_mechanism.m_log, m_config.m_capturePeriod);
+  }
+}
+
+void SysIdRoutine::Log() {
+  if (!IsCapturing()) {
+    m_mechanism.m_log(this);
+  }
+}
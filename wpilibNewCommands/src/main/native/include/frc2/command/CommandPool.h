@@ -0,0 +1,119 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stddef.h>
+
+#include <new>
+
+namespace frc2 {
+
+/**
+ * A memory pool that heap-allocated commands can opt in to being allocated
+ * from, by deriving from PoolAllocated. The library's compositions
+ * (SequentialCommandGroup, the parallel groups, DeferredCommand, and the
+ * WaitCommand used by WithTimeout()) do so, as do commands derived from them.
+ * Other commands use the default allocator.
+ *
+ * Commands are carved out of large chunks and freed commands are kept on
+ * per-size free lists, so once a program has built its commands, building and
+ * destroying more (e.g. in a DeferredCommand) reuses memory instead of
+ * calling the system allocator. Reserve() can be called at startup so that
+ * even the first mid-match compositions don't allocate. Chunks are never
+ * returned to the system.
+ *
+ * This class is provided by the NewCommands VendorDep
+ */
+class CommandPool {
+ public:
+  /// Commands larger than this are allocated from the heap.
+  static constexpr size_t kMaxPooledSize = 1024;
+
+  /// Size of the chunks commands are allocated from.
+  static constexpr size_t kChunkSize = 64 * 1024;
+
+  /**
+   * Pool statistics.
+   */
+  struct Statistics {
+    /// Total size of the chunks owned by the pool.
+    size_t chunkBytes = 0;
+
+    /// Number of pooled commands currently allocated.
+    size_t liveCommands = 0;
+
+    /// Number of chunks allocated from the system.
+    size_t chunkAllocations = 0;
+
+    /// Number of commands too large to be pooled.
+    size_t largeAllocations = 0;
+  };
+
+  CommandPool() = delete;
+
+  /**
+   * Allocates memory for a command.
+   *
+   * @param size Size of the command.
+   * @return Memory for the command.
+   */
+  static void* Allocate(size_t size);
+
+  /**
+   * Frees memory allocated by Allocate().
+   *
+   * @param ptr Memory to free.
+   * @param size Size passed to Allocate().
+   */
+  static void Free(void* ptr, size_t size);
+
+  /**
+   * Makes sure the pool can allocate at least the given number of bytes of
+   * commands without allocating from the system.
+   *
+   * @param bytes Number of bytes.
+   */
+  static void Reserve(size_t bytes);
+
+  /**
+   * Gets pool statistics.
+   *
+   * @return Statistics.
+   */
+  static Statistics GetStatistics();
+};
+
+/**
+ * Mixin that allocates a command class from the CommandPool when it is
+ * heap-allocated (e.g. by ToPtr()):
+ *
+ * <pre>
+ * class MyCommand : public frc2::CommandHelper<frc2::Command, MyCommand>,
+ *                   public frc2::PoolAllocated {
+ *   ...
+ * };
+ * </pre>
+ *
+ * This class is provided by the NewCommands VendorDep
+ */
+class PoolAllocated {
+ public:
+  static void* operator new(size_t size) { return CommandPool::Allocate(size); }
+
+  static void operator delete(void* ptr, size_t size) {
+    CommandPool::Free(ptr, size);
+  }
+
+  // Over-aligned commands are rare; allocate them from the heap.
+  static void* operator new(size_t size, std::align_val_t align) {
+    return ::operator new(size, align);
+  }
+
+  static void operator delete(void* ptr, size_t size, std::align_val_t align) {
+    ::operator delete(ptr, size, align);
+  }
+};
+
+}  // namespace frc2
@@ -10,6 +10,7 @@
 #include <memory>
 #include <optional>
 #include <span>
+#include <string_view>
 #include <utility>
 
 #include <frc/Errors.h>
@@ -20,6 +21,10 @@
 #include <wpi/sendable/Sendable.h>
 #include <wpi/sendable/SendableHelper.h>
 
+namespace wpi::log {
+class DataLog;
+}  // namespace wpi::log
+
 namespace frc2 {
 class Command;
 class CommandPtr;
@@ -163,9 +168,36 @@ class CommandScheduler final : public wpi::Sendable,
    *
    * <p>Any subsystems not being used as requirements have their default methods
    * started.
+   *
+   * <p>If parallel threads are enabled, the periodic methods of subsystems
+   * marked with SetParallel() run concurrently before those of the other
+   * subsystems, and the Execute() methods of commands that only require such
+   * subsystems run concurrently before those of the other commands. Both
+   * finish before the scheduler moves on.
    */
   void Run();
 
+  /**
+   * Sets the number of worker threads used to run parallel subsystems and their
+   * commands. The thread calling Run() also runs tasks, so 0 (the default) runs
+   * everything on the calling thread.
+   *
+   * @param threads the number of worker threads
+   */
+  void SetParallelThreads(int threads);
+
+  /**
+   * Marks a subsystem as safe to run in parallel. Its Periodic() and
+   * SimulationPeriodic() methods, and the Execute() method of any command
+   * that only requires parallel subsystems, may then run on a worker thread
+   * at the same time as other parallel subsystems and commands. They must not
+   * share state with other subsystems or call into the scheduler.
+   *
+   * @param subsystem the subsystem
+   * @param parallel whether the subsystem runs in parallel
+   */
+  void SetParallel(Subsystem* subsystem, bool parallel = true);
+
   /**
    * Registers subsystems with the scheduler.  This must be called for the
    * subsystem's periodic block to run when the scheduler is run, and for the
@@ -407,6 +439,23 @@ class CommandScheduler final : public wpi::Sendable,
    */
   void OnCommandFinish(Action action);
 
+  /**
+   * Starts logging command lifecycle events and execute times to a DataLog.
+   * Only the first call has any effect.
+   *
+   * Each command is given an ID when it's first scheduled; its name is
+   * appended to the "<prefix>Names" string entry, so the Nth record is the name
+   * of command N. The "<prefix>Events" integer array entry gets an [event, id]
+   * record for every initialization (0), interruption (1), and finish (2), and
+   * the "<prefix>ExecuteTimes" integer array entry gets one record per
+   * scheduler run with an [id, microseconds] pair for every executed command.
+   *
+   * @param log the DataLog to log to
+   * @param prefix the entry name prefix
+   */
+  void StartDataLog(wpi::log::DataLog& log,
+                    std::string_view prefix = "CommandScheduler/");
+
   /**
    * Requires that the specified command hasn't already been added to a
    * composition.
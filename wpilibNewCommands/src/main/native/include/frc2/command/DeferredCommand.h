@@ -10,6 +10,7 @@
 
 #include "frc2/command/Command.h"
 #include "frc2/command/CommandHelper.h"
+#include "frc2/command/CommandPool.h"
 #include "frc2/command/Requirements.h"
 
 namespace frc2 {
@@ -24,7 +25,8 @@ namespace frc2 {
  *
  * <p>This class is provided by the NewCommands VendorDep
  */
-class DeferredCommand : public CommandHelper<Command, DeferredCommand> {
+class DeferredCommand : public CommandHelper<Command, DeferredCommand>,
+                        public PoolAllocated {
  public:
   /**
    * Creates a new DeferredCommand that directly runs the supplied command when
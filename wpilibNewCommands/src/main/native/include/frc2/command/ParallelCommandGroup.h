@@ -17,6 +17,7 @@
 #include <wpi/DecayedDerivedFrom.h>
 
 #include "frc2/command/CommandHelper.h"
+#include "frc2/command/CommandPool.h"
 
 namespace frc2 {
 /**
@@ -31,7 +32,8 @@ namespace frc2 {
  * This class is provided by the NewCommands VendorDep
  */
 class ParallelCommandGroup
-    : public CommandHelper<Command, ParallelCommandGroup> {
+    : public CommandHelper<Command, ParallelCommandGroup>,
+      public PoolAllocated {
  public:
   /**
    * Creates a new ParallelCommandGroup. The given commands will be executed
@@ -17,6 +17,7 @@
 #include <wpi/DecayedDerivedFrom.h>
 
 #include "frc2/command/CommandHelper.h"
+#include "frc2/command/CommandPool.h"
 
 namespace frc2 {
 /**
@@ -32,7 +33,8 @@ namespace frc2 {
  * This class is provided by the NewCommands VendorDep
  */
 class ParallelDeadlineGroup
-    : public CommandHelper<Command, ParallelDeadlineGroup> {
+    : public CommandHelper<Command, ParallelDeadlineGroup>,
+      public PoolAllocated {
  public:
   /**
    * Creates a new ParallelDeadlineGroup. The given commands (including the
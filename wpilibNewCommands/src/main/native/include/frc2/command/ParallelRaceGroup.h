@@ -17,6 +17,7 @@
 #include <wpi/DecayedDerivedFrom.h>
 
 #include "frc2/command/CommandHelper.h"
+#include "frc2/command/CommandPool.h"
 
 namespace frc2 {
 /**
@@ -30,7 +31,8 @@ namespace frc2 {
  *
  * This class is provided by the NewCommands VendorDep
  */
-class ParallelRaceGroup : public CommandHelper<Command, ParallelRaceGroup> {
+class ParallelRaceGroup : public CommandHelper<Command, ParallelRaceGroup>,
+                          public PoolAllocated {
  public:
   /**
    * Creates a new ParallelCommandRace. The given commands will be executed
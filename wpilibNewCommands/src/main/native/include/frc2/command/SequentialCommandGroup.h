@@ -18,6 +18,7 @@
 #include <wpi/DecayedDerivedFrom.h>
 
 #include "frc2/command/CommandHelper.h"
+#include "frc2/command/CommandPool.h"
 
 namespace frc2 {
 
@@ -34,7 +35,8 @@ const size_t invalid_index = std::numeric_limits<size_t>::max();
  * This class is provided by the NewCommands VendorDep
  */
 class SequentialCommandGroup
-    : public CommandHelper<Command, SequentialCommandGroup> {
+    : public CommandHelper<Command, SequentialCommandGroup>,
+      public PoolAllocated {
  public:
   /**
    * Creates a new SequentialCommandGroup. The given commands will be run
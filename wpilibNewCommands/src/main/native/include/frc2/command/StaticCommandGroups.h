@@ -0,0 +1,415 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#ifdef _WIN32
+#pragma warning(push)
+#pragma warning(disable : 4521)
+#endif
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <frc/Errors.h>
+#include <wpi/sendable/SendableBuilder.h>
+
+#include "frc2/command/CommandHelper.h"
+#include "frc2/command/CommandScheduler.h"
+
+namespace frc2 {
+namespace detail {
+
+// Children are stored by value, so their dynamic type is their static type.
+// Qualified calls skip the virtual dispatch and let the compiler inline them.
+template <typename T>
+void InitializeChild(T& command) {
+  command.T::Initialize();
+}
+
+template <typename T>
+void ExecuteChild(T& command) {
+  command.T::Execute();
+}
+
+template <typename T>
+void EndChild(T& command, bool interrupted) {
+  command.T::End(interrupted);
+}
+
+template <typename T>
+bool IsChildFinished(T& command) {
+  return command.T::IsFinished();
+}
+
+/**
+ * Common base of the statically composed command groups. Owns the child
+ * commands by value and aggregates their requirements and properties the same
+ * way the dynamic command groups do.
+ */
+template <std::derived_from<Command>... Commands>
+class StaticCommandGroupBase : public Command {
+ public:
+  StaticCommandGroupBase(bool parallel, Commands&&... commands)
+      : m_commands{std::move(commands)...} {
+    std::apply([&](auto&... children) { (AddChild(children, parallel), ...); },
+               m_commands);
+  }
+
+  StaticCommandGroupBase(StaticCommandGroupBase&&) = default;
+
+  // No copy constructors for command groups
+  StaticCommandGroupBase(const StaticCommandGroupBase&) = delete;
+
+  bool RunsWhenDisabled() const override { return m_runWhenDisabled; }
+
+  Command::InterruptionBehavior GetInterruptionBehavior() const override {
+    return m_interruptBehavior;
+  }
+
+ protected:
+  static constexpr size_t kSize = sizeof...(Commands);
+
+  template <typename F>
+  void ForEach(F&& func) {
+    std::apply([&](auto&... children) { (func(children), ...); }, m_commands);
+  }
+
+  template <typename F>
+  void ForEachIndexed(F&& func) {
+    size_t i = 0;
+    std::apply([&](auto&... children) { (func(i++, children), ...); },
+               m_commands);
+  }
+
+  template <typename F>
+  void Visit(size_t index, F&& func) {
+    size_t i = 0;
+    std::apply(
+        [&](auto&... children) {
+          ((i++ == index ? func(children) : void()), ...);
+        },
+        m_commands);
+  }
+
+  std::tuple<Commands...> m_commands;
+
+ private:
+  void AddChild(Command& command, bool parallel) {
+    CommandScheduler::GetInstance().RequireUngroupedAndUnscheduled(&command);
+    if (parallel && !RequirementsDisjoint(this, &command)) {
+      throw FRC_MakeError(frc::err::CommandIllegalUse,
+                          "Multiple commands in a parallel group cannot "
+                          "require the same subsystems");
+    }
+    command.SetComposed(true);
+    AddRequirements(command.GetRequirements());
+    m_runWhenDisabled &= command.RunsWhenDisabled();
+    if (command.GetInterruptionBehavior() ==
+        Command::InterruptionBehavior::kCancelSelf) {
+      m_interruptBehavior = Command::InterruptionBehavior::kCancelSelf;
+    }
+  }
+
+  bool m_runWhenDisabled{true};
+  Command::InterruptionBehavior m_interruptBehavior{
+      Command::InterruptionBehavior::kCancelIncoming};
+};
+
+}  // namespace detail
+
+/**
+ * A command composition that runs a fixed list of commands in sequence, like
+ * SequentialCommandGroup.
+ *
+ * <p>Unlike SequentialCommandGroup, the children are part of the composition's
+ * type and stored inline rather than in separately allocated unique_ptrs, and
+ * calls to them are not virtual. Nesting Seq, Par, Race, and Deadline produces
+ * a single concrete command type with no heap allocation; convert it to a
+ * CommandPtr with ToPtr() where a type-erased command is needed.
+ *
+ * <pre>
+ * frc2::CommandPtr command =
+ *     frc2::Seq{DriveCommand{...},
+ *               frc2::Par{IntakeCommand{...}, frc2::WaitCommand{1_s}}}
+ *         .ToPtr();
+ * </pre>
+ *
+ * <p>The rules for command compositions apply: command instances that are
+ * passed to it are owned by the composition and cannot be added to any other
+ * composition or scheduled individually, and the composition requires all
+ * subsystems its components require.
+ *
+ * This class is provided by the NewCommands VendorDep
+ */
+template <std::derived_from<Command>... Commands>
+class Seq : public CommandHelper<detail::StaticCommandGroupBase<Commands...>,
+                                 Seq<Commands...>> {
+ public:
+  /**
+   * Creates a new Seq. The given commands will be run sequentially, with the
+   * composition finishing when the last command finishes.
+   *
+   * @param commands the commands to include in this composition.
+   */
+  explicit Seq(Commands... commands)
+      : Seq::CommandHelper{false, std::move(commands)...} {}
+
+  Seq(Seq&&) = default;
+
+  void Initialize() final {
+    m_index = 0;
+    this->Visit(0, [](auto& child) { detail::InitializeChild(child); });
+  }
+
+  void Execute() final {
+    this->Visit(m_index, [this](auto& child) {
+      detail::ExecuteChild(child);
+      if (detail::IsChildFinished(child)) {
+        detail::EndChild(child, false);
+        ++m_index;
+        this->Visit(m_index,
+                    [](auto& next) { detail::InitializeChild(next); });
+      }
+    });
+  }
+
+  void End(bool interrupted) final {
+    if (interrupted) {
+      this->Visit(m_index, [](auto& child) { detail::EndChild(child, true); });
+    }
+    m_index = invalid_index;
+  }
+
+  bool IsFinished() final { return m_index == Seq::kSize; }
+
+  void InitSendable(wpi::SendableBuilder& builder) override {
+    Command::InitSendable(builder);
+    builder.AddIntegerProperty(
+        "index", [this] { return m_index; }, nullptr);
+  }
+
+ private:
+  static constexpr size_t invalid_index = static_cast<size_t>(-1);
+
+  size_t m_index{invalid_index};
+};
+
+/**
+ * A command composition that runs a fixed set of commands in parallel, ending
+ * when the last command ends, like ParallelCommandGroup. See Seq for how this
+ * differs from the dynamic groups.
+ *
+ * <p>The rules for command compositions apply: command instances that are
+ * passed to it are owned by the composition and cannot be added to any other
+ * composition or scheduled individually, and the composition requires all
+ * subsystems its components require.
+ *
+ * This class is provided by the NewCommands VendorDep
+ */
+template <std::derived_from<Command>... Commands>
+class Par : public CommandHelper<detail::StaticCommandGroupBase<Commands...>,
+                                 Par<Commands...>> {
+ public:
+  /**
+   * Creates a new Par. The given commands will be executed simultaneously.
+   * The composition will finish when the last command finishes. If the
+   * composition is interrupted, only the commands that are still running will
+   * be interrupted.
+   *
+   * @param commands the commands to include in this composition.
+   */
+  explicit Par(Commands... commands)
+      : Par::CommandHelper{true, std::move(commands)...} {}
+
+  Par(Par&&) = default;
+
+  void Initialize() final {
+    this->ForEachIndexed([this](size_t i, auto& child) {
+      detail::InitializeChild(child);
+      m_running[i] = true;
+    });
+  }
+
+  void Execute() final {
+    this->ForEachIndexed([this](size_t i, auto& child) {
+      if (!m_running[i]) {
+        return;
+      }
+      detail::ExecuteChild(child);
+      if (detail::IsChildFinished(child)) {
+        detail::EndChild(child, false);
+        m_running[i] = false;
+      }
+    });
+  }
+
+  void End(bool interrupted) final {
+    if (interrupted) {
+      this->ForEachIndexed([this](size_t i, auto& child) {
+        if (m_running[i]) {
+          detail::EndChild(child, true);
+        }
+      });
+    }
+  }
+
+  bool IsFinished() final {
+    for (bool running : m_running) {
+      if (running) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  std::array<bool, sizeof...(Commands)> m_running{};
+};
+
+/**
+ * A command composition that runs a fixed set of commands in parallel, ending
+ * when any one of the commands ends and interrupting all the others, like
+ * ParallelRaceGroup. See Seq for how this differs from the dynamic groups.
+ *
+ * <p>The rules for command compositions apply: command instances that are
+ * passed to it are owned by the composition and cannot be added to any other
+ * composition or scheduled individually, and the composition requires all
+ * subsystems its components require.
+ *
+ * This class is provided by the NewCommands VendorDep
+ */
+template <std::derived_from<Command>... Commands>
+class Race : public CommandHelper<detail::StaticCommandGroupBase<Commands...>,
+                                  Race<Commands...>> {
+ public:
+  /**
+   * Creates a new Race. The given commands will be executed simultaneously,
+   * and will "race to the finish" - the first command to finish ends the
+   * entire command, with all other commands being interrupted.
+   *
+   * @param commands the commands to include in this composition.
+   */
+  explicit Race(Commands... commands)
+      : Race::CommandHelper{true, std::move(commands)...} {}
+
+  Race(Race&&) = default;
+
+  void Initialize() final {
+    m_finished = false;
+    this->ForEach([](auto& child) { detail::InitializeChild(child); });
+  }
+
+  void Execute() final {
+    this->ForEach([this](auto& child) {
+      detail::ExecuteChild(child);
+      if (detail::IsChildFinished(child)) {
+        m_finished = true;
+      }
+    });
+  }
+
+  void End(bool interrupted) final {
+    this->ForEach([](auto& child) {
+      detail::EndChild(child, !detail::IsChildFinished(child));
+    });
+  }
+
+  bool IsFinished() final { return m_finished; }
+
+ private:
+  bool m_finished{false};
+};
+
+/**
+ * A command composition that runs a fixed set of commands in parallel, ending
+ * only when a specific command (the "deadline") ends, interrupting all other
+ * commands that are still running at that point, like ParallelDeadlineGroup.
+ * See Seq for how this differs from the dynamic groups.
+ *
+ * <p>The rules for command compositions apply: command instances that are
+ * passed to it are owned by the composition and cannot be added to any other
+ * composition or scheduled individually, and the composition requires all
+ * subsystems its components require.
+ *
+ * This class is provided by the NewCommands VendorDep
+ */
+template <std::derived_from<Command> DeadlineCommand,
+          std::derived_from<Command>... Commands>
+class Deadline
+    : public CommandHelper<
+          detail::StaticCommandGroupBase<DeadlineCommand, Commands...>,
+          Deadline<DeadlineCommand, Commands...>> {
+ public:
+  /**
+   * Creates a new Deadline. The given commands, including the deadline, will
+   * be executed simultaneously. The composition will finish when the deadline
+   * finishes, interrupting all other still-running commands. If the
+   * composition is interrupted, only the commands still running will be
+   * interrupted.
+   *
+   * @param deadline the command that determines when the composition ends
+   * @param commands the commands to be executed
+   */
+  explicit Deadline(DeadlineCommand deadline, Commands... commands)
+      : Deadline::CommandHelper{true, std::move(deadline),
+                                std::move(commands)...} {}
+
+  Deadline(Deadline&&) = default;
+
+  void Initialize() final {
+    m_finished = false;
+    this->ForEachIndexed([this](size_t i, auto& child) {
+      detail::InitializeChild(child);
+      m_running[i] = true;
+    });
+  }
+
+  void Execute() final {
+    this->ForEachIndexed([this](size_t i, auto& child) {
+      if (!m_running[i]) {
+        return;
+      }
+      detail::ExecuteChild(child);
+      if (detail::IsChildFinished(child)) {
+        detail::EndChild(child, false);
+        m_running[i] = false;
+        if (i == 0) {
+          m_finished = true;
+        }
+      }
+    });
+  }
+
+  void End(bool interrupted) final {
+    this->ForEachIndexed([this](size_t i, auto& child) {
+      if (m_running[i]) {
+        detail::EndChild(child, true);
+      }
+    });
+  }
+
+  bool IsFinished() final { return m_finished; }
+
+  void InitSendable(wpi::SendableBuilder& builder) override {
+    Command::InitSendable(builder);
+    builder.AddStringProperty(
+        "deadline",
+        [this] { return std::get<0>(this->m_commands).GetName(); }, nullptr);
+  }
+
+ private:
+  std::array<bool, sizeof...(Commands) + 1> m_running{};
+  bool m_finished{true};
+};
+
+}  // namespace frc2
+
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
@@ -9,6 +9,7 @@
 
 #include "frc2/command/Command.h"
 #include "frc2/command/CommandHelper.h"
+#include "frc2/command/CommandPool.h"
 
 namespace frc2 {
 /**
@@ -16,7 +17,8 @@ namespace frc2 {
  *
  * This class is provided by the NewCommands VendorDep
  */
-class WaitCommand : public CommandHelper<Command, WaitCommand> {
+class WaitCommand : public CommandHelper<Command, WaitCommand>,
+                    public PoolAllocated {
  public:
   /**
    * Creates a new WaitCommand.  This command will do nothing, and end after the
@@ -3,7 +3,10 @@
 // the WPILib BSD license file in the root directory of this project.
 
 #pragma once
+#include <utility>
+
 #include <frc/GenericHID.h>
+#include <wpi/DenseMap.h>
 
 #include "Trigger.h"
 #include "frc2/command/CommandScheduler.h"
@@ -35,6 +38,8 @@ class CommandGenericHID {
 
   /**
    * Constructs an event instance around this button's digital signal.
+   * Triggers for the same button and loop share their condition, so the button
+   * is read once per poll however many bindings use it.
    *
    * @param button the button index
    * @param loop the event loop instance to attach the event to. Defaults to the
@@ -264,5 +269,6 @@ class CommandGenericHID {
 
  private:
   frc::GenericHID m_hid;
+  mutable wpi::DenseMap<std::pair<frc::EventLoop*, int>, Trigger> m_buttons;
 };
 }  // namespace frc2
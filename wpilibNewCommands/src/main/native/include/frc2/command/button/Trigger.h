@@ -4,7 +4,10 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #include <functional>
+#include <memory>
 #include <utility>
 
 #include <frc/event/BooleanEvent.h>
@@ -26,6 +29,9 @@ class Command;
  *
  * <p>Triggers can easily be composed for advanced functionality using the
  * {@link #operator!}, {@link #operator||}, {@link #operator&&} operators.
+ * Composed triggers share the conditions they're built from, and while the
+ * loop is being polled each condition is evaluated at most once per poll, no
+ * matter how many triggers and bindings use it.
  *
  * <p>This class is provided by the NewCommands VendorDep
  */
@@ -49,7 +55,8 @@ class Trigger {
    * @param condition the condition represented by this trigger
    */
   Trigger(frc::EventLoop* loop, std::function<bool()> condition)
-      : m_loop{loop}, m_condition{std::move(condition)} {}
+      : m_loop{loop},
+        m_condition{std::make_shared<Condition>(loop, std::move(condition))} {}
 
   /**
    * Create a new trigger that is always `false`.
@@ -225,7 +232,7 @@ class Trigger {
    */
   Trigger operator&&(std::function<bool()> rhs) {
     return Trigger(m_loop, [condition = m_condition, rhs = std::move(rhs)] {
-      return condition() && rhs();
+      return condition->Get() && rhs();
     });
   }
 
@@ -235,8 +242,8 @@ class Trigger {
    * @return A trigger which is active when both component triggers are active.
    */
   Trigger operator&&(Trigger rhs) {
-    return Trigger(m_loop, [condition = m_condition, rhs] {
-      return condition() && rhs.m_condition();
+    return Trigger(m_loop, [condition = m_condition, rhs = rhs.m_condition] {
+      return condition->Get() && rhs->Get();
     });
   }
 
@@ -247,7 +254,7 @@ class Trigger {
    */
   Trigger operator||(std::function<bool()> rhs) {
     return Trigger(m_loop, [condition = m_condition, rhs = std::move(rhs)] {
-      return condition() || rhs();
+      return condition->Get() || rhs();
     });
   }
 
@@ -257,8 +264,8 @@ class Trigger {
    * @return A trigger which is active when either component trigger is active.
    */
   Trigger operator||(Trigger rhs) {
-    return Trigger(m_loop, [condition = m_condition, rhs] {
-      return condition() || rhs.m_condition();
+    return Trigger(m_loop, [condition = m_condition, rhs = rhs.m_condition] {
+      return condition->Get() || rhs->Get();
     });
   }
 
@@ -269,7 +276,8 @@ class Trigger {
    * and vice-versa.
    */
   Trigger operator!() {
-    return Trigger(m_loop, [condition = m_condition] { return !condition(); });
+    return Trigger(m_loop,
+                   [condition = m_condition] { return !condition->Get(); });
   }
 
   /**
@@ -292,6 +300,23 @@ class Trigger {
   bool Get() const;
 
  private:
+  /**
+   * A condition shared by the triggers built from it. While its loop is being
+   * polled, the first Get() of each poll evaluates the condition and later
+   * calls return the cached value.
+   */
+  struct Condition {
+    Condition(frc::EventLoop* loop, std::function<bool()> func)
+        : loop{loop}, func{std::move(func)} {}
+
+    bool Get();
+
+    frc::EventLoop* loop;
+    std::function<bool()> func;
+    uint64_t lastPoll = 0;
+    bool value = false;
+  };
+
   /**
    * Adds a binding to the EventLoop.
    *
@@ -300,6 +325,6 @@ class Trigger {
   void AddBinding(wpi::unique_function<void(bool, bool)>&& body);
 
   frc::EventLoop* m_loop;
-  std::function<bool()> m_condition;
+  std::shared_ptr<Condition> m_condition;
 };
 }  // namespace frc2
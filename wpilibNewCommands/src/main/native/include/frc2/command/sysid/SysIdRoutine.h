@@ -36,6 +36,11 @@ class Config {
   /// solution.
   std::function<void(frc::sysid::State)> m_recordState;
 
+  /// If nonzero, motor data is captured on a dedicated real-time notifier at
+  /// this period instead of once per robot loop. See
+  /// frc::sysid::SysIdRoutineLog::StartCapture().
+  units::second_t m_capturePeriod{0_s};
+
   /**
    * Create a new configuration for a SysId test routine.
    *
@@ -189,6 +194,9 @@ class SysIdRoutine : public frc::sysid::SysIdRoutineLog {
   frc2::CommandPtr Dynamic(Direction direction);
 
  private:
+  void StartLogging();
+  void Log();
+
   Config m_config;
   Mechanism m_mechanism;
   units::volt_t m_outputVolts{0};
@@ -0,0 +1,64 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <memory>
+#include <vector>
+
+#include "CommandTestBase.h"
+#include "frc2/command/CommandHelper.h"
+#include "frc2/command/CommandPool.h"
+#include "frc2/command/Commands.h"
+#include "frc2/command/InstantCommand.h"
+
+using namespace frc2;
+class CommandPoolTest : public CommandTestBase {};
+
+namespace {
+class PooledCommand : public CommandHelper<Command, PooledCommand>,
+                      public PoolAllocated {};
+}  // namespace
+
+TEST_F(CommandPoolTest, ReusesFreedCommands) {
+  std::unique_ptr<Command> command = std::make_unique<PooledCommand>();
+  void* address = command.get();
+  size_t live = CommandPool::GetStatistics().liveCommands;
+  command.reset();
+  EXPECT_EQ(CommandPool::GetStatistics().liveCommands, live - 1);
+
+  command = std::make_unique<PooledCommand>();
+  EXPECT_EQ(command.get(), address);
+}
+
+TEST_F(CommandPoolTest, NotPooledByDefault) {
+  size_t live = CommandPool::GetStatistics().liveCommands;
+  auto command = std::make_unique<InstantCommand>();
+  EXPECT_EQ(CommandPool::GetStatistics().liveCommands, live);
+}
+
+TEST_F(CommandPoolTest, CompositionsArePooled) {
+  size_t live = CommandPool::GetStatistics().liveCommands;
+  {
+    // sequence, parallel, race (from WithTimeout), wait, and deferred
+    auto command =
+        cmd::Sequence(cmd::Parallel(cmd::None()),
+                      cmd::Defer([] { return cmd::None(); }, {}))
+            .WithTimeout(2_s);
+    EXPECT_EQ(CommandPool::GetStatistics().liveCommands, live + 5);
+  }
+  EXPECT_EQ(CommandPool::GetStatistics().liveCommands, live);
+}
+
+TEST_F(CommandPoolTest, ReserveAvoidsChunkAllocations) {
+  CommandPool::Reserve(2 * CommandPool::kChunkSize);
+  size_t chunkAllocations = CommandPool::GetStatistics().chunkAllocations;
+
+  for (int i = 0; i < 10; ++i) {
+    std::vector<std::unique_ptr<PooledCommand>> commands;
+    for (int j = 0; j < 100; ++j) {
+      commands.emplace_back(std::make_unique<PooledCommand>());
+    }
+  }
+
+  EXPECT_EQ(CommandPool::GetStatistics().chunkAllocations, chunkAllocations);
+}
@@ -4,7 +4,16 @@
 
 #include <frc2/command/Commands.h>
 
+#include <atomic>
+#include <memory>
+#include <string>
 #include <utility>
+#include <vector>
+
+#include <wpi/DataLogReader.h>
+#include <wpi/DataLogWriter.h>
+#include <wpi/Logger.h>
+#include <wpi/raw_ostream.h>
 
 #include "CommandTestBase.h"
 #include "frc2/command/InstantCommand.h"
@@ -224,3 +233,78 @@ TEST_F(SchedulerTest, ScheduleCommandPtr) {
   EXPECT_EQ(destructionCounter, 1)
       << "Scheduler should delete command after command completes";
 }
+
+TEST_F(SchedulerTest, ParallelSubsystems) {
+  CommandScheduler scheduler = GetScheduler();
+  scheduler.SetParallelThreads(2);
+
+  std::atomic_int periodicCounter = 0;
+  std::atomic_int executeCounter = 0;
+  TestSubsystem parallel1{[&] { periodicCounter++; }};
+  TestSubsystem parallel2{[&] { periodicCounter++; }};
+  TestSubsystem sequential{[&] { periodicCounter++; }};
+  scheduler.RegisterSubsystem({&parallel1, &parallel2, &sequential});
+  scheduler.SetParallel(&parallel1);
+  scheduler.SetParallel(&parallel2);
+
+  auto command1 = cmd::Run([&] { executeCounter++; }, {&parallel1});
+  auto command2 = cmd::Run([&] { executeCounter++; }, {&parallel2});
+  auto command3 = cmd::Run([&] { executeCounter++; }, {&sequential});
+  scheduler.Schedule(command1);
+  scheduler.Schedule(command2);
+  scheduler.Schedule(command3);
+
+  scheduler.Run();
+  EXPECT_EQ(periodicCounter, 3);
+  EXPECT_EQ(executeCounter, 3);
+
+  scheduler.Run();
+  EXPECT_EQ(periodicCounter, 6);
+  EXPECT_EQ(executeCounter, 6);
+}
+
+TEST_F(SchedulerTest, DataLog) {
+  CommandScheduler scheduler = GetScheduler();
+  wpi::Logger msglog;
+  std::vector<uint8_t> data;
+  wpi::log::DataLogWriter log{msglog,
+                              std::make_unique<wpi::raw_uvector_ostream>(data)};
+  scheduler.StartDataLog(log, "cmd/");
+
+  auto finishing = cmd::RunOnce([] {}).WithName("Finishing");
+  auto idle = cmd::Idle().WithName("Idle");
+  scheduler.Schedule(finishing);
+  scheduler.Schedule(idle);
+  scheduler.Run();
+  scheduler.Cancel(idle);
+  log.Flush();
+
+  wpi::log::DataLogReader reader{wpi::MemoryBuffer::GetMemBuffer(data, "")};
+  ASSERT_TRUE(reader.IsValid());
+  wpi::StringMap<int> entries;
+  std::vector<std::string> names;
+  std::vector<std::vector<int64_t>> events;
+  std::vector<int64_t> times;
+  for (auto&& record : reader) {
+    wpi::log::StartRecordData start;
+    std::vector<int64_t> arr;
+    if (record.GetStartData(&start)) {
+      entries[start.name] = start.entry;
+    } else if (record.GetEntry() == entries["cmd/Names"]) {
+      std::string_view name;
+      ASSERT_TRUE(record.GetString(&name));
+      names.emplace_back(name);
+    } else if (record.GetEntry() == entries["cmd/Events"]) {
+      ASSERT_TRUE(record.GetIntegerArray(&arr));
+      events.emplace_back(arr);
+    } else if (record.GetEntry() == entries["cmd/ExecuteTimes"]) {
+      ASSERT_TRUE(record.GetIntegerArray(&times));
+    }
+  }
+
+  EXPECT_EQ(names, (std::vector<std::string>{"Finishing", "Idle"}));
+  EXPECT_EQ(events, (std::vector<std::vector<int64_t>>{
+                        {0, 0}, {0, 1}, {2, 0}, {1, 1}}));
+  ASSERT_EQ(times.size(), 4u);
+  EXPECT_EQ(times[0] + times[2], 1);  // one of each ID
+}
@@ -0,0 +1,167 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <utility>
+
+#include "CommandTestBase.h"
+#include "frc2/command/FunctionalCommand.h"
+#include "frc2/command/StaticCommandGroups.h"
+
+using namespace frc2;
+class StaticCommandGroupsTest : public CommandTestBase {};
+
+namespace {
+struct Counts {
+  int initialize = 0;
+  int execute = 0;
+  int endFinished = 0;
+  int endInterrupted = 0;
+  bool finished = false;
+};
+
+FunctionalCommand MakeCommand(Counts& counts, Requirements requirements = {}) {
+  return FunctionalCommand{
+      [&counts] { ++counts.initialize; }, [&counts] { ++counts.execute; },
+      [&counts](bool interrupted) {
+        ++(interrupted ? counts.endInterrupted : counts.endFinished);
+      },
+      [&counts] { return counts.finished; }, requirements};
+}
+}  // namespace
+
+TEST_F(StaticCommandGroupsTest, SeqSchedule) {
+  CommandScheduler scheduler = GetScheduler();
+
+  Counts counts1, counts2;
+  Seq group{MakeCommand(counts1), MakeCommand(counts2)};
+
+  scheduler.Schedule(&group);
+  EXPECT_EQ(1, counts1.initialize);
+  EXPECT_EQ(0, counts2.initialize);
+
+  counts1.finished = true;
+  scheduler.Run();
+  EXPECT_EQ(1, counts1.endFinished);
+  EXPECT_EQ(1, counts2.initialize);
+  EXPECT_TRUE(scheduler.IsScheduled(&group));
+
+  counts2.finished = true;
+  scheduler.Run();
+  EXPECT_EQ(1, counts1.execute);
+  EXPECT_EQ(1, counts2.execute);
+  EXPECT_EQ(1, counts2.endFinished);
+  EXPECT_FALSE(scheduler.IsScheduled(&group));
+}
+
+TEST_F(StaticCommandGroupsTest, SeqInterrupt) {
+  CommandScheduler scheduler = GetScheduler();
+
+  Counts counts1, counts2, counts3;
+  Seq group{MakeCommand(counts1), MakeCommand(counts2), MakeCommand(counts3)};
+
+  scheduler.Schedule(&group);
+  counts1.finished = true;
+  scheduler.Run();
+  scheduler.Cancel(&group);
+
+  EXPECT_EQ(1, counts1.endFinished);
+  EXPECT_EQ(1, counts2.endInterrupted);
+  EXPECT_EQ(0, counts3.initialize);
+  EXPECT_FALSE(scheduler.IsScheduled(&group));
+}
+
+TEST_F(StaticCommandGroupsTest, ParSchedule) {
+  CommandScheduler scheduler = GetScheduler();
+
+  Counts counts1, counts2;
+  Par group{MakeCommand(counts1), MakeCommand(counts2)};
+
+  scheduler.Schedule(&group);
+  counts1.finished = true;
+  scheduler.Run();
+  EXPECT_EQ(1, counts1.endFinished);
+  EXPECT_TRUE(scheduler.IsScheduled(&group));
+
+  counts2.finished = true;
+  scheduler.Run();
+  EXPECT_EQ(1, counts1.execute);
+  EXPECT_EQ(2, counts2.execute);
+  EXPECT_EQ(1, counts2.endFinished);
+  EXPECT_FALSE(scheduler.IsScheduled(&group));
+}
+
+TEST_F(StaticCommandGroupsTest, RaceSchedule) {
+  CommandScheduler scheduler = GetScheduler();
+
+  Counts counts1, counts2;
+  Race group{MakeCommand(counts1), MakeCommand(counts2)};
+
+  scheduler.Schedule(&group);
+  scheduler.Run();
+  counts1.finished = true;
+  scheduler.Run();
+
+  EXPECT_EQ(2, counts2.execute);
+  EXPECT_EQ(1, counts1.endFinished);
+  EXPECT_EQ(1, counts2.endInterrupted);
+  EXPECT_FALSE(scheduler.IsScheduled(&group));
+}
+
+TEST_F(StaticCommandGroupsTest, DeadlineSchedule) {
+  CommandScheduler scheduler = GetScheduler();
+
+  Counts deadline, counts1, counts2;
+  Deadline group{MakeCommand(deadline), MakeCommand(counts1),
+                 MakeCommand(counts2)};
+
+  scheduler.Schedule(&group);
+  counts1.finished = true;
+  scheduler.Run();
+  EXPECT_EQ(1, counts1.endFinished);
+  EXPECT_TRUE(scheduler.IsScheduled(&group));
+
+  deadline.finished = true;
+  scheduler.Run();
+  EXPECT_EQ(1, deadline.endFinished);
+  EXPECT_EQ(1, counts1.execute);
+  EXPECT_EQ(1, counts2.endInterrupted);
+  EXPECT_FALSE(scheduler.IsScheduled(&group));
+}
+
+TEST_F(StaticCommandGroupsTest, Requirements) {
+  TestSubsystem subsystem1, subsystem2;
+  Counts counts;
+
+  Seq group{MakeCommand(counts, {&subsystem1}),
+            MakeCommand(counts, {&subsystem1, &subsystem2})};
+  EXPECT_TRUE(group.HasRequirement(&subsystem1));
+  EXPECT_TRUE(group.HasRequirement(&subsystem2));
+
+  EXPECT_THROW(Par(MakeCommand(counts, {&subsystem1}),
+                   MakeCommand(counts, {&subsystem1})),
+               frc::RuntimeError);
+}
+
+TEST_F(StaticCommandGroupsTest, NestedToPtr) {
+  CommandScheduler scheduler = GetScheduler();
+
+  Counts counts1, counts2, counts3;
+  CommandPtr command =
+      Seq{MakeCommand(counts1),
+          Par{MakeCommand(counts2), MakeCommand(counts3)}}
+          .ToPtr();
+
+  scheduler.Schedule(command);
+  counts1.finished = true;
+  scheduler.Run();
+  EXPECT_EQ(1, counts2.initialize);
+  EXPECT_EQ(1, counts3.initialize);
+
+  counts2.finished = true;
+  counts3.finished = true;
+  scheduler.Run();
+  EXPECT_EQ(1, counts2.endFinished);
+  EXPECT_EQ(1, counts3.endFinished);
+  EXPECT_FALSE(scheduler.IsScheduled(command));
+}
@@ -247,3 +247,32 @@ TEST_F(TriggerTest, Debounce) {
   scheduler.Run();
   EXPECT_TRUE(scheduler.IsScheduled(&command));
 }
+
+TEST_F(TriggerTest, SharedConditionEvaluatedOncePerPoll) {
+  frc::EventLoop loop;
+  int evaluations = 0;
+  bool pressed = false;
+  RunCommand command1([] {});
+  RunCommand command2([] {});
+  RunCommand command3([] {});
+
+  Trigger trigger(&loop, [&] {
+    evaluations++;
+    return pressed;
+  });
+  trigger.OnTrue(&command1);
+  (trigger && !trigger).OnTrue(&command2);
+  (trigger || trigger).WhileTrue(&command3);
+  evaluations = 0;
+
+  pressed = true;
+  loop.Poll();
+  EXPECT_EQ(evaluations, 1);
+  EXPECT_TRUE(command1.IsScheduled());
+  EXPECT_FALSE(command2.IsScheduled());
+  EXPECT_TRUE(command3.IsScheduled());
+
+  // Get() outside a poll always evaluates the condition
+  trigger.Get();
+  EXPECT_EQ(evaluations, 2);
+}
@@ -5,9 +5,12 @@
 #include <frc2/command/Subsystem.h>
 #include <frc2/command/sysid/SysIdRoutine.h>
 
+#include <atomic>
+#include <filesystem>
 #include <utility>
 #include <vector>
 
+#include <frc/DataLogManager.h>
 #include <frc/Timer.h>
 #include <frc/simulation/SimHooks.h>
 #include <gtest/gtest.h>
@@ -90,6 +93,15 @@ class SysIdRoutineTest : public ::testing::Test {
     command.get()->End(true);
   }
 
+  static void SetUpTestSuite() {
+    // the mechanism log callbacks write to the data log; keep it out of the
+    // working directory
+    frc::DataLogManager::Start(
+        std::filesystem::temp_directory_path().string());
+  }
+
+  static void TearDownTestSuite() { frc::DataLogManager::Stop(); }
+
   void SetUp() override {
     frc::sim::PauseTiming();
     frc2::CommandPtr m_quasistaticForward{
@@ -183,3 +195,33 @@ TEST_F(SysIdRoutineTest, EmptyLogFunc) {
   RunCommand(std::move(m_emptyRoutineForward));
   SUCCEED();
 }
+
+TEST_F(SysIdRoutineTest, CaptureOnNotifier) {
+  std::atomic<int> logCount{0};
+  std::atomic<int> stateCount{0};
+  frc2::sysid::Config config{std::nullopt, std::nullopt, std::nullopt,
+                             [&](frc::sysid::State) { ++stateCount; }};
+  config.m_capturePeriod = 1_ms;
+  frc2::sysid::SysIdRoutine routine{
+      config, frc2::sysid::Mechanism{
+                  [](units::volt_t) {},
+                  [&](frc::sysid::SysIdRoutineLog* log) {
+                    ++logCount;
+                    log->Motor("Mock Motor").voltage(0_V);
+                  },
+                  &m_subsystem, "capture"}};
+  auto command = routine.Quasistatic(frc2::sysid::Direction::kForward);
+
+  command.get()->Initialize();
+  EXPECT_TRUE(routine.IsCapturing());
+  command.get()->Execute();
+  for (int i = 0; i < 10; ++i) {
+    frc::sim::StepTiming(1_ms);
+  }
+  command.get()->End(true);
+  EXPECT_FALSE(routine.IsCapturing());
+
+  EXPECT_GT(stateCount, 0);
+  // samples come from the notifier, not from Execute()
+  EXPECT_GE(logCount, 10);
+}
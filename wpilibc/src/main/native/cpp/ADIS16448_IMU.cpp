@@ -16,6 +16,7 @@
 #include <algorithm>
 #include <cmath>
 #include <numbers>
+#include <span>
 #include <utility>
 
 #include <fmt/format.h>
@@ -28,6 +29,7 @@
 #include "frc/Errors.h"
 #include "frc/MathUtil.h"
 #include "frc/SPI.h"
+#include "frc/SPIAutoReceiver.h"
 #include "frc/Timer.h"
 
 /* Helpful conversion functions */
@@ -207,32 +209,32 @@ ADIS16448_IMU::ADIS16448_IMU(ADIS16448_IMU&& other)
     : m_reset_in{std::move(other.m_reset_in)},
       m_status_led{std::move(other.m_status_led)},
       m_yaw_axis{std::move(other.m_yaw_axis)},
-      m_gyro_rate_x{std::move(other.m_gyro_rate_x)},
-      m_gyro_rate_y{std::move(other.m_gyro_rate_y)},
-      m_gyro_rate_z{std::move(other.m_gyro_rate_z)},
-      m_accel_x{std::move(other.m_accel_x)},
-      m_accel_y{std::move(other.m_accel_y)},
-      m_accel_z{std::move(other.m_accel_z)},
-      m_mag_x{std::move(other.m_mag_x)},
-      m_mag_y{std::move(other.m_mag_y)},
-      m_mag_z{std::move(other.m_mag_z)},
-      m_baro{std::move(other.m_baro)},
-      m_temp{std::move(other.m_temp)},
+      m_gyro_rate_x{other.m_gyro_rate_x.load()},
+      m_gyro_rate_y{other.m_gyro_rate_y.load()},
+      m_gyro_rate_z{other.m_gyro_rate_z.load()},
+      m_accel_x{other.m_accel_x.load()},
+      m_accel_y{other.m_accel_y.load()},
+      m_accel_z{other.m_accel_z.load()},
+      m_mag_x{other.m_mag_x.load()},
+      m_mag_y{other.m_mag_y.load()},
+      m_mag_z{other.m_mag_z.load()},
+      m_baro{other.m_baro.load()},
+      m_temp{other.m_temp.load()},
       m_dt{std::move(other.m_dt)},
       m_alpha{std::move(other.m_alpha)},
-      m_compAngleX{std::move(other.m_compAngleX)},
-      m_compAngleY{std::move(other.m_compAngleY)},
-      m_accelAngleX{std::move(other.m_accelAngleX)},
-      m_accelAngleY{std::move(other.m_accelAngleY)},
+      m_compAngleX{other.m_compAngleX.load()},
+      m_compAngleY{other.m_compAngleY.load()},
+      m_accelAngleX{other.m_accelAngleX.load()},
+      m_accelAngleY{other.m_accelAngleY.load()},
       m_offset_buffer{other.m_offset_buffer},
       m_gyro_rate_offset_x{std::move(other.m_gyro_rate_offset_x)},
       m_gyro_rate_offset_y{std::move(other.m_gyro_rate_offset_y)},
       m_gyro_rate_offset_z{std::move(other.m_gyro_rate_offset_z)},
       m_avg_size{std::move(other.m_avg_size)},
       m_accum_count{std::move(other.m_accum_count)},
-      m_integ_gyro_angle_x{std::move(other.m_integ_gyro_angle_x)},
-      m_integ_gyro_angle_y{std::move(other.m_integ_gyro_angle_y)},
-      m_integ_gyro_angle_z{std::move(other.m_integ_gyro_angle_z)},
+      m_integ_gyro_angle_x{other.m_integ_gyro_angle_x.load()},
+      m_integ_gyro_angle_y{other.m_integ_gyro_angle_y.load()},
+      m_integ_gyro_angle_z{other.m_integ_gyro_angle_z.load()},
       m_thread_active{other.m_thread_active.load()},
       m_first_run{other.m_first_run.load()},
       m_thread_idle{other.m_thread_idle.load()},
@@ -265,32 +267,32 @@ ADIS16448_IMU& ADIS16448_IMU::operator=(ADIS16448_IMU&& other) {
   std::swap(this->m_reset_in, other.m_reset_in);
   std::swap(this->m_status_led, other.m_status_led);
   std::swap(this->m_yaw_axis, other.m_yaw_axis);
-  std::swap(this->m_gyro_rate_x, other.m_gyro_rate_x);
-  std::swap(this->m_gyro_rate_y, other.m_gyro_rate_y);
-  std::swap(this->m_gyro_rate_z, other.m_gyro_rate_z);
-  std::swap(this->m_accel_x, other.m_accel_x);
-  std::swap(this->m_accel_y, other.m_accel_y);
-  std::swap(this->m_accel_z, other.m_accel_z);
-  std::swap(this->m_mag_x, other.m_mag_x);
-  std::swap(this->m_mag_y, other.m_mag_y);
-  std::swap(this->m_mag_z, other.m_mag_z);
-  std::swap(this->m_baro, other.m_baro);
-  std::swap(this->m_temp, other.m_temp);
+  this->m_gyro_rate_x = other.m_gyro_rate_x.load();
+  this->m_gyro_rate_y = other.m_gyro_rate_y.load();
+  this->m_gyro_rate_z = other.m_gyro_rate_z.load();
+  this->m_accel_x = other.m_accel_x.load();
+  this->m_accel_y = other.m_accel_y.load();
+  this->m_accel_z = other.m_accel_z.load();
+  this->m_mag_x = other.m_mag_x.load();
+  this->m_mag_y = other.m_mag_y.load();
+  this->m_mag_z = other.m_mag_z.load();
+  this->m_baro = other.m_baro.load();
+  this->m_temp = other.m_temp.load();
   std::swap(this->m_dt, other.m_dt);
   std::swap(this->m_alpha, other.m_alpha);
-  std::swap(this->m_compAngleX, other.m_compAngleX);
-  std::swap(this->m_compAngleY, other.m_compAngleY);
-  std::swap(this->m_accelAngleX, other.m_accelAngleX);
-  std::swap(this->m_accelAngleY, other.m_accelAngleY);
+  this->m_compAngleX = other.m_compAngleX.load();
+  this->m_compAngleY = other.m_compAngleY.load();
+  this->m_accelAngleX = other.m_accelAngleX.load();
+  this->m_accelAngleY = other.m_accelAngleY.load();
   std::swap(this->m_offset_buffer, other.m_offset_buffer);
   std::swap(this->m_gyro_rate_offset_x, other.m_gyro_rate_offset_x);
   std::swap(this->m_gyro_rate_offset_y, other.m_gyro_rate_offset_y);
   std::swap(this->m_gyro_rate_offset_z, other.m_gyro_rate_offset_z);
   std::swap(this->m_avg_size, other.m_avg_size);
   std::swap(this->m_accum_count, other.m_accum_count);
-  std::swap(this->m_integ_gyro_angle_x, other.m_integ_gyro_angle_x);
-  std::swap(this->m_integ_gyro_angle_y, other.m_integ_gyro_angle_y);
-  std::swap(this->m_integ_gyro_angle_z, other.m_integ_gyro_angle_z);
+  this->m_integ_gyro_angle_x = other.m_integ_gyro_angle_x.load();
+  this->m_integ_gyro_angle_y = other.m_integ_gyro_angle_y.load();
+  this->m_integ_gyro_angle_z = other.m_integ_gyro_angle_z.load();
   this->m_thread_active = other.m_thread_active.load();
   this->m_first_run = other.m_first_run.load();
   this->m_thread_idle = other.m_thread_idle.load();
@@ -518,7 +520,6 @@ void ADIS16448_IMU::WriteRegister(uint8_t reg, uint16_t val) {
 }
 
 void ADIS16448_IMU::Reset() {
-  std::scoped_lock sync(m_mutex);
   m_integ_gyro_angle_x = 0.0;
   m_integ_gyro_angle_y = 0.0;
   m_integ_gyro_angle_z = 0.0;
@@ -559,47 +560,55 @@ ADIS16448_IMU::~ADIS16448_IMU() {
 }
 
 void ADIS16448_IMU::Acquire() {
-  // Set data packet length
-  const int dataset_len = 29;  // 18 data points + timestamp
-  const int BUFFER_SIZE = 4000;
-
-  // This buffer can contain many datasets
-  uint32_t buffer[BUFFER_SIZE];
-  uint32_t previous_timestamp = 0;
+  // 18 data points + timestamp; read up to 4000 words at a time
+  SPIAutoReceiver receiver{29, 4000 / 29};
+  uint64_t previous_timestamp = 0;
   double compAngleX = 0.0;
   double compAngleY = 0.0;
+  int dropped = 0;
   while (true) {
     // Wait for data
     Wait(10_ms);
 
     if (m_thread_active) {
-      // Read number of bytes currently stored in the buffer
-      int data_count = m_spi->ReadAutoReceivedData(buffer, 0, 0_s);
-      // Check if frame is incomplete
-      int data_remainder = data_count % dataset_len;
-      // Remove incomplete data from read count
-      int data_to_read = data_count - data_remainder;
-      // Want to cap the data to read in a single read at the buffer size
-      if (data_to_read > BUFFER_SIZE) {
-        REPORT_WARNING(
-            "ADIS16448 data processing thread overrun has occurred!");
-        data_to_read = BUFFER_SIZE - (BUFFER_SIZE % dataset_len);
-      }
-      // Read data from DMA buffer
-      m_spi->ReadAutoReceivedData(buffer, data_to_read, 0_s);
+      // Integrate locally and publish once per batch, so the getters never
+      // wait on this thread
+      bool first_run = false;
+      bool publish = false;
+      double integ_gyro_angle_x = 0.0;
+      double integ_gyro_angle_y = 0.0;
+      double integ_gyro_angle_z = 0.0;
+      double gyro_rate_x = 0.0;
+      double gyro_rate_y = 0.0;
+      double gyro_rate_z = 0.0;
+      double accel_x = 0.0;
+      double accel_y = 0.0;
+      double accel_z = 0.0;
+      double mag_x = 0.0;
+      double mag_y = 0.0;
+      double mag_z = 0.0;
+      double baro = 0.0;
+      double temp = 0.0;
+      double accelAngleX = 0.0;
+      double accelAngleY = 0.0;
+
+      // The mutex only guards the offset calibration state, so hold it for
+      // the whole batch
+      std::scoped_lock sync(m_mutex);
 
       // Could be multiple data sets in the buffer. Handle each one.
-      for (int i = 0; i < data_to_read; i += dataset_len) {
+      receiver.Drain(*m_spi, [&](std::span<const uint32_t> buffer,
+                                 uint64_t timestamp) {
         // Calculate CRC-16 on each data packet
         uint16_t calc_crc = 0xFFFF;  // Starting word
         // Cycle through XYZ GYRO, XYZ ACCEL, XYZ MAG, BARO, TEMP (Ignore Status
         // & CRC)
         for (int k = 5; k < 27; k += 2) {
           // Process LSB
-          uint8_t byte = static_cast<uint8_t>(buffer[i + k + 1]);
+          uint8_t byte = static_cast<uint8_t>(buffer[k + 1]);
           calc_crc = (calc_crc >> 8) ^ m_adiscrc[(calc_crc & 0xFF) ^ byte];
           // Process MSB
-          byte = static_cast<uint8_t>(buffer[i + k]);
+          byte = static_cast<uint8_t>(buffer[k]);
           calc_crc = (calc_crc >> 8) ^ m_adiscrc[(calc_crc & 0xFF) ^ byte];
         }
         // Complement
@@ -607,106 +616,121 @@ void ADIS16448_IMU::Acquire() {
         // Flip LSB & MSB
         calc_crc = static_cast<uint16_t>((calc_crc << 8) | (calc_crc >> 8));
         // Extract DUT CRC from data buffer
-        uint16_t imu_crc = BuffToUShort(&buffer[i + 27]);
+        uint16_t imu_crc = BuffToUShort(&buffer[27]);
 
         // Compare calculated vs read CRC. Don't update outputs or dt if CRC-16
         // is bad
-        if (calc_crc == imu_crc) {
-          // Timestamp is at buffer[i]
-          m_dt = (buffer[i] - previous_timestamp) / 1000000.0;
-          // Scale sensor data
-          double gyro_rate_x = BuffToShort(&buffer[i + 5]) * 0.04;
-          double gyro_rate_y = BuffToShort(&buffer[i + 7]) * 0.04;
-          double gyro_rate_z = BuffToShort(&buffer[i + 9]) * 0.04;
-          double accel_x = BuffToShort(&buffer[i + 11]) * 0.833;
-          double accel_y = BuffToShort(&buffer[i + 13]) * 0.833;
-          double accel_z = BuffToShort(&buffer[i + 15]) * 0.833;
-          double mag_x = BuffToShort(&buffer[i + 17]) * 0.1429;
-          double mag_y = BuffToShort(&buffer[i + 19]) * 0.1429;
-          double mag_z = BuffToShort(&buffer[i + 21]) * 0.1429;
-          double baro = BuffToShort(&buffer[i + 23]) * 0.02;
-          double temp = BuffToShort(&buffer[i + 25]) * 0.07386 + 31.0;
-
-          // Convert scaled sensor data to SI units
-          double gyro_rate_x_si = gyro_rate_x * kDegToRad;
-          double gyro_rate_y_si = gyro_rate_y * kDegToRad;
-          // double gyro_rate_z_si = gyro_rate_z * kDegToRad;
-          double accel_x_si = accel_x * kGrav;
-          double accel_y_si = accel_y * kGrav;
-          double accel_z_si = accel_z * kGrav;
-          // Store timestamp for next iteration
-          previous_timestamp = buffer[i];
-          // Calculate alpha for use with the complementary filter
-          m_alpha = kTau / (kTau + m_dt);
-          // Run inclinometer calculations
-          double accelAngleX =
-              atan2f(-accel_x_si, std::hypotf(accel_y_si, -accel_z_si));
-          double accelAngleY =
-              atan2f(accel_y_si, std::hypotf(-accel_x_si, -accel_z_si));
-          // Calculate complementary filter
-          if (m_first_run) {
-            compAngleX = accelAngleX;
-            compAngleY = accelAngleY;
-          } else {
-            accelAngleX = FormatAccelRange(accelAngleX, -accel_z_si);
-            accelAngleY = FormatAccelRange(accelAngleY, -accel_z_si);
-            compAngleX =
-                CompFilterProcess(compAngleX, accelAngleX, -gyro_rate_y_si);
-            compAngleY =
-                CompFilterProcess(compAngleY, accelAngleY, -gyro_rate_x_si);
-          }
-
-          // Update global variables and state
-          {
-            std::scoped_lock sync(m_mutex);
-            // Ignore first, integrated sample
-            if (m_first_run) {
-              m_integ_gyro_angle_x = 0.0;
-              m_integ_gyro_angle_y = 0.0;
-              m_integ_gyro_angle_z = 0.0;
-            } else {
-              // Accumulate gyro for offset calibration
-              // Add most recent sample data to buffer
-              int bufferAvgIndex = m_accum_count % m_avg_size;
-              m_offset_buffer[bufferAvgIndex] =
-                  OffsetData{gyro_rate_x, gyro_rate_y, gyro_rate_z};
-              // Increment counter
-              m_accum_count++;
-            }
-            // Don't post accumulated data to the global variables until an
-            // initial gyro offset has been calculated
-            if (!m_start_up_mode) {
-              m_gyro_rate_x = gyro_rate_x;
-              m_gyro_rate_y = gyro_rate_y;
-              m_gyro_rate_z = gyro_rate_z;
-              m_accel_x = accel_x;
-              m_accel_y = accel_y;
-              m_accel_z = accel_z;
-              m_mag_x = mag_x;
-              m_mag_y = mag_y;
-              m_mag_z = mag_z;
-              m_baro = baro;
-              m_temp = temp;
-              m_compAngleX = compAngleX * kRadToDeg;
-              m_compAngleY = compAngleY * kRadToDeg;
-              m_accelAngleX = accelAngleX * kRadToDeg;
-              m_accelAngleY = accelAngleY * kRadToDeg;
-              // Accumulate gyro for angle integration and publish to global
-              // variables
-              m_integ_gyro_angle_x +=
-                  (gyro_rate_x - m_gyro_rate_offset_x) * m_dt;
-              m_integ_gyro_angle_y +=
-                  (gyro_rate_y - m_gyro_rate_offset_y) * m_dt;
-              m_integ_gyro_angle_z +=
-                  (gyro_rate_z - m_gyro_rate_offset_z) * m_dt;
-            }
-          }
-          m_first_run = false;
+        if (calc_crc != imu_crc) {
+          return;
+        }
+
+        m_dt = (timestamp - previous_timestamp) / 1000000.0;
+        // Scale sensor data
+        gyro_rate_x = BuffToShort(&buffer[5]) * 0.04;
+        gyro_rate_y = BuffToShort(&buffer[7]) * 0.04;
+        gyro_rate_z = BuffToShort(&buffer[9]) * 0.04;
+        accel_x = BuffToShort(&buffer[11]) * 0.833;
+        accel_y = BuffToShort(&buffer[13]) * 0.833;
+        accel_z = BuffToShort(&buffer[15]) * 0.833;
+        mag_x = BuffToShort(&buffer[17]) * 0.1429;
+        mag_y = BuffToShort(&buffer[19]) * 0.1429;
+        mag_z = BuffToShort(&buffer[21]) * 0.1429;
+        baro = BuffToShort(&buffer[23]) * 0.02;
+        temp = BuffToShort(&buffer[25]) * 0.07386 + 31.0;
+
+        // Convert scaled sensor data to SI units
+        double gyro_rate_x_si = gyro_rate_x * kDegToRad;
+        double gyro_rate_y_si = gyro_rate_y * kDegToRad;
+        // double gyro_rate_z_si = gyro_rate_z * kDegToRad;
+        double accel_x_si = accel_x * kGrav;
+        double accel_y_si = accel_y * kGrav;
+        double accel_z_si = accel_z * kGrav;
+        // Store timestamp for next iteration
+        previous_timestamp = timestamp;
+        // Calculate alpha for use with the complementary filter
+        m_alpha = kTau / (kTau + m_dt);
+        // Run inclinometer calculations
+        accelAngleX =
+            atan2f(-accel_x_si, std::hypotf(accel_y_si, -accel_z_si));
+        accelAngleY =
+            atan2f(accel_y_si, std::hypotf(-accel_x_si, -accel_z_si));
+        // Calculate complementary filter
+        if (m_first_run) {
+          compAngleX = accelAngleX;
+          compAngleY = accelAngleY;
+        } else {
+          accelAngleX = FormatAccelRange(accelAngleX, -accel_z_si);
+          accelAngleY = FormatAccelRange(accelAngleY, -accel_z_si);
+          compAngleX =
+              CompFilterProcess(compAngleX, accelAngleX, -gyro_rate_y_si);
+          compAngleY =
+              CompFilterProcess(compAngleY, accelAngleY, -gyro_rate_x_si);
+        }
+
+        // Ignore first, integrated sample
+        if (m_first_run) {
+          first_run = true;
+          integ_gyro_angle_x = 0.0;
+          integ_gyro_angle_y = 0.0;
+          integ_gyro_angle_z = 0.0;
+        } else {
+          // Accumulate gyro for offset calibration
+          // Add most recent sample data to buffer
+          int bufferAvgIndex = m_accum_count % m_avg_size;
+          m_offset_buffer[bufferAvgIndex] =
+              OffsetData{gyro_rate_x, gyro_rate_y, gyro_rate_z};
+          // Increment counter
+          m_accum_count++;
         }
+        // Don't post accumulated data to the global variables until an
+        // initial gyro offset has been calculated
+        publish = !m_start_up_mode;
+        if (publish) {
+          // Accumulate gyro for angle integration
+          integ_gyro_angle_x += (gyro_rate_x - m_gyro_rate_offset_x) * m_dt;
+          integ_gyro_angle_y += (gyro_rate_y - m_gyro_rate_offset_y) * m_dt;
+          integ_gyro_angle_z += (gyro_rate_z - m_gyro_rate_offset_z) * m_dt;
+        }
+        m_first_run = false;
+      });
+
+      int total_dropped = m_spi->GetAutoDroppedCount();
+      if (total_dropped != dropped) {
+        REPORT_WARNING(
+            "ADIS16448 data processing thread overrun has occurred!");
+        dropped = total_dropped;
+      }
+
+      // Update global variables and state
+      if (first_run) {
+        m_integ_gyro_angle_x = integ_gyro_angle_x;
+        m_integ_gyro_angle_y = integ_gyro_angle_y;
+        m_integ_gyro_angle_z = integ_gyro_angle_z;
+      } else {
+        m_integ_gyro_angle_x += integ_gyro_angle_x;
+        m_integ_gyro_angle_y += integ_gyro_angle_y;
+        m_integ_gyro_angle_z += integ_gyro_angle_z;
+      }
+      if (publish) {
+        m_gyro_rate_x = gyro_rate_x;
+        m_gyro_rate_y = gyro_rate_y;
+        m_gyro_rate_z = gyro_rate_z;
+        m_accel_x = accel_x;
+        m_accel_y = accel_y;
+        m_accel_z = accel_z;
+        m_mag_x = mag_x;
+        m_mag_y = mag_y;
+        m_mag_z = mag_z;
+        m_baro = baro;
+        m_temp = temp;
+        m_compAngleX = compAngleX * kRadToDeg;
+        m_compAngleY = compAngleY * kRadToDeg;
+        m_accelAngleX = accelAngleX * kRadToDeg;
+        m_accelAngleY = accelAngleY * kRadToDeg;
       }
     } else {
       m_thread_idle = true;
-      previous_timestamp = 0.0;
+      previous_timestamp = 0;
       compAngleX = 0.0;
       compAngleY = 0.0;
     }
@@ -807,117 +831,99 @@ units::degree_t ADIS16448_IMU::GetGyroAngleX() const {
   if (m_simGyroAngleX) {
     return units::degree_t{m_simGyroAngleX.Get()};
   }
-  std::scoped_lock sync(m_mutex);
-  return units::degree_t{m_integ_gyro_angle_x};
+  return units::degree_t{m_integ_gyro_angle_x.load()};
 }
 
 units::degree_t ADIS16448_IMU::GetGyroAngleY() const {
   if (m_simGyroAngleY) {
     return units::degree_t{m_simGyroAngleY.Get()};
   }
-  std::scoped_lock sync(m_mutex);
-  return units::degree_t{m_integ_gyro_angle_y};
+  return units::degree_t{m_integ_gyro_angle_y.load()};
 }
 
 units::degree_t ADIS16448_IMU::GetGyroAngleZ() const {
   if (m_simGyroAngleZ) {
     return units::degree_t{m_simGyroAngleZ.Get()};
   }
-  std::scoped_lock sync(m_mutex);
-  return units::degree_t{m_integ_gyro_angle_z};
+  return units::degree_t{m_integ_gyro_angle_z.load()};
 }
 
 units::degrees_per_second_t ADIS16448_IMU::GetGyroRateX() const {
   if (m_simGyroRateX) {
     return units::degrees_per_second_t{m_simGyroRateX.Get()};
   }
-  std::scoped_lock sync(m_mutex);
-  return units::degrees_per_second_t{m_gyro_rate_x};
+  return units::degrees_per_second_t{m_gyro_rate_x.load()};
 }
 
 units::degrees_per_second_t ADIS16448_IMU::GetGyroRateY() const {
   if (m_simGyroRateY) {
     return units::degrees_per_second_t{m_simGyroRateY.Get()};
   }
-  std::scoped_lock sync(m_mutex);
-  return units::degrees_per_second_t{m_gyro_rate_y};
+  return units::degrees_per_second_t{m_gyro_rate_y.load()};
 }
 
 units::degrees_per_second_t ADIS16448_IMU::GetGyroRateZ() const {
   if (m_simGyroRateZ) {
     return units::degrees_per_second_t{m_simGyroRateZ.Get()};
   }
-  std::scoped_lock sync(m_mutex);
-  return units::degrees_per_second_t{m_gyro_rate_z};
+  return units::degrees_per_second_t{m_gyro_rate_z.load()};
 }
 
 units::meters_per_second_squared_t ADIS16448_IMU::GetAccelX() const {
   if (m_simAccelX) {
     return units::meters_per_second_squared_t{m_simAccelX.Get()};
   }
-  std::scoped_lock sync(m_mutex);
-  return m_accel_x * 9.81_mps_sq;
+  return m_accel_x.load() * 9.81_mps_sq;
 }
 
 units::meters_per_second_squared_t ADIS16448_IMU::GetAccelY() const {
   if (m_simAccelY) {
     return units::meters_per_second_squared_t{m_simAccelY.Get()};
   }
-  std::scoped_lock sync(m_mutex);
-  return m_accel_y * 9.81_mps_sq;
+  return m_accel_y.load() * 9.81_mps_sq;
 }
 
 units::meters_per_second_squared_t ADIS16448_IMU::GetAccelZ() const {
   if (m_simAccelZ) {
     return units::meters_per_second_squared_t{m_simAccelZ.Get()};
   }
-  std::scoped_lock sync(m_mutex);
-  return m_accel_z * 9.81_mps_sq;
+  return m_accel_z.load() * 9.81_mps_sq;
 }
 
 units::tesla_t ADIS16448_IMU::GetMagneticFieldX() const {
-  std::scoped_lock sync(m_mutex);
-  return units::gauss_t{m_mag_x * 1e-3};
+  return units::gauss_t{m_mag_x.load() * 1e-3};
 }
 
 units::tesla_t ADIS16448_IMU::GetMagneticFieldY() const {
-  std::scoped_lock sync(m_mutex);
-  return units::gauss_t{m_mag_y * 1e-3};
+  return units::gauss_t{m_mag_y.load() * 1e-3};
 }
 
 units::tesla_t ADIS16448_IMU::GetMagneticFieldZ() const {
-  std::scoped_lock sync(m_mutex);
-  return units::gauss_t{m_mag_z * 1e-3};
+  return units::gauss_t{m_mag_z.load() * 1e-3};
 }
 
 units::degree_t ADIS16448_IMU::GetXComplementaryAngle() const {
-  std::scoped_lock sync(m_mutex);
-  return units::degree_t{m_compAngleX};
+  return units::degree_t{m_compAngleX.load()};
 }
 
 units::degree_t ADIS16448_IMU::GetYComplementaryAngle() const {
-  std::scoped_lock sync(m_mutex);
-  return units::degree_t{m_compAngleY};
+  return units::degree_t{m_compAngleY.load()};
 }
 
 units::degree_t ADIS16448_IMU::GetXFilteredAccelAngle() const {
-  std::scoped_lock sync(m_mutex);
-  return units::degree_t{m_accelAngleX};
+  return units::degree_t{m_accelAngleX.load()};
 }
 
 units::degree_t ADIS16448_IMU::GetYFilteredAccelAngle() const {
-  std::scoped_lock sync(m_mutex);
-  return units::degree_t{m_accelAngleY};
+  return units::degree_t{m_accelAngleY.load()};
 }
 
 units::pounds_per_square_inch_t ADIS16448_IMU::GetBarometricPressure() const {
-  std::scoped_lock sync(m_mutex);
-  return units::mbar_t{m_baro};
+  return units::mbar_t{m_baro.load()};
 }
 
 units::celsius_t ADIS16448_IMU::GetTemperature() const {
-  std::scoped_lock sync(m_mutex);
-  return units::celsius_t{m_temp};
+  return units::celsius_t{m_temp.load()};
 }
 
 ADIS16448_IMU::IMUAxis ADIS16448_IMU::GetYawAxis() const {
@@ -15,6 +15,7 @@
 
 #include <cmath>
 #include <numbers>
+#include <span>
 #include <utility>
 
 #include <fmt/format.h>
@@ -25,6 +26,7 @@
 #include "frc/DigitalInput.h"
 #include "frc/Errors.h"
 #include "frc/MathUtil.h"
+#include "frc/SPIAutoReceiver.h"
 #include "frc/Timer.h"
 
 /* Helpful conversion functions */
@@ -208,21 +210,21 @@ ADIS16470_IMU::ADIS16470_IMU(ADIS16470_IMU&& other)
       m_roll_axis{std::move(other.m_roll_axis)},
       m_reset_in{std::move(other.m_reset_in)},
       m_status_led{std::move(other.m_status_led)},
-      m_integ_angle_x{std::move(other.m_integ_angle_x)},
-      m_integ_angle_y{std::move(other.m_integ_angle_y)},
-      m_integ_angle_z{std::move(other.m_integ_angle_z)},
-      m_gyro_rate_x{std::move(other.m_gyro_rate_x)},
-      m_gyro_rate_y{std::move(other.m_gyro_rate_y)},
-      m_gyro_rate_z{std::move(other.m_gyro_rate_z)},
-      m_accel_x{std::move(other.m_accel_x)},
-      m_accel_y{std::move(other.m_accel_y)},
-      m_accel_z{std::move(other.m_accel_z)},
+      m_integ_angle_x{other.m_integ_angle_x.load()},
+      m_integ_angle_y{other.m_integ_angle_y.load()},
+      m_integ_angle_z{other.m_integ_angle_z.load()},
+      m_gyro_rate_x{other.m_gyro_rate_x.load()},
+      m_gyro_rate_y{other.m_gyro_rate_y.load()},
+      m_gyro_rate_z{other.m_gyro_rate_z.load()},
+      m_accel_x{other.m_accel_x.load()},
+      m_accel_y{other.m_accel_y.load()},
+      m_accel_z{other.m_accel_z.load()},
       m_dt{std::move(other.m_dt)},
       m_alpha{std::move(other.m_alpha)},
-      m_compAngleX{std::move(other.m_compAngleX)},
-      m_compAngleY{std::move(other.m_compAngleY)},
-      m_accelAngleX{std::move(other.m_accelAngleX)},
-      m_accelAngleY{std::move(other.m_accelAngleY)},
+      m_compAngleX{other.m_compAngleX.load()},
+      m_compAngleY{other.m_compAngleY.load()},
+      m_accelAngleX{other.m_accelAngleX.load()},
+      m_accelAngleY{other.m_accelAngleY.load()},
       m_thread_active{other.m_thread_active.load()},
       m_first_run{other.m_first_run.load()},
       m_thread_idle{other.m_thread_idle.load()},
@@ -244,8 +246,7 @@ ADIS16470_IMU::ADIS16470_IMU(ADIS16470_IMU&& other)
       m_simGyroRateZ{std::move(other.m_simGyroRateZ)},
       m_simAccelX{std::move(other.m_simAccelX)},
       m_simAccelY{std::move(other.m_simAccelY)},
-      m_simAccelZ{std::move(other.m_simAccelZ)},
-      m_mutex{std::move(other.m_mutex)} {}
+      m_simAccelZ{std::move(other.m_simAccelZ)} {}
 
 ADIS16470_IMU& ADIS16470_IMU::operator=(ADIS16470_IMU&& other) {
   if (this == &other) {
@@ -257,21 +258,21 @@ ADIS16470_IMU& ADIS16470_IMU::operator=(ADIS16470_IMU&& other) {
   std::swap(this->m_roll_axis, other.m_roll_axis);
   std::swap(this->m_reset_in, other.m_reset_in);
   std::swap(this->m_status_led, other.m_status_led);
-  std::swap(this->m_integ_angle_x, other.m_integ_angle_x);
-  std::swap(this->m_integ_angle_y, other.m_integ_angle_y);
-  std::swap(this->m_integ_angle_z, other.m_integ_angle_z);
-  std::swap(this->m_gyro_rate_x, other.m_gyro_rate_x);
-  std::swap(this->m_gyro_rate_y, other.m_gyro_rate_y);
-  std::swap(this->m_gyro_rate_z, other.m_gyro_rate_z);
-  std::swap(this->m_accel_x, other.m_accel_x);
-  std::swap(this->m_accel_y, other.m_accel_y);
-  std::swap(this->m_accel_z, other.m_accel_z);
+  this->m_integ_angle_x = other.m_integ_angle_x.load();
+  this->m_integ_angle_y = other.m_integ_angle_y.load();
+  this->m_integ_angle_z = other.m_integ_angle_z.load();
+  this->m_gyro_rate_x = other.m_gyro_rate_x.load();
+  this->m_gyro_rate_y = other.m_gyro_rate_y.load();
+  this->m_gyro_rate_z = other.m_gyro_rate_z.load();
+  this->m_accel_x = other.m_accel_x.load();
+  this->m_accel_y = other.m_accel_y.load();
+  this->m_accel_z = other.m_accel_z.load();
   std::swap(this->m_dt, other.m_dt);
   std::swap(this->m_alpha, other.m_alpha);
-  std::swap(this->m_compAngleX, other.m_compAngleX);
-  std::swap(this->m_compAngleY, other.m_compAngleY);
-  std::swap(this->m_accelAngleX, other.m_accelAngleX);
-  std::swap(this->m_accelAngleY, other.m_accelAngleY);
+  this->m_compAngleX = other.m_compAngleX.load();
+  this->m_compAngleY = other.m_compAngleY.load();
+  this->m_accelAngleX = other.m_accelAngleX.load();
+  this->m_accelAngleY = other.m_accelAngleY.load();
   this->m_thread_active = other.m_thread_active.load();
   this->m_first_run = other.m_first_run.load();
   this->m_thread_idle = other.m_thread_idle.load();
@@ -294,7 +295,6 @@ ADIS16470_IMU& ADIS16470_IMU::operator=(ADIS16470_IMU&& other) {
   std::swap(this->m_simAccelX, other.m_simAccelX);
   std::swap(this->m_simAccelY, other.m_simAccelY);
   std::swap(this->m_simAccelZ, other.m_simAccelZ);
-  std::swap(this->m_mutex, other.m_mutex);
   return *this;
 }
 
@@ -535,7 +535,6 @@ void ADIS16470_IMU::WriteRegister(uint8_t reg, uint16_t val) {
 }
 
 void ADIS16470_IMU::Reset() {
-  std::scoped_lock sync(m_mutex);
   m_integ_angle_x = 0.0;
   m_integ_angle_y = 0.0;
   m_integ_angle_z = 0.0;
@@ -594,15 +593,12 @@ ADIS16470_IMU::~ADIS16470_IMU() {
  *https://github.com/tcleg/Six_Axis_Complementary_Filter
  **/
 void ADIS16470_IMU::Acquire() {
-  // Set data packet length
-  const int dataset_len = 27;  // 26 data points + timestamp
-  const int BUFFER_SIZE = 4000;
-
-  // This buffer can contain many datasets
-  uint32_t buffer[BUFFER_SIZE];
-  uint32_t previous_timestamp = 0;
+  // 26 data points + timestamp; read up to 4000 words at a time
+  SPIAutoReceiver receiver{27, 4000 / 27};
+  uint64_t previous_timestamp = 0;
   double compAngleX = 0.0;
   double compAngleY = 0.0;
+  int dropped = 0;
   while (true) {
     // Wait for data
     Wait(10_ms);
@@ -610,42 +606,42 @@ void ADIS16470_IMU::Acquire() {
     if (m_thread_active) {
       m_thread_idle = false;
 
-      // Read number of bytes currently stored in the buffer
-      int data_count = m_spi->ReadAutoReceivedData(buffer, 0, 0_s);
-      // Check if frame is incomplete
-      int data_remainder = data_count % dataset_len;
-      // Remove incomplete data from read count
-      int data_to_read = data_count - data_remainder;
-      // Want to cap the data to read in a single read at the buffer size
-      if (data_to_read > BUFFER_SIZE) {
-        REPORT_WARNING(
-            "ADIS16470 data processing thread overrun has occurred!");
-        data_to_read = BUFFER_SIZE - (BUFFER_SIZE % dataset_len);
-      }
-      // Read data from DMA buffer (only complete sets)
-      m_spi->ReadAutoReceivedData(buffer, data_to_read, 0_s);
+      // Integrate locally and publish once per batch, so the getters never
+      // wait on this thread
+      bool first_run = false;
+      double integ_angle_x = 0.0;
+      double integ_angle_y = 0.0;
+      double integ_angle_z = 0.0;
+      double gyro_rate_x = 0.0;
+      double gyro_rate_y = 0.0;
+      double gyro_rate_z = 0.0;
+      double accel_x = 0.0;
+      double accel_y = 0.0;
+      double accel_z = 0.0;
+      double accelAngleX = 0.0;
+      double accelAngleY = 0.0;
 
       // Could be multiple data sets in the buffer. Handle each one.
-      for (int i = 0; i < data_to_read; i += dataset_len) {
-        // Timestamp is at buffer[i]
-        m_dt = (buffer[i] - previous_timestamp) / 1000000.0;
+      int frames = receiver.Drain(*m_spi, [&](std::span<const uint32_t> buffer,
+                                              uint64_t timestamp) {
+        m_dt = (timestamp - previous_timestamp) / 1000000.0;
         // Get delta angle value for selected yaw axis and scale by the elapsed
         // time (based on timestamp)
         double elapsed_time =
-            m_scaled_sample_rate / (buffer[i] - previous_timestamp);
+            m_scaled_sample_rate / (timestamp - previous_timestamp);
         double delta_angle_x =
-            ToInt(&buffer[i + 3]) * delta_angle_sf / elapsed_time;
+            ToInt(&buffer[3]) * delta_angle_sf / elapsed_time;
         double delta_angle_y =
-            ToInt(&buffer[i + 7]) * delta_angle_sf / elapsed_time;
+            ToInt(&buffer[7]) * delta_angle_sf / elapsed_time;
         double delta_angle_z =
-            ToInt(&buffer[i + 11]) * delta_angle_sf / elapsed_time;
+            ToInt(&buffer[11]) * delta_angle_sf / elapsed_time;
 
-        double gyro_rate_x = BuffToShort(&buffer[i + 15]) / 10.0;
-        double gyro_rate_y = BuffToShort(&buffer[i + 17]) / 10.0;
-        double gyro_rate_z = BuffToShort(&buffer[i + 19]) / 10.0;
-        double accel_x = BuffToShort(&buffer[i + 21]) / 800.0;
-        double accel_y = BuffToShort(&buffer[i + 23]) / 800.0;
-        double accel_z = BuffToShort(&buffer[i + 25]) / 800.0;
+        gyro_rate_x = BuffToShort(&buffer[15]) / 10.0;
+        gyro_rate_y = BuffToShort(&buffer[17]) / 10.0;
+        gyro_rate_z = BuffToShort(&buffer[19]) / 10.0;
+        accel_x = BuffToShort(&buffer[21]) / 800.0;
+        accel_y = BuffToShort(&buffer[23]) / 800.0;
+        accel_z = BuffToShort(&buffer[25]) / 800.0;
 
         // Convert scaled sensor data to SI units
         double gyro_rate_x_si = gyro_rate_x * kDegToRad;
@@ -656,15 +652,13 @@ void ADIS16470_IMU::Acquire() {
         double accel_z_si = accel_z * kGrav;
 
         // Store timestamp for next iteration
-        previous_timestamp = buffer[i];
+        previous_timestamp = timestamp;
 
         m_alpha = kTau / (kTau + m_dt);
 
         // Run inclinometer calculations
-        double accelAngleX =
-            atan2f(accel_x_si, std::hypotf(accel_y_si, accel_z_si));
-        double accelAngleY =
-            atan2f(accel_y_si, std::hypotf(accel_x_si, accel_z_si));
+        accelAngleX = atan2f(accel_x_si, std::hypotf(accel_y_si, accel_z_si));
+        accelAngleY = atan2f(accel_y_si, std::hypotf(accel_x_si, accel_z_si));
         if (m_first_run) {
           compAngleX = accelAngleX;
           compAngleY = accelAngleY;
@@ -677,33 +671,52 @@ void ADIS16470_IMU::Acquire() {
               CompFilterProcess(compAngleY, accelAngleY, gyro_rate_x_si);
         }
 
-        {
-          std::scoped_lock sync(m_mutex);
-          // Push data to global variables
-          if (m_first_run) {
-            // Don't accumulate first run. previous_timestamp will be "very" old
-            // and the integration will end up way off
-            m_integ_angle_x = 0.0;
-            m_integ_angle_y = 0.0;
-            m_integ_angle_z = 0.0;
-          } else {
-            m_integ_angle_x += delta_angle_x;
-            m_integ_angle_y += delta_angle_y;
-            m_integ_angle_z += delta_angle_z;
-          }
-          m_gyro_rate_x = gyro_rate_x;
-          m_gyro_rate_y = gyro_rate_y;
-          m_gyro_rate_z = gyro_rate_z;
-          m_accel_x = accel_x;
-          m_accel_y = accel_y;
-          m_accel_z = accel_z;
-          m_compAngleX = compAngleX * kRadToDeg;
-          m_compAngleY = compAngleY * kRadToDeg;
-          m_accelAngleX = accelAngleX * kRadToDeg;
-          m_accelAngleY = accelAngleY * kRadToDeg;
+        if (m_first_run) {
+          // Don't accumulate first run. previous_timestamp will be "very" old
+          // and the integration will end up way off
+          first_run = true;
+          integ_angle_x = 0.0;
+          integ_angle_y = 0.0;
+          integ_angle_z = 0.0;
+        } else {
+          integ_angle_x += delta_angle_x;
+          integ_angle_y += delta_angle_y;
+          integ_angle_z += delta_angle_z;
         }
         m_first_run = false;
+      });
+
+      int total_dropped = m_spi->GetAutoDroppedCount();
+      if (total_dropped != dropped) {
+        REPORT_WARNING(
+            "ADIS16470 data processing thread overrun has occurred!");
+        dropped = total_dropped;
       }
+
+      if (frames == 0) {
+        continue;
+      }
+
+      // Push data to global variables
+      if (first_run) {
+        m_integ_angle_x = integ_angle_x;
+        m_integ_angle_y = integ_angle_y;
+        m_integ_angle_z = integ_angle_z;
+      } else {
+        m_integ_angle_x += integ_angle_x;
+        m_integ_angle_y += integ_angle_y;
+        m_integ_angle_z += integ_angle_z;
+      }
+      m_gyro_rate_x = gyro_rate_x;
+      m_gyro_rate_y = gyro_rate_y;
+      m_gyro_rate_z = gyro_rate_z;
+      m_accel_x = accel_x;
+      m_accel_y = accel_y;
+      m_accel_z = accel_z;
+      m_compAngleX = compAngleX * kRadToDeg;
+      m_compAngleY = compAngleY * kRadToDeg;
+      m_accelAngleX = accelAngleX * kRadToDeg;
+      m_accelAngleY = accelAngleY * kRadToDeg;
     } else {
       m_thread_idle = true;
       previous_timestamp = 0;
@@ -771,17 +784,14 @@ void ADIS16470_IMU::SetGyroAngle(IMUAxis axis, units::degree_t angle) {
 }
 
 void ADIS16470_IMU::SetGyroAngleX(units::degree_t angle) {
-  std::scoped_lock sync(m_mutex);
   m_integ_angle_x = angle.value();
 }
 
 void ADIS16470_IMU::SetGyroAngleY(units::degree_t angle) {
-  std::scoped_lock sync(m_mutex);
   m_integ_angle_y = angle.value();
 }
 
 void ADIS16470_IMU::SetGyroAngleZ(units::degree_t angle) {
-  std::scoped_lock sync(m_mutex);
   m_integ_angle_z = angle.value();
 }
 
@@ -805,26 +815,17 @@ units::degree_t ADIS16470_IMU::GetAngle(IMUAxis axis) const {
       if (m_simGyroAngleX) {
         return units::degree_t{m_simGyroAngleX.Get()};
       }
-      {
-        std::scoped_lock sync(m_mutex);
-        return units::degree_t{m_integ_angle_x};
-      }
+      return units::degree_t{m_integ_angle_x.load()};
     case kY:
       if (m_simGyroAngleY) {
         return units::degree_t{m_simGyroAngleY.Get()};
       }
-      {
-        std::scoped_lock sync(m_mutex);
-        return units::degree_t{m_integ_angle_y};
-      }
+      return units::degree_t{m_integ_angle_y.load()};
     case kZ:
       if (m_simGyroAngleZ) {
         return units::degree_t{m_simGyroAngleZ.Get()};
       }
-      {
-        std::scoped_lock sync(m_mutex);
-        return units::degree_t{m_integ_angle_z};
-      }
+      return units::degree_t{m_integ_angle_z.load()};
     default:
       break;
   }
@@ -852,26 +853,17 @@ units::degrees_per_second_t ADIS16470_IMU::GetRate(IMUAxis axis) const {
       if (m_simGyroRateX) {
         return units::degrees_per_second_t{m_simGyroRateX.Get()};
       }
-      {
-        std::scoped_lock sync(m_mutex);
-        return units::degrees_per_second_t{m_gyro_rate_x};
-      }
+      return units::degrees_per_second_t{m_gyro_rate_x.load()};
     case kY:
       if (m_simGyroRateY) {
         return units::degrees_per_second_t{m_simGyroRateY.Get()};
       }
-      {
-        std::scoped_lock sync(m_mutex);
-        return units::degrees_per_second_t{m_gyro_rate_y};
-      }
+      return units::degrees_per_second_t{m_gyro_rate_y.load()};
     case kZ:
       if (m_simGyroRateZ) {
         return units::degrees_per_second_t{m_simGyroRateZ.Get()};
       }
-      {
-        std::scoped_lock sync(m_mutex);
-        return units::degrees_per_second_t{m_gyro_rate_z};
-      }
+      return units::degrees_per_second_t{m_gyro_rate_z.load()};
     default:
       break;
   }
@@ -883,44 +875,37 @@ units::meters_per_second_squared_t ADIS16470_IMU::GetAccelX() const {
   if (m_simAccelX) {
     return units::meters_per_second_squared_t{m_simAccelX.Get()};
   }
-  std::scoped_lock sync(m_mutex);
-  return units::meters_per_second_squared_t{m_accel_x};
+  return units::meters_per_second_squared_t{m_accel_x.load()};
 }
 
 units::meters_per_second_squared_t ADIS16470_IMU::GetAccelY() const {
   if (m_simAccelY) {
     return units::meters_per_second_squared_t{m_simAccelY.Get()};
   }
-  std::scoped_lock sync(m_mutex);
-  return units::meters_per_second_squared_t{m_accel_y};
+  return units::meters_per_second_squared_t{m_accel_y.load()};
 }
 
 units::meters_per_second_squared_t ADIS16470_IMU::GetAccelZ() const {
   if (m_simAccelZ) {
     return units::meters_per_second_squared_t{m_simAccelZ.Get()};
   }
-  std::scoped_lock sync(m_mutex);
-  return units::meters_per_second_squared_t{m_accel_z};
+  return units::meters_per_second_squared_t{m_accel_z.load()};
 }
 
 units::degree_t ADIS16470_IMU::GetXComplementaryAngle() const {
-  std::scoped_lock sync(m_mutex);
-  return units::degree_t{m_compAngleX};
+  return units::degree_t{m_compAngleX.load()};
 }
 
 units::degree_t ADIS16470_IMU::GetYComplementaryAngle() const {
-  std::scoped_lock sync(m_mutex);
-  return units::degree_t{m_compAngleY};
+  return units::degree_t{m_compAngleY.load()};
 }
 
 units::degree_t ADIS16470_IMU::GetXFilteredAccelAngle() const {
-  std::scoped_lock sync(m_mutex);
-  return units::degree_t{m_accelAngleX};
+  return units::degree_t{m_accelAngleX.load()};
 }
 
 units::degree_t ADIS16470_IMU::GetYFilteredAccelAngle() const {
-  std::scoped_lock sync(m_mutex);
-  return units::degree_t{m_accelAngleY};
+  return units::degree_t{m_accelAngleY.load()};
 }
 
 ADIS16470_IMU::IMUAxis ADIS16470_IMU::GetYawAxis() const {
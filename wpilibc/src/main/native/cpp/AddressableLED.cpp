@@ -65,6 +65,13 @@ void AddressableLED::SetData(std::initializer_list<LEDData> ledData) {
   FRC_CheckErrorStatus(status, "Port {}", m_port);
 }
 
+void AddressableLED::SetData(int start, std::span<const LEDData> ledData) {
+  int32_t status = 0;
+  HAL_WriteAddressableLEDDataRange(m_handle, ledData.data(), start,
+                                   ledData.size(), &status);
+  FRC_CheckErrorStatus(status, "Port {}", m_port);
+}
+
 void AddressableLED::SetBitTiming(units::nanosecond_t highTime0,
                                   units::nanosecond_t lowTime0,
                                   units::nanosecond_t highTime1,
@@ -0,0 +1,40 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/AddressableLEDBuffer.h"
+
+#include <algorithm>
+
+using namespace frc;
+
+static bool Equal(const AddressableLED::LEDData& a,
+                  const AddressableLED::LEDData& b) {
+  return a.r == b.r && a.g == b.g && a.b == b.b;
+}
+
+AddressableLEDBuffer::AddressableLEDBuffer(int length)
+    : m_data(length), m_written(length) {}
+
+void AddressableLEDBuffer::Flush(AddressableLED& led) {
+  size_t start = 0;
+  size_t end = m_data.size();
+  if (m_flushed) {
+    // find the changed range
+    auto [dataFirst, writtenFirst] =
+        std::mismatch(m_data.begin(), m_data.end(), m_written.begin(), Equal);
+    if (dataFirst == m_data.end()) {
+      return;
+    }
+    start = dataFirst - m_data.begin();
+    auto [dataLast, writtenLast] = std::mismatch(
+        m_data.rbegin(), m_data.rend(), m_written.rbegin(), Equal);
+    end = m_data.rend() - dataLast;
+  }
+
+  std::span<const AddressableLED::LEDData> changed{m_data.data() + start,
+                                                   end - start};
+  led.SetData(start, changed);
+  std::copy(changed.begin(), changed.end(), m_written.begin() + start);
+  m_flushed = true;
+}
@@ -6,11 +6,187 @@
 
 #include <frc/DigitalSource.h>
 
+#include <algorithm>
+#include <functional>
 #include <memory>
+#include <thread>
 #include <utility>
+#include <vector>
+
+#include <hal/Interrupts.h>
+#include <wpi/condition_variable.h>
+#include <wpi/mutex.h>
+
+#include "frc/Errors.h"
+#include "frc/Threads.h"
 
 using namespace frc;
 
+namespace {
+
+struct DispatchEntry {
+  const AsynchronousInterrupt* owner;
+  HAL_InterruptHandle handle;
+  int64_t risingMask;
+  int64_t fallingMask;
+  std::function<void(bool, bool)>* callback;
+};
+
+// Waits for all enabled interrupts with a single thread and calls their
+// callbacks
+class InterruptDispatcher {
+ public:
+  static InterruptDispatcher& GetInstance() {
+    // never destroyed, as the thread may be waiting in the HAL at exit
+    static auto* inst = new InterruptDispatcher;
+    return *inst;
+  }
+
+  void Add(const DispatchEntry& entry);
+
+  // After this returns, the entry's callback won't be called, unless called
+  // from a callback
+  void Remove(const AsynchronousInterrupt* owner);
+
+  bool SetPriority(bool realTime, int priority);
+
+ private:
+  void ThreadMain();
+  void Wake();
+
+  wpi::mutex m_mutex;
+  wpi::condition_variable m_cond;
+  std::vector<DispatchEntry> m_entries;
+  // incremented on every change to m_entries
+  uint64_t m_generation = 0;
+  // generation of the entries the thread is using
+  uint64_t m_threadGeneration = 0;
+  // handle the thread is waiting with, or invalid if not waiting
+  HAL_InterruptHandle m_waitHandle = HAL_kInvalidHandle;
+  bool m_woken = false;
+  bool m_prioritySet = false;
+  bool m_realTime = false;
+  int m_priority = 0;
+  std::thread m_thread;
+};
+
+}  // namespace
+
+void InterruptDispatcher::Add(const DispatchEntry& entry) {
+  std::scoped_lock lock{m_mutex};
+  m_entries.emplace_back(entry);
+  ++m_generation;
+  if (!m_thread.joinable()) {
+    m_thread = std::thread{[this] { ThreadMain(); }};
+    if (m_prioritySet) {
+      frc::SetThreadPriority(m_thread, m_realTime, m_priority);
+    }
+  }
+  Wake();
+}
+
+void InterruptDispatcher::Remove(const AsynchronousInterrupt* owner) {
+  std::unique_lock lock{m_mutex};
+  auto it = std::find_if(m_entries.begin(), m_entries.end(),
+                         [&](auto&& entry) { return entry.owner == owner; });
+  if (it == m_entries.end()) {
+    return;
+  }
+  m_entries.erase(it);
+  uint64_t generation = ++m_generation;
+  Wake();
+  if (std::this_thread::get_id() == m_thread.get_id()) {
+    return;
+  }
+  // wait for the thread to stop waiting for and dispatching the entry
+  m_cond.wait(lock, [&] { return m_threadGeneration >= generation; });
+}
+
+bool InterruptDispatcher::SetPriority(bool realTime, int priority) {
+  std::scoped_lock lock{m_mutex};
+  m_prioritySet = true;
+  m_realTime = realTime;
+  m_priority = priority;
+  if (m_thread.joinable()) {
+    return frc::SetThreadPriority(m_thread, realTime, priority);
+  }
+  return true;
+}
+
+// must be called with m_mutex held
+void InterruptDispatcher::Wake() {
+  if (m_waitHandle != HAL_kInvalidHandle && !m_woken) {
+    m_woken = true;
+    int32_t status = 0;
+    HAL_ReleaseWaitingInterrupt(m_waitHandle, &status);
+  }
+  m_cond.notify_all();
+}
+
+void InterruptDispatcher::ThreadMain() {
+  std::vector<DispatchEntry> entries;
+  std::unique_lock lock{m_mutex};
+  for (;;) {
+    entries = m_entries;
+    m_threadGeneration = m_generation;
+    m_cond.notify_all();
+    if (entries.empty()) {
+      m_cond.wait(lock, [&] { return m_generation != m_threadGeneration; });
+      continue;
+    }
+
+    int64_t mask = 0;
+    for (auto&& entry : entries) {
+      mask |= entry.risingMask | entry.fallingMask;
+    }
+    auto& waitEntry = entries.front();
+    m_waitHandle = waitEntry.handle;
+    m_woken = false;
+    lock.unlock();
+
+    // Wake() releases the wait handle's interrupt, which reports its edges
+    // whether or not they happened, so remember its timestamps
+    int32_t status = 0;
+    int64_t rising =
+        HAL_ReadInterruptRisingTimestamp(waitEntry.handle, &status);
+    int64_t falling =
+        HAL_ReadInterruptFallingTimestamp(waitEntry.handle, &status);
+    int64_t result = HAL_WaitForMultipleInterrupts(waitEntry.handle, mask,
+                                                   10.0, false, &status);
+
+    lock.lock();
+    m_waitHandle = HAL_kInvalidHandle;
+    if (m_woken) {
+      if (HAL_ReadInterruptRisingTimestamp(waitEntry.handle, &status) ==
+          rising) {
+        result &= ~waitEntry.risingMask;
+      }
+      if (HAL_ReadInterruptFallingTimestamp(waitEntry.handle, &status) ==
+          falling) {
+        result &= ~waitEntry.fallingMask;
+      }
+    }
+
+    for (auto&& entry : entries) {
+      bool risingEdge = (result & entry.risingMask) != 0;
+      bool fallingEdge = (result & entry.fallingMask) != 0;
+      if (!risingEdge && !fallingEdge) {
+        continue;
+      }
+      // skip entries removed since the wait started
+      if (m_generation != m_threadGeneration &&
+          std::none_of(m_entries.begin(), m_entries.end(), [&](auto&& e) {
+            return e.owner == entry.owner;
+          })) {
+        continue;
+      }
+      lock.unlock();
+      (*entry.callback)(risingEdge, fallingEdge);
+      lock.lock();
+    }
+  }
+}
+
 AsynchronousInterrupt::AsynchronousInterrupt(
     DigitalSource& source, std::function<void(bool, bool)> callback)
     : m_interrupt{source}, m_callback{std::move(callback)} {}
@@ -26,35 +202,27 @@ AsynchronousInterrupt::~AsynchronousInterrupt() {
   Disable();
 }
 
-void AsynchronousInterrupt::ThreadMain() {
-  while (m_keepRunning) {
-    auto result = m_interrupt.WaitForInterrupt(10_s, false);
-    if (!m_keepRunning) {
-      break;
-    }
-    if (result == SynchronousInterrupt::WaitResult::kTimeout) {
-      continue;
-    }
-    m_callback((result & SynchronousInterrupt::WaitResult::kRisingEdge) != 0,
-               (result & SynchronousInterrupt::WaitResult::kFallingEdge) != 0);
-  }
-}
-
 void AsynchronousInterrupt::Enable() {
-  if (m_keepRunning) {
+  if (m_enabled.exchange(true)) {
     return;
   }
 
-  m_keepRunning = true;
-  m_thread = std::thread([this] { this->ThreadMain(); });
+  int32_t status = 0;
+  int64_t mask = HAL_GetInterruptMask(m_interrupt.m_handle, &status);
+  if (status != 0) {
+    m_enabled = false;
+    FRC_CheckErrorStatus(status, "Interrupt get mask failed");
+    return;
+  }
+  InterruptDispatcher::GetInstance().Add(
+      {this, m_interrupt.m_handle, mask & 0xFF, mask & 0xFF00, &m_callback});
 }
 
 void AsynchronousInterrupt::Disable() {
-  m_keepRunning = false;
-  m_interrupt.WakeupWaitingInterrupt();
-  if (m_thread.joinable()) {
-    m_thread.join();
+  if (!m_enabled.exchange(false)) {
+    return;
   }
+  InterruptDispatcher::GetInstance().Remove(this);
 }
 
 void AsynchronousInterrupt::SetInterruptEdges(bool risingEdge,
@@ -68,3 +236,8 @@ units::second_t AsynchronousInterrupt::GetRisingTimestamp() {
 units::second_t AsynchronousInterrupt::GetFallingTimestamp() {
   return m_interrupt.GetFallingTimestamp();
 }
+
+bool AsynchronousInterrupt::SetCallbackThreadPriority(bool realTime,
+                                                      int priority) {
+  return InterruptDispatcher::GetInstance().SetPriority(realTime, priority);
+}
@@ -0,0 +1,329 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/CycleProfiler.h"
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <networktables/DoubleTopic.h>
+#include <networktables/IntegerTopic.h>
+#include <networktables/NetworkTable.h>
+#include <wpi/DataLog.h>
+#include <wpi/StringMap.h>
+#include <wpi/mutex.h>
+
+#include "frc/Errors.h"
+
+using namespace frc;
+
+namespace {
+struct Zone {
+  std::string name;
+  std::atomic<int64_t> cycleNs{0};  // accumulated over the current cycle
+  std::atomic<int64_t> cycles{0};
+  std::atomic<int64_t> lastNs{0};
+  std::atomic<int64_t> totalNs{0};
+  std::atomic<int64_t> maxNs{0};
+  std::array<std::atomic<int64_t>, CycleProfiler::kHistoryLength> history{};
+
+  // allocations accumulated over the current cycle
+  std::atomic<int64_t> cycleAllocations{0};
+  std::atomic<int64_t> cycleBytes{0};
+  std::atomic<int64_t> lastAllocations{0};
+  std::atomic<int64_t> lastBytes{0};
+  std::atomic<int64_t> totalAllocations{0};
+};
+
+struct ZoneLogEntries {
+  wpi::log::DoubleLogEntry time;
+  // only started once allocations are tracked
+  wpi::log::IntegerLogEntry allocations;
+  wpi::log::IntegerLogEntry bytes;
+};
+
+struct ZonePublishers {
+  nt::DoublePublisher time;
+  // only started once allocations are tracked
+  nt::IntegerPublisher allocations;
+  nt::IntegerPublisher bytes;
+};
+
+struct Sinks {
+  std::string logPrefix;
+  wpi::log::DataLog* log = nullptr;
+  std::vector<ZoneLogEntries> logEntries;
+  ZoneLogEntries cycleLogEntries;
+
+  std::shared_ptr<nt::NetworkTable> table;
+  std::vector<ZonePublishers> publishers;
+  ZonePublishers cyclePublishers;
+
+  void Publish(int numZones, bool allocations);
+};
+
+struct Instance {
+  std::array<Zone, CycleProfiler::kMaxZones> zones;
+  // zones below this index have their name set
+  std::atomic_int numZones{0};
+  std::atomic<uint64_t> cycle{0};
+
+  wpi::mutex registerMutex;
+  wpi::StringMap<int> zoneIndex;
+
+  // only accessed by EndCycle()
+  wpi::AllocationTracker::Counts cycleStartAllocations;
+  std::atomic<uint64_t> lastCycleAllocations{0};
+  std::atomic<uint64_t> lastCycleDeallocations{0};
+  std::atomic<uint64_t> lastCycleBytes{0};
+
+  wpi::mutex sinksMutex;
+  Sinks sinks;
+};
+}  // namespace
+
+static Instance& GetInstance() {
+  static Instance instance;
+  return instance;
+}
+
+void Sinks::Publish(int numZones, bool allocations) {
+  auto& inst = GetInstance();
+  auto& zones = inst.zones;
+  if (log) {
+    for (int i = logEntries.size(); i < numZones; ++i) {
+      logEntries.emplace_back().time =
+          wpi::log::DoubleLogEntry{*log, logPrefix + zones[i].name};
+    }
+    for (int i = 0; i < numZones; ++i) {
+      auto& entries = logEntries[i];
+      entries.time.Append(zones[i].lastNs.load(std::memory_order_relaxed) /
+                          1.0e9);
+      if (allocations) {
+        if (!entries.allocations) {
+          entries.allocations = wpi::log::IntegerLogEntry{
+              *log, logPrefix + zones[i].name + "/Allocations"};
+          entries.bytes = wpi::log::IntegerLogEntry{
+              *log, logPrefix + zones[i].name + "/AllocatedBytes"};
+        }
+        entries.allocations.Append(
+            zones[i].lastAllocations.load(std::memory_order_relaxed));
+        entries.bytes.Append(
+            zones[i].lastBytes.load(std::memory_order_relaxed));
+      }
+    }
+    if (allocations) {
+      if (!cycleLogEntries.allocations) {
+        cycleLogEntries.allocations =
+            wpi::log::IntegerLogEntry{*log, logPrefix + "Cycle/Allocations"};
+        cycleLogEntries.bytes =
+            wpi::log::IntegerLogEntry{*log, logPrefix + "Cycle/AllocatedBytes"};
+      }
+      cycleLogEntries.allocations.Append(
+          inst.lastCycleAllocations.load(std::memory_order_relaxed));
+      cycleLogEntries.bytes.Append(
+          inst.lastCycleBytes.load(std::memory_order_relaxed));
+    }
+  }
+  if (table) {
+    for (int i = publishers.size(); i < numZones; ++i) {
+      publishers.emplace_back().time =
+          table->GetDoubleTopic(zones[i].name).Publish({.sendAll = true});
+    }
+    for (int i = 0; i < numZones; ++i) {
+      auto& pubs = publishers[i];
+      pubs.time.Set(zones[i].lastNs.load(std::memory_order_relaxed) / 1.0e9);
+      if (allocations) {
+        if (!pubs.allocations) {
+          pubs.allocations =
+              table->GetIntegerTopic(zones[i].name + "/Allocations")
+                  .Publish({.sendAll = true});
+          pubs.bytes = table->GetIntegerTopic(zones[i].name + "/AllocatedBytes")
+                           .Publish({.sendAll = true});
+        }
+        pubs.allocations.Set(
+            zones[i].lastAllocations.load(std::memory_order_relaxed));
+        pubs.bytes.Set(zones[i].lastBytes.load(std::memory_order_relaxed));
+      }
+    }
+    if (allocations) {
+      if (!cyclePublishers.allocations) {
+        cyclePublishers.allocations =
+            table->GetIntegerTopic("Cycle/Allocations")
+                .Publish({.sendAll = true});
+        cyclePublishers.bytes = table->GetIntegerTopic("Cycle/AllocatedBytes")
+                                    .Publish({.sendAll = true});
+      }
+      cyclePublishers.allocations.Set(
+          inst.lastCycleAllocations.load(std::memory_order_relaxed));
+      cyclePublishers.bytes.Set(
+          inst.lastCycleBytes.load(std::memory_order_relaxed));
+    }
+  }
+}
+
+void CycleProfiler::SetEnabled(bool enabled) {
+  s_enabled = enabled;
+}
+
+int CycleProfiler::RegisterZone(std::string_view name) {
+  auto& inst = GetInstance();
+  std::scoped_lock lock{inst.registerMutex};
+  auto [it, isNew] = inst.zoneIndex.try_emplace(name, -1);
+  if (isNew) {
+    int index = inst.numZones.load(std::memory_order_relaxed);
+    if (index >= kMaxZones) {
+      inst.zoneIndex.erase(it);
+      FRC_ReportWarning("CycleProfiler: too many zones, ignoring {}", name);
+      return -1;
+    }
+    inst.zones[index].name = name;
+    inst.numZones.store(index + 1, std::memory_order_release);
+    it->second = index;
+  }
+  return it->second;
+}
+
+void CycleProfiler::Record(int zone, std::chrono::nanoseconds duration) {
+  if (zone < 0 || zone >= kMaxZones) {
+    return;
+  }
+  GetInstance().zones[zone].cycleNs.fetch_add(duration.count(),
+                                              std::memory_order_relaxed);
+}
+
+void CycleProfiler::RecordAllocations(int zone, uint64_t allocations,
+                                      uint64_t bytes) {
+  if (zone < 0 || zone >= kMaxZones || allocations == 0) {
+    return;
+  }
+  auto& z = GetInstance().zones[zone];
+  z.cycleAllocations.fetch_add(allocations, std::memory_order_relaxed);
+  z.cycleBytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void CycleProfiler::EndCycle() {
+  if (!IsEnabled()) {
+    return;
+  }
+  auto& inst = GetInstance();
+  int numZones = inst.numZones.load(std::memory_order_acquire);
+  size_t pos =
+      inst.cycle.fetch_add(1, std::memory_order_relaxed) % kHistoryLength;
+  for (int i = 0; i < numZones; ++i) {
+    auto& zone = inst.zones[i];
+    int64_t ns = zone.cycleNs.exchange(0, std::memory_order_relaxed);
+    zone.history[pos].store(ns, std::memory_order_relaxed);
+    zone.lastNs.store(ns, std::memory_order_relaxed);
+    zone.totalNs.fetch_add(ns, std::memory_order_relaxed);
+    zone.cycles.fetch_add(1, std::memory_order_relaxed);
+    if (ns > zone.maxNs.load(std::memory_order_relaxed)) {
+      zone.maxNs.store(ns, std::memory_order_relaxed);
+    }
+    int64_t allocations =
+        zone.cycleAllocations.exchange(0, std::memory_order_relaxed);
+    zone.lastAllocations.store(allocations, std::memory_order_relaxed);
+    zone.lastBytes.store(zone.cycleBytes.exchange(0, std::memory_order_relaxed),
+                         std::memory_order_relaxed);
+    zone.totalAllocations.fetch_add(allocations, std::memory_order_relaxed);
+  }
+
+  bool trackAllocations = wpi::AllocationTracker::IsEnabled();
+  auto counts = wpi::AllocationTracker::GetThreadCounts();
+  auto& start = inst.cycleStartAllocations;
+  inst.lastCycleAllocations.store(counts.allocations - start.allocations,
+                                  std::memory_order_relaxed);
+  inst.lastCycleDeallocations.store(counts.deallocations - start.deallocations,
+                                    std::memory_order_relaxed);
+  inst.lastCycleBytes.store(counts.bytes - start.bytes,
+                            std::memory_order_relaxed);
+  start = counts;
+
+  std::scoped_lock lock{inst.sinksMutex};
+  inst.sinks.Publish(numZones, trackAllocations);
+}
+
+CycleProfiler::ZoneStats CycleProfiler::GetZoneStats(int zone) {
+  auto& inst = GetInstance();
+  if (zone < 0 || zone >= inst.numZones.load(std::memory_order_acquire)) {
+    return {};
+  }
+  auto& z = inst.zones[zone];
+  ZoneStats stats;
+  stats.cycles = z.cycles.load(std::memory_order_relaxed);
+  stats.last = std::chrono::nanoseconds{z.lastNs.load()};
+  stats.max = std::chrono::nanoseconds{z.maxNs.load()};
+  if (stats.cycles > 0) {
+    stats.average = std::chrono::nanoseconds{z.totalNs.load()} / stats.cycles;
+  }
+  stats.lastAllocations = z.lastAllocations.load(std::memory_order_relaxed);
+  stats.lastAllocatedBytes = z.lastBytes.load(std::memory_order_relaxed);
+  stats.totalAllocations = z.totalAllocations.load(std::memory_order_relaxed);
+  return stats;
+}
+
+wpi::AllocationTracker::Counts CycleProfiler::GetLastCycleAllocations() {
+  auto& inst = GetInstance();
+  return {inst.lastCycleAllocations.load(std::memory_order_relaxed),
+          inst.lastCycleDeallocations.load(std::memory_order_relaxed),
+          inst.lastCycleBytes.load(std::memory_order_relaxed)};
+}
+
+std::vector<units::second_t> CycleProfiler::GetHistory(int zone) {
+  auto& inst = GetInstance();
+  std::vector<units::second_t> history;
+  if (zone < 0 || zone >= inst.numZones.load(std::memory_order_acquire)) {
+    return history;
+  }
+  auto& z = inst.zones[zone];
+  uint64_t cycle = inst.cycle.load(std::memory_order_relaxed);
+  uint64_t count =
+      std::min<uint64_t>({cycle, kHistoryLength,
+                          static_cast<uint64_t>(z.cycles.load())});
+  history.reserve(count);
+  for (uint64_t i = cycle - count; i < cycle; ++i) {
+    history.emplace_back(
+        std::chrono::nanoseconds{z.history[i % kHistoryLength].load()});
+  }
+  return history;
+}
+
+void CycleProfiler::Reset() {
+  auto& inst = GetInstance();
+  for (auto& zone : inst.zones) {
+    zone.cycleNs = 0;
+    zone.cycles = 0;
+    zone.lastNs = 0;
+    zone.totalNs = 0;
+    zone.maxNs = 0;
+    zone.cycleAllocations = 0;
+    zone.cycleBytes = 0;
+    zone.lastAllocations = 0;
+    zone.lastBytes = 0;
+    zone.totalAllocations = 0;
+  }
+  inst.cycleStartAllocations = wpi::AllocationTracker::GetThreadCounts();
+}
+
+void CycleProfiler::StartDataLog(wpi::log::DataLog& log,
+                                 std::string_view prefix) {
+  auto& inst = GetInstance();
+  std::scoped_lock lock{inst.sinksMutex};
+  if (!inst.sinks.log) {
+    inst.sinks.log = &log;
+    inst.sinks.logPrefix = prefix;
+  }
+}
+
+void CycleProfiler::StartNetworkTables(nt::NetworkTableInstance inst,
+                                       std::string_view table) {
+  auto& instance = GetInstance();
+  std::scoped_lock lock{instance.sinksMutex};
+  if (!instance.sinks.table) {
+    instance.sinks.table = inst.GetTable(table);
+  }
+}
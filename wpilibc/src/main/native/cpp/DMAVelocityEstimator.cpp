@@ -0,0 +1,207 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/DMAVelocityEstimator.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <vector>
+
+#include <hal/HALBase.h>
+
+#include "frc/DMASample.h"
+#include "frc/DutyCycleEncoder.h"
+#include "frc/Encoder.h"
+#include "frc/Errors.h"
+#include "frc/MathUtil.h"
+#include "frc/RobotBase.h"
+#include "frc/Threads.h"
+
+using namespace frc;
+
+// samples read from DMA per transfer
+static constexpr size_t kReadBatchSize = 64;
+// DMA queue depth; at 1 ms, enough for the thread to fall a second behind
+static constexpr int kQueueDepth = 1024;
+
+DMAVelocityEstimator::DMAVelocityEstimator(units::second_t period,
+                                           int windowSize)
+    : m_period{period}, m_windowSize{windowSize < 2 ? 2 : windowSize} {}
+
+DMAVelocityEstimator::DMAVelocityEstimator(const Encoder& encoder,
+                                           units::second_t period,
+                                           int windowSize)
+    : DMAVelocityEstimator{period, windowSize} {
+  if constexpr (RobotBase::IsSimulation()) {
+    Start(nullptr, [&encoder] { return encoder.GetDistance(); }, 0);
+  } else {
+    m_dma.AddEncoder(&encoder);
+    Start(
+        [&encoder](DMASample& sample, int32_t* status) {
+          return sample.GetEncoderDistance(&encoder, status);
+        },
+        nullptr, 0);
+  }
+}
+
+DMAVelocityEstimator::DMAVelocityEstimator(const DutyCycleEncoder& encoder,
+                                           units::second_t period,
+                                           int windowSize)
+    : DMAVelocityEstimator{period, windowSize} {
+  if constexpr (RobotBase::IsSimulation()) {
+    Start(nullptr, [&encoder] { return encoder.Get(); }, encoder.m_fullRange);
+  } else {
+    m_dma.AddDutyCycle(encoder.m_dutyCycle.get());
+    Start(
+        [&encoder](DMASample& sample, int32_t* status) {
+          return encoder.MapOutput(
+              sample.GetDutyCycleOutput(encoder.m_dutyCycle.get(), status));
+        },
+        nullptr, encoder.m_fullRange);
+  }
+}
+
+DMAVelocityEstimator::~DMAVelocityEstimator() {
+  m_stop = true;
+  if (m_thread.joinable()) {
+    m_thread.join();
+  }
+  if constexpr (!RobotBase::IsSimulation()) {
+    m_dma.Stop();
+  }
+}
+
+double DMAVelocityEstimator::GetVelocity() const {
+  std::scoped_lock lock{m_mutex};
+  return m_velocity;
+}
+
+double DMAVelocityEstimator::GetPosition() const {
+  std::scoped_lock lock{m_mutex};
+  return m_position;
+}
+
+units::second_t DMAVelocityEstimator::GetTimestamp() const {
+  std::scoped_lock lock{m_mutex};
+  return m_timestamp;
+}
+
+bool DMAVelocityEstimator::SetThreadPriority(bool realTime, int priority) {
+  return frc::SetThreadPriority(m_thread, realTime, priority);
+}
+
+double DMAVelocityEstimator::FitVelocity(std::span<const double> times,
+                                         std::span<const double> positions) {
+  size_t count = std::min(times.size(), positions.size());
+  if (count < 2) {
+    return 0;
+  }
+
+  double meanTime = 0;
+  double meanPosition = 0;
+  for (size_t i = 0; i < count; ++i) {
+    meanTime += times[i];
+    meanPosition += positions[i];
+  }
+  meanTime /= count;
+  meanPosition /= count;
+
+  // slope = cov(t, x) / var(t); centering keeps this well conditioned
+  double covariance = 0;
+  double variance = 0;
+  for (size_t i = 0; i < count; ++i) {
+    double dt = times[i] - meanTime;
+    covariance += dt * (positions[i] - meanPosition);
+    variance += dt * dt;
+  }
+  if (variance == 0) {
+    return 0;
+  }
+  return covariance / variance;
+}
+
+void DMAVelocityEstimator::Start(
+    std::function<double(DMASample&, int32_t*)> readDMA,
+    std::function<double()> readDirect, double wrapRange) {
+  if (readDMA) {
+    m_dma.SetTimedTrigger(m_period);
+    m_dma.Start(kQueueDepth);
+  }
+  m_thread = std::thread{
+      [=, this] { ThreadMain(readDMA, readDirect, wrapRange); }};
+}
+
+void DMAVelocityEstimator::ThreadMain(
+    std::function<double(DMASample&, int32_t*)> readDMA,
+    std::function<double()> readDirect, double wrapRange) {
+  // the window is a ring buffer; the fit doesn't depend on sample order
+  std::vector<double> times(m_windowSize);
+  std::vector<double> positions(m_windowSize);
+  size_t count = 0;
+  size_t next = 0;
+
+  // times are relative to the first sample, to preserve precision
+  uint64_t startTime = 0;
+  uint64_t lastTime = 0;
+  double lastRaw = 0;
+  double position = 0;
+
+  auto addSample = [&](uint64_t time, double raw) {
+    if (count == 0) {
+      startTime = time;
+      position = raw;
+    } else if (wrapRange != 0) {
+      // take the shortest way around
+      position += InputModulus(raw - lastRaw, -wrapRange / 2, wrapRange / 2);
+    } else {
+      position = raw;
+    }
+    lastTime = time;
+    lastRaw = raw;
+    times[next] = (time - startTime) * 1.0e-6;
+    positions[next] = position;
+    next = (next + 1) % times.size();
+    if (count < times.size()) {
+      ++count;
+    }
+  };
+
+  std::array<DMASample, kReadBatchSize> samples;
+  while (!m_stop) {
+    uint64_t prevTime = lastTime;
+    if (readDMA) {
+      int32_t remaining = 0;
+      int32_t status = 0;
+      auto read = DMASample::ReadSamples(&m_dma, samples, 100_ms, &remaining,
+                                         &status);
+      if (status != 0) {
+        FRC_ReportError(status, "DMAVelocityEstimator");
+        return;
+      }
+      for (auto&& sample : read) {
+        status = 0;
+        double raw = readDMA(sample, &status);
+        if (status == 0) {
+          addSample(sample.GetTime(), raw);
+        }
+      }
+    } else {
+      std::this_thread::sleep_for(
+          std::chrono::duration<double>(m_period.value()));
+      int32_t status = 0;
+      addSample(HAL_GetFPGATime(&status), readDirect());
+    }
+
+    if (lastTime == prevTime) {
+      continue;
+    }
+    double velocity = FitVelocity(std::span{times}.first(count),
+                                  std::span{positions}.first(count));
+    std::scoped_lock lock{m_mutex};
+    m_velocity = velocity;
+    m_position = position;
+    m_timestamp = units::second_t{lastTime * 1.0e-6};
+  }
+}
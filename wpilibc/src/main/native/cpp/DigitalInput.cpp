@@ -10,6 +10,7 @@
 #include <hal/FRCUsageReporting.h>
 #include <hal/HALBase.h>
 #include <hal/Ports.h>
+#include <wpi/SmallVector.h>
 #include <wpi/StackTrace.h>
 #include <wpi/sendable/SendableBuilder.h>
 #include <wpi/sendable/SendableRegistry.h>
@@ -42,6 +43,33 @@ bool DigitalInput::Get() const {
   return value;
 }
 
+void DigitalInput::GetBulk(std::span<const DigitalInput* const> inputs,
+                           std::span<bool> values) {
+  if (values.size() != inputs.size()) {
+    throw FRC_MakeError(err::InvalidParameter,
+                        "values size {} does not match inputs size {}",
+                        values.size(), inputs.size());
+  }
+  wpi::SmallVector<HAL_DigitalHandle, 32> handles;
+  handles.reserve(inputs.size());
+  for (auto input : inputs) {
+    handles.emplace_back(input->m_handle);
+  }
+  wpi::SmallVector<HAL_Bool, 32> halValues;
+  halValues.resize(inputs.size());
+  int32_t status = 0;
+  int32_t count =
+      HAL_GetDIOBulk(handles.data(), halValues.data(),
+                     static_cast<int32_t>(handles.size()), &status);
+  if (status != 0) {
+    // count is the index of the channel that failed
+    FRC_CheckErrorStatus(status, "Channel {}", inputs[count]->m_channel);
+  }
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = halValues[i];
+  }
+}
+
 HAL_Handle DigitalInput::GetPortHandleForRouting() const {
   return m_handle;
 }
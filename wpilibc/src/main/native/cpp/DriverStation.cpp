@@ -6,6 +6,7 @@
 
 #include <stdint.h>
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <memory>
@@ -351,6 +352,32 @@ int DriverStation::GetStickButtons(int stick) {
   return buttons.buttons;
 }
 
+DriverStation::JoystickSnapshot DriverStation::GetJoystickSnapshot(int stick) {
+  static_assert(kJoystickPorts == HAL_kMaxJoysticks);
+  static_assert(kMaxJoystickAxes == HAL_kMaxJoystickAxes);
+  static_assert(kMaxJoystickPOVs == HAL_kMaxJoystickPOVs);
+
+  JoystickSnapshot snapshot;
+  if (stick < 0 || stick >= kJoystickPorts) {
+    FRC_ReportError(warn::BadJoystickIndex, "stick {} out of range", stick);
+    return snapshot;
+  }
+
+  // reading all sticks at once returns a consistent set of data
+  HAL_JoystickAxes axes[HAL_kMaxJoysticks];
+  HAL_JoystickPOVs povs[HAL_kMaxJoysticks];
+  HAL_JoystickButtons buttons[HAL_kMaxJoysticks];
+  HAL_GetAllJoystickData(axes, povs, buttons);
+
+  snapshot.axisCount = axes[stick].count;
+  std::copy_n(axes[stick].axes, kMaxJoystickAxes, snapshot.axes.begin());
+  snapshot.povCount = povs[stick].count;
+  std::copy_n(povs[stick].povs, kMaxJoystickPOVs, snapshot.povs.begin());
+  snapshot.buttonCount = buttons[stick].count;
+  snapshot.buttons = buttons[stick].buttons;
+  return snapshot;
+}
+
 int DriverStation::GetStickAxisCount(int stick) {
   if (stick < 0 || stick >= kJoystickPorts) {
     FRC_ReportError(warn::BadJoystickIndex, "stick {} out of range", stick);
@@ -127,6 +127,10 @@ double DutyCycleEncoder::Get() const {
     pos = highTime / m_period;
   }
 
+  return MapOutput(pos);
+}
+
+double DutyCycleEncoder::MapOutput(double pos) const {
   // Map sensor range if range isn't full
   pos = MapSensorRange(pos);
 
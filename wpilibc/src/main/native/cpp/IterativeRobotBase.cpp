@@ -9,8 +9,10 @@
 #include <hal/DriverStation.h>
 #include <hal/FRCUsageReporting.h>
 #include <networktables/NetworkTableInstance.h>
+#include <wpi/MonotonicArena.h>
 #include <wpi/print.h>
 
+#include "frc/CycleProfiler.h"
 #include "frc/DSControlWord.h"
 #include "frc/Errors.h"
 #include "frc/livewindow/LiveWindow.h"
@@ -120,6 +122,9 @@ units::second_t IterativeRobotBase::GetPeriod() const {
 }
 
 void IterativeRobotBase::LoopFunc() {
+  // free temporary allocations made during the previous loop
+  wpi::GetThreadArena().Reset();
+
   DriverStation::RefreshData();
   m_watchdog.Reset();
 
@@ -227,6 +232,8 @@ void IterativeRobotBase::LoopFunc() {
   if (m_watchdog.IsExpired()) {
     m_watchdog.PrintEpochs();
   }
+
+  CycleProfiler::EndCycle();
 }
 
 void IterativeRobotBase::PrintLoopOverrunMessage() {
@@ -7,7 +7,6 @@
 #include <algorithm>
 #include <cmath>
 #include <numbers>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -38,6 +37,20 @@ void LEDPattern::ApplyTo(std::span<AddressableLED::LEDData> data) const {
   ApplyTo(data, [&](int index, Color color) { data[index].SetLED(color); });
 }
 
+// Applies a pattern with every index shifted by offset.  Used by the
+// scrolling patterns, which compute the offset once per buffer rather than
+// reading the time for every LED.
+static void ApplyOffset(const LEDPattern& pattern, LEDPattern::LEDReader data,
+                        std::function<void(int, Color)> writer,
+                        int64_t offset) {
+  int bufLen = static_cast<int>(data.size());
+  auto mapIndex = [=](int i) { return frc::FloorMod(i + offset, bufLen); };
+  pattern.ApplyTo(
+      LEDPattern::LEDReader{[&](int i) { return data[mapIndex(i)]; },
+                            data.size()},
+      [&](int i, Color color) { writer(mapIndex(i), color); });
+}
+
 LEDPattern LEDPattern::MapIndex(
     std::function<size_t(size_t, size_t)> indexMapper) {
   return LEDPattern{[self = *this, indexMapper](auto data, auto writer) {
@@ -66,17 +79,17 @@ LEDPattern LEDPattern::ScrollAtRelativeSpeed(units::hertz_t velocity) {
   // Invert and multiply by 1,000,000 to get microseconds
   double periodMicros = 1e6 / velocity.value();
 
-  return MapIndex([=](size_t bufLen, size_t i) {
+  return LEDPattern{[=, self = *this](auto data, auto writer) {
     auto now = wpi::Now();
+    size_t bufLen = data.size();
 
     // index should move by (bufLen) / (period)
     double t =
         (now % static_cast<int64_t>(std::floor(periodMicros))) / periodMicros;
     int offset = static_cast<int>(std::floor(t * bufLen));
 
-    return frc::FloorMod(static_cast<int>(i) + offset,
-                         static_cast<int>(bufLen));
-  });
+    ApplyOffset(self, data, writer, offset);
+  }};
 }
 
 LEDPattern LEDPattern::ScrollAtAbsoluteSpeed(
@@ -86,7 +99,7 @@ LEDPattern LEDPattern::ScrollAtAbsoluteSpeed(
   auto microsPerLed =
       static_cast<int64_t>(std::floor((ledSpacing / velocity).value() * 1e6));
 
-  return MapIndex([=](size_t bufLen, size_t i) {
+  return LEDPattern{[=, self = *this](auto data, auto writer) {
     auto now = wpi::Now();
 
     // every step in time that's a multiple of microsPerLED will increment
@@ -95,9 +108,8 @@ LEDPattern LEDPattern::ScrollAtAbsoluteSpeed(
     // offset values for negative velocities
     auto offset = static_cast<int64_t>(now) / microsPerLed;
 
-    return frc::FloorMod(static_cast<int>(i) + offset,
-                         static_cast<int>(bufLen));
-  });
+    ApplyOffset(self, data, writer, offset);
+  }};
 }
 
 LEDPattern LEDPattern::Blink(units::second_t onTime, units::second_t offTime) {
@@ -131,15 +143,15 @@ LEDPattern LEDPattern::Breathe(units::second_t period) {
   auto periodMicros = units::microsecond_t{period};
 
   return LEDPattern{[periodMicros, self = *this](auto data, auto writer) {
-    self.ApplyTo(data, [&writer, periodMicros](int i, Color color) {
-      double t = (wpi::Now() % periodMicros.to<uint64_t>()) /
-                 periodMicros.to<double>();
-      double phase = t * 2 * std::numbers::pi;
+    double t = (wpi::Now() % periodMicros.to<uint64_t>()) /
+               periodMicros.to<double>();
+    double phase = t * 2 * std::numbers::pi;
 
-      // Apply the cosine function and shift its output from [-1, 1] to [0, 1]
-      // Use cosine so the period starts at 100% brightness
-      double dim = (std::cos(phase) + 1) / 2.0;
+    // Apply the cosine function and shift its output from [-1, 1] to [0, 1]
+    // Use cosine so the period starts at 100% brightness
+    double dim = (std::cos(phase) + 1) / 2.0;
 
+    self.ApplyTo(data, [&writer, dim](int i, Color color) {
       writer(i, Color{color.red * dim, color.green * dim, color.blue * dim});
     });
   }};
@@ -245,17 +257,28 @@ LEDPattern LEDPattern::Steps(std::span<const std::pair<double, Color>> steps) {
                         auto data, auto writer) {
     auto bufLen = data.size();
 
-    // precompute relevant positions for this buffer so we don't need to do a
-    // check on every single LED index
-    std::unordered_map<int, Color> stopPositions;
-
+    // precompute relevant positions for this buffer, sorted so they can be
+    // walked alongside the LED index instead of looked up for every LED
+    std::vector<std::pair<int, Color>> stopPositions;
+    stopPositions.reserve(steps.size());
     for (auto step : steps) {
-      stopPositions[std::floor(step.first * bufLen)] = step.second;
+      stopPositions.emplace_back(std::floor(step.first * bufLen), step.second);
+    }
+    // stable so the last of several steps at the same position wins
+    std::stable_sort(
+        stopPositions.begin(), stopPositions.end(),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    auto stop = stopPositions.begin();
+    while (stop != stopPositions.end() && stop->first < 0) {
+      ++stop;
     }
     auto currentColor = Color::kBlack;
     for (size_t led = 0; led < bufLen; led++) {
-      if (stopPositions.contains(led)) {
-        currentColor = stopPositions[led];
+      while (stop != stopPositions.end() &&
+             stop->first == static_cast<int>(led)) {
+        currentColor = stop->second;
+        ++stop;
       }
       writer(led, currentColor);
     }
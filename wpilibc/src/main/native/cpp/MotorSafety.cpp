@@ -5,11 +5,13 @@
 #include "frc/MotorSafety.h"
 
 #include <algorithm>
+#include <atomic>
 #include <utility>
 
 #include <hal/DriverStation.h>
 #include <wpi/SafeThread.h>
 #include <wpi/SmallPtrSet.h>
+#include <wpi/mutex.h>
 
 #include "frc/DriverStation.h"
 #include "frc/Errors.h"
@@ -100,59 +102,52 @@ MotorSafety::~MotorSafety() {
 }
 
 MotorSafety::MotorSafety(MotorSafety&& rhs)
-    : m_expiration(std::move(rhs.m_expiration)),
-      m_enabled(std::move(rhs.m_enabled)),
-      m_stopTime(std::move(rhs.m_stopTime)) {}
+    : m_expiration(rhs.m_expiration.load(std::memory_order_relaxed)),
+      m_enabled(rhs.m_enabled.load(std::memory_order_relaxed)),
+      m_stopTime(rhs.m_stopTime.load(std::memory_order_relaxed)) {}
 
 MotorSafety& MotorSafety::operator=(MotorSafety&& rhs) {
-  std::scoped_lock lock(m_thisMutex, rhs.m_thisMutex);
-
-  m_expiration = std::move(rhs.m_expiration);
-  m_enabled = std::move(rhs.m_enabled);
-  m_stopTime = std::move(rhs.m_stopTime);
+  m_expiration.store(rhs.m_expiration.load(std::memory_order_relaxed),
+                     std::memory_order_relaxed);
+  m_enabled.store(rhs.m_enabled.load(std::memory_order_relaxed),
+                  std::memory_order_relaxed);
+  m_stopTime.store(rhs.m_stopTime.load(std::memory_order_relaxed),
+                   std::memory_order_relaxed);
 
   return *this;
 }
 
 void MotorSafety::Feed() {
-  std::scoped_lock lock(m_thisMutex);
-  m_stopTime = Timer::GetFPGATimestamp() + m_expiration;
+  m_stopTime.store(Timer::GetFPGATimestamp().value() +
+                       m_expiration.load(std::memory_order_relaxed),
+                   std::memory_order_relaxed);
 }
 
 void MotorSafety::SetExpiration(units::second_t expirationTime) {
-  std::scoped_lock lock(m_thisMutex);
-  m_expiration = expirationTime;
+  m_expiration.store(expirationTime.value(), std::memory_order_relaxed);
 }
 
 units::second_t MotorSafety::GetExpiration() const {
-  std::scoped_lock lock(m_thisMutex);
-  return m_expiration;
+  return units::second_t{m_expiration.load(std::memory_order_relaxed)};
 }
 
 bool MotorSafety::IsAlive() const {
-  std::scoped_lock lock(m_thisMutex);
-  return !m_enabled || m_stopTime > Timer::GetFPGATimestamp();
+  return !m_enabled.load(std::memory_order_relaxed) ||
+         m_stopTime.load(std::memory_order_relaxed) >
+             Timer::GetFPGATimestamp().value();
 }
 
 void MotorSafety::SetSafetyEnabled(bool enabled) {
-  std::scoped_lock lock(m_thisMutex);
-  m_enabled = enabled;
+  m_enabled.store(enabled, std::memory_order_relaxed);
 }
 
 bool MotorSafety::IsSafetyEnabled() const {
-  std::scoped_lock lock(m_thisMutex);
-  return m_enabled;
+  return m_enabled.load(std::memory_order_relaxed);
 }
 
 void MotorSafety::Check() {
-  bool enabled;
-  units::second_t stopTime;
-
-  {
-    std::scoped_lock lock(m_thisMutex);
-    enabled = m_enabled;
-    stopTime = m_stopTime;
-  }
+  bool enabled = m_enabled.load(std::memory_order_relaxed);
+  units::second_t stopTime{m_stopTime.load(std::memory_order_relaxed)};
 
   if (!enabled || DriverStation::IsDisabled() || DriverStation::IsTest()) {
     return;
@@ -10,6 +10,7 @@
 #include <hal/HALBase.h>
 #include <hal/PWM.h>
 #include <hal/Ports.h>
+#include <wpi/SmallVector.h>
 #include <wpi/StackTrace.h>
 #include <wpi/sendable/SendableBuilder.h>
 #include <wpi/sendable/SendableRegistry.h>
@@ -85,6 +86,28 @@ void PWM::SetSpeed(double speed) {
   FRC_CheckErrorStatus(status, "Channel {}", m_channel);
 }
 
+void PWM::SetSpeedBulk(std::span<PWM* const> pwms,
+                       std::span<const double> speeds) {
+  if (speeds.size() != pwms.size()) {
+    throw FRC_MakeError(err::InvalidParameter,
+                        "speeds size {} does not match pwms size {}",
+                        speeds.size(), pwms.size());
+  }
+  wpi::SmallVector<HAL_DigitalHandle, 16> handles;
+  handles.reserve(pwms.size());
+  for (auto pwm : pwms) {
+    handles.emplace_back(pwm->m_handle);
+  }
+  int32_t status = 0;
+  int32_t count =
+      HAL_SetPWMSpeedBulk(handles.data(), speeds.data(),
+                          static_cast<int32_t>(handles.size()), &status);
+  if (status != 0) {
+    // count is the index of the channel that failed
+    FRC_CheckErrorStatus(status, "Channel {}", pwms[count]->m_channel);
+  }
+}
+
 double PWM::GetSpeed() const {
   int32_t status = 0;
   double speed = HAL_GetPWMSpeed(m_handle, &status);
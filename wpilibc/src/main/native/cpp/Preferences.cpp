@@ -5,7 +5,9 @@
 #include "frc/Preferences.h"
 
 #include <memory>
+#include <optional>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #include <fmt/format.h>
@@ -41,6 +43,47 @@ static Instance& GetInstance() {
   return instance;
 }
 
+// Converts a value received for a preference to the handle's type
+template <typename T>
+static std::optional<T> ConvertValue(const nt::Value& value) {
+  if constexpr (std::is_same_v<T, bool>) {
+    if (value.IsBoolean()) {
+      return value.GetBoolean();
+    }
+  } else {
+    if (value.IsDouble()) {
+      return static_cast<T>(value.GetDouble());
+    } else if (value.IsInteger()) {
+      return static_cast<T>(value.GetInteger());
+    } else if (value.IsFloat()) {
+      return static_cast<T>(value.GetFloat());
+    }
+  }
+  return std::nullopt;
+}
+
+template <typename T>
+static void SetEntry(nt::NetworkTableEntry& entry, T value) {
+  if constexpr (std::is_same_v<T, bool>) {
+    entry.SetBoolean(value);
+  } else if constexpr (std::is_same_v<T, double>) {
+    entry.SetDouble(value);
+  } else {
+    entry.SetInteger(value);
+  }
+}
+
+template <typename T>
+static void SetDefaultEntry(nt::NetworkTableEntry& entry, T value) {
+  if constexpr (std::is_same_v<T, bool>) {
+    entry.SetDefaultBoolean(value);
+  } else if constexpr (std::is_same_v<T, double>) {
+    entry.SetDefaultDouble(value);
+  } else {
+    entry.SetDefaultInteger(value);
+  }
+}
+
 #ifndef __FRC_ROBORIO__
 namespace frc::impl {
 void ResetPreferencesInstance() {
@@ -168,6 +211,57 @@ void Preferences::RemoveAll() {
   }
 }
 
+Preferences::DoubleHandle Preferences::GetDoubleHandle(std::string_view key,
+                                                       double defaultValue) {
+  return MakeHandle(key, defaultValue);
+}
+
+Preferences::BooleanHandle Preferences::GetBooleanHandle(std::string_view key,
+                                                         bool defaultValue) {
+  return MakeHandle(key, defaultValue);
+}
+
+Preferences::LongHandle Preferences::GetLongHandle(std::string_view key,
+                                                   int64_t defaultValue) {
+  return MakeHandle(key, defaultValue);
+}
+
+template <typename T>
+Preferences::Handle<T> Preferences::MakeHandle(std::string_view key,
+                                               T defaultValue) {
+  Handle<T> handle;
+  handle.m_entry = ::GetInstance().table->GetEntry(key);
+  SetDefaultEntry(handle.m_entry, defaultValue);
+  handle.m_entry.SetPersistent();
+
+  handle.m_value = std::make_shared<std::atomic<T>>(
+      ConvertValue<T>(handle.m_entry.GetValue()).value_or(defaultValue));
+  // The immediate event repeats the current value, so values are always
+  // stored in the order they were set
+  handle.m_listener = nt::NetworkTableListener::CreateListener(
+      handle.m_entry, NT_EVENT_VALUE_ALL | NT_EVENT_IMMEDIATE,
+      [value = handle.m_value](const nt::Event& event) {
+        if (auto valueData = event.GetValueEventData()) {
+          if (auto converted = ConvertValue<T>(valueData->value)) {
+            value->store(*converted, std::memory_order_relaxed);
+          }
+        }
+      });
+  return handle;
+}
+
+template <typename T>
+void Preferences::Handle<T>::Set(T value) {
+  if (m_value) {
+    m_value->store(value, std::memory_order_relaxed);
+    SetEntry(m_entry, value);
+  }
+}
+
+template class Preferences::Handle<double>;
+template class Preferences::Handle<bool>;
+template class Preferences::Handle<int64_t>;
+
 Instance::Instance() {
   typePublisher.Set(kSmartDashboardType);
   listener = nt::NetworkTableListener::CreateListener(
@@ -0,0 +1,45 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/SPIAutoReceiver.h"
+
+#include <algorithm>
+
+#include "frc/RobotController.h"
+#include "frc/SPI.h"
+
+using namespace frc;
+
+SPIAutoReceiver::SPIAutoReceiver(int frameSize, int maxFrames)
+    : m_frameSize{frameSize},
+      m_buffer(static_cast<size_t>(frameSize) * maxFrames) {}
+
+int SPIAutoReceiver::Drain(
+    SPI& spi,
+    wpi::function_ref<void(std::span<const uint32_t> frame,
+                           uint64_t timestamp)>
+        func) {
+  // Only process what is available now, so a fast sensor can't keep us here
+  int available = spi.ReadAutoReceivedData(m_buffer.data(), 0, 0_s);
+  available -= available % m_frameSize;
+  int maxWords = static_cast<int>(m_buffer.size());
+  int frames = 0;
+  while (available > 0) {
+    int toRead = std::min(available, maxWords);
+    spi.ReadAutoReceivedData(m_buffer.data(), toRead, 0_s);
+    available -= toRead;
+
+    // Every frame was received before now, so extend the 32-bit timestamps
+    // relative to the current 64-bit time
+    uint64_t now = RobotController::GetFPGATime();
+    uint32_t now32 = static_cast<uint32_t>(now);
+    for (int i = 0; i < toRead; i += m_frameSize) {
+      uint64_t timestamp = now - static_cast<uint32_t>(now32 - m_buffer[i]);
+      func({m_buffer.data() + i, static_cast<size_t>(m_frameSize)},
+           timestamp);
+      ++frames;
+    }
+  }
+  return frames;
+}
@@ -6,9 +6,12 @@
 
 #include <stdint.h>
 
+#include <algorithm>
+#include <bit>
 #include <cstdio>
 #include <utility>
 
+#include <fmt/format.h>
 #include <hal/DriverStation.h>
 #include <hal/FRCUsageReporting.h>
 #include <hal/Notifier.h>
@@ -46,9 +49,8 @@ void TimedRobot::StartCompetition() {
       break;
     }
 
-    m_loopStartTimeUs = RobotController::GetFPGATime();
-
-    callback.func();
+    auto now = RunCallback(
+        callback, std::chrono::microseconds{RobotController::GetFPGATime()});
 
     // Increment the expiration time by the number of full periods it's behind
     // plus one to avoid rapid repeat fires from a large loop overrun. We assume
@@ -63,7 +65,7 @@ void TimedRobot::StartCompetition() {
     while (m_callbacks.top().expirationTime <= currentTime) {
       callback = m_callbacks.pop();
 
-      callback.func();
+      now = RunCallback(callback, now);
 
       callback.expirationTime +=
           callback.period + (currentTime - callback.expirationTime) /
@@ -103,10 +105,75 @@ uint64_t TimedRobot::GetLoopStartTime() {
   return m_loopStartTimeUs;
 }
 
-void TimedRobot::AddPeriodic(std::function<void()> callback,
-                             units::second_t period, units::second_t offset) {
-  m_callbacks.emplace(
-      callback, m_startTime,
+int TimedRobot::AddPeriodic(std::function<void()> callback,
+                            units::second_t period, units::second_t offset) {
+  Callback entry{
+      std::move(callback), m_startTime,
       std::chrono::microseconds{static_cast<int64_t>(period.value() * 1e6)},
-      std::chrono::microseconds{static_cast<int64_t>(offset.value() * 1e6)});
+      std::chrono::microseconds{static_cast<int64_t>(offset.value() * 1e6)}};
+  entry.stats = AddStats();
+  m_callbacks.push(std::move(entry));
+  return m_stats.size() - 1;
+}
+
+int TimedRobot::AddPeriodicThread(std::function<void()> callback,
+                                  units::second_t period, int priority) {
+  auto stats = AddStats();
+  std::chrono::microseconds periodUs{
+      static_cast<int64_t>(period.value() * 1e6)};
+  auto& notifier = m_threads.emplace_back(std::make_unique<Notifier>(
+      priority, [stats, periodUs, callback = std::move(callback)] {
+        std::chrono::microseconds start{RobotController::GetFPGATime()};
+        callback();
+        auto duration =
+            std::chrono::microseconds{RobotController::GetFPGATime()} - start;
+        stats->Record(duration, duration > periodUs);
+      }));
+  notifier->SetName(fmt::format("TimedRobot{}", m_stats.size() - 1));
+  notifier->StartPeriodic(period);
+  return m_stats.size() - 1;
+}
+
+TimedRobot::CallbackStats TimedRobot::GetCallbackStats(int callback) const {
+  if (callback < 0 || static_cast<size_t>(callback) >= m_stats.size()) {
+    throw FRC_MakeError(err::ParameterOutOfRange, "callback {}", callback);
+  }
+  auto& entry = *m_stats[callback];
+  std::scoped_lock lock{entry.mutex};
+  return entry.stats;
+}
+
+void TimedRobot::StatsEntry::Record(std::chrono::microseconds duration,
+                                    bool missed) {
+  // bucket i holds durations below 64 << i us
+  auto us = static_cast<uint64_t>(std::max<int64_t>(duration.count(), 0));
+  size_t bucket = std::min<size_t>(std::bit_width(us >> 6),
+                                   kNumHistogramBuckets - 1);
+  units::second_t seconds = duration;
+
+  std::scoped_lock lock{mutex};
+  ++stats.runs;
+  if (missed) {
+    ++stats.deadlineMisses;
+  }
+  stats.lastDuration = seconds;
+  stats.maxDuration = units::math::max(stats.maxDuration, seconds);
+  ++stats.histogram[bucket];
+}
+
+TimedRobot::StatsEntry* TimedRobot::AddStats() {
+  return m_stats.emplace_back(std::make_unique<StatsEntry>()).get();
+}
+
+std::chrono::microseconds TimedRobot::RunCallback(
+    Callback& callback, std::chrono::microseconds startTime) {
+  m_loopStartTimeUs = startTime.count();
+
+  callback.func();
+
+  std::chrono::microseconds endTime{RobotController::GetFPGATime()};
+  // A run misses its deadline if it's still going when the next one is due
+  callback.stats->Record(endTime - startTime,
+                         endTime > callback.expirationTime + callback.period);
+  return endTime;
 }
@@ -8,6 +8,7 @@
 #include <wpi/SmallString.h>
 #include <wpi/raw_ostream.h>
 
+#include "frc/CycleProfiler.h"
 #include "frc/Errors.h"
 
 using namespace frc;
@@ -18,6 +19,7 @@ Tracer::Tracer() {
 
 void Tracer::ResetTimer() {
   m_startTime = hal::fpga_clock::now();
+  m_startAllocations = wpi::AllocationTracker::GetThreadCounts();
 }
 
 void Tracer::ClearEpochs() {
@@ -28,7 +30,16 @@ void Tracer::ClearEpochs() {
 void Tracer::AddEpoch(std::string_view epochName) {
   auto currentTime = hal::fpga_clock::now();
   m_epochs[epochName] = currentTime - m_startTime;
+  auto allocations = wpi::AllocationTracker::GetThreadCounts();
+  if (CycleProfiler::IsEnabled()) {
+    int zone = CycleProfiler::RegisterZone(epochName);
+    CycleProfiler::Record(zone, currentTime - m_startTime);
+    CycleProfiler::RecordAllocations(
+        zone, allocations.allocations - m_startAllocations.allocations,
+        allocations.bytes - m_startAllocations.bytes);
+  }
   m_startTime = currentTime;
+  m_startAllocations = allocations;
 }
 
 void Tracer::PrintEpochs() {
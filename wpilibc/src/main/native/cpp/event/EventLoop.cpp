@@ -32,6 +32,7 @@ void EventLoop::Bind(wpi::unique_function<void()> action) {
 
 void EventLoop::Poll() {
   RunningSetter runSetter{m_running};
+  ++m_pollCount;
   for (wpi::unique_function<void()>& action : m_bindings) {
     action();
   }
@@ -41,6 +41,8 @@ void ComplexWidget::BuildInto(std::shared_ptr<nt::NetworkTable> parentTable,
         .SetTable(parentTable->GetSubTable(GetTitle()));
     m_sendable.InitSendable(static_cast<SendableBuilderImpl&>(*m_builder));
     static_cast<SendableBuilderImpl&>(*m_builder).StartListeners();
+  } else if (!ShouldUpdateValue()) {
+    return;
   }
   m_builder->Update();
 }
@@ -4,9 +4,12 @@
 
 #include "frc/shuffleboard/ShuffleboardComponentBase.h"
 
+#include <cmath>
 #include <memory>
 #include <string>
 
+#include "frc/RobotController.h"
+
 using namespace frc;
 
 ShuffleboardComponentBase::ShuffleboardComponentBase(
@@ -52,6 +55,22 @@ void ShuffleboardComponentBase::BuildMetadata(
   m_metadataDirty = false;
 }
 
+bool ShuffleboardComponentBase::ShouldUpdateValue() {
+  if (m_updatePeriod <= 0_s) {
+    return true;
+  }
+  // compare in integer microseconds, so periods made of several steps of
+  // simulated time aren't lost to rounding
+  uint64_t now = RobotController::GetFPGATime();
+  uint64_t period = std::llround(units::microsecond_t{m_updatePeriod}.value());
+  if (m_valueUpdated && now - m_lastValueUpdate < period) {
+    return false;
+  }
+  m_lastValueUpdate = now;
+  m_valueUpdated = true;
+  return true;
+}
+
 ShuffleboardContainer& ShuffleboardComponentBase::GetParent() {
   return m_parent;
 }
@@ -10,6 +10,7 @@
 #include <vector>
 
 #include <ntcore_cpp.h>
+#include <wpi/json.h>
 #include <wpi/sendable/SendableRegistry.h>
 
 #include "frc/Errors.h"
@@ -20,6 +21,8 @@
 
 using namespace frc;
 
+static constexpr std::string_view kSmartDashboardType = "ShuffleboardLayout";
+
 static constexpr const char* layoutStrings[] = {"List Layout", "Grid Layout"};
 
 static constexpr const char* GetStringFromBuiltInLayout(BuiltInLayouts layout) {
@@ -34,6 +37,28 @@ ShuffleboardContainer::GetComponents() const {
   return m_components;
 }
 
+void ShuffleboardContainer::InitTable(
+    const std::shared_ptr<nt::NetworkTable>& parentTable) {
+  if (!m_table) {
+    m_table = parentTable->GetSubTable(GetTitle());
+    auto typeEntry = m_table->GetEntry(".type");
+    typeEntry.SetString(kSmartDashboardType);
+    typeEntry.GetTopic().SetProperty("SmartDashboard", kSmartDashboardType);
+  }
+}
+
+void ShuffleboardContainer::BuildComponents(
+    const std::shared_ptr<nt::NetworkTable>& metaTable) {
+  // components are only ever appended
+  for (size_t i = m_componentMetaTables.size(); i < m_components.size(); ++i) {
+    m_componentMetaTables.emplace_back(
+        metaTable->GetSubTable(m_components[i]->GetTitle()));
+  }
+  for (size_t i = 0; i < m_components.size(); ++i) {
+    m_components[i]->BuildInto(m_table, m_componentMetaTables[i]);
+  }
+}
+
 ShuffleboardLayout& ShuffleboardContainer::GetLayout(std::string_view title,
                                                      BuiltInLayouts type) {
   return GetLayout(title, GetStringFromBuiltInLayout(type));
@@ -6,6 +6,8 @@
 
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <hal/FRCUsageReporting.h>
 #include <networktables/NetworkTable.h>
@@ -19,6 +21,9 @@ using namespace frc::detail;
 
 struct ShuffleboardInstance::Impl {
   wpi::StringMap<ShuffleboardTab> tabs;
+  // tabs with their metadata tables, in creation order
+  std::vector<std::pair<ShuffleboardTab*, std::shared_ptr<nt::NetworkTable>>>
+      tabMetaTables;
 
   bool tabsChanged = false;
   std::shared_ptr<nt::NetworkTable> rootTable;
@@ -47,6 +52,8 @@ frc::ShuffleboardTab& ShuffleboardInstance::GetTab(std::string_view title) {
   auto [it, added] = m_impl->tabs.try_emplace(title, *this, title);
   if (added) {
     m_impl->tabsChanged = true;
+    m_impl->tabMetaTables.emplace_back(
+        &it->second, m_impl->rootMetaTable->GetSubTable(title));
   }
   return it->second;
 }
@@ -60,10 +67,8 @@ void ShuffleboardInstance::Update() {
     m_impl->rootMetaTable->GetEntry("Tabs").SetStringArray(tabTitles);
     m_impl->tabsChanged = false;
   }
-  for (auto& entry : m_impl->tabs) {
-    auto& tab = entry.second;
-    tab.BuildInto(m_impl->rootTable,
-                  m_impl->rootMetaTable->GetSubTable(tab.GetTitle()));
+  for (auto& [tab, metaTable] : m_impl->tabMetaTables) {
+    tab->BuildInto(m_impl->rootTable, metaTable);
   }
 }
 
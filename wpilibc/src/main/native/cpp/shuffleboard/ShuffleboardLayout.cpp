@@ -6,12 +6,8 @@
 
 #include <memory>
 
-#include <wpi/json.h>
-
 using namespace frc;
 
-static constexpr std::string_view kSmartDashboardType = "ShuffleboardLayout";
-
 ShuffleboardLayout::ShuffleboardLayout(ShuffleboardContainer& parent,
                                        std::string_view title,
                                        std::string_view type)
@@ -25,11 +21,6 @@ void ShuffleboardLayout::BuildInto(
     std::shared_ptr<nt::NetworkTable> parentTable,
     std::shared_ptr<nt::NetworkTable> metaTable) {
   BuildMetadata(metaTable);
-  auto table = parentTable->GetSubTable(GetTitle());
-  table->GetEntry(".type").SetString(kSmartDashboardType);
-  table->GetEntry(".type").GetTopic().SetProperty("SmartDashboard",
-                                                  kSmartDashboardType);
-  for (auto& component : GetComponents()) {
-    component->BuildInto(table, metaTable->GetSubTable(component->GetTitle()));
-  }
+  InitTable(parentTable);
+  BuildComponents(metaTable);
 }
@@ -6,12 +6,8 @@
 
 #include <memory>
 
-#include <wpi/json.h>
-
 using namespace frc;
 
-static constexpr std::string_view kSmartDashboardType = "ShuffleboardLayout";
-
 ShuffleboardTab::ShuffleboardTab(ShuffleboardRoot& root, std::string_view title)
     : ShuffleboardValue(title), ShuffleboardContainer(title), m_root(root) {}
 
@@ -21,12 +17,6 @@ ShuffleboardRoot& ShuffleboardTab::GetRoot() {
 
 void ShuffleboardTab::BuildInto(std::shared_ptr<nt::NetworkTable> parentTable,
                                 std::shared_ptr<nt::NetworkTable> metaTable) {
-  auto tabTable = parentTable->GetSubTable(GetTitle());
-  tabTable->GetEntry(".type").SetString(kSmartDashboardType);
-  tabTable->GetEntry(".type").GetTopic().SetProperty("SmartDashboard",
-                                                     kSmartDashboardType);
-  for (auto& component : GetComponents()) {
-    component->BuildInto(tabTable,
-                         metaTable->GetSubTable(component->GetTitle()));
-  }
+  InitTable(parentTable);
+  BuildComponents(metaTable);
 }
@@ -113,7 +113,7 @@ Vectord<2> ElevatorSim::UpdateX(const Vectord<2>& currentXhat,
         }
         return xdot;
       },
-      currentXhat, u, dt);
+      currentXhat, u, dt, 1e-6, &m_stepSize);
   // Check for collision after updating x-hat.
   if (WouldHitLowerLimit(units::meter_t{updatedXhat(0)})) {
     return Vectord<2>{m_minHeight.value(), 0.0};
@@ -0,0 +1,98 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/simulation/ParallelSimUpdater.h"
+
+#include <utility>
+
+using namespace frc::sim;
+
+ParallelSimUpdater::ParallelSimUpdater(int numThreads) {
+  // The thread calling Update() is one of the threads
+  for (int i = 1; i < numThreads; ++i) {
+    m_threads.emplace_back([this] { WorkerMain(); });
+  }
+}
+
+ParallelSimUpdater::~ParallelSimUpdater() {
+  {
+    std::scoped_lock lock{m_mutex};
+    m_stop = true;
+  }
+  m_startCondition.notify_all();
+  for (auto& thread : m_threads) {
+    thread.join();
+  }
+}
+
+void ParallelSimUpdater::Add(std::function<void(units::second_t)> update) {
+  m_updates.emplace_back(std::move(update));
+}
+
+void ParallelSimUpdater::Update(units::second_t dt) {
+  if (m_threads.empty() || m_updates.size() <= 1) {
+    for (auto& update : m_updates) {
+      update(dt);
+    }
+    return;
+  }
+
+  {
+    std::scoped_lock lock{m_mutex};
+    m_dt = dt;
+    m_next = 0;
+    m_activeWorkers = m_threads.size();
+    ++m_generation;
+  }
+  m_startCondition.notify_all();
+
+  RunUpdates();
+
+  std::exception_ptr exception;
+  {
+    std::unique_lock lock{m_mutex};
+    m_doneCondition.wait(lock, [&] { return m_activeWorkers == 0; });
+    exception = std::exchange(m_exception, nullptr);
+  }
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
+
+void ParallelSimUpdater::WorkerMain() {
+  uint64_t generation = 0;
+  while (true) {
+    {
+      std::unique_lock lock{m_mutex};
+      m_startCondition.wait(
+          lock, [&] { return m_stop || m_generation != generation; });
+      if (m_stop) {
+        return;
+      }
+      generation = m_generation;
+    }
+
+    RunUpdates();
+
+    {
+      std::scoped_lock lock{m_mutex};
+      if (--m_activeWorkers == 0) {
+        m_doneCondition.notify_one();
+      }
+    }
+  }
+}
+
+void ParallelSimUpdater::RunUpdates() {
+  for (size_t i = m_next++; i < m_updates.size(); i = m_next++) {
+    try {
+      m_updates[i](m_dt);
+    } catch (...) {
+      std::scoped_lock lock{m_mutex};
+      if (!m_exception) {
+        m_exception = std::current_exception();
+      }
+    }
+  }
+}
@@ -122,7 +122,7 @@ Vectord<2> SingleJointedArmSim::UpdateX(const Vectord<2>& currentXhat,
         }
         return xdot;
       },
-      currentXhat, u, dt);
+      currentXhat, u, dt, 1e-6, &m_stepSize);
 
   // Check for collisions.
   if (WouldHitLowerLimit(units::radian_t{updatedXhat(0)})) {
@@ -81,4 +81,13 @@ void Field2d::InitSendable(nt::NTSendableBuilder& builder) {
     obj->m_entry = m_table->GetDoubleArrayTopic(obj->m_name).GetEntry({});
     obj->UpdateEntry(true);
   }
+
+  // publish poses held back by a publish period
+  builder.SetUpdateTable([this] {
+    std::scoped_lock lock(m_mutex);
+    for (auto&& obj : m_objects) {
+      std::scoped_lock lock2(obj->m_mutex);
+      obj->PublishIfDue();
+    }
+  });
 }
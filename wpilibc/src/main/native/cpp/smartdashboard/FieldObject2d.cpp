@@ -4,9 +4,11 @@
 
 #include "frc/smartdashboard/FieldObject2d.h"
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 
+#include "frc/Timer.h"
 #include "frc/trajectory/Trajectory.h"
 
 using namespace frc;
@@ -15,12 +17,20 @@ FieldObject2d::FieldObject2d(FieldObject2d&& rhs) {
   std::swap(m_name, rhs.m_name);
   std::swap(m_entry, rhs.m_entry);
   std::swap(m_poses, rhs.m_poses);
+  std::swap(m_dirty, rhs.m_dirty);
+  std::swap(m_publishPeriod, rhs.m_publishPeriod);
+  std::swap(m_lastPublish, rhs.m_lastPublish);
+  std::swap(m_publishedChange, rhs.m_publishedChange);
 }
 
 FieldObject2d& FieldObject2d::operator=(FieldObject2d&& rhs) {
   std::swap(m_name, rhs.m_name);
   std::swap(m_entry, rhs.m_entry);
   std::swap(m_poses, rhs.m_poses);
+  std::swap(m_dirty, rhs.m_dirty);
+  std::swap(m_publishPeriod, rhs.m_publishPeriod);
+  std::swap(m_lastPublish, rhs.m_lastPublish);
+  std::swap(m_publishedChange, rhs.m_publishedChange);
 
   return *this;
 }
@@ -45,8 +55,15 @@ Pose2d FieldObject2d::GetPose() const {
 
 void FieldObject2d::SetPoses(std::span<const Pose2d> poses) {
   std::scoped_lock lock(m_mutex);
+  // skip unchanged poses, unless the entry has been changed remotely
+  if (std::equal(poses.begin(), poses.end(), m_poses.begin(), m_poses.end()) &&
+      (!m_entry || m_entry.GetLastChange() == m_publishedChange)) {
+    PublishIfDue();
+    return;
+  }
   m_poses.assign(poses.begin(), poses.end());
-  UpdateEntry();
+  m_dirty = true;
+  PublishIfDue();
 }
 
 void FieldObject2d::SetPoses(std::initializer_list<Pose2d> poses) {
@@ -60,7 +77,8 @@ void FieldObject2d::SetTrajectory(const Trajectory& trajectory) {
   for (auto&& state : trajectory.States()) {
     m_poses.push_back(state.pose);
   }
-  UpdateEntry();
+  m_dirty = true;
+  PublishIfDue();
 }
 
 std::vector<Pose2d> FieldObject2d::GetPoses() const {
@@ -77,6 +95,22 @@ std::span<const Pose2d> FieldObject2d::GetPoses(
   return out;
 }
 
+void FieldObject2d::SetPublishPeriod(units::second_t period) {
+  std::scoped_lock lock(m_mutex);
+  m_publishPeriod = period;
+}
+
+void FieldObject2d::PublishIfDue() {
+  if (!m_dirty || !m_entry) {
+    return;
+  }
+  if (m_publishPeriod > 0_s &&
+      Timer::GetFPGATimestamp() - m_lastPublish < m_publishPeriod) {
+    return;
+  }
+  UpdateEntry();
+}
+
 void FieldObject2d::UpdateEntry(bool setDefault) {
   if (!m_entry) {
     return;
@@ -93,10 +127,14 @@ void FieldObject2d::UpdateEntry(bool setDefault) {
   } else {
     m_entry.Set(arr);
   }
+  m_dirty = false;
+  m_lastPublish = Timer::GetFPGATimestamp();
+  m_publishedChange = m_entry.GetLastChange();
 }
 
 void FieldObject2d::UpdateFromEntry() const {
-  if (!m_entry) {
+  // poses waiting to be published are newer than the entry
+  if (!m_entry || m_dirty) {
     return;
   }
   auto arr = m_entry.Get();
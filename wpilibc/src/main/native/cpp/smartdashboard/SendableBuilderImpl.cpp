@@ -4,9 +4,13 @@
 
 #include "frc/smartdashboard/SendableBuilderImpl.h"
 
+#include <algorithm>
 #include <memory>
+#include <ranges>
 #include <string>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <networktables/BooleanArrayTopic.h>
 #include <networktables/BooleanTopic.h>
@@ -24,14 +28,96 @@
 
 using namespace frc;
 
+namespace {
+// The last value published by a property, so unchanged values aren't
+// published again
+template <typename T>
+class LastValue {
+ public:
+  // Returns true (and remembers the value) if the value needs to be published
+  template <typename V>
+  bool Update(const V& value, bool force) {
+    if constexpr (std::ranges::range<V>) {
+      if (m_valid && !force && std::ranges::equal(m_value, value)) {
+        return false;
+      }
+      m_value.assign(std::ranges::begin(value), std::ranges::end(value));
+    } else {
+      if (m_valid && !force && m_value == value) {
+        return false;
+      }
+      m_value = value;
+    }
+    m_valid = true;
+    return true;
+  }
+
+ private:
+  T m_value{};
+  bool m_valid = false;
+};
+
+// Storage for the values returned by a small property getter
+template <typename T>
+using SmallValue =
+    std::conditional_t<std::is_same_v<T, char>, std::string, std::vector<T>>;
+
+nt::Value MakeValue(bool value, int64_t time) {
+  return nt::Value::MakeBoolean(value, time);
+}
+
+nt::Value MakeValue(int64_t value, int64_t time) {
+  return nt::Value::MakeInteger(value, time);
+}
+
+nt::Value MakeValue(float value, int64_t time) {
+  return nt::Value::MakeFloat(value, time);
+}
+
+nt::Value MakeValue(double value, int64_t time) {
+  return nt::Value::MakeDouble(value, time);
+}
+
+nt::Value MakeValue(std::string_view value, int64_t time) {
+  return nt::Value::MakeString(value, time);
+}
+
+nt::Value MakeValue(std::span<const uint8_t> value, int64_t time) {
+  return nt::Value::MakeRaw(value, time);
+}
+
+nt::Value MakeValue(std::span<const int> value, int64_t time) {
+  return nt::Value::MakeBooleanArray(value, time);
+}
+
+nt::Value MakeValue(std::span<const int64_t> value, int64_t time) {
+  return nt::Value::MakeIntegerArray(value, time);
+}
+
+nt::Value MakeValue(std::span<const float> value, int64_t time) {
+  return nt::Value::MakeFloatArray(value, time);
+}
+
+nt::Value MakeValue(std::span<const double> value, int64_t time) {
+  return nt::Value::MakeDoubleArray(value, time);
+}
+
+nt::Value MakeValue(std::span<const std::string> value, int64_t time) {
+  return nt::Value::MakeStringArray(value, time);
+}
+}  // namespace
+
 template <typename Topic>
 void SendableBuilderImpl::PropertyImpl<Topic>::Update(bool controllable,
-                                                      int64_t time) {
+                                                      int64_t time,
+                                                      ValueBatch& batch) {
+  // republish after receiving a value, in case the setter didn't accept it
+  bool received = false;
   if (controllable && sub && updateLocal) {
-    updateLocal(sub);
+    received = updateLocal(sub);
   }
   if (pub && updateNetwork) {
-    updateNetwork(pub, time);
+    updateNetwork(pub, time, received, batch);
   }
 }
 
@@ -56,7 +142,13 @@ bool SendableBuilderImpl::IsActuator() const {
 void SendableBuilderImpl::Update() {
   uint64_t time = nt::Now();
   for (auto& property : m_properties) {
-    property->Update(m_controllable, time);
+    property->Update(m_controllable, time, m_batch);
+  }
+  // publish all changed values with a single storage lock
+  if (!m_batch.handles.empty()) {
+    nt::SetEntryValues(m_batch.handles, m_batch.values);
+    m_batch.handles.clear();
+    m_batch.values.clear();
   }
   for (auto& updateTable : m_updateTables) {
     updateTable();
@@ -129,17 +221,24 @@ void SendableBuilderImpl::AddPropertyImpl(Topic topic, Getter getter,
   auto prop = std::make_unique<PropertyImpl<Topic>>();
   if (getter) {
     prop->pub = topic.Publish();
-    prop->updateNetwork = [=](auto& pub, int64_t time) {
-      pub.Set(getter(), time);
-    };
+    prop->updateNetwork =
+        [=, last = LastValue<typename Getter::result_type>{}](
+            auto& pub, int64_t time, bool force, ValueBatch& batch) mutable {
+          auto value = getter();
+          if (last.Update(value, force)) {
+            batch.Add(pub.GetHandle(), MakeValue(value, time));
+          }
+        };
   }
   if (setter) {
     prop->sub =
         topic.Subscribe({}, {.excludePublisher = prop->pub.GetHandle()});
     prop->updateLocal = [=](auto& sub) {
-      for (auto&& val : sub.ReadQueue()) {
+      auto values = sub.ReadQueue();
+      for (auto&& val : values) {
         setter(val.value);
       }
+      return !values.empty();
     };
   }
   m_properties.emplace_back(std::move(prop));
@@ -280,17 +379,24 @@ void SendableBuilderImpl::AddRawProperty(
   auto prop = std::make_unique<PropertyImpl<nt::RawTopic>>();
   if (getter) {
     prop->pub = topic.Publish(typeString);
-    prop->updateNetwork = [=](auto& pub, int64_t time) {
-      pub.Set(getter(), time);
+    prop->updateNetwork = [=, last = LastValue<std::vector<uint8_t>>{}](
+                              auto& pub, int64_t time, bool force,
+                              ValueBatch& batch) mutable {
+      auto value = getter();
+      if (last.Update(value, force)) {
+        batch.Add(pub.GetHandle(), MakeValue(value, time));
+      }
     };
   }
   if (setter) {
     prop->sub = topic.Subscribe(typeString, {},
                                 {.excludePublisher = prop->pub.GetHandle()});
     prop->updateLocal = [=](auto& sub) {
-      for (auto&& val : sub.ReadQueue()) {
+      auto values = sub.ReadQueue();
+      for (auto&& val : values) {
         setter(val.value);
       }
+      return !values.empty();
     };
   }
   m_properties.emplace_back(std::move(prop));
@@ -313,18 +419,25 @@ void SendableBuilderImpl::AddSmallPropertyImpl(Topic topic, Getter getter,
   auto prop = std::make_unique<PropertyImpl<Topic>>();
   if (getter) {
     prop->pub = topic.Publish();
-    prop->updateNetwork = [=](auto& pub, int64_t time) {
+    prop->updateNetwork = [=, last = LastValue<SmallValue<T>>{}](
+                              auto& pub, int64_t time, bool force,
+                              ValueBatch& batch) mutable {
       wpi::SmallVector<T, Size> buf;
-      pub.Set(getter(buf), time);
+      auto value = getter(buf);
+      if (last.Update(value, force)) {
+        batch.Add(pub.GetHandle(), MakeValue(value, time));
+      }
     };
   }
   if (setter) {
     prop->sub =
         topic.Subscribe({}, {.excludePublisher = prop->pub.GetHandle()});
     prop->updateLocal = [=](auto& sub) {
-      for (auto&& val : sub.ReadQueue()) {
+      auto values = sub.ReadQueue();
+      for (auto&& val : values) {
         setter(val.value);
       }
+      return !values.empty();
     };
   }
   m_properties.emplace_back(std::move(prop));
@@ -392,18 +505,25 @@ void SendableBuilderImpl::AddSmallRawProperty(
   auto prop = std::make_unique<PropertyImpl<nt::RawTopic>>();
   if (getter) {
     prop->pub = topic.Publish(typeString);
-    prop->updateNetwork = [=](auto& pub, int64_t time) {
+    prop->updateNetwork = [=, last = LastValue<std::vector<uint8_t>>{}](
+                              auto& pub, int64_t time, bool force,
+                              ValueBatch& batch) mutable {
       wpi::SmallVector<uint8_t, 128> buf;
-      pub.Set(getter(buf), time);
+      auto value = getter(buf);
+      if (last.Update(value, force)) {
+        batch.Add(pub.GetHandle(), MakeValue(value, time));
+      }
     };
   }
   if (setter) {
     prop->sub = topic.Subscribe(typeString, {},
                                 {.excludePublisher = prop->pub.GetHandle()});
     prop->updateLocal = [=](auto& sub) {
-      for (auto&& val : sub.ReadQueue()) {
+      auto values = sub.ReadQueue();
+      for (auto&& val : values) {
         setter(val.value);
       }
+      return !values.empty();
     };
   }
   m_properties.emplace_back(std::move(prop));
@@ -27,8 +27,16 @@ struct Instance {
   detail::ListenerExecutor listenerExecutor;
   std::shared_ptr<nt::NetworkTable> table =
       nt::NetworkTableInstance::GetDefault().GetTable("SmartDashboard");
-  wpi::StringMap<wpi::SendableRegistry::UID> tablesToData;
+  struct Data {
+    wpi::SendableRegistry::UID uid = 0;
+    int updatePeriod = 1;
+    // offsets sendables with the same update period from each other, so their
+    // updates are spread across cycles
+    int updatePhase = 0;
+  };
+  wpi::StringMap<Data> tablesToData;
   wpi::mutex tablesToDataMutex;
+  uint64_t updateCount = 0;
 };
 }  // namespace
 
@@ -95,7 +103,11 @@ void SmartDashboard::PutData(std::string_view key, wpi::Sendable* data) {
   }
   auto& inst = GetInstance();
   std::scoped_lock lock(inst.tablesToDataMutex);
-  auto& uid = inst.tablesToData[key];
+  auto [it, isNew] = inst.tablesToData.try_emplace(key);
+  if (isNew) {
+    it->second.updatePhase = inst.tablesToData.size();
+  }
+  auto& uid = it->second.uid;
   wpi::Sendable* sddata = wpi::SendableRegistry::GetSendable(uid);
   if (sddata != data) {
     uid = wpi::SendableRegistry::GetUniqueId(data);
@@ -126,7 +138,20 @@ wpi::Sendable* SmartDashboard::GetData(std::string_view key) {
   if (it == inst.tablesToData.end()) {
     throw FRC_MakeError(err::SmartDashboardMissingKey, "{}", key);
   }
-  return wpi::SendableRegistry::GetSendable(it->second);
+  return wpi::SendableRegistry::GetSendable(it->second.uid);
+}
+
+void SmartDashboard::SetUpdatePeriod(std::string_view key, int cycles) {
+  if (cycles < 1) {
+    throw FRC_MakeError(err::ParameterOutOfRange, "cycles {}", cycles);
+  }
+  auto& inst = GetInstance();
+  std::scoped_lock lock(inst.tablesToDataMutex);
+  auto it = inst.tablesToData.find(key);
+  if (it == inst.tablesToData.end()) {
+    throw FRC_MakeError(err::SmartDashboardMissingKey, "{}", key);
+  }
+  it->second.updatePeriod = cycles;
 }
 
 bool SmartDashboard::PutBoolean(std::string_view keyName, bool value) {
@@ -253,7 +278,11 @@ void SmartDashboard::UpdateValues() {
   auto& inst = GetInstance();
   inst.listenerExecutor.RunListenerTasks();
   std::scoped_lock lock(inst.tablesToDataMutex);
+  uint64_t count = inst.updateCount++;
   for (auto& i : inst.tablesToData) {
-    wpi::SendableRegistry::Update(i.second);
+    auto& data = i.second;
+    if ((count + data.updatePhase) % data.updatePeriod == 0) {
+      wpi::SendableRegistry::Update(data.uid);
+    }
   }
 }
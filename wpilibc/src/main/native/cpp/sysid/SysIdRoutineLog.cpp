@@ -4,7 +4,9 @@
 
 #include "frc/sysid/SysIdRoutineLog.h"
 
+#include <memory>
 #include <string>
+#include <utility>
 
 #include <fmt/format.h>
 
@@ -18,22 +20,22 @@ SysIdRoutineLog::SysIdRoutineLog(std::string_view logName)
 SysIdRoutineLog::MotorLog::MotorLog(std::string_view motorName,
                                     std::string_view logName,
                                     LogEntries* logEntries)
-    : m_motorName(motorName), m_logName(logName), m_logEntries(logEntries) {
-  (*logEntries)[motorName] = MotorEntries();
-}
+    : m_motorName(motorName), m_logName(logName), m_logEntries(logEntries) {}
 
 SysIdRoutineLog::MotorLog& SysIdRoutineLog::MotorLog::value(
     std::string_view name, double value, std::string_view unit) {
   auto& motorEntries = (*m_logEntries)[m_motorName];
 
-  if (!motorEntries.contains(name)) {
+  // entries are kept across calls so each sample is only a lookup and append
+  auto [it, inserted] = motorEntries.try_emplace(name);
+  if (inserted) {
     wpi::log::DataLog& log = frc::DataLogManager::GetLog();
 
-    motorEntries[name] = wpi::log::DoubleLogEntry(
+    it->second = wpi::log::DoubleLogEntry(
         log, fmt::format("{}-{}-{}", name, m_motorName, m_logName), unit);
   }
 
-  motorEntries[name].Append(value);
+  it->second.Append(value);
   return *this;
 }
 
@@ -41,6 +43,22 @@ SysIdRoutineLog::MotorLog SysIdRoutineLog::Motor(std::string_view motorName) {
   return MotorLog{motorName, m_logName, &m_logEntries};
 }
 
+void SysIdRoutineLog::StartCapture(std::function<void(SysIdRoutineLog*)> log,
+                                   units::second_t period, int priority) {
+  StopCapture();
+  m_captureNotifier = std::make_unique<frc::Notifier>(
+      priority, [this, log = std::move(log)] { log(this); });
+  m_captureNotifier->SetName(fmt::format("sysid-capture-{}", m_logName));
+  m_captureNotifier->StartPeriodic(period);
+}
+
+void SysIdRoutineLog::StopCapture() {
+  if (m_captureNotifier) {
+    m_captureNotifier->Stop();
+    m_captureNotifier.reset();
+  }
+}
+
 void SysIdRoutineLog::RecordState(State state) {
   if (!m_stateInitialized) {
     m_state =
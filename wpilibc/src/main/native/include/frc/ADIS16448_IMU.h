@@ -368,23 +368,27 @@ class ADIS16448_IMU : public wpi::Sendable,
   // User-specified yaw axis
   IMUAxis m_yaw_axis;
 
-  // Last read values (post-scaling)
-  double m_gyro_rate_x = 0.0;
-  double m_gyro_rate_y = 0.0;
-  double m_gyro_rate_z = 0.0;
-  double m_accel_x = 0.0;
-  double m_accel_y = 0.0;
-  double m_accel_z = 0.0;
-  double m_mag_x = 0.0;
-  double m_mag_y = 0.0;
-  double m_mag_z = 0.0;
-  double m_baro = 0.0;
-  double m_temp = 0.0;
+  // Last read values (post-scaling). The outputs are written by the
+  // acquisition thread once per batch of samples and read without locking.
+  std::atomic<double> m_gyro_rate_x = 0.0;
+  std::atomic<double> m_gyro_rate_y = 0.0;
+  std::atomic<double> m_gyro_rate_z = 0.0;
+  std::atomic<double> m_accel_x = 0.0;
+  std::atomic<double> m_accel_y = 0.0;
+  std::atomic<double> m_accel_z = 0.0;
+  std::atomic<double> m_mag_x = 0.0;
+  std::atomic<double> m_mag_y = 0.0;
+  std::atomic<double> m_mag_z = 0.0;
+  std::atomic<double> m_baro = 0.0;
+  std::atomic<double> m_temp = 0.0;
 
   // Complementary filter variables
   double m_dt, m_alpha = 0.0;
   static constexpr double kTau = 0.5;
-  double m_compAngleX, m_compAngleY, m_accelAngleX, m_accelAngleY = 0.0;
+  std::atomic<double> m_compAngleX = 0.0;
+  std::atomic<double> m_compAngleY = 0.0;
+  std::atomic<double> m_accelAngleX = 0.0;
+  std::atomic<double> m_accelAngleY = 0.0;
 
   // vector for storing most recent imu values
   OffsetData* m_offset_buffer = nullptr;
@@ -401,9 +405,9 @@ class ADIS16448_IMU : public wpi::Sendable,
   int m_accum_count = 0;
 
   // Integrated gyro values
-  double m_integ_gyro_angle_x = 0.0;
-  double m_integ_gyro_angle_y = 0.0;
-  double m_integ_gyro_angle_z = 0.0;
+  std::atomic<double> m_integ_gyro_angle_x = 0.0;
+  std::atomic<double> m_integ_gyro_angle_y = 0.0;
+  std::atomic<double> m_integ_gyro_angle_z = 0.0;
 
   // Complementary filter functions
   double FormatFastConverge(double compAngle, double accAngle);
@@ -458,6 +462,7 @@ class ADIS16448_IMU : public wpi::Sendable,
     bool try_lock() noexcept { return mutex.try_lock(); }
   };
 
+  // Guards the gyro offset calibration state
   mutable NonMovableMutexWrapper m_mutex;
 
   // CRC-16 Look-Up Table
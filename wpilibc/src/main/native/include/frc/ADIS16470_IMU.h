@@ -23,7 +23,6 @@
 #include <units/angle.h>
 #include <units/angular_velocity.h>
 #include <wpi/condition_variable.h>
-#include <wpi/mutex.h>
 #include <wpi/sendable/Sendable.h>
 #include <wpi/sendable/SendableHelper.h>
 
@@ -475,23 +474,27 @@ class ADIS16470_IMU : public wpi::Sendable,
 
   void Close();
 
-  // Integrated gyro angles.
-  double m_integ_angle_x = 0.0;
-  double m_integ_angle_y = 0.0;
-  double m_integ_angle_z = 0.0;
+  // Integrated gyro angles. The outputs are written by the acquisition thread
+  // once per batch of samples and read without locking.
+  std::atomic<double> m_integ_angle_x = 0.0;
+  std::atomic<double> m_integ_angle_y = 0.0;
+  std::atomic<double> m_integ_angle_z = 0.0;
 
   // Instant raw outputs
-  double m_gyro_rate_x = 0.0;
-  double m_gyro_rate_y = 0.0;
-  double m_gyro_rate_z = 0.0;
-  double m_accel_x = 0.0;
-  double m_accel_y = 0.0;
-  double m_accel_z = 0.0;
+  std::atomic<double> m_gyro_rate_x = 0.0;
+  std::atomic<double> m_gyro_rate_y = 0.0;
+  std::atomic<double> m_gyro_rate_z = 0.0;
+  std::atomic<double> m_accel_x = 0.0;
+  std::atomic<double> m_accel_y = 0.0;
+  std::atomic<double> m_accel_z = 0.0;
 
   // Complementary filter variables
   double m_dt, m_alpha = 0.0;
   static constexpr double kTau = 1.0;
-  double m_compAngleX, m_compAngleY, m_accelAngleX, m_accelAngleY = 0.0;
+  std::atomic<double> m_compAngleX = 0.0;
+  std::atomic<double> m_compAngleY = 0.0;
+  std::atomic<double> m_accelAngleX = 0.0;
+  std::atomic<double> m_accelAngleY = 0.0;
 
   // Complementary filter functions
   double FormatFastConverge(double compAngle, double accAngle);
@@ -525,27 +528,6 @@ class ADIS16470_IMU : public wpi::Sendable,
   hal::SimDouble m_simAccelX;
   hal::SimDouble m_simAccelY;
   hal::SimDouble m_simAccelZ;
-
-  struct NonMovableMutexWrapper {
-    wpi::mutex mutex;
-    NonMovableMutexWrapper() = default;
-
-    NonMovableMutexWrapper(const NonMovableMutexWrapper&) = delete;
-    NonMovableMutexWrapper& operator=(const NonMovableMutexWrapper&) = delete;
-
-    NonMovableMutexWrapper(NonMovableMutexWrapper&&) {}
-    NonMovableMutexWrapper& operator=(NonMovableMutexWrapper&&) {
-      return *this;
-    }
-
-    void lock() { mutex.lock(); }
-
-    void unlock() { mutex.unlock(); }
-
-    bool try_lock() noexcept { return mutex.try_lock(); }
-  };
-
-  mutable NonMovableMutexWrapper m_mutex;
 };
 
 }  // namespace frc
@@ -151,6 +151,19 @@ class AddressableLED {
    */
   void SetData(std::initializer_list<LEDData> ledData);
 
+  /**
+   * Sets the led output data for part of the strip, leaving the rest of the
+   * strip unchanged.
+   *
+   * <p>Only the given LEDs are copied to the output, so updating a small part
+   * of a long strip is cheaper than rewriting all of it. If the output is
+   * enabled, this will start writing the next data cycle.
+   *
+   * @param start the index of the first LED to write
+   * @param ledData the data to write, starting at start
+   */
+  void SetData(int start, std::span<const LEDData> ledData);
+
   /**
    * Sets the bit timing.
    *
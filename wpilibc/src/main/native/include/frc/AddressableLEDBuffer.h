@@ -0,0 +1,80 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "frc/AddressableLED.h"
+
+namespace frc {
+
+/**
+ * Double-buffered LED data for an AddressableLED.
+ *
+ * Patterns are applied to the buffer, or to segments of it, and Flush() writes
+ * only the part of the strip that changed since the previous flush. This
+ * allows one physical strip to be split into several virtual strips, each
+ * driven by its own LEDPattern, without rewriting the whole strip when one
+ * segment changes.
+ *
+ * <pre>
+ * frc::AddressableLEDBuffer buffer{60};
+ * pattern.ApplyTo(buffer.Segment(0, 10));
+ * statusPattern.ApplyTo(buffer.Segment(10, 50));
+ * buffer.Flush(led);
+ * </pre>
+ */
+class AddressableLEDBuffer {
+ public:
+  /**
+   * Constructs a buffer.
+   *
+   * @param length the number of LEDs; this should match the strip length set
+   *               with AddressableLED::SetLength()
+   */
+  explicit AddressableLEDBuffer(int length);
+
+  /**
+   * Gets the number of LEDs in the buffer.
+   *
+   * @return the number of LEDs
+   */
+  int GetLength() const { return m_data.size(); }
+
+  /**
+   * Gets the data for the whole buffer.
+   *
+   * @return the LED data
+   */
+  std::span<AddressableLED::LEDData> GetData() { return m_data; }
+
+  /**
+   * Gets the data for a segment of the buffer.
+   *
+   * @param start the index of the first LED in the segment
+   * @param length the number of LEDs in the segment
+   * @return the LED data of the segment
+   */
+  std::span<AddressableLED::LEDData> Segment(int start, int length) {
+    return GetData().subspan(start, length);
+  }
+
+  /**
+   * Writes the LEDs that changed since the previous flush to the strip. The
+   * first flush writes the whole buffer.
+   *
+   * @param led the LED strip to write to
+   */
+  void Flush(AddressableLED& led);
+
+ private:
+  std::vector<AddressableLED::LEDData> m_data;
+  // what was last written to the strip
+  std::vector<AddressableLED::LEDData> m_written;
+  bool m_flushed = false;
+};
+
+}  // namespace frc
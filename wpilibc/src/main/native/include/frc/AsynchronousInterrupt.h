@@ -9,7 +9,6 @@
 #include <atomic>
 #include <functional>
 #include <memory>
-#include <thread>
 #include <utility>
 
 #include <units/time.h>
@@ -24,6 +23,12 @@ namespace frc {
  * <p> Both rising and falling edges can be indicated in one callback if both a
  * rising and falling edge occurred since the previous callback.
  *
+ * <p> All asynchronous interrupts share a single callback thread, which waits
+ * for every enabled interrupt at once, so callbacks should return quickly.
+ * Within a callback, GetRisingTimestamp() and GetFallingTimestamp() return the
+ * FPGA timestamps of the edges being reported. Use
+ * SetCallbackThreadPriority() to run the thread at real-time priority.
+ *
  * <p>Synchronous (blocking) interrupts are handled by the SynchronousInterrupt
  * class.
  */
@@ -169,11 +174,22 @@ class AsynchronousInterrupt {
    */
   units::second_t GetFallingTimestamp();
 
- private:
-  void ThreadMain();
+  /**
+   * Sets the priority of the thread shared by all asynchronous interrupt
+   * callbacks. Applies immediately if the thread is running, otherwise when
+   * it's started by the first Enable().
+   *
+   * @param realTime Set to true to set a real-time priority, false for
+   *                 standard priority.
+   * @param priority Priority to set the thread to. For real-time, this is 1-99
+   *                 with 99 being highest. For non-real-time, this is forced to
+   *                 0. See "man 7 sched" for more details.
+   * @return True on success.
+   */
+  static bool SetCallbackThreadPriority(bool realTime, int priority);
 
-  std::atomic_bool m_keepRunning{false};
-  std::thread m_thread;
+ private:
+  std::atomic_bool m_enabled{false};
   SynchronousInterrupt m_interrupt;
   std::function<void(bool, bool)> m_callback;
 };
@@ -0,0 +1,234 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <string_view>
+#include <vector>
+
+#include <hal/cpp/fpga_clock.h>
+#include <networktables/NetworkTableInstance.h>
+#include <units/time.h>
+#include <wpi/AllocationTracker.h>
+
+namespace wpi::log {
+class DataLog;
+}  // namespace wpi::log
+
+namespace frc {
+
+/**
+ * A low-overhead profiler for code that runs once per robot loop.
+ *
+ * Code is divided into named zones, which are registered once (typically via
+ * FRC_PROFILE_ZONE(), which registers the zone the first time the enclosing
+ * scope runs) and afterwards referred to by index, so recording a sample is
+ * only a few atomic operations. The time spent in each zone is accumulated
+ * over a cycle; EndCycle() (called at the end of every TimedRobot loop) stores
+ * the per-cycle totals in a ring buffer and publishes them to any attached
+ * DataLog or NetworkTables instance.
+ *
+ * The profiler is disabled by default; when disabled, recording doesn't read
+ * the clock. Tracer epochs (and therefore Watchdog and ScopedTracer epochs)
+ * are also recorded as zones while the profiler is enabled.
+ *
+ * If wpi::AllocationTracker is enabled, the number of heap allocations made
+ * by the thread in each zone, and by the thread calling EndCycle() over the
+ * whole cycle, are also recorded and published.
+ */
+class CycleProfiler {
+ public:
+  /// Maximum number of zones.
+  static constexpr int kMaxZones = 64;
+
+  /// Number of cycles kept in the history ring buffer.
+  static constexpr int kHistoryLength = 64;
+
+  /**
+   * Statistics for a zone.
+   */
+  struct ZoneStats {
+    /// Number of cycles recorded.
+    int64_t cycles = 0;
+
+    /// Time spent in the zone during the last cycle.
+    units::second_t last = 0_s;
+
+    /// Average time spent in the zone per cycle.
+    units::second_t average = 0_s;
+
+    /// Longest time spent in the zone during a cycle.
+    units::second_t max = 0_s;
+
+    /// Number of heap allocations in the zone during the last cycle.
+    int64_t lastAllocations = 0;
+
+    /// Bytes allocated in the zone during the last cycle.
+    int64_t lastAllocatedBytes = 0;
+
+    /// Total number of heap allocations in the zone over all cycles.
+    int64_t totalAllocations = 0;
+  };
+
+  CycleProfiler() = delete;
+
+  /**
+   * Enables or disables the profiler.
+   *
+   * @param enabled True to enable.
+   */
+  static void SetEnabled(bool enabled);
+
+  /**
+   * Returns whether the profiler is enabled.
+   *
+   * @return True if enabled.
+   */
+  static bool IsEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+  /**
+   * Registers a zone, or looks up an existing zone with the same name.
+   *
+   * @param name Zone name.
+   * @return Zone index, or -1 if kMaxZones zones are already registered.
+   */
+  static int RegisterZone(std::string_view name);
+
+  /**
+   * Adds time spent in a zone to the current cycle.
+   *
+   * @param zone Zone index.
+   * @param duration Time spent.
+   */
+  static void Record(int zone, std::chrono::nanoseconds duration);
+
+  /**
+   * Adds heap allocations made in a zone to the current cycle.
+   *
+   * @param zone Zone index.
+   * @param allocations Number of allocations.
+   * @param bytes Total size of allocations, in bytes.
+   */
+  static void RecordAllocations(int zone, uint64_t allocations,
+                                uint64_t bytes);
+
+  /**
+   * Ends the current cycle, storing and publishing the time spent in each
+   * zone. Does nothing if the profiler is disabled.
+   */
+  static void EndCycle();
+
+  /**
+   * Gets statistics for a zone.
+   *
+   * @param zone Zone index.
+   * @return Zone statistics.
+   */
+  static ZoneStats GetZoneStats(int zone);
+
+  /**
+   * Gets the heap allocations made by the thread that called EndCycle()
+   * during the last cycle. Only counted while wpi::AllocationTracker is
+   * enabled.
+   *
+   * @return Allocation counts.
+   */
+  static wpi::AllocationTracker::Counts GetLastCycleAllocations();
+
+  /**
+   * Gets the time spent in a zone during recent cycles, oldest first.
+   *
+   * @param zone Zone index.
+   * @return Up to kHistoryLength per-cycle times.
+   */
+  static std::vector<units::second_t> GetHistory(int zone);
+
+  /**
+   * Clears all statistics and history. Zones stay registered.
+   */
+  static void Reset();
+
+  /**
+   * Logs the per-cycle time (and allocations, if tracked) of each zone to a
+   * DataLog. Only the first call has any effect.
+   *
+   * @param log DataLog
+   * @param prefix Entry name prefix; the zone name is appended
+   */
+  static void StartDataLog(wpi::log::DataLog& log,
+                           std::string_view prefix = "Profiler/");
+
+  /**
+   * Publishes the per-cycle time (and allocations, if tracked) of each zone to
+   * NetworkTables. Only the first call has any effect.
+   *
+   * @param inst NetworkTables instance
+   * @param table Table name
+   */
+  static void StartNetworkTables(nt::NetworkTableInstance inst,
+                                 std::string_view table = "Profiler");
+
+ private:
+  static inline std::atomic_bool s_enabled{false};
+};
+
+/**
+ * Records the time from construction to destruction in a CycleProfiler zone.
+ */
+class ProfileScope {
+ public:
+  /**
+   * Starts timing a zone.
+   *
+   * @param zone Zone index from CycleProfiler::RegisterZone().
+   */
+  explicit ProfileScope(int zone)
+      : m_zone{zone}, m_active{CycleProfiler::IsEnabled()} {
+    if (m_active) {
+      m_startAllocations = wpi::AllocationTracker::GetThreadCounts();
+      m_start = hal::fpga_clock::now();
+    }
+  }
+
+  ~ProfileScope() {
+    if (m_active) {
+      CycleProfiler::Record(m_zone, hal::fpga_clock::now() - m_start);
+      auto counts = wpi::AllocationTracker::GetThreadCounts();
+      CycleProfiler::RecordAllocations(
+          m_zone, counts.allocations - m_startAllocations.allocations,
+          counts.bytes - m_startAllocations.bytes);
+    }
+  }
+
+  ProfileScope(const ProfileScope&) = delete;
+  ProfileScope& operator=(const ProfileScope&) = delete;
+
+ private:
+  int m_zone;
+  bool m_active;
+  hal::fpga_clock::time_point m_start;
+  wpi::AllocationTracker::Counts m_startAllocations;
+};
+
+}  // namespace frc
+
+#define FRC_PROFILE_CONCAT_IMPL(a, b) a##b
+#define FRC_PROFILE_CONCAT(a, b) FRC_PROFILE_CONCAT_IMPL(a, b)
+
+/**
+ * Times the rest of the enclosing scope as a CycleProfiler zone. The zone is
+ * registered the first time the scope runs.
+ *
+ * @param name Zone name (string literal).
+ */
+#define FRC_PROFILE_ZONE(name)                                               \
+  static const int FRC_PROFILE_CONCAT(frcProfileZone_, __LINE__) =           \
+      ::frc::CycleProfiler::RegisterZone(name);                              \
+  ::frc::ProfileScope FRC_PROFILE_CONCAT(frcProfileScope_, __LINE__) {       \
+    FRC_PROFILE_CONCAT(frcProfileZone_, __LINE__)                            \
+  }
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <span>
 #include <type_traits>
 
 #include <hal/AnalogInput.h>
@@ -48,6 +49,29 @@ class DMASample : public HAL_DMASample {
         HAL_ReadDMA(dma->dmaHandle, this, timeout.value(), remaining, status));
   }
 
+  /**
+   * Retrieves multiple DMA samples.
+   *
+   * If no samples are queued, waits for one. Then reads as many of the already
+   * queued samples as fit in the buffer with a single FPGA transfer.
+   *
+   * @param dma DMA object.
+   * @param samples Buffer to read samples into.
+   * @param timeout Timeout for retrieval.
+   * @param remaining Number of remaining samples.
+   * @param status DMA read status.
+   * @return The samples read, a prefix of samples (empty on timeout or error).
+   */
+  static std::span<DMASample> ReadSamples(const DMA* dma,
+                                          std::span<DMASample> samples,
+                                          units::second_t timeout,
+                                          int32_t* remaining,
+                                          int32_t* status) {
+    return samples.first(HAL_ReadDMASamples(
+        dma->dmaHandle, samples.data(), samples.size(), timeout.value(),
+        remaining, status));
+  }
+
   /**
    * Returns the DMA sample time in microseconds.
    *
@@ -229,4 +253,6 @@ class DMASample : public HAL_DMASample {
 
 static_assert(std::is_standard_layout_v<frc::DMASample>,
               "frc::DMASample must have standard layout");
+static_assert(sizeof(frc::DMASample) == sizeof(HAL_DMASample),
+              "frc::DMASample arrays must be usable as HAL_DMASample arrays");
 }  // namespace frc
@@ -0,0 +1,139 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <span>
+#include <thread>
+
+#include <units/time.h>
+#include <wpi/mutex.h>
+
+#include "frc/DMA.h"
+
+namespace frc {
+class DMASample;
+class DutyCycleEncoder;
+class Encoder;
+
+/**
+ * Estimates the velocity of an Encoder or DutyCycleEncoder from positions
+ * sampled by DMA at a high fixed rate.
+ *
+ * <p>Encoder::GetRate() is computed from the period of the last encoder edges,
+ * which is noisy at low speeds and slow to update at high speeds. This class
+ * instead has the FPGA capture the position and its timestamp at a fixed
+ * period (1 ms by default), and a background thread fits a line to a sliding
+ * window of the captured positions. The slope of the line is the velocity.
+ * Averaging over the window rejects quantization noise, while the high sample
+ * rate keeps the window short and the estimate current.
+ *
+ * <p>The estimator uses its own DMA instance, so the encoder should not be
+ * added to another DMA. In simulation, where DMA is unavailable, the thread
+ * polls the encoder at the same period instead.
+ *
+ * <p>The encoder must outlive the estimator.
+ */
+class DMAVelocityEstimator {
+ public:
+  /**
+   * Constructs and starts an estimator for a quadrature encoder. Positions and
+   * velocity are in the units of Encoder::GetDistance().
+   *
+   * @param encoder Encoder to sample.
+   * @param period Sampling period.
+   * @param windowSize Number of samples to fit the velocity over. The
+   *                   estimate is delayed by half the window duration.
+   */
+  explicit DMAVelocityEstimator(const Encoder& encoder,
+                                units::second_t period = 1_ms,
+                                int windowSize = 20);
+
+  /**
+   * Constructs and starts an estimator for an absolute duty cycle encoder.
+   * Positions and velocity are in the units of DutyCycleEncoder::Get(). The
+   * position is unwrapped, so it keeps counting past the encoder's full range.
+   *
+   * @param encoder Encoder to sample.
+   * @param period Sampling period. This should be no shorter than the period
+   *               of the encoder's duty cycle output.
+   * @param windowSize Number of samples to fit the velocity over. The
+   *                   estimate is delayed by half the window duration.
+   */
+  explicit DMAVelocityEstimator(const DutyCycleEncoder& encoder,
+                                units::second_t period = 1_ms,
+                                int windowSize = 20);
+
+  ~DMAVelocityEstimator();
+
+  DMAVelocityEstimator(const DMAVelocityEstimator&) = delete;
+  DMAVelocityEstimator& operator=(const DMAVelocityEstimator&) = delete;
+
+  /**
+   * Gets the estimated velocity, as of GetTimestamp().
+   *
+   * @return Velocity in position units per second (0 until the window has at
+   *         least two samples)
+   */
+  double GetVelocity() const;
+
+  /**
+   * Gets the most recently sampled position.
+   *
+   * @return Position
+   */
+  double GetPosition() const;
+
+  /**
+   * Gets the FPGA timestamp of the most recent sample.
+   *
+   * @return Timestamp (0 if nothing has been sampled yet)
+   */
+  units::second_t GetTimestamp() const;
+
+  /**
+   * Sets the priority of the sampling thread.
+   *
+   * @param realTime Set to true to set a real-time priority, false for
+   *                 standard priority.
+   * @param priority Priority to set the thread to. For real-time, this is 1-99
+   *                 with 99 being highest. For non-real-time, this is forced to
+   *                 0. See "man 7 sched" for more details.
+   * @return True on success.
+   */
+  bool SetThreadPriority(bool realTime, int priority);
+
+  /**
+   * Computes the slope of the least-squares line through a set of points.
+   *
+   * @param times Sample times in seconds.
+   * @param positions Sampled positions; must be the same size as times.
+   * @return Slope in position units per second, or 0 if there are fewer than
+   *         two distinct times.
+   */
+  static double FitVelocity(std::span<const double> times,
+                            std::span<const double> positions);
+
+ private:
+  DMAVelocityEstimator(units::second_t period, int windowSize);
+
+  void Start(std::function<double(DMASample&, int32_t*)> readDMA,
+             std::function<double()> readDirect, double wrapRange);
+  void ThreadMain(std::function<double(DMASample&, int32_t*)> readDMA,
+                  std::function<double()> readDirect, double wrapRange);
+
+  units::second_t m_period;
+  int m_windowSize;
+  DMA m_dma;
+  std::atomic_bool m_stop{false};
+  std::thread m_thread;
+
+  mutable wpi::mutex m_mutex;
+  double m_velocity = 0;
+  double m_position = 0;
+  units::second_t m_timestamp{0_s};
+};
+}  // namespace frc
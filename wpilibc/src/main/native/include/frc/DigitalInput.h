@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <span>
+
 #include <hal/DIO.h>
 #include <wpi/sendable/Sendable.h>
 #include <wpi/sendable/SendableHelper.h>
@@ -48,6 +50,19 @@ class DigitalInput : public DigitalSource,
    */
   bool Get() const;
 
+  /**
+   * Get the values from multiple digital input channels.
+   *
+   * This reads the FPGA input register once for all of the inputs, which is
+   * faster than calling Get() on each one and gives values from the same
+   * instant.
+   *
+   * @param inputs The inputs to read
+   * @param values Output for the input values; must be the same size as inputs
+   */
+  static void GetBulk(std::span<const DigitalInput* const> inputs,
+                      std::span<bool> values);
+
   // Digital Source Interface
   /**
    * @return The HAL Handle to the specified source.
@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <stdint.h>
+
+#include <array>
 #include <optional>
 #include <string>
 
@@ -49,6 +52,36 @@ class DriverStation final {
   /// Number of Joystick ports.
   static constexpr int kJoystickPorts = 6;
 
+  /// Maximum number of axes on a joystick.
+  static constexpr int kMaxJoystickAxes = 12;
+
+  /// Maximum number of POVs on a joystick.
+  static constexpr int kMaxJoystickPOVs = 12;
+
+  /**
+   * The axes, POVs, and buttons of one joystick, all from the same Driver
+   * Station packet.
+   */
+  struct JoystickSnapshot {
+    /// Number of valid entries in axes.
+    int axisCount = 0;
+
+    /// Axis values.
+    std::array<float, kMaxJoystickAxes> axes{};
+
+    /// Number of valid entries in povs.
+    int povCount = 0;
+
+    /// POV angles in degrees, or -1 if not pressed.
+    std::array<int, kMaxJoystickPOVs> povs{};
+
+    /// Number of buttons.
+    int buttonCount = 0;
+
+    /// Button states; bit 0 is button 1.
+    uint32_t buttons = 0;
+  };
+
   /**
    * The state of one joystick button. %Button indexes begin at 1.
    *
@@ -105,6 +138,17 @@ class DriverStation final {
    */
   static int GetStickButtons(int stick);
 
+  /**
+   * Gets the state of all axes, POVs, and buttons on a joystick at once.
+   *
+   * This is cheaper than reading each value separately, and the values are
+   * guaranteed to be from the same Driver Station packet.
+   *
+   * @param stick The joystick to read.
+   * @return The state of the joystick; empty if stick is out of range.
+   */
+  static JoystickSnapshot GetJoystickSnapshot(int stick);
+
   /**
    * Returns the number of axes on a given joystick port.
    *
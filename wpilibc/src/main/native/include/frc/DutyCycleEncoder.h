@@ -24,6 +24,8 @@ class DigitalSource;
  */
 class DutyCycleEncoder : public wpi::Sendable,
                          public wpi::SendableHelper<DutyCycleEncoder> {
+  friend class DMAVelocityEstimator;
+
  public:
   /**
    * Construct a new DutyCycleEncoder on a specific channel.
@@ -247,6 +249,8 @@ class DutyCycleEncoder : public wpi::Sendable,
  private:
   void Init(double fullRange, double expectedZero);
   double MapSensorRange(double pos) const;
+  // maps a duty cycle output (0-1) to a position
+  double MapOutput(double pos) const;
 
   std::shared_ptr<DutyCycle> m_dutyCycle;
   int m_frequencyThreshold = 100;
@@ -4,10 +4,10 @@
 
 #pragma once
 
+#include <atomic>
 #include <string>
 
 #include <units/time.h>
-#include <wpi/mutex.h>
 
 #include "frc/Timer.h"
 
@@ -108,16 +108,18 @@ class MotorSafety {
  private:
   static constexpr auto kDefaultSafetyExpiration = 100_ms;
 
-  // The expiration time for this object
-  units::second_t m_expiration = kDefaultSafetyExpiration;
+  // These are atomics rather than mutex-protected so Feed(), which is called
+  // on every motor output, stays cheap. They are only read and written
+  // individually, so relaxed ordering is sufficient.
 
-  // True if motor safety is enabled for this motor
-  bool m_enabled = false;
+  // The expiration time for this object, in seconds
+  std::atomic<double> m_expiration{kDefaultSafetyExpiration.value()};
 
-  // The FPGA clock value when the motor has expired
-  units::second_t m_stopTime = Timer::GetFPGATimestamp();
+  // True if motor safety is enabled for this motor
+  std::atomic<bool> m_enabled{false};
 
-  mutable wpi::mutex m_thisMutex;
+  // The FPGA clock value when the motor has expired, in seconds
+  std::atomic<double> m_stopTime{Timer::GetFPGATimestamp().value()};
 };
 
 }  // namespace frc
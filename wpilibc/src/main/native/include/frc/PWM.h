@@ -6,6 +6,8 @@
 
 #include <stdint.h>
 
+#include <span>
+
 #include <hal/PWM.h>
 #include <hal/Types.h>
 #include <units/time.h>
@@ -121,6 +123,22 @@ class PWM : public wpi::Sendable, public wpi::SendableHelper<PWM> {
    */
   virtual void SetSpeed(double speed);
 
+  /**
+   * Set the PWM values of multiple channels based on speeds, with a single
+   * HAL call.
+   *
+   * This calls the base PWM SetSpeed() behavior directly, bypassing any
+   * override.
+   *
+   * @pre SetBounds() called on each PWM.
+   *
+   * @param pwms The PWMs to set
+   * @param speeds The speeds to set, between -1.0 and 1.0; must be the same
+   *               size as pwms
+   */
+  static void SetSpeedBulk(std::span<PWM* const> pwms,
+                           std::span<const double> speeds);
+
   /**
    * Get the PWM value in terms of speed.
    *
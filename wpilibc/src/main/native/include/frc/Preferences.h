@@ -6,10 +6,15 @@
 
 #include <stdint.h>
 
+#include <atomic>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <vector>
 
+#include <networktables/NetworkTableEntry.h>
+#include <networktables/NetworkTableListener.h>
+
 namespace frc {
 
 /**
@@ -25,9 +30,57 @@ namespace frc {
  *
  * This will also interact with NetworkTable by creating a table called
  * "Preferences" with all the key-value pairs.
+ *
+ * Values that are read every loop should be read through a handle (e.g.
+ * GetDoubleHandle()), which caches the value locally and is kept up to date by
+ * a NetworkTables listener, so reading it is a single atomic load.
  */
 class Preferences {
  public:
+  /**
+   * A cached preference value.
+   *
+   * The value is updated asynchronously when the preference changes, so a
+   * change made from the dashboard becomes visible shortly after it's
+   * received. Handles are created by GetDoubleHandle(), GetBooleanHandle(),
+   * and GetLongHandle().
+   *
+   * @tparam T value type (double, bool, or int64_t)
+   */
+  template <typename T>
+  class Handle {
+   public:
+    Handle() = default;
+
+    /**
+     * Gets the current value.
+     *
+     * @return the value, or a default-constructed value if the handle is
+     *         empty
+     */
+    T Get() const {
+      return m_value ? m_value->load(std::memory_order_relaxed) : T{};
+    }
+
+    /**
+     * Sets the preference. The cached value is updated immediately.
+     *
+     * @param value the value
+     */
+    void Set(T value);
+
+   private:
+    friend class Preferences;
+
+    nt::NetworkTableEntry m_entry;
+    std::shared_ptr<std::atomic<T>> m_value;
+    nt::NetworkTableListener m_listener;
+  };
+
+  using DoubleHandle = Handle<double>;
+  using BooleanHandle = Handle<bool>;
+  using LongHandle = Handle<int64_t>;
+
   /**
    * Returns a vector of all the keys.
    *
@@ -214,8 +267,44 @@ class Preferences {
    */
   static void RemoveAll();
 
+  /**
+   * Gets a cached handle to a double preference, putting the given default
+   * value if the preference doesn't exist yet.
+   *
+   * @param key the key
+   * @param defaultValue the value to use if the preference doesn't exist
+   * @return handle to the preference
+   */
+  static DoubleHandle GetDoubleHandle(std::string_view key,
+                                      double defaultValue = 0.0);
+
+  /**
+   * Gets a cached handle to a boolean preference, putting the given default
+   * value if the preference doesn't exist yet.
+   *
+   * @param key the key
+   * @param defaultValue the value to use if the preference doesn't exist
+   * @return handle to the preference
+   */
+  static BooleanHandle GetBooleanHandle(std::string_view key,
+                                        bool defaultValue = false);
+
+  /**
+   * Gets a cached handle to a long preference, putting the given default
+   * value if the preference doesn't exist yet.
+   *
+   * @param key the key
+   * @param defaultValue the value to use if the preference doesn't exist
+   * @return handle to the preference
+   */
+  static LongHandle GetLongHandle(std::string_view key,
+                                  int64_t defaultValue = 0);
+
  private:
   Preferences() = default;
+
+  template <typename T>
+  static Handle<T> MakeHandle(std::string_view key, T defaultValue);
 };
 
 }  // namespace frc
@@ -12,6 +12,7 @@
 #include <hal/Main.h>
 #include <networktables/NetworkTable.h>
 #include <wpi/RuntimeCheck.h>
+#include <wpi/ThreadRegistry.h>
 #include <wpi/condition_variable.h>
 #include <wpi/mutex.h>
 #include <wpi/string.h>
@@ -30,6 +31,7 @@ void ResetMotorSafety();
 
 template <class Robot>
 void RunRobot(wpi::mutex& m, Robot** robot) {
+  wpi::SetCurrentThreadClass(wpi::ThreadClass::kMain, "RobotMain");
   try {
     static Robot theRobot;
     {
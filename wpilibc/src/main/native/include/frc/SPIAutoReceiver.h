@@ -0,0 +1,71 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <span>
+#include <vector>
+
+#include <wpi/function_ref.h>
+
+namespace frc {
+
+class SPI;
+
+/**
+ * Bulk reader for the automatic SPI transfer engine.
+ *
+ * Sensor drivers that stream fixed-size frames with SPI::StartAutoRate() or
+ * SPI::StartAutoTrigger() call Drain() periodically from their acquisition
+ * thread. Each call reads every complete frame currently buffered with as few
+ * HAL calls as possible and hands them to the callback along with a 64-bit
+ * FPGA timestamp.
+ *
+ * This class is not thread safe; use one instance per acquisition thread.
+ */
+class SPIAutoReceiver {
+ public:
+  /**
+   * Constructs a receiver.
+   *
+   * @param frameSize number of words in each received frame, including the
+   *                  leading timestamp word (i.e. the size of the transmit
+   *                  data plus the zero size, plus one)
+   * @param maxFrames maximum number of frames to read with a single HAL call
+   */
+  SPIAutoReceiver(int frameSize, int maxFrames);
+
+  /**
+   * Reads and processes all complete frames currently buffered.
+   *
+   * The callback is called once per frame, oldest first, with the frame words
+   * (frame[0] is the raw 32-bit timestamp) and the frame timestamp extended to
+   * the 64-bit FPGA time (microseconds), as returned by
+   * RobotController::GetFPGATime().
+   *
+   * @param spi SPI port with the automatic transfer engine running
+   * @param func callback
+   * @return Number of frames processed
+   */
+  int Drain(
+      SPI& spi,
+      wpi::function_ref<void(std::span<const uint32_t> frame,
+                             uint64_t timestamp)>
+          func);
+
+  /**
+   * Gets the frame size.
+   *
+   * @return Number of words in each frame
+   */
+  int GetFrameSize() const { return m_frameSize; }
+
+ private:
+  int m_frameSize;
+  std::vector<uint32_t> m_buffer;
+};
+
+}  // namespace frc
@@ -105,6 +105,8 @@ class SynchronousInterrupt {
   void WakeupWaitingInterrupt();
 
  private:
+  friend class AsynchronousInterrupt;
+
   void InitSynchronousInterrupt();
   std::shared_ptr<DigitalSource> m_source;
   hal::Handle<HAL_InterruptHandle, HAL_CleanInterrupts> m_handle;
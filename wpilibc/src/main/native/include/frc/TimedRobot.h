@@ -4,8 +4,10 @@
 
 #pragma once
 
+#include <array>
 #include <chrono>
 #include <functional>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -13,9 +15,11 @@
 #include <hal/Types.h>
 #include <units/math.h>
 #include <units/time.h>
+#include <wpi/mutex.h>
 #include <wpi/priority_queue.h>
 
 #include "frc/IterativeRobotBase.h"
+#include "frc/Notifier.h"
 #include "frc/RobotController.h"
 
 namespace frc {
@@ -34,6 +38,33 @@ class TimedRobot : public IterativeRobotBase {
   /// Default loop period.
   static constexpr auto kDefaultPeriod = 20_ms;
 
+  /// Number of buckets in CallbackStats::histogram.
+  static constexpr int kNumHistogramBuckets = 12;
+
+  /**
+   * Execution statistics for a periodic callback.
+   */
+  struct CallbackStats {
+    /// Number of times the callback has run.
+    int64_t runs = 0;
+
+    /// Number of runs that finished after the start of the next period.
+    int64_t deadlineMisses = 0;
+
+    /// Execution time of the most recent run.
+    units::second_t lastDuration = 0_s;
+
+    /// Longest execution time seen.
+    units::second_t maxDuration = 0_s;
+
+    /**
+     * Histogram of execution times. Bucket i counts runs that took less than
+     * 64 << i microseconds (and at least the bound of bucket i - 1); the last
+     * bucket counts everything longer.
+     */
+    std::array<int64_t, kNumHistogramBuckets> histogram{};
+  };
+
   /**
    * Provide an alternate "main loop" via StartCompetition().
    */
@@ -78,16 +109,53 @@ class TimedRobot : public IterativeRobotBase {
    * @param offset   The offset from the common starting time. This is useful
    *                 for scheduling a callback in a different timeslot relative
    *                 to TimedRobot.
+   * @return Callback index for GetCallbackStats().
+   */
+  int AddPeriodic(std::function<void()> callback, units::second_t period,
+                  units::second_t offset = 0_s);
+
+  /**
+   * Add a callback to run at a specific period on its own real-time thread.
+   *
+   * Unlike AddPeriodic(), the callback runs concurrently with TimedRobot and
+   * other callbacks, so a slow main loop can't delay it (and vice versa). The
+   * callback is responsible for synchronizing any state it shares with the
+   * rest of the robot program.
+   *
+   * @param callback The callback to run.
+   * @param period   The period at which to run the callback.
+   * @param priority The real-time priority of the thread (1-99, with 99 being
+   *                 highest).
+   * @return Callback index for GetCallbackStats().
+   */
+  int AddPeriodicThread(std::function<void()> callback, units::second_t period,
+                        int priority);
+
+  /**
+   * Get execution statistics for a callback.
+   *
+   * The main loop (LoopFunc()) is callback 0; other indices are returned by
+   * AddPeriodic() and AddPeriodicThread().
+   *
+   * @param callback Callback index.
+   * @return Statistics for the callback.
    */
-  void AddPeriodic(std::function<void()> callback, units::second_t period,
-                   units::second_t offset = 0_s);
+  CallbackStats GetCallbackStats(int callback) const;
 
  private:
+  struct StatsEntry {
+    mutable wpi::mutex mutex;
+    CallbackStats stats;
+
+    void Record(std::chrono::microseconds duration, bool missed);
+  };
+
   class Callback {
    public:
     std::function<void()> func;
     std::chrono::microseconds period;
     std::chrono::microseconds expirationTime;
+    StatsEntry* stats = nullptr;
 
     /**
      * Construct a callback container.
@@ -112,12 +180,24 @@ class TimedRobot : public IterativeRobotBase {
     }
   };
 
+  // Runs a callback that was started at startTime, records its statistics,
+  // and returns the time it finished.
+  std::chrono::microseconds RunCallback(Callback& callback,
+                                        std::chrono::microseconds startTime);
+
+  StatsEntry* AddStats();
+
   hal::Handle<HAL_NotifierHandle, HAL_CleanNotifier> m_notifier;
   std::chrono::microseconds m_startTime;
   uint64_t m_loopStartTimeUs = 0;
 
   wpi::priority_queue<Callback, std::vector<Callback>, std::greater<Callback>>
       m_callbacks;
+
+  std::vector<std::unique_ptr<StatsEntry>> m_stats;
+
+  // Declared after m_stats so the threads are stopped before it's destroyed
+  std::vector<std::unique_ptr<Notifier>> m_threads;
 };
 
 }  // namespace frc
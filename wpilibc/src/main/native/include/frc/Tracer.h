@@ -8,6 +8,7 @@
 #include <string_view>
 
 #include <hal/cpp/fpga_clock.h>
+#include <wpi/AllocationTracker.h>
 #include <wpi/StringMap.h>
 
 namespace wpi {
@@ -22,6 +23,10 @@ namespace frc {
  *
  * Epochs are a way to partition the time elapsed so that when overruns occur,
  * one can determine which parts of an operation consumed the most time.
+ *
+ * While the CycleProfiler is enabled, epochs are also recorded as profiler
+ * zones of the same name, including the allocations made by the calling
+ * thread during the epoch.
  */
 class Tracer {
  public:
@@ -66,6 +71,7 @@ class Tracer {
   static constexpr std::chrono::milliseconds kMinPrintPeriod{1000};
 
   hal::fpga_clock::time_point m_startTime;
+  wpi::AllocationTracker::Counts m_startAllocations;
   hal::fpga_clock::time_point m_lastEpochsPrintTime = hal::fpga_clock::epoch();
 
   wpi::StringMap<std::chrono::nanoseconds> m_epochs;
@@ -0,0 +1,242 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+#include <units/time.h>
+#include <wpi/array.h>
+
+#include "frc/Notifier.h"
+#include "frc/Timer.h"
+#include "frc/estimator/SwerveDrivePoseEstimator.h"
+#include "frc/geometry/Pose2d.h"
+#include "frc/geometry/Rotation2d.h"
+#include "frc/kinematics/SwerveModulePosition.h"
+
+namespace frc {
+
+/**
+ * Samples swerve odometry on a dedicated notifier thread, at a higher rate
+ * than the main robot loop, and feeds the samples into a
+ * SwerveDrivePoseEstimator.
+ *
+ * The notifier thread only reads the sensors and pushes the samples into a
+ * lock-free queue. The queued samples are replayed into the pose estimator
+ * (with their original timestamps) by Poll(), which every other method calls
+ * first, so the estimator is only ever touched by the thread that uses this
+ * object. This means no lock is needed around the estimator, but it also means
+ * the estimator must not be updated through any other path, and all methods
+ * other than Start() and Stop() must be called from the same thread (typically
+ * the main robot thread).
+ *
+ * If the queue fills up because Poll() isn't called often enough, new samples
+ * are dropped. Since samples hold absolute module positions, a dropped sample
+ * only loses resolution, not distance.
+ */
+template <size_t NumModules>
+class SwerveOdometryThread {
+ public:
+  /// Number of samples the queue can hold between calls to Poll().
+  static constexpr size_t kQueueSize = 64;
+
+  /**
+   * A single odometry sample.
+   */
+  struct Sample {
+    /// The time the sample was taken, in the epoch of Timer::GetTimestamp().
+    units::second_t timestamp = 0_s;
+
+    /// The gyro angle.
+    Rotation2d gyroAngle;
+
+    /// The swerve module positions.
+    wpi::array<SwerveModulePosition, NumModules> modulePositions{
+        wpi::empty_array};
+  };
+
+  /**
+   * Constructs a SwerveOdometryThread. The thread doesn't run until Start()
+   * is called.
+   *
+   * @param estimator The pose estimator to update. Its lifetime must exceed
+   *     that of this object.
+   * @param sampler Called on the notifier thread to read the sensors into a
+   *     sample. The sample's timestamp is preset to the current time, but may
+   *     be overwritten with a more precise sensor timestamp.
+   */
+  SwerveOdometryThread(SwerveDrivePoseEstimator<NumModules>& estimator,
+                       std::function<void(Sample& sample)> sampler)
+      : m_estimator{estimator},
+        m_sampler{std::move(sampler)},
+        m_notifier{[this] { TakeSample(); }} {}
+
+  /**
+   * Constructs a SwerveOdometryThread that runs its thread with a real-time
+   * priority. The thread doesn't run until Start() is called.
+   *
+   * @param estimator The pose estimator to update. Its lifetime must exceed
+   *     that of this object.
+   * @param sampler Called on the notifier thread to read the sensors into a
+   *     sample. The sample's timestamp is preset to the current time, but may
+   *     be overwritten with a more precise sensor timestamp.
+   * @param priority The FIFO real-time scheduler priority ([1..99] where a
+   *     higher number represents higher priority).
+   */
+  SwerveOdometryThread(SwerveDrivePoseEstimator<NumModules>& estimator,
+                       std::function<void(Sample& sample)> sampler,
+                       int priority)
+      : m_estimator{estimator},
+        m_sampler{std::move(sampler)},
+        m_notifier{priority, [this] { TakeSample(); }} {}
+
+  SwerveOdometryThread(const SwerveOdometryThread&) = delete;
+  SwerveOdometryThread& operator=(const SwerveOdometryThread&) = delete;
+
+  /**
+   * Starts sampling.
+   *
+   * @param period The sample period.
+   */
+  void Start(units::second_t period = 4_ms) {
+    m_notifier.StartPeriodic(period);
+  }
+
+  /**
+   * Stops sampling. Samples already queued are still replayed by the next
+   * Poll().
+   */
+  void Stop() { m_notifier.Stop(); }
+
+  /**
+   * Replays queued samples into the pose estimator.
+   *
+   * @return The number of samples replayed.
+   */
+  size_t Poll() {
+    size_t head = m_head.load(std::memory_order_relaxed);
+    size_t tail = m_tail.load(std::memory_order_acquire);
+    for (size_t i = head; i != tail; ++i) {
+      m_latest = m_queue[i % kQueueSize];
+      m_estimator.UpdateWithTime(m_latest.timestamp, m_latest.gyroAngle,
+                                 m_latest.modulePositions);
+    }
+    m_head.store(tail, std::memory_order_release);
+    return tail - head;
+  }
+
+  /**
+   * Gets the pose estimate including all samples taken so far.
+   *
+   * @return The estimated robot pose.
+   */
+  Pose2d GetEstimatedPosition() {
+    Poll();
+    return m_estimator.GetEstimatedPosition();
+  }
+
+  /**
+   * Gets the most recent sample replayed into the pose estimator, so the main
+   * loop can see sensor values consistent with the pose estimate.
+   *
+   * @return The latest sample; all zero if no sample has been taken.
+   */
+  const Sample& GetLatestSample() {
+    Poll();
+    return m_latest;
+  }
+
+  /**
+   * Adds a vision measurement to the pose estimator, after replaying queued
+   * samples so the estimator has odometry up to the present.
+   *
+   * @param visionRobotPose The pose of the robot as measured by the vision
+   *     camera.
+   * @param timestamp The timestamp of the vision measurement, in the epoch of
+   *     Timer::GetTimestamp().
+   */
+  void AddVisionMeasurement(const Pose2d& visionRobotPose,
+                            units::second_t timestamp) {
+    Poll();
+    m_estimator.AddVisionMeasurement(visionRobotPose, timestamp);
+  }
+
+  /**
+   * Adds a vision measurement to the pose estimator, after replaying queued
+   * samples so the estimator has odometry up to the present.
+   *
+   * @param visionRobotPose The pose of the robot as measured by the vision
+   *     camera.
+   * @param timestamp The timestamp of the vision measurement, in the epoch of
+   *     Timer::GetTimestamp().
+   * @param visionMeasurementStdDevs Standard deviations of the vision pose
+   *     measurement (x position in meters, y position in meters, and heading in
+   *     radians).
+   */
+  void AddVisionMeasurement(
+      const Pose2d& visionRobotPose, units::second_t timestamp,
+      const wpi::array<double, 3>& visionMeasurementStdDevs) {
+    Poll();
+    m_estimator.AddVisionMeasurement(visionRobotPose, timestamp,
+                                     visionMeasurementStdDevs);
+  }
+
+  /**
+   * Resets the robot's pose, after replaying queued samples.
+   *
+   * @param pose The pose to reset to.
+   */
+  void ResetPose(const Pose2d& pose) {
+    Poll();
+    m_estimator.ResetPose(pose);
+  }
+
+  /**
+   * Gets the number of samples dropped because the queue was full.
+   *
+   * @return Number of dropped samples.
+   */
+  uint64_t GetDroppedSamples() const {
+    return m_dropped.load(std::memory_order_relaxed);
+  }
+
+ private:
+  // Runs on the notifier thread
+  void TakeSample() {
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail - m_head.load(std::memory_order_acquire) == kQueueSize) {
+      m_dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    Sample& sample = m_queue[tail % kQueueSize];
+    sample.timestamp = Timer::GetTimestamp();
+    m_sampler(sample);
+    m_tail.store(tail + 1, std::memory_order_release);
+  }
+
+  SwerveDrivePoseEstimator<NumModules>& m_estimator;
+  std::function<void(Sample&)> m_sampler;
+
+  // Single-producer (notifier thread), single-consumer (Poll()) ring buffer;
+  // m_head and m_tail count samples and are never wrapped.
+  std::array<Sample, kQueueSize> m_queue;
+  std::atomic<size_t> m_head{0};
+  std::atomic<size_t> m_tail{0};
+  std::atomic<uint64_t> m_dropped{0};
+
+  Sample m_latest;
+
+  // Declared last so the thread stops before the rest of the members are
+  // destroyed.
+  Notifier m_notifier;
+};
+
+}  // namespace frc
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #include <functional>
 #include <vector>
 
@@ -36,8 +38,24 @@ class EventLoop {
    */
   void Clear();
 
+  /**
+   * Returns whether the loop is currently being polled.
+   *
+   * @return True while Poll() is running.
+   */
+  bool IsPolling() const { return m_running; }
+
+  /**
+   * Returns the number of times the loop has been polled. While polling, this
+   * identifies the current poll.
+   *
+   * @return Number of calls to Poll().
+   */
+  uint64_t GetPollCount() const { return m_pollCount; }
+
  private:
   std::vector<wpi::unique_function<void()>> m_bindings;
   bool m_running{false};
+  uint64_t m_pollCount{0};
 };
 }  // namespace frc
@@ -8,6 +8,7 @@
 
 #include <networktables/NetworkTable.h>
 #include <networktables/NetworkTableValue.h>
+#include <units/time.h>
 #include <wpi/StringMap.h>
 
 #include "frc/shuffleboard/ShuffleboardComponentBase.h"
@@ -84,6 +85,23 @@ class ShuffleboardComponent : public ShuffleboardComponentBase {
     m_metadataDirty = true;
     return *static_cast<Derived*>(this);
   }
+
+  /**
+   * Sets the minimum time between updates of the value of this component.
+   * By default, the value is updated on every Shuffleboard::Update(). Slowing
+   * down the updates of values that change slowly or aren't watched closely
+   * reduces the cost of large tabs. For complex widgets, this also delays
+   * applying changes made from the dashboard. This has no effect on layouts,
+   * or on simple widgets, whose values are only sent when set.
+   *
+   * @param period the minimum time between value updates, or 0 to update on
+   *               every Shuffleboard::Update()
+   * @return this component
+   */
+  Derived& WithUpdatePeriod(units::second_t period) {
+    m_updatePeriod = period;
+    return *static_cast<Derived*>(this);
+  }
 };
 
 }  // namespace frc
@@ -4,12 +4,15 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #include <memory>
 #include <string>
 #include <string_view>
 
 #include <networktables/NetworkTable.h>
 #include <networktables/NetworkTableValue.h>
+#include <units/time.h>
 #include <wpi/StringMap.h>
 
 #include "frc/shuffleboard/ShuffleboardValue.h"
@@ -34,6 +37,14 @@ class ShuffleboardComponentBase : public virtual ShuffleboardValue {
 
   const std::string& GetType() const;
 
+  /**
+   * Returns true if the value of this component should be updated by this
+   * build, based on the update period, and if so records the update time.
+   *
+   * @return True if the value should be updated
+   */
+  bool ShouldUpdateValue();
+
  protected:
   wpi::StringMap<nt::Value> m_properties;
   bool m_metadataDirty = true;
@@ -41,10 +52,13 @@ class ShuffleboardComponentBase : public virtual ShuffleboardValue {
   int m_row = -1;
   int m_width = -1;
   int m_height = -1;
+  units::second_t m_updatePeriod{0_s};
 
  private:
   ShuffleboardContainer& m_parent;
   std::string m_type;
+  uint64_t m_lastValueUpdate = 0;  // FPGA time in microseconds
+  bool m_valueUpdated = false;
 
   /**
    * Gets the custom properties for this component. May be null.
@@ -11,6 +11,7 @@
 #include <string_view>
 #include <vector>
 
+#include <networktables/NetworkTable.h>
 #include <networktables/NetworkTableEntry.h>
 #include <networktables/NetworkTableValue.h>
 #include <wpi/SmallSet.h>
@@ -684,11 +685,33 @@ class ShuffleboardContainer : public virtual ShuffleboardValue {
  protected:
   bool m_isLayout = false;
 
+  /**
+   * Creates the table of this container and publishes its type, if not
+   * already done.
+   *
+   * @param parentTable the table of the parent
+   */
+  void InitTable(const std::shared_ptr<nt::NetworkTable>& parentTable);
+
+  /**
+   * Builds all components into the table of this container, which must have
+   * been created by InitTable(). The metadata table of each component is
+   * looked up only on its first build.
+   *
+   * @param metaTable the metadata table of this container
+   */
+  void BuildComponents(const std::shared_ptr<nt::NetworkTable>& metaTable);
+
  private:
   wpi::SmallSet<std::string, 32> m_usedTitles;
   std::vector<std::unique_ptr<ShuffleboardComponentBase>> m_components;
   wpi::StringMap<ShuffleboardLayout*> m_layouts;
 
+  // set by the first build
+  std::shared_ptr<nt::NetworkTable> m_table;
+  // metadata tables of m_components, by index
+  std::vector<std::shared_ptr<nt::NetworkTable>> m_componentMetaTables;
+
   /**
    * Adds title to internal set if it hasn't already.
    *
@@ -45,7 +45,9 @@ class SuppliedValueWidget : public ShuffleboardWidget<SuppliedValueWidget<T>> {
       m_entry =
           parentTable->GetTopic(this->GetTitle()).GenericPublish(m_typeString);
     }
-    m_setter(m_entry, m_supplier());
+    if (this->ShouldUpdateValue()) {
+      m_setter(m_entry, m_supplier());
+    }
   }
 
  private:
@@ -0,0 +1,295 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <array>
+#include <random>
+#include <span>
+#include <vector>
+
+#include <Eigen/Core>
+#include <units/time.h>
+
+#include "frc/EigenCore.h"
+#include "frc/system/Discretization.h"
+#include "frc/system/LinearSystem.h"
+
+namespace frc::sim {
+/**
+ * This class simulates many copies of a linear system at once, such as
+ * parameter-perturbed copies of a plant for Monte Carlo analysis of a
+ * controller.
+ *
+ * States, inputs, and outputs are stored in structure-of-arrays form: each is a
+ * matrix with one row per instance and one column per element, so every
+ * column is contiguous across instances and the dynamics are vectorized across
+ * them. Row i of each matrix belongs to the i-th system passed to the
+ * constructor.
+ *
+ * Each instance's system is discretized once per timestep length instead of
+ * once per update. Nonlinear plants can be simulated by overriding UpdateX();
+ * frc::RK4() accepts dynamics functions of the batched state and input
+ * matrices.
+ *
+ * @tparam States  Number of states of the system.
+ * @tparam Inputs  Number of inputs to the system.
+ * @tparam Outputs Number of outputs of the system.
+ */
+template <int States, int Inputs, int Outputs>
+class BatchedLinearSystemSim {
+ public:
+  /// Batched state matrix. Each row is one instance's state.
+  using StateBatch = Eigen::Matrix<double, Eigen::Dynamic, States>;
+
+  /// Batched input matrix. Each row is one instance's input.
+  using InputBatch = Eigen::Matrix<double, Eigen::Dynamic, Inputs>;
+
+  /// Batched output matrix. Each row is one instance's output.
+  using OutputBatch = Eigen::Matrix<double, Eigen::Dynamic, Outputs>;
+
+  /**
+   * Creates a simulation of the given linear systems.
+   *
+   * @param systems            The systems to simulate, one per instance.
+   * @param measurementStdDevs The standard deviations of the measurements.
+   */
+  explicit BatchedLinearSystemSim(
+      std::span<const LinearSystem<States, Inputs, Outputs>> systems,
+      const std::array<double, Outputs>& measurementStdDevs = {})
+      : m_plants(systems.begin(), systems.end()),
+        m_measurementStdDevs(measurementStdDevs),
+        m_generator{std::random_device{}()} {
+    const int size = m_plants.size();
+
+    m_x = StateBatch::Zero(size, States);
+    m_u = InputBatch::Zero(size, Inputs);
+    m_y = OutputBatch::Zero(size, Outputs);
+
+    m_discA.resize(size, States * States);
+    m_discB.resize(size, States * Inputs);
+    m_C.resize(size, Outputs * States);
+    m_D.resize(size, Outputs * Inputs);
+    for (int i = 0; i < size; ++i) {
+      m_C.row(i) = m_plants[i].C().template reshaped<Eigen::RowMajor>();
+      m_D.row(i) = m_plants[i].D().template reshaped<Eigen::RowMajor>();
+    }
+  }
+
+  virtual ~BatchedLinearSystemSim() = default;
+
+  /**
+   * Returns the number of simulated instances.
+   */
+  int Size() const { return m_x.rows(); }
+
+  /**
+   * Updates the simulation.
+   *
+   * @param dt The time between updates.
+   */
+  void Update(units::second_t dt) {
+    // Update x. By default, this is the linear system dynamics xₖ₊₁ = Axₖ +
+    // Buₖ.
+    m_x = UpdateX(m_x, m_u, dt);
+
+    // yₖ = Cxₖ + Duₖ
+    m_y = CalculateY(m_x, m_u);
+
+    // Add noise. If the user did not pass a noise vector to the
+    // constructor, then this method will not do anything because
+    // the standard deviations default to zero.
+    for (int row = 0; row < Outputs; ++row) {
+      // Passing a standard deviation of 0.0 to std::normal_distribution is
+      // undefined behavior
+      if (m_measurementStdDevs[row] != 0.0) {
+        std::normal_distribution distr{0.0, m_measurementStdDevs[row]};
+        for (auto& y : m_y.col(row)) {
+          y += distr(m_generator);
+        }
+      }
+    }
+  }
+
+  /**
+   * Returns the current outputs of the plants.
+   *
+   * @return The current outputs of the plants, one row per instance.
+   */
+  const OutputBatch& GetOutput() const { return m_y; }
+
+  /**
+   * Returns the current output of one plant.
+   *
+   * @param instance The instance whose output to return.
+   * @return The current output of the plant.
+   */
+  Vectord<Outputs> GetOutput(int instance) const {
+    return m_y.row(instance).transpose();
+  }
+
+  /**
+   * Sets the system inputs (usually voltages).
+   *
+   * @param u The system inputs, one row per instance.
+   */
+  void SetInput(const InputBatch& u) { m_u = u; }
+
+  /**
+   * Sets one system's inputs.
+   *
+   * @param instance The instance whose input to set.
+   * @param u        The system inputs.
+   */
+  void SetInput(int instance, const Vectord<Inputs>& u) {
+    m_u.row(instance) = u.transpose();
+  }
+
+  /**
+   * Returns the current inputs of the plants.
+   *
+   * @return The current inputs of the plants, one row per instance.
+   */
+  const InputBatch& GetInput() const { return m_u; }
+
+  /**
+   * Returns the current states of the plants.
+   *
+   * @return The current states of the plants, one row per instance.
+   */
+  const StateBatch& GetState() const { return m_x; }
+
+  /**
+   * Sets the system states.
+   *
+   * @param x The new states, one row per instance.
+   */
+  void SetState(const StateBatch& x) {
+    m_x = x;
+
+    // Update the output to reflect the new state.
+    //
+    //   yₖ = Cxₖ + Duₖ
+    m_y = CalculateY(m_x, m_u);
+  }
+
+  /**
+   * Sets one system's state.
+   *
+   * @param instance The instance whose state to set.
+   * @param x        The new state.
+   */
+  void SetState(int instance, const Vectord<States>& x) {
+    m_x.row(instance) = x.transpose();
+
+    // Update the output to reflect the new state.
+    //
+    //   yₖ = Cxₖ + Duₖ
+    m_y.row(instance) =
+        m_plants[instance].CalculateY(x, m_u.row(instance).transpose());
+  }
+
+ protected:
+  /**
+   * Updates the states of the systems.
+   *
+   * @param currentX The current states, one row per instance.
+   * @param u        The system inputs (usually voltage), one row per instance.
+   * @param dt       The time difference between controller updates.
+   */
+  virtual StateBatch UpdateX(const StateBatch& currentX, const InputBatch& u,
+                             units::second_t dt) {
+    if (dt != m_dt) {
+      for (size_t i = 0; i < m_plants.size(); ++i) {
+        Matrixd<States, States> discA;
+        Matrixd<States, Inputs> discB;
+        DiscretizeAB<States, Inputs>(m_plants[i].A(), m_plants[i].B(), dt,
+                                     &discA, &discB);
+        m_discA.row(i) = discA.template reshaped<Eigen::RowMajor>();
+        m_discB.row(i) = discB.template reshaped<Eigen::RowMajor>();
+      }
+      m_dt = dt;
+    }
+
+    // xₖ₊₁ = Axₖ + Buₖ, one state element at a time for every instance
+    StateBatch x = StateBatch::Zero(currentX.rows(), States);
+    for (int row = 0; row < States; ++row) {
+      for (int col = 0; col < States; ++col) {
+        x.col(row).array() += m_discA.col(row * States + col).array() *
+                              currentX.col(col).array();
+      }
+      for (int col = 0; col < Inputs; ++col) {
+        x.col(row).array() +=
+            m_discB.col(row * Inputs + col).array() * u.col(col).array();
+      }
+    }
+    return x;
+  }
+
+  /**
+   * Computes the outputs of the systems.
+   *
+   * @param x The states, one row per instance.
+   * @param u The inputs, one row per instance.
+   */
+  OutputBatch CalculateY(const StateBatch& x, const InputBatch& u) const {
+    // yₖ = Cxₖ + Duₖ, one output element at a time for every instance
+    OutputBatch y = OutputBatch::Zero(x.rows(), Outputs);
+    for (int row = 0; row < Outputs; ++row) {
+      for (int col = 0; col < States; ++col) {
+        y.col(row).array() +=
+            m_C.col(row * States + col).array() * x.col(col).array();
+      }
+      for (int col = 0; col < Inputs; ++col) {
+        y.col(row).array() +=
+            m_D.col(row * Inputs + col).array() * u.col(col).array();
+      }
+    }
+    return y;
+  }
+
+  /**
+   * Clamp each instance's input vector such that no element exceeds the given
+   * voltage. If any does, the relative magnitudes of that input will be
+   * maintained.
+   *
+   * @param maxInput The maximum magnitude of each input vector after clamping.
+   */
+  void ClampInput(double maxInput) {
+    Eigen::VectorXd scale =
+        maxInput /
+        m_u.cwiseAbs().rowwise().maxCoeff().cwiseMax(maxInput).array();
+    m_u = scale.asDiagonal() * m_u;
+  }
+
+  /// The plants that represent the linear systems.
+  std::vector<LinearSystem<States, Inputs, Outputs>> m_plants;
+
+  /// State matrix.
+  StateBatch m_x;
+
+  /// Input matrix.
+  InputBatch m_u;
+
+  /// Output matrix.
+  OutputBatch m_y;
+
+  /// The standard deviations of measurements, used for adding noise to the
+  /// measurements.
+  std::array<double, Outputs> m_measurementStdDevs;
+
+ private:
+  // Each system's discretized A and B matrices and C and D matrices, one row
+  // per instance with the elements in row-major order
+  Eigen::MatrixXd m_discA;
+  Eigen::MatrixXd m_discB;
+  Eigen::MatrixXd m_C;
+  Eigen::MatrixXd m_D;
+
+  // The timestep m_discA and m_discB were discretized with
+  units::second_t m_dt{-1.0};
+
+  std::mt19937 m_generator;
+};
+}  // namespace frc::sim
@@ -357,5 +357,8 @@ class DifferentialDrivetrainSim {
   Eigen::Vector2d m_u;
   Vectord<7> m_y;
   std::array<double, 7> m_measurementStdDevs;
+
+  // The integrator's next step size from the last update
+  units::second_t m_stepSize = 0_s;
 };
 }  // namespace frc::sim
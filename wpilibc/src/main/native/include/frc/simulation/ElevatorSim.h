@@ -175,5 +175,8 @@ class ElevatorSim : public LinearSystemSim<2, 1, 2> {
   units::meter_t m_minHeight;
   units::meter_t m_maxHeight;
   bool m_simulateGravity;
+
+  // The integrator's next step size from the last update
+  units::second_t m_stepSize = 0_s;
 };
 }  // namespace frc::sim
@@ -135,7 +135,7 @@ class LinearSystemSim {
   virtual Vectord<States> UpdateX(const Vectord<States>& currentXhat,
                                   const Vectord<Inputs>& u,
                                   units::second_t dt) {
-    return m_plant.CalculateX(currentXhat, u, dt);
+    return m_plant.CalculateX(currentXhat, u, dt, m_discreteAB);
   }
 
   /**
@@ -163,5 +163,8 @@ class LinearSystemSim {
   /// The standard deviations of measurements, used for adding noise to the
   /// measurements.
   std::array<double, Outputs> m_measurementStdDevs;
+
+  /// Discretized A and B matrices of the plant for recent timesteps.
+  typename LinearSystem<States, Inputs, Outputs>::DiscreteABCache m_discreteAB;
 };
 }  // namespace frc::sim
@@ -0,0 +1,95 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <units/time.h>
+
+namespace frc::sim {
+
+/**
+ * Updates several physics simulations concurrently on a pool of threads.
+ *
+ * Add each drivetrain or mechanism simulation once, then call Update() from
+ * SimulationPeriodic() instead of calling each simulation's Update(). The
+ * simulations must be independent of each other, and their Update() functions
+ * must not touch shared state such as HAL simulation data, so set inputs and
+ * simulated sensor values before and after Update() on the calling thread.
+ */
+class ParallelSimUpdater {
+ public:
+  /**
+   * Constructs a parallel simulation updater.
+   *
+   * @param numThreads The number of threads to update simulations on,
+   *                   including the thread that calls Update(). Defaults to the
+   *                   number of hardware threads.
+   */
+  explicit ParallelSimUpdater(
+      int numThreads = static_cast<int>(std::thread::hardware_concurrency()));
+
+  ~ParallelSimUpdater();
+
+  ParallelSimUpdater(const ParallelSimUpdater&) = delete;
+  ParallelSimUpdater& operator=(const ParallelSimUpdater&) = delete;
+
+  /**
+   * Adds a simulation to update. The simulation must outlive this object.
+   *
+   * @param sim A simulation with an Update(units::second_t) function, such as
+   *            DifferentialDrivetrainSim or ElevatorSim.
+   */
+  template <typename Sim>
+  void Add(Sim& sim) {
+    Add([&sim](units::second_t dt) { sim.Update(dt); });
+  }
+
+  /**
+   * Adds a function to call on every update.
+   *
+   * @param update The function, which takes the time between updates.
+   */
+  void Add(std::function<void(units::second_t)> update);
+
+  /**
+   * Updates every simulation, and returns once they're all done. If any
+   * simulation throws, one of the exceptions is rethrown after the rest are
+   * done.
+   *
+   * @param dt The time between updates.
+   */
+  void Update(units::second_t dt);
+
+ private:
+  void WorkerMain();
+  void RunUpdates();
+
+  std::vector<std::function<void(units::second_t)>> m_updates;
+  std::vector<std::thread> m_threads;
+
+  std::mutex m_mutex;
+  std::condition_variable m_startCondition;
+  std::condition_variable m_doneCondition;
+
+  // Incremented to start an update on the worker threads
+  uint64_t m_generation = 0;
+  bool m_stop = false;
+  size_t m_activeWorkers = 0;
+
+  units::second_t m_dt = 0_s;
+  std::atomic<size_t> m_next = 0;
+  std::exception_ptr m_exception;
+};
+
+}  // namespace frc::sim
@@ -60,4 +60,21 @@ void StepTiming(units::second_t delta);
  */
 void StepTimingAsync(units::second_t delta);
 
+/**
+ * Enable or disable fast timing. With fast timing, the simulator time advances
+ * directly to the next notifier alarm as soon as all notifiers are waiting, so
+ * the robot program runs as fast as it can rather than in real time. Also
+ * enabled by setting the HALSIM_FAST_TIMING environment variable.
+ *
+ * @param enable true to enable fast timing
+ */
+void SetFastTiming(bool enable);
+
+/**
+ * Check if fast timing is enabled.
+ *
+ * @return true if fast timing is enabled
+ */
+bool IsFastTiming();
+
 }  // namespace frc::sim
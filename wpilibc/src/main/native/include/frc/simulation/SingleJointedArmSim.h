@@ -167,5 +167,8 @@ class SingleJointedArmSim : public LinearSystemSim<2, 1, 2> {
   const DCMotor m_gearbox;
   double m_gearing;
   bool m_simulateGravity;
+
+  // The integrator's next step size from the last update
+  units::second_t m_stepSize = 0_s;
 };
 }  // namespace frc::sim
@@ -12,6 +12,7 @@
 
 #include <networktables/DoubleArrayTopic.h>
 #include <units/length.h>
+#include <units/time.h>
 #include <wpi/SmallVector.h>
 #include <wpi/mutex.h>
 
@@ -97,7 +98,19 @@ class FieldObject2d {
    */
   std::span<const Pose2d> GetPoses(wpi::SmallVectorImpl<Pose2d>& out) const;
 
+  /**
+   * Sets the minimum period between publishes of the poses. Poses set more
+   * often than this are published at the end of the period, when the next
+   * poses are set or SmartDashboard::UpdateValues() is called. This is useful
+   * for objects with many poses, such as trajectories, that are updated every
+   * loop. Defaults to 0 (publish on every change).
+   *
+   * @param period minimum period between publishes
+   */
+  void SetPublishPeriod(units::second_t period);
+
  private:
+  void PublishIfDue();
   void UpdateEntry(bool setDefault = false);
   void UpdateFromEntry() const;
 
@@ -105,6 +118,14 @@ class FieldObject2d {
   std::string m_name;
   nt::DoubleArrayEntry m_entry;
   mutable wpi::SmallVector<Pose2d, 1> m_poses;
+
+  // True if m_poses has changes that haven't been published yet
+  bool m_dirty = false;
+  units::second_t m_publishPeriod = 0_s;
+  units::second_t m_lastPublish = 0_s;
+  // Entry last change time after our last publish; if it differs, the entry
+  // was changed remotely
+  int64_t m_publishedChange = 0;
 };
 
 }  // namespace frc
@@ -210,21 +210,38 @@ class SendableBuilderImpl : public nt::NTSendableBuilder {
       std::function<void(std::span<const uint8_t>)> setter) override;
 
  private:
+  // Values changed by one Update(), published together
+  struct ValueBatch {
+    std::vector<NT_Handle> handles;
+    std::vector<nt::Value> values;
+
+    void Add(NT_Handle handle, nt::Value&& value) {
+      handles.emplace_back(handle);
+      values.emplace_back(std::move(value));
+    }
+  };
+
   struct Property {
     virtual ~Property() = default;
-    virtual void Update(bool controllable, int64_t time) = 0;
+    virtual void Update(bool controllable, int64_t time,
+                        ValueBatch& batch) = 0;
   };
 
   template <typename Topic>
   struct PropertyImpl : public Property {
-    void Update(bool controllable, int64_t time) override;
+    void Update(bool controllable, int64_t time, ValueBatch& batch) override;
 
     using Publisher = typename Topic::PublisherType;
     using Subscriber = typename Topic::SubscriberType;
     Publisher pub;
     Subscriber sub;
-    std::function<void(Publisher& pub, int64_t time)> updateNetwork;
-    std::function<void(Subscriber& sub)> updateLocal;
+    // Adds the getter value to the batch if it changed since the last call
+    // (or if force is true)
+    std::function<void(Publisher& pub, int64_t time, bool force,
+                       ValueBatch& batch)>
+        updateNetwork;
+    // Passes received values to the setter; returns true if there were any
+    std::function<bool(Subscriber& sub)> updateLocal;
   };
 
   template <typename Topic, typename Getter, typename Setter>
@@ -238,6 +255,7 @@ class SendableBuilderImpl : public nt::NTSendableBuilder {
   void AddSmallPropertyImpl(Topic topic, Getter getter, Setter setter);
 
   std::vector<std::unique_ptr<Property>> m_properties;
+  ValueBatch m_batch;
   std::function<void()> m_safeState;
   std::vector<wpi::unique_function<void()>> m_updateTables;
   std::shared_ptr<nt::NetworkTable> m_table;
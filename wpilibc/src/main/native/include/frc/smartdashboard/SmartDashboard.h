@@ -109,6 +109,17 @@ class SmartDashboard {
    */
   static wpi::Sendable* GetData(std::string_view keyName);
 
+  /**
+   * Sets how often the Sendable mapped to the specified key is updated by
+   * UpdateValues(). Sendables with the same period are updated on different
+   * cycles where possible, to spread the work evenly.
+   *
+   * @param key the key
+   * @param cycles update every this many calls to UpdateValues() (1 to update
+   *               on every call, the default)
+   */
+  static void SetUpdatePeriod(std::string_view key, int cycles);
+
   /**
    * Maps the specified key to the specified value in this table.
    *
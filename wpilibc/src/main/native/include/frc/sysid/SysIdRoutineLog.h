@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <functional>
+#include <memory>
 #include <string>
 #include <string_view>
 
@@ -13,10 +15,13 @@
 #include <units/angular_velocity.h>
 #include <units/current.h>
 #include <units/length.h>
+#include <units/time.h>
 #include <units/velocity.h>
 #include <units/voltage.h>
 #include <wpi/DataLog.h>
 
+#include "frc/Notifier.h"
+
 namespace frc::sysid {
 
 /**
@@ -189,6 +194,37 @@ class SysIdRoutineLog {
    */
   MotorLog Motor(std::string_view motorName);
 
+  /**
+   * Starts capturing motor data on a dedicated real-time notifier thread
+   * instead of the robot loop. The log callback is called every period, so
+   * data can be sampled much faster than the robot loop (e.g. 1 ms), which
+   * reduces noise in the fits of fast mechanisms.
+   *
+   * The callback runs on the notifier thread, so the sensor reads it does must
+   * be safe to call concurrently with the robot loop, and Motor() must not be
+   * called from other threads while capturing.
+   *
+   * @param log Callback that logs motor data using Motor().
+   * @param period The sampling period.
+   * @param priority The real-time priority of the notifier thread, 1-99 with
+   *   99 being highest.
+   */
+  void StartCapture(std::function<void(SysIdRoutineLog*)> log,
+                    units::second_t period, int priority = 40);
+
+  /**
+   * Stops capturing motor data started with StartCapture(). If a capture is
+   * in progress, this blocks until it completes.
+   */
+  void StopCapture();
+
+  /**
+   * Returns true if motor data is being captured on a notifier thread.
+   *
+   * @return True if capturing.
+   */
+  bool IsCapturing() const { return m_captureNotifier != nullptr; }
+
   static std::string StateEnumToString(State state);
 
  private:
@@ -196,5 +232,6 @@ class SysIdRoutineLog {
   std::string m_logName;
   bool m_stateInitialized = false;
   wpi::log::StringLogEntry m_state;
+  std::unique_ptr<frc::Notifier> m_captureNotifier;
 };
 }  // namespace frc::sysid
@@ -0,0 +1,53 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/AddressableLEDBuffer.h"  // NOLINT(build/include_order)
+
+#include <array>
+
+#include <gtest/gtest.h>
+#include <hal/HAL.h>
+
+#include "frc/LEDPattern.h"
+#include "frc/simulation/AddressableLEDSim.h"
+
+namespace frc {
+
+TEST(AddressableLEDBufferTest, FlushWritesChangedSegments) {
+  HAL_Initialize(500, 0);
+
+  AddressableLED led{0};
+  led.SetLength(10);
+  sim::AddressableLEDSim sim{led};
+  int writes = 0;
+  auto cb = sim.RegisterDataCallback(
+      [&](std::string_view, const unsigned char*, unsigned int) { ++writes; },
+      false);
+
+  AddressableLEDBuffer buffer{10};
+  EXPECT_EQ(10, buffer.GetLength());
+  LEDPattern::Solid(Color::kRed).ApplyTo(buffer.Segment(2, 3));
+  buffer.Flush(led);
+  EXPECT_EQ(1, writes);
+
+  // nothing changed, so nothing is written
+  buffer.Flush(led);
+  EXPECT_EQ(1, writes);
+
+  LEDPattern::Solid(Color::kBlue).ApplyTo(buffer.Segment(8, 1));
+  buffer.Flush(led);
+  EXPECT_EQ(2, writes);
+
+  std::array<HAL_AddressableLEDData, 10> simData;
+  ASSERT_EQ(10, sim.GetData(simData.data()));
+  for (int i = 0; i < 10; i++) {
+    bool red = i >= 2 && i < 5;
+    bool blue = i == 8;
+    EXPECT_EQ(red ? 255 : 0, simData[i].r) << i;
+    EXPECT_EQ(0, simData[i].g) << i;
+    EXPECT_EQ(blue ? 255 : 0, simData[i].b) << i;
+  }
+}
+
+}  // namespace frc
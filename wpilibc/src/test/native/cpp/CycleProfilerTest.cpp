@@ -0,0 +1,84 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <gtest/gtest.h>
+
+#include "frc/CycleProfiler.h"
+#include "frc/Tracer.h"
+#include "frc/simulation/SimHooks.h"
+
+class CycleProfilerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    frc::sim::PauseTiming();
+    frc::CycleProfiler::Reset();
+    frc::CycleProfiler::SetEnabled(true);
+  }
+
+  void TearDown() override {
+    frc::CycleProfiler::SetEnabled(false);
+    frc::sim::ResumeTiming();
+  }
+};
+
+TEST_F(CycleProfilerTest, Zones) {
+  for (int i = 1; i <= 3; ++i) {
+    for (int j = 0; j < 2; ++j) {
+      FRC_PROFILE_ZONE("CycleProfilerTest.Zones");
+      frc::sim::StepTiming(i * 1_ms);
+    }
+    frc::CycleProfiler::EndCycle();
+  }
+
+  int zone = frc::CycleProfiler::RegisterZone("CycleProfilerTest.Zones");
+  auto stats = frc::CycleProfiler::GetZoneStats(zone);
+  EXPECT_EQ(3, stats.cycles);
+  EXPECT_EQ(6_ms, stats.last);
+  EXPECT_EQ(4_ms, stats.average);
+  EXPECT_EQ(6_ms, stats.max);
+
+  auto history = frc::CycleProfiler::GetHistory(zone);
+  ASSERT_EQ(3u, history.size());
+  EXPECT_EQ(2_ms, history[0]);
+  EXPECT_EQ(4_ms, history[1]);
+  EXPECT_EQ(6_ms, history[2]);
+}
+
+TEST_F(CycleProfilerTest, Disabled) {
+  frc::CycleProfiler::SetEnabled(false);
+  {
+    FRC_PROFILE_ZONE("CycleProfilerTest.Disabled");
+    frc::sim::StepTiming(1_ms);
+  }
+  frc::CycleProfiler::EndCycle();
+
+  int zone = frc::CycleProfiler::RegisterZone("CycleProfilerTest.Disabled");
+  EXPECT_EQ(0, frc::CycleProfiler::GetZoneStats(zone).cycles);
+}
+
+TEST_F(CycleProfilerTest, TracerEpochs) {
+  frc::Tracer tracer;
+  frc::sim::StepTiming(5_ms);
+  tracer.AddEpoch("CycleProfilerTest.TracerEpochs");
+  frc::CycleProfiler::EndCycle();
+
+  int zone =
+      frc::CycleProfiler::RegisterZone("CycleProfilerTest.TracerEpochs");
+  EXPECT_EQ(5_ms, frc::CycleProfiler::GetZoneStats(zone).last);
+}
+
+TEST_F(CycleProfilerTest, Allocations) {
+  int zone = frc::CycleProfiler::RegisterZone("CycleProfilerTest.Allocations");
+  frc::CycleProfiler::RecordAllocations(zone, 2, 64);
+  frc::CycleProfiler::RecordAllocations(zone, 1, 16);
+  frc::CycleProfiler::EndCycle();
+  auto stats = frc::CycleProfiler::GetZoneStats(zone);
+  EXPECT_EQ(3, stats.lastAllocations);
+  EXPECT_EQ(80, stats.lastAllocatedBytes);
+
+  frc::CycleProfiler::EndCycle();
+  stats = frc::CycleProfiler::GetZoneStats(zone);
+  EXPECT_EQ(0, stats.lastAllocations);
+  EXPECT_EQ(3, stats.totalAllocations);
+}
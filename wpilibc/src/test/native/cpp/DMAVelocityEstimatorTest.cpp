@@ -0,0 +1,50 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "frc/DMAVelocityEstimator.h"
+
+using frc::DMAVelocityEstimator;
+
+TEST(DMAVelocityEstimatorTest, FitTooFewSamples) {
+  std::vector<double> times{0.5};
+  std::vector<double> positions{3.0};
+  EXPECT_EQ(DMAVelocityEstimator::FitVelocity({}, {}), 0.0);
+  EXPECT_EQ(DMAVelocityEstimator::FitVelocity(times, positions), 0.0);
+}
+
+TEST(DMAVelocityEstimatorTest, FitSameTime) {
+  std::vector<double> times{1.0, 1.0, 1.0};
+  std::vector<double> positions{1.0, 2.0, 3.0};
+  EXPECT_EQ(DMAVelocityEstimator::FitVelocity(times, positions), 0.0);
+}
+
+TEST(DMAVelocityEstimatorTest, FitLine) {
+  std::vector<double> times;
+  std::vector<double> positions;
+  // out of order, as in the estimator's ring buffer
+  for (int i : {5, 6, 7, 0, 1, 2, 3, 4}) {
+    times.push_back(100.0 + i * 0.001);
+    positions.push_back(-2.0 + 3.5 * i * 0.001);
+  }
+  EXPECT_NEAR(DMAVelocityEstimator::FitVelocity(times, positions), 3.5, 1e-6);
+}
+
+TEST(DMAVelocityEstimatorTest, FitQuantized) {
+  // 1 mm/count encoder moving at 0.3 m/s, sampled at 1 kHz; the difference of
+  // successive samples is 0 or 1 count (0 or 1 m/s), but the fit over 20
+  // samples is much closer
+  std::vector<double> times;
+  std::vector<double> positions;
+  for (int i = 0; i < 20; ++i) {
+    double time = i * 0.001;
+    times.push_back(time);
+    positions.push_back(std::floor(0.3 * time / 0.001) * 0.001);
+  }
+  EXPECT_NEAR(DMAVelocityEstimator::FitVelocity(times, positions), 0.3, 0.02);
+}
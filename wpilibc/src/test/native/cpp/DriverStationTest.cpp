@@ -74,3 +74,21 @@ INSTANTIATE_TEST_SUITE_P(
             true, false, false,
             "Warning: Joystick Button 1 missing (max 0), check if all "
             "controllers are plugged in\n")));
+
+TEST(DriverStationTest, JoystickSnapshot) {
+  frc::sim::DriverStationSim::SetJoystickAxisCount(2, 2);
+  frc::sim::DriverStationSim::SetJoystickAxis(2, 1, 0.5);
+  frc::sim::DriverStationSim::SetJoystickPOVCount(2, 1);
+  frc::sim::DriverStationSim::SetJoystickPOV(2, 0, 90);
+  frc::sim::DriverStationSim::SetJoystickButtonCount(2, 3);
+  frc::sim::DriverStationSim::SetJoystickButtons(2, 0b101);
+  frc::sim::DriverStationSim::NotifyNewData();
+
+  auto snapshot = frc::DriverStation::GetJoystickSnapshot(2);
+  EXPECT_EQ(snapshot.axisCount, 2);
+  EXPECT_EQ(snapshot.axes[1], 0.5);
+  EXPECT_EQ(snapshot.povCount, 1);
+  EXPECT_EQ(snapshot.povs[0], 90);
+  EXPECT_EQ(snapshot.buttonCount, 3);
+  EXPECT_EQ(snapshot.buttons, 0b101u);
+}
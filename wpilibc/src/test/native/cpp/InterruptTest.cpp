@@ -3,6 +3,7 @@
 // the WPILib BSD license file in the root directory of this project.
 
 #include <atomic>
+#include <thread>
 
 #include <gtest/gtest.h>
 #include <hal/HAL.h>
@@ -100,4 +101,47 @@ TEST(InterruptTest, FallingEdge) {
   EXPECT_TRUE(hasFiredFallingEdge);
   EXPECT_FALSE(hasFiredRisingEdge);
 }
+
+TEST(InterruptTest, MultipleInterrupts) {
+  HAL_Initialize(500, 0);
+
+  std::atomic_int counter1{0};
+  std::atomic_int counter2{0};
+  std::thread::id thread1;
+  std::thread::id thread2;
+
+  DigitalInput di1{0};
+  DigitalInput di2{1};
+  AsynchronousInterrupt interrupt1{di1, [&](bool rising, bool falling) {
+                                     thread1 = std::this_thread::get_id();
+                                     counter1++;
+                                   }};
+  AsynchronousInterrupt interrupt2{di2, [&](bool rising, bool falling) {
+                                     thread2 = std::this_thread::get_id();
+                                     counter2++;
+                                   }};
+  DIOSim digitalSim1{di1};
+  DIOSim digitalSim2{di2};
+  digitalSim1.SetValue(false);
+  digitalSim2.SetValue(false);
+  interrupt1.Enable();
+  interrupt2.Enable();
+  frc::Wait(0.5_s);
+  digitalSim1.SetValue(true);
+  frc::Wait(20_ms);
+  digitalSim2.SetValue(true);
+
+  int count = 0;
+  while (counter1 == 0 || counter2 == 0) {
+    frc::Wait(5_ms);
+    count++;
+    ASSERT_TRUE(count < 1000);
+  }
+  interrupt1.Disable();
+  interrupt2.Disable();
+  EXPECT_EQ(1, counter1.load());
+  EXPECT_EQ(1, counter2.load());
+  // both callbacks run on the shared thread
+  EXPECT_EQ(thread1, thread2);
+}
 }  // namespace frc
@@ -175,6 +175,24 @@ TEST(LEDPatternTest, SingleHalfStepSetsHalfOffHalfColor) {
   }
 }
 
+TEST(LEDPatternTest, UnorderedStepsApplyInPositionOrder) {
+  std::array<std::pair<double, Color>, 3> steps{std::pair{0.5, Color::kRed},
+                                                std::pair{0.0, Color::kBlue},
+                                                std::pair{0.5, Color::kGreen}};
+  LEDPattern pattern = LEDPattern::Steps(steps);
+  std::array<AddressableLED::LEDData, 10> buffer;
+
+  pattern.ApplyTo(buffer);
+
+  for (int i = 0; i < 5; i++) {
+    AssertIndexColor(buffer, i, Color::kBlue);
+  }
+  // the later of two steps at the same position wins
+  for (int i = 5; i < 10; i++) {
+    AssertIndexColor(buffer, i, Color::kGreen);
+  }
+}
+
 TEST(LEDPatternTest, ScrollRelativeForward) {
   // A black to white gradient
   LEDPattern pattern = LEDPattern{[=](auto data, auto writer) {
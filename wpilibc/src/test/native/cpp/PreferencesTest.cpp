@@ -0,0 +1,41 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <gtest/gtest.h>
+#include <networktables/NetworkTableInstance.h>
+
+#include "frc/Preferences.h"
+
+TEST(PreferencesTest, DoubleHandle) {
+  auto inst = nt::NetworkTableInstance::GetDefault();
+  frc::Preferences::Remove("handleDouble");
+
+  auto handle = frc::Preferences::GetDoubleHandle("handleDouble", 1.5);
+  EXPECT_EQ(1.5, handle.Get());
+  EXPECT_EQ(1.5, frc::Preferences::GetDouble("handleDouble"));
+
+  // changes made elsewhere are picked up by the listener
+  frc::Preferences::SetDouble("handleDouble", 2.5);
+  inst.WaitForListenerQueue(1.0);
+  EXPECT_EQ(2.5, handle.Get());
+
+  handle.Set(3.5);
+  EXPECT_EQ(3.5, handle.Get());
+  EXPECT_EQ(3.5, frc::Preferences::GetDouble("handleDouble"));
+
+  // integers are converted
+  frc::Preferences::Remove("handleDouble");
+  inst.WaitForListenerQueue(1.0);
+  frc::Preferences::SetLong("handleDouble", 4);
+  inst.WaitForListenerQueue(1.0);
+  EXPECT_EQ(4.0, handle.Get());
+}
+
+TEST(PreferencesTest, ExistingValue) {
+  frc::Preferences::SetBoolean("handleBoolean", true);
+  frc::Preferences::SetLong("handleLong", 42);
+
+  EXPECT_TRUE(frc::Preferences::GetBooleanHandle("handleBoolean").Get());
+  EXPECT_EQ(42, frc::Preferences::GetLongHandle("handleLong", 7).Get());
+}
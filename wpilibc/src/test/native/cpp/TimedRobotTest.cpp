@@ -610,4 +610,39 @@ TEST_F(TimedRobotTest, AddPeriodicWithOffset) {
   robotThread.join();
 }
 
+TEST_F(TimedRobotTest, CallbackStats) {
+  MockRobot robot;
+
+  std::atomic<uint32_t> callbackCount{0};
+  int callback = robot.AddPeriodic([&] { callbackCount++; }, kPeriod / 2.0);
+  EXPECT_EQ(1, callback);
+
+  std::thread robotThread{[&] { robot.StartCompetition(); }};
+
+  frc::sim::DriverStationSim::SetEnabled(false);
+  frc::sim::DriverStationSim::NotifyNewData();
+  frc::sim::StepTiming(0_ms);  // Wait for Notifiers
+
+  frc::sim::StepTiming(kPeriod);
+
+  EXPECT_EQ(2u, callbackCount);
+
+  // Simulated time doesn't advance while callbacks run, so every run lands in
+  // the first bucket and meets its deadline
+  auto stats = robot.GetCallbackStats(callback);
+  EXPECT_EQ(2, stats.runs);
+  EXPECT_EQ(0, stats.deadlineMisses);
+  EXPECT_EQ(0_s, stats.maxDuration);
+  EXPECT_EQ(2, stats.histogram[0]);
+
+  auto loopStats = robot.GetCallbackStats(0);
+  EXPECT_EQ(1, loopStats.runs);
+  EXPECT_EQ(0, loopStats.deadlineMisses);
+
+  EXPECT_THROW(robot.GetCallbackStats(2), frc::RuntimeError);
+
+  robot.EndCompetition();
+  robotThread.join();
+}
+
 INSTANTIATE_TEST_SUITE_P(TimedRobotTests, TimedRobotTest, testing::Bool());
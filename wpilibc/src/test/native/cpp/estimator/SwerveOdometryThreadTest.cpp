@@ -0,0 +1,90 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <gtest/gtest.h>
+
+#include "frc/estimator/SwerveOdometryThread.h"
+#include "frc/simulation/SimHooks.h"
+
+using namespace frc;
+
+namespace {
+
+class SwerveOdometryThreadTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    sim::PauseTiming();
+    sim::RestartTiming();
+  }
+
+  void TearDown() override { sim::ResumeTiming(); }
+
+  // Drives straight ahead at 1 m/s
+  static void Sample(SwerveOdometryThread<4>::Sample& sample) {
+    units::meter_t distance = sample.timestamp * 1_mps;
+    for (auto& position : sample.modulePositions) {
+      position = {distance, 0_deg};
+    }
+  }
+
+  Translation2d m_fl{12_m, 12_m};
+  Translation2d m_fr{12_m, -12_m};
+  Translation2d m_bl{-12_m, 12_m};
+  Translation2d m_br{-12_m, -12_m};
+  SwerveDriveKinematics<4> m_kinematics{m_fl, m_fr, m_bl, m_br};
+  SwerveDrivePoseEstimator<4> m_estimator{
+      m_kinematics,
+      Rotation2d{},
+      {SwerveModulePosition{}, SwerveModulePosition{}, SwerveModulePosition{},
+       SwerveModulePosition{}},
+      Pose2d{}};
+};
+
+}  // namespace
+
+TEST_F(SwerveOdometryThreadTest, ReplaysSamples) {
+  SwerveOdometryThread<4> thread{m_estimator, Sample};
+  thread.Start(5_ms);
+
+  size_t samples = 0;
+  for (int i = 0; i < 50; ++i) {
+    sim::StepTiming(20_ms);
+    samples += thread.Poll();
+  }
+  thread.Stop();
+
+  EXPECT_EQ(samples, 200u);
+  EXPECT_EQ(thread.GetDroppedSamples(), 0u);
+  EXPECT_NEAR(thread.GetLatestSample().timestamp.value(), 1.0, 1e-6);
+  EXPECT_NEAR(thread.GetEstimatedPosition().X().value(), 1.0, 1e-6);
+  EXPECT_NEAR(thread.GetEstimatedPosition().Y().value(), 0.0, 1e-6);
+}
+
+TEST_F(SwerveOdometryThreadTest, DropsSamplesWhenFull) {
+  SwerveOdometryThread<4> thread{m_estimator, Sample};
+  thread.Start(5_ms);
+  sim::StepTiming(1_s);
+  thread.Stop();
+
+  EXPECT_EQ(thread.Poll(), SwerveOdometryThread<4>::kQueueSize);
+  EXPECT_EQ(thread.GetDroppedSamples(),
+            200u - SwerveOdometryThread<4>::kQueueSize);
+
+  // the samples that were kept still hold absolute positions
+  EXPECT_NEAR(thread.GetEstimatedPosition().X().value(),
+              thread.GetLatestSample().timestamp.value(), 1e-6);
+}
+
+TEST_F(SwerveOdometryThreadTest, VisionMeasurement) {
+  SwerveOdometryThread<4> thread{m_estimator, Sample};
+  thread.Start(5_ms);
+  sim::StepTiming(100_ms);
+
+  // the queued samples are replayed before the vision measurement is applied,
+  // so it isn't discarded as being newer than the odometry
+  thread.AddVisionMeasurement(Pose2d{0.1_m, 1_m, 0_deg}, 100_ms,
+                              {0.01, 0.01, 0.01});
+  EXPECT_GT(thread.GetEstimatedPosition().Y().value(), 0.5);
+  thread.Stop();
+}
@@ -11,6 +11,7 @@
 
 #include "frc/shuffleboard/ShuffleboardInstance.h"
 #include "frc/shuffleboard/ShuffleboardTab.h"
+#include "frc/simulation/SimHooks.h"
 
 using namespace frc;
 
@@ -108,3 +109,24 @@ TEST_F(SuppliedValueWidgetTest, AddRaw) {
   auto actual = entry.GetValue().GetRaw();
   EXPECT_EQ(bytes, std::vector<uint8_t>(actual.begin(), actual.end()));
 }
+
+TEST_F(SuppliedValueWidgetTest, UpdatePeriod) {
+  frc::sim::PauseTiming();
+  int num = 0;
+  m_tab->AddNumber("Num", [&num]() { return ++num; })
+      .WithUpdatePeriod(100_ms);
+  auto entry = m_ntInst.inst.GetEntry("/Shuffleboard/Tab/Num");
+
+  m_shuffleboardInst.Update();
+  EXPECT_FLOAT_EQ(1.0, entry.GetValue().GetDouble());
+
+  // not updated again until the period has passed
+  frc::sim::StepTiming(50_ms);
+  m_shuffleboardInst.Update();
+  EXPECT_FLOAT_EQ(1.0, entry.GetValue().GetDouble());
+
+  frc::sim::StepTiming(50_ms);
+  m_shuffleboardInst.Update();
+  EXPECT_FLOAT_EQ(2.0, entry.GetValue().GetDouble());
+  frc::sim::ResumeTiming();
+}
@@ -0,0 +1,109 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "frc/simulation/BatchedLinearSystemSim.h"
+#include "frc/simulation/LinearSystemSim.h"
+#include "frc/system/NumericalIntegration.h"
+#include "frc/system/plant/DCMotor.h"
+#include "frc/system/plant/LinearSystemId.h"
+
+namespace {
+
+std::vector<frc::LinearSystem<2, 1, 2>> MakePerturbedElevators() {
+  // Elevators with a range of carriage masses
+  std::vector<frc::LinearSystem<2, 1, 2>> plants;
+  for (int i = 0; i < 10; ++i) {
+    plants.push_back(frc::LinearSystemId::ElevatorSystem(
+        frc::DCMotor::NEO(2), units::kilogram_t{20.0 + i}, 0.05_m, 10.0));
+  }
+  return plants;
+}
+
+}  // namespace
+
+TEST(BatchedLinearSystemSimTest, MatchesIndividualSims) {
+  auto plants = MakePerturbedElevators();
+
+  frc::sim::BatchedLinearSystemSim<2, 1, 2> batch{plants};
+  std::vector<frc::sim::LinearSystemSim<2, 1, 2>> sims;
+  for (const auto& plant : plants) {
+    sims.emplace_back(plant);
+  }
+  ASSERT_EQ(static_cast<int>(plants.size()), batch.Size());
+
+  for (int step = 0; step < 50; ++step) {
+    for (int i = 0; i < batch.Size(); ++i) {
+      frc::Vectord<1> u{12.0 * (i + 1) / batch.Size()};
+      batch.SetInput(i, u);
+      sims[i].SetInput(u);
+      sims[i].Update(20_ms);
+    }
+    batch.Update(20_ms);
+
+    for (int i = 0; i < batch.Size(); ++i) {
+      EXPECT_NEAR(sims[i].GetOutput(0), batch.GetOutput(i)(0), 1e-9);
+    }
+  }
+}
+
+TEST(BatchedLinearSystemSimTest, SetState) {
+  auto plants = MakePerturbedElevators();
+  frc::sim::BatchedLinearSystemSim<2, 1, 2> batch{plants};
+
+  frc::sim::BatchedLinearSystemSim<2, 1, 2>::StateBatch x{batch.Size(), 2};
+  x.col(0).setLinSpaced(0.0, 1.0);
+  x.col(1).setZero();
+  batch.SetState(x);
+  EXPECT_EQ(x.col(0), batch.GetOutput().col(0));
+
+  batch.SetState(3, frc::Vectord<2>{2.0, 0.5});
+  EXPECT_EQ(2.0, batch.GetState()(3, 0));
+  EXPECT_EQ(0.5, batch.GetState()(3, 1));
+  EXPECT_EQ(2.0, batch.GetOutput(3)(0));
+}
+
+namespace {
+
+// Elevators with gravity, which makes the dynamics affine
+class BatchedElevatorSim : public frc::sim::BatchedLinearSystemSim<2, 1, 2> {
+ public:
+  using BatchedLinearSystemSim::BatchedLinearSystemSim;
+
+ protected:
+  StateBatch UpdateX(const StateBatch& currentX, const InputBatch& u,
+                     units::second_t dt) override {
+    return frc::RK4(
+        [&](const StateBatch& x, const InputBatch& u) -> StateBatch {
+          StateBatch xdot{x.rows(), 2};
+          for (int i = 0; i < x.rows(); ++i) {
+            xdot.row(i) = (m_plants[i].A() * x.row(i).transpose() +
+                           m_plants[i].B() * u.row(i).transpose())
+                              .transpose();
+          }
+          xdot.col(1).array() -= 9.8;
+          return xdot;
+        },
+        currentX, u, dt);
+  }
+};
+
+}  // namespace
+
+TEST(BatchedLinearSystemSimTest, NonlinearUpdate) {
+  auto plants = MakePerturbedElevators();
+  BatchedElevatorSim batch{plants};
+
+  // With no input, every elevator falls
+  for (int step = 0; step < 10; ++step) {
+    batch.Update(20_ms);
+  }
+  for (int i = 0; i < batch.Size(); ++i) {
+    EXPECT_LT(batch.GetOutput(i)(0), 0.0);
+    EXPECT_LT(batch.GetState()(i, 1), 0.0);
+  }
+}
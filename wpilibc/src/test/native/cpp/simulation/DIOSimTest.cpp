@@ -77,4 +77,20 @@ TEST(DIOSimTest, Output) {
   EXPECT_TRUE(valueCallback.WasTriggered());
   EXPECT_FALSE(valueCallback.GetLastValue());
 }
+
+TEST(DIOSimTest, InputBulk) {
+  HAL_Initialize(500, 0);
+  DigitalInput input0{0};
+  DigitalInput input1{1};
+  DIOSim sim0(input0);
+  DIOSim sim1(input1);
+  sim0.SetValue(false);
+  sim1.SetValue(true);
+
+  const DigitalInput* inputs[] = {&input1, &input0};
+  bool values[2];
+  DigitalInput::GetBulk(inputs, values);
+  EXPECT_TRUE(values[0]);
+  EXPECT_FALSE(values[1]);
+}
 }  // namespace frc::sim
@@ -100,6 +100,22 @@ TEST(PWMSimTest, SetSpeed) {
   EXPECT_NEAR(1.0, pwm.GetPosition(), kPWMStepSize);
 }
 
+TEST(PWMSimTest, SetSpeedBulk) {
+  HAL_Initialize(500, 0);
+
+  PWMSim sim0{0};
+  PWMSim sim1{1};
+  PWM pwm0{0};
+  PWM pwm1{1};
+
+  PWM* pwms[] = {&pwm0, &pwm1};
+  double speeds[] = {0.5, -0.25};
+  PWM::SetSpeedBulk(pwms, speeds);
+
+  EXPECT_NEAR(0.5, sim0.GetSpeed(), kPWMStepSize);
+  EXPECT_NEAR(-0.25, sim1.GetSpeed(), kPWMStepSize);
+}
+
 TEST(PWMSimTest, SetPosition) {
   HAL_Initialize(500, 0);
 
@@ -0,0 +1,61 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "frc/simulation/DifferentialDrivetrainSim.h"
+#include "frc/simulation/ParallelSimUpdater.h"
+#include "frc/system/plant/DCMotor.h"
+
+TEST(ParallelSimUpdaterTest, MatchesSequentialUpdates) {
+  auto MakeSim = [] {
+    return frc::sim::DifferentialDrivetrainSim{
+        frc::DCMotor::NEO(2), 10.71, 5_kg_sq_m, 50_kg, 3_in, 24_in};
+  };
+
+  std::vector<frc::sim::DifferentialDrivetrainSim> parallelSims;
+  std::vector<frc::sim::DifferentialDrivetrainSim> sequentialSims;
+  for (int i = 0; i < 6; ++i) {
+    parallelSims.push_back(MakeSim());
+    sequentialSims.push_back(MakeSim());
+  }
+
+  frc::sim::ParallelSimUpdater updater{4};
+  for (auto& sim : parallelSims) {
+    updater.Add(sim);
+  }
+
+  for (int step = 0; step < 50; ++step) {
+    for (size_t i = 0; i < parallelSims.size(); ++i) {
+      auto left = units::volt_t{2.0 * i};
+      auto right = units::volt_t{12.0 - 2.0 * i};
+      parallelSims[i].SetInputs(left, right);
+      sequentialSims[i].SetInputs(left, right);
+      sequentialSims[i].Update(20_ms);
+    }
+    updater.Update(20_ms);
+  }
+
+  for (size_t i = 0; i < parallelSims.size(); ++i) {
+    EXPECT_EQ(sequentialSims[i].GetPose(), parallelSims[i].GetPose());
+  }
+}
+
+TEST(ParallelSimUpdaterTest, RethrowsException) {
+  frc::sim::ParallelSimUpdater updater{3};
+
+  int calls = 0;
+  updater.Add([&](units::second_t) { throw std::runtime_error{"error"}; });
+  updater.Add([&](units::second_t) { ++calls; });
+
+  EXPECT_THROW(updater.Update(20_ms), std::runtime_error);
+  EXPECT_EQ(1, calls);
+
+  // The updater is still usable afterward
+  EXPECT_THROW(updater.Update(20_ms), std::runtime_error);
+  EXPECT_EQ(2, calls);
+}
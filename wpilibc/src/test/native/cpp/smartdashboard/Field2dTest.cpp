@@ -0,0 +1,47 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <vector>
+
+#include <frc/simulation/SimHooks.h>
+#include <frc/smartdashboard/Field2d.h>
+#include <frc/smartdashboard/SmartDashboard.h>
+
+#include <gtest/gtest.h>
+#include <networktables/NetworkTableInstance.h>
+
+TEST(Field2dTest, RepublishRemoteChange) {
+  frc::Field2d field;
+  auto entry = nt::NetworkTableInstance::GetDefault().GetEntry(
+      "/SmartDashboard/field/Robot");
+  frc::SmartDashboard::PutData("field", &field);
+  field.SetRobotPose(1_m, 2_m, 0_deg);
+  EXPECT_EQ((std::vector<double>{1, 2, 0}), entry.GetDoubleArray({}));
+
+  // setting the same pose again is skipped, but not after a remote change
+  entry.SetDoubleArray(std::vector<double>{3, 4, 0});
+  field.SetRobotPose(1_m, 2_m, 0_deg);
+  EXPECT_EQ((std::vector<double>{1, 2, 0}), entry.GetDoubleArray({}));
+}
+
+TEST(Field2dTest, PublishPeriod) {
+  frc::sim::PauseTiming();
+  frc::Field2d field;
+  auto entry = nt::NetworkTableInstance::GetDefault().GetEntry(
+      "/SmartDashboard/periodField/traj");
+  auto obj = field.GetObject("traj");
+  obj->SetPublishPeriod(100_ms);
+  frc::SmartDashboard::PutData("periodField", &field);
+
+  // held back until the period elapses
+  obj->SetPose(1_m, 2_m, 0_deg);
+  frc::SmartDashboard::UpdateValues();
+  EXPECT_TRUE(entry.GetDoubleArray({}).empty());
+  EXPECT_EQ(1_m, obj->GetPose().X());
+
+  frc::sim::StepTiming(100_ms);
+  frc::SmartDashboard::UpdateValues();
+  EXPECT_EQ((std::vector<double>{1, 2, 0}), entry.GetDoubleArray({}));
+  frc::sim::ResumeTiming();
+}
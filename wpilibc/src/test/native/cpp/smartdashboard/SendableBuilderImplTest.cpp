@@ -0,0 +1,88 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <gtest/gtest.h>
+#include <networktables/DoubleTopic.h>
+#include <networktables/NetworkTableInstance.h>
+#include <wpi/sendable/Sendable.h>
+#include <wpi/sendable/SendableBuilder.h>
+#include <wpi/sendable/SendableRegistry.h>
+
+#include "frc/smartdashboard/SendableBuilderImpl.h"
+#include "frc/smartdashboard/SmartDashboard.h"
+
+class SendableBuilderImplTest : public ::testing::Test {
+ protected:
+  void SetUp() override { m_inst = nt::NetworkTableInstance::Create(); }
+
+  void TearDown() override { nt::NetworkTableInstance::Destroy(m_inst); }
+
+  nt::NetworkTableInstance m_inst;
+};
+
+TEST_F(SendableBuilderImplTest, UnchangedValuesNotPublished) {
+  auto table = m_inst.GetTable("test");
+  auto sub = table->GetDoubleTopic("value").Subscribe(
+      0.0, {.keepDuplicates = true});
+
+  double value = 1.0;
+  int getterCalls = 0;
+  frc::SendableBuilderImpl builder;
+  builder.SetTable(table);
+  builder.AddDoubleProperty(
+      "value",
+      [&] {
+        ++getterCalls;
+        return value;
+      },
+      nullptr);
+
+  builder.Update();
+  builder.Update();
+  builder.Update();
+  EXPECT_EQ(3, getterCalls);
+  EXPECT_EQ(1u, sub.ReadQueue().size());
+
+  value = 2.0;
+  builder.Update();
+  builder.Update();
+  auto values = sub.ReadQueue();
+  ASSERT_EQ(1u, values.size());
+  EXPECT_EQ(2.0, values[0].value);
+}
+
+namespace {
+class CountingSendable : public wpi::Sendable {
+ public:
+  void InitSendable(wpi::SendableBuilder& builder) override {
+    builder.AddDoubleProperty("count", [this] { return ++count; }, nullptr);
+  }
+
+  int count = 0;
+};
+}  // namespace
+
+TEST(SmartDashboardUpdateTest, UpdatePeriod) {
+  CountingSendable every;
+  CountingSendable third;
+  wpi::SendableRegistry::Add(&every, "every");
+  wpi::SendableRegistry::Add(&third, "third");
+  frc::SmartDashboard::PutData("UpdatePeriodEvery", &every);
+  frc::SmartDashboard::PutData("UpdatePeriodThird", &third);
+  frc::SmartDashboard::SetUpdatePeriod("UpdatePeriodThird", 3);
+  every.count = 0;
+  third.count = 0;
+
+  for (int i = 0; i < 9; ++i) {
+    frc::SmartDashboard::UpdateValues();
+  }
+  EXPECT_EQ(9, every.count);
+  EXPECT_EQ(3, third.count);
+
+  EXPECT_THROW(frc::SmartDashboard::SetUpdatePeriod("UpdatePeriodThird", 0),
+               std::runtime_error);
+
+  wpi::SendableRegistry::Remove(&every);
+  wpi::SendableRegistry::Remove(&third);
+}
@@ -79,4 +79,25 @@ public final class SimHooks {
   public static void stepTimingAsync(double deltaSeconds) {
     SimulatorJNI.stepTimingAsync((long) (deltaSeconds * 1e6));
   }
+
+  /**
+   * Enable or disable fast timing. With fast timing, the simulator time advances
+   * directly to the next notifier alarm as soon as all notifiers are waiting, so
+   * the robot program runs as fast as it can rather than in real time. Also
+   * enabled by setting the HALSIM_FAST_TIMING environment variable.
+   *
+   * @param enable true to enable fast timing
+   */
+  public static void setFastTiming(boolean enable) {
+    SimulatorJNI.setFastTiming(enable);
+  }
+
+  /**
+   * Check if fast timing is enabled.
+   *
+   * @return true if fast timing is enabled
+   */
+  public static boolean isFastTiming() {
+    return SimulatorJNI.isFastTiming();
+  }
 }
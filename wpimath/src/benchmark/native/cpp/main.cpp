@@ -0,0 +1,376 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+// Microbenchmarks for the wpimath code robot programs run every loop.  For
+// each case, reports the time per operation and the number of heap
+// allocations per operation (counted by replacing the global operator new).
+//
+// Usage: wpimathBenchmark [--quick] [filter]
+//
+// Only cases whose name contains the filter are run.  --quick runs each case
+// for less time.
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <string_view>
+#include <vector>
+
+#include <wpi/print.h>
+
+#include "frc/DARE.h"
+#include "frc/EigenCore.h"
+#include "frc/estimator/AngleStatistics.h"
+#include "frc/estimator/SwerveDrivePoseEstimator.h"
+#include "frc/estimator/UnscentedKalmanFilter.h"
+#include "frc/geometry/Pose3d.h"
+#include "frc/kinematics/SwerveDriveKinematics.h"
+#include "frc/system/plant/DCMotor.h"
+#include "frc/trajectory/TrajectoryConfig.h"
+#include "frc/trajectory/TrajectoryGenerator.h"
+#include "units/moment_of_inertia.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+static std::atomic<uint64_t> gAllocations{0};
+
+// GCC 11+ sees free() on a pointer from the (inlined) replacement operator
+// new and flags it as mismatched, even though both sides are ours.
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(size_t size) {
+  gAllocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+  std::free(p);
+}
+
+// Over-aligned types (fixed-size vectorizable Eigen members) go through the
+// aligned overloads, so those must be counted too.
+void* operator new(size_t size, std::align_val_t align) {
+  gAllocations.fetch_add(1, std::memory_order_relaxed);
+  size_t alignment = static_cast<size_t>(align);
+  // aligned_alloc() requires the size to be a multiple of the alignment
+  size = (size == 0 ? 1 : size) + alignment - 1;
+  size -= size % alignment;
+#ifdef _MSC_VER
+  if (void* p = _aligned_malloc(size, alignment)) {
+#else
+  if (void* p = std::aligned_alloc(alignment, size)) {
+#endif
+    return p;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* p, std::align_val_t) noexcept {
+#ifdef _MSC_VER
+  _aligned_free(p);
+#else
+  std::free(p);
+#endif
+}
+
+void operator delete(void* p, size_t, std::align_val_t align) noexcept {
+  operator delete(p, align);
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+namespace {
+
+// Keeps the compiler from optimizing away the computation of value
+template <typename T>
+void DoNotOptimize(const T& value) {
+#ifdef _MSC_VER
+  static const void* volatile sink;
+  sink = &value;
+  _ReadWriteBarrier();
+#else
+  asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+struct Benchmark {
+  std::string_view name;
+  // called once before timing; returns the operation to time
+  std::function<std::function<void()>()> setup;
+};
+
+// Runs op repeatedly for about minTime and prints the time and allocations per
+// operation
+void Run(std::string_view name, const std::function<void()>& op,
+         std::chrono::duration<double> minTime) {
+  using Clock = std::chrono::steady_clock;
+
+  // warm up, and find the number of iterations per timing batch
+  op();
+  uint64_t batch = 1;
+  for (;;) {
+    auto start = Clock::now();
+    for (uint64_t i = 0; i < batch; ++i) {
+      op();
+    }
+    if (Clock::now() - start > minTime / 20 || batch >= (1u << 30)) {
+      break;
+    }
+    batch *= 2;
+  }
+
+  uint64_t iterations = 0;
+  uint64_t allocations = gAllocations.load(std::memory_order_relaxed);
+  auto start = Clock::now();
+  auto elapsed = Clock::duration::zero();
+  do {
+    for (uint64_t i = 0; i < batch; ++i) {
+      op();
+    }
+    iterations += batch;
+    elapsed = Clock::now() - start;
+  } while (elapsed < minTime);
+  allocations = gAllocations.load(std::memory_order_relaxed) - allocations;
+
+  wpi::print("{:<48} {:>12.1f} {:>12.2f}\n", name,
+             std::chrono::duration<double, std::nano>(elapsed).count() /
+                 iterations,
+             static_cast<double>(allocations) / iterations);
+}
+
+frc::Vectord<5> Dynamics(const frc::Vectord<5>& x, const frc::Vectord<2>& u) {
+  auto motors = frc::DCMotor::CIM(2);
+
+  constexpr double Ghigh = 7.08;       // High gear ratio
+  constexpr auto rb = 0.8382_m / 2.0;  // Robot radius
+  constexpr auto r = 0.0746125_m;      // Wheel radius
+  constexpr auto m = 63.503_kg;        // Robot mass
+  constexpr auto J = 5.6_kg_sq_m;      // Robot moment of inertia
+
+  auto C1 = -std::pow(Ghigh, 2) * motors.Kt /
+            (motors.Kv * motors.R * units::math::pow<2>(r));
+  auto C2 = Ghigh * motors.Kt / (motors.R * r);
+  auto k1 = (1 / m + units::math::pow<2>(rb) / J);
+  auto k2 = (1 / m - units::math::pow<2>(rb) / J);
+
+  units::meters_per_second_t vl{x(3)};
+  units::meters_per_second_t vr{x(4)};
+  units::volt_t Vl{u(0)};
+  units::volt_t Vr{u(1)};
+
+  auto v = 0.5 * (vl + vr);
+  return frc::Vectord<5>{
+      v.value() * std::cos(x(2)), v.value() * std::sin(x(2)),
+      ((vr - vl) / (2.0 * rb)).value(),
+      k1.value() * ((C1 * vl).value() + (C2 * Vl).value()) +
+          k2.value() * ((C1 * vr).value() + (C2 * Vr).value()),
+      k2.value() * ((C1 * vl).value() + (C2 * Vl).value()) +
+          k1.value() * ((C1 * vr).value() + (C2 * Vr).value())};
+}
+
+frc::Vectord<3> LocalMeasurementModel(
+    const frc::Vectord<5>& x, [[maybe_unused]] const frc::Vectord<2>& u) {
+  return frc::Vectord<3>{x(2), x(3), x(4)};
+}
+
+frc::SwerveDriveKinematics<4> MakeSwerveKinematics() {
+  return frc::SwerveDriveKinematics<4>{
+      frc::Translation2d{0.3_m, 0.3_m}, frc::Translation2d{0.3_m, -0.3_m},
+      frc::Translation2d{-0.3_m, 0.3_m}, frc::Translation2d{-0.3_m, -0.3_m}};
+}
+
+std::vector<Benchmark> GetBenchmarks() {
+  std::vector<Benchmark> benchmarks;
+
+  benchmarks.push_back({"SwerveDriveKinematics::ToSwerveModuleStates", [] {
+                          return [kinematics = MakeSwerveKinematics()] {
+                            frc::ChassisSpeeds speeds{1_mps, 0.5_mps,
+                                                      1_rad_per_s};
+                            DoNotOptimize(
+                                kinematics.ToSwerveModuleStates(speeds));
+                          };
+                        }});
+
+  benchmarks.push_back(
+      {"SwerveDriveKinematics::ToChassisSpeeds", [] {
+         return [kinematics = MakeSwerveKinematics()] {
+           wpi::array<frc::SwerveModuleState, 4> states{
+               frc::SwerveModuleState{1_mps, 10_deg},
+               frc::SwerveModuleState{1.1_mps, 20_deg},
+               frc::SwerveModuleState{0.9_mps, 30_deg},
+               frc::SwerveModuleState{1_mps, 40_deg}};
+           DoNotOptimize(kinematics.ToChassisSpeeds(states));
+         };
+       }});
+
+  benchmarks.push_back(
+      {"SwerveDrivePoseEstimator::Update", [] {
+         struct State {
+           frc::SwerveDriveKinematics<4> kinematics = MakeSwerveKinematics();
+           wpi::array<frc::SwerveModulePosition, 4> positions{wpi::empty_array};
+           frc::SwerveDrivePoseEstimator<4> estimator{
+               kinematics,    frc::Rotation2d{}, positions,
+               frc::Pose2d{}, {0.1, 0.1, 0.1},   {0.45, 0.45, 0.45}};
+           units::second_t time = 0_s;
+         };
+         auto state = std::make_shared<State>();
+         return [state] {
+           state->time += 20_ms;
+           for (auto&& position : state->positions) {
+             position.distance += 0.02_m;
+           }
+           DoNotOptimize(state->estimator.UpdateWithTime(
+               state->time, frc::Rotation2d{}, state->positions));
+         };
+       }});
+
+  benchmarks.push_back(
+      {"SwerveDrivePoseEstimator::AddVisionMeasurement", [] {
+         struct State {
+           frc::SwerveDriveKinematics<4> kinematics = MakeSwerveKinematics();
+           wpi::array<frc::SwerveModulePosition, 4> positions{wpi::empty_array};
+           frc::SwerveDrivePoseEstimator<4> estimator{
+               kinematics,    frc::Rotation2d{}, positions,
+               frc::Pose2d{}, {0.1, 0.1, 0.1},   {0.45, 0.45, 0.45}};
+           units::second_t time = 0_s;
+         };
+         auto state = std::make_shared<State>();
+         // fill the odometry buffer
+         for (int i = 0; i < 100; ++i) {
+           state->time += 20_ms;
+           for (auto&& position : state->positions) {
+             position.distance += 0.02_m;
+           }
+           state->estimator.UpdateWithTime(state->time, frc::Rotation2d{},
+                                           state->positions);
+         }
+         return [state] {
+           state->time += 20_ms;
+           for (auto&& position : state->positions) {
+             position.distance += 0.02_m;
+           }
+           state->estimator.UpdateWithTime(state->time, frc::Rotation2d{},
+                                           state->positions);
+           // a measurement with 100 ms of latency
+           state->estimator.AddVisionMeasurement(
+               frc::Pose2d{state->positions[0].distance, 0_m, 0_deg},
+               state->time - 100_ms);
+           DoNotOptimize(state->estimator.GetEstimatedPosition());
+         };
+       }});
+
+  auto makeUKF = [] {
+    return std::make_shared<frc::UnscentedKalmanFilter<5, 2, 3>>(
+        Dynamics, LocalMeasurementModel,
+        wpi::array<double, 5>{0.5, 0.5, 10.0, 1.0, 1.0},
+        wpi::array<double, 3>{0.0001, 0.01, 0.01}, frc::AngleMean<5, 5>(2),
+        frc::AngleMean<3, 5>(0), frc::AngleResidual<5>(2),
+        frc::AngleResidual<3>(0), frc::AngleAdd<5>(2), 5_ms);
+  };
+
+  benchmarks.push_back({"UnscentedKalmanFilter<5, 2, 3>::Predict", [=] {
+                          return [observer = makeUKF()] {
+                            observer->Predict(frc::Vectord<2>{1.0, 1.0}, 5_ms);
+                            DoNotOptimize(observer->Xhat());
+                          };
+                        }});
+
+  benchmarks.push_back({"UnscentedKalmanFilter<5, 2, 3>::Correct", [=] {
+                          return [observer = makeUKF()] {
+                            observer->Correct(frc::Vectord<2>{1.0, 1.0},
+                                              frc::Vectord<3>{0.1, 1.0, 1.0});
+                            DoNotOptimize(observer->Xhat());
+                          };
+                        }});
+
+  benchmarks.push_back(
+      {"DARE<4, 2>", [] {
+         return [] {
+           frc::Matrixd<4, 4> A{{1.0, 0.005, 0.0, 0.0},
+                                {0.0, 0.98, 0.0, 0.0},
+                                {0.0, 0.0, 1.0, 0.005},
+                                {0.0, 0.0, 0.0, 0.98}};
+           frc::Matrixd<4, 2> B{
+               {0.0, 0.0}, {0.01, 0.0}, {0.0, 0.0}, {0.0, 0.01}};
+           frc::Matrixd<4, 4> Q = frc::Matrixd<4, 4>::Identity();
+           frc::Matrixd<2, 2> R = frc::Matrixd<2, 2>::Identity();
+           DoNotOptimize(frc::DARE<4, 2>(A, B, Q, R, false));
+         };
+       }});
+
+  benchmarks.push_back(
+      {"TrajectoryGenerator::GenerateTrajectory", [] {
+         return [] {
+           DoNotOptimize(frc::TrajectoryGenerator::GenerateTrajectory(
+               frc::Pose2d{}, {frc::Translation2d{1_m, 1_m}},
+               frc::Pose2d{3_m, 0_m, -45_deg},
+               frc::TrajectoryConfig{3_mps, 2_mps_sq}));
+         };
+       }});
+
+  benchmarks.push_back(
+      {"Pose3d::Exp", [] {
+         return [] {
+           frc::Pose3d pose{1_m, 2_m, 3_m, frc::Rotation3d{0.1_rad, 0.2_rad,
+                                                           0.3_rad}};
+           DoNotOptimize(pose.Exp(frc::Twist3d{0.1_m, 0.2_m, 0.3_m, 0.01_rad,
+                                               0.02_rad, 0.03_rad}));
+         };
+       }});
+
+  benchmarks.push_back(
+      {"Pose3d::Log", [] {
+         return [] {
+           frc::Pose3d start{1_m, 2_m, 3_m,
+                             frc::Rotation3d{0.1_rad, 0.2_rad, 0.3_rad}};
+           frc::Pose3d end{1.1_m, 2.2_m, 3.3_m,
+                           frc::Rotation3d{0.11_rad, 0.22_rad, 0.33_rad}};
+           DoNotOptimize(start.Log(end));
+         };
+       }});
+
+  return benchmarks;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::chrono::duration<double> minTime = std::chrono::seconds{1};
+  std::string_view filter;
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg{argv[i]};
+    if (arg == "--quick") {
+      minTime = std::chrono::milliseconds{100};
+    } else {
+      filter = arg;
+    }
+  }
+
+  wpi::print("{:<48} {:>12} {:>12}\n", "benchmark", "ns/op", "allocs/op");
+  for (auto&& benchmark : GetBenchmarks()) {
+    if (benchmark.name.find(filter) == std::string_view::npos) {
+      continue;
+    }
+    Run(benchmark.name, benchmark.setup(), minTime);
+  }
+}
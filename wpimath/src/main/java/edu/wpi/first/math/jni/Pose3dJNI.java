@@ -41,6 +41,20 @@ public final class Pose3dJNI extends WPIMathJNI {
       double twistRy,
       double twistRz);
 
+  /**
+   * Obtains multiple Pose3ds from (constant curvature) velocities in one call. This is much
+   * faster than calling exp() for each pose.
+   *
+   * <p>Each pose is 7 consecutive elements of the form [x, y, z, qw, qx, qy, qz], and each twist
+   * is 6 consecutive elements of the form [dx, dy, dz, rx, ry, rz].
+   *
+   * @param poses The poses; 7 elements per pose.
+   * @param twists The twists; 6 elements per pose.
+   * @param result Array to store the new poses into; must be the same length as poses.
+   * @throws IllegalArgumentException if the array lengths don't match.
+   */
+  public static native void expBatch(double[] poses, double[] twists, double[] result);
+
   /**
    * Returns a Twist3d that maps the starting pose to the end pose.
    *
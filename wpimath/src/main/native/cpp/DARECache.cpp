@@ -0,0 +1,154 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/DARECache.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <bit>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include <fmt/format.h>
+#include <wpi/mutex.h>
+
+using namespace frc;
+
+namespace {
+
+// The cache file is a sequence of records, each of which is the key length and
+// value length as uint64_t followed by the key and value as doubles
+constexpr std::string_view kFilename = "DARECache.bin";
+
+// Orders keys by the bit patterns of their elements, as comparing doubles
+// isn't a strict weak ordering once NaN is involved
+struct KeyLess {
+  bool operator()(const std::vector<double>& lhs,
+                  const std::vector<double>& rhs) const {
+    return std::lexicographical_compare(
+        lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+        [](double a, double b) {
+          return std::bit_cast<uint64_t>(a) < std::bit_cast<uint64_t>(b);
+        });
+  }
+};
+
+struct Cache {
+  wpi::mutex mutex;
+  std::map<std::vector<double>, std::vector<double>, KeyLess> entries;
+  std::string path;
+};
+
+Cache& GetCache() {
+  static Cache cache;
+  return cache;
+}
+
+void WriteRecord(std::ofstream& file, std::span<const double> key,
+                 std::span<const double> value) {
+  uint64_t sizes[2] = {key.size(), value.size()};
+  file.write(reinterpret_cast<const char*>(sizes), sizeof(sizes));
+  file.write(reinterpret_cast<const char*>(key.data()),
+             key.size() * sizeof(double));
+  file.write(reinterpret_cast<const char*>(value.data()),
+             value.size() * sizeof(double));
+}
+
+}  // namespace
+
+void DARECache::SetDirectory(std::string_view directory) {
+  auto& cache = GetCache();
+  std::scoped_lock lock{cache.mutex};
+
+  if (directory.empty()) {
+    cache.path.clear();
+    return;
+  }
+  cache.path = fmt::format("{}/{}", directory, kFilename);
+
+  std::ifstream file{cache.path, std::ios::binary};
+  if (!file) {
+    return;
+  }
+
+  bool corrupt = false;
+  while (cache.entries.size() < kMaxEntries) {
+    uint64_t sizes[2];
+    if (!file.read(reinterpret_cast<char*>(sizes), sizeof(sizes))) {
+      corrupt = file.gcount() != 0;
+      break;
+    }
+
+    if (sizes[0] > (1 << 20) || sizes[1] > (1 << 20)) {
+      corrupt = true;
+      break;
+    }
+
+    std::vector<double> key(sizes[0]);
+    std::vector<double> value(sizes[1]);
+    if (!file.read(reinterpret_cast<char*>(key.data()),
+                   key.size() * sizeof(double)) ||
+        !file.read(reinterpret_cast<char*>(value.data()),
+                   value.size() * sizeof(double))) {
+      corrupt = true;
+      break;
+    }
+    cache.entries.try_emplace(std::move(key), std::move(value));
+  }
+  file.close();
+
+  // Records appended after a truncated or corrupt one (e.g., from a program
+  // killed mid-write) would never be read, so rewrite the file from the valid
+  // records
+  if (corrupt) {
+    std::ofstream out{cache.path, std::ios::binary | std::ios::trunc};
+    for (const auto& [key, value] : cache.entries) {
+      WriteRecord(out, key, value);
+    }
+  }
+}
+
+void DARECache::Clear() {
+  auto& cache = GetCache();
+  std::scoped_lock lock{cache.mutex};
+  cache.entries.clear();
+}
+
+std::optional<std::vector<double>> DARECache::Find(
+    std::span<const double> key) {
+  auto& cache = GetCache();
+  std::scoped_lock lock{cache.mutex};
+
+  auto it = cache.entries.find(std::vector<double>{key.begin(), key.end()});
+  if (it == cache.entries.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+void DARECache::Insert(std::span<const double> key,
+                       std::span<const double> value) {
+  auto& cache = GetCache();
+  std::scoped_lock lock{cache.mutex};
+
+  if (cache.entries.size() >= kMaxEntries) {
+    return;
+  }
+
+  bool inserted =
+      cache.entries
+          .try_emplace(std::vector<double>{key.begin(), key.end()},
+                       value.begin(), value.end())
+          .second;
+  if (!inserted || cache.path.empty()) {
+    return;
+  }
+
+  std::ofstream file{cache.path, std::ios::binary | std::ios::app};
+  WriteRecord(file, key, value);
+}
@@ -6,10 +6,12 @@
 
 #include <cmath>
 #include <stdexcept>
+#include <vector>
 
 #include <Eigen/Cholesky>
 
 #include "frc/DARE.h"
+#include "frc/DARECache.h"
 #include "frc/MathUtil.h"
 #include "frc/StateSpaceUtil.h"
 #include "frc/system/Discretization.h"
@@ -82,6 +84,26 @@ LTVDifferentialDriveController::LTVDifferentialDriveController(
         "Max velocity of plant with 12 V input must be less than 15 m/s.");
   }
 
+  // Building the gain table takes a DARE solve per velocity, so it's cached by
+  // everything it depends on
+  std::vector<double> key{
+      static_cast<double>(detail::DARECacheKind::kLTVDifferentialDrive),
+      dt.value(), m_trackwidth.value()};
+  detail::AppendToDARECacheKey(key, plant.A(), plant.B(), Q, R);
+
+  // Each table entry is the velocity followed by the gain matrix
+  constexpr size_t kEntrySize = 1 + Matrixd<2, 5>::SizeAtCompileTime;
+
+  if (auto table = DARECache::Find(key)) {
+    for (size_t i = 0; i < table->size(); i += kEntrySize) {
+      m_table.insert(units::meters_per_second_t{(*table)[i]},
+                     Eigen::Map<const Matrixd<2, 5>>{table->data() + i + 1});
+    }
+    return;
+  }
+
+  std::vector<double> table;
+
   auto R_llt = R.llt();
 
   for (auto velocity = -maxV; velocity < maxV; velocity += 0.01_mps) {
@@ -100,10 +122,16 @@ LTVDifferentialDriveController::LTVDifferentialDriveController(
     auto S = detail::DARE<5, 2>(discA, discB, Q, R_llt);
 
     // K = (BᵀSB + R)⁻¹BᵀSA
-    m_table.insert(velocity, (discB.transpose() * S * discB + R)
-                                 .llt()
-                                 .solve(discB.transpose() * S * discA));
+    Matrixd<2, 5> K = (discB.transpose() * S * discB + R)
+                         .llt()
+                         .solve(discB.transpose() * S * discA);
+    m_table.insert(velocity, K);
+
+    table.push_back(velocity.value());
+    table.insert(table.end(), K.data(), K.data() + K.size());
   }
+
+  DARECache::Insert(key, table);
 }
 
 bool LTVDifferentialDriveController::AtReference() const {
@@ -5,10 +5,12 @@
 #include "frc/controller/LTVUnicycleController.h"
 
 #include <stdexcept>
+#include <vector>
 
 #include <Eigen/Cholesky>
 
 #include "frc/DARE.h"
+#include "frc/DARECache.h"
 #include "frc/StateSpaceUtil.h"
 #include "frc/system/Discretization.h"
 #include "units/math.h"
@@ -87,6 +89,26 @@ LTVUnicycleController::LTVUnicycleController(
   Matrixd<3, 3> Q = frc::MakeCostMatrix(Qelems);
   Matrixd<2, 2> R = frc::MakeCostMatrix(Relems);
 
+  // Building the gain table takes a DARE solve per velocity, so it's cached by
+  // everything it depends on
+  std::vector<double> key{
+      static_cast<double>(detail::DARECacheKind::kLTVUnicycle), dt.value(),
+      maxVelocity.value()};
+  detail::AppendToDARECacheKey(key, Q, R);
+
+  // Each table entry is the velocity followed by the gain matrix
+  constexpr size_t kEntrySize = 1 + Matrixd<2, 3>::SizeAtCompileTime;
+
+  if (auto table = DARECache::Find(key)) {
+    for (size_t i = 0; i < table->size(); i += kEntrySize) {
+      m_table.insert(units::meters_per_second_t{(*table)[i]},
+                     Eigen::Map<const Matrixd<2, 3>>{table->data() + i + 1});
+    }
+    return;
+  }
+
+  std::vector<double> table;
+
   auto R_llt = R.llt();
 
   for (auto velocity = -maxVelocity; velocity < maxVelocity;
@@ -106,10 +128,16 @@ LTVUnicycleController::LTVUnicycleController(
     auto S = detail::DARE<3, 2>(discA, discB, Q, R_llt);
 
     // K = (BᵀSB + R)⁻¹BᵀSA
-    m_table.insert(velocity, (discB.transpose() * S * discB + R)
-                                 .llt()
-                                 .solve(discB.transpose() * S * discA));
+    Matrixd<2, 3> K = (discB.transpose() * S * discB + R)
+                         .llt()
+                         .solve(discB.transpose() * S * discA);
+    m_table.insert(velocity, K);
+
+    table.push_back(velocity.value());
+    table.insert(table.end(), K.data(), K.data() + K.size());
   }
+
+  DARECache::Insert(key, table);
 }
 
 bool LTVUnicycleController::AtReference() const {
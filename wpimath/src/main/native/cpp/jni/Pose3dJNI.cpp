@@ -6,6 +6,7 @@
 
 #include <wpi/jni_util.h>
 
+#include "Exceptions.h"
 #include "edu_wpi_first_math_jni_Pose3dJNI.h"
 #include "frc/geometry/Pose3d.h"
 
@@ -67,4 +68,50 @@ Java_edu_wpi_first_math_jni_Pose3dJNI_log
              result.rx.value(), result.ry.value(), result.rz.value()}});
 }
 
+/*
+ * Class:     edu_wpi_first_math_jni_Pose3dJNI
+ * Method:    expBatch
+ * Signature: ([D[D[D)V
+ */
+JNIEXPORT void JNICALL
+Java_edu_wpi_first_math_jni_Pose3dJNI_expBatch
+  (JNIEnv* env, jclass, jdoubleArray poses, jdoubleArray twists,
+   jdoubleArray result)
+{
+  jsize posesLen = env->GetArrayLength(poses);
+  if (posesLen % 7 != 0 || env->GetArrayLength(twists) != posesLen / 7 * 6 ||
+      env->GetArrayLength(result) != posesLen) {
+    illegalArgEx.Throw(env,
+                       "poses and result must have 7 elements per pose and "
+                       "twists must have 6 elements per pose");
+    return;
+  }
+
+  CriticalJSpan<const jdouble> posesRef{env, poses};
+  CriticalJSpan<const jdouble> twistsRef{env, twists};
+  CriticalJSpan<jdouble> resultRef{env, result};
+  for (jsize i = 0; i < posesLen / 7; ++i) {
+    const jdouble* p = &posesRef[i * 7];
+    const jdouble* t = &twistsRef[i * 6];
+    frc::Pose3d pose{units::meter_t{p[0]}, units::meter_t{p[1]},
+                     units::meter_t{p[2]},
+                     frc::Rotation3d{frc::Quaternion{p[3], p[4], p[5], p[6]}}};
+    frc::Twist3d twist{units::meter_t{t[0]},  units::meter_t{t[1]},
+                       units::meter_t{t[2]},  units::radian_t{t[3]},
+                       units::radian_t{t[4]}, units::radian_t{t[5]}};
+
+    frc::Pose3d out = pose.Exp(twist);
+
+    const auto& q = out.Rotation().GetQuaternion();
+    jdouble* r = &resultRef[i * 7];
+    r[0] = out.X().value();
+    r[1] = out.Y().value();
+    r[2] = out.Z().value();
+    r[3] = q.W();
+    r[4] = q.X();
+    r[5] = q.Y();
+    r[6] = q.Z();
+  }
+}
+
 }  // extern "C"
@@ -0,0 +1,90 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/trajectory/CompactTrajectory.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using namespace frc;
+
+CompactTrajectory::CompactTrajectory(const Trajectory& trajectory) {
+  const auto& states = trajectory.States();
+  m_t.reserve(states.size());
+  m_velocity.reserve(states.size());
+  m_acceleration.reserve(states.size());
+  m_x.reserve(states.size());
+  m_y.reserve(states.size());
+  m_cos.reserve(states.size());
+  m_sin.reserve(states.size());
+  m_curvature.reserve(states.size());
+  for (auto&& state : states) {
+    m_t.emplace_back(state.t.value());
+    m_velocity.emplace_back(state.velocity.value());
+    m_acceleration.emplace_back(state.acceleration.value());
+    m_x.emplace_back(state.pose.X().value());
+    m_y.emplace_back(state.pose.Y().value());
+    m_cos.emplace_back(state.pose.Rotation().Cos());
+    m_sin.emplace_back(state.pose.Rotation().Sin());
+    m_curvature.emplace_back(state.curvature.value());
+  }
+}
+
+Trajectory::State CompactTrajectory::GetState(size_t index) const {
+  return {units::second_t{m_t[index]},
+          units::meters_per_second_t{m_velocity[index]},
+          units::meters_per_second_squared_t{m_acceleration[index]},
+          Pose2d{units::meter_t{m_x[index]}, units::meter_t{m_y[index]},
+                 Rotation2d{m_cos[index], m_sin[index]}},
+          units::curvature_t{m_curvature[index]}};
+}
+
+Trajectory CompactTrajectory::ToTrajectory() const {
+  std::vector<Trajectory::State> states;
+  states.reserve(m_t.size());
+  for (size_t i = 0; i < m_t.size(); ++i) {
+    states.emplace_back(GetState(i));
+  }
+  return Trajectory{std::move(states)};
+}
+
+Trajectory::State CompactTrajectory::Sample(units::second_t t,
+                                            size_t& cursor) const {
+  if (m_t.empty()) {
+    throw std::runtime_error(
+        "Trajectory cannot be sampled if it has no states.");
+  }
+  double time = t.value();
+  if (time <= m_t.front()) {
+    return GetState(0);
+  }
+  if (time >= m_t.back()) {
+    return GetState(m_t.size() - 1);
+  }
+
+  // Find the first state with a timestamp no less than t; see
+  // Trajectory::Sample()
+  size_t index = std::min(cursor, m_t.size() - 1);
+  if (index == 0 || m_t[index - 1] >= time) {
+    auto end = index == 0 ? m_t.cend() : m_t.cbegin() + index;
+    index = std::lower_bound(m_t.cbegin() + 1, end, time,
+                             [](float a, double b) { return a < b; }) -
+            m_t.cbegin();
+  } else {
+    while (m_t[index] < time) {
+      ++index;
+    }
+  }
+  cursor = index;
+
+  auto sample = GetState(index);
+  auto prevSample = GetState(index - 1);
+  if (units::math::abs(sample.t - prevSample.t) < 1E-9_s) {
+    return sample;
+  }
+  return prevSample.Interpolate(
+      sample, (t - prevSample.t) / (sample.t - prevSample.t));
+}
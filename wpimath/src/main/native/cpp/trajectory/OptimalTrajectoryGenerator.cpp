@@ -0,0 +1,470 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/trajectory/OptimalTrajectoryGenerator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <sleipnir/control/OCPSolver.hpp>
+
+#include "frc/EigenCore.h"
+#include "frc/MathUtil.h"
+#include "frc/kinematics/DifferentialDriveKinematics.h"
+#include "frc/trajectory/TrajectoryConfig.h"
+#include "frc/trajectory/TrajectoryGenerator.h"
+#include "frc/trajectory/constraint/CentripetalAccelerationConstraint.h"
+#include "frc/trajectory/constraint/DifferentialDriveKinematicsConstraint.h"
+
+using namespace frc;
+
+namespace {
+
+using VarMat = sleipnir::VariableMatrix;
+
+// The spline trajectory the OCP is warm started from, and the time at which it
+// passes each waypoint.
+struct WarmStart {
+  Trajectory trajectory;
+  std::vector<double> waypointTimes;
+};
+
+WarmStart GenerateWarmStart(const std::vector<Pose2d>& waypoints,
+                            const TrajectoryConfig& config) {
+  WarmStart warmStart{
+      TrajectoryGenerator::GenerateTrajectory(waypoints, config), {}};
+  const auto& states = warmStart.trajectory.States();
+  if (states.size() < 2) {
+    // Malformed spline
+    return warmStart;
+  }
+
+  // Each waypoint is the spline point closest to it, searching forward from
+  // the previous waypoint
+  warmStart.waypointTimes.emplace_back(0.0);
+  size_t index = 0;
+  for (size_t i = 1; i < waypoints.size() - 1; ++i) {
+    const auto& translation = waypoints[i].Translation();
+    size_t closest = index;
+    for (size_t j = index; j < states.size(); ++j) {
+      if (states[j].pose.Translation().Distance(translation) <
+          states[closest].pose.Translation().Distance(translation)) {
+        closest = j;
+      }
+    }
+    index = closest;
+    warmStart.waypointTimes.emplace_back(states[index].t.value());
+  }
+  warmStart.waypointTimes.emplace_back(
+      warmStart.trajectory.TotalTime().value());
+  return warmStart;
+}
+
+// Returns the time of each OCP step in the warm start, with stepsPerSegment
+// equal steps between each pair of waypoints.
+std::vector<double> WarmStartStepTimes(const WarmStart& warmStart,
+                                       int stepsPerSegment) {
+  std::vector<double> times;
+  for (size_t k = 0; k + 1 < warmStart.waypointTimes.size(); ++k) {
+    double t0 = warmStart.waypointTimes[k];
+    double dt = (warmStart.waypointTimes[k + 1] - t0) / stepsPerSegment;
+    for (int i = 0; i < stepsPerSegment; ++i) {
+      times.emplace_back(t0 + i * dt);
+    }
+  }
+  times.emplace_back(warmStart.waypointTimes.back());
+  return times;
+}
+
+// Makes the steps of each segment between waypoints the same length, and
+// minimizes the total time.
+void ConstrainTimesteps(sleipnir::OCPSolver& problem, int numSegments,
+                        int stepsPerSegment, const std::vector<double>& times) {
+  int numSteps = numSegments * stepsPerSegment;
+  auto& DT = problem.DT();
+  sleipnir::Variable totalTime = 0.0;
+  for (int i = 0; i < numSteps + 1; ++i) {
+    int segment = std::min(i / stepsPerSegment, numSegments - 1);
+    int first = segment * stepsPerSegment;
+    double dt = times[(segment + 1) * stepsPerSegment] -
+                times[segment * stepsPerSegment];
+    DT(0, i).SetValue(dt / stepsPerSegment);
+    if (i == first) {
+      problem.SubjectTo(DT(0, i) >= 1e-3);
+    } else {
+      problem.SubjectTo(DT(0, i) == DT(0, first));
+    }
+    if (i < numSteps) {
+      totalTime += DT(0, i);
+    }
+  }
+  problem.Minimize(totalTime);
+}
+
+// Constrains the norm of the vector (x, y) to at most limit. The circle is
+// approximated by an inscribed polygon, since linear constraints converge far
+// more reliably than the quadratic one.
+void SubjectToNorm(sleipnir::OCPSolver& problem, const sleipnir::Variable& x,
+                   const sleipnir::Variable& y, double limit) {
+  constexpr int kSides = 16;
+  for (int k = 0; k < kSides; ++k) {
+    double angle = 2.0 * std::numbers::pi * k / kSides;
+    problem.SubjectTo(std::cos(angle) * x + std::sin(angle) * y <=
+                      limit * std::cos(std::numbers::pi / kSides));
+  }
+}
+
+bool Solve(sleipnir::OCPSolver& problem,
+           const OptimalTrajectoryGenerator::SolverOptions& options) {
+  auto status = problem.Solve(
+      {.maxIterations = options.maxIterations,
+       .timeout = std::chrono::duration<double>{options.timeout.value()}});
+  return status.exitCondition == sleipnir::SolverExitCondition::kSuccess ||
+         status.exitCondition ==
+             sleipnir::SolverExitCondition::kSolvedToAcceptableTolerance;
+}
+
+// Fills in the time and acceleration of trajectory states whose pose, velocity,
+// and curvature are set. Each state's acceleration is the constant
+// acceleration that reaches the next state's velocity, which is what
+// Trajectory::Sample() assumes.
+Trajectory FinishTrajectory(std::vector<Trajectory::State> states,
+                            sleipnir::OCPSolver& problem) {
+  units::second_t t = 0_s;
+  for (size_t i = 0; i < states.size(); ++i) {
+    states[i].t = t;
+    if (i + 1 < states.size()) {
+      units::second_t dt{problem.DT().Value(0, i)};
+      states[i].acceleration =
+          (states[i + 1].velocity - states[i].velocity) / dt;
+      t += dt;
+    }
+  }
+  return Trajectory{std::move(states)};
+}
+
+void CheckWaypoints(const std::vector<Pose2d>& waypoints,
+                    const OptimalTrajectoryGenerator::SolverOptions& options) {
+  if (waypoints.size() < 2) {
+    throw std::invalid_argument("At least two waypoints are required");
+  }
+  if (options.stepsPerSegment < 1) {
+    throw std::invalid_argument("stepsPerSegment must be positive");
+  }
+}
+
+}  // namespace
+
+OptimalTrajectoryGenerator::Result
+OptimalTrajectoryGenerator::GenerateSwerveTrajectory(
+    const std::vector<Pose2d>& waypoints, const SwerveDrivetrain& drivetrain,
+    const SolverOptions& options) {
+  CheckWaypoints(waypoints, options);
+
+  // With every module pointed the same way, the drivetrain is a point mass
+  // driven by numModules motors. The input is the acceleration, which the
+  // drive motors produce with a voltage across their windings of
+  //
+  //   m/kForce a
+  //
+  // on top of the back-EMF kEmf v. The winding voltage is limited by the
+  // current limit, and the total voltage by the supply voltage.
+  const auto& motor = drivetrain.driveMotor;
+  const double G = drivetrain.gearing;
+  const double r = drivetrain.wheelRadius.value();
+  const double m = drivetrain.mass.value();
+  const double kEmf = G / (r * motor.Kv.value());
+  const double kForce =
+      drivetrain.numModules * G * motor.Kt.value() / (r * motor.R.value());
+  const double maxVoltage = motor.nominalVoltage.value();
+  const double maxWindingVoltage =
+      std::min(maxVoltage, motor.R.value() * drivetrain.currentLimit.value());
+
+  // Warm start from a spline trajectory whose constant acceleration limit
+  // (including centripetal acceleration) is achievable up to its max velocity
+  const double maxAcceleration = kForce / m * maxWindingVoltage;
+  TrajectoryConfig config{
+      units::meters_per_second_t{0.75 * maxVoltage / kEmf},
+      units::meters_per_second_squared_t{0.25 * maxAcceleration}};
+  config.AddConstraint(CentripetalAccelerationConstraint{
+      units::meters_per_second_squared_t{0.25 * maxAcceleration}});
+  auto warmStart = GenerateWarmStart(waypoints, config);
+  if (warmStart.waypointTimes.empty()) {
+    return {warmStart.trajectory, false, 0_s};
+  }
+
+  auto startTime = std::chrono::steady_clock::now();
+
+  const int numSegments = waypoints.size() - 1;
+  const int stepsPerSegment = options.stepsPerSegment;
+  const int numSteps = numSegments * stepsPerSegment;
+  auto times = WarmStartStepTimes(warmStart, stepsPerSegment);
+
+  // x = [x, y, vx, vy]ᵀ, u = [ax, ay]ᵀ
+  auto f = [](const sleipnir::Variable&, const VarMat& x, const VarMat& u,
+              const sleipnir::Variable&) -> VarMat {
+    VarMat xdot{4, 1};
+    xdot.Segment(0, 2) = x.Segment(2, 2);
+    xdot.Segment(2, 2) = u;
+    return xdot;
+  };
+  sleipnir::OCPSolver problem{
+      4,
+      2,
+      std::chrono::duration<double>{times[1] - times[0]},
+      numSteps,
+      f,
+      sleipnir::DynamicsType::kExplicitODE,
+      sleipnir::TimestepMethod::kVariable,
+      sleipnir::TranscriptionMethod::kDirectTranscription};
+  ConstrainTimesteps(problem, numSegments, stepsPerSegment, times);
+
+  auto& X = problem.X();
+  auto& U = problem.U();
+
+  // Start and end at rest, and pass through each waypoint
+  for (int k = 0; k < numSegments + 1; ++k) {
+    int i = k * stepsPerSegment;
+    problem.SubjectTo(X(0, i) == waypoints[k].X().value());
+    problem.SubjectTo(X(1, i) == waypoints[k].Y().value());
+  }
+  problem.SubjectTo(X.Segment(2, 2) == Vectord<2>::Zero());
+  problem.SubjectTo(X.Block(2, numSteps, 2, 1) == Vectord<2>::Zero());
+
+  for (int i = 0; i < numSteps; ++i) {
+    // Current limit
+    auto ax = U(0, i);
+    auto ay = U(1, i);
+    if (maxWindingVoltage < maxVoltage) {
+      SubjectToNorm(problem, ax, ay, maxAcceleration);
+    }
+
+    // Supply voltage limit. The acceleration is constant over the step, so
+    // the voltage is highest at one of its ends.
+    for (int j : {i, i + 1}) {
+      SubjectToNorm(problem, m / kForce * ax + kEmf * X(2, j),
+                    m / kForce * ay + kEmf * X(3, j), maxVoltage);
+    }
+  }
+
+  // Warm start
+  for (int i = 0; i < numSteps + 1; ++i) {
+    auto state = warmStart.trajectory.Sample(units::second_t{times[i]});
+    double v = state.velocity.value();
+    double a = state.acceleration.value();
+    double ac = v * v * state.curvature.value();
+    double cos = state.pose.Rotation().Cos();
+    double sin = state.pose.Rotation().Sin();
+    X(0, i).SetValue(state.pose.X().value());
+    X(1, i).SetValue(state.pose.Y().value());
+    X(2, i).SetValue(v * cos);
+    X(3, i).SetValue(v * sin);
+
+    // The spline's curvature can spike near waypoints, so keep the warm start
+    // inputs within the current limit
+    double ax = a * cos - ac * sin;
+    double ay = a * sin + ac * cos;
+    double scale =
+        std::min(1.0, 0.9 * maxAcceleration / std::max(std::hypot(ax, ay),
+                                                        1e-9));
+    U(0, i).SetValue(scale * ax);
+    U(1, i).SetValue(scale * ay);
+  }
+
+  bool optimal = Solve(problem, options);
+  units::second_t solveTime{std::chrono::duration<double>{
+      std::chrono::steady_clock::now() - startTime}
+                                .count()};
+  if (!optimal) {
+    return {warmStart.trajectory, false, solveTime};
+  }
+
+  std::vector<Trajectory::State> states(numSteps + 1);
+  Rotation2d heading = waypoints.front().Rotation();
+  for (int i = 0; i < numSteps + 1; ++i) {
+    double vx = X.Value(2, i);
+    double vy = X.Value(3, i);
+    double v = std::hypot(vx, vy);
+
+    double curvature = 0.0;
+    if (v > 1e-6) {
+      heading = Rotation2d{vx, vy};
+      curvature = (vx * U.Value(1, i) - vy * U.Value(0, i)) / (v * v * v);
+    }
+
+    states[i].velocity = units::meters_per_second_t{v};
+    states[i].pose = Pose2d{units::meter_t{X.Value(0, i)},
+                            units::meter_t{X.Value(1, i)}, heading};
+    states[i].curvature = units::curvature_t{curvature};
+  }
+  return {FinishTrajectory(std::move(states), problem), true, solveTime};
+}
+
+OptimalTrajectoryGenerator::Result
+OptimalTrajectoryGenerator::GenerateDifferentialTrajectory(
+    const std::vector<Pose2d>& waypoints,
+    const DifferentialDrivetrain& drivetrain, const SolverOptions& options) {
+  CheckWaypoints(waypoints, options);
+
+  // The inputs are the forces of the left and right wheels divided by the
+  // robot's mass, which each side's motors produce with a voltage across
+  // their windings of
+  //
+  //   m/kForce u
+  //
+  // on top of the back-EMF kEmf v. The winding voltage is limited by the
+  // current limit, and the total voltage by the supply voltage.
+  const auto& motor = drivetrain.driveMotor;
+  const double G = drivetrain.gearing;
+  const double r = drivetrain.wheelRadius.value();
+  const double m = drivetrain.mass.value();
+  const double J = drivetrain.moi.value();
+  const double rb = drivetrain.trackwidth.value() / 2.0;
+  const double kEmf = G / (r * motor.Kv.value());
+  const double kForce = G * motor.Kt.value() / (r * motor.R.value());
+  const double maxVoltage = motor.nominalVoltage.value();
+  const double maxWindingVoltage =
+      std::min(maxVoltage, motor.R.value() * drivetrain.currentLimit.value());
+  const double maxInput = kForce / m * maxWindingVoltage;
+
+  // Warm start from a spline trajectory whose wheel speeds leave voltage
+  // headroom for acceleration
+  const double maxWheelSpeed = 0.75 * maxVoltage / kEmf;
+  TrajectoryConfig config{units::meters_per_second_t{maxWheelSpeed},
+                          units::meters_per_second_squared_t{0.5 * maxInput}};
+  config.AddConstraint(DifferentialDriveKinematicsConstraint{
+      DifferentialDriveKinematics{drivetrain.trackwidth},
+      units::meters_per_second_t{maxWheelSpeed}});
+  auto warmStart = GenerateWarmStart(waypoints, config);
+  if (warmStart.waypointTimes.empty()) {
+    return {warmStart.trajectory, false, 0_s};
+  }
+
+  auto startTime = std::chrono::steady_clock::now();
+
+  const int numSegments = waypoints.size() - 1;
+  const int stepsPerSegment = options.stepsPerSegment;
+  const int numSteps = numSegments * stepsPerSegment;
+  auto times = WarmStartStepTimes(warmStart, stepsPerSegment);
+
+  // x = [x, y, θ, vₗ, vᵣ]ᵀ, u = [Fₗ/m, Fᵣ/m]ᵀ
+  //
+  // The chassis accelerates at a = uₗ + uᵣ and turns with angular
+  // acceleration α = (uᵣ − uₗ)mr_b/J, so the wheels accelerate at a ∓ r_b α.
+  auto f = [&](const sleipnir::Variable&, const VarMat& x, const VarMat& u,
+               const sleipnir::Variable&) -> VarMat {
+    auto v = (x(3) + x(4)) / 2.0;
+    auto a = u(0) + u(1);
+    auto rbAlpha = (u(1) - u(0)) * m * rb * rb / J;
+    VarMat xdot{5, 1};
+    xdot(0) = v * sleipnir::cos(x(2));
+    xdot(1) = v * sleipnir::sin(x(2));
+    xdot(2) = (x(4) - x(3)) / (2.0 * rb);
+    xdot(3) = a - rbAlpha;
+    xdot(4) = a + rbAlpha;
+    return xdot;
+  };
+  sleipnir::OCPSolver problem{
+      5,
+      2,
+      std::chrono::duration<double>{times[1] - times[0]},
+      numSteps,
+      f,
+      sleipnir::DynamicsType::kExplicitODE,
+      sleipnir::TimestepMethod::kVariable,
+      sleipnir::TranscriptionMethod::kDirectTranscription};
+  ConstrainTimesteps(problem, numSegments, stepsPerSegment, times);
+
+  auto& X = problem.X();
+  auto& U = problem.U();
+
+  // Warm start. The heading is unwrapped so it's continuous.
+  double prevHeading = waypoints.front().Rotation().Radians().value();
+  for (int i = 0; i < numSteps + 1; ++i) {
+    auto state = warmStart.trajectory.Sample(units::second_t{times[i]});
+    double v = state.velocity.value();
+    double a = state.acceleration.value();
+    double k = state.curvature.value();
+    double heading =
+        prevHeading + InputModulus(state.pose.Rotation().Radians().value() -
+                                       prevHeading,
+                                   -std::numbers::pi, std::numbers::pi);
+    prevHeading = heading;
+
+    // Ignoring the change in curvature, α = ak
+    double rbAlpha = a * k * rb;
+    X(0, i).SetValue(state.pose.X().value());
+    X(1, i).SetValue(state.pose.Y().value());
+    X(2, i).SetValue(heading);
+    X(3, i).SetValue(v * (1.0 - k * rb));
+    X(4, i).SetValue(v * (1.0 + k * rb));
+    U(0, i).SetValue((a - rbAlpha * J / (m * rb * rb)) / 2.0);
+    U(1, i).SetValue((a + rbAlpha * J / (m * rb * rb)) / 2.0);
+  }
+
+  // Start and end at rest, and pass through each waypoint with its heading
+  for (int k = 0; k < numSegments + 1; ++k) {
+    int i = k * stepsPerSegment;
+    problem.SubjectTo(X(0, i) == waypoints[k].X().value());
+    problem.SubjectTo(X(1, i) == waypoints[k].Y().value());
+
+    // Use the equivalent heading closest to the unwrapped warm start
+    double heading = X.Value(2, i);
+    problem.SubjectTo(
+        X(2, i) ==
+        heading + InputModulus(
+                      waypoints[k].Rotation().Radians().value() - heading,
+                      -std::numbers::pi, std::numbers::pi));
+  }
+  problem.SubjectTo(X.Segment(3, 2) == Vectord<2>::Zero());
+  problem.SubjectTo(X.Block(3, numSteps, 2, 1) == Vectord<2>::Zero());
+
+  for (int i = 0; i < numSteps; ++i) {
+    for (int side = 0; side < 2; ++side) {
+      // Current limit
+      auto u = U(side, i);
+      if (maxWindingVoltage < maxVoltage) {
+        problem.SubjectTo(-maxInput <= u);
+        problem.SubjectTo(u <= maxInput);
+      }
+
+      // Supply voltage limit. The input is constant over the step, so the
+      // voltage is highest at one of its ends.
+      for (int j : {i, i + 1}) {
+        auto voltage = m / kForce * u + kEmf * X(3 + side, j);
+        problem.SubjectTo(-maxVoltage <= voltage);
+        problem.SubjectTo(voltage <= maxVoltage);
+      }
+    }
+  }
+
+  bool optimal = Solve(problem, options);
+  units::second_t solveTime{std::chrono::duration<double>{
+      std::chrono::steady_clock::now() - startTime}
+                                .count()};
+  if (!optimal) {
+    return {warmStart.trajectory, false, solveTime};
+  }
+
+  std::vector<Trajectory::State> states(numSteps + 1);
+  for (int i = 0; i < numSteps + 1; ++i) {
+    double vl = X.Value(3, i);
+    double vr = X.Value(4, i);
+    double v = (vl + vr) / 2.0;
+
+    states[i].velocity = units::meters_per_second_t{v};
+    states[i].pose =
+        Pose2d{units::meter_t{X.Value(0, i)}, units::meter_t{X.Value(1, i)},
+               units::radian_t{X.Value(2, i)}};
+    if (std::abs(v) > 1e-6) {
+      states[i].curvature = units::curvature_t{(vr - vl) / (2.0 * rb) / v};
+    }
+  }
+  return {FinishTrajectory(std::move(states), problem), true, solveTime};
+}
@@ -4,6 +4,11 @@
 
 #include "frc/trajectory/TrajectoryGenerator.h"
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -18,6 +23,78 @@ using namespace frc;
 const Trajectory TrajectoryGenerator::kDoNothingTrajectory(
     std::vector<Trajectory::State>{Trajectory::State()});
 std::function<void(const char*)> TrajectoryGenerator::s_errorFunc;
+int TrajectoryGenerator::s_maxThreads = 1;
+
+const std::vector<TrajectoryGenerator::PoseWithCurvature>*
+TrajectoryGenerator::SegmentCache::Find(const std::vector<double>& key) {
+  for (auto& entry : m_entries) {
+    if (entry.key == key) {
+      entry.lastUsed = ++m_useCount;
+      ++m_hits;
+      return &entry.points;
+    }
+  }
+  ++m_misses;
+  return nullptr;
+}
+
+void TrajectoryGenerator::SegmentCache::Insert(
+    std::vector<double> key, std::vector<PoseWithCurvature> points) {
+  if (m_capacity == 0) {
+    return;
+  }
+  if (m_entries.size() >= m_capacity) {
+    auto lru = std::min_element(
+        m_entries.begin(), m_entries.end(),
+        [](const auto& a, const auto& b) { return a.lastUsed < b.lastUsed; });
+    *lru = Entry{std::move(key), std::move(points), ++m_useCount};
+  } else {
+    m_entries.emplace_back(
+        Entry{std::move(key), std::move(points), ++m_useCount});
+  }
+}
+
+void TrajectoryGenerator::ForEachIndex(
+    size_t count, const std::function<void(size_t)>& func) {
+  size_t numThreads =
+      std::min(count, static_cast<size_t>(std::max(s_maxThreads, 1)));
+  if (numThreads <= 1) {
+    for (size_t i = 0; i < count; ++i) {
+      func(i);
+    }
+    return;
+  }
+
+  std::atomic<size_t> next{0};
+  std::mutex exceptionMutex;
+  std::exception_ptr exception;
+  auto worker = [&] {
+    for (size_t i = next++; i < count; i = next++) {
+      try {
+        func(i);
+      } catch (...) {
+        std::scoped_lock lock{exceptionMutex};
+        if (!exception) {
+          exception = std::current_exception();
+        }
+      }
+    }
+  };
+
+  // The calling thread is one of the workers
+  std::vector<std::thread> threads;
+  threads.reserve(numThreads - 1);
+  for (size_t i = 1; i < numThreads; ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
 
 void TrajectoryGenerator::ReportError(const char* error) {
   if (s_errorFunc) {
@@ -30,7 +107,8 @@ void TrajectoryGenerator::ReportError(const char* error) {
 Trajectory TrajectoryGenerator::GenerateTrajectory(
     Spline<3>::ControlVector initial,
     const std::vector<Translation2d>& interiorWaypoints,
-    Spline<3>::ControlVector end, const TrajectoryConfig& config) {
+    Spline<3>::ControlVector end, const TrajectoryConfig& config,
+    SegmentCache* cache) {
   const Transform2d flip{Translation2d{}, 180_deg};
 
   // Make theta normal for trajectory generation if path is reversed.
@@ -46,7 +124,8 @@ Trajectory TrajectoryGenerator::GenerateTrajectory(
   try {
     points =
         SplinePointsFromSplines(SplineHelper::CubicSplinesFromControlVectors(
-            initial, interiorWaypoints, end));
+                                    initial, interiorWaypoints, end),
+                                cache);
   } catch (SplineParameterizer::MalformedSplineException& e) {
     ReportError(e.what());
     return kDoNothingTrajectory;
@@ -68,15 +147,15 @@ Trajectory TrajectoryGenerator::GenerateTrajectory(
 
 Trajectory TrajectoryGenerator::GenerateTrajectory(
     const Pose2d& start, const std::vector<Translation2d>& interiorWaypoints,
-    const Pose2d& end, const TrajectoryConfig& config) {
+    const Pose2d& end, const TrajectoryConfig& config, SegmentCache* cache) {
   auto [startCV, endCV] = SplineHelper::CubicControlVectorsFromWaypoints(
       start, interiorWaypoints, end);
-  return GenerateTrajectory(startCV, interiorWaypoints, endCV, config);
+  return GenerateTrajectory(startCV, interiorWaypoints, endCV, config, cache);
 }
 
 Trajectory TrajectoryGenerator::GenerateTrajectory(
     std::vector<Spline<5>::ControlVector> controlVectors,
-    const TrajectoryConfig& config) {
+    const TrajectoryConfig& config, SegmentCache* cache) {
   const Transform2d flip{Translation2d{}, 180_deg};
   // Make theta normal for trajectory generation if path is reversed.
   if (config.IsReversed()) {
@@ -90,7 +169,7 @@ Trajectory TrajectoryGenerator::GenerateTrajectory(
   std::vector<frc::SplineParameterizer::PoseWithCurvature> points;
   try {
     points = SplinePointsFromSplines(
-        SplineHelper::QuinticSplinesFromControlVectors(controlVectors));
+        SplineHelper::QuinticSplinesFromControlVectors(controlVectors), cache);
   } catch (SplineParameterizer::MalformedSplineException& e) {
     ReportError(e.what());
     return kDoNothingTrajectory;
@@ -111,7 +190,8 @@ Trajectory TrajectoryGenerator::GenerateTrajectory(
 }
 
 Trajectory TrajectoryGenerator::GenerateTrajectory(
-    const std::vector<Pose2d>& waypoints, const TrajectoryConfig& config) {
+    const std::vector<Pose2d>& waypoints, const TrajectoryConfig& config,
+    SegmentCache* cache) {
   auto newWaypoints = waypoints;
   const Transform2d flip{Translation2d{}, 180_deg};
   if (config.IsReversed()) {
@@ -123,7 +203,8 @@ Trajectory TrajectoryGenerator::GenerateTrajectory(
   std::vector<SplineParameterizer::PoseWithCurvature> points;
   try {
     points = SplinePointsFromSplines(SplineHelper::OptimizeCurvature(
-        SplineHelper::QuinticSplinesFromWaypoints(newWaypoints)));
+        SplineHelper::QuinticSplinesFromWaypoints(newWaypoints)),
+                                     cache);
   } catch (SplineParameterizer::MalformedSplineException& e) {
     ReportError(e.what());
     return kDoNothingTrajectory;
@@ -147,3 +228,7 @@ void TrajectoryGenerator::SetErrorHandler(
     std::function<void(const char*)> func) {
   s_errorFunc = std::move(func);
 }
+
+void TrajectoryGenerator::SetMaxThreads(int maxThreads) {
+  s_maxThreads = maxThreads;
+}
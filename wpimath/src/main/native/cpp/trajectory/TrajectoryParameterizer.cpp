@@ -45,6 +45,23 @@ Trajectory TrajectoryParameterizer::TimeParameterizeTrajectory(
     units::meters_per_second_squared_t maxAcceleration, bool reversed) {
   std::vector<ConstrainedState> constrainedStates(points.size());
 
+  // Evaluate the velocity constraints for all points up front, one constraint
+  // at a time, instead of calling every constraint for every point on every
+  // iteration of the forward pass.
+  std::vector<units::meters_per_second_t> maxVelocities(points.size(),
+                                                        maxVelocity);
+  if (!constraints.empty()) {
+    std::vector<units::meters_per_second_t> constraintMaxVelocities(
+        points.size());
+    for (const auto& constraint : constraints) {
+      constraint->MaxVelocities(points, maxVelocity, constraintMaxVelocities);
+      for (size_t i = 0; i < points.size(); ++i) {
+        maxVelocities[i] =
+            units::math::min(maxVelocities[i], constraintMaxVelocities[i]);
+      }
+    }
+  }
+
   ConstrainedState predecessor{points.front(), 0_m, startVelocity,
                                -maxAcceleration, maxAcceleration};
 
@@ -63,27 +80,18 @@ Trajectory TrajectoryParameterizer::TimeParameterizeTrajectory(
     // We may need to iterate to find the maximum end velocity and common
     // acceleration, since acceleration limits may be a function of velocity.
     while (true) {
-      // Enforce global max velocity and max reachable velocity by global
-      // acceleration limit. v_f = √(v_i² + 2ad).
+      // Enforce global max velocity, user-defined velocity constraints, and
+      // max reachable velocity by global acceleration limit.
+      // v_f = √(v_i² + 2ad).
 
       constrainedState.maxVelocity = units::math::min(
-          maxVelocity,
+          maxVelocities[i],
           units::math::sqrt(predecessor.maxVelocity * predecessor.maxVelocity +
                             predecessor.maxAcceleration * ds * 2.0));
 
       constrainedState.minAcceleration = -maxAcceleration;
       constrainedState.maxAcceleration = maxAcceleration;
 
-      // At this point, the constrained state is fully constructed apart from
-      // all the custom-defined user constraints.
-      for (const auto& constraint : constraints) {
-        constrainedState.maxVelocity = units::math::min(
-            constrainedState.maxVelocity,
-            constraint->MaxVelocity(constrainedState.pose.first,
-                                    constrainedState.pose.second,
-                                    constrainedState.maxVelocity));
-      }
-
       // Now enforce all acceleration limits.
       EnforceAccelerationLimits(reversed, constraints, &constrainedState);
 
@@ -12,7 +12,8 @@
 
 std::optional<frc::Trajectory> wpi::Protobuf<frc::Trajectory>::Unpack(
     InputStream& stream) {
-  wpi::StdVectorUnpackCallback<frc::Trajectory::State, SIZE_MAX> states;
+  wpi::ArenaUnpackCallback<frc::Trajectory::State, SIZE_MAX> states{
+      stream.Arena()};
   wpi_proto_ProtobufTrajectory msg{
       .states = states.Callback(),
   };
@@ -20,7 +21,9 @@ std::optional<frc::Trajectory> wpi::Protobuf<frc::Trajectory>::Unpack(
     return {};
   }
 
-  return frc::Trajectory{states.Vec()};
+  auto items = states.Items();
+  return frc::Trajectory{
+      std::vector<frc::Trajectory::State>(items.begin(), items.end())};
 }
 
 bool wpi::Protobuf<frc::Trajectory>::Pack(OutputStream& stream,
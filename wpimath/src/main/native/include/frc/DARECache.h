@@ -0,0 +1,179 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <Eigen/Core>
+#include <wpi/SymbolExports.h>
+#include <wpi/expected>
+
+#include "frc/DARE.h"
+
+namespace frc {
+
+/**
+ * Process-wide cache of DARE solutions and the gain tables computed from them.
+ *
+ * LinearQuadraticRegulator, KalmanFilter, LTVUnicycleController, and
+ * LTVDifferentialDriveController look up their DARE solutions here before
+ * solving, so constructing a second one with the same discretized system and
+ * weights is nearly free. Entries are keyed by the exact values of every input
+ * they depend on.
+ *
+ * The cache is kept in memory by default. If a directory is set, the cache is
+ * also loaded from and appended to a file in that directory, so the cost of
+ * building controllers is only paid on the first run of a robot program.
+ */
+class WPILIB_DLLEXPORT DARECache {
+ public:
+  /// The maximum number of entries kept in memory. Later entries aren't
+  /// cached.
+  static constexpr size_t kMaxEntries = 1024;
+
+  /**
+   * Sets the directory the cache is persisted in, and loads any entries
+   * previously saved there. An empty directory disables persistence.
+   *
+   * Errors reading or writing the cache file are ignored; the affected entries
+   * are recomputed instead.
+   *
+   * @param directory The directory to persist the cache in.
+   */
+  static void SetDirectory(std::string_view directory);
+
+  /**
+   * Removes all entries from memory. The cache file, if any, is left as is.
+   */
+  static void Clear();
+
+  /**
+   * Returns the value cached for the given key, if any.
+   *
+   * @param key The key.
+   */
+  static std::optional<std::vector<double>> Find(std::span<const double> key);
+
+  /**
+   * Caches a value for the given key.
+   *
+   * @param key The key.
+   * @param value The value.
+   */
+  static void Insert(std::span<const double> key,
+                     std::span<const double> value);
+};
+
+namespace detail {
+
+/**
+ * Kinds of DARECache entries. It's the first element of each key so different
+ * kinds of entries with the same inputs don't collide.
+ */
+enum class DARECacheKind {
+  /// Solution to the DARE with Q and R cost matrices.
+  kDARE = 0,
+  /// Solution to the DARE with Q, R, and N cost matrices.
+  kDAREWithN = 1,
+  /// LTVUnicycleController gain table.
+  kLTVUnicycle = 2,
+  /// LTVDifferentialDriveController gain table.
+  kLTVDifferentialDrive = 3,
+};
+
+/**
+ * Appends the elements of the given matrices to a DARECache key.
+ *
+ * @param key The key.
+ * @param matrices The matrices.
+ */
+template <typename... Derived>
+void AppendToDARECacheKey(std::vector<double>& key,
+                          const Eigen::MatrixBase<Derived>&... matrices) {
+  (key.insert(key.end(), matrices.derived().data(),
+              matrices.derived().data() + matrices.size()),
+   ...);
+}
+
+}  // namespace detail
+
+/**
+ * Returns DARE(A, B, Q, R) from DARECache, or solves it and caches the
+ * solution if it isn't cached. Only successful solutions are cached.
+ *
+ * @tparam States Number of states.
+ * @tparam Inputs Number of inputs.
+ * @param A The system matrix.
+ * @param B The input matrix.
+ * @param Q The state cost matrix.
+ * @param R The input cost matrix.
+ * @return Solution to the DARE on success, or DAREError on failure.
+ */
+template <int States, int Inputs>
+wpi::expected<Eigen::Matrix<double, States, States>, DAREError> CachedDARE(
+    const Eigen::Matrix<double, States, States>& A,
+    const Eigen::Matrix<double, States, Inputs>& B,
+    const Eigen::Matrix<double, States, States>& Q,
+    const Eigen::Matrix<double, Inputs, Inputs>& R) {
+  std::vector<double> key{
+      static_cast<double>(detail::DARECacheKind::kDARE),
+      static_cast<double>(B.rows()), static_cast<double>(B.cols())};
+  detail::AppendToDARECacheKey(key, A, B, Q, R);
+
+  if (auto value = DARECache::Find(key)) {
+    return Eigen::Map<const Eigen::Matrix<double, States, States>>{
+        value->data(), A.rows(), A.cols()};
+  }
+
+  auto S = DARE<States, Inputs>(A, B, Q, R);
+  if (S) {
+    DARECache::Insert(key, {S.value().data(),
+                            static_cast<size_t>(S.value().size())});
+  }
+  return S;
+}
+
+/**
+ * Returns DARE(A, B, Q, R, N) from DARECache, or solves it and caches the
+ * solution if it isn't cached. Only successful solutions are cached.
+ *
+ * @tparam States Number of states.
+ * @tparam Inputs Number of inputs.
+ * @param A The system matrix.
+ * @param B The input matrix.
+ * @param Q The state cost matrix.
+ * @param R The input cost matrix.
+ * @param N The state-input cross cost matrix.
+ * @return Solution to the DARE on success, or DAREError on failure.
+ */
+template <int States, int Inputs>
+wpi::expected<Eigen::Matrix<double, States, States>, DAREError> CachedDARE(
+    const Eigen::Matrix<double, States, States>& A,
+    const Eigen::Matrix<double, States, Inputs>& B,
+    const Eigen::Matrix<double, States, States>& Q,
+    const Eigen::Matrix<double, Inputs, Inputs>& R,
+    const Eigen::Matrix<double, States, Inputs>& N) {
+  std::vector<double> key{
+      static_cast<double>(detail::DARECacheKind::kDAREWithN),
+      static_cast<double>(B.rows()), static_cast<double>(B.cols())};
+  detail::AppendToDARECacheKey(key, A, B, Q, R, N);
+
+  if (auto value = DARECache::Find(key)) {
+    return Eigen::Map<const Eigen::Matrix<double, States, States>>{
+        value->data(), A.rows(), A.cols()};
+  }
+
+  auto S = DARE<States, Inputs>(A, B, Q, R, N);
+  if (S) {
+    DARECache::Insert(key, {S.value().data(),
+                            static_cast<size_t>(S.value().size())});
+  }
+  return S;
+}
+
+}  // namespace frc
@@ -13,6 +13,7 @@
 #include <wpi/array.h>
 
 #include "frc/DARE.h"
+#include "frc/DARECache.h"
 #include "frc/EigenCore.h"
 #include "frc/StateSpaceUtil.h"
 #include "frc/fmt/Eigen.h"
@@ -103,7 +104,7 @@ class LinearQuadraticRegulator {
     Matrixd<States, Inputs> discB;
     DiscretizeAB<States, Inputs>(A, B, dt, &discA, &discB);
 
-    if (auto S = DARE<States, Inputs>(discA, discB, Q, R)) {
+    if (auto S = CachedDARE<States, Inputs>(discA, discB, Q, R)) {
       // K = (BᵀSB + R)⁻¹BᵀSA
       m_K = (discB.transpose() * S.value() * discB + R)
                 .llt()
@@ -158,7 +159,7 @@ class LinearQuadraticRegulator {
     Matrixd<States, Inputs> discB;
     DiscretizeAB<States, Inputs>(A, B, dt, &discA, &discB);
 
-    if (auto S = DARE<States, Inputs>(discA, discB, Q, R, N)) {
+    if (auto S = CachedDARE<States, Inputs>(discA, discB, Q, R, N)) {
       // K = (BᵀSB + R)⁻¹(BᵀSA + Nᵀ)
       m_K = (discB.transpose() * S.value() * discB + R)
                 .llt()
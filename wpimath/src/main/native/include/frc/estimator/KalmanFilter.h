@@ -12,10 +12,12 @@
 #include <wpi/array.h>
 
 #include "frc/DARE.h"
+#include "frc/DARECache.h"
 #include "frc/EigenCore.h"
 #include "frc/StateSpaceUtil.h"
 #include "frc/fmt/Eigen.h"
 #include "frc/system/Discretization.h"
+#include "frc/system/DiscretizationCache.h"
 #include "frc/system/LinearSystem.h"
 #include "units/time.h"
 #include "wpimath/MathShared.h"
@@ -85,8 +87,8 @@ class KalmanFilter {
 
     const auto& C = plant.C();
 
-    if (auto P = DARE<States, Outputs>(discA.transpose(), C.transpose(), discQ,
-                                       discR)) {
+    if (auto P = CachedDARE<States, Outputs>(discA.transpose(), C.transpose(),
+                                             discQ, discR)) {
       m_initP = P.value();
     } else if (P.error() == DAREError::QNotSymmetric ||
                P.error() == DAREError::QNotPositiveSemidefinite) {
@@ -183,14 +185,14 @@ class KalmanFilter {
    */
   void Predict(const InputVector& u, units::second_t dt) {
     // Find discrete A and Q
-    StateMatrix discA;
-    StateMatrix discQ;
-    DiscretizeAQ<States>(m_plant->A(), m_contQ, dt, &discA, &discQ);
+    const auto& disc = m_discreteAQ.Get(dt, [&](DiscreteAQ* aq) {
+      DiscretizeAQ<States>(m_plant->A(), m_contQ, dt, &aq->A, &aq->Q);
+    });
 
-    m_xHat = m_plant->CalculateX(m_xHat, u, dt);
+    m_xHat = m_plant->CalculateX(m_xHat, u, dt, m_discreteAB);
 
     // Pₖ₊₁⁻ = APₖ⁻Aᵀ + Q
-    m_P = discA * m_P * discA.transpose() + discQ;
+    m_P = disc.A * m_P * disc.A.transpose() + disc.Q;
 
     m_dt = dt;
   }
@@ -257,6 +259,15 @@ class KalmanFilter {
   units::second_t m_dt;
 
   StateMatrix m_initP;
+
+  struct DiscreteAQ {
+    StateMatrix A;
+    StateMatrix Q;
+  };
+
+  // Discretized matrices for recent timesteps
+  typename LinearSystem<States, Inputs, Outputs>::DiscreteABCache m_discreteAB;
+  DiscretizationCache<DiscreteAQ> m_discreteAQ;
 };
 
 extern template class EXPORT_TEMPLATE_DECLARE(WPILIB_DLLEXPORT)
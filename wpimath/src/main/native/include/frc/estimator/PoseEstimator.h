@@ -4,11 +4,14 @@
 
 #pragma once
 
+#include <algorithm>
 #include <map>
 #include <optional>
+#include <span>
 #include <vector>
 
 #include <Eigen/Core>
+#include <wpi/SmallVector.h>
 #include <wpi/SymbolExports.h>
 #include <wpi/array.h>
 
@@ -83,21 +86,7 @@ class WPILIB_DLLEXPORT PoseEstimator {
    */
   void SetVisionMeasurementStdDevs(
       const wpi::array<double, 3>& visionMeasurementStdDevs) {
-    wpi::array<double, 3> r{wpi::empty_array};
-    for (size_t i = 0; i < 3; ++i) {
-      r[i] = visionMeasurementStdDevs[i] * visionMeasurementStdDevs[i];
-    }
-
-    // Solve for closed form Kalman gain for continuous Kalman filter with A = 0
-    // and C = I. See wpimath/algorithms.md.
-    for (size_t row = 0; row < 3; ++row) {
-      if (m_q[row] == 0.0) {
-        m_visionK(row, row) = 0.0;
-      } else {
-        m_visionK(row, row) =
-            m_q[row] / (m_q[row] + std::sqrt(m_q[row] * r[row]));
-      }
-    }
+    m_visionK = CalculateVisionK(visionMeasurementStdDevs);
   }
 
   /**
@@ -233,61 +222,7 @@ class WPILIB_DLLEXPORT PoseEstimator {
    */
   void AddVisionMeasurement(const Pose2d& visionRobotPose,
                             units::second_t timestamp) {
-    // Step 0: If this measurement is old enough to be outside the pose buffer's
-    // timespan, skip.
-    if (m_odometryPoseBuffer.GetInternalBuffer().empty() ||
-        m_odometryPoseBuffer.GetInternalBuffer().front().first -
-                kBufferDuration >
-            timestamp) {
-      return;
-    }
-
-    // Step 1: Clean up any old entries
-    CleanUpVisionUpdates();
-
-    // Step 2: Get the pose measured by odometry at the moment the vision
-    // measurement was made.
-    auto odometrySample = m_odometryPoseBuffer.Sample(timestamp);
-
-    if (!odometrySample) {
-      return;
-    }
-
-    // Step 3: Get the vision-compensated pose estimate at the moment the vision
-    // measurement was made.
-    auto visionSample = SampleAt(timestamp);
-
-    if (!visionSample) {
-      return;
-    }
-
-    // Step 4: Measure the twist between the old pose estimate and the vision
-    // pose.
-    auto twist = visionSample.value().Log(visionRobotPose);
-
-    // Step 5: We should not trust the twist entirely, so instead we scale this
-    // twist by a Kalman gain matrix representing how much we trust vision
-    // measurements compared to our current pose.
-    Eigen::Vector3d k_times_twist =
-        m_visionK * Eigen::Vector3d{twist.dx.value(), twist.dy.value(),
-                                    twist.dtheta.value()};
-
-    // Step 6: Convert back to Twist2d.
-    Twist2d scaledTwist{units::meter_t{k_times_twist(0)},
-                        units::meter_t{k_times_twist(1)},
-                        units::radian_t{k_times_twist(2)}};
-
-    // Step 7: Calculate and record the vision update.
-    VisionUpdate visionUpdate{visionSample->Exp(scaledTwist), *odometrySample};
-    m_visionUpdates[timestamp] = visionUpdate;
-
-    // Step 8: Remove later vision measurements. (Matches previous behavior)
-    auto firstAfter = m_visionUpdates.upper_bound(timestamp);
-    m_visionUpdates.erase(firstAfter, m_visionUpdates.end());
-
-    // Step 9: Update latest pose estimate. Since we cleared all updates after
-    // this vision update, it's guaranteed to be the latest vision update.
-    m_poseEstimate = visionUpdate.Compensate(m_odometry.GetPose());
+    ApplyVisionMeasurement(visionRobotPose, timestamp, m_visionK);
   }
 
   /**
@@ -325,6 +260,57 @@ class WPILIB_DLLEXPORT PoseEstimator {
     AddVisionMeasurement(visionRobotPose, timestamp);
   }
 
+  /**
+   * A vision measurement for AddVisionMeasurements().
+   */
+  struct VisionMeasurement {
+    /// The pose of the robot as measured by the vision camera.
+    Pose2d visionRobotPose;
+
+    /// The timestamp of the vision measurement, in the same epoch as
+    /// UpdateWithTime().
+    units::second_t timestamp;
+
+    /// Standard deviations of the vision pose measurement (x position in
+    /// meters, y position in meters, and heading in radians). If empty, the
+    /// standard deviations set by SetVisionMeasurementStdDevs() are used.
+    std::optional<wpi::array<double, 3>> stdDevs;
+  };
+
+  /**
+   * Adds several vision measurements taken around the same time, such as one
+   * from each camera.
+   *
+   * Adding a vision measurement discards any vision measurements added earlier
+   * with a later timestamp, so measurements from several cameras, which
+   * often arrive out of order, should be added with this method rather than
+   * one at a time. They are sorted and applied in timestamp order. Unlike
+   * AddVisionMeasurement(), per-measurement standard deviations don't replace
+   * the ones set by SetVisionMeasurementStdDevs().
+   *
+   * @param measurements The vision measurements.
+   */
+  void AddVisionMeasurements(std::span<const VisionMeasurement> measurements) {
+    wpi::SmallVector<const VisionMeasurement*, 8> sorted;
+    for (auto& measurement : measurements) {
+      sorted.push_back(&measurement);
+    }
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const auto* a, const auto* b) {
+                       return a->timestamp < b->timestamp;
+                     });
+    for (auto* measurement : sorted) {
+      if (measurement->stdDevs) {
+        ApplyVisionMeasurement(measurement->visionRobotPose,
+                               measurement->timestamp,
+                               CalculateVisionK(*measurement->stdDevs));
+      } else {
+        ApplyVisionMeasurement(measurement->visionRobotPose,
+                               measurement->timestamp, m_visionK);
+      }
+    }
+  }
+
   /**
    * Updates the pose estimator with wheel encoder and gyro information. This
    * should be called every loop.
@@ -368,6 +354,94 @@ class WPILIB_DLLEXPORT PoseEstimator {
   }
 
  private:
+  /**
+   * Calculates the Kalman gain for vision measurements with the given
+   * standard deviations.
+   */
+  Eigen::Matrix3d CalculateVisionK(
+      const wpi::array<double, 3>& visionMeasurementStdDevs) const {
+    Eigen::Matrix3d visionK = Eigen::Matrix3d::Zero();
+    wpi::array<double, 3> r{wpi::empty_array};
+    for (size_t i = 0; i < 3; ++i) {
+      r[i] = visionMeasurementStdDevs[i] * visionMeasurementStdDevs[i];
+    }
+
+    // Solve for closed form Kalman gain for continuous Kalman filter with A = 0
+    // and C = I. See wpimath/algorithms.md.
+    for (size_t row = 0; row < 3; ++row) {
+      if (m_q[row] == 0.0) {
+        visionK(row, row) = 0.0;
+      } else {
+        visionK(row, row) =
+            m_q[row] / (m_q[row] + std::sqrt(m_q[row] * r[row]));
+      }
+    }
+    return visionK;
+  }
+
+  /**
+   * Adds a vision measurement, scaled by the given Kalman gain.
+   */
+  void ApplyVisionMeasurement(const Pose2d& visionRobotPose,
+                              units::second_t timestamp,
+                              const Eigen::Matrix3d& visionK) {
+    // Step 0: If this measurement is old enough to be outside the pose buffer's
+    // timespan, skip.
+    if (m_odometryPoseBuffer.GetInternalBuffer().empty() ||
+        m_odometryPoseBuffer.GetInternalBuffer().front().first -
+                kBufferDuration >
+            timestamp) {
+      return;
+    }
+
+    // Step 1: Clean up any old entries
+    CleanUpVisionUpdates();
+
+    // Step 2: Get the pose measured by odometry at the moment the vision
+    // measurement was made.
+    auto odometrySample = m_odometryPoseBuffer.Sample(timestamp);
+
+    if (!odometrySample) {
+      return;
+    }
+
+    // Step 3: Get the vision-compensated pose estimate at the moment the vision
+    // measurement was made.
+    auto visionSample = SampleAt(timestamp);
+
+    if (!visionSample) {
+      return;
+    }
+
+    // Step 4: Measure the twist between the old pose estimate and the vision
+    // pose.
+    auto twist = visionSample.value().Log(visionRobotPose);
+
+    // Step 5: We should not trust the twist entirely, so instead we scale this
+    // twist by a Kalman gain matrix representing how much we trust vision
+    // measurements compared to our current pose.
+    Eigen::Vector3d k_times_twist =
+        visionK * Eigen::Vector3d{twist.dx.value(), twist.dy.value(),
+                                  twist.dtheta.value()};
+
+    // Step 6: Convert back to Twist2d.
+    Twist2d scaledTwist{units::meter_t{k_times_twist(0)},
+                        units::meter_t{k_times_twist(1)},
+                        units::radian_t{k_times_twist(2)}};
+
+    // Step 7: Calculate and record the vision update.
+    VisionUpdate visionUpdate{visionSample->Exp(scaledTwist), *odometrySample};
+    m_visionUpdates[timestamp] = visionUpdate;
+
+    // Step 8: Remove later vision measurements. (Matches previous behavior)
+    auto firstAfter = m_visionUpdates.upper_bound(timestamp);
+    m_visionUpdates.erase(firstAfter, m_visionUpdates.end());
+
+    // Step 9: Update latest pose estimate. Since we cleared all updates after
+    // this vision update, it's guaranteed to be the latest vision update.
+    m_poseEstimate = visionUpdate.Compensate(m_odometry.GetPose());
+  }
+
   /**
    * Removes stale vision updates that won't affect sampling.
    */
@@ -4,12 +4,15 @@
 
 #pragma once
 
+#include <algorithm>
 #include <map>
 #include <optional>
+#include <span>
 #include <utility>
 #include <vector>
 
 #include <Eigen/Core>
+#include <wpi/SmallVector.h>
 #include <wpi/SymbolExports.h>
 #include <wpi/array.h>
 
@@ -89,24 +92,7 @@ class WPILIB_DLLEXPORT PoseEstimator3d {
    */
   void SetVisionMeasurementStdDevs(
       const wpi::array<double, 4>& visionMeasurementStdDevs) {
-    wpi::array<double, 4> r{wpi::empty_array};
-    for (size_t i = 0; i < 4; ++i) {
-      r[i] = visionMeasurementStdDevs[i] * visionMeasurementStdDevs[i];
-    }
-
-    // Solve for closed form Kalman gain for continuous Kalman filter with A = 0
-    // and C = I. See wpimath/algorithms.md.
-    for (size_t row = 0; row < 4; ++row) {
-      if (m_q[row] == 0.0) {
-        m_visionK(row, row) = 0.0;
-      } else {
-        m_visionK(row, row) =
-            m_q[row] / (m_q[row] + std::sqrt(m_q[row] * r[row]));
-      }
-    }
-    double angle_gain = m_visionK(3, 3);
-    m_visionK(4, 4) = angle_gain;
-    m_visionK(5, 5) = angle_gain;
+    m_visionK = CalculateVisionK(visionMeasurementStdDevs);
   }
 
   /**
@@ -242,63 +228,7 @@ class WPILIB_DLLEXPORT PoseEstimator3d {
    */
   void AddVisionMeasurement(const Pose3d& visionRobotPose,
                             units::second_t timestamp) {
-    // Step 0: If this measurement is old enough to be outside the pose buffer's
-    // timespan, skip.
-    if (m_odometryPoseBuffer.GetInternalBuffer().empty() ||
-        m_odometryPoseBuffer.GetInternalBuffer().front().first -
-                kBufferDuration >
-            timestamp) {
-      return;
-    }
-
-    // Step 1: Clean up any old entries
-    CleanUpVisionUpdates();
-
-    // Step 2: Get the pose measured by odometry at the moment the vision
-    // measurement was made.
-    auto odometrySample = m_odometryPoseBuffer.Sample(timestamp);
-
-    if (!odometrySample) {
-      return;
-    }
-
-    // Step 3: Get the vision-compensated pose estimate at the moment the vision
-    // measurement was made.
-    auto visionSample = SampleAt(timestamp);
-
-    if (!visionSample) {
-      return;
-    }
-
-    // Step 4: Measure the twist between the old pose estimate and the vision
-    // pose.
-    auto twist = visionSample.value().Log(visionRobotPose);
-
-    // Step 5: We should not trust the twist entirely, so instead we scale this
-    // twist by a Kalman gain matrix representing how much we trust vision
-    // measurements compared to our current pose.
-    frc::Vectord<6> k_times_twist =
-        m_visionK * frc::Vectord<6>{twist.dx.value(), twist.dy.value(),
-                                    twist.dz.value(), twist.rx.value(),
-                                    twist.ry.value(), twist.rz.value()};
-
-    // Step 6: Convert back to Twist3d.
-    Twist3d scaledTwist{
-        units::meter_t{k_times_twist(0)},  units::meter_t{k_times_twist(1)},
-        units::meter_t{k_times_twist(2)},  units::radian_t{k_times_twist(3)},
-        units::radian_t{k_times_twist(4)}, units::radian_t{k_times_twist(5)}};
-
-    // Step 7: Calculate and record the vision update.
-    VisionUpdate visionUpdate{visionSample->Exp(scaledTwist), *odometrySample};
-    m_visionUpdates[timestamp] = visionUpdate;
-
-    // Step 8: Remove later vision measurements. (Matches previous behavior)
-    auto firstAfter = m_visionUpdates.upper_bound(timestamp);
-    m_visionUpdates.erase(firstAfter, m_visionUpdates.end());
-
-    // Step 9: Update latest pose estimate. Since we cleared all updates after
-    // this vision update, it's guaranteed to be the latest vision update.
-    m_poseEstimate = visionUpdate.Compensate(m_odometry.GetPose());
+    ApplyVisionMeasurement(visionRobotPose, timestamp, m_visionK);
   }
 
   /**
@@ -336,6 +266,58 @@ class WPILIB_DLLEXPORT PoseEstimator3d {
     AddVisionMeasurement(visionRobotPose, timestamp);
   }
 
+  /**
+   * A vision measurement for AddVisionMeasurements().
+   */
+  struct VisionMeasurement {
+    /// The pose of the robot as measured by the vision camera.
+    Pose3d visionRobotPose;
+
+    /// The timestamp of the vision measurement, in the same epoch as
+    /// UpdateWithTime().
+    units::second_t timestamp;
+
+    /// Standard deviations of the vision pose measurement (x position in
+    /// meters, y position in meters, z position in meters, and angle in
+    /// radians). If empty, the standard deviations set by
+    /// SetVisionMeasurementStdDevs() are used.
+    std::optional<wpi::array<double, 4>> stdDevs;
+  };
+
+  /**
+   * Adds several vision measurements taken around the same time, such as one
+   * from each camera.
+   *
+   * Adding a vision measurement discards any vision measurements added earlier
+   * with a later timestamp, so measurements from several cameras, which
+   * often arrive out of order, should be added with this method rather than
+   * one at a time. They are sorted and applied in timestamp order. Unlike
+   * AddVisionMeasurement(), per-measurement standard deviations don't replace
+   * the ones set by SetVisionMeasurementStdDevs().
+   *
+   * @param measurements The vision measurements.
+   */
+  void AddVisionMeasurements(std::span<const VisionMeasurement> measurements) {
+    wpi::SmallVector<const VisionMeasurement*, 8> sorted;
+    for (auto& measurement : measurements) {
+      sorted.push_back(&measurement);
+    }
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const auto* a, const auto* b) {
+                       return a->timestamp < b->timestamp;
+                     });
+    for (auto* measurement : sorted) {
+      if (measurement->stdDevs) {
+        ApplyVisionMeasurement(measurement->visionRobotPose,
+                               measurement->timestamp,
+                               CalculateVisionK(*measurement->stdDevs));
+      } else {
+        ApplyVisionMeasurement(measurement->visionRobotPose,
+                               measurement->timestamp, m_visionK);
+      }
+    }
+  }
+
   /**
    * Updates the pose estimator with wheel encoder and gyro information. This
    * should be called every loop.
@@ -379,6 +361,99 @@ class WPILIB_DLLEXPORT PoseEstimator3d {
   }
 
  private:
+  /**
+   * Calculates the Kalman gain for vision measurements with the given
+   * standard deviations.
+   */
+  frc::Matrixd<6, 6> CalculateVisionK(
+      const wpi::array<double, 4>& visionMeasurementStdDevs) const {
+    frc::Matrixd<6, 6> visionK = frc::Matrixd<6, 6>::Zero();
+    wpi::array<double, 4> r{wpi::empty_array};
+    for (size_t i = 0; i < 4; ++i) {
+      r[i] = visionMeasurementStdDevs[i] * visionMeasurementStdDevs[i];
+    }
+
+    // Solve for closed form Kalman gain for continuous Kalman filter with A = 0
+    // and C = I. See wpimath/algorithms.md.
+    for (size_t row = 0; row < 4; ++row) {
+      if (m_q[row] == 0.0) {
+        visionK(row, row) = 0.0;
+      } else {
+        visionK(row, row) =
+            m_q[row] / (m_q[row] + std::sqrt(m_q[row] * r[row]));
+      }
+    }
+    double angle_gain = visionK(3, 3);
+    visionK(4, 4) = angle_gain;
+    visionK(5, 5) = angle_gain;
+    return visionK;
+  }
+
+  /**
+   * Adds a vision measurement, scaled by the given Kalman gain.
+   */
+  void ApplyVisionMeasurement(const Pose3d& visionRobotPose,
+                              units::second_t timestamp,
+                              const frc::Matrixd<6, 6>& visionK) {
+    // Step 0: If this measurement is old enough to be outside the pose buffer's
+    // timespan, skip.
+    if (m_odometryPoseBuffer.GetInternalBuffer().empty() ||
+        m_odometryPoseBuffer.GetInternalBuffer().front().first -
+                kBufferDuration >
+            timestamp) {
+      return;
+    }
+
+    // Step 1: Clean up any old entries
+    CleanUpVisionUpdates();
+
+    // Step 2: Get the pose measured by odometry at the moment the vision
+    // measurement was made.
+    auto odometrySample = m_odometryPoseBuffer.Sample(timestamp);
+
+    if (!odometrySample) {
+      return;
+    }
+
+    // Step 3: Get the vision-compensated pose estimate at the moment the vision
+    // measurement was made.
+    auto visionSample = SampleAt(timestamp);
+
+    if (!visionSample) {
+      return;
+    }
+
+    // Step 4: Measure the twist between the old pose estimate and the vision
+    // pose.
+    auto twist = visionSample.value().Log(visionRobotPose);
+
+    // Step 5: We should not trust the twist entirely, so instead we scale this
+    // twist by a Kalman gain matrix representing how much we trust vision
+    // measurements compared to our current pose.
+    frc::Vectord<6> k_times_twist =
+        visionK * frc::Vectord<6>{twist.dx.value(), twist.dy.value(),
+                                  twist.dz.value(), twist.rx.value(),
+                                  twist.ry.value(), twist.rz.value()};
+
+    // Step 6: Convert back to Twist3d.
+    Twist3d scaledTwist{
+        units::meter_t{k_times_twist(0)},  units::meter_t{k_times_twist(1)},
+        units::meter_t{k_times_twist(2)},  units::radian_t{k_times_twist(3)},
+        units::radian_t{k_times_twist(4)}, units::radian_t{k_times_twist(5)}};
+
+    // Step 7: Calculate and record the vision update.
+    VisionUpdate visionUpdate{visionSample->Exp(scaledTwist), *odometrySample};
+    m_visionUpdates[timestamp] = visionUpdate;
+
+    // Step 8: Remove later vision measurements. (Matches previous behavior)
+    auto firstAfter = m_visionUpdates.upper_bound(timestamp);
+    m_visionUpdates.erase(firstAfter, m_visionUpdates.end());
+
+    // Step 9: Update latest pose estimate. Since we cleared all updates after
+    // this vision update, it's guaranteed to be the latest vision update.
+    m_poseEstimate = visionUpdate.Compensate(m_odometry.GetPose());
+  }
+
   /**
    * Removes stale vision updates that won't affect sampling.
    */
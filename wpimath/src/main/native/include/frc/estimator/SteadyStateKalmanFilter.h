@@ -202,7 +202,7 @@ class SteadyStateKalmanFilter {
    * @param dt Timestep for prediction.
    */
   void Predict(const InputVector& u, units::second_t dt) {
-    m_xHat = m_plant->CalculateX(m_xHat, u, dt);
+    m_xHat = m_plant->CalculateX(m_xHat, u, dt, m_discreteAB);
   }
 
   /**
@@ -231,6 +231,11 @@ class SteadyStateKalmanFilter {
    * The state estimate.
    */
   StateVector m_xHat;
+
+  /**
+   * Discretized A and B matrices for recent timesteps.
+   */
+  typename LinearSystem<States, Inputs, Outputs>::DiscreteABCache m_discreteAB;
 };
 
 extern template class EXPORT_TEMPLATE_DECLARE(WPILIB_DLLEXPORT)
@@ -306,12 +306,10 @@ class UnscentedKalmanFilter {
    *          vector.
    * @param R Continuous measurement noise covariance matrix.
    */
-  template <int Rows>
-  void Correct(
-      const InputVector& u, const Vectord<Rows>& y,
-      std::function<Vectord<Rows>(const StateVector&, const InputVector&)> h,
-      const Matrixd<Rows, Rows>& R) {
-    auto meanFuncY = [](const Matrixd<Outputs, 2 * States + 1>& sigmas,
+  template <int Rows, typename H>
+  void Correct(const InputVector& u, const Vectord<Rows>& y, H&& h,
+               const Matrixd<Rows, Rows>& R) {
+    auto meanFuncY = [](const Matrixd<Rows, 2 * States + 1>& sigmas,
                         const Vectord<2 * States + 1>& Wc) -> Vectord<Rows> {
       return sigmas * Wc;
     };
@@ -325,9 +323,8 @@ class UnscentedKalmanFilter {
     };
     auto addFuncX = [](const StateVector& a,
                        const StateVector& b) -> StateVector { return a + b; };
-    Correct<Rows>(u, y, std::move(h), R, std::move(meanFuncY),
-                  std::move(residualFuncY), std::move(residualFuncX),
-                  std::move(addFuncX));
+    Correct<Rows>(u, y, h, R, meanFuncY, residualFuncY, residualFuncX,
+                  addFuncX);
   }
 
   /**
@@ -349,21 +346,16 @@ class UnscentedKalmanFilter {
    * @param residualFuncX A function that computes the residual of two state
    *                      vectors (i.e. it subtracts them.)
    * @param addFuncX      A function that adds two state vectors.
+   *
+   * The functions are taken as template parameters so that lambdas passed
+   * directly can be inlined into the sigma point loops.
    */
-  template <int Rows>
-  void Correct(
-      const InputVector& u, const Vectord<Rows>& y,
-      std::function<Vectord<Rows>(const StateVector&, const InputVector&)> h,
-      const Matrixd<Rows, Rows>& R,
-      std::function<Vectord<Rows>(const Matrixd<Rows, 2 * States + 1>&,
-                                  const Vectord<2 * States + 1>&)>
-          meanFuncY,
-      std::function<Vectord<Rows>(const Vectord<Rows>&, const Vectord<Rows>&)>
-          residualFuncY,
-      std::function<StateVector(const StateVector&, const StateVector&)>
-          residualFuncX,
-      std::function<StateVector(const StateVector&, const StateVector&)>
-          addFuncX) {
+  template <int Rows, typename H, typename MeanFuncY, typename ResidualFuncY,
+            typename ResidualFuncX, typename AddFuncX>
+  void Correct(const InputVector& u, const Vectord<Rows>& y, H&& h,
+               const Matrixd<Rows, Rows>& R, MeanFuncY&& meanFuncY,
+               ResidualFuncY&& residualFuncY, ResidualFuncX&& residualFuncX,
+               AddFuncX&& addFuncX) {
     Matrixd<Rows, Rows> discR = DiscretizeR<Rows>(R, m_dt);
     Eigen::internal::llt_inplace<double, Eigen::Lower>::blocked(discR);
 
@@ -396,10 +388,13 @@ class UnscentedKalmanFilter {
     // K = (P_{xy} / S_yᵀ) / S_y
     // K = (S_y \ P_{xy}ᵀ)ᵀ / S_y
     // K = (S_yᵀ \ (S_y \ P_{xy}ᵀ))ᵀ
+    //
+    // S_y is upper triangular, so these are back and forward substitutions.
     Matrixd<States, Rows> K =
         Sy.transpose()
-            .fullPivHouseholderQr()
-            .solve(Sy.fullPivHouseholderQr().solve(Pxy.transpose()))
+            .template triangularView<Eigen::Lower>()
+            .solve(Sy.template triangularView<Eigen::Upper>().solve(
+                Pxy.transpose()))
             .transpose();
 
     // x̂ₖ₊₁⁺ = x̂ₖ₊₁⁻ + K(y − ŷ)
@@ -4,7 +4,7 @@
 
 #pragma once
 
-#include <functional>
+#include <cmath>
 #include <tuple>
 
 #include <Eigen/QR>
@@ -27,26 +27,23 @@ namespace frc {
  * @param Wm           Weights for the mean.
  * @param Wc           Weights for the covariance.
  * @param meanFunc     A function that computes the mean of 2 * States + 1 state
- *                     vectors using a given set of weights.
+ *                     vectors using a given set of weights. Taken as a template
+ *                     parameter so it can be inlined.
  * @param residualFunc A function that computes the residual of two state
- *                     vectors (i.e. it subtracts them.)
+ *                     vectors (i.e. it subtracts them.) Taken as a template
+ *                     parameter so it can be inlined.
  * @param squareRootR  Square-root of the noise covariance of the sigma points.
  *
  * @return Tuple of x, mean of sigma points; S, square-root covariance of
  * sigmas.
  */
-template <int CovDim, int States>
+template <int CovDim, int States, typename MeanFunc, typename ResidualFunc>
 std::tuple<Vectord<CovDim>, Matrixd<CovDim, CovDim>>
-SquareRootUnscentedTransform(
-    const Matrixd<CovDim, 2 * States + 1>& sigmas,
-    const Vectord<2 * States + 1>& Wm, const Vectord<2 * States + 1>& Wc,
-    std::function<Vectord<CovDim>(const Matrixd<CovDim, 2 * States + 1>&,
-                                  const Vectord<2 * States + 1>&)>
-        meanFunc,
-    std::function<Vectord<CovDim>(const Vectord<CovDim>&,
-                                  const Vectord<CovDim>&)>
-        residualFunc,
-    const Matrixd<CovDim, CovDim>& squareRootR) {
+SquareRootUnscentedTransform(const Matrixd<CovDim, 2 * States + 1>& sigmas,
+                             const Vectord<2 * States + 1>& Wm,
+                             const Vectord<2 * States + 1>& Wc,
+                             MeanFunc&& meanFunc, ResidualFunc&& residualFunc,
+                             const Matrixd<CovDim, CovDim>& squareRootR) {
   // New mean is usually just the sum of the sigmas * weight:
   //       n
   // dot = Σ W[k] Xᵢ[k]
@@ -54,10 +51,10 @@ SquareRootUnscentedTransform(
   Vectord<CovDim> x = meanFunc(sigmas, Wm);
 
   Matrixd<CovDim, States * 2 + CovDim> Sbar;
+  const double sqrtWc = std::sqrt(Wc[1]);
   for (int i = 0; i < States * 2; i++) {
     Sbar.template block<CovDim, 1>(0, i) =
-        std::sqrt(Wc[1]) *
-        residualFunc(sigmas.template block<CovDim, 1>(0, 1 + i), x);
+        sqrtWc * residualFunc(sigmas.template block<CovDim, 1>(0, 1 + i), x);
   }
   Sbar.template block<CovDim, CovDim>(0, States * 2) = squareRootR;
 
@@ -71,6 +71,11 @@ namespace frc {
  * definitely need to adjust the gains if you then want to run it at 200Hz!
  * Combining this with Note 1 - the impetus is on YOU as a developer to make
  * sure Calculate() gets called at the desired, constant frequency!
+ *
+ * Note 3: T may be a fixed-size Eigen vector or array type, such as
+ * Eigen::Array<double, 12, 1>, to filter several signals with the same gains at
+ * once. Each element is filtered independently, and Eigen vectorizes the
+ * arithmetic across elements.
  */
 template <class T>
 class LinearFilter {
@@ -88,10 +93,10 @@ class LinearFilter {
         m_inputGains(ffGains.begin(), ffGains.end()),
         m_outputGains(fbGains.begin(), fbGains.end()) {
     for (size_t i = 0; i < ffGains.size(); ++i) {
-      m_inputs.emplace_front(0.0);
+      m_inputs.push_front(Zero());
     }
     for (size_t i = 0; i < fbGains.size(); ++i) {
-      m_outputs.emplace_front(0.0);
+      m_outputs.push_front(Zero());
     }
 
     if (!std::is_constant_evaluated()) {
@@ -271,8 +276,8 @@ class LinearFilter {
    * Reset the filter state.
    */
   constexpr void Reset() {
-    std::fill(m_inputs.begin(), m_inputs.end(), T{0.0});
-    std::fill(m_outputs.begin(), m_outputs.end(), T{0.0});
+    std::fill(m_inputs.begin(), m_inputs.end(), Zero());
+    std::fill(m_outputs.begin(), m_outputs.end(), Zero());
   }
 
   /**
@@ -352,7 +357,7 @@ class LinearFilter {
    * @return The filtered value at this step
    */
   constexpr T Calculate(T input) {
-    T retVal{0.0};
+    T retVal = Zero();
 
     // Rotate the inputs
     if (m_inputGains.size() > 0) {
@@ -388,7 +393,18 @@ class LinearFilter {
   wpi::circular_buffer<T> m_outputs;
   std::vector<double> m_inputGains;
   std::vector<double> m_outputGains;
-  T m_lastOutput{0.0};
+  T m_lastOutput = Zero();
+
+  /**
+   * Returns zero for scalars, or a vector of zeros for fixed-size Eigen types.
+   */
+  static constexpr T Zero() {
+    if constexpr (requires { T::Zero(); }) {
+      return T::Zero();
+    } else {
+      return T{0.0};
+    }
+  }
 
   // Usage reporting instances
   inline static int instances = 0;
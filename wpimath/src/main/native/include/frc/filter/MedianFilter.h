@@ -35,23 +35,32 @@ class MedianFilter {
    * @return The median of the moving window, updated to include the next value.
    */
   constexpr T Calculate(T next) {
-    // Insert next value at proper point in sorted array
-    wpi::insert_sorted(m_orderedValues, next);
-
-    size_t curSize = m_orderedValues.size();
-
-    // If buffer is at max size, pop element off of end of circular buffer
-    // and remove from ordered list
-    if (curSize > m_size) {
-      m_orderedValues.erase(std::find(m_orderedValues.begin(),
-                                      m_orderedValues.end(),
-                                      m_valueBuffer.pop_back()));
-      --curSize;
+    if (m_orderedValues.size() < m_size) {
+      // Insert next value at proper point in sorted array
+      wpi::insert_sorted(m_orderedValues, next);
+    } else {
+      // If buffer is at max size, pop element off of end of circular buffer
+      // and replace it in the ordered list with the next value. Only the
+      // elements between the old and new values' positions need to shift,
+      // which is much cheaper than an erase and insert for large windows.
+      auto old = std::lower_bound(m_orderedValues.begin(),
+                                  m_orderedValues.end(),
+                                  m_valueBuffer.pop_back());
+      if (next < *old) {
+        auto pos = std::upper_bound(m_orderedValues.begin(), old, next);
+        std::move_backward(pos, old, old + 1);
+        *pos = next;
+      } else {
+        auto pos = std::upper_bound(old + 1, m_orderedValues.end(), next);
+        std::move(old + 1, pos, old);
+        *(pos - 1) = next;
+      }
     }
 
     // Add next value to circular buffer
     m_valueBuffer.push_front(next);
 
+    size_t curSize = m_orderedValues.size();
     if (curSize % 2 != 0) {
       // If size is odd, return middle element of sorted list
       return m_orderedValues[curSize / 2];
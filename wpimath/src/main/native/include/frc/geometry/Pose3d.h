@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <span>
 #include <stdexcept>
 #include <type_traits>
 #include <utility>
@@ -193,6 +194,21 @@ class WPILIB_DLLEXPORT Pose3d {
    */
   constexpr Pose3d TransformBy(const Transform3d& other) const;
 
+  /**
+   * Transforms the pose by each of the given transformations, which gives the
+   * same poses as calling TransformBy(const Transform3d&) on each one. The
+   * pose's rotation matrix is computed once and shared by every
+   * transformation, which is faster than separate calls when transforming many
+   * poses relative to the same frame (e.g., the corners of an AprilTag).
+   *
+   * @param transforms The transforms to transform the pose by.
+   * @param poses The span to write the transformed poses to. It must be the
+   *     same size as transforms.
+   * @throws std::invalid_argument if the spans are different sizes.
+   */
+  constexpr void TransformBy(std::span<const Transform3d> transforms,
+                             std::span<Pose3d> poses) const;
+
   /**
    * Returns the current pose relative to the given pose.
    *
@@ -343,6 +359,44 @@ constexpr Pose3d Pose3d::TransformBy(const Transform3d& other) const {
           other.Rotation() + m_rotation};
 }
 
+constexpr void Pose3d::TransformBy(std::span<const Transform3d> transforms,
+                                   std::span<Pose3d> poses) const {
+  if (transforms.size() != poses.size()) {
+    throw std::invalid_argument(
+        "Transforms and poses must be the same size");
+  }
+
+  // Rotating a translation by a rotation matrix takes nine multiplies, fewer
+  // than the quaternion products in Translation3d::RotateBy()
+  double w = m_rotation.GetQuaternion().W();
+  double x = m_rotation.GetQuaternion().X();
+  double y = m_rotation.GetQuaternion().Y();
+  double z = m_rotation.GetQuaternion().Z();
+  double r00 = 1.0 - 2.0 * (y * y + z * z);
+  double r01 = 2.0 * (x * y - w * z);
+  double r02 = 2.0 * (x * z + w * y);
+  double r10 = 2.0 * (x * y + w * z);
+  double r11 = 1.0 - 2.0 * (x * x + z * z);
+  double r12 = 2.0 * (y * z - w * x);
+  double r20 = 2.0 * (x * z - w * y);
+  double r21 = 2.0 * (y * z + w * x);
+  double r22 = 1.0 - 2.0 * (x * x + y * y);
+
+  for (size_t i = 0; i < transforms.size(); ++i) {
+    double tx = transforms[i].X().value();
+    double ty = transforms[i].Y().value();
+    double tz = transforms[i].Z().value();
+    poses[i] = Pose3d{
+        units::meter_t{m_translation.X().value() + r00 * tx + r01 * ty +
+                       r02 * tz},
+        units::meter_t{m_translation.Y().value() + r10 * tx + r11 * ty +
+                       r12 * tz},
+        units::meter_t{m_translation.Z().value() + r20 * tx + r21 * ty +
+                       r22 * tz},
+        transforms[i].Rotation().RotateBy(m_rotation)};
+  }
+}
+
 constexpr Pose3d Pose3d::RelativeTo(const Pose3d& other) const {
   const Transform3d transform{other, *this};
   return {transform.Translation(), transform.Rotation()};
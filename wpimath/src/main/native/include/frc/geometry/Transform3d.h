@@ -202,7 +202,10 @@ constexpr Transform3d::Transform3d(const Pose3d& initial, const Pose3d& final) {
 }
 
 constexpr Transform3d Transform3d::operator+(const Transform3d& other) const {
-  return Transform3d{Pose3d{}, Pose3d{}.TransformBy(*this).TransformBy(other)};
+  // Equivalent to Transform3d{Pose3d{}, Pose3d{}.TransformBy(*this)
+  // .TransformBy(other)} without the round trip through the pose difference
+  return Transform3d{m_translation + other.m_translation.RotateBy(m_rotation),
+                     other.m_rotation.RotateBy(m_rotation)};
 }
 
 }  // namespace frc
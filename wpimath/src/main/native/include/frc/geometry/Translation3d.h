@@ -142,8 +142,10 @@ class WPILIB_DLLEXPORT Translation3d {
    * @return The new rotated translation.
    */
   constexpr Translation3d RotateBy(const Rotation3d& other) const {
+    // Rotation3d's quaternion is always normalized, so its inverse is its
+    // conjugate. This avoids the square root and division in Inverse().
     Quaternion p{0.0, m_x.value(), m_y.value(), m_z.value()};
-    auto qprime = other.GetQuaternion() * p * other.GetQuaternion().Inverse();
+    auto qprime = other.GetQuaternion() * p * other.GetQuaternion().Conjugate();
     return Translation3d{units::meter_t{qprime.X()}, units::meter_t{qprime.Y()},
                          units::meter_t{qprime.Z()}};
   }
@@ -11,6 +11,7 @@
 
 template <>
 struct WPILIB_DLLEXPORT wpi::Struct<frc::Translation3d> {
+  static constexpr bool kLayoutCompatible = true;
   static constexpr std::string_view GetTypeName() { return "Translation3d"; }
   static constexpr size_t GetSize() { return 24; }
   static constexpr std::string_view GetSchema() {
@@ -22,3 +23,4 @@ struct WPILIB_DLLEXPORT wpi::Struct<frc::Translation3d> {
 };
 
 static_assert(wpi::StructSerializable<frc::Translation3d>);
+static_assert(wpi::LayoutCompatibleStruct<frc::Translation3d>);
@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <functional>
 #include <optional>
+#include <span>
 #include <utility>
 #include <vector>
 
@@ -62,35 +63,41 @@ class TimeInterpolatableBuffer {
    * @param sample The sample object.
    */
   void AddSample(units::second_t time, T sample) {
+    // Remove expired samples
+    while (m_start < m_pastSnapshots.size() &&
+           time - m_pastSnapshots[m_start].first > m_historySize) {
+      ++m_start;
+    }
+    // Expired samples are only erased from the front of the vector once they
+    // make up half of it, so each sample is shifted a bounded number of times
+    if (m_start > 0 && m_start * 2 >= m_pastSnapshots.size()) {
+      Compact();
+    }
+
     // Add the new state into the vector
-    if (m_pastSnapshots.size() == 0 || time > m_pastSnapshots.back().first) {
-      m_pastSnapshots.emplace_back(time, sample);
-    } else {
-      auto first_after = std::upper_bound(
-          m_pastSnapshots.begin(), m_pastSnapshots.end(), time,
-          [](auto t, const auto& pair) { return t < pair.first; });
-
-      if (first_after == m_pastSnapshots.begin()) {
-        // All entries come after the sample
-        m_pastSnapshots.insert(first_after, std::pair{time, sample});
-      } else if (auto last_not_greater_than = first_after - 1;
-                 last_not_greater_than == m_pastSnapshots.begin() ||
-                 last_not_greater_than->first < time) {
-        // Some entries come before the sample, but none are recorded with the
-        // same time
-        m_pastSnapshots.insert(first_after, std::pair{time, sample});
-      } else {
-        // An entry exists with the same recorded time
-        last_not_greater_than->second = sample;
-      }
+    if (m_start == m_pastSnapshots.size() ||
+        time > m_pastSnapshots.back().first) {
+      m_pastSnapshots.emplace_back(time, std::move(sample));
+      return;
     }
-    while (time - m_pastSnapshots[0].first > m_historySize) {
-      m_pastSnapshots.erase(m_pastSnapshots.begin());
+
+    auto first_after = std::upper_bound(
+        m_pastSnapshots.begin() + m_start, m_pastSnapshots.end(), time,
+        [](auto t, const auto& pair) { return t < pair.first; });
+    if (first_after != m_pastSnapshots.begin() + m_start &&
+        (first_after - 1)->first == time) {
+      // An entry exists with the same recorded time
+      (first_after - 1)->second = std::move(sample);
+    } else {
+      m_pastSnapshots.insert(first_after, std::pair{time, std::move(sample)});
     }
   }
 
   /** Clear all old samples. */
-  void Clear() { m_pastSnapshots.clear(); }
+  void Clear() {
+    m_pastSnapshots.clear();
+    m_start = 0;
+  }
 
   /**
    * Sample the buffer at the given time. If the buffer is empty, an empty
@@ -99,7 +106,9 @@ class TimeInterpolatableBuffer {
    * @param time The time at which to sample the buffer.
    */
   std::optional<T> Sample(units::second_t time) const {
-    if (m_pastSnapshots.empty()) {
+    auto begin = m_pastSnapshots.begin() + m_start;
+    auto end = m_pastSnapshots.end();
+    if (begin == end) {
       return {};
     }
 
@@ -107,22 +116,23 @@ class TimeInterpolatableBuffer {
     // vector that has a timestamp that is equal to or greater than the vision
     // measurement timestamp.
 
-    if (time <= m_pastSnapshots.front().first) {
-      return m_pastSnapshots.front().second;
+    if (time <= begin->first) {
+      return begin->second;
     }
     if (time > m_pastSnapshots.back().first) {
       return m_pastSnapshots.back().second;
     }
-    if (m_pastSnapshots.size() < 2) {
-      return m_pastSnapshots[0].second;
+    if (end - begin < 2) {
+      return begin->second;
     }
 
     // Get the iterator which has a key no less than the requested key.
-    auto upper_bound = std::lower_bound(
-        m_pastSnapshots.begin(), m_pastSnapshots.end(), time,
-        [](const auto& pair, auto t) { return t > pair.first; });
+    auto upper_bound =
+        std::lower_bound(begin, end, time, [](const auto& pair, auto t) {
+          return t > pair.first;
+        });
 
-    if (upper_bound == m_pastSnapshots.begin()) {
+    if (upper_bound == begin) {
       return upper_bound->second;
     }
 
@@ -139,19 +149,30 @@ class TimeInterpolatableBuffer {
    * replay odometry inputs stored within this buffer.
    */
   std::vector<std::pair<units::second_t, T>>& GetInternalBuffer() {
+    Compact();
     return m_pastSnapshots;
   }
 
   /**
    * Grant access to the internal sample buffer.
    */
-  const std::vector<std::pair<units::second_t, T>>& GetInternalBuffer() const {
-    return m_pastSnapshots;
+  std::span<const std::pair<units::second_t, T>> GetInternalBuffer() const {
+    return std::span{m_pastSnapshots}.subspan(m_start);
   }
 
  private:
+  // Erases the expired samples from the front of the vector.
+  void Compact() {
+    m_pastSnapshots.erase(m_pastSnapshots.begin(),
+                          m_pastSnapshots.begin() + m_start);
+    m_start = 0;
+  }
+
   units::second_t m_historySize;
+  // Samples before m_start have expired but not yet been erased; they are
+  // erased before the vector is exposed by GetInternalBuffer()
   std::vector<std::pair<units::second_t, T>> m_pastSnapshots;
+  size_t m_start = 0;
   std::function<T(const T&, const T&, double)> m_interpolatingFunc;
 };
 
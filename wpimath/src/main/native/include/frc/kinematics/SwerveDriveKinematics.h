@@ -7,6 +7,8 @@
 #include <algorithm>
 #include <concepts>
 #include <cstddef>
+#include <span>
+#include <stdexcept>
 
 #include <Eigen/QR>
 #include <wpi/SymbolExports.h>
@@ -76,7 +78,8 @@ class SwerveDriveKinematics
       // clang-format on
     }
 
-    m_forwardKinematics = m_inverseKinematics.householderQr();
+    m_forwardKinematics = m_inverseKinematics.householderQr().solve(
+        Matrixd<NumModules * 2, NumModules * 2>::Identity());
 
     wpi::math::MathSharedStore::ReportUsage(
         wpi::math::MathUsageId::kKinematics_SwerveDrive, 1);
@@ -93,7 +96,8 @@ class SwerveDriveKinematics
       // clang-format on
     }
 
-    m_forwardKinematics = m_inverseKinematics.householderQr();
+    m_forwardKinematics = m_inverseKinematics.householderQr().solve(
+        Matrixd<NumModules * 2, NumModules * 2>::Identity());
 
     wpi::math::MathSharedStore::ReportUsage(
         wpi::math::MathUsageId::kKinematics_SwerveDrive, 1);
@@ -253,7 +257,7 @@ class SwerveDriveKinematics
     }
 
     Eigen::Vector3d chassisSpeedsVector =
-        m_forwardKinematics.solve(moduleStateMatrix);
+        m_forwardKinematics * moduleStateMatrix;
 
     return {units::meters_per_second_t{chassisSpeedsVector(0)},
             units::meters_per_second_t{chassisSpeedsVector(1)},
@@ -306,7 +310,7 @@ class SwerveDriveKinematics
     }
 
     Eigen::Vector3d chassisDeltaVector =
-        m_forwardKinematics.solve(moduleDeltaMatrix);
+        m_forwardKinematics * moduleDeltaMatrix;
 
     return {units::meter_t{chassisDeltaVector(0)},
             units::meter_t{chassisDeltaVector(1)},
@@ -324,6 +328,56 @@ class SwerveDriveKinematics
     return ToTwist2d(result);
   }
 
+  /**
+   * Performs forward kinematics on a batch of module states, such as a queue of
+   * samples from a high-frequency odometry thread. This is equivalent to, but
+   * faster than, calling ToChassisSpeeds() on each element.
+   *
+   * @param moduleStates The module states of each sample. The order of the
+   * swerve module states should be same as passed into the constructor of this
+   * class.
+   * @param chassisSpeeds Where to store the resulting chassis speeds; must be
+   * the same size as moduleStates.
+   */
+  void ToChassisSpeeds(
+      std::span<const wpi::array<SwerveModuleState, NumModules>> moduleStates,
+      std::span<ChassisSpeeds> chassisSpeeds) const {
+    if (moduleStates.size() != chassisSpeeds.size()) {
+      throw std::invalid_argument(
+          "moduleStates and chassisSpeeds must be the same size");
+    }
+    SolveBatch(moduleStates, [&](size_t j, const Eigen::Vector3d& result) {
+      chassisSpeeds[j] = {units::meters_per_second_t{result(0)},
+                          units::meters_per_second_t{result(1)},
+                          units::radians_per_second_t{result(2)}};
+    });
+  }
+
+  /**
+   * Performs forward kinematics on a batch of module position deltas, such as
+   * a queue of samples from a high-frequency odometry thread. This is
+   * equivalent to, but faster than, calling ToTwist2d() on each element.
+   *
+   * @param moduleDeltas The module position deltas of each sample. The order
+   * of the swerve module positions should be same as passed into the
+   * constructor of this class.
+   * @param twists Where to store the resulting twists; must be the same size as
+   * moduleDeltas.
+   */
+  void ToTwist2d(
+      std::span<const wpi::array<SwerveModulePosition, NumModules>>
+          moduleDeltas,
+      std::span<Twist2d> twists) const {
+    if (moduleDeltas.size() != twists.size()) {
+      throw std::invalid_argument(
+          "moduleDeltas and twists must be the same size");
+    }
+    SolveBatch(moduleDeltas, [&](size_t j, const Eigen::Vector3d& result) {
+      twists[j] = {units::meter_t{result(0)}, units::meter_t{result(1)},
+                   units::radian_t{result(2)}};
+    });
+  }
+
   /**
    * Renormalizes the wheel speeds if any individual speed is above the
    * specified maximum.
@@ -444,9 +498,43 @@ class SwerveDriveKinematics
   }
 
  private:
+  // Batches are converted this many samples at a time, so the matrix products
+  // have fixed sizes.
+  static constexpr int kBatchBlockSize = 8;
+
+  template <typename Module, typename F>
+  void SolveBatch(std::span<const wpi::array<Module, NumModules>> samples,
+                  F&& output) const {
+    Matrixd<NumModules * 2, kBatchBlockSize> moduleMatrix =
+        Matrixd<NumModules * 2, kBatchBlockSize>::Zero();
+    for (size_t start = 0; start < samples.size(); start += kBatchBlockSize) {
+      size_t count =
+          std::min<size_t>(kBatchBlockSize, samples.size() - start);
+      for (size_t j = 0; j < count; ++j) {
+        for (size_t i = 0; i < NumModules; ++i) {
+          const Module& module = samples[start + j][i];
+          double magnitude;
+          if constexpr (std::same_as<Module, SwerveModuleState>) {
+            magnitude = module.speed.value();
+          } else {
+            magnitude = module.distance.value();
+          }
+          moduleMatrix(i * 2, j) = magnitude * module.angle.Cos();
+          moduleMatrix(i * 2 + 1, j) = magnitude * module.angle.Sin();
+        }
+      }
+
+      Matrixd<3, kBatchBlockSize> result = m_forwardKinematics * moduleMatrix;
+      for (size_t j = 0; j < count; ++j) {
+        output(start + j, result.col(j));
+      }
+    }
+  }
+
   wpi::array<Translation2d, NumModules> m_modules;
   mutable Matrixd<NumModules * 2, 3> m_inverseKinematics;
-  Eigen::HouseholderQR<Matrixd<NumModules * 2, 3>> m_forwardKinematics;
+  // Least-squares pseudo-inverse of the inverse kinematics matrix
+  Matrixd<3, NumModules * 2> m_forwardKinematics;
   mutable wpi::array<Rotation2d, NumModules> m_moduleHeadings;
 
   mutable Translation2d m_previousCoR;
@@ -11,6 +11,7 @@
 
 template <>
 struct WPILIB_DLLEXPORT wpi::Struct<frc::DifferentialDriveWheelPositions> {
+  static constexpr bool kLayoutCompatible = true;
   static constexpr std::string_view GetTypeName() {
     return "DifferentialDriveWheelPositions";
   }
@@ -26,3 +27,5 @@ struct WPILIB_DLLEXPORT wpi::Struct<frc::DifferentialDriveWheelPositions> {
 };
 
 static_assert(wpi::StructSerializable<frc::DifferentialDriveWheelPositions>);
+static_assert(
+    wpi::LayoutCompatibleStruct<frc::DifferentialDriveWheelPositions>);
@@ -11,6 +11,7 @@
 
 template <>
 struct WPILIB_DLLEXPORT wpi::Struct<frc::DifferentialDriveWheelSpeeds> {
+  static constexpr bool kLayoutCompatible = true;
   static constexpr std::string_view GetTypeName() {
     return "DifferentialDriveWheelSpeeds";
   }
@@ -26,3 +27,4 @@ struct WPILIB_DLLEXPORT wpi::Struct<frc::DifferentialDriveWheelSpeeds> {
 };
 
 static_assert(wpi::StructSerializable<frc::DifferentialDriveWheelSpeeds>);
+static_assert(wpi::LayoutCompatibleStruct<frc::DifferentialDriveWheelSpeeds>);
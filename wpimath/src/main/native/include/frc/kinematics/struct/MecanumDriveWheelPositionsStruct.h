@@ -11,6 +11,7 @@
 
 template <>
 struct WPILIB_DLLEXPORT wpi::Struct<frc::MecanumDriveWheelPositions> {
+  static constexpr bool kLayoutCompatible = true;
   static constexpr std::string_view GetTypeName() {
     return "MecanumDriveWheelPositions";
   }
@@ -26,3 +27,4 @@ struct WPILIB_DLLEXPORT wpi::Struct<frc::MecanumDriveWheelPositions> {
 };
 
 static_assert(wpi::StructSerializable<frc::MecanumDriveWheelPositions>);
+static_assert(wpi::LayoutCompatibleStruct<frc::MecanumDriveWheelPositions>);
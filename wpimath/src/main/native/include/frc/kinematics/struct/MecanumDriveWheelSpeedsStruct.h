@@ -11,6 +11,7 @@
 
 template <>
 struct WPILIB_DLLEXPORT wpi::Struct<frc::MecanumDriveWheelSpeeds> {
+  static constexpr bool kLayoutCompatible = true;
   static constexpr std::string_view GetTypeName() {
     return "MecanumDriveWheelSpeeds";
   }
@@ -26,3 +27,4 @@ struct WPILIB_DLLEXPORT wpi::Struct<frc::MecanumDriveWheelSpeeds> {
 };
 
 static_assert(wpi::StructSerializable<frc::MecanumDriveWheelSpeeds>);
+static_assert(wpi::LayoutCompatibleStruct<frc::MecanumDriveWheelSpeeds>);
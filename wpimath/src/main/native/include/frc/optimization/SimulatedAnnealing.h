@@ -4,10 +4,20 @@
 
 #pragma once
 
+#include <stdint.h>
+
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <functional>
 #include <limits>
+#include <optional>
 #include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "units/time.h"
 
 namespace frc {
 
@@ -22,6 +32,13 @@ namespace frc {
  * interior-point method). Simulated annealing is a popular choice for solving
  * the traveling salesman problem (see TravelingSalesman).
  *
+ * Several independent annealing chains can be run in parallel from the same
+ * initial guess, and the best state any of them finds is returned. The neighbor
+ * and cost functions are then called from multiple threads at once, so they
+ * must be thread-safe; neighbor functions that take a random number generator
+ * should draw their random numbers from it, which also makes solves repeatable
+ * with SetSeed().
+ *
  * @see <a
  * href="https://en.wikipedia.org/wiki/Simulated_annealing">https://en.wikipedia.org/wiki/Simulated_annealing</a>
  * @tparam State The type of the state to optimize.
@@ -44,9 +61,51 @@ class SimulatedAnnealing {
                                std::function<State(const State&)> neighbor,
                                std::function<double(const State&)> cost)
       : m_initialTemperature{initialTemperature},
-        m_neighbor{neighbor},
+        m_neighbor{[neighbor = std::move(neighbor)](const State& state,
+                                                    std::mt19937&) {
+          return neighbor(state);
+        }},
         m_cost{cost} {}
 
+  /**
+   * Constructor for Simulated Annealing that can be used for the same functions
+   * but with different initial states.
+   *
+   * @param initialTemperature The initial temperature. Higher temperatures make
+   *     it more likely a worse state will be accepted during iteration, helping
+   *     to avoid local minima. The temperature is decreased over time.
+   * @param neighbor Function that generates a random neighbor of the current
+   *     state using the given random number generator, which belongs to the
+   *     annealing chain calling it.
+   * @param cost Function that returns the scalar cost of a state.
+   */
+  constexpr SimulatedAnnealing(
+      double initialTemperature,
+      std::function<State(const State&, std::mt19937&)> neighbor,
+      std::function<double(const State&)> cost)
+      : m_initialTemperature{initialTemperature},
+        m_neighbor{std::move(neighbor)},
+        m_cost{std::move(cost)} {}
+
+  /**
+   * Sets the number of independent annealing chains to run in parallel. The
+   * best state found by any chain is returned. Defaults to 1.
+   *
+   * @param chains The number of chains.
+   */
+  void SetChains(int chains) { m_chains = std::max(chains, 1); }
+
+  /**
+   * Seeds the random number generators so solves are repeatable. Chain i is
+   * seeded with seed + i. By default, each solve is randomly seeded.
+   *
+   * A time-limited solve is only repeatable if its chains run the same number
+   * of iterations.
+   *
+   * @param seed The seed.
+   */
+  void SetSeed(uint32_t seed) { m_seed = seed; }
+
   /**
    * Runs the Simulated Annealing algorithm.
    *
@@ -55,20 +114,87 @@ class SimulatedAnnealing {
    * @return The optimized state.
    */
   State Solve(const State& initialGuess, int iterations) {
+    return SolveChains(initialGuess, iterations, std::nullopt);
+  }
+
+  /**
+   * Runs the Simulated Annealing algorithm until the time limit passes.
+   *
+   * @param initialGuess The initial state.
+   * @param timeLimit How long to run the solver.
+   * @return The optimized state.
+   */
+  State Solve(const State& initialGuess, units::second_t timeLimit) {
+    return SolveChains(
+        initialGuess, std::numeric_limits<int>::max(),
+        std::chrono::steady_clock::now() +
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>{timeLimit.value()}));
+  }
+
+ private:
+  double m_initialTemperature;
+  std::function<State(const State&, std::mt19937&)> m_neighbor;
+  std::function<double(const State&)> m_cost;
+  int m_chains = 1;
+  std::optional<uint32_t> m_seed;
+
+  State SolveChains(
+      const State& initialGuess, int iterations,
+      std::optional<std::chrono::steady_clock::time_point> deadline) {
+    uint32_t seed = m_seed.value_or(std::random_device{}());
+
+    std::vector<std::pair<State, double>> results(
+        m_chains, {initialGuess, std::numeric_limits<double>::infinity()});
+    auto runChain = [&](int chain) {
+      std::mt19937 gen{seed + static_cast<uint32_t>(chain)};
+      results[chain] = RunChain(initialGuess, iterations, deadline, gen);
+    };
+
+    // The calling thread runs the first chain
+    std::vector<std::thread> threads;
+    threads.reserve(m_chains - 1);
+    for (int chain = 1; chain < m_chains; ++chain) {
+      threads.emplace_back(runChain, chain);
+    }
+    runChain(0);
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    // Ties go to the lowest chain so seeded solves are repeatable
+    size_t best = 0;
+    for (size_t chain = 1; chain < results.size(); ++chain) {
+      if (results[chain].second < results[best].second) {
+        best = chain;
+      }
+    }
+    return std::move(results[best].first);
+  }
+
+  std::pair<State, double> RunChain(
+      const State& initialGuess, int iterations,
+      std::optional<std::chrono::steady_clock::time_point> deadline,
+      std::mt19937& gen) {
     State minState = initialGuess;
     double minCost = std::numeric_limits<double>::infinity();
 
-    std::random_device rd;
-    std::mt19937 gen{rd()};
     std::uniform_real_distribution<> distr{0.0, 1.0};
 
     State state = initialGuess;
     double cost = m_cost(state);
 
     for (int i = 0; i < iterations; ++i) {
+      // Checking the clock is relatively expensive, so only check it
+      // periodically
+      if (deadline && i % 16 == 0 &&
+          std::chrono::steady_clock::now() >= deadline.value()) {
+        break;
+      }
+
       double temperature = m_initialTemperature / i;
 
-      State proposedState = m_neighbor(state);
+      State proposedState = m_neighbor(state, gen);
       double proposedCost = m_cost(proposedState);
       double deltaCost = proposedCost - cost;
 
@@ -89,13 +215,8 @@ class SimulatedAnnealing {
       }
     }
 
-    return minState;
+    return {std::move(minState), minCost};
   }
-
- private:
-  double m_initialTemperature;
-  std::function<State(const State&)> m_neighbor;
-  std::function<double(const State&)> m_cost;
 };
 
 }  // namespace frc
@@ -4,17 +4,22 @@
 
 #pragma once
 
+#include <stdint.h>
+
+#include <algorithm>
 #include <cmath>
 #include <functional>
+#include <optional>
 #include <random>
+#include <span>
 #include <utility>
 #include <vector>
 
 #include <wpi/array.h>
 
-#include "frc/EigenCore.h"
 #include "frc/geometry/Pose2d.h"
 #include "frc/optimization/SimulatedAnnealing.h"
+#include "units/time.h"
 
 namespace frc {
 
@@ -43,6 +48,22 @@ class TravelingSalesman {
   explicit TravelingSalesman(std::function<double(Pose2d, Pose2d)> cost)
       : m_cost{std::move(cost)} {}
 
+  /**
+   * Sets the number of independent annealing chains to run in parallel. The
+   * best path found by any chain is returned. Defaults to 1.
+   *
+   * @param chains The number of chains.
+   */
+  void SetChains(int chains) { m_chains = chains; }
+
+  /**
+   * Seeds the solver's random number generators so solves are repeatable. By
+   * default, each solve is randomly seeded.
+   *
+   * @param seed The seed.
+   */
+  void SetSeed(uint32_t seed) { m_seed = seed; }
+
   /**
    * Finds the path through every pose that minimizes the cost. The first pose
    * in the returned array is the first pose that was passed in.
@@ -58,36 +79,26 @@ class TravelingSalesman {
   template <size_t Poses>
   wpi::array<Pose2d, Poses> Solve(const wpi::array<Pose2d, Poses>& poses,
                                   int iterations) {
-    SimulatedAnnealing<Vectord<Poses>> solver{
-        1, &Neighbor<Poses>, [&](const Vectord<Poses>& state) {
-          // Total cost is sum of all costs between adjacent pairs in path
-          double sum = 0.0;
-          for (int i = 0; i < state.rows(); ++i) {
-            sum +=
-                m_cost(poses[static_cast<int>(state(i))],
-                       poses[static_cast<int>(state((i + 1) % poses.size()))]);
-          }
-          return sum;
-        }};
-
-    Eigen::Vector<double, Poses> initial;
-    for (int i = 0; i < initial.rows(); ++i) {
-      initial(i) = i;
-    }
-
-    auto indices = solver.Solve(initial, iterations);
-
-    wpi::array<Pose2d, Poses> solution{wpi::empty_array};
-    for (size_t i = 0; i < poses.size(); ++i) {
-      solution[i] = poses[static_cast<int>(indices[i])];
-    }
-
-    // Rotate solution list until solution[0] = poses[0]
-    std::rotate(solution.begin(),
-                std::find(solution.begin(), solution.end(), poses[0]),
-                solution.end());
+    return ToArray(poses, SolveIndices(poses, iterations));
+  }
 
-    return solution;
+  /**
+   * Finds the path through every pose that minimizes the cost within a time
+   * limit. The first pose in the returned array is the first pose that was
+   * passed in.
+   *
+   * This overload supports a statically-sized list of poses.
+   *
+   * @tparam Poses The length of the path and the number of poses.
+   * @param poses An array of Pose2ds the path must pass through.
+   * @param timeLimit How long to search for better random neighbors. The local
+   *     search afterward takes a small amount of additional time.
+   * @return The optimized path as an array of Pose2ds.
+   */
+  template <size_t Poses>
+  wpi::array<Pose2d, Poses> Solve(const wpi::array<Pose2d, Poses>& poses,
+                                  units::second_t timeLimit) {
+    return ToArray(poses, SolveIndices(poses, timeLimit));
   }
 
   /**
@@ -102,63 +113,204 @@ class TravelingSalesman {
    * @return The optimized path as an array of Pose2ds.
    */
   std::vector<Pose2d> Solve(std::span<const Pose2d> poses, int iterations) {
-    SimulatedAnnealing<Eigen::VectorXd> solver{
-        1.0, &Neighbor<Eigen::Dynamic>, [&](const Eigen::VectorXd& state) {
-          // Total cost is sum of all costs between adjacent pairs in path
-          double sum = 0.0;
-          for (int i = 0; i < state.rows(); ++i) {
-            sum +=
-                m_cost(poses[static_cast<int>(state(i))],
-                       poses[static_cast<int>(state((i + 1) % poses.size()))]);
-          }
-          return sum;
-        }};
+    return ToVector(poses, SolveIndices(poses, iterations));
+  }
+
+  /**
+   * Finds the path through every pose that minimizes the cost within a time
+   * limit. The first pose in the returned array is the first pose that was
+   * passed in.
+   *
+   * This overload supports a dynamically-sized list of poses for Python to use.
+   *
+   * @param poses An array of Pose2ds the path must pass through.
+   * @param timeLimit How long to search for better random neighbors. The local
+   *     search afterward takes a small amount of additional time.
+   * @return The optimized path as an array of Pose2ds.
+   */
+  std::vector<Pose2d> Solve(std::span<const Pose2d> poses,
+                            units::second_t timeLimit) {
+    return ToVector(poses, SolveIndices(poses, timeLimit));
+  }
+
+ private:
+  // Default cost is distance between poses
+  std::function<double(const Pose2d&, const Pose2d&)> m_cost =
+      [](const Pose2d& a, const Pose2d& b) -> double {
+    return units::math::hypot(a.X() - b.X(), a.Y() - b.Y()).value();
+  };
 
-    Eigen::VectorXd initial{poses.size()};
-    for (int i = 0; i < initial.rows(); ++i) {
-      initial(i) = i;
+  int m_chains = 1;
+  std::optional<uint32_t> m_seed;
+
+  /**
+   * Costs between every pair of poses, precomputed so the solver doesn't call
+   * the cost function in its inner loop.
+   */
+  class CostMatrix {
+   public:
+    CostMatrix(std::span<const Pose2d> poses,
+               const std::function<double(const Pose2d&, const Pose2d&)>& cost)
+        : m_size{poses.size()}, m_costs(m_size * m_size) {
+      for (size_t i = 0; i < m_size; ++i) {
+        for (size_t j = 0; j < m_size; ++j) {
+          m_costs[i * m_size + j] = cost(poses[i], poses[j]);
+        }
+      }
     }
 
-    auto indices = solver.Solve(initial, iterations);
+    double operator()(int from, int to) const {
+      return m_costs[from * m_size + to];
+    }
 
-    std::vector<Pose2d> solution;
-    for (size_t i = 0; i < poses.size(); ++i) {
-      solution.emplace_back(poses[static_cast<int>(indices[i])]);
+    /**
+     * Returns the total cost of the closed path through the given indices.
+     */
+    double PathCost(std::span<const int> path) const {
+      double sum = 0.0;
+      for (size_t i = 0; i < path.size(); ++i) {
+        sum += (*this)(path[i], path[(i + 1) % path.size()]);
+      }
+      return sum;
+    }
+
+   private:
+    size_t m_size;
+    std::vector<double> m_costs;
+  };
+
+  /**
+   * Finds the indices of the path through every pose that minimizes the cost,
+   * starting with index 0.
+   *
+   * @param poses The poses the path must pass through.
+   * @param limit The iteration count or time limit of the annealing.
+   */
+  template <typename Limit>
+  std::vector<int> SolveIndices(std::span<const Pose2d> poses, Limit limit) {
+    if (poses.empty()) {
+      return {};
     }
 
+    CostMatrix costs{poses, m_cost};
+
+    SimulatedAnnealing<std::vector<int>> solver{
+        1.0, &Neighbor,
+        [&](const std::vector<int>& state) { return costs.PathCost(state); }};
+    solver.SetChains(m_chains);
+    if (m_seed) {
+      solver.SetSeed(m_seed.value());
+    }
+
+    std::vector<int> initial(poses.size());
+    for (size_t i = 0; i < initial.size(); ++i) {
+      initial[i] = i;
+    }
+
+    auto indices = solver.Solve(initial, limit);
+    LocalSearch(costs, indices);
+
     // Rotate solution list until solution[0] = poses[0]
-    std::rotate(solution.begin(),
-                std::find(solution.begin(), solution.end(), poses[0]),
-                solution.end());
+    std::rotate(indices.begin(), std::find(indices.begin(), indices.end(), 0),
+                indices.end());
 
+    return indices;
+  }
+
+  /**
+   * Improves a path with 2-opt (reversing a range) and Or-opt (moving a range
+   * of up to three poses elsewhere) moves until neither finds an improvement.
+   *
+   * Moves are compared by total path cost rather than by the costs of the
+   * edges they change, so asymmetric cost functions are handled correctly.
+   *
+   * @param costs The costs between poses.
+   * @param path The path to improve.
+   */
+  static void LocalSearch(const CostMatrix& costs, std::vector<int>& path) {
+    const int size = path.size();
+    double cost = costs.PathCost(path);
+    std::vector<int> candidate;
+
+    bool improved = true;
+    while (improved) {
+      improved = false;
+
+      // 2-opt
+      for (int start = 0; start < size - 1; ++start) {
+        for (int end = start + 1; end < size; ++end) {
+          candidate = path;
+          std::reverse(candidate.begin() + start, candidate.begin() + end + 1);
+          double candidateCost = costs.PathCost(candidate);
+          if (candidateCost < cost - 1e-9) {
+            path.swap(candidate);
+            cost = candidateCost;
+            improved = true;
+          }
+        }
+      }
+
+      // Or-opt
+      for (int length = 1; length <= std::min(3, size - 2); ++length) {
+        for (int start = 0; start + length <= size; ++start) {
+          for (int dest = 0; dest + length <= size; ++dest) {
+            if (dest == start) {
+              continue;
+            }
+            candidate = path;
+            std::vector<int> range(candidate.begin() + start,
+                                   candidate.begin() + start + length);
+            candidate.erase(candidate.begin() + start,
+                            candidate.begin() + start + length);
+            candidate.insert(candidate.begin() + dest, range.begin(),
+                             range.end());
+            double candidateCost = costs.PathCost(candidate);
+            if (candidateCost < cost - 1e-9) {
+              path.swap(candidate);
+              cost = candidateCost;
+              improved = true;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  template <size_t Poses>
+  static wpi::array<Pose2d, Poses> ToArray(
+      const wpi::array<Pose2d, Poses>& poses, std::span<const int> indices) {
+    wpi::array<Pose2d, Poses> solution{wpi::empty_array};
+    for (size_t i = 0; i < poses.size(); ++i) {
+      solution[i] = poses[indices[i]];
+    }
     return solution;
   }
 
- private:
-  // Default cost is distance between poses
-  std::function<double(const Pose2d&, const Pose2d&)> m_cost =
-      [](const Pose2d& a, const Pose2d& b) -> double {
-    return units::math::hypot(a.X() - b.X(), a.Y() - b.Y()).value();
-  };
+  static std::vector<Pose2d> ToVector(std::span<const Pose2d> poses,
+                                      std::span<const int> indices) {
+    std::vector<Pose2d> solution;
+    solution.reserve(poses.size());
+    for (int index : indices) {
+      solution.emplace_back(poses[index]);
+    }
+    return solution;
+  }
 
   /**
    * A random neighbor is generated to try to replace the current one.
    *
-   * @tparam Poses The length of the path and the number of poses.
-   * @param state A vector that is a list of indices that defines the path
-   *     through the path array.
+   * @param state A list of indices that defines the path through the path
+   *     array.
+   * @param gen The random number generator.
    * @return Generates a random neighbor of the current state by flipping a
    *     random range in the path array.
    */
-  template <int Poses>
-  static Eigen::Vector<double, Poses> Neighbor(
-      const Eigen::Vector<double, Poses>& state) {
-    Eigen::Vector<double, Poses> proposedState = state;
+  static std::vector<int> Neighbor(const std::vector<int>& state,
+                                   std::mt19937& gen) {
+    std::vector<int> proposedState = state;
 
-    std::random_device rd;
-    std::mt19937 gen{rd()};
     std::uniform_int_distribution<> distr{0,
-                                          static_cast<int>(state.rows()) - 1};
+                                          static_cast<int>(state.size()) - 1};
 
     int rangeStart = distr(gen);
     int rangeEnd = distr(gen);
@@ -166,11 +318,8 @@ class TravelingSalesman {
       std::swap(rangeStart, rangeEnd);
     }
 
-    for (int i = rangeStart; i <= (rangeStart + rangeEnd) / 2; ++i) {
-      double temp = proposedState(i, 0);
-      proposedState(i, 0) = state(rangeEnd - (i - rangeStart), 0);
-      proposedState(rangeEnd - (i - rangeStart), 0) = temp;
-    }
+    std::reverse(proposedState.begin() + rangeStart,
+                 proposedState.begin() + rangeEnd + 1);
 
     return proposedState;
   }
@@ -62,24 +62,28 @@ class Spline {
   std::optional<PoseWithCurvature> GetPoint(double t) const {
     Vectord<Degree + 1> polynomialBases;
 
-    // Populate the polynomial bases
-    for (int i = 0; i <= Degree; i++) {
-      polynomialBases(i) = gcem::pow(t, Degree - i);
+    // Populate the polynomial bases (t^Degree, ..., t, 1)
+    polynomialBases(Degree) = 1.0;
+    for (int i = Degree - 1; i >= 0; i--) {
+      polynomialBases(i) = polynomialBases(i + 1) * t;
     }
 
+    // Coefficients() is virtual and returns by value, so only call it once
+    const Matrixd<6, Degree + 1> coefficients = Coefficients();
+
     // This simply multiplies by the coefficients. We need to divide out t some
     // n number of times where n is the derivative we want to take.
-    Vectord<6> combined = Coefficients() * polynomialBases;
+    Vectord<6> combined = coefficients * polynomialBases;
 
     double dx, dy, ddx, ddy;
 
     // If t = 0, all other terms in the equation cancel out to zero. We can use
     // the last x^0 term in the equation.
     if (t == 0.0) {
-      dx = Coefficients()(2, Degree - 1);
-      dy = Coefficients()(3, Degree - 1);
-      ddx = Coefficients()(4, Degree - 2);
-      ddy = Coefficients()(5, Degree - 2);
+      dx = coefficients(2, Degree - 1);
+      dy = coefficients(3, Degree - 1);
+      ddx = coefficients(4, Degree - 2);
+      ddy = coefficients(5, Degree - 2);
     } else {
       // Divide out t for first derivative.
       dx = combined(2) / t;
@@ -28,7 +28,6 @@
 
 #pragma once
 
-#include <stack>
 #include <string>
 #include <utility>
 #include <vector>
@@ -78,43 +77,43 @@ class WPILIB_DLLEXPORT SplineParameterizer {
         "together with headings in opposing directions.";
     std::vector<PoseWithCurvature> splinePoints;
 
-    // The parameterization does not add the initial point. Let's add that.
-    if (auto point = spline.GetPoint(t0)) {
-      splinePoints.push_back(point.value());
-    } else {
+    auto getPoint = [&](double t) {
+      if (auto point = spline.GetPoint(t)) {
+        return point.value();
+      }
       throw MalformedSplineException(kMalformedSplineExceptionMsg);
-    }
+    };
+
+    // The parameterization does not add the initial point. Let's add that.
+    splinePoints.push_back(getPoint(t0));
 
     // We use an "explicit stack" to simulate recursion, instead of a recursive
-    // function call This give us greater control, instead of a stack overflow
-    std::stack<StackContents> stack;
-    stack.emplace(StackContents{t0, t1});
+    // function call This give us greater control, instead of a stack overflow.
+    // Each entry carries its already evaluated endpoints, so subdividing an
+    // arc only evaluates the spline at the new midpoint.
+    std::vector<StackContents> stack;
+    stack.emplace_back(
+        StackContents{t0, t1, splinePoints.front(), getPoint(t1)});
 
     int iterations = 0;
 
     while (!stack.empty()) {
-      auto current = stack.top();
-      stack.pop();
-
-      auto start = spline.GetPoint(current.t0);
-      if (!start) {
-        throw MalformedSplineException(kMalformedSplineExceptionMsg);
-      }
-
-      auto end = spline.GetPoint(current.t1);
-      if (!end) {
-        throw MalformedSplineException(kMalformedSplineExceptionMsg);
-      }
+      auto current = std::move(stack.back());
+      stack.pop_back();
 
-      const auto twist = start.value().first.Log(end.value().first);
+      const auto twist = current.start.first.Log(current.end.first);
 
       if (units::math::abs(twist.dy) > kMaxDy ||
           units::math::abs(twist.dx) > kMaxDx ||
           units::math::abs(twist.dtheta) > kMaxDtheta) {
-        stack.emplace(StackContents{(current.t0 + current.t1) / 2, current.t1});
-        stack.emplace(StackContents{current.t0, (current.t0 + current.t1) / 2});
+        double mid = (current.t0 + current.t1) / 2;
+        auto midPoint = getPoint(mid);
+        stack.emplace_back(
+            StackContents{mid, current.t1, midPoint, current.end});
+        stack.emplace_back(
+            StackContents{current.t0, mid, current.start, midPoint});
       } else {
-        splinePoints.push_back(end.value());
+        splinePoints.push_back(current.end);
       }
 
       if (iterations++ >= kMaxIterations) {
@@ -134,6 +133,8 @@ class WPILIB_DLLEXPORT SplineParameterizer {
   struct StackContents {
     double t0;
     double t1;
+    PoseWithCurvature start;
+    PoseWithCurvature end;
   };
 
   /**
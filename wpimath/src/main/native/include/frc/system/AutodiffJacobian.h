@@ -0,0 +1,445 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <cmath>
+#include <compare>
+#include <concepts>
+#include <type_traits>
+
+#include "frc/EigenCore.h"
+
+namespace frc {
+
+/**
+ * Dual number for forward-mode automatic differentiation. It holds a value
+ * and its gradient with respect to N variables, so evaluating a function with
+ * dual number arguments computes the function and all its partial derivatives
+ * in one pass.
+ *
+ * Functions templated on the scalar type (e.g. taking Eigen::Matrix<T, 3, 1>)
+ * can be evaluated with dual numbers. Math functions must be called
+ * unqualified after a using-declaration (e.g. "using std::cos; cos(x(2))") so
+ * the dual number overloads are found.
+ *
+ * @tparam N Number of variables.
+ */
+template <int N>
+struct Dual {
+  /// The value.
+  double value = 0.0;
+
+  /// The partial derivatives of the value with respect to each variable.
+  Vectord<N> grad = Vectord<N>::Zero();
+
+  Dual() = default;
+
+  /**
+   * Constructs a constant.
+   *
+   * @param value The value.
+   */
+  Dual(double value) : value{value} {}  // NOLINT
+
+  /**
+   * Constructs a dual number.
+   *
+   * @param value The value.
+   * @param grad The partial derivatives.
+   */
+  Dual(double value, const Vectord<N>& grad) : value{value}, grad{grad} {}
+
+  /**
+   * Constructs the variable with the given index.
+   *
+   * @param value The value of the variable.
+   * @param index The index of the variable.
+   */
+  static Dual Variable(double value, int index) {
+    Dual result{value};
+    result.grad(index) = 1.0;
+    return result;
+  }
+
+  Dual& operator+=(const Dual& rhs) {
+    value += rhs.value;
+    grad += rhs.grad;
+    return *this;
+  }
+
+  Dual& operator-=(const Dual& rhs) {
+    value -= rhs.value;
+    grad -= rhs.grad;
+    return *this;
+  }
+
+  Dual& operator*=(const Dual& rhs) {
+    grad = grad * rhs.value + value * rhs.grad;
+    value *= rhs.value;
+    return *this;
+  }
+
+  Dual& operator/=(const Dual& rhs) {
+    grad = (grad - value / rhs.value * rhs.grad) / rhs.value;
+    value /= rhs.value;
+    return *this;
+  }
+
+  Dual& operator+=(double rhs) {
+    value += rhs;
+    return *this;
+  }
+
+  Dual& operator-=(double rhs) {
+    value -= rhs;
+    return *this;
+  }
+
+  Dual& operator*=(double rhs) {
+    value *= rhs;
+    grad *= rhs;
+    return *this;
+  }
+
+  Dual& operator/=(double rhs) {
+    value /= rhs;
+    grad /= rhs;
+    return *this;
+  }
+};
+
+template <int N>
+Dual<N> operator+(const Dual<N>& x) {
+  return x;
+}
+
+template <int N>
+Dual<N> operator-(const Dual<N>& x) {
+  return {-x.value, -x.grad};
+}
+
+template <int N>
+Dual<N> operator+(Dual<N> lhs, const Dual<N>& rhs) {
+  return lhs += rhs;
+}
+
+template <int N>
+Dual<N> operator+(Dual<N> lhs, double rhs) {
+  return lhs += rhs;
+}
+
+template <int N>
+Dual<N> operator+(double lhs, Dual<N> rhs) {
+  return rhs += lhs;
+}
+
+template <int N>
+Dual<N> operator-(Dual<N> lhs, const Dual<N>& rhs) {
+  return lhs -= rhs;
+}
+
+template <int N>
+Dual<N> operator-(Dual<N> lhs, double rhs) {
+  return lhs -= rhs;
+}
+
+template <int N>
+Dual<N> operator-(double lhs, const Dual<N>& rhs) {
+  return {lhs - rhs.value, -rhs.grad};
+}
+
+template <int N>
+Dual<N> operator*(Dual<N> lhs, const Dual<N>& rhs) {
+  return lhs *= rhs;
+}
+
+template <int N>
+Dual<N> operator*(Dual<N> lhs, double rhs) {
+  return lhs *= rhs;
+}
+
+template <int N>
+Dual<N> operator*(double lhs, Dual<N> rhs) {
+  return rhs *= lhs;
+}
+
+template <int N>
+Dual<N> operator/(Dual<N> lhs, const Dual<N>& rhs) {
+  return lhs /= rhs;
+}
+
+template <int N>
+Dual<N> operator/(Dual<N> lhs, double rhs) {
+  return lhs /= rhs;
+}
+
+template <int N>
+Dual<N> operator/(double lhs, const Dual<N>& rhs) {
+  double value = lhs / rhs.value;
+  return {value, -value / rhs.value * rhs.grad};
+}
+
+// Comparisons only compare the values
+template <int N>
+bool operator==(const Dual<N>& lhs, const Dual<N>& rhs) {
+  return lhs.value == rhs.value;
+}
+
+template <int N>
+bool operator==(const Dual<N>& lhs, double rhs) {
+  return lhs.value == rhs;
+}
+
+template <int N>
+auto operator<=>(const Dual<N>& lhs, const Dual<N>& rhs) {
+  return lhs.value <=> rhs.value;
+}
+
+template <int N>
+auto operator<=>(const Dual<N>& lhs, double rhs) {
+  return lhs.value <=> rhs;
+}
+
+// Each function returns f(x) with gradient f'(x) * x.grad
+
+template <int N>
+Dual<N> abs(const Dual<N>& x) {
+  return x.value < 0.0 ? -x : x;
+}
+
+template <int N>
+Dual<N> sqrt(const Dual<N>& x) {
+  double value = std::sqrt(x.value);
+  return {value, x.grad / (2.0 * value)};
+}
+
+template <int N>
+Dual<N> exp(const Dual<N>& x) {
+  double value = std::exp(x.value);
+  return {value, value * x.grad};
+}
+
+template <int N>
+Dual<N> log(const Dual<N>& x) {
+  return {std::log(x.value), x.grad / x.value};
+}
+
+template <int N>
+Dual<N> pow(const Dual<N>& base, double power) {
+  double value = std::pow(base.value, power);
+  return {value, power * std::pow(base.value, power - 1.0) * base.grad};
+}
+
+template <int N>
+Dual<N> pow(const Dual<N>& base, const Dual<N>& power) {
+  // d/dx bᵖ = bᵖ(p' ln(b) + p b'/b)
+  double value = std::pow(base.value, power.value);
+  return {value,
+          value * (power.grad * std::log(base.value) +
+                   power.value / base.value * base.grad)};
+}
+
+template <int N>
+Dual<N> sin(const Dual<N>& x) {
+  return {std::sin(x.value), std::cos(x.value) * x.grad};
+}
+
+template <int N>
+Dual<N> cos(const Dual<N>& x) {
+  return {std::cos(x.value), -std::sin(x.value) * x.grad};
+}
+
+template <int N>
+Dual<N> tan(const Dual<N>& x) {
+  double value = std::tan(x.value);
+  return {value, (1.0 + value * value) * x.grad};
+}
+
+template <int N>
+Dual<N> asin(const Dual<N>& x) {
+  return {std::asin(x.value), x.grad / std::sqrt(1.0 - x.value * x.value)};
+}
+
+template <int N>
+Dual<N> acos(const Dual<N>& x) {
+  return {std::acos(x.value), -x.grad / std::sqrt(1.0 - x.value * x.value)};
+}
+
+template <int N>
+Dual<N> atan(const Dual<N>& x) {
+  return {std::atan(x.value), x.grad / (1.0 + x.value * x.value)};
+}
+
+template <int N>
+Dual<N> atan2(const Dual<N>& y, const Dual<N>& x) {
+  double denom = x.value * x.value + y.value * y.value;
+  return {std::atan2(y.value, x.value),
+          (x.value * y.grad - y.value * x.grad) / denom};
+}
+
+template <int N>
+Dual<N> hypot(const Dual<N>& x, const Dual<N>& y) {
+  double value = std::hypot(x.value, y.value);
+  return {value, (x.value * x.grad + y.value * y.grad) / value};
+}
+
+template <int N>
+Dual<N> sinh(const Dual<N>& x) {
+  return {std::sinh(x.value), std::cosh(x.value) * x.grad};
+}
+
+template <int N>
+Dual<N> cosh(const Dual<N>& x) {
+  return {std::cosh(x.value), std::sinh(x.value) * x.grad};
+}
+
+template <int N>
+Dual<N> tanh(const Dual<N>& x) {
+  double value = std::tanh(x.value);
+  return {value, (1.0 - value * value) * x.grad};
+}
+
+/**
+ * Returns the Jacobian with respect to x for f(x), computed with forward-mode
+ * automatic differentiation.
+ *
+ * Unlike NumericalJacobian(), f is only evaluated once and the result is exact
+ * (to within floating point error).
+ *
+ * @tparam Rows Number of rows in result of f(x).
+ * @tparam Cols Number of rows in x.
+ * @param f     Vector-valued function from which to compute Jacobian. It must
+ *              accept an Eigen::Matrix<Dual<Cols>, Cols, 1>.
+ * @param x     Vector argument.
+ */
+template <int Rows, int Cols, typename F>
+Matrixd<Rows, Cols> AutodiffJacobian(F&& f, const Vectord<Cols>& x) {
+  Eigen::Matrix<Dual<Cols>, Cols, 1> xAD;
+  for (int i = 0; i < Cols; ++i) {
+    xAD(i) = Dual<Cols>::Variable(x(i), i);
+  }
+
+  Eigen::Matrix<Dual<Cols>, Rows, 1> y = f(xAD);
+
+  Matrixd<Rows, Cols> result;
+  for (int row = 0; row < Rows; ++row) {
+    result.row(row) = y(row).grad.transpose();
+  }
+  return result;
+}
+
+/**
+ * Returns the Jacobian with respect to x for f(x, u, ...), computed with
+ * forward-mode automatic differentiation.
+ *
+ * @tparam Rows    Number of rows in result of f(x, u, ...).
+ * @tparam States  Number of rows in x.
+ * @tparam Inputs  Number of rows in u.
+ * @tparam F       Function object type.
+ * @tparam Args... Types of remaining arguments to f(x, u, ...).
+ * @param f        Vector-valued function from which to compute Jacobian. It
+ *                 must accept Eigen::Matrix<Dual<States>, ...> for x and u.
+ * @param x        State vector.
+ * @param u        Input vector.
+ * @param args     Remaining arguments to f(x, u, ...).
+ */
+template <int Rows, int States, int Inputs, typename F, typename... Args>
+Matrixd<Rows, States> AutodiffJacobianX(F&& f, const Vectord<States>& x,
+                                        const Vectord<Inputs>& u,
+                                        Args&&... args) {
+  Eigen::Matrix<Dual<States>, Inputs, 1> uAD = u.template cast<Dual<States>>();
+  return AutodiffJacobian<Rows, States>(
+      [&](const Eigen::Matrix<Dual<States>, States, 1>& x) {
+        return f(x, uAD, args...);
+      },
+      x);
+}
+
+/**
+ * Returns the Jacobian with respect to u for f(x, u, ...), computed with
+ * forward-mode automatic differentiation.
+ *
+ * @tparam Rows    Number of rows in result of f(x, u, ...).
+ * @tparam States  Number of rows in x.
+ * @tparam Inputs  Number of rows in u.
+ * @tparam F       Function object type.
+ * @tparam Args... Types of remaining arguments to f(x, u, ...).
+ * @param f        Vector-valued function from which to compute Jacobian. It
+ *                 must accept Eigen::Matrix<Dual<Inputs>, ...> for x and u.
+ * @param x        State vector.
+ * @param u        Input vector.
+ * @param args     Remaining arguments to f(x, u, ...).
+ */
+template <int Rows, int States, int Inputs, typename F, typename... Args>
+Matrixd<Rows, Inputs> AutodiffJacobianU(F&& f, const Vectord<States>& x,
+                                        const Vectord<Inputs>& u,
+                                        Args&&... args) {
+  Eigen::Matrix<Dual<Inputs>, States, 1> xAD = x.template cast<Dual<Inputs>>();
+  return AutodiffJacobian<Rows, Inputs>(
+      [&](const Eigen::Matrix<Dual<Inputs>, Inputs, 1>& u) {
+        return f(xAD, u, args...);
+      },
+      u);
+}
+
+/**
+ * Concept for models that can be differentiated by AutodiffJacobianX(), i.e.
+ * function objects of x and u templated on the scalar type, which return a
+ * vector of dual numbers when called with dual number vectors.
+ */
+template <typename F, int States, int Inputs>
+concept AutodiffModel =
+    std::invocable<F, const Eigen::Matrix<Dual<States>, States, 1>&,
+                   const Eigen::Matrix<Dual<States>, Inputs, 1>&> &&
+    std::same_as<typename std::remove_cvref_t<std::invoke_result_t<
+                     F, const Eigen::Matrix<Dual<States>, States, 1>&,
+                     const Eigen::Matrix<Dual<States>, Inputs, 1>&>>::Scalar,
+                 Dual<States>>;
+
+}  // namespace frc
+
+namespace Eigen {
+
+template <int N>
+struct NumTraits<frc::Dual<N>> : GenericNumTraits<frc::Dual<N>> {
+  using Real = frc::Dual<N>;
+  using NonInteger = frc::Dual<N>;
+  using Nested = frc::Dual<N>;
+  using Literal = double;
+
+  enum {
+    IsComplex = 0,
+    IsInteger = 0,
+    IsSigned = 1,
+    RequireInitialization = 1,
+    ReadCost = 1,
+    AddCost = 1 + N,
+    MulCost = 1 + 2 * N
+  };
+
+  static inline double epsilon() { return NumTraits<double>::epsilon(); }
+  static inline double dummy_precision() {
+    return NumTraits<double>::dummy_precision();
+  }
+  static inline int digits10() { return NumTraits<double>::digits10(); }
+  static inline frc::Dual<N> highest() {
+    return NumTraits<double>::highest();
+  }
+  static inline frc::Dual<N> lowest() { return NumTraits<double>::lowest(); }
+};
+
+// Allow mixing dual number and double matrices (e.g. A * x, where A is a
+// matrix of doubles)
+template <int N, typename BinaryOp>
+struct ScalarBinaryOpTraits<frc::Dual<N>, double, BinaryOp> {
+  using ReturnType = frc::Dual<N>;
+};
+
+template <int N, typename BinaryOp>
+struct ScalarBinaryOpTraits<double, frc::Dual<N>, BinaryOp> {
+  using ReturnType = frc::Dual<N>;
+};
+
+}  // namespace Eigen
@@ -0,0 +1,72 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stddef.h>
+
+#include <array>
+
+#include "units/time.h"
+
+namespace frc {
+
+/**
+ * A small cache of discretized matrices keyed by timestep.
+ *
+ * Discretization computes a matrix exponential, which is expensive compared
+ * to the rest of a state-space update. Control loops almost always run with
+ * the same timestep (or one of a few timesteps if the measured loop period
+ * jitters), so the last few results are kept and reused when the timestep
+ * matches exactly. When all entries are in use, the oldest one is replaced.
+ *
+ * @tparam T The type holding the discretized matrices.
+ * @tparam N The number of timesteps to cache.
+ */
+template <typename T, size_t N = 4>
+class DiscretizationCache {
+ public:
+  /**
+   * Returns the cached value for the timestep, computing it if it isn't
+   * cached.
+   *
+   * @param dt The timestep.
+   * @param compute Callable taking a T* to store the discretized matrices
+   *                into for the timestep.
+   * @return The discretized matrices for the timestep.
+   */
+  template <typename F>
+  const T& Get(units::second_t dt, F&& compute) {
+    for (size_t i = 0; i < m_size; ++i) {
+      if (m_dts[i] == dt) {
+        return m_values[i];
+      }
+    }
+
+    size_t i = m_next;
+    m_next = (m_next + 1) % N;
+    if (m_size < N) {
+      ++m_size;
+    }
+    m_dts[i] = dt;
+    compute(&m_values[i]);
+    return m_values[i];
+  }
+
+  /**
+   * Removes all cached values.
+   */
+  void Clear() {
+    m_size = 0;
+    m_next = 0;
+  }
+
+ private:
+  std::array<units::second_t, N> m_dts{};
+  std::array<T, N> m_values{};
+  size_t m_size = 0;
+  size_t m_next = 0;
+};
+
+}  // namespace frc
@@ -15,6 +15,7 @@
 
 #include "frc/EigenCore.h"
 #include "frc/system/Discretization.h"
+#include "frc/system/DiscretizationCache.h"
 #include "units/time.h"
 
 namespace frc {
@@ -98,6 +99,22 @@ class LinearSystem {
   constexpr LinearSystem(LinearSystem&&) = default;
   constexpr LinearSystem& operator=(LinearSystem&&) = default;
 
+  /**
+   * Discretized system and input matrices.
+   */
+  struct DiscreteAB {
+    /// Discretized system matrix.
+    Matrixd<States, States> A;
+
+    /// Discretized input matrix.
+    Matrixd<States, Inputs> B;
+  };
+
+  /**
+   * Cache of discretized system and input matrices for CalculateX().
+   */
+  using DiscreteABCache = DiscretizationCache<DiscreteAB>;
+
   /**
    * Returns the system matrix A.
    */
@@ -169,6 +186,28 @@ class LinearSystem {
     return discA * x + discB * clampedU;
   }
 
+  /**
+   * Computes the new x given the old x and the control input, reusing the
+   * discretized A and B matrices from the cache if it has them for dt.
+   *
+   * This avoids recomputing the discretization (a matrix exponential) on
+   * every update when the timestep doesn't change. The cache must only be
+   * used with this system.
+   *
+   * @param x        The current state.
+   * @param clampedU The control input.
+   * @param dt       Timestep for model update.
+   * @param cache    Cache of discretized matrices for this system.
+   */
+  StateVector CalculateX(const StateVector& x, const InputVector& clampedU,
+                         units::second_t dt, DiscreteABCache& cache) const {
+    const auto& disc = cache.Get(dt, [&](DiscreteAB* ab) {
+      DiscretizeAB<States, Inputs>(m_A, m_B, dt, &ab->A, &ab->B);
+    });
+
+    return disc.A * x + disc.B * clampedU;
+  }
+
   /**
    * Computes the new y given the control input.
    *
@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <utility>
 
 #include "units/time.h"
 
@@ -74,6 +75,11 @@ T RK4(F&& f, units::second_t t, T y, units::second_t dt) {
 /**
  * Performs adaptive Dormand-Prince integration of dx/dt = f(x, u) for dt.
  *
+ * The integrator starts from the given step size and returns the step size it
+ * would take next, so calling it repeatedly with the same step size variable
+ * (e.g., once per simulation update) avoids rediscovering the step size and
+ * the rejected steps that come with it.
+ *
  * @param f        The function to integrate. It must take two arguments x and
  *                 u.
  * @param x        The initial value of x.
@@ -81,9 +87,12 @@ T RK4(F&& f, units::second_t t, T y, units::second_t dt) {
  * @param dt       The time over which to integrate.
  * @param maxError The maximum acceptable truncation error. Usually a small
  *                 number like 1e-6.
+ * @param stepSize The initial step size, and output location for the next
+ *                 step size. A nonpositive value means dt.
  */
 template <typename F, typename T, typename U>
-T RKDP(F&& f, T x, U u, units::second_t dt, double maxError = 1e-6) {
+T RKDP(F&& f, T x, U u, units::second_t dt, double maxError,
+       units::second_t* stepSize) {
   // See https://en.wikipedia.org/wiki/Dormand%E2%80%93Prince_method for the
   // Butcher tableau the following arrays came from.
 
@@ -111,49 +120,86 @@ T RKDP(F&& f, T x, U u, units::second_t dt, double maxError = 1e-6) {
   double truncationError;
 
   double dtElapsed = 0.0;
-  double h = dt.value();
+  double h = stepSize->value() > 0.0 ? stepSize->value() : dt.value();
+
+  // The last stage of an accepted step is evaluated at the new x, so it's the
+  // first stage of the next step (the "first same as last" property)
+  T k1 = f(x, u);
 
   // Loop until we've gotten to our desired dt
   while (dtElapsed < dt.value()) {
+    double hStep;
     do {
       // Only allow us to advance up to the dt remaining
-      h = (std::min)(h, dt.value() - dtElapsed);
+      hStep = (std::min)(h, dt.value() - dtElapsed);
 
       // clang-format off
-      T k1 = f(x, u);
-      T k2 = f(x + h * (A[0][0] * k1), u);
-      T k3 = f(x + h * (A[1][0] * k1 + A[1][1] * k2), u);
-      T k4 = f(x + h * (A[2][0] * k1 + A[2][1] * k2 + A[2][2] * k3), u);
-      T k5 = f(x + h * (A[3][0] * k1 + A[3][1] * k2 + A[3][2] * k3 + A[3][3] * k4), u);
-      T k6 = f(x + h * (A[4][0] * k1 + A[4][1] * k2 + A[4][2] * k3 + A[4][3] * k4 + A[4][4] * k5), u);
+      T k2 = f(x + hStep * (A[0][0] * k1), u);
+      T k3 = f(x + hStep * (A[1][0] * k1 + A[1][1] * k2), u);
+      T k4 = f(x + hStep * (A[2][0] * k1 + A[2][1] * k2 + A[2][2] * k3), u);
+      T k5 = f(x + hStep * (A[3][0] * k1 + A[3][1] * k2 + A[3][2] * k3 + A[3][3] * k4), u);
+      T k6 = f(x + hStep * (A[4][0] * k1 + A[4][1] * k2 + A[4][2] * k3 + A[4][3] * k4 + A[4][4] * k5), u);
       // clang-format on
 
       // Since the final row of A and the array b1 have the same coefficients
       // and k7 has no effect on newX, we can reuse the calculation.
-      newX = x + h * (A[5][0] * k1 + A[5][1] * k2 + A[5][2] * k3 +
-                      A[5][3] * k4 + A[5][4] * k5 + A[5][5] * k6);
+      newX = x + hStep * (A[5][0] * k1 + A[5][1] * k2 + A[5][2] * k3 +
+                          A[5][3] * k4 + A[5][4] * k5 + A[5][5] * k6);
       T k7 = f(newX, u);
 
-      truncationError = (h * ((b1[0] - b2[0]) * k1 + (b1[1] - b2[1]) * k2 +
-                              (b1[2] - b2[2]) * k3 + (b1[3] - b2[3]) * k4 +
-                              (b1[4] - b2[4]) * k5 + (b1[5] - b2[5]) * k6 +
-                              (b1[6] - b2[6]) * k7))
-                            .norm();
+      truncationError =
+          (hStep * ((b1[0] - b2[0]) * k1 + (b1[1] - b2[1]) * k2 +
+                    (b1[2] - b2[2]) * k3 + (b1[3] - b2[3]) * k4 +
+                    (b1[4] - b2[4]) * k5 + (b1[5] - b2[5]) * k6 +
+                    (b1[6] - b2[6]) * k7))
+              .norm();
 
       if (truncationError == 0.0) {
-        h = dt.value() - dtElapsed;
+        h = (std::max)(h, dt.value());
       } else {
-        h *= 0.9 * std::pow(maxError / truncationError, 1.0 / 5.0);
+        double newH =
+            0.9 * hStep * std::pow(maxError / truncationError, 1.0 / 5.0);
+
+        // A step shortened to end at dt doesn't say a longer step would have
+        // been accepted, so it can only shrink the next step
+        if (hStep < h && truncationError <= maxError) {
+          h = (std::min)(h, newH);
+        } else {
+          h = newH;
+        }
+      }
+
+      if (truncationError <= maxError) {
+        k1 = k7;
       }
     } while (truncationError > maxError);
 
-    dtElapsed += h;
+    dtElapsed += hStep;
     x = newX;
   }
 
+  *stepSize = units::second_t{h};
   return x;
 }
 
+/**
+ * Performs adaptive Dormand-Prince integration of dx/dt = f(x, u) for dt.
+ *
+ * @param f        The function to integrate. It must take two arguments x and
+ *                 u.
+ * @param x        The initial value of x.
+ * @param u        The value u held constant over the integration period.
+ * @param dt       The time over which to integrate.
+ * @param maxError The maximum acceptable truncation error. Usually a small
+ *                 number like 1e-6.
+ */
+template <typename F, typename T, typename U>
+T RKDP(F&& f, T x, U u, units::second_t dt, double maxError = 1e-6) {
+  units::second_t stepSize = dt;
+  return RKDP(std::forward<F>(f), std::move(x), std::move(u), dt, maxError,
+              &stepSize);
+}
+
 /**
  * Performs adaptive Dormand-Prince integration of dy/dt = f(t, y) for dt.
  *
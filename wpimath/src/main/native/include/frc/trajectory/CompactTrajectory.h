@@ -0,0 +1,109 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stddef.h>
+
+#include <vector>
+
+#include <wpi/SymbolExports.h>
+
+#include "frc/trajectory/Trajectory.h"
+#include "units/time.h"
+
+namespace frc {
+
+/**
+ * A trajectory stored in a compact form, for keeping many pre-generated
+ * trajectories in memory.
+ *
+ * Each state is stored as single precision floats in separate arrays (time,
+ * velocity, acceleration, x, y, heading cosine and sine, and curvature), which
+ * takes half the memory of a Trajectory::State and keeps the timestamps
+ * contiguous for searching. Single precision keeps about 7 significant
+ * digits, e.g. positions within a micrometer on a 16 meter field.
+ *
+ * Samples are the same as sampling the Trajectory the compact trajectory was
+ * constructed from, to within single precision.
+ */
+class WPILIB_DLLEXPORT CompactTrajectory {
+ public:
+  CompactTrajectory() = default;
+
+  /**
+   * Constructs a compact trajectory from a trajectory.
+   *
+   * @param trajectory The trajectory.
+   */
+  explicit CompactTrajectory(const Trajectory& trajectory);
+
+  /**
+   * Returns the overall duration of the trajectory.
+   *
+   * @return The duration of the trajectory.
+   */
+  units::second_t TotalTime() const {
+    return units::second_t{m_t.empty() ? 0.0 : m_t.back()};
+  }
+
+  /**
+   * Returns the number of states in the trajectory.
+   *
+   * @return The number of states.
+   */
+  size_t Size() const { return m_t.size(); }
+
+  /**
+   * Returns a state of the trajectory.
+   *
+   * @param index The index of the state; must be less than Size().
+   * @return The state.
+   */
+  Trajectory::State GetState(size_t index) const;
+
+  /**
+   * Converts back to a trajectory.
+   *
+   * @return The trajectory.
+   */
+  Trajectory ToTrajectory() const;
+
+  /**
+   * Sample the trajectory at a point in time.
+   *
+   * @param t The point in time since the beginning of the trajectory to sample.
+   * @return The state at that point in time.
+   * @throws std::runtime_error if the trajectory has no states.
+   */
+  Trajectory::State Sample(units::second_t t) const {
+    size_t cursor = 0;
+    return Sample(t, cursor);
+  }
+
+  /**
+   * Sample the trajectory at a point in time, starting the search from the
+   * state found by the previous call. See Trajectory::Sample(units::second_t,
+   * size_t&).
+   *
+   * @param t The point in time since the beginning of the trajectory to sample.
+   * @param[in,out] cursor The search position. Initialize to 0, and pass the
+   *                       same variable to every call for this trajectory.
+   * @return The state at that point in time.
+   * @throws std::runtime_error if the trajectory has no states.
+   */
+  Trajectory::State Sample(units::second_t t, size_t& cursor) const;
+
+ private:
+  std::vector<float> m_t;
+  std::vector<float> m_velocity;
+  std::vector<float> m_acceleration;
+  std::vector<float> m_x;
+  std::vector<float> m_y;
+  std::vector<float> m_cos;
+  std::vector<float> m_sin;
+  std::vector<float> m_curvature;
+};
+
+}  // namespace frc
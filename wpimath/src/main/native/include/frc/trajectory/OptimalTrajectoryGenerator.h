@@ -0,0 +1,184 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <limits>
+#include <vector>
+
+#include <wpi/SymbolExports.h>
+
+#include "frc/geometry/Pose2d.h"
+#include "frc/system/plant/DCMotor.h"
+#include "frc/trajectory/Trajectory.h"
+#include "units/current.h"
+#include "units/length.h"
+#include "units/mass.h"
+#include "units/moment_of_inertia.h"
+#include "units/time.h"
+
+namespace frc {
+
+/**
+ * Generates minimum-time trajectories by solving an optimal control problem
+ * (OCP) over a drivetrain model, instead of time parameterizing a spline with
+ * velocity and acceleration limits.
+ *
+ * The drivetrain is modeled from its DCMotor, gearing, and mass, with the
+ * wheel forces as the input. The force is limited by the current limit and by
+ * the voltage left over after back-EMF, so the solution follows the motors'
+ * actual torque-speed curve. This is typically faster than a spline
+ * trajectory, whose constant acceleration limit has to be low enough for the
+ * motors to achieve at any speed.
+ *
+ * The problem is warm started from the spline trajectory TrajectoryGenerator
+ * generates through the same waypoints, which keeps the solve time bounded.
+ * The solve can also be given a time budget; if the solver doesn't converge in
+ * time, the spline trajectory is returned instead.
+ *
+ * Like TrajectoryGenerator, waypoint headings are the direction of travel.
+ * Swerve trajectories don't rotate the robot (the holonomic heading is
+ * supplied to the controller separately), and only constrain the waypoint
+ * translations; the headings only shape the warm start.
+ */
+class WPILIB_DLLEXPORT OptimalTrajectoryGenerator {
+ public:
+  /**
+   * A swerve drivetrain.
+   */
+  struct SwerveDrivetrain {
+    /// The robot's mass.
+    units::kilogram_t mass;
+
+    /// The wheel radius.
+    units::meter_t wheelRadius;
+
+    /// The drive motor(s) of a single module.
+    DCMotor driveMotor;
+
+    /// The gear ratio between the drive motor and the wheel (greater than 1 is
+    /// a reduction).
+    double gearing;
+
+    /// The number of modules.
+    int numModules = 4;
+
+    /// The drive motor current limit of a single module.
+    units::ampere_t currentLimit{std::numeric_limits<double>::infinity()};
+  };
+
+  /**
+   * A differential drivetrain.
+   */
+  struct DifferentialDrivetrain {
+    /// The robot's mass.
+    units::kilogram_t mass;
+
+    /// The robot's moment of inertia.
+    units::kilogram_square_meter_t moi;
+
+    /// The wheel radius.
+    units::meter_t wheelRadius;
+
+    /// The distance between the left and right wheels.
+    units::meter_t trackwidth;
+
+    /// The drive motor(s) of one side of the drivetrain.
+    DCMotor driveMotor;
+
+    /// The gear ratio between the drive motors and the wheels (greater than 1
+    /// is a reduction).
+    double gearing;
+
+    /// The drive motor current limit of one side of the drivetrain.
+    units::ampere_t currentLimit{std::numeric_limits<double>::infinity()};
+  };
+
+  /**
+   * Solver options.
+   */
+  struct SolverOptions {
+    /// Number of timesteps between each pair of waypoints.
+    int stepsPerSegment = 20;
+
+    /// The maximum time spent solving, after generating the warm start.
+    units::second_t timeout{std::numeric_limits<double>::infinity()};
+
+    /// The maximum number of solver iterations.
+    int maxIterations = 500;
+  };
+
+  /**
+   * The result of a trajectory generation.
+   */
+  struct Result {
+    /// The generated trajectory. If the solver didn't converge, this is the
+    /// spline trajectory used as the warm start.
+    Trajectory trajectory;
+
+    /// Whether the solver converged to a minimum-time trajectory.
+    bool optimal = false;
+
+    /// The time spent solving the OCP.
+    units::second_t solveTime = 0_s;
+  };
+
+  OptimalTrajectoryGenerator() = delete;
+
+  /**
+   * Generates a minimum-time swerve trajectory through the given waypoints,
+   * starting and ending at rest.
+   *
+   * @param waypoints  The waypoints. There must be at least two.
+   * @param drivetrain The drivetrain.
+   * @param options    The solver options.
+   * @return The generated trajectory.
+   */
+  static Result GenerateSwerveTrajectory(const std::vector<Pose2d>& waypoints,
+                                         const SwerveDrivetrain& drivetrain,
+                                         const SolverOptions& options);
+
+  /**
+   * Generates a minimum-time swerve trajectory through the given waypoints,
+   * starting and ending at rest, with the default solver options.
+   *
+   * @param waypoints  The waypoints. There must be at least two.
+   * @param drivetrain The drivetrain.
+   * @return The generated trajectory.
+   */
+  static Result GenerateSwerveTrajectory(const std::vector<Pose2d>& waypoints,
+                                         const SwerveDrivetrain& drivetrain) {
+    return GenerateSwerveTrajectory(waypoints, drivetrain, SolverOptions{});
+  }
+
+  /**
+   * Generates a minimum-time differential drive trajectory through the given
+   * waypoints, starting and ending at rest.
+   *
+   * @param waypoints  The waypoints. There must be at least two.
+   * @param drivetrain The drivetrain.
+   * @param options    The solver options.
+   * @return The generated trajectory.
+   */
+  static Result GenerateDifferentialTrajectory(
+      const std::vector<Pose2d>& waypoints,
+      const DifferentialDrivetrain& drivetrain, const SolverOptions& options);
+
+  /**
+   * Generates a minimum-time differential drive trajectory through the given
+   * waypoints, starting and ending at rest, with the default solver options.
+   *
+   * @param waypoints  The waypoints. There must be at least two.
+   * @param drivetrain The drivetrain.
+   * @return The generated trajectory.
+   */
+  static Result GenerateDifferentialTrajectory(
+      const std::vector<Pose2d>& waypoints,
+      const DifferentialDrivetrain& drivetrain) {
+    return GenerateDifferentialTrajectory(waypoints, drivetrain,
+                                          SolverOptions{});
+  }
+};
+
+}  // namespace frc
@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 #include <wpi/MathExtras.h>
@@ -109,13 +110,13 @@ class WPILIB_DLLEXPORT Trajectory {
    *
    * @throws std::invalid_argument if the vector of states is empty.
    */
-  explicit Trajectory(const std::vector<State>& states) : m_states(states) {
+  explicit Trajectory(std::vector<State> states) : m_states(std::move(states)) {
     if (m_states.empty()) {
       throw std::invalid_argument(
           "Trajectory manually initialized with no states.");
     }
 
-    m_totalTime = states.back().t;
+    m_totalTime = m_states.back().t;
   }
 
   /**
@@ -158,20 +159,54 @@ class WPILIB_DLLEXPORT Trajectory {
         std::lower_bound(m_states.cbegin() + 1, m_states.cend(), t,
                          [](const auto& a, const auto& b) { return a.t < b; });
 
-    auto prevSample = sample - 1;
+    return Interpolate(sample - m_states.cbegin(), t);
+  }
 
-    // The sample's timestamp is now greater than or equal to the requested
-    // timestamp. If it is greater, we need to interpolate between the
-    // previous state and the current state to get the exact state that we
-    // want.
+  /**
+   * Sample the trajectory at a point in time, starting the search from the
+   * state found by the previous call.
+   *
+   * This is intended for playing back a trajectory: when t increases between
+   * calls, finding the states to interpolate between takes amortized constant
+   * time instead of a binary search. Going back in time falls back to a binary
+   * search.
+   *
+   * @param t The point in time since the beginning of the trajectory to sample.
+   * @param[in,out] cursor The search position. Initialize to 0, and pass the
+   *                       same variable to every call for this trajectory.
+   * @return The state at that point in time.
+   * @throws std::runtime_error if the trajectory has no states.
+   */
+  State Sample(units::second_t t, size_t& cursor) const {
+    if (m_states.empty()) {
+      throw std::runtime_error(
+          "Trajectory cannot be sampled if it has no states.");
+    }
+    if (t <= m_states.front().t) {
+      return m_states.front();
+    }
+    if (t >= m_totalTime) {
+      return m_states.back();
+    }
 
-    // If the difference in states is negligible, then we are spot on!
-    if (units::math::abs(sample->t - prevSample->t) < 1E-9_s) {
-      return *sample;
+    // Find the first state with a timestamp no less than t, as Sample(t) does
+    size_t index = std::min(cursor, m_states.size() - 1);
+    if (index == 0 || m_states[index - 1].t >= t) {
+      // first call, or going back in time
+      auto end = index == 0 ? m_states.cend() : m_states.cbegin() + index;
+      index = std::lower_bound(
+                  m_states.cbegin() + 1, end, t,
+                  [](const auto& a, const auto& b) { return a.t < b; }) -
+              m_states.cbegin();
+    } else {
+      // t < m_totalTime, so this stops at the last state at the latest
+      while (m_states[index].t < t) {
+        ++index;
+      }
     }
-    // Interpolate between the two states for the state that we want.
-    return prevSample->Interpolate(
-        *sample, (t - prevSample->t) / (sample->t - prevSample->t));
+    cursor = index;
+
+    return Interpolate(index, t);
   }
 
   /**
@@ -262,6 +297,26 @@ class WPILIB_DLLEXPORT Trajectory {
  private:
   std::vector<State> m_states;
   units::second_t m_totalTime = 0_s;
+
+  // Interpolates between the states before and at index, where the state at
+  // index is the first with a timestamp no less than t
+  State Interpolate(size_t index, units::second_t t) const {
+    const auto& sample = m_states[index];
+    const auto& prevSample = m_states[index - 1];
+
+    // The sample's timestamp is now greater than or equal to the requested
+    // timestamp. If it is greater, we need to interpolate between the
+    // previous state and the current state to get the exact state that we
+    // want.
+
+    // If the difference in states is negligible, then we are spot on!
+    if (units::math::abs(sample.t - prevSample.t) < 1E-9_s) {
+      return sample;
+    }
+    // Interpolate between the two states for the state that we want.
+    return prevSample.Interpolate(
+        sample, (t - prevSample.t) / (sample.t - prevSample.t));
+  }
 };
 
 WPILIB_DLLEXPORT
@@ -4,8 +4,12 @@
 
 #pragma once
 
+#include <stdint.h>
+
+#include <cstddef>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -25,6 +29,79 @@ class WPILIB_DLLEXPORT TrajectoryGenerator {
  public:
   using PoseWithCurvature = std::pair<Pose2d, units::curvature_t>;
 
+  /**
+   * Caches parameterized spline segments between trajectory generations.
+   *
+   * Segments are keyed by their spline coefficients, so when a trajectory is
+   * regenerated after moving one waypoint, only the segments whose shape
+   * changed (the ones adjacent to the waypoint, plus any whose headings were
+   * changed by curvature optimization) are parameterized again. The least
+   * recently used segment is evicted when the cache is full.
+   *
+   * A cache must not be used by more than one generation at a time.
+   */
+  class SegmentCache {
+   public:
+    /**
+     * Constructs a segment cache.
+     *
+     * @param capacity Maximum number of segments to keep.
+     */
+    explicit SegmentCache(size_t capacity = 64) : m_capacity{capacity} {}
+
+    /**
+     * Removes all cached segments.
+     */
+    void Clear() { m_entries.clear(); }
+
+    /**
+     * Returns the number of cached segments.
+     *
+     * @return Number of segments.
+     */
+    size_t Size() const { return m_entries.size(); }
+
+    /**
+     * Returns the number of segments found in the cache since construction.
+     *
+     * @return Number of cache hits.
+     */
+    uint64_t GetHits() const { return m_hits; }
+
+    /**
+     * Returns the number of segments that had to be parameterized since
+     * construction.
+     *
+     * @return Number of cache misses.
+     */
+    uint64_t GetMisses() const { return m_misses; }
+
+   private:
+    friend class TrajectoryGenerator;
+
+    struct Entry {
+      std::vector<double> key;
+      std::vector<PoseWithCurvature> points;
+      uint64_t lastUsed;
+    };
+
+    template <typename Spline>
+    static std::vector<double> MakeKey(const Spline& spline) {
+      auto coefficients = spline.Coefficients();
+      return {coefficients.data(), coefficients.data() + coefficients.size()};
+    }
+
+    const std::vector<PoseWithCurvature>* Find(const std::vector<double>& key);
+    void Insert(std::vector<double> key,
+                std::vector<PoseWithCurvature> points);
+
+    size_t m_capacity;
+    std::vector<Entry> m_entries;
+    uint64_t m_useCount = 0;
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+  };
+
   /**
    * Generates a trajectory from the given control vectors and config. This
    * method uses clamped cubic splines -- a method in which the exterior control
@@ -35,12 +112,14 @@ class WPILIB_DLLEXPORT TrajectoryGenerator {
    * @param interiorWaypoints The interior waypoints.
    * @param end               The ending control vector.
    * @param config            The configuration for the trajectory.
+   * @param cache             Optional cache of parameterized segments.
    * @return The generated trajectory.
    */
   static Trajectory GenerateTrajectory(
       Spline<3>::ControlVector initial,
       const std::vector<Translation2d>& interiorWaypoints,
-      Spline<3>::ControlVector end, const TrajectoryConfig& config);
+      Spline<3>::ControlVector end, const TrajectoryConfig& config,
+      SegmentCache* cache = nullptr);
 
   /**
    * Generates a trajectory from the given waypoints and config. This method
@@ -52,11 +131,13 @@ class WPILIB_DLLEXPORT TrajectoryGenerator {
    * @param interiorWaypoints The interior waypoints.
    * @param end               The ending pose.
    * @param config            The configuration for the trajectory.
+   * @param cache             Optional cache of parameterized segments.
    * @return The generated trajectory.
    */
   static Trajectory GenerateTrajectory(
       const Pose2d& start, const std::vector<Translation2d>& interiorWaypoints,
-      const Pose2d& end, const TrajectoryConfig& config);
+      const Pose2d& end, const TrajectoryConfig& config,
+      SegmentCache* cache = nullptr);
 
   /**
    * Generates a trajectory from the given quintic control vectors and config.
@@ -66,11 +147,12 @@ class WPILIB_DLLEXPORT TrajectoryGenerator {
    *
    * @param controlVectors List of quintic control vectors.
    * @param config         The configuration for the trajectory.
+   * @param cache          Optional cache of parameterized segments.
    * @return The generated trajectory.
    */
   static Trajectory GenerateTrajectory(
       std::vector<Spline<5>::ControlVector> controlVectors,
-      const TrajectoryConfig& config);
+      const TrajectoryConfig& config, SegmentCache* cache = nullptr);
 
   /**
    * Generates a trajectory from the given waypoints and config. This method
@@ -79,41 +161,87 @@ class WPILIB_DLLEXPORT TrajectoryGenerator {
    *
    * @param waypoints List of waypoints..
    * @param config    The configuration for the trajectory.
+   * @param cache     Optional cache of parameterized segments.
    * @return The generated trajectory.
    */
   static Trajectory GenerateTrajectory(const std::vector<Pose2d>& waypoints,
-                                       const TrajectoryConfig& config);
+                                       const TrajectoryConfig& config,
+                                       SegmentCache* cache = nullptr);
 
   /**
    * Generate spline points from a vector of splines by parameterizing the
-   * splines.
+   * splines. Segments not found in the cache are parameterized in parallel
+   * if SetMaxThreads() allows more than one thread.
    *
    * @param splines The splines to parameterize.
+   * @param cache Optional cache of parameterized segments.
    *
    * @return The spline points for use in time parameterization of a trajectory.
    */
   template <typename Spline>
   static std::vector<PoseWithCurvature> SplinePointsFromSplines(
-      const std::vector<Spline>& splines) {
+      const std::vector<Spline>& splines, SegmentCache* cache = nullptr) {
+    // Look up each segment in the cache, and parameterize the rest.
+    std::vector<std::vector<double>> keys;
+    std::vector<const std::vector<PoseWithCurvature>*> cached(splines.size());
+    std::vector<std::optional<std::vector<PoseWithCurvature>>> parameterized(
+        splines.size());
+    std::vector<size_t> misses;
+    if (cache) {
+      keys.reserve(splines.size());
+      for (size_t i = 0; i < splines.size(); ++i) {
+        keys.emplace_back(SegmentCache::MakeKey(splines[i]));
+        cached[i] = cache->Find(keys.back());
+        if (!cached[i]) {
+          misses.push_back(i);
+        }
+      }
+    } else {
+      misses.resize(splines.size());
+      for (size_t i = 0; i < splines.size(); ++i) {
+        misses[i] = i;
+      }
+    }
+    ForEachIndex(misses.size(), [&](size_t i) {
+      parameterized[misses[i]] =
+          SplineParameterizer::Parameterize(splines[misses[i]]);
+    });
+
     // Create the vector of spline points.
     std::vector<PoseWithCurvature> splinePoints;
 
     // Add the first point to the vector.
     splinePoints.push_back(splines.front().GetPoint(0.0).value());
 
-    // Iterate through the vector and parameterize each spline, adding the
-    // parameterized points to the final vector.
-    for (auto&& spline : splines) {
-      auto points = SplineParameterizer::Parameterize(spline);
+    // Iterate through the vector of segments, adding the parameterized points
+    // to the final vector.
+    for (size_t i = 0; i < splines.size(); ++i) {
+      const auto& points = cached[i] ? *cached[i] : *parameterized[i];
       // Append the array of poses to the vector. We are removing the first
       // point because it's a duplicate of the last point from the previous
       // spline.
       splinePoints.insert(std::end(splinePoints), std::begin(points) + 1,
                           std::end(points));
     }
+
+    if (cache) {
+      // Insert after assembling the points, since inserting may evict
+      // segments the cached pointers refer to.
+      for (size_t i : misses) {
+        cache->Insert(std::move(keys[i]), std::move(*parameterized[i]));
+      }
+    }
     return splinePoints;
   }
 
+  /**
+   * Sets the maximum number of threads used to parameterize spline segments.
+   * The default is 1, which parameterizes segments on the calling thread.
+   *
+   * @param maxThreads Maximum number of threads.
+   */
+  static void SetMaxThreads(int maxThreads);
+
   /**
    * Set error reporting function. By default, it is output to stderr.
    *
@@ -124,7 +252,13 @@ class WPILIB_DLLEXPORT TrajectoryGenerator {
  private:
   static void ReportError(const char* error);
 
+  // Calls func(0) through func(count - 1), spread across up to s_maxThreads
+  // threads. Rethrows the first exception thrown by func.
+  static void ForEachIndex(size_t count,
+                           const std::function<void(size_t)>& func);
+
   static const Trajectory kDoNothingTrajectory;
   static std::function<void(const char*)> s_errorFunc;
+  static int s_maxThreads;
 };
 }  // namespace frc
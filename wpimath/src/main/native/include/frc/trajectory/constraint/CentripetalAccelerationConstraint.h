@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <span>
+
 #include <wpi/SymbolExports.h>
 
 #include "frc/trajectory/constraint/TrajectoryConstraint.h"
@@ -47,6 +49,17 @@ class WPILIB_DLLEXPORT CentripetalAccelerationConstraint
                              units::math::abs(curvature) * 1_rad);
   }
 
+  constexpr void MaxVelocities(
+      std::span<const PoseWithCurvature> points,
+      units::meters_per_second_t velocity,
+      std::span<units::meters_per_second_t> maxVelocities) const override {
+    for (size_t i = 0; i < points.size(); ++i) {
+      maxVelocities[i] = units::math::sqrt(
+          m_maxCentripetalAcceleration / units::math::abs(points[i].second) *
+          1_rad);
+    }
+  }
+
   constexpr MinMax MinMaxAcceleration(
       const Pose2d& pose, units::curvature_t curvature,
       units::meters_per_second_t speed) const override {
@@ -4,12 +4,14 @@
 
 #pragma once
 
+#include <span>
 #include <utility>
 
 #include <wpi/SymbolExports.h>
 
 #include "frc/kinematics/DifferentialDriveKinematics.h"
 #include "frc/trajectory/constraint/TrajectoryConstraint.h"
+#include "units/math.h"
 #include "units/velocity.h"
 
 namespace frc {
@@ -37,6 +39,20 @@ class WPILIB_DLLEXPORT DifferentialDriveKinematicsConstraint
     return m_kinematics.ToChassisSpeeds(wheelSpeeds).vx;
   }
 
+  constexpr void MaxVelocities(
+      std::span<const PoseWithCurvature> points,
+      units::meters_per_second_t velocity,
+      std::span<units::meters_per_second_t> maxVelocities) const override {
+    // The outer wheel's speed is v(1 + |k|T/2), so desaturating it to the max
+    // speed limits the chassis to maxSpeed / (1 + |k|T/2).
+    for (size_t i = 0; i < points.size(); ++i) {
+      maxVelocities[i] = units::math::min(
+          velocity, m_maxSpeed / (1 + m_kinematics.trackWidth *
+                                          units::math::abs(points[i].second) /
+                                          2_rad));
+    }
+  }
+
   constexpr MinMax MinMaxAcceleration(
       const Pose2d& pose, units::curvature_t curvature,
       units::meters_per_second_t speed) const override {
@@ -6,6 +6,7 @@
 
 #include <concepts>
 #include <limits>
+#include <span>
 
 #include "frc/geometry/Ellipse2d.h"
 #include "frc/geometry/Rotation2d.h"
@@ -63,6 +64,19 @@ class EllipticalRegionConstraint : public TrajectoryConstraint {
     }
   }
 
+  constexpr void MaxVelocities(
+      std::span<const PoseWithCurvature> points,
+      units::meters_per_second_t velocity,
+      std::span<units::meters_per_second_t> maxVelocities) const override {
+    m_constraint.MaxVelocities(points, velocity, maxVelocities);
+    for (size_t i = 0; i < points.size(); ++i) {
+      if (!m_ellipse.Contains(points[i].first.Translation())) {
+        maxVelocities[i] =
+            units::meters_per_second_t{std::numeric_limits<double>::infinity()};
+      }
+    }
+  }
+
   constexpr MinMax MinMaxAcceleration(
       const Pose2d& pose, units::curvature_t curvature,
       units::meters_per_second_t speed) const override {
@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <span>
+
 #include <wpi/SymbolExports.h>
 
 #include "frc/trajectory/constraint/TrajectoryConstraint.h"
@@ -34,6 +37,13 @@ class WPILIB_DLLEXPORT MaxVelocityConstraint : public TrajectoryConstraint {
     return m_maxVelocity;
   }
 
+  constexpr void MaxVelocities(
+      std::span<const PoseWithCurvature> points,
+      units::meters_per_second_t velocity,
+      std::span<units::meters_per_second_t> maxVelocities) const override {
+    std::fill(maxVelocities.begin(), maxVelocities.end(), m_maxVelocity);
+  }
+
   constexpr MinMax MinMaxAcceleration(
       const Pose2d& pose, units::curvature_t curvature,
       units::meters_per_second_t speed) const override {
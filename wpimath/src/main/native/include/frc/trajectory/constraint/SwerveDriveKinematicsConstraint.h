@@ -4,7 +4,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
+#include <span>
 
 #include "frc/kinematics/SwerveDriveKinematics.h"
 #include "frc/trajectory/constraint/TrajectoryConstraint.h"
@@ -40,6 +42,29 @@ class SwerveDriveKinematicsConstraint : public TrajectoryConstraint {
     return units::math::hypot(normSpeeds.vx, normSpeeds.vy);
   }
 
+  void MaxVelocities(
+      std::span<const PoseWithCurvature> points,
+      units::meters_per_second_t velocity,
+      std::span<units::meters_per_second_t> maxVelocities) const override {
+    // Each module's velocity is v(cos θ − ky, sin θ + kx) for a module at
+    // (x, y), so desaturating the fastest one to the max speed limits the
+    // chassis to maxSpeed / max |(cos θ − ky, sin θ + kx)|.
+    const auto& modules = m_kinematics.GetModules();
+    for (size_t i = 0; i < points.size(); ++i) {
+      double cos = points[i].first.Rotation().Cos();
+      double sin = points[i].first.Rotation().Sin();
+      double k = points[i].second.value();
+      double maxNormSquared = 0.0;
+      for (const auto& module : modules) {
+        double vx = cos - k * module.Y().value();
+        double vy = sin + k * module.X().value();
+        maxNormSquared = std::max(maxNormSquared, vx * vx + vy * vy);
+      }
+      maxVelocities[i] = units::math::min(
+          velocity, m_maxSpeed / std::sqrt(maxNormSquared));
+    }
+  }
+
   MinMax MinMaxAcceleration(const Pose2d& pose, units::curvature_t curvature,
                             units::meters_per_second_t speed) const override {
     return {};
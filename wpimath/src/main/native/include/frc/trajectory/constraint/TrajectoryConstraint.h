@@ -5,6 +5,8 @@
 #pragma once
 
 #include <limits>
+#include <span>
+#include <utility>
 
 #include <wpi/SymbolExports.h>
 
@@ -31,6 +33,8 @@ class WPILIB_DLLEXPORT TrajectoryConstraint {
 
   constexpr virtual ~TrajectoryConstraint() = default;
 
+  using PoseWithCurvature = std::pair<Pose2d, units::curvature_t>;
+
   /**
    * Represents a minimum and maximum acceleration.
    */
@@ -62,6 +66,34 @@ class WPILIB_DLLEXPORT TrajectoryConstraint {
       const Pose2d& pose, units::curvature_t curvature,
       units::meters_per_second_t velocity) const = 0;
 
+  /**
+   * Returns the max velocity at each of a span of points.
+   *
+   * The trajectory parameterizer calls this once per trajectory, passing the
+   * trajectory's max velocity, and caps the velocity at each point by the
+   * result. MaxVelocity() must therefore only use the velocity before
+   * constraints are applied as an upper bound on its result (as desaturating
+   * wheel speeds does), so that lowering it never raises the limit.
+   *
+   * The default implementation calls MaxVelocity() for each point. Override it
+   * when the limit can be computed for many points without redoing the same
+   * work per point.
+   *
+   * @param points The points in the trajectory.
+   * @param velocity The velocity before constraints are applied.
+   * @param maxVelocities Output: the absolute maximum velocity at each point.
+   *     Must be the same size as points.
+   */
+  constexpr virtual void MaxVelocities(
+      std::span<const PoseWithCurvature> points,
+      units::meters_per_second_t velocity,
+      std::span<units::meters_per_second_t> maxVelocities) const {
+    for (size_t i = 0; i < points.size(); ++i) {
+      maxVelocities[i] =
+          MaxVelocity(points[i].first, points[i].second, velocity);
+    }
+  }
+
   /**
    * Returns the minimum and maximum allowable acceleration for the trajectory
    * given pose, curvature, and speed.
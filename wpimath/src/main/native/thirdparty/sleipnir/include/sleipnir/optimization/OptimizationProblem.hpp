@@ -7,6 +7,7 @@
 #include <concepts>
 #include <functional>
 #include <iterator>
+#include <memory>
 #include <optional>
 #include <utility>
 
@@ -59,6 +60,7 @@ class SLEIPNIR_DLLEXPORT OptimizationProblem {
    */
   [[nodiscard]]
   Variable DecisionVariable() {
+    m_interiorPointWorkspace.reset();
     m_decisionVariables.emplace_back();
     return m_decisionVariables.back();
   }
@@ -71,6 +73,7 @@ class SLEIPNIR_DLLEXPORT OptimizationProblem {
    */
   [[nodiscard]]
   VariableMatrix DecisionVariable(int rows, int cols = 1) {
+    m_interiorPointWorkspace.reset();
     m_decisionVariables.reserve(m_decisionVariables.size() + rows * cols);
 
     VariableMatrix vars{rows, cols};
@@ -96,6 +99,7 @@ class SLEIPNIR_DLLEXPORT OptimizationProblem {
    */
   [[nodiscard]]
   VariableMatrix SymmetricDecisionVariable(int rows) {
+    m_interiorPointWorkspace.reset();
     // We only need to store the lower triangle of an n x n symmetric matrix;
     // the other elements are duplicates. The lower triangle has (n² + n)/2
     // elements.
@@ -129,6 +133,8 @@ class SLEIPNIR_DLLEXPORT OptimizationProblem {
    * @param cost The cost function to minimize.
    */
   void Minimize(const Variable& cost) {
+    m_interiorPointWorkspace.reset();
+
     m_f = cost;
     status.costFunctionType = m_f.value().Type();
   }
@@ -143,6 +149,8 @@ class SLEIPNIR_DLLEXPORT OptimizationProblem {
    * @param cost The cost function to minimize.
    */
   void Minimize(Variable&& cost) {
+    m_interiorPointWorkspace.reset();
+
     m_f = std::move(cost);
     status.costFunctionType = m_f.value().Type();
   }
@@ -157,6 +165,8 @@ class SLEIPNIR_DLLEXPORT OptimizationProblem {
    * @param objective The objective function to maximize.
    */
   void Maximize(const Variable& objective) {
+    m_interiorPointWorkspace.reset();
+
     // Maximizing a cost function is the same as minimizing its negative
     m_f = -objective;
     status.costFunctionType = m_f.value().Type();
@@ -172,6 +182,8 @@ class SLEIPNIR_DLLEXPORT OptimizationProblem {
    * @param objective The objective function to maximize.
    */
   void Maximize(Variable&& objective) {
+    m_interiorPointWorkspace.reset();
+
     // Maximizing a cost function is the same as minimizing its negative
     m_f = -std::move(objective);
     status.costFunctionType = m_f.value().Type();
@@ -184,6 +196,8 @@ class SLEIPNIR_DLLEXPORT OptimizationProblem {
    * @param constraint The constraint to satisfy.
    */
   void SubjectTo(const EqualityConstraints& constraint) {
+    m_interiorPointWorkspace.reset();
+
     // Get the highest order equality constraint expression type
     for (const auto& c : constraint.constraints) {
       status.equalityConstraintType =
@@ -203,6 +217,8 @@ class SLEIPNIR_DLLEXPORT OptimizationProblem {
    * @param constraint The constraint to satisfy.
    */
   void SubjectTo(EqualityConstraints&& constraint) {
+    m_interiorPointWorkspace.reset();
+
     // Get the highest order equality constraint expression type
     for (const auto& c : constraint.constraints) {
       status.equalityConstraintType =
@@ -222,6 +238,8 @@ class SLEIPNIR_DLLEXPORT OptimizationProblem {
    * @param constraint The constraint to satisfy.
    */
   void SubjectTo(const InequalityConstraints& constraint) {
+    m_interiorPointWorkspace.reset();
+
     // Get the highest order inequality constraint expression type
     for (const auto& c : constraint.constraints) {
       status.inequalityConstraintType =
@@ -241,6 +259,8 @@ class SLEIPNIR_DLLEXPORT OptimizationProblem {
    * @param constraint The constraint to satisfy.
    */
   void SubjectTo(InequalityConstraints&& constraint) {
+    m_interiorPointWorkspace.reset();
+
     // Get the highest order inequality constraint expression type
     for (const auto& c : constraint.constraints) {
       status.inequalityConstraintType =
@@ -257,6 +277,14 @@ class SLEIPNIR_DLLEXPORT OptimizationProblem {
    * Solve the optimization problem. The solution will be stored in the original
    * variables used to construct the problem.
    *
+   * The solver's setup (autodiff expression graphs and the KKT system's
+   * sparsity analysis) is kept and reused by later solves until a decision
+   * variable, constraint, or cost function is added. To solve a sequence of
+   * similar problems quickly, such as in model predictive control, build the
+   * problem once with parameters (variables that aren't decision variables),
+   * then update the parameters' values before each solve. See
+   * SolverConfig::warmStart.
+   *
    * @param config Configuration options for the solver.
    */
   SolverStatus Solve(const SolverConfig& config = SolverConfig{}) {
@@ -310,10 +338,15 @@ class SLEIPNIR_DLLEXPORT OptimizationProblem {
       SQP(m_decisionVariables, m_equalityConstraints, m_f.value(), m_callback,
           config, x, &status);
     } else {
+      if (!m_interiorPointWorkspace) {
+        m_interiorPointWorkspace = MakeInteriorPointWorkspace(
+            m_decisionVariables, m_equalityConstraints, m_inequalityConstraints,
+            m_f.value());
+      }
       Eigen::VectorXd s = Eigen::VectorXd::Ones(m_inequalityConstraints.size());
       InteriorPoint(m_decisionVariables, m_equalityConstraints,
                     m_inequalityConstraints, m_f.value(), m_callback, config,
-                    false, x, s, &status);
+                    false, x, s, &status, m_interiorPointWorkspace.get());
     }
 
     if (config.diagnostics) {
@@ -381,6 +414,10 @@ class SLEIPNIR_DLLEXPORT OptimizationProblem {
 
   // The solver status
   SolverStatus status;
+
+  // Interior-point solver state reused by subsequent solves. It's reset
+  // whenever the problem's structure changes.
+  std::shared_ptr<InteriorPointWorkspace> m_interiorPointWorkspace;
 };
 
 }  // namespace sleipnir
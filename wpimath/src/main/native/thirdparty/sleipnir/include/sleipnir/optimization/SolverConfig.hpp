@@ -49,6 +49,13 @@ struct SLEIPNIR_DLLEXPORT SolverConfig {
   ///
   /// Use tools/spy.py to plot them.
   bool spy = false;
+
+  /// Warm starts the interior-point method's slack variables and Lagrange
+  /// multipliers from the previous solve of the same OptimizationProblem, in
+  /// addition to the decision variables (which always start from their current
+  /// values). This speeds up solving a sequence of similar problems, such as
+  /// model predictive control with a new initial state each time.
+  bool warmStart = false;
 };
 
 }  // namespace sleipnir
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <memory>
 #include <span>
 
 #include <Eigen/Core>
@@ -15,6 +16,32 @@
 
 namespace sleipnir {
 
+/**
+ * Solver state that persists between interior-point solves of the same
+ * problem: the autodiff expression graphs for the Lagrangian's derivatives, the
+ * KKT system's symbolic factorization, and the previous solution's slack
+ * variables and Lagrange multipliers for warm starts.
+ *
+ * A workspace is only valid for the decision variables, constraints, and cost
+ * function it was made with. Parameters (variables that aren't decision
+ * variables) may change value between solves.
+ */
+class InteriorPointWorkspace;
+
+/**
+ * Makes an interior-point workspace for the given problem.
+ *
+ * @param decisionVariables The list of decision variables.
+ * @param equalityConstraints The list of equality constraints.
+ * @param inequalityConstraints The list of inequality constraints.
+ * @param f The cost function.
+ */
+SLEIPNIR_DLLEXPORT std::shared_ptr<InteriorPointWorkspace>
+MakeInteriorPointWorkspace(std::span<Variable> decisionVariables,
+                           std::span<Variable> equalityConstraints,
+                           std::span<Variable> inequalityConstraints,
+                           Variable& f);
+
 /**
 Finds the optimal solution to a nonlinear program using the interior-point
 method.
@@ -43,6 +70,11 @@ are the inequality constraints.
 @param[in,out] s The initial guess and output location for the inequality
   constraint slack variables.
 @param[out] status The solver status.
+@param[in,out] workspace Persistent solver state made by
+  MakeInteriorPointWorkspace() for the same problem, or nullptr to make a
+  temporary one. If config.warmStart is set and the workspace has a previous
+  solution, its slack variables and Lagrange multipliers are used instead of s
+  and the default initial guess.
 */
 SLEIPNIR_DLLEXPORT void InteriorPoint(
     std::span<Variable> decisionVariables,
@@ -50,6 +82,7 @@ SLEIPNIR_DLLEXPORT void InteriorPoint(
     std::span<Variable> inequalityConstraints, Variable& f,
     function_ref<bool(const SolverIterationInfo& info)> callback,
     const SolverConfig& config, bool feasibilityRestoration, Eigen::VectorXd& x,
-    Eigen::VectorXd& s, SolverStatus* status);
+    Eigen::VectorXd& s, SolverStatus* status,
+    InteriorPointWorkspace* workspace = nullptr);
 
 }  // namespace sleipnir
@@ -7,6 +7,8 @@
 #include <cmath>
 #include <fstream>
 #include <limits>
+#include <memory>
+#include <optional>
 
 #include <Eigen/SparseCholesky>
 #include <wpi/SmallVector.h>
@@ -34,64 +36,138 @@
 
 namespace sleipnir {
 
+class InteriorPointWorkspace {
+ public:
+  InteriorPointWorkspace(std::span<Variable> decisionVariables,
+                         std::span<Variable> equalityConstraints,
+                         std::span<Variable> inequalityConstraints, Variable& f)
+      : xAD{decisionVariables},
+        c_eAD{equalityConstraints},
+        c_iAD{inequalityConstraints},
+        sAD(inequalityConstraints.size()),
+        yAD(equalityConstraints.size()),
+        zAD(inequalityConstraints.size()),
+        // Lagrangian L
+        //
+        // L(xₖ, sₖ, yₖ, zₖ) = f(xₖ) − yₖᵀcₑ(xₖ) − zₖᵀ(cᵢ(xₖ) − sₖ)
+        L{f - (yAD.T() * c_eAD)(0) - (zAD.T() * (c_iAD - sAD))(0)},
+        // Equality constraint Jacobian Aₑ
+        //
+        //         [∇ᵀcₑ₁(xₖ)]
+        // Aₑ(x) = [∇ᵀcₑ₂(xₖ)]
+        //         [    ⋮    ]
+        //         [∇ᵀcₑₘ(xₖ)]
+        jacobianCe{c_eAD, xAD},
+        // Inequality constraint Jacobian Aᵢ
+        //
+        //         [∇ᵀcᵢ₁(xₖ)]
+        // Aᵢ(x) = [∇ᵀcᵢ₂(xₖ)]
+        //         [    ⋮    ]
+        //         [∇ᵀcᵢₘ(xₖ)]
+        jacobianCi{c_iAD, xAD},
+        // Gradient of f ∇f
+        gradientF{f, xAD},
+        // Hessian of the Lagrangian H
+        //
+        // Hₖ = ∇²ₓₓL(xₖ, sₖ, yₖ, zₖ)
+        hessianL{L, xAD} {}
+
+  // Autodiff variables for x, s, y, z, and the constraints
+  VariableMatrix xAD;
+  VariableMatrix c_eAD;
+  VariableMatrix c_iAD;
+  VariableMatrix sAD;
+  VariableMatrix yAD;
+  VariableMatrix zAD;
+
+  Variable L;
+
+  Jacobian jacobianCe;
+  Jacobian jacobianCi;
+  Gradient gradientF;
+  Hessian hessianL;
+
+  // Keeps the KKT system's symbolic factorization between solves
+  RegularizedLDLT solver;
+
+  // Slack variables and Lagrange multipliers of the previous solve. Empty if
+  // there hasn't been one.
+  Eigen::VectorXd s;
+  Eigen::VectorXd y;
+  Eigen::VectorXd z;
+};
+
+std::shared_ptr<InteriorPointWorkspace> MakeInteriorPointWorkspace(
+    std::span<Variable> decisionVariables,
+    std::span<Variable> equalityConstraints,
+    std::span<Variable> inequalityConstraints, Variable& f) {
+  return std::make_shared<InteriorPointWorkspace>(
+      decisionVariables, equalityConstraints, inequalityConstraints, f);
+}
+
 void InteriorPoint(std::span<Variable> decisionVariables,
                    std::span<Variable> equalityConstraints,
                    std::span<Variable> inequalityConstraints, Variable& f,
                    function_ref<bool(const SolverIterationInfo& info)> callback,
                    const SolverConfig& config, bool feasibilityRestoration,
                    Eigen::VectorXd& x, Eigen::VectorXd& s,
-                   SolverStatus* status) {
+                   SolverStatus* status, InteriorPointWorkspace* workspace) {
   const auto solveStartTime = std::chrono::system_clock::now();
 
-  // Map decision variables and constraints to VariableMatrices for Lagrangian
-  VariableMatrix xAD{decisionVariables};
-  xAD.SetValue(x);
-  VariableMatrix c_eAD{equalityConstraints};
-  VariableMatrix c_iAD{inequalityConstraints};
-
-  // Create autodiff variables for s, y, and z for Lagrangian
-  VariableMatrix sAD(inequalityConstraints.size());
-  sAD.SetValue(s);
-  VariableMatrix yAD(equalityConstraints.size());
-  for (auto& y : yAD) {
-    y.SetValue(0.0);
+  // Building the autodiff expression graphs is a large part of the setup cost,
+  // so they're kept in a workspace that can be reused across solves
+  std::optional<InteriorPointWorkspace> localWorkspace;
+  if (workspace == nullptr) {
+    workspace = &localWorkspace.emplace(decisionVariables, equalityConstraints,
+                                        inequalityConstraints, f);
   }
-  VariableMatrix zAD(inequalityConstraints.size());
-  for (auto& z : zAD) {
-    z.SetValue(1.0);
+  auto& xAD = workspace->xAD;
+  auto& c_eAD = workspace->c_eAD;
+  auto& c_iAD = workspace->c_iAD;
+  auto& sAD = workspace->sAD;
+  auto& yAD = workspace->yAD;
+  auto& zAD = workspace->zAD;
+  auto& jacobianCe = workspace->jacobianCe;
+  auto& jacobianCi = workspace->jacobianCi;
+  auto& gradientF = workspace->gradientF;
+  auto& hessianL = workspace->hessianL;
+  auto& solver = workspace->solver;
+
+  // Barrier parameter minimum
+  const double μ_min = config.tolerance / 10.0;
+
+  // Barrier parameter μ
+  double μ = 0.1;
+
+  xAD.SetValue(x);
+  if (config.warmStart && workspace->s.size() == s.size() &&
+      workspace->y.size() == static_cast<int>(equalityConstraints.size())) {
+    // Start from the previous solution's slack variables and Lagrange
+    // multipliers. They're kept away from zero so the iterates aren't stuck
+    // at the boundary if the parameters changed, and the barrier parameter
+    // starts at their average complementarity instead of its usual value.
+    constexpr double kMinWarmStart = 1e-6;
+    s = workspace->s.cwiseMax(kMinWarmStart);
+    sAD.SetValue(s);
+    yAD.SetValue(workspace->y);
+    Eigen::VectorXd z = workspace->z.cwiseMax(kMinWarmStart);
+    zAD.SetValue(z);
+    if (s.size() > 0) {
+      μ = std::clamp(s.dot(z) / s.size(), μ_min, μ);
+    }
+  } else {
+    sAD.SetValue(s);
+    for (auto& y : yAD) {
+      y.SetValue(0.0);
+    }
+    for (auto& z : zAD) {
+      z.SetValue(1.0);
+    }
   }
 
-  // Lagrangian L
-  //
-  // L(xₖ, sₖ, yₖ, zₖ) = f(xₖ) − yₖᵀcₑ(xₖ) − zₖᵀ(cᵢ(xₖ) − sₖ)
-  auto L = f - (yAD.T() * c_eAD)(0) - (zAD.T() * (c_iAD - sAD))(0);
-
-  // Equality constraint Jacobian Aₑ
-  //
-  //         [∇ᵀcₑ₁(xₖ)]
-  // Aₑ(x) = [∇ᵀcₑ₂(xₖ)]
-  //         [    ⋮    ]
-  //         [∇ᵀcₑₘ(xₖ)]
-  Jacobian jacobianCe{c_eAD, xAD};
   Eigen::SparseMatrix<double> A_e = jacobianCe.Value();
-
-  // Inequality constraint Jacobian Aᵢ
-  //
-  //         [∇ᵀcᵢ₁(xₖ)]
-  // Aᵢ(x) = [∇ᵀcᵢ₂(xₖ)]
-  //         [    ⋮    ]
-  //         [∇ᵀcᵢₘ(xₖ)]
-  Jacobian jacobianCi{c_iAD, xAD};
   Eigen::SparseMatrix<double> A_i = jacobianCi.Value();
-
-  // Gradient of f ∇f
-  Gradient gradientF{f, xAD};
   Eigen::SparseVector<double> g = gradientF.Value();
-
-  // Hessian of the Lagrangian H
-  //
-  // Hₖ = ∇²ₓₓL(xₖ, sₖ, yₖ, zₖ)
-  Hessian hessianL{L, xAD};
   Eigen::SparseMatrix<double> H = hessianL.Value();
 
   Eigen::VectorXd y = yAD.Value();
@@ -145,6 +221,14 @@ void InteriorPoint(std::span<Variable> decisionVariables,
   scope_exit exit{[&] {
     status->cost = f.Value();
 
+    // Save the slack variables and Lagrange multipliers for warm starting the
+    // next solve
+    if (s.allFinite() && y.allFinite() && z.allFinite()) {
+      workspace->s = s;
+      workspace->y = y;
+      workspace->z = z;
+    }
+
     if (config.diagnostics && !feasibilityRestoration) {
       auto solveEndTime = std::chrono::system_clock::now();
 
@@ -183,12 +267,6 @@ void InteriorPoint(std::span<Variable> decisionVariables,
     }
   }};
 
-  // Barrier parameter minimum
-  const double μ_min = config.tolerance / 10.0;
-
-  // Barrier parameter μ
-  double μ = 0.1;
-
   // Fraction-to-the-boundary rule scale factor minimum
   constexpr double τ_min = 0.99;
 
@@ -228,8 +306,6 @@ void InteriorPoint(std::span<Variable> decisionVariables,
   // Kept outside the loop so its storage can be reused
   wpi::SmallVector<Eigen::Triplet<double>> triplets;
 
-  RegularizedLDLT solver;
-
   // Variables for determining when a step is acceptable
   constexpr double α_red_factor = 0.5;
   int acceptableIterCounter = 0;
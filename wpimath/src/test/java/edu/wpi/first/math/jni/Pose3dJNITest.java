@@ -5,6 +5,8 @@
 package edu.wpi.first.math.jni;
 
 import static org.junit.jupiter.api.Assertions.assertDoesNotThrow;
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertThrows;
 
 import org.junit.jupiter.api.Test;
 
@@ -13,4 +15,37 @@ public class Pose3dJNITest {
   public void testLink() {
     assertDoesNotThrow(Pose3dJNI::forceLoad);
   }
+
+  @Test
+  public void testExpBatch() {
+    double[] poses = {1, 2, 3, 1, 0, 0, 0, 0, 0, 0, 0.5, 0.5, 0.5, 0.5};
+    double[] twists = {1, 0, 0, 0, 0, 0.5, 0.2, 0.3, 0.4, 0.1, 0.2, 0.3};
+    double[] result = new double[poses.length];
+    Pose3dJNI.expBatch(poses, twists, result);
+
+    for (int i = 0; i < 2; i++) {
+      double[] expected =
+          Pose3dJNI.exp(
+              poses[i * 7],
+              poses[i * 7 + 1],
+              poses[i * 7 + 2],
+              poses[i * 7 + 3],
+              poses[i * 7 + 4],
+              poses[i * 7 + 5],
+              poses[i * 7 + 6],
+              twists[i * 6],
+              twists[i * 6 + 1],
+              twists[i * 6 + 2],
+              twists[i * 6 + 3],
+              twists[i * 6 + 4],
+              twists[i * 6 + 5]);
+      for (int j = 0; j < 7; j++) {
+        assertEquals(expected[j], result[i * 7 + j], 1e-9);
+      }
+    }
+
+    assertThrows(
+        IllegalArgumentException.class,
+        () -> Pose3dJNI.expBatch(poses, new double[6], result));
+  }
 }
@@ -0,0 +1,103 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <filesystem>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "frc/DARECache.h"
+#include "frc/EigenCore.h"
+#include "frc/controller/LTVUnicycleController.h"
+
+TEST(DARECacheTest, CachedDAREMatchesDARE) {
+  frc::DARECache::Clear();
+
+  frc::Matrixd<2, 2> A{{1, 1}, {0, 1}};
+  frc::Matrixd<2, 1> B{{0}, {1}};
+  frc::Matrixd<2, 2> Q{{1, 0}, {0, 0}};
+  frc::Matrixd<1, 1> R{{0.3}};
+
+  auto S = frc::DARE<2, 1>(A, B, Q, R);
+  ASSERT_TRUE(S);
+
+  // The first call solves the DARE and the second finds the cached solution
+  for (int i = 0; i < 2; ++i) {
+    auto cachedS = frc::CachedDARE<2, 1>(A, B, Q, R);
+    ASSERT_TRUE(cachedS);
+    EXPECT_EQ(S.value(), cachedS.value());
+  }
+
+  // Changing an input is a cache miss
+  Q(1, 1) = 1.0;
+  auto S2 = frc::CachedDARE<2, 1>(A, B, Q, R);
+  ASSERT_TRUE(S2);
+  EXPECT_NE(S.value(), S2.value());
+  auto uncachedS2 = frc::DARE<2, 1>(A, B, Q, R);
+  EXPECT_EQ(uncachedS2.value(), S2.value());
+
+  // Failed solves aren't cached
+  frc::Matrixd<1, 1> badR{{-1.0}};
+  for (int i = 0; i < 2; ++i) {
+    auto badS = frc::CachedDARE<2, 1>(A, B, Q, badR);
+    EXPECT_FALSE(badS);
+  }
+}
+
+TEST(DARECacheTest, Persistence) {
+  auto directory =
+      std::filesystem::temp_directory_path() / "DARECacheTestPersistence";
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directories(directory);
+
+  frc::DARECache::Clear();
+  frc::DARECache::SetDirectory(directory.string());
+
+  std::vector<double> key{1.0, 2.0, 3.0};
+  std::vector<double> value{4.0, 5.0};
+  frc::DARECache::Insert(key, value);
+
+  // Entries are reloaded from the file after being removed from memory
+  frc::DARECache::Clear();
+  EXPECT_FALSE(frc::DARECache::Find(key));
+  frc::DARECache::SetDirectory(directory.string());
+  EXPECT_EQ(value, frc::DARECache::Find(key));
+
+  frc::DARECache::SetDirectory("");
+  frc::DARECache::Clear();
+  std::filesystem::remove_all(directory);
+}
+
+TEST(DARECacheTest, NaNKeyOnlyMatchesItself) {
+  frc::DARECache::Clear();
+
+  constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+  std::vector<double> nanKey{kNaN, 1.0};
+  std::vector<double> value{4.0};
+  frc::DARECache::Insert(nanKey, value);
+
+  EXPECT_FALSE(frc::DARECache::Find(std::vector<double>{2.0, 1.0}));
+  EXPECT_EQ(value, frc::DARECache::Find(nanKey));
+
+  frc::DARECache::Clear();
+}
+
+TEST(DARECacheTest, LTVUnicycleControllerGainTable) {
+  frc::DARECache::Clear();
+
+  frc::Pose2d pose{1_m, 2_m, 0.5_rad};
+  frc::Pose2d poseRef{1.5_m, 2.25_m, 0.25_rad};
+
+  // The second controller's gain table comes from the cache
+  frc::LTVUnicycleController first{20_ms, 3_mps};
+  frc::LTVUnicycleController second{20_ms, 3_mps};
+
+  for (auto velocity : {-2.995_mps, -1_mps, 0_mps, 0.5_mps, 2.5_mps}) {
+    auto firstSpeeds = first.Calculate(pose, poseRef, velocity, 1_rad_per_s);
+    auto secondSpeeds = second.Calculate(pose, poseRef, velocity, 1_rad_per_s);
+    EXPECT_EQ(firstSpeeds.vx, secondSpeeds.vx);
+    EXPECT_EQ(firstSpeeds.omega, secondSpeeds.omega);
+  }
+}
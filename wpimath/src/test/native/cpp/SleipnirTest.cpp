@@ -24,3 +24,65 @@ TEST(SleipnirTest, Quartic) {
 
   EXPECT_NEAR(x.Value(), 1.0, 1e-6);
 }
+
+TEST(SleipnirTest, ReuseWithParametersAndWarmStart) {
+  // Double integrator MPC that drives the position to zero with bounded
+  // acceleration, solved repeatedly from a new initial state
+  constexpr int N = 20;
+  constexpr double dt = 0.05;
+
+  sleipnir::OptimizationProblem problem;
+  auto X = problem.DecisionVariable(2, N + 1);
+  auto U = problem.DecisionVariable(1, N);
+  sleipnir::VariableMatrix x0(2);
+
+  problem.SubjectTo(X.Col(0) == x0);
+  for (int k = 0; k < N; ++k) {
+    problem.SubjectTo(X(0, k + 1) == X(0, k) + X(1, k) * dt);
+    problem.SubjectTo(X(1, k + 1) == X(1, k) + U(0, k) * dt);
+    problem.SubjectTo(U(0, k) >= -1);
+    problem.SubjectTo(U(0, k) <= 1);
+  }
+  sleipnir::Variable J = 0.0;
+  for (int k = 0; k < N + 1; ++k) {
+    J += X(0, k) * X(0, k) + 0.1 * X(1, k) * X(1, k);
+  }
+  problem.Minimize(J);
+
+  int iterations = 0;
+  problem.Callback([&](const sleipnir::SolverIterationInfo&) { ++iterations; });
+
+  // Runs the MPC for a few timesteps, each time starting from the state the
+  // previous solution predicted for the next timestep, and returns the total
+  // number of solver iterations
+  auto RunMPC = [&](bool warmStart) {
+    x0(0).SetValue(1.0);
+    x0(1).SetValue(0.0);
+    X.SetValue(Eigen::MatrixXd::Zero(2, N + 1));
+    U.SetValue(Eigen::MatrixXd::Zero(1, N));
+
+    int totalIterations = 0;
+    for (int step = 0; step < 10; ++step) {
+      iterations = 0;
+      EXPECT_EQ(problem.Solve({.warmStart = warmStart && step > 0})
+                    .exitCondition,
+                sleipnir::SolverExitCondition::kSuccess);
+      totalIterations += iterations;
+
+      // The parameter update is reflected in the solution
+      EXPECT_NEAR(X.Value(0, 0), x0(0).Value(), 1e-8);
+      EXPECT_NEAR(X.Value(1, 0), x0(1).Value(), 1e-8);
+
+      x0(0).SetValue(X.Value(0, 1));
+      x0(1).SetValue(X.Value(1, 1));
+    }
+    return totalIterations;
+  };
+
+  int coldIterations = RunMPC(false);
+  Eigen::MatrixXd coldU = U.Value();
+
+  int warmIterations = RunMPC(true);
+  EXPECT_TRUE(U.Value().isApprox(coldU, 1e-4));
+  EXPECT_LT(warmIterations, coldIterations);
+}
@@ -49,6 +49,46 @@ frc::Vectord<5> Dynamics(const frc::Vectord<5>& x, const frc::Vectord<2>& u) {
           k1.value() * ((C1 * vr).value() + (C2 * Vr).value())};
 }
 
+// Dynamics() templated on the scalar type, for autodiff Jacobians
+struct AutodiffDynamics {
+  template <typename T>
+  Eigen::Matrix<T, 5, 1> operator()(const Eigen::Matrix<T, 5, 1>& x,
+                                    const Eigen::Matrix<T, 2, 1>& u) const {
+    using std::cos;
+    using std::sin;
+
+    auto motors = frc::DCMotor::CIM(2);
+
+    constexpr double Ghigh = 7.08;       // High gear ratio
+    constexpr auto rb = 0.8382_m / 2.0;  // Robot radius
+    constexpr auto r = 0.0746125_m;      // Wheel radius
+    constexpr auto m = 63.503_kg;        // Robot mass
+    constexpr auto J = 5.6_kg_sq_m;      // Robot moment of inertia
+
+    double C1 = (-std::pow(Ghigh, 2) * motors.Kt /
+                 (motors.Kv * motors.R * units::math::pow<2>(r)))
+                    .value();
+    double C2 = (Ghigh * motors.Kt / (motors.R * r)).value();
+    double k1 = (1 / m + units::math::pow<2>(rb) / J).value();
+    double k2 = (1 / m - units::math::pow<2>(rb) / J).value();
+
+    T v = 0.5 * (x(3) + x(4));
+    return Eigen::Matrix<T, 5, 1>{
+        v * cos(x(2)), v * sin(x(2)), (x(4) - x(3)) / (2.0 * rb.value()),
+        k1 * (C1 * x(3) + C2 * u(0)) + k2 * (C1 * x(4) + C2 * u(1)),
+        k2 * (C1 * x(3) + C2 * u(0)) + k1 * (C1 * x(4) + C2 * u(1))};
+  }
+};
+
+struct AutodiffLocalMeasurementModel {
+  template <typename T>
+  Eigen::Matrix<T, 3, 1> operator()(
+      const Eigen::Matrix<T, 5, 1>& x,
+      [[maybe_unused]] const Eigen::Matrix<T, 2, 1>& u) const {
+    return Eigen::Matrix<T, 3, 1>{x(2), x(3), x(4)};
+  }
+};
+
 frc::Vectord<3> LocalMeasurementModel(
     const frc::Vectord<5>& x, [[maybe_unused]] const frc::Vectord<2>& u) {
   return frc::Vectord<3>{x(2), x(3), x(4)};
@@ -146,3 +186,40 @@ TEST(ExtendedKalmanFilterTest, Convergence) {
   ASSERT_NEAR(0.0, observer.Xhat(3), 1.0);
   ASSERT_NEAR(0.0, observer.Xhat(4), 1.0);
 }
+
+TEST(ExtendedKalmanFilterTest, Autodiff) {
+  constexpr auto dt = 0.00505_s;
+
+  frc::ExtendedKalmanFilter<5, 2, 3> numerical{Dynamics,
+                                               LocalMeasurementModel,
+                                               {0.5, 0.5, 10.0, 1.0, 1.0},
+                                               {0.0001, 0.5, 0.5},
+                                               dt};
+  frc::ExtendedKalmanFilter<5, 2, 3> autodiff{AutodiffDynamics{},
+                                              AutodiffLocalMeasurementModel{},
+                                              {0.5, 0.5, 10.0, 1.0, 1.0},
+                                              {0.0001, 0.5, 0.5},
+                                              dt};
+  EXPECT_TRUE(autodiff.P().isApprox(numerical.P(), 1e-6));
+
+  frc::Vectord<5> x{1.0, 2.0, 0.5, 0.0, 0.0};
+  numerical.SetXhat(x);
+  autodiff.SetXhat(x);
+
+  frc::Vectord<2> u{6.0, 8.0};
+  for (int i = 0; i < 100; ++i) {
+    x = frc::RK4(Dynamics, x, u, dt);
+    auto y = LocalMeasurementModel(x, u);
+
+    numerical.Predict(u, dt);
+    numerical.Correct(u, y);
+    autodiff.Predict(u, dt);
+    autodiff.Correct(u, y);
+  }
+
+  EXPECT_TRUE(autodiff.Xhat().isApprox(numerical.Xhat(), 1e-6));
+  EXPECT_TRUE(autodiff.P().isApprox(numerical.P(), 1e-6));
+  EXPECT_NEAR(x(2), autodiff.Xhat(2), 1e-3);
+  EXPECT_NEAR(x(3), autodiff.Xhat(3), 0.1);
+  EXPECT_NEAR(x(4), autodiff.Xhat(4), 0.1);
+}
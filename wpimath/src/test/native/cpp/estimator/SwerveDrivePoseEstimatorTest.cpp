@@ -2,8 +2,10 @@
 // Open Source Software; you can modify and/or share it under the terms of
 // the WPILib BSD license file in the root directory of this project.
 
+#include <array>
 #include <limits>
 #include <numbers>
+#include <optional>
 #include <random>
 #include <tuple>
 #include <vector>
@@ -385,6 +387,57 @@ TEST(SwerveDrivePoseEstimatorTest, TestSampleAt) {
             estimator.SampleAt(2.5_s));
 }
 
+TEST(SwerveDrivePoseEstimatorTest, BatchVisionMeasurements) {
+  frc::SwerveDriveKinematics<4> kinematics{
+      frc::Translation2d{1_m, 1_m}, frc::Translation2d{1_m, -1_m},
+      frc::Translation2d{-1_m, -1_m}, frc::Translation2d{-1_m, 1_m}};
+  wpi::array<frc::SwerveModulePosition, 4> initialPositions{
+      frc::SwerveModulePosition{}, frc::SwerveModulePosition{},
+      frc::SwerveModulePosition{}, frc::SwerveModulePosition{}};
+  frc::SwerveDrivePoseEstimator<4> batch{
+      kinematics,      frc::Rotation2d{}, initialPositions,
+      frc::Pose2d{},   {1.0, 1.0, 1.0},   {1.0, 1.0, 1.0}};
+  frc::SwerveDrivePoseEstimator<4> inOrder{
+      kinematics,      frc::Rotation2d{}, initialPositions,
+      frc::Pose2d{},   {1.0, 1.0, 1.0},   {1.0, 1.0, 1.0}};
+  frc::SwerveDrivePoseEstimator<4> outOfOrder{
+      kinematics,      frc::Rotation2d{}, initialPositions,
+      frc::Pose2d{},   {1.0, 1.0, 1.0},   {1.0, 1.0, 1.0}};
+  for (auto* estimator : {&batch, &inOrder, &outOfOrder}) {
+    for (double time = 1; time <= 2 + 1e-9; time += 0.02) {
+      frc::SwerveModulePosition position{units::meter_t{time},
+                                         frc::Rotation2d{}};
+      estimator->UpdateWithTime(units::second_t{time}, frc::Rotation2d{},
+                                {position, position, position, position});
+    }
+  }
+
+  frc::Pose2d early{1.2_m, 0.2_m, frc::Rotation2d{}};
+  frc::Pose2d late{1.8_m, 0.4_m, frc::Rotation2d{0.1_rad}};
+
+  // Measurements arriving out of order are applied in timestamp order, so the
+  // earlier one doesn't discard the later one
+  std::array<frc::SwerveDrivePoseEstimator<4>::VisionMeasurement, 2>
+      measurements{{{late, 1.8_s, std::nullopt},
+                    {early, 1.2_s, wpi::array{0.5, 0.5, 0.5}}}};
+  batch.AddVisionMeasurements(measurements);
+
+  inOrder.AddVisionMeasurement(early, 1.2_s, {0.5, 0.5, 0.5});
+  inOrder.SetVisionMeasurementStdDevs({1.0, 1.0, 1.0});
+  inOrder.AddVisionMeasurement(late, 1.8_s);
+
+  outOfOrder.AddVisionMeasurement(late, 1.8_s);
+  outOfOrder.AddVisionMeasurement(early, 1.2_s, {0.5, 0.5, 0.5});
+
+  EXPECT_EQ(inOrder.GetEstimatedPosition(), batch.GetEstimatedPosition());
+  EXPECT_NE(outOfOrder.GetEstimatedPosition(), batch.GetEstimatedPosition());
+
+  // The per-measurement standard deviations didn't replace the default ones
+  batch.AddVisionMeasurement(late, 2_s);
+  inOrder.AddVisionMeasurement(late, 2_s);
+  EXPECT_EQ(inOrder.GetEstimatedPosition(), batch.GetEstimatedPosition());
+}
+
 TEST(SwerveDrivePoseEstimatorTest, TestReset) {
   frc::SwerveDriveKinematics<4> kinematics{
       frc::Translation2d{1_m, 1_m}, frc::Translation2d{1_m, -1_m},
@@ -9,7 +9,9 @@
 #include <memory>
 #include <numbers>
 #include <random>
+#include <vector>
 
+#include <Eigen/Core>
 #include <gtest/gtest.h>
 #include <wpi/array.h>
 
@@ -318,3 +320,34 @@ TEST(LinearFilterOutputTest, BackwardFiniteDifference) {
       },
       h, 1.0, 20.0);
 }
+
+/**
+ * Test that filtering several channels at once matches filtering each one
+ * separately.
+ */
+TEST(LinearFilterOutputTest, MultichannelMatchesScalar) {
+  using Channels = Eigen::Array<double, 4, 1>;
+
+  auto multiFilter = frc::LinearFilter<Channels>::HighPass(
+      kHighPassTimeConstant, kFilterStep);
+  std::vector<frc::LinearFilter<double>> filters;
+  for (int i = 0; i < Channels::RowsAtCompileTime; ++i) {
+    filters.push_back(frc::LinearFilter<double>::HighPass(
+        kHighPassTimeConstant, kFilterStep));
+  }
+
+  for (auto t = 0_s; t < kFilterTime; t += kFilterStep) {
+    Channels input;
+    for (int i = 0; i < input.rows(); ++i) {
+      input(i) = std::sin((i + 1) * 2.0 * std::numbers::pi * t.value());
+    }
+
+    Channels output = multiFilter.Calculate(input);
+    for (int i = 0; i < input.rows(); ++i) {
+      EXPECT_DOUBLE_EQ(filters[i].Calculate(input(i)), output(i));
+    }
+  }
+
+  multiFilter.Reset();
+  EXPECT_TRUE((multiFilter.Calculate(Channels::Zero()) == 0.0).all());
+}
@@ -2,6 +2,11 @@
 // Open Source Software; you can modify and/or share it under the terms of
 // the WPILib BSD license file in the root directory of this project.
 
+#include <algorithm>
+#include <deque>
+#include <random>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "frc/filter/MedianFilter.h"
@@ -51,3 +56,32 @@ TEST(MedianFilterTest, MedianFilterFullTestOdd) {
 
   EXPECT_EQ(filter.Calculate(99), 5);
 }
+
+TEST(MedianFilterTest, MedianFilterLargeWindow) {
+  constexpr size_t kSize = 101;
+  frc::MedianFilter<double> filter{kSize};
+
+  std::mt19937 gen{1234};
+  std::uniform_int_distribution<> distr{-50, 50};
+
+  // Compare against sorting a copy of the window every sample. Integer-valued
+  // samples exercise duplicate values.
+  std::deque<double> window;
+  for (int i = 0; i < 1000; ++i) {
+    double next = distr(gen);
+    window.push_back(next);
+    if (window.size() > kSize) {
+      window.pop_front();
+    }
+
+    std::vector<double> sorted(window.begin(), window.end());
+    std::sort(sorted.begin(), sorted.end());
+    double expected = sorted.size() % 2 != 0
+                          ? sorted[sorted.size() / 2]
+                          : (sorted[sorted.size() / 2 - 1] +
+                             sorted[sorted.size() / 2]) /
+                                2.0;
+
+    EXPECT_EQ(expected, filter.Calculate(next));
+  }
+}
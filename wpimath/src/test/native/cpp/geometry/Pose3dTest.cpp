@@ -3,6 +3,7 @@
 // the WPILib BSD license file in the root directory of this project.
 
 #include <cmath>
+#include <stdexcept>
 
 #include <gtest/gtest.h>
 #include <wpi/array.h>
@@ -70,6 +71,32 @@ TEST(Pose3dTest, TransformBy) {
                    units::radian_t{50_deg}.value());
 }
 
+TEST(Pose3dTest, TransformBySpan) {
+  const Pose3d initial{1_m, 2_m, 3_m, Rotation3d{10_deg, -20_deg, 45_deg}};
+  const wpi::array<Transform3d, 4> transforms{
+      Transform3d{Translation3d{0_m, 0.1_m, 0.1_m}, Rotation3d{}},
+      Transform3d{Translation3d{0_m, -0.1_m, 0.1_m}, Rotation3d{}},
+      Transform3d{Translation3d{0_m, -0.1_m, -0.1_m},
+                  Rotation3d{0_deg, 0_deg, 90_deg}},
+      Transform3d{Translation3d{5_m, 0_m, 0_m},
+                  Rotation3d{30_deg, 15_deg, -5_deg}}};
+
+  wpi::array<Pose3d, 4> transformed{wpi::empty_array};
+  initial.TransformBy(transforms, transformed);
+
+  for (size_t i = 0; i < transforms.size(); ++i) {
+    const auto expected = initial.TransformBy(transforms[i]);
+    EXPECT_NEAR(expected.X().value(), transformed[i].X().value(), 1e-12);
+    EXPECT_NEAR(expected.Y().value(), transformed[i].Y().value(), 1e-12);
+    EXPECT_NEAR(expected.Z().value(), transformed[i].Z().value(), 1e-12);
+    EXPECT_EQ(expected.Rotation(), transformed[i].Rotation());
+  }
+
+  wpi::array<Pose3d, 3> tooSmall{wpi::empty_array};
+  EXPECT_THROW(initial.TransformBy(transforms, tooSmall),
+               std::invalid_argument);
+}
+
 TEST(Pose3dTest, RelativeTo) {
   Eigen::Vector3d zAxis{0.0, 0.0, 1.0};
 
@@ -2,6 +2,8 @@
 // Open Source Software; you can modify and/or share it under the terms of
 // the WPILib BSD license file in the root directory of this project.
 
+#include <array>
+
 #include <gtest/gtest.h>
 
 #include "frc/geometry/Translation2d.h"
@@ -24,3 +26,20 @@ TEST(Translation2dStructTest, Roundtrip) {
   EXPECT_EQ(kExpectedData.X(), unpacked_data.X());
   EXPECT_EQ(kExpectedData.Y(), unpacked_data.Y());
 }
+
+TEST(Translation2dStructTest, ArrayRoundtrip) {
+  using ArrayStructType = wpi::Struct<std::array<Translation2d, 3>>;
+  const std::array<Translation2d, 3> expected{
+      kExpectedData, Translation2d{-1_m, 2_m}, Translation2d{}};
+  uint8_t buffer[ArrayStructType::GetSize()];
+  ArrayStructType::Pack(buffer, expected);
+
+  EXPECT_EQ((wpi::UnpackStruct<double, 16>(buffer)), -1.0);
+  EXPECT_EQ((wpi::UnpackStruct<double, 24>(buffer)), 2.0);
+
+  auto unpacked_data = ArrayStructType::Unpack(buffer);
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(expected[i].X(), unpacked_data[i].X());
+    EXPECT_EQ(expected[i].Y(), unpacked_data[i].Y());
+  }
+}
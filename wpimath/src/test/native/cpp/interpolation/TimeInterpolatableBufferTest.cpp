@@ -59,3 +59,51 @@ TEST(TimeInterpolatableBufferTest, Pose2d) {
   EXPECT_TRUE(std::abs(sample.Y().value() - (1.0 / std::sqrt(2.0))) < 0.01);
   EXPECT_TRUE(std::abs(sample.Rotation().Degrees().value() - 45.0) < 0.01);
 }
+
+TEST(TimeInterpolatableBufferTest, ManySamples) {
+  frc::TimeInterpolatableBuffer<double> buffer{1_s};
+
+  // Add several seconds of samples at 200 Hz, with every tenth sample late
+  for (int i = 0; i < 1000; ++i) {
+    if (i % 10 == 9) {
+      buffer.AddSample(units::second_t{(i + 1) * 0.005}, i + 1);
+      buffer.AddSample(units::second_t{i * 0.005}, i);
+      ++i;
+    } else {
+      buffer.AddSample(units::second_t{i * 0.005}, i);
+    }
+  }
+
+  // Only the last second is kept, in order
+  const auto& samples = buffer.GetInternalBuffer();
+  EXPECT_EQ(samples.size(), 201u);
+  for (size_t i = 1; i < samples.size(); ++i) {
+    EXPECT_LT(samples[i - 1].first, samples[i].first);
+  }
+  EXPECT_DOUBLE_EQ(buffer.Sample(4_s).value(), 800.0);
+  EXPECT_DOUBLE_EQ(buffer.Sample(4.0025_s).value(), 800.5);
+}
+
+namespace {
+struct NoDefault {
+  explicit NoDefault(double value) : value{value} {}
+  NoDefault operator+(const NoDefault& rhs) const {
+    return NoDefault{value + rhs.value};
+  }
+  NoDefault operator-(const NoDefault& rhs) const {
+    return NoDefault{value - rhs.value};
+  }
+  NoDefault operator*(double rhs) const { return NoDefault{value * rhs}; }
+  double value;
+};
+}  // namespace
+
+TEST(TimeInterpolatableBufferTest, NotDefaultConstructible) {
+  frc::TimeInterpolatableBuffer<NoDefault> buffer{1_s};
+
+  for (int i = 0; i < 12; ++i) {
+    buffer.AddSample(units::second_t{i * 0.25}, NoDefault{i * 1.0});
+  }
+  EXPECT_EQ(buffer.GetInternalBuffer().size(), 5u);
+  EXPECT_DOUBLE_EQ(buffer.Sample(2.625_s).value().value, 10.5);
+}
@@ -3,6 +3,8 @@
 // the WPILib BSD license file in the root directory of this project.
 
 #include <numbers>
+#include <stdexcept>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -309,3 +311,41 @@ TEST_F(SwerveDriveKinematicsTest, DesaturateNegativeSpeed) {
   EXPECT_NEAR(arr[2].speed.value(), -1.0, kEpsilon);
   EXPECT_NEAR(arr[3].speed.value(), -1.0, kEpsilon);
 }
+
+TEST_F(SwerveDriveKinematicsTest, BatchForwardKinematics) {
+  // more samples than one block, and not a multiple of the block size
+  std::vector<wpi::array<SwerveModuleState, 4>> states;
+  std::vector<wpi::array<SwerveModulePosition, 4>> deltas;
+  for (int i = 0; i < 19; ++i) {
+    units::degree_t angle{i * 10.0};
+    states.push_back({SwerveModuleState{0.5_mps * i, 30_deg},
+                      SwerveModuleState{1_mps, angle},
+                      SwerveModuleState{2_mps, -45_deg},
+                      SwerveModuleState{-1_mps, 90_deg}});
+    deltas.push_back({SwerveModulePosition{0.5_m * i, 30_deg},
+                      SwerveModulePosition{1_m, angle},
+                      SwerveModulePosition{2_m, -45_deg},
+                      SwerveModulePosition{-1_m, 90_deg}});
+  }
+
+  std::vector<ChassisSpeeds> speeds(states.size());
+  m_kinematics.ToChassisSpeeds(states, speeds);
+  std::vector<Twist2d> twists(deltas.size());
+  m_kinematics.ToTwist2d(deltas, twists);
+
+  for (size_t i = 0; i < states.size(); ++i) {
+    auto expectedSpeeds = m_kinematics.ToChassisSpeeds(states[i]);
+    EXPECT_NEAR(speeds[i].vx.value(), expectedSpeeds.vx.value(), 1e-9);
+    EXPECT_NEAR(speeds[i].vy.value(), expectedSpeeds.vy.value(), 1e-9);
+    EXPECT_NEAR(speeds[i].omega.value(), expectedSpeeds.omega.value(), 1e-9);
+
+    auto expectedTwist = m_kinematics.ToTwist2d(deltas[i]);
+    EXPECT_NEAR(twists[i].dx.value(), expectedTwist.dx.value(), 1e-9);
+    EXPECT_NEAR(twists[i].dy.value(), expectedTwist.dy.value(), 1e-9);
+    EXPECT_NEAR(twists[i].dtheta.value(), expectedTwist.dtheta.value(), 1e-9);
+  }
+
+  std::vector<ChassisSpeeds> tooFew(states.size() - 1);
+  EXPECT_THROW(m_kinematics.ToChassisSpeeds(states, tooFew),
+               std::invalid_argument);
+}
@@ -55,3 +55,47 @@ TEST(SimulatedAnnealingTest, DoubleFunctionOptimizationMultimodal) {
 
   EXPECT_NEAR(5.146, solution, 1e-1);
 }
+
+TEST(SimulatedAnnealingTest, DoubleFunctionOptimizationParallelSeeded) {
+  auto function = [](double x) {
+    return std::sin(x) + std::sin((10.0 / 3.0) * x);
+  };
+
+  constexpr double stepSize = 10.0;
+
+  frc::SimulatedAnnealing<double> simulatedAnnealing{
+      2.0,
+      [&](const double& x, std::mt19937& gen) {
+        std::uniform_real_distribution<> distr{0.0, 1.0};
+        return std::clamp(x + (distr(gen) - 0.5) * stepSize, 0.0, 7.0);
+      },
+      [&](const double& x) { return function(x); }};
+  simulatedAnnealing.SetChains(4);
+  simulatedAnnealing.SetSeed(1234);
+
+  double solution = simulatedAnnealing.Solve(-1.0, 5000);
+  EXPECT_NEAR(5.146, solution, 1e-1);
+
+  // The same seed gives the same solution
+  EXPECT_EQ(solution, simulatedAnnealing.Solve(-1.0, 5000));
+}
+
+TEST(SimulatedAnnealingTest, DoubleFunctionOptimizationTimeLimit) {
+  auto function = [](double x) {
+    return std::sin(x) + std::sin((10.0 / 3.0) * x);
+  };
+
+  constexpr double stepSize = 10.0;
+
+  frc::SimulatedAnnealing<double> simulatedAnnealing{
+      2.0,
+      [&](const double& x, std::mt19937& gen) {
+        std::uniform_real_distribution<> distr{0.0, 1.0};
+        return std::clamp(x + (distr(gen) - 0.5) * stepSize, 0.0, 7.0);
+      },
+      [&](const double& x) { return function(x); }};
+  simulatedAnnealing.SetChains(2);
+
+  double solution = simulatedAnnealing.Solve(-1.0, 5_ms);
+  EXPECT_NEAR(5.146, solution, 1e-1);
+}
@@ -142,3 +142,50 @@ TEST(TravelingSalesmanTest, TenLengthDynamicPathWithDistanceCost) {
 
   EXPECT_TRUE(IsMatchingCycle(expected, solution));
 }
+
+TEST(TravelingSalesmanTest, TenLengthParallelSeededPathWithTimeLimit) {
+  // ....6.3..1.2.......
+  // ..4................
+  // .............9.....
+  // .0.................
+  // .....7..5...8......
+  // ...................
+  wpi::array<frc::Pose2d, 10> poses{
+      frc::Pose2d{2_m, 4_m, 0_rad},  frc::Pose2d{10_m, 1_m, 0_rad},
+      frc::Pose2d{12_m, 1_m, 0_rad}, frc::Pose2d{7_m, 1_m, 0_rad},
+      frc::Pose2d{3_m, 2_m, 0_rad},  frc::Pose2d{9_m, 5_m, 0_rad},
+      frc::Pose2d{5_m, 1_m, 0_rad},  frc::Pose2d{6_m, 5_m, 0_rad},
+      frc::Pose2d{13_m, 5_m, 0_rad}, frc::Pose2d{14_m, 3_m, 0_rad}};
+
+  frc::TravelingSalesman traveler;
+  traveler.SetChains(4);
+  traveler.SetSeed(1234);
+  wpi::array<frc::Pose2d, 10> solution = traveler.Solve(poses, 5_ms);
+
+  wpi::array<frc::Pose2d, 10> expected{poses[0], poses[4], poses[6], poses[3],
+                                       poses[1], poses[2], poses[9], poses[8],
+                                       poses[5], poses[7]};
+
+  EXPECT_TRUE(IsMatchingCycle(expected, solution));
+}
+
+TEST(TravelingSalesmanTest, SeededSolveIsRepeatable) {
+  wpi::array<frc::Pose2d, 10> poses{
+      frc::Pose2d{2_m, 4_m, 0_rad},  frc::Pose2d{10_m, 1_m, 0_rad},
+      frc::Pose2d{12_m, 1_m, 0_rad}, frc::Pose2d{7_m, 1_m, 0_rad},
+      frc::Pose2d{3_m, 2_m, 0_rad},  frc::Pose2d{9_m, 5_m, 0_rad},
+      frc::Pose2d{5_m, 1_m, 0_rad},  frc::Pose2d{6_m, 5_m, 0_rad},
+      frc::Pose2d{13_m, 5_m, 0_rad}, frc::Pose2d{14_m, 3_m, 0_rad}};
+
+  frc::TravelingSalesman traveler;
+  traveler.SetChains(3);
+  traveler.SetSeed(42);
+
+  // Too few iterations to reliably find the optimum, so any nondeterminism
+  // would show up as different paths
+  auto first = traveler.Solve(poses, 5);
+  auto second = traveler.Solve(poses, 5);
+  for (size_t i = 0; i < poses.size(); ++i) {
+    EXPECT_EQ(first[i], second[i]);
+  }
+}
@@ -0,0 +1,109 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "frc/system/AutodiffJacobian.h"
+#include "frc/system/NumericalJacobian.h"
+
+namespace {
+
+frc::Matrixd<4, 4> A{{1, 2, 4, 1}, {5, 2, 3, 4}, {5, 1, 3, 2}, {1, 1, 3, 7}};
+frc::Matrixd<4, 2> B{{1, 1}, {2, 1}, {3, 2}, {3, 7}};
+
+// Function from which to recover A and B
+struct AxBuFn {
+  template <typename T>
+  Eigen::Matrix<T, 4, 1> operator()(const Eigen::Matrix<T, 4, 1>& x,
+                                    const Eigen::Matrix<T, 2, 1>& u) const {
+    return A * x + B * u;
+  }
+};
+
+// Nonlinear function to compare against the numerical Jacobian
+struct NonlinearFn {
+  template <typename T>
+  Eigen::Matrix<T, 3, 1> operator()(const Eigen::Matrix<T, 3, 1>& x,
+                                    const Eigen::Matrix<T, 2, 1>& u) const {
+    using std::atan2;
+    using std::cos;
+    using std::exp;
+    using std::sin;
+    using std::sqrt;
+    return Eigen::Matrix<T, 3, 1>{x(2) * cos(x(0)) * u(0),
+                                  sin(x(1)) / x(2) + exp(u(1) * x(0)),
+                                  atan2(x(1), x(0)) + sqrt(x(2) * x(2) + 1.0)};
+  }
+};
+
+}  // namespace
+
+TEST(AutodiffJacobianTest, Ax) {
+  frc::Matrixd<4, 4> newA = frc::AutodiffJacobianX<4, 4, 2>(
+      AxBuFn{}, frc::Vectord<4>::Zero(), frc::Vectord<2>::Zero());
+  EXPECT_TRUE(newA.isApprox(A));
+}
+
+TEST(AutodiffJacobianTest, Bu) {
+  frc::Matrixd<4, 2> newB = frc::AutodiffJacobianU<4, 4, 2>(
+      AxBuFn{}, frc::Vectord<4>::Zero(), frc::Vectord<2>::Zero());
+  EXPECT_TRUE(newB.isApprox(B));
+}
+
+TEST(AutodiffJacobianTest, Nonlinear) {
+  frc::Vectord<3> x{0.3, -1.2, 2.5};
+  frc::Vectord<2> u{1.5, -0.7};
+  auto f = [](const frc::Vectord<3>& x, const frc::Vectord<2>& u) {
+    return NonlinearFn{}(x, u);
+  };
+
+  frc::Matrixd<3, 3> dfdx =
+      frc::AutodiffJacobianX<3, 3, 2>(NonlinearFn{}, x, u);
+  EXPECT_TRUE(dfdx.isApprox(frc::NumericalJacobianX<3, 3, 2>(f, x, u), 1e-8));
+
+  frc::Matrixd<3, 2> dfdu =
+      frc::AutodiffJacobianU<3, 3, 2>(NonlinearFn{}, x, u);
+  EXPECT_TRUE(dfdu.isApprox(frc::NumericalJacobianU<3, 3, 2>(f, x, u), 1e-8));
+}
+
+TEST(AutodiffJacobianTest, Dual) {
+  using Dual = frc::Dual<2>;
+  Dual x = Dual::Variable(3.0, 0);
+  Dual y = Dual::Variable(4.0, 1);
+
+  // d/dx x²y = 2xy, d/dy x²y = x²
+  Dual z = x * x * y;
+  EXPECT_DOUBLE_EQ(36.0, z.value);
+  EXPECT_DOUBLE_EQ(24.0, z.grad(0));
+  EXPECT_DOUBLE_EQ(9.0, z.grad(1));
+
+  // d/dx x/y = 1/y, d/dy x/y = -x/y²
+  z = x / y;
+  EXPECT_DOUBLE_EQ(0.75, z.value);
+  EXPECT_DOUBLE_EQ(0.25, z.grad(0));
+  EXPECT_DOUBLE_EQ(-3.0 / 16.0, z.grad(1));
+
+  // d/dx 1/x = -1/x²
+  z = 1.0 / x;
+  EXPECT_DOUBLE_EQ(-1.0 / 9.0, z.grad(0));
+  EXPECT_DOUBLE_EQ(0.0, z.grad(1));
+
+  z = hypot(x, y);
+  EXPECT_DOUBLE_EQ(5.0, z.value);
+  EXPECT_DOUBLE_EQ(0.6, z.grad(0));
+  EXPECT_DOUBLE_EQ(0.8, z.grad(1));
+
+  // d/dx xʸ = yxʸ⁻¹, d/dy xʸ = xʸ ln(x)
+  z = pow(x, y);
+  EXPECT_DOUBLE_EQ(81.0, z.value);
+  EXPECT_DOUBLE_EQ(108.0, z.grad(0));
+  EXPECT_DOUBLE_EQ(81.0 * std::log(3.0), z.grad(1));
+
+  EXPECT_TRUE(x < y);
+  EXPECT_TRUE(x == 3.0);
+  EXPECT_DOUBLE_EQ(3.0, abs(-x).value);
+  EXPECT_DOUBLE_EQ(1.0, abs(-x).grad(0));
+}
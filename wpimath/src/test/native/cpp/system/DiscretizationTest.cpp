@@ -9,6 +9,7 @@
 
 #include "frc/EigenCore.h"
 #include "frc/system/Discretization.h"
+#include "frc/system/LinearSystem.h"
 #include "frc/system/NumericalIntegration.h"
 
 // Check that for a simple second-order system that we can easily analyze
@@ -125,3 +126,25 @@ TEST(DiscretizationTest, DiscretizeR) {
       << discR << "\ndiscRTruth:\n"
       << discRTruth;
 }
+
+// Test that cached discretizations match discretizing each time, including
+// after cache entries are replaced
+TEST(DiscretizationTest, LinearSystemCache) {
+  frc::Matrixd<2, 2> contA{{0, 1}, {0, -2}};
+  frc::Matrixd<2, 1> contB{{0}, {1}};
+  frc::LinearSystem<2, 1, 1> plant{contA, contB, frc::Matrixd<1, 2>{{1, 0}},
+                                   frc::Matrixd<1, 1>{{0}}};
+
+  frc::Vectord<2> x{1, 2};
+  frc::Vectord<1> u{3};
+  frc::LinearSystem<2, 1, 1>::DiscreteABCache cache;
+  for (int i = 0; i < 3; ++i) {
+    for (auto dt : {5_ms, 10_ms, 20_ms, 21_ms, 19_ms, 20_ms}) {
+      frc::Matrixd<2, 2> discA;
+      frc::Matrixd<2, 1> discB;
+      frc::DiscretizeAB<2, 1>(contA, contB, dt, &discA, &discB);
+
+      EXPECT_EQ(discA * x + discB * u, plant.CalculateX(x, u, dt, cache));
+    }
+  }
+}
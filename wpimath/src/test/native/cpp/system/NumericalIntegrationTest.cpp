@@ -94,3 +94,32 @@ TEST(NumericalIntegrationTest, RKDPTimeVarying) {
   EXPECT_NEAR(y1(0), 12.0 * std::exp(6.0) / std::pow(std::exp(6.0) + 1.0, 2.0),
               1e-3);
 }
+
+// Tests that reusing the RKDP step size across calls gives the same solution
+// with fewer function evaluations
+TEST(NumericalIntegrationTest, RKDPReusedStepSize) {
+  int evaluations = 0;
+  auto f = [&](const frc::Vectord<1>& x, const frc::Vectord<1>& u) {
+    ++evaluations;
+    return frc::Vectord<1>{-200.0 * x(0) + u(0)};
+  };
+
+  frc::Vectord<1> x{1.0};
+  for (int i = 0; i < 50; ++i) {
+    x = frc::RKDP(f, x, frc::Vectord<1>{100.0}, 20_ms);
+  }
+  int defaultEvaluations = evaluations;
+
+  evaluations = 0;
+  frc::Vectord<1> reusedX{1.0};
+  units::second_t stepSize = 0_s;
+  for (int i = 0; i < 50; ++i) {
+    reusedX =
+        frc::RKDP(f, reusedX, frc::Vectord<1>{100.0}, 20_ms, 1e-6, &stepSize);
+  }
+
+  EXPECT_NEAR(x(0), 0.5, 1e-6);
+  EXPECT_NEAR(reusedX(0), 0.5, 1e-6);
+  EXPECT_GT(stepSize, 0_s);
+  EXPECT_LT(evaluations, defaultEvaluations);
+}
@@ -0,0 +1,97 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "frc/trajectory/OptimalTrajectoryGenerator.h"
+#include "units/math.h"
+
+using namespace frc;
+
+namespace {
+
+void ExpectEndpoints(const Trajectory& trajectory,
+                     const std::vector<Pose2d>& waypoints) {
+  const auto& states = trajectory.States();
+  EXPECT_NEAR(states.front().pose.X().value(), waypoints.front().X().value(),
+              1e-6);
+  EXPECT_NEAR(states.front().pose.Y().value(), waypoints.front().Y().value(),
+              1e-6);
+  EXPECT_NEAR(states.back().pose.X().value(), waypoints.back().X().value(),
+              1e-6);
+  EXPECT_NEAR(states.back().pose.Y().value(), waypoints.back().Y().value(),
+              1e-6);
+  EXPECT_NEAR(states.front().velocity.value(), 0.0, 1e-6);
+  EXPECT_NEAR(states.back().velocity.value(), 0.0, 1e-6);
+}
+
+}  // namespace
+
+TEST(OptimalTrajectoryGeneratorTest, Swerve) {
+  const OptimalTrajectoryGenerator::SwerveDrivetrain drivetrain{
+      .mass = 60_kg,
+      .wheelRadius = 2_in,
+      .driveMotor = DCMotor::KrakenX60(),
+      .gearing = 6.75,
+      .currentLimit = 60_A};
+  const std::vector<Pose2d> waypoints{{0_m, 0_m, 0_deg},
+                                      {2_m, 1_m, 45_deg},
+                                      {4_m, 1_m, 0_deg}};
+
+  auto result =
+      OptimalTrajectoryGenerator::GenerateSwerveTrajectory(waypoints,
+                                                           drivetrain);
+  ASSERT_TRUE(result.optimal);
+  ExpectEndpoints(result.trajectory, waypoints);
+
+  // The free speed is about 4.9 m/s
+  for (const auto& state : result.trajectory.States()) {
+    EXPECT_LT(units::math::abs(state.velocity), 5_mps);
+  }
+
+  // Not limiting the acceleration to what the motors can do at top speed is
+  // faster than the spline trajectory
+  auto warmStart = OptimalTrajectoryGenerator::GenerateSwerveTrajectory(
+      waypoints, drivetrain, {.maxIterations = 0});
+  EXPECT_FALSE(warmStart.optimal);
+  EXPECT_LT(result.trajectory.TotalTime(), warmStart.trajectory.TotalTime());
+}
+
+TEST(OptimalTrajectoryGeneratorTest, Differential) {
+  const OptimalTrajectoryGenerator::DifferentialDrivetrain drivetrain{
+      .mass = 60_kg,
+      .moi = 6_kg_sq_m,
+      .wheelRadius = 3_in,
+      .trackwidth = 0.6_m,
+      .driveMotor = DCMotor::NEO(2),
+      .gearing = 8.0};
+  const std::vector<Pose2d> waypoints{{0_m, 0_m, 0_deg},
+                                      {2_m, 1_m, 90_deg},
+                                      {0_m, 2_m, 180_deg}};
+
+  auto result = OptimalTrajectoryGenerator::GenerateDifferentialTrajectory(
+      waypoints, drivetrain);
+  ASSERT_TRUE(result.optimal);
+  ExpectEndpoints(result.trajectory, waypoints);
+
+  // Passes through the interior waypoint with its heading
+  bool passed = false;
+  for (const auto& state : result.trajectory.States()) {
+    if (state.pose.Translation().Distance(waypoints[1].Translation()) <
+        1e-6_m) {
+      passed = true;
+      EXPECT_NEAR(state.pose.Rotation().Degrees().value(), 90.0, 1e-4);
+    }
+  }
+  EXPECT_TRUE(passed);
+  EXPECT_NEAR(
+      result.trajectory.States().back().pose.Rotation().Degrees().value(),
+      180.0, 1e-4);
+
+  auto warmStart = OptimalTrajectoryGenerator::GenerateDifferentialTrajectory(
+      waypoints, drivetrain, {.maxIterations = 0});
+  EXPECT_LT(result.trajectory.TotalTime(), warmStart.trajectory.TotalTime());
+}
@@ -2,13 +2,21 @@
 // Open Source Software; you can modify and/or share it under the terms of
 // the WPILib BSD license file in the root directory of this project.
 
+#include <initializer_list>
 #include <vector>
 
 #include <gtest/gtest.h>
 
+#include "frc/kinematics/DifferentialDriveKinematics.h"
+#include "frc/kinematics/SwerveDriveKinematics.h"
+#include "frc/spline/SplineHelper.h"
 #include "frc/trajectory/Trajectory.h"
 #include "frc/trajectory/TrajectoryGenerator.h"
 #include "frc/trajectory/constraint/CentripetalAccelerationConstraint.h"
+#include "frc/trajectory/constraint/DifferentialDriveKinematicsConstraint.h"
+#include "frc/trajectory/constraint/MaxVelocityConstraint.h"
+#include "frc/trajectory/constraint/RectangularRegionConstraint.h"
+#include "frc/trajectory/constraint/SwerveDriveKinematicsConstraint.h"
 #include "frc/trajectory/constraint/TrajectoryConstraint.h"
 #include "trajectory/TestTrajectory.h"
 #include "units/math.h"
@@ -55,3 +63,69 @@ TEST(TrajectoryGenerationTest, CurvatureOptimization) {
     EXPECT_NE(0, t.States()[i].curvature.value());
   }
 }
+
+TEST(TrajectoryGenerationTest, SegmentCacheAndThreads) {
+  std::vector<Pose2d> waypoints{{0_m, 0_m, 0_deg},   {2_m, 1_m, 30_deg},
+                                {4_m, 1_m, -30_deg}, {6_m, 0_m, 0_deg},
+                                {8_m, 1_m, 45_deg},  {10_m, 2_m, 0_deg}};
+  TrajectoryConfig config{12_fps, 12_fps_sq};
+  const auto expected =
+      TrajectoryGenerator::GenerateTrajectory(waypoints, config);
+
+  TrajectoryGenerator::SetMaxThreads(4);
+  TrajectoryGenerator::SegmentCache cache;
+  auto t = TrajectoryGenerator::GenerateTrajectory(waypoints, config, &cache);
+  EXPECT_EQ(t, expected);
+  EXPECT_EQ(cache.GetHits(), 0u);
+  EXPECT_EQ(cache.GetMisses(), 5u);
+
+  // Regenerating the same path is served entirely from the cache
+  t = TrajectoryGenerator::GenerateTrajectory(waypoints, config, &cache);
+  EXPECT_EQ(t, expected);
+  EXPECT_EQ(cache.GetHits(), 5u);
+
+  // Moving the last waypoint only reparameterizes the segments whose shape
+  // changed (the last one, and the one before it since curvature optimization
+  // adjusts the shared heading)
+  waypoints.back() = Pose2d{10_m, 3_m, 0_deg};
+  t = TrajectoryGenerator::GenerateTrajectory(waypoints, config, &cache);
+  EXPECT_EQ(t, TrajectoryGenerator::GenerateTrajectory(waypoints, config));
+  EXPECT_EQ(cache.GetHits(), 8u);
+  EXPECT_EQ(cache.GetMisses(), 7u);
+  TrajectoryGenerator::SetMaxThreads(1);
+}
+
+TEST(TrajectoryGenerationTest, BatchConstraintsMatchPerPoint) {
+  const auto points = TrajectoryGenerator::SplinePointsFromSplines(
+      SplineHelper::QuinticSplinesFromWaypoints({{0_m, 0_m, 0_deg},
+                                                 {2_m, 1_m, 90_deg},
+                                                 {0_m, 2_m, 180_deg},
+                                                 {-1_m, 0_m, -45_deg}}));
+
+  const SwerveDriveKinematics<4> swerveKinematics{
+      Translation2d{0.3_m, 0.3_m}, Translation2d{0.3_m, -0.3_m},
+      Translation2d{-0.3_m, 0.3_m}, Translation2d{-0.3_m, -0.3_m}};
+  const CentripetalAccelerationConstraint centripetal{2_mps_sq};
+  const DifferentialDriveKinematicsConstraint differential{
+      DifferentialDriveKinematics{0.6_m}, 2_mps};
+  const SwerveDriveKinematicsConstraint<4> swerve{swerveKinematics, 2_mps};
+  const RectangularRegionConstraint<MaxVelocityConstraint> region{
+      Rectangle2d{Translation2d{0_m, 0_m}, Translation2d{1_m, 1_m}},
+      MaxVelocityConstraint{0.5_mps}};
+
+  for (const TrajectoryConstraint* constraint :
+       std::initializer_list<const TrajectoryConstraint*>{
+           &centripetal, &differential, &swerve, &region}) {
+    for (auto velocity : {1_mps, 3_mps}) {
+      std::vector<units::meters_per_second_t> maxVelocities(points.size());
+      constraint->MaxVelocities(points, velocity, maxVelocities);
+      for (size_t i = 0; i < points.size(); ++i) {
+        auto expected = units::math::min(
+            velocity, constraint->MaxVelocity(points[i].first,
+                                              points[i].second, velocity));
+        EXPECT_NEAR(units::math::min(velocity, maxVelocities[i]).value(),
+                    expected.value(), 1e-9);
+      }
+    }
+  }
+}
@@ -0,0 +1,70 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <gtest/gtest.h>
+
+#include "frc/trajectory/CompactTrajectory.h"
+#include "frc/trajectory/TrajectoryConfig.h"
+#include "frc/trajectory/TrajectoryGenerator.h"
+
+namespace {
+
+frc::Trajectory GetTrajectory() {
+  return frc::TrajectoryGenerator::GenerateTrajectory(
+      {}, {{1_m, 1_m}}, {3_m, 0_m, -45_deg}, {3_mps, 2_mps_sq});
+}
+
+void ExpectNear(const frc::Trajectory::State& expected,
+                const frc::Trajectory::State& actual, double tolerance) {
+  EXPECT_NEAR(expected.t.value(), actual.t.value(), tolerance);
+  EXPECT_NEAR(expected.velocity.value(), actual.velocity.value(), tolerance);
+  EXPECT_NEAR(expected.acceleration.value(), actual.acceleration.value(),
+              tolerance);
+  EXPECT_NEAR(expected.pose.X().value(), actual.pose.X().value(), tolerance);
+  EXPECT_NEAR(expected.pose.Y().value(), actual.pose.Y().value(), tolerance);
+  EXPECT_NEAR(expected.pose.Rotation().Radians().value(),
+              actual.pose.Rotation().Radians().value(), tolerance);
+  EXPECT_NEAR(expected.curvature.value(), actual.curvature.value(), tolerance);
+}
+
+}  // namespace
+
+TEST(TrajectorySampleTest, Cursor) {
+  auto trajectory = GetTrajectory();
+
+  // monotone playback, including samples between and on states
+  size_t cursor = 0;
+  for (auto t = -0.1_s; t < trajectory.TotalTime() + 0.1_s; t += 4_ms) {
+    EXPECT_EQ(trajectory.Sample(t), trajectory.Sample(t, cursor));
+  }
+  for (auto&& state : trajectory.States()) {
+    EXPECT_EQ(trajectory.Sample(state.t), trajectory.Sample(state.t, cursor));
+  }
+
+  // going back in time
+  for (auto t = trajectory.TotalTime(); t > 0_s; t -= 0.3_s) {
+    EXPECT_EQ(trajectory.Sample(t), trajectory.Sample(t, cursor));
+  }
+}
+
+TEST(TrajectorySampleTest, Compact) {
+  auto trajectory = GetTrajectory();
+  frc::CompactTrajectory compact{trajectory};
+
+  ASSERT_EQ(trajectory.States().size(), compact.Size());
+  EXPECT_NEAR(trajectory.TotalTime().value(), compact.TotalTime().value(),
+              1e-6);
+  for (size_t i = 0; i < compact.Size(); ++i) {
+    ExpectNear(trajectory.States()[i], compact.GetState(i), 1e-5);
+  }
+
+  size_t cursor = 0;
+  for (auto t = -0.1_s; t < trajectory.TotalTime() + 0.1_s; t += 4_ms) {
+    ExpectNear(trajectory.Sample(t), compact.Sample(t, cursor), 1e-4);
+    EXPECT_EQ(compact.Sample(t), compact.Sample(t, cursor));
+  }
+
+  EXPECT_EQ(trajectory.States().size(),
+            compact.ToTrajectory().States().size());
+}
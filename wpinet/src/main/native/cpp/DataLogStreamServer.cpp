@@ -0,0 +1,403 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpinet/DataLogStreamServer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <wpi/DataLog.h>
+#include <wpi/DenseMap.h>
+#include <wpi/Endian.h>
+#include <wpi/mutex.h>
+#include <wpi/print.h>
+
+#include "wpinet/EventLoopRunner.h"
+#include "wpinet/uv/Async.h"
+#include "wpinet/uv/Buffer.h"
+#include "wpinet/uv/Tcp.h"
+
+using namespace wpi;
+
+namespace {
+
+using Data = std::shared_ptr<const std::vector<uint8_t>>;
+
+// a run of complete records
+struct Chunk {
+  uint64_t pos;  // position in the stream (excluding the header)
+  Data data;
+};
+
+// state needed to read an entry's data records
+struct EntryState {
+  std::vector<uint8_t> start;
+  std::vector<uint8_t> metadata;
+  std::vector<uint8_t> schemaData;
+  bool schema = false;
+};
+
+struct Record {
+  uint32_t entry;
+  std::span<const uint8_t> payload;
+  size_t size;  // including header
+};
+
+// parses the record at the start of buf; returns false if incomplete
+bool ParseRecord(std::span<const uint8_t> buf, Record* record) {
+  if (buf.empty()) {
+    return false;
+  }
+  unsigned int entryLen = (buf[0] & 0x3) + 1;
+  unsigned int sizeLen = ((buf[0] >> 2) & 0x3) + 1;
+  unsigned int timestampLen = ((buf[0] >> 4) & 0x7) + 1;
+  size_t headerLen = 1 + entryLen + sizeLen + timestampLen;
+  if (buf.size() < headerLen) {
+    return false;
+  }
+  uint32_t entry = 0;
+  for (unsigned int i = 0; i < entryLen; ++i) {
+    entry |= static_cast<uint32_t>(buf[1 + i]) << (8 * i);
+  }
+  uint32_t size = 0;
+  for (unsigned int i = 0; i < sizeLen; ++i) {
+    size |= static_cast<uint32_t>(buf[1 + entryLen + i]) << (8 * i);
+  }
+  if (buf.size() - headerLen < size) {
+    return false;
+  }
+  record->entry = entry;
+  record->payload = buf.subspan(headerLen, size);
+  record->size = headerLen + size;
+  return true;
+}
+
+// The data of one log (from the header to the end of the log).  Accessed with
+// the server mutex held.
+class LogStream {
+ public:
+  explicit LogStream(size_t bufferSize) : m_bufferSize{bufferSize} {}
+
+  // returns true if the data added any chunks
+  bool Append(std::span<const uint8_t> data);
+
+  bool IsStarted() const {
+    return m_headerSize != 0 && m_header.size() == m_headerSize;
+  }
+
+  // returns the header and the records needed to read the ring contents
+  Data MakePreamble() const;
+
+  // returns the chunks starting at pos, and the end position
+  uint64_t GetChunks(uint64_t pos, std::vector<Data>* chunks) const;
+
+  uint64_t GetStartPos() const {
+    return m_ring.empty() ? m_endPos : m_ring.front().pos;
+  }
+  uint64_t GetEndPos() const { return m_endPos; }
+
+  bool ended = false;
+
+ private:
+  void Evict(std::span<const uint8_t> data);
+
+  size_t m_bufferSize;
+  std::vector<uint8_t> m_header;
+  size_t m_headerSize = 0;  // 0 if not yet known
+  std::vector<uint8_t> m_partial;  // incomplete record at the end of the data
+  std::deque<Chunk> m_ring;
+  size_t m_ringSize = 0;
+  uint64_t m_endPos = 0;
+  // entries started before the oldest chunk in the ring
+  wpi::DenseMap<uint32_t, EntryState> m_entries;
+};
+
+struct Client {
+  std::shared_ptr<uv::Tcp> stream;
+  std::shared_ptr<LogStream> log;  // null until the log starts
+  uint64_t next = 0;  // stream position of the next chunk to send
+  bool writing = false;
+};
+
+}  // namespace
+
+bool LogStream::Append(std::span<const uint8_t> data) {
+  // header is 12 bytes plus the extra header string
+  auto readHeader = [&](size_t size) {
+    size_t n = (std::min)(data.size(), size - m_header.size());
+    m_header.insert(m_header.end(), data.begin(), data.begin() + n);
+    data = data.subspan(n);
+    return m_header.size() == size;
+  };
+  if (m_headerSize == 0) {
+    if (!readHeader(12)) {
+      return false;
+    }
+    m_headerSize = 12 + support::endian::read32le(&m_header[8]);
+  }
+  if (!readHeader(m_headerSize)) {
+    return false;
+  }
+
+  // split off any incomplete record at the end
+  auto chunk = std::make_shared<std::vector<uint8_t>>();
+  chunk->reserve(m_partial.size() + data.size());
+  chunk->assign(m_partial.begin(), m_partial.end());
+  chunk->insert(chunk->end(), data.begin(), data.end());
+  std::span<const uint8_t> rest{*chunk};
+  Record record;
+  while (ParseRecord(rest, &record)) {
+    rest = rest.subspan(record.size);
+  }
+  m_partial.assign(rest.begin(), rest.end());
+  chunk->resize(chunk->size() - rest.size());
+  if (chunk->empty()) {
+    return false;
+  }
+
+  m_ring.emplace_back(m_endPos, chunk);
+  m_ringSize += chunk->size();
+  m_endPos += chunk->size();
+  while (m_ringSize > m_bufferSize && m_ring.size() > 1) {
+    auto& front = *m_ring.front().data;
+    Evict(front);
+    m_ringSize -= front.size();
+    m_ring.pop_front();
+  }
+  return true;
+}
+
+void LogStream::Evict(std::span<const uint8_t> data) {
+  Record record;
+  while (ParseRecord(data, &record)) {
+    auto bytes = data.subspan(0, record.size);
+    data = data.subspan(record.size);
+    auto payload = record.payload;
+    if (record.entry != 0) {
+      auto it = m_entries.find(record.entry);
+      if (it != m_entries.end() && it->second.schema) {
+        it->second.schemaData.assign(bytes.begin(), bytes.end());
+      }
+      continue;
+    }
+    if (payload.size() < 5) {
+      continue;
+    }
+    uint32_t entry = support::endian::read32le(&payload[1]);
+    switch (payload[0]) {
+      case log::impl::kControlStart: {
+        auto& state = m_entries[entry];
+        state = EntryState{};
+        state.start.assign(bytes.begin(), bytes.end());
+        if (payload.size() >= 9) {
+          uint32_t nameLen = support::endian::read32le(&payload[5]);
+          std::string_view name{
+              reinterpret_cast<const char*>(payload.data() + 9),
+              std::min<size_t>(nameLen, payload.size() - 9)};
+          state.schema = name.starts_with("/.schema/");
+        }
+        break;
+      }
+      case log::impl::kControlFinish:
+        m_entries.erase(entry);
+        break;
+      case log::impl::kControlSetMetadata: {
+        auto it = m_entries.find(entry);
+        if (it != m_entries.end()) {
+          it->second.metadata.assign(bytes.begin(), bytes.end());
+        }
+        break;
+      }
+      default:
+        break;
+    }
+  }
+}
+
+Data LogStream::MakePreamble() const {
+  auto preamble = std::make_shared<std::vector<uint8_t>>(m_header);
+  for (auto&& [entry, state] : m_entries) {
+    preamble->insert(preamble->end(), state.start.begin(), state.start.end());
+    preamble->insert(preamble->end(), state.metadata.begin(),
+                     state.metadata.end());
+    preamble->insert(preamble->end(), state.schemaData.begin(),
+                     state.schemaData.end());
+  }
+  return preamble;
+}
+
+uint64_t LogStream::GetChunks(uint64_t pos, std::vector<Data>* chunks) const {
+  auto it = std::partition_point(
+      m_ring.begin(), m_ring.end(),
+      [&](const Chunk& chunk) { return chunk.pos < pos; });
+  for (; it != m_ring.end(); ++it) {
+    chunks->emplace_back(it->data);
+  }
+  return m_endPos;
+}
+
+struct DataLogStreamServer::Impl {
+  explicit Impl(size_t bufferSize)
+      : bufferSize{bufferSize},
+        log{std::make_shared<LogStream>(bufferSize)} {}
+
+  // loop thread only
+  void Accept(uv::Tcp& server);
+  void Pump(const std::shared_ptr<Client>& client);
+  void PumpAll();
+
+  size_t bufferSize;
+  std::atomic<unsigned int> numClients{0};
+
+  wpi::mutex mutex;
+  std::shared_ptr<LogStream> log;
+  std::weak_ptr<uv::Async<>> async;
+
+  // loop thread only
+  std::vector<std::shared_ptr<Client>> clients;
+
+  // destroyed first, so loop callbacks don't outlive the state above
+  EventLoopRunner runner;
+};
+
+void DataLogStreamServer::Impl::Accept(uv::Tcp& server) {
+  auto stream = server.Accept();
+  if (!stream) {
+    return;
+  }
+  stream->SetNoDelay(true);
+  auto client = std::make_shared<Client>();
+  client->stream = stream;
+  clients.emplace_back(client);
+  ++numClients;
+
+  stream->error.connect([s = stream.get()](uv::Error) { s->Close(); });
+  stream->end.connect([s = stream.get()] { s->Close(); });
+  // clients don't send anything; reading detects disconnects
+  stream->data.connect([](uv::Buffer&, size_t) {});
+  stream->closed.connect([this, c = client.get()] {
+    std::erase_if(clients, [&](auto&& elem) { return elem.get() == c; });
+    --numClients;
+  });
+  stream->StartRead();
+
+  Pump(client);
+}
+
+void DataLogStreamServer::Impl::Pump(const std::shared_ptr<Client>& client) {
+  if (client->writing || client->stream->IsClosing()) {
+    return;
+  }
+
+  std::vector<Data> chunks;
+  bool ended;
+  {
+    std::scoped_lock lock{mutex};
+    if (!client->log) {
+      if (!log->IsStarted()) {
+        return;  // wait for the log to start
+      }
+      client->log = log;
+      chunks.emplace_back(log->MakePreamble());
+      client->next = log->GetStartPos();
+    }
+    if (client->next < client->log->GetStartPos()) {
+      wpi::print(stderr,
+                 "DataLogStreamServer: client fell behind by {} bytes\n",
+                 client->log->GetEndPos() - client->next);
+      client->stream->Close();
+      return;
+    }
+    client->next = client->log->GetChunks(client->next, &chunks);
+    ended = client->log->ended;
+  }
+
+  if (chunks.empty()) {
+    if (ended) {
+      client->stream->Close();
+    }
+    return;
+  }
+
+  std::vector<uv::Buffer> bufs;
+  bufs.reserve(chunks.size());
+  for (auto&& chunk : chunks) {
+    bufs.emplace_back(*chunk);
+  }
+  client->writing = true;
+  client->stream->Write(
+      bufs, [this, weak = std::weak_ptr<Client>{client},
+             chunks = std::move(chunks)](auto, uv::Error err) {
+        auto client = weak.lock();
+        if (!client) {
+          return;
+        }
+        client->writing = false;
+        if (!err) {
+          Pump(client);
+        }
+      });
+}
+
+void DataLogStreamServer::Impl::PumpAll() {
+  // Pump() may close clients, which removes them from the list
+  auto toPump = clients;
+  for (auto&& client : toPump) {
+    Pump(client);
+  }
+}
+
+DataLogStreamServer::DataLogStreamServer(unsigned int port, size_t bufferSize)
+    : m_impl{new Impl{bufferSize}} {
+  m_impl->runner.ExecSync([&](uv::Loop& loop) {
+    auto async = uv::Async<>::Create(loop);
+    if (!async) {
+      wpi::print(stderr, "DataLogStreamServer: Creating async failed\n");
+      return;
+    }
+    async->wakeup.connect([impl = m_impl.get()] { impl->PumpAll(); });
+    m_impl->async = async;
+
+    auto server = uv::Tcp::Create(loop);
+    if (!server) {
+      wpi::print(stderr, "DataLogStreamServer: Creating server failed\n");
+      return;
+    }
+    server->error.connect([port](uv::Error err) {
+      wpi::print(stderr, "DataLogStreamServer: port {}: {}\n", port,
+                 err.str());
+    });
+    server->Bind("", port);
+    server->Listen(
+        [impl = m_impl.get(), s = server.get()] { impl->Accept(*s); });
+  });
+}
+
+DataLogStreamServer::~DataLogStreamServer() {
+  m_impl->runner.Stop();
+}
+
+void DataLogStreamServer::Write(std::span<const uint8_t> data) {
+  {
+    std::scoped_lock lock{m_impl->mutex};
+    if (data.empty()) {
+      // clients are disconnected once they have received everything
+      m_impl->log->ended = true;
+      m_impl->log = std::make_shared<LogStream>(m_impl->bufferSize);
+    } else if (!m_impl->log->Append(data)) {
+      return;
+    }
+  }
+  if (auto async = m_impl->async.lock()) {
+    async->Send();
+  }
+}
+
+unsigned int DataLogStreamServer::GetNumClients() const {
+  return m_impl->numClients;
+}
@@ -0,0 +1,106 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpinet/HostAddressCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <wpi/StringExtras.h>
+
+using namespace wpi;
+
+static bool AddressEquals(const sockaddr_storage& a,
+                          const sockaddr_storage& b) {
+  if (a.ss_family != b.ss_family) {
+    return false;
+  }
+  if (a.ss_family == AF_INET) {
+    return reinterpret_cast<const sockaddr_in&>(a).sin_addr.s_addr ==
+           reinterpret_cast<const sockaddr_in&>(b).sin_addr.s_addr;
+  }
+  return std::memcmp(&(reinterpret_cast<const sockaddr_in6&>(a).sin6_addr),
+                     &(reinterpret_cast<const sockaddr_in6&>(b).sin6_addr),
+                     sizeof(in6_addr)) == 0;
+}
+
+HostAddressCache& HostAddressCache::GetInstance() {
+  static HostAddressCache instance;
+  return instance;
+}
+
+std::string HostAddressCache::GetKey(std::string_view host) const {
+  host = wpi::rtrim(host, '.');
+  std::string key;
+  key.reserve(host.size());
+  for (char ch : host) {
+    key.push_back(wpi::toLower(ch));
+  }
+  return key;
+}
+
+void HostAddressCache::Add(std::string_view host, const sockaddr& addr,
+                           clock::duration ttl) {
+  Entry entry;
+  std::memset(&entry.addr, 0, sizeof(entry.addr));
+  if (addr.sa_family == AF_INET) {
+    std::memcpy(&entry.addr, &addr, sizeof(sockaddr_in));
+    reinterpret_cast<sockaddr_in&>(entry.addr).sin_port = 0;
+  } else if (addr.sa_family == AF_INET6) {
+    std::memcpy(&entry.addr, &addr, sizeof(sockaddr_in6));
+    reinterpret_cast<sockaddr_in6&>(entry.addr).sin6_port = 0;
+  } else {
+    return;
+  }
+  entry.expiry = clock::now() + ttl;
+
+  std::string key = GetKey(host);
+  std::scoped_lock lock{m_mutex};
+  auto& entries = m_hosts[key];
+  std::erase_if(entries, [&](const Entry& e) {
+    return AddressEquals(e.addr, entry.addr) || e.expiry < clock::now();
+  });
+  entries.emplace_back(entry);
+}
+
+void HostAddressCache::AddIPv4(std::string_view host, unsigned int ipv4Address,
+                               clock::duration ttl) {
+  sockaddr_in addr;
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = ipv4Address;
+  Add(host, reinterpret_cast<const sockaddr&>(addr), ttl);
+}
+
+std::vector<sockaddr_storage> HostAddressCache::Get(std::string_view host,
+                                                    unsigned int port) {
+  std::vector<sockaddr_storage> addrs;
+  std::string key = GetKey(host);
+  auto now = clock::now();
+  std::scoped_lock lock{m_mutex};
+  auto it = m_hosts.find(key);
+  if (it == m_hosts.end()) {
+    return addrs;
+  }
+  for (auto&& entry : it->second) {
+    if (entry.expiry < now) {
+      continue;
+    }
+    auto& addr = addrs.emplace_back(entry.addr);
+    if (addr.ss_family == AF_INET) {
+      reinterpret_cast<sockaddr_in&>(addr).sin_port = htons(port);
+    } else {
+      reinterpret_cast<sockaddr_in6&>(addr).sin6_port = htons(port);
+    }
+  }
+  std::reverse(addrs.begin(), addrs.end());
+  return addrs;
+}
+
+void HostAddressCache::Clear() {
+  std::scoped_lock lock{m_mutex};
+  m_hosts.clear();
+}
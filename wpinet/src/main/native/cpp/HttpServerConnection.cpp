@@ -5,6 +5,8 @@
 #include "wpinet/HttpServerConnection.h"
 
 #include <memory>
+#include <string>
+#include <utility>
 
 #include <wpi/SmallString.h>
 #include <wpi/SmallVector.h>
@@ -39,11 +41,7 @@ HttpServerConnection::HttpServerConnection(std::shared_ptr<uv::Stream> stream)
   // pass incoming data to HTTP parser
   m_dataConn =
       stream->data.connect_connection([this](uv::Buffer& buf, size_t size) {
-        m_request.Execute({buf.base, size});
-        if (m_request.HasError()) {
-          // could not parse; just close the connection
-          m_stream.Close();
-        }
+        ProcessInput({buf.base, size});
       });
 
   // close when remote side closes
@@ -54,6 +52,41 @@ HttpServerConnection::HttpServerConnection(std::shared_ptr<uv::Stream> stream)
   stream->StartRead();
 }
 
+void HttpServerConnection::ProcessInput(std::string_view data) {
+  auto rest = m_request.Execute(data);
+  if (m_paused && m_request.GetError() == HPE_PAUSED) {
+    // keep the rest for ResumeRequests()
+    m_pausedInput.append(rest);
+    return;
+  }
+  if (m_request.HasError()) {
+    // could not parse; just close the connection
+    m_stream.Close();
+  }
+}
+
+void HttpServerConnection::PauseRequests() {
+  m_paused = true;
+  m_request.Pause(true);
+  m_stream.StopRead();
+}
+
+void HttpServerConnection::ResumeRequests() {
+  if (!m_paused) {
+    return;
+  }
+  m_paused = false;
+  m_request.Pause(false);
+  if (!m_pausedInput.empty()) {
+    std::string input = std::move(m_pausedInput);
+    m_pausedInput.clear();
+    ProcessInput(input);
+  }
+  if (!m_paused && !m_stream.IsClosing()) {
+    m_stream.StartRead();
+  }
+}
+
 void HttpServerConnection::BuildCommonHeaders(raw_ostream& os) {
   os << "Server: WebServer/1.0\r\n"
         "Cache-Control: no-store, no-cache, must-revalidate, pre-check=0, "
@@ -4,6 +4,8 @@
 
 #include "wpinet/HttpUtil.h"
 
+#include <stdint.h>
+
 #include <cctype>
 #include <string>
 #include <utility>
@@ -97,6 +99,80 @@ std::string_view EscapeHTML(std::string_view str, SmallVectorImpl<char>& buf) {
   return {buf.data(), buf.size()};
 }
 
+std::optional<std::pair<uint64_t, uint64_t>> ParseHttpRange(
+    std::string_view value, uint64_t size, bool* unsatisfiable) {
+  *unsatisfiable = false;
+  value = trim(value);
+  if (value.size() < 6 || !equals_lower(value.substr(0, 6), "bytes=")) {
+    return {};
+  }
+  value.remove_prefix(6);
+  if (contains(value, ',') || !contains(value, '-')) {
+    return {};
+  }
+  auto [firstStr, lastStr] = split(value, '-');
+  firstStr = trim(firstStr);
+  lastStr = trim(lastStr);
+
+  if (firstStr.empty()) {
+    // suffix range: last N bytes
+    auto len = parse_integer<uint64_t>(lastStr, 10);
+    if (!len) {
+      return {};
+    }
+    if (*len == 0 || size == 0) {
+      *unsatisfiable = true;
+      return {};
+    }
+    if (*len > size) {
+      *len = size;
+    }
+    return std::pair{size - *len, *len};
+  }
+
+  auto first = parse_integer<uint64_t>(firstStr, 10);
+  if (!first) {
+    return {};
+  }
+  uint64_t last = UINT64_MAX;
+  if (!lastStr.empty()) {
+    auto lastVal = parse_integer<uint64_t>(lastStr, 10);
+    if (!lastVal || *lastVal < *first) {
+      return {};
+    }
+    last = *lastVal;
+  }
+  if (*first >= size) {
+    *unsatisfiable = true;
+    return {};
+  }
+  if (last >= size) {
+    last = size - 1;
+  }
+  return std::pair{*first, last - *first + 1};
+}
+
+bool MatchHttpETag(std::string_view value, std::string_view etag) {
+  if (starts_with(etag, "W/")) {
+    etag.remove_prefix(2);
+  }
+  SmallVector<std::string_view, 4> tags;
+  split(value, tags, ',', -1, false);
+  for (auto tag : tags) {
+    tag = trim(tag);
+    if (tag == "*") {
+      return true;
+    }
+    if (starts_with(tag, "W/")) {
+      tag.remove_prefix(2);
+    }
+    if (tag == etag) {
+      return true;
+    }
+  }
+  return false;
+}
+
 HttpQueryMap::HttpQueryMap(std::string_view query) {
   SmallVector<std::string_view, 16> queryElems;
   split(query, queryElems, '&', 100, false);
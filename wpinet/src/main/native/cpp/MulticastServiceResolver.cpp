@@ -11,6 +11,15 @@
 #include <wpi/MemAlloc.h>
 
 #include "MulticastHandleManager.h"
+#include "wpinet/HostAddressCache.h"
+
+void wpi::MulticastServiceResolver::PushData(ServiceData&& data) {
+  // make the address available to e.g. ParallelTcpConnector
+  HostAddressCache::GetInstance().AddIPv4(data.hostName, data.ipv4Address);
+  std::scoped_lock lock{mutex};
+  queue.emplace_back(std::forward<ServiceData>(data));
+  event.Set();
+}
 
 extern "C" {
 WPI_MulticastServiceResolverHandle WPI_CreateMulticastServiceResolver(
@@ -13,6 +13,7 @@
 #include <fmt/format.h>
 #include <wpi/Logger.h>
 
+#include "wpinet/HostAddressCache.h"
 #include "wpinet/uv/GetAddrInfo.h"
 #include "wpinet/uv/Loop.h"
 #include "wpinet/uv/Tcp.h"
@@ -105,80 +106,37 @@ void ParallelTcpConnector::Connect() {
 
   WPI_DEBUG3(m_logger, "starting new connection attempts");
 
+  auto& cache = HostAddressCache::GetInstance();
+  for (auto&& server : m_servers) {
+    // immediately try previously resolved addresses, racing the lookup
+    for (auto&& addr : cache.Get(server.first, server.second)) {
+      if (m_ipv4Only && addr.ss_family != AF_INET) {
+        continue;
+      }
+      WPI_DEBUG4(m_logger, "using cached address for {}", server.first);
+      StartAttempt(reinterpret_cast<const sockaddr&>(addr), server.first);
+    }
+  }
+
   // kick off parallel lookups
   for (auto&& server : m_servers) {
     auto req = std::make_shared<uv::GetAddrInfoReq>();
     m_resolvers.emplace_back(req);
 
     req->resolved.connect(
-        [this, req = req.get()](const addrinfo& addrinfo) {
+        [this, host = server.first](const addrinfo& addrinfo) {
+          auto& cache = HostAddressCache::GetInstance();
+          for (auto ai = &addrinfo; ai; ai = ai->ai_next) {
+            cache.Add(host, *ai->ai_addr);
+          }
+
           if (IsConnected()) {
             return;
           }
 
           // kick off parallel connection attempts
           for (auto ai = &addrinfo; ai; ai = ai->ai_next) {
-            // check for duplicates
-            bool duplicate = false;
-            for (auto&& attempt : m_attempts) {
-              if (AddressEquals(*ai->ai_addr, reinterpret_cast<const sockaddr&>(
-                                                  attempt.first))) {
-                duplicate = true;
-                break;
-              }
-            }
-            if (duplicate) {
-              continue;
-            }
-
-            auto tcp = uv::Tcp::Create(m_loop);
-            if (!tcp) {
-              continue;
-            }
-            m_attempts.emplace_back(CopyAddress(*ai->ai_addr, ai->ai_addrlen),
-                                    tcp);
-
-            auto connreq = std::make_shared<uv::TcpConnectReq>();
-            connreq->connected.connect(
-                [this, tcp = tcp.get()] {
-                  if (m_logger.min_level() <= wpi::WPI_LOG_DEBUG4) {
-                    std::string ip;
-                    unsigned int port = 0;
-                    uv::AddrToName(tcp->GetPeer(), &ip, &port);
-                    WPI_DEBUG4(m_logger,
-                               "successful connection ({}) to {} port {}",
-                               static_cast<void*>(tcp), ip, port);
-                  }
-                  if (IsConnected()) {
-                    tcp->Shutdown([tcp] { tcp->Close(); });
-                    return;
-                  }
-                  if (m_connected) {
-                    m_connected(*tcp);
-                  }
-                },
-                shared_from_this());
-
-            connreq->error = [selfWeak = weak_from_this(),
-                              tcp = tcp.get()](uv::Error err) {
-              if (auto self = selfWeak.lock()) {
-                WPI_DEBUG1(self->m_logger, "connect failure ({}): {}",
-                           static_cast<void*>(tcp), err.str());
-              }
-            };
-
-            if (m_logger.min_level() <= wpi::WPI_LOG_DEBUG4) {
-              std::string ip;
-              unsigned int port = 0;
-              uv::AddrToName(*reinterpret_cast<sockaddr_storage*>(ai->ai_addr),
-                             &ip, &port);
-              WPI_DEBUG4(
-                  m_logger,
-                  "Info({}) starting connection attempt ({}) to {} port {}",
-                  static_cast<void*>(req), static_cast<void*>(tcp.get()), ip,
-                  port);
-            }
-            tcp->Connect(*ai->ai_addr, connreq);
+            StartAttempt(*ai->ai_addr, host);
           }
         },
         shared_from_this());
@@ -203,6 +161,67 @@ void ParallelTcpConnector::Connect() {
   }
 }
 
+void ParallelTcpConnector::StartAttempt(const sockaddr& addr,
+                                        const std::string& host) {
+  // check for duplicates
+  for (auto&& attempt : m_attempts) {
+    if (AddressEquals(addr, reinterpret_cast<const sockaddr&>(attempt.first))) {
+      return;
+    }
+  }
+
+  auto tcp = uv::Tcp::Create(m_loop);
+  if (!tcp) {
+    return;
+  }
+  m_attempts.emplace_back(
+      CopyAddress(addr, addr.sa_family == AF_INET6 ? sizeof(sockaddr_in6)
+                                                   : sizeof(sockaddr_in)),
+      tcp);
+
+  auto connreq = std::make_shared<uv::TcpConnectReq>();
+  connreq->connected.connect(
+      [this, tcp = tcp.get(), host] {
+        if (m_logger.min_level() <= wpi::WPI_LOG_DEBUG4) {
+          std::string ip;
+          unsigned int port = 0;
+          uv::AddrToName(tcp->GetPeer(), &ip, &port);
+          WPI_DEBUG4(m_logger, "successful connection ({}) to {} port {}",
+                     static_cast<void*>(tcp), ip, port);
+        }
+        if (IsConnected()) {
+          tcp->Shutdown([tcp] { tcp->Close(); });
+          return;
+        }
+        // keep the working address in the cache
+        auto peer = tcp->GetPeer();
+        HostAddressCache::GetInstance().Add(
+            host, reinterpret_cast<const sockaddr&>(peer));
+        if (m_connected) {
+          m_connected(*tcp);
+        }
+      },
+      shared_from_this());
+
+  connreq->error = [selfWeak = weak_from_this(),
+                    tcp = tcp.get()](uv::Error err) {
+    if (auto self = selfWeak.lock()) {
+      WPI_DEBUG1(self->m_logger, "connect failure ({}): {}",
+                 static_cast<void*>(tcp), err.str());
+    }
+  };
+
+  if (m_logger.min_level() <= wpi::WPI_LOG_DEBUG4) {
+    std::string ip;
+    unsigned int port = 0;
+    uv::AddrToName(reinterpret_cast<const sockaddr_storage&>(addr), &ip,
+                   &port);
+    WPI_DEBUG4(m_logger, "starting connection attempt ({}) to {} port {}",
+               static_cast<void*>(tcp.get()), ip, port);
+  }
+  tcp->Connect(addr, connreq);
+}
+
 void ParallelTcpConnector::CancelAll(wpi::uv::Tcp* except) {
   WPI_DEBUG4(m_logger, "canceling previous attempts");
   for (auto&& resolverWeak : m_resolvers) {
@@ -4,6 +4,12 @@
 
 #include "wpinet/PortForwarder.h"
 
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
 #include <memory>
 #include <string>
 
@@ -12,7 +18,9 @@
 #include <wpi/print.h>
 
 #include "wpinet/EventLoopRunner.h"
+#include "wpinet/uv/Buffer.h"
 #include "wpinet/uv/GetAddrInfo.h"
+#include "wpinet/uv/Poll.h"
 #include "wpinet/uv/Tcp.h"
 #include "wpinet/uv/Timer.h"
 
@@ -31,23 +39,210 @@ PortForwarder& PortForwarder::GetInstance() {
   return instance;
 }
 
+static constexpr size_t kBufferSize = 65536;
+
+using BufferPool = uv::SimpleBufferPool<4>;
+
 static void CopyStream(uv::Stream& in, std::weak_ptr<uv::Stream> outWeak) {
-  in.data.connect([&in, outWeak](uv::Buffer& buf, size_t len) {
-    uv::Buffer buf2 = buf.Dup();
-    buf2.len = len;
+  // Read into pooled buffers and hand them straight to the write, rather than
+  // copying each read into a new buffer.  Buffers return to the pool when the
+  // write completes.
+  auto pool = std::make_shared<BufferPool>(kBufferSize);
+  in.SetBufferAllocator([pool](size_t) { return pool->Allocate(); },
+                        [pool](uv::Buffer& buf) {
+                          if (buf.base) {
+                            pool->Release({&buf, 1});
+                          }
+                        });
+  in.data.connect([&in, outWeak, pool](uv::Buffer& buf, size_t len) {
     auto out = outWeak.lock();
     if (!out) {
-      buf2.Deallocate();
       in.Close();
       return;
     }
-    out->Write({buf2}, [](auto bufs, uv::Error) {
-      for (auto buf : bufs) {
-        buf.Deallocate();
+    // take ownership; the stream frees the (now empty) buffer on return
+    uv::Buffer buf2{buf.base, len};
+    buf = uv::Buffer{};
+    out->Write({buf2}, [pool](auto bufs, uv::Error) { pool->Release(bufs); });
+  });
+}
+
+#ifdef __linux__
+namespace {
+
+/**
+ * Forwards data between two connected sockets with splice(), moving it
+ * through kernel pipes so it is never copied into user space.  The sockets
+ * are polled through duplicated descriptors; the TCP handles are only used
+ * to close the connection.
+ */
+class SpliceForwarder {
+ public:
+  ~SpliceForwarder();
+
+  /**
+   * Starts forwarding between two connected sockets.
+   *
+   * @return False if splicing isn't available, in which case nothing has
+   *         been started.
+   */
+  static bool Start(const std::shared_ptr<uv::Tcp>& a,
+                    const std::shared_ptr<uv::Tcp>& b);
+
+ private:
+  struct Side {
+    std::weak_ptr<uv::Tcp> tcp;
+    std::weak_ptr<uv::Poll> poll;
+    int fd = -1;
+    // pipe holding data read from this side, not yet written to the other
+    int pipe[2] = {-1, -1};
+    size_t pending = 0;
+  };
+
+  bool Fill(int i);
+  bool Drain(int i);
+  void Update(int i);
+  void Close();
+
+  Side m_sides[2];
+  bool m_closed = false;
+};
+
+}  // namespace
+
+SpliceForwarder::~SpliceForwarder() {
+  for (auto& side : m_sides) {
+    for (int fd : {side.fd, side.pipe[0], side.pipe[1]}) {
+      if (fd >= 0) {
+        ::close(fd);
+      }
+    }
+  }
+}
+
+bool SpliceForwarder::Start(const std::shared_ptr<uv::Tcp>& a,
+                            const std::shared_ptr<uv::Tcp>& b) {
+  auto self = std::make_shared<SpliceForwarder>();
+  const std::shared_ptr<uv::Tcp> tcps[2] = {a, b};
+  for (int i = 0; i < 2; ++i) {
+    auto& side = self->m_sides[i];
+    uv_os_fd_t fd;
+    if (uv_fileno(tcps[i]->GetRawHandle(), &fd) != 0) {
+      return false;
+    }
+    side.tcp = tcps[i];
+    side.fd = ::fcntl(fd, F_DUPFD_CLOEXEC, 0);
+    if (side.fd < 0 || ::pipe2(side.pipe, O_NONBLOCK | O_CLOEXEC) != 0) {
+      return false;
+    }
+    ::fcntl(side.fd, F_SETFL, ::fcntl(side.fd, F_GETFL) | O_NONBLOCK);
+  }
+
+  std::shared_ptr<uv::Poll> polls[2];
+  for (int i = 0; i < 2; ++i) {
+    polls[i] = uv::Poll::Create(a->GetLoopRef(), self->m_sides[i].fd);
+    if (!polls[i]) {
+      if (i == 1) {
+        polls[0]->Close();
+      }
+      return false;
+    }
+  }
+
+  // the polls keep the forwarder alive until both have been destroyed
+  for (int i = 0; i < 2; ++i) {
+    self->m_sides[i].poll = polls[i];
+    polls[i]->SetData(self);
+    polls[i]->pollEvent.connect([ptr = self.get(), i](int events) {
+      if (events & UV_WRITABLE) {
+        if (!ptr->Drain(1 - i)) {
+          return;
+        }
       }
+      if (events & UV_READABLE) {
+        if (!ptr->Fill(i) || !ptr->Drain(i)) {
+          return;
+        }
+      }
+      ptr->Update(0);
+      ptr->Update(1);
     });
-  });
+    polls[i]->error.connect([ptr = self.get()](uv::Error) { ptr->Close(); });
+  }
+  self->Update(0);
+  self->Update(1);
+  return true;
+}
+
+// Moves data from side i into its pipe.
+bool SpliceForwarder::Fill(int i) {
+  auto& side = m_sides[i];
+  ssize_t n = ::splice(side.fd, nullptr, side.pipe[1], nullptr, kBufferSize,
+                       SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+  if (n > 0) {
+    side.pending += n;
+    return true;
+  }
+  if (n < 0 && errno == EAGAIN) {
+    return true;
+  }
+  // end of stream or error: close both sides, like the copying path does
+  Close();
+  return false;
+}
+
+// Moves data from side i's pipe into the other side.
+bool SpliceForwarder::Drain(int i) {
+  auto& side = m_sides[i];
+  if (side.pending == 0) {
+    return true;
+  }
+  ssize_t n = ::splice(side.pipe[0], nullptr, m_sides[1 - i].fd, nullptr,
+                       side.pending, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+  if (n > 0) {
+    side.pending -= n;
+    return true;
+  }
+  if (n < 0 && errno == EAGAIN) {
+    return true;
+  }
+  Close();
+  return false;
+}
+
+// Polls side i for reading while its pipe is empty, and for writing while the
+// other side's pipe has data.
+void SpliceForwarder::Update(int i) {
+  if (m_closed) {
+    return;
+  }
+  int events = 0;
+  if (m_sides[i].pending == 0) {
+    events |= UV_READABLE;
+  }
+  if (m_sides[1 - i].pending != 0) {
+    events |= UV_WRITABLE;
+  }
+  if (auto poll = m_sides[i].poll.lock()) {
+    poll->Start(events);
+  }
+}
+
+void SpliceForwarder::Close() {
+  if (m_closed) {
+    return;
+  }
+  m_closed = true;
+  for (auto& side : m_sides) {
+    if (auto poll = side.poll.lock()) {
+      poll->Close();
+    }
+    if (auto tcp = side.tcp.lock()) {
+      tcp->Close();
+    }
+  }
 }
+#endif
 
 void PortForwarder::Add(unsigned int port, std::string_view remoteHost,
                         unsigned int remotePort) {
@@ -129,6 +324,12 @@ void PortForwarder::Add(unsigned int port, std::string_view remoteHost,
                 }
               });
 
+#ifdef __linux__
+              if (SpliceForwarder::Start(client, remoteWeak.lock())) {
+                return;
+              }
+#endif
+
               // copy bidirectionally
               client->StartRead();
               remotePtr->StartRead();
@@ -0,0 +1,146 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpinet/ThreadPool.h"
+
+#include <stdint.h>
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <wpi/condition_variable.h>
+#include <wpi/mutex.h>
+
+using namespace wpi;
+
+namespace {
+struct Worker {
+  wpi::mutex mutex;
+  std::deque<ThreadPool::Task> tasks;
+  std::thread thread;
+};
+}  // namespace
+
+struct ThreadPool::Impl {
+  explicit Impl(unsigned int numThreads) : workers(numThreads) {}
+
+  void Main(size_t index);
+  bool Pop(size_t index, Task& task);
+  bool Steal(size_t index, Task& task);
+
+  std::vector<Worker> workers;
+  // number of queued tasks; may briefly go negative, as tasks are counted
+  // after they are queued
+  std::atomic<int64_t> pending{0};
+  std::atomic<size_t> next{0};
+  wpi::mutex sleepMutex;
+  wpi::condition_variable sleepCv;
+  bool active = true;
+};
+
+// the pool and index of the worker running on this thread, if any
+static thread_local const void* gCurrentPool = nullptr;
+static thread_local size_t gCurrentIndex = 0;
+
+void ThreadPool::Impl::Main(size_t index) {
+  gCurrentPool = this;
+  gCurrentIndex = index;
+  for (;;) {
+    Task task;
+    if (Pop(index, task) || Steal(index, task)) {
+      --pending;
+      task();
+      continue;
+    }
+    std::unique_lock lock{sleepMutex};
+    sleepCv.wait(lock, [&] { return pending > 0 || !active; });
+    if (!active && pending <= 0) {
+      break;
+    }
+  }
+}
+
+bool ThreadPool::Impl::Pop(size_t index, Task& task) {
+  auto& worker = workers[index];
+  std::scoped_lock lock{worker.mutex};
+  if (worker.tasks.empty()) {
+    return false;
+  }
+  task = std::move(worker.tasks.back());
+  worker.tasks.pop_back();
+  return true;
+}
+
+bool ThreadPool::Impl::Steal(size_t index, Task& task) {
+  for (size_t i = 1; i < workers.size(); ++i) {
+    auto& worker = workers[(index + i) % workers.size()];
+    std::scoped_lock lock{worker.mutex};
+    if (!worker.tasks.empty()) {
+      task = std::move(worker.tasks.front());
+      worker.tasks.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+ThreadPool::ThreadPool(unsigned int numThreads) {
+  if (numThreads == 0) {
+    numThreads = std::thread::hardware_concurrency();
+    if (numThreads == 0) {
+      numThreads = 2;
+    }
+  }
+  m_impl = std::make_unique<Impl>(numThreads);
+  for (size_t i = 0; i < numThreads; ++i) {
+    m_impl->workers[i].thread =
+        std::thread{[impl = m_impl.get(), i] { impl->Main(i); }};
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::scoped_lock lock{m_impl->sleepMutex};
+    m_impl->active = false;
+  }
+  m_impl->sleepCv.notify_all();
+  for (auto&& worker : m_impl->workers) {
+    worker.thread.join();
+  }
+}
+
+ThreadPool& ThreadPool::GetInstance() {
+  // never destroyed, so tasks may be queued during static destruction
+  static ThreadPool* instance = new ThreadPool;
+  return *instance;
+}
+
+unsigned int ThreadPool::GetNumThreads() const {
+  return m_impl->workers.size();
+}
+
+void ThreadPool::Post(Task task) {
+  size_t index;
+  if (gCurrentPool == m_impl.get()) {
+    index = gCurrentIndex;
+  } else {
+    index = m_impl->next.fetch_add(1, std::memory_order_relaxed) %
+            m_impl->workers.size();
+  }
+  {
+    auto& worker = m_impl->workers[index];
+    std::scoped_lock lock{worker.mutex};
+    worker.tasks.emplace_back(std::move(task));
+  }
+  ++m_impl->pending;
+  {
+    // don't let the notification slip in between a worker's check and wait
+    std::scoped_lock lock{m_impl->sleepMutex};
+  }
+  m_impl->sleepCv.notify_one();
+}
@@ -12,6 +12,7 @@
 #include <arpa/inet.h>
 #include <fcntl.h>
 #include <netinet/in.h>
+#include <sys/socket.h>
 #include <sys/time.h>
 #include <unistd.h>
 #endif
@@ -20,6 +21,7 @@
 
 #include <wpi/Logger.h>
 #include <wpi/SmallString.h>
+#include <wpi/SmallVector.h>
 
 #include "wpinet/SocketError.h"
 
@@ -138,28 +140,36 @@ void UDPClient::shutdown() {
   }
 }
 
-int UDPClient::send(std::span<const uint8_t> data, std::string_view server,
-                    int port) {
-  // server must be a resolvable IP address
-  struct sockaddr_in addr;
-  std::memset(&addr, 0, sizeof(addr));
-  addr.sin_family = AF_INET;
+// server must be a resolvable IP address
+static bool ResolveAddress(std::string_view server, int port,
+                           sockaddr_in* addr, Logger& logger) {
+  std::memset(addr, 0, sizeof(*addr));
+  addr->sin_family = AF_INET;
   SmallString<128> remoteAddr{server};
   if (remoteAddr.empty()) {
-    WPI_ERROR(m_logger, "server must be passed");
-    return -1;
+    WPI_ERROR(logger, "server must be passed");
+    return false;
   }
 
 #ifdef _WIN32
-  int res = InetPton(AF_INET, remoteAddr.c_str(), &(addr.sin_addr));
+  int res = InetPton(AF_INET, remoteAddr.c_str(), &(addr->sin_addr));
 #else
-  int res = inet_pton(AF_INET, remoteAddr.c_str(), &(addr.sin_addr));
+  int res = inet_pton(AF_INET, remoteAddr.c_str(), &(addr->sin_addr));
 #endif
   if (res != 1) {
-    WPI_ERROR(m_logger, "could not resolve {} address", server);
+    WPI_ERROR(logger, "could not resolve {} address", server);
+    return false;
+  }
+  addr->sin_port = htons(port);
+  return true;
+}
+
+int UDPClient::send(std::span<const uint8_t> data, std::string_view server,
+                    int port) {
+  struct sockaddr_in addr;
+  if (!ResolveAddress(server, port, &addr, m_logger)) {
     return -1;
   }
-  addr.sin_port = htons(port);
 
   // sendto should not block
   int result =
@@ -169,26 +179,10 @@ int UDPClient::send(std::span<const uint8_t> data, std::string_view server,
 }
 
 int UDPClient::send(std::string_view data, std::string_view server, int port) {
-  // server must be a resolvable IP address
   struct sockaddr_in addr;
-  std::memset(&addr, 0, sizeof(addr));
-  addr.sin_family = AF_INET;
-  SmallString<128> remoteAddr{server};
-  if (remoteAddr.empty()) {
-    WPI_ERROR(m_logger, "server must be passed");
-    return -1;
-  }
-
-#ifdef _WIN32
-  int res = InetPton(AF_INET, remoteAddr.c_str(), &(addr.sin_addr));
-#else
-  int res = inet_pton(AF_INET, remoteAddr.c_str(), &(addr.sin_addr));
-#endif
-  if (res != 1) {
-    WPI_ERROR(m_logger, "could not resolve {} address", server);
+  if (!ResolveAddress(server, port, &addr, m_logger)) {
     return -1;
   }
-  addr.sin_port = htons(port);
 
   // sendto should not block
   int result = sendto(m_lsd, data.data(), data.size(), 0,
@@ -196,6 +190,54 @@ int UDPClient::send(std::string_view data, std::string_view server, int port) {
   return result;
 }
 
+int UDPClient::send_batch(std::span<const std::span<const uint8_t>> datagrams,
+                          std::string_view server, int port) {
+  struct sockaddr_in addr;
+  if (!ResolveAddress(server, port, &addr, m_logger)) {
+    return -1;
+  }
+
+  size_t sent = 0;
+#ifdef __linux__
+  SmallVector<iovec, 16> iovs;
+  SmallVector<mmsghdr, 16> msgs;
+  iovs.resize(datagrams.size());
+  msgs.resize(datagrams.size());
+  for (size_t i = 0; i < datagrams.size(); ++i) {
+    iovs[i].iov_base = const_cast<uint8_t*>(datagrams[i].data());
+    iovs[i].iov_len = datagrams[i].size();
+    std::memset(&msgs[i], 0, sizeof(msgs[i]));
+    msgs[i].msg_hdr.msg_name = &addr;
+    msgs[i].msg_hdr.msg_namelen = sizeof(addr);
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  // sendmmsg should not block, but may send only part of the batch
+  while (sent < msgs.size()) {
+    int result = sendmmsg(m_lsd, msgs.data() + sent, msgs.size() - sent, 0);
+    if (result <= 0) {
+      break;
+    }
+    sent += result;
+  }
+#else
+  for (auto&& data : datagrams) {
+    int result =
+        sendto(m_lsd, reinterpret_cast<const char*>(data.data()), data.size(),
+               0, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    if (result < 0) {
+      break;
+    }
+    ++sent;
+  }
+#endif
+  if (sent == 0 && !datagrams.empty()) {
+    return -1;
+  }
+  return sent;
+}
+
 int UDPClient::receive(uint8_t* data_received, int receive_len) {
   if (m_port == 0) {
     return -1;  // return if not receiving
@@ -236,6 +278,46 @@ int UDPClient::receive(uint8_t* data_received, int receive_len,
   return result;
 }
 
+int UDPClient::receive_batch(std::span<const std::span<uint8_t>> buffers,
+                             int* received_lens) {
+  if (m_port == 0) {
+    return -1;  // return if not receiving
+  }
+  if (buffers.empty()) {
+    return 0;
+  }
+
+#ifdef __linux__
+  SmallVector<iovec, 16> iovs;
+  SmallVector<mmsghdr, 16> msgs;
+  iovs.resize(buffers.size());
+  msgs.resize(buffers.size());
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    iovs[i].iov_base = buffers[i].data();
+    iovs[i].iov_len = buffers[i].size();
+    std::memset(&msgs[i], 0, sizeof(msgs[i]));
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  // only wait (subject to the timeout) for the first datagram
+  int result =
+      recvmmsg(m_lsd, msgs.data(), msgs.size(), MSG_WAITFORONE, nullptr);
+  for (int i = 0; i < result; ++i) {
+    received_lens[i] = msgs[i].msg_len;
+  }
+  return result;
+#else
+  int result = recv(m_lsd, reinterpret_cast<char*>(buffers[0].data()),
+                    buffers[0].size(), 0);
+  if (result < 0) {
+    return -1;
+  }
+  received_lens[0] = result;
+  return 1;
+#endif
+}
+
 int UDPClient::set_timeout(double timeout) {
   if (timeout < 0) {
     return -1;
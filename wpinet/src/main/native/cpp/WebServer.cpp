@@ -8,8 +8,11 @@
 #include <unistd.h>
 #endif
 
+#include <list>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <tuple>
 #include <utility>
 
 #include <fmt/format.h>
@@ -17,9 +20,11 @@
 #include <wpi/MemoryBuffer.h>
 #include <wpi/SmallString.h>
 #include <wpi/Signal.h>
+#include <wpi/SpanExtras.h>
 #include <wpi/StringMap.h>
 #include <wpi/fs.h>
 #include <wpi/json.h>
+#include <wpi/mutex.h>
 #include <wpi/print.h>
 #include <wpi/raw_ostream.h>
 
@@ -32,27 +37,198 @@
 #include "wpinet/uv/Stream.h"
 #include "wpinet/uv/Tcp.h"
 #include "wpinet/uv/Timer.h"
+#include "wpinet/uv/Work.h"
 
 using namespace wpi;
 
 namespace {
+// LRU cache of the contents of small files, shared by all connections to a
+// server.  Entries are keyed by path and are only used while the file size
+// and modification time are unchanged.
+class FileCache {
+ public:
+  static constexpr uint64_t kMaxFileSize = 64 * 1024;
+  static constexpr size_t kMaxSize = 4 * 1024 * 1024;
+
+  std::shared_ptr<MemoryBuffer> Get(std::string_view path, uint64_t size,
+                                    int64_t mtime);
+  void Put(std::string_view path, uint64_t size, int64_t mtime,
+           std::shared_ptr<MemoryBuffer> data);
+
+ private:
+  struct Entry {
+    std::string path;
+    uint64_t size;
+    int64_t mtime;
+    std::shared_ptr<MemoryBuffer> data;
+  };
+
+  wpi::mutex m_mutex;
+  std::list<Entry> m_entries;  // most recently used first
+  wpi::StringMap<std::list<Entry>::iterator> m_index;
+  size_t m_totalSize = 0;
+};
+
+// Result of looking up a file on the thread pool
+struct FileInfo {
+  bool found = false;
+  uint64_t size = 0;
+  std::string etag;
+  // file contents; null if the file is to be sent with sendfile
+  std::shared_ptr<MemoryBuffer> data;
+#ifndef _WIN32
+  int fd = -1;
+#endif
+};
+
 class MyHttpConnection : public wpi::HttpServerConnection,
                          public std::enable_shared_from_this<MyHttpConnection> {
  public:
-  explicit MyHttpConnection(std::shared_ptr<wpi::uv::Stream> stream,
-                            std::string_view path)
-      : HttpServerConnection{std::move(stream)}, m_path{path} {}
+  MyHttpConnection(std::shared_ptr<wpi::uv::Stream> stream,
+                   std::string_view path, std::shared_ptr<FileCache> cache);
 
  protected:
   void ProcessRequest() override;
-  void SendFileResponse(int code, std::string_view codeText,
-                        std::string_view contentType, fs::path filename,
+  void BuildCommonHeaders(raw_ostream& os) override;
+  void SendFileResponse(std::string_view contentType, fs::path filename,
                         std::string_view extraHeader = {});
+  bool SendFileInfo(FileInfo& info, std::string_view contentType,
+                    std::string_view extraHeader, std::string_view ifNoneMatch,
+                    std::string_view range);
 
   std::string m_path;
+  std::shared_ptr<FileCache> m_cache;
+  std::string m_ifNoneMatch;
+  std::string m_range;
+  bool m_revalidate = false;
 };
 }  // namespace
 
+std::shared_ptr<MemoryBuffer> FileCache::Get(std::string_view path,
+                                             uint64_t size, int64_t mtime) {
+  std::scoped_lock lock{m_mutex};
+  auto it = m_index.find(path);
+  if (it == m_index.end()) {
+    return nullptr;
+  }
+  auto entry = it->second;
+  if (entry->size != size || entry->mtime != mtime) {
+    // stale
+    m_totalSize -= entry->data->size();
+    m_entries.erase(entry);
+    m_index.erase(it);
+    return nullptr;
+  }
+  m_entries.splice(m_entries.begin(), m_entries, entry);
+  return entry->data;
+}
+
+void FileCache::Put(std::string_view path, uint64_t size, int64_t mtime,
+                    std::shared_ptr<MemoryBuffer> data) {
+  std::scoped_lock lock{m_mutex};
+  auto [it, inserted] = m_index.try_emplace(path);
+  if (!inserted) {
+    m_totalSize -= it->second->data->size();
+    m_entries.erase(it->second);
+  }
+  m_totalSize += data->size();
+  m_entries.emplace_front(
+      Entry{std::string{path}, size, mtime, std::move(data)});
+  it->second = m_entries.begin();
+
+  // evict least recently used entries
+  while (m_totalSize > kMaxSize && m_entries.size() > 1) {
+    auto& last = m_entries.back();
+    m_totalSize -= last.data->size();
+    m_index.erase(last.path);
+    m_entries.pop_back();
+  }
+}
+
+// Runs on the thread pool.  Small files are read into (or served from) the
+// cache; larger files are opened for sendfile.
+static FileInfo LookupFile(const fs::path& filename, FileCache& cache) {
+  FileInfo info;
+  std::error_code ec;
+  auto size = fs::file_size(filename, ec);
+  if (ec) {
+    return info;
+  }
+  auto mtime = fs::last_write_time(filename, ec);
+  if (ec) {
+    return info;
+  }
+  int64_t mtimeCount = mtime.time_since_epoch().count();
+  info.size = size;
+  info.etag = fmt::format("\"{:x}-{:x}\"", size,
+                          static_cast<uint64_t>(mtimeCount));
+
+#ifndef _WIN32
+  if (size > FileCache::kMaxFileSize) {
+    auto infile = fs::OpenFileForRead(filename, ec);
+    if (ec) {
+      return info;
+    }
+    info.fd = fs::FileToFd(infile, ec, fs::OF_None);
+    if (ec) {
+      fs::CloseFile(infile);
+      return info;
+    }
+    info.found = true;
+    return info;
+  }
+#endif
+
+  std::string path = filename.string();
+  info.data = cache.Get(path, size, mtimeCount);
+  if (!info.data) {
+    auto membuf = MemoryBuffer::GetFile(path);
+    if (!membuf) {
+      return info;
+    }
+    info.data = std::move(*membuf);
+    // the file may have changed since it was stat'ed
+    info.size = info.data->size();
+    if (info.size == size && size <= FileCache::kMaxFileSize) {
+      cache.Put(path, size, mtimeCount, info.data);
+    }
+  }
+  info.found = true;
+  return info;
+}
+
+MyHttpConnection::MyHttpConnection(std::shared_ptr<wpi::uv::Stream> stream,
+                                   std::string_view path,
+                                   std::shared_ptr<FileCache> cache)
+    : HttpServerConnection{std::move(stream)},
+      m_path{path},
+      m_cache{std::move(cache)} {
+  // save the conditional and range request headers
+  m_request.messageBegin.connect([this] {
+    m_ifNoneMatch.clear();
+    m_range.clear();
+  });
+  m_request.header.connect(
+      [this](std::string_view name, std::string_view value) {
+        if (wpi::equals_lower(name, "if-none-match")) {
+          m_ifNoneMatch = value;
+        } else if (wpi::equals_lower(name, "range")) {
+          m_range = value;
+        }
+      });
+}
+
+void MyHttpConnection::BuildCommonHeaders(raw_ostream& os) {
+  if (!m_revalidate) {
+    HttpServerConnection::BuildCommonHeaders(os);
+    return;
+  }
+  // files have an ETag, so let the browser cache them as long as it checks
+  // for changes on every use
+  os << "Server: WebServer/1.0\r\n"
+        "Cache-Control: no-cache\r\n";
+}
+
 #ifndef _WIN32
 namespace {
 class SendfileReq : public uv::RequestImpl<SendfileReq, uv_fs_t> {
@@ -150,78 +326,145 @@ static std::string_view GetMimeType(std::string_view ext) {
   return it->second;
 }
 
-void MyHttpConnection::SendFileResponse(int code, std::string_view codeText,
-                                        std::string_view contentType,
+void MyHttpConnection::SendFileResponse(std::string_view contentType,
                                         fs::path filename,
                                         std::string_view extraHeader) {
-#ifdef _WIN32
-  auto membuf = wpi::MemoryBuffer::GetFile(filename.string());
-  if (!membuf) {
-    SendError(404);
-    return;
-  }
-
-  wpi::SmallVector<uv::Buffer, 4> toSend;
-  wpi::raw_uv_ostream os{toSend, 4096};
-  BuildHeader(os, code, codeText, contentType, (*membuf)->size(), extraHeader);
-  SendData(os.bufs(), false);
-  auto buf = (*membuf)->GetBuffer();
-  m_stream.Write(
-      {{buf}}, [closeAfter = !m_keepAlive, stream = &m_stream,
-                membuf = std::shared_ptr{std::move(*membuf)}](auto, uv::Error) {
-        if (closeAfter) {
-          stream->Close();
+  // stat, open, and read the file off the loop; later requests on this
+  // connection wait until the response is queued, so responses stay in order
+  PauseRequests();
+  auto info = std::make_shared<FileInfo>();
+  uv::QueueWork(
+      m_stream.GetLoopRef(),
+      [info, filename = std::move(filename), cache = m_cache] {
+        *info = LookupFile(filename, *cache);
+      },
+      [info, self = shared_from_this(), stream = m_stream.shared_from_this(),
+       contentType = std::string{contentType},
+       extraHeader = std::string{extraHeader}, ifNoneMatch = m_ifNoneMatch,
+       range = m_range] {
+        if (stream->IsClosing()) {
+#ifndef _WIN32
+          if (info->fd != -1) {
+            ::close(info->fd);
+          }
+#endif
+          return;
+        }
+        if (self->SendFileInfo(*info, contentType, extraHeader, ifNoneMatch,
+                               range)) {
+          self->ResumeRequests();
         }
       });
-#else
-  // open file
-  std::error_code ec;
-  auto infile = fs::OpenFileForRead(filename, ec);
-  if (ec) {
+}
+
+// Returns false if the file is still being sent, in which case requests are
+// resumed once it has been
+bool MyHttpConnection::SendFileInfo(FileInfo& info,
+                                    std::string_view contentType,
+                                    std::string_view extraHeader,
+                                    std::string_view ifNoneMatch,
+                                    std::string_view range) {
+  if (!info.found) {
     SendError(404);
-    return;
+    return true;
   }
-  int infd = fs::FileToFd(infile, ec, fs::OF_None);
-  if (ec) {
-    fs::CloseFile(infile);
-    SendError(404);
-    return;
+
+#ifndef _WIN32
+  uv_os_fd_t outfd = -1;
+  if (!info.data) {
+    int err = uv_fileno(m_stream.GetRawHandle(), &outfd);
+    if (err < 0) {
+      m_stream.GetLoopRef().ReportError(err);
+      SendError(404);
+      ::close(info.fd);
+      return true;
+    }
   }
+  auto closeFile = [&] {
+    if (info.fd != -1) {
+      ::close(info.fd);
+    }
+  };
+#else
+  auto closeFile = [] {};
+#endif
 
-  // get file size
-  auto size = fs::file_size(filename, ec);
-  if (ec) {
-    SendError(404);
-    ::close(infd);
-    return;
+  m_revalidate = true;
+  std::string extra = fmt::format("{}ETag: {}\r\nAccept-Ranges: bytes\r\n",
+                                  extraHeader, info.etag);
+
+  if (!ifNoneMatch.empty() && MatchHttpETag(ifNoneMatch, info.etag)) {
+    closeFile();
+    SendResponse(304, "Not Modified", contentType, "", extra);
+    m_revalidate = false;
+    return true;
   }
 
-  uv_os_fd_t outfd;
-  int err = uv_fileno(m_stream.GetRawHandle(), &outfd);
-  if (err < 0) {
-    m_stream.GetLoopRef().ReportError(err);
-    SendError(404);
-    ::close(infd);
-    return;
+  int code = 200;
+  std::string_view codeText = "OK";
+  uint64_t offset = 0;
+  uint64_t length = info.size;
+  if (!range.empty()) {
+    bool unsatisfiable;
+    if (auto r = ParseHttpRange(range, info.size, &unsatisfiable)) {
+      code = 206;
+      codeText = "Partial Content";
+      std::tie(offset, length) = *r;
+      extra += fmt::format("Content-Range: bytes {}-{}/{}\r\n", offset,
+                           offset + length - 1, info.size);
+    } else if (unsatisfiable) {
+      closeFile();
+      SendResponse(416, "Range Not Satisfiable", "text/plain", "",
+                   fmt::format("Content-Range: bytes */{}\r\n", info.size));
+      m_revalidate = false;
+      return true;
+    }
   }
 
   wpi::SmallVector<uv::Buffer, 4> toSend;
   wpi::raw_uv_ostream os{toSend, 4096};
-  BuildHeader(os, code, codeText, contentType, size, extraHeader);
+  BuildHeader(os, code, codeText, contentType, length, extra);
+  m_revalidate = false;
+
+  if (info.data) {
+    // send from memory without copying
+    auto buf = info.data->GetBuffer().subspan(offset, length);
+    toSend.emplace_back(
+        std::string_view{reinterpret_cast<const char*>(buf.data()),
+                         buf.size()});
+    m_stream.Write(toSend, [closeAfter = !m_keepAlive, stream = &m_stream,
+                            data = info.data](auto bufs, uv::Error) {
+      // don't deallocate the file contents
+      for (auto&& buf : wpi::drop_back(bufs)) {
+        buf.Deallocate();
+      }
+      if (closeAfter) {
+        stream->Close();
+      }
+    });
+    return true;
+  }
+
+#ifndef _WIN32
   SendData(os.bufs(), false);
 
   // close after write completes if we aren't keeping alive
   // since we're using sendfile, set socket to blocking
   m_stream.SetBlocking(true);
-  Sendfile(m_stream.GetLoopRef(), outfd, infd, 0, size,
-           [infd, closeAfter = !m_keepAlive, stream = &m_stream] {
+  Sendfile(m_stream.GetLoopRef(), outfd, info.fd, offset, length,
+           [infd = info.fd, closeAfter = !m_keepAlive, stream = &m_stream,
+            self = shared_from_this()] {
              ::close(infd);
              if (closeAfter) {
                stream->Close();
              } else {
                stream->SetBlocking(false);
+               self->ResumeRequests();
              }
            });
+  return false;
+#else
+  return true;
 #endif
 }
 
@@ -290,7 +533,7 @@ void MyHttpConnection::ProcessRequest() {
             wpi::json{{"dirs", std::move(dirs)}, {"files", std::move(files)}}
                 .dump());
       } else if (fs::exists(indexpath)) {
-        SendFileResponse(200, "OK", GetMimeType("html"), indexpath,
+        SendFileResponse(GetMimeType("html"), indexpath,
                          "Content-Disposition: filename=\"index.html\"\r\n");
       } else {
         wpi::StringMap<std::string> dirs;
@@ -333,8 +576,8 @@ void MyHttpConnection::ProcessRequest() {
       os << "Content-Disposition: filename=\"";
       os.write_escaped(fullpath.filename().string());
       os << "\"\r\n";
-      SendFileResponse(200, "OK", GetMimeType(wpi::rsplit(path, '.').second),
-                       fullpath, os.str());
+      SendFileResponse(GetMimeType(wpi::rsplit(path, '.').second), fullpath,
+                       os.str());
     }
   } else {
     SendError(404, "Resource not found");
@@ -367,7 +610,8 @@ void WebServer::Start(unsigned int port, std::string_view path) {
 
     // when we get a connection, accept it
     server->connection.connect(
-        [serverPtr = server.get(), path = std::string{path}] {
+        [serverPtr = server.get(), path = std::string{path},
+         cache = std::make_shared<FileCache>()] {
           auto client = serverPtr->Accept();
           if (!client) {
             wpi::print(stderr, "WebServer: Connecting to client failed\n");
@@ -379,7 +623,7 @@ void WebServer::Start(unsigned int port, std::string_view path) {
             clientPtr->Close();
           });
 
-          auto conn = std::make_shared<MyHttpConnection>(client, path);
+          auto conn = std::make_shared<MyHttpConnection>(client, path, cache);
           client->SetData(conn);
         });
 
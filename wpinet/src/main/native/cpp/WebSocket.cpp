@@ -4,15 +4,19 @@
 
 #include "wpinet/WebSocket.h"
 
+#include <algorithm>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <random>
 #include <span>
 #include <string>
 #include <string_view>
+#include <tuple>
 #include <utility>
 
 #include <wpi/Base64.h>
+#include <wpi/Deflate.h>
 #include <wpi/SmallString.h>
 #include <wpi/SmallVector.h>
 #include <wpi/StringExtras.h>
@@ -108,6 +112,7 @@ class WebSocket::WriteReq : public uv::WriteReq,
   std::shared_ptr<WriteReq> m_controlCont;
 };
 
+static constexpr uint8_t kFlagRsv1 = 0x40;
 static constexpr uint8_t kFlagMasking = 0x80;
 static constexpr uint8_t kLenMask = 0x7f;
 static constexpr size_t kWriteAllocSize = 4096;
@@ -140,6 +145,7 @@ class WebSocket::ClientHandshakeData {
   bool hasConnection = false;
   bool hasAccept = false;
   bool hasProtocol = false;
+  bool hasDeflate = false;
 
   std::weak_ptr<uv::Timer> timer;
 };
@@ -153,6 +159,65 @@ static std::string_view AcceptHash(std::string_view key,
   return Base64Encode(hash.RawFinal(hashBuf), buf);
 }
 
+namespace {
+// permessage-deflate extension parameters (RFC 7692 section 7.1)
+struct DeflateParams {
+  bool serverNoContextTakeover = false;
+  bool clientNoContextTakeover = false;
+  std::optional<int> serverMaxWindowBits;
+  // 0 if given without a value
+  std::optional<int> clientMaxWindowBits;
+};
+}  // namespace
+
+// Parses the parameters following "permessage-deflate" in an extension offer
+// or response. Returns false if a parameter is unknown, repeated, or invalid.
+static bool ParseDeflateParams(std::string_view params, DeflateParams* out) {
+  while (!params.empty()) {
+    std::string_view param;
+    std::tie(param, params) = split(params, ';');
+    auto [name, value] = split(param, '=');
+    name = trim(name);
+    value = trim(value);
+    bool hasValue = param.find('=') != std::string_view::npos;
+    if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+      value = value.substr(1, value.size() - 2);
+    }
+    std::optional<int> bits;
+    if (hasValue) {
+      bits = parse_integer<int>(value, 10);
+      if (!bits || *bits < 8 || *bits > 15) {
+        return false;
+      }
+    }
+
+    if (equals_lower(name, "server_no_context_takeover")) {
+      if (hasValue || out->serverNoContextTakeover) {
+        return false;
+      }
+      out->serverNoContextTakeover = true;
+    } else if (equals_lower(name, "client_no_context_takeover")) {
+      if (hasValue || out->clientNoContextTakeover) {
+        return false;
+      }
+      out->clientNoContextTakeover = true;
+    } else if (equals_lower(name, "server_max_window_bits")) {
+      if (!hasValue || out->serverMaxWindowBits) {
+        return false;
+      }
+      out->serverMaxWindowBits = bits;
+    } else if (equals_lower(name, "client_max_window_bits")) {
+      if (out->clientMaxWindowBits) {
+        return false;
+      }
+      out->clientMaxWindowBits = bits.value_or(0);
+    } else if (!name.empty()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 WebSocket::WebSocket(uv::Stream& stream, bool server, const private_init&)
     : m_stream{stream}, m_server{server} {
   // Connect closed and error signals to ourselves
@@ -181,13 +246,12 @@ std::shared_ptr<WebSocket> WebSocket::CreateClient(
   return ws;
 }
 
-std::shared_ptr<WebSocket> WebSocket::CreateServer(uv::Stream& stream,
-                                                   std::string_view key,
-                                                   std::string_view version,
-                                                   std::string_view protocol) {
+std::shared_ptr<WebSocket> WebSocket::CreateServer(
+    uv::Stream& stream, std::string_view key, std::string_view version,
+    std::string_view protocol, const ServerOptions& options) {
   auto ws = std::make_shared<WebSocket>(stream, true, private_init{});
   stream.SetData(ws);
-  ws->StartServer(key, version, protocol);
+  ws->StartServer(key, version, protocol, options);
   return ws;
 }
 
@@ -249,6 +313,17 @@ void WebSocket::StartClient(std::string_view uri, std::string_view host,
     os << "\r\n";
   }
 
+  // permessage-deflate offer; sent messages never use context takeover
+  if (options.deflate) {
+    m_deflate = options.deflate;
+    os << "Sec-WebSocket-Extensions: permessage-deflate; "
+          "client_no_context_takeover; client_max_window_bits";
+    if (!options.deflate->allowContextTakeover) {
+      os << "; server_no_context_takeover";
+    }
+    os << "\r\n";
+  }
+
   // other headers
   for (auto&& header : options.extraHeaders) {
     os << header.first << ": " << header.second << "\r\n";
@@ -292,9 +367,26 @@ void WebSocket::StartClient(std::string_view uri, std::string_view host,
           }
           m_clientHandshake->hasAccept = true;
         } else if (equals_lower(name, "sec-websocket-extensions")) {
-          // No extensions are supported
-          if (!value.empty()) {
-            return Terminate(1010, "unsupported extension");
+          // Only permessage-deflate is supported, and only if offered
+          SmallVector<std::string_view, 2> extensions;
+          split(value, extensions, ",", -1, false);
+          for (auto extension : extensions) {
+            auto [extName, params] = split(extension, ';');
+            DeflateParams deflate;
+            if (!m_deflate || m_clientHandshake->hasDeflate ||
+                !equals_lower(trim(extName), "permessage-deflate") ||
+                !ParseDeflateParams(params, &deflate) ||
+                deflate.clientMaxWindowBits == 0 ||
+                (!m_deflate->allowContextTakeover &&
+                 !deflate.serverNoContextTakeover)) {
+              return Terminate(1010, "unsupported extension");
+            }
+            if (deflate.clientMaxWindowBits) {
+              m_deflate->windowBits = (std::min)(
+                  m_deflate->windowBits, *deflate.clientMaxWindowBits);
+            }
+            m_peerNoContextTakeover = deflate.serverNoContextTakeover;
+            m_clientHandshake->hasDeflate = true;
           }
         } else if (equals_lower(name, "sec-websocket-protocol")) {
           // Make sure it was one of the provided protocols
@@ -319,6 +411,9 @@ void WebSocket::StartClient(std::string_view uri, std::string_view host,
          !m_clientHandshake->protocols.empty())) {
       return Terminate(1002, "invalid response");
     }
+    if (!m_clientHandshake->hasDeflate) {
+      m_deflate.reset();  // declined by the server
+    }
     if (m_state == CONNECTING) {
       m_state = OPEN;
       open(m_protocol);
@@ -337,7 +432,8 @@ void WebSocket::StartClient(std::string_view uri, std::string_view host,
 }
 
 void WebSocket::StartServer(std::string_view key, std::string_view version,
-                            std::string_view protocol) {
+                            std::string_view protocol,
+                            const ServerOptions& options) {
   m_protocol = protocol;
 
   // Build server response
@@ -372,6 +468,37 @@ void WebSocket::StartServer(std::string_view key, std::string_view version,
     os << "Sec-WebSocket-Protocol: " << protocol << "\r\n";
   }
 
+  // accept the first acceptable permessage-deflate offer; sent messages never
+  // use context takeover
+  if (options.deflate) {
+    SmallVector<std::string_view, 2> extensions;
+    split(options.extensions, extensions, ",", -1, false);
+    for (auto extension : extensions) {
+      auto [name, params] = split(extension, ';');
+      DeflateParams deflate;
+      if (!equals_lower(trim(name), "permessage-deflate") ||
+          !ParseDeflateParams(params, &deflate)) {
+        continue;
+      }
+      m_deflate = options.deflate;
+      m_peerNoContextTakeover = deflate.clientNoContextTakeover ||
+                                !options.deflate->allowContextTakeover;
+      os << "Sec-WebSocket-Extensions: permessage-deflate; "
+            "server_no_context_takeover";
+      if (deflate.serverMaxWindowBits) {
+        m_deflate->windowBits =
+            (std::min)(m_deflate->windowBits, *deflate.serverMaxWindowBits);
+        os << fmt::format("; server_max_window_bits={}",
+                          m_deflate->windowBits);
+      }
+      if (!options.deflate->allowContextTakeover) {
+        os << "; client_no_context_takeover";
+      }
+      os << "\r\n";
+      break;
+    }
+  }
+
   // end headers
   os << "\r\n";
 
@@ -415,17 +542,6 @@ void WebSocket::Shutdown() {
   m_stream.Shutdown([this] { m_stream.Close(); });
 }
 
-static inline void Unmask(std::span<uint8_t> data,
-                          std::span<const uint8_t, 4> key) {
-  int n = 0;
-  for (uint8_t& ch : data) {
-    ch ^= key[n++];
-    if (n >= 4) {
-      n = 0;
-    }
-  }
-}
-
 void WebSocket::HandleIncoming(uv::Buffer& buf, size_t size) {
   m_lastReceivedTime = m_stream.GetLoopRef().Now().count();
 
@@ -469,8 +585,13 @@ void WebSocket::HandleIncoming(uv::Buffer& buf, size_t size) {
           return;  // need more data
         }
 
-        // Validate RSV bits are zero
-        if ((m_header[0] & 0x70) != 0) {
+        // Validate RSV bits are zero, except RSV1 on the first frame of a
+        // compressed message
+        uint8_t opcode = m_header[0] & kOpMask;
+        if ((m_header[0] & 0x70) == kFlagRsv1 && m_deflate &&
+            (opcode == kOpText || opcode == kOpBinary)) {
+          m_compressedMessage = true;
+        } else if ((m_header[0] & 0x70) != 0) {
           return Fail(1002, "nonzero RSV");
         }
       }
@@ -556,34 +677,67 @@ void WebSocket::HandleIncoming(uv::Buffer& buf, size_t size) {
         // We have a complete frame
         // If the message had masking, unmask it
         if ((m_header[1] & kFlagMasking) != 0) {
-          Unmask(control ? std::span{m_controlPayload}
-                         : std::span{m_payload}.subspan(m_frameStart),
-                 std::span<const uint8_t, 4>{&m_header[m_headerSize - 4], 4});
+          auto payload = control ? std::span{m_controlPayload}
+                                 : std::span{m_payload}.subspan(m_frameStart);
+          detail::MaskData(
+              payload.data(), payload,
+              std::span<const uint8_t, 4>{&m_header[m_headerSize - 4], 4});
         }
 
-        // Handle message
         bool fin = (m_header[0] & kFlagFin) != 0;
         uint8_t opcode = m_header[0] & kOpMask;
+
+        // Compressed messages are always combined, and decompressed once
+        // complete
+        bool combine = m_combineFragments || m_compressedMessage;
+        std::span<const uint8_t> message = m_payload;
+        if (m_compressedMessage && !control && fin) {
+          // if the peer compresses messages independently, decompressors can
+          // be shared
+          thread_local DeflateDecompressor sharedDecompressor;
+          DeflateDecompressor* decompressor = &sharedDecompressor;
+          if (!m_peerNoContextTakeover) {
+            if (!m_decompressor) {
+              m_decompressor = std::make_unique<DeflateDecompressor>();
+            }
+            decompressor = m_decompressor.get();
+          }
+          // restore the empty stored block removed by the sender
+          static constexpr uint8_t kTail[] = {0x00, 0x00, 0xff, 0xff};
+          m_payload.append(std::begin(kTail), std::end(kTail));
+          m_decompressed.clear();
+          bool ok = decompressor->Decompress(m_payload, m_decompressed,
+                                             m_maxMessageSize);
+          if (m_peerNoContextTakeover) {
+            decompressor->Reset();
+          }
+          if (!ok) {
+            return Fail(1009, "invalid or too large compressed message");
+          }
+          message = m_decompressed;
+        }
+
+        // Handle message
         switch (opcode) {
           case kOpCont:
             WS_DEBUG(m_stream, "WS Fragment {} [{}]", m_payload.size(),
                      DebugBinary(m_payload));
             switch (m_fragmentOpcode) {
               case kOpText:
-                if (!m_combineFragments || fin) {
+                if (!combine || fin) {
                   std::string_view content{
-                      reinterpret_cast<char*>(m_payload.data()),
-                      m_payload.size()};
+                      reinterpret_cast<const char*>(message.data()),
+                      message.size()};
                   WS_DEBUG(m_stream, "WS RecvText(Defrag) {} ({})",
-                           m_payload.size(), DebugText(content));
+                           message.size(), DebugText(content));
                   text(content, fin);
                 }
                 break;
               case kOpBinary:
-                if (!m_combineFragments || fin) {
+                if (!combine || fin) {
                   WS_DEBUG(m_stream, "WS RecvBinary(Defrag) {} ({})",
-                           m_payload.size(), DebugBinary(m_payload));
-                  binary(m_payload, fin);
+                           message.size(), DebugBinary(message));
+                  binary(message, fin);
                 }
                 break;
               default:
@@ -595,15 +749,15 @@ void WebSocket::HandleIncoming(uv::Buffer& buf, size_t size) {
             }
             break;
           case kOpText: {
-            std::string_view content{reinterpret_cast<char*>(m_payload.data()),
-                                     m_payload.size()};
+            std::string_view content{
+                reinterpret_cast<const char*>(message.data()), message.size()};
             if (m_fragmentOpcode != 0) {
               WS_DEBUG(m_stream, "WS RecvText {} ({}) -> INCOMPLETE FRAGMENT",
-                       m_payload.size(), DebugText(content));
+                       message.size(), DebugText(content));
               return Fail(1002, "incomplete fragment");
             }
-            if (!m_combineFragments || fin) {
-              WS_DEBUG(m_stream, "WS RecvText {} ({})", m_payload.size(),
+            if (!combine || fin) {
+              WS_DEBUG(m_stream, "WS RecvText {} ({})", message.size(),
                        DebugText(content));
               text(content, fin);
             }
@@ -619,10 +773,10 @@ void WebSocket::HandleIncoming(uv::Buffer& buf, size_t size) {
                        m_payload.size(), DebugBinary(m_payload));
               return Fail(1002, "incomplete fragment");
             }
-            if (!m_combineFragments || fin) {
-              WS_DEBUG(m_stream, "WS RecvBinary {} ({})", m_payload.size(),
-                       DebugBinary(m_payload));
-              binary(m_payload, fin);
+            if (!combine || fin) {
+              WS_DEBUG(m_stream, "WS RecvBinary {} ({})", message.size(),
+                       DebugBinary(message));
+              binary(message, fin);
             }
             if (!fin) {
               WS_DEBUG(m_stream, "WS RecvBinary {} StartFrag",
@@ -694,13 +848,16 @@ void WebSocket::HandleIncoming(uv::Buffer& buf, size_t size) {
         // Prepare for next message
         m_header.clear();
         m_headerSize = 0;
-        if (!m_combineFragments || fin) {
+        if (!combine || fin) {
           if (control) {
             m_controlPayload.clear();
           } else {
             m_payload.clear();
           }
         }
+        if (!control && fin) {
+          m_compressedMessage = false;
+        }
         m_frameStart = m_payload.size();
         m_frameSize = UINT64_MAX;
       }
@@ -759,7 +916,8 @@ void WebSocket::SendFrames(
   int numBytes = 0;
   for (auto&& frame : frames) {
     VerboseDebug(frame);
-    numBytes += req->m_frames.AddFrame(frame, m_server);
+    numBytes += req->m_frames.AddFrame(frame, m_server,
+                                       m_deflate ? &*m_deflate : nullptr);
     req->m_continueFrameOffs.emplace_back(numBytes);
     req->m_userBufs.append(frame.data.begin(), frame.data.end());
   }
@@ -806,7 +964,7 @@ std::span<const WebSocket::Frame> WebSocket::TrySendFrames(
         m_lastWriteReq = req;
         return req;
       },
-      std::move(callback));
+      std::move(callback), m_deflate ? &*m_deflate : nullptr);
 }
 
 void WebSocket::SendControl(
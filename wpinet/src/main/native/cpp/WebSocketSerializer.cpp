@@ -4,10 +4,17 @@
 
 #include "WebSocketSerializer.h"
 
+#include <algorithm>
+#include <cstring>
+#include <optional>
 #include <random>
+#include <vector>
+
+#include <wpi/Deflate.h>
 
 using namespace wpi::detail;
 
+static constexpr uint8_t kFlagRsv1 = 0x40;
 static constexpr uint8_t kFlagMasking = 0x80;
 static constexpr size_t kWriteAllocSize = 4096;
 
@@ -44,42 +51,80 @@ static std::span<uint8_t> BuildHeader(std::span<uint8_t, 10> header,
   return header.subspan(0, pHeader - header.data());
 }
 
+size_t wpi::detail::MaskData(uint8_t* out, std::span<const uint8_t> data,
+                             std::span<const uint8_t, 4> key, size_t keyPos) {
+  const uint8_t* in = data.data();
+  size_t len = data.size();
+
+  // mask 8 bytes at a time; the key repeats every 4 bytes, so the position
+  // within it doesn't change
+  if (len >= 8) {
+    uint8_t wideKeyBytes[8];
+    for (size_t i = 0; i < 8; ++i) {
+      wideKeyBytes[i] = key[(keyPos + i) % 4];
+    }
+    uint64_t wideKey;
+    std::memcpy(&wideKey, wideKeyBytes, 8);
+    for (; len >= 8; len -= 8, in += 8, out += 8) {
+      uint64_t v;
+      std::memcpy(&v, in, 8);
+      v ^= wideKey;
+      std::memcpy(out, &v, 8);
+    }
+  }
+
+  for (; len > 0; --len) {
+    *out++ = *in++ ^ key[keyPos];
+    keyPos = (keyPos + 1) % 4;
+  }
+  return keyPos;
+}
+
 size_t SerializedFrames::AddClientFrame(const WebSocket::Frame& frame) {
   uint8_t headerBuf[10];
   auto header = BuildHeader(headerBuf, false, frame);
 
-  // allocate a buffer per frame
+  // masking modifies the data, so it has to be copied; small frames share
+  // allocBufs, larger frames get their own buffer
   size_t size = header.size() + 4;
   for (auto&& buf : frame.data) {
     size += buf.len;
   }
-  m_allocBufs.emplace_back(uv::Buffer::Allocate(size));
-  m_bufs.emplace_back(m_allocBufs.back());
+  char* internalBuf;
+  if (size > kWriteAllocSize) {
+    m_allocBufs.emplace_back(uv::BufferPool::GetThreadLocal().Allocate(size));
+    m_allocBufPos = kWriteAllocSize;  // don't put anything else in it
+    internalBuf = m_allocBufs.back().data().data();
+  } else {
+    if (m_allocBufs.empty() || (m_allocBufPos + size) > kWriteAllocSize) {
+      m_allocBufs.emplace_back(
+          uv::BufferPool::GetThreadLocal().Allocate(kWriteAllocSize));
+      m_allocBufPos = 0;
+    }
+    internalBuf = m_allocBufs.back().data().data() + m_allocBufPos;
+    m_allocBufPos += size;
+  }
+  m_bufs.emplace_back(internalBuf, size);
 
-  char* internalBuf = m_allocBufs.back().data().data();
   std::memcpy(internalBuf, header.data(), header.size());
   internalBuf += header.size();
 
   // generate masking key
   static std::random_device rd;
   static std::default_random_engine gen{rd()};
-  std::uniform_int_distribution<unsigned int> dist(0, 255);
+  std::uniform_int_distribution<uint32_t> dist;
+  uint32_t keyValue = dist(gen);
   uint8_t key[4];
-  for (uint8_t& v : key) {
-    v = dist(gen);
-  }
+  std::memcpy(key, &keyValue, 4);
   std::memcpy(internalBuf, key, 4);
   internalBuf += 4;
 
   // copy and mask data
-  int n = 0;
+  size_t keyPos = 0;
   for (auto&& buf : frame.data) {
-    for (auto&& ch : buf.data()) {
-      *internalBuf++ = static_cast<uint8_t>(ch) ^ key[n++];
-      if (n >= 4) {
-        n = 0;
-      }
-    }
+    keyPos = MaskData(reinterpret_cast<uint8_t*>(internalBuf), buf.bytes(),
+                      key, keyPos);
+    internalBuf += buf.len;
   }
   return size;
 }
@@ -91,7 +136,8 @@ size_t SerializedFrames::AddServerFrame(const WebSocket::Frame& frame) {
   // manage allocBufs to efficiently store header
   if (m_allocBufs.empty() ||
       (m_allocBufPos + header.size()) > kWriteAllocSize) {
-    m_allocBufs.emplace_back(uv::Buffer::Allocate(kWriteAllocSize));
+    m_allocBufs.emplace_back(
+        uv::BufferPool::GetThreadLocal().Allocate(kWriteAllocSize));
     m_allocBufPos = 0;
   }
   char* internalBuf = m_allocBufs.back().data().data() + m_allocBufPos;
@@ -106,3 +152,62 @@ size_t SerializedFrames::AddServerFrame(const WebSocket::Frame& frame) {
   }
   return sent;
 }
+
+size_t SerializedFrames::AddCompressedFrame(
+    const WebSocket::Frame& frame, bool server,
+    const WebSocket::DeflateOptions& deflate) {
+  size_t size = 0;
+  for (auto&& buf : frame.data) {
+    size += buf.len;
+  }
+  if (size < deflate.threshold) {
+    return server ? AddServerFrame(frame) : AddClientFrame(frame);
+  }
+
+  // Messages are compressed independently of each other, so each thread can
+  // share one compressor (per window size) between all connections
+  thread_local std::optional<DeflateCompressor> compressors[8];
+  thread_local std::vector<uint8_t> in;
+  thread_local std::vector<uint8_t> out;
+  auto& compressor = compressors[std::clamp(deflate.windowBits, 8, 15) - 8];
+  if (!compressor) {
+    compressor.emplace(deflate.windowBits);
+  }
+
+  std::span<const uint8_t> data;
+  if (frame.data.size() == 1) {
+    data = frame.data[0].bytes();
+  } else {
+    in.clear();
+    for (auto&& buf : frame.data) {
+      in.insert(in.end(), buf.bytes().begin(), buf.bytes().end());
+    }
+    data = in;
+  }
+  out.clear();
+  compressor->Compress(data, out);
+  // the empty stored block at the end is implied (RFC 7692 section 7.2.1)
+  out.resize(out.size() - 4);
+  if (out.size() >= size) {
+    return server ? AddServerFrame(frame) : AddClientFrame(frame);
+  }
+
+  uint8_t opcode = frame.opcode | kFlagRsv1;
+  if (!server) {
+    // masking copies the data anyway
+    uv::Buffer buf{out};
+    return AddClientFrame(WebSocket::Frame{opcode, {&buf, 1}});
+  }
+
+  // servers send data buffers directly, so the compressed data needs its own
+  // buffer; keep the partly used header buffer last
+  uv::Buffer buf = uv::BufferPool::GetThreadLocal().Allocate(out.size());
+  std::memcpy(buf.base, out.data(), out.size());
+  if (m_allocBufs.empty()) {
+    m_allocBufs.emplace_back(buf);
+    m_allocBufPos = kWriteAllocSize;
+  } else {
+    m_allocBufs.insert(m_allocBufs.end() - 1, buf);
+  }
+  return AddServerFrame(WebSocket::Frame{opcode, {&buf, 1}});
+}
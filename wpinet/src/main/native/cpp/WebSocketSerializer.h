@@ -4,8 +4,11 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #include <functional>
 #include <memory>
+#include <span>
 #include <utility>
 
 #include <wpi/SmallVector.h>
@@ -17,6 +20,12 @@
 
 namespace wpi::detail {
 
+// Copies data while XORing it with the repeating 4-byte masking key, starting
+// at byte keyPos of the key. Masks in place if out is data.data(). Returns the
+// key position for the next byte.
+size_t MaskData(uint8_t* out, std::span<const uint8_t> data,
+                std::span<const uint8_t, 4> key, size_t keyPos = 0);
+
 class SerializedFrames {
  public:
   SerializedFrames() = default;
@@ -24,7 +33,13 @@ class SerializedFrames {
   SerializedFrames& operator=(const SerializedFrames&) = delete;
   ~SerializedFrames() { ReleaseBufs(); }
 
-  size_t AddFrame(const WebSocket::Frame& frame, bool server) {
+  // Compresses whole text and binary messages if deflate is not null
+  size_t AddFrame(const WebSocket::Frame& frame, bool server,
+                  const WebSocket::DeflateOptions* deflate = nullptr) {
+    if (deflate && (frame.opcode == WebSocket::Frame::kText ||
+                    frame.opcode == WebSocket::Frame::kBinary)) {
+      return AddCompressedFrame(frame, server, *deflate);
+    }
     if (server) {
       return AddServerFrame(frame);
     } else {
@@ -32,16 +47,18 @@ class SerializedFrames {
     }
   }
 
+  size_t AddCompressedFrame(const WebSocket::Frame& frame, bool server,
+                            const WebSocket::DeflateOptions& deflate);
+
   size_t AddClientFrame(const WebSocket::Frame& frame);
   size_t AddServerFrame(const WebSocket::Frame& frame);
 
   void ReleaseBufs() {
-    for (auto&& buf : m_allocBufs) {
-      buf.Deallocate();
-    }
+    uv::BufferPool::GetThreadLocal().Release(m_allocBufs);
     m_allocBufs.clear();
   }
 
+  // Allocated from uv::BufferPool::GetThreadLocal()
   SmallVector<uv::Buffer, 4> m_allocBufs;
   SmallVector<uv::Buffer, 4> m_bufs;
   size_t m_allocBufPos = 0;
@@ -145,7 +162,8 @@ template <typename MakeReq, typename Stream>
 std::span<const WebSocket::Frame> TrySendFrames(
     bool server, Stream& stream, std::span<const WebSocket::Frame> frames,
     MakeReq&& makeReq,
-    std::function<void(std::span<uv::Buffer>, uv::Error)> callback) {
+    std::function<void(std::span<uv::Buffer>, uv::Error)> callback,
+    const WebSocket::DeflateOptions* deflate = nullptr) {
   WS_DEBUG(stream, "TrySendFrames({})", frames.size());
   auto frameIt = frames.begin();
   auto frameEnd = frames.end();
@@ -157,7 +175,7 @@ std::span<const WebSocket::Frame> TrySendFrames(
     SmallVector<int, 32> frameOffs;
     int numBytes = 0;
     while (frameIt != frameEnd) {
-      numBytes += sendFrames.AddFrame(*frameIt++, server);
+      numBytes += sendFrames.AddFrame(*frameIt++, server, deflate);
       frameOffs.emplace_back(numBytes);
       if ((server && (numBytes >= 65536 || frameOffs.size() > 32)) ||
           (!server && numBytes >= 8192)) {
@@ -269,7 +287,8 @@ std::span<const WebSocket::Frame> TrySendFrames(
           // WS_DEBUG("generating frame for continuation {} {}\n",
           //          frameStart->opcode, frameStart->data.size());
           // need to generate and add this frame
-          continuePos += req->m_frames.AddFrame(*frameStart, server);
+          continuePos +=
+              req->m_frames.AddFrame(*frameStart, server, deflate);
         }
         req->m_continueFrameOffs.emplace_back(continuePos);
         isFin = (frameStart->opcode & WebSocket::kFlagFin) != 0;
@@ -0,0 +1,113 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpinet/uv/Buffer.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+
+using namespace wpi::uv;
+
+// Each pooled allocation starts with a header holding its size class, so
+// buffers can be released without knowing their original size.
+static constexpr size_t kHeaderSize = alignof(std::max_align_t);
+static constexpr size_t kUnpooled = SIZE_MAX;
+
+static size_t ClassSize(size_t sizeClass) {
+  return BufferPool::kMinPooledSize << sizeClass;
+}
+
+BufferPool& BufferPool::GetThreadLocal() {
+  // never destroyed, so buffers can still be released while other thread
+  // local and static objects are destroyed
+  thread_local BufferPool* pool = new BufferPool;
+  return *pool;
+}
+
+Buffer BufferPool::Allocate(size_t size) {
+  size_t sizeClass = kUnpooled;
+  size_t allocSize = size;
+  if (size <= kMaxPooledSize) {
+    sizeClass = std::bit_width((std::max(size, kMinPooledSize) - 1) /
+                               kMinPooledSize);
+    allocSize = ClassSize(sizeClass);
+
+    auto& cls = m_classes[sizeClass];
+    cls.highWater = (std::max)(cls.highWater, ++cls.inUse);
+    if (!cls.free.empty()) {
+      char* base = cls.free.back();
+      cls.free.pop_back();
+      return Buffer{base, size};
+    }
+  }
+
+  char* raw = new char[kHeaderSize + allocSize];
+  std::memcpy(raw, &sizeClass, sizeof(sizeClass));
+  return Buffer{raw + kHeaderSize, size};
+}
+
+void BufferPool::Release(Buffer& buf) {
+  if (!buf.base) {
+    return;
+  }
+  char* raw = buf.base - kHeaderSize;
+  size_t sizeClass;
+  std::memcpy(&sizeClass, raw, sizeof(sizeClass));
+  char* base = buf.base;
+  buf = Buffer{};
+
+  if (sizeClass == kUnpooled) {
+    delete[] raw;
+    return;
+  }
+
+  // the buffer may have been allocated by another thread's pool
+  auto& cls = m_classes[sizeClass];
+  if (cls.inUse > 0) {
+    --cls.inUse;
+  }
+  if (cls.inUse + cls.free.size() <
+      (std::max)(cls.highWater, cls.lastHighWater)) {
+    cls.free.emplace_back(base);
+  } else {
+    delete[] raw;
+  }
+
+  if (++m_releases >= kTrimInterval) {
+    Trim();
+  }
+}
+
+void BufferPool::Trim() {
+  m_releases = 0;
+  for (auto& cls : m_classes) {
+    // keep only enough free buffers to reach the most recent high-water mark
+    size_t keep = (std::max)(cls.highWater, cls.lastHighWater);
+    keep = keep > cls.inUse ? keep - cls.inUse : 0;
+    while (cls.free.size() > keep) {
+      delete[] (cls.free.back() - kHeaderSize);
+      cls.free.pop_back();
+    }
+    cls.lastHighWater = cls.highWater;
+    cls.highWater = cls.inUse;
+  }
+}
+
+void BufferPool::Clear() {
+  for (auto& cls : m_classes) {
+    for (char* base : cls.free) {
+      delete[] (base - kHeaderSize);
+    }
+    cls.free.clear();
+  }
+}
+
+size_t BufferPool::GetPooledBytes() const {
+  size_t bytes = 0;
+  for (size_t i = 0; i < kNumClasses; ++i) {
+    bytes += m_classes[i].free.size() * ClassSize(i);
+  }
+  return bytes;
+}
@@ -193,10 +193,19 @@ void Udp::Send(std::span<const Buffer> bufs,
 }
 
 void Udp::StartRecv() {
+  StartRecv(1);
+}
+
+void Udp::StartRecv(unsigned int batchSize) {
   if (IsLoopClosing()) {
     return;
   }
-  Invoke(&uv_udp_recv_start, GetRaw(), &AllocBuf,
+  m_recvBatchSize = batchSize == 0 ? 1 : batchSize;
+  Invoke(&uv_udp_recv_start, GetRaw(),
+         [](uv_handle_t* handle, size_t size, uv_buf_t* buf) {
+           auto& h = *static_cast<Udp*>(handle->data);
+           AllocBuf(handle, size * h.m_recvBatchSize, buf);
+         },
          [](uv_udp_t* handle, ssize_t nread, const uv_buf_t* buf,
             const sockaddr* addr, unsigned flags) {
            auto& h = *static_cast<Udp*>(handle->data);
@@ -209,8 +218,11 @@ void Udp::StartRecv() {
              h.ReportError(nread);
            }
 
-           // free the buffer
-           h.FreeBuf(data);
+           // free the buffer; a batch shares one buffer, which is freed by a
+           // final UV_UDP_MMSG_FREE callback
+           if (!(flags & UV_UDP_MMSG_CHUNK)) {
+             h.FreeBuf(data);
+           }
          });
 }
 
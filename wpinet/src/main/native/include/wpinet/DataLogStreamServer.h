@@ -0,0 +1,78 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef WPINET_DATALOGSTREAMSERVER_H_
+#define WPINET_DATALOGSTREAMSERVER_H_
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <span>
+
+namespace wpi {
+
+/**
+ * Serves the live byte stream of a data log over TCP, so that live views can
+ * read exactly the data being logged.  Each client receives a complete data
+ * log stream: the header and the records needed to start reading (start and
+ * metadata records, and the latest schema values, of entries started before
+ * the oldest buffered data), then the recently buffered data, then new data
+ * as it is written.  A client that falls behind by more than the buffer size
+ * is disconnected.
+ *
+ * The log data is provided by Write(), typically from the write function of a
+ * DataLogBackgroundWriter:
+ *
+ * @code
+ * wpi::DataLogStreamServer server{5810};
+ * wpi::log::DataLogBackgroundWriter log{
+ *     [&](auto data) { server.Write(data); }};
+ * @endcode
+ *
+ * The serialized data is buffered once and shared by all clients.
+ */
+class DataLogStreamServer {
+ public:
+  /**
+   * Starts serving on a port.
+   *
+   * @param port TCP port number
+   * @param bufferSize amount of recent log data, in bytes, buffered for
+   *                   clients to catch up from
+   */
+  explicit DataLogStreamServer(unsigned int port,
+                               size_t bufferSize = 4 * 1024 * 1024);
+  ~DataLogStreamServer();
+
+  DataLogStreamServer(const DataLogStreamServer&) = delete;
+  DataLogStreamServer& operator=(const DataLogStreamServer&) = delete;
+
+  /**
+   * Appends data log bytes to the stream.  Data must be provided in order
+   * starting with the file header, but may be split at arbitrary points.
+   * Calls must not be concurrent.  An empty data array indicates the end of
+   * the log: clients are disconnected, and the next call starts a new log.
+   *
+   * @param data data log bytes
+   */
+  void Write(std::span<const uint8_t> data);
+
+  /**
+   * Gets the number of connected clients.
+   *
+   * @return Number of clients
+   */
+  unsigned int GetNumClients() const;
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> m_impl;
+};
+
+}  // namespace wpi
+
+#endif  // WPINET_DATALOGSTREAMSERVER_H_
@@ -0,0 +1,94 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <uv.h>
+
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <wpi/StringMap.h>
+#include <wpi/mutex.h>
+
+namespace wpi {
+
+/**
+ * Process-wide cache of resolved host addresses.
+ *
+ * Name resolution (particularly mDNS) can take seconds, so consumers such as
+ * ParallelTcpConnector use the cached addresses of a host right away while a
+ * fresh resolution runs, and add the results of each resolution. Addresses
+ * found by MulticastServiceResolver are also added.
+ *
+ * Host names are compared case-insensitively, ignoring a trailing '.'.
+ * Addresses are stored without ports. This class is thread-safe.
+ */
+class HostAddressCache {
+ public:
+  using clock = std::chrono::steady_clock;
+
+  /**
+   * Default time to keep an address, which is the mDNS recommended TTL for
+   * host address records (RFC 6762).
+   */
+  static constexpr std::chrono::seconds kDefaultTtl{120};
+
+  /**
+   * Gets the process-wide cache.
+   *
+   * @return Cache
+   */
+  static HostAddressCache& GetInstance();
+
+  /**
+   * Adds an address of a host, or extends the expiry time of an existing one.
+   *
+   * @param host host name
+   * @param addr IPv4 or IPv6 address; the port is ignored
+   * @param ttl how long to keep the address
+   */
+  void Add(std::string_view host, const sockaddr& addr,
+           clock::duration ttl = kDefaultTtl);
+
+  /**
+   * Adds an IPv4 address of a host, or extends the expiry time of an existing
+   * one.
+   *
+   * @param host host name
+   * @param ipv4Address IPv4 address, in network byte order
+   * @param ttl how long to keep the address
+   */
+  void AddIPv4(std::string_view host, unsigned int ipv4Address,
+               clock::duration ttl = kDefaultTtl);
+
+  /**
+   * Gets the unexpired addresses of a host, most recently added first.
+   *
+   * @param host host name
+   * @param port port to set in the returned addresses
+   * @return Addresses
+   */
+  std::vector<sockaddr_storage> Get(std::string_view host, unsigned int port);
+
+  /**
+   * Removes all addresses.
+   */
+  void Clear();
+
+ private:
+  struct Entry {
+    sockaddr_storage addr;
+    clock::time_point expiry;
+  };
+
+  std::string GetKey(std::string_view host) const;
+
+  wpi::mutex m_mutex;
+  wpi::StringMap<std::vector<Entry>> m_hosts;
+};
+
+}  // namespace wpi
@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <span>
+#include <string>
 #include <string_view>
 
 #include "wpinet/HttpParser.h"
@@ -125,6 +126,20 @@ class HttpServerConnection {
    */
   virtual void SendError(int code, std::string_view message = {});
 
+  /**
+   * Stops processing requests, e.g. while a response is prepared
+   * asynchronously. Requests received in the meantime (including pipelined
+   * requests already read) are processed after ResumeRequests(), so
+   * responses are sent in request order and m_request and m_keepAlive keep
+   * describing the current request. May be called from ProcessRequest().
+   */
+  void PauseRequests();
+
+  /**
+   * Resumes processing requests after PauseRequests().
+   */
+  void ResumeRequests();
+
   /** The HTTP request. */
   HttpParser m_request{HttpParser::kRequest};
 
@@ -145,6 +160,13 @@ class HttpServerConnection {
 
   /** The message complete connection. */
   sig::Connection m_messageCompleteConn;
+
+ private:
+  void ProcessInput(std::string_view data);
+
+  // input received but not parsed while requests are paused
+  std::string m_pausedInput;
+  bool m_paused = false;
 };
 
 }  // namespace wpi
@@ -5,6 +5,8 @@
 #ifndef WPINET_HTTPUTIL_H_
 #define WPINET_HTTPUTIL_H_
 
+#include <stdint.h>
+
 #include <initializer_list>
 #include <memory>
 #include <optional>
@@ -44,6 +46,24 @@ std::string_view EscapeURI(std::string_view str, SmallVectorImpl<char>& buf,
 // @return Escaped string
 std::string_view EscapeHTML(std::string_view str, SmallVectorImpl<char>& buf);
 
+// Parse the value of a Range header.  Only a single range of bytes is
+// supported; if the header is malformed or requests anything else (e.g.
+// multiple ranges), it should be ignored and the whole resource sent.
+// @param value Header value
+// @param size Size of the resource
+// @param unsatisfiable Set to true if the range does not overlap the resource
+// @return Offset and length of the range, or empty if the header should be
+//     ignored or the range is not satisfiable
+std::optional<std::pair<uint64_t, uint64_t>> ParseHttpRange(
+    std::string_view value, uint64_t size, bool* unsatisfiable);
+
+// Check whether an If-None-Match header matches an entity tag.  Uses the weak
+// comparison, so "W/" prefixes are ignored.
+// @param value Header value (e.g. a list of entity tags, or "*")
+// @param etag Entity tag of the resource, including quotes
+// @return True if any of the entity tags in the header match
+bool MatchHttpETag(std::string_view value, std::string_view etag);
+
 // Parse a set of HTTP headers.  Saves just the Content-Type and Content-Length
 // fields.
 // @param is Input stream
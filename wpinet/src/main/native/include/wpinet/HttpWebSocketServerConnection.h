@@ -7,6 +7,7 @@
 
 #include <initializer_list>
 #include <memory>
+#include <optional>
 #include <span>
 #include <string>
 #include <string_view>
@@ -62,7 +63,7 @@ class HttpWebSocketServerConnection
       auto self = this->shared_from_this();
 
       // Accept the upgrade
-      auto ws = m_helper.Accept(m_stream, protocol);
+      auto ws = m_helper.Accept(m_stream, protocol, m_deflate);
 
       // Set this as the websocket user data to keep it around
       ws->SetData(self);
@@ -117,6 +118,12 @@ class HttpWebSocketServerConnection
    */
   WebSocket* m_websocket = nullptr;
 
+  /**
+   * permessage-deflate options used when accepting an upgrade.  If set,
+   * compression is used if the client offers it.
+   */
+  std::optional<WebSocket::DeflateOptions> m_deflate;
+
  private:
   WebSocketServerHelper m_helper;
   SmallVector<std::string, 2> m_protocols;
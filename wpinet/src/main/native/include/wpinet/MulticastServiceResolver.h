@@ -70,11 +70,7 @@ class MulticastServiceResolver {
   struct Impl;
 
  private:
-  void PushData(ServiceData&& data) {
-    std::scoped_lock lock{mutex};
-    queue.emplace_back(std::forward<ServiceData>(data));
-    event.Set();
-  }
+  void PushData(ServiceData&& data);
   wpi::Event event{true};
   std::vector<ServiceData> queue;
   wpi::mutex mutex;
@@ -30,6 +30,9 @@ class Timer;
  * Parallel TCP connector.  Attempts parallel resolution and connection to
  * multiple servers with automatic retry if none connect.
  *
+ * Addresses of each server found by earlier resolutions (see HostAddressCache)
+ * are tried immediately, in parallel with the new resolution.
+ *
  * Each successful TCP connection results in a call to the connected callback.
  * For correct operation, the consuming code (either the connected callback or
  * e.g. task it starts) must call Succeeded() to indicate if the connection has
@@ -110,6 +113,7 @@ class ParallelTcpConnector
  private:
   bool IsConnected() const { return m_isConnected || m_servers.empty(); }
   void Connect();
+  void StartAttempt(const sockaddr& addr, const std::string& host);
   void CancelAll(wpi::uv::Tcp* except = nullptr);
 
   wpi::uv::Loop& m_loop;
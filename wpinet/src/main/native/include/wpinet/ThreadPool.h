@@ -0,0 +1,143 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef WPINET_THREADPOOL_H_
+#define WPINET_THREADPOOL_H_
+
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <wpi/future.h>
+
+#include "wpinet/EventLoopRunner.h"
+
+namespace wpi {
+
+/**
+ * A pool of worker threads for running short blocking tasks (file I/O,
+ * encoding, name resolution, etc) without each component starting its own
+ * thread.
+ *
+ * Each worker has its own task queue. Tasks queued from a worker thread go to
+ * that worker's queue and are run most recently queued first; idle workers
+ * steal the oldest tasks from the other workers' queues. Tasks queued from
+ * other threads are spread across the workers.
+ *
+ * Tasks must not block waiting for other tasks in the same pool, as all the
+ * workers may be blocked that way.
+ */
+class ThreadPool final {
+ public:
+  using Task = std::function<void()>;
+
+  /**
+   * Constructs a pool and starts its threads.
+   *
+   * @param numThreads number of threads; 0 to use the number of hardware
+   *                   threads
+   */
+  explicit ThreadPool(unsigned int numThreads = 0);
+
+  /**
+   * Runs all queued tasks (including tasks they queue), then stops the
+   * threads.  Must not be called from a task.
+   */
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /**
+   * Gets the shared process-wide pool.
+   *
+   * @return Pool
+   */
+  static ThreadPool& GetInstance();
+
+  /**
+   * Gets the number of threads.
+   *
+   * @return Number of threads
+   */
+  unsigned int GetNumThreads() const;
+
+  /**
+   * Queues a task.  It's safe to call this function from any thread,
+   * including from a task.
+   *
+   * @param task task to run on a worker thread
+   */
+  void Post(Task task);
+
+  /**
+   * Calls the work function on a worker thread, and returns a future for the
+   * result.  It's safe to call this function from any thread.
+   *
+   * @param work Work function (called on a worker thread)
+   * @param u Arguments to work function
+   * @return Future for the result of the work function
+   */
+  template <typename F, typename... U>
+  auto QueueWork(F&& work, U&&... u)
+      -> future<std::invoke_result_t<std::decay_t<F>, std::decay_t<U>...>> {
+    using R = std::invoke_result_t<std::decay_t<F>, std::decay_t<U>...>;
+    uint64_t req = PromiseFactory<R>::GetInstance().CreateRequest();
+    Post([req, work = std::forward<F>(work),
+          params = std::make_tuple(std::forward<U>(u)...)]() mutable {
+      if constexpr (std::is_void_v<R>) {
+        std::apply(work, std::move(params));
+        PromiseFactory<R>::GetInstance().SetValue(req);
+      } else {
+        PromiseFactory<R>::GetInstance().SetValue(
+            req, std::apply(work, std::move(params)));
+      }
+    });
+    return PromiseFactory<R>::GetInstance().CreateFuture(req);
+  }
+
+  /**
+   * Calls the work function on a worker thread, and then calls the afterWork
+   * function with the result on an event loop.  It's safe to call this
+   * function from any thread.
+   *
+   * The runner must outlive the work; afterWork is not called if the loop
+   * has been stopped.
+   *
+   * @param runner Event loop runner to call afterWork on
+   * @param work Work function (called on a worker thread)
+   * @param afterWork After work function (called on the loop thread)
+   * @param u Arguments to work function
+   */
+  template <typename F, typename A, typename... U>
+  void QueueWorkThen(EventLoopRunner& runner, F&& work, A&& afterWork,
+                     U&&... u) {
+    using R = std::invoke_result_t<std::decay_t<F>, std::decay_t<U>...>;
+    Post([runner = &runner, work = std::forward<F>(work),
+          afterWork = std::forward<A>(afterWork),
+          params = std::make_tuple(std::forward<U>(u)...)]() mutable {
+      if constexpr (std::is_void_v<R>) {
+        std::apply(work, std::move(params));
+        runner->ExecAsync(
+            [afterWork = std::move(afterWork)](uv::Loop&) { afterWork(); });
+      } else {
+        runner->ExecAsync(
+            [afterWork = std::move(afterWork),
+             result = std::apply(work, std::move(params))](uv::Loop&) {
+              afterWork(result);
+            });
+      }
+    });
+  }
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> m_impl;
+};
+
+}  // namespace wpi
+
+#endif  // WPINET_THREADPOOL_H_
@@ -38,9 +38,20 @@ class UDPClient {
   // The passed in address MUST be a resolved IP address.
   int send(std::span<const uint8_t> data, std::string_view server, int port);
   int send(std::string_view data, std::string_view server, int port);
+  // Sends each datagram to the same server and port, using a single system
+  // call where supported.  Returns the number of datagrams sent, or -1 if none
+  // could be sent.
+  int send_batch(std::span<const std::span<const uint8_t>> datagrams,
+                 std::string_view server, int port);
   int receive(uint8_t* data_received, int receive_len);
   int receive(uint8_t* data_received, int receive_len,
               SmallVectorImpl<char>* addr_received, int* port_received);
+  // Receives up to buffers.size() datagrams, one per buffer, using a single
+  // system call where supported.  Only the first datagram is waited for.  The
+  // length of each received datagram is stored in received_lens.  Returns the
+  // number of datagrams received, or -1 on error.
+  int receive_batch(std::span<const std::span<uint8_t>> buffers,
+                    int* received_lens);
   int set_timeout(double timeout);
 };
 
@@ -10,10 +10,12 @@
 #include <functional>
 #include <initializer_list>
 #include <memory>
+#include <optional>
 #include <span>
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include <wpi/Signal.h>
 #include <wpi/SmallVector.h>
@@ -24,6 +26,8 @@
 
 namespace wpi {
 
+class DeflateDecompressor;
+
 namespace uv {
 class Stream;
 }  // namespace uv
@@ -68,6 +72,34 @@ class WebSocket : public std::enable_shared_from_this<WebSocket> {
     CLOSED
   };
 
+  /**
+   * permessage-deflate (RFC 7692) compression options.
+   *
+   * Sent messages are always compressed independently of earlier messages
+   * (no context takeover), so one compressor can be shared by all connections
+   * on a thread and unsent frames can be compressed again when resent.
+   */
+  struct DeflateOptions {
+    /**
+     * Base 2 logarithm of the LZ77 window used to compress sent messages
+     * (8-15). The peer may request a smaller window.
+     */
+    int windowBits = 15;
+
+    /**
+     * Messages smaller than this many bytes are sent uncompressed, as
+     * compressing them costs more time than it saves bandwidth.
+     */
+    size_t threshold = 256;
+
+    /**
+     * Whether the peer may compress messages using the contents of earlier
+     * messages. This compresses better, but the last 32 KB of received
+     * messages must be kept for each connection.
+     */
+    bool allowContextTakeover = true;
+  };
+
   /**
    * Client connection options.
    */
@@ -79,6 +111,29 @@ class WebSocket : public std::enable_shared_from_this<WebSocket> {
 
     /** Additional headers to include in handshake. */
     std::span<const std::pair<std::string_view, std::string_view>> extraHeaders;
+
+    /**
+     * permessage-deflate options. If set, compression is offered to the
+     * server, which may decline it.
+     */
+    std::optional<DeflateOptions> deflate;
+  };
+
+  /**
+   * Server connection options.
+   */
+  struct ServerOptions {
+    /**
+     * The value of the Sec-WebSocket-Extensions header field(s) in the client
+     * request.
+     */
+    std::string_view extensions;
+
+    /**
+     * permessage-deflate options. If set, compression is accepted if the
+     * client offers it.
+     */
+    std::optional<DeflateOptions> deflate;
   };
 
   /**
@@ -146,10 +201,11 @@ class WebSocket : public std::enable_shared_from_this<WebSocket> {
    *                client request
    * @param protocol The subprotocol to send to the client (in the
    *                 Sec-WebSocket-Protocol header field).
+   * @param options Handshake options
    */
   static std::shared_ptr<WebSocket> CreateServer(
       uv::Stream& stream, std::string_view key, std::string_view version,
-      std::string_view protocol = {});
+      std::string_view protocol = {}, const ServerOptions& options = {});
 
   /**
    * Get connection state.
@@ -172,6 +228,12 @@ class WebSocket : public std::enable_shared_from_this<WebSocket> {
    */
   std::string_view GetProtocol() const { return m_protocol; }
 
+  /**
+   * Get whether permessage-deflate compression was negotiated.  Only valid in
+   * or after the open() event.
+   */
+  bool IsCompressed() const { return m_deflate.has_value(); }
+
   /**
    * Set the maximum message size.  Default is 128 KB.  If configured to combine
    * fragments this maximum applies to the entire message (all combined
@@ -513,6 +575,13 @@ class WebSocket : public std::enable_shared_from_this<WebSocket> {
   // subprotocol, set via constructor (server) or handshake (client)
   std::string m_protocol;
 
+  // negotiated permessage-deflate parameters; windowBits is the window used
+  // for sending
+  std::optional<DeflateOptions> m_deflate;
+  // whether the peer compresses each message independently
+  bool m_peerNoContextTakeover = false;
+  std::unique_ptr<DeflateDecompressor> m_decompressor;
+
   // user-settable configuration
   size_t m_maxMessageSize = 128 * 1024;
   bool m_combineFragments = true;
@@ -535,6 +604,8 @@ class WebSocket : public std::enable_shared_from_this<WebSocket> {
   size_t m_frameStart = 0;
   uint64_t m_frameSize = UINT64_MAX;
   uint8_t m_fragmentOpcode = 0;
+  bool m_compressedMessage = false;
+  std::vector<uint8_t> m_decompressed;
 
   // temporary data used only during client handshake
   class ClientHandshakeData;
@@ -544,7 +615,7 @@ class WebSocket : public std::enable_shared_from_this<WebSocket> {
                    std::span<const std::string_view> protocols,
                    const ClientOptions& options);
   void StartServer(std::string_view key, std::string_view version,
-                   std::string_view protocol);
+                   std::string_view protocol, const ServerOptions& options);
   void SendClose(uint16_t code, std::string_view reason);
   void SetClosed(uint16_t code, std::string_view reason, bool failed = false);
   void HandleIncoming(uv::Buffer& buf, size_t size);
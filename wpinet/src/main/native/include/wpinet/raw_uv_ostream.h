@@ -34,6 +34,20 @@ class raw_uv_ostream : public raw_ostream {
     SetUnbuffered();
   }
 
+  /**
+   * Construct a new raw_uv_ostream.
+   * @param bufs Buffers vector.  NOT cleared on construction.
+   * @param pool Pool to allocate from; the buffers must be released with
+   *             uv::BufferPool::Release().
+   * @param allocSize Size to allocate for each buffer.
+   */
+  raw_uv_ostream(SmallVectorImpl<uv::Buffer>& bufs, uv::BufferPool& pool,
+                 size_t allocSize)
+      : m_bufs(bufs),
+        m_alloc([&pool, allocSize] { return pool.Allocate(allocSize); }) {
+    SetUnbuffered();
+  }
+
   /**
    * Construct a new raw_uv_ostream.
    * @param bufs Buffers vector.  NOT cleared on construction.
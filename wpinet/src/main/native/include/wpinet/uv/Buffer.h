@@ -7,11 +7,13 @@
 
 #include <uv.h>
 
+#include <array>
 #include <cstring>
 #include <initializer_list>
 #include <span>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include <wpi/SmallVector.h>
 
@@ -171,6 +173,91 @@ class SimpleBufferPool {
   size_t m_size;  // NOLINT
 };
 
+/**
+ * A pool allocator for Buffers of varying sizes.
+ *
+ * Requested sizes are rounded up to power-of-two size classes, and released
+ * buffers are kept per size class for reuse; sizes above kMaxPooledSize are
+ * allocated and freed directly.  Each size class keeps at most as many
+ * buffers as were recently in use at once (its high-water mark), so the pool
+ * shrinks again after a burst.
+ *
+ * Buffers allocated from a pool MUST be released with Release() (to any
+ * pool), not with Buffer::Deallocate().  The length of a released buffer may
+ * have been changed since allocation.
+ *
+ * Pools are not thread-safe.  GetThreadLocal() returns a pool for the calling
+ * thread, which for event loop callbacks is effectively a pool per loop.
+ */
+class BufferPool {
+ public:
+  /// Smallest size class.
+  static constexpr size_t kMinPooledSize = 256;
+
+  /// Largest size class; larger buffers are not pooled.
+  static constexpr size_t kMaxPooledSize = 65536;
+
+  BufferPool() = default;
+  ~BufferPool() { Clear(); }
+
+  BufferPool(const BufferPool& other) = delete;
+  BufferPool& operator=(const BufferPool& other) = delete;
+
+  /**
+   * Gets the pool for the calling thread.
+   */
+  static BufferPool& GetThreadLocal();
+
+  /**
+   * Allocate a buffer.
+   *
+   * @param size Size of the buffer.  The returned buffer's len is set to this.
+   */
+  Buffer Allocate(size_t size);
+
+  /**
+   * Release a buffer allocated by a pool, and reset it to empty.
+   */
+  void Release(Buffer& buf);
+
+  /**
+   * Release buffers allocated by a pool, and reset them to empty.
+   */
+  void Release(std::span<Buffer> bufs) {
+    for (auto& buf : bufs) {
+      Release(buf);
+    }
+  }
+
+  /**
+   * Clear the pool, freeing all pooled buffers.
+   */
+  void Clear();
+
+  /**
+   * Get the total size of the buffers currently held in the pool.
+   */
+  size_t GetPooledBytes() const;
+
+ private:
+  static constexpr size_t kNumClasses = 9;  // kMinPooledSize..kMaxPooledSize
+
+  // Number of releases between high-water mark updates.
+  static constexpr size_t kTrimInterval = 256;
+
+  struct SizeClass {
+    std::vector<char*> free;
+    size_t inUse = 0;
+    size_t highWater = 0;      // most in use at once in this interval
+    size_t lastHighWater = 0;  // most in use at once in the last interval
+  };
+
+  void Trim();
+
+  std::array<SizeClass, kNumClasses> m_classes;
+  size_t m_releases = 0;
+};
+
 }  // namespace wpi::uv
 
 #endif  // WPINET_UV_BUFFER_H_
@@ -362,6 +362,21 @@ class Udp final : public HandleImpl<Udp, uv_udp_t> {
    */
   void StartRecv();
 
+  /**
+   * Prepare for receiving data, reading up to batchSize datagrams per system
+   * call.  Batching requires the handle to have been created with the
+   * UV_UDP_RECVMMSG flag and platform support for recvmmsg(2) (see
+   * IsUsingRecvmmsg()); otherwise this is identical to StartRecv().
+   *
+   * Each batched read allocates a single buffer large enough for batchSize
+   * maximum-size (64 KiB) datagrams, so a pooling allocator set with
+   * SetBufferAllocator() is recommended.  A received signal is still emitted
+   * for each datagram, with UV_UDP_MMSG_CHUNK set in the flags.
+   *
+   * @param batchSize Maximum number of datagrams to read at once (at most 20).
+   */
+  void StartRecv(unsigned int batchSize);
+
   /**
    * Stop listening for incoming datagrams.
    */
@@ -393,6 +408,9 @@ class Udp final : public HandleImpl<Udp, uv_udp_t> {
    * the number of bytes received, the address of the sender, and flags.
    */
   sig::Signal<Buffer&, size_t, const sockaddr&, unsigned> received;
+
+ private:
+  unsigned int m_recvBatchSize = 1;
 };
 
 }  // namespace wpi::uv
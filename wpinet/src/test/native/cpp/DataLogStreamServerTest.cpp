@@ -0,0 +1,128 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpinet/DataLogStreamServer.h"
+
+#include <stdint.h>
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <wpi/DataLogBackgroundWriter.h>
+#include <wpi/DataLogReader.h>
+#include <wpi/Logger.h>
+#include <wpi/MemoryBuffer.h>
+
+#include "wpinet/NetworkStream.h"
+#include "wpinet/TCPConnector.h"
+
+namespace {
+
+constexpr int kPort = 17834;
+
+std::unique_ptr<wpi::NetworkStream> Connect(wpi::DataLogStreamServer& server,
+                                            unsigned int numClients) {
+  wpi::Logger logger;
+  auto stream = wpi::TCPConnector::connect("127.0.0.1", kPort, logger, 1);
+  for (int i = 0; i < 100 && server.GetNumClients() < numClients; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return stream;
+}
+
+// reads until the server closes the connection
+std::vector<uint8_t> ReadAll(wpi::NetworkStream& stream) {
+  std::vector<uint8_t> data;
+  char buf[4096];
+  for (;;) {
+    wpi::NetworkStream::Error err;
+    size_t len = stream.receive(buf, sizeof(buf), &err, 5);
+    if (len == 0) {
+      break;
+    }
+    data.insert(data.end(), buf, buf + len);
+  }
+  return data;
+}
+
+// returns the values of the integer entry "value"
+std::vector<int64_t> ReadValues(const std::vector<uint8_t>& data) {
+  std::vector<int64_t> values;
+  wpi::log::DataLogReader reader{wpi::MemoryBuffer::GetMemBuffer(data, "")};
+  EXPECT_TRUE(reader.IsValid());
+  int entry = 0;
+  for (auto&& record : reader) {
+    wpi::log::StartRecordData start;
+    int64_t value;
+    if (record.IsStart() && record.GetStartData(&start)) {
+      if (start.name == "value") {
+        entry = start.entry;
+      }
+    } else if (entry != 0 && record.GetEntry() == entry &&
+               record.GetInteger(&value)) {
+      values.push_back(value);
+    }
+  }
+  return values;
+}
+
+}  // namespace
+
+TEST(DataLogStreamServerTest, LiveAndCatchUp) {
+  constexpr int64_t kCount = 20000;
+  wpi::DataLogStreamServer server{kPort, 64 * 1024};
+
+  // connected before the log starts; receives everything
+  auto early = Connect(server, 1);
+  ASSERT_TRUE(early);
+  // read concurrently, so the client keeps up with the log
+  auto earlyData =
+      std::async(std::launch::async, [&] { return ReadAll(*early); });
+
+  std::unique_ptr<wpi::NetworkStream> late;
+  std::future<std::vector<uint8_t>> lateData;
+  {
+    wpi::log::DataLogBackgroundWriter log{
+        [&](auto data) { server.Write(data); }, 0.01};
+    int entry = log.Start("value", "int64");
+    // each batch is much smaller than the buffer, so connected clients keep up
+    auto append = [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; ++i) {
+        log.AppendInteger(entry, i, i + 1);
+        if (i % 1000 == 999) {
+          log.Flush();
+          std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+      }
+    };
+    append(0, kCount / 2);
+
+    // connects after the start record has left the buffer; receives the
+    // start record and the buffered data
+    late = Connect(server, 2);
+    ASSERT_TRUE(late);
+    lateData =
+        std::async(std::launch::async, [&] { return ReadAll(*late); });
+    append(kCount / 2, kCount);
+  }
+
+  auto earlyValues = ReadValues(earlyData.get());
+  ASSERT_EQ(earlyValues.size(), static_cast<size_t>(kCount));
+  for (int64_t i = 0; i < kCount; ++i) {
+    ASSERT_EQ(earlyValues[i], i);
+  }
+
+  auto lateValues = ReadValues(lateData.get());
+  ASSERT_FALSE(lateValues.empty());
+  EXPECT_GT(lateValues.front(), 0);
+  EXPECT_LT(lateValues.front(), kCount / 2);
+  for (size_t i = 1; i < lateValues.size(); ++i) {
+    ASSERT_EQ(lateValues[i], lateValues[i - 1] + 1);
+  }
+  EXPECT_EQ(lateValues.back(), kCount - 1);
+}
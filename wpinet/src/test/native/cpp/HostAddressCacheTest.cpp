@@ -0,0 +1,58 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpinet/HostAddressCache.h"  // NOLINT(build/include_order)
+
+#include <chrono>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "wpinet/uv/util.h"
+
+namespace wpi {
+
+static std::string ToString(const sockaddr_storage& addr) {
+  std::string ip;
+  unsigned int port = 0;
+  uv::AddrToName(addr, &ip, &port);
+  return ip + ":" + std::to_string(port);
+}
+
+TEST(HostAddressCacheTest, AddGet) {
+  HostAddressCache cache;
+  cache.AddIPv4("roborio-1234-frc.local.", htonl(0x0a0c2202));
+  sockaddr_in6 addr6;
+  uv::NameToAddr("fe80::1", 1735, &addr6);
+  cache.Add("roborio-1234-frc.local", reinterpret_cast<const sockaddr&>(addr6));
+  auto addrs = cache.Get("RoboRIO-1234-FRC.local", 5810);
+  ASSERT_EQ(addrs.size(), 2u);
+  EXPECT_EQ(ToString(addrs[0]), "fe80::1:5810");
+  EXPECT_EQ(ToString(addrs[1]), "10.12.34.2:5810");
+  EXPECT_TRUE(cache.Get("roborio-4321-frc.local", 5810).empty());
+}
+
+TEST(HostAddressCacheTest, Duplicate) {
+  HostAddressCache cache;
+  cache.AddIPv4("host", htonl(0x0a000001));
+  cache.AddIPv4("host", htonl(0x0a000002));
+  cache.AddIPv4("host", htonl(0x0a000001));
+  auto addrs = cache.Get("host", 1);
+  ASSERT_EQ(addrs.size(), 2u);
+  EXPECT_EQ(ToString(addrs[0]), "10.0.0.1:1");
+  EXPECT_EQ(ToString(addrs[1]), "10.0.0.2:1");
+}
+
+TEST(HostAddressCacheTest, Expiry) {
+  HostAddressCache cache;
+  cache.AddIPv4("host", htonl(0x0a000001), std::chrono::seconds{-1});
+  cache.AddIPv4("host", htonl(0x0a000002));
+  auto addrs = cache.Get("host", 1);
+  ASSERT_EQ(addrs.size(), 1u);
+  EXPECT_EQ(ToString(addrs[0]), "10.0.0.2:1");
+  cache.Clear();
+  EXPECT_TRUE(cache.Get("host", 1).empty());
+}
+
+}  // namespace wpi
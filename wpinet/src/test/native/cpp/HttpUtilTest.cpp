@@ -99,4 +99,70 @@ TEST(HttpMultipartScannerTest, SeqNoDashesNoDashes) {
   EXPECT_TRUE(scanner.IsDone());
 }
 
+TEST(HttpRangeTest, Single) {
+  bool unsatisfiable;
+  auto range = ParseHttpRange("bytes=10-19", 100, &unsatisfiable);
+  ASSERT_TRUE(range);
+  EXPECT_FALSE(unsatisfiable);
+  EXPECT_EQ(10u, range->first);
+  EXPECT_EQ(10u, range->second);
+
+  range = ParseHttpRange("bytes=90-", 100, &unsatisfiable);
+  ASSERT_TRUE(range);
+  EXPECT_EQ(90u, range->first);
+  EXPECT_EQ(10u, range->second);
+
+  // last byte past the end is truncated
+  range = ParseHttpRange("bytes=50-1000", 100, &unsatisfiable);
+  ASSERT_TRUE(range);
+  EXPECT_EQ(50u, range->first);
+  EXPECT_EQ(50u, range->second);
+}
+
+TEST(HttpRangeTest, Suffix) {
+  bool unsatisfiable;
+  auto range = ParseHttpRange("bytes=-10", 100, &unsatisfiable);
+  ASSERT_TRUE(range);
+  EXPECT_EQ(90u, range->first);
+  EXPECT_EQ(10u, range->second);
+
+  range = ParseHttpRange("bytes=-1000", 100, &unsatisfiable);
+  ASSERT_TRUE(range);
+  EXPECT_EQ(0u, range->first);
+  EXPECT_EQ(100u, range->second);
+}
+
+TEST(HttpRangeTest, Unsatisfiable) {
+  bool unsatisfiable;
+  EXPECT_FALSE(ParseHttpRange("bytes=100-", 100, &unsatisfiable));
+  EXPECT_TRUE(unsatisfiable);
+  EXPECT_FALSE(ParseHttpRange("bytes=-0", 100, &unsatisfiable));
+  EXPECT_TRUE(unsatisfiable);
+  EXPECT_FALSE(ParseHttpRange("bytes=-10", 0, &unsatisfiable));
+  EXPECT_TRUE(unsatisfiable);
+}
+
+TEST(HttpRangeTest, Ignored) {
+  bool unsatisfiable;
+  EXPECT_FALSE(ParseHttpRange("bytes=0-9,20-29", 100, &unsatisfiable));
+  EXPECT_FALSE(unsatisfiable);
+  EXPECT_FALSE(ParseHttpRange("items=0-9", 100, &unsatisfiable));
+  EXPECT_FALSE(unsatisfiable);
+  EXPECT_FALSE(ParseHttpRange("bytes=9-0", 100, &unsatisfiable));
+  EXPECT_FALSE(unsatisfiable);
+  EXPECT_FALSE(ParseHttpRange("bytes=x-", 100, &unsatisfiable));
+  EXPECT_FALSE(unsatisfiable);
+  EXPECT_FALSE(ParseHttpRange("bytes=10", 100, &unsatisfiable));
+  EXPECT_FALSE(unsatisfiable);
+}
+
+TEST(HttpETagTest, Match) {
+  EXPECT_TRUE(MatchHttpETag("\"abc\"", "\"abc\""));
+  EXPECT_TRUE(MatchHttpETag("\"xyz\", \"abc\"", "\"abc\""));
+  EXPECT_TRUE(MatchHttpETag("W/\"abc\"", "\"abc\""));
+  EXPECT_TRUE(MatchHttpETag("*", "\"abc\""));
+  EXPECT_FALSE(MatchHttpETag("\"xyz\"", "\"abc\""));
+  EXPECT_FALSE(MatchHttpETag("", "\"abc\""));
+}
+
 }  // namespace wpi
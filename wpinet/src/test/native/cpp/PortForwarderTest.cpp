@@ -0,0 +1,99 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpinet/PortForwarder.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <wpi/Logger.h>
+
+#include "wpinet/NetworkStream.h"
+#include "wpinet/TCPAcceptor.h"
+#include "wpinet/TCPConnector.h"
+
+namespace {
+
+constexpr int kRemotePort = 17831;
+constexpr int kLocalPort = 17832;
+
+// Echoes everything received on a single connection back to the sender.
+void EchoOne(wpi::TCPAcceptor& acceptor) {
+  auto stream = acceptor.accept();
+  if (!stream) {
+    return;
+  }
+  char buf[4096];
+  for (;;) {
+    wpi::NetworkStream::Error err;
+    size_t len = stream->receive(buf, sizeof(buf), &err);
+    if (len == 0) {
+      break;
+    }
+    size_t sent = 0;
+    while (sent < len) {
+      size_t n = stream->send(buf + sent, len - sent, &err);
+      if (n == 0) {
+        return;
+      }
+      sent += n;
+    }
+  }
+}
+
+}  // namespace
+
+TEST(PortForwarderTest, ForwardsBothDirections) {
+  wpi::Logger logger;
+  wpi::TCPAcceptor acceptor{kRemotePort, "127.0.0.1", logger};
+  ASSERT_EQ(0, acceptor.start());
+  std::thread echo{[&] { EchoOne(acceptor); }};
+
+  auto& forwarder = wpi::PortForwarder::GetInstance();
+  forwarder.Add(kLocalPort, "127.0.0.1", kRemotePort);
+
+  auto stream = wpi::TCPConnector::connect("127.0.0.1", kLocalPort, logger, 1);
+  ASSERT_TRUE(stream);
+
+  // larger than the socket and pipe buffers, so the forwarder has to wait for
+  // the destination to become writable
+  std::string data(1 << 20, '\0');
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<char>(i * 7 + (i >> 12));
+  }
+
+  std::thread sender{[&] {
+    wpi::NetworkStream::Error err;
+    size_t sent = 0;
+    while (sent < data.size()) {
+      size_t n = stream->send(data.data() + sent, data.size() - sent, &err);
+      if (n == 0) {
+        break;
+      }
+      sent += n;
+    }
+  }};
+
+  std::string received;
+  char buf[4096];
+  while (received.size() < data.size()) {
+    wpi::NetworkStream::Error err;
+    size_t len = stream->receive(buf, sizeof(buf), &err, 5);
+    if (len == 0) {
+      break;
+    }
+    received.append(buf, len);
+  }
+  sender.join();
+  EXPECT_EQ(data.size(), received.size());
+  EXPECT_TRUE(data == received);
+
+  stream->close();
+  echo.join();
+  acceptor.shutdown();
+  forwarder.Remove(kLocalPort);
+}
@@ -0,0 +1,112 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpinet/ThreadPool.h"  // NOLINT(build/include_order)
+
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <wpi/condition_variable.h>
+#include <wpi/mutex.h>
+
+#include "wpinet/EventLoopRunner.h"
+#include "wpinet/uv/Loop.h"
+
+namespace wpi {
+
+TEST(ThreadPoolTest, Future) {
+  ThreadPool pool{2};
+  future<int> f = pool.QueueWork([](bool v) -> int { return v ? 1 : 2; }, true);
+  ASSERT_EQ(f.get(), 1);
+}
+
+TEST(ThreadPoolTest, FutureVoid) {
+  std::atomic<int> callbacks = 0;
+  ThreadPool pool{2};
+  future<void> f = pool.QueueWork(
+      [&](int v) {
+        ++callbacks;
+        ASSERT_EQ(v, 3);
+      },
+      3);
+  f.get();
+  ASSERT_EQ(callbacks, 1);
+}
+
+TEST(ThreadPoolTest, Then) {
+  ThreadPool pool{2};
+  auto f = pool.QueueWork([] { return 2; }).then([](int v) { return v * 3; });
+  ASSERT_EQ(f.get(), 6);
+}
+
+TEST(ThreadPoolTest, Loop) {
+  mutex m;
+  condition_variable cv;
+  int callbacks = 0;
+  std::thread::id loopThread;
+
+  ThreadPool pool{2};
+  EventLoopRunner runner;
+  runner.ExecSync(
+      [&](uv::Loop&) { loopThread = std::this_thread::get_id(); });
+  pool.QueueWorkThen(
+      runner, [](bool v) -> int { return v ? 1 : 2; },
+      [&](int v2) {
+        std::scoped_lock lock{m};
+        ASSERT_EQ(std::this_thread::get_id(), loopThread);
+        ++callbacks;
+        cv.notify_all();
+        ASSERT_EQ(v2, 1);
+      },
+      true);
+  pool.QueueWorkThen(runner, [] {}, [&] {
+    std::scoped_lock lock{m};
+    ++callbacks;
+    cv.notify_all();
+  });
+
+  std::unique_lock lock{m};
+  cv.wait(lock, [&] { return callbacks == 2; });
+  ASSERT_EQ(callbacks, 2);
+}
+
+TEST(ThreadPoolTest, Steal) {
+  // tasks queued from a task go to that worker, and are stolen by the others
+  mutex m;
+  condition_variable cv;
+  int count = 0;
+  std::set<std::thread::id> threads;
+  ThreadPool pool{4};
+  pool.Post([&] {
+    for (int i = 0; i < 100; ++i) {
+      pool.Post([&] {
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        std::scoped_lock lock{m};
+        threads.emplace(std::this_thread::get_id());
+        ++count;
+        cv.notify_all();
+      });
+    }
+  });
+
+  std::unique_lock lock{m};
+  cv.wait(lock, [&] { return count == 100; });
+  ASSERT_GT(threads.size(), 1u);
+}
+
+TEST(ThreadPoolTest, DestroyRunsQueued) {
+  std::atomic<int> count = 0;
+  {
+    ThreadPool pool{1};
+    for (int i = 0; i < 100; ++i) {
+      pool.Post([&] { ++count; });
+    }
+  }
+  ASSERT_EQ(count, 100);
+}
+
+}  // namespace wpi
@@ -0,0 +1,49 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpinet/UDPClient.h"
+
+#include <array>
+#include <span>
+
+#include <gtest/gtest.h>
+#include <wpi/Logger.h>
+
+TEST(UDPClientTest, BatchSendReceive) {
+  wpi::Logger logger;
+  wpi::UDPClient receiver{"127.0.0.1", logger};
+  ASSERT_EQ(0, receiver.start(17833));
+  receiver.set_timeout(1.0);
+  wpi::UDPClient sender{logger};
+  ASSERT_EQ(0, sender.start());
+
+  std::array<uint8_t, 3> a{1, 2, 3};
+  std::array<uint8_t, 1> b{4};
+  std::array<uint8_t, 2> c{5, 6};
+  std::array<std::span<const uint8_t>, 3> datagrams{a, b, c};
+  ASSERT_EQ(3, sender.send_batch(datagrams, "127.0.0.1", 17833));
+
+  std::array<std::array<uint8_t, 16>, 4> storage;
+  std::array<std::span<uint8_t>, 4> buffers;
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    buffers[i] = storage[i];
+  }
+  std::array<int, 4> lens{};
+
+  // platforms without batch receive return one datagram per call
+  int received = 0;
+  while (received < 3) {
+    int n = receiver.receive_batch(std::span{buffers}.subspan(received),
+                                   lens.data() + received);
+    ASSERT_GT(n, 0);
+    received += n;
+  }
+  EXPECT_EQ(3, received);
+  EXPECT_EQ(3, lens[0]);
+  EXPECT_EQ(1, lens[1]);
+  EXPECT_EQ(2, lens[2]);
+  EXPECT_EQ(3, storage[0][2]);
+  EXPECT_EQ(4, storage[1][0]);
+  EXPECT_EQ(6, storage[2][1]);
+}
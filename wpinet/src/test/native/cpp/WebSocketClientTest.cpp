@@ -28,6 +28,8 @@ class WebSocketClientTest : public WebSocketTest {
       // save key (required for valid response)
       if (equals_lower(name, "sec-websocket-key")) {
         clientKey = value;
+      } else if (equals_lower(name, "sec-websocket-extensions")) {
+        clientExtensions = value;
       }
     });
     req.headersComplete.connect([this](bool) {
@@ -54,6 +56,10 @@ class WebSocketClientTest : public WebSocketTest {
         os << "Sec-WebSocket-Protocol: " << mockProtocol << "\r\n";
       }
 
+      if (!mockExtensions.empty()) {
+        os << "Sec-WebSocket-Extensions: " << mockExtensions << "\r\n";
+      }
+
       os << "\r\n";
 
       conn->Write(bufs, [](auto bufs, uv::Error) {
@@ -95,6 +101,8 @@ class WebSocketClientTest : public WebSocketTest {
   HttpParser req{HttpParser::kRequest};
   SmallString<64> clientKey;
   std::string mockProtocol;
+  std::string clientExtensions;
+  std::string mockExtensions;
   bool serverHeadersDone = false;
   std::function<void()> connected;
 };
@@ -231,6 +239,94 @@ TEST_F(WebSocketClientTest, ProtocolReqNotResp) {
   ASSERT_EQ(gotClosed, 1);
 }
 
+TEST_F(WebSocketClientTest, DeflateGood) {
+  int gotOpen = 0;
+
+  mockExtensions = "permessage-deflate; server_no_context_takeover";
+
+  clientPipe->Connect(pipeName, [&] {
+    WebSocket::ClientOptions options;
+    options.deflate = WebSocket::DeflateOptions{};
+    auto ws =
+        WebSocket::CreateClient(*clientPipe, "/test", pipeName, {}, options);
+    ws->closed.connect([&](uint16_t code, std::string_view msg) {
+      Finish();
+      if (code != 1005 && code != 1006) {
+        FAIL() << "Code: " << code << "Message: " << msg;
+      }
+    });
+    ws->open.connect([&, s = ws.get()](std::string_view) {
+      ++gotOpen;
+      Finish();
+      ASSERT_TRUE(s->IsCompressed());
+    });
+  });
+
+  loop->Run();
+
+  if (HasFatalFailure()) {
+    return;
+  }
+  ASSERT_EQ(gotOpen, 1);
+  ASSERT_TRUE(starts_with(clientExtensions, "permessage-deflate"));
+}
+
+TEST_F(WebSocketClientTest, DeflateReqNotResp) {
+  int gotOpen = 0;
+
+  clientPipe->Connect(pipeName, [&] {
+    WebSocket::ClientOptions options;
+    options.deflate = WebSocket::DeflateOptions{};
+    auto ws =
+        WebSocket::CreateClient(*clientPipe, "/test", pipeName, {}, options);
+    ws->closed.connect([&](uint16_t code, std::string_view msg) {
+      Finish();
+      if (code != 1005 && code != 1006) {
+        FAIL() << "Code: " << code << "Message: " << msg;
+      }
+    });
+    ws->open.connect([&, s = ws.get()](std::string_view) {
+      ++gotOpen;
+      Finish();
+      ASSERT_FALSE(s->IsCompressed());
+    });
+  });
+
+  loop->Run();
+
+  if (HasFatalFailure()) {
+    return;
+  }
+  ASSERT_EQ(gotOpen, 1);
+}
+
+TEST_F(WebSocketClientTest, DeflateRespNotReq) {
+  int gotClosed = 0;
+
+  mockExtensions = "permessage-deflate";
+
+  clientPipe->Connect(pipeName, [&] {
+    auto ws = WebSocket::CreateClient(*clientPipe, "/test", pipeName);
+    ws->closed.connect([&](uint16_t code, std::string_view msg) {
+      Finish();
+      ++gotClosed;
+      ASSERT_EQ(code, 1010) << "Message: " << msg;
+    });
+    ws->open.connect([&](std::string_view protocol) {
+      Finish();
+      FAIL() << "Got open";
+    });
+  });
+
+  loop->Run();
+
+  if (HasFatalFailure()) {
+    return;
+  }
+  ASSERT_TRUE(clientExtensions.empty());
+  ASSERT_EQ(gotClosed, 1);
+}
+
 //
 // Send and receive data.  Most of these cases are tested in
 // WebSocketServerTest, so only spot check differences like masking.
@@ -14,6 +14,7 @@
 #include <vector>
 
 #include <gmock/gmock.h>
+#include <wpi/Deflate.h>
 #include <wpi/SpanMatcher.h>
 
 #include "WebSocketTest.h"
@@ -75,6 +76,93 @@ class MockStream {
   Logger* GetLogger() const { return nullptr; }
 };
 
+TEST(SerializedFramesTest, MaskInPlace) {
+  const uint8_t key[4] = {1, 2, 4, 8};
+  std::vector<uint8_t> data(21, 0x10);
+  // continue from the middle of the key
+  EXPECT_EQ(MaskData(data.data(), data, key, 2), 3u);
+  for (size_t i = 0; i < data.size(); ++i) {
+    ASSERT_EQ(data[i], 0x10 ^ key[(i + 2) % 4]) << "at " << i;
+  }
+}
+
+TEST(SerializedFramesTest, ClientMasking) {
+  // odd buffer sizes so the masking key is split across buffers
+  std::vector<uint8_t> data(300);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = i * 7;
+  }
+  std::array<uv::Buffer, 3> bufs{uv::Buffer{std::span{data}.subspan(0, 3)},
+                                 uv::Buffer{std::span{data}.subspan(3, 21)},
+                                 uv::Buffer{std::span{data}.subspan(24)}};
+  std::array<uv::Buffer, 1> smallBufs{
+      uv::Buffer{std::span{data}.subspan(0, 5)}};
+
+  SerializedFrames frames;
+  ASSERT_EQ(frames.AddClientFrame({WebSocket::Frame::kBinary, bufs}),
+            4u + 4u + data.size());
+  ASSERT_EQ(frames.AddClientFrame({WebSocket::Frame::kBinary, smallBufs}),
+            2u + 4u + 5u);
+  ASSERT_EQ(frames.m_bufs.size(), 2u);
+  // small frames share an allocated buffer
+  ASSERT_EQ(frames.m_allocBufs.size(), 1u);
+
+  auto frame = frames.m_bufs[0].bytes();
+  ASSERT_EQ(frame[1], 0x80 | 126);
+  auto key = frame.subspan(4, 4);
+  auto masked = frame.subspan(8);
+  ASSERT_EQ(masked.size(), data.size());
+  for (size_t i = 0; i < data.size(); ++i) {
+    ASSERT_EQ(masked[i] ^ key[i % 4], data[i]) << "at " << i;
+  }
+
+  frame = frames.m_bufs[1].bytes();
+  ASSERT_EQ(frame[1], 0x80 | 5);
+  for (size_t i = 0; i < 5; ++i) {
+    ASSERT_EQ(frame[6 + i] ^ frame[2 + i % 4], data[i]);
+  }
+}
+
+TEST(SerializedFramesTest, Compression) {
+  std::vector<uint8_t> data(1000);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = i % 10;
+  }
+  std::array<uv::Buffer, 2> bufs{uv::Buffer{std::span{data}.subspan(0, 300)},
+                                 uv::Buffer{std::span{data}.subspan(300)}};
+  std::array<uv::Buffer, 1> smallBufs{
+      uv::Buffer{std::span{data}.subspan(0, 10)}};
+  WebSocket::DeflateOptions deflate;
+  deflate.threshold = 100;
+
+  SerializedFrames frames;
+  size_t size = frames.AddFrame({WebSocket::Frame::kBinary, bufs}, true,
+                                &deflate);
+  ASSERT_LT(size, 100u);
+  // below the threshold
+  ASSERT_EQ(frames.AddFrame({WebSocket::Frame::kBinary, smallBufs}, true,
+                            &deflate),
+            2u + 10u);
+  // fragments are never compressed
+  ASSERT_EQ(
+      frames.AddFrame({WebSocket::Frame::kFragment, bufs}, true, &deflate),
+      4u + data.size());
+
+  // header with RSV1 set, then the compressed data
+  ASSERT_EQ(frames.m_bufs.size(), 7u);
+  auto header = frames.m_bufs[0].bytes();
+  ASSERT_EQ(header.size(), 2u);
+  ASSERT_EQ(header[0], 0x80 | 0x40 | WebSocket::kOpBinary);
+  ASSERT_EQ(header[1], size - 2);
+  std::vector<uint8_t> compressed(frames.m_bufs[1].bytes().begin(),
+                                  frames.m_bufs[1].bytes().end());
+  compressed.insert(compressed.end(), {0x00, 0x00, 0xff, 0xff});
+  std::vector<uint8_t> decompressed;
+  ASSERT_TRUE(DeflateDecompressor{}.Decompress(compressed, decompressed));
+  ASSERT_EQ(decompressed, data);
+  ASSERT_EQ(frames.m_bufs[2].bytes()[0], WebSocket::Frame::kBinary);
+}
+
 class WebSocketWriteReqTest : public ::testing::Test {
  public:
   WebSocketWriteReqTest() {
@@ -9,7 +9,9 @@
 #include <vector>
 
 #include <wpi/Base64.h>
+#include <wpi/Deflate.h>
 #include <wpi/SmallString.h>
+#include <wpi/StringExtras.h>
 #include <wpi/sha1.h>
 
 #include "WebSocketTest.h"
@@ -20,11 +22,16 @@ namespace wpi {
 class WebSocketServerTest : public WebSocketTest {
  public:
   WebSocketServerTest() {
+    resp.header.connect([this](std::string_view name, std::string_view value) {
+      if (equals_lower(name, "sec-websocket-extensions")) {
+        respExtensions = value;
+      }
+    });
     resp.headersComplete.connect([this](bool) { headersDone = true; });
 
     serverPipe->Listen([this]() {
       auto conn = serverPipe->Accept();
-      ws = WebSocket::CreateServer(*conn, "foo", "13");
+      ws = WebSocket::CreateServer(*conn, "foo", "13", {}, serverOptions);
       if (setupWebSocket) {
         setupWebSocket();
       }
@@ -57,7 +64,9 @@ class WebSocketServerTest : public WebSocketTest {
   std::function<void(std::string_view)> handleData;
   std::vector<uint8_t> wireData;
   std::shared_ptr<WebSocket> ws;
+  WebSocket::ServerOptions serverOptions;
   HttpParser resp{HttpParser::kResponse};
+  std::string respExtensions;
   bool headersDone = false;
 };
 
@@ -794,4 +803,152 @@ TEST_P(WebSocketServerDataTest, ReceiveUnmasked) {
   ASSERT_EQ(gotCallback, 1);
 }
 
+//
+// permessage-deflate compression.
+//
+
+static std::vector<uint8_t> Deflate(std::span<const uint8_t> data) {
+  std::vector<uint8_t> out;
+  DeflateCompressor{}.Compress(data, out);
+  out.resize(out.size() - 4);  // sender removes the empty stored block
+  return out;
+}
+
+TEST_F(WebSocketServerTest, ReceiveCompressed) {
+  int gotCallback = 0;
+
+  std::vector<uint8_t> data(1000);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = i % 10;
+  }
+  auto compressed = Deflate(data);
+  std::span compressedSpan{compressed};
+
+  serverOptions.extensions = "permessage-deflate; client_max_window_bits";
+  serverOptions.deflate = WebSocket::DeflateOptions{};
+  setupWebSocket = [&] {
+    // compressed messages are combined regardless
+    ws->SetCombineFragments(false);
+    ws->binary.connect([&](auto inData, bool fin) {
+      ++gotCallback;
+      ws->Terminate();
+      ASSERT_TRUE(fin);
+      std::vector<uint8_t> recvData{inData.begin(), inData.end()};
+      ASSERT_EQ(data, recvData);
+    });
+  };
+
+  // RSV1 is only set on the first fragment
+  auto message = BuildMessage(0x42, false, true, compressedSpan.subspan(0, 5));
+  auto message2 = BuildMessage(0x00, true, true, compressedSpan.subspan(5));
+  resp.headersComplete.connect([&](bool) {
+    clientPipe->Write({{message}, {message2}}, [&](auto bufs, uv::Error) {});
+  });
+
+  loop->Run();
+
+  ASSERT_EQ(gotCallback, 1);
+  ASSERT_TRUE(starts_with(respExtensions, "permessage-deflate"));
+}
+
+TEST_F(WebSocketServerTest, ReceiveCompressedNotNegotiated) {
+  int gotCallback = 0;
+
+  std::vector<uint8_t> data(1000, 0x03);
+  auto compressed = Deflate(data);
+
+  setupWebSocket = [&] {
+    ws->binary.connect([&](auto, bool) {
+      ws->Terminate();
+      FAIL() << "Should not have gotten message";
+    });
+    ws->closed.connect([&](uint16_t code, std::string_view reason) {
+      ++gotCallback;
+      ASSERT_EQ(code, 1002) << "reason: " << reason;
+    });
+  };
+  auto message = BuildMessage(0x42, true, true, compressed);
+  resp.headersComplete.connect([&](bool) {
+    clientPipe->Write({{message}}, [&](auto bufs, uv::Error) {});
+  });
+
+  loop->Run();
+
+  ASSERT_EQ(gotCallback, 1);
+  ASSERT_TRUE(respExtensions.empty());
+}
+
+TEST_F(WebSocketServerTest, ReceiveCompressedTooLarge) {
+  int gotCallback = 0;
+
+  std::vector<uint8_t> data(2048, 0x03);
+  auto compressed = Deflate(data);
+
+  serverOptions.extensions = "permessage-deflate";
+  serverOptions.deflate = WebSocket::DeflateOptions{};
+  setupWebSocket = [&] {
+    ws->SetMaxMessageSize(1024);
+    ws->binary.connect([&](auto, bool) {
+      ws->Terminate();
+      FAIL() << "Should not have gotten message";
+    });
+    ws->closed.connect([&](uint16_t code, std::string_view reason) {
+      ++gotCallback;
+      ASSERT_EQ(code, 1009) << "reason: " << reason;
+    });
+  };
+  auto message = BuildMessage(0x42, true, true, compressed);
+  resp.headersComplete.connect([&](bool) {
+    clientPipe->Write({{message}}, [&](auto bufs, uv::Error) {});
+  });
+
+  loop->Run();
+
+  ASSERT_EQ(gotCallback, 1);
+}
+
+TEST_F(WebSocketServerTest, SendCompressed) {
+  int gotCallback = 0;
+
+  std::vector<uint8_t> data(1000);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = i % 10;
+  }
+  std::vector<uint8_t> small(10, 0x03);
+
+  serverOptions.extensions = "permessage-deflate";
+  serverOptions.deflate = WebSocket::DeflateOptions{};
+  setupWebSocket = [&] {
+    ws->open.connect([&](std::string_view) {
+      ws->SendBinary({{data}}, [&](auto, uv::Error) {});
+      // below the threshold
+      ws->SendBinary({{small}}, [&](auto, uv::Error) { ++gotCallback; });
+    });
+  };
+
+  std::vector<uint8_t> expectSmall = BuildMessage(0x02, true, false, small);
+  handleData = [&](std::string_view) {
+    // RSV1 set on the compressed message
+    if (wireData.size() < 2 ||
+        wireData.size() < 2u + wireData[1] + expectSmall.size()) {
+      return;
+    }
+    Finish();
+    ASSERT_EQ(wireData[0], 0xc2);
+    std::vector<uint8_t> compressed{wireData.begin() + 2,
+                                    wireData.begin() + 2 + wireData[1]};
+    compressed.insert(compressed.end(), {0x00, 0x00, 0xff, 0xff});
+    std::vector<uint8_t> decompressed;
+    ASSERT_TRUE(DeflateDecompressor{}.Decompress(compressed, decompressed));
+    ASSERT_EQ(data, decompressed);
+    ASSERT_EQ(expectSmall, std::vector<uint8_t>(wireData.begin() + 2 +
+                                                    wireData[1],
+                                                wireData.end()));
+  };
+
+  loop->Run();
+
+  ASSERT_EQ(gotCallback, 1);
+}
+
 }  // namespace wpi
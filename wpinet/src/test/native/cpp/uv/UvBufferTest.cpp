@@ -45,4 +45,53 @@ TEST(UvSimpleBufferPoolTest, ClearRemaining) {
   ASSERT_EQ(pool.Remaining(), 0u);
 }
 
+TEST(UvBufferPoolTest, SizeClassReuse) {
+  BufferPool pool;
+  auto buf1 = pool.Allocate(300);
+  ASSERT_EQ(buf1.len, 300u);  // NOLINT
+  auto buf1copy = buf1;
+  buf1.len = 8;
+  pool.Release(buf1);
+  ASSERT_EQ(buf1.base, nullptr);
+  ASSERT_EQ(pool.GetPooledBytes(), 512u);
+
+  // same size class
+  auto buf2 = pool.Allocate(512);
+  ASSERT_EQ(buf1copy.base, buf2.base);
+  ASSERT_EQ(buf2.len, 512u);  // NOLINT
+
+  // different size class
+  auto buf3 = pool.Allocate(100);
+  ASSERT_NE(buf1copy.base, buf3.base);
+  pool.Release(buf2);
+  pool.Release(buf3);
+  ASSERT_EQ(pool.GetPooledBytes(), 768u);
+}
+
+TEST(UvBufferPoolTest, LargeNotPooled) {
+  BufferPool pool;
+  auto buf = pool.Allocate(BufferPool::kMaxPooledSize + 1);
+  pool.Release(buf);
+  ASSERT_EQ(pool.GetPooledBytes(), 0u);
+}
+
+TEST(UvBufferPoolTest, TrimToHighWater) {
+  BufferPool pool;
+
+  // burst of 16 buffers in use at once
+  Buffer bufs[16];
+  for (auto& buf : bufs) {
+    buf = pool.Allocate(1000);
+  }
+  pool.Release(bufs);
+  ASSERT_EQ(pool.GetPooledBytes(), 16 * 1024u);
+
+  // then only one at a time for a while
+  for (int i = 0; i < 1000; ++i) {
+    auto buf = pool.Allocate(1000);
+    pool.Release(buf);
+  }
+  ASSERT_EQ(pool.GetPooledBytes(), 1024u);
+}
+
 }  // namespace wpi::uv
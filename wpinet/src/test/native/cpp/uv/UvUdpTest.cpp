@@ -0,0 +1,52 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpinet/uv/Udp.h"  // NOLINT(build/include_order)
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "wpinet/uv/util.h"
+
+namespace wpi::uv {
+
+TEST(UvUdpTest, BatchedRecv) {
+  auto loop = Loop::Create();
+  auto receiver = Udp::Create(loop, AF_INET | UV_UDP_RECVMMSG);
+  auto sender = Udp::Create(loop, AF_INET);
+
+  receiver->error.connect([](Error) { FAIL(); });
+  sender->error.connect([](Error) { FAIL(); });
+
+  receiver->Bind("127.0.0.1", 0);
+  sockaddr_storage addr = receiver->GetSock();
+
+  std::vector<std::string> received;
+  receiver->received.connect(
+      [&](Buffer& buf, size_t len, const sockaddr&, unsigned) {
+        received.emplace_back(buf.base, len);
+        if (received.size() == 3) {
+          receiver->Close();
+          sender->Close();
+        }
+      });
+  receiver->StartRecv(4);
+
+  const std::string datagrams[] = {"a", "bc", "def"};
+  for (auto&& datagram : datagrams) {
+    Buffer buf{datagram};
+    sender->TrySend(reinterpret_cast<const sockaddr&>(addr), {&buf, 1});
+  }
+
+  loop->Run();
+
+  ASSERT_EQ(3u, received.size());
+  EXPECT_EQ("a", received[0]);
+  EXPECT_EQ("bc", received[1]);
+  EXPECT_EQ("def", received[2]);
+}
+
+}  // namespace wpi::uv
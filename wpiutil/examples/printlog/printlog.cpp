@@ -3,6 +3,7 @@
 // the WPILib BSD license file in the root directory of this project.
 
 #include <ctime>
+#include <system_error>
 #include <utility>
 #include <vector>
 
@@ -12,7 +13,6 @@
 
 #include "wpi/DataLogReader.h"
 #include "wpi/DenseMap.h"
-#include "wpi/MemoryBuffer.h"
 #include "wpi/print.h"
 
 int main(int argc, const char** argv) {
@@ -20,13 +20,12 @@ int main(int argc, const char** argv) {
     wpi::print(stderr, "Usage: printlog <file>\n");
     return EXIT_FAILURE;
   }
-  auto fileBuffer = wpi::MemoryBuffer::GetFile(argv[1]);
-  if (!fileBuffer) {
-    wpi::print(stderr, "could not open file: {}\n",
-               fileBuffer.error().message());
+  std::error_code ec;
+  wpi::log::DataLogReader reader{argv[1], ec};
+  if (ec) {
+    wpi::print(stderr, "could not open file: {}\n", ec.message());
     return EXIT_FAILURE;
   }
-  wpi::log::DataLogReader reader{std::move(*fileBuffer)};
   if (!reader) {
     wpi::print(stderr, "not a log file\n");
     return EXIT_FAILURE;
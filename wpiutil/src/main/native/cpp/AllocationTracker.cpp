@@ -0,0 +1,67 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/AllocationTracker.h"
+
+#include <stdlib.h>
+
+using namespace wpi;
+
+namespace {
+// Must be constant initialized, as it's used from operator new before (or
+// after) dynamic initialization. Per-thread counts are only written by the
+// owning thread but may be read while it's running, so are also atomic.
+struct AtomicCounts {
+  std::atomic<uint64_t> allocations{0};
+  std::atomic<uint64_t> deallocations{0};
+  std::atomic<uint64_t> bytes{0};
+};
+}  // namespace
+
+static constinit thread_local AtomicCounts gThreadCounts;
+static constinit AtomicCounts gTotalCounts;
+
+static AllocationTracker::Counts Load(const AtomicCounts& counts) {
+  return {counts.allocations.load(std::memory_order_relaxed),
+          counts.deallocations.load(std::memory_order_relaxed),
+          counts.bytes.load(std::memory_order_relaxed)};
+}
+
+// only the owning thread writes, so a load and store is enough
+static void Increment(std::atomic<uint64_t>& value, uint64_t amount) {
+  value.store(value.load(std::memory_order_relaxed) + amount,
+              std::memory_order_relaxed);
+}
+
+AllocationTracker::Counts AllocationTracker::GetThreadCounts() noexcept {
+  return Load(gThreadCounts);
+}
+
+AllocationTracker::Counts AllocationTracker::GetTotalCounts() noexcept {
+  return Load(gTotalCounts);
+}
+
+void* AllocationTracker::Allocate(size_t size) noexcept {
+  if (!s_installed.load(std::memory_order_relaxed)) {
+    s_installed.store(true, std::memory_order_relaxed);
+  }
+  if (IsEnabled()) {
+    Increment(gThreadCounts.allocations, 1);
+    Increment(gThreadCounts.bytes, size);
+    gTotalCounts.allocations.fetch_add(1, std::memory_order_relaxed);
+    gTotalCounts.bytes.fetch_add(size, std::memory_order_relaxed);
+  }
+  return malloc(size == 0 ? 1 : size);
+}
+
+void AllocationTracker::Deallocate(void* p) noexcept {
+  if (!p) {
+    return;
+  }
+  if (IsEnabled()) {
+    Increment(gThreadCounts.deallocations, 1);
+    gTotalCounts.deallocations.fetch_add(1, std::memory_order_relaxed);
+  }
+  free(p);
+}
@@ -57,6 +57,7 @@
 
 #include "wpi/Base64.h"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -83,11 +84,15 @@ static const unsigned char pr2six[256] = {
     64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
     64, 64, 64, 64, 64, 64, 64, 64, 64};
 
+// Input is processed in chunks, with each chunk's output written to the
+// stream at once; a multiple of both 3 and 4.
+static constexpr size_t kChunkSize = 768;
+
 size_t Base64Decode(raw_ostream& os, std::string_view encoded) {
   auto bytes_begin = reinterpret_cast<const unsigned char*>(encoded.data());
   auto bytes_end = bytes_begin + encoded.size();
   const unsigned char* end = bytes_begin;
-  while (pr2six[*end] <= 63 && end != bytes_end) {
+  while (end != bytes_end && pr2six[*end] <= 63) {
     ++end;
   }
   size_t nprbytes = end - bytes_begin;
@@ -96,13 +101,23 @@ size_t Base64Decode(raw_ostream& os, std::string_view encoded) {
   }
 
   const unsigned char* cur = bytes_begin;
+  unsigned char buf[kChunkSize];
 
   while (nprbytes > 4) {
-    os << static_cast<unsigned char>(pr2six[cur[0]] << 2 | pr2six[cur[1]] >> 4);
-    os << static_cast<unsigned char>(pr2six[cur[1]] << 4 | pr2six[cur[2]] >> 2);
-    os << static_cast<unsigned char>(pr2six[cur[2]] << 6 | pr2six[cur[3]]);
-    cur += 4;
-    nprbytes -= 4;
+    // full groups of 4, leaving 1-4 characters for the tail
+    size_t groups = std::min((nprbytes - 1) / 4, kChunkSize / 3);
+    unsigned char* out = buf;
+    for (size_t i = 0; i < groups; ++i) {
+      uint32_t v = pr2six[cur[0]] << 18 | pr2six[cur[1]] << 12 |
+                   pr2six[cur[2]] << 6 | pr2six[cur[3]];
+      out[0] = v >> 16;
+      out[1] = v >> 8;
+      out[2] = v;
+      cur += 4;
+      out += 3;
+    }
+    os.write(reinterpret_cast<const char*>(buf), out - buf);
+    nprbytes -= groups * 4;
   }
 
   // Note: (nprbytes == 1) would be an error, so just ignore that case
@@ -156,26 +171,35 @@ void Base64Encode(raw_ostream& os, std::string_view plain) {
   if (plain.empty()) {
     return;
   }
+  auto in = reinterpret_cast<const unsigned char*>(plain.data());
   size_t len = plain.size();
 
-  size_t i;
-  for (i = 0; (i + 2) < len; i += 3) {
-    os << basis_64[(plain[i] >> 2) & 0x3F];
-    os << basis_64[((plain[i] & 0x3) << 4) |
-                   (static_cast<int>(plain[i + 1] & 0xF0) >> 4)];
-    os << basis_64[((plain[i + 1] & 0xF) << 2) |
-                   (static_cast<int>(plain[i + 2] & 0xC0) >> 6)];
-    os << basis_64[plain[i + 2] & 0x3F];
+  // full groups of 3
+  char buf[kChunkSize / 3 * 4];
+  while (len >= 3) {
+    size_t groups = std::min(len / 3, kChunkSize / 3);
+    char* out = buf;
+    for (size_t i = 0; i < groups; ++i) {
+      uint32_t v = in[0] << 16 | in[1] << 8 | in[2];
+      out[0] = basis_64[v >> 18];
+      out[1] = basis_64[(v >> 12) & 0x3F];
+      out[2] = basis_64[(v >> 6) & 0x3F];
+      out[3] = basis_64[v & 0x3F];
+      in += 3;
+      out += 4;
+    }
+    os.write(buf, out - buf);
+    len -= groups * 3;
   }
-  if (i < len) {
-    os << basis_64[(plain[i] >> 2) & 0x3F];
-    if (i == (len - 1)) {
-      os << basis_64[((plain[i] & 0x3) << 4)];
+
+  if (len > 0) {
+    os << basis_64[(in[0] >> 2) & 0x3F];
+    if (len == 1) {
+      os << basis_64[((in[0] & 0x3) << 4)];
       os << '=';
     } else {
-      os << basis_64[((plain[i] & 0x3) << 4) |
-                     (static_cast<int>(plain[i + 1] & 0xF0) >> 4)];
-      os << basis_64[((plain[i + 1] & 0xF) << 2)];
+      os << basis_64[((in[0] & 0x3) << 4) | (in[1] >> 4)];
+      os << basis_64[((in[1] & 0xF) << 2)];
     }
     os << '=';
   }
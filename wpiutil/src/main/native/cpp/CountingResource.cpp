@@ -0,0 +1,27 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/CountingResource.h"
+
+using namespace wpi;
+
+void CountingResource::ResetCounts() {
+  m_allocations.store(0, std::memory_order_relaxed);
+  m_deallocations.store(0, std::memory_order_relaxed);
+  m_bytesAllocated.store(0, std::memory_order_relaxed);
+}
+
+void* CountingResource::do_allocate(size_t bytes, size_t alignment) {
+  m_allocations.fetch_add(1, std::memory_order_relaxed);
+  m_bytesAllocated.fetch_add(bytes, std::memory_order_relaxed);
+  if (m_hook) {
+    m_hook(bytes, alignment);
+  }
+  return m_upstream->allocate(bytes, alignment);
+}
+
+void CountingResource::do_deallocate(void* p, size_t bytes, size_t alignment) {
+  m_deallocations.fetch_add(1, std::memory_order_relaxed);
+  m_upstream->deallocate(p, bytes, alignment);
+}
@@ -5,10 +5,14 @@
 #include "wpi/DataLog.h"
 
 #include <algorithm>
+#include <atomic>
 #include <bit>
+#include <cmath>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <functional>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -18,6 +22,7 @@
 #include "wpi/SmallString.h"
 #include "wpi/print.h"
 #include "wpi/timestamp.h"
+#include "wpi/xxhash.h"
 
 using namespace wpi::log;
 
@@ -34,6 +39,63 @@ static void DefaultLog(unsigned int level, const char* file, unsigned int line,
 
 wpi::Logger DataLog::s_defaultMessageLog{DefaultLog};
 
+struct DataLog::ThreadBuffers {
+  wpi::mutex mutex;
+  std::vector<Buffer> bufs;
+  // set when the owning thread exits
+  std::atomic_bool orphaned{false};
+  // set when the DataLog is destroyed
+  std::atomic_bool detached{false};
+  AppendCounts counts;
+};
+
+// Per-thread map from DataLog instance to that thread's buffers.  Instance IDs
+// are never reused, so entries of destroyed instances can't be mistaken for
+// those of a new instance at the same address.
+struct DataLog::ThreadBuffersCache {
+  ~ThreadBuffersCache() {
+    for (auto&& entry : entries) {
+      entry.second->orphaned = true;
+    }
+  }
+
+  std::vector<std::pair<unsigned int, std::shared_ptr<ThreadBuffers>>> entries;
+};
+
+static std::atomic<unsigned int> gInstanceCount{0};
+
+DataLog::DataLog(wpi::Logger& msglog, std::string_view extraHeader)
+    : m_msglog{msglog},
+      m_extraHeader{extraHeader},
+      m_instanceId{++gInstanceCount} {}
+
+DataLog::~DataLog() {
+  std::scoped_lock lock{m_mutex};
+  for (auto&& tb : m_threadBufs) {
+    tb->detached = true;
+  }
+}
+
+DataLog::ThreadBuffers& DataLog::GetThreadBuffers() {
+  static thread_local ThreadBuffersCache cache;
+  for (auto&& [id, tb] : cache.entries) {
+    if (id == m_instanceId) {
+      [[likely]] return *tb;
+    }
+  }
+
+  // first append from this thread; drop buffers of destroyed instances
+  std::erase_if(cache.entries, [](const auto& entry) {
+    return entry.second->detached.load();
+  });
+  auto tb = std::make_shared<ThreadBuffers>();
+  {
+    std::scoped_lock lock{m_mutex};
+    m_threadBufs.emplace_back(tb);
+  }
+  return *cache.entries.emplace_back(m_instanceId, std::move(tb)).second;
+}
+
 template <typename T>
 static unsigned int WriteVarInt(uint8_t* buf, T val) {
   unsigned int len = 0;
@@ -70,26 +132,36 @@ void DataLog::StartFile() {
   }
 
   // Grab previously pending writes
+  CollectThreadBuffers();
   std::vector<Buffer> bufs;
   bufs.swap(m_outgoing);
   m_outgoing.reserve(bufs.size() + 1);
 
   // File header (version 1.0)
-  uint8_t* buf = Reserve(m_extraHeader.size() + 12);
+  uint8_t* buf = Reserve(m_outgoing, m_extraHeader.size() + 12);
   static const uint8_t header[] = {'W', 'P', 'I', 'L', 'O', 'G', 0, 1};
   std::memcpy(buf, header, 8);
   support::endian::write32le(buf + 8, m_extraHeader.size());
   std::memcpy(buf + 12, m_extraHeader.data(), m_extraHeader.size());
 
+  // Filters compare against the last stored record, which isn't in the new
+  // file
+  {
+    std::scoped_lock filterLock{m_filterMutex};
+    for (auto&& filter : m_filters) {
+      filter.second.hasLast = false;
+    }
+  }
+
   // Existing start and schema data records
   for (auto&& entryInfo : m_entries) {
     AppendStartRecord(entryInfo.second.id, entryInfo.first,
                       entryInfo.second.type,
                       m_entryIds[entryInfo.second.id].metadata, 0);
     if (!entryInfo.second.schemaData.empty()) {
-      StartRecord(entryInfo.second.id, 0, entryInfo.second.schemaData.size(),
-                  0);
-      AppendImpl(entryInfo.second.schemaData);
+      StartRecord(m_outgoing, entryInfo.second.id, 0,
+                  entryInfo.second.schemaData.size(), 0);
+      AppendImpl(m_outgoing, entryInfo.second.schemaData);
     }
   }
 
@@ -102,23 +174,52 @@ void DataLog::StartFile() {
 }
 
 void DataLog::FlushBufs(std::vector<Buffer>* writeBufs) {
+  RunFlushCallbacks();
   std::scoped_lock lock{m_mutex};
+  CollectThreadBuffers();
   writeBufs->swap(m_outgoing);
+  std::scoped_lock poolLock{m_poolMutex};
+  m_outgoingCount -= writeBufs->size();
   DoReleaseBufs(&m_outgoing);
 }
 
 void DataLog::ReleaseBufs(std::vector<Buffer>* bufs) {
-  std::scoped_lock lock{m_mutex};
+  std::scoped_lock lock{m_poolMutex};
   DoReleaseBufs(bufs);
 }
 
+int DataLog::AddFlushCallback(std::function<void()> func) {
+  std::scoped_lock lock{m_flushCallbackMutex};
+  int handle = ++m_lastFlushCallback;
+  m_flushCallbacks.emplace_back(handle, std::move(func));
+  ++m_flushCallbackCount;
+  return handle;
+}
+
+void DataLog::RemoveFlushCallback(int handle) {
+  std::scoped_lock lock{m_flushCallbackMutex};
+  if (std::erase_if(m_flushCallbacks,
+                    [&](const auto& cb) { return cb.first == handle; }) != 0) {
+    --m_flushCallbackCount;
+  }
+}
+
+void DataLog::RunFlushCallbacks() {
+  if (m_flushCallbackCount == 0) {
+    [[likely]] return;
+  }
+  std::scoped_lock lock{m_flushCallbackMutex};
+  for (auto&& cb : m_flushCallbacks) {
+    cb.second();
+  }
+}
+
 void DataLog::Pause() {
-  std::scoped_lock lock{m_mutex};
   m_paused = true;
 }
 
 void DataLog::Resume() {
-  std::scoped_lock lock{m_mutex};
+  m_overflowPaused = false;
   m_paused = false;
 }
 
@@ -129,6 +230,110 @@ void DataLog::Stop() {
 
 void DataLog::BufferHalfFull() {}
 
+DataLog::Stats DataLog::GetStats() const {
+  Stats stats;
+  {
+    std::scoped_lock lock{m_mutex};
+    stats.records = m_exitedCounts.records;
+    stats.bytes = m_exitedCounts.bytes;
+    for (auto&& tb : m_threadBufs) {
+      std::scoped_lock tbLock{tb->mutex};
+      stats.records += tb->counts.records;
+      stats.bytes += tb->counts.bytes;
+    }
+    std::scoped_lock poolLock{m_poolMutex};
+    stats.overflowCount = m_overflowCount;
+    stats.buffersInFlight = m_outgoingCount;
+  }
+  stats.droppedRecords = m_droppedRecords.load(std::memory_order_relaxed);
+  std::scoped_lock filterLock{m_filterMutex};
+  stats.filteredRecords = m_filteredRecords;
+  return stats;
+}
+
+static bool IsFilterEnabled(const DataLog::EntryFilter& filter) {
+  return filter.minPeriod > 0 || filter.deadband >= 0 || filter.onChange;
+}
+
+void DataLog::SetEntryFilter(int entry, const EntryFilter& filter) {
+  if (entry <= 0) {
+    return;
+  }
+  std::scoped_lock lock{m_filterMutex};
+  if (IsFilterEnabled(filter)) {
+    m_filters[entry] = FilterState{.filter = filter};
+  } else {
+    m_filters.erase(entry);
+  }
+  m_filterCount = m_filters.size();
+}
+
+void DataLog::SetEntryFilter(std::string_view prefix,
+                             const EntryFilter& filter) {
+  std::scoped_lock lock{m_mutex};
+  auto it =
+      std::find_if(m_prefixFilters.begin(), m_prefixFilters.end(),
+                   [&](const auto& elem) { return elem.first == prefix; });
+  if (IsFilterEnabled(filter)) {
+    if (it == m_prefixFilters.end()) {
+      m_prefixFilters.emplace_back(prefix, filter);
+    } else {
+      it->second = filter;
+    }
+  } else if (it != m_prefixFilters.end()) {
+    m_prefixFilters.erase(it);
+  } else {
+    return;
+  }
+
+  // update existing entries
+  for (auto&& entryInfo : m_entries) {
+    if (entryInfo.second.id != 0 && entryInfo.first.starts_with(prefix)) {
+      ApplyPrefixFilter(entryInfo.second.id, entryInfo.first);
+    }
+  }
+}
+
+void DataLog::ApplyPrefixFilter(int entry, std::string_view name) {
+  const EntryFilter* best = nullptr;
+  size_t bestLen = 0;
+  for (auto&& [prefix, filter] : m_prefixFilters) {
+    if (name.starts_with(prefix) && (!best || prefix.size() > bestLen)) {
+      best = &filter;
+      bestLen = prefix.size();
+    }
+  }
+  SetEntryFilter(entry, best ? *best : EntryFilter{});
+}
+
+uint64_t DataLog::GetEntryBytes(int entry) const {
+  if (entry <= 0) {
+    return 0;
+  }
+  auto get = [&](const AppendCounts& counts) -> uint64_t {
+    size_t index = entry;
+    return index < counts.entryBytes.size() ? counts.entryBytes[index] : 0;
+  };
+  std::scoped_lock lock{m_mutex};
+  uint64_t bytes = get(m_exitedCounts);
+  for (auto&& tb : m_threadBufs) {
+    std::scoped_lock tbLock{tb->mutex};
+    bytes += get(tb->counts);
+  }
+  return bytes;
+}
+
+void DataLog::AppendCounts::Add(const AppendCounts& oth) {
+  records += oth.records;
+  bytes += oth.bytes;
+  if (entryBytes.size() < oth.entryBytes.size()) {
+    entryBytes.resize(oth.entryBytes.size());
+  }
+  for (size_t i = 0; i < oth.entryBytes.size(); ++i) {
+    entryBytes[i] += oth.entryBytes[i];
+  }
+}
+
 bool DataLog::HasSchema(std::string_view name) const {
   std::scoped_lock lock{m_mutex};
   wpi::SmallString<128> fullName{"/.schema/"};
@@ -156,8 +361,8 @@ void DataLog::AddSchema(std::string_view name, std::string_view type,
   if (!m_active) {
     [[unlikely]] return;
   }
-  StartRecord(entry, timestamp, schema.size(), 0);
-  AppendImpl(schema);
+  StartRecord(m_outgoing, entry, timestamp, schema.size(), 0);
+  AppendImpl(m_outgoing, schema);
 }
 
 // Control records use the following format:
@@ -176,6 +381,9 @@ int DataLog::StartImpl(std::string_view name, std::string_view type,
   auto& entryInfo = m_entries[name];
   if (entryInfo.id == 0) {
     entryInfo.id = ++m_lastId;
+    if (!m_prefixFilters.empty()) {
+      ApplyPrefixFilter(entryInfo.id, name);
+    }
   }
   auto& entryInfo2 = m_entryIds[entryInfo.id];
   ++entryInfo2.count;
@@ -195,6 +403,7 @@ int DataLog::StartImpl(std::string_view name, std::string_view type,
     [[unlikely]] return entryInfo.id;
   }
 
+  CollectThreadBuffers();
   AppendStartRecord(entryInfo.id, name, type, metadata, timestamp);
   return entryInfo.id;
 }
@@ -203,12 +412,48 @@ void DataLog::AppendStartRecord(int id, std::string_view name,
                                 std::string_view type,
                                 std::string_view metadata, int64_t timestamp) {
   size_t strsize = name.size() + type.size() + metadata.size();
-  uint8_t* buf = StartRecord(0, timestamp, 5 + 12 + strsize, 5);
+  uint8_t* buf = StartRecord(m_outgoing, 0, timestamp, 5 + 12 + strsize, 5);
   *buf++ = impl::kControlStart;
   wpi::support::endian::write32le(buf, id);
-  AppendStringImpl(name);
-  AppendStringImpl(type);
-  AppendStringImpl(metadata);
+  AppendStringImpl(m_outgoing, name);
+  AppendStringImpl(m_outgoing, type);
+  AppendStringImpl(m_outgoing, metadata);
+}
+
+void DataLog::CollectThreadBuffers() {
+  std::erase_if(m_threadBufs, [&](const auto& tb) {
+    std::scoped_lock lock{tb->mutex};
+    for (auto&& buf : tb->bufs) {
+      m_outgoing.emplace_back(std::move(buf));
+    }
+    tb->bufs.clear();
+    if (tb->orphaned.load()) {
+      m_exitedCounts.Add(tb->counts);
+      return true;
+    }
+    return false;
+  });
+}
+
+DataLog::Buffer DataLog::AllocBuffer() {
+  std::scoped_lock lock{m_poolMutex};
+  if (m_outgoingCount == kMaxBufferCount / 2) {
+    [[unlikely]] BufferHalfFull();
+  }
+  ++m_outgoingCount;
+  if (m_free.empty()) {
+    if (m_outgoingCount > kMaxBufferCount) {
+      [[unlikely]]
+      if (BufferFull() && !m_paused.exchange(true)) {
+        m_overflowPaused = true;
+        ++m_overflowCount;
+      }
+    }
+    return Buffer{};
+  }
+  Buffer buf = std::move(m_free.back());
+  m_free.pop_back();
+  return buf;
 }
 
 void DataLog::DoReleaseBufs(std::vector<Buffer>* bufs) {
@@ -238,7 +483,8 @@ void DataLog::Finish(int entry, int64_t timestamp) {
   if (!m_active) {
     [[unlikely]] return;
   }
-  uint8_t* buf = StartRecord(0, timestamp, 5, 5);
+  CollectThreadBuffers();
+  uint8_t* buf = StartRecord(m_outgoing, 0, timestamp, 5, 5);
   *buf++ = impl::kControlFinish;
   wpi::support::endian::write32le(buf, entry);
 }
@@ -253,59 +499,147 @@ void DataLog::SetMetadata(int entry, std::string_view metadata,
   if (!m_active) {
     [[unlikely]] return;
   }
-  uint8_t* buf = StartRecord(0, timestamp, 5 + 4 + metadata.size(), 5);
+  CollectThreadBuffers();
+  uint8_t* buf =
+      StartRecord(m_outgoing, 0, timestamp, 5 + 4 + metadata.size(), 5);
   *buf++ = impl::kControlSetMetadata;
   wpi::support::endian::write32le(buf, entry);
-  AppendStringImpl(metadata);
+  AppendStringImpl(m_outgoing, metadata);
 }
 
-uint8_t* DataLog::Reserve(size_t size) {
-  assert(size <= kBlockSize);
-  if (m_outgoing.empty() || size > m_outgoing.back().GetRemaining()) {
-    if (m_outgoing.size() == kMaxBufferCount / 2) {
-      [[unlikely]] BufferHalfFull();
-    }
-    if (m_free.empty()) {
-      if (m_outgoing.size() >= kMaxBufferCount) {
-        [[unlikely]]
-        if (BufferFull()) {
-          m_paused = true;
-        }
-      }
-      m_outgoing.emplace_back();
+inline bool DataLog::CheckPaused() {
+  if (!m_paused.load(std::memory_order_relaxed)) {
+    [[likely]] return false;
+  }
+  if (m_overflowPaused.load(std::memory_order_relaxed)) {
+    m_droppedRecords.fetch_add(1, std::memory_order_relaxed);
+  }
+  return true;
+}
+
+inline bool DataLog::Accept(int entry, int64_t* timestamp,
+                            function_ref<uint64_t()> hash,
+                            const double* value) {
+  if (m_filterCount.load(std::memory_order_relaxed) == 0) {
+    [[likely]] return true;
+  }
+  return CheckFilter(entry, timestamp, hash, value);
+}
+
+bool DataLog::CheckFilter(int entry, int64_t* timestamp,
+                          function_ref<uint64_t()> hash, const double* value) {
+  std::scoped_lock lock{m_filterMutex};
+  auto it = m_filters.find(entry);
+  if (it == m_filters.end()) {
+    return true;
+  }
+  auto& state = it->second;
+  auto& filter = state.filter;
+  if (*timestamp == 0) {
+    *timestamp = wpi::Now();
+  }
+  if (state.hasLast) {
+    // out of order timestamps are never decimated
+    int64_t elapsed = *timestamp - state.lastTimestamp;
+    if (elapsed >= 0 && elapsed < filter.minPeriod) {
+      ++m_filteredRecords;
+      return false;
+    }
+    if (value && filter.deadband >= 0 &&
+        std::abs(*value - state.lastValue) <= filter.deadband) {
+      ++m_filteredRecords;
+      return false;
+    }
+  }
+  uint64_t h = 0;
+  if (filter.onChange) {
+    h = hash();
+    if (state.hasLast && h == state.lastHash) {
+      ++m_filteredRecords;
+      return false;
+    }
+  }
+  state.hasLast = true;
+  state.lastTimestamp = *timestamp;
+  state.lastHash = h;
+  if (value) {
+    state.lastValue = *value;
+  }
+  return true;
+}
+
+static uint64_t CombineHash(uint64_t h, uint64_t v) {
+  return (h ^ v) * 0x9e3779b97f4a7c15ull + (h >> 29);
+}
+
+template <typename T>
+static uint64_t HashSpan(std::span<const T> arr) {
+  return wpi::xxh3_64bits(
+      {reinterpret_cast<const uint8_t*>(arr.data()), arr.size_bytes()});
+}
+
+template <typename T>
+static uint64_t HashStrings(std::span<const T> arr) {
+  uint64_t h = arr.size();
+  for (auto&& str : arr) {
+    if constexpr (std::same_as<T, WPI_String>) {
+      h = CombineHash(h, wpi::xxh3_64bits(wpi::to_string_view(&str)));
     } else {
-      m_outgoing.emplace_back(std::move(m_free.back()));
-      m_free.pop_back();
+      h = CombineHash(h, wpi::xxh3_64bits(str));
     }
   }
-  return m_outgoing.back().Reserve(size);
+  return h;
+}
+
+uint8_t* DataLog::StartDataRecord(ThreadBuffers& out, int entry,
+                                  int64_t timestamp, uint32_t payloadSize,
+                                  size_t reserveSize) {
+  auto& counts = out.counts;
+  ++counts.records;
+  counts.bytes += payloadSize;
+  size_t index = entry;
+  if (index >= counts.entryBytes.size()) {
+    [[unlikely]] counts.entryBytes.resize(index + 1);
+  }
+  counts.entryBytes[index] += payloadSize;
+  return StartRecord(out.bufs, entry, timestamp, payloadSize, reserveSize);
+}
+
+uint8_t* DataLog::Reserve(std::vector<Buffer>& out, size_t size) {
+  assert(size <= kBlockSize);
+  if (out.empty() || size > out.back().GetRemaining()) {
+    out.emplace_back(AllocBuffer());
+  }
+  return out.back().Reserve(size);
 }
 
-uint8_t* DataLog::StartRecord(uint32_t entry, uint64_t timestamp,
-                              uint32_t payloadSize, size_t reserveSize) {
-  uint8_t* buf = Reserve(kRecordMaxHeaderSize + reserveSize);
+uint8_t* DataLog::StartRecord(std::vector<Buffer>& out, uint32_t entry,
+                              uint64_t timestamp, uint32_t payloadSize,
+                              size_t reserveSize) {
+  uint8_t* buf = Reserve(out, kRecordMaxHeaderSize + reserveSize);
   auto headerLen = WriteRecordHeader(buf, entry, timestamp, payloadSize);
-  m_outgoing.back().Unreserve(kRecordMaxHeaderSize - headerLen);
+  out.back().Unreserve(kRecordMaxHeaderSize - headerLen);
   buf += headerLen;
   return buf;
 }
 
-void DataLog::AppendImpl(std::span<const uint8_t> data) {
+void DataLog::AppendImpl(std::vector<Buffer>& out,
+                         std::span<const uint8_t> data) {
   while (data.size() > kBlockSize) {
-    uint8_t* buf = Reserve(kBlockSize);
+    uint8_t* buf = Reserve(out, kBlockSize);
     std::memcpy(buf, data.data(), kBlockSize);
     data = data.subspan(kBlockSize);
   }
   if (!data.empty()) {
-    uint8_t* buf = Reserve(data.size());
+    uint8_t* buf = Reserve(out, data.size());
     std::memcpy(buf, data.data(), data.size());
   }
 }
 
-void DataLog::AppendStringImpl(std::string_view str) {
-  uint8_t* buf = Reserve(4);
+void DataLog::AppendStringImpl(std::vector<Buffer>& out, std::string_view str) {
+  uint8_t* buf = Reserve(out, 4);
   wpi::support::endian::write32le(buf, str.size());
-  AppendImpl({reinterpret_cast<const uint8_t*>(str.data()), str.size()});
+  AppendImpl(out, {reinterpret_cast<const uint8_t*>(str.data()), str.size()});
 }
 
 void DataLog::AppendRaw(int entry, std::span<const uint8_t> data,
@@ -313,12 +647,16 @@ void DataLog::AppendRaw(int entry, std::span<const uint8_t> data,
   if (entry <= 0) {
     return;
   }
-  std::scoped_lock lock{m_mutex};
-  if (m_paused) {
+  if (CheckPaused()) {
     [[unlikely]] return;
   }
-  StartRecord(entry, timestamp, data.size(), 0);
-  AppendImpl(data);
+  if (!Accept(entry, &timestamp, [&] { return wpi::xxh3_64bits(data); })) {
+    return;
+  }
+  auto& out = GetThreadBuffers();
+  std::scoped_lock lock{out.mutex};
+  StartDataRecord(out, entry, timestamp, data.size(), 0);
+  AppendImpl(out.bufs, data);
 }
 
 void DataLog::AppendRaw2(int entry,
@@ -327,17 +665,27 @@ void DataLog::AppendRaw2(int entry,
   if (entry <= 0) {
     return;
   }
-  std::scoped_lock lock{m_mutex};
-  if (m_paused) {
+  if (CheckPaused()) {
     [[unlikely]] return;
   }
+  if (!Accept(entry, &timestamp, [&] {
+        uint64_t h = data.size();
+        for (auto&& chunk : data) {
+          h = CombineHash(h, wpi::xxh3_64bits(chunk));
+        }
+        return h;
+      })) {
+    return;
+  }
+  auto& out = GetThreadBuffers();
+  std::scoped_lock lock{out.mutex};
   size_t size = 0;
   for (auto&& chunk : data) {
     size += chunk.size();
   }
-  StartRecord(entry, timestamp, size, 0);
+  StartDataRecord(out, entry, timestamp, size, 0);
   for (auto chunk : data) {
-    AppendImpl(chunk);
+    AppendImpl(out.bufs, chunk);
   }
 }
 
@@ -345,11 +693,15 @@ void DataLog::AppendBoolean(int entry, bool value, int64_t timestamp) {
   if (entry <= 0) {
     return;
   }
-  std::scoped_lock lock{m_mutex};
-  if (m_paused) {
+  if (CheckPaused()) {
     [[unlikely]] return;
   }
-  uint8_t* buf = StartRecord(entry, timestamp, 1, 1);
+  if (!Accept(entry, &timestamp, [&] { return value ? 1 : 0; })) {
+    return;
+  }
+  auto& out = GetThreadBuffers();
+  std::scoped_lock lock{out.mutex};
+  uint8_t* buf = StartDataRecord(out, entry, timestamp, 1, 1);
   buf[0] = value ? 1 : 0;
 }
 
@@ -357,11 +709,15 @@ void DataLog::AppendInteger(int entry, int64_t value, int64_t timestamp) {
   if (entry <= 0) {
     return;
   }
-  std::scoped_lock lock{m_mutex};
-  if (m_paused) {
+  if (CheckPaused()) {
     [[unlikely]] return;
   }
-  uint8_t* buf = StartRecord(entry, timestamp, 8, 8);
+  if (!Accept(entry, &timestamp, [&] { return value; })) {
+    return;
+  }
+  auto& out = GetThreadBuffers();
+  std::scoped_lock lock{out.mutex};
+  uint8_t* buf = StartDataRecord(out, entry, timestamp, 8, 8);
   wpi::support::endian::write64le(buf, value);
 }
 
@@ -369,11 +725,18 @@ void DataLog::AppendFloat(int entry, float value, int64_t timestamp) {
   if (entry <= 0) {
     return;
   }
-  std::scoped_lock lock{m_mutex};
-  if (m_paused) {
+  if (CheckPaused()) {
     [[unlikely]] return;
   }
-  uint8_t* buf = StartRecord(entry, timestamp, 4, 4);
+  double dvalue = value;
+  if (!Accept(
+          entry, &timestamp,
+          [&] { return std::bit_cast<uint32_t>(value); }, &dvalue)) {
+    return;
+  }
+  auto& out = GetThreadBuffers();
+  std::scoped_lock lock{out.mutex};
+  uint8_t* buf = StartDataRecord(out, entry, timestamp, 4, 4);
   if constexpr (std::endian::native == std::endian::little) {
     std::memcpy(buf, &value, 4);
   } else {
@@ -385,11 +748,17 @@ void DataLog::AppendDouble(int entry, double value, int64_t timestamp) {
   if (entry <= 0) {
     return;
   }
-  std::scoped_lock lock{m_mutex};
-  if (m_paused) {
+  if (CheckPaused()) {
     [[unlikely]] return;
   }
-  uint8_t* buf = StartRecord(entry, timestamp, 8, 8);
+  if (!Accept(
+          entry, &timestamp,
+          [&] { return std::bit_cast<uint64_t>(value); }, &value)) {
+    return;
+  }
+  auto& out = GetThreadBuffers();
+  std::scoped_lock lock{out.mutex};
+  uint8_t* buf = StartDataRecord(out, entry, timestamp, 8, 8);
   if constexpr (std::endian::native == std::endian::little) {
     std::memcpy(buf, &value, 8);
   } else {
@@ -409,20 +778,24 @@ void DataLog::AppendBooleanArray(int entry, std::span<const bool> arr,
   if (entry <= 0) {
     return;
   }
-  std::scoped_lock lock{m_mutex};
-  if (m_paused) {
+  if (CheckPaused()) {
     [[unlikely]] return;
   }
-  StartRecord(entry, timestamp, arr.size(), 0);
+  if (!Accept(entry, &timestamp, [&] { return HashSpan(arr); })) {
+    return;
+  }
+  auto& out = GetThreadBuffers();
+  std::scoped_lock lock{out.mutex};
+  StartDataRecord(out, entry, timestamp, arr.size(), 0);
   uint8_t* buf;
   while (arr.size() > kBlockSize) {
-    buf = Reserve(kBlockSize);
+    buf = Reserve(out.bufs, kBlockSize);
     for (auto val : arr.subspan(0, kBlockSize)) {
       *buf++ = val ? 1 : 0;
     }
     arr = arr.subspan(kBlockSize);
   }
-  buf = Reserve(arr.size());
+  buf = Reserve(out.bufs, arr.size());
   for (auto val : arr) {
     *buf++ = val ? 1 : 0;
   }
@@ -433,20 +806,24 @@ void DataLog::AppendBooleanArray(int entry, std::span<const int> arr,
   if (entry <= 0) {
     return;
   }
-  std::scoped_lock lock{m_mutex};
-  if (m_paused) {
+  if (CheckPaused()) {
     [[unlikely]] return;
   }
-  StartRecord(entry, timestamp, arr.size(), 0);
+  if (!Accept(entry, &timestamp, [&] { return HashSpan(arr); })) {
+    return;
+  }
+  auto& out = GetThreadBuffers();
+  std::scoped_lock lock{out.mutex};
+  StartDataRecord(out, entry, timestamp, arr.size(), 0);
   uint8_t* buf;
   while (arr.size() > kBlockSize) {
-    buf = Reserve(kBlockSize);
+    buf = Reserve(out.bufs, kBlockSize);
     for (auto val : arr.subspan(0, kBlockSize)) {
       *buf++ = val & 1;
     }
     arr = arr.subspan(kBlockSize);
   }
-  buf = Reserve(arr.size());
+  buf = Reserve(out.bufs, arr.size());
   for (auto val : arr) {
     *buf++ = val & 1;
   }
@@ -467,21 +844,25 @@ void DataLog::AppendIntegerArray(int entry, std::span<const int64_t> arr,
     if (entry <= 0) {
       return;
     }
-    std::scoped_lock lock{m_mutex};
-    if (m_paused) {
+    if (CheckPaused()) {
       [[unlikely]] return;
     }
-    StartRecord(entry, timestamp, arr.size() * 8, 0);
+    if (!Accept(entry, &timestamp, [&] { return HashSpan(arr); })) {
+      return;
+    }
+    auto& out = GetThreadBuffers();
+    std::scoped_lock lock{out.mutex};
+    StartDataRecord(out, entry, timestamp, arr.size() * 8, 0);
     uint8_t* buf;
     while ((arr.size() * 8) > kBlockSize) {
-      buf = Reserve(kBlockSize);
+      buf = Reserve(out.bufs, kBlockSize);
       for (auto val : arr.subspan(0, kBlockSize / 8)) {
         wpi::support::endian::write64le(buf, val);
         buf += 8;
       }
       arr = arr.subspan(kBlockSize / 8);
     }
-    buf = Reserve(arr.size() * 8);
+    buf = Reserve(out.bufs, arr.size() * 8);
     for (auto val : arr) {
       wpi::support::endian::write64le(buf, val);
       buf += 8;
@@ -499,21 +880,25 @@ void DataLog::AppendFloatArray(int entry, std::span<const float> arr,
     if (entry <= 0) {
       return;
     }
-    std::scoped_lock lock{m_mutex};
-    if (m_paused) {
+    if (CheckPaused()) {
       [[unlikely]] return;
     }
-    StartRecord(entry, timestamp, arr.size() * 4, 0);
+    if (!Accept(entry, &timestamp, [&] { return HashSpan(arr); })) {
+      return;
+    }
+    auto& out = GetThreadBuffers();
+    std::scoped_lock lock{out.mutex};
+    StartDataRecord(out, entry, timestamp, arr.size() * 4, 0);
     uint8_t* buf;
     while ((arr.size() * 4) > kBlockSize) {
-      buf = Reserve(kBlockSize);
+      buf = Reserve(out.bufs, kBlockSize);
       for (auto val : arr.subspan(0, kBlockSize / 4)) {
         wpi::support::endian::write32le(buf, std::bit_cast<uint32_t>(val));
         buf += 4;
       }
       arr = arr.subspan(kBlockSize / 4);
     }
-    buf = Reserve(arr.size() * 4);
+    buf = Reserve(out.bufs, arr.size() * 4);
     for (auto val : arr) {
       wpi::support::endian::write32le(buf, std::bit_cast<uint32_t>(val));
       buf += 4;
@@ -531,21 +916,25 @@ void DataLog::AppendDoubleArray(int entry, std::span<const double> arr,
     if (entry <= 0) {
       return;
     }
-    std::scoped_lock lock{m_mutex};
-    if (m_paused) {
+    if (CheckPaused()) {
       [[unlikely]] return;
     }
-    StartRecord(entry, timestamp, arr.size() * 8, 0);
+    if (!Accept(entry, &timestamp, [&] { return HashSpan(arr); })) {
+      return;
+    }
+    auto& out = GetThreadBuffers();
+    std::scoped_lock lock{out.mutex};
+    StartDataRecord(out, entry, timestamp, arr.size() * 8, 0);
     uint8_t* buf;
     while ((arr.size() * 8) > kBlockSize) {
-      buf = Reserve(kBlockSize);
+      buf = Reserve(out.bufs, kBlockSize);
       for (auto val : arr.subspan(0, kBlockSize / 8)) {
         wpi::support::endian::write64le(buf, std::bit_cast<uint64_t>(val));
         buf += 8;
       }
       arr = arr.subspan(kBlockSize / 8);
     }
-    buf = Reserve(arr.size() * 8);
+    buf = Reserve(out.bufs, arr.size() * 8);
     for (auto val : arr) {
       wpi::support::endian::write64le(buf, std::bit_cast<uint64_t>(val));
       buf += 8;
@@ -564,14 +953,18 @@ void DataLog::AppendStringArray(int entry, std::span<const std::string> arr,
   for (auto&& str : arr) {
     size += 4 + str.size();
   }
-  std::scoped_lock lock{m_mutex};
-  if (m_paused) {
+  if (CheckPaused()) {
     [[unlikely]] return;
   }
-  uint8_t* buf = StartRecord(entry, timestamp, size, 4);
+  if (!Accept(entry, &timestamp, [&] { return HashStrings(arr); })) {
+    return;
+  }
+  auto& out = GetThreadBuffers();
+  std::scoped_lock lock{out.mutex};
+  uint8_t* buf = StartDataRecord(out, entry, timestamp, size, 4);
   wpi::support::endian::write32le(buf, arr.size());
   for (auto&& str : arr) {
-    AppendStringImpl(str);
+    AppendStringImpl(out.bufs, str);
   }
 }
 
@@ -587,14 +980,18 @@ void DataLog::AppendStringArray(int entry,
   for (auto&& str : arr) {
     size += 4 + str.size();
   }
-  std::scoped_lock lock{m_mutex};
-  if (m_paused) {
+  if (CheckPaused()) {
     [[unlikely]] return;
   }
-  uint8_t* buf = StartRecord(entry, timestamp, size, 4);
+  if (!Accept(entry, &timestamp, [&] { return HashStrings(arr); })) {
+    return;
+  }
+  auto& out = GetThreadBuffers();
+  std::scoped_lock lock{out.mutex};
+  uint8_t* buf = StartDataRecord(out, entry, timestamp, size, 4);
   wpi::support::endian::write32le(buf, arr.size());
   for (auto&& sv : arr) {
-    AppendStringImpl(sv);
+    AppendStringImpl(out.bufs, sv);
   }
 }
 
@@ -610,14 +1007,18 @@ void DataLog::AppendStringArray(int entry,
   for (auto&& str : arr) {
     size += 4 + str.len;
   }
-  std::scoped_lock lock{m_mutex};
-  if (m_paused) {
+  if (CheckPaused()) {
     [[unlikely]] return;
   }
-  uint8_t* buf = StartRecord(entry, timestamp, size, 4);
+  if (!Accept(entry, &timestamp, [&] { return HashStrings(arr); })) {
+    return;
+  }
+  auto& out = GetThreadBuffers();
+  std::scoped_lock lock{out.mutex};
+  uint8_t* buf = StartDataRecord(out, entry, timestamp, size, 4);
   wpi::support::endian::write32le(buf, arr.size());
   for (auto&& sv : arr) {
-    AppendStringImpl(sv.str);
+    AppendStringImpl(out.bufs, sv.str);
   }
 }
 
@@ -722,6 +1123,174 @@ void StringArrayLogEntry::Update(std::span<const std::string_view> arr,
   }
 }
 
+DataLogFrame::DataLogFrame(DataLog& log, std::span<const Field> fields,
+                           int64_t timestamp)
+    : m_log{&log} {
+  m_fields.reserve(fields.size());
+  for (auto&& field : fields) {
+    auto& info = m_fields.emplace_back();
+    info.offset = m_size;
+    if (field.type == "boolean") {
+      info.type = 'b';
+      info.size = 1;
+    } else if (field.type == "int64") {
+      info.type = 'i';
+      info.size = 8;
+    } else if (field.type == "float") {
+      info.type = 'f';
+      info.size = 4;
+    } else if (field.type == "double") {
+      info.type = 'd';
+      info.size = 8;
+    } else {
+      WPI_ERROR(log.m_msglog,
+                "unsupported frame field type '{}' for '{}'; ignoring",
+                field.type, field.name);
+      info.type = 0;
+      info.size = 0;
+    }
+    if (info.type != 'd') {
+      m_allDouble = false;
+    }
+    m_size += info.size;
+    info.entry =
+        info.type == 0
+            ? 0
+            : log.Start(field.name, field.type, field.metadata, timestamp);
+    if (info.entry <= 0) {
+      info.type = 0;
+      info.headerLen = 0;
+      continue;
+    }
+
+    // preformat the record header, leaving out the timestamp
+    unsigned int entryLen = WriteVarInt(info.header + 1, info.entry);
+    unsigned int sizeLen =
+        WriteVarInt(info.header + 1 + entryLen, info.size);
+    info.header[0] = ((sizeLen - 1) << 2) | (entryLen - 1);
+    info.headerLen = 1 + entryLen + sizeLen;
+    m_recordsSize += info.headerLen + info.size;
+  }
+}
+
+void DataLogFrame::Append(std::span<const uint8_t> data, int64_t timestamp) {
+  if (!m_log || data.size() < m_size) {
+    return;
+  }
+  if (m_log->CheckPaused()) {
+    [[unlikely]] return;
+  }
+  if (m_log->m_filterCount.load(std::memory_order_relaxed) != 0) {
+    // filters are per entry
+    [[unlikely]] AppendUnbatched(data, timestamp);
+    return;
+  }
+
+  if (timestamp == 0) {
+    timestamp = wpi::Now();
+  }
+  uint8_t timestampBuf[8];
+  unsigned int timestampLen =
+      WriteVarInt(timestampBuf, static_cast<uint64_t>(timestamp));
+  uint8_t timestampBits = (timestampLen - 1) << 4;
+  size_t totalSize = m_recordsSize + m_fields.size() * timestampLen;
+
+  auto& out = m_log->GetThreadBuffers();
+  std::scoped_lock lock{out.mutex};
+  uint8_t* buf = nullptr;
+  if (totalSize <= DataLog::kBlockSize) {
+    [[likely]] buf = m_log->Reserve(out.bufs, totalSize);
+  }
+  auto& counts = out.counts;
+  for (auto&& field : m_fields) {
+    if (field.type == 0) {
+      continue;
+    }
+    uint8_t* rec = buf;
+    if (!buf) {
+      // too large for one buffer; reserve each record separately
+      rec = m_log->Reserve(out.bufs,
+                           field.headerLen + timestampLen + field.size);
+    }
+    std::memcpy(rec, field.header, field.headerLen);
+    rec[0] |= timestampBits;
+    rec += field.headerLen;
+    std::memcpy(rec, timestampBuf, timestampLen);
+    rec += timestampLen;
+    std::memcpy(rec, data.data() + field.offset, field.size);
+    rec += field.size;
+    if (buf) {
+      buf = rec;
+    }
+
+    size_t index = field.entry;
+    if (index >= counts.entryBytes.size()) {
+      [[unlikely]] counts.entryBytes.resize(index + 1);
+    }
+    counts.entryBytes[index] += field.size;
+    ++counts.records;
+    counts.bytes += field.size;
+  }
+}
+
+void DataLogFrame::AppendUnbatched(std::span<const uint8_t> data,
+                                   int64_t timestamp) {
+  for (auto&& field : m_fields) {
+    const uint8_t* value = data.data() + field.offset;
+    switch (field.type) {
+      case 'b':
+        m_log->AppendBoolean(field.entry, value[0] != 0, timestamp);
+        break;
+      case 'i':
+        m_log->AppendInteger(field.entry, support::endian::read64le(value),
+                             timestamp);
+        break;
+      case 'f':
+        m_log->AppendFloat(
+            field.entry,
+            std::bit_cast<float>(support::endian::read32le(value)),
+            timestamp);
+        break;
+      case 'd':
+        m_log->AppendDouble(
+            field.entry,
+            std::bit_cast<double>(support::endian::read64le(value)),
+            timestamp);
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+void DataLogFrame::AppendDoubles(std::span<const double> values,
+                                 int64_t timestamp) {
+  if (!m_allDouble || values.size() < m_fields.size()) {
+    return;
+  }
+  if constexpr (std::endian::native == std::endian::little) {
+    Append({reinterpret_cast<const uint8_t*>(values.data()), m_size},
+           timestamp);
+  } else {
+    wpi::SmallVector<uint8_t, 1024> data;
+    data.resize_for_overwrite(m_size);
+    for (size_t i = 0; i < m_fields.size(); ++i) {
+      support::endian::write64le(data.data() + i * 8,
+                                 std::bit_cast<uint64_t>(values[i]));
+    }
+    Append(data, timestamp);
+  }
+}
+
+void DataLogFrame::Finish(int64_t timestamp) {
+  if (!m_log) {
+    return;
+  }
+  for (auto&& field : m_fields) {
+    m_log->Finish(field.entry, timestamp);
+  }
+}
+
 extern "C" {
 
 void WPI_DataLog_Release(struct WPI_DataLog* datalog) {
@@ -5,6 +5,8 @@
 #include "wpi/DataLogBackgroundWriter.h"
 
 #ifndef _WIN32
+#include <fcntl.h>
+#include <sys/stat.h>
 #include <unistd.h>
 #endif
 
@@ -17,15 +19,27 @@
 
 #endif
 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <optional>
 #include <random>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include <fmt/format.h>
 
+#include "wpi/DataLogCompressor.h"
 #include "wpi/Logger.h"
+#include "wpi/ThreadRegistry.h"
+#include "wpi/condition_variable.h"
 #include "wpi/fs.h"
+#include "wpi/mutex.h"
+#include "wpi/timestamp.h"
 
 using namespace wpi::log;
 
@@ -46,22 +60,25 @@ static std::string FormatBytesSize(uintmax_t value) {
   }
 }
 
-DataLogBackgroundWriter::DataLogBackgroundWriter(std::string_view dir,
-                                                 std::string_view filename,
-                                                 double period,
-                                                 std::string_view extraHeader)
+DataLogBackgroundWriter::DataLogBackgroundWriter(
+    std::string_view dir, std::string_view filename, double period,
+    std::string_view extraHeader, bool compress,
+    const DataLogFileOptions& options)
     : DataLogBackgroundWriter{s_defaultMessageLog, dir, filename, period,
-                              extraHeader} {}
+                              extraHeader, compress, options} {}
 
-DataLogBackgroundWriter::DataLogBackgroundWriter(wpi::Logger& msglog,
-                                                 std::string_view dir,
-                                                 std::string_view filename,
-                                                 double period,
-                                                 std::string_view extraHeader)
+DataLogBackgroundWriter::DataLogBackgroundWriter(
+    wpi::Logger& msglog, std::string_view dir, std::string_view filename,
+    double period, std::string_view extraHeader, bool compress,
+    const DataLogFileOptions& options)
     : DataLog{msglog, extraHeader},
       m_period{period},
       m_newFilename{filename},
-      m_thread{[this, dir = std::string{dir}] { WriterThreadMain(dir); }} {}
+      m_spillBudget{options.spillBudget},
+      m_thread{[this, dir = std::string{dir}, compress, options] {
+        wpi::SetCurrentThreadClass(wpi::ThreadClass::kLogging, "DataLog");
+        WriterThreadMain(dir, compress, options);
+      }} {}
 
 DataLogBackgroundWriter::DataLogBackgroundWriter(
     std::function<void(std::span<const uint8_t> data)> write, double period,
@@ -76,6 +93,7 @@ DataLogBackgroundWriter::DataLogBackgroundWriter(
     : DataLog{msglog, extraHeader},
       m_period{period},
       m_thread{[this, write = std::move(write)] {
+        wpi::SetCurrentThreadClass(wpi::ThreadClass::kLogging, "DataLog");
         WriterThreadMain(std::move(write));
       }} {}
 
@@ -131,6 +149,46 @@ void DataLogBackgroundWriter::Stop() {
   m_cond.notify_all();
 }
 
+DataLogBackgroundWriter::WriterStats DataLogBackgroundWriter::GetWriterStats()
+    const {
+  std::scoped_lock lock{m_mutex};
+  return m_writerStats;
+}
+
+void DataLogBackgroundWriter::SetStatsLogging(bool enable) {
+  std::scoped_lock lock{m_mutex};
+  m_logStats = enable;
+}
+
+void DataLogBackgroundWriter::LogStats(int64_t flushTime) {
+  if (m_statsEntries.bytes == 0) {
+    m_statsEntries.bytes = Start("/.datalog/bytes", "int64");
+    m_statsEntries.droppedRecords = Start("/.datalog/droppedRecords", "int64");
+    m_statsEntries.buffersInFlight =
+        Start("/.datalog/buffersInFlight", "int64");
+    m_statsEntries.flushTime = Start("/.datalog/flushTime", "int64");
+  }
+  auto stats = GetStats();
+  int64_t now = wpi::Now();
+  AppendInteger(m_statsEntries.bytes, stats.bytes, now);
+  AppendInteger(m_statsEntries.droppedRecords, stats.droppedRecords, now);
+  AppendInteger(m_statsEntries.buffersInFlight, stats.buffersInFlight, now);
+  AppendInteger(m_statsEntries.flushTime, flushTime, now);
+}
+
+void DataLogBackgroundWriter::UpdateWriterStats(int64_t flushTime,
+                                                uint64_t written,
+                                                uint64_t discarded) {
+  m_writerStats.bytesWritten += written;
+  m_writerStats.bytesDiscarded += discarded;
+  if (written != 0) {
+    ++m_writerStats.flushCount;
+    m_writerStats.lastFlushTime = flushTime;
+    m_writerStats.maxFlushTime =
+        (std::max)(m_writerStats.maxFlushTime, flushTime);
+  }
+}
+
 static void WriteToFile(fs::file_t f, std::span<const uint8_t> data,
                         std::string_view filename, wpi::Logger& msglog) {
   do {
@@ -161,6 +219,224 @@ static void WriteToFile(fs::file_t f, std::span<const uint8_t> data,
   } while (data.size() > 0);
 }
 
+#ifdef __linux__
+static bool PWriteAll(int fd, std::span<const uint8_t> data, uint64_t offset,
+                      std::string_view filename, wpi::Logger& msglog) {
+  while (!data.empty()) {
+    ssize_t ret = ::pwrite(fd, data.data(), data.size(), offset);
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      WPI_ERROR(msglog, "Error writing to log file '{}': {}", filename,
+                std::strerror(errno));
+      return false;
+    }
+    data = data.subspan(ret);
+    offset += ret;
+  }
+  return true;
+}
+#endif
+
+static void SyncFile(fs::file_t f) {
+#if defined(__linux__)
+  ::fdatasync(f);
+#elif defined(__APPLE__)
+  ::fsync(f);
+#endif
+}
+
+// reserves len bytes of storage for the file starting at offset, without
+// changing the file size
+static bool PreallocateFile(fs::file_t f, uint64_t offset, uint64_t len) {
+#if defined(__linux__)
+  int ret;
+  do {
+    ret = ::fallocate(f, FALLOC_FL_KEEP_SIZE, offset, len);
+  } while (ret < 0 && errno == EINTR);
+  return ret == 0;
+#elif defined(__APPLE__)
+  // allocates relative to the end of the storage already allocated
+  fstore_t store{F_ALLOCATECONTIG, F_PEOFPOSMODE, 0, static_cast<off_t>(len),
+                 0};
+  if (::fcntl(f, F_PREALLOCATE, &store) != -1) {
+    return true;
+  }
+  store.fst_flags = F_ALLOCATEALL;
+  return ::fcntl(f, F_PREALLOCATE, &store) != -1;
+#elif defined(_WIN32)
+  FILE_ALLOCATION_INFO info;
+  info.AllocationSize.QuadPart = offset + len;
+  return SetFileInformationByHandle(f, FileAllocationInfo, &info,
+                                    sizeof(info));
+#else
+  return false;
+#endif
+}
+
+// releases storage reserved by PreallocateFile() past the end of the file
+static void TrimFile(fs::file_t f) {
+#ifdef _WIN32
+  FILE_ALLOCATION_INFO info;
+  if (GetFileSizeEx(f, &info.AllocationSize)) {
+    SetFileInformationByHandle(f, FileAllocationInfo, &info, sizeof(info));
+  }
+#else
+  struct stat st;
+  if (::fstat(f, &st) == 0) {
+    int ret;
+    do {
+      ret = ::ftruncate(f, st.st_size);
+    } while (ret < 0 && errno == EINTR);
+  }
+#endif
+}
+
+namespace {
+
+// Preallocates and syncs the log file on its own thread, so that file growth
+// and syncs (which can stall for hundreds of milliseconds on some storage)
+// don't delay writing out the log buffers.
+class FileMaintainer {
+ public:
+  FileMaintainer(const wpi::log::DataLogFileOptions& options,
+                 wpi::Logger& msglog)
+      : m_preallocateSize{options.preallocateSize},
+        m_syncPeriod{options.syncPeriod},
+        m_msglog{msglog} {}
+
+  ~FileMaintainer() {
+    if (m_thread.joinable()) {
+      {
+        std::scoped_lock lock{m_mutex};
+        m_shutdown = true;
+      }
+      m_cond.notify_all();
+      m_thread.join();
+    }
+  }
+
+  FileMaintainer(const FileMaintainer&) = delete;
+  FileMaintainer& operator=(const FileMaintainer&) = delete;
+
+  // starts maintaining a newly opened file
+  void Attach(fs::file_t f, std::string_view filename) {
+    {
+      std::scoped_lock lock{m_mutex};
+      m_f = f;
+      m_filename = filename;
+      m_written = 0;
+      m_allocated = 0;
+      m_pending = true;
+      if (!m_thread.joinable()) {
+        m_thread = std::thread{[this] {
+          wpi::SetCurrentThreadClass(wpi::ThreadClass::kLogging,
+                                     "DataLogSync");
+          ThreadMain();
+        }};
+      }
+    }
+    m_cond.notify_all();
+  }
+
+  // stops maintaining the file; waits for a preallocation or sync in progress
+  void Detach() {
+    std::unique_lock lock{m_mutex};
+    m_f = fs::kInvalidFile;
+    m_pending = false;
+    m_idle.wait(lock, [&] { return !m_busy; });
+  }
+
+  // requests a sync (and more preallocation, if needed) after data has been
+  // written up to the given file size
+  void Written(uint64_t size) {
+    {
+      std::scoped_lock lock{m_mutex};
+      m_written = size;
+      m_pending = true;
+    }
+    m_cond.notify_all();
+  }
+
+  // returns the number of bytes preallocated beyond the data written
+  uint64_t GetReserved() const {
+    std::scoped_lock lock{m_mutex};
+    return m_allocated > m_written ? m_allocated - m_written : 0;
+  }
+
+ private:
+  void ThreadMain();
+
+  // only used by the maintainer thread
+  uint64_t m_preallocateSize;
+  std::chrono::duration<double> m_syncPeriod;
+  std::chrono::steady_clock::time_point m_lastSync;
+  wpi::Logger& m_msglog;
+
+  mutable wpi::mutex m_mutex;
+  wpi::condition_variable m_cond;
+  wpi::condition_variable m_idle;
+  fs::file_t m_f = fs::kInvalidFile;
+  std::string m_filename;
+  uint64_t m_written = 0;
+  uint64_t m_allocated = 0;
+  bool m_pending = false;
+  bool m_busy = false;
+  bool m_shutdown = false;
+  std::thread m_thread;
+};
+
+}  // namespace
+
+void FileMaintainer::ThreadMain() {
+  std::unique_lock lock{m_mutex};
+  for (;;) {
+    m_cond.wait(lock, [&] { return m_shutdown || m_pending; });
+    if (m_shutdown) {
+      break;
+    }
+    if (m_syncPeriod.count() > 0) {
+      auto next = m_lastSync + std::chrono::duration_cast<
+                                   std::chrono::steady_clock::duration>(
+                                   m_syncPeriod);
+      if (std::chrono::steady_clock::now() < next) {
+        m_cond.wait_until(lock, next);
+        continue;
+      }
+    }
+
+    m_pending = false;
+    m_busy = true;
+    fs::file_t f = m_f;
+    uint64_t written = m_written;
+    uint64_t allocated = m_allocated;
+    lock.unlock();
+
+    // keep at least half of the preallocation size reserved ahead
+    if (m_preallocateSize != 0 &&
+        written + m_preallocateSize / 2 >= allocated) {
+      uint64_t end = written + m_preallocateSize;
+      if (PreallocateFile(f, allocated, end - allocated)) {
+        allocated = end;
+      } else {
+        WPI_WARNING(m_msglog,
+                    "Could not preallocate log file '{}', disabling "
+                    "preallocation",
+                    m_filename);
+        m_preallocateSize = 0;
+      }
+    }
+    SyncFile(f);
+
+    lock.lock();
+    m_busy = false;
+    m_allocated = allocated;
+    m_lastSync = std::chrono::steady_clock::now();
+    m_idle.notify_all();
+  }
+}
+
 static std::string MakeRandomFilename() {
   // build random filename
   static std::random_device dev;
@@ -176,19 +452,69 @@ static std::string MakeRandomFilename() {
 }
 
 struct DataLogBackgroundWriter::WriterThreadState {
-  explicit WriterThreadState(std::string_view dir)
-      : dirPath{dir.empty() ? "." : dir} {}
+  WriterThreadState(std::string_view dir, bool compress,
+                    const DataLogFileOptions& options, wpi::Logger& msglog)
+      : dirPath{dir.empty() ? "." : dir},
+        compress{compress},
+        directIO{options.directIO},
+        maintainer{options, msglog},
+        msglog{msglog} {}
   WriterThreadState(const WriterThreadState&) = delete;
   WriterThreadState& operator=(const WriterThreadState&) = delete;
   ~WriterThreadState() { Close(); }
 
+  // must be called after the file is opened
+  void Opened() {
+    offset = 0;
+#ifdef __linux__
+    direct = false;
+    if (directIO) {
+      EnableDirect();
+    }
+#endif
+    maintainer.Attach(f, filename);
+  }
+
   void Close() {
     if (f != fs::kInvalidFile) {
+      if (compressor) {
+        // write block index
+        compressed.clear();
+        compressor->Finish(compressed);
+        Write(compressed);
+        compressor.reset();
+      }
+      Commit();
+      maintainer.Detach();
+      TrimFile(f);
+      SyncFile(f);
       fs::CloseFile(f);
       f = fs::kInvalidFile;
     }
   }
 
+  // writes data to the end of the file; with direct I/O, some of the data
+  // may be held back until Commit()
+  void Write(std::span<const uint8_t> data) {
+    offset += data.size();
+#ifdef __linux__
+    if (direct) {
+      WriteDirect(data);
+      return;
+    }
+#endif
+    WriteToFile(f, data, filename, msglog);
+  }
+
+  // writes out all data passed to Write()
+  void Commit() {
+#ifdef __linux__
+    if (direct) {
+      CommitDirect();
+    }
+#endif
+  }
+
   void SetFilename(std::string_view fn) {
     baseFilename = fn;
     filename = fn;
@@ -203,13 +529,100 @@ struct DataLogBackgroundWriter::WriterThreadState {
     path = dirPath / filename;
   }
 
+#ifdef __linux__
+  // O_DIRECT requires aligned buffers, file offsets, and sizes
+  static constexpr size_t kDirectAlign = 4096;
+  static constexpr size_t kStageSize = 256 * 1024;
+
+  struct FreeDeleter {
+    void operator()(uint8_t* p) const { std::free(p); }
+  };
+
+  bool SetDirect(bool enable) {
+    int flags = ::fcntl(f, F_GETFL);
+    if (flags < 0) {
+      return false;
+    }
+    // pwrite() ignores the offset in append mode
+    flags &= ~O_APPEND;
+    return ::fcntl(f, F_SETFL, enable ? (flags | O_DIRECT)
+                                      : (flags & ~O_DIRECT)) == 0;
+  }
+
+  void EnableDirect() {
+    if (!stage) {
+      stage.reset(
+          static_cast<uint8_t*>(std::aligned_alloc(kDirectAlign, kStageSize)));
+    }
+    if (!stage || !SetDirect(true)) {
+      WPI_WARNING(msglog, "Direct I/O not supported for log file '{}'",
+                  filename);
+      directIO = false;
+      return;
+    }
+    direct = true;
+    stageOffset = 0;
+    stageLen = 0;
+  }
+
+  void WriteDirect(std::span<const uint8_t> data) {
+    while (!data.empty()) {
+      size_t n = (std::min)(data.size(), kStageSize - stageLen);
+      std::memcpy(stage.get() + stageLen, data.data(), n);
+      stageLen += n;
+      data = data.subspan(n);
+      if (stageLen == kStageSize) {
+        WriteStage(kStageSize);
+      }
+    }
+  }
+
+  // writes and removes the first len bytes (a multiple of kDirectAlign) of
+  // the staging buffer
+  void WriteStage(size_t len) {
+    if (len == 0) {
+      return;
+    }
+    PWriteAll(f, {stage.get(), len}, stageOffset, filename, msglog);
+    stageOffset += len;
+    stageLen -= len;
+    std::memmove(stage.get(), stage.get() + len, stageLen);
+  }
+
+  void CommitDirect() {
+    WriteStage(stageLen / kDirectAlign * kDirectAlign);
+    if (stageLen == 0) {
+      return;
+    }
+    // Write the partial last block through the page cache so it's in the
+    // file now; it stays staged, and the whole block is rewritten with direct
+    // I/O once it fills up.
+    if (SetDirect(false)) {
+      PWriteAll(f, {stage.get(), stageLen}, stageOffset, filename, msglog);
+      SetDirect(true);
+    }
+  }
+
+  std::unique_ptr<uint8_t, FreeDeleter> stage;
+  size_t stageLen = 0;
+  uint64_t stageOffset = 0;  // file offset of the start of stage
+  bool direct = false;
+#endif
+
   fs::path dirPath;
   std::string baseFilename;
   std::string filename;
   fs::path path;
   fs::file_t f = fs::kInvalidFile;
+  uint64_t offset = 0;  // file size, including data held back by Write()
   uintmax_t freeSpace = UINTMAX_MAX;
   int segmentCount = 1;
+  bool compress;
+  bool directIO;
+  FileMaintainer maintainer;
+  std::optional<DataLogCompressor> compressor;
+  std::vector<uint8_t> compressed;
+  wpi::Logger& msglog;
 };
 
 void DataLogBackgroundWriter::BufferHalfFull() {
@@ -217,6 +630,18 @@ void DataLogBackgroundWriter::BufferHalfFull() {
 }
 
 bool DataLogBackgroundWriter::BufferFull() {
+  // keep buffering in memory (e.g. while a write is stalled) until the spill
+  // budget is used up
+  size_t spilled = m_spillBuffers.fetch_add(1, std::memory_order_relaxed);
+  if (spilled * kBlockSize < m_spillBudget) {
+    if (spilled == 0) {
+      WPI_WARNING(m_msglog,
+                  "outgoing buffers exceeded threshold, buffering up to {} "
+                  "more in memory",
+                  FormatBytesSize(m_spillBudget));
+    }
+    return false;
+  }
   WPI_ERROR(m_msglog,
             "outgoing buffers exceeded threshold, pausing logging--"
             "consider flushing to disk more frequently (smaller period)");
@@ -274,14 +699,19 @@ void DataLogBackgroundWriter::StartLogFile(WriterThreadState& state) {
 
   // start file
   if (state.f != fs::kInvalidFile) {
+    state.Opened();
+    if (state.compress) {
+      state.compressor.emplace();
+    }
     StartFile();
   }
 }
 
-void DataLogBackgroundWriter::WriterThreadMain(std::string_view dir) {
+void DataLogBackgroundWriter::WriterThreadMain(
+    std::string_view dir, bool compress, const DataLogFileOptions& options) {
   std::chrono::duration<double> periodTime{m_period};
 
-  WriterThreadState state{dir};
+  WriterThreadState state{dir, compress, options, m_msglog};
   {
     std::scoped_lock lock{m_mutex};
     state.SetFilename(m_newFilename);
@@ -300,12 +730,15 @@ void DataLogBackgroundWriter::WriterThreadMain(std::string_view dir) {
   do {
     bool doFlush = false;
     auto timeoutTime = std::chrono::steady_clock::now() + periodTime;
-    if (m_cond.wait_until(lock, timeoutTime) == std::cv_status::timeout) {
+    // don't wait if a flush was requested while writing
+    if (!m_doFlush &&
+        m_cond.wait_until(lock, timeoutTime) == std::cv_status::timeout) {
       doFlush = true;
     }
 
     if (m_state == kStopped) {
       state.Close();
+      m_doFlush = false;
       continue;
     }
 
@@ -341,6 +774,7 @@ void DataLogBackgroundWriter::WriterThreadMain(std::string_view dir) {
       StartLogFile(state);
       lock.lock();
       if (m_state == kStopped) {
+        m_doFlush = false;
         continue;
       }
       m_state = kActive;
@@ -367,50 +801,91 @@ void DataLogBackgroundWriter::WriterThreadMain(std::string_view dir) {
     }
 
     if (doFlush || m_doFlush) {
+      if (m_logStats) {
+        int64_t flushTime = m_writerStats.lastFlushTime;
+        lock.unlock();
+        LogStats(flushTime);
+        lock.lock();
+      }
+
       // flush to file
       m_doFlush = false;
       DataLog::FlushBufs(&toWrite);
+      m_spillBuffers.store(0, std::memory_order_relaxed);
       if (toWrite.empty()) {
         continue;
       }
 
-      if (state.f != fs::kInvalidFile && !blocked) {
+      uint64_t toWriteSize = 0;
+      for (auto&& buf : toWrite) {
+        toWriteSize += buf.GetData().size();
+      }
+
+      if (state.f == fs::kInvalidFile || blocked) {
+        UpdateWriterStats(0, 0, toWriteSize);
+      } else {
         lock.unlock();
+        int64_t flushStart = wpi::Now();
+        uint64_t flushWritten = 0;
+        // uncompressed bytes of toWrite that were written
+        uint64_t flushConsumed = 0;
 
         // update free space every 10 flushes (in case other things are writing)
         if (++freeSpaceCount >= 10) {
           freeSpaceCount = 0;
           auto freeSpaceInfo = fs::space(state.dirPath, ec);
           if (!ec) {
-            state.freeSpace = freeSpaceInfo.available;
+            // space preallocated for the file is still available to it
+            state.freeSpace =
+                freeSpaceInfo.available + state.maintainer.GetReserved();
           } else {
             state.freeSpace = UINTMAX_MAX;
           }
         }
 
         // write buffers to file
-        for (auto&& buf : toWrite) {
+        auto writeData = [&](std::span<const uint8_t> data) {
           // stop writing when we go below the minimum free space
-          state.freeSpace -= buf.GetData().size();
-          written += buf.GetData().size();
+          state.freeSpace -= data.size();
+          written += data.size();
           if (state.freeSpace < kMinFreeSpace) {
             [[unlikely]] WPI_ERROR(
                 m_msglog,
                 "Stopped logging due to low free space ({} available)",
                 FormatBytesSize(state.freeSpace));
             blocked = true;
-            break;
+            return false;
+          }
+          state.Write(data);
+          flushWritten += data.size();
+          return true;
+        };
+        if (state.compressor) {
+          // end the block so everything flushed so far gets synced
+          state.compressed.clear();
+          for (auto&& buf : toWrite) {
+            state.compressor->Write(buf.GetData(), state.compressed);
+          }
+          state.compressor->Flush(state.compressed);
+          if (writeData(state.compressed)) {
+            flushConsumed = toWriteSize;
+          }
+        } else {
+          for (auto&& buf : toWrite) {
+            if (!writeData(buf.GetData())) {
+              break;
+            }
+            flushConsumed += buf.GetData().size();
           }
-          WriteToFile(state.f, buf.GetData(), state.filename, m_msglog);
         }
 
-        // sync to storage
-#if defined(__linux__)
-        ::fdatasync(state.f);
-#elif defined(__APPLE__)
-        ::fsync(state.f);
-#endif
+        // sync to storage in the background
+        state.Commit();
+        state.maintainer.Written(state.offset);
+        int64_t flushTime = wpi::Now() - flushStart;
         lock.lock();
+        UpdateWriterStats(flushTime, flushWritten,
+                          toWriteSize - flushConsumed);
         if (blocked) {
           [[unlikely]] m_state = kPaused;
         }
@@ -419,7 +894,7 @@ void DataLogBackgroundWriter::WriterThreadMain(std::string_view dir) {
       // release buffers back to free list
       ReleaseBufs(&toWrite);
     }
-  } while (!m_shutdown);
+  } while (!m_shutdown || m_doFlush);
 }
 
 void DataLogBackgroundWriter::WriterThreadMain(
@@ -434,31 +909,46 @@ void DataLogBackgroundWriter::WriterThreadMain(
   do {
     bool doFlush = false;
     auto timeoutTime = std::chrono::steady_clock::now() + periodTime;
-    if (m_cond.wait_until(lock, timeoutTime) == std::cv_status::timeout) {
+    // don't wait if a flush was requested while writing
+    if (!m_doFlush &&
+        m_cond.wait_until(lock, timeoutTime) == std::cv_status::timeout) {
       doFlush = true;
     }
 
     if (doFlush || m_doFlush) {
+      if (m_logStats) {
+        int64_t flushTime = m_writerStats.lastFlushTime;
+        lock.unlock();
+        LogStats(flushTime);
+        lock.lock();
+      }
+
       // flush to file
       m_doFlush = false;
       DataLog::FlushBufs(&toWrite);
+      m_spillBuffers.store(0, std::memory_order_relaxed);
       if (toWrite.empty()) {
         continue;
       }
 
       lock.unlock();
       // write buffers
+      int64_t flushStart = wpi::Now();
+      uint64_t flushWritten = 0;
       for (auto&& buf : toWrite) {
         if (!buf.GetData().empty()) {
           write(buf.GetData());
+          flushWritten += buf.GetData().size();
         }
       }
+      int64_t flushTime = wpi::Now() - flushStart;
       lock.lock();
+      UpdateWriterStats(flushTime, flushWritten, 0);
 
       // release buffers back to free list
       ReleaseBufs(&toWrite);
     }
-  } while (!m_shutdown);
+  } while (!m_shutdown || m_doFlush);
 
   write({});  // indicate EOF
 }
@@ -0,0 +1,139 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/DataLogCompressor.h"
+
+#include <cstring>
+
+#include "wpi/Endian.h"
+#include "wpi/LZ4.h"
+
+using namespace wpi::log;
+
+static uint64_t ReadVarInt(std::span<const uint8_t> buf) {
+  uint64_t val = 0;
+  int shift = 0;
+  for (auto v : buf) {
+    val |= static_cast<uint64_t>(v) << shift;
+    shift += 8;
+  }
+  return val;
+}
+
+void DataLogCompressor::Start(std::vector<uint8_t>& out) {
+  if (!m_started) {
+    out.insert(out.end(), std::begin(impl::kCompressedMagic),
+               std::end(impl::kCompressedMagic));
+    m_fileOffset = sizeof(impl::kCompressedMagic);
+    m_started = true;
+  }
+}
+
+void DataLogCompressor::Write(std::span<const uint8_t> data,
+                              std::vector<uint8_t>& out) {
+  Start(out);
+  m_pending.insert(m_pending.end(), data.begin(), data.end());
+  for (;;) {
+    ParseRecords();
+    if (m_lastBoundary == 0 || m_lastBoundary < m_blockSize) {
+      break;
+    }
+    WriteBlock(m_lastBoundary, out);
+  }
+}
+
+void DataLogCompressor::Flush(std::vector<uint8_t>& out) {
+  Start(out);
+  if (m_lastBoundary != 0) {
+    WriteBlock(m_lastBoundary, out);
+  }
+}
+
+void DataLogCompressor::Finish(std::vector<uint8_t>& out) {
+  Flush(out);
+  // shouldn't happen, but don't lose a truncated record
+  if (!m_pending.empty()) {
+    WriteBlock(m_pending.size(), out);
+  }
+
+  size_t pos = out.size();
+  out.resize(pos + m_index.size() * impl::kCompressedIndexEntrySize +
+             impl::kCompressedIndexTrailerSize);
+  uint8_t* buf = out.data() + pos;
+  for (auto&& entry : m_index) {
+    support::endian::write64le(buf, entry.fileOffset);
+    support::endian::write64le(buf + 8, entry.uncompressedOffset);
+    support::endian::write64le(buf + 16, entry.timestamp);
+    buf += impl::kCompressedIndexEntrySize;
+  }
+  support::endian::write32le(buf, m_index.size());
+  std::memcpy(buf + 4, impl::kCompressedIndexMagic,
+              sizeof(impl::kCompressedIndexMagic));
+  m_index.clear();
+}
+
+void DataLogCompressor::ParseRecords() {
+  if (!m_headerParsed) {
+    if (m_pending.size() < 12) {
+      return;
+    }
+    m_nextRecord = 12 + support::endian::read32le(&m_pending[8]);
+    m_headerParsed = true;
+  }
+
+  while (m_nextRecord <= m_pending.size()) {
+    m_lastBoundary = m_nextRecord;
+    if (m_lastBoundary >= m_blockSize) {
+      return;  // end block here; next record goes into the next block
+    }
+
+    auto buf = std::span{m_pending}.subspan(m_nextRecord);
+    if (buf.empty()) {
+      return;
+    }
+    unsigned int entryLen = (buf[0] & 0x3) + 1;
+    unsigned int sizeLen = ((buf[0] >> 2) & 0x3) + 1;
+    unsigned int timestampLen = ((buf[0] >> 4) & 0x7) + 1;
+    unsigned int headerLen = 1 + entryLen + sizeLen + timestampLen;
+    if (buf.size() < headerLen) {
+      return;
+    }
+    if (!m_haveTimestamp) {
+      m_firstTimestamp =
+          ReadVarInt(buf.subspan(1 + entryLen + sizeLen, timestampLen));
+      m_haveTimestamp = true;
+    }
+    m_nextRecord += headerLen + ReadVarInt(buf.subspan(1 + entryLen, sizeLen));
+  }
+}
+
+void DataLogCompressor::WriteBlock(size_t size, std::vector<uint8_t>& out) {
+  auto data = std::span{m_pending}.subspan(0, size);
+  int64_t timestamp = m_haveTimestamp ? m_firstTimestamp : 0;
+
+  size_t pos = out.size();
+  out.resize(pos + impl::kCompressedBlockHeaderSize + LZ4CompressBound(size));
+  uint8_t* buf = out.data() + pos;
+  size_t compressedSize = LZ4Compress(
+      data, std::span{out}.subspan(pos + impl::kCompressedBlockHeaderSize));
+  if (compressedSize >= size) {
+    // incompressible; store raw
+    compressedSize = size;
+    std::memcpy(buf + impl::kCompressedBlockHeaderSize, data.data(), size);
+  }
+  out.resize(pos + impl::kCompressedBlockHeaderSize + compressedSize);
+  buf = out.data() + pos;
+  support::endian::write32le(buf, compressedSize);
+  support::endian::write32le(buf + 4, size);
+  support::endian::write64le(buf + 8, timestamp);
+
+  m_index.emplace_back(m_fileOffset, m_uncompressedOffset, timestamp);
+  m_fileOffset += impl::kCompressedBlockHeaderSize + compressedSize;
+  m_uncompressedOffset += size;
+
+  m_pending.erase(m_pending.begin(), m_pending.begin() + size);
+  m_nextRecord -= size;
+  m_lastBoundary = 0;
+  m_haveTimestamp = false;
+}
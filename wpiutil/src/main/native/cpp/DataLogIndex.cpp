@@ -0,0 +1,301 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/DataLogIndex.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include "wpi/DenseMap.h"
+#include "wpi/Endian.h"
+#include "wpi/MemoryBuffer.h"
+#include "wpi/raw_ostream.h"
+
+using namespace wpi::log;
+
+static constexpr uint8_t kMagic[8] = {'W', 'P', 'I', 'L', 'O', 'G', 'I', 'X'};
+static constexpr uint32_t kVersion = 1;
+
+DataLogIndex::DataLogIndex(const DataLogReader& reader, size_t spanSize)
+    : m_reader{&reader}, m_spanSize{spanSize} {
+  if (!reader.IsValid()) {
+    return;
+  }
+
+  // active EntryInfo (index into m_entries) for each entry ID
+  wpi::DenseMap<int, size_t> active;
+  size_t pos = 12 + reader.GetExtraHeader().size();
+  size_t spanEnd = 0;
+  DataLogRecord record;
+  for (;;) {
+    size_t recordPos = pos;
+    if (!reader.GetRecord(&pos, &record)) {
+      break;
+    }
+    m_lastRecordPos = recordPos;
+    m_endPos = pos;
+    if (recordPos >= spanEnd) {
+      m_spans.emplace_back(recordPos);
+      spanEnd = recordPos + m_spanSize;
+    }
+
+    if (record.IsStart()) {
+      StartRecordData data;
+      if (record.GetStartData(&data)) {
+        active[data.entry] = m_entries.size();
+        m_entries.emplace_back(data.entry, std::string{data.name},
+                               std::string{data.type},
+                               std::string{data.metadata}, recordPos,
+                               SIZE_MAX);
+        m_ranges.emplace_back();
+      }
+    } else if (record.IsFinish()) {
+      int entry;
+      if (record.GetFinishEntry(&entry)) {
+        auto it = active.find(entry);
+        if (it != active.end()) {
+          m_entries[it->second].finishPos = recordPos;
+          active.erase(it);
+        }
+      }
+    } else if (!record.IsControl()) {
+      auto it = active.find(record.GetEntry());
+      if (it == active.end()) {
+        continue;
+      }
+      auto& ranges = m_ranges[it->second];
+      uint32_t span = m_spans.size() - 1;
+      int64_t timestamp = record.GetTimestamp();
+      if (ranges.empty() || ranges.back().span != span) {
+        ranges.emplace_back(span, timestamp, timestamp);
+      } else {
+        auto& range = ranges.back();
+        range.minTimestamp = (std::min)(range.minTimestamp, timestamp);
+        range.maxTimestamp = (std::max)(range.maxTimestamp, timestamp);
+      }
+    }
+  }
+}
+
+std::optional<size_t> DataLogIndex::Find(std::string_view name) const {
+  for (size_t i = m_entries.size(); i > 0; --i) {
+    if (m_entries[i - 1].name == name) {
+      return i - 1;
+    }
+  }
+  return std::nullopt;
+}
+
+void DataLogIndex::ForEachRecord(
+    size_t index, int64_t start, int64_t end,
+    function_ref<void(const DataLogRecord& record)> func) const {
+  if (index >= m_entries.size()) {
+    return;
+  }
+  auto& info = m_entries[index];
+  DataLogRecord record;
+  for (auto&& range : m_ranges[index]) {
+    if (range.maxTimestamp < start || range.minTimestamp > end) {
+      continue;
+    }
+    size_t pos = (std::max)(m_spans[range.span], info.startPos);
+    size_t spanEnd = range.span + 1 < m_spans.size()
+                         ? m_spans[range.span + 1]
+                         : m_endPos;
+    spanEnd = (std::min)(spanEnd, info.finishPos);
+    while (pos < spanEnd && m_reader->GetRecord(&pos, &record)) {
+      if (record.GetEntry() == info.entry &&
+          record.GetTimestamp() >= start && record.GetTimestamp() <= end) {
+        func(record);
+      }
+    }
+  }
+}
+
+namespace {
+class Writer {
+ public:
+  explicit Writer(wpi::raw_ostream& os) : m_os{os} {}
+
+  void Write32(uint32_t val) {
+    uint8_t buf[4];
+    wpi::support::endian::write32le(buf, val);
+    m_os << std::span<const uint8_t>{buf};
+  }
+
+  void Write64(uint64_t val) {
+    uint8_t buf[8];
+    wpi::support::endian::write64le(buf, val);
+    m_os << std::span<const uint8_t>{buf};
+  }
+
+  void WriteString(std::string_view str) {
+    Write32(str.size());
+    m_os << str;
+  }
+
+ private:
+  wpi::raw_ostream& m_os;
+};
+
+class Reader {
+ public:
+  explicit Reader(std::span<const uint8_t> data) : m_data{data} {}
+
+  bool Read32(uint32_t* val) {
+    if (m_data.size() < 4) {
+      return false;
+    }
+    *val = wpi::support::endian::read32le(m_data.data());
+    m_data = m_data.subspan(4);
+    return true;
+  }
+
+  bool Read64(uint64_t* val) {
+    if (m_data.size() < 8) {
+      return false;
+    }
+    *val = wpi::support::endian::read64le(m_data.data());
+    m_data = m_data.subspan(8);
+    return true;
+  }
+
+  bool ReadString(std::string* str) {
+    uint32_t len;
+    if (!Read32(&len) || len > m_data.size()) {
+      return false;
+    }
+    str->assign(reinterpret_cast<const char*>(m_data.data()), len);
+    m_data = m_data.subspan(len);
+    return true;
+  }
+
+  bool ReadMagic() {
+    if (m_data.size() < sizeof(kMagic) ||
+        std::memcmp(m_data.data(), kMagic, sizeof(kMagic)) != 0) {
+      return false;
+    }
+    m_data = m_data.subspan(sizeof(kMagic));
+    return true;
+  }
+
+  bool empty() const { return m_data.empty(); }
+
+ private:
+  std::span<const uint8_t> m_data;
+};
+}  // namespace
+
+void DataLogIndex::Save(wpi::raw_ostream& os) const {
+  Writer w{os};
+  os << std::span<const uint8_t>{kMagic};
+  w.Write32(kVersion);
+  w.Write64(m_spanSize);
+  w.Write64(m_lastRecordPos);
+  w.Write64(m_endPos);
+  w.Write32(m_spans.size());
+  for (auto pos : m_spans) {
+    w.Write64(pos);
+  }
+  w.Write32(m_entries.size());
+  for (size_t i = 0; i < m_entries.size(); ++i) {
+    auto& info = m_entries[i];
+    w.Write32(info.entry);
+    w.WriteString(info.name);
+    w.WriteString(info.type);
+    w.WriteString(info.metadata);
+    w.Write64(info.startPos);
+    w.Write64(info.finishPos);
+    w.Write32(m_ranges[i].size());
+    for (auto&& range : m_ranges[i]) {
+      w.Write32(range.span);
+      w.Write64(range.minTimestamp);
+      w.Write64(range.maxTimestamp);
+    }
+  }
+}
+
+std::optional<DataLogIndex> DataLogIndex::Load(const DataLogReader& reader,
+                                               std::span<const uint8_t> data) {
+  Reader r{data};
+  uint32_t version;
+  uint64_t spanSize, lastRecordPos, endPos;
+  uint32_t count;
+  if (!r.ReadMagic() || !r.Read32(&version) || version != kVersion ||
+      !r.Read64(&spanSize) || !r.Read64(&lastRecordPos) ||
+      !r.Read64(&endPos) || !r.Read32(&count)) {
+    return std::nullopt;
+  }
+
+  // check the log still ends where it did when it was indexed
+  DataLogRecord record;
+  size_t pos = lastRecordPos;
+  if (!reader.IsValid() || !reader.GetRecord(&pos, &record) ||
+      pos != endPos || reader.GetRecord(&pos, &record)) {
+    return std::nullopt;
+  }
+
+  DataLogIndex index{&reader, static_cast<size_t>(spanSize)};
+  index.m_lastRecordPos = lastRecordPos;
+  index.m_endPos = endPos;
+  for (uint32_t i = 0; i < count; ++i) {
+    uint64_t spanPos;
+    if (!r.Read64(&spanPos)) {
+      return std::nullopt;
+    }
+    index.m_spans.emplace_back(spanPos);
+  }
+  if (!r.Read32(&count)) {
+    return std::nullopt;
+  }
+  for (uint32_t i = 0; i < count; ++i) {
+    uint32_t entry, numRanges;
+    uint64_t startPos, finishPos;
+    EntryInfo info;
+    if (!r.Read32(&entry) || !r.ReadString(&info.name) ||
+        !r.ReadString(&info.type) || !r.ReadString(&info.metadata) ||
+        !r.Read64(&startPos) || !r.Read64(&finishPos) ||
+        !r.Read32(&numRanges)) {
+      return std::nullopt;
+    }
+    info.entry = entry;
+    info.startPos = startPos;
+    info.finishPos = finishPos;
+    auto& ranges = index.m_ranges.emplace_back();
+    for (uint32_t j = 0; j < numRanges; ++j) {
+      uint32_t span;
+      uint64_t minTimestamp, maxTimestamp;
+      if (!r.Read32(&span) || span >= index.m_spans.size() ||
+          !r.Read64(&minTimestamp) || !r.Read64(&maxTimestamp)) {
+        return std::nullopt;
+      }
+      ranges.emplace_back(span, static_cast<int64_t>(minTimestamp),
+                          static_cast<int64_t>(maxTimestamp));
+    }
+    index.m_entries.emplace_back(std::move(info));
+  }
+  if (!r.empty()) {
+    return std::nullopt;
+  }
+  return index;
+}
+
+DataLogIndex DataLogIndex::LoadOrBuild(const DataLogReader& reader,
+                                       std::string_view filename) {
+  if (auto file = wpi::MemoryBuffer::GetFile(filename)) {
+    if (auto index = Load(reader, (*file)->GetBuffer())) {
+      return std::move(*index);
+    }
+  }
+  DataLogIndex index{reader};
+  std::error_code ec;
+  wpi::raw_fd_ostream os{filename, ec};
+  if (!ec) {
+    index.Save(os);
+  }
+  return index;
+}
@@ -4,11 +4,20 @@
 
 #include "wpi/DataLogReader.h"
 
+#include <algorithm>
 #include <bit>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <new>
 #include <utility>
+#include <vector>
 
 #include "wpi/DataLog.h"
+#include "wpi/DataLogCompressor.h"
 #include "wpi/Endian.h"
+#include "wpi/LZ4.h"
+#include "wpi/fs.h"
 
 using namespace wpi::log;
 
@@ -189,14 +198,251 @@ bool DataLogRecord::GetStringArray(std::vector<std::string_view>* arr) const {
   return true;
 }
 
+struct DataLogReader::CompressedData {
+  struct Block {
+    uint64_t fileOffset;
+    uint64_t offset;  // in uncompressed log
+    int64_t timestamp;
+  };
+
+  explicit CompressedData(std::span<const uint8_t> file);
+
+  bool ReadIndex(size_t* end);
+  void ScanBlocks(size_t end);
+  bool ReadBlockHeader(size_t pos, size_t end, uint32_t* compressedSize,
+                       uint32_t* uncompressedSize) const;
+  size_t GetBlockEnd(size_t block) const {
+    return block + 1 < blocks.size() ? blocks[block + 1].offset : size;
+  }
+  // thread-safe; different blocks are decompressed in parallel
+  bool Load(size_t block);
+  bool Decompress(size_t block);
+
+  std::span<const uint8_t> file;
+  std::vector<Block> blocks;
+  size_t size = 0;  // uncompressed size
+
+  std::unique_ptr<uint8_t[]> data;
+  std::unique_ptr<std::once_flag[]> loadOnce;
+  std::unique_ptr<bool[]> loaded;
+};
+
+DataLogReader::CompressedData::CompressedData(std::span<const uint8_t> file)
+    : file{file} {
+  size_t end = file.size();
+  if (!ReadIndex(&end)) {
+    // log wasn't closed cleanly, or the index is bad
+    blocks.clear();
+    size = 0;
+    ScanBlocks(end);
+  }
+  // not initialized; only the pages of blocks that are loaded get touched
+  data.reset(new (std::nothrow) uint8_t[size]);
+  if (!data) {
+    // no blocks makes the log invalid
+    blocks.clear();
+    size = 0;
+  }
+  loadOnce.reset(new std::once_flag[blocks.size()]);
+  loaded.reset(new bool[blocks.size()]);
+}
+
+// On failure, end is set to the start of the index if there appears to be one
+bool DataLogReader::CompressedData::ReadIndex(size_t* end) {
+  constexpr size_t kStart = sizeof(impl::kCompressedMagic);
+  if (file.size() < kStart + impl::kCompressedIndexTrailerSize) {
+    return false;
+  }
+  auto trailer = file.subspan(file.size() - impl::kCompressedIndexTrailerSize);
+  if (std::memcmp(trailer.data() + 4, impl::kCompressedIndexMagic,
+                  sizeof(impl::kCompressedIndexMagic)) != 0) {
+    return false;
+  }
+  uint32_t count = wpi::support::endian::read32le(trailer.data());
+  if (count == 0 ||
+      count > (file.size() - kStart - impl::kCompressedIndexTrailerSize) /
+                  impl::kCompressedIndexEntrySize) {
+    return false;
+  }
+  size_t indexStart = file.size() - impl::kCompressedIndexTrailerSize -
+                      count * impl::kCompressedIndexEntrySize;
+  *end = indexStart;
+
+  // the blocks are contiguous, so each index entry must match the block
+  // headers exactly
+  blocks.reserve(count);
+  const uint8_t* entry = file.data() + indexStart;
+  size_t pos = kStart;
+  for (uint32_t i = 0; i < count; ++i) {
+    Block block{wpi::support::endian::read64le(entry),
+                wpi::support::endian::read64le(entry + 8),
+                static_cast<int64_t>(
+                    wpi::support::endian::read64le(entry + 16))};
+    uint32_t compressedSize;
+    uint32_t uncompressedSize;
+    if (block.fileOffset != pos || block.offset != size ||
+        !ReadBlockHeader(pos, indexStart, &compressedSize,
+                         &uncompressedSize)) {
+      return false;
+    }
+    blocks.emplace_back(block);
+    size += uncompressedSize;
+    pos += impl::kCompressedBlockHeaderSize + compressedSize;
+    entry += impl::kCompressedIndexEntrySize;
+  }
+  return pos == indexStart;
+}
+
+// Checks that pos has a block header for a block ending by end, and that
+// the block's uncompressed size is plausible (LZ4 can't expand data more than
+// 255 times, which also caps the total size) and can be added to size
+bool DataLogReader::CompressedData::ReadBlockHeader(
+    size_t pos, size_t end, uint32_t* compressedSize,
+    uint32_t* uncompressedSize) const {
+  if (end < pos || end - pos < impl::kCompressedBlockHeaderSize) {
+    return false;
+  }
+  const uint8_t* header = file.data() + pos;
+  *compressedSize = wpi::support::endian::read32le(header);
+  *uncompressedSize = wpi::support::endian::read32le(header + 4);
+  return *compressedSize <= end - pos - impl::kCompressedBlockHeaderSize &&
+         *uncompressedSize / 256 <= *compressedSize &&
+         *uncompressedSize <= SIZE_MAX - size;
+}
+
+void DataLogReader::CompressedData::ScanBlocks(size_t end) {
+  size_t pos = sizeof(impl::kCompressedMagic);
+  uint32_t compressedSize;
+  uint32_t uncompressedSize;
+  // stops at a truncated block, or something that isn't a block header
+  while (ReadBlockHeader(pos, end, &compressedSize, &uncompressedSize)) {
+    blocks.emplace_back(
+        pos, size,
+        static_cast<int64_t>(
+            wpi::support::endian::read64le(file.data() + pos + 8)));
+    size += uncompressedSize;
+    pos += impl::kCompressedBlockHeaderSize + compressedSize;
+  }
+}
+
+bool DataLogReader::CompressedData::Load(size_t block) {
+  std::call_once(loadOnce[block], [&] { loaded[block] = Decompress(block); });
+  return loaded[block];
+}
+
+bool DataLogReader::CompressedData::Decompress(size_t block) {
+  auto& info = blocks[block];
+  const uint8_t* header = file.data() + info.fileOffset;
+  uint32_t compressedSize = wpi::support::endian::read32le(header);
+  uint32_t uncompressedSize = wpi::support::endian::read32le(header + 4);
+  if (uncompressedSize != GetBlockEnd(block) - info.offset ||
+      compressedSize >
+          file.size() - info.fileOffset - impl::kCompressedBlockHeaderSize) {
+    return false;
+  }
+  auto in = file.subspan(info.fileOffset + impl::kCompressedBlockHeaderSize,
+                         compressedSize);
+  std::span<uint8_t> out{data.get() + info.offset, uncompressedSize};
+  if (compressedSize == uncompressedSize) {
+    std::memcpy(out.data(), in.data(), in.size());
+  } else if (!wpi::LZ4Decompress(in, out)) {
+    return false;
+  }
+  return true;
+}
+
 DataLogReader::DataLogReader(std::unique_ptr<MemoryBuffer> buffer)
-    : m_buf{std::move(buffer)} {}
+    : m_buf{std::move(buffer)} {
+  Init();
+}
+
+DataLogReader::DataLogReader(std::string_view filename, std::error_code& ec) {
+  fs::file_t f = fs::OpenFileForRead(fs::path{filename}, ec);
+  if (ec) {
+    return;
+  }
+  uint64_t size = fs::file_size(fs::path{filename}, ec);
+  if (!ec && size > 0) {
+    m_mapping = MappedFileRegion{f, size, 0, MappedFileRegion::kReadOnly, ec};
+  }
+  fs::CloseFile(f);
+  if (ec) {
+    m_mapping = {};
+    return;
+  }
+  // the memory buffer only references the mapping
+  m_buf = MemoryBuffer::GetMemBuffer({m_mapping.const_data(), size}, filename);
+  Init();
+}
+
+void DataLogReader::Init() {
+  if (!m_buf) {
+    return;
+  }
+  auto buf = m_buf->GetBuffer();
+  if (buf.size() >= sizeof(impl::kCompressedMagic) &&
+      std::memcmp(buf.data(), impl::kCompressedMagic,
+                  sizeof(impl::kCompressedMagic)) == 0) {
+    m_compressed = std::make_unique<CompressedData>(buf);
+  }
+}
+
+DataLogReader::~DataLogReader() = default;
+
+DataLogReader::DataLogReader(DataLogReader&&) = default;
+
+DataLogReader& DataLogReader::operator=(DataLogReader&&) = default;
+
+std::span<const uint8_t> DataLogReader::GetBuffer(size_t pos) const {
+  if (!m_compressed) {
+    return m_buf->GetBuffer();
+  }
+  auto& blocks = m_compressed->blocks;
+  auto it = std::upper_bound(
+      blocks.begin(), blocks.end(), pos,
+      [](size_t pos, const auto& block) { return pos < block.offset; });
+  if (it == blocks.begin()) {
+    return {};
+  }
+  size_t block = it - blocks.begin() - 1;
+
+  if (!m_compressed->Load(block)) {
+    return {m_compressed->data.get(), blocks[block].offset};
+  }
+  // also load the next block, so a record ending at the end of this block
+  // isn't mistaken for the last record in the log
+  if (block + 1 < blocks.size() && m_compressed->Load(block + 1)) {
+    ++block;
+  }
+  return {m_compressed->data.get(), m_compressed->GetBlockEnd(block)};
+}
+
+size_t DataLogReader::GetBlockCount() const {
+  return m_compressed ? m_compressed->blocks.size() : 0;
+}
+
+int64_t DataLogReader::GetBlockTimestamp(size_t block) const {
+  if (block >= GetBlockCount()) {
+    return 0;
+  }
+  return m_compressed->blocks[block].timestamp;
+}
+
+DataLogReader::iterator DataLogReader::BlockBegin(size_t block) const {
+  if (block == 0) {
+    return begin();  // skip the file header
+  }
+  if (block >= GetBlockCount()) {
+    return end();
+  }
+  return DataLogIterator{this, m_compressed->blocks[block].offset};
+}
 
 bool DataLogReader::IsValid() const {
   if (!m_buf) {
     return false;
   }
-  auto buf = m_buf->GetBuffer();
+  auto buf = GetBuffer(0);
   return buf.size() >= 12 &&
          std::string_view{reinterpret_cast<const char*>(buf.data()), 6} ==
              "WPILOG" &&
@@ -207,7 +453,7 @@ uint16_t DataLogReader::GetVersion() const {
   if (!m_buf) {
     return 0;
   }
-  auto buf = m_buf->GetBuffer();
+  auto buf = GetBuffer(0);
   if (buf.size() < 12) {
     return 0;
   }
@@ -218,7 +464,7 @@ std::string_view DataLogReader::GetExtraHeader() const {
   if (!m_buf) {
     return {};
   }
-  auto buf = m_buf->GetBuffer();
+  auto buf = GetBuffer(0);
   if (buf.size() < 8) {
     return {};
   }
@@ -232,7 +478,7 @@ DataLogReader::iterator DataLogReader::begin() const {
   if (!m_buf) {
     return end();
   }
-  auto buf = m_buf->GetBuffer();
+  auto buf = GetBuffer(0);
   if (buf.size() < 12) {
     return end();
   }
@@ -257,7 +503,7 @@ bool DataLogReader::GetRecord(size_t* pos, DataLogRecord* out) const {
   if (!m_buf) {
     return false;
   }
-  auto buf = m_buf->GetBuffer();
+  auto buf = GetBuffer(*pos);
   if (*pos >= buf.size()) {
     return false;
   }
@@ -288,7 +534,7 @@ bool DataLogReader::GetNextRecord(size_t* pos) const {
   if (!m_buf) {
     return false;
   }
-  auto buf = m_buf->GetBuffer();
+  auto buf = GetBuffer(*pos);
   if (buf.size() < (*pos + 4)) {  // minimum header length
     return false;
   }
@@ -0,0 +1,310 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/DataLogSeries.h"
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "wpi/DenseMap.h"
+#include "wpi/leb128.h"
+
+using namespace wpi::log;
+
+class DataLogSeries::Strings {
+ public:
+  uint32_t Intern(std::string_view str) {
+    auto [it, isNew] = m_indexes.try_emplace(str, m_values.size());
+    if (isNew) {
+      m_values.emplace_back(it->first);
+    }
+    return it->second;
+  }
+
+  std::string_view Get(uint32_t index) const { return m_values[index]; }
+
+ private:
+  wpi::StringMap<uint32_t> m_indexes;
+  std::vector<std::string_view> m_values;  // keys of m_indexes
+};
+
+// Reorders values by a permutation
+template <typename T>
+static void Permute(std::vector<T>& values, std::span<const size_t> order) {
+  if (values.empty()) {
+    return;
+  }
+  std::vector<T> sorted;
+  sorted.reserve(values.size());
+  for (size_t i : order) {
+    sorted.emplace_back(values[i]);
+  }
+  values = std::move(sorted);
+}
+
+DataLogSeries::DataLogSeries(const DataLogReader& reader)
+    : m_strings{std::make_unique<Strings>()} {
+  // series index for each active entry ID
+  wpi::DenseMap<int, size_t> active;
+  // timestamps of each series, in log order
+  std::vector<std::vector<int64_t>> timestamps;
+
+  for (auto&& record : reader) {
+    if (record.IsStart()) {
+      StartRecordData data;
+      if (!record.GetStartData(&data)) {
+        continue;
+      }
+      Type type;
+      if (data.type == "boolean") {
+        type = kBoolean;
+      } else if (data.type == "int64") {
+        type = kInteger;
+      } else if (data.type == "float") {
+        type = kFloat;
+      } else if (data.type == "double") {
+        type = kDouble;
+      } else if (data.type == "string") {
+        type = kString;
+      } else {
+        active.erase(data.entry);
+        continue;
+      }
+      auto [it, isNew] = m_seriesByName.try_emplace(data.name, m_series.size());
+      if (isNew) {
+        auto& series = m_series.emplace_back();
+        series.m_name = data.name;
+        series.m_typeStr = data.type;
+        series.m_type = type;
+        series.m_stringTable = m_strings.get();
+        timestamps.emplace_back();
+      } else if (m_series[it->second].m_type != type) {
+        // a series has a single type
+        active.erase(data.entry);
+        continue;
+      }
+      active[data.entry] = it->second;
+    } else if (record.IsFinish()) {
+      int entry;
+      if (record.GetFinishEntry(&entry)) {
+        active.erase(entry);
+      }
+    } else if (!record.IsControl()) {
+      auto it = active.find(record.GetEntry());
+      if (it == active.end()) {
+        continue;
+      }
+      auto& series = m_series[it->second];
+      bool ok = false;
+      switch (series.m_type) {
+        case kBoolean: {
+          bool value;
+          if ((ok = record.GetBoolean(&value))) {
+            series.m_booleans.emplace_back(value);
+          }
+          break;
+        }
+        case kInteger: {
+          int64_t value;
+          if ((ok = record.GetInteger(&value))) {
+            series.m_integers.emplace_back(value);
+          }
+          break;
+        }
+        case kFloat: {
+          float value;
+          if ((ok = record.GetFloat(&value))) {
+            series.m_floats.emplace_back(value);
+          }
+          break;
+        }
+        case kDouble: {
+          double value;
+          if ((ok = record.GetDouble(&value))) {
+            series.m_doubles.emplace_back(value);
+          }
+          break;
+        }
+        case kString: {
+          std::string_view value;
+          if ((ok = record.GetString(&value))) {
+            series.m_strings.emplace_back(m_strings->Intern(value));
+          }
+          break;
+        }
+      }
+      if (ok) {
+        timestamps[it->second].emplace_back(record.GetTimestamp());
+      }
+    }
+  }
+
+  for (size_t i = 0; i < m_series.size(); ++i) {
+    auto& series = m_series[i];
+    auto& ts = timestamps[i];
+
+    // records are usually already in timestamp order
+    if (!std::is_sorted(ts.begin(), ts.end())) {
+      std::vector<size_t> order(ts.size());
+      std::iota(order.begin(), order.end(), 0);
+      std::stable_sort(order.begin(), order.end(),
+                       [&](size_t a, size_t b) { return ts[a] < ts[b]; });
+      Permute(ts, order);
+      Permute(series.m_booleans, order);
+      Permute(series.m_integers, order);
+      Permute(series.m_floats, order);
+      Permute(series.m_doubles, order);
+      Permute(series.m_strings, order);
+    }
+
+    series.m_size = ts.size();
+    series.m_blockTimestamps.reserve((ts.size() + Series::kBlockSize - 1) /
+                                     Series::kBlockSize);
+    series.m_blockOffsets.reserve(series.m_blockTimestamps.capacity());
+    size_t deltasSize = 0;
+    for (size_t j = 1; j < ts.size(); ++j) {
+      deltasSize += wpi::SizeUleb128(ts[j] - ts[j - 1]);
+    }
+    series.m_deltas.reserve(deltasSize);
+    for (size_t j = 0; j < ts.size(); ++j) {
+      if (j % Series::kBlockSize == 0) {
+        series.m_blockTimestamps.emplace_back(ts[j]);
+        series.m_blockOffsets.emplace_back(series.m_deltas.size());
+      } else {
+        wpi::WriteUleb128(series.m_deltas, ts[j] - ts[j - 1]);
+      }
+    }
+    series.m_booleans.shrink_to_fit();
+    series.m_integers.shrink_to_fit();
+    series.m_floats.shrink_to_fit();
+    series.m_doubles.shrink_to_fit();
+    series.m_strings.shrink_to_fit();
+  }
+}
+
+DataLogSeries::~DataLogSeries() = default;
+
+DataLogSeries::DataLogSeries(DataLogSeries&&) = default;
+
+DataLogSeries& DataLogSeries::operator=(DataLogSeries&&) = default;
+
+const DataLogSeries::Series* DataLogSeries::Find(std::string_view name) const {
+  auto it = m_seriesByName.find(name);
+  if (it == m_seriesByName.end()) {
+    return nullptr;
+  }
+  return &m_series[it->second];
+}
+
+int64_t DataLogSeries::Series::GetTimestamp(size_t index) const {
+  size_t block = index / kBlockSize;
+  int64_t timestamp = m_blockTimestamps[block];
+  const char* delta = m_deltas.data() + m_blockOffsets[block];
+  for (size_t i = block * kBlockSize; i < index; ++i) {
+    uint64_t value;
+    delta += wpi::ReadUleb128(delta, &value);
+    timestamp += value;
+  }
+  return timestamp;
+}
+
+double DataLogSeries::Series::GetDouble(size_t index) const {
+  switch (m_type) {
+    case kBoolean:
+      return m_booleans[index];
+    case kInteger:
+      return m_integers[index];
+    case kFloat:
+      return m_floats[index];
+    case kDouble:
+      return m_doubles[index];
+    default:
+      return 0;
+  }
+}
+
+std::string_view DataLogSeries::Series::GetString(size_t index) const {
+  if (m_type != kString) {
+    return {};
+  }
+  return m_stringTable->Get(m_strings[index]);
+}
+
+size_t DataLogSeries::Series::LowerBound(int64_t timestamp) const {
+  // the answer is in the block before the first block starting at or after
+  // the timestamp
+  size_t block =
+      std::lower_bound(m_blockTimestamps.begin(), m_blockTimestamps.end(),
+                       timestamp) -
+      m_blockTimestamps.begin();
+  if (block == 0) {
+    return 0;
+  }
+  --block;
+  size_t index = block * kBlockSize;
+  size_t end = (std::min)(index + kBlockSize, m_size);
+  int64_t sampleTimestamp = m_blockTimestamps[block];
+  const char* delta = m_deltas.data() + m_blockOffsets[block];
+  while (sampleTimestamp < timestamp && ++index < end) {
+    uint64_t value;
+    delta += wpi::ReadUleb128(delta, &value);
+    sampleTimestamp += value;
+  }
+  return index;
+}
+
+void DataLogSeries::Series::ForEach(
+    int64_t start, int64_t end,
+    function_ref<void(size_t index, int64_t timestamp)> func) const {
+  size_t first = LowerBound(start);
+  if (first >= m_size) {
+    return;
+  }
+  // deltas of consecutive blocks are contiguous, and the first sample of each
+  // block has none
+  size_t block = first / kBlockSize;
+  int64_t timestamp = 0;
+  const char* delta = m_deltas.data() + m_blockOffsets[block];
+  for (size_t i = block * kBlockSize; i < m_size; ++i) {
+    if (i % kBlockSize == 0) {
+      timestamp = m_blockTimestamps[i / kBlockSize];
+    } else {
+      uint64_t value;
+      delta += wpi::ReadUleb128(delta, &value);
+      timestamp += value;
+    }
+    if (timestamp > end) {
+      break;
+    }
+    if (i >= first) {
+      func(i, timestamp);
+    }
+  }
+}
+
+std::vector<DataLogSeries::MinMax> DataLogSeries::Series::Decimate(
+    int64_t start, int64_t end, size_t buckets) const {
+  std::vector<MinMax> rv;
+  if (buckets == 0 || end < start || m_type == kString) {
+    return rv;
+  }
+  double bucketWidth = (static_cast<double>(end - start) + 1) / buckets;
+  size_t lastBucket = SIZE_MAX;
+  ForEach(start, end, [&](size_t index, int64_t timestamp) {
+    size_t bucket = (std::min)(
+        static_cast<size_t>((timestamp - start) / bucketWidth), buckets - 1);
+    double value = GetDouble(index);
+    if (bucket != lastBucket) {
+      rv.emplace_back(timestamp, value, value);
+      lastBucket = bucket;
+    } else {
+      rv.back().min = (std::min)(rv.back().min, value);
+      rv.back().max = (std::max)(rv.back().max, value);
+    }
+  });
+  return rv;
+}
@@ -0,0 +1,805 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/Deflate.h"
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <queue>
+#include <utility>
+
+using namespace wpi;
+
+namespace {
+
+constexpr uint16_t kLengthBase[29] = {
+    3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+    31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+constexpr uint8_t kLengthExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1,
+                                      1, 1, 2, 2, 2, 2, 3, 3, 3, 3,
+                                      4, 4, 4, 4, 5, 5, 5, 5, 0};
+constexpr uint16_t kDistanceBase[30] = {
+    1,   2,   3,   4,   5,   7,    9,    13,   17,   25,   33,   49,   65,
+    97,  129, 193, 257, 385, 513,  769,  1025, 1537, 2049, 3073, 4097, 6145,
+    8193, 12289, 16385, 24577};
+constexpr uint8_t kDistanceExtra[30] = {0, 0, 0,  0,  1,  1,  2,  2,  3,  3,
+                                        4, 4, 5,  5,  6,  6,  7,  7,  8,  8,
+                                        9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+// order in which code length code lengths are stored
+constexpr uint8_t kCodeLengthOrder[19] = {16, 17, 18, 0, 8,  7, 9,  6, 10, 5,
+                                          11, 4,  12, 3, 13, 2, 14, 1, 15};
+
+constexpr int kNumLitLen = 286;
+constexpr int kNumDistance = 30;
+constexpr int kNumCodeLength = 19;
+constexpr int kEndOfBlock = 256;
+constexpr int kMaxBits = 15;
+constexpr int kMaxCodeLengthBits = 7;
+constexpr size_t kMinMatch = 3;
+constexpr size_t kMaxMatch = 258;
+constexpr size_t kMaxStored = 65535;
+constexpr size_t kMaxWindow = 32768;
+
+// symbols per block; blocks are ended early so their codes follow the data
+constexpr size_t kBlockSymbols = 16384;
+// candidates compared per match search
+constexpr int kMaxChain = 48;
+// matches at least this long are taken without searching further
+constexpr size_t kNiceMatch = 128;
+// matches at least this long are taken without checking the next position
+constexpr size_t kLazyMatch = 32;
+
+int LengthCode(size_t length) {
+  return std::upper_bound(std::begin(kLengthBase), std::end(kLengthBase),
+                          length) -
+         std::begin(kLengthBase) - 1;
+}
+
+int DistanceCode(size_t distance) {
+  return std::upper_bound(std::begin(kDistanceBase), std::end(kDistanceBase),
+                          distance) -
+         std::begin(kDistanceBase) - 1;
+}
+
+// Computes Huffman code lengths no longer than maxBits for the given symbol
+// frequencies. At least two symbols always get a code, as some decoders reject
+// codes with only one.
+void BuildLengths(std::span<const uint32_t> freqs, std::span<uint8_t> lengths,
+                  int maxBits) {
+  std::vector<uint32_t> f(freqs.begin(), freqs.end());
+  int used = std::count_if(f.begin(), f.end(), [](auto v) { return v != 0; });
+  for (size_t i = 0; used < 2 && i < f.size(); ++i) {
+    if (f[i] == 0) {
+      f[i] = 1;
+      ++used;
+    }
+  }
+
+  size_t n = f.size();
+  std::vector<int> parent(2 * n);
+  for (;;) {
+    using Node = std::pair<uint64_t, int>;
+    std::priority_queue<Node, std::vector<Node>, std::greater<Node>> queue;
+    for (size_t i = 0; i < n; ++i) {
+      if (f[i] != 0) {
+        queue.emplace(f[i], i);
+      }
+    }
+    int next = n;
+    while (queue.size() > 1) {
+      auto [w1, n1] = queue.top();
+      queue.pop();
+      auto [w2, n2] = queue.top();
+      queue.pop();
+      parent[n1] = next;
+      parent[n2] = next;
+      queue.emplace(w1 + w2, next++);
+    }
+    int root = queue.top().second;
+
+    // internal nodes are created after their children, so depths can be
+    // computed from the root down
+    std::vector<uint8_t> depth(next);
+    for (int i = next - 1; i >= static_cast<int>(n); --i) {
+      depth[i] = i == root ? 0 : depth[parent[i]] + 1;
+    }
+    int maxDepth = 0;
+    for (size_t i = 0; i < n; ++i) {
+      lengths[i] = f[i] == 0 ? 0 : depth[parent[i]] + 1;
+      maxDepth = std::max<int>(maxDepth, lengths[i]);
+    }
+    if (maxDepth <= maxBits) {
+      return;
+    }
+
+    // flatten the distribution and retry
+    for (auto& v : f) {
+      if (v != 0) {
+        v = (v >> 1) | 1;
+      }
+    }
+  }
+}
+
+// Computes canonical codes from code lengths, bit reversed as DEFLATE writes
+// Huffman codes starting from the most significant bit.
+void BuildCodes(std::span<const uint8_t> lengths, std::span<uint16_t> codes) {
+  uint16_t count[kMaxBits + 1] = {};
+  for (auto len : lengths) {
+    ++count[len];
+  }
+  count[0] = 0;
+  uint16_t next[kMaxBits + 1] = {};
+  uint16_t code = 0;
+  for (int bits = 1; bits <= kMaxBits; ++bits) {
+    code = (code + count[bits - 1]) << 1;
+    next[bits] = code;
+  }
+  for (size_t i = 0; i < lengths.size(); ++i) {
+    int len = lengths[i];
+    if (len != 0) {
+      uint16_t c = next[len]++;
+      uint16_t reversed = 0;
+      for (int bit = 0; bit < len; ++bit) {
+        reversed = (reversed << 1) | ((c >> bit) & 1);
+      }
+      codes[i] = reversed;
+    }
+  }
+}
+
+// code length code symbol, with the repeat count for symbols 16-18
+struct CodeLengthSymbol {
+  uint8_t symbol;
+  uint8_t extra;
+};
+
+// Run length encodes code lengths with code length symbols 0-18
+void EncodeCodeLengths(std::span<const uint8_t> lengths,
+                       std::vector<CodeLengthSymbol>& out) {
+  for (size_t i = 0; i < lengths.size();) {
+    uint8_t len = lengths[i];
+    size_t run = 1;
+    while (i + run < lengths.size() && lengths[i + run] == len) {
+      ++run;
+    }
+    i += run;
+    if (len == 0) {
+      while (run >= 11) {
+        size_t n = std::min<size_t>(run, 138);
+        out.push_back({18, static_cast<uint8_t>(n - 11)});
+        run -= n;
+      }
+      if (run >= 3) {
+        out.push_back({17, static_cast<uint8_t>(run - 3)});
+        run = 0;
+      }
+    } else {
+      out.push_back({len, 0});
+      --run;
+      while (run >= 3) {
+        size_t n = std::min<size_t>(run, 6);
+        out.push_back({16, static_cast<uint8_t>(n - 3)});
+        run -= n;
+      }
+    }
+    for (; run > 0; --run) {
+      out.push_back({len, 0});
+    }
+  }
+}
+
+constexpr uint8_t kCodeLengthExtra[kNumCodeLength] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 3, 7};
+
+inline uint32_t Hash(const uint8_t* p, int bits) {
+  uint32_t v = (p[0] << 16) | (p[1] << 8) | p[2];
+  return (v * 2654435761u) >> (32 - bits);
+}
+
+}  // namespace
+
+DeflateCompressor::DeflateCompressor(int windowBits)
+    : m_windowBits{std::clamp(windowBits, 8, 15)} {}
+
+void DeflateCompressor::Compress(std::span<const uint8_t> in,
+                                 std::vector<uint8_t>& out) {
+  m_out = &out;
+  m_bitBuf = 0;
+  m_bitCount = 0;
+  m_symbols.clear();
+  m_blockStart = 0;
+  m_blockEnd = 0;
+
+  if (in.size() >= kMinMatch) {
+    // size the tables for the input so short messages are cheap
+    size_t window = size_t{1} << m_windowBits;
+    m_hashBits = std::clamp<int>(std::bit_width(in.size()), 8, 15);
+    m_head.assign(size_t{1} << m_hashBits, 0);
+    size_t prevSize = std::bit_ceil(std::min(in.size(), window));
+    if (m_prev.size() < prevSize) {
+      m_prev.resize(prevSize);
+    }
+    m_prevMask = prevSize - 1;
+    Match(in);
+  } else {
+    for (size_t i = 0; i < in.size(); ++i) {
+      AddSymbol(in, {in[i], 0}, 1);
+    }
+  }
+  if (!m_symbols.empty()) {
+    WriteBlock(in);
+  }
+
+  // empty stored block
+  m_bitCount += 3;
+  m_bitCount = (m_bitCount + 7) & ~7;
+  while (m_bitCount > 0) {
+    out.push_back(m_bitBuf & 0xff);
+    m_bitBuf >>= 8;
+    m_bitCount -= 8;
+  }
+  m_bitCount = 0;
+  out.insert(out.end(), {0x00, 0x00, 0xff, 0xff});
+  m_out = nullptr;
+}
+
+void DeflateCompressor::Match(std::span<const uint8_t> in) {
+  // lazy matching: a match is only taken if the next position doesn't start
+  // a longer one
+  size_t prevLength = 0;
+  size_t prevDistance = 0;
+  bool havePrev = false;
+  size_t i = 0;
+  while (i < in.size()) {
+    size_t length = 0;
+    size_t distance = 0;
+    if (i + kMinMatch <= in.size()) {
+      if (!havePrev || prevLength < kLazyMatch) {
+        length = FindMatch(in, i, &distance);
+      }
+      Insert(in, i);
+    }
+
+    if (havePrev && prevLength >= kMinMatch && length <= prevLength) {
+      AddSymbol(in,
+                {static_cast<uint16_t>(prevLength),
+                 static_cast<uint16_t>(prevDistance)},
+                prevLength);
+      // i - 1 and i are already in the tables
+      size_t end = i - 1 + prevLength;
+      for (size_t p = i + 1; p < end && p + kMinMatch <= in.size(); ++p) {
+        Insert(in, p);
+      }
+      i = end;
+      havePrev = false;
+      continue;
+    }
+    if (havePrev) {
+      AddSymbol(in, {in[i - 1], 0}, 1);
+    }
+    havePrev = true;
+    prevLength = length;
+    prevDistance = distance;
+    ++i;
+  }
+  if (havePrev) {
+    if (prevLength >= kMinMatch) {
+      AddSymbol(in,
+                {static_cast<uint16_t>(prevLength),
+                 static_cast<uint16_t>(prevDistance)},
+                prevLength);
+    } else {
+      AddSymbol(in, {in.back(), 0}, 1);
+    }
+  }
+}
+
+void DeflateCompressor::Insert(std::span<const uint8_t> in, size_t pos) {
+  auto& head = m_head[Hash(&in[pos], m_hashBits)];
+  m_prev[pos & m_prevMask] = head;
+  head = pos + 1;
+}
+
+size_t DeflateCompressor::FindMatch(std::span<const uint8_t> in, size_t pos,
+                                    size_t* distance) {
+  size_t maxDistance = std::min<size_t>(size_t{1} << m_windowBits, kMaxWindow);
+  size_t maxLength = std::min(kMaxMatch, in.size() - pos);
+  size_t best = 0;
+  const uint8_t* cur = &in[pos];
+  uint32_t candidate = m_head[Hash(cur, m_hashBits)];
+  for (int chain = 0; chain < kMaxChain && candidate != 0; ++chain) {
+    size_t cand = candidate - 1;
+    if (cand >= pos || pos - cand > maxDistance) {
+      break;
+    }
+    const uint8_t* match = &in[cand];
+    if (match[best] == cur[best] && match[0] == cur[0]) {
+      size_t len = 0;
+      while (len < maxLength && match[len] == cur[len]) {
+        ++len;
+      }
+      if (len > best) {
+        best = len;
+        *distance = pos - cand;
+        if (len >= kNiceMatch || len == maxLength) {
+          break;
+        }
+      }
+    }
+    uint32_t next = m_prev[cand & m_prevMask];
+    // entries overwritten by newer positions end the chain
+    if (next >= candidate) {
+      break;
+    }
+    candidate = next;
+  }
+  return best >= kMinMatch ? best : 0;
+}
+
+void DeflateCompressor::AddSymbol(std::span<const uint8_t> in, Symbol symbol,
+                                  size_t length) {
+  m_symbols.push_back(symbol);
+  m_blockEnd += length;
+  if (m_symbols.size() >= kBlockSymbols) {
+    WriteBlock(in);
+  }
+}
+
+void DeflateCompressor::WriteBlock(std::span<const uint8_t> in) {
+  auto writeBits = [&](uint32_t bits, int count) {
+    m_bitBuf |= static_cast<uint64_t>(bits) << m_bitCount;
+    m_bitCount += count;
+    while (m_bitCount >= 8) {
+      m_out->push_back(m_bitBuf & 0xff);
+      m_bitBuf >>= 8;
+      m_bitCount -= 8;
+    }
+  };
+
+  uint32_t litFreq[kNumLitLen] = {};
+  uint32_t distFreq[kNumDistance] = {};
+  for (auto&& sym : m_symbols) {
+    if (sym.distance == 0) {
+      ++litFreq[sym.value];
+    } else {
+      ++litFreq[257 + LengthCode(sym.value)];
+      ++distFreq[DistanceCode(sym.distance)];
+    }
+  }
+  litFreq[kEndOfBlock] = 1;
+
+  uint8_t litLengths[kNumLitLen];
+  uint8_t distLengths[kNumDistance];
+  BuildLengths(litFreq, litLengths, kMaxBits);
+  BuildLengths(distFreq, distLengths, kMaxBits);
+
+  int numLit = kNumLitLen;
+  while (numLit > 257 && litLengths[numLit - 1] == 0) {
+    --numLit;
+  }
+  int numDist = kNumDistance;
+  while (numDist > 1 && distLengths[numDist - 1] == 0) {
+    --numDist;
+  }
+  uint8_t allLengths[kNumLitLen + kNumDistance];
+  std::copy_n(litLengths, numLit, allLengths);
+  std::copy_n(distLengths, numDist, allLengths + numLit);
+  std::vector<CodeLengthSymbol> clSymbols;
+  EncodeCodeLengths({allLengths, static_cast<size_t>(numLit + numDist)},
+                    clSymbols);
+  uint32_t clFreq[kNumCodeLength] = {};
+  for (auto&& sym : clSymbols) {
+    ++clFreq[sym.symbol];
+  }
+  uint8_t clLengths[kNumCodeLength];
+  BuildLengths(clFreq, clLengths, kMaxCodeLengthBits);
+  int numCl = kNumCodeLength;
+  while (numCl > 4 && clLengths[kCodeLengthOrder[numCl - 1]] == 0) {
+    --numCl;
+  }
+
+  uint8_t fixedLitLengths[288];
+  std::fill_n(fixedLitLengths, 144, 8);
+  std::fill_n(fixedLitLengths + 144, 112, 9);
+  std::fill_n(fixedLitLengths + 256, 24, 7);
+  std::fill_n(fixedLitLengths + 280, 8, 8);
+
+  // compare the sizes of the block with each encoding
+  size_t dynamicBits = 3 + 14 + 3 * numCl;
+  for (auto&& sym : clSymbols) {
+    dynamicBits += clLengths[sym.symbol] + kCodeLengthExtra[sym.symbol];
+  }
+  size_t fixedBits = 3;
+  for (int i = 0; i < kNumLitLen; ++i) {
+    dynamicBits += static_cast<size_t>(litFreq[i]) * litLengths[i];
+    fixedBits += static_cast<size_t>(litFreq[i]) * fixedLitLengths[i];
+    if (i > kEndOfBlock) {
+      size_t extra = static_cast<size_t>(litFreq[i]) * kLengthExtra[i - 257];
+      dynamicBits += extra;
+      fixedBits += extra;
+    }
+  }
+  for (int i = 0; i < kNumDistance; ++i) {
+    size_t extra = static_cast<size_t>(distFreq[i]) * kDistanceExtra[i];
+    dynamicBits += distFreq[i] * distLengths[i] + extra;
+    fixedBits += distFreq[i] * 5 + extra;
+  }
+  size_t storedSize = m_blockEnd - m_blockStart;
+  size_t storedBits =
+      (storedSize + (kMaxStored - 1)) / kMaxStored * (3 + 7 + 32) +
+      storedSize * 8;
+
+  if (storedBits < dynamicBits && storedBits < fixedBits) {
+    auto data = in.subspan(m_blockStart, storedSize);
+    while (!data.empty()) {
+      size_t len = std::min(data.size(), kMaxStored);
+      writeBits(0, 3);
+      if (m_bitCount > 0) {
+        writeBits(0, 8 - m_bitCount);
+      }
+      writeBits(len, 16);
+      writeBits(len ^ 0xffff, 16);
+      m_out->insert(m_out->end(), data.begin(), data.begin() + len);
+      data = data.subspan(len);
+    }
+  } else {
+    uint16_t litCodes[288] = {};
+    uint16_t distCodes[kNumDistance] = {};
+    const uint8_t* litLen = litLengths;
+    const uint8_t* distLen = distLengths;
+    uint8_t fixedDistLengths[kNumDistance];
+    if (fixedBits <= dynamicBits) {
+      std::fill_n(fixedDistLengths, kNumDistance, 5);
+      litLen = fixedLitLengths;
+      distLen = fixedDistLengths;
+      BuildCodes(fixedLitLengths, litCodes);
+      BuildCodes(fixedDistLengths, distCodes);
+      writeBits(1 << 1, 3);
+    } else {
+      BuildCodes({litLengths, kNumLitLen}, litCodes);
+      BuildCodes(distLengths, distCodes);
+      uint16_t clCodes[kNumCodeLength] = {};
+      BuildCodes(clLengths, clCodes);
+      writeBits(2 << 1, 3);
+      writeBits(numLit - 257, 5);
+      writeBits(numDist - 1, 5);
+      writeBits(numCl - 4, 4);
+      for (int i = 0; i < numCl; ++i) {
+        writeBits(clLengths[kCodeLengthOrder[i]], 3);
+      }
+      for (auto&& sym : clSymbols) {
+        writeBits(clCodes[sym.symbol], clLengths[sym.symbol]);
+        writeBits(sym.extra, kCodeLengthExtra[sym.symbol]);
+      }
+    }
+
+    for (auto&& sym : m_symbols) {
+      if (sym.distance == 0) {
+        writeBits(litCodes[sym.value], litLen[sym.value]);
+      } else {
+        int lc = LengthCode(sym.value);
+        writeBits(litCodes[257 + lc], litLen[257 + lc]);
+        writeBits(sym.value - kLengthBase[lc], kLengthExtra[lc]);
+        int dc = DistanceCode(sym.distance);
+        writeBits(distCodes[dc], distLen[dc]);
+        writeBits(sym.distance - kDistanceBase[dc], kDistanceExtra[dc]);
+      }
+    }
+    writeBits(litCodes[kEndOfBlock], litLen[kEndOfBlock]);
+  }
+
+  m_symbols.clear();
+  m_blockStart = m_blockEnd;
+}
+
+namespace {
+
+// canonical Huffman decoding table
+struct Huffman {
+  uint16_t count[kMaxBits + 1];  // number of codes of each length
+  uint16_t symbol[288];          // symbols ordered by code
+};
+
+// Builds a decoding table from code lengths. Returns 0 for a complete code,
+// a positive number for an incomplete code, and a negative number for an
+// oversubscribed one.
+int BuildHuffman(Huffman& h, std::span<const uint8_t> lengths) {
+  std::fill(std::begin(h.count), std::end(h.count), 0);
+  for (auto len : lengths) {
+    ++h.count[len];
+  }
+  if (h.count[0] == lengths.size()) {
+    return 0;
+  }
+  int left = 1;
+  for (int len = 1; len <= kMaxBits; ++len) {
+    left <<= 1;
+    left -= h.count[len];
+    if (left < 0) {
+      return left;
+    }
+  }
+  uint16_t offs[kMaxBits + 1];
+  offs[1] = 0;
+  for (int len = 1; len < kMaxBits; ++len) {
+    offs[len + 1] = offs[len] + h.count[len];
+  }
+  for (size_t i = 0; i < lengths.size(); ++i) {
+    if (lengths[i] != 0) {
+      h.symbol[offs[lengths[i]]++] = i;
+    }
+  }
+  return left;
+}
+
+class BitReader {
+ public:
+  explicit BitReader(std::span<const uint8_t> in) : m_in{in} {}
+
+  // Returns false if the input runs out
+  bool Bits(int count, int* out) {
+    while (m_bitCount < count) {
+      if (m_pos == m_in.size()) {
+        return false;
+      }
+      m_bitBuf |= static_cast<uint32_t>(m_in[m_pos++]) << m_bitCount;
+      m_bitCount += 8;
+    }
+    *out = m_bitBuf & ((1u << count) - 1);
+    m_bitBuf >>= count;
+    m_bitCount -= count;
+    return true;
+  }
+
+  // Returns the decoded symbol, or -1 for running out or an invalid code
+  int Decode(const Huffman& h) {
+    int code = 0;
+    int first = 0;
+    int index = 0;
+    for (int len = 1; len <= kMaxBits; ++len) {
+      int bit;
+      if (!Bits(1, &bit)) {
+        return -1;
+      }
+      code |= bit;
+      int count = h.count[len];
+      if (code - count < first) {
+        return h.symbol[index + (code - first)];
+      }
+      index += count;
+      first += count;
+      first <<= 1;
+      code <<= 1;
+    }
+    return -1;
+  }
+
+  void AlignToByte() {
+    m_bitBuf = 0;
+    m_bitCount = 0;
+  }
+
+  // true when only padding bits of the last byte are left
+  bool AtEnd() const { return m_pos == m_in.size(); }
+
+  std::span<const uint8_t> TakeBytes(size_t count) {
+    if (m_in.size() - m_pos < count) {
+      return {};
+    }
+    auto bytes = m_in.subspan(m_pos, count);
+    m_pos += count;
+    return bytes;
+  }
+
+ private:
+  std::span<const uint8_t> m_in;
+  size_t m_pos = 0;
+  uint32_t m_bitBuf = 0;
+  int m_bitCount = 0;
+};
+
+struct FixedCodes {
+  FixedCodes() {
+    uint8_t lengths[288];
+    std::fill_n(lengths, 144, 8);
+    std::fill_n(lengths + 144, 112, 9);
+    std::fill_n(lengths + 256, 24, 7);
+    std::fill_n(lengths + 280, 8, 8);
+    BuildHuffman(lit, lengths);
+    std::fill_n(lengths, kNumDistance, 5);
+    BuildHuffman(dist, {lengths, kNumDistance});
+  }
+
+  Huffman lit;
+  Huffman dist;
+};
+
+bool ReadDynamicCodes(BitReader& reader, Huffman& lit, Huffman& dist) {
+  int numLit, numDist, numCl;
+  if (!reader.Bits(5, &numLit) || !reader.Bits(5, &numDist) ||
+      !reader.Bits(4, &numCl)) {
+    return false;
+  }
+  numLit += 257;
+  numDist += 1;
+  numCl += 4;
+  if (numLit > kNumLitLen || numDist > kNumDistance) {
+    return false;
+  }
+
+  uint8_t clLengths[kNumCodeLength] = {};
+  for (int i = 0; i < numCl; ++i) {
+    int len;
+    if (!reader.Bits(3, &len)) {
+      return false;
+    }
+    clLengths[kCodeLengthOrder[i]] = len;
+  }
+  Huffman cl;
+  if (BuildHuffman(cl, clLengths) != 0) {
+    return false;
+  }
+
+  uint8_t lengths[kNumLitLen + kNumDistance];
+  for (int i = 0; i < numLit + numDist;) {
+    int sym = reader.Decode(cl);
+    if (sym < 0) {
+      return false;
+    }
+    if (sym < 16) {
+      lengths[i++] = sym;
+      continue;
+    }
+    int len = 0;
+    int repeat;
+    if (sym == 16) {
+      if (i == 0) {
+        return false;
+      }
+      len = lengths[i - 1];
+      if (!reader.Bits(2, &repeat)) {
+        return false;
+      }
+      repeat += 3;
+    } else if (sym == 17) {
+      if (!reader.Bits(3, &repeat)) {
+        return false;
+      }
+      repeat += 3;
+    } else {
+      if (!reader.Bits(7, &repeat)) {
+        return false;
+      }
+      repeat += 11;
+    }
+    if (i + repeat > numLit + numDist) {
+      return false;
+    }
+    std::fill_n(lengths + i, repeat, len);
+    i += repeat;
+  }
+  if (lengths[kEndOfBlock] == 0) {
+    return false;
+  }
+
+  // incomplete codes are only allowed for a single code
+  int left = BuildHuffman(lit, {lengths, static_cast<size_t>(numLit)});
+  if (left < 0 || (left > 0 && numLit - lit.count[0] != 1)) {
+    return false;
+  }
+  left = BuildHuffman(dist, {lengths + numLit, static_cast<size_t>(numDist)});
+  if (left < 0 || (left > 0 && numDist - dist.count[0] != 1)) {
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+bool DeflateDecompressor::Decompress(std::span<const uint8_t> in,
+                                     std::vector<uint8_t>& out,
+                                     size_t maxSize) {
+  static const FixedCodes fixed;
+
+  // decompress after the window so matches can refer back into it
+  std::vector<uint8_t> buf;
+  buf.reserve(m_window.size() + in.size() * 4);
+  buf = m_window;
+  size_t start = buf.size();
+  size_t limit = maxSize > SIZE_MAX - start ? SIZE_MAX : start + maxSize;
+
+  BitReader reader{in};
+  Huffman lit, dist;
+  while (!reader.AtEnd()) {
+    int last, type;
+    if (!reader.Bits(1, &last) || !reader.Bits(2, &type)) {
+      return false;
+    }
+
+    if (type == 0) {
+      reader.AlignToByte();
+      auto header = reader.TakeBytes(4);
+      if (header.empty()) {
+        return false;
+      }
+      size_t len = header[0] | (header[1] << 8);
+      size_t nlen = header[2] | (header[3] << 8);
+      if (nlen != (len ^ 0xffff)) {
+        return false;
+      }
+      if (len > limit - buf.size()) {
+        return false;
+      }
+      auto data = reader.TakeBytes(len);
+      if (data.size() != len) {
+        return false;
+      }
+      buf.insert(buf.end(), data.begin(), data.end());
+    } else {
+      const Huffman* litCode = &fixed.lit;
+      const Huffman* distCode = &fixed.dist;
+      if (type == 2) {
+        if (!ReadDynamicCodes(reader, lit, dist)) {
+          return false;
+        }
+        litCode = &lit;
+        distCode = &dist;
+      } else if (type != 1) {
+        return false;
+      }
+
+      for (;;) {
+        int sym = reader.Decode(*litCode);
+        if (sym < 0) {
+          return false;
+        }
+        if (sym < kEndOfBlock) {
+          if (buf.size() == limit) {
+            return false;
+          }
+          buf.push_back(sym);
+          continue;
+        }
+        if (sym == kEndOfBlock) {
+          break;
+        }
+        sym -= 257;
+        if (sym >= 29) {
+          return false;
+        }
+        int extra;
+        if (!reader.Bits(kLengthExtra[sym], &extra)) {
+          return false;
+        }
+        size_t length = kLengthBase[sym] + extra;
+        sym = reader.Decode(*distCode);
+        if (sym < 0 || sym >= kNumDistance) {
+          return false;
+        }
+        if (!reader.Bits(kDistanceExtra[sym], &extra)) {
+          return false;
+        }
+        size_t distance = kDistanceBase[sym] + extra;
+        if (distance > buf.size() || length > limit - buf.size()) {
+          return false;
+        }
+        size_t from = buf.size() - distance;
+        for (size_t i = 0; i < length; ++i) {
+          buf.push_back(buf[from + i]);
+        }
+      }
+    }
+
+    if (last) {
+      break;
+    }
+  }
+
+  out.insert(out.end(), buf.begin() + start, buf.end());
+  size_t keep = std::min(buf.size(), kMaxWindow);
+  m_window.assign(buf.end() - keep, buf.end());
+  return true;
+}
@@ -14,7 +14,6 @@
 #include <string>
 #include <string_view>
 #include <thread>
-#include <tuple>
 #include <utility>
 
 #include <fmt/format.h>
@@ -22,27 +21,71 @@
 #include "wpi/StringExtras.h"
 
 namespace wpi {
+#ifdef __linux__
+// Returns false if the watch was removed
+static bool ReadEvents(int inotifyHandle) {
+  alignas(struct inotify_event) char
+      eventBuf[sizeof(struct inotify_event) + NAME_MAX + 1];
+  ssize_t len = read(inotifyHandle, eventBuf, sizeof(eventBuf));
+  if (len <= 0) {
+    return false;
+  }
+  for (ssize_t i = 0; i < len;) {
+    auto event = reinterpret_cast<const struct inotify_event*>(eventBuf + i);
+    if ((event->mask & IN_IGNORED) != 0) {
+      return false;
+    }
+    i += sizeof(struct inotify_event) + event->len;
+  }
+  return true;
+}
+#endif
+
 FileLogger::FileLogger(std::string_view file,
                        std::function<void(std::string_view)> callback)
 #ifdef __linux__
     : m_fileHandle{open(file.data(), O_RDONLY)},
       m_inotifyHandle{inotify_init()},
       m_inotifyWatchHandle{
-          inotify_add_watch(m_inotifyHandle, file.data(), IN_MODIFY)},
-      m_thread{[=, this] {
-        char buf[8000];
-        char eventBuf[sizeof(struct inotify_event) + NAME_MAX + 1];
-        lseek(m_fileHandle, 0, SEEK_END);
-        while (read(m_inotifyHandle, eventBuf, sizeof(eventBuf)) > 0) {
-          int bufLen = 0;
-          if ((bufLen = read(m_fileHandle, buf, sizeof(buf))) > 0) {
-            callback(std::string_view{buf, static_cast<size_t>(bufLen)});
-          }
-          std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        }
-      }}
+          inotify_add_watch(m_inotifyHandle, file.data(), IN_MODIFY)}
 #endif
 {
+#ifdef __linux__
+  if (m_fileHandle == -1 || m_inotifyWatchHandle == -1) {
+    return;
+  }
+  lseek(m_fileHandle, 0, SEEK_END);
+  // the thread uses copies of the handles, as this object may be moved
+  m_thread = std::thread{[callback = std::move(callback),
+                          fileHandle = m_fileHandle,
+                          inotifyHandle = m_inotifyHandle] {
+    std::string buf;
+    buf.resize(kMaxReadSize);
+    // the destructor removes the watch to stop the thread
+    while (ReadEvents(inotifyHandle)) {
+      size_t bufLen = 0;
+      ssize_t len;
+      while (bufLen < buf.size() &&
+             (len = read(fileHandle, buf.data() + bufLen,
+                         buf.size() - bufLen)) > 0) {
+        bufLen += len;
+      }
+      if (bufLen > 0) {
+        callback(std::string_view{buf.data(), bufLen});
+      }
+      if (bufLen == buf.size()) {
+        // skip whatever the callback didn't keep up with
+        off_t pos = lseek(fileHandle, 0, SEEK_CUR);
+        off_t end = lseek(fileHandle, 0, SEEK_END);
+        if (pos != -1 && end > pos) {
+          callback(fmt::format("\nFileLogger: skipped {} bytes\n", end - pos));
+        }
+      }
+      // batch lines written in quick succession
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+  }};
+#endif
 }
 FileLogger::FileLogger(std::string_view file, log::DataLog& log,
                        std::string_view key)
@@ -61,27 +104,29 @@ FileLogger::FileLogger(FileLogger&& other)
 }
 FileLogger& FileLogger::operator=(FileLogger&& rhs) {
 #ifdef __linux__
+  // rhs takes over (and destroys) the previous file and thread
   std::swap(m_fileHandle, rhs.m_fileHandle);
   std::swap(m_inotifyHandle, rhs.m_inotifyHandle);
   std::swap(m_inotifyWatchHandle, rhs.m_inotifyWatchHandle);
-  m_thread = std::move(rhs.m_thread);
+  std::swap(m_thread, rhs.m_thread);
 #endif
   return *this;
 }
 FileLogger::~FileLogger() {
 #ifdef __linux__
+  // removing the watch generates an IN_IGNORED event, which stops the thread
   if (m_inotifyWatchHandle != -1) {
     inotify_rm_watch(m_inotifyHandle, m_inotifyWatchHandle);
   }
+  if (m_thread.joinable()) {
+    m_thread.join();
+  }
   if (m_inotifyHandle != -1) {
     close(m_inotifyHandle);
   }
   if (m_fileHandle != -1) {
     close(m_fileHandle);
   }
-  if (m_thread.joinable()) {
-    m_thread.join();
-  }
 #endif
 }
 
@@ -93,12 +138,10 @@ std::function<void(std::string_view)> FileLogger::Buffer(
     if (!wpi::contains({data.data(), data.size()}, "\n")) {
       return;
     }
-    auto [wholeData, extra] = wpi::rsplit({buf.data(), buf.size()}, "\n");
-    std::string leftover{extra};
-
+    auto wholeData = wpi::rsplit({buf.data(), buf.size()}, "\n").first;
     callback(wholeData);
-    buf.clear();
-    buf.append(leftover.begin(), leftover.end());
+    // keep the incomplete last line for the next call
+    buf.erase(buf.begin(), buf.begin() + wholeData.size() + 1);
   };
 }
 }  // namespace wpi
@@ -0,0 +1,168 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/LZ4.h"
+
+#include <cstring>
+#include <memory>
+
+#include "wpi/Endian.h"
+
+// See https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md
+
+static constexpr size_t kMinMatch = 4;
+// the last 5 bytes are always literals
+static constexpr size_t kLastLiterals = 5;
+// the last match must start at least 12 bytes before the end
+static constexpr size_t kMatchStartLimit = 12;
+static constexpr size_t kMaxOffset = 65535;
+static constexpr int kHashBits = 14;
+
+static inline uint32_t Hash(uint32_t seq) {
+  return (seq * 2654435761u) >> (32 - kHashBits);
+}
+
+static uint8_t* WriteLength(uint8_t* op, size_t len) {
+  while (len >= 255) {
+    *op++ = 255;
+    len -= 255;
+  }
+  *op++ = len;
+  return op;
+}
+
+static uint8_t* WriteLiterals(uint8_t* op, uint8_t* token, const uint8_t* src,
+                              size_t len) {
+  if (len >= 15) {
+    *token = 15 << 4;
+    op = WriteLength(op, len - 15);
+  } else {
+    *token = len << 4;
+  }
+  std::memcpy(op, src, len);
+  return op + len;
+}
+
+size_t wpi::LZ4Compress(std::span<const uint8_t> in, std::span<uint8_t> out) {
+  const uint8_t* src = in.data();
+  size_t size = in.size();
+  uint8_t* op = out.data();
+  size_t anchor = 0;
+
+  if (size > kMatchStartLimit) {
+    // positions of the last occurrence of each hashed 4-byte sequence
+    auto table = std::make_unique<uint32_t[]>(1 << kHashBits);
+    size_t matchEndLimit = size - kLastLiterals;
+    size_t ip = 0;
+    while (ip + kMatchStartLimit < size) {
+      uint32_t seq = support::endian::read32le(src + ip);
+      uint32_t& slot = table[Hash(seq)];
+      size_t ref = slot;
+      slot = ip;
+      if (ref >= ip || ip - ref > kMaxOffset ||
+          support::endian::read32le(src + ref) != seq) {
+        ++ip;
+        continue;
+      }
+
+      // extend the match forwards, then backwards
+      size_t len = kMinMatch;
+      while (ip + len < matchEndLimit && src[ref + len] == src[ip + len]) {
+        ++len;
+      }
+      while (ip > anchor && ref > 0 && src[ip - 1] == src[ref - 1]) {
+        --ip;
+        --ref;
+        ++len;
+      }
+
+      uint8_t* token = op++;
+      op = WriteLiterals(op, token, src + anchor, ip - anchor);
+      support::endian::write16le(op, ip - ref);
+      op += 2;
+      if (len - kMinMatch >= 15) {
+        *token |= 15;
+        op = WriteLength(op, len - kMinMatch - 15);
+      } else {
+        *token |= len - kMinMatch;
+      }
+
+      ip += len;
+      anchor = ip;
+    }
+  }
+
+  // last sequence is literals only
+  uint8_t* token = op++;
+  op = WriteLiterals(op, token, src + anchor, size - anchor);
+  return op - out.data();
+}
+
+static bool ReadLength(const uint8_t** ip, const uint8_t* end, size_t* len) {
+  uint8_t val;
+  do {
+    if (*ip == end) {
+      return false;
+    }
+    val = *(*ip)++;
+    *len += val;
+  } while (val == 255);
+  return true;
+}
+
+bool wpi::LZ4Decompress(std::span<const uint8_t> in, std::span<uint8_t> out) {
+  const uint8_t* ip = in.data();
+  const uint8_t* iend = ip + in.size();
+  uint8_t* op = out.data();
+  uint8_t* oend = op + out.size();
+
+  for (;;) {
+    if (ip == iend) {
+      return false;
+    }
+    unsigned int token = *ip++;
+
+    size_t litLen = token >> 4;
+    if (litLen == 15 && !ReadLength(&ip, iend, &litLen)) {
+      return false;
+    }
+    if (litLen > static_cast<size_t>(iend - ip) ||
+        litLen > static_cast<size_t>(oend - op)) {
+      return false;
+    }
+    std::memcpy(op, ip, litLen);
+    ip += litLen;
+    op += litLen;
+    if (ip == iend) {
+      return op == oend;
+    }
+
+    if (iend - ip < 2) {
+      return false;
+    }
+    size_t offset = support::endian::read16le(ip);
+    ip += 2;
+    if (offset == 0 || offset > static_cast<size_t>(op - out.data())) {
+      return false;
+    }
+    size_t len = token & 15;
+    if (len == 15 && !ReadLength(&ip, iend, &len)) {
+      return false;
+    }
+    len += kMinMatch;
+    if (len > static_cast<size_t>(oend - op)) {
+      return false;
+    }
+    const uint8_t* match = op - offset;
+    if (offset >= len) {
+      std::memcpy(op, match, len);
+      op += len;
+    } else {
+      // overlapping match repeats the last offset bytes
+      for (size_t i = 0; i < len; ++i) {
+        *op++ = *match++;
+      }
+    }
+  }
+}
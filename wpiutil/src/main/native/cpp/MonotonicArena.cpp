@@ -0,0 +1,42 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/MonotonicArena.h"
+
+#include <memory>
+
+using namespace wpi;
+
+MonotonicArena::MonotonicArena(size_t initialSize) {
+  Init(initialSize);
+}
+
+void MonotonicArena::Init(size_t size) {
+  m_resource.reset();
+  m_size = size;
+  if (size == 0) {
+    m_buffer.reset();
+    m_resource.emplace(&m_upstream);
+  } else {
+    m_buffer.reset(new std::byte[size]);
+    m_resource.emplace(m_buffer.get(), size, &m_upstream);
+  }
+}
+
+void MonotonicArena::Reset() {
+  size_t overflow = m_upstream.GetBytesAllocated();
+  m_upstream.ResetCounts();
+  if (overflow == 0) {
+    m_resource->release();
+  } else {
+    // the overflow blocks grow geometrically, so this is at least as large as
+    // the high water mark
+    Init(m_size + overflow);
+  }
+}
+
+MonotonicArena& wpi::GetThreadArena() {
+  thread_local MonotonicArena arena;
+  return arena;
+}
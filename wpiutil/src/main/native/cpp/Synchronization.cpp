@@ -5,10 +5,25 @@
 #include "wpi/Synchronization.h"
 
 #include <algorithm>
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <climits>
 #include <cstring>
 #include <mutex>
 
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#undef CreateEvent
+#undef CreateSemaphore
+#pragma comment(lib, "Synchronization.lib")
+#endif
+
 #include "wpi/DenseMap.h"
 #include "wpi/SmallVector.h"
 #include "wpi/UidVector.h"
@@ -21,19 +36,210 @@ static std::atomic_bool gShutdown{false};
 
 namespace {
 
+using Clock = std::chrono::steady_clock;
+
+// Sleeps until word is woken by FutexWake, unless it no longer contains
+// expected. May return spuriously.
+void FutexWait(std::atomic<uint32_t>& word, uint32_t expected,
+               const Clock::time_point* deadline);
+
+// Wakes one or all FutexWait waiters on word.
+void FutexWake(std::atomic<uint32_t>& word, bool all);
+
+#if defined(__linux__)
+
+void FutexWait(std::atomic<uint32_t>& word, uint32_t expected,
+               const Clock::time_point* deadline) {
+  timespec ts;
+  if (deadline) {
+    auto remaining = *deadline - Clock::now();
+    if (remaining <= Clock::duration::zero()) {
+      return;
+    }
+    auto secs = std::chrono::duration_cast<std::chrono::seconds>(remaining);
+    ts.tv_sec = secs.count();
+    ts.tv_nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                     remaining - secs)
+                     .count();
+  }
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE,
+          expected, deadline ? &ts : nullptr, nullptr, 0);
+}
+
+void FutexWake(std::atomic<uint32_t>& word, bool all) {
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE,
+          all ? INT_MAX : 1, nullptr, nullptr, 0);
+}
+
+#elif defined(_WIN32)
+
+void FutexWait(std::atomic<uint32_t>& word, uint32_t expected,
+               const Clock::time_point* deadline) {
+  DWORD ms = INFINITE;
+  if (deadline) {
+    auto remaining = *deadline - Clock::now();
+    if (remaining <= Clock::duration::zero()) {
+      return;
+    }
+    // round up so we don't spin on sub-millisecond remainders
+    ms = static_cast<DWORD>(
+        std::chrono::ceil<std::chrono::milliseconds>(remaining).count());
+  }
+  WaitOnAddress(&word, &expected, sizeof(expected), ms);
+}
+
+void FutexWake(std::atomic<uint32_t>& word, bool all) {
+  if (all) {
+    WakeByAddressAll(&word);
+  } else {
+    WakeByAddressSingle(&word);
+  }
+}
+
+#else
+
+// no native address wait; park on a condition variable picked by address
+struct ParkingBucket {
+  wpi::mutex mutex;
+  wpi::condition_variable cv;
+};
+
+ParkingBucket& GetParkingBucket(const void* addr) {
+  static std::array<ParkingBucket, 32> buckets;
+  return buckets[(reinterpret_cast<uintptr_t>(addr) >> 4) % buckets.size()];
+}
+
+void FutexWait(std::atomic<uint32_t>& word, uint32_t expected,
+               const Clock::time_point* deadline) {
+  auto& bucket = GetParkingBucket(&word);
+  std::unique_lock lock{bucket.mutex};
+  if (word.load() != expected) {
+    return;
+  }
+  if (deadline) {
+    bucket.cv.wait_until(lock, *deadline);
+  } else {
+    bucket.cv.wait(lock);
+  }
+}
+
+void FutexWake(std::atomic<uint32_t>& word, bool) {
+  auto& bucket = GetParkingBucket(&word);
+  {
+    std::scoped_lock lock{bucket.mutex};
+  }
+  bucket.cv.notify_all();
+}
+
+#endif
+
+// WaitForObjects call on more than one handle
+struct MultiWaiter {
+  void Notify() {
+    {
+      std::scoped_lock lock{mutex};
+      notified = true;
+    }
+    cv.notify_all();
+  }
+
+  wpi::mutex mutex;
+  wpi::condition_variable cv;
+  bool notified = false;
+};
+
 struct State {
-  int signaled{0};
-  bool autoReset{false};
-  wpi::SmallVector<wpi::condition_variable*, 2> waiters;
+  // Consumes the signal (for auto-reset objects) if signaled.
+  bool TryAcquire() {
+    if (!autoReset) {
+      return signaled.load() > 0;
+    }
+    int count = signaled.load();
+    while (count > 0) {
+      if (signaled.compare_exchange_weak(count, count - 1)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Wakes waiters after a change to signaled or destroyed.
+  void Wake(bool all) {
+    seq.fetch_add(1);
+    FutexWake(seq, all);
+    if (numWaiters.load() > 0) {
+      std::scoped_lock lock{waitersMutex};
+      for (auto waiter : waiters) {
+        waiter->Notify();
+      }
+    }
+  }
+
+  std::atomic<int> signaled{0};
+  std::atomic_bool autoReset{false};
+  std::atomic_bool destroyed{false};
+  int maxCount = INT_MAX;
+
+  // incremented by Wake(); single-handle waiters sleep on this
+  std::atomic<uint32_t> seq{0};
+
+  // the map holds one reference, and each operation in progress another
+  std::atomic<int> refs{1};
+
+  std::atomic<int> numWaiters{0};
+  wpi::mutex waitersMutex;
+  wpi::SmallVector<MultiWaiter*, 2> waiters;
+};
+
+void Unref(State* state) {
+  if (state && --state->refs == 0) {
+    delete state;
+  }
+}
+
+class StateRef {
+ public:
+  explicit StateRef(State* state = nullptr) : m_state{state} {}
+  StateRef(StateRef&& rhs) noexcept : m_state{rhs.m_state} {
+    rhs.m_state = nullptr;
+  }
+  StateRef(const StateRef&) = delete;
+  StateRef& operator=(const StateRef&) = delete;
+  ~StateRef() { Unref(m_state); }
+
+  State* get() const { return m_state; }
+  State* operator->() const { return m_state; }
+  explicit operator bool() const { return m_state; }
+
+ private:
+  State* m_state;
+};
+
+// Handle states are split across several maps to reduce lock contention;
+// the locks are only held to look up and reference count states.
+struct StateShard {
+  wpi::mutex mutex;
+  wpi::DenseMap<WPI_Handle, State*> states;
 };
 
 struct HandleManager {
-  ~HandleManager() { gShutdown = true; }
+  ~HandleManager() {
+    gShutdown = true;
+    for (auto&& shard : shards) {
+      for (auto&& state : shard.states) {
+        Unref(state.second);
+      }
+    }
+  }
+
+  StateShard& GetShard(WPI_Handle handle) {
+    return shards[(handle * 0x9e3779b1u) >> 28];
+  }
 
   wpi::mutex mutex;
   wpi::UidVector<int, 8> eventIds;
   wpi::UidVector<int, 8> semaphoreIds;
-  wpi::DenseMap<WPI_Handle, State> states;
+  std::array<StateShard, 16> shards;
 };
 
 }  // namespace
@@ -43,20 +249,45 @@ static HandleManager& GetManager() {
   return manager;
 }
 
+static StateRef LookupState(HandleManager& manager, WPI_Handle handle) {
+  auto& shard = manager.GetShard(handle);
+  std::scoped_lock lock{shard.mutex};
+  auto it = shard.states.find(handle);
+  if (it == shard.states.end()) {
+    return StateRef{};
+  }
+  ++it->second->refs;
+  return StateRef{it->second};
+}
+
+static void CreateState(HandleManager& manager, WPI_Handle handle,
+                        int signaled, bool autoReset, int maxCount) {
+  auto& shard = manager.GetShard(handle);
+  std::scoped_lock lock{shard.mutex};
+  auto& state = shard.states[handle];
+  if (!state) {
+    state = new State;
+    state->maxCount = maxCount;
+  }
+  state->signaled = signaled;
+  state->autoReset = autoReset;
+}
+
 WPI_EventHandle wpi::CreateEvent(bool manualReset, bool initialState) {
   auto& manager = GetManager();
   if (gShutdown) {
     return {};
   }
-  std::scoped_lock lock{manager.mutex};
 
-  auto index = manager.eventIds.emplace_back(0);
-  WPI_EventHandle handle = (kHandleTypeEvent << 24) | (index & 0xffffff);
+  WPI_EventHandle handle;
+  {
+    std::scoped_lock lock{manager.mutex};
+    auto index = manager.eventIds.emplace_back(0);
+    handle = (kHandleTypeEvent << 24) | (index & 0xffffff);
+  }
 
   // configure state data
-  auto& state = manager.states[handle];
-  state.signaled = initialState ? 1 : 0;
-  state.autoReset = !manualReset;
+  CreateState(manager, handle, initialState ? 1 : 0, !manualReset, INT_MAX);
 
   return handle;
 }
@@ -97,15 +328,16 @@ WPI_SemaphoreHandle wpi::CreateSemaphore(int initialCount, int maximumCount) {
   if (gShutdown) {
     return {};
   }
-  std::scoped_lock lock{manager.mutex};
 
-  auto index = manager.semaphoreIds.emplace_back(maximumCount);
-  WPI_EventHandle handle = (kHandleTypeSemaphore << 24) | (index & 0xffffff);
+  WPI_SemaphoreHandle handle;
+  {
+    std::scoped_lock lock{manager.mutex};
+    auto index = manager.semaphoreIds.emplace_back(maximumCount);
+    handle = (kHandleTypeSemaphore << 24) | (index & 0xffffff);
+  }
 
   // configure state data
-  auto& state = manager.states[handle];
-  state.signaled = initialCount;
-  state.autoReset = true;
+  CreateState(manager, handle, initialCount, true, maximumCount);
 
   return handle;
 }
@@ -122,7 +354,7 @@ void wpi::DestroySemaphore(WPI_SemaphoreHandle handle) {
     return;
   }
   std::scoped_lock lock{manager.mutex};
-  manager.eventIds.erase(handle & 0xffffff);
+  manager.semaphoreIds.erase(handle & 0xffffff);
 }
 
 bool wpi::ReleaseSemaphore(WPI_SemaphoreHandle handle, int releaseCount,
@@ -133,29 +365,26 @@ bool wpi::ReleaseSemaphore(WPI_SemaphoreHandle handle, int releaseCount,
   if (releaseCount <= 0) {
     return false;
   }
-  int index = handle & 0xffffff;
 
   auto& manager = GetManager();
   if (gShutdown) {
     return true;
   }
-  std::scoped_lock lock{manager.mutex};
-  auto it = manager.states.find(handle);
-  if (it == manager.states.end()) {
-    return false;
-  }
-  auto& state = it->second;
-  int maxCount = manager.eventIds[index];
-  if (prevCount) {
-    *prevCount = state.signaled;
-  }
-  if ((maxCount - state.signaled) < releaseCount) {
+  auto state = LookupState(manager, handle);
+  if (!state) {
     return false;
   }
-  state.signaled += releaseCount;
-  for (auto& waiter : state.waiters) {
-    waiter->notify_all();
-  }
+  int count = state->signaled.load();
+  do {
+    if (prevCount) {
+      *prevCount = count;
+    }
+    if ((state->maxCount - count) < releaseCount) {
+      return false;
+    }
+  } while (
+      !state->signaled.compare_exchange_weak(count, count + releaseCount));
+  state->Wake(true);
   return true;
 }
 
@@ -178,6 +407,61 @@ std::span<WPI_Handle> wpi::WaitForObjects(std::span<const WPI_Handle> handles,
   return WaitForObjects(handles, signaled, -1, nullptr);
 }
 
+// Fast path for a single handle: waits on the state's futex word, without
+// taking any locks once the state is found.
+static std::span<WPI_Handle> WaitForSingleObject(
+    HandleManager& manager, WPI_Handle handle, std::span<WPI_Handle> signaled,
+    double timeout, bool* timedOut) {
+  auto state = LookupState(manager, handle);
+  bool timedOutVal = false;
+  size_t count = 0;
+
+  Clock::time_point deadline;
+  if (timeout > 0) {
+    deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                                  std::chrono::duration<double>(timeout));
+  }
+
+  for (;;) {
+    // read before checking the state, so a wake in between isn't lost
+    uint32_t seq = state ? state->seq.load() : 0;
+    if (!state || state->destroyed) {
+      if (count < signaled.size()) {
+        // treat a non-existent handle as signaled, but set the error bit
+        signaled[count++] = handle | 0x80000000ul;
+      }
+    } else if (state->TryAcquire()) {
+      if (count < signaled.size()) {
+        signaled[count++] = handle;
+      }
+    }
+
+    if (timedOutVal || count != 0 || !state) {
+      break;
+    }
+
+    if (timeout == 0) {
+      timedOutVal = true;
+      break;
+    }
+
+    if (timeout < 0) {
+      FutexWait(state->seq, seq, nullptr);
+    } else {
+      FutexWait(state->seq, seq, &deadline);
+      if (Clock::now() >= deadline) {
+        timedOutVal = true;
+      }
+    }
+  }
+
+  if (timedOut) {
+    *timedOut = timedOutVal;
+  }
+
+  return signaled.subspan(0, count);
+}
+
 std::span<WPI_Handle> wpi::WaitForObjects(std::span<const WPI_Handle> handles,
                                           std::span<WPI_Handle> signaled,
                                           double timeout, bool* timedOut) {
@@ -186,32 +470,40 @@ std::span<WPI_Handle> wpi::WaitForObjects(std::span<const WPI_Handle> handles,
     *timedOut = false;
     return {};
   }
-  std::unique_lock lock{manager.mutex};
-  wpi::condition_variable cv;
+
+  if (handles.size() == 1) {
+    return WaitForSingleObject(manager, handles[0], signaled, timeout,
+                               timedOut);
+  }
+
+  wpi::SmallVector<StateRef, 8> states;
+  states.reserve(handles.size());
+  for (auto handle : handles) {
+    states.emplace_back(LookupState(manager, handle));
+  }
+
+  MultiWaiter waiter;
   bool addedWaiters = false;
   bool timedOutVal = false;
   size_t count = 0;
 
+  Clock::time_point deadline;
+  if (timeout > 0) {
+    deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                                  std::chrono::duration<double>(timeout));
+  }
+
   for (;;) {
-    for (auto handle : handles) {
-      auto it = manager.states.find(handle);
-      if (it == manager.states.end()) {
+    for (size_t i = 0; i < handles.size(); ++i) {
+      auto& state = states[i];
+      if (!state || state->destroyed) {
         if (count < signaled.size()) {
           // treat a non-existent handle as signaled, but set the error bit
-          signaled[count++] = handle | 0x80000000ul;
+          signaled[count++] = handles[i] | 0x80000000ul;
         }
-      } else {
-        auto& state = it->second;
-        if (state.signaled > 0) {
-          if (count < signaled.size()) {
-            signaled[count++] = handle;
-          }
-          if (state.autoReset) {
-            --state.signaled;
-            if (state.signaled < 0) {
-              state.signaled = 0;
-            }
-          }
+      } else if (state->TryAcquire()) {
+        if (count < signaled.size()) {
+          signaled[count++] = handles[i];
         }
       }
     }
@@ -226,30 +518,40 @@ std::span<WPI_Handle> wpi::WaitForObjects(std::span<const WPI_Handle> handles,
     }
 
     if (!addedWaiters) {
+      // check again after adding, so a signal in between isn't lost
       addedWaiters = true;
-      for (auto handle : handles) {
-        auto& state = manager.states[handle];
-        state.waiters.emplace_back(&cv);
+      for (auto&& state : states) {
+        if (!state) {
+          continue;
+        }
+        std::scoped_lock lock{state->waitersMutex};
+        state->waiters.emplace_back(&waiter);
+        ++state->numWaiters;
       }
+      continue;
     }
 
+    std::unique_lock lock{waiter.mutex};
     if (timeout < 0) {
-      cv.wait(lock);
-    } else {
-      auto timeoutTime = std::chrono::steady_clock::now() +
-                         std::chrono::duration<double>(timeout);
-      if (cv.wait_until(lock, timeoutTime) == std::cv_status::timeout) {
-        timedOutVal = true;
-      }
+      waiter.cv.wait(lock, [&] { return waiter.notified; });
+    } else if (!waiter.cv.wait_until(lock, deadline,
+                                     [&] { return waiter.notified; })) {
+      timedOutVal = true;
     }
+    waiter.notified = false;
   }
 
   if (addedWaiters) {
-    for (auto handle : handles) {
-      auto& state = manager.states[handle];
-      auto it = std::find(state.waiters.begin(), state.waiters.end(), &cv);
-      if (it != state.waiters.end()) {
-        state.waiters.erase(it);
+    for (auto&& state : states) {
+      if (!state) {
+        continue;
+      }
+      std::scoped_lock lock{state->waitersMutex};
+      auto it = std::find(state->waiters.begin(), state->waiters.end(),
+                          &waiter);
+      if (it != state->waiters.end()) {
+        state->waiters.erase(it);
+        --state->numWaiters;
       }
     }
   }
@@ -267,10 +569,7 @@ void wpi::CreateSignalObject(WPI_Handle handle, bool manualReset,
   if (gShutdown) {
     return;
   }
-  std::scoped_lock lock{manager.mutex};
-  auto& state = manager.states[handle];
-  state.signaled = initialState ? 1 : 0;
-  state.autoReset = !manualReset;
+  CreateState(manager, handle, initialState ? 1 : 0, !manualReset, INT_MAX);
 }
 
 void wpi::SetSignalObject(WPI_Handle handle) {
@@ -278,20 +577,13 @@ void wpi::SetSignalObject(WPI_Handle handle) {
   if (gShutdown) {
     return;
   }
-  std::scoped_lock lock{manager.mutex};
-  auto it = manager.states.find(handle);
-  if (it == manager.states.end()) {
+  auto state = LookupState(manager, handle);
+  if (!state) {
     return;
   }
-  auto& state = it->second;
-  state.signaled = 1;
-  for (auto& waiter : state.waiters) {
-    waiter->notify_all();
-    if (state.autoReset) {
-      // expect the first waiter to reset it
-      break;
-    }
-  }
+  state->signaled = 1;
+  // only one waiter can consume an auto-reset signal
+  state->Wake(!state->autoReset);
 }
 
 void wpi::ResetSignalObject(WPI_Handle handle) {
@@ -299,10 +591,8 @@ void wpi::ResetSignalObject(WPI_Handle handle) {
   if (gShutdown) {
     return;
   }
-  std::scoped_lock lock{manager.mutex};
-  auto it = manager.states.find(handle);
-  if (it != manager.states.end()) {
-    it->second.signaled = 0;
+  if (auto state = LookupState(manager, handle)) {
+    state->signaled = 0;
   }
 }
 
@@ -311,16 +601,23 @@ void wpi::DestroySignalObject(WPI_Handle handle) {
   if (gShutdown) {
     return;
   }
-  std::scoped_lock lock{manager.mutex};
 
-  auto it = manager.states.find(handle);
-  if (it != manager.states.end()) {
-    // wake up any waiters
-    for (auto& waiter : it->second.waiters) {
-      waiter->notify_all();
+  State* state;
+  {
+    auto& shard = manager.GetShard(handle);
+    std::scoped_lock lock{shard.mutex};
+    auto it = shard.states.find(handle);
+    if (it == shard.states.end()) {
+      return;
     }
-    manager.states.erase(it);
+    state = it->second;
+    shard.states.erase(it);
   }
+
+  // wake up any waiters
+  state->destroyed = true;
+  state->Wake(true);
+  Unref(state);  // the map's reference
 }
 
 extern "C" {
@@ -0,0 +1,187 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/ThreadRegistry.h"
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "wpi/mutex.h"
+
+using namespace wpi;
+
+namespace {
+
+struct ThreadEntry {
+#ifdef __linux__
+  pthread_t handle;
+#endif
+  std::string name;
+  ThreadClass threadClass;
+};
+
+class Registry {
+ public:
+  bool Register(ThreadEntry* entry, ThreadClass threadClass,
+                std::string_view name);
+  void Unregister(ThreadEntry* entry);
+  bool SetSchedule(ThreadClass threadClass, const ThreadSchedule& schedule);
+  ThreadSchedule GetSchedule(ThreadClass threadClass);
+  std::vector<RegisteredThread> GetThreads();
+
+ private:
+  static bool Apply(const ThreadEntry& entry, const ThreadSchedule& schedule);
+
+  wpi::mutex m_mutex;
+  std::array<ThreadSchedule, static_cast<size_t>(ThreadClass::kNumClasses)>
+      m_schedules;
+  // classes with a schedule set; others leave thread scheduling alone
+  std::array<bool, static_cast<size_t>(ThreadClass::kNumClasses)>
+      m_configured{};
+  std::vector<ThreadEntry*> m_threads;
+};
+
+// Unregisters the thread when it exits
+struct ThreadRegistration {
+  ~ThreadRegistration();
+
+  ThreadEntry entry;
+  bool registered = false;
+};
+
+}  // namespace
+
+static Registry& GetRegistry() {
+  static Registry* registry = new Registry;
+  return *registry;
+}
+
+bool Registry::Register(ThreadEntry* entry, ThreadClass threadClass,
+                        std::string_view name) {
+  std::scoped_lock lock{m_mutex};
+  entry->name = name;
+  entry->threadClass = threadClass;
+  if (std::find(m_threads.begin(), m_threads.end(), entry) ==
+      m_threads.end()) {
+    m_threads.emplace_back(entry);
+  }
+  auto i = static_cast<size_t>(threadClass);
+  return !m_configured[i] || Apply(*entry, m_schedules[i]);
+}
+
+void Registry::Unregister(ThreadEntry* entry) {
+  std::scoped_lock lock{m_mutex};
+  std::erase(m_threads, entry);
+}
+
+bool Registry::SetSchedule(ThreadClass threadClass,
+                           const ThreadSchedule& schedule) {
+  std::scoped_lock lock{m_mutex};
+  m_schedules[static_cast<size_t>(threadClass)] = schedule;
+  m_configured[static_cast<size_t>(threadClass)] = true;
+  bool ok = true;
+  for (auto entry : m_threads) {
+    if (entry->threadClass == threadClass) {
+      ok = Apply(*entry, schedule) && ok;
+    }
+  }
+  return ok;
+}
+
+ThreadSchedule Registry::GetSchedule(ThreadClass threadClass) {
+  std::scoped_lock lock{m_mutex};
+  return m_schedules[static_cast<size_t>(threadClass)];
+}
+
+std::vector<RegisteredThread> Registry::GetThreads() {
+  std::scoped_lock lock{m_mutex};
+  std::vector<RegisteredThread> threads;
+  threads.reserve(m_threads.size());
+  for (auto entry : m_threads) {
+    threads.emplace_back(entry->name, entry->threadClass);
+  }
+  return threads;
+}
+
+bool Registry::Apply(const ThreadEntry& entry, const ThreadSchedule& schedule) {
+#ifdef __linux__
+  bool ok = true;
+
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  for (int i = 0; i < CPU_SETSIZE; ++i) {
+    if (schedule.cpuMask == 0 ||
+        (i < 32 && (schedule.cpuMask & (1u << i)) != 0)) {
+      CPU_SET(i, &cpus);
+    }
+  }
+  if (pthread_setaffinity_np(entry.handle, sizeof(cpus), &cpus) != 0) {
+    ok = false;
+  }
+
+  if (schedule.priority < 0) {
+    return ok;
+  }
+  sched_param sch{};
+  int policy = SCHED_OTHER;
+  if (schedule.priority > 0) {
+    policy = SCHED_FIFO;
+    sch.sched_priority =
+        std::clamp(schedule.priority, sched_get_priority_min(SCHED_FIFO),
+                   sched_get_priority_max(SCHED_FIFO));
+  }
+  if (pthread_setschedparam(entry.handle, policy, &sch) != 0) {
+    ok = false;
+  }
+  return ok;
+#else
+  return false;
+#endif
+}
+
+ThreadRegistration::~ThreadRegistration() {
+  if (registered) {
+    GetRegistry().Unregister(&entry);
+  }
+}
+
+static thread_local ThreadRegistration gThreadRegistration;
+
+bool wpi::SetCurrentThreadClass(ThreadClass threadClass,
+                                std::string_view name) {
+  auto& reg = gThreadRegistration;
+#ifdef __linux__
+  reg.entry.handle = pthread_self();
+  // the main thread's name is the process name (e.g. as seen by killall)
+  if (::syscall(SYS_gettid) != ::getpid()) {
+    pthread_setname_np(reg.entry.handle,
+                       std::string{name.substr(0, 15)}.c_str());
+  }
+#endif
+  reg.registered = true;
+  return GetRegistry().Register(&reg.entry, threadClass, name);
+}
+
+bool wpi::SetThreadSchedule(ThreadClass threadClass,
+                            const ThreadSchedule& schedule) {
+  return GetRegistry().SetSchedule(threadClass, schedule);
+}
+
+ThreadSchedule wpi::GetThreadSchedule(ThreadClass threadClass) {
+  return GetRegistry().GetSchedule(threadClass);
+}
+
+std::vector<RegisteredThread> wpi::GetRegisteredThreads() {
+  return GetRegistry().GetThreads();
+}
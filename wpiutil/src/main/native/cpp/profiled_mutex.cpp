@@ -0,0 +1,122 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/profiled_mutex.h"
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "wpi/StringMap.h"
+
+namespace wpi::detail {
+
+class LockRegistry {
+ public:
+  static LockRegistry& GetInstance() {
+    // intentionally leaked, as mutexes may be destroyed during static
+    // destruction
+    static LockRegistry* inst = new LockRegistry;
+    return *inst;
+  }
+
+  void Add(LockCounters* counters) {
+    std::scoped_lock lock{m_mutex};
+    counters->m_next = m_head;
+    if (m_head) {
+      m_head->m_prev = counters;
+    }
+    m_head = counters;
+  }
+
+  void Remove(LockCounters* counters) {
+    std::scoped_lock lock{m_mutex};
+    // keep the statistics of destroyed mutexes
+    auto& stats = m_retired[counters->GetName()];
+    counters->AddTo(stats);
+    if (counters->m_prev) {
+      counters->m_prev->m_next = counters->m_next;
+    } else {
+      m_head = counters->m_next;
+    }
+    if (counters->m_next) {
+      counters->m_next->m_prev = counters->m_prev;
+    }
+  }
+
+  std::vector<LockStats> GetStats() {
+    std::scoped_lock lock{m_mutex};
+    wpi::StringMap<LockStats> byName;
+    for (auto&& [name, stats] : m_retired) {
+      byName[name] = stats;
+    }
+    for (auto counters = m_head; counters; counters = counters->m_next) {
+      counters->AddTo(byName[counters->GetName()]);
+    }
+    std::vector<LockStats> rv;
+    rv.reserve(byName.size());
+    for (auto&& [name, stats] : byName) {
+      rv.emplace_back(stats);
+      rv.back().name = name;
+    }
+    std::sort(rv.begin(), rv.end(),
+              [](const auto& a, const auto& b) { return a.name < b.name; });
+    return rv;
+  }
+
+  void Reset() {
+    std::scoped_lock lock{m_mutex};
+    m_retired.clear();
+    for (auto counters = m_head; counters; counters = counters->m_next) {
+      counters->Reset();
+    }
+  }
+
+ private:
+  std::mutex m_mutex;
+  LockCounters* m_head = nullptr;
+  wpi::StringMap<LockStats> m_retired;
+};
+
+}  // namespace wpi::detail
+
+using namespace wpi;
+using namespace wpi::detail;
+
+LockCounters::LockCounters(std::string_view name) : m_name{name} {
+  LockRegistry::GetInstance().Add(this);
+}
+
+LockCounters::~LockCounters() {
+  LockRegistry::GetInstance().Remove(this);
+}
+
+void LockCounters::AddTo(LockStats& stats) const {
+  stats.locks += m_locks.load(std::memory_order_relaxed);
+  stats.contended += m_contended.load(std::memory_order_relaxed);
+  stats.totalWait += m_totalWait.load(std::memory_order_relaxed);
+  stats.maxWait =
+      std::max(stats.maxWait, m_maxWait.load(std::memory_order_relaxed));
+  stats.totalHold += m_totalHold.load(std::memory_order_relaxed);
+  stats.maxHold =
+      std::max(stats.maxHold, m_maxHold.load(std::memory_order_relaxed));
+}
+
+void LockCounters::Reset() {
+  m_locks.store(0, std::memory_order_relaxed);
+  m_contended.store(0, std::memory_order_relaxed);
+  m_totalWait.store(0, std::memory_order_relaxed);
+  m_maxWait.store(0, std::memory_order_relaxed);
+  m_totalHold.store(0, std::memory_order_relaxed);
+  m_maxHold.store(0, std::memory_order_relaxed);
+}
+
+std::vector<LockStats> wpi::GetLockStats() {
+  return LockRegistry::GetInstance().GetStats();
+}
+
+void wpi::ResetLockStats() {
+  LockRegistry::GetInstance().Reset();
+}
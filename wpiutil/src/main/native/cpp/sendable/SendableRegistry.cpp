@@ -13,7 +13,7 @@
 #include "wpi/DenseMap.h"
 #include "wpi/SmallVector.h"
 #include "wpi/UidVector.h"
-#include "wpi/mutex.h"
+#include "wpi/profiled_mutex.h"
 #include "wpi/sendable/Sendable.h"
 #include "wpi/sendable/SendableBuilder.h"
 
@@ -39,7 +39,7 @@ struct Component {
 };
 
 struct SendableRegistryInst {
-  wpi::recursive_mutex mutex;
+  wpi::profiled_recursive_mutex mutex{"SendableRegistry"};
 
   std::function<std::unique_ptr<SendableBuilder>()> liveWindowFactory;
   wpi::UidVector<std::unique_ptr<Component>, 32> components;
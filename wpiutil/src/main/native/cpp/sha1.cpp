@@ -19,8 +19,22 @@
 
 #include "wpi/sha1.h"
 
+#include <string.h>
+
 #include <string>
 
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || \
+    defined(_M_IX86)
+#define WPI_SHA1_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+#include "wpi/Endian.h"
 #include "wpi/SmallVector.h"
 #include "wpi/StringExtras.h"
 #include "wpi/raw_istream.h"
@@ -214,13 +228,168 @@ static void buffer_to_block(const unsigned char* buffer,
   }
 }
 
+#ifdef WPI_SHA1_X86
+#ifdef _MSC_VER
+#define WPI_SHA1_TARGET
+#else
+#define WPI_SHA1_TARGET __attribute__((target("sha,ssse3,sse4.1")))
+#endif
+
+static bool have_sha_ni() {
+  // SHA (leaf 7 EBX bit 29), SSSE3 (leaf 1 ECX bit 9), SSE4.1 (bit 19)
+#ifdef _MSC_VER
+  int regs[4];
+  __cpuid(regs, 0);
+  if (regs[0] < 7) {
+    return false;
+  }
+  __cpuid(regs, 1);
+  unsigned int ecx1 = regs[2];
+  __cpuidex(regs, 7, 0);
+  unsigned int ebx7 = regs[1];
+#else
+  unsigned int eax, ebx, ecx1, edx;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx1, &edx)) {
+    return false;
+  }
+  unsigned int ebx7, ecx;
+  if (!__get_cpuid_count(7, 0, &eax, &ebx7, &ecx, &edx)) {
+    return false;
+  }
+#endif
+  return (ebx7 & (1u << 29)) != 0 && (ecx1 & (1u << 9)) != 0 &&
+         (ecx1 & (1u << 19)) != 0;
+}
+
+/*
+ * Hash 512-bit blocks with the x86 SHA extensions. Each group of 4 rounds
+ * finishes the message schedule for the next group (sha1msg2), continues it
+ * for the group after that (xor), and starts it for the group 3 ahead
+ * (sha1msg1).
+ */
+
+#define SHA1_GROUP(g, ecur, eother)                             \
+  if constexpr (g == 0) {                                       \
+    ecur = _mm_add_epi32(ecur, msg[0]);                         \
+  } else {                                                      \
+    ecur = _mm_sha1nexte_epu32(ecur, msg[g % 4]);               \
+  }                                                             \
+  eother = abcd;                                                \
+  if constexpr (g >= 3 && g <= 18) {                            \
+    msg[(g + 1) % 4] = _mm_sha1msg2_epu32(msg[(g + 1) % 4], msg[g % 4]); \
+  }                                                             \
+  abcd = _mm_sha1rnds4_epu32(abcd, ecur, g / 5);                \
+  if constexpr (g >= 1 && g <= 16) {                            \
+    msg[(g + 3) % 4] = _mm_sha1msg1_epu32(msg[(g + 3) % 4], msg[g % 4]); \
+  }                                                             \
+  if constexpr (g >= 2 && g <= 17) {                            \
+    msg[(g + 2) % 4] = _mm_xor_si128(msg[(g + 2) % 4], msg[g % 4]); \
+  }
+
+WPI_SHA1_TARGET
+static void transform_sha_ni(uint32_t digest[], const unsigned char* data,
+                             size_t blocks) {
+  const __m128i mask =
+      _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+  __m128i abcd = _mm_shuffle_epi32(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(digest)), 0x1B);
+  __m128i e0 = _mm_set_epi32(digest[4], 0, 0, 0);
+  __m128i e1;
+  __m128i msg[4];
+
+  for (; blocks > 0; --blocks, data += BLOCK_BYTES) {
+    __m128i abcd_save = abcd;
+    __m128i e0_save = e0;
+    for (int i = 0; i < 4; ++i) {
+      msg[i] = _mm_shuffle_epi8(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * i)),
+          mask);
+    }
+
+    SHA1_GROUP(0, e0, e1)
+    SHA1_GROUP(1, e1, e0)
+    SHA1_GROUP(2, e0, e1)
+    SHA1_GROUP(3, e1, e0)
+    SHA1_GROUP(4, e0, e1)
+    SHA1_GROUP(5, e1, e0)
+    SHA1_GROUP(6, e0, e1)
+    SHA1_GROUP(7, e1, e0)
+    SHA1_GROUP(8, e0, e1)
+    SHA1_GROUP(9, e1, e0)
+    SHA1_GROUP(10, e0, e1)
+    SHA1_GROUP(11, e1, e0)
+    SHA1_GROUP(12, e0, e1)
+    SHA1_GROUP(13, e1, e0)
+    SHA1_GROUP(14, e0, e1)
+    SHA1_GROUP(15, e1, e0)
+    SHA1_GROUP(16, e0, e1)
+    SHA1_GROUP(17, e1, e0)
+    SHA1_GROUP(18, e0, e1)
+    SHA1_GROUP(19, e1, e0)
+
+    e0 = _mm_sha1nexte_epu32(e0, e0_save);
+    abcd = _mm_add_epi32(abcd, abcd_save);
+  }
+
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(digest),
+                   _mm_shuffle_epi32(abcd, 0x1B));
+  digest[4] = _mm_extract_epi32(e0, 3);
+}
+
+#undef SHA1_GROUP
+#endif  // WPI_SHA1_X86
+
+/*
+ * Hash whole 512-bit blocks, with the SHA extensions if available.
+ */
+
+static void transform(uint32_t digest[], const unsigned char* data,
+                      size_t blocks, uint64_t& transforms) {
+#ifdef WPI_SHA1_X86
+  static const bool sha_ni = have_sha_ni();
+  if (sha_ni) {
+    transform_sha_ni(digest, data, blocks);
+    transforms += blocks;
+    return;
+  }
+#endif
+  for (; blocks > 0; --blocks, data += BLOCK_BYTES) {
+    uint32_t block[BLOCK_INTS];
+    buffer_to_block(data, block);
+    do_transform(digest, block, transforms);
+  }
+}
+
 SHA1::SHA1() {
   reset(digest, buf_size, transforms);
 }
 
 void SHA1::Update(std::string_view s) {
-  raw_mem_istream is(std::span<const char>(s.data(), s.size()));
-  Update(is);
+  auto data = reinterpret_cast<const unsigned char*>(s.data());
+  size_t len = s.size();
+
+  /* Finish a partial block */
+  if (buf_size > 0) {
+    size_t n = std::min(len, BLOCK_BYTES - buf_size);
+    memcpy(&buffer[buf_size], data, n);
+    buf_size += n;
+    data += n;
+    len -= n;
+    if (buf_size != BLOCK_BYTES) {
+      return;
+    }
+    transform(digest, buffer, 1, transforms);
+    buf_size = 0;
+  }
+
+  /* Hash whole blocks directly from the input */
+  size_t blocks = len / BLOCK_BYTES;
+  transform(digest, data, blocks, transforms);
+  data += blocks * BLOCK_BYTES;
+  len -= blocks * BLOCK_BYTES;
+
+  memcpy(buffer, data, len);
+  buf_size = len;
 }
 
 void SHA1::Update(raw_istream& is) {
@@ -229,9 +398,7 @@ void SHA1::Update(raw_istream& is) {
     if (buf_size != BLOCK_BYTES) {
       return;
     }
-    uint32_t block[BLOCK_INTS];
-    buffer_to_block(buffer, block);
-    do_transform(digest, block, transforms);
+    transform(digest, buffer, 1, transforms);
     buf_size = 0;
   }
 }
@@ -247,24 +414,16 @@ static void finalize(uint32_t digest[], unsigned char* buffer, size_t& buf_size,
 
   /* Padding */
   buffer[buf_size++] = 0x80;
-  for (size_t i = buf_size; i < BLOCK_BYTES; ++i) {
-    buffer[i] = 0x00;
-  }
-
-  uint32_t block[BLOCK_INTS];
-  buffer_to_block(buffer, block);
-
   if (buf_size > BLOCK_BYTES - 8) {
-    do_transform(digest, block, transforms);
-    for (size_t i = 0; i < BLOCK_INTS - 2; i++) {
-      block[i] = 0;
-    }
+    memset(&buffer[buf_size], 0, BLOCK_BYTES - buf_size);
+    transform(digest, buffer, 1, transforms);
+    buf_size = 0;
   }
+  memset(&buffer[buf_size], 0, BLOCK_BYTES - 8 - buf_size);
 
-  /* Append total_bits, split this uint64_t into two uint32_t */
-  block[BLOCK_INTS - 1] = total_bits;
-  block[BLOCK_INTS - 2] = (total_bits >> 32);
-  do_transform(digest, block, transforms);
+  /* Append total_bits */
+  support::endian::write64be(&buffer[BLOCK_BYTES - 8], total_bits);
+  transform(digest, buffer, 1, transforms);
 
   /* Hex string */
   static const char* const LUT = "0123456789abcdef";
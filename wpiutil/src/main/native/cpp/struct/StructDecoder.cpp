@@ -0,0 +1,147 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/struct/StructDecoder.h"
+
+#include <cassert>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "wpi/Endian.h"
+#include "wpi/bit.h"
+
+using namespace wpi;
+
+StructDecoder::StructDecoder(const StructDescriptor* desc)
+    : m_desc{desc}, m_size{desc->GetSize()} {
+  AddFields(desc, 0, "");
+}
+
+void StructDecoder::AddFields(const StructDescriptor* desc, size_t offset,
+                              const std::string& prefix) {
+  for (auto&& field : desc->GetFields()) {
+    auto type = field.GetType();
+    if (type == StructFieldType::kChar) {
+      continue;
+    }
+    for (size_t i = 0; i < field.GetArraySize(); ++i) {
+      std::string name = prefix + field.GetName();
+      if (field.IsArray()) {
+        name += fmt::format("[{}]", i);
+      }
+
+      if (type == StructFieldType::kStruct) {
+        auto sub = field.GetStruct();
+        AddFields(sub, offset + field.GetOffset() + i * sub->GetSize(),
+                  name + ".");
+        continue;
+      }
+
+      Op op;
+      op.offset = offset + field.GetOffset() + i * field.GetSize();
+      op.size = field.GetSize();
+      op.shift = field.GetBitShift();
+      op.mask = field.GetBitMask();
+      if (type == StructFieldType::kBool) {
+        op.kind = kBool;
+      } else if (type == StructFieldType::kFloat) {
+        op.kind = kFloat;
+      } else if (type == StructFieldType::kDouble) {
+        op.kind = kDouble;
+      } else if (field.IsUint()) {
+        op.kind = kUint;
+      } else {
+        switch (op.size) {
+          case 1:
+            op.kind = kInt8;
+            break;
+          case 2:
+            op.kind = kInt16;
+            break;
+          case 4:
+            op.kind = kInt32;
+            break;
+          default:
+            op.kind = kInt64;
+            break;
+        }
+      }
+      m_ops.emplace_back(op);
+      m_columns.emplace_back(Column{std::move(name), type});
+    }
+  }
+}
+
+double StructDecoder::Read(const Op& op, const uint8_t* data) {
+  const uint8_t* p = data + op.offset;
+  uint64_t raw;
+  switch (op.size) {
+    case 1:
+      raw = *p;
+      break;
+    case 2:
+      raw = support::endian::read16le(p);
+      break;
+    case 4:
+      raw = support::endian::read32le(p);
+      break;
+    default:
+      raw = support::endian::read64le(p);
+      break;
+  }
+  raw = (raw >> op.shift) & op.mask;
+  // same conversions as the DynamicStruct getters
+  switch (op.kind) {
+    case kBool:
+      return raw != 0;
+    case kInt8:
+      return static_cast<int8_t>(raw);
+    case kInt16:
+      return static_cast<int16_t>(raw);
+    case kInt32:
+      return static_cast<int32_t>(raw);
+    case kInt64:
+      return static_cast<double>(static_cast<int64_t>(raw));
+    case kUint:
+      return static_cast<double>(raw);
+    case kFloat:
+      return bit_cast<float>(static_cast<uint32_t>(raw));
+    default:
+      return bit_cast<double>(raw);
+  }
+}
+
+void StructDecoder::Decode(std::span<const uint8_t> data,
+                           std::span<double> out) const {
+  assert(data.size() >= m_size);
+  assert(out.size() >= m_ops.size());
+  double* o = out.data();
+  for (auto&& op : m_ops) {
+    *o++ = Read(op, data.data());
+  }
+}
+
+size_t StructDecoder::DecodeColumns(
+    std::span<const uint8_t> data,
+    std::span<std::vector<double>> columns) const {
+  assert(columns.size() == m_ops.size());
+  if (m_size == 0) {
+    return 0;
+  }
+  size_t count = data.size() / m_size;
+  for (size_t i = 0; i < m_ops.size(); ++i) {
+    auto& column = columns[i];
+    size_t start = column.size();
+    column.resize(start + count);
+    double* o = column.data() + start;
+    const uint8_t* p = data.data();
+    const Op op = m_ops[i];
+    for (size_t j = 0; j < count; ++j, p += m_size) {
+      *o++ = Read(op, p);
+    }
+  }
+  return count;
+}
@@ -4,6 +4,7 @@
 
 #include "wpi/timestamp.h"
 
+#include <algorithm>
 #include <atomic>
 #include <optional>
 #include <utility>
@@ -310,6 +311,63 @@ uint64_t wpi::Now() {
 #endif
 }
 
+namespace {
+// Calibration of NowDefault() against Now() for NowCalibrated()
+struct Calibration {
+  static constexpr int64_t kSyncPeriod = 100000;  // us
+  // maximum backward slew, as a fraction of the time since the last sync
+  static constexpr int64_t kSlewDivisor = 64;
+  std::atomic<int64_t> offset{0};
+  std::atomic<int64_t> lastSync{INT64_MIN};
+  std::atomic<int64_t> lastResult{0};
+  // set (with release) once the first sync has stored offset
+  std::atomic<bool> calibrated{false};
+};
+}  // namespace
+
+static Calibration calibration;
+
+uint64_t wpi::NowCalibrated() {
+#ifndef __FRC_ROBORIO__
+  if (now_impl.load(std::memory_order_relaxed) == NowDefault) {
+    return NowDefault();
+  }
+#endif
+  int64_t local = NowDefault();
+  int64_t lastSync = calibration.lastSync.load(std::memory_order_relaxed);
+  int64_t result;
+  if ((lastSync == INT64_MIN ||
+       local - lastSync >= Calibration::kSyncPeriod) &&
+      calibration.lastSync.compare_exchange_strong(lastSync, local)) {
+    int64_t target = static_cast<int64_t>(Now()) - local;
+    int64_t offset;
+    if (lastSync == INT64_MIN) {
+      offset = target;
+    } else {
+      // moving the offset forward keeps the result monotonic, but moving it
+      // back is limited so the result only stalls briefly
+      offset = calibration.offset.load(std::memory_order_relaxed);
+      offset =
+          (std::max)(target, offset - (local - lastSync) /
+                                          Calibration::kSlewDivisor);
+    }
+    calibration.offset.store(offset, std::memory_order_relaxed);
+    calibration.calibrated.store(true, std::memory_order_release);
+    result = local + offset;
+  } else if (calibration.calibrated.load(std::memory_order_acquire)) {
+    result = local + calibration.offset.load(std::memory_order_relaxed);
+  } else {
+    // another thread is still doing the first sync
+    result = Now();
+  }
+
+  int64_t last = calibration.lastResult.load(std::memory_order_relaxed);
+  while (result > last && !calibration.lastResult.compare_exchange_weak(
+                              last, result, std::memory_order_relaxed)) {
+  }
+  return (std::max)(result, last);
+}
+
 uint64_t wpi::GetSystemTime() {
   return time_since_epoch();
 }
@@ -340,6 +398,10 @@ uint64_t WPI_Now(void) {
   return wpi::Now();
 }
 
+uint64_t WPI_NowCalibrated(void) {
+  return wpi::NowCalibrated();
+}
+
 uint64_t WPI_GetSystemTime(void) {
   return wpi::GetSystemTime();
 }
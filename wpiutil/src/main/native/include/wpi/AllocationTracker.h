@@ -0,0 +1,146 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <new>
+
+namespace wpi {
+
+/**
+ * Counts heap allocations, per thread and in total, for finding code that
+ * allocates in loops that should be allocation-free.
+ *
+ * Counting requires replacing the global operator new and delete, which a
+ * library can't do on behalf of a program. To opt in, put
+ * WPI_ALLOCATION_TRACKER_HOOKS() in exactly one source file of the program and
+ * call SetEnabled(true). Allocations are only counted while enabled; when
+ * disabled the hooks only add a relaxed atomic load to each allocation.
+ *
+ * Over-aligned allocations (operator new with std::align_val_t) are not
+ * counted.
+ */
+class AllocationTracker {
+ public:
+  /**
+   * Allocation counts.
+   */
+  struct Counts {
+    /// Number of allocations.
+    uint64_t allocations = 0;
+
+    /// Number of deallocations.
+    uint64_t deallocations = 0;
+
+    /// Total size of allocations, in bytes.
+    uint64_t bytes = 0;
+  };
+
+  AllocationTracker() = delete;
+
+  /**
+   * Enables or disables counting.
+   *
+   * @param enabled True to enable.
+   */
+  static void SetEnabled(bool enabled) {
+    s_enabled.store(enabled, std::memory_order_relaxed);
+  }
+
+  /**
+   * Returns whether counting is enabled.
+   *
+   * @return True if enabled.
+   */
+  static bool IsEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+  /**
+   * Returns whether the operator new hooks are installed, i.e. whether any
+   * allocation has been seen by them.
+   *
+   * @return True if installed.
+   */
+  static bool IsInstalled() {
+    return s_installed.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Gets the counts for allocations made by the calling thread.
+   *
+   * @return Counts since the thread started.
+   */
+  static Counts GetThreadCounts() noexcept;
+
+  /**
+   * Gets the counts for allocations made by all threads.
+   *
+   * @return Counts since the program started.
+   */
+  static Counts GetTotalCounts() noexcept;
+
+  /**
+   * Allocates memory and counts the allocation. Used by the operator new
+   * hooks.
+   *
+   * @param size Size, in bytes.
+   * @return Memory, or nullptr on failure.
+   */
+  static void* Allocate(size_t size) noexcept;
+
+  /**
+   * Frees memory from Allocate() and counts the deallocation. Used by the
+   * operator delete hooks.
+   *
+   * @param p Memory; may be nullptr.
+   */
+  static void Deallocate(void* p) noexcept;
+
+ private:
+  static inline std::atomic_bool s_enabled{false};
+  static inline std::atomic_bool s_installed{false};
+};
+
+}  // namespace wpi
+
+/**
+ * Replaces the global operator new and delete with versions that count
+ * allocations in wpi::AllocationTracker. Use at namespace scope in exactly
+ * one source file of a program.
+ */
+#define WPI_ALLOCATION_TRACKER_HOOKS()                                       \
+  void* operator new(std::size_t size) {                                    \
+    if (void* p = ::wpi::AllocationTracker::Allocate(size)) {               \
+      return p;                                                             \
+    }                                                                       \
+    throw std::bad_alloc{};                                                 \
+  }                                                                         \
+  void* operator new[](std::size_t size) { return ::operator new(size); }   \
+  void* operator new(std::size_t size, const std::nothrow_t&) noexcept {    \
+    return ::wpi::AllocationTracker::Allocate(size);                        \
+  }                                                                         \
+  void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {  \
+    return ::wpi::AllocationTracker::Allocate(size);                        \
+  }                                                                         \
+  void operator delete(void* p) noexcept {                                  \
+    ::wpi::AllocationTracker::Deallocate(p);                                \
+  }                                                                         \
+  void operator delete[](void* p) noexcept {                                \
+    ::wpi::AllocationTracker::Deallocate(p);                                \
+  }                                                                         \
+  void operator delete(void* p, std::size_t) noexcept {                     \
+    ::wpi::AllocationTracker::Deallocate(p);                                \
+  }                                                                         \
+  void operator delete[](void* p, std::size_t) noexcept {                   \
+    ::wpi::AllocationTracker::Deallocate(p);                                \
+  }                                                                         \
+  void operator delete(void* p, const std::nothrow_t&) noexcept {           \
+    ::wpi::AllocationTracker::Deallocate(p);                                \
+  }                                                                         \
+  void operator delete[](void* p, const std::nothrow_t&) noexcept {         \
+    ::wpi::AllocationTracker::Deallocate(p);                                \
+  }
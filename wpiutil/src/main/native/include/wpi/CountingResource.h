@@ -0,0 +1,106 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <functional>
+#include <memory_resource>
+#include <utility>
+
+namespace wpi {
+
+/**
+ * Memory resource that forwards to another resource and counts the
+ * allocations made through it.
+ *
+ * This is useful for finding allocations in code that should not allocate
+ * (e.g. the main robot loop): install it with std::pmr::set_default_resource()
+ * or pass it to containers, and check the counts or set an allocation hook
+ * (e.g. to print a stack trace or break in a debugger).
+ *
+ * The counts may be read from any thread.
+ */
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  /**
+   * Hook called on each allocation with the size and alignment, in bytes.
+   */
+  using AllocationHook = std::function<void(size_t bytes, size_t alignment)>;
+
+  /**
+   * Constructs a counting resource.
+   *
+   * @param upstream resource to allocate from
+   */
+  explicit CountingResource(
+      std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+      : m_upstream{upstream} {}
+
+  CountingResource(const CountingResource&) = delete;
+  CountingResource& operator=(const CountingResource&) = delete;
+
+  /**
+   * Gets the number of allocations since construction or the last
+   * ResetCounts().
+   *
+   * @return number of allocations
+   */
+  uint64_t GetAllocationCount() const {
+    return m_allocations.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Gets the number of deallocations since construction or the last
+   * ResetCounts().
+   *
+   * @return number of deallocations
+   */
+  uint64_t GetDeallocationCount() const {
+    return m_deallocations.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Gets the total size of allocations since construction or the last
+   * ResetCounts().
+   *
+   * @return bytes allocated
+   */
+  uint64_t GetBytesAllocated() const {
+    return m_bytesAllocated.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Resets the counts to zero.
+   */
+  void ResetCounts();
+
+  /**
+   * Sets a hook to call on each allocation. This is not thread safe with
+   * respect to concurrent allocations, so it should be set before the
+   * resource is used.
+   *
+   * @param hook hook; may be empty to remove the hook
+   */
+  void SetAllocationHook(AllocationHook hook) { m_hook = std::move(hook); }
+
+ private:
+  void* do_allocate(size_t bytes, size_t alignment) override;
+  void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+  bool do_is_equal(
+      const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+
+  std::pmr::memory_resource* m_upstream;
+  std::atomic<uint64_t> m_allocations{0};
+  std::atomic<uint64_t> m_deallocations{0};
+  std::atomic<uint64_t> m_bytesAllocated{0};
+  AllocationHook m_hook;
+};
+
+}  // namespace wpi
@@ -7,8 +7,12 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <atomic>
 #include <concepts>
+#include <cstring>
+#include <functional>
 #include <initializer_list>
+#include <memory>
 #include <optional>
 #include <ranges>
 #include <span>
@@ -23,7 +27,9 @@
 #include "wpi/DenseMap.h"
 #include "wpi/SmallVector.h"
 #include "wpi/StringMap.h"
+#include "wpi/function_ref.h"
 #include "wpi/mutex.h"
+#include "wpi/profiled_mutex.h"
 #include "wpi/protobuf/Protobuf.h"
 #include "wpi/string.h"
 #include "wpi/struct/Struct.h"
@@ -60,16 +66,18 @@ enum ControlRecordType {
  * good idea to call Finish() from destructors for this reason.
  *
  * DataLog calls are thread safe.  DataLog uses a typical multiple-supplier,
- * single-consumer setup.  Writes to the log are atomic, but there is no
- * guaranteed order in the log when multiple threads are writing to it;
- * whichever thread grabs the write mutex first will get written first.
+ * single-consumer setup.  Each thread appends data records to its own set of
+ * buffers, so threads logging concurrently don't contend with each other;
+ * the buffers of all threads are combined when the log is flushed.  Writes to
+ * the log are atomic, and records from a single thread stay in order, but
+ * there is no guaranteed order between records from different threads.
  * For this reason (as well as the fact that timestamps can be set to
  * arbitrary values), records in the log are not guaranteed to be sorted by
  * timestamp.
  */
 class DataLog {
  public:
-  virtual ~DataLog() = default;
+  virtual ~DataLog();
 
   DataLog(const DataLog&) = delete;
   DataLog& operator=(const DataLog&) = delete;
@@ -98,6 +106,121 @@ class DataLog {
    */
   virtual void Stop();
 
+  /**
+   * Adds a function to call at the start of every flush of the log, before
+   * the appended records are collected for writing.  This lets a producer
+   * that generates many records (e.g. NetworkTables capture) queue them
+   * cheaply and append them in a batch from the thread that flushes the log.
+   *
+   * The function may call the AppendX functions, but must not call
+   * AddFlushCallback() or RemoveFlushCallback().
+   *
+   * @param func function to call
+   * @return Handle to pass to RemoveFlushCallback()
+   */
+  int AddFlushCallback(std::function<void()> func);
+
+  /**
+   * Removes a flush callback.  If the callback is running on another thread,
+   * waits for it to return.
+   *
+   * @param handle handle returned by AddFlushCallback()
+   */
+  void RemoveFlushCallback(int handle);
+
+  /**
+   * Data log statistics.  Counters are cumulative since the log was
+   * constructed; compute rates by taking the difference between two snapshots.
+   */
+  struct Stats {
+    /** Number of data records appended. */
+    uint64_t records = 0;
+
+    /** Number of data record payload bytes appended. */
+    uint64_t bytes = 0;
+
+    /**
+     * Number of data records dropped because logging was paused due to the
+     * buffers reaching the maximum count (see BufferFull()).  Records dropped
+     * due to an explicit Pause() are not counted.
+     */
+    uint64_t droppedRecords = 0;
+
+    /** Number of times logging was paused due to full buffers. */
+    uint64_t overflowCount = 0;
+
+    /** Number of data records dropped by entry filters. */
+    uint64_t filteredRecords = 0;
+
+    /** Number of buffers appended to but not yet handed to the writer. */
+    size_t buffersInFlight = 0;
+  };
+
+  /**
+   * Gets the log statistics.
+   *
+   * @return Statistics
+   */
+  Stats GetStats() const;
+
+  /**
+   * Gets the number of data record payload bytes appended to an entry.  This
+   * is cumulative since the log was constructed.
+   *
+   * @param entry Entry index, as returned by Start()
+   * @return Number of bytes
+   */
+  uint64_t GetEntryBytes(int entry) const;
+
+  /**
+   * Filter for the data records of an entry.  Records rejected by the filter
+   * are dropped by the AppendX functions, so values can be appended
+   * unconditionally (e.g. every loop iteration) while only meaningful changes
+   * are stored.  A default-constructed filter accepts all records.
+   */
+  struct EntryFilter {
+    /**
+     * Minimum time between stored records, in microseconds.  Records with a
+     * timestamp less than this after the last stored record are dropped.
+     * 0 disables.
+     */
+    int64_t minPeriod = 0;
+
+    /**
+     * For float and double entries, records within this distance of the last
+     * stored value are dropped.  Negative disables.
+     */
+    double deadband = -1;
+
+    /**
+     * If true, records with the same payload as the last stored record are
+     * dropped.  Payloads are compared by hash, so no copy of the last value is
+     * kept, even for large arrays.
+     */
+    bool onChange = false;
+  };
+
+  /**
+   * Sets the filter for an entry.  The filter stays in effect until changed,
+   * including across Finish() and Start() of the entry.  The state of the
+   * filter (e.g. the last stored value) is reset when a new file is started.
+   *
+   * @param entry Entry index, as returned by Start()
+   * @param filter Filter
+   */
+  void SetEntryFilter(int entry, const EntryFilter& filter);
+
+  /**
+   * Sets the filter for all entries, current and future, whose names start
+   * with the given prefix.  If multiple prefixes match an entry, the longest
+   * one is used.  This is useful for entries created by other code, e.g. data
+   * logs of NetworkTables values.
+   *
+   * @param prefix Entry name prefix
+   * @param filter Filter; a default-constructed filter removes the prefix
+   */
+  void SetEntryFilter(std::string_view prefix, const EntryFilter& filter);
+
   /**
    * Returns whether there is a data schema already registered with the given
    * name.
@@ -441,8 +564,7 @@ class DataLog {
    * @param msglog message logger (will be called from separate thread)
    * @param extraHeader extra header metadata
    */
-  explicit DataLog(wpi::Logger& msglog, std::string_view extraHeader = "")
-      : m_msglog{msglog}, m_extraHeader{extraHeader} {}
+  explicit DataLog(wpi::Logger& msglog, std::string_view extraHeader = "");
 
   /**
    * Starts the log.  Appends file header and Start records and schema data
@@ -473,45 +595,107 @@ class DataLog {
 
   /**
    * Called when internal buffers are half the maximum count.  Called with
-   * internal mutex held; do not call any other DataLog functions from this
-   * function.
+   * internal mutex held (possibly from any thread that appends to the log);
+   * do not call any other DataLog functions from this function.
    */
   virtual void BufferHalfFull();
 
   /**
    * Called when internal buffers reach the maximum count.  Called with internal
-   * mutex held; do not call any other DataLog functions from this function.
+   * mutex held (possibly from any thread that appends to the log); do not call
+   * any other DataLog functions from this function.
    *
    * @return true if log should be paused (don't call PauseLog)
    */
   virtual bool BufferFull() = 0;
 
  private:
+  friend class DataLogFrame;
+
   static constexpr size_t kMaxBufferCount = 1024 * 1024 / kBlockSize;
   static constexpr size_t kMaxFreeCount = 256 * 1024 / kBlockSize;
 
+  // counts of data records appended
+  struct AppendCounts {
+    uint64_t records = 0;
+    uint64_t bytes = 0;
+    std::vector<uint64_t> entryBytes;  // indexed by entry ID
+
+    void Add(const AppendCounts& oth);
+  };
+
+  // data record buffers of one appending thread
+  struct ThreadBuffers;
+  struct ThreadBuffersCache;
+
+  // returns the calling thread's buffers, creating them if needed
+  ThreadBuffers& GetThreadBuffers();
+
   // must be called with m_mutex held
   int StartImpl(std::string_view name, std::string_view type,
                 std::string_view metadata, int64_t timestamp);
-  uint8_t* StartRecord(uint32_t entry, uint64_t timestamp, uint32_t payloadSize,
-                       size_t reserveSize);
-  uint8_t* Reserve(size_t size);
-  void AppendImpl(std::span<const uint8_t> data);
-  void AppendStringImpl(std::string_view str);
   void AppendStartRecord(int id, std::string_view name, std::string_view type,
                          std::string_view metadata, int64_t timestamp);
+  // moves all thread buffers to m_outgoing, so records written to m_outgoing
+  // afterwards are ordered after everything appended so far
+  void CollectThreadBuffers();
+
+  // calls the flush callbacks; must be called without m_mutex held
+  void RunFlushCallbacks();
+
+  // returns true if data records should not be appended; counts the record
+  // as dropped if paused due to full buffers
+  bool CheckPaused();
+
+  // returns false if the record should be dropped by the entry's filter;
+  // a timestamp of 0 is replaced with the current time if the entry has a
+  // filter.  value is only provided for float and double entries.
+  bool Accept(int entry, int64_t* timestamp, function_ref<uint64_t()> hash,
+              const double* value = nullptr);
+  bool CheckFilter(int entry, int64_t* timestamp,
+                   function_ref<uint64_t()> hash, const double* value);
+  // must be called with m_mutex held
+  void ApplyPrefixFilter(int entry, std::string_view name);
+
+  // must be called with out.mutex held; counts the record
+  uint8_t* StartDataRecord(ThreadBuffers& out, int entry, int64_t timestamp,
+                           uint32_t payloadSize, size_t reserveSize);
+
+  // must be called with the lock for out held
+  uint8_t* StartRecord(std::vector<Buffer>& out, uint32_t entry,
+                       uint64_t timestamp, uint32_t payloadSize,
+                       size_t reserveSize);
+  uint8_t* Reserve(std::vector<Buffer>& out, size_t size);
+  void AppendImpl(std::vector<Buffer>& out, std::span<const uint8_t> data);
+  void AppendStringImpl(std::vector<Buffer>& out, std::string_view str);
+
+  Buffer AllocBuffer();  // locks m_poolMutex
+  // must be called with m_poolMutex held
   void DoReleaseBufs(std::vector<Buffer>* bufs);
 
  protected:
   wpi::Logger& m_msglog;
 
  private:
-  mutable wpi::mutex m_mutex;
+  // lock order: m_mutex, then ThreadBuffers::mutex, then m_poolMutex
+  mutable wpi::profiled_mutex m_mutex{"DataLog"};
   bool m_active = false;
-  bool m_paused = false;
+  std::atomic_bool m_paused = false;
+  // set when paused due to full buffers; cleared by Resume()
+  std::atomic_bool m_overflowPaused = false;
+  std::atomic<uint64_t> m_droppedRecords = 0;
   std::string m_extraHeader;
-  std::vector<Buffer> m_free;
   std::vector<Buffer> m_outgoing;
+  std::vector<std::shared_ptr<ThreadBuffers>> m_threadBufs;
+  const unsigned int m_instanceId;
+  // counts from threads that have exited
+  AppendCounts m_exitedCounts;
+
+  mutable wpi::mutex m_poolMutex;
+  std::vector<Buffer> m_free;
+  size_t m_outgoingCount = 0;  // buffers not yet passed to FlushBufs()
+  uint64_t m_overflowCount = 0;
+
   struct EntryInfo {
     std::string type;
     std::vector<uint8_t> schemaData;  // only set for schema entries
@@ -524,6 +708,27 @@ class DataLog {
   };
   wpi::DenseMap<int, EntryInfo2> m_entryIds;
   int m_lastId = 0;
+  std::vector<std::pair<std::string, EntryFilter>> m_prefixFilters;
+
+  // filter state; m_filterMutex may be locked with m_mutex held
+  struct FilterState {
+    EntryFilter filter;
+    bool hasLast = false;
+    int64_t lastTimestamp = 0;
+    double lastValue = 0;
+    uint64_t lastHash = 0;
+  };
+  mutable wpi::mutex m_filterMutex;
+  wpi::DenseMap<int, FilterState> m_filters;
+  std::atomic<size_t> m_filterCount = 0;
+  uint64_t m_filteredRecords = 0;
+
+  // flush callbacks; m_flushCallbackMutex is held while they run, so it is
+  // locked before m_mutex
+  wpi::mutex m_flushCallbackMutex;
+  std::vector<std::pair<int, std::function<void()>>> m_flushCallbacks;
+  std::atomic<size_t> m_flushCallbackCount = 0;
+  int m_lastFlushCallback = 0;
 };
 
 /**
@@ -565,6 +770,15 @@ class DataLogEntry {
     m_log->SetMetadata(m_entry, metadata, timestamp);
   }
 
+  /**
+   * Sets the filter for the entry.  See DataLog::SetEntryFilter().
+   *
+   * @param filter Filter
+   */
+  void SetFilter(const DataLog::EntryFilter& filter) {
+    m_log->SetEntryFilter(m_entry, filter);
+  }
+
   /**
    * Finishes the entry.
    *
@@ -1556,6 +1770,11 @@ class StructArrayLogEntry : public DataLogEntry {
     auto& lastValue = m_lastValue.value();
     size_t size = std::apply(S::GetSize, m_info);
     std::vector<T> rv;
+    if constexpr (LayoutCompatibleStruct<T, I...>) {
+      rv.resize(lastValue.size() / size);
+      std::memcpy(rv.data(), lastValue.data(), rv.size() * size);
+      return rv;
+    }
     rv.reserve(lastValue.size() / size);
     for (auto in = lastValue.begin(), end = lastValue.end(); in < end;
          in += size) {
@@ -1657,13 +1876,137 @@ class ProtobufLogEntry : public DataLogEntry {
     if (!m_lastValue.has_value()) {
       return std::nullopt;
     }
-    return m_msg.Unpack(m_lastValue);
+    m_arena.Reset();
+    return m_msg.Unpack(m_lastValue.value(), m_arena);
   }
 
  private:
   mutable wpi::mutex m_mutex;
-  ProtobufMessage<T> m_msg;
+  mutable ProtobufMessage<T> m_msg;
+  mutable ProtobufArena m_arena;
   std::optional<std::vector<uint8_t>> m_lastValue;
 };
 
+/**
+ * A fixed set of entries whose values are appended together, with a single
+ * timestamp, as one "frame".  The record headers are preformatted when the
+ * frame is created, so appending a frame takes the log lock once and copies
+ * the values into a single reservation, instead of locking and formatting a
+ * header for each value.
+ *
+ * Only fixed-size data types are supported: "boolean", "int64", "float", and
+ * "double".
+ */
+class DataLogFrame {
+ public:
+  /** Frame field. */
+  struct Field {
+    /** Entry name. */
+    std::string_view name;
+
+    /** Data type; must be a fixed-size type. */
+    std::string_view type;
+
+    /** Initial metadata. */
+    std::string_view metadata = {};
+  };
+
+  DataLogFrame() = default;
+
+  /**
+   * Starts the entries of a frame.  Fields with unsupported data types, or
+   * that fail to start (e.g. due to a type mismatch with an existing entry),
+   * are ignored.  Ignored fields of supported types still take space in the
+   * frame data; see GetOffset().
+   *
+   * @param log data log
+   * @param fields fields
+   * @param timestamp Time stamp (may be 0 to indicate now)
+   */
+  DataLogFrame(DataLog& log, std::span<const Field> fields,
+               int64_t timestamp = 0);
+
+  /**
+   * Starts the entries of a frame.
+   *
+   * @param log data log
+   * @param fields fields
+   * @param timestamp Time stamp (may be 0 to indicate now)
+   */
+  DataLogFrame(DataLog& log, std::initializer_list<Field> fields,
+               int64_t timestamp = 0)
+      : DataLogFrame{log, std::span{fields.begin(), fields.end()}, timestamp} {
+  }
+
+  explicit operator bool() const { return m_log != nullptr; }
+
+  /**
+   * Gets the size of the frame data passed to Append().
+   *
+   * @return Size, in bytes
+   */
+  size_t GetSize() const { return m_size; }
+
+  /**
+   * Gets the offset of a field's value in the frame data passed to Append().
+   *
+   * @param field field index
+   * @return Offset, in bytes
+   */
+  size_t GetOffset(size_t field) const { return m_fields[field].offset; }
+
+  /**
+   * Gets the entry index of a field.
+   *
+   * @param field field index
+   * @return Entry index (0 if the field is ignored)
+   */
+  int GetEntry(size_t field) const { return m_fields[field].entry; }
+
+  /**
+   * Appends a frame to the log.  Each field's value is encoded as in the
+   * data log (little endian); booleans take 1 byte.
+   *
+   * @param data frame data; must be GetSize() bytes
+   * @param timestamp Time stamp (may be 0 to indicate now)
+   */
+  void Append(std::span<const uint8_t> data, int64_t timestamp = 0);
+
+  /**
+   * Appends a frame where all fields are doubles.
+   *
+   * @param values values, one per field
+   * @param timestamp Time stamp (may be 0 to indicate now)
+   */
+  void AppendDoubles(std::span<const double> values, int64_t timestamp = 0);
+
+  /**
+   * Finishes the entries of the frame.
+   *
+   * @param timestamp Time stamp (may be 0 to indicate now)
+   */
+  void Finish(int64_t timestamp = 0);
+
+ private:
+  struct FieldInfo {
+    int entry;
+    char type;  // 'b', 'i', 'f', 'd', or 0 if ignored
+    uint32_t size;
+    uint32_t offset;
+    // record header without the timestamp: header byte (without timestamp
+    // length bits), entry ID, and payload size
+    uint8_t headerLen;
+    uint8_t header[9];
+  };
+
+  void AppendUnbatched(std::span<const uint8_t> data, int64_t timestamp);
+
+  DataLog* m_log = nullptr;
+  std::vector<FieldInfo> m_fields;
+  size_t m_size = 0;
+  // size of all records, not including the timestamps
+  size_t m_recordsSize = 0;
+  bool m_allDouble = true;
+};
+
 }  // namespace wpi::log
@@ -6,6 +6,7 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <functional>
 #include <span>
 #include <string>
@@ -22,6 +23,40 @@ class Logger;
 
 namespace wpi::log {
 
+/**
+ * Options for how DataLogBackgroundWriter writes log files.
+ */
+struct DataLogFileOptions {
+  /**
+   * Size of the file extents reserved ahead of the data written, in bytes;
+   * 0 disables preallocation.  Growing the file in large chunks avoids a file
+   * system metadata update on most writes, which can stall for hundreds of
+   * milliseconds on some storage (e.g. FAT-formatted USB drives).
+   */
+  uint64_t preallocateSize = 8 * 1024 * 1024;
+
+  /**
+   * Minimum time between syncs of the file to storage, in seconds; 0 syncs
+   * after every flush.  Syncs (and preallocation) run on a separate thread,
+   * so a slow sync doesn't delay writing out buffered log data.
+   */
+  double syncPeriod = 0;
+
+  /**
+   * If true, bypass the operating system page cache (O_DIRECT), writing the
+   * file in aligned blocks.  Only supported on Linux; ignored on other
+   * platforms or if the file system doesn't support it.
+   */
+  bool directIO = false;
+
+  /**
+   * Amount of log data, in bytes, that may be buffered in memory beyond the
+   * normal limit while writes to storage are stalled.  Logging is paused
+   * only when this is exceeded as well.
+   */
+  size_t spillBudget = 8 * 1024 * 1024;
+};
+
 /**
  * A data log background writer that periodically flushes the data log on a
  * background thread.  The data log file is created immediately upon
@@ -47,11 +82,16 @@ class DataLogBackgroundWriter final : public DataLog {
    * @param period time between automatic flushes to disk, in seconds;
    *               this is a time/storage tradeoff
    * @param extraHeader extra header data
+   * @param compress if true, write files in the compressed container format
+   *                 (see DataLogCompressor); DataLogReader reads either format
+   * @param options file writing options
    */
   explicit DataLogBackgroundWriter(std::string_view dir = "",
                                    std::string_view filename = "",
                                    double period = 0.25,
-                                   std::string_view extraHeader = "");
+                                   std::string_view extraHeader = "",
+                                   bool compress = false,
+                                   const DataLogFileOptions& options = {});
 
   /**
    * Construct a new Data Log.  The log will be initially created with a
@@ -64,12 +104,17 @@ class DataLogBackgroundWriter final : public DataLog {
    * @param period time between automatic flushes to disk, in seconds;
    *               this is a time/storage tradeoff
    * @param extraHeader extra header data
+   * @param compress if true, write files in the compressed container format
+   *                 (see DataLogCompressor); DataLogReader reads either format
+   * @param options file writing options
    */
   explicit DataLogBackgroundWriter(wpi::Logger& msglog,
                                    std::string_view dir = "",
                                    std::string_view filename = "",
                                    double period = 0.25,
-                                   std::string_view extraHeader = "");
+                                   std::string_view extraHeader = "",
+                                   bool compress = false,
+                                   const DataLogFileOptions& options = {});
 
   /**
    * Construct a new Data Log that passes its output to the provided function
@@ -141,6 +186,48 @@ class DataLogBackgroundWriter final : public DataLog {
    */
   void Stop() final;
 
+  /**
+   * Background writer statistics.  Counters are cumulative since the writer
+   * was constructed.
+   */
+  struct WriterStats {
+    /** Number of bytes written (after compression, if enabled). */
+    uint64_t bytesWritten = 0;
+
+    /**
+     * Number of log bytes discarded because there was no file to write to or
+     * free space was low.
+     */
+    uint64_t bytesDiscarded = 0;
+
+    /** Number of flushes that wrote data. */
+    uint64_t flushCount = 0;
+
+    /** Duration of the most recent flush (write and sync), in microseconds. */
+    int64_t lastFlushTime = 0;
+
+    /** Longest flush duration, in microseconds. */
+    int64_t maxFlushTime = 0;
+  };
+
+  /**
+   * Gets the background writer statistics.  See also GetStats().
+   *
+   * @return Statistics
+   */
+  WriterStats GetWriterStats() const;
+
+  /**
+   * Enables or disables logging statistics into the log itself.  When enabled,
+   * int64 records are appended before each flush to the entries
+   * "/.datalog/bytes" (cumulative data bytes appended),
+   * "/.datalog/droppedRecords", "/.datalog/buffersInFlight", and
+   * "/.datalog/flushTime" (duration of the previous flush, in microseconds).
+   *
+   * @param enable true to enable
+   */
+  void SetStatsLogging(bool enable);
+
  private:
   struct WriterThreadState;
 
@@ -148,7 +235,13 @@ class DataLogBackgroundWriter final : public DataLog {
   bool BufferFull() final;
 
   void StartLogFile(WriterThreadState& state);
-  void WriterThreadMain(std::string_view dir);
+  // must be called from the writer thread without m_mutex held
+  void LogStats(int64_t flushTime);
+  // must be called with m_mutex held
+  void UpdateWriterStats(int64_t flushTime, uint64_t written,
+                         uint64_t discarded);
+  void WriterThreadMain(std::string_view dir, bool compress,
+                        const DataLogFileOptions& options);
   void WriterThreadMain(
       std::function<void(std::span<const uint8_t> data)> write);
 
@@ -164,6 +257,20 @@ class DataLogBackgroundWriter final : public DataLog {
   } m_state = kActive;
   double m_period;
   std::string m_newFilename;
+  WriterStats m_writerStats;
+  bool m_logStats{false};
+  // buffers allocated beyond the normal limit since the last flush
+  std::atomic<size_t> m_spillBuffers{0};
+  size_t m_spillBudget{0};
+
+  // only used by the writer thread
+  struct StatsEntries {
+    int bytes = 0;
+    int droppedRecords = 0;
+    int buffersInFlight = 0;
+    int flushTime = 0;
+  } m_statsEntries;
+
   std::thread m_thread;
 };
 
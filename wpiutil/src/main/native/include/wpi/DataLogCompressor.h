@@ -0,0 +1,115 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <span>
+#include <vector>
+
+namespace wpi::log {
+
+namespace impl {
+
+// Compressed data log container layout (all integers little endian):
+//   8-byte magic: "WPILOGZ" followed by container version (1)
+//   blocks, each:
+//     4-byte compressed size (equal to uncompressed size if stored raw)
+//     4-byte uncompressed size
+//     8-byte timestamp of the first record in the block
+//     LZ4 block format data (or raw data)
+//   index (only present if the log was closed cleanly), per block:
+//     8-byte file offset of block
+//     8-byte offset of block contents in the uncompressed log
+//     8-byte timestamp of the first record in the block
+//   4-byte number of index entries
+//   4-byte index magic: "WLZI"
+//
+// The concatenated block contents form a regular uncompressed data log.  Each
+// block contains only complete records, so records can be read starting at
+// any block without decompressing earlier blocks.
+inline constexpr uint8_t kCompressedMagic[8] = {'W', 'P', 'I', 'L',
+                                                'O', 'G', 'Z', 1};
+inline constexpr uint8_t kCompressedIndexMagic[4] = {'W', 'L', 'Z', 'I'};
+inline constexpr size_t kCompressedBlockHeaderSize = 16;
+inline constexpr size_t kCompressedIndexEntrySize = 24;
+inline constexpr size_t kCompressedIndexTrailerSize = 8;
+
+}  // namespace impl
+
+/**
+ * Converts an uncompressed data log byte stream (as produced by DataLog) into
+ * the compressed data log container format, which DataLogReader can read
+ * directly.  Records are grouped into independently compressed blocks, and an
+ * index of blocks is appended by Finish().
+ */
+class DataLogCompressor {
+ public:
+  /**
+   * Constructs a compressor.
+   *
+   * @param blockSize target uncompressed block size, in bytes; blocks end at
+   *                  the first record boundary after this size
+   */
+  explicit DataLogCompressor(size_t blockSize = 256 * 1024)
+      : m_blockSize{blockSize} {}
+
+  /**
+   * Appends uncompressed log data.  Data must be provided in order starting
+   * with the file header, but may be split at arbitrary points.  Compressed
+   * data for any completed blocks is appended to out.
+   *
+   * @param data uncompressed log data
+   * @param out output buffer
+   */
+  void Write(std::span<const uint8_t> data, std::vector<uint8_t>& out);
+
+  /**
+   * Ends the current block at the last complete record, so all complete
+   * records written so far are in the output.  Call this before syncing the
+   * output to storage; blocks get smaller if this is called frequently.
+   *
+   * @param out output buffer
+   */
+  void Flush(std::vector<uint8_t>& out);
+
+  /**
+   * Flushes and appends the block index.  No more data may be written after
+   * this is called.
+   *
+   * @param out output buffer
+   */
+  void Finish(std::vector<uint8_t>& out);
+
+ private:
+  void Start(std::vector<uint8_t>& out);
+  void ParseRecords();
+  void WriteBlock(size_t size, std::vector<uint8_t>& out);
+
+  size_t m_blockSize;
+  bool m_started = false;
+  uint64_t m_fileOffset = 0;
+  uint64_t m_uncompressedOffset = 0;
+
+  // uncompressed data not yet in a block
+  std::vector<uint8_t> m_pending;
+  // offset in m_pending of the next record header, and of the end of the last
+  // complete record
+  size_t m_nextRecord = 0;
+  size_t m_lastBoundary = 0;
+  bool m_headerParsed = false;
+  // timestamp of the first record in m_pending
+  int64_t m_firstTimestamp = 0;
+  bool m_haveTimestamp = false;
+
+  struct IndexEntry {
+    uint64_t fileOffset;
+    uint64_t uncompressedOffset;
+    int64_t timestamp;
+  };
+  std::vector<IndexEntry> m_index;
+};
+
+}  // namespace wpi::log
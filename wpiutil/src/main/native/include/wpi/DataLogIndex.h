@@ -0,0 +1,152 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "wpi/DataLogReader.h"
+#include "wpi/function_ref.h"
+
+namespace wpi {
+class raw_ostream;
+}  // namespace wpi
+
+namespace wpi::log {
+
+/**
+ * Index of a data log, for reading the records of an entry within a timestamp
+ * range without scanning the whole log.
+ *
+ * The log is divided into spans of roughly equal size.  For each entry, the
+ * index stores the range of timestamps of the entry's records in each span
+ * they appear in, so only spans that may contain matching records are read.
+ *
+ * Building the index requires one sequential scan of the log.  The index can
+ * be saved to and loaded from a sidecar file to avoid repeating the scan.
+ *
+ * The reader must outlive the index and must not be moved.
+ */
+class DataLogIndex {
+ public:
+  /** Default span size, in bytes. */
+  static constexpr size_t kDefaultSpanSize = 64 * 1024;
+
+  /** Entry information.  Each Start of an entry ID gets its own EntryInfo. */
+  struct EntryInfo {
+    /** Entry ID. */
+    int entry;
+
+    /** Entry name. */
+    std::string name;
+
+    /** Entry type. */
+    std::string type;
+
+    /** Initial metadata. */
+    std::string metadata;
+
+    /** Log position of the start record. */
+    size_t startPos;
+
+    /** Log position of the finish record, or SIZE_MAX if not finished. */
+    size_t finishPos;
+  };
+
+  /**
+   * Builds an index by scanning the log.
+   *
+   * @param reader data log reader
+   * @param spanSize span size, in bytes; smaller spans make queries read less
+   *                 data but make the index larger
+   */
+  explicit DataLogIndex(const DataLogReader& reader,
+                        size_t spanSize = kDefaultSpanSize);
+
+  /**
+   * Loads an index previously written by Save().
+   *
+   * @param reader data log reader
+   * @param data saved index
+   * @return Index, or empty if the data is invalid or doesn't match the log
+   *         (e.g. because the log has changed since the index was saved)
+   */
+  static std::optional<DataLogIndex> Load(const DataLogReader& reader,
+                                          std::span<const uint8_t> data);
+
+  /**
+   * Loads an index from a sidecar file, or builds it (and tries to save it
+   * to the sidecar file) if the file doesn't exist or doesn't match the log.
+   *
+   * @param reader data log reader
+   * @param filename sidecar filename, e.g. the log filename plus ".idx"
+   * @return Index
+   */
+  static DataLogIndex LoadOrBuild(const DataLogReader& reader,
+                                  std::string_view filename);
+
+  /**
+   * Saves the index.
+   *
+   * @param os output stream
+   */
+  void Save(wpi::raw_ostream& os) const;
+
+  /**
+   * Gets all entries, in order of their start records.
+   *
+   * @return Entries
+   */
+  std::span<const EntryInfo> GetEntries() const { return m_entries; }
+
+  /**
+   * Finds the most recently started entry with a given name.
+   *
+   * @param name entry name
+   * @return Index into GetEntries(), or empty if not found
+   */
+  std::optional<size_t> Find(std::string_view name) const;
+
+  /**
+   * Calls a function for each data record of an entry with a timestamp in a
+   * given range, in log order.
+   *
+   * @param index index into GetEntries()
+   * @param start start timestamp (inclusive)
+   * @param end end timestamp (inclusive)
+   * @param func function to call
+   */
+  void ForEachRecord(
+      size_t index, int64_t start, int64_t end,
+      function_ref<void(const DataLogRecord& record)> func) const;
+
+ private:
+  struct SpanRange {
+    uint32_t span;
+    int64_t minTimestamp;
+    int64_t maxTimestamp;
+  };
+
+  DataLogIndex(const DataLogReader* reader, size_t spanSize)
+      : m_reader{reader}, m_spanSize{spanSize} {}
+
+  const DataLogReader* m_reader;
+  size_t m_spanSize;
+  // log position of the first record in each span
+  std::vector<size_t> m_spans;
+  std::vector<EntryInfo> m_entries;
+  // parallel to m_entries
+  std::vector<std::vector<SpanRange>> m_ranges;
+  // position of the last record, and the end of the log, when indexed
+  size_t m_lastRecordPos = SIZE_MAX;
+  size_t m_endPos = 0;
+};
+
+}  // namespace wpi::log
@@ -9,9 +9,12 @@
 #include <iterator>
 #include <memory>
 #include <span>
+#include <string_view>
+#include <system_error>
 #include <utility>
 #include <vector>
 
+#include "wpi/MappedFileRegion.h"
 #include "wpi/MemoryBuffer.h"
 
 namespace wpi::log {
@@ -295,8 +298,13 @@ class DataLogIterator {
   mutable DataLogRecord m_value;
 };
 
-/** Data log reader (reads logs written by the DataLog class). */
+/**
+ * Data log reader (reads logs written by the DataLog class).  Logs in the
+ * compressed container format (see DataLogCompressor) are also supported;
+ * their blocks are decompressed as records in them are accessed.
+ */
 class DataLogReader {
+  friend class DataLogIndex;
   friend class DataLogIterator;
 
  public:
@@ -305,6 +313,19 @@ class DataLogReader {
   /** Constructs from a memory buffer. */
   explicit DataLogReader(std::unique_ptr<MemoryBuffer> buffer);
 
+  /**
+   * Constructs from a file.  The file is memory mapped rather than read, so
+   * only the parts of the file that are accessed are paged in.
+   *
+   * @param filename filename
+   * @param ec error code output, set to non-zero on error
+   */
+  DataLogReader(std::string_view filename, std::error_code& ec);
+
+  ~DataLogReader();
+  DataLogReader(DataLogReader&&);
+  DataLogReader& operator=(DataLogReader&&);
+
   /** Returns true if the data log is valid (e.g. has a valid header). */
   explicit operator bool() const { return IsValid(); }
 
@@ -341,9 +362,50 @@ class DataLogReader {
   /** Returns end iterator. */
   iterator end() const { return DataLogIterator{this, SIZE_MAX}; }
 
+  /**
+   * Returns true if the data log is in the compressed container format.
+   */
+  bool IsCompressed() const { return m_compressed != nullptr; }
+
+  /**
+   * Gets the number of independently compressed blocks.
+   *
+   * @return Number of blocks; always 0 for uncompressed logs
+   */
+  size_t GetBlockCount() const;
+
+  /**
+   * Gets the timestamp of the first record in a compressed block.  Records are
+   * not guaranteed to be sorted by timestamp, so this should only be used as a
+   * hint for where to start reading.
+   *
+   * @param block block number
+   * @return Timestamp, or 0 if the block doesn't exist
+   */
+  int64_t GetBlockTimestamp(size_t block) const;
+
+  /**
+   * Returns iterator to the first record in a compressed block.  Earlier
+   * blocks are not decompressed.
+   *
+   * @param block block number
+   * @return Iterator, or end() if the block doesn't exist
+   */
+  iterator BlockBegin(size_t block) const;
+
  private:
+  struct CompressedData;
+
+  void Init();
+
+  MappedFileRegion m_mapping;
   std::unique_ptr<MemoryBuffer> m_buf;
+  std::unique_ptr<CompressedData> m_compressed;
 
+  // Gets the log contents, starting at the beginning of the (uncompressed)
+  // log.  For compressed logs, this ensures the block containing pos (and the
+  // one after it) are decompressed, and the result ends after those blocks.
+  std::span<const uint8_t> GetBuffer(size_t pos) const;
   bool GetRecord(size_t* pos, DataLogRecord* out) const;
   bool GetNextRecord(size_t* pos) const;
 };
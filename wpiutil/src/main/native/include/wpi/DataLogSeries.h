@@ -0,0 +1,187 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "wpi/DataLogReader.h"
+#include "wpi/SmallVector.h"
+#include "wpi/StringMap.h"
+#include "wpi/function_ref.h"
+
+namespace wpi::log {
+
+/**
+ * Decoded values of the entries of a data log, stored compactly per entry for
+ * fast random access without rereading the log.
+ *
+ * Entries of type "boolean", "int64", "float", "double", and "string" are
+ * decoded; other entries are ignored. All records of entries with the same
+ * name form one series, sorted by timestamp. Timestamps are stored as
+ * variable-length deltas, values as arrays of their type, and each distinct
+ * string only once.
+ *
+ * Decoding requires one sequential scan of the log. The reader is not needed
+ * afterwards.
+ */
+class DataLogSeries {
+  // interned strings
+  class Strings;
+
+ public:
+  /** Value type of a series. */
+  enum Type { kBoolean, kInteger, kFloat, kDouble, kString };
+
+  /** Minimum and maximum value of a range of samples. */
+  struct MinMax {
+    /** Timestamp of the first sample in the range. */
+    int64_t timestamp;
+
+    /** Minimum value. */
+    double min;
+
+    /** Maximum value. */
+    double max;
+  };
+
+  /** Samples of one entry. */
+  class Series {
+    friend class DataLogSeries;
+
+   public:
+    /** Entry name. */
+    std::string_view GetName() const { return m_name; }
+
+    /** Entry type string, e.g. "double". */
+    std::string_view GetTypeString() const { return m_typeStr; }
+
+    /** Value type. */
+    Type GetType() const { return m_type; }
+
+    /** Number of samples. */
+    size_t size() const { return m_size; }
+
+    /** Returns true if there are no samples. */
+    bool empty() const { return m_size == 0; }
+
+    /**
+     * Gets the timestamp of a sample.
+     *
+     * @param index sample index
+     * @return Timestamp
+     */
+    int64_t GetTimestamp(size_t index) const;
+
+    /**
+     * Gets the value of a sample of a boolean or numeric series as a double.
+     * Booleans are 0 or 1.
+     *
+     * @param index sample index
+     * @return Value, or 0 for string series
+     */
+    double GetDouble(size_t index) const;
+
+    /**
+     * Gets the value of a sample of a string series.
+     *
+     * @param index sample index
+     * @return Value, or empty for other series
+     */
+    std::string_view GetString(size_t index) const;
+
+    /**
+     * Finds the first sample at or after a timestamp.
+     *
+     * @param timestamp timestamp
+     * @return Sample index, or size() if all samples are earlier
+     */
+    size_t LowerBound(int64_t timestamp) const;
+
+    /**
+     * Calls a function for each sample with a timestamp in a given range, in
+     * timestamp order. This is faster than calling GetTimestamp() for each
+     * sample.
+     *
+     * @param start start timestamp (inclusive)
+     * @param end end timestamp (inclusive)
+     * @param func function to call with the sample index and timestamp
+     */
+    void ForEach(
+        int64_t start, int64_t end,
+        function_ref<void(size_t index, int64_t timestamp)> func) const;
+
+    /**
+     * Decimates the samples of a boolean or numeric series in a given range,
+     * e.g. for plotting. The range is divided into equal time buckets, and
+     * the minimum and maximum value of each non-empty bucket is returned.
+     *
+     * @param start start timestamp (inclusive)
+     * @param end end timestamp (inclusive)
+     * @param buckets number of buckets
+     * @return Minimum and maximum of each non-empty bucket, in order
+     */
+    std::vector<MinMax> Decimate(int64_t start, int64_t end,
+                                 size_t buckets) const;
+
+   private:
+    // samples per block of timestamp deltas
+    static constexpr size_t kBlockSize = 64;
+
+    std::string m_name;
+    std::string m_typeStr;
+    Type m_type;
+    size_t m_size = 0;
+    // first timestamp of each block, and offset of its deltas in m_deltas
+    std::vector<int64_t> m_blockTimestamps;
+    std::vector<size_t> m_blockOffsets;
+    wpi::SmallVector<char, 0> m_deltas;
+    // only the one for m_type is used
+    std::vector<uint8_t> m_booleans;
+    std::vector<int64_t> m_integers;
+    std::vector<float> m_floats;
+    std::vector<double> m_doubles;
+    std::vector<uint32_t> m_strings;  // indexes into the string table
+    const Strings* m_stringTable = nullptr;
+  };
+
+  /**
+   * Decodes a data log.
+   *
+   * @param reader data log reader
+   */
+  explicit DataLogSeries(const DataLogReader& reader);
+
+  ~DataLogSeries();
+  DataLogSeries(DataLogSeries&&);
+  DataLogSeries& operator=(DataLogSeries&&);
+
+  /**
+   * Gets all series, in order of the first start record of each entry name.
+   *
+   * @return Series
+   */
+  std::span<const Series> GetSeries() const { return m_series; }
+
+  /**
+   * Finds the series of an entry.
+   *
+   * @param name entry name
+   * @return Series, or nullptr if not found
+   */
+  const Series* Find(std::string_view name) const;
+
+ private:
+  std::vector<Series> m_series;
+  wpi::StringMap<size_t> m_seriesByName;
+  std::unique_ptr<Strings> m_strings;
+};
+
+}  // namespace wpi::log
@@ -0,0 +1,101 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <span>
+#include <vector>
+
+namespace wpi {
+
+/**
+ * Compressor for the raw DEFLATE format (RFC 1951).
+ *
+ * Each call to Compress() compresses its input independently, so a compressor
+ * may be shared by unrelated streams. The compressor keeps its match tables
+ * between calls to avoid reallocating them.
+ */
+class DeflateCompressor {
+ public:
+  /**
+   * Constructs a compressor.
+   *
+   * @param windowBits base 2 logarithm of the maximum distance of matches
+   *                   (8-15); decompressors with a window at least this large
+   *                   can decompress the output
+   */
+  explicit DeflateCompressor(int windowBits = 15);
+
+  /**
+   * Compresses data into DEFLATE blocks, none of which is marked final. The
+   * output ends with an empty stored block (what zlib calls a sync flush), so
+   * it ends on a byte boundary with the bytes 00 00 FF FF.
+   *
+   * @param in data to compress
+   * @param out output; compressed data is appended
+   */
+  void Compress(std::span<const uint8_t> in, std::vector<uint8_t>& out);
+
+ private:
+  struct Symbol {
+    uint16_t value;     // literal byte, or match length
+    uint16_t distance;  // 0 for literals
+  };
+
+  void Match(std::span<const uint8_t> in);
+  size_t FindMatch(std::span<const uint8_t> in, size_t pos, size_t* distance);
+  void Insert(std::span<const uint8_t> in, size_t pos);
+  void AddSymbol(std::span<const uint8_t> in, Symbol symbol, size_t length);
+  void WriteBlock(std::span<const uint8_t> in);
+
+  int m_windowBits;
+  int m_hashBits = 0;
+  // position + 1 of the last occurrence of each hashed 3 byte sequence
+  std::vector<uint32_t> m_head;
+  // position + 1 of the previous occurrence of the sequence at each position
+  std::vector<uint32_t> m_prev;
+  size_t m_prevMask = 0;
+  // symbols of the current block, and the input they cover
+  std::vector<Symbol> m_symbols;
+  size_t m_blockStart = 0;
+  size_t m_blockEnd = 0;
+  std::vector<uint8_t>* m_out = nullptr;
+  uint64_t m_bitBuf = 0;
+  int m_bitCount = 0;
+};
+
+/**
+ * Decompressor for the raw DEFLATE format (RFC 1951).
+ *
+ * The last 32 KB of output are kept between calls to Decompress(), so data
+ * that refers back to earlier output (e.g. consecutive sync flushed parts of
+ * one DEFLATE stream) can be decompressed.
+ */
+class DeflateDecompressor {
+ public:
+  /**
+   * Forgets earlier output, to start decompressing a new stream.
+   */
+  void Reset() { m_window.clear(); }
+
+  /**
+   * Decompresses DEFLATE blocks. The input must end at the end of a block
+   * (e.g. after a sync flush) or of the final block.
+   *
+   * @param in compressed data
+   * @param out output; decompressed data is appended
+   * @param maxSize maximum number of bytes to decompress
+   * @return False if the data is malformed or truncated, or decompresses to
+   *         more than maxSize bytes
+   */
+  bool Decompress(std::span<const uint8_t> in, std::vector<uint8_t>& out,
+                  size_t maxSize = SIZE_MAX);
+
+ private:
+  std::vector<uint8_t> m_window;
+};
+
+}  // namespace wpi
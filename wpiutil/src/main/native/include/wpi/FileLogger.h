@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <stddef.h>
+
 #include <functional>
 #include <string_view>
 #include <thread>
@@ -14,9 +16,18 @@ namespace wpi {
 /**
  * A class version of `tail -f`, otherwise known as `tail -f` at home.  Watches
  * a file and puts the data somewhere else. Only works on Linux-based platforms.
+ *
+ * Appended data is read at most every 100 ms, so bursts of lines are passed
+ * to the callback in a single call.  At most kMaxReadSize bytes are passed
+ * per read; if more data was appended (e.g. the console is being flooded),
+ * the excess is skipped and replaced with a line giving the number of bytes
+ * skipped, so the logger never falls behind the file.
  */
 class FileLogger {
  public:
+  /** Maximum number of bytes passed to the callback per read. */
+  static constexpr size_t kMaxReadSize = 64 * 1024;
+
   FileLogger() = default;
   /**
    * Construct a FileLogger. When the specified file is modified, the callback
@@ -0,0 +1,146 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stddef.h>
+
+#include <functional>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace wpi {
+
+/**
+ * Fixed-capacity pool of objects of a single type.
+ *
+ * All storage is allocated at construction; allocating and freeing objects
+ * afterwards is constant time and never calls the global allocator, so it is
+ * safe to use in real-time loops. Allocation fails (returns nullptr) when the
+ * pool is exhausted.
+ *
+ * Objects must be deleted before the pool is destroyed. This class is not
+ * thread safe.
+ *
+ * @tparam T object type
+ */
+template <typename T>
+class FixedPool {
+ public:
+  /**
+   * Constructs a pool.
+   *
+   * @param capacity maximum number of objects
+   */
+  explicit FixedPool(size_t capacity)
+      : m_slots{new Slot[capacity]}, m_capacity{capacity} {
+    for (size_t i = capacity; i > 0; --i) {
+      m_slots[i - 1].next = m_free;
+      m_free = &m_slots[i - 1];
+    }
+  }
+
+  FixedPool(const FixedPool&) = delete;
+  FixedPool& operator=(const FixedPool&) = delete;
+
+  /**
+   * Allocates uninitialized storage for one object.
+   *
+   * @return storage, or nullptr if the pool is exhausted
+   */
+  void* Allocate() noexcept {
+    Slot* slot = m_free;
+    if (!slot) {
+      return nullptr;
+    }
+    m_free = slot->next;
+    ++m_size;
+    return slot->storage;
+  }
+
+  /**
+   * Frees storage returned by Allocate().
+   *
+   * @param p storage
+   */
+  void Deallocate(void* p) noexcept {
+    Slot* slot = reinterpret_cast<Slot*>(p);
+    slot->next = m_free;
+    m_free = slot;
+    --m_size;
+  }
+
+  /**
+   * Allocates and constructs an object.
+   *
+   * @param args constructor arguments
+   * @return object, or nullptr if the pool is exhausted
+   */
+  template <typename... Args>
+  T* New(Args&&... args) {
+    void* p = Allocate();
+    if (!p) {
+      return nullptr;
+    }
+    try {
+      return new (p) T(std::forward<Args>(args)...);
+    } catch (...) {
+      Deallocate(p);
+      throw;
+    }
+  }
+
+  /**
+   * Destroys and frees an object returned by New().
+   *
+   * @param obj object; may be nullptr
+   */
+  void Delete(T* obj) {
+    if (obj) {
+      obj->~T();
+      Deallocate(obj);
+    }
+  }
+
+  /**
+   * Returns true if the pointer is to storage in this pool.
+   *
+   * @param p pointer
+   * @return True if in this pool
+   */
+  bool Owns(const void* p) const noexcept {
+    const Slot* begin = m_slots.get();
+    auto slot = static_cast<const Slot*>(p);
+    return std::less_equal<>{}(begin, slot) &&
+           std::less<>{}(slot, begin + m_capacity);
+  }
+
+  /**
+   * Gets the maximum number of objects.
+   *
+   * @return Capacity
+   */
+  size_t Capacity() const noexcept { return m_capacity; }
+
+  /**
+   * Gets the number of allocated objects.
+   *
+   * @return Number of objects
+   */
+  size_t Size() const noexcept { return m_size; }
+
+ private:
+  union Slot {
+    Slot* next;
+    alignas(T) unsigned char storage[sizeof(T)];
+  };
+
+  std::unique_ptr<Slot[]> m_slots;
+  size_t m_capacity;
+  size_t m_size = 0;
+  Slot* m_free = nullptr;
+};
+
+}  // namespace wpi
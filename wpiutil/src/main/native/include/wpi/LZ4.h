@@ -0,0 +1,46 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <span>
+
+namespace wpi {
+
+/**
+ * Gets the maximum size of LZ4Compress() output for a given input size.
+ *
+ * @param size input size, in bytes
+ * @return Maximum compressed size, in bytes
+ */
+constexpr size_t LZ4CompressBound(size_t size) {
+  return size + size / 255 + 16;
+}
+
+/**
+ * Compresses data into the LZ4 block format.  This is a fast, single pass
+ * compressor that favors speed over compression ratio; any LZ4 block
+ * decompressor can decompress the output.
+ *
+ * @param in data to compress
+ * @param out output buffer; must be at least LZ4CompressBound(in.size()) bytes
+ * @return Number of bytes written to out
+ */
+size_t LZ4Compress(std::span<const uint8_t> in, std::span<uint8_t> out);
+
+/**
+ * Decompresses LZ4 block format data.  The decompressed size is not stored in
+ * the LZ4 block format, so it must be known by the caller.
+ *
+ * @param in compressed data
+ * @param out output buffer; must be exactly the decompressed size
+ * @return False if the compressed data is malformed or doesn't decompress to
+ *         exactly out.size() bytes
+ */
+bool LZ4Decompress(std::span<const uint8_t> in, std::span<uint8_t> out);
+
+}  // namespace wpi
@@ -0,0 +1,100 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stddef.h>
+
+#include <memory>
+#include <memory_resource>
+#include <optional>
+
+#include "wpi/CountingResource.h"
+
+namespace wpi {
+
+/**
+ * Memory arena for temporary storage that is freed all at once.
+ *
+ * Allocations are bump allocated from a single buffer and are only freed by
+ * Reset(). If more memory is needed than the buffer holds, the extra is
+ * allocated from the heap, and the buffer is grown on the next Reset() so
+ * that the same allocation pattern no longer allocates from the heap at all.
+ *
+ * This class is not thread safe; see GetThreadArena() for a per-thread arena.
+ */
+class MonotonicArena : public std::pmr::memory_resource {
+ public:
+  /**
+   * Constructs an arena.
+   *
+   * @param initialSize initial buffer size, in bytes; if 0, the buffer is
+   *                    allocated at the first Reset() after use
+   */
+  explicit MonotonicArena(size_t initialSize = 0);
+
+  MonotonicArena(const MonotonicArena&) = delete;
+  MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+  /**
+   * Gets the memory resource to allocate from.
+   *
+   * @return memory resource
+   */
+  std::pmr::memory_resource* Resource() noexcept { return this; }
+
+  /**
+   * Frees all allocations, growing the buffer if it overflowed since the last
+   * reset. Nothing allocated from the arena may be used after this is called.
+   */
+  void Reset();
+
+  /**
+   * Gets the buffer size.
+   *
+   * @return buffer size, in bytes
+   */
+  size_t GetCapacity() const noexcept { return m_size; }
+
+  /**
+   * Gets the number of heap allocations made since the last reset because the
+   * buffer was full. In steady state this should be zero.
+   *
+   * @return number of heap allocations
+   */
+  uint64_t GetOverflowCount() const noexcept {
+    return m_upstream.GetAllocationCount();
+  }
+
+ private:
+  void* do_allocate(size_t bytes, size_t alignment) override {
+    return m_resource->allocate(bytes, alignment);
+  }
+  void do_deallocate(void* p, size_t bytes, size_t alignment) override {}
+  bool do_is_equal(
+      const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+
+  void Init(size_t size);
+
+  CountingResource m_upstream{std::pmr::new_delete_resource()};
+  std::unique_ptr<std::byte[]> m_buffer;
+  size_t m_size = 0;
+  std::optional<std::pmr::monotonic_buffer_resource> m_resource;
+};
+
+/**
+ * Gets the calling thread's arena.
+ *
+ * The main robot loop (IterativeRobotBase) resets its thread's arena at the
+ * start of every loop iteration, so on that thread memory allocated from this
+ * arena is valid until the end of the current robot cycle. Other threads must
+ * call Reset() themselves.
+ *
+ * @return arena
+ */
+MonotonicArena& GetThreadArena();
+
+}  // namespace wpi
@@ -0,0 +1,275 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "wpi/Synchronization.h"
+
+namespace wpi {
+
+namespace detail {
+
+/** Assumed cache line size, used to keep independently written data apart. */
+inline constexpr size_t kCacheLineSize = 64;
+
+/**
+ * Blocking support for the lock-free queues. A consumer that finds the queue
+ * empty registers as a waiter and waits on a semaphore; producers only touch
+ * the semaphore when there are waiters, so pushing stays lock-free when no
+ * consumer is blocked.
+ */
+class QueueWaiter {
+ public:
+  /** Wakes a waiting consumer (if any); call after each push. */
+  void Notify() {
+    // order the push before the waiter check; pairs with the fence in Wait()
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_waiters.load(std::memory_order_relaxed) > 0) {
+      m_sem.Release();
+    }
+  }
+
+  /**
+   * Calls tryPop until it returns a value or the timeout expires.
+   *
+   * @param tryPop function returning std::optional
+   * @param timeout timeout in seconds; negative for no timeout
+   * @return result of the last call to tryPop
+   */
+  template <typename F>
+  auto Wait(F&& tryPop, double timeout) -> decltype(tryPop()) {
+    if (auto value = tryPop()) {
+      return value;
+    }
+    if (timeout == 0) {
+      return {};
+    }
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::duration<double>(timeout));
+    m_waiters.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    decltype(tryPop()) value;
+    for (;;) {
+      value = tryPop();
+      if (value) {
+        break;
+      }
+      double remaining = -1;
+      if (timeout > 0) {
+        remaining = std::chrono::duration<double>(
+                        deadline - std::chrono::steady_clock::now())
+                        .count();
+        if (remaining <= 0) {
+          break;
+        }
+      }
+      // permits may be left over from earlier pushes, so this can wake
+      // without anything to pop
+      bool timedOut;
+      WaitForObject(m_sem.GetHandle(), remaining, &timedOut);
+    }
+    m_waiters.fetch_sub(1, std::memory_order_relaxed);
+    return value;
+  }
+
+ private:
+  std::atomic<int> m_waiters{0};
+  Semaphore m_sem;
+};
+
+}  // namespace detail
+
+/**
+ * Bounded lock-free multi-producer, multi-consumer queue.
+ *
+ * Any thread may push and pop. TryPush() and TryPop() never block; Pop()
+ * blocks until a value is available. Values are popped in the order their
+ * pushes completed claiming a slot. The capacity is fixed at construction.
+ *
+ * The element type must be nothrow move constructible.
+ *
+ * @tparam T element type
+ */
+template <typename T>
+class MpmcQueue {
+  static_assert(std::is_nothrow_move_constructible_v<T>);
+
+ public:
+  /**
+   * Constructs a queue.
+   *
+   * @param capacity maximum number of elements; rounded up to a power of 2
+   */
+  explicit MpmcQueue(size_t capacity)
+      : m_mask{std::bit_ceil(std::max<size_t>(capacity, 2)) - 1},
+        m_cells{new Cell[m_mask + 1]} {
+    for (size_t i = 0; i <= m_mask; ++i) {
+      m_cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  ~MpmcQueue() {
+    while (TryPop()) {
+    }
+  }
+
+  MpmcQueue(const MpmcQueue&) = delete;
+  MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+  /**
+   * Pushes a value if the queue isn't full.
+   *
+   * @param value value
+   * @return False if the queue was full
+   */
+  bool TryPush(T&& value) { return Push(std::move(value)); }
+
+  /**
+   * Pushes a value if the queue isn't full.
+   *
+   * @param value value
+   * @return False if the queue was full
+   */
+  bool TryPush(const T& value) { return Push(T{value}); }
+
+  /**
+   * Constructs and pushes a value if the queue isn't full.
+   *
+   * @param args constructor arguments
+   * @return False if the queue was full
+   */
+  template <typename... Args>
+  bool TryEmplace(Args&&... args) {
+    return Push(T(std::forward<Args>(args)...));
+  }
+
+  /**
+   * Pops a value if one is available.
+   *
+   * @return Value, or empty if the queue was empty
+   */
+  std::optional<T> TryPop() {
+    size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+      cell = &m_cells[pos & m_mask];
+      size_t seq = cell->seq.load(std::memory_order_acquire);
+      auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+      if (diff == 0) {
+        if (m_dequeuePos.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return {};  // empty
+      } else {
+        pos = m_dequeuePos.load(std::memory_order_relaxed);
+      }
+    }
+    std::optional<T> value{std::move(*cell->Get())};
+    cell->Get()->~T();
+    cell->seq.store(pos + m_mask + 1, std::memory_order_release);
+    return value;
+  }
+
+  /**
+   * Pops a value, waiting until one is available.
+   *
+   * @return Value
+   */
+  T Pop() {
+    return std::move(*m_waiter.Wait([&] { return TryPop(); }, -1));
+  }
+
+  /**
+   * Pops a value, waiting up to a timeout for one to be available.
+   *
+   * @param timeout timeout in seconds
+   * @return Value, or empty if the timeout expired
+   */
+  std::optional<T> Pop(double timeout) {
+    return m_waiter.Wait([&] { return TryPop(); }, timeout);
+  }
+
+  /**
+   * Gets the maximum number of elements.
+   *
+   * @return Capacity
+   */
+  size_t Capacity() const { return m_mask + 1; }
+
+  /**
+   * Gets the number of elements. This is only a snapshot if other threads
+   * are pushing or popping.
+   *
+   * @return Number of elements
+   */
+  size_t SizeApprox() const {
+    size_t dequeuePos = m_dequeuePos.load(std::memory_order_relaxed);
+    size_t enqueuePos = m_enqueuePos.load(std::memory_order_relaxed);
+    return enqueuePos > dequeuePos ? enqueuePos - dequeuePos : 0;
+  }
+
+  /**
+   * Returns true if the queue is empty. This is only a snapshot if other
+   * threads are pushing or popping.
+   *
+   * @return True if empty
+   */
+  bool Empty() const { return SizeApprox() == 0; }
+
+ private:
+  struct Cell {
+    T* Get() { return std::launder(reinterpret_cast<T*>(storage)); }
+
+    std::atomic<size_t> seq;
+    alignas(T) unsigned char storage[sizeof(T)];
+  };
+
+  bool Push(T&& value) {
+    size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+      cell = &m_cells[pos & m_mask];
+      size_t seq = cell->seq.load(std::memory_order_acquire);
+      auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (m_enqueuePos.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;  // full
+      } else {
+        pos = m_enqueuePos.load(std::memory_order_relaxed);
+      }
+    }
+    new (cell->storage) T(std::move(value));
+    cell->seq.store(pos + 1, std::memory_order_release);
+    m_waiter.Notify();
+    return true;
+  }
+
+  size_t m_mask;
+  std::unique_ptr<Cell[]> m_cells;
+  alignas(detail::kCacheLineSize) std::atomic<size_t> m_enqueuePos{0};
+  alignas(detail::kCacheLineSize) std::atomic<size_t> m_dequeuePos{0};
+  alignas(detail::kCacheLineSize) detail::QueueWaiter m_waiter;
+};
+
+}  // namespace wpi
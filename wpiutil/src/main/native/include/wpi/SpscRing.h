@@ -0,0 +1,185 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "wpi/MpmcQueue.h"
+
+namespace wpi {
+
+/**
+ * Bounded lock-free single-producer, single-consumer ring buffer.
+ *
+ * Only one thread at a time may push, and only one thread at a time may pop.
+ * The producer and consumer indexes are kept on separate cache lines, and
+ * each side caches the other's index, so in the common case a push or pop
+ * touches no cache line written by the other thread except the element.
+ *
+ * The element type must be nothrow move constructible.
+ *
+ * @tparam T element type
+ */
+template <typename T>
+class SpscRing {
+  static_assert(std::is_nothrow_move_constructible_v<T>);
+
+ public:
+  /**
+   * Constructs a ring.
+   *
+   * @param capacity maximum number of elements; rounded up to a power of 2
+   */
+  explicit SpscRing(size_t capacity)
+      : m_mask{std::bit_ceil(std::max<size_t>(capacity, 1)) - 1},
+        m_slots{new Slot[m_mask + 1]} {}
+
+  ~SpscRing() {
+    while (TryPop()) {
+    }
+  }
+
+  SpscRing(const SpscRing&) = delete;
+  SpscRing& operator=(const SpscRing&) = delete;
+
+  /**
+   * Pushes a value if the ring isn't full. Producer only.
+   *
+   * @param value value
+   * @return False if the ring was full
+   */
+  bool TryPush(T&& value) { return Push(std::move(value)); }
+
+  /**
+   * Pushes a value if the ring isn't full. Producer only.
+   *
+   * @param value value
+   * @return False if the ring was full
+   */
+  bool TryPush(const T& value) { return Push(T{value}); }
+
+  /**
+   * Constructs and pushes a value if the ring isn't full. Producer only.
+   *
+   * @param args constructor arguments
+   * @return False if the ring was full
+   */
+  template <typename... Args>
+  bool TryEmplace(Args&&... args) {
+    return Push(T(std::forward<Args>(args)...));
+  }
+
+  /**
+   * Pops a value if one is available. Consumer only.
+   *
+   * @return Value, or empty if the ring was empty
+   */
+  std::optional<T> TryPop() {
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail == m_cachedHead) {
+      m_cachedHead = m_head.load(std::memory_order_acquire);
+      if (tail == m_cachedHead) {
+        return {};
+      }
+    }
+    T* elem = m_slots[tail & m_mask].Get();
+    std::optional<T> value{std::move(*elem)};
+    elem->~T();
+    m_tail.store(tail + 1, std::memory_order_release);
+    return value;
+  }
+
+  /**
+   * Pops a value, waiting until one is available. Consumer only.
+   *
+   * @return Value
+   */
+  T Pop() {
+    return std::move(*m_waiter.Wait([&] { return TryPop(); }, -1));
+  }
+
+  /**
+   * Pops a value, waiting up to a timeout for one to be available. Consumer
+   * only.
+   *
+   * @param timeout timeout in seconds
+   * @return Value, or empty if the timeout expired
+   */
+  std::optional<T> Pop(double timeout) {
+    return m_waiter.Wait([&] { return TryPop(); }, timeout);
+  }
+
+  /**
+   * Gets the maximum number of elements.
+   *
+   * @return Capacity
+   */
+  size_t Capacity() const { return m_mask + 1; }
+
+  /**
+   * Gets the number of elements. This is only a snapshot if the other thread
+   * is pushing or popping.
+   *
+   * @return Number of elements
+   */
+  size_t SizeApprox() const {
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    size_t head = m_head.load(std::memory_order_relaxed);
+    return head > tail ? head - tail : 0;
+  }
+
+  /**
+   * Returns true if the ring is empty. This is only a snapshot if the other
+   * thread is pushing or popping.
+   *
+   * @return True if empty
+   */
+  bool Empty() const { return SizeApprox() == 0; }
+
+ private:
+  struct Slot {
+    T* Get() { return std::launder(reinterpret_cast<T*>(storage)); }
+
+    alignas(T) unsigned char storage[sizeof(T)];
+  };
+
+  bool Push(T&& value) {
+    size_t head = m_head.load(std::memory_order_relaxed);
+    if (head - m_cachedTail > m_mask) {
+      m_cachedTail = m_tail.load(std::memory_order_acquire);
+      if (head - m_cachedTail > m_mask) {
+        return false;
+      }
+    }
+    new (m_slots[head & m_mask].storage) T(std::move(value));
+    m_head.store(head + 1, std::memory_order_release);
+    m_waiter.Notify();
+    return true;
+  }
+
+  size_t m_mask;
+  std::unique_ptr<Slot[]> m_slots;
+
+  // written by the producer
+  alignas(detail::kCacheLineSize) std::atomic<size_t> m_head{0};
+  size_t m_cachedTail = 0;
+
+  // written by the consumer
+  alignas(detail::kCacheLineSize) std::atomic<size_t> m_tail{0};
+  size_t m_cachedHead = 0;
+
+  alignas(detail::kCacheLineSize) detail::QueueWaiter m_waiter;
+};
+
+}  // namespace wpi
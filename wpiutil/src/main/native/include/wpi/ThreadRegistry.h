@@ -0,0 +1,113 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wpi {
+
+/**
+ * Classes of library threads. Threads in the same class share a scheduling
+ * configuration.
+ */
+enum class ThreadClass {
+  /// Robot program main loop.
+  kMain = 0,
+  /// NetworkTables and other network event loops.
+  kNetwork,
+  /// Data log writers.
+  kLogging,
+  /// Camera source and sink threads.
+  kCamera,
+  /// Listener callback dispatch threads.
+  kListener,
+  /// HAL notifier threads.
+  kNotifier,
+  /// Number of thread classes.
+  kNumClasses
+};
+
+/**
+ * Scheduling configuration for a thread class.
+ */
+struct ThreadSchedule {
+  /// Real-time (SCHED_FIFO) priority 1-99, with 99 being highest, 0 for
+  /// standard (non-real-time) scheduling, or -1 to leave each thread's
+  /// scheduling policy and priority unchanged.
+  int priority = -1;
+
+  /// Bitmask of the CPUs threads may run on (bit 0 is CPU 0), or 0 for all
+  /// CPUs.
+  uint32_t cpuMask = 0;
+};
+
+/**
+ * Information about a registered thread.
+ */
+struct RegisteredThread {
+  /// Thread name.
+  std::string name;
+
+  /// Thread class.
+  ThreadClass threadClass;
+};
+
+/**
+ * Registers the calling thread as a thread of the given class, and applies
+ * the class's scheduling configuration to it if one has been set with
+ * SetThreadSchedule(). The thread is automatically
+ * unregistered when it exits. Calling this again on the same thread changes
+ * its class.
+ *
+ * Scheduling is only applied on Linux; on other platforms threads are only
+ * registered.
+ *
+ * @param threadClass thread class
+ * @param name thread name; this is also set as the operating system thread
+ *             name (truncated to 15 characters), except on the process main
+ *             thread, as that would rename the process
+ * @return False if applying the scheduling configuration failed.
+ */
+bool SetCurrentThreadClass(ThreadClass threadClass, std::string_view name);
+
+/**
+ * Sets the scheduling configuration for a thread class. This is applied to
+ * all currently registered threads of the class, and to threads registered
+ * later.
+ *
+ * For example, on the dual-core roboRIO, the main loop can be isolated on one
+ * core by setting kMain to {.priority = 40, .cpuMask = 0b10} and every other
+ * class to {.cpuMask = 0b01}; as no priority is given for the other classes,
+ * their threads (such as the real-time HAL notifier) keep their priority.
+ *
+ * Setting a real-time priority requires permission to do so; on the roboRIO
+ * robot programs have it.
+ *
+ * @param threadClass thread class
+ * @param schedule scheduling configuration
+ * @return True if the configuration was applied to all registered threads.
+ */
+bool SetThreadSchedule(ThreadClass threadClass, const ThreadSchedule& schedule);
+
+/**
+ * Gets the scheduling configuration for a thread class.
+ *
+ * @param threadClass thread class
+ * @return Scheduling configuration
+ */
+ThreadSchedule GetThreadSchedule(ThreadClass threadClass);
+
+/**
+ * Gets the currently registered threads.
+ *
+ * @return Registered threads
+ */
+std::vector<RegisteredThread> GetRegisteredThreads();
+
+}  // namespace wpi
@@ -107,6 +107,11 @@ class circular_buffer {
    */
   constexpr size_t size() const { return m_length; }
 
+  /**
+   * Returns true if the buffer has no elements
+   */
+  constexpr bool empty() const { return m_length == 0; }
+
   /**
    * Returns value at front of buffer
    */
@@ -257,7 +262,7 @@ class circular_buffer {
       }
 
       // Add elements to end of buffer
-      m_data.insert(m_data.begin() + insertLocation, size - m_data.size(), 0);
+      m_data.insert(m_data.begin() + insertLocation, size - m_data.size(), T{});
     } else if (size < m_data.size()) {
       /* 1) Shift element block start at "front" left as many blocks as were
        *    removed up to but not exceeding buffer[0]
@@ -0,0 +1,238 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "wpi/mutex.h"
+
+namespace wpi {
+
+/**
+ * Lock wait and hold time statistics. Times are in nanoseconds.
+ */
+struct LockStats {
+  /** Lock name; statistics for all locks with the same name are combined */
+  std::string name;
+
+  /** Number of times the lock was acquired */
+  uint64_t locks = 0;
+
+  /** Number of times lock() had to wait for another thread */
+  uint64_t contended = 0;
+
+  /** Total time spent waiting to acquire the lock */
+  uint64_t totalWait = 0;
+
+  /** Longest single wait to acquire the lock */
+  uint64_t maxWait = 0;
+
+  /** Total time the lock was held */
+  uint64_t totalHold = 0;
+
+  /** Longest single hold of the lock */
+  uint64_t maxHold = 0;
+};
+
+namespace detail {
+inline std::atomic_bool gLockProfilingEnabled{false};
+}  // namespace detail
+
+/**
+ * Enables or disables lock profiling. Profiling is disabled by default; while
+ * disabled, a profiled mutex costs one relaxed atomic load per operation on
+ * top of the underlying mutex.
+ *
+ * @param enabled true to enable
+ */
+inline void SetLockProfilingEnabled(bool enabled) {
+  detail::gLockProfilingEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+/**
+ * Returns true if lock profiling is enabled.
+ *
+ * @return True if enabled
+ */
+inline bool IsLockProfilingEnabled() {
+  return detail::gLockProfilingEnabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * Gets the statistics for all profiled locks, combined by name and sorted by
+ * name. Includes locks that have since been destroyed.
+ *
+ * @return statistics
+ */
+std::vector<LockStats> GetLockStats();
+
+/**
+ * Resets the statistics for all profiled locks.
+ */
+void ResetLockStats();
+
+namespace detail {
+
+/**
+ * Statistics for a single profiled mutex. Registers itself so that
+ * GetLockStats() can find it.
+ */
+class LockCounters {
+ public:
+  explicit LockCounters(std::string_view name);
+  ~LockCounters();
+
+  LockCounters(const LockCounters&) = delete;
+  LockCounters& operator=(const LockCounters&) = delete;
+
+  void AddLock() { m_locks.fetch_add(1, std::memory_order_relaxed); }
+
+  void AddWait(uint64_t ns) {
+    m_contended.fetch_add(1, std::memory_order_relaxed);
+    m_totalWait.fetch_add(ns, std::memory_order_relaxed);
+    UpdateMax(m_maxWait, ns);
+  }
+
+  void AddHold(uint64_t ns) {
+    m_totalHold.fetch_add(ns, std::memory_order_relaxed);
+    UpdateMax(m_maxHold, ns);
+  }
+
+  /** Adds the counts to stats; must be called with the registry locked. */
+  void AddTo(LockStats& stats) const;
+
+  /** Resets the counts; must be called with the registry locked. */
+  void Reset();
+
+  std::string_view GetName() const { return m_name; }
+
+ private:
+  static void UpdateMax(std::atomic<uint64_t>& max, uint64_t value) {
+    uint64_t prev = max.load(std::memory_order_relaxed);
+    while (prev < value &&
+           !max.compare_exchange_weak(prev, value, std::memory_order_relaxed)) {
+    }
+  }
+
+  std::string m_name;
+  std::atomic<uint64_t> m_locks{0};
+  std::atomic<uint64_t> m_contended{0};
+  std::atomic<uint64_t> m_totalWait{0};
+  std::atomic<uint64_t> m_maxWait{0};
+  std::atomic<uint64_t> m_totalHold{0};
+  std::atomic<uint64_t> m_maxHold{0};
+
+  // registry list, protected by the registry mutex
+  friend class LockRegistry;
+  LockCounters* m_prev = nullptr;
+  LockCounters* m_next = nullptr;
+};
+
+}  // namespace detail
+
+/**
+ * Mutex wrapper that records how long threads wait for and hold the lock
+ * (see GetLockStats()), to help find the cause of priority inversion and
+ * loop time spikes.
+ *
+ * The underlying mutex is wpi::mutex or wpi::recursive_mutex, so the lock
+ * keeps priority inheritance where wpi::mutex has it (on the roboRIO, or when
+ * built with WPI_USE_PRIORITY_MUTEX on Linux). For a recursive mutex, the
+ * hold time is measured from the outermost lock to the matching unlock.
+ *
+ * This meets the Lockable requirements, so it works with std::scoped_lock and
+ * std::unique_lock, but not with std::condition_variable.
+ *
+ * @tparam Mutex underlying mutex type
+ */
+template <typename Mutex>
+class basic_profiled_mutex {
+ public:
+  /**
+   * Constructs a mutex.
+   *
+   * @param name name for statistics (e.g. "NT.LocalStorage")
+   */
+  explicit basic_profiled_mutex(std::string_view name) : m_counters{name} {}
+
+  basic_profiled_mutex(const basic_profiled_mutex&) = delete;
+  basic_profiled_mutex& operator=(const basic_profiled_mutex&) = delete;
+
+  /** Lock the mutex, blocking until it's available. */
+  void lock() {
+    if (!IsLockProfilingEnabled()) {
+      m_mutex.lock();
+      Acquired(0);
+      return;
+    }
+    if (m_mutex.try_lock()) {
+      Acquired(NowNs());
+    } else {
+      uint64_t start = NowNs();
+      m_mutex.lock();
+      uint64_t now = NowNs();
+      m_counters.AddWait(now - start);
+      Acquired(now);
+    }
+    m_counters.AddLock();
+  }
+
+  /** Tries to lock the mutex. */
+  bool try_lock() {
+    if (!m_mutex.try_lock()) {
+      return false;
+    }
+    if (IsLockProfilingEnabled()) {
+      Acquired(NowNs());
+      m_counters.AddLock();
+    } else {
+      Acquired(0);
+    }
+    return true;
+  }
+
+  /** Unlock the mutex. */
+  void unlock() {
+    if (--m_depth == 0 && m_acquired != 0) {
+      m_counters.AddHold(NowNs() - m_acquired);
+      m_acquired = 0;
+    }
+    m_mutex.unlock();
+  }
+
+ private:
+  static uint64_t NowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  // must be called with m_mutex held
+  void Acquired(uint64_t now) {
+    if (m_depth++ == 0) {
+      m_acquired = now;
+    }
+  }
+
+  Mutex m_mutex;
+  // protected by m_mutex
+  int m_depth = 0;
+  uint64_t m_acquired = 0;  // 0 if not being timed
+  detail::LockCounters m_counters;
+};
+
+/** Profiled wpi::mutex. */
+using profiled_mutex = basic_profiled_mutex<wpi::mutex>;
+
+/** Profiled wpi::recursive_mutex. */
+using profiled_recursive_mutex = basic_profiled_mutex<wpi::recursive_mutex>;
+
+}  // namespace wpi
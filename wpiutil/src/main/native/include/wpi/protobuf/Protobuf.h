@@ -19,6 +19,7 @@
 #include "pb_encode.h"
 #include "wpi/array.h"
 #include "wpi/function_ref.h"
+#include "wpi/protobuf/ProtobufArena.h"
 
 namespace wpi {
 
@@ -59,9 +60,12 @@ class ProtoInputStream {
    * Generally used internally for decoding submessages
    *
    * @param[in] stream the nanopb istream
+   * @param[in] arena arena for temporary decoding storage, or nullptr
    */
-  explicit ProtoInputStream(pb_istream_t* stream)
+  explicit ProtoInputStream(pb_istream_t* stream,
+                            ProtobufArena* arena = nullptr)
       : m_streamMsg{stream},
+        m_arena{arena},
         m_msgDesc{
             Protobuf<std::remove_cvref_t<T>>::MessageStruct::msg_descriptor()} {
   }
@@ -70,10 +74,13 @@ class ProtoInputStream {
    * Constructs a nanopb istream from a buffer.
    *
    * @param[in] stream the stream buffer
+   * @param[in] arena arena for temporary decoding storage, or nullptr
    */
-  explicit ProtoInputStream(std::span<const uint8_t> stream)
+  explicit ProtoInputStream(std::span<const uint8_t> stream,
+                            ProtobufArena* arena = nullptr)
       : m_streamLocal{pb_istream_from_buffer(
             reinterpret_cast<const pb_byte_t*>(stream.data()), stream.size())},
+        m_arena{arena},
         m_msgDesc{
             Protobuf<std::remove_cvref_t<T>>::MessageStruct::msg_descriptor()} {
   }
@@ -94,6 +101,15 @@ class ProtoInputStream {
    */
   const pb_msgdesc_t* MsgDesc() const noexcept { return m_msgDesc; }
 
+  /**
+   * Gets the arena to allocate temporary decoding storage from. Anything
+   * allocated from the arena must be freed or moved out of before Unpack
+   * returns.
+   *
+   * @return the arena, or nullptr if there is none
+   */
+  ProtobufArena* Arena() const noexcept { return m_arena; }
+
   /**
    * Decodes a protobuf. Flags are the same flags passed to pb_decode_ex.
    *
@@ -109,6 +125,7 @@ class ProtoInputStream {
  private:
   pb_istream_t m_streamLocal;
   pb_istream_t* m_streamMsg{nullptr};
+  ProtobufArena* m_arena{nullptr};
   const pb_msgdesc_t* m_msgDesc;
 };
 
@@ -317,6 +334,20 @@ class ProtobufMessage {
     return Protobuf<std::remove_cvref_t<T>>::Unpack(stream);
   }
 
+  /**
+   * Unpacks from a byte array, allocating temporary decoding storage from an
+   * arena. The arena is not reset.
+   *
+   * @param data byte array
+   * @param arena arena
+   * @return Optional; empty if parsing failed
+   */
+  std::optional<std::remove_cvref_t<T>> Unpack(std::span<const uint8_t> data,
+                                               ProtobufArena& arena) {
+    ProtoInputStream<std::remove_cvref_t<T>> stream{data, &arena};
+    return Protobuf<std::remove_cvref_t<T>>::Unpack(stream);
+  }
+
   /**
    * Unpacks from a byte array into an existing object.
    *
@@ -325,17 +356,20 @@ class ProtobufMessage {
    * @return true if successful
    */
   bool UnpackInto(T* out, std::span<const uint8_t> data) {
-    if constexpr (MutableProtobufSerializable<T>) {
-      ProtoInputStream<std::remove_cvref_t<T>> stream{data};
-      return Protobuf<std::remove_cvref_t<T>>::UnpackInto(out, stream);
-    } else {
-      auto unpacked = Unpack(data);
-      if (!unpacked) {
-        return false;
-      }
-      *out = std::move(unpacked.value());
-      return true;
-    }
+    return DoUnpackInto(out, data, nullptr);
+  }
+
+  /**
+   * Unpacks from a byte array into an existing object, allocating temporary
+   * decoding storage from an arena. The arena is not reset.
+   *
+   * @param[out] out output object
+   * @param[in] data byte array
+   * @param[in] arena arena
+   * @return true if successful
+   */
+  bool UnpackInto(T* out, std::span<const uint8_t> data, ProtobufArena& arena) {
+    return DoUnpackInto(out, data, &arena);
   }
 
   /**
@@ -389,6 +423,22 @@ class ProtobufMessage {
         Protobuf<std::remove_cvref_t<T>>::MessageStruct::msg_descriptor(),
         exists, fn);
   }
+
+ private:
+  bool DoUnpackInto(T* out, std::span<const uint8_t> data,
+                    ProtobufArena* arena) {
+    ProtoInputStream<std::remove_cvref_t<T>> stream{data, arena};
+    if constexpr (MutableProtobufSerializable<T>) {
+      return Protobuf<std::remove_cvref_t<T>>::UnpackInto(out, stream);
+    } else {
+      auto unpacked = Protobuf<std::remove_cvref_t<T>>::Unpack(stream);
+      if (!unpacked) {
+        return false;
+      }
+      *out = std::move(unpacked.value());
+      return true;
+    }
+  }
 };
 
 }  // namespace wpi
@@ -0,0 +1,37 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <memory_resource>
+
+#include "wpi/MonotonicArena.h"
+
+namespace wpi {
+
+/**
+ * Memory arena for the temporary storage used while decoding protobuf
+ * messages (e.g. the contents of repeated fields before they are moved into
+ * the decoded object).
+ *
+ * Pass the arena to ProtobufMessage::Unpack(); Protobuf implementations get
+ * it from ProtoInputStream::Arena(). This class is not thread safe.
+ */
+class ProtobufArena : public MonotonicArena {
+ public:
+  using MonotonicArena::MonotonicArena;
+};
+
+/**
+ * Gets the memory resource of an arena.
+ *
+ * @param arena arena, or nullptr
+ * @return arena memory resource, or the default memory resource if arena is
+ *         nullptr
+ */
+inline std::pmr::memory_resource* GetArenaResource(ProtobufArena* arena) {
+  return arena ? arena->Resource() : std::pmr::get_default_resource();
+}
+
+}  // namespace wpi
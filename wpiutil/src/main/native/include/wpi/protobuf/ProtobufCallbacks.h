@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <memory_resource>
 #include <span>
 #include <utility>
 #include <vector>
@@ -14,6 +15,7 @@
 #include "wpi/SmallVector.h"
 #include "wpi/array.h"
 #include "wpi/protobuf/Protobuf.h"
+#include "wpi/protobuf/ProtobufArena.h"
 
 namespace wpi {
 
@@ -133,6 +135,14 @@ class DirectUnpackCallback {
    */
   void SetLimits(DecodeLimits limit) noexcept { m_limits = limit; }
 
+  /**
+   * Set the arena passed to the decoding of submessages. This should
+   * generally be the arena of the stream being decoded.
+   *
+   * @param arena the arena, or nullptr
+   */
+  void SetArena(ProtobufArena* arena) noexcept { m_arena = arena; }
+
   /**
    * Gets the nanopb callback pointing to this object.
    *
@@ -267,7 +277,7 @@ class DirectUnpackCallback {
       return pb_read(stream, reinterpret_cast<pb_byte_t*>(space.data()),
                      space.size());
     } else if constexpr (ProtobufSerializable<T>) {
-      ProtoInputStream<T> istream{stream};
+      ProtoInputStream<T> istream{stream, m_arena};
       auto decoded = wpi::Protobuf<T>::Unpack(istream);
       if (decoded.has_value()) {
         m_storage.emplace_back(std::move(decoded.value()));
@@ -319,6 +329,7 @@ class DirectUnpackCallback {
   U& m_storage;
   pb_callback_t m_callback;
   DecodeLimits m_limits{DecodeLimits::Add};
+  ProtobufArena* m_arena{nullptr};
 };
 
 /**
@@ -413,6 +424,62 @@ class StdVectorUnpackCallback
   std::vector<T> m_storedBuffer;
 };
 
+/**
+ * A DirectUnpackCallback backed by a std::pmr::vector allocated from a
+ * ProtobufArena, for temporary storage that is moved or copied out of before
+ * the decode returns. The arena is also passed to submessage decoding.
+ *
+ * Element types that allocate should use the polymorphic allocator (e.g.
+ * std::pmr::string instead of std::string) so they also allocate from the
+ * arena.
+ *
+ * By default, any elements in the packed buffer past N will
+ * be ignored, but decoding will still succeed
+ *
+ * @tparam T object type
+ * @tparam N number of expected elements
+ */
+template <ProtoCallbackUnpackable T, size_t N = 1>
+class ArenaUnpackCallback
+    : public DirectUnpackCallback<T, std::pmr::vector<T>, N> {
+ public:
+  /**
+   * Constructs an ArenaUnpackCallback.
+   *
+   * @param arena the arena, or nullptr to use the default memory resource
+   */
+  explicit ArenaUnpackCallback(ProtobufArena* arena)
+      : DirectUnpackCallback<T, std::pmr::vector<T>, N>{m_storedBuffer},
+        m_storedBuffer{GetArenaResource(arena)} {
+    this->SetLimits(DecodeLimits::Ignore);
+    this->SetArena(arena);
+  }
+
+  /**
+   * Gets a span pointing to the storage buffer.
+   *
+   * @return storage buffer span
+   */
+  std::span<T> Items() noexcept { return m_storedBuffer; }
+
+  /**
+   * Gets a const span pointing to the storage buffer.
+   *
+   * @return storage buffer span
+   */
+  std::span<const T> Items() const noexcept { return m_storedBuffer; }
+
+  /**
+   * Gets a reference to the backing vector.
+   *
+   * @return vector reference
+   */
+  std::pmr::vector<T>& Vec() noexcept { return m_storedBuffer; }
+
+ private:
+  std::pmr::vector<T> m_storedBuffer;
+};
+
 /**
  * A wrapper around a wpi::array that lets us
  * treat it as a limited sized vector.
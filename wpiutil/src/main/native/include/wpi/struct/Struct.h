@@ -6,7 +6,9 @@
 
 #include <stdint.h>
 
+#include <bit>
 #include <concepts>
+#include <cstring>
 #include <memory>
 #include <span>
 #include <string>
@@ -125,6 +127,28 @@ concept HasNestedStruct =
              typename std::remove_cvref_t<I>...>::ForEachNested(fn, info...);
     };
 
+/**
+ * Specifies that the in-memory representation of a type is identical to its
+ * raw struct serialization, so arrays of the type can be packed and unpacked
+ * with a single memcpy (or not copied at all).
+ *
+ * Implementations opt in by defining a wpi::Struct<T> static member
+ * `static constexpr bool kLayoutCompatible = true` and a constexpr GetSize().
+ * The type must be trivially copyable and default constructible, and its
+ * members must be laid out in schema order without padding; the size is
+ * checked here, but the member order is up to the implementation. As the
+ * serialization is little endian, this only applies on little endian
+ * platforms.
+ */
+template <typename T, typename... I>
+concept LayoutCompatibleStruct =
+    sizeof...(I) == 0 && StructSerializable<T> &&
+    Struct<std::remove_cvref_t<T>>::kLayoutCompatible &&
+    std::is_trivially_copyable_v<std::remove_cvref_t<T>> &&
+    std::default_initializable<std::remove_cvref_t<T>> &&
+    std::endian::native == std::endian::little &&
+    sizeof(T) == Struct<std::remove_cvref_t<T>>::GetSize();
+
 /**
  * Unpack a serialized struct.
  *
@@ -170,7 +194,12 @@ inline T UnpackStruct(std::span<const uint8_t> data, const I&... info) {
  */
 template <StructSerializable T, size_t Offset, size_t N>
 inline wpi::array<T, N> UnpackStructArray(std::span<const uint8_t> data) {
-  if (is_constexpr([] { Struct<std::remove_cvref_t<T>>::GetSize(); })) {
+  if constexpr (LayoutCompatibleStruct<T>) {
+    wpi::array<T, N> arr(wpi::empty_array);
+    std::memcpy(arr.data(), data.data() + Offset, N * sizeof(T));
+    return arr;
+  } else if (is_constexpr(
+                 [] { Struct<std::remove_cvref_t<T>>::GetSize(); })) {
     constexpr auto StructSize = Struct<std::remove_cvref_t<T>>::GetSize();
     wpi::array<T, N> arr(wpi::empty_array);
     [&]<size_t... Is>(std::index_sequence<Is...>) {
@@ -233,7 +262,10 @@ inline void PackStruct(std::span<uint8_t> data, T&& value, const I&... info) {
 template <size_t Offset, size_t N, StructSerializable T>
 inline void PackStructArray(std::span<uint8_t> data,
                             const wpi::array<T, N>& arr) {
-  if (is_constexpr([] { Struct<std::remove_cvref_t<T>>::GetSize(); })) {
+  if constexpr (LayoutCompatibleStruct<T>) {
+    std::memcpy(data.data() + Offset, arr.data(), N * sizeof(T));
+  } else if (is_constexpr(
+                 [] { Struct<std::remove_cvref_t<T>>::GetSize(); })) {
     constexpr auto StructSize = Struct<std::remove_cvref_t<T>>::GetSize();
     [&]<size_t... Is>(std::index_sequence<Is...>) {
       (PackStruct<Offset + Is * StructSize>(data, arr[Is]), ...);
@@ -455,6 +487,17 @@ class StructArrayBuffer {
 #endif
       std::invocable<F, std::span<const uint8_t>>
     void Write(U&& data, F&& func, const I&... info) {
+#if __cpp_lib_ranges >= 201911L
+    if constexpr (LayoutCompatibleStruct<T, I...> &&
+                  std::ranges::contiguous_range<U> &&
+                  std::same_as<std::ranges::range_value_t<U>, T>) {
+      // already serialized
+      func(std::span<const uint8_t>{
+          reinterpret_cast<const uint8_t*>(std::ranges::data(data)),
+          std::ranges::size(data) * sizeof(T)});
+      return;
+    }
+#endif
     auto size = S::GetSize(info...);
     if ((std::size(data) * size) < 256) {
       // use the stack
@@ -501,21 +544,29 @@ struct Struct<std::array<T, N>, I...> {
   }
   static std::array<T, N> Unpack(std::span<const uint8_t> data,
                                  const I&... info) {
-    auto size = GetStructSize<T>(info...);
     std::array<T, N> result;
-    for (size_t i = 0; i < N; ++i) {
-      result[i] = UnpackStruct<T, 0>(data, info...);
-      data = data.subspan(size);
+    if constexpr (LayoutCompatibleStruct<T, I...>) {
+      std::memcpy(result.data(), data.data(), N * sizeof(T));
+    } else {
+      auto size = GetStructSize<T>(info...);
+      for (size_t i = 0; i < N; ++i) {
+        result[i] = UnpackStruct<T, 0>(data, info...);
+        data = data.subspan(size);
+      }
     }
     return result;
   }
   static void Pack(std::span<uint8_t> data, std::span<const T, N> values,
                    const I&... info) {
-    auto size = GetStructSize<T>(info...);
-    std::span<uint8_t> unsizedData = data;
-    for (auto&& val : values) {
-      PackStruct(unsizedData, val, info...);
-      unsizedData = unsizedData.subspan(size);
+    if constexpr (LayoutCompatibleStruct<T, I...>) {
+      std::memcpy(data.data(), values.data(), N * sizeof(T));
+    } else {
+      auto size = GetStructSize<T>(info...);
+      std::span<uint8_t> unsizedData = data;
+      for (auto&& val : values) {
+        PackStruct(unsizedData, val, info...);
+        unsizedData = unsizedData.subspan(size);
+      }
     }
   }
   static void UnpackInto(std::array<T, N>* out, std::span<const uint8_t> data,
@@ -525,11 +576,15 @@ struct Struct<std::array<T, N>, I...> {
   // alternate span-based function
   static void UnpackInto(std::span<T, N> out, std::span<const uint8_t> data,
                          const I&... info) {
-    auto size = GetStructSize<T>(info...);
-    std::span<const uint8_t> unsizedData = data;
-    for (size_t i = 0; i < N; ++i) {
-      UnpackStructInto(&out[i], unsizedData, info...);
-      unsizedData = unsizedData.subspan(size);
+    if constexpr (LayoutCompatibleStruct<T, I...>) {
+      std::memcpy(out.data(), data.data(), N * sizeof(T));
+    } else {
+      auto size = GetStructSize<T>(info...);
+      std::span<const uint8_t> unsizedData = data;
+      for (size_t i = 0; i < N; ++i) {
+        UnpackStructInto(&out[i], unsizedData, info...);
+        unsizedData = unsizedData.subspan(size);
+      }
     }
   }
 };
@@ -555,6 +610,7 @@ struct Struct<bool> {
  */
 template <>
 struct Struct<uint8_t> {
+  static constexpr bool kLayoutCompatible = true;
   static constexpr std::string_view GetTypeName() { return "uint8"; }
   static constexpr size_t GetSize() { return 1; }
   static constexpr std::string_view GetSchema() { return "uint8 value"; }
@@ -568,6 +624,7 @@ struct Struct<uint8_t> {
  */
 template <>
 struct Struct<int8_t> {
+  static constexpr bool kLayoutCompatible = true;
   static constexpr std::string_view GetTypeName() { return "int8"; }
   static constexpr size_t GetSize() { return 1; }
   static constexpr std::string_view GetSchema() { return "int8 value"; }
@@ -581,6 +638,7 @@ struct Struct<int8_t> {
  */
 template <>
 struct Struct<uint16_t> {
+  static constexpr bool kLayoutCompatible = true;
   static constexpr std::string_view GetTypeName() { return "uint16"; }
   static constexpr size_t GetSize() { return 2; }
   static constexpr std::string_view GetSchema() { return "uint16 value"; }
@@ -598,6 +656,7 @@ struct Struct<uint16_t> {
  */
 template <>
 struct Struct<int16_t> {
+  static constexpr bool kLayoutCompatible = true;
   static constexpr std::string_view GetTypeName() { return "int16"; }
   static constexpr size_t GetSize() { return 2; }
   static constexpr std::string_view GetSchema() { return "int16 value"; }
@@ -615,6 +674,7 @@ struct Struct<int16_t> {
  */
 template <>
 struct Struct<uint32_t> {
+  static constexpr bool kLayoutCompatible = true;
   static constexpr std::string_view GetTypeName() { return "uint32"; }
   static constexpr size_t GetSize() { return 4; }
   static constexpr std::string_view GetSchema() { return "uint32 value"; }
@@ -632,6 +692,7 @@ struct Struct<uint32_t> {
  */
 template <>
 struct Struct<int32_t> {
+  static constexpr bool kLayoutCompatible = true;
   static constexpr std::string_view GetTypeName() { return "int32"; }
   static constexpr size_t GetSize() { return 4; }
   static constexpr std::string_view GetSchema() { return "int32 value"; }
@@ -649,6 +710,7 @@ struct Struct<int32_t> {
  */
 template <>
 struct Struct<uint64_t> {
+  static constexpr bool kLayoutCompatible = true;
   static constexpr std::string_view GetTypeName() { return "uint64"; }
   static constexpr size_t GetSize() { return 8; }
   static constexpr std::string_view GetSchema() { return "uint64 value"; }
@@ -666,6 +728,7 @@ struct Struct<uint64_t> {
  */
 template <>
 struct Struct<int64_t> {
+  static constexpr bool kLayoutCompatible = true;
   static constexpr std::string_view GetTypeName() { return "int64"; }
   static constexpr size_t GetSize() { return 8; }
   static constexpr std::string_view GetSchema() { return "int64 value"; }
@@ -683,6 +746,7 @@ struct Struct<int64_t> {
  */
 template <>
 struct Struct<float> {
+  static constexpr bool kLayoutCompatible = true;
   static constexpr std::string_view GetTypeName() { return "float"; }
   static constexpr size_t GetSize() { return 4; }
   static constexpr std::string_view GetSchema() { return "float value"; }
@@ -700,6 +764,7 @@ struct Struct<float> {
  */
 template <>
 struct Struct<double> {
+  static constexpr bool kLayoutCompatible = true;
   static constexpr std::string_view GetTypeName() { return "double"; }
   static constexpr size_t GetSize() { return 8; }
   static constexpr std::string_view GetSchema() { return "double value"; }
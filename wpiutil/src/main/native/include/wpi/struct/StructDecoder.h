@@ -0,0 +1,115 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <span>
+#include <string>
+#include <vector>
+
+#include "wpi/struct/DynamicStruct.h"
+
+namespace wpi {
+
+/**
+ * Decoder for all the numeric fields of a raw struct at once.
+ *
+ * The struct descriptor is walked once at construction to build a flat plan
+ * of columns, one for each numeric value in the struct (including the fields
+ * of nested structs and each element of arrays). Decoding then runs through
+ * the plan without any lookups, which is much faster than calling
+ * DynamicStruct getters for each field of each sample.
+ *
+ * Values are decoded as doubles; booleans are 0 or 1. Integers with a
+ * magnitude above 2^53 lose precision. Char fields are not decoded.
+ */
+class StructDecoder {
+ public:
+  /** A decoded value. */
+  struct Column {
+    /**
+     * Field path, e.g. "translation.x" or "modules[1].angle.value".
+     */
+    std::string name;
+
+    /** Field type. */
+    StructFieldType type;
+  };
+
+  /**
+   * Builds a decoder for a struct.
+   *
+   * @param desc struct descriptor; must be valid
+   */
+  explicit StructDecoder(const StructDescriptor* desc);
+
+  /**
+   * Gets the struct descriptor.
+   *
+   * @return struct descriptor
+   */
+  const StructDescriptor* GetDescriptor() const { return m_desc; }
+
+  /**
+   * Gets the decoded columns, in field order.
+   *
+   * @return columns
+   */
+  std::span<const Column> GetColumns() const { return m_columns; }
+
+  /**
+   * Decodes one struct.
+   *
+   * @param data serialized struct; must be at least the struct size
+   * @param out output, one value per column; must be at least
+   *            GetColumns().size() long
+   */
+  void Decode(std::span<const uint8_t> data, std::span<double> out) const;
+
+  /**
+   * Decodes a serialized array of structs (or a single struct), appending the
+   * values of each column to a separate vector. Trailing data shorter than
+   * the struct size is ignored.
+   *
+   * @param data serialized structs
+   * @param columns output, one vector per column; must be GetColumns().size()
+   *                long
+   * @return number of structs decoded
+   */
+  size_t DecodeColumns(std::span<const uint8_t> data,
+                       std::span<std::vector<double>> columns) const;
+
+ private:
+  enum Kind : uint8_t {
+    kBool,
+    kInt8,
+    kInt16,
+    kInt32,
+    kInt64,
+    kUint,
+    kFloat,
+    kDouble
+  };
+
+  struct Op {
+    uint32_t offset;
+    uint8_t size;
+    Kind kind;
+    uint8_t shift;
+    uint64_t mask;
+  };
+
+  void AddFields(const StructDescriptor* desc, size_t offset,
+                 const std::string& prefix);
+  static double Read(const Op& op, const uint8_t* data);
+
+  const StructDescriptor* m_desc;
+  size_t m_size;
+  std::vector<Column> m_columns;
+  std::vector<Op> m_ops;
+};
+
+}  // namespace wpi
@@ -44,6 +44,13 @@ void WPI_SetNowImpl(uint64_t (*func)(void));
  */
 uint64_t WPI_Now(void);
 
+/**
+ * Return a value representing the current time in microseconds, read from the
+ * operating system monotonic clock and calibrated against WPI_Now().
+ * @return Time in microseconds.
+ */
+uint64_t WPI_NowCalibrated(void);
+
 /**
  * Return the current system time in microseconds since the Unix epoch
  * (January 1st, 1970 00:00 UTC).
@@ -118,6 +125,21 @@ void SetNowImpl(uint64_t (*func)());
  */
 uint64_t Now();
 
+/**
+ * Return a value representing the current time in microseconds, read from the
+ * operating system monotonic clock and calibrated against Now().
+ *
+ * This is intended for timestamping in hot paths when the implementation set
+ * with SetNowImpl() is expensive to call. Now() is only called to
+ * re-synchronize at most every 100 ms, and the difference is slewed out
+ * gradually so the result stays monotonic. The result may differ from Now()
+ * by the drift between the two clocks over that interval. When Now() is
+ * already the operating system clock, this is the same as Now().
+ *
+ * @return Time in microseconds.
+ */
+uint64_t NowCalibrated();
+
 /**
  * Return the current system time in microseconds since the Unix epoch
  * (January 1st, 1970 00:00 UTC).
@@ -0,0 +1,57 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/AllocationTracker.h"  // NOLINT(build/include_order)
+
+#include <memory>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+// installs the hooks for the whole test executable; they only count while
+// the tracker is enabled
+WPI_ALLOCATION_TRACKER_HOOKS()
+
+// keeps the compiler from eliding allocations
+static void* volatile gSink;
+
+class AllocationTrackerTest : public ::testing::Test {
+ protected:
+  void SetUp() override { wpi::AllocationTracker::SetEnabled(true); }
+  void TearDown() override { wpi::AllocationTracker::SetEnabled(false); }
+};
+
+TEST_F(AllocationTrackerTest, ThreadCounts) {
+  auto start = wpi::AllocationTracker::GetThreadCounts();
+  auto p = std::make_unique<int64_t[]>(4);
+  gSink = p.get();
+  auto counts = wpi::AllocationTracker::GetThreadCounts();
+  EXPECT_EQ(counts.allocations - start.allocations, 1u);
+  EXPECT_EQ(counts.bytes - start.bytes, 4 * sizeof(int64_t));
+  EXPECT_EQ(counts.deallocations, start.deallocations);
+  p.reset();
+  counts = wpi::AllocationTracker::GetThreadCounts();
+  EXPECT_EQ(counts.deallocations - start.deallocations, 1u);
+  EXPECT_TRUE(wpi::AllocationTracker::IsInstalled());
+}
+
+TEST_F(AllocationTrackerTest, OtherThread) {
+  auto start = wpi::AllocationTracker::GetThreadCounts();
+  auto totalStart = wpi::AllocationTracker::GetTotalCounts();
+  std::thread thr{[] { auto p = std::make_unique<int>(1); }};
+  thr.join();
+  auto counts = wpi::AllocationTracker::GetThreadCounts();
+  auto total = wpi::AllocationTracker::GetTotalCounts();
+  // std::thread allocates its state on this thread
+  EXPECT_GE(total.allocations - totalStart.allocations,
+            counts.allocations - start.allocations + 1);
+}
+
+TEST_F(AllocationTrackerTest, Disabled) {
+  wpi::AllocationTracker::SetEnabled(false);
+  auto start = wpi::AllocationTracker::GetThreadCounts();
+  auto p = std::make_unique<int>(1);
+  EXPECT_EQ(wpi::AllocationTracker::GetThreadCounts().allocations,
+            start.allocations);
+}
@@ -102,4 +102,21 @@ static Base64TestParam standard[] = {
 INSTANTIATE_TEST_SUITE_P(Base64StandardTests, Base64Test,
                          ::testing::ValuesIn(standard));
 
+TEST(Base64LongTest, RoundTrip) {
+  // spans several internal chunks, with each possible tail length
+  for (size_t len : {2999u, 3000u, 3001u}) {
+    std::string plain;
+    for (size_t i = 0; i < len; ++i) {
+      plain.push_back(static_cast<char>(i * 7));
+    }
+    std::string encoded;
+    Base64Encode(plain, &encoded);
+    ASSERT_EQ(encoded.size(), (len + 2) / 3 * 4);
+
+    std::string decoded;
+    EXPECT_EQ(Base64Decode(encoded, &decoded), encoded.size());
+    EXPECT_EQ(decoded, plain);
+  }
+}
+
 }  // namespace wpi
@@ -0,0 +1,101 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <stdint.h>
+
+#ifdef __linux__
+#include <sys/stat.h>
+#endif
+
+#include <string>
+#include <system_error>
+#include <tuple>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "wpi/DataLogBackgroundWriter.h"
+#include "wpi/DataLogReader.h"
+#include "wpi/fs.h"
+
+namespace {
+
+class DataLogBackgroundWriterTest
+    : public ::testing::TestWithParam<std::tuple<bool, bool>> {
+ public:
+  DataLogBackgroundWriterTest() {
+    auto [directIO, compress] = GetParam();
+    dir = fs::temp_directory_path() /
+          fmt::format("DataLogBackgroundWriterTest_{}_{}", directIO, compress);
+    std::error_code ec;
+    fs::remove_all(dir, ec);
+    fs::create_directories(dir, ec);
+  }
+
+  ~DataLogBackgroundWriterTest() override {
+    std::error_code ec;
+    fs::remove_all(dir, ec);
+  }
+
+  fs::path dir;
+};
+
+}  // namespace
+
+TEST_P(DataLogBackgroundWriterTest, WritesAllRecords) {
+  auto [directIO, compress] = GetParam();
+  wpi::log::DataLogFileOptions options;
+  options.preallocateSize = 64 * 1024;
+  options.directIO = directIO;
+
+  // enough data to fill the direct I/O staging buffer and grow the
+  // preallocated space several times
+  constexpr int64_t kCount = 100000;
+  {
+    wpi::log::DataLogBackgroundWriter log{
+        dir.string(), "test.wpilog", 0.01, "", compress, options};
+    int entry = log.Start("value", "int64", "", 1);
+    for (int64_t i = 0; i < kCount; ++i) {
+      log.AppendInteger(entry, i, i + 1);
+      if (i % 10000 == 0) {
+        log.Flush();
+      }
+    }
+  }
+
+  auto path = dir / "test.wpilog";
+#ifdef __linux__
+  // storage preallocated past the end of the file is released on close
+  struct stat st;
+  ASSERT_EQ(::stat(path.c_str(), &st), 0);
+  EXPECT_LE(st.st_blocks * 512, st.st_size + 16 * 1024);
+#endif
+
+  std::error_code ec;
+  wpi::log::DataLogReader reader{path.string(), ec};
+  ASSERT_FALSE(ec);
+  ASSERT_TRUE(reader.IsValid());
+
+  int entry = 0;
+  int64_t expected = 0;
+  for (auto&& record : reader) {
+    wpi::log::StartRecordData start;
+    int64_t value;
+    if (record.IsStart() && record.GetStartData(&start)) {
+      if (start.name == "value") {
+        entry = start.entry;
+      }
+    } else if (entry != 0 && record.GetEntry() == entry &&
+               record.GetInteger(&value)) {
+      ASSERT_EQ(value, expected);
+      ++expected;
+    }
+  }
+  EXPECT_EQ(expected, kCount);
+}
+
+INSTANTIATE_TEST_SUITE_P(DataLogBackgroundWriterTests,
+                         DataLogBackgroundWriterTest,
+                         ::testing::Combine(::testing::Bool(),
+                                            ::testing::Bool()));
@@ -2,15 +2,26 @@
 // Open Source Software; you can modify and/or share it under the terms of
 // the WPILib BSD license file in the root directory of this project.
 
+#include <algorithm>
 #include <array>
+#include <bit>
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include <fmt/format.h>
 #include <gtest/gtest.h>
 
+#include "wpi/DataLogCompressor.h"
+#include "wpi/DataLogIndex.h"
+#include "wpi/DataLogReader.h"
+#include "wpi/DataLogSeries.h"
 #include "wpi/DataLogWriter.h"
+#include "wpi/Endian.h"
 #include "wpi/Logger.h"
+#include "wpi/MemoryBuffer.h"
+#include "wpi/fs.h"
 #include "wpi/raw_ostream.h"
 
 namespace {
@@ -30,6 +41,15 @@ struct ThingC {
   int x = 0;
 };
 
+struct ThingD {
+  int16_t x = 0;
+  int16_t y = 0;
+};
+
+inline bool operator==(const ThingD& a, const ThingD& b) {
+  return a.x == b.x && a.y == b.y;
+}
+
 struct Info1 {
   int info = 0;
 };
@@ -99,6 +119,22 @@ struct wpi::Struct<ThingC, Info1> {
   }
 };
 
+template <>
+struct wpi::Struct<ThingD> {
+  static constexpr bool kLayoutCompatible = true;
+  static constexpr std::string_view GetTypeName() { return "ThingD"; }
+  static constexpr size_t GetSize() { return 4; }
+  static constexpr std::string_view GetSchema() { return "int16 x;int16 y"; }
+  static ThingD Unpack(std::span<const uint8_t> data) {
+    return ThingD{.x = wpi::UnpackStruct<int16_t, 0>(data),
+                  .y = wpi::UnpackStruct<int16_t, 2>(data)};
+  }
+  static void Pack(std::span<uint8_t> data, const ThingD& value) {
+    wpi::PackStruct<0>(data, value.x);
+    wpi::PackStruct<2>(data, value.y);
+  }
+};
+
 template <>
 struct wpi::Struct<ThingC, Info2> {
   static constexpr std::string_view GetTypeName(const Info2&) {
@@ -142,6 +178,455 @@ TEST_F(DataLogTest, SimpleInt) {
   ASSERT_EQ(data.size(), 54u);
 }
 
+TEST_F(DataLogTest, MultipleThreads) {
+  constexpr int kNumThreads = 4;
+  constexpr int kNumValues = 10000;
+  int entries[kNumThreads];
+  for (int i = 0; i < kNumThreads; ++i) {
+    entries[i] = log.Start(std::to_string(i), "int64", "", 1);
+  }
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&, entry = entries[i]] {
+      for (int j = 0; j < kNumValues; ++j) {
+        log.AppendInteger(entry, j, j + 1);
+      }
+    });
+  }
+  for (auto&& thread : threads) {
+    thread.join();
+  }
+  log.Flush();
+
+  // each thread's records must be complete and in order
+  wpi::log::DataLogReader reader{wpi::MemoryBuffer::GetMemBuffer(data, "")};
+  ASSERT_TRUE(reader.IsValid());
+  int64_t next[kNumThreads] = {};
+  for (auto&& record : reader) {
+    if (record.IsControl()) {
+      continue;
+    }
+    int i = std::find(entries, entries + kNumThreads, record.GetEntry()) -
+            entries;
+    ASSERT_LT(i, kNumThreads);
+    int64_t value;
+    ASSERT_TRUE(record.GetInteger(&value));
+    ASSERT_EQ(value, next[i]);
+    ++next[i];
+  }
+  for (auto count : next) {
+    EXPECT_EQ(count, kNumValues);
+  }
+}
+
+TEST_F(DataLogTest, Stats) {
+  int entry1 = log.Start("a", "int64", "", 1);
+  int entry2 = log.Start("b", "double", "", 1);
+  log.AppendInteger(entry1, 1, 2);
+  std::thread{[&] {
+    log.AppendDouble(entry2, 1.0, 2);
+    log.AppendDouble(entry2, 2.0, 3);
+  }}.join();
+  log.Flush();
+  log.AppendInteger(entry1, 2, 3);
+
+  auto stats = log.GetStats();
+  EXPECT_EQ(stats.records, 4u);
+  EXPECT_EQ(stats.bytes, 32u);
+  EXPECT_EQ(stats.droppedRecords, 0u);
+  EXPECT_EQ(stats.overflowCount, 0u);
+  EXPECT_EQ(stats.buffersInFlight, 1u);
+  EXPECT_EQ(log.GetEntryBytes(entry1), 16u);
+  EXPECT_EQ(log.GetEntryBytes(entry2), 16u);
+
+  // explicitly paused records are not counted as dropped
+  log.Pause();
+  log.AppendInteger(entry1, 3, 4);
+  log.Resume();
+  stats = log.GetStats();
+  EXPECT_EQ(stats.records, 4u);
+  EXPECT_EQ(stats.droppedRecords, 0u);
+}
+
+TEST_F(DataLogTest, FlushCallback) {
+  int entry = log.Start("a", "int64", "", 1);
+  std::vector<int64_t> queued{1, 2, 3};
+  int handle = log.AddFlushCallback([&] {
+    for (auto value : queued) {
+      log.AppendInteger(entry, value, value + 1);
+    }
+    queued.clear();
+  });
+  log.Flush();
+  EXPECT_TRUE(queued.empty());
+  EXPECT_EQ(log.GetStats().records, 3u);
+
+  log.RemoveFlushCallback(handle);
+  queued.emplace_back(4);
+  log.Flush();
+  EXPECT_EQ(queued.size(), 1u);
+  EXPECT_EQ(log.GetStats().records, 3u);
+}
+
+TEST_F(DataLogTest, EntryFilter) {
+  int deadband = log.Start("deadband", "double", "", 1);
+  log.SetEntryFilter(deadband, {.deadband = 0.5});
+  int rate = log.Start("rate", "int64", "", 1);
+  log.SetEntryFilter(rate, {.minPeriod = 100});
+  int array = log.Start("array", "int64[]", "", 1);
+  log.SetEntryFilter(array, {.onChange = true});
+  log.SetEntryFilter("NT:/", {.onChange = true});
+  int prefixed = log.Start("NT:/a", "int64", "", 1);
+
+  log.AppendDouble(deadband, 1.0, 10);
+  log.AppendDouble(deadband, 1.2, 20);
+  log.AppendDouble(deadband, 1.6, 30);
+  log.AppendDouble(deadband, 1.7, 40);
+  for (int64_t t = 1000; t < 1200; t += 50) {
+    log.AppendInteger(rate, t, t);
+  }
+  int64_t arr1[] = {1, 2};
+  int64_t arr2[] = {1, 3};
+  log.AppendIntegerArray(array, arr1, 10);
+  log.AppendIntegerArray(array, arr1, 20);
+  log.AppendIntegerArray(array, arr2, 30);
+  log.AppendInteger(prefixed, 5, 10);
+  log.AppendInteger(prefixed, 5, 20);
+  log.AppendInteger(prefixed, 6, 30);
+  log.Flush();
+  EXPECT_EQ(log.GetStats().filteredRecords, 6u);
+
+  wpi::log::DataLogReader reader{wpi::MemoryBuffer::GetMemBuffer(data, "")};
+  ASSERT_TRUE(reader.IsValid());
+  std::vector<int64_t> timestamps[5];
+  for (auto&& record : reader) {
+    if (!record.IsControl()) {
+      ASSERT_LT(record.GetEntry(), 5);
+      timestamps[record.GetEntry()].push_back(record.GetTimestamp());
+    }
+  }
+  EXPECT_EQ(timestamps[deadband], (std::vector<int64_t>{10, 30}));
+  EXPECT_EQ(timestamps[rate], (std::vector<int64_t>{1000, 1100}));
+  EXPECT_EQ(timestamps[array], (std::vector<int64_t>{10, 30}));
+  EXPECT_EQ(timestamps[prefixed], (std::vector<int64_t>{10, 30}));
+}
+
+TEST_F(DataLogTest, Frame) {
+  wpi::log::DataLogFrame frame{
+      log, {{"a", "double"}, {"b", "int64"}, {"c", "boolean"}}, 1};
+  ASSERT_EQ(frame.GetSize(), 17u);
+  EXPECT_EQ(frame.GetOffset(2), 16u);
+  uint8_t values[17] = {};
+  wpi::support::endian::write64le(values, std::bit_cast<uint64_t>(1.5));
+  wpi::support::endian::write64le(values + 8, 42);
+  values[16] = 1;
+  frame.Append(values, 100);
+
+  // too large to fit into a single buffer
+  std::vector<wpi::log::DataLogFrame::Field> fields;
+  std::vector<std::string> names;
+  for (int i = 0; i < 2000; ++i) {
+    names.emplace_back(fmt::format("d{}", i));
+  }
+  for (auto&& name : names) {
+    fields.push_back({name, "double"});
+  }
+  wpi::log::DataLogFrame bigFrame{log, fields, 1};
+  std::vector<double> doubles(fields.size());
+  for (size_t i = 0; i < doubles.size(); ++i) {
+    doubles[i] = i;
+  }
+  bigFrame.AppendDoubles(doubles, 200);
+  log.Flush();
+
+  wpi::log::DataLogReader reader{wpi::MemoryBuffer::GetMemBuffer(data, "")};
+  ASSERT_TRUE(reader.IsValid());
+  int count = 0;
+  for (auto&& record : reader) {
+    if (record.IsControl()) {
+      continue;
+    }
+    ++count;
+    if (record.GetEntry() == frame.GetEntry(0)) {
+      double value;
+      ASSERT_TRUE(record.GetDouble(&value));
+      EXPECT_EQ(value, 1.5);
+      EXPECT_EQ(record.GetTimestamp(), 100);
+    } else if (record.GetEntry() == frame.GetEntry(1)) {
+      int64_t value;
+      ASSERT_TRUE(record.GetInteger(&value));
+      EXPECT_EQ(value, 42);
+    } else if (record.GetEntry() == frame.GetEntry(2)) {
+      bool value;
+      ASSERT_TRUE(record.GetBoolean(&value));
+      EXPECT_TRUE(value);
+    } else {
+      int index = record.GetEntry() - bigFrame.GetEntry(0);
+      double value;
+      ASSERT_TRUE(record.GetDouble(&value));
+      EXPECT_EQ(value, index);
+      EXPECT_EQ(record.GetTimestamp(), 200);
+    }
+  }
+  EXPECT_EQ(count, 2003);
+  EXPECT_EQ(log.GetStats().records, 2003u);
+}
+
+TEST_F(DataLogTest, Compressed) {
+  int entry = log.Start("test", "int64", "", 1);
+  for (int i = 0; i < 1000; ++i) {
+    log.AppendInteger(entry, i, i + 1);
+  }
+  log.Flush();
+
+  // split input at arbitrary points, and use small blocks
+  wpi::log::DataLogCompressor compressor{1000};
+  std::vector<uint8_t> compressed;
+  for (size_t i = 0; i < data.size(); i += 77) {
+    compressor.Write(
+        std::span{data}.subspan(i, std::min<size_t>(77, data.size() - i)),
+        compressed);
+  }
+  compressor.Finish(compressed);
+  EXPECT_LT(compressed.size(), data.size());
+
+  auto checkRecords = [](const wpi::log::DataLogReader& reader,
+                         wpi::log::DataLogReader::iterator it, int64_t first) {
+    int64_t next = first;
+    for (; it != reader.end(); ++it) {
+      if (it->IsControl()) {
+        continue;
+      }
+      int64_t value;
+      ASSERT_TRUE(it->GetInteger(&value));
+      ASSERT_EQ(value, next);
+      ASSERT_EQ(it->GetTimestamp(), next + 1);
+      ++next;
+    }
+    EXPECT_EQ(next, 1000);
+  };
+
+  wpi::log::DataLogReader reader{
+      wpi::MemoryBuffer::GetMemBuffer(compressed, "")};
+  ASSERT_TRUE(reader.IsValid());
+  ASSERT_TRUE(reader.IsCompressed());
+  ASSERT_GT(reader.GetBlockCount(), 2u);
+  checkRecords(reader, reader.begin(), 0);
+
+  // start in the middle, without reading earlier blocks
+  wpi::log::DataLogReader reader2{
+      wpi::MemoryBuffer::GetMemBuffer(compressed, "")};
+  int64_t timestamp = reader2.GetBlockTimestamp(2);
+  ASSERT_GT(timestamp, 1);
+  checkRecords(reader2, reader2.BlockBegin(2), timestamp - 1);
+
+  // without the index (e.g. log not closed)
+  compressor = wpi::log::DataLogCompressor{1000};
+  compressed.clear();
+  compressor.Write(data, compressed);
+  compressor.Flush(compressed);
+  wpi::log::DataLogReader reader3{
+      wpi::MemoryBuffer::GetMemBuffer(compressed, "")};
+  EXPECT_EQ(reader3.GetBlockCount(), reader.GetBlockCount());
+  checkRecords(reader3, reader3.begin(), 0);
+}
+
+TEST_F(DataLogTest, CompressedBadIndex) {
+  int entry = log.Start("test", "int64", "", 1);
+  for (int i = 0; i < 1000; ++i) {
+    log.AppendInteger(entry, i, i + 1);
+  }
+  log.Flush();
+
+  wpi::log::DataLogCompressor compressor{1000};
+  std::vector<uint8_t> compressed;
+  compressor.Write(data, compressed);
+  compressor.Finish(compressed);
+
+  auto countRecords = [](const wpi::log::DataLogReader& reader) {
+    int count = 0;
+    for (auto&& record : reader) {
+      if (!record.IsControl()) {
+        ++count;
+      }
+    }
+    return count;
+  };
+
+  wpi::log::DataLogReader reader{
+      wpi::MemoryBuffer::GetMemBuffer(compressed, "")};
+  ASSERT_TRUE(reader.IsValid());
+  size_t blockCount = reader.GetBlockCount();
+  ASSERT_GT(blockCount, 2u);
+  size_t lastEntry = compressed.size() -
+                     wpi::log::impl::kCompressedIndexTrailerSize -
+                     wpi::log::impl::kCompressedIndexEntrySize;
+
+  // an index offset that disagrees with the block headers falls back to
+  // scanning the blocks
+  auto badOffset = compressed;
+  wpi::support::endian::write64le(badOffset.data() + lastEntry + 8,
+                                  UINT64_C(1) << 62);
+  wpi::log::DataLogReader reader2{
+      wpi::MemoryBuffer::GetMemBuffer(badOffset, "")};
+  ASSERT_TRUE(reader2.IsValid());
+  EXPECT_EQ(reader2.GetBlockCount(), blockCount);
+  EXPECT_EQ(countRecords(reader2), 1000);
+
+  // an implausible uncompressed size stops the scan at that block
+  auto badSize = compressed;
+  uint64_t lastBlock =
+      wpi::support::endian::read64le(badSize.data() + lastEntry);
+  wpi::support::endian::write32le(badSize.data() + lastBlock + 4, UINT32_MAX);
+  wpi::log::DataLogReader reader3{
+      wpi::MemoryBuffer::GetMemBuffer(badSize, "")};
+  ASSERT_TRUE(reader3.IsValid());
+  EXPECT_EQ(reader3.GetBlockCount(), blockCount - 1);
+  EXPECT_LT(countRecords(reader3), 1000);
+}
+
+TEST_F(DataLogTest, Index) {
+  int a = log.Start("a", "int64", "", 1);
+  int b = log.Start("b", "int64", "", 1);
+  for (int i = 0; i < 1000; ++i) {
+    log.AppendInteger(a, i, i + 1);
+    log.AppendInteger(b, -i, i + 1);
+  }
+  log.Finish(b, 2000);
+  log.Flush();
+
+  wpi::log::DataLogReader reader{wpi::MemoryBuffer::GetMemBuffer(data, "")};
+  wpi::log::DataLogIndex index{reader, 256};
+  ASSERT_EQ(index.GetEntries().size(), 2u);
+  auto bIndex = index.Find("b");
+  ASSERT_TRUE(bIndex);
+  EXPECT_EQ(index.GetEntries()[*bIndex].entry, b);
+  EXPECT_FALSE(index.Find("c"));
+
+  auto check = [](const wpi::log::DataLogIndex& index, size_t entryIndex) {
+    std::vector<int64_t> values;
+    index.ForEachRecord(entryIndex, 501, 600, [&](const auto& record) {
+      int64_t value;
+      ASSERT_TRUE(record.GetInteger(&value));
+      values.push_back(value);
+    });
+    ASSERT_EQ(values.size(), 100u);
+    for (int i = 0; i < 100; ++i) {
+      EXPECT_EQ(values[i], -(500 + i));
+    }
+  };
+  check(index, *bIndex);
+
+  // save and load
+  std::vector<uint8_t> saved;
+  {
+    wpi::raw_uvector_ostream os{saved};
+    index.Save(os);
+  }
+  auto loaded = wpi::log::DataLogIndex::Load(reader, saved);
+  ASSERT_TRUE(loaded);
+  ASSERT_EQ(loaded->GetEntries().size(), 2u);
+  check(*loaded, *bIndex);
+
+  // log has grown since the index was saved
+  log.AppendInteger(a, 0, 0);
+  log.Flush();
+  wpi::log::DataLogReader reader2{wpi::MemoryBuffer::GetMemBuffer(data, "")};
+  EXPECT_FALSE(wpi::log::DataLogIndex::Load(reader2, saved));
+}
+
+TEST_F(DataLogTest, Series) {
+  int a = log.Start("a", "double", "", 1);
+  int b = log.Start("b", "string", "", 1);
+  int c = log.Start("c", "int64[]", "", 1);
+  for (int i = 0; i < 1000; ++i) {
+    log.AppendDouble(a, i % 10, 10 * i + 1);
+    log.AppendString(b, i % 2 == 0 ? "even" : "odd", 10 * i + 1);
+    log.AppendIntegerArray(c, std::array<int64_t, 1>{i}, 10 * i + 1);
+  }
+  // restarting an entry continues its series; out of order timestamps are
+  // sorted
+  log.Finish(a, 20000);
+  a = log.Start("a", "double", "", 20001);
+  log.AppendDouble(a, 100, 10005);
+  log.Flush();
+
+  wpi::log::DataLogReader reader{wpi::MemoryBuffer::GetMemBuffer(data, "")};
+  wpi::log::DataLogSeries series{reader};
+  ASSERT_EQ(series.GetSeries().size(), 2u);
+  EXPECT_FALSE(series.Find("c"));
+
+  auto aSeries = series.Find("a");
+  ASSERT_TRUE(aSeries);
+  EXPECT_EQ(aSeries->GetType(), wpi::log::DataLogSeries::kDouble);
+  ASSERT_EQ(aSeries->size(), 1001u);
+  EXPECT_EQ(aSeries->GetTimestamp(0), 1);
+  EXPECT_EQ(aSeries->GetTimestamp(999), 9991);
+  EXPECT_EQ(aSeries->GetTimestamp(1000), 10005);
+  EXPECT_EQ(aSeries->GetDouble(999), 9);
+  EXPECT_EQ(aSeries->GetDouble(1000), 100);
+  EXPECT_EQ(aSeries->LowerBound(0), 0u);
+  EXPECT_EQ(aSeries->LowerBound(641), 64u);
+  EXPECT_EQ(aSeries->LowerBound(642), 65u);
+  EXPECT_EQ(aSeries->LowerBound(10000), 1000u);
+  EXPECT_EQ(aSeries->LowerBound(10006), 1001u);
+
+  std::vector<size_t> indexes;
+  aSeries->ForEach(631, 651, [&](size_t index, int64_t timestamp) {
+    EXPECT_EQ(timestamp, aSeries->GetTimestamp(index));
+    indexes.push_back(index);
+  });
+  EXPECT_EQ(indexes, (std::vector<size_t>{63, 64, 65}));
+
+  auto decimated = aSeries->Decimate(1, 200, 2);
+  ASSERT_EQ(decimated.size(), 2u);
+  EXPECT_EQ(decimated[0].timestamp, 1);
+  EXPECT_EQ(decimated[0].min, 0);
+  EXPECT_EQ(decimated[0].max, 9);
+  EXPECT_EQ(decimated[1].timestamp, 101);
+
+  auto bSeries = series.Find("b");
+  ASSERT_TRUE(bSeries);
+  ASSERT_EQ(bSeries->size(), 1000u);
+  EXPECT_EQ(bSeries->GetString(0), "even");
+  EXPECT_EQ(bSeries->GetString(1), "odd");
+  EXPECT_EQ(bSeries->GetString(0).data(), bSeries->GetString(2).data());
+}
+
+TEST_F(DataLogTest, ReadMappedFile) {
+  int entry = log.Start("test", "int64", "", 1);
+  log.AppendInteger(entry, 5, 2);
+  log.Flush();
+
+  auto path = fs::temp_directory_path() / "DataLogTest_ReadMappedFile.wpilog";
+  {
+    std::error_code ec;
+    wpi::raw_fd_ostream os{path.string(), ec};
+    ASSERT_FALSE(ec);
+    os << std::span<const uint8_t>{data};
+  }
+
+  std::error_code ec;
+  wpi::log::DataLogReader reader{path.string(), ec};
+  ASSERT_FALSE(ec);
+  ASSERT_TRUE(reader.IsValid());
+  EXPECT_EQ(reader.GetBufferIdentifier(), path.string());
+  int count = 0;
+  for (auto&& record : reader) {
+    int64_t value;
+    if (record.GetEntry() == entry && record.GetInteger(&value)) {
+      EXPECT_EQ(value, 5);
+      ++count;
+    }
+  }
+  EXPECT_EQ(count, 1);
+
+  wpi::log::DataLogReader missing{path.string() + ".missing", ec};
+  EXPECT_TRUE(ec);
+  EXPECT_FALSE(missing.IsValid());
+  fs::remove(path, ec);
+}
+
 TEST_F(DataLogTest, BooleanAppend) {
   wpi::log::BooleanLogEntry entry{log, "a", 5};
   entry.Append(false, 7);
@@ -574,6 +1059,20 @@ TEST_F(DataLogTest, StructArrayUpdate) {
   ASSERT_EQ(entry.GetLastValue().value(), std::vector<ThingA>{});
 }
 
+TEST_F(DataLogTest, StructArrayLayoutCompatible) {
+  static_assert(wpi::LayoutCompatibleStruct<ThingD>);
+  static_assert(!wpi::LayoutCompatibleStruct<ThingA>);
+  wpi::log::StructArrayLogEntry<ThingD> entry{log, "d", 5};
+  std::vector<ThingD> values{ThingD{.x = 1, .y = -2}, ThingD{.x = 3, .y = 4}};
+  entry.Update(values, 7);
+  log.Flush();
+  ASSERT_GE(data.size(), 8u);
+  ASSERT_EQ(std::vector<uint8_t>(data.end() - 8, data.end()),
+            (std::vector<uint8_t>{1, 0, 0xfe, 0xff, 3, 0, 4, 0}));
+  ASSERT_TRUE(entry.GetLastValue().has_value());
+  ASSERT_EQ(entry.GetLastValue().value(), values);
+}
+
 TEST_F(DataLogTest, StructFixedArrayA) {
   [[maybe_unused]]
   wpi::log::StructArrayLogEntry<std::array<ThingA, 2>> entry0;
@@ -0,0 +1,150 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <stdint.h>
+
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "wpi/Deflate.h"
+
+namespace {
+
+std::vector<uint8_t> Compress(const std::vector<uint8_t>& in) {
+  wpi::DeflateCompressor compressor;
+  std::vector<uint8_t> out;
+  compressor.Compress(in, out);
+  return out;
+}
+
+void CheckRoundTrip(const std::vector<uint8_t>& in) {
+  auto compressed = Compress(in);
+  ASSERT_GE(compressed.size(), 4u);
+  EXPECT_EQ(0xff, compressed.back());
+  wpi::DeflateDecompressor decompressor;
+  std::vector<uint8_t> out;
+  ASSERT_TRUE(decompressor.Decompress(compressed, out));
+  EXPECT_EQ(in, out);
+}
+
+}  // namespace
+
+TEST(DeflateTest, Empty) {
+  CheckRoundTrip({});
+}
+
+TEST(DeflateTest, Short) {
+  CheckRoundTrip({1});
+  CheckRoundTrip({1, 2, 3, 1, 2, 3, 1, 2, 3});
+}
+
+TEST(DeflateTest, Repetitive) {
+  std::vector<uint8_t> in;
+  for (int i = 0; i < 10000; ++i) {
+    in.push_back(i % 7);
+  }
+  CheckRoundTrip(in);
+  EXPECT_LT(Compress(in).size(), in.size() / 50);
+}
+
+TEST(DeflateTest, Random) {
+  std::mt19937 rng{1234};
+  std::uniform_int_distribution<int> dist{0, 255};
+  std::vector<uint8_t> in;
+  for (int i = 0; i < 100000; ++i) {
+    in.push_back(dist(rng));
+  }
+  CheckRoundTrip(in);
+  // incompressible data is stored
+  EXPECT_LT(Compress(in).size(), in.size() + 64);
+}
+
+TEST(DeflateTest, Mixed) {
+  std::mt19937 rng{5678};
+  std::uniform_int_distribution<int> dist{0, 3};
+  std::vector<uint8_t> in;
+  for (int i = 0; i < 200000; ++i) {
+    in.push_back(dist(rng) == 0 ? i & 0xff : 0);
+  }
+  CheckRoundTrip(in);
+}
+
+TEST(DeflateTest, Text) {
+  std::string text;
+  for (int i = 0; i < 200; ++i) {
+    text += "{\"topic\":\"/SmartDashboard/value" + std::to_string(i % 13) +
+            "\",\"type\":\"double\",\"id\":" + std::to_string(i) + "}";
+  }
+  std::vector<uint8_t> in{text.begin(), text.end()};
+  CheckRoundTrip(in);
+  EXPECT_LT(Compress(in).size(), in.size() / 4);
+}
+
+TEST(DeflateTest, SmallWindow) {
+  std::mt19937 rng{42};
+  std::uniform_int_distribution<int> dist{0, 255};
+  std::vector<uint8_t> block;
+  for (int i = 0; i < 1000; ++i) {
+    block.push_back(dist(rng));
+  }
+  std::vector<uint8_t> in;
+  for (int i = 0; i < 10; ++i) {
+    in.insert(in.end(), block.begin(), block.end());
+  }
+  wpi::DeflateCompressor compressor{9};
+  std::vector<uint8_t> compressed;
+  compressor.Compress(in, compressed);
+  // repeats are further apart than the window
+  EXPECT_GT(compressed.size(), in.size() * 9 / 10);
+  EXPECT_LT(Compress(in).size(), in.size() / 4);
+  wpi::DeflateDecompressor decompressor;
+  std::vector<uint8_t> out;
+  ASSERT_TRUE(decompressor.Decompress(compressed, out));
+  EXPECT_EQ(in, out);
+}
+
+TEST(DeflateTest, ContextTakeover) {
+  // zlib output for "hello" then "hello" compressed as one stream with sync
+  // flushes; the second message refers back into the first
+  std::vector<uint8_t> first{0xca, 0x48, 0xcd, 0xc9, 0xc9, 0x07,
+                             0x00, 0x00, 0x00, 0xff, 0xff};
+  std::vector<uint8_t> second{0xca, 0x00, 0x11, 0x00, 0x00,
+                              0x00, 0x00, 0xff, 0xff};
+  wpi::DeflateDecompressor decompressor;
+  std::vector<uint8_t> out;
+  ASSERT_TRUE(decompressor.Decompress(first, out));
+  ASSERT_TRUE(decompressor.Decompress(second, out));
+  EXPECT_EQ(std::string_view("hellohello"),
+            std::string_view(reinterpret_cast<const char*>(out.data()),
+                             out.size()));
+
+  // without the earlier output, the match is out of range
+  decompressor.Reset();
+  out.clear();
+  EXPECT_FALSE(decompressor.Decompress(second, out));
+}
+
+TEST(DeflateTest, Malformed) {
+  std::vector<uint8_t> in;
+  for (int i = 0; i < 1000; ++i) {
+    in.push_back(i % 100);
+  }
+  auto compressed = Compress(in);
+  wpi::DeflateDecompressor decompressor;
+  std::vector<uint8_t> out;
+  // too large
+  EXPECT_FALSE(decompressor.Decompress(compressed, out, in.size() - 1));
+  // truncated input
+  decompressor.Reset();
+  compressed.resize(compressed.size() / 2);
+  EXPECT_FALSE(decompressor.Decompress(compressed, out));
+  // invalid block type
+  decompressor.Reset();
+  std::vector<uint8_t> bad{0x07};
+  EXPECT_FALSE(decompressor.Decompress(bad, out));
+}
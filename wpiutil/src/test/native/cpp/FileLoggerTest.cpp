@@ -2,10 +2,20 @@
 // Open Source Software; you can modify and/or share it under the terms of
 // the WPILib BSD license file in the root directory of this project.
 
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <vector>
 
+#include <fmt/format.h>
 #include <gtest/gtest.h>
 
 #include "wpi/FileLogger.h"
@@ -57,3 +67,58 @@ TEST(FileLoggerTest, BufferMultipleMultiLinePartials) {
   EXPECT_EQ("part 1part 2", buf[0]);
   EXPECT_EQ("part 3part 4", buf[1]);
 }
+
+#ifdef __linux__
+class FileLoggerFileTest : public ::testing::Test {
+ public:
+  FileLoggerFileTest() { std::ofstream{filename}; }
+  ~FileLoggerFileTest() override { std::remove(filename.c_str()); }
+
+  void Append(std::string_view data) {
+    std::ofstream out{filename, std::ios::app};
+    out << data;
+  }
+
+  // waits for the logger thread to pass data to the callback
+  std::string WaitForData(size_t size) {
+    for (int i = 0; i < 50; ++i) {
+      {
+        std::scoped_lock lock{mutex};
+        if (data.size() >= size) {
+          return data;
+        }
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    std::scoped_lock lock{mutex};
+    return data;
+  }
+
+  std::string filename = fmt::format("FileLoggerTest{}.log", getpid());
+  std::mutex mutex;
+  std::string data;
+  int calls = 0;
+};
+
+TEST_F(FileLoggerFileTest, Tail) {
+  wpi::FileLogger logger{filename, [&](std::string_view newData) {
+                           std::scoped_lock lock{mutex};
+                           data += newData;
+                           ++calls;
+                         }};
+  Append("line 1\nline 2\n");
+  EXPECT_EQ(WaitForData(14), "line 1\nline 2\n");
+  EXPECT_EQ(calls, 1);
+}
+
+TEST_F(FileLoggerFileTest, SkipFlood) {
+  wpi::FileLogger logger{filename, [&](std::string_view newData) {
+                           std::scoped_lock lock{mutex};
+                           data += newData;
+                         }};
+  Append(std::string(wpi::FileLogger::kMaxReadSize * 3, 'x'));
+  auto result = WaitForData(wpi::FileLogger::kMaxReadSize + 1);
+  EXPECT_LT(result.size(), wpi::FileLogger::kMaxReadSize * 3);
+  EXPECT_NE(result.find("FileLogger: skipped"), std::string::npos);
+}
+#endif
@@ -0,0 +1,49 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/FixedPool.h"  // NOLINT(build/include_order)
+
+#include <stdexcept>
+#include <string>
+
+#include <gtest/gtest.h>
+
+TEST(FixedPoolTest, NewDelete) {
+  wpi::FixedPool<std::string> pool{2};
+  EXPECT_EQ(pool.Capacity(), 2u);
+  auto a = pool.New("a string that is too long for SSO");
+  auto b = pool.New(3, 'b');
+  ASSERT_NE(a, nullptr);
+  ASSERT_NE(b, nullptr);
+  EXPECT_EQ(*b, "bbb");
+  EXPECT_TRUE(pool.Owns(a));
+  EXPECT_EQ(pool.Size(), 2u);
+  EXPECT_EQ(pool.New(), nullptr);
+
+  pool.Delete(a);
+  EXPECT_EQ(pool.Size(), 1u);
+  auto c = pool.New("c");
+  EXPECT_EQ(c, a);
+  pool.Delete(b);
+  pool.Delete(c);
+  EXPECT_EQ(pool.Size(), 0u);
+}
+
+TEST(FixedPoolTest, Owns) {
+  wpi::FixedPool<int> pool{1};
+  int other;
+  EXPECT_FALSE(pool.Owns(&other));
+}
+
+namespace {
+struct Throws {
+  Throws() { throw std::runtime_error("ctor"); }
+};
+}  // namespace
+
+TEST(FixedPoolTest, ConstructorThrows) {
+  wpi::FixedPool<Throws> pool{1};
+  EXPECT_THROW(pool.New(), std::runtime_error);
+  EXPECT_EQ(pool.Size(), 0u);
+}
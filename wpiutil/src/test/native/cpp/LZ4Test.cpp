@@ -0,0 +1,82 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <stdint.h>
+
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "wpi/LZ4.h"
+
+namespace {
+
+std::vector<uint8_t> Compress(const std::vector<uint8_t>& in) {
+  std::vector<uint8_t> out(wpi::LZ4CompressBound(in.size()));
+  out.resize(wpi::LZ4Compress(in, out));
+  return out;
+}
+
+void CheckRoundTrip(const std::vector<uint8_t>& in) {
+  auto compressed = Compress(in);
+  ASSERT_LE(compressed.size(), wpi::LZ4CompressBound(in.size()));
+  std::vector<uint8_t> out(in.size());
+  ASSERT_TRUE(wpi::LZ4Decompress(compressed, out));
+  EXPECT_EQ(in, out);
+}
+
+}  // namespace
+
+TEST(LZ4Test, Empty) {
+  CheckRoundTrip({});
+}
+
+TEST(LZ4Test, Short) {
+  CheckRoundTrip({1, 2, 3, 1, 2, 3, 1, 2, 3});
+}
+
+TEST(LZ4Test, Repetitive) {
+  std::vector<uint8_t> in;
+  for (int i = 0; i < 10000; ++i) {
+    in.push_back(i % 7);
+  }
+  CheckRoundTrip(in);
+  EXPECT_LT(Compress(in).size(), in.size() / 50);
+}
+
+TEST(LZ4Test, Random) {
+  std::mt19937 rng{1234};
+  std::uniform_int_distribution<int> dist{0, 255};
+  std::vector<uint8_t> in;
+  for (int i = 0; i < 100000; ++i) {
+    in.push_back(dist(rng));
+  }
+  CheckRoundTrip(in);
+}
+
+TEST(LZ4Test, Mixed) {
+  std::mt19937 rng{5678};
+  std::uniform_int_distribution<int> dist{0, 3};
+  std::vector<uint8_t> in;
+  for (int i = 0; i < 200000; ++i) {
+    in.push_back(dist(rng) == 0 ? i & 0xff : 0);
+  }
+  CheckRoundTrip(in);
+}
+
+TEST(LZ4Test, Malformed) {
+  std::vector<uint8_t> in(1000, 5);
+  auto compressed = Compress(in);
+  std::vector<uint8_t> out(in.size());
+  // wrong output size
+  std::vector<uint8_t> small(in.size() - 1);
+  EXPECT_FALSE(wpi::LZ4Decompress(compressed, small));
+  // truncated input
+  compressed.pop_back();
+  EXPECT_FALSE(wpi::LZ4Decompress(compressed, out));
+  // offset before start of output
+  std::vector<uint8_t> bad{0x10, 'a', 0x05, 0x00, 0x00};
+  EXPECT_FALSE(wpi::LZ4Decompress(bad, out));
+}
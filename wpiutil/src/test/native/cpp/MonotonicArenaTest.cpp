@@ -0,0 +1,62 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/MonotonicArena.h"  // NOLINT(build/include_order)
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "wpi/CountingResource.h"
+
+TEST(MonotonicArenaTest, Grow) {
+  wpi::MonotonicArena arena;
+  EXPECT_EQ(arena.GetCapacity(), 0u);
+  EXPECT_NE(arena.allocate(1000), nullptr);
+  EXPECT_EQ(arena.GetOverflowCount(), 1u);
+  arena.Reset();
+  size_t capacity = arena.GetCapacity();
+  EXPECT_GE(capacity, 1000u);
+
+  // fits in the buffer, so doesn't grow
+  EXPECT_NE(arena.allocate(1000), nullptr);
+  EXPECT_EQ(arena.GetOverflowCount(), 0u);
+  arena.Reset();
+  EXPECT_EQ(arena.GetCapacity(), capacity);
+}
+
+TEST(MonotonicArenaTest, Vector) {
+  wpi::MonotonicArena arena{1024};
+  std::pmr::vector<int> vec{arena.Resource()};
+  vec.assign(100, 5);
+  EXPECT_EQ(arena.GetOverflowCount(), 0u);
+}
+
+TEST(MonotonicArenaTest, ThreadArena) {
+  wpi::MonotonicArena* main = &wpi::GetThreadArena();
+  EXPECT_EQ(main, &wpi::GetThreadArena());
+  wpi::MonotonicArena* other = nullptr;
+  std::thread thr{[&] { other = &wpi::GetThreadArena(); }};
+  thr.join();
+  EXPECT_NE(main, other);
+}
+
+TEST(CountingResourceTest, Counts) {
+  wpi::CountingResource counter;
+  size_t hookBytes = 0;
+  counter.SetAllocationHook(
+      [&](size_t bytes, size_t alignment) { hookBytes += bytes; });
+  {
+    std::pmr::vector<int> vec{&counter};
+    vec.reserve(10);
+    EXPECT_EQ(counter.GetAllocationCount(), 1u);
+    EXPECT_EQ(counter.GetBytesAllocated(), 10 * sizeof(int));
+    EXPECT_EQ(hookBytes, 10 * sizeof(int));
+  }
+  EXPECT_EQ(counter.GetDeallocationCount(), 1u);
+  counter.ResetCounts();
+  EXPECT_EQ(counter.GetAllocationCount(), 0u);
+  EXPECT_EQ(counter.GetBytesAllocated(), 0u);
+}
@@ -0,0 +1,116 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/MpmcQueue.h"  // NOLINT(build/include_order)
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(MpmcQueueTest, Capacity) {
+  wpi::MpmcQueue<int> queue{5};
+  EXPECT_EQ(queue.Capacity(), 8u);
+  EXPECT_TRUE(queue.Empty());
+}
+
+TEST(MpmcQueueTest, PushPop) {
+  wpi::MpmcQueue<int> queue{4};
+  EXPECT_FALSE(queue.TryPop());
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(queue.TryPush(i));
+  }
+  EXPECT_FALSE(queue.TryPush(4));
+  EXPECT_EQ(queue.SizeApprox(), 4u);
+  for (int i = 0; i < 4; ++i) {
+    auto value = queue.TryPop();
+    ASSERT_TRUE(value);
+    EXPECT_EQ(*value, i);
+  }
+  EXPECT_FALSE(queue.TryPop());
+  EXPECT_TRUE(queue.Empty());
+}
+
+TEST(MpmcQueueTest, Wraparound) {
+  wpi::MpmcQueue<int> queue{2};
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_TRUE(queue.TryPush(i));
+    ASSERT_EQ(queue.TryPop(), i);
+  }
+}
+
+TEST(MpmcQueueTest, MoveOnly) {
+  wpi::MpmcQueue<std::unique_ptr<int>> queue{4};
+  EXPECT_TRUE(queue.TryEmplace(new int{5}));
+  auto value = queue.TryPop();
+  ASSERT_TRUE(value);
+  EXPECT_EQ(**value, 5);
+}
+
+TEST(MpmcQueueTest, DestroysRemaining) {
+  auto ptr = std::make_shared<int>(1);
+  {
+    wpi::MpmcQueue<std::shared_ptr<int>> queue{4};
+    queue.TryPush(ptr);
+    queue.TryPush(ptr);
+    EXPECT_EQ(ptr.use_count(), 3);
+  }
+  EXPECT_EQ(ptr.use_count(), 1);
+}
+
+TEST(MpmcQueueTest, PopTimeout) {
+  wpi::MpmcQueue<int> queue{4};
+  EXPECT_FALSE(queue.Pop(0.01));
+  queue.TryPush(1);
+  EXPECT_EQ(queue.Pop(0.01), 1);
+}
+
+TEST(MpmcQueueTest, BlockingPop) {
+  wpi::MpmcQueue<int> queue{4};
+  std::thread thr{[&] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    queue.TryPush(5);
+  }};
+  EXPECT_EQ(queue.Pop(), 5);
+  thr.join();
+}
+
+TEST(MpmcQueueTest, MultiThreaded) {
+  constexpr int kProducers = 4;
+  constexpr int kConsumers = 4;
+  constexpr int kCount = 10000;
+  wpi::MpmcQueue<int> queue{64};
+  std::atomic<int64_t> sum{0};
+  std::atomic<int> received{0};
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kProducers; ++i) {
+    threads.emplace_back([&] {
+      for (int j = 1; j <= kCount; ++j) {
+        while (!queue.TryPush(j)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (int i = 0; i < kConsumers; ++i) {
+    threads.emplace_back([&] {
+      while (received < kProducers * kCount) {
+        if (auto value = queue.Pop(0.01)) {
+          sum += *value;
+          ++received;
+        }
+      }
+    });
+  }
+  for (auto&& thr : threads) {
+    thr.join();
+  }
+
+  EXPECT_EQ(received, kProducers * kCount);
+  EXPECT_EQ(sum, int64_t{kProducers} * kCount * (kCount + 1) / 2);
+  EXPECT_TRUE(queue.Empty());
+}
@@ -0,0 +1,70 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/SpscRing.h"  // NOLINT(build/include_order)
+
+#include <memory>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+TEST(SpscRingTest, Capacity) {
+  wpi::SpscRing<int> ring{3};
+  EXPECT_EQ(ring.Capacity(), 4u);
+  EXPECT_TRUE(ring.Empty());
+}
+
+TEST(SpscRingTest, PushPop) {
+  wpi::SpscRing<int> ring{4};
+  EXPECT_FALSE(ring.TryPop());
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(ring.TryPush(i));
+  }
+  EXPECT_FALSE(ring.TryPush(4));
+  EXPECT_EQ(ring.SizeApprox(), 4u);
+  for (int i = 0; i < 4; ++i) {
+    auto value = ring.TryPop();
+    ASSERT_TRUE(value);
+    EXPECT_EQ(*value, i);
+  }
+  EXPECT_FALSE(ring.TryPop());
+  EXPECT_TRUE(ring.TryPush(4));
+  EXPECT_EQ(ring.TryPop(), 4);
+}
+
+TEST(SpscRingTest, DestroysRemaining) {
+  auto ptr = std::make_shared<int>(1);
+  {
+    wpi::SpscRing<std::shared_ptr<int>> ring{4};
+    ring.TryPush(ptr);
+    ring.TryPush(ptr);
+    EXPECT_EQ(ptr.use_count(), 3);
+  }
+  EXPECT_EQ(ptr.use_count(), 1);
+}
+
+TEST(SpscRingTest, PopTimeout) {
+  wpi::SpscRing<int> ring{4};
+  EXPECT_FALSE(ring.Pop(0.01));
+  ring.TryPush(1);
+  EXPECT_EQ(ring.Pop(0.01), 1);
+}
+
+TEST(SpscRingTest, Ordered) {
+  constexpr int kCount = 100000;
+  wpi::SpscRing<std::unique_ptr<int>> ring{16};
+  std::thread producer{[&] {
+    for (int i = 0; i < kCount; ++i) {
+      while (!ring.TryEmplace(new int{i})) {
+        std::this_thread::yield();
+      }
+    }
+  }};
+  for (int i = 0; i < kCount; ++i) {
+    auto value = ring.Pop();
+    ASSERT_EQ(*value, i);
+  }
+  producer.join();
+  EXPECT_TRUE(ring.Empty());
+}
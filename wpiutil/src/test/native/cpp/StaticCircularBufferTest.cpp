@@ -116,9 +116,12 @@ TEST(StaticCircularBufferTest, Reset) {
     queue.push_back(i);
   }
 
+  EXPECT_FALSE(queue.empty());
+
   queue.reset();
 
   EXPECT_EQ(queue.size(), size_t{0});
+  EXPECT_TRUE(queue.empty());
 }
 
 TEST(StaticCircularBufferTest, Iterator) {
@@ -4,6 +4,8 @@
 
 #include "wpi/Synchronization.h"  // NOLINT(build/include_order)
 
+#include <atomic>
+#include <chrono>
 #include <thread>
 
 #include <gtest/gtest.h>
@@ -54,3 +56,79 @@ TEST(EventTest, WaitMultiple) {
   ASSERT_EQ(timedOut, true);
   ASSERT_EQ(result2.size(), 0u);
 }
+
+TEST(EventTest, WaitTimeout) {
+  auto event = wpi::CreateEvent(false, false);
+  bool timedOut = false;
+  auto start = std::chrono::steady_clock::now();
+  ASSERT_FALSE(wpi::WaitForObject(event, 0.05, &timedOut));
+  ASSERT_TRUE(timedOut);
+  ASSERT_GE(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds{50});
+  wpi::DestroyEvent(event);
+}
+
+TEST(EventTest, DestroyWakes) {
+  auto event = wpi::CreateEvent(false, false);
+  std::thread thr([&] {
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    wpi::DestroyEvent(event);
+  });
+  bool timedOut = true;
+  // signaled, but with the error bit set
+  ASSERT_FALSE(wpi::WaitForObject(event, 10, &timedOut));
+  ASSERT_FALSE(timedOut);
+  thr.join();
+}
+
+TEST(EventTest, AutoResetWakesOne) {
+  constexpr int kCount = 10000;
+  auto produced = wpi::CreateEvent(false, false);
+  auto consumed = wpi::CreateEvent(false, false);
+  std::atomic<int> received{0};
+  std::thread thr([&] {
+    for (int i = 0; i < kCount; ++i) {
+      wpi::WaitForObject(produced);
+      ++received;
+      wpi::SetEvent(consumed);
+    }
+  });
+  for (int i = 0; i < kCount; ++i) {
+    wpi::SetEvent(produced);
+    wpi::WaitForObject(consumed);
+  }
+  thr.join();
+  ASSERT_EQ(received, kCount);
+  wpi::DestroyEvent(produced);
+  wpi::DestroyEvent(consumed);
+}
+
+TEST(SemaphoreTest, Release) {
+  auto sem = wpi::CreateSemaphore(0, 2);
+  int prev = -1;
+  ASSERT_TRUE(wpi::ReleaseSemaphore(sem, 2, &prev));
+  ASSERT_EQ(prev, 0);
+  // over the maximum
+  ASSERT_FALSE(wpi::ReleaseSemaphore(sem, 1, &prev));
+  ASSERT_EQ(prev, 2);
+
+  bool timedOut;
+  ASSERT_TRUE(wpi::WaitForObject(sem, 0, &timedOut));
+  ASSERT_TRUE(wpi::WaitForObject(sem, 0, &timedOut));
+  ASSERT_FALSE(wpi::WaitForObject(sem, 0, &timedOut));
+  ASSERT_TRUE(timedOut);
+  wpi::DestroySemaphore(sem);
+}
+
+TEST(SemaphoreTest, WaitMultiple) {
+  auto sem = wpi::CreateSemaphore(0, 10);
+  auto event = wpi::CreateEvent(true, false);
+  std::thread thr([&] { wpi::ReleaseSemaphore(sem); });
+  WPI_Handle signaled[2];
+  auto result = wpi::WaitForObjects({event, sem}, signaled);
+  thr.join();
+  ASSERT_EQ(result.size(), 1u);
+  ASSERT_EQ(result[0], sem);
+  wpi::DestroySemaphore(sem);
+  wpi::DestroyEvent(event);
+}
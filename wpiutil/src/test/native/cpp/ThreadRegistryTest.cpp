@@ -0,0 +1,73 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/ThreadRegistry.h"  // NOLINT(build/include_order)
+
+#include <algorithm>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <gtest/gtest.h>
+
+static bool IsRegistered(std::string_view name) {
+  auto threads = wpi::GetRegisteredThreads();
+  return std::any_of(threads.begin(), threads.end(),
+                     [&](const auto& thr) { return thr.name == name; });
+}
+
+TEST(ThreadRegistryTest, UnregisterOnExit) {
+  std::thread thr{[] {
+    wpi::SetCurrentThreadClass(wpi::ThreadClass::kListener, "TestListener");
+    EXPECT_TRUE(IsRegistered("TestListener"));
+  }};
+  thr.join();
+  EXPECT_FALSE(IsRegistered("TestListener"));
+}
+
+#ifdef __linux__
+TEST(ThreadRegistryTest, ApplyAffinity) {
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  std::thread thr{[&] {
+    EXPECT_TRUE(
+        wpi::SetCurrentThreadClass(wpi::ThreadClass::kLogging, "TestLogging"));
+    EXPECT_TRUE(
+        wpi::SetThreadSchedule(wpi::ThreadClass::kLogging, {.cpuMask = 1}));
+    pthread_getaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+  }};
+  thr.join();
+  EXPECT_TRUE(CPU_ISSET(0, &cpus));
+  EXPECT_EQ(CPU_COUNT(&cpus), 1);
+  EXPECT_EQ(wpi::GetThreadSchedule(wpi::ThreadClass::kLogging).cpuMask, 1u);
+  wpi::SetThreadSchedule(wpi::ThreadClass::kLogging, {});
+}
+
+TEST(ThreadRegistryTest, AffinityOnlyKeepsPolicy) {
+  int policy = -1;
+  std::thread thr{[&] {
+    sched_param sch{};
+    ASSERT_EQ(pthread_setschedparam(pthread_self(), SCHED_BATCH, &sch), 0);
+    wpi::SetCurrentThreadClass(wpi::ThreadClass::kCamera, "TestCamera");
+    EXPECT_TRUE(
+        wpi::SetThreadSchedule(wpi::ThreadClass::kCamera, {.cpuMask = 1}));
+    pthread_getschedparam(pthread_self(), &policy, &sch);
+  }};
+  thr.join();
+  EXPECT_EQ(policy, SCHED_BATCH);
+  wpi::SetThreadSchedule(wpi::ThreadClass::kCamera, {});
+}
+
+TEST(ThreadRegistryTest, MainThreadKeepsName) {
+  char before[16];
+  char after[16];
+  pthread_getname_np(pthread_self(), before, sizeof(before));
+  wpi::SetCurrentThreadClass(wpi::ThreadClass::kMain, "TestMain");
+  pthread_getname_np(pthread_self(), after, sizeof(after));
+  EXPECT_STREQ(before, after);
+}
+#endif
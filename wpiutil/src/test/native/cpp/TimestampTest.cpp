@@ -0,0 +1,41 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <stdint.h>
+
+#include <atomic>
+
+#include <gtest/gtest.h>
+
+#include "wpi/timestamp.h"
+
+static std::atomic<int> nowCalls{0};
+
+static uint64_t OffsetNow() {
+  ++nowCalls;
+  return wpi::NowDefault() + 1000000000;
+}
+
+TEST(TimestampTest, CalibratedDefault) {
+  uint64_t before = wpi::Now();
+  uint64_t calibrated = wpi::NowCalibrated();
+  EXPECT_LE(before, calibrated);
+  EXPECT_LE(calibrated, wpi::Now());
+}
+
+TEST(TimestampTest, CalibratedTracksImpl) {
+  wpi::SetNowImpl(OffsetNow);
+  uint64_t last = 0;
+  for (int i = 0; i < 10000; ++i) {
+    uint64_t before = wpi::NowDefault() + 1000000000;
+    uint64_t calibrated = wpi::NowCalibrated();
+    EXPECT_GE(calibrated, last);
+    EXPECT_NEAR(static_cast<double>(calibrated), static_cast<double>(before),
+                1000.0);
+    last = calibrated;
+  }
+  // Now() is only called to re-synchronize
+  EXPECT_LT(nowCalls, 100);
+  wpi::SetNowImpl(nullptr);
+}
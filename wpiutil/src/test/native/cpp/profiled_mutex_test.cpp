@@ -0,0 +1,115 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/profiled_mutex.h"  // NOLINT(build/include_order)
+
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+std::optional<wpi::LockStats> FindStats(std::string_view name) {
+  for (auto&& stats : wpi::GetLockStats()) {
+    if (stats.name == name) {
+      return stats;
+    }
+  }
+  return {};
+}
+
+class ProfiledMutexTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    wpi::ResetLockStats();
+    wpi::SetLockProfilingEnabled(true);
+  }
+  void TearDown() override { wpi::SetLockProfilingEnabled(false); }
+};
+
+}  // namespace
+
+TEST_F(ProfiledMutexTest, Disabled) {
+  wpi::SetLockProfilingEnabled(false);
+  wpi::profiled_mutex mutex{"Test.Disabled"};
+  { std::scoped_lock lock{mutex}; }
+  auto stats = FindStats("Test.Disabled");
+  ASSERT_TRUE(stats);
+  EXPECT_EQ(stats->locks, 0u);
+  EXPECT_EQ(stats->totalHold, 0u);
+}
+
+TEST_F(ProfiledMutexTest, Hold) {
+  wpi::profiled_mutex mutex{"Test.Hold"};
+  {
+    std::scoped_lock lock{mutex};
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_TRUE(mutex.try_lock());
+  mutex.unlock();
+
+  auto stats = FindStats("Test.Hold");
+  ASSERT_TRUE(stats);
+  EXPECT_EQ(stats->locks, 2u);
+  EXPECT_EQ(stats->contended, 0u);
+  EXPECT_GE(stats->maxHold, 10000000u);
+  EXPECT_GE(stats->totalHold, stats->maxHold);
+}
+
+TEST_F(ProfiledMutexTest, Wait) {
+  wpi::profiled_mutex mutex{"Test.Wait"};
+  mutex.lock();
+  std::thread thr{[&] {
+    std::scoped_lock lock{mutex};
+  }};
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  mutex.unlock();
+  thr.join();
+
+  auto stats = FindStats("Test.Wait");
+  ASSERT_TRUE(stats);
+  EXPECT_EQ(stats->locks, 2u);
+  EXPECT_EQ(stats->contended, 1u);
+  EXPECT_GT(stats->maxWait, 0u);
+  EXPECT_EQ(stats->totalWait, stats->maxWait);
+}
+
+TEST_F(ProfiledMutexTest, Recursive) {
+  wpi::profiled_recursive_mutex mutex{"Test.Recursive"};
+  {
+    std::scoped_lock lock{mutex};
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    std::scoped_lock lock2{mutex};
+  }
+  auto stats = FindStats("Test.Recursive");
+  ASSERT_TRUE(stats);
+  EXPECT_EQ(stats->locks, 2u);
+  // only the outermost lock is timed
+  EXPECT_EQ(stats->totalHold, stats->maxHold);
+  EXPECT_GE(stats->maxHold, 5000000u);
+}
+
+TEST_F(ProfiledMutexTest, CombinedByName) {
+  {
+    wpi::profiled_mutex mutex1{"Test.Combined"};
+    { std::scoped_lock lock{mutex1}; }
+  }
+  wpi::profiled_mutex mutex2{"Test.Combined"};
+  { std::scoped_lock lock{mutex2}; }
+  { std::scoped_lock lock{mutex2}; }
+
+  // includes the destroyed mutex
+  auto stats = FindStats("Test.Combined");
+  ASSERT_TRUE(stats);
+  EXPECT_EQ(stats->locks, 3u);
+
+  wpi::ResetLockStats();
+  stats = FindStats("Test.Combined");
+  ASSERT_TRUE(stats);
+  EXPECT_EQ(stats->locks, 0u);
+}
@@ -0,0 +1,199 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "TestProtoInner.h"
+#include "wpi/protobuf/ProtobufArena.h"
+#include "wpi/protobuf/ProtobufCallbacks.h"
+#include "wpiutil.npb.h"
+
+namespace {
+struct ArenaTestProto {
+  std::vector<double> doubles;
+  std::vector<std::string> strings;
+  std::vector<TestProtoInner> inners;
+};
+}  // namespace
+
+template <>
+struct wpi::Protobuf<ArenaTestProto> {
+  using MessageStruct = wpi_proto_RepeatedTestProto;
+  using InputStream = wpi::ProtoInputStream<ArenaTestProto>;
+  using OutputStream = wpi::ProtoOutputStream<ArenaTestProto>;
+  static std::optional<ArenaTestProto> Unpack(InputStream& stream);
+  static bool UnpackInto(ArenaTestProto* out, InputStream& stream);
+  static bool Pack(OutputStream& stream, const ArenaTestProto& value);
+};
+
+std::optional<ArenaTestProto> wpi::Protobuf<ArenaTestProto>::Unpack(
+    InputStream& stream) {
+  wpi::ArenaUnpackCallback<double, SIZE_MAX> doubles{stream.Arena()};
+  wpi::ArenaUnpackCallback<std::pmr::string, SIZE_MAX> strings{
+      stream.Arena()};
+  wpi::ArenaUnpackCallback<TestProtoInner, SIZE_MAX> inners{stream.Arena()};
+  wpi_proto_RepeatedTestProto msg{
+      .double_msg = doubles.Callback(),
+      .float_msg = {},
+      .int32_msg = {},
+      .int64_msg = {},
+      .uint32_msg = {},
+      .uint64_msg = {},
+      .sint32_msg = {},
+      .sint64_msg = {},
+      .fixed32_msg = {},
+      .fixed64_msg = {},
+      .sfixed32_msg = {},
+      .sfixed64_msg = {},
+      .bool_msg = {},
+      .string_msg = strings.Callback(),
+      .bytes_msg = {},
+      .TestProtoInner_msg = inners.Callback(),
+  };
+  if (!stream.Decode(msg)) {
+    return {};
+  }
+
+  ArenaTestProto rv;
+  rv.doubles.assign(doubles.Items().begin(), doubles.Items().end());
+  rv.strings.assign(strings.Items().begin(), strings.Items().end());
+  rv.inners.assign(inners.Items().begin(), inners.Items().end());
+  return rv;
+}
+
+bool wpi::Protobuf<ArenaTestProto>::UnpackInto(ArenaTestProto* out,
+                                               InputStream& stream) {
+  // decode directly into the existing vectors to reuse their capacity
+  out->doubles.clear();
+  out->strings.clear();
+  out->inners.clear();
+  wpi::DirectUnpackCallback<double, std::vector<double>> doubles{
+      out->doubles};
+  wpi::DirectUnpackCallback<std::string, std::vector<std::string>> strings{
+      out->strings};
+  wpi::DirectUnpackCallback<TestProtoInner, std::vector<TestProtoInner>>
+      inners{out->inners};
+  inners.SetArena(stream.Arena());
+  wpi_proto_RepeatedTestProto msg{
+      .double_msg = doubles.Callback(),
+      .float_msg = {},
+      .int32_msg = {},
+      .int64_msg = {},
+      .uint32_msg = {},
+      .uint64_msg = {},
+      .sint32_msg = {},
+      .sint64_msg = {},
+      .fixed32_msg = {},
+      .fixed64_msg = {},
+      .sfixed32_msg = {},
+      .sfixed64_msg = {},
+      .bool_msg = {},
+      .string_msg = strings.Callback(),
+      .bytes_msg = {},
+      .TestProtoInner_msg = inners.Callback(),
+  };
+  return stream.Decode(msg);
+}
+
+bool wpi::Protobuf<ArenaTestProto>::Pack(OutputStream& stream,
+                                         const ArenaTestProto& value) {
+  wpi::PackCallback<double> doubles{value.doubles};
+  wpi::PackCallback<std::string> strings{value.strings};
+  wpi::PackCallback<TestProtoInner> inners{value.inners};
+  wpi_proto_RepeatedTestProto msg{
+      .double_msg = doubles.Callback(),
+      .float_msg = {},
+      .int32_msg = {},
+      .int64_msg = {},
+      .uint32_msg = {},
+      .uint64_msg = {},
+      .sint32_msg = {},
+      .sint64_msg = {},
+      .fixed32_msg = {},
+      .fixed64_msg = {},
+      .sfixed32_msg = {},
+      .sfixed64_msg = {},
+      .bool_msg = {},
+      .string_msg = strings.Callback(),
+      .bytes_msg = {},
+      .TestProtoInner_msg = inners.Callback(),
+  };
+  return stream.Encode(msg);
+}
+
+namespace {
+ArenaTestProto MakeData() {
+  ArenaTestProto data;
+  for (int i = 0; i < 100; ++i) {
+    data.doubles.emplace_back(i * 0.5);
+  }
+  data.strings.emplace_back("a string that is too long for SSO");
+  data.strings.emplace_back("short");
+  data.inners.emplace_back(TestProtoInner{.msg = "inner"});
+  return data;
+}
+}  // namespace
+
+TEST(ProtobufArenaTest, Grow) {
+  wpi::ProtobufArena arena;
+  EXPECT_EQ(arena.GetCapacity(), 0u);
+  EXPECT_NE(arena.Resource()->allocate(1000), nullptr);
+  arena.Reset();
+  size_t capacity = arena.GetCapacity();
+  EXPECT_GE(capacity, 1000u);
+
+  // fits in the buffer, so doesn't grow
+  EXPECT_NE(arena.Resource()->allocate(1000), nullptr);
+  arena.Reset();
+  EXPECT_EQ(arena.GetCapacity(), capacity);
+}
+
+TEST(ProtobufArenaTest, Unpack) {
+  ArenaTestProto data = MakeData();
+  wpi::ProtobufMessage<ArenaTestProto> message;
+  std::vector<uint8_t> buf;
+  ASSERT_TRUE(message.Pack(buf, data));
+
+  wpi::ProtobufArena arena;
+  auto unpacked = message.Unpack(buf, arena);
+  ASSERT_TRUE(unpacked.has_value());
+  EXPECT_EQ(unpacked->doubles, data.doubles);
+  EXPECT_EQ(unpacked->strings, data.strings);
+  ASSERT_EQ(unpacked->inners.size(), 1u);
+  EXPECT_EQ(unpacked->inners[0].msg, "inner");
+
+  // temporary storage came from the arena
+  arena.Reset();
+  size_t capacity = arena.GetCapacity();
+  EXPECT_GT(capacity, 100 * sizeof(double));
+
+  unpacked = message.Unpack(buf, arena);
+  ASSERT_TRUE(unpacked.has_value());
+  EXPECT_EQ(unpacked->doubles, data.doubles);
+  arena.Reset();
+  EXPECT_EQ(arena.GetCapacity(), capacity);
+}
+
+TEST(ProtobufArenaTest, UnpackIntoReusesStorage) {
+  ArenaTestProto data = MakeData();
+  wpi::ProtobufMessage<ArenaTestProto> message;
+  std::vector<uint8_t> buf;
+  ASSERT_TRUE(message.Pack(buf, data));
+
+  wpi::ProtobufArena arena;
+  ArenaTestProto out;
+  ASSERT_TRUE(message.UnpackInto(&out, buf, arena));
+  EXPECT_EQ(out.doubles, data.doubles);
+  const double* doubles = out.doubles.data();
+
+  arena.Reset();
+  ASSERT_TRUE(message.UnpackInto(&out, buf, arena));
+  EXPECT_EQ(out.doubles, data.doubles);
+  EXPECT_EQ(out.strings, data.strings);
+  EXPECT_EQ(out.doubles.data(), doubles);
+}
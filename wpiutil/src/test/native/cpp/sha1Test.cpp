@@ -19,7 +19,10 @@
         -- Volker Grabsch <vog@notjusthosting.com>
 */
 
+#include <algorithm>
+#include <iterator>
 #include <string>
+#include <string_view>
 
 #include <gtest/gtest.h>
 
@@ -77,6 +80,24 @@ TEST(SHA1Test, OtherABCDE) {
   ASSERT_EQ(checksum.Final(), "03de6c570bfe24bfc328ccd7ca46b76eadaf4334");
 }
 
+TEST(SHA1Test, MultiBlock) {
+  // One million repetitions of 'a', in one call and in uneven pieces
+  std::string data(1000000, 'a');
+  SHA1 checksum1;
+  checksum1.Update(data);
+  ASSERT_EQ(checksum1.Final(), "34aa973cd4c4daa4f61eeb2bdbad27316534016f");
+
+  SHA1 checksum2;
+  std::string_view rest = data;
+  for (size_t i = 0; !rest.empty(); ++i) {
+    static constexpr size_t kSizes[] = {1, 63, 64, 65, 200, 1000, 4096};
+    size_t n = std::min(kSizes[i % std::size(kSizes)], rest.size());
+    checksum2.Update(rest.substr(0, n));
+    rest.remove_prefix(n);
+  }
+  ASSERT_EQ(checksum2.Final(), "34aa973cd4c4daa4f61eeb2bdbad27316534016f");
+}
+
 TEST(SHA1Test, Concurrent) {
   // Two concurrent checksum calculations
   SHA1 checksum1, checksum2;
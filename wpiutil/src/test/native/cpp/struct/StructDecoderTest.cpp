@@ -0,0 +1,104 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/struct/StructDecoder.h"  // NOLINT(build/include_order)
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace wpi;
+
+class StructDecoderTest : public ::testing::Test {
+ protected:
+  StructDescriptorDatabase db;
+  std::string err;
+};
+
+TEST_F(StructDecoderTest, Nested) {
+  db.Add("Translation2d", "double x;double y", &err);
+  db.Add("Rotation2d", "double value", &err);
+  auto desc =
+      db.Add("Pose2d", "Translation2d translation;Rotation2d rotation", &err);
+  ASSERT_TRUE(desc);
+  ASSERT_TRUE(desc->IsValid());
+
+  StructDecoder decoder{desc};
+  auto columns = decoder.GetColumns();
+  ASSERT_EQ(columns.size(), 3u);
+  EXPECT_EQ(columns[0].name, "translation.x");
+  EXPECT_EQ(columns[1].name, "translation.y");
+  EXPECT_EQ(columns[2].name, "rotation.value");
+  EXPECT_EQ(columns[2].type, StructFieldType::kDouble);
+
+  // two poses
+  std::vector<uint8_t> data(2 * desc->GetSize());
+  MutableDynamicStruct pose0{desc, data};
+  MutableDynamicStruct pose1{desc, std::span{data}.subspan(desc->GetSize())};
+  auto translation = desc->FindFieldByName("translation");
+  auto rotation = desc->FindFieldByName("rotation");
+  auto x = translation->GetStruct()->FindFieldByName("x");
+  auto y = translation->GetStruct()->FindFieldByName("y");
+  auto value = rotation->GetStruct()->FindFieldByName("value");
+  pose0.GetStructField(translation).SetDoubleField(x, 1.5);
+  pose0.GetStructField(translation).SetDoubleField(y, -2.0);
+  pose0.GetStructField(rotation).SetDoubleField(value, 0.25);
+  pose1.GetStructField(translation).SetDoubleField(x, 3.0);
+
+  double out[3];
+  decoder.Decode(data, out);
+  EXPECT_EQ(out[0], 1.5);
+  EXPECT_EQ(out[1], -2.0);
+  EXPECT_EQ(out[2], 0.25);
+
+  std::vector<std::vector<double>> cols(3);
+  // trailing partial struct is ignored
+  data.push_back(0);
+  ASSERT_EQ(decoder.DecodeColumns(data, cols), 2u);
+  EXPECT_EQ(cols[0], (std::vector<double>{1.5, 3.0}));
+  EXPECT_EQ(cols[1], (std::vector<double>{-2.0, 0.0}));
+  EXPECT_EQ(cols[2], (std::vector<double>{0.25, 0.0}));
+}
+
+TEST_F(StructDecoderTest, Types) {
+  auto desc = db.Add("test",
+                     "bool a;int8 b;int16 c[2];uint32 d;int64 e;float f;"
+                     "char name[4];int8 g:4;uint8 h:4;bool i:1",
+                     &err);
+  ASSERT_TRUE(desc);
+  ASSERT_TRUE(desc->IsValid());
+
+  StructDecoder decoder{desc};
+  auto columns = decoder.GetColumns();
+  ASSERT_EQ(columns.size(), 10u);
+  EXPECT_EQ(columns[2].name, "c[0]");
+  EXPECT_EQ(columns[3].name, "c[1]");
+  EXPECT_EQ(columns[7].name, "g");
+
+  std::vector<uint8_t> data(desc->GetSize());
+  MutableDynamicStruct s{desc, data};
+  s.SetBoolField(desc->FindFieldByName("a"), true);
+  s.SetIntField(desc->FindFieldByName("b"), -5);
+  s.SetIntField(desc->FindFieldByName("c"), 1000, 0);
+  s.SetIntField(desc->FindFieldByName("c"), -1000, 1);
+  s.SetUintField(desc->FindFieldByName("d"), 4000000000u);
+  s.SetIntField(desc->FindFieldByName("e"), -123456789012);
+  s.SetFloatField(desc->FindFieldByName("f"), 1.25f);
+  s.SetStringField(desc->FindFieldByName("name"), "abc");
+  s.SetIntField(desc->FindFieldByName("g"), 7);
+  s.SetUintField(desc->FindFieldByName("h"), 9);
+  s.SetBoolField(desc->FindFieldByName("i"), true);
+
+  std::vector<double> out(columns.size());
+  decoder.Decode(data, out);
+  EXPECT_EQ(out, (std::vector<double>{1, -5, 1000, -1000, 4000000000.0,
+                                      -123456789012.0, 1.25, 7, 9, 1}));
+
+  // matches the DynamicStruct getters
+  EXPECT_EQ(out[7], s.GetIntField(desc->FindFieldByName("g")));
+  EXPECT_EQ(out[8], s.GetUintField(desc->FindFieldByName("h")));
+}